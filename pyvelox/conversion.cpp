@@ -15,6 +15,7 @@
  */
 
 #include "conversion.h"
+#include <velox/vector/ComplexVector.h>
 #include <velox/vector/arrow/Abi.h>
 #include <velox/vector/arrow/Bridge.h>
 #include "context.h"
@@ -23,6 +24,56 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+namespace {
+
+// Iterates over the batches of an ArrowArrayStream, such as one exported by a
+// pyarrow.RecordBatchReader, and imports each batch as a RowVector. The
+// buffers are taken over without copying.
+class ArrowStreamIterator {
+ public:
+  explicit ArrowStreamIterator(py::object reader)
+      : stream_(new ArrowArrayStream(), [](ArrowArrayStream* stream) {
+          if (stream->release != nullptr) {
+            stream->release(stream);
+          }
+          delete stream;
+        }) {
+    reader.attr("_export_to_c")(reinterpret_cast<uintptr_t>(stream_.get()));
+  }
+
+  RowVectorPtr next() {
+    ArrowSchema schema;
+    checkStatus(stream_->get_schema(stream_.get(), &schema));
+    ArrowArray array;
+    auto status = stream_->get_next(stream_.get(), &array);
+    if (status != 0) {
+      schema.release(&schema);
+      checkStatus(status);
+    }
+    if (array.release == nullptr) {
+      // The stream has ended.
+      schema.release(&schema);
+      throw py::stop_iteration();
+    }
+    auto pool = PyVeloxContext::getSingletonInstance().pool();
+    return std::dynamic_pointer_cast<RowVector>(
+        importFromArrowAsOwner(schema, array, pool));
+  }
+
+ private:
+  void checkStatus(int status) {
+    if (status != 0) {
+      const char* error = stream_->get_last_error(stream_.get());
+      throw std::runtime_error(
+          error != nullptr ? error : "Failed to read Arrow stream");
+    }
+  }
+
+  std::shared_ptr<ArrowArrayStream> stream_;
+};
+
+} // namespace
+
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
   m.def("export_to_arrow", [](VectorPtr& inputVector) {
     auto arrowArray = std::make_unique<ArrowArray>();
@@ -48,5 +99,60 @@ void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
     auto pool_ = PyVeloxContext::getSingletonInstance().pool();
     return importFromArrowAsOwner(*arrowSchema, *arrowArray, pool_);
   });
+
+  m.def("export_to_arrow_batch", [](RowVectorPtr& inputVector) {
+    auto arrowArray = std::make_unique<ArrowArray>();
+    auto pool = PyVeloxContext::getSingletonInstance().pool();
+    facebook::velox::exportToArrow(inputVector, *arrowArray, pool);
+
+    auto arrowSchema = std::make_unique<ArrowSchema>();
+    facebook::velox::exportToArrow(inputVector, *arrowSchema);
+
+    py::module arrowModule = py::module::import("pyarrow");
+    py::object batchClass = arrowModule.attr("RecordBatch");
+    return batchClass.attr("_import_from_c")(
+        reinterpret_cast<uintptr_t>(arrowArray.get()),
+        reinterpret_cast<uintptr_t>(arrowSchema.get()));
+  });
+
+  m.def("import_from_arrow_batch", [](py::object inputBatch) {
+    auto arrowArray = std::make_unique<ArrowArray>();
+    auto arrowSchema = std::make_unique<ArrowSchema>();
+    inputBatch.attr("_export_to_c")(
+        reinterpret_cast<uintptr_t>(arrowArray.get()),
+        reinterpret_cast<uintptr_t>(arrowSchema.get()));
+    auto pool = PyVeloxContext::getSingletonInstance().pool();
+    return std::dynamic_pointer_cast<RowVector>(
+        importFromArrowAsOwner(*arrowSchema, *arrowArray, pool));
+  });
+
+  py::class_<ArrowStreamIterator>(
+      m,
+      "ArrowStreamIterator",
+      py::module_local(asModuleLocalDefinitions))
+      .def(
+          "__iter__",
+          [](ArrowStreamIterator& it) -> ArrowStreamIterator& { return it; },
+          py::return_value_policy::reference_internal)
+      .def("__next__", &ArrowStreamIterator::next);
+
+  m.def(
+      "import_from_arrow_stream",
+      [](py::object reader) { return ArrowStreamIterator(std::move(reader)); },
+      R"delimiter(
+        Returns an iterator over the batches of a pyarrow.RecordBatchReader.
+        Each batch is imported as a RowVector without copying its buffers.
+
+        Examples
+        --------
+
+        >>> import pyarrow as pa
+        >>> import pyvelox.pyvelox as pv
+        >>> batch = pa.record_batch([pa.array([1, 2, 3])], names=["c0"])
+        >>> reader = pa.RecordBatchReader.from_batches(batch.schema, [batch])
+        >>> [len(v) for v in pv.import_from_arrow_stream(reader)]
+        [3]
+      )delimiter",
+      py::arg("reader"));
 }
 } // namespace facebook::velox::py
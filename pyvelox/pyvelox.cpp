@@ -224,11 +224,20 @@ static VectorPtr evaluateExpression(
   memory::MemoryPool* pool = PyVeloxContext::getSingletonInstance().pool();
   RowVectorPtr rowVector = std::make_shared<RowVector>(
       pool, rowType, BufferPtr{nullptr}, numRows, inputs);
-  core::TypedExprPtr typed = core::Expressions::inferTypes(expr, rowType, pool);
+  return evaluateExpression(expr, rowVector);
+}
+
+static VectorPtr evaluateExpression(
+    std::shared_ptr<const facebook::velox::core::IExpr>& expr,
+    const RowVectorPtr& input) {
+  using namespace facebook::velox;
+  memory::MemoryPool* pool = PyVeloxContext::getSingletonInstance().pool();
+  core::TypedExprPtr typed =
+      core::Expressions::inferTypes(expr, asRowType(input->type()), pool);
   exec::ExprSet set({typed}, PyVeloxContext::getSingletonInstance().execCtx());
   exec::EvalCtx evalCtx(
-      PyVeloxContext::getSingletonInstance().execCtx(), &set, rowVector.get());
-  SelectivityVector rows(numRows);
+      PyVeloxContext::getSingletonInstance().execCtx(), &set, input.get());
+  SelectivityVector rows(input->size());
   std::vector<VectorPtr> result;
   set.eval(rows, evalCtx, result);
   return result[0];
@@ -290,6 +299,12 @@ static void addExpressionBindings(
             return evaluateExpression(e.expr, names, inputs);
           },
           "Evaluates the expression, taking in a map from names to input vectors")
+      .def(
+          "evaluate",
+          [](IExprWrapper& e, RowVectorPtr& input) {
+            return evaluateExpression(e.expr, input);
+          },
+          "Evaluates the expression over the columns of a RowVector, e.g. one imported with import_from_arrow_batch")
       .def_static("from_string", [](std::string& str) {
         parse::ParseOptions opts;
         return IExprWrapper{parse::parseExpr(str, opts)};
@@ -205,6 +205,10 @@ static VectorPtr evaluateExpression(
     std::vector<std::string> names,
     std::vector<VectorPtr>& inputs);
 
+static VectorPtr evaluateExpression(
+    std::shared_ptr<const facebook::velox::core::IExpr>& expr,
+    const RowVectorPtr& input);
+
 inline void addDataTypeBindings(
     py::module& m,
     bool asModuleLocalDefinitions = true) {
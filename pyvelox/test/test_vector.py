@@ -392,6 +392,32 @@ class TestVeloxVector(unittest.TestCase):
                 for i in range(0, len(data)):
                     self.assertEqual(velox_vector[i], data[i])
 
+    def test_arrow_batch_roundtrip(self):
+        batch = pa.record_batch(
+            [pa.array([1, 2, 3]), pa.array(["a", "b", None])], names=["x", "y"]
+        )
+        row_vector = pv.import_from_arrow_batch(batch)
+        self.assertEqual(len(row_vector), 3)
+        self.assertEqual(str(row_vector), "0: {1, a}\n1: {2, b}\n2: {3, null}")
+
+        result = pv.export_to_arrow_batch(row_vector)
+        self.assertEqual(result.to_pydict(), batch.to_pydict())
+
+    def test_import_from_arrow_stream(self):
+        schema = pa.schema([("x", pa.int64())])
+        batches = [
+            pa.record_batch([pa.array([1, 2, 3])], schema=schema),
+            pa.record_batch([pa.array([4, 5])], schema=schema),
+        ]
+        reader = pa.RecordBatchReader.from_batches(schema, batches)
+
+        expr = pv.Expression.from_string("x * 2")
+        results = [
+            pv.export_to_arrow(expr.evaluate(row_vector)).tolist()
+            for row_vector in pv.import_from_arrow_stream(reader)
+        ]
+        self.assertEqual(results, [[2, 4, 6], [8, 10]])
+
     def test_row_vector_basic(self):
         vals = [
             pv.from_list([1, 2, 3]),
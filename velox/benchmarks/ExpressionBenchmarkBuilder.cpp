@@ -36,6 +36,24 @@ ExpressionBenchmarkSet& ExpressionBenchmarkSet::addExpressions(
   return *this;
 }
 
+ExpressionBenchmarkSet& ExpressionBenchmarkSet::addExpressionWithFusion(
+    const std::string& name,
+    const std::string& expression) {
+  addExpression(name, expression);
+  expressions_.push_back(std::make_pair(
+      fmt::format("{}_fused", name),
+      builder_.compileFusedExpression(expression, inputType_)));
+  return *this;
+}
+
+exec::ExprSet ExpressionBenchmarkBuilder::compileFusedExpression(
+    const std::string& expression,
+    const TypePtr& rowType) {
+  auto untyped = parse::parseExpr(expression, options_);
+  auto typed = core::Expressions::inferTypes(untyped, rowType, pool());
+  return exec::ExprSet({typed}, &fusedExecCtx_);
+}
+
 // Make sure all input vectors are generated.
 void ExpressionBenchmarkBuilder::ensureInputVectors() {
   for (auto& [_, benchmarkSet] : benchmarkSets_) {
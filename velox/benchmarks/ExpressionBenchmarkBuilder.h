@@ -39,6 +39,13 @@ class ExpressionBenchmarkSet {
   ExpressionBenchmarkSet& addExpressions(
       const std::vector<std::pair<std::string, std::string>>& expressions);
 
+  // Adds 'expression' as 'name' and, compiled with
+  // QueryConfig::kExprFuseSimpleFunctions enabled, as '<name>_fused' to compare
+  // the fused and the unfused evaluation.
+  ExpressionBenchmarkSet& addExpressionWithFusion(
+      const std::string& name,
+      const std::string& expression);
+
   ExpressionBenchmarkSet& disableTesting() {
     disableTesting_ = true;
     return *this;
@@ -131,9 +138,20 @@ class ExpressionBenchmarkBuilder
     return benchmarkSets_.at(name);
   }
 
+  // Compiles 'expression' with QueryConfig::kExprFuseSimpleFunctions enabled.
+  exec::ExprSet compileFusedExpression(
+      const std::string& expression,
+      const TypePtr& rowType);
+
  private:
   void ensureInputVectors();
 
   std::map<std::string, ExpressionBenchmarkSet> benchmarkSets_;
+
+  std::shared_ptr<core::QueryCtx> fusedQueryCtx_{core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig{
+          {{core::QueryConfig::kExprFuseSimpleFunctions, "true"}}})};
+  core::ExecCtx fusedExecCtx_{pool_.get(), fusedQueryCtx_.get()};
 };
 } // namespace facebook::velox
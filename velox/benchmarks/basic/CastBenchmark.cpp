@@ -74,6 +74,14 @@ int main(int argc, char** argv) {
       vectorMaker.flatVector<Timestamp>(vectorSize, [&](auto j) {
         return Timestamp(1695859694 + j / 1000, j % 1000 * 1'000'000);
       });
+  auto bigintInput = vectorMaker.flatVector<int64_t>(
+      vectorSize, [](auto row) { return row * 1'000'000'007LL - 1; });
+  auto integerInput = vectorMaker.flatVector<int32_t>(
+      vectorSize, [](auto row) { return row * 1'000'003 - 1; });
+  auto bigintStringInput =
+      vectorMaker.flatVector<std::string>(vectorSize, [](auto row) {
+        return std::to_string(row * 1'000'000'007LL);
+      });
   auto validDateStrings = vectorMaker.flatVector<std::string>(
       vectorSize,
       [](auto row) { return fmt::format("2024-05-{:02d}", 1 + row % 30); });
@@ -117,6 +125,17 @@ int main(int argc, char** argv) {
           vectorMaker.rowVector({"timestamp"}, {timestampInput}))
       .addExpression("cast", "cast (timestamp as varchar)");
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_integer_and_varchar",
+          vectorMaker.rowVector(
+              {"bigint_value", "integer_value", "bigint_string"},
+              {bigintInput, integerInput, bigintStringInput}))
+      .addExpression("cast_bigint_as_varchar", "cast(bigint_value as varchar)")
+      .addExpression(
+          "cast_integer_as_varchar", "cast(integer_value as varchar)")
+      .addExpression("cast_varchar_as_bigint", "cast(bigint_string as bigint)");
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast_varchar_as_double",
@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 #include <gflags/gflags.h>
 
+#include "velox/expression/DecodedArgs.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
@@ -118,7 +119,29 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     DecodedVector decodedVector(*dictionaryNestedVector_, rows_);
   }
 
+  // Measure time for several functions over the same 5-way nested dictionary
+  // vector to decode it, each by itself.
+  void decodeDictionary5NestedRepeated() {
+    EvalCtx context(&execCtx_);
+    for (auto i = 0; i < kNumDecodes; ++i) {
+      LocalDecodedVector decoded(context, *dictionaryNestedVector_, rows_);
+      folly::doNotOptimizeAway(decoded->size());
+    }
+  }
+
+  // Same as above with the decoding shared through the EvalCtx.
+  void decodeDictionary5NestedCached() {
+    EvalCtx context(&execCtx_);
+    const std::vector<VectorPtr> args{dictionaryNestedVector_};
+    for (auto i = 0; i < kNumDecodes; ++i) {
+      DecodedArgs decodedArgs(rows_, args, context);
+      folly::doNotOptimizeAway(decodedArgs.at(0)->size());
+    }
+  }
+
  private:
+  static constexpr int32_t kNumDecodes = 4;
+
   void decodedRun(const DecodedVector& decodedVector) {
     size_t sum = 0;
     for (auto i = 0; i < vectorSize_; i++) {
@@ -185,6 +208,14 @@ BENCHMARK(decodeDictionary5Nested) {
   run([&] { benchmark->decodeDictionary5Nested(); });
 }
 
+BENCHMARK(decodeDictionary5NestedRepeated) {
+  run([&] { benchmark->decodeDictionary5NestedRepeated(); });
+}
+
+BENCHMARK_RELATIVE(decodeDictionary5NestedCached) {
+  run([&] { benchmark->decodeDictionary5NestedCached(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+using namespace facebook;
+using namespace facebook::velox;
+
+// Compares the evaluation of arithmetic expressions with and without
+// QueryConfig::kExprFuseSimpleFunctions.
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions("");
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+
+  // Floating point inputs so that the fuzzed values do not overflow.
+  const std::vector<std::pair<std::string, TypePtr>> inputTypes = {
+      {"double", DOUBLE()}, {"real", REAL()}};
+  for (const auto& [setName, type] : inputTypes) {
+    VectorFuzzer::Options options;
+    options.vectorSize = 10'000;
+    options.nullRatio = 0.01;
+    benchmarkBuilder
+        .addBenchmarkSet(
+            setName, ROW({"a", "b", "c", "d"}, {type, type, type, type}))
+        .withFuzzerOptions(options)
+        .withIterations(100)
+        .addExpressionWithFusion("a_times_b_plus_c_minus_d", "a * b + c - d")
+        .addExpressionWithFusion(
+            "polynomial", "a * a * a + b * a * a + c * a + d")
+        .addExpressionWithFusion("compare", "a * b + c > d * d");
+  }
+
+  benchmarkBuilder.registerBenchmarks();
+  benchmarkBuilder.testBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -17,6 +17,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/lib/Re2Functions.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
@@ -174,6 +175,36 @@ class LikeFunctionsBenchmark : public FunctionBaseTest,
     return cnt;
   }
 
+  // Searches 'needle' in the rows of the data of 'tpchCase' with
+  // simd::simdStrstr or with std::string_view::find, which LIKE '%needle%' and
+  // strpos used before.
+  size_t runSubstringSearch(
+      const TpchBenchmarkCase tpchCase,
+      const std::string& needle,
+      bool useSimd) {
+    folly::BenchmarkSuspender kSuspender;
+    const auto input = getTpchData(tpchCase);
+    const auto* values = input->asFlatVector<StringView>()->rawValues();
+    kSuspender.dismiss();
+
+    size_t cnt = 0;
+    for (auto i = 0; i < FLAGS_num_runs; i++) {
+      for (auto row = 0; row < input->size(); ++row) {
+        const auto& value = values[row];
+        if (useSimd) {
+          cnt += simd::simdStrstr(
+                     value.data(), value.size(), needle.data(), needle.size()) !=
+              std::string_view::npos;
+        } else {
+          cnt += std::string_view(value).find(needle) != std::string_view::npos;
+        }
+      }
+    }
+    folly::doNotOptimizeAway(cnt);
+
+    return cnt;
+  }
+
   // We inherit from FunctionBaseTest so that we can get access to the helpers
   // it defines, but since it is supposed to be a test fixture TestBody() is
   // declared pure virtual.  We must provide an implementation here.
@@ -239,6 +270,26 @@ BENCHMARK(tpchQuery20) {
   benchmark->run(TpchBenchmarkCase::TpchQuery20, "forest%");
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(tpchQuery9Find) {
+  benchmark->runSubstringSearch(TpchBenchmarkCase::TpchQuery9, "green", false);
+}
+
+BENCHMARK_RELATIVE(tpchQuery9SimdStrstr) {
+  benchmark->runSubstringSearch(TpchBenchmarkCase::TpchQuery9, "green", true);
+}
+
+BENCHMARK(tpchQuery13Find) {
+  benchmark->runSubstringSearch(
+      TpchBenchmarkCase::TpchQuery13, "special", false);
+}
+
+BENCHMARK_RELATIVE(tpchQuery13SimdStrstr) {
+  benchmark->runSubstringSearch(
+      TpchBenchmarkCase::TpchQuery13, "special", true);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -75,6 +75,10 @@ class SelectivityVectorBenchmark
     rows50PerCent_.updateBounds();
     rows10PerCent_.updateBounds();
     rows1PerCent_.updateBounds();
+
+    scratch_.resize(bits::nwords(vectorSize_));
+    lastBitOnly_.resize(bits::nwords(vectorSize_));
+    bits::setBit(lastBitOnly_.data(), vectorSize_ - 1);
   }
 
   size_t runBaseline() {
@@ -108,6 +112,47 @@ class SelectivityVectorBenchmark
     return run(rows99PerCent_);
   }
 
+  // Scalar and SIMD versions of the bit primitives behind SelectivityVector.
+  template <bool kSimd>
+  size_t runCountBits() {
+    const auto* words = rows50PerCent_.allBits();
+    int32_t count = kSimd ? simd::countBits(words, 0, vectorSize_)
+                          : bits::countBits(words, 0, vectorSize_);
+    folly::doNotOptimizeAway(count);
+    return vectorSize_;
+  }
+
+  template <bool kSimd>
+  size_t runAndBits() {
+    if constexpr (kSimd) {
+      simd::andRange<false>(
+          scratch_.data(),
+          rows10PerCent_.allBits(),
+          rows50PerCent_.allBits(),
+          0,
+          vectorSize_);
+    } else {
+      bits::andBits(
+          scratch_.data(),
+          rows10PerCent_.allBits(),
+          rows50PerCent_.allBits(),
+          0,
+          vectorSize_);
+    }
+    folly::doNotOptimizeAway(scratch_);
+    return vectorSize_;
+  }
+
+  template <bool kSimd>
+  size_t runFindFirstBit() {
+    // Only the last bit is set.
+    int32_t first = kSimd
+        ? simd::findFirstBit(lastBitOnly_.data(), 0, vectorSize_)
+        : bits::findFirstBit(lastBitOnly_.data(), 0, vectorSize_);
+    folly::doNotOptimizeAway(first);
+    return vectorSize_;
+  }
+
  private:
   size_t run(const SelectivityVector& rows) {
     const int64_t* flatBuffer = flatVector_->values()->as<int64_t>();
@@ -126,6 +171,9 @@ class SelectivityVectorBenchmark
   SelectivityVector rows50PerCent_;
   SelectivityVector rows10PerCent_;
   SelectivityVector rows1PerCent_;
+
+  std::vector<uint64_t> scratch_;
+  std::vector<uint64_t> lastBitOnly_;
 };
 
 std::unique_ptr<SelectivityVectorBenchmark> benchmark;
@@ -161,6 +209,32 @@ BENCHMARK(sumSelectivity1PerCent) {
   run([] { benchmark->runSelectivity1PerCent(); });
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(countBits) {
+  run([] { benchmark->runCountBits<false>(); });
+}
+
+BENCHMARK_RELATIVE(countBitsSimd) {
+  run([] { benchmark->runCountBits<true>(); });
+}
+
+BENCHMARK(andBits) {
+  run([] { benchmark->runAndBits<false>(); });
+}
+
+BENCHMARK_RELATIVE(andBitsSimd) {
+  run([] { benchmark->runAndBits<true>(); });
+}
+
+BENCHMARK(findFirstBit) {
+  run([] { benchmark->runFindFirstBit<false>(); });
+}
+
+BENCHMARK_RELATIVE(findFirstBitSimd) {
+  run([] { benchmark->runFindFirstBit<true>(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <iostream>
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/file/tests/FaultyFileSystem.h"
+#include "velox/common/file/tests/LatencyInjectingModel.h"
+#include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/dwio/common/Options.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+DEFINE_string(
+    data_path,
+    "",
+    "A data file or a directory of data files to scan. The files must have "
+    "the same schema");
+DEFINE_string(data_format, "parquet", "Data format, parquet or dwrf");
+DEFINE_string(
+    columns,
+    "",
+    "Comma separated columns to read. All columns if empty");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_int32(num_splits_per_file, 10, "Number of splits per file");
+DEFINE_int32(num_io_threads, 8, "Threads for speculative IO");
+DEFINE_int32(num_repeats, 3, "Number of times to run each configuration");
+DEFINE_int32(cache_gb, 4, "Size of the in-memory data cache in GB");
+
+DEFINE_int64(latency_us, 10'000, "Median first byte latency of a read");
+DEFINE_double(
+    latency_sigma,
+    0.4,
+    "Standard deviation of the log of the first byte latency");
+DEFINE_double(
+    tail_probability,
+    0.01,
+    "Fraction of reads that take --tail_latency_us");
+DEFINE_int64(tail_latency_us, 200'000, "Latency of the tail reads");
+DEFINE_int64(
+    request_mb_per_second,
+    100,
+    "Throughput of a single read. 0 is unlimited");
+DEFINE_int64(
+    total_mb_per_second,
+    1'000,
+    "Throughput shared by all concurrent reads. 0 is unlimited");
+
+DEFINE_string(
+    coalesce_distances_kb,
+    "0,512",
+    "Values of max_coalesced_distance_bytes in KB to try");
+DEFINE_int64(max_coalesced_mb, 128, "Value of max_coalesced_bytes in MB");
+DEFINE_string(
+    prefetch_row_groups,
+    "0,1",
+    "Values of the Parquet row group prefetch to try");
+DEFINE_string(
+    split_preloads,
+    "0,2",
+    "Values of max_split_preload_per_driver to try");
+DEFINE_string(
+    cache_modes,
+    "off,cold,warm",
+    "Cache modes to try. 'off' reads without the data cache, 'cold' clears "
+    "the cache before each run and 'warm' runs once before measuring");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::tests::utils;
+
+namespace {
+
+enum class CacheMode { kOff, kCold, kWarm };
+
+CacheMode toCacheMode(const std::string& name) {
+  if (name == "off") {
+    return CacheMode::kOff;
+  }
+  if (name == "cold") {
+    return CacheMode::kCold;
+  }
+  if (name == "warm") {
+    return CacheMode::kWarm;
+  }
+  VELOX_USER_FAIL("Unknown cache mode: {}", name);
+}
+
+std::string cacheModeName(CacheMode mode) {
+  switch (mode) {
+    case CacheMode::kOff:
+      return "off";
+    case CacheMode::kCold:
+      return "cold";
+    case CacheMode::kWarm:
+      return "warm";
+  }
+  VELOX_UNREACHABLE();
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string& flag) {
+  std::vector<T> values;
+  folly::split(',', flag, values, true);
+  VELOX_USER_CHECK(!values.empty(), "Empty list of values: '{}'", flag);
+  return values;
+}
+
+/// One combination of the read path settings to measure.
+struct ReadPathConfig {
+  int64_t coalesceDistanceKB;
+  int32_t prefetchRowGroups;
+  int32_t splitPreload;
+  CacheMode cacheMode;
+
+  std::string toString() const {
+    return fmt::format(
+        "coalesce {}KB, prefetch {}, preload {}, cache {}",
+        coalesceDistanceKB,
+        prefetchRowGroups,
+        splitPreload,
+        cacheModeName(cacheMode));
+  }
+};
+
+/// Measurements of one run of a scan.
+struct ScanResult {
+  uint64_t firstBatchUs{0};
+  uint64_t totalUs{0};
+  uint64_t numRows{0};
+  uint64_t rawInputBytes{0};
+  uint64_t ioWaitNanos{0};
+  LatencyInjectingModel::Stats storage;
+
+  void add(const ScanResult& other) {
+    firstBatchUs += other.firstBatchUs;
+    totalUs += other.totalUs;
+    numRows += other.numRows;
+    rawInputBytes += other.rawInputBytes;
+    ioWaitNanos += other.ioWaitNanos;
+    storage.numRequests += other.storage.numRequests;
+    storage.numTailRequests += other.storage.numTailRequests;
+    storage.bytes += other.storage.bytes;
+    storage.delayUs += other.storage.delayUs;
+  }
+};
+
+std::vector<std::string> listDataFiles(const std::string& path) {
+  std::vector<std::string> files;
+  if (!fs::is_directory(path)) {
+    files.push_back(path);
+    return files;
+  }
+  for (const auto& entry : fs::directory_iterator(path)) {
+    const auto name = entry.path().filename().string();
+    if (entry.is_regular_file() && name[0] != '.' && name[0] != '_') {
+      files.push_back(entry.path().string());
+    }
+  }
+  std::sort(files.begin(), files.end());
+  VELOX_USER_CHECK(!files.empty(), "No data files in {}", path);
+  return files;
+}
+
+RowTypePtr readSchema(
+    const std::string& path,
+    dwio::common::FileFormat format,
+    memory::MemoryPool* pool) {
+  dwio::common::ReaderOptions readerOptions{pool};
+  readerOptions.setFileFormat(format);
+  std::shared_ptr<ReadFile> readFile =
+      filesystems::getFileSystem(path, nullptr)->openFileForRead(path);
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      readFile, readerOptions.memoryPool());
+  auto reader = dwio::common::getReaderFactory(format)->createReader(
+      std::move(input), readerOptions);
+  return reader->rowType();
+}
+
+/// Scans the data files through FaultyFileSystem with a LatencyInjectingModel
+/// in each ReadPathConfig and prints the time to the first batch, the total
+/// time and the number of storage requests. The storage latency applies to
+/// all reads of the scan, including the file footers.
+class ScanLatencyBenchmark {
+ public:
+  void initialize() {
+    memory::MemoryManagerOptions options;
+    options.useMmapAllocator = true;
+    options.allocatorCapacity = static_cast<int64_t>(FLAGS_cache_gb) << 30;
+    options.useMmapArena = true;
+    options.mmapArenaCapacityRatio = 1;
+    memory::MemoryManager::testingSetInstance(options);
+    cache_ =
+        cache::AsyncDataCache::create(memory::memoryManager()->allocator());
+    cache::AsyncDataCache::setInstance(cache_.get());
+    pool_ = memory::memoryManager()->addLeafPool();
+
+    filesystems::registerLocalFileSystem();
+    registerFaultyFileSystem();
+
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        std::thread::hardware_concurrency());
+    ioExecutor_ =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+
+    LatencyInjectingModel::Config config;
+    config.latencyUs = FLAGS_latency_us;
+    config.latencySigma = FLAGS_latency_sigma;
+    config.tailProbability = FLAGS_tail_probability;
+    config.tailLatencyUs = FLAGS_tail_latency_us;
+    config.requestBytesPerSecond = FLAGS_request_mb_per_second << 20;
+    config.totalBytesPerSecond = FLAGS_total_mb_per_second << 20;
+    storage_ = std::make_unique<LatencyInjectingModel>(config);
+
+    format_ = dwio::common::toFileFormat(FLAGS_data_format);
+    for (const auto& file : listDataFiles(FLAGS_data_path)) {
+      dataFiles_.push_back(
+          fmt::format("{}{}", FaultyFileSystem::scheme(), file));
+    }
+    auto fileType = readSchema(dataFiles_[0], format_, pool_.get());
+    if (FLAGS_columns.empty()) {
+      rowType_ = fileType;
+    } else {
+      std::vector<std::string> names;
+      std::vector<TypePtr> types;
+      for (const auto& name : parseList<std::string>(FLAGS_columns)) {
+        types.push_back(fileType->findChild(name));
+        names.push_back(name);
+      }
+      rowType_ = ROW(std::move(names), std::move(types));
+    }
+  }
+
+  void shutdown() {
+    faultyFileSystem()->clearFileFaultInjections();
+    connector::unregisterConnector(kHiveConnectorId);
+    cache_->shutdown();
+  }
+
+  void run() {
+    std::vector<ReadPathConfig> configs;
+    for (auto distance : parseList<int64_t>(FLAGS_coalesce_distances_kb)) {
+      for (auto prefetch : parseList<int32_t>(FLAGS_prefetch_row_groups)) {
+        for (auto preload : parseList<int32_t>(FLAGS_split_preloads)) {
+          for (const auto& mode : parseList<std::string>(FLAGS_cache_modes)) {
+            configs.push_back({distance, prefetch, preload, toCacheMode(mode)});
+          }
+        }
+      }
+    }
+
+    std::cout << fmt::format(
+                     "Scanning {} files of {} columns. Storage latency {}us "
+                     "(sigma {}), {}% at {}us, {}MB/s per read, {}MB/s total",
+                     dataFiles_.size(),
+                     rowType_->size(),
+                     FLAGS_latency_us,
+                     FLAGS_latency_sigma,
+                     FLAGS_tail_probability * 100,
+                     FLAGS_tail_latency_us,
+                     FLAGS_request_mb_per_second,
+                     FLAGS_total_mb_per_second)
+              << std::endl;
+    faultyFileSystem()->setFileInjectionHook(storage_->makeHook());
+    for (const auto& config : configs) {
+      const auto result = runConfig(config);
+      const auto n = FLAGS_num_repeats;
+      std::cout << fmt::format(
+                       "{}: first batch {}, total {}, {} rows, {} requests "
+                       "({} tail), {} read, {} raw input, {} io wait",
+                       config.toString(),
+                       succinctMicros(result.firstBatchUs / n),
+                       succinctMicros(result.totalUs / n),
+                       result.numRows / n,
+                       result.storage.numRequests / n,
+                       result.storage.numTailRequests / n,
+                       succinctBytes(result.storage.bytes / n),
+                       succinctBytes(result.rawInputBytes / n),
+                       succinctNanos(result.ioWaitNanos / n))
+                << std::endl;
+    }
+  }
+
+ private:
+  // Returns the sum of the measurements of --num_repeats runs.
+  ScanResult runConfig(const ReadPathConfig& config) {
+    registerHiveConnector(config);
+    if (config.cacheMode == CacheMode::kWarm) {
+      cache_->testingClear();
+      runScan(config);
+    }
+    ScanResult total;
+    for (auto i = 0; i < FLAGS_num_repeats; ++i) {
+      if (config.cacheMode == CacheMode::kCold) {
+        cache_->testingClear();
+      }
+      total.add(runScan(config));
+    }
+    return total;
+  }
+
+  // Replaces the Hive connector with one that has the coalescing and
+  // prefetch settings of 'config'. The new connector also has a new file
+  // handle cache, so the files are opened again.
+  void registerHiveConnector(const ReadPathConfig& config) {
+    std::unordered_map<std::string, std::string> values;
+    values[connector::hive::HiveConfig::kMaxCoalescedBytes] =
+        std::to_string(FLAGS_max_coalesced_mb << 20);
+    values[connector::hive::HiveConfig::kMaxCoalescedDistanceBytes] =
+        std::to_string(config.coalesceDistanceKB << 10);
+    values[connector::hive::HiveConfig::kPrefetchRowGroups] =
+        std::to_string(config.prefetchRowGroups);
+    connector::unregisterConnector(kHiveConnectorId);
+    connector::registerConnector(
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId,
+                std::make_shared<const core::MemConfig>(std::move(values)),
+                ioExecutor_.get()));
+  }
+
+  ScanResult runScan(const ReadPathConfig& config) {
+    core::PlanNodeId scanId;
+    CursorParameters params;
+    params.planNode =
+        PlanBuilder().tableScan(rowType_).capturePlanNodeId(scanId).planNode();
+    params.maxDrivers = FLAGS_num_drivers;
+    params.copyResult = false;
+    params.queryCtx = core::QueryCtx::create(
+        executor_.get(),
+        core::QueryConfig({}),
+        {},
+        config.cacheMode == CacheMode::kOff ? nullptr : cache_.get());
+    params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
+        std::to_string(config.splitPreload);
+
+    storage_->resetStats();
+    ScanResult result;
+    const auto startUs = getCurrentTimeMicro();
+    auto cursor = TaskCursor::create(params);
+    auto* task = cursor->task().get();
+    for (const auto& file : dataFiles_) {
+      for (const auto& split : HiveConnectorTestBase::makeHiveConnectorSplits(
+               file, FLAGS_num_splits_per_file, format_)) {
+        task->addSplit(scanId, Split(split));
+      }
+    }
+    task->noMoreSplits(scanId);
+    while (cursor->moveNext()) {
+      if (result.numRows == 0) {
+        result.firstBatchUs = getCurrentTimeMicro() - startUs;
+      }
+      result.numRows += cursor->current()->size();
+    }
+    VELOX_CHECK(waitForTaskCompletion(task));
+    result.totalUs = getCurrentTimeMicro() - startUs;
+    result.storage = storage_->stats();
+
+    const auto stats = toPlanStats(task->taskStats()).at(scanId);
+    result.rawInputBytes = stats.rawInputBytes;
+    auto it = stats.customStats.find("ioWaitWallNanos");
+    if (it != stats.customStats.end()) {
+      result.ioWaitNanos = it->second.sum;
+    }
+    return result;
+  }
+
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<LatencyInjectingModel> storage_;
+  dwio::common::FileFormat format_;
+  std::vector<std::string> dataFiles_;
+  RowTypePtr rowType_;
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string kUsage(
+      "Scans data files with simulated remote storage latency and throughput "
+      "and reports the time to the first batch, the total time and the "
+      "number of storage requests for each combination of read path "
+      "settings.\n");
+  gflags::SetUsageMessage(kUsage);
+  folly::Init init{&argc, &argv, false};
+  VELOX_USER_CHECK(!FLAGS_data_path.empty(), "--data_path is required");
+
+  ScanLatencyBenchmark benchmark;
+  benchmark.initialize();
+  benchmark.run();
+  benchmark.shutdown();
+  return 0;
+}
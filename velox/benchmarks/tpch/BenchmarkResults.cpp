@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/benchmarks/tpch/BenchmarkResults.h"
+
+#include <folly/String.h>
+
+#include <cmath>
+#include <numeric>
+#include <optional>
+
+namespace facebook::velox {
+
+namespace {
+constexpr int64_t kVersion = 1;
+
+// Two sided critical values of Student's t distribution for 1 to 30 degrees
+// of freedom.
+constexpr std::array<double, 30> kT95 = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+constexpr std::array<double, 30> kT99 = {
+    63.657, 9.925, 5.841, 4.604, 4.032, 3.707, 3.499, 3.355, 3.250, 3.169,
+    3.106,  3.055, 3.012, 2.977, 2.947, 2.921, 2.898, 2.878, 2.861, 2.845,
+    2.831,  2.819, 2.807, 2.797, 2.787, 2.779, 2.771, 2.763, 2.756, 2.750};
+
+double criticalT(double confidence, double degreesOfFreedom) {
+  VELOX_CHECK(
+      confidence == 0.95 || confidence == 0.99,
+      "Unsupported confidence level: {}",
+      confidence);
+  const auto& table = confidence == 0.95 ? kT95 : kT99;
+  // Rounding the degrees of freedom down is conservative.
+  const auto df = static_cast<int64_t>(std::floor(degreesOfFreedom));
+  if (df < 1) {
+    return table[0];
+  }
+  if (df > static_cast<int64_t>(table.size())) {
+    return confidence == 0.95 ? 1.960 : 2.576;
+  }
+  return table[df - 1];
+}
+
+std::string operatorTypes(const exec::PlanNodeStats& stats) {
+  std::vector<std::string> types;
+  types.reserve(stats.operatorStats.size());
+  for (const auto& [type, _] : stats.operatorStats) {
+    types.push_back(type);
+  }
+  std::sort(types.begin(), types.end());
+  return folly::join(",", types);
+}
+
+// Returns the regression of 'metric' if it increased significantly from
+// 'baseline' to 'candidate'.
+std::optional<Regression> checkMetric(
+    const std::string& location,
+    const std::string& metric,
+    const folly::dynamic& baseline,
+    const folly::dynamic& candidate,
+    const CompareOptions& options) {
+  if (!baseline.isObject() || !candidate.isObject()) {
+    return std::nullopt;
+  }
+  auto before = MetricSummary::fromJson(baseline);
+  auto after = MetricSummary::fromJson(candidate);
+  if (after.mean <= before.mean) {
+    return std::nullopt;
+  }
+  const double changePct = before.mean == 0
+      ? std::numeric_limits<double>::infinity()
+      : 100 * (after.mean - before.mean) / before.mean;
+  if (changePct < options.minChangePct) {
+    return std::nullopt;
+  }
+
+  double t = 0;
+  if (before.count >= 2 && after.count >= 2) {
+    // Welch's t-test with the Welch-Satterthwaite degrees of freedom.
+    const double beforeVar = before.stddev * before.stddev / before.count;
+    const double afterVar = after.stddev * after.stddev / after.count;
+    const double stderror = std::sqrt(beforeVar + afterVar);
+    if (stderror == 0) {
+      t = std::numeric_limits<double>::infinity();
+    } else {
+      t = (after.mean - before.mean) / stderror;
+      const double df = (beforeVar + afterVar) * (beforeVar + afterVar) /
+          (beforeVar * beforeVar / (before.count - 1) +
+           afterVar * afterVar / (after.count - 1));
+      if (t < criticalT(options.confidence, df)) {
+        return std::nullopt;
+      }
+    }
+  }
+  return Regression{location, metric, before, after, changePct, t};
+}
+} // namespace
+
+double MetricSamples::mean() const {
+  if (values.empty()) {
+    return 0;
+  }
+  return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+double MetricSamples::stddev() const {
+  if (values.size() < 2) {
+    return 0;
+  }
+  const auto average = mean();
+  double sumSquares = 0;
+  for (auto value : values) {
+    sumSquares += (value - average) * (value - average);
+  }
+  return std::sqrt(sumSquares / (values.size() - 1));
+}
+
+folly::dynamic MetricSamples::toJson() const {
+  folly::dynamic json = folly::dynamic::object;
+  json["mean"] = mean();
+  json["stddev"] = stddev();
+  json["min"] =
+      values.empty() ? 0 : *std::min_element(values.begin(), values.end());
+  json["max"] =
+      values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+  json["count"] = static_cast<int64_t>(values.size());
+  return json;
+}
+
+// static
+MetricSummary MetricSummary::fromJson(const folly::dynamic& json) {
+  MetricSummary summary;
+  summary.mean = json["mean"].asDouble();
+  summary.stddev = json["stddev"].asDouble();
+  summary.count = json["count"].asInt();
+  return summary;
+}
+
+void BenchmarkResults::addRun(
+    const std::string& query,
+    const exec::TaskStats& taskStats,
+    uint64_t wallNanos,
+    uint64_t peakMemoryBytes) {
+  auto& samples = queries_[query];
+  samples.wallNanos.add(wallNanos);
+  samples.peakMemoryBytes.add(peakMemoryBytes);
+
+  uint64_t cpuNanos = 0;
+  for (const auto& [id, stats] : exec::toPlanStats(taskStats)) {
+    const uint64_t nodeCpuNanos =
+        stats.cpuWallTiming.cpuNanos + stats.backgroundTiming.cpuNanos;
+    cpuNanos += nodeCpuNanos;
+
+    auto& node = samples.planNodes[id];
+    node.operatorType = operatorTypes(stats);
+    node.cpuNanos.add(nodeCpuNanos);
+    node.inputRows.add(stats.inputRows);
+    node.outputRows.add(stats.outputRows);
+    node.spilledBytes.add(stats.spilledBytes);
+  }
+  samples.cpuNanos.add(cpuNanos);
+}
+
+folly::dynamic BenchmarkResults::toJson() const {
+  folly::dynamic context = folly::dynamic::object;
+  for (const auto& [key, value] : context_) {
+    context[key] = value;
+  }
+
+  folly::dynamic queries = folly::dynamic::object;
+  for (const auto& [query, samples] : queries_) {
+    folly::dynamic planNodes = folly::dynamic::object;
+    for (const auto& [id, node] : samples.planNodes) {
+      folly::dynamic nodeJson = folly::dynamic::object;
+      nodeJson["operatorType"] = node.operatorType;
+      nodeJson["cpuNanos"] = node.cpuNanos.toJson();
+      nodeJson["inputRows"] = node.inputRows.toJson();
+      nodeJson["outputRows"] = node.outputRows.toJson();
+      nodeJson["spilledBytes"] = node.spilledBytes.toJson();
+      planNodes[id] = std::move(nodeJson);
+    }
+
+    folly::dynamic queryJson = folly::dynamic::object;
+    queryJson["wallNanos"] = samples.wallNanos.toJson();
+    queryJson["cpuNanos"] = samples.cpuNanos.toJson();
+    queryJson["peakMemoryBytes"] = samples.peakMemoryBytes.toJson();
+    queryJson["planNodes"] = std::move(planNodes);
+    queries[query] = std::move(queryJson);
+  }
+
+  folly::dynamic json = folly::dynamic::object;
+  json["version"] = kVersion;
+  json["context"] = std::move(context);
+  json["queries"] = std::move(queries);
+  return json;
+}
+
+std::string Regression::toString() const {
+  return fmt::format(
+      "{} {}: {:.0f} -> {:.0f} (+{:.1f}%, stddev {:.0f} -> {:.0f}, "
+      "runs {} -> {}, t {:.2f})",
+      location,
+      metric,
+      baseline.mean,
+      candidate.mean,
+      changePct,
+      baseline.stddev,
+      candidate.stddev,
+      baseline.count,
+      candidate.count,
+      t);
+}
+
+std::vector<Regression> compareBenchmarkResults(
+    const folly::dynamic& baseline,
+    const folly::dynamic& candidate,
+    const CompareOptions& options) {
+  VELOX_CHECK_EQ(baseline["version"].asInt(), kVersion);
+  VELOX_CHECK_EQ(candidate["version"].asInt(), kVersion);
+
+  std::vector<Regression> regressions;
+  auto check = [&](const std::string& location,
+                   const std::string& metric,
+                   const folly::dynamic& before,
+                   const folly::dynamic& after) {
+    if (auto regression = checkMetric(
+            location,
+            metric,
+            before.getDefault(metric),
+            after.getDefault(metric),
+            options)) {
+      regressions.push_back(std::move(regression.value()));
+    }
+  };
+
+  const auto& candidateQueries = candidate["queries"];
+  for (const auto& [queryName, before] : baseline["queries"].items()) {
+    const auto* after = candidateQueries.get_ptr(queryName);
+    if (after == nullptr) {
+      continue;
+    }
+    const auto query = queryName.asString();
+    for (const auto* metric : {"wallNanos", "cpuNanos", "peakMemoryBytes"}) {
+      check(query, metric, before, *after);
+    }
+
+    const auto& afterNodes = (*after)["planNodes"];
+    for (const auto& [id, beforeNode] : before["planNodes"].items()) {
+      const auto* afterNode = afterNodes.get_ptr(id);
+      if (afterNode == nullptr ||
+          (*afterNode)["operatorType"] != beforeNode["operatorType"]) {
+        continue;
+      }
+      const auto location = fmt::format(
+          "{}/node {} ({})",
+          query,
+          id.asString(),
+          beforeNode["operatorType"].asString());
+      for (const auto* metric : {"cpuNanos", "spilledBytes"}) {
+        check(location, metric, beforeNode, *afterNode);
+      }
+    }
+  }
+  return regressions;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/json.h>
+
+#include "velox/exec/PlanNodeStats.h"
+
+namespace facebook::velox {
+
+/// Values of one metric over the repeated runs of a query.
+struct MetricSamples {
+  std::vector<double> values;
+
+  void add(double value) {
+    values.push_back(value);
+  }
+
+  double mean() const;
+
+  /// Sample standard deviation. 0 for less than 2 values.
+  double stddev() const;
+
+  /// {"mean", "stddev", "min", "max", "count"}.
+  folly::dynamic toJson() const;
+};
+
+/// Summary of a metric as read back from a results file.
+struct MetricSummary {
+  double mean{0};
+  double stddev{0};
+  int64_t count{0};
+
+  static MetricSummary fromJson(const folly::dynamic& json);
+};
+
+/// Collects per-query and per-plan-node metrics of repeated benchmark runs and
+/// writes them as JSON. The file has the form:
+///
+///  {"version": 1,
+///   "context": {<flag>: <value>, ...},
+///   "queries": {
+///     <query>: {
+///       "wallNanos": <metric>, "cpuNanos": <metric>,
+///       "peakMemoryBytes": <metric>,
+///       "planNodes": {
+///         <plan node id>: {
+///           "operatorType": "HashBuild,HashProbe",
+///           "cpuNanos": <metric>, "inputRows": <metric>,
+///           "outputRows": <metric>, "spilledBytes": <metric>}}}}}
+///
+/// where <metric> is MetricSamples::toJson(). Plan node ids are assigned
+/// deterministically by the query builders, so the same id denotes the same
+/// node in results of different builds as long as the plan is unchanged.
+class BenchmarkResults {
+ public:
+  /// Adds 'value' as information on the run environment, e.g. a flag.
+  void addContext(const std::string& key, const std::string& value) {
+    context_[key] = value;
+  }
+
+  /// Records one run of 'query'. 'wallNanos' is the execution time of the
+  /// task, 'peakMemoryBytes' the peak memory of its pool.
+  void addRun(
+      const std::string& query,
+      const exec::TaskStats& taskStats,
+      uint64_t wallNanos,
+      uint64_t peakMemoryBytes);
+
+  folly::dynamic toJson() const;
+
+ private:
+  struct PlanNodeSamples {
+    std::string operatorType;
+    MetricSamples cpuNanos;
+    MetricSamples inputRows;
+    MetricSamples outputRows;
+    MetricSamples spilledBytes;
+  };
+
+  struct QuerySamples {
+    MetricSamples wallNanos;
+    MetricSamples cpuNanos;
+    MetricSamples peakMemoryBytes;
+    std::map<core::PlanNodeId, PlanNodeSamples> planNodes;
+  };
+
+  std::map<std::string, std::string> context_;
+  std::map<std::string, QuerySamples> queries_;
+};
+
+struct CompareOptions {
+  /// Changes smaller than this are not reported even if significant.
+  double minChangePct{5};
+
+  /// Critical value of the two sided Welch t-test is taken for this
+  /// confidence level. Supported levels are 0.95 and 0.99.
+  double confidence{0.95};
+};
+
+/// A metric that got worse between two results files.
+struct Regression {
+  /// E.g. "q3" or "q3/node 5 (HashBuild,HashProbe)".
+  std::string location;
+  std::string metric;
+  MetricSummary baseline;
+  MetricSummary candidate;
+  double changePct;
+
+  /// Welch t statistic. 0 if either side has less than 2 runs, in which case
+  /// only 'changePct' is tested.
+  double t;
+
+  std::string toString() const;
+};
+
+/// Compares the time and memory metrics of the queries and plan nodes present
+/// in both 'baseline' and 'candidate', as produced by
+/// BenchmarkResults::toJson(), and returns the ones that increased
+/// significantly. Plan nodes are compared only if their operator types match.
+std::vector<Regression> compareBenchmarkResults(
+    const folly::dynamic& baseline,
+    const folly::dynamic& candidate,
+    const CompareOptions& options = {});
+
+} // namespace facebook::velox
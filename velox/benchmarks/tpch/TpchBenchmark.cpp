@@ -25,6 +25,7 @@
 #include <sys/types.h>
 #include <fstream>
 
+#include "velox/benchmarks/tpch/BenchmarkResults.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/memory/MmapAllocator.h"
@@ -34,6 +35,7 @@
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
 #include "velox/exec/tests/utils/TpchQueryBuilder.h"
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -99,8 +101,14 @@ DEFINE_string(
     "If the above are directories, they contain the data files for "
     "each table. If they are files, they contain a file system path for each "
     "data file, one per line. This allows running against cloud storage or "
-    "HDFS");
+    "HDFS. With -tpcds the directories are the TPC-DS tables, e.g. "
+    "store_sales, item and date_dim");
 
+DEFINE_bool(
+    tpcds,
+    false,
+    "Run the TPC-DS queries of TpcdsQueryBuilder instead of the TPC-H "
+    "queries. The benchmarks are named tpcds_q<N>");
 DEFINE_int32(
     run_query_verbose,
     -1,
@@ -184,6 +192,15 @@ DEFINE_int32(
 
 DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
 
+DEFINE_string(
+    json_output,
+    "",
+    "If set, runs each query, or only --run_query_verbose if given, "
+    "--num_repeats times and writes per-query wall time, CPU time and peak "
+    "memory and per-plan-node CPU time, rows and spilled bytes with their "
+    "variance to this file as JSON. Compare two such files with "
+    "velox_tpch_benchmark_compare");
+
 struct RunStats {
   std::map<std::string, std::string> flags;
   int64_t micros{0};
@@ -215,7 +232,10 @@ struct ParameterDim {
   std::vector<std::string> values;
 };
 
+DECLARE_string(bm_regex);
+
 std::shared_ptr<TpchQueryBuilder> queryBuilder;
+std::shared_ptr<TpcdsQueryBuilder> tpcdsQueryBuilder;
 
 class TpchBenchmark {
  public:
@@ -285,32 +305,7 @@ class TpchBenchmark {
     int32_t repeat = 0;
     try {
       for (;;) {
-        CursorParameters params;
-        params.maxDrivers = FLAGS_num_drivers;
-        params.planNode = tpchPlan.plan;
-        params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
-            std::to_string(FLAGS_split_preload_per_driver);
-        const int numSplitsPerFile = FLAGS_num_splits_per_file;
-
-        bool noMoreSplits = false;
-        auto addSplits = [&](exec::Task* task) {
-          if (!noMoreSplits) {
-            for (const auto& entry : tpchPlan.dataFiles) {
-              for (const auto& path : entry.second) {
-                auto const splits =
-                    HiveConnectorTestBase::makeHiveConnectorSplits(
-                        path, numSplitsPerFile, tpchPlan.dataFileFormat);
-                for (const auto& split : splits) {
-                  task->addSplit(entry.first, exec::Split(split));
-                }
-              }
-              task->noMoreSplits(entry.first);
-            }
-          }
-          noMoreSplits = true;
-        };
-        auto result = readCursor(params, addSplits);
-        ensureTaskCompletion(result.first->task().get());
+        auto result = runOnce(tpchPlan);
         if (++repeat >= FLAGS_num_repeats) {
           return result;
         }
@@ -321,12 +316,44 @@ class TpchBenchmark {
     }
   }
 
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> runOnce(
+      const TpchPlan& tpchPlan) {
+    CursorParameters params;
+    params.maxDrivers = FLAGS_num_drivers;
+    params.planNode = tpchPlan.plan;
+    params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
+        std::to_string(FLAGS_split_preload_per_driver);
+    const int numSplitsPerFile = FLAGS_num_splits_per_file;
+
+    bool noMoreSplits = false;
+    auto addSplits = [&](exec::Task* task) {
+      if (!noMoreSplits) {
+        for (const auto& entry : tpchPlan.dataFiles) {
+          for (const auto& path : entry.second) {
+            auto const splits = HiveConnectorTestBase::makeHiveConnectorSplits(
+                path, numSplitsPerFile, tpchPlan.dataFileFormat);
+            for (const auto& split : splits) {
+              task->addSplit(entry.first, exec::Split(split));
+            }
+          }
+          task->noMoreSplits(entry.first);
+        }
+      }
+      noMoreSplits = true;
+    };
+    auto result = readCursor(params, addSplits);
+    ensureTaskCompletion(result.first->task().get());
+    return result;
+  }
+
   void runMain(std::ostream& out, RunStats& runStats) {
     if (FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
       folly::runBenchmarks();
     } else {
       const auto queryPlan = FLAGS_io_meter_column_pct > 0
           ? queryBuilder->getIoMeterPlan(FLAGS_io_meter_column_pct)
+          : FLAGS_tpcds
+          ? tpcdsQueryBuilder->getQueryPlan(FLAGS_run_query_verbose)
           : queryBuilder->getQueryPlan(FLAGS_run_query_verbose);
       auto [cursor, actualResults] = run(queryPlan);
       if (!cursor) {
@@ -364,6 +391,59 @@ class TpchBenchmark {
     }
   }
 
+  // Runs the queries --num_repeats times each and writes their stats to
+  // --json_output.
+  void runJson() {
+    std::vector<int> queryIds;
+    if (FLAGS_run_query_verbose != -1) {
+      queryIds.push_back(FLAGS_run_query_verbose);
+    } else if (FLAGS_tpcds) {
+      queryIds = TpcdsQueryBuilder::getQueryIds();
+    } else {
+      for (auto i = 1; i <= 22; ++i) {
+        queryIds.push_back(i);
+      }
+    }
+
+    BenchmarkResults results;
+    for (const auto* flag :
+         {"data_path",
+          "data_format",
+          "num_drivers",
+          "num_splits_per_file",
+          "num_repeats",
+          "cache_gb",
+          "ssd_cache_gb"}) {
+      std::string value;
+      gflags::GetCommandLineOption(flag, &value);
+      results.addContext(flag, value);
+    }
+
+    for (const auto queryId : queryIds) {
+      const auto queryName =
+          fmt::format("{}q{}", FLAGS_tpcds ? "tpcds_" : "", queryId);
+      const auto queryPlan = FLAGS_tpcds
+          ? tpcdsQueryBuilder->getQueryPlan(queryId)
+          : queryBuilder->getQueryPlan(queryId);
+      for (auto repeat = 0; repeat < FLAGS_num_repeats; ++repeat) {
+        auto [cursor, ignore] = runOnce(queryPlan);
+        const auto task = cursor->task();
+        const auto stats = task->taskStats();
+        results.addRun(
+            queryName,
+            stats,
+            (stats.executionEndTimeMs - stats.executionStartTimeMs) * 1'000'000,
+            task->pool()->peakBytes());
+      }
+      LOG(INFO) << "Ran " << queryName << " " << FLAGS_num_repeats
+                << " times";
+    }
+
+    std::ofstream out(FLAGS_json_output);
+    VELOX_CHECK(out.good(), "Cannot open {}", FLAGS_json_output);
+    out << folly::toPrettyJson(results.toJson()) << std::endl;
+  }
+
   void readCombinations() {
     std::ifstream file(FLAGS_test_flags_file);
     std::string line;
@@ -506,6 +586,11 @@ BENCHMARK(q3) {
   benchmark.run(planContext);
 }
 
+BENCHMARK(q4) {
+  const auto planContext = queryBuilder->getQueryPlan(4);
+  benchmark.run(planContext);
+}
+
 BENCHMARK(q5) {
   const auto planContext = queryBuilder->getQueryPlan(5);
   benchmark.run(planContext);
@@ -596,12 +681,40 @@ BENCHMARK(q22) {
   benchmark.run(planContext);
 }
 
+namespace {
+// Registers a benchmark per TPC-DS query and selects only these since the
+// TPC-H benchmarks have no data to run on.
+void addTpcdsBenchmarks() {
+  for (const auto queryId : TpcdsQueryBuilder::getQueryIds()) {
+    folly::addBenchmark(
+        __FILE__, fmt::format("tpcds_q{}", queryId), [queryId]() {
+          benchmark.run(tpcdsQueryBuilder->getQueryPlan(queryId));
+          return 1;
+        });
+  }
+  if (FLAGS_bm_regex.empty()) {
+    FLAGS_bm_regex = "^tpcds_";
+  }
+}
+} // namespace
+
 int tpchBenchmarkMain() {
   benchmark.initialize();
-  queryBuilder =
-      std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
-  queryBuilder->initialize(FLAGS_data_path);
-  if (FLAGS_test_flags_file.empty()) {
+  if (FLAGS_tpcds) {
+    VELOX_CHECK_EQ(
+        FLAGS_io_meter_column_pct, 0, "IO meter query is TPC-H only");
+    tpcdsQueryBuilder =
+        std::make_shared<TpcdsQueryBuilder>(toFileFormat(FLAGS_data_format));
+    tpcdsQueryBuilder->initialize(FLAGS_data_path);
+    addTpcdsBenchmarks();
+  } else {
+    queryBuilder =
+        std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
+    queryBuilder->initialize(FLAGS_data_path);
+  }
+  if (!FLAGS_json_output.empty()) {
+    benchmark.runJson();
+  } else if (FLAGS_test_flags_file.empty()) {
     RunStats ignore;
     benchmark.runMain(std::cout, ignore);
   } else {
@@ -609,5 +722,6 @@ int tpchBenchmarkMain() {
   }
   benchmark.shutdown();
   queryBuilder.reset();
+  tpcdsQueryBuilder.reset();
   return 0;
 }
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/FileUtil.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <iostream>
+
+#include "velox/benchmarks/tpch/BenchmarkResults.h"
+
+DEFINE_string(baseline, "", "Results file of the baseline build");
+DEFINE_string(candidate, "", "Results file of the build to check");
+DEFINE_double(
+    min_change_pct,
+    5,
+    "Increases of a metric by less than this percentage are not reported");
+DEFINE_double(
+    confidence,
+    0.95,
+    "Confidence level of the Welch t-test that decides whether an increase "
+    "is significant. 0.95 or 0.99");
+
+using namespace facebook::velox;
+
+namespace {
+folly::dynamic readResults(const std::string& path) {
+  std::string text;
+  VELOX_CHECK(folly::readFile(path.c_str(), text), "Cannot read {}", path);
+  return folly::parseJson(text);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string kUsage(
+      "Compares two result files written by velox_tpch_benchmark "
+      "--json_output and lists the metrics that increased significantly. "
+      "Exits with 1 if there are any.\n");
+  gflags::SetUsageMessage(kUsage);
+  folly::Init init{&argc, &argv, false};
+  VELOX_USER_CHECK(
+      !FLAGS_baseline.empty() && !FLAGS_candidate.empty(),
+      "--baseline and --candidate are required");
+
+  CompareOptions options;
+  options.minChangePct = FLAGS_min_change_pct;
+  options.confidence = FLAGS_confidence;
+  const auto regressions = compareBenchmarkResults(
+      readResults(FLAGS_baseline), readResults(FLAGS_candidate), options);
+  for (const auto& regression : regressions) {
+    std::cout << regression.toString() << std::endl;
+  }
+  std::cout << regressions.size() << " regressions" << std::endl;
+  return regressions.empty() ? 0 : 1;
+}
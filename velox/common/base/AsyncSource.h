@@ -21,6 +21,7 @@
 #include <folly/futures/Future.h>
 #include <functional>
 #include <memory>
+#include <vector>
 #include "velox/common/time/CpuWallTimer.h"
 
 #include "velox/common/base/Exceptions.h"
@@ -88,6 +89,7 @@ class AsyncSource {
       exception_ = std::current_exception();
     }
     std::unique_ptr<ContinuePromise> promise;
+    std::vector<ContinuePromise> makingPromises;
     {
       std::lock_guard<std::mutex> l(mutex_);
       VELOX_CHECK_NULL(item_);
@@ -96,10 +98,27 @@ class AsyncSource {
       }
       making_ = false;
       promise.swap(promise_);
+      makingPromises.swap(makingPromises_);
     }
     if (promise != nullptr) {
       promise->setValue();
     }
+    for (auto& makingPromise : makingPromises) {
+      makingPromise.setValue();
+    }
+  }
+
+  /// Returns true if prepare() is making the item on another thread, so that
+  /// move() would wait for it. Sets 'future' to be realized when the item is
+  /// made. Lets a caller that must not block wait asynchronously.
+  bool isMaking(ContinueFuture& future) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!making_) {
+      return false;
+    }
+    makingPromises_.emplace_back("AsyncSource::isMaking");
+    future = makingPromises_.back().getSemiFuture();
+    return true;
   }
 
   // Returns the item to the first caller and nullptr to subsequent callers.
@@ -221,6 +240,8 @@ class AsyncSource {
   // True if 'prepare() is making the item.
   bool making_{false};
   std::unique_ptr<ContinuePromise> promise_;
+  // Promises of isMaking() callers, realized when prepare() is done.
+  std::vector<ContinuePromise> makingPromises_;
   std::unique_ptr<Item> item_;
   std::function<std::unique_ptr<Item>()> make_;
   std::exception_ptr exception_;
@@ -55,12 +55,42 @@ class BloomFilter {
     set(bits_.data(), bits_.size(), value);
   }
 
+  // Adds 'size' hashed values. Prefetches the words of the values a few
+  // positions ahead, which overlaps the cache misses on filters that do not
+  // fit in cache.
+  void insert(const uint64_t* values, int32_t size) {
+    auto* bloom = bits_.data();
+    const int32_t bloomSize = bits_.size();
+    for (auto i = 0; i < size; ++i) {
+      if (i + kPrefetchDistance < size) {
+        __builtin_prefetch(
+            bloom + bloomIndex(bloomSize, values[i + kPrefetchDistance]));
+      }
+      set(bloom, bloomSize, values[i]);
+    }
+  }
+
   // Input is hashed uint64_t value, optional hash function is
   // folly::hasher<InputType>()(value).
   bool mayContain(uint64_t value) const {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Sets bit 'i' of 'result' to mayContain(values[i]) for 'size' hashed
+  // values. Prefetches like insert() above.
+  void mayContain(const uint64_t* values, int32_t size, uint64_t* result)
+      const {
+    const auto* bloom = bits_.data();
+    const int32_t bloomSize = bits_.size();
+    for (auto i = 0; i < size; ++i) {
+      if (i + kPrefetchDistance < size) {
+        __builtin_prefetch(
+            bloom + bloomIndex(bloomSize, values[i + kPrefetchDistance]));
+      }
+      bits::setBit(result, i, test(bloom, bloomSize, values[i]));
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -127,6 +157,10 @@ class BloomFilter {
     return mask == (bloom[index] & mask);
   }
 
+  // Number of values ahead of the current one whose words are prefetched in
+  // the batch insert() and mayContain().
+  static constexpr int32_t kPrefetchDistance = 8;
+
   const int8_t kBloomFilterV1 = 1;
   std::vector<uint64_t, Allocator> bits_;
 };
@@ -347,6 +347,12 @@ void registerVeloxMetrics() {
       kMetricArbitratorSlowGlobalArbitrationCount,
       facebook::velox::StatType::COUNT);
 
+  // The number of times the arbitrator reclaims memory by spilling ahead of
+  // time as the memory usage is forecast to exceed the soft watermark.
+  DEFINE_METRIC(
+      kMetricArbitratorProactiveReclaimCount,
+      facebook::velox::StatType::COUNT);
+
   // The distribution of the amount of time an arbitration operation stays in
   // arbitration queues and waits the arbitration r/w locks in range of [0,
   // 600s] with 20 buckets. It is configured to report the latency at P50, P90,
@@ -82,6 +82,9 @@ constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationCount{
 constexpr folly::StringPiece kMetricArbitratorSlowGlobalArbitrationCount{
     "velox.arbitrator_slow_global_arbitration_count"};
 
+constexpr folly::StringPiece kMetricArbitratorProactiveReclaimCount{
+    "velox.arbitrator_proactive_reclaim_count"};
+
 constexpr folly::StringPiece kMetricArbitratorAbortedCount{
     "velox.arbitrator_aborted_count"};
 
@@ -313,4 +316,10 @@ constexpr folly::StringPiece kMetricStorageLocalThrottled{
 
 constexpr folly::StringPiece kMetricStorageGlobalThrottled{
     "velox.storage_global_throttled_count"};
+
+constexpr folly::StringPiece kMetricStorageReadLatencyUs{
+    "velox.storage_read_latency_us"};
+
+constexpr folly::StringPiece kMetricSsdCacheReadLatencyUs{
+    "velox.ssd_cache_read_latency_us"};
 } // namespace facebook::velox
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+namespace {
+std::mutex& registryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// The histograms by name. Must be accessed while holding registryMutex().
+std::map<std::string, std::unique_ptr<LatencyHistogram>>& registry() {
+  static std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms;
+  return histograms;
+}
+} // namespace
+
+// static
+LatencyHistogram* LatencyHistogram::get(const std::string& name) {
+  std::lock_guard<std::mutex> l(registryMutex());
+  auto& histogram = registry()[name];
+  if (histogram == nullptr) {
+    histogram = std::make_unique<LatencyHistogram>();
+  }
+  return histogram.get();
+}
+
+// static
+std::vector<std::pair<std::string, LatencyHistogram*>>
+LatencyHistogram::all() {
+  std::lock_guard<std::mutex> l(registryMutex());
+  std::vector<std::pair<std::string, LatencyHistogram*>> histograms;
+  for (const auto& [name, histogram] : registry()) {
+    histograms.emplace_back(name, histogram.get());
+  }
+  return histograms;
+}
+
+// static
+int32_t LatencyHistogram::shardIndex() {
+  static std::atomic<int32_t> numThreads{0};
+  thread_local const int32_t index =
+      numThreads.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return index;
+}
+
+std::vector<uint64_t> LatencyHistogram::counts() const {
+  std::vector<uint64_t> counts(kNumBuckets);
+  for (auto shard = 0; shard < kNumShards; ++shard) {
+    for (auto i = 0; i < kNumBuckets; ++i) {
+      counts[i] += shards_[shard][i].load(std::memory_order_relaxed);
+    }
+  }
+  return counts;
+}
+
+void LatencyHistogram::testingClear() {
+  for (auto shard = 0; shard < kNumShards; ++shard) {
+    for (auto& count : shards_[shard]) {
+      count = 0;
+    }
+  }
+}
+
+// static
+uint64_t LatencyHistogram::bucketUpperBound(int32_t bucket) {
+  VELOX_DCHECK_LT(bucket, kNumBuckets);
+  if (bucket < (1 << kSubBucketBits)) {
+    return bucket;
+  }
+  const int32_t shift = (bucket >> kSubBucketBits) - 1;
+  const uint64_t subBucket = bucket & ((1 << kSubBucketBits) - 1);
+  const uint64_t lowerBound = ((1 << kSubBucketBits) + subBucket) << shift;
+  return lowerBound + (1UL << shift) - 1;
+}
+
+// static
+uint64_t LatencyHistogram::percentile(
+    const std::vector<uint64_t>& counts,
+    double pct) {
+  VELOX_CHECK_EQ(counts.size(), kNumBuckets);
+  uint64_t total = 0;
+  for (auto count : counts) {
+    total += count;
+  }
+  if (total == 0) {
+    return 0;
+  }
+  // The rank of the value at 'pct', counting from 1.
+  const auto rank = std::max<uint64_t>(1, std::ceil(total * pct / 100));
+  uint64_t numValues = 0;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    numValues += counts[i];
+    if (numValues >= rank) {
+      return bucketUpperBound(i);
+    }
+  }
+  return bucketUpperBound(kNumBuckets - 1);
+}
+
+} // namespace facebook::velox
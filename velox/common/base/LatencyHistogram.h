@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::velox {
+
+/// Histogram of latencies in microseconds for hot paths like storage and SSD
+/// cache reads, where calling the StatsReporter for each event costs too
+/// much. Recording a value is a relaxed atomic increment of a counter in a
+/// shard picked by the recording thread, so that threads recording at the
+/// same time rarely share cache lines. PeriodicStatsReporter reports the
+/// percentiles of the values recorded since its last report.
+///
+/// The buckets are log-linear: values below 8 have one bucket each and each
+/// larger power of two is split into 8 buckets, so the bucket bounds are
+/// within 12.5% of the values in the bucket. Values above 2^36us (about 19
+/// hours) go to the last bucket.
+class LatencyHistogram {
+ public:
+  static constexpr int32_t kSubBucketBits = 3;
+  static constexpr int32_t kMaxBits = 36;
+  static constexpr int32_t kNumBuckets =
+      (kMaxBits - kSubBucketBits + 1) << kSubBucketBits;
+  static constexpr int32_t kNumShards = 16;
+
+  /// Returns the process-wide histogram with 'name', creating it on first
+  /// use. The histogram lives until the process exits, so callers on hot
+  /// paths keep the pointer.
+  static LatencyHistogram* get(const std::string& name);
+
+  /// Returns the names and histograms created by get().
+  static std::vector<std::pair<std::string, LatencyHistogram*>> all();
+
+  void record(uint64_t micros) {
+    shards_[shardIndex()][bucket(micros)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+
+  /// Returns the number of values recorded in each bucket so far.
+  std::vector<uint64_t> counts() const;
+
+  /// Returns the upper bound of the bucket that contains the 'pct' percentile
+  /// of the values counted in 'counts' or 0 if 'counts' is empty.
+  static uint64_t percentile(const std::vector<uint64_t>& counts, double pct);
+
+  static int32_t bucket(uint64_t micros) {
+    if (micros < (1 << kSubBucketBits)) {
+      return micros;
+    }
+    const int32_t highBit = 63 - __builtin_clzll(micros);
+    if (highBit >= kMaxBits) {
+      return kNumBuckets - 1;
+    }
+    const int32_t subBucket =
+        (micros >> (highBit - kSubBucketBits)) & ((1 << kSubBucketBits) - 1);
+    return ((highBit - kSubBucketBits + 1) << kSubBucketBits) + subBucket;
+  }
+
+  /// Returns the largest value in 'bucket'.
+  static uint64_t bucketUpperBound(int32_t bucket);
+
+  /// Sets the counts of all buckets to 0.
+  void testingClear();
+
+ private:
+  using Shard = std::array<std::atomic<uint64_t>, kNumBuckets>;
+
+  static int32_t shardIndex();
+
+  std::unique_ptr<Shard[]> shards_{std::make_unique<Shard[]>(kNumShards)};
+};
+
+} // namespace facebook::velox
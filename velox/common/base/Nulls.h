@@ -19,6 +19,7 @@
 // Declares constants for null flag polarity.
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox::bits {
 
@@ -52,7 +53,7 @@ inline void setNull(uint64_t* bits, int32_t index, bool isNull) {
 
 inline uint64_t
 countNonNulls(const uint64_t* nulls, int32_t begin, int32_t end) {
-  return countBits(nulls, begin, end);
+  return simd::countBits(nulls, begin, end);
 }
 
 inline uint64_t countNulls(const uint64_t* nulls, int32_t begin, int32_t end) {
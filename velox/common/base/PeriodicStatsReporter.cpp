@@ -16,6 +16,7 @@
 
 #include "velox/common/base/PeriodicStatsReporter.h"
 #include "velox/common/base/Counters.h"
+#include "velox/common/base/LatencyHistogram.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/caching/CacheTTLController.h"
 #include "velox/common/memory/Memory.h"
@@ -84,6 +85,10 @@ void PeriodicStatsReporter::start() {
       "report_spill_stats",
       [this]() { reportSpillStats(); },
       options_.spillStatsIntervalMs);
+  addTask(
+      "report_latency_stats",
+      [this]() { reportLatencyStats(); },
+      options_.latencyStatsIntervalMs);
 }
 
 void PeriodicStatsReporter::stop() {
@@ -252,4 +257,40 @@ void PeriodicStatsReporter::reportSpillStats() {
   RECORD_METRIC_VALUE(kMetricSpillPeakMemoryBytes, spillMemoryStats.peakBytes);
 }
 
+void PeriodicStatsReporter::reportLatencyStats() {
+  static const std::vector<std::pair<std::string, double>> kPercentiles = {
+      {"p50", 50}, {"p99", 99}, {"p999", 99.9}};
+  for (const auto& [name, histogram] : LatencyHistogram::all()) {
+    auto counts = histogram->counts();
+    auto it = lastLatencyCounts_.find(name);
+    if (it == lastLatencyCounts_.end()) {
+      // The histograms are created on first use, so their metrics are
+      // registered when they are first reported.
+      for (const auto& [suffix, pct] : kPercentiles) {
+        DEFINE_METRIC(
+            fmt::format("{}.{}", name, suffix),
+            facebook::velox::StatType::AVG);
+      }
+      it = lastLatencyCounts_
+               .emplace(name, std::vector<uint64_t>(counts.size()))
+               .first;
+    }
+    auto deltaCounts = counts;
+    for (auto i = 0; i < counts.size(); ++i) {
+      deltaCounts[i] -= it->second[i];
+    }
+    it->second = std::move(counts);
+    if (std::all_of(deltaCounts.begin(), deltaCounts.end(), [](auto count) {
+          return count == 0;
+        })) {
+      continue;
+    }
+    for (const auto& [suffix, pct] : kPercentiles) {
+      RECORD_METRIC_VALUE(
+          fmt::format("{}.{}", name, suffix),
+          LatencyHistogram::percentile(deltaCounts, pct));
+    }
+  }
+}
+
 } // namespace facebook::velox
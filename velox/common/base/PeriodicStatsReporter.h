@@ -53,14 +53,19 @@ class PeriodicStatsReporter {
     const memory::MemoryPool* spillMemoryPool{nullptr};
     uint64_t spillStatsIntervalMs{60'000};
 
+    /// The interval of reporting the percentiles of the LatencyHistograms.
+    uint64_t latencyStatsIntervalMs{60'000};
+
     std::string toString() const {
       return fmt::format(
           "allocatorStatsIntervalMs:{}, cacheStatsIntervalMs:{}, "
-          "arbitratorStatsIntervalMs:{}, spillStatsIntervalMs:{}",
+          "arbitratorStatsIntervalMs:{}, spillStatsIntervalMs:{}, "
+          "latencyStatsIntervalMs:{}",
           allocatorStatsIntervalMs,
           cacheStatsIntervalMs,
           arbitratorStatsIntervalMs,
-          spillStatsIntervalMs);
+          spillStatsIntervalMs,
+          latencyStatsIntervalMs);
     }
   };
 
@@ -96,6 +101,11 @@ class PeriodicStatsReporter {
   void reportArbitratorStats();
   void reportSpillStats();
 
+  // Reports the P50, P99 and P999 of the values recorded in each
+  // LatencyHistogram since the last report as '<name>.p50', '<name>.p99' and
+  // '<name>.p999'.
+  void reportLatencyStats();
+
   const velox::memory::MemoryAllocator* const allocator_{nullptr};
   const velox::cache::AsyncDataCache* const cache_{nullptr};
   const velox::memory::MemoryArbitrator* const arbitrator_{nullptr};
@@ -104,6 +114,9 @@ class PeriodicStatsReporter {
 
   cache::CacheStats lastCacheStats_;
 
+  // The bucket counts of each LatencyHistogram at the last report.
+  std::unordered_map<std::string, std::vector<uint64_t>> lastLatencyCounts_;
+
   folly::ThreadedRepeatingFunctionRunner scheduler_;
 };
 
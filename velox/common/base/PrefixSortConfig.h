@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace facebook::velox::common {
+
+/// Specifies the config for prefix-sort.
+struct PrefixSortConfig {
+  PrefixSortConfig() = default;
+
+  PrefixSortConfig(
+      uint32_t _maxNormalizedKeySize,
+      uint32_t _threshold,
+      uint32_t _maxStringPrefixLength = 16)
+      : maxNormalizedKeySize(_maxNormalizedKeySize),
+        threshold(_threshold),
+        maxStringPrefixLength(_maxStringPrefixLength) {}
+
+  /// Max number of bytes can store normalized keys in prefix-sort buffer per
+  /// entry.
+  uint32_t maxNormalizedKeySize{128};
+
+  /// PrefixSort will have performance regression when the dateset is too small.
+  /// The threshold is set to 130 according to the benchmark test results by
+  /// default.
+  int64_t threshold{130};
+
+  /// Number of leading bytes of a VARCHAR or VARBINARY sort key that are
+  /// normalized into the prefix. The rows whose prefixes are equal are
+  /// compared in full. If it is 0, string keys are not normalized.
+  uint32_t maxStringPrefixLength{16};
+};
+} // namespace facebook::velox::common
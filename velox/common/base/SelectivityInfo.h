@@ -24,6 +24,11 @@ namespace velox {
 
 class SelectivityInfo {
  public:
+  SelectivityInfo() = default;
+
+  SelectivityInfo(uint64_t numIn, uint64_t numOut, uint64_t timeClocks)
+      : numIn_(numIn), numOut_(numOut), timeClocks_(timeClocks) {}
+
   void addOutput(uint64_t numOut) {
     numOut_ += numOut;
   }
@@ -35,6 +40,30 @@ class SelectivityInfo {
     return timeClocks_ / static_cast<float>(numIn_ - numOut_);
   }
 
+  /// Returns the clocks spent per row dropped, estimated as the cost per row
+  /// divided by the fraction of rows dropped. The fraction is smoothed so that
+  /// a filter that has not dropped any row yet ranks after a filter of similar
+  /// cost that drops some rows, instead of looking as cheap as its total time
+  /// like in timeToDropValue(). Returns 0 if no row was seen, so that such a
+  /// filter is tried first.
+  float costPerDroppedRow() const {
+    if (numIn_ == 0) {
+      return 0;
+    }
+    const auto clocksPerRow = timeClocks_ / static_cast<float>(numIn_);
+    const auto dropRate =
+        (numIn_ - numOut_ + 1) / static_cast<float>(numIn_ + 1);
+    return clocksPerRow / dropRate;
+  }
+
+  /// Halves the counts and the time so that the recent batches weigh more
+  /// than the old ones. The ratios between them are preserved.
+  void decay() {
+    numIn_ /= 2;
+    numOut_ /= 2;
+    timeClocks_ /= 2;
+  }
+
   bool operator<(const SelectivityInfo& right) const {
     return timeToDropValue() < right.timeToDropValue();
   }
@@ -47,6 +76,10 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  uint64_t timeClocks() const {
+    return timeClocks_;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "velox/common/base/SelectivityInfo.h"
+
+namespace facebook::velox {
+
+/// Filter timing and selectivity shared by all readers of a scan across splits
+/// and drivers, keyed by the path of the filtered column. A reader starts from
+/// the numbers learned so far and adds its own measurements with atomic
+/// increments, so that the filter order converges over many short splits
+/// instead of being learned again for each split.
+class SharedSelectivityInfo {
+ public:
+  /// The numbers of one filtered column.
+  class Entry {
+   public:
+    SelectivityInfo snapshot() const {
+      const auto numIn = numIn_.load(std::memory_order_relaxed);
+      const auto numOut = numOut_.load(std::memory_order_relaxed);
+      // The counters are not updated together, so 'numOut' may be ahead.
+      return SelectivityInfo(
+          numIn,
+          std::min(numIn, numOut),
+          timeClocks_.load(std::memory_order_relaxed));
+    }
+
+    /// Adds the difference between 'current' and 'published', where
+    /// 'published' is the part of 'current' the caller has already added.
+    void add(const SelectivityInfo& current, const SelectivityInfo& published) {
+      numIn_.fetch_add(
+          current.numIn() - published.numIn(), std::memory_order_relaxed);
+      numOut_.fetch_add(
+          current.numOut() - published.numOut(), std::memory_order_relaxed);
+      timeClocks_.fetch_add(
+          current.timeClocks() - published.timeClocks(),
+          std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<uint64_t> numIn_{0};
+    std::atomic<uint64_t> numOut_{0};
+    std::atomic<uint64_t> timeClocks_{0};
+  };
+
+  /// Constructs an instance owned by shared_ptr and referenced from a map from
+  /// 'id' to weak_ptr. 'unregisterer' removes the weak_ptr from the map on
+  /// destruction.
+  SharedSelectivityInfo(
+      std::string_view id,
+      std::function<void(SharedSelectivityInfo*)> unregisterer)
+      : id_(id), unregisterer_(std::move(unregisterer)) {}
+
+  ~SharedSelectivityInfo() {
+    if (unregisterer_) {
+      unregisterer_(this);
+    }
+  }
+
+  const std::string& id() const {
+    return id_;
+  }
+
+  /// Returns the entry for the column at 'path', creating it on first use.
+  /// The entry lives as long as 'this'.
+  Entry* entry(const std::string& path) {
+    return entries_.withWLock([&](auto& entries) {
+      auto& entry = entries[path];
+      if (entry == nullptr) {
+        entry = std::make_unique<Entry>();
+      }
+      return entry.get();
+    });
+  }
+
+ private:
+  const std::string id_;
+  const std::function<void(SharedSelectivityInfo*)> unregisterer_;
+  folly::Synchronized<folly::F14FastMap<std::string, std::unique_ptr<Entry>>>
+      entries_;
+};
+
+} // namespace facebook::velox
@@ -251,6 +251,161 @@ int32_t indicesOfSetBits(
   return result - originalResult;
 }
 
+template <bool negate, typename A>
+void andRange(
+    uint64_t* target,
+    const uint64_t* left,
+    const uint64_t* right,
+    int32_t begin,
+    int32_t end,
+    const A&) {
+  using Batch = xsimd::batch<uint64_t, A>;
+  constexpr int32_t kBatchSize = Batch::size;
+  const int32_t firstWord = bits::roundUp(begin, 64) / 64;
+  const int32_t lastWord = end / 64;
+  if (lastWord - firstWord < kBatchSize) {
+    bits::andRange<negate>(target, left, right, begin, end);
+    return;
+  }
+  bits::andRange<negate>(target, left, right, begin, firstWord * 64);
+  auto word = firstWord;
+  for (; word + kBatchSize <= lastWord; word += kBatchSize) {
+    const auto leftWords = Batch::load_unaligned(left + word);
+    const auto rightWords = Batch::load_unaligned(right + word);
+    if constexpr (negate) {
+      xsimd::bitwise_andnot(leftWords, rightWords).store_unaligned(
+          target + word);
+    } else {
+      (leftWords & rightWords).store_unaligned(target + word);
+    }
+  }
+  bits::andRange<negate>(target, left, right, word * 64, end);
+}
+
+template <bool negate, typename A>
+void orRange(
+    uint64_t* target,
+    const uint64_t* left,
+    const uint64_t* right,
+    int32_t begin,
+    int32_t end,
+    const A&) {
+  using Batch = xsimd::batch<uint64_t, A>;
+  constexpr int32_t kBatchSize = Batch::size;
+  const int32_t firstWord = bits::roundUp(begin, 64) / 64;
+  const int32_t lastWord = end / 64;
+  if (lastWord - firstWord < kBatchSize) {
+    bits::orRange<negate>(target, left, right, begin, end);
+    return;
+  }
+  bits::orRange<negate>(target, left, right, begin, firstWord * 64);
+  auto word = firstWord;
+  for (; word + kBatchSize <= lastWord; word += kBatchSize) {
+    const auto leftWords = Batch::load_unaligned(left + word);
+    auto rightWords = Batch::load_unaligned(right + word);
+    if constexpr (negate) {
+      rightWords = ~rightWords;
+    }
+    (leftWords | rightWords).store_unaligned(target + word);
+  }
+  bits::orRange<negate>(target, left, right, word * 64, end);
+}
+
+namespace detail {
+
+inline int32_t countBitsInWords(
+    const uint64_t* words,
+    int32_t numWords,
+    const xsimd::generic&) {
+  // Independent sums, so that the popcounts do not wait for each other.
+  int32_t counts[4] = {};
+  int32_t i = 0;
+  for (; i + 4 <= numWords; i += 4) {
+    counts[0] += __builtin_popcountll(words[i]);
+    counts[1] += __builtin_popcountll(words[i + 1]);
+    counts[2] += __builtin_popcountll(words[i + 2]);
+    counts[3] += __builtin_popcountll(words[i + 3]);
+  }
+  for (; i < numWords; ++i) {
+    counts[0] += __builtin_popcountll(words[i]);
+  }
+  return counts[0] + counts[1] + counts[2] + counts[3];
+}
+
+#if XSIMD_WITH_AVX2
+inline int32_t countBitsInWords(
+    const uint64_t* words,
+    int32_t numWords,
+    const xsimd::avx2&) {
+  // Looks up the count of each nibble with a byte shuffle and sums the bytes
+  // of each word with a sum of absolute differences.
+  const auto lookup = _mm256_setr_epi8(
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const auto lowNibbles = _mm256_set1_epi8(0x0f);
+  auto sums = _mm256_setzero_si256();
+  int32_t i = 0;
+  for (; i + 4 <= numWords; i += 4) {
+    const auto data =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+    const auto low = _mm256_and_si256(data, lowNibbles);
+    const auto high = _mm256_and_si256(_mm256_srli_epi16(data, 4), lowNibbles);
+    const auto byteCounts = _mm256_add_epi8(
+        _mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+    sums = _mm256_add_epi64(
+        sums, _mm256_sad_epu8(byteCounts, _mm256_setzero_si256()));
+  }
+  int32_t count = _mm256_extract_epi64(sums, 0) +
+      _mm256_extract_epi64(sums, 1) + _mm256_extract_epi64(sums, 2) +
+      _mm256_extract_epi64(sums, 3);
+  for (; i < numWords; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+#endif
+
+} // namespace detail
+
+template <typename A>
+int32_t countBits(const uint64_t* bits, int32_t begin, int32_t end, const A&) {
+  const int32_t firstWord = bits::roundUp(begin, 64) / 64;
+  const int32_t lastWord = end / 64;
+  if (lastWord <= firstWord) {
+    return bits::countBits(bits, begin, end);
+  }
+  return bits::countBits(bits, begin, firstWord * 64) +
+      detail::countBitsInWords(bits + firstWord, lastWord - firstWord, A{}) +
+      bits::countBits(bits, lastWord * 64, end);
+}
+
+template <typename A>
+int32_t
+findFirstBit(const uint64_t* bits, int32_t begin, int32_t end, const A&) {
+  using Batch = xsimd::batch<uint64_t, A>;
+  constexpr int32_t kBatchSize = Batch::size;
+  const int32_t firstWord = bits::roundUp(begin, 64) / 64;
+  const int32_t lastWord = end / 64;
+  if (lastWord - firstWord < kBatchSize) {
+    return bits::findFirstBit(bits, begin, end);
+  }
+  const auto found = bits::findFirstBit(bits, begin, firstWord * 64);
+  if (found >= 0) {
+    return found;
+  }
+  const auto zero = setAll<uint64_t, A>(0);
+  auto word = firstWord;
+  for (; word + kBatchSize <= lastWord; word += kBatchSize) {
+    if (xsimd::any(Batch::load_unaligned(bits + word) != zero)) {
+      while (bits[word] == 0) {
+        ++word;
+      }
+      return word * 64 + __builtin_ctzll(bits[word]);
+    }
+  }
+  return bits::findFirstBit(bits, word * 64, end);
+}
+
 namespace detail {
 
 template <typename T, typename A>
@@ -1436,4 +1591,52 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+inline size_t simdStrstr(
+    const char* haystack,
+    size_t haystackSize,
+    const char* needle,
+    size_t needleSize,
+    const A&) {
+  if (needleSize == 0) {
+    return 0;
+  }
+  if (needleSize > haystackSize) {
+    return std::string_view::npos;
+  }
+  if (needleSize == 1) {
+    auto* found = ::memchr(haystack, needle[0], haystackSize);
+    return found == nullptr ? std::string_view::npos
+                            : static_cast<const char*>(found) - haystack;
+  }
+
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr size_t kBatch = Batch::size;
+  const auto first = Batch::broadcast(needle[0]);
+  const auto last = Batch::broadcast(needle[needleSize - 1]);
+  auto data = reinterpret_cast<const uint8_t*>(haystack);
+  // The last position where 'needle' can start.
+  const size_t lastStart = haystackSize - needleSize;
+  size_t start = 0;
+  for (; start + kBatch <= lastStart + 1; start += kBatch) {
+    uint32_t candidates = toBitMask(
+        (first == Batch::load_unaligned(data + start)) &
+        (last == Batch::load_unaligned(data + start + needleSize - 1)));
+    while (candidates != 0) {
+      const auto offset = start + __builtin_ctz(candidates);
+      if (::memcmp(haystack + offset + 1, needle + 1, needleSize - 2) == 0) {
+        return offset;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  for (; start <= lastStart; ++start) {
+    if (haystack[start] == needle[0] &&
+        ::memcmp(haystack + start + 1, needle + 1, needleSize - 1) == 0) {
+      return start;
+    }
+  }
+  return std::string_view::npos;
+}
+
 } // namespace facebook::velox::simd
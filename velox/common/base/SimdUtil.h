@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string_view>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
@@ -73,6 +75,47 @@ inline const int32_t* byteSetBits(uint8_t byte) {
   return detail::byteSetBits[byte];
 }
 
+// Sets the bits of 'target' from 'begin' to 'end' to the AND of 'left' and
+// 'right', or of 'left' and NOT 'right' if 'negate'. Same as
+// bits::andRange but processes a SIMD register of whole words at a time.
+template <bool negate, typename A = xsimd::default_arch>
+void andRange(
+    uint64_t* target,
+    const uint64_t* left,
+    const uint64_t* right,
+    int32_t begin,
+    int32_t end,
+    const A& = {});
+
+// Sets the bits of 'target' from 'begin' to 'end' to the OR of 'left' and
+// 'right', or of 'left' and NOT 'right' if 'negate'.
+template <bool negate, typename A = xsimd::default_arch>
+void orRange(
+    uint64_t* target,
+    const uint64_t* left,
+    const uint64_t* right,
+    int32_t begin,
+    int32_t end,
+    const A& = {});
+
+// Returns the number of set bits in 'bits' from 'begin' to 'end'. Counts the
+// bits of whole words with vector byte lookups where available.
+template <typename A = xsimd::default_arch>
+int32_t countBits(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    const A& = {});
+
+// Returns the position of the first set bit in 'bits' from 'begin' to 'end',
+// or -1 if none is set. Tests a SIMD register of whole words at a time.
+template <typename A = xsimd::default_arch>
+int32_t findFirstBit(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    const A& = {});
+
 namespace detail {
 template <typename T, typename A, typename = void>
 struct HalfBatchImpl;
@@ -497,6 +540,20 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the offset of the first occurrence of 'needle' in 'haystack' or
+// std::string_view::npos if there is none. The positions where both the first
+// and the last byte of 'needle' match are found a full SIMD width at a time
+// and only these are compared in full, which skips most of the haystack for
+// needles whose first and last bytes are not frequent. Does not read past the
+// end of 'haystack'.
+template <typename A = xsimd::default_arch>
+inline size_t simdStrstr(
+    const char* haystack,
+    size_t haystackSize,
+    const char* needle,
+    size_t needleSize,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
@@ -34,7 +34,12 @@ SpillConfig::SpillConfig(
     uint64_t _maxSpillRunRows,
     uint64_t _writerFlushThresholdSize,
     const std::string& _compressionKind,
-    const std::string& _fileCreateConfig)
+    const std::string& _fileCreateConfig,
+    std::optional<PrefixSortConfig> _prefixSortConfig,
+    GetSpillDirectoryPathCB _getOverflowSpillDirPathCb,
+    uint32_t _readAheadDepth,
+    std::shared_ptr<SpillReadAheadBudget> _readAheadBudget,
+    uint64_t _maxMergeBytes)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -52,7 +57,12 @@ SpillConfig::SpillConfig(
       maxSpillRunRows(_maxSpillRunRows),
       writerFlushThresholdSize(_writerFlushThresholdSize),
       compressionKind(common::stringToCompressionKind(_compressionKind)),
-      fileCreateConfig(_fileCreateConfig) {
+      fileCreateConfig(_fileCreateConfig),
+      prefixSortConfig(std::move(_prefixSortConfig)),
+      getOverflowSpillDirPathCb(std::move(_getOverflowSpillDirPathCb)),
+      readAheadDepth(_readAheadDepth),
+      readAheadBudget(std::move(_readAheadBudget)),
+      maxMergeBytes(_maxMergeBytes) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
@@ -86,4 +96,20 @@ bool SpillConfig::exceedSpillLevelLimit(uint8_t startBitOffset) const {
   }
   return spillLevel(startBitOffset) > maxSpillLevel;
 }
+
+bool SpillReadAheadBudget::tryReserve(uint64_t bytes) {
+  auto reservedBytes = reservedBytes_.load();
+  do {
+    if (reservedBytes + bytes > capacity_) {
+      return false;
+    }
+  } while (!reservedBytes_.compare_exchange_weak(
+      reservedBytes, reservedBytes + bytes));
+  return true;
+}
+
+void SpillReadAheadBudget::release(uint64_t bytes) {
+  const auto reservedBytes = reservedBytes_.fetch_sub(bytes);
+  VELOX_CHECK_GE(reservedBytes, bytes);
+}
 } // namespace facebook::velox::common
@@ -18,8 +18,12 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <atomic>
+#include <memory>
+#include <optional>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
@@ -42,6 +46,32 @@ using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// Bounds the bytes read ahead by the spill streams sharing 'this', e.g. all
+/// the spill streams of a task. Thread safe.
+class SpillReadAheadBudget {
+ public:
+  explicit SpillReadAheadBudget(uint64_t capacity) : capacity_(capacity) {}
+
+  /// Reserves 'bytes' for a read-ahead. Returns false without reserving if
+  /// this would exceed the capacity.
+  bool tryReserve(uint64_t bytes);
+
+  /// Releases 'bytes' reserved by tryReserve().
+  void release(uint64_t bytes);
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  uint64_t reservedBytes() const {
+    return reservedBytes_;
+  }
+
+ private:
+  const uint64_t capacity_;
+  std::atomic<uint64_t> reservedBytes_{0};
+};
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -61,7 +91,12 @@ struct SpillConfig {
       uint64_t _maxSpillRunRows,
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
+      GetSpillDirectoryPathCB _getOverflowSpillDirPathCb = nullptr,
+      uint32_t _readAheadDepth = 1,
+      std::shared_ptr<SpillReadAheadBudget> _readAheadBudget = nullptr,
+      uint64_t _maxMergeBytes = 0);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -138,5 +173,30 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If set, the sorted spill runs are sorted with prefix-sort using this
+  /// config.
+  std::optional<PrefixSortConfig> prefixSortConfig;
+
+  /// If set, a callback function invoked before creating a spill file that
+  /// returns the overflow spill directory path if the file should be created
+  /// there instead of in the directory from 'getSpillDirPathCb', or an empty
+  /// path otherwise.
+  GetSpillDirectoryPathCB getOverflowSpillDirPathCb;
+
+  /// The number of read buffers kept in flight ahead of the one being consumed
+  /// by each spill file read stream. Zero disables read-ahead. The reads are
+  /// issued with the native async read of the file system if it has one, and
+  /// on 'executor' otherwise.
+  uint32_t readAheadDepth;
+
+  /// If set, bounds the bytes read ahead by all the spill read streams that
+  /// share it. A read is not issued ahead if it exceeds the budget.
+  std::shared_ptr<SpillReadAheadBudget> readAheadBudget;
+
+  /// The max bytes of the read buffers of the spill files merged at once by
+  /// the final merge of a sort. If it is zero, then all the spill files are
+  /// merged at once. See exec::SpillPartition::createOrderedReader().
+  uint64_t maxMergeBytes{0};
 };
 } // namespace facebook::velox::common
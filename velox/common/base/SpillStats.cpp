@@ -42,6 +42,8 @@ SpillStats::SpillStats(
     uint64_t _spilledRows,
     uint32_t _spilledPartitions,
     uint64_t _spilledFiles,
+    uint64_t _spilledOverflowBytes,
+    uint64_t _spilledOverflowFiles,
     uint64_t _spillFillTimeUs,
     uint64_t _spillSortTimeUs,
     uint64_t _spillSerializationTimeUs,
@@ -59,6 +61,8 @@ SpillStats::SpillStats(
       spilledRows(_spilledRows),
       spilledPartitions(_spilledPartitions),
       spilledFiles(_spilledFiles),
+      spilledOverflowBytes(_spilledOverflowBytes),
+      spilledOverflowFiles(_spilledOverflowFiles),
       spillFillTimeUs(_spillFillTimeUs),
       spillSortTimeUs(_spillSortTimeUs),
       spillSerializationTimeUs(_spillSerializationTimeUs),
@@ -78,6 +82,8 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spilledRows += other.spilledRows;
   spilledPartitions += other.spilledPartitions;
   spilledFiles += other.spilledFiles;
+  spilledOverflowBytes += other.spilledOverflowBytes;
+  spilledOverflowFiles += other.spilledOverflowFiles;
   spillFillTimeUs += other.spillFillTimeUs;
   spillSortTimeUs += other.spillSortTimeUs;
   spillSerializationTimeUs += other.spillSerializationTimeUs;
@@ -100,6 +106,10 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spilledRows = spilledRows - other.spilledRows;
   result.spilledPartitions = spilledPartitions - other.spilledPartitions;
   result.spilledFiles = spilledFiles - other.spilledFiles;
+  result.spilledOverflowBytes =
+      spilledOverflowBytes - other.spilledOverflowBytes;
+  result.spilledOverflowFiles =
+      spilledOverflowFiles - other.spilledOverflowFiles;
   result.spillFillTimeUs = spillFillTimeUs - other.spillFillTimeUs;
   result.spillSortTimeUs = spillSortTimeUs - other.spillSortTimeUs;
   result.spillSerializationTimeUs =
@@ -135,6 +145,8 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spilledRows);
   UPDATE_COUNTER(spilledPartitions);
   UPDATE_COUNTER(spilledFiles);
+  UPDATE_COUNTER(spilledOverflowBytes);
+  UPDATE_COUNTER(spilledOverflowFiles);
   UPDATE_COUNTER(spillFillTimeUs);
   UPDATE_COUNTER(spillSortTimeUs);
   UPDATE_COUNTER(spillSerializationTimeUs);
@@ -175,6 +187,8 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spilledRows,
              spilledPartitions,
              spilledFiles,
+             spilledOverflowBytes,
+             spilledOverflowFiles,
              spillFillTimeUs,
              spillSortTimeUs,
              spillSerializationTimeUs,
@@ -193,6 +207,8 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spilledRows,
              other.spilledPartitions,
              other.spilledFiles,
+             other.spilledOverflowBytes,
+             other.spilledOverflowFiles,
              other.spillFillTimeUs,
              other.spillSortTimeUs,
              other.spillSerializationTimeUs,
@@ -213,6 +229,8 @@ void SpillStats::reset() {
   spilledRows = 0;
   spilledPartitions = 0;
   spilledFiles = 0;
+  spilledOverflowBytes = 0;
+  spilledOverflowFiles = 0;
   spillFillTimeUs = 0;
   spillSortTimeUs = 0;
   spillSerializationTimeUs = 0;
@@ -229,7 +247,8 @@ void SpillStats::reset() {
 std::string SpillStats::toString() const {
   return fmt::format(
       "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
-      "spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] "
+      "spilledPartitions[{}] spilledFiles[{}] spilledOverflowBytes[{}] "
+      "spilledOverflowFiles[{}] spillFillTimeUs[{}] "
       "spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] "
       "spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTime[{}] "
@@ -240,6 +259,8 @@ std::string SpillStats::toString() const {
       spilledRows,
       spilledPartitions,
       spilledFiles,
+      succinctBytes(spilledOverflowBytes),
+      spilledOverflowFiles,
       succinctMicros(spillFillTimeUs),
       succinctMicros(spillSortTimeUs),
       succinctMicros(spillSerializationTimeUs),
@@ -38,6 +38,11 @@ struct SpillStats {
   uint32_t spilledPartitions{0};
   /// The number of spilled files.
   uint64_t spilledFiles{0};
+  /// The number of bytes spilled to the overflow spill directory. The rest
+  /// of 'spilledBytes' is spilled to the local spill directory.
+  uint64_t spilledOverflowBytes{0};
+  /// The number of spilled files in the overflow spill directory.
+  uint64_t spilledOverflowFiles{0};
   /// The time spent on filling rows for spilling.
   uint64_t spillFillTimeUs{0};
   /// The time spent on sorting rows for spilling.
@@ -72,6 +77,8 @@ struct SpillStats {
       uint64_t _spilledRows,
       uint32_t _spilledPartitions,
       uint64_t _spilledFiles,
+      uint64_t _spilledOverflowBytes,
+      uint64_t _spilledOverflowFiles,
       uint64_t _spillFillTimeUs,
       uint64_t _spillSortTimeUs,
       uint64_t _spillSerializationTimeUs,
@@ -50,6 +50,8 @@ std::string_view toString(StatusCode code) {
       return "Unknown error";
     case StatusCode::kNotImplemented:
       return "NotImplemented";
+    case StatusCode::kArithmeticError:
+      return "Arithmetic error";
   }
   return ""; // no-op
 }
@@ -129,6 +129,9 @@ namespace facebook::velox {
 /// - kNotImplemented: An error triggered by a feature not being implemented
 ///   yet.
 ///
+/// - kArithmeticError: A user error triggered by an arithmetic operation, e.g.
+///   an overflow or a division by zero.
+///
 enum class StatusCode : int8_t {
   kOK = 0,
   kUserError = 1,
@@ -142,6 +145,7 @@ enum class StatusCode : int8_t {
   kInvalid = 9,
   kUnknownError = 10,
   kNotImplemented = 11,
+  kArithmeticError = 12,
 };
 std::string_view toString(StatusCode code);
 
@@ -271,6 +275,14 @@ class [[nodiscard]] Status {
         StatusCode::kNotImplemented, std::forward<Args>(args)...);
   }
 
+  /// Return an error status for arithmetic errors such as an overflow or a
+  /// division by zero. These are user errors.
+  template <typename... Args>
+  static Status ArithmeticError(Args&&... args) {
+    return Status::fromArgs(
+        StatusCode::kArithmeticError, std::forward<Args>(args)...);
+  }
+
   /// Return true iff the status indicates success.
   constexpr bool ok() const {
     return (state_ == nullptr);
@@ -331,6 +343,11 @@ class [[nodiscard]] Status {
     return code() == StatusCode::kNotImplemented;
   }
 
+  /// Return true iff the status indicates an arithmetic error.
+  constexpr bool isArithmeticError() const {
+    return code() == StatusCode::kArithmeticError;
+  }
+
   /// Return a string representation of this status suitable for printing.
   ///
   /// The string "OK" is returned for success.
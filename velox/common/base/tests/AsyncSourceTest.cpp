@@ -246,6 +246,33 @@ TEST(AsyncSourceTest, close) {
   thread1.join();
 }
 
+TEST(AsyncSourceTest, isMaking) {
+  AsyncSource<Gizmo> gizmo([]() { return std::make_unique<Gizmo>(11); });
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  // Not started, so move() would make the item on the caller thread.
+  EXPECT_FALSE(gizmo.isMaking(future));
+  EXPECT_FALSE(future.valid());
+
+  folly::Baton<> making;
+  folly::Baton<> finish;
+  AsyncSource<Gizmo> slowGizmo([&]() {
+    making.post();
+    finish.wait();
+    return std::make_unique<Gizmo>(12);
+  });
+  std::thread thread([&]() { slowGizmo.prepare(); });
+  making.wait();
+  ASSERT_TRUE(slowGizmo.isMaking(future));
+  EXPECT_FALSE(future.isReady());
+  finish.post();
+  std::move(future).wait();
+  EXPECT_TRUE(slowGizmo.hasValue());
+  EXPECT_FALSE(slowGizmo.isMaking(future));
+  EXPECT_EQ(12, slowGizmo.move()->id);
+  thread.join();
+  gizmo.close();
+}
+
 void verifyContexts(
     const std::string& expectedPoolName,
     const std::string& expectedTaskId) {
@@ -90,3 +90,26 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, batch) {
+  constexpr int32_t kSize = 1000;
+  std::vector<uint64_t> hashes(2 * kSize);
+  for (auto i = 0; i < hashes.size(); ++i) {
+    hashes[i] = folly::hasher<int64_t>()(i);
+  }
+
+  BloomFilter batch;
+  batch.reset(kSize);
+  batch.insert(hashes.data(), kSize);
+  BloomFilter single;
+  single.reset(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    single.insert(hashes[i]);
+  }
+
+  std::vector<uint64_t> result(bits::nwords(hashes.size()));
+  batch.mayContain(hashes.data(), hashes.size(), result.data());
+  for (auto i = 0; i < hashes.size(); ++i) {
+    EXPECT_EQ(bits::isBitSet(result.data(), i), single.mayContain(hashes[i]));
+  }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/LatencyHistogram.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+namespace facebook::velox {
+namespace {
+
+TEST(LatencyHistogramTest, buckets) {
+  for (uint64_t value = 0; value < 8; ++value) {
+    EXPECT_EQ(LatencyHistogram::bucket(value), value);
+    EXPECT_EQ(LatencyHistogram::bucketUpperBound(value), value);
+  }
+  int32_t lastBucket = 7;
+  for (uint64_t value = 8; value < 100'000; ++value) {
+    const auto bucket = LatencyHistogram::bucket(value);
+    // Consecutive values are in the same or the next bucket.
+    ASSERT_TRUE(bucket == lastBucket || bucket == lastBucket + 1) << value;
+    if (bucket == lastBucket + 1) {
+      ASSERT_EQ(LatencyHistogram::bucketUpperBound(lastBucket), value - 1);
+    }
+    // The bucket bounds are within 12.5% of the value.
+    ASSERT_GE(LatencyHistogram::bucketUpperBound(bucket), value);
+    ASSERT_LE(LatencyHistogram::bucketUpperBound(bucket), value * 1.125);
+    lastBucket = bucket;
+  }
+  EXPECT_EQ(
+      LatencyHistogram::bucket(1UL << 40), LatencyHistogram::kNumBuckets - 1);
+  EXPECT_EQ(
+      LatencyHistogram::bucket(std::numeric_limits<uint64_t>::max()),
+      LatencyHistogram::kNumBuckets - 1);
+}
+
+TEST(LatencyHistogramTest, percentile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(LatencyHistogram::percentile(histogram.counts(), 50), 0);
+
+  for (auto i = 1; i <= 1'000; ++i) {
+    histogram.record(i);
+  }
+  const auto counts = histogram.counts();
+  EXPECT_EQ(std::accumulate(counts.begin(), counts.end(), 0UL), 1'000);
+  const auto p50 = LatencyHistogram::percentile(counts, 50);
+  EXPECT_GE(p50, 500);
+  EXPECT_LE(p50, 500 * 1.125);
+  const auto p99 = LatencyHistogram::percentile(counts, 99);
+  EXPECT_GE(p99, 990);
+  EXPECT_LE(p99, 990 * 1.125);
+  EXPECT_EQ(LatencyHistogram::percentile(counts, 100), 1'023);
+
+  histogram.testingClear();
+  EXPECT_EQ(LatencyHistogram::percentile(histogram.counts(), 50), 0);
+}
+
+TEST(LatencyHistogramTest, concurrentRecord) {
+  LatencyHistogram histogram;
+  constexpr int32_t kNumThreads = 20;
+  constexpr int32_t kNumValues = 10'000;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < kNumValues; ++j) {
+        histogram.record(j % 100);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto counts = histogram.counts();
+  EXPECT_EQ(
+      std::accumulate(counts.begin(), counts.end(), 0UL),
+      kNumThreads * kNumValues);
+  EXPECT_EQ(counts[LatencyHistogram::bucket(0)], kNumThreads * 100);
+}
+
+TEST(LatencyHistogramTest, registry) {
+  auto* histogram = LatencyHistogram::get("latency_histogram_test");
+  EXPECT_EQ(histogram, LatencyHistogram::get("latency_histogram_test"));
+  EXPECT_NE(histogram, LatencyHistogram::get("latency_histogram_test2"));
+  bool found = false;
+  for (const auto& [name, registered] : LatencyHistogram::all()) {
+    if (name == "latency_histogram_test") {
+      EXPECT_EQ(registered, histogram);
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+} // namespace
+} // namespace facebook::velox
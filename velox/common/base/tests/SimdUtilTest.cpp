@@ -129,6 +129,61 @@ TEST_F(SimdUtilTest, bitIndices) {
   testIndices(999);
 }
 
+TEST_F(SimdUtilTest, bitRanges) {
+  constexpr int32_t kWords = 100;
+  for (auto onesPer1000 : {0, 1, 100, 500, 999}) {
+    SCOPED_TRACE(fmt::format("onesPer1000 {}", onesPer1000));
+    std::vector<uint64_t> left(kWords);
+    std::vector<uint64_t> right(kWords);
+    randomBits(left, onesPer1000);
+    randomBits(right, 500);
+    for (auto [begin, end] : std::vector<std::pair<int32_t, int32_t>>{
+             {0, kWords * 64},
+             {3, 70},
+             {64, 64 * 9},
+             {17, kWords * 64 - 5},
+             {130, 131},
+             {kWords * 64 - 1, kWords * 64}}) {
+      SCOPED_TRACE(fmt::format("begin {} end {}", begin, end));
+      EXPECT_EQ(
+          bits::countBits(left.data(), begin, end),
+          simd::countBits(left.data(), begin, end));
+      EXPECT_EQ(
+          bits::findFirstBit(left.data(), begin, end),
+          simd::findFirstBit(left.data(), begin, end));
+
+      auto expectedTarget = right;
+      auto actualTarget = right;
+      bits::andRange<false>(
+          expectedTarget.data(), left.data(), right.data(), begin, end);
+      simd::andRange<false>(
+          actualTarget.data(), left.data(), right.data(), begin, end);
+      EXPECT_EQ(expectedTarget, actualTarget);
+      bits::andRange<true>(
+          expectedTarget.data(), left.data(), right.data(), begin, end);
+      simd::andRange<true>(
+          actualTarget.data(), left.data(), right.data(), begin, end);
+      EXPECT_EQ(expectedTarget, actualTarget);
+      bits::orRange<false>(
+          expectedTarget.data(), left.data(), right.data(), begin, end);
+      simd::orRange<false>(
+          actualTarget.data(), left.data(), right.data(), begin, end);
+      EXPECT_EQ(expectedTarget, actualTarget);
+      bits::orRange<true>(
+          expectedTarget.data(), left.data(), right.data(), begin, end);
+      simd::orRange<true>(
+          actualTarget.data(), left.data(), right.data(), begin, end);
+      EXPECT_EQ(expectedTarget, actualTarget);
+    }
+  }
+
+  // A single set bit after many zero words.
+  std::vector<uint64_t> bits(kWords);
+  bits::setBit(bits.data(), kWords * 64 - 70);
+  EXPECT_EQ(kWords * 64 - 70, simd::findFirstBit(bits.data(), 5, kWords * 64));
+  EXPECT_EQ(-1, simd::findFirstBit(bits.data(), 5, kWords * 64 - 70));
+}
+
 TEST_F(SimdUtilTest, gather32) {
   int32_t indices8[8] = {7, 6, 5, 4, 3, 2, 1, 0};
   int32_t indices6[8] = {7, 6, 5, 4, 3, 2, 1 << 31, 1 << 31};
@@ -453,6 +508,48 @@ TEST_F(SimdUtilTest, memEqualUnsafe) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, simdStrstr) {
+  auto find = [](std::string_view haystack, std::string_view needle) {
+    return simd::simdStrstr(
+        haystack.data(), haystack.size(), needle.data(), needle.size());
+  };
+  constexpr auto npos = std::string_view::npos;
+  EXPECT_EQ(find("", ""), 0);
+  EXPECT_EQ(find("abc", ""), 0);
+  EXPECT_EQ(find("", "a"), npos);
+  EXPECT_EQ(find("ab", "abc"), npos);
+  EXPECT_EQ(find("abc", "c"), 2);
+  EXPECT_EQ(find("abc", "abc"), 0);
+
+  // Matches in and after the part searched a SIMD width at a time, and
+  // candidates whose first and last bytes match but the middle does not.
+  std::string haystack(200, 'a');
+  EXPECT_EQ(find(haystack, "ab"), npos);
+  EXPECT_EQ(find(haystack, "aa"), 0);
+  for (size_t position : {0, 1, 15, 31, 32, 33, 100, 190, 195}) {
+    auto text = haystack;
+    text.replace(position, 5, "axyzb");
+    EXPECT_EQ(find(text, "axyzb"), position);
+    EXPECT_EQ(find(text, "axazb"), npos);
+    EXPECT_EQ(find(text.substr(0, position + 4), "axyzb"), npos);
+  }
+
+  // Random text over a small alphabet has many partial matches.
+  folly::Random::DefaultGenerator rng(1);
+  for (auto i = 0; i < 10'000; ++i) {
+    std::string text(folly::Random::rand32(100, rng), ' ');
+    for (auto& c : text) {
+      c = 'a' + folly::Random::rand32(3, rng);
+    }
+    std::string needle(folly::Random::rand32(1, 6, rng), ' ');
+    for (auto& c : needle) {
+      c = 'a' + folly::Random::rand32(3, rng);
+    }
+    ASSERT_EQ(find(text, needle), std::string_view(text).find(needle))
+        << text << " " << needle;
+  }
+}
+
 TEST_F(SimdUtilTest, memcpyTime) {
   constexpr int64_t kMaxMove = 128;
   constexpr int64_t kSize = (128 << 20) + kMaxMove;
@@ -183,3 +183,19 @@ TEST(SpillConfig, spillableReservationPercentages) {
     }
   }
 }
+
+TEST(SpillConfig, readAheadBudget) {
+  SpillReadAheadBudget budget(100);
+  ASSERT_EQ(budget.capacity(), 100);
+  ASSERT_TRUE(budget.tryReserve(60));
+  ASSERT_FALSE(budget.tryReserve(50));
+  ASSERT_EQ(budget.reservedBytes(), 60);
+  ASSERT_TRUE(budget.tryReserve(40));
+  ASSERT_FALSE(budget.tryReserve(1));
+  budget.release(60);
+  ASSERT_EQ(budget.reservedBytes(), 40);
+  ASSERT_TRUE(budget.tryReserve(50));
+  budget.release(90);
+  ASSERT_EQ(budget.reservedBytes(), 0);
+  VELOX_ASSERT_THROW(budget.release(1), "");
+}
@@ -29,6 +29,8 @@ TEST(SpillStatsTest, spillStats) {
   stats1.spilledBytes = 1024;
   stats1.spilledPartitions = 1024;
   stats1.spilledFiles = 1023;
+  stats1.spilledOverflowBytes = 512;
+  stats1.spilledOverflowFiles = 511;
   stats1.spillWriteTimeUs = 1023;
   stats1.spillFlushTimeUs = 1023;
   stats1.spillWrites = 1023;
@@ -48,6 +50,8 @@ TEST(SpillStatsTest, spillStats) {
   stats2.spilledBytes = 1024;
   stats2.spilledPartitions = 1025;
   stats2.spilledFiles = 1026;
+  stats2.spilledOverflowBytes = 512;
+  stats2.spilledOverflowFiles = 513;
   stats2.spillWriteTimeUs = 1026;
   stats2.spillFlushTimeUs = 1027;
   stats2.spillWrites = 1028;
@@ -79,6 +83,8 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spilledBytes, 0);
   ASSERT_EQ(delta.spilledPartitions, 1);
   ASSERT_EQ(delta.spilledFiles, 3);
+  ASSERT_EQ(delta.spilledOverflowBytes, 0);
+  ASSERT_EQ(delta.spilledOverflowFiles, 2);
   ASSERT_EQ(delta.spillWriteTimeUs, 3);
   ASSERT_EQ(delta.spillFlushTimeUs, 4);
   ASSERT_EQ(delta.spillWrites, 5);
@@ -95,6 +101,8 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spilledBytes, 0);
   ASSERT_EQ(delta.spilledPartitions, -1);
   ASSERT_EQ(delta.spilledFiles, -3);
+  ASSERT_EQ(delta.spilledOverflowBytes, 0);
+  ASSERT_EQ(delta.spilledOverflowFiles, -2);
   ASSERT_EQ(delta.spillWriteTimeUs, -3);
   ASSERT_EQ(delta.spillFlushTimeUs, -4);
   ASSERT_EQ(delta.spillWrites, -5);
@@ -123,6 +131,7 @@ TEST(SpillStatsTest, spillStats) {
       stats2.toString(),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
       "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
+      "spilledOverflowBytes[512B] spilledOverflowFiles[513] "
       "spillFillTimeUs[1.03ms] spillSortTime[1.03ms] "
       "spillSerializationTime[1.03ms] spillWrites[1028] spillFlushTime[1.03ms] "
       "spillWriteTime[1.03ms] maxSpillExceededLimitCount[4] "
@@ -132,6 +141,7 @@ TEST(SpillStatsTest, spillStats) {
       fmt::format("{}", stats2),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
       "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
+      "spilledOverflowBytes[512B] spilledOverflowFiles[513] "
       "spillFillTimeUs[1.03ms] spillSortTime[1.03ms] "
       "spillSerializationTime[1.03ms] spillWrites[1028] "
       "spillFlushTime[1.03ms] spillWriteTime[1.03ms] "
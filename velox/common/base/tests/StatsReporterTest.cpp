@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include "velox/common/base/Counters.h"
+#include "velox/common/base/LatencyHistogram.h"
 #include "velox/common/base/PeriodicStatsReporter.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/AsyncDataCache.h"
@@ -542,7 +543,7 @@ TEST_F(PeriodicStatsReporterTest, basic) {
        .sumEvictScore = 10,
        .ssdStats = newSsdStats});
   arbitrator.updateStats(memory::MemoryArbitrator::Stats(
-      10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10));
+      10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10));
   std::this_thread::sleep_for(std::chrono::milliseconds(4'000));
 
   // Stop right after sufficient wait to ensure the following reads from main
@@ -586,6 +587,28 @@ TEST_F(PeriodicStatsReporterTest, basic) {
   }
 }
 
+TEST_F(PeriodicStatsReporterTest, latencyStats) {
+  auto* histogram = LatencyHistogram::get("test_latency_us");
+  for (auto i = 1; i <= 1'000; ++i) {
+    histogram->record(i);
+  }
+  PeriodicStatsReporter::Options options;
+  options.latencyStatsIntervalMs = 4'000;
+  PeriodicStatsReporter periodicReporter(options);
+  periodicReporter.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(2'000));
+  periodicReporter.stop();
+  // Keeps the histogram from being reported by the other tests.
+  histogram->testingClear();
+
+  std::lock_guard<std::mutex> l(reporter_->m);
+  const auto& counterMap = reporter_->counterMap;
+  ASSERT_EQ(reporter_->statTypeMap.at("test_latency_us.p50"), StatType::AVG);
+  ASSERT_EQ(counterMap.at("test_latency_us.p50"), 511);
+  ASSERT_EQ(counterMap.at("test_latency_us.p99"), 1'023);
+  ASSERT_EQ(counterMap.at("test_latency_us.p999"), 1'023);
+}
+
 TEST_F(PeriodicStatsReporterTest, globalInstance) {
   TestStatsReportMemoryArbitrator arbitrator({});
   PeriodicStatsReporter::Options options;
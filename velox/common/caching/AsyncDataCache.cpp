@@ -115,6 +115,7 @@ void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   VELOX_CHECK(isExclusive());
   setSsdFile(nullptr, 0);
   key_ = std::move(key);
+  numaNode_ = process::currentNumaNode();
   auto* cache = shard_->cache();
   ClockTimer t(shard_->allocClocks());
   if (size_ < AsyncDataCacheEntry::kTinyDataSize) {
@@ -126,6 +127,12 @@ void AsyncDataCacheEntry::initialize(FileCacheKey key) {
     const auto sizePages = memory::AllocationTraits::numPages(size_);
     if (cache->allocator()->allocateNonContiguous(sizePages, data_)) {
       cache->incrementCachedPages(data().numPages());
+      if (shard_->numaLocal()) {
+        for (auto i = 0; i < data_.numRuns(); ++i) {
+          const auto run = data_.runAt(i);
+          process::moveToNumaNode(run.data(), run.numBytes(), numaNode_);
+        }
+      }
     } else {
       // No memory to cover 'this'.
       release();
@@ -190,6 +197,14 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += foundEntry->size();
+          if (multiNode_ &&
+              foundEntry->numaNode_ != process::currentNumaNode()) {
+            ++numCrossNodeHit_;
+          }
+          if (sketch_ != nullptr &&
+              recordAccessLocked(key) >= admissionFrequency_) {
+            foundEntry->isProbation_ = false;
+          }
         }
         ++foundEntry->numPins_;
         CachePin pin;
@@ -230,10 +245,28 @@ CachePin CacheShard::findOrCreate(
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
+    entryToInit->isDense_ = false;
+    entryToInit->isProbation_ = false;
+    if (sketch_ != nullptr) {
+      if (entries_.size() > sketch_->capacity()) {
+        sketch_->ensureCapacity(2 * entries_.size());
+      }
+      if (recordAccessLocked(key) >= admissionFrequency_) {
+        ++numReadmit_;
+      } else {
+        entryToInit->isProbation_ = true;
+      }
+    }
   }
   return initEntry(key, entryToInit);
 }
 
+int32_t CacheShard::recordAccessLocked(const RawFileCacheKey& key) {
+  const auto hash = std::hash<RawFileCacheKey>()(key);
+  sketch_->increment(hash);
+  return sketch_->estimate(hash);
+}
+
 void CacheShard::makeEvictable(RawFileCacheKey key) {
   std::lock_guard<std::mutex> l(mutex_);
   auto it = entryMap_.find(key);
@@ -440,7 +473,10 @@ uint64_t CacheShard::evict(
         emptySlots_.push_back(entryIndex);
         tryAddFreeEntry(std::move(*iter));
         ++numEvict_;
-        if (score > 0) {
+        if (score == AsyncDataCacheEntry::kProbationScore) {
+          // Not a measure of time in cache.
+          ++numProbationEvict_;
+        } else if (score > 0) {
           sumEvictScore_ += score;
         }
         if (largeEvicted + tinyEvicted > bytesToFree) {
@@ -544,6 +580,9 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numAgedOut += numAgedOut_;
   stats.numStales += numStales_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numProbationEvict += numProbationEvict_;
+  stats.numReadmit += numReadmit_;
+  stats.numCrossNodeHit += numCrossNodeHit_;
   stats.allocClocks += allocClocks_;
 }
 
@@ -631,6 +670,9 @@ CacheStats CacheStats::operator-(CacheStats& other) const {
   result.numStales = numStales - other.numStales;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numProbationEvict = numProbationEvict - other.numProbationEvict;
+  result.numReadmit = numReadmit - other.numReadmit;
+  result.numCrossNodeHit = numCrossNodeHit - other.numCrossNodeHit;
   if (ssdStats != nullptr && other.ssdStats != nullptr) {
     result.ssdStats =
         std::make_shared<SsdCacheStats>(*ssdStats - *other.ssdStats);
@@ -652,7 +694,11 @@ AsyncDataCache::AsyncDataCache(
       ssdCache_(std::move(ssdCache)),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this,
+        opts_.maxWriteRatio,
+        opts_.admissionFrequency,
+        opts_.numaLocal));
   }
 }
 
@@ -1004,9 +1050,17 @@ std::string CacheStats::toString() const {
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
       << " stales: " << numStales
-      << "\n"
-      // Cache prefetch stats.
-      << "Prefetch entries: " << numPrefetch
+      << "\n";
+  if (numProbationEvict + numReadmit > 0) {
+    // Frequency based admission stats.
+    out << "Admission probation evictions: " << numProbationEvict
+        << " readmits: " << numReadmit << "\n";
+  }
+  if (numCrossNodeHit > 0) {
+    out << "NUMA cross node hits: " << numCrossNodeHit << "\n";
+  }
+  // Cache prefetch stats.
+  out << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
       << "\n"
       // Cache timing stats.
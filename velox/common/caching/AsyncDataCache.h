@@ -27,12 +27,15 @@
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CachePeer.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/common/process/ProcessBase.h"
 
 namespace facebook::velox::cache {
 
@@ -149,6 +152,8 @@ class AsyncDataCacheEntry {
  public:
   static constexpr int32_t kExclusive = -10000;
   static constexpr int32_t kTinyDataSize = 2048;
+  static constexpr int32_t kProbationScore =
+      std::numeric_limits<int32_t>::max() - 1;
 
   explicit AsyncDataCacheEntry(CacheShard* shard);
   ~AsyncDataCacheEntry();
@@ -191,7 +196,15 @@ class AsyncDataCacheEntry {
   }
 
   int32_t score(AccessTime now) const {
-    return accessStats_.score(now, size_);
+    if (isEvictableProbation()) {
+      return kProbationScore;
+    }
+    const auto score = accessStats_.score(now, size_);
+    if (isDense_ && score != std::numeric_limits<int32_t>::max()) {
+      // Densely read column streams are retained twice as long.
+      return score / 2;
+    }
+    return score;
   }
 
   bool isShared() const {
@@ -253,6 +266,39 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  /// Marks 'this' as data of a column stream that is read for most of its
+  /// references, so that it is retained in preference to other entries. Must
+  /// be called while holding 'this' exclusively.
+  void setDense() {
+    VELOX_CHECK(isExclusive());
+    isDense_ = true;
+    isProbation_ = false;
+  }
+
+  bool isDense() const {
+    return isDense_;
+  }
+
+  /// NUMA node of the thread that created 'this'. With NUMA local caching, the
+  /// memory of 'this' is on this node.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
+  /// True if 'this' was loaded for a key with fewer recent accesses than the
+  /// admission frequency of the cache and has not been accessed enough since.
+  bool isProbation() const {
+    return isProbation_;
+  }
+
+  /// True if 'this' is on probation and its possible prefetch has been used.
+  /// Such entries score as the least worth retaining short of the explicitly
+  /// evictable ones. When they are more than a fifth of the entries, the
+  /// eviction threshold rises to their score and only they are evicted.
+  bool isEvictableProbation() const {
+    return isProbation_ && !isPrefetch_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -322,6 +368,15 @@ class AsyncDataCacheEntry {
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
+  // See setDense(). Set while exclusive and read in eviction while unpinned.
+  bool isDense_{false};
+
+  // See isProbation(). Set inside the shard mutex or while exclusive.
+  bool isProbation_{false};
+
+  // See numaNode(). Set in initialize().
+  int32_t numaNode_{0};
+
   // SSD file from which this was loaded or nullptr if not backed by
   // SsdFile. Used to avoid re-adding items that already come from
   // SSD. The exact file and offset are needed to include uses in RAM
@@ -538,6 +593,18 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of entries evicted while on probation, i.e. data of one-off reads
+  /// that was evicted before more frequently accessed data. Only counted with
+  /// an admission frequency.
+  int64_t numProbationEvict{0};
+  /// Number of new entries for keys that were accessed recently enough to be
+  /// admitted right away. Most of these are misses on data that was evicted,
+  /// so a high count relative to 'numNew' indicates thrashing. Only counted
+  /// with an admission frequency.
+  int64_t numReadmit{0};
+  /// Number of hits on entries created on a different NUMA node than the one
+  /// of the hitting thread. Only counted on machines with more than one node.
+  int64_t numCrossNodeHit{0};
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
@@ -553,8 +620,19 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      int32_t admissionFrequency = 0,
+      bool numaLocal = false)
+      : cache_(cache),
+        maxWriteRatio_(maxWriteRatio),
+        admissionFrequency_(admissionFrequency),
+        numaLocal_(numaLocal),
+        sketch_(
+            admissionFrequency > 0
+                ? std::make_unique<FrequencySketch>(kInitialSketchCapacity)
+                : nullptr) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -621,14 +699,25 @@ class CacheShard {
     return allocClocks_;
   }
 
+  /// True if the memory of new entries is moved to the NUMA node of the
+  /// creating thread. See AsyncDataCache::Options::numaLocal.
+  bool numaLocal() const {
+    return numaLocal_;
+  }
+
   std::vector<AsyncDataCacheEntry*> testingCacheEntries() const;
 
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
+  static constexpr uint64_t kInitialSketchCapacity = 1 << 10;
 
   void calibrateThreshold();
 
+  // Counts an access to 'key' in 'sketch_' and returns its estimated number of
+  // recent accesses. Must be called inside 'mutex_' and with 'sketch_' set.
+  int32_t recordAccessLocked(const RawFileCacheKey& key);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -645,6 +734,15 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
+  // Number of recent accesses for a new entry to be admitted without
+  // probation. 0 disables the frequency based admission.
+  const int32_t admissionFrequency_;
+  // Recent access counts of the keys of 'this'. Set if 'admissionFrequency_'
+  // is set.
+  const std::unique_ptr<FrequencySketch> sketch_;
+  const bool numaLocal_;
+  // True if the machine has more than one NUMA node.
+  const bool multiNode_{process::numaNodeCount() > 1};
 
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
@@ -682,6 +780,13 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Cumulative count of entries evicted on probation.
+  uint64_t numProbationEvict_{0};
+  // Cumulative count of new entries admitted without probation.
+  uint64_t numReadmit_{0};
+  // Cumulative count of hits from a thread on another NUMA node than the
+  // creator of the entry.
+  uint64_t numCrossNodeHit_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -693,10 +798,14 @@ class AsyncDataCache : public memory::Cache {
     Options(
         double _maxWriteRatio = 0.7,
         double _ssdSavableRatio = 0.125,
-        int32_t _minSsdSavableBytes = 1 << 24)
+        int32_t _minSsdSavableBytes = 1 << 24,
+        int32_t _admissionFrequency = 0,
+        bool _numaLocal = false)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
-          minSsdSavableBytes(_minSsdSavableBytes){};
+          minSsdSavableBytes(_minSsdSavableBytes),
+          admissionFrequency(_admissionFrequency),
+          numaLocal(_numaLocal){};
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -715,6 +824,27 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// Number of recent accesses to a key, including the current one, for its
+    /// new entry to be admitted like any other. Entries for keys with fewer
+    /// accesses are on probation and are evicted first once unpinned, unless
+    /// hit again or read as part of a densely read column. This keeps large
+    /// one-off scans from flushing frequently read data. The recent accesses
+    /// are counted in a FrequencySketch that also remembers evicted keys. 2
+    /// admits the keys that were accessed before. 0 disables the admission
+    /// policy.
+    int32_t admissionFrequency;
+
+    /// If true and the machine has more than one NUMA node, the memory of a
+    /// new entry is moved to the node of the thread that creates it. The
+    /// thread that loads an entry is usually the one that first reads it, and
+    /// with drivers bound to nodes, e.g. by process::NumaThreadFactory, the
+    /// splits of a file tend to be read on the same node. The allocator reuses
+    /// freed pages regardless of node, so without this the data of the cache
+    /// ends up spread over the nodes. Entries stay in the shard of their key,
+    /// so that any thread finds any entry, and hits from other nodes are
+    /// counted in CacheStats::numCrossNodeHit.
+    bool numaLocal;
   };
 
   AsyncDataCache(
@@ -802,6 +932,17 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Sets the source of data cached by other workers. Misses that are not in
+  /// the SSD cache are read from 'peer' before storage. Must be set before
+  /// the cache is used for reading.
+  void setCachePeer(std::shared_ptr<CachePeer> peer) {
+    cachePeer_ = std::move(peer);
+  }
+
+  CachePeer* cachePeer() const {
+    return cachePeer_.get();
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -882,6 +1023,7 @@ class AsyncDataCache : public memory::Cache {
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  std::shared_ptr<CachePeer> cachePeer_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+
+#include <string_view>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Source of file data cached by other workers. A worker that takes over
+/// splits from another worker, e.g. after a node failure or rebalance, would
+/// otherwise read from storage data that a neighbor still holds in its memory
+/// or SSD cache. The implementation maps a file to the workers that cached it
+/// and fetches the data over the network. The cache consults the peer on a
+/// miss, after the local SSD cache and before storage.
+class CachePeer {
+ public:
+  virtual ~CachePeer() = default;
+
+  /// Reads the data of 'fileName' starting at 'offset' into 'buffers'. A
+  /// buffer with nullptr data skips its size worth of bytes, as in
+  /// ReadFile::preadv. Returns true if all of 'buffers' were filled. Returns
+  /// false if no peer has the data or a peer does not respond in time, in
+  /// which case the caller reads from storage. Should not throw.
+  virtual bool read(
+      std::string_view fileName,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) = 0;
+};
+
+} // namespace facebook::velox::cache
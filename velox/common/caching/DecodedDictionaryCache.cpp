@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/DecodedDictionaryCache.h"
+
+#include <cstring>
+
+namespace facebook::velox::cache {
+
+bool DecodedDictionary::getFilterResults(
+    const std::string& filterKey,
+    uint8_t* results) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = filterResults_.find(filterKey);
+  if (it == filterResults_.end()) {
+    return false;
+  }
+  std::memcpy(results, it->second.data(), numValues_);
+  return true;
+}
+
+void DecodedDictionary::setFilterResults(
+    const std::string& filterKey,
+    const uint8_t* results) {
+  std::vector<uint8_t> copy(results, results + numValues_);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (filterResults_.size() >= kMaxFilters &&
+      !filterResults_.contains(filterKey)) {
+    filterResults_.clear();
+  }
+  filterResults_[filterKey] = std::move(copy);
+}
+
+DecodedDictionaryCache::DecodedDictionaryCache(
+    memory::MemoryPool* pool,
+    uint64_t maxBytes)
+    : pool_(pool), cache_(maxBytes) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+std::shared_ptr<DecodedDictionary> DecodedDictionaryCache::find(
+    const DecodedDictionaryKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* dictionary = cache_.get(key);
+  if (dictionary == nullptr) {
+    return nullptr;
+  }
+  auto result = *dictionary;
+  cache_.release(key);
+  return result;
+}
+
+std::shared_ptr<DecodedDictionary> DecodedDictionaryCache::insert(
+    const DecodedDictionaryKey& key,
+    const StringView* values,
+    int32_t numValues,
+    const char* strings,
+    uint64_t stringsBytes) {
+  const uint64_t size = numValues * sizeof(StringView) + stringsBytes;
+  if (size > cache_.maxSize()) {
+    return nullptr;
+  }
+  // Copies outside of the lock. A concurrent insert of the same dictionary
+  // makes the add below fail and the copy is dropped.
+  auto valuesCopy = AlignedBuffer::allocate<StringView>(numValues, pool_);
+  auto stringsCopy = AlignedBuffer::allocate<char>(stringsBytes, pool_);
+  auto* rawStrings = stringsCopy->asMutable<char>();
+  if (stringsBytes > 0) {
+    std::memcpy(rawStrings, strings, stringsBytes);
+  }
+  auto* rawValues = valuesCopy->asMutable<StringView>();
+  for (auto i = 0; i < numValues; ++i) {
+    const auto& value = values[i];
+    rawValues[i] = value.isInline()
+        ? value
+        : StringView(rawStrings + (value.data() - strings), value.size());
+  }
+  auto dictionary = std::make_unique<std::shared_ptr<DecodedDictionary>>(
+      std::make_shared<DecodedDictionary>(
+          std::move(valuesCopy), std::move(stringsCopy), numValues));
+  auto result = *dictionary;
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, dictionary.get(), size)) {
+    dictionary.release();
+    return result;
+  }
+  auto* cached = cache_.get(key);
+  if (cached == nullptr) {
+    return nullptr;
+  }
+  result = *cached;
+  cache_.release(key);
+  return result;
+}
+
+void DecodedDictionaryCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.currentSize());
+}
+
+SimpleLRUCacheStats DecodedDictionaryCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+// static
+DecodedDictionaryCache* DecodedDictionaryCache::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void DecodedDictionaryCache::setInstance(DecodedDictionaryCache* cache) {
+  *getInstancePtr() = cache;
+}
+
+// static
+DecodedDictionaryCache** DecodedDictionaryCache::getInstancePtr() {
+  static DecodedDictionaryCache* cache_{nullptr};
+  return &cache_;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+#include <mutex>
+
+#include "velox/buffer/Buffer.h"
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/type/StringView.h"
+
+namespace facebook::velox::cache {
+
+/// Identifies a dictionary by the file it is in and the offset in the file of
+/// the stream it is decoded from.
+struct DecodedDictionaryKey {
+  uint64_t fileNum;
+  uint64_t offset;
+
+  bool operator==(const DecodedDictionaryKey& other) const {
+    return fileNum == other.fileNum && offset == other.offset;
+  }
+};
+
+struct DecodedDictionaryKeyHasher {
+  size_t operator()(const DecodedDictionaryKey& key) const {
+    return folly::hash::hash_combine(key.fileNum, key.offset);
+  }
+};
+
+/// A decoded string dictionary. The StringViews in 'values' point into
+/// 'strings'. Also keeps the results of filters on the values so that the
+/// readers of the dictionary do not evaluate the same filter again.
+class DecodedDictionary {
+ public:
+  /// The maximum number of filters with results kept per dictionary. All are
+  /// dropped when exceeded.
+  static constexpr int32_t kMaxFilters = 8;
+
+  DecodedDictionary(BufferPtr values, BufferPtr strings, int32_t numValues)
+      : values_(std::move(values)),
+        strings_(std::move(strings)),
+        numValues_(numValues) {}
+
+  const BufferPtr& values() const {
+    return values_;
+  }
+
+  const BufferPtr& strings() const {
+    return strings_;
+  }
+
+  int32_t numValues() const {
+    return numValues_;
+  }
+
+  /// Copies the results of the filter serialized as 'filterKey' into
+  /// 'results', which has space for numValues() results. Returns false if
+  /// there are no results for the filter.
+  bool getFilterResults(const std::string& filterKey, uint8_t* results) const;
+
+  /// Keeps the numValues() results of the filter serialized as 'filterKey'
+  /// at 'results'.
+  void setFilterResults(const std::string& filterKey, const uint8_t* results);
+
+ private:
+  const BufferPtr values_;
+  const BufferPtr strings_;
+  const int32_t numValues_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, std::vector<uint8_t>> filterResults_;
+};
+
+/// Keeps string dictionaries decoded by file readers so that the readers of
+/// the same stripe or row group, e.g. from repeated queries or retries, skip
+/// decompressing and decoding the dictionary. Has its own budget, separate
+/// from the capacity of AsyncDataCache, which keeps the encoded bytes. When
+/// the budget is exceeded the least recently used dictionaries are dropped.
+/// Thread-safe.
+class DecodedDictionaryCache {
+ public:
+  /// Allocates the cached dictionaries from 'pool' and keeps at most
+  /// 'maxBytes' of them.
+  DecodedDictionaryCache(memory::MemoryPool* pool, uint64_t maxBytes);
+
+  /// Returns the dictionary for 'key' or nullptr if not cached. The returned
+  /// dictionary stays valid after it is evicted from the cache.
+  std::shared_ptr<DecodedDictionary> find(const DecodedDictionaryKey& key);
+
+  /// Caches a copy of the 'numValues' StringViews at 'values' over the
+  /// 'stringsBytes' bytes at 'strings' as the dictionary for 'key'. Returns
+  /// the cached dictionary, which is the one cached before if 'key' is
+  /// already cached, or nullptr if the dictionary does not fit in the budget.
+  std::shared_ptr<DecodedDictionary> insert(
+      const DecodedDictionaryKey& key,
+      const StringView* values,
+      int32_t numValues,
+      const char* strings,
+      uint64_t stringsBytes);
+
+  /// Drops all dictionaries.
+  void clear();
+
+  SimpleLRUCacheStats stats() const;
+
+  /// Returns the process wide instance or nullptr if decoded dictionaries are
+  /// not cached, which is the default.
+  static DecodedDictionaryCache* getInstance();
+
+  static void setInstance(DecodedDictionaryCache* cache);
+
+ private:
+  static DecodedDictionaryCache** getInstancePtr();
+
+  memory::MemoryPool* const pool_;
+
+  mutable std::mutex mutex_;
+
+  SimpleLRUCache<
+      DecodedDictionaryKey,
+      std::shared_ptr<DecodedDictionary>,
+      std::equal_to<DecodedDictionaryKey>,
+      DecodedDictionaryKeyHasher>
+      cache_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/DecompressedCache.h"
+
+#include <cstring>
+
+namespace facebook::velox::cache {
+
+DecompressedCache::DecompressedCache(
+    memory::MemoryPool* pool,
+    uint64_t maxBytes)
+    : pool_(pool), cache_(maxBytes) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+BufferPtr DecompressedCache::find(const DecompressedBlockKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* buffer = cache_.get(key);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  auto result = *buffer;
+  cache_.release(key);
+  return result;
+}
+
+bool DecompressedCache::contains(const DecompressedBlockKey& key) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.contains(key);
+}
+
+void DecompressedCache::insert(
+    const DecompressedBlockKey& key,
+    const char* data,
+    uint64_t size) {
+  if (size > cache_.maxSize() || contains(key)) {
+    return;
+  }
+  // Copies outside of the lock. A concurrent insert of the same block makes
+  // the add below fail and the copy is dropped.
+  auto buffer =
+      std::make_unique<BufferPtr>(AlignedBuffer::allocate<char>(size, pool_));
+  std::memcpy((*buffer)->asMutable<char>(), data, size);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, buffer.get(), size)) {
+    buffer.release();
+  }
+}
+
+void DecompressedCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.currentSize());
+}
+
+SimpleLRUCacheStats DecompressedCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+// static
+DecompressedCache* DecompressedCache::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void DecompressedCache::setInstance(DecompressedCache* cache) {
+  *getInstancePtr() = cache;
+}
+
+// static
+DecompressedCache** DecompressedCache::getInstancePtr() {
+  static DecompressedCache* cache_{nullptr};
+  return &cache_;
+}
+
+} // namespace facebook::velox::cache
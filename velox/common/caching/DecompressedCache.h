@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/hash/Hash.h>
+#include <mutex>
+
+#include "velox/buffer/Buffer.h"
+#include "velox/common/caching/SimpleLRUCache.h"
+
+namespace facebook::velox::cache {
+
+/// Identifies a compressed block by the file it is in and the offset of its
+/// header in the file.
+struct DecompressedBlockKey {
+  uint64_t fileNum;
+  uint64_t offset;
+
+  bool operator==(const DecompressedBlockKey& other) const {
+    return fileNum == other.fileNum && offset == other.offset;
+  }
+};
+
+struct DecompressedBlockKeyHasher {
+  size_t operator()(const DecompressedBlockKey& key) const {
+    return folly::hash::hash_combine(key.fileNum, key.offset);
+  }
+};
+
+/// Tier next to AsyncDataCache that keeps decompressed blocks of frequently
+/// read streams so that repeated scans of hot columns skip decompression. The
+/// compressed bytes stay in AsyncDataCache. This trades memory for CPU and
+/// has its own budget, separate from the capacity of AsyncDataCache. When the
+/// budget is exceeded the least recently used blocks are dropped, which
+/// demotes them back to their compressed form. Thread-safe.
+class DecompressedCache {
+ public:
+  /// Allocates the cached blocks from 'pool' and keeps at most 'maxBytes' of
+  /// them.
+  DecompressedCache(memory::MemoryPool* pool, uint64_t maxBytes);
+
+  /// Returns the decompressed block for 'key' or nullptr if not cached. The
+  /// returned buffer stays valid after it is evicted from the cache.
+  BufferPtr find(const DecompressedBlockKey& key);
+
+  /// Returns true if 'key' is cached. Does not count as a lookup or make the
+  /// block more recently used.
+  bool contains(const DecompressedBlockKey& key) const;
+
+  /// Caches a copy of the 'size' bytes at 'data' as the decompressed block
+  /// for 'key'. Does nothing if 'key' is already cached or 'size' does not
+  /// fit in the budget.
+  void insert(const DecompressedBlockKey& key, const char* data, uint64_t size);
+
+  /// Drops all unpinned blocks.
+  void clear();
+
+  SimpleLRUCacheStats stats() const;
+
+  /// Returns the process wide instance or nullptr if decompressed blocks are
+  /// not cached, which is the default.
+  static DecompressedCache* getInstance();
+
+  static void setInstance(DecompressedCache* cache);
+
+ private:
+  static DecompressedCache** getInstancePtr();
+
+  memory::MemoryPool* const pool_;
+
+  mutable std::mutex mutex_;
+
+  // The cache owns a BufferPtr per block. Readers hold references to the
+  // buffer, so an entry is never pinned.
+  SimpleLRUCache<
+      DecompressedBlockKey,
+      BufferPtr,
+      std::equal_to<DecompressedBlockKey>,
+      DecompressedBlockKeyHasher>
+      cache_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <algorithm>
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+namespace {
+constexpr uint64_t kSeeds[] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL};
+
+constexpr uint64_t kCounterMask = 0xf;
+// Clears the top bit of each counter after a right shift by one.
+constexpr uint64_t kHalfMask = 0x7777777777777777ULL;
+} // namespace
+
+FrequencySketch::FrequencySketch(uint64_t capacity) {
+  ensureCapacity(capacity);
+}
+
+void FrequencySketch::ensureCapacity(uint64_t capacity) {
+  capacity = std::max<uint64_t>(capacity, 64);
+  if (capacity <= capacity_) {
+    return;
+  }
+  capacity_ = capacity;
+  // A word of 16 counters per key gives each of the 4 counters of a key a
+  // small chance of collision.
+  const auto numWords = bits::nextPowerOfTwo(capacity);
+  table_.assign(numWords, 0);
+  tableMask_ = numWords - 1;
+  sampleSize_ = 10 * capacity;
+  numIncrements_ = 0;
+}
+
+uint64_t FrequencySketch::counterIndex(uint64_t hash, int32_t i, int32_t& shift)
+    const {
+  const auto mixed = folly::hash::twang_mix64(hash ^ kSeeds[i]);
+  // The high 4 bits select one of the 16 counters in the word.
+  shift = static_cast<int32_t>(mixed >> 60) * 4;
+  return mixed & tableMask_;
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  bool incremented = false;
+  for (auto i = 0; i < kNumHashes; ++i) {
+    int32_t shift;
+    auto& word = table_[counterIndex(hash, i, shift)];
+    if (((word >> shift) & kCounterMask) < kMaxCount) {
+      word += 1ULL << shift;
+      incremented = true;
+    }
+  }
+  if (incremented && ++numIncrements_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  int32_t count = kMaxCount;
+  for (auto i = 0; i < kNumHashes; ++i) {
+    int32_t shift;
+    const auto word = table_[counterIndex(hash, i, shift)];
+    count = std::min<int32_t>(count, (word >> shift) & kCounterMask);
+  }
+  return count;
+}
+
+void FrequencySketch::age() {
+  for (auto& word : table_) {
+    word = (word >> 1) & kHalfMask;
+  }
+  numIncrements_ /= 2;
+}
+
+} // namespace facebook::velox::cache
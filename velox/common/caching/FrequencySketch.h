@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Approximate access counts of recently used keys, for scan resistant cache
+/// admission in the manner of TinyLFU. This is a count-min sketch of 4 bit
+/// counters, so that a count saturates at kMaxCount. The sketch remembers keys
+/// that are no longer cached, which lets the cache tell a re-read of evicted
+/// data from a first read. All counts are halved after a sample of 10 accesses
+/// per tracked key so that the counts follow the recent access pattern. Not
+/// thread-safe.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxCount = 15;
+
+  /// Sizes the sketch for about 'capacity' distinct keys.
+  explicit FrequencySketch(uint64_t capacity);
+
+  /// Counts an access to the key with 'hash'.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of recent accesses to the key with 'hash'.
+  int32_t estimate(uint64_t hash) const;
+
+  /// Number of distinct keys the sketch is sized for.
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  /// Resizes the sketch for about 'capacity' distinct keys if this is more
+  /// than the current capacity. The counts are reset.
+  void ensureCapacity(uint64_t capacity);
+
+ private:
+  // Number of counters that are looked up for a key.
+  static constexpr int32_t kNumHashes = 4;
+
+  // Returns the index of the word and sets 'shift' to the bit offset in the
+  // word of the 'i'th counter of 'hash'.
+  uint64_t counterIndex(uint64_t hash, int32_t i, int32_t& shift) const;
+
+  // Halves all counts.
+  void age();
+
+  uint64_t capacity_{0};
+  // Each word holds 16 counters.
+  std::vector<uint64_t> table_;
+  uint64_t tableMask_{0};
+  // Number of increments after which the counts are halved.
+  uint64_t sampleSize_{0};
+  // Number of increments since the counts were last halved.
+  uint64_t numIncrements_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -168,6 +168,12 @@ class SimpleLRUCache {
   /// to manage your own locking.
   Value* get(const Key& key);
 
+  /// Returns true if 'key' is present. Does not pin the element, update its
+  /// recency or count as a lookup.
+  bool contains(const Key& key) const {
+    return keys_.count(key) > 0;
+  }
+
   /// Unpins a key. You MUST call release on every key you have
   /// get'd once are you done using the value or bad things will
   /// happen (namely, memory leaks).
@@ -16,6 +16,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
@@ -59,6 +60,11 @@ SsdCache::SsdCache(const Config& config)
   const uint64_t sizeQuantum = numShards_ * SsdFile::kRegionSize;
   const int32_t fileMaxRegions =
       bits::roundUp(config.maxBytes, sizeQuantum) / sizeQuantum;
+  // Opens the shards in parallel on 'executor_'. Opening a shard recovers its
+  // checkpoint, which dominates the time to restart with a warm cache. A shard
+  // not started by the executor is opened on this thread.
+  std::vector<std::shared_ptr<AsyncSource<SsdFile>>> shards;
+  shards.reserve(numShards_);
   for (auto i = 0; i < numShards_; ++i) {
     const auto fileConfig = SsdFile::Config(
         fmt::format("{}{}", filePrefix_, i),
@@ -68,8 +74,15 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
-    files_.push_back(std::make_unique<SsdFile>(fileConfig));
+        executor_,
+        config.compressionKind);
+    auto shard = std::make_shared<AsyncSource<SsdFile>>(
+        [fileConfig]() { return std::make_unique<SsdFile>(fileConfig); });
+    executor_->add([shard]() { shard->prepare(); });
+    shards.push_back(std::move(shard));
+  }
+  for (auto& shard : shards) {
+    files_.push_back(shard->move());
   }
 }
 
@@ -200,8 +213,20 @@ void SsdCache::shutdown() {
   while (writesInProgress_) {
     std::this_thread::sleep_for(std::chrono::milliseconds(100)); // NOLINT
   }
+  // Checkpoints the shards in parallel on 'executor_'. A checkpoint not
+  // started by the executor runs on this thread.
+  std::vector<std::shared_ptr<AsyncSource<bool>>> checkpoints;
+  checkpoints.reserve(files_.size());
   for (auto& file : files_) {
-    file->checkpoint(true);
+    auto checkpoint = std::make_shared<AsyncSource<bool>>([&file]() {
+      file->checkpoint(true);
+      return std::make_unique<bool>(true);
+    });
+    executor_->add([checkpoint]() { checkpoint->prepare(); });
+    checkpoints.push_back(std::move(checkpoint));
+  }
+  for (auto& checkpoint : checkpoints) {
+    checkpoint->move();
   }
   VELOX_SSD_CACHE_LOG(INFO) << "SSD cache has been shutdown";
 }
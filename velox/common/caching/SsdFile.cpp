@@ -17,6 +17,9 @@
 #include "velox/common/caching/SsdFile.h"
 
 #include <folly/Executor.h>
+#include <folly/FileUtil.h>
+#include <folly/ScopeGuard.h>
+#include <folly/io/Cursor.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Crc.h"
@@ -24,6 +27,7 @@
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -36,10 +40,15 @@
 #include <numeric>
 
 #include "velox/common/base/Counters.h"
+#include "velox/common/base/LatencyHistogram.h"
 #include "velox/common/base/StatsReporter.h"
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_bool(
+    ssd_use_io_uring,
+    true,
+    "Use io_uring for SSD cache IO if Velox is built with io_uring support");
 
 namespace facebook::velox::cache {
 
@@ -137,6 +146,7 @@ SsdFile::SsdFile(const Config& config)
       checksumEnabled_(config.checksumEnabled),
       checksumReadVerificationEnabled_(
           config.checksumEnabled && config.checksumReadVerificationEnabled),
+      compressionKind_(config.compressionKind),
       shardId_(config.shardId),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
       executor_(config.executor) {
@@ -161,7 +171,14 @@ SsdFile::SsdFile(const Config& config)
     disableCow(fd_);
   }
 
-  readFile_ = std::make_unique<LocalReadFile>(fd_);
+  if (FLAGS_ssd_use_io_uring) {
+    ioUring_ = IoUring::instance();
+  }
+  if (ioUring_ != nullptr) {
+    readFile_ = std::make_unique<IoUringReadFile>(fd_, ioUring_);
+  } else {
+    readFile_ = std::make_unique<LocalReadFile>(fd_);
+  }
   const uint64_t size = lseek(fd_, 0, SEEK_END);
   numRegions_ = std::min<int32_t>(size / kRegionSize, maxRegions_);
   fileSize_ = numRegions_ * kRegionSize;
@@ -231,41 +248,75 @@ CoalesceIoStats SsdFile::load(
   if (pins.empty()) {
     return CoalesceIoStats();
   }
+  const auto startUs = getCurrentTimeMicro();
+  SCOPE_EXIT {
+    static auto* const readLatency =
+        LatencyHistogram::get(kMetricSsdCacheReadLatencyUs.str());
+    readLatency->record(getCurrentTimeMicro() - startUs);
+  };
   size_t totalPayloadBytes = 0;
+  bool hasCompressed = false;
   for (auto i = 0; i < pins.size(); ++i) {
-    const auto runSize = ssdPins[i].run().size();
+    const auto run = ssdPins[i].run();
     auto* entry = pins[i].checkedEntry();
-    if (FOLLY_UNLIKELY(runSize < entry->size())) {
+    if (FOLLY_UNLIKELY(run.rawSize() < entry->size())) {
       ++stats_.readSsdErrors;
       VELOX_FAIL(
           "IOERR: SSD cache cache entry {} short than requested range {}",
-          succinctBytes(runSize),
+          succinctBytes(run.rawSize()),
           succinctBytes(entry->size()));
     }
+    hasCompressed |= run.compressed();
     totalPayloadBytes += entry->size();
-    regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
+    regionRead(regionIndex(run.offset()), run.size());
     ++stats_.entriesRead;
     stats_.bytesRead += entry->size();
   }
 
-  // Do coalesced IO for the pins. For short payloads, the break-even between
-  // discrete pread calls and a single preadv that discards gaps is ~25K per
-  // gap. For longer payloads this is ~50-100K.
-  const auto stats = readPins(
-      pins,
-      totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
-      [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
-          int32_t /*begin*/,
-          int32_t /*end*/,
-          uint64_t offset,
-          const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
-      });
+  CoalesceIoStats stats;
+  if (hasCompressed) {
+    // Compressed data does not go directly into the pins. The entries are
+    // read one at a time and copied or decompressed into their pins.
+    auto codec = common::compressionKindToCodec(compressionKind_);
+    for (auto i = 0; i < pins.size(); ++i) {
+      loadEntry(ssdPins[i].run(), *pins[i].checkedEntry(), codec.get());
+      ++stats.numIos;
+      stats.payloadBytes += pins[i].checkedEntry()->size();
+    }
+  } else {
+    std::vector<folly::SemiFuture<uint64_t>> pendingReads;
+    // Do coalesced IO for the pins. For short payloads, the break-even between
+    // discrete pread calls and a single preadv that discards gaps is ~25K per
+    // gap. For longer payloads this is ~50-100K.
+    stats = readPins(
+        pins,
+        totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
+        // Max ranges in one preadv call. Longest gap + longest cache entry are
+        // under 12 ranges. If a system has a limit of 1K ranges, coalesce
+        // limit of 1000 is safe.
+        900,
+        [&](int32_t index) { return ssdPins[index].run().offset(); },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          if (readFile_->hasPreadvAsync()) {
+            pendingReads.push_back(readAsync(offset, buffers));
+          } else {
+            read(offset, buffers);
+          }
+        });
+    // The reads are submitted without waiting, so that the coalesced ranges of
+    // all the pins are read in parallel. All of them are waited for before
+    // reporting an error since they write into the entries of 'pins'.
+    if (!pendingReads.empty()) {
+      auto results = folly::collectAll(std::move(pendingReads)).get();
+      for (auto& result : results) {
+        result.value();
+      }
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -276,6 +327,73 @@ CoalesceIoStats SsdFile::load(
   return stats;
 }
 
+void SsdFile::loadEntry(
+    const SsdRun& run,
+    AsyncDataCacheEntry& entry,
+    folly::io::Codec* codec) {
+  auto buffer = folly::IOBuf::create(run.size());
+  read(
+      run.offset(),
+      {folly::Range<char*>(
+          reinterpret_cast<char*>(buffer->writableData()), run.size())});
+  buffer->append(run.size());
+  std::unique_ptr<folly::IOBuf> data;
+  if (run.compressed()) {
+    VELOX_CHECK_NOT_NULL(
+        codec, "No codec for compressed SSD cache entry in {}", fileName_);
+    data = codec->uncompress(buffer.get(), run.rawSize());
+  } else {
+    data = std::move(buffer);
+  }
+  VELOX_CHECK_GE(data->computeChainDataLength(), entry.size());
+  folly::io::Cursor cursor(data.get());
+  if (entry.tinyData() != nullptr) {
+    cursor.pull(entry.tinyData(), entry.size());
+    return;
+  }
+  const auto& allocation = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < allocation.numRuns() && bytesLeft > 0; ++i) {
+    const auto allocationRun = allocation.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, allocationRun.numBytes());
+    cursor.pull(allocationRun.data<char>(), size);
+    bytesLeft -= size;
+  }
+}
+
+std::unique_ptr<folly::IOBuf> SsdFile::compressEntry(
+    const AsyncDataCacheEntry& entry,
+    folly::io::Codec* codec) const {
+  if (codec == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<folly::IOBuf> data;
+  if (entry.tinyData() != nullptr) {
+    data = folly::IOBuf::wrapBuffer(entry.tinyData(), entry.size());
+  } else {
+    const auto& allocation = entry.data();
+    int64_t bytesLeft = entry.size();
+    for (auto i = 0; i < allocation.numRuns() && bytesLeft > 0; ++i) {
+      const auto run = allocation.runAt(i);
+      const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+      auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), size);
+      if (data == nullptr) {
+        data = std::move(buffer);
+      } else {
+        data->prependChain(std::move(buffer));
+      }
+      bytesLeft -= size;
+    }
+  }
+  auto compressed = codec->compress(data.get());
+  if (compressed->computeChainDataLength() * 100 >
+      entry.size() * (100 - kMinCompressionSavingPct)) {
+    return nullptr;
+  }
+  compressed->coalesce();
+  return compressed;
+}
+
 void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
@@ -283,8 +401,14 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+folly::SemiFuture<uint64_t> SsdFile::readAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  return readFile_->preadvAsync(offset, buffers);
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -299,13 +423,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -385,9 +508,24 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The entries that compress are written in compressed form. 'sizes' are the
+  // sizes of the data written for each of 'pins'.
+  std::unique_ptr<folly::io::Codec> codec;
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    codec = common::compressionKindToCodec(compressionKind_);
+  }
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  std::vector<uint32_t> sizes(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    const auto* entry = pins[i].checkedEntry();
+    compressed[i] = compressEntry(*entry, codec.get());
+    sizes[i] =
+        compressed[i] != nullptr ? compressed[i]->length() : entry->size();
+  }
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(sizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -401,8 +539,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     std::vector<iovec> writeIovecs;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto entrySize = sizes[i];
+      const auto numIovecs =
+          compressed[i] != nullptr ? 1 : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
@@ -419,7 +558,11 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (compressed[i] != nullptr) {
+        writeIovecs.push_back({compressed[i]->writableData(), entrySize});
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -441,16 +584,24 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = sizes[i];
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
         uint32_t checksum = 0;
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
-        if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+        const auto run = SsdRun(
+            offset,
+            size,
+            checksum,
+            compressed[i] != nullptr ? entry->size() : 0);
+        entries_[std::move(key)] = run;
+        if (run.compressed()) {
+          ++stats_.entriesCompressed;
+          stats_.bytesSavedByCompression += entry->size() - size;
+        } else if (FLAGS_ssd_verify_write) {
+          verifyWrite(*entry, run);
         }
         offset += size;
         ++stats_.entriesWritten;
@@ -470,6 +621,19 @@ bool SsdFile::write(
     uint64_t offset,
     uint64_t length,
     const std::vector<iovec>& iovecs) {
+  if (ioUring_ != nullptr) {
+    try {
+      ioUring_->submit({{fd_, offset, iovecs, /*write=*/true}}).get();
+      return true;
+    } catch (const std::exception& e) {
+      VELOX_SSD_CACHE_LOG(ERROR)
+          << "Failed to write to SSD, file name: " << fileName_
+          << ", fd: " << fd_ << ", size: " << iovecs.size()
+          << ", offset: " << offset << ", error: " << e.what();
+      ++stats_.writeSsdErrors;
+      return false;
+    }
+  }
   const auto ret = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
   if (ret == length) {
     return true;
@@ -528,6 +692,8 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   std::shared_lock<std::shared_mutex> l(mutex_);
   stats.entriesWritten += stats_.entriesWritten;
   stats.bytesWritten += stats_.bytesWritten;
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.bytesSavedByCompression += stats_.bytesSavedByCompression;
   stats.checkpointsWritten += stats_.checkpointsWritten;
   stats.entriesRead += stats_.entriesRead;
   stats.bytesRead += stats_.bytesRead;
@@ -554,6 +720,8 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
   stats.readSsdCorruptions += stats_.readSsdCorruptions;
+  stats.checkpointDurationUs += stats_.checkpointDurationUs;
+  stats.checkpointStallUs += stats_.checkpointStallUs;
 }
 
 void SsdFile::testingClear() {
@@ -719,19 +887,68 @@ inline const char* asChar(const T* ptr) {
 
 void SsdFile::checkpoint(bool force) {
   process::TraceContext trace("SsdFile::checkpoint");
-  std::lock_guard<std::shared_mutex> l(mutex_);
-  if (!needCheckpoint(force)) {
+  // A checkpoint triggered by a write is skipped if another one is in
+  // progress. The bytes written meanwhile are covered by the next one.
+  std::unique_lock<std::mutex> checkpointLock(checkpointMutex_, std::defer_lock);
+  if (force) {
+    checkpointLock.lock();
+  } else if (!checkpointLock.try_lock()) {
     return;
   }
 
-  VELOX_SSD_CACHE_LOG(INFO)
-      << "Checkpointing shard " << shardId_ << ", force: " << force
-      << " bytesAfterCheckpoint: " << succinctBytes(bytesAfterCheckpoint_)
-      << " checkpointIntervalBytes: "
-      << succinctBytes(checkpointIntervalBytes_);
+  const auto startUs = getCurrentTimeMicro();
+  // The state to write, copied under 'mutex_' so that the checkpoint file is
+  // written without blocking reads and writes of 'this'.
+  struct CheckpointEntry {
+    uint64_t fileNum;
+    uint64_t offset;
+    uint64_t fileBits;
+    uint32_t checksum;
+    uint32_t rawSize;
+  };
+  int32_t numRegions;
+  std::vector<uint64_t> scores;
+  std::vector<std::pair<uint64_t, std::string>> fileNames;
+  std::vector<CheckpointEntry> entries;
+  // Position of the eviction log at the time of the copy. The evictions
+  // logged after this are not reflected in the checkpoint.
+  off_t evictLogOffset;
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    if (!needCheckpoint(force)) {
+      return;
+    }
+
+    VELOX_SSD_CACHE_LOG(INFO)
+        << "Checkpointing shard " << shardId_ << ", force: " << force
+        << " bytesAfterCheckpoint: " << succinctBytes(bytesAfterCheckpoint_)
+        << " checkpointIntervalBytes: "
+        << succinctBytes(checkpointIntervalBytes_);
+
+    checkpointDeleted_ = false;
+    bytesAfterCheckpoint_ = 0;
+    numRegions = numRegions_;
+    scores = tracker_.copyScores();
+    entries.reserve(entries_.size());
+    // The names are looked up while the entries hold a reference to their
+    // file ids.
+    std::unordered_set<uint64_t> fileNums;
+    for (const auto& [key, run] : entries_) {
+      const auto fileNum = key.fileNum.id();
+      if (fileNums.insert(fileNum).second) {
+        fileNames.emplace_back(fileNum, fileIds().string(fileNum));
+      }
+      entries.push_back(
+          {fileNum,
+           key.offset,
+           run.fileBits(),
+           checksumEnabled_ ? run.checksum() : 0,
+           run.compressed() ? run.rawSize() : 0});
+    }
+    evictLogOffset = ::lseek(evictLogFd_, 0, SEEK_CUR);
+    stats_.checkpointStallUs += getCurrentTimeMicro() - startUs;
+  }
 
-  checkpointDeleted_ = false;
-  bytesAfterCheckpoint_ = 0;
   try {
     const auto checkRc = [&](int32_t rc, const std::string& errMsg) {
       if (rc < 0) {
@@ -739,6 +956,7 @@ void SsdFile::checkpoint(bool force) {
       }
       return rc;
     };
+    checkRc(evictLogOffset, "Seek of evict log");
 
     // We schedule the potentially long fsync of the cache file on another
     // thread of the cache write executor, if available. If there is none, we do
@@ -756,43 +974,42 @@ void SsdFile::checkpoint(bool force) {
       state.open(checkpointPath, std::ios_base::out | std::ios_base::trunc);
       // The checkpoint state file contains:
       // int32_t The 4 bytes of checkpoint version,
+      // int32_t compression kind if compression is enabled,
       // int32_t maxRegions,
       // int32_t numRegions,
       // regionScores from the 'tracker_',
       // {fileId, fileName} pairs,
       // kMapMarker,
-      // {fileId, offset, SSdRun} triples,
+      // {fileId, offset, SSdRun} triples, where the SsdRun has its checksum
+      // if checksum is enabled and its uncompressed size if compression is
+      // enabled,
       // kEndMarker.
       state.write(checkpointVersion().data(), sizeof(int32_t));
+      if (compressionKind_ != common::CompressionKind_NONE) {
+        const int32_t compressionKind = compressionKind_;
+        state.write(asChar(&compressionKind), sizeof(compressionKind));
+      }
       state.write(asChar(&maxRegions_), sizeof(maxRegions_));
-      state.write(asChar(&numRegions_), sizeof(numRegions_));
-
-      // Copy the region scores before writing out for tsan.
-      const auto scoresCopy = tracker_.copyScores();
-      state.write(asChar(scoresCopy.data()), maxRegions_ * sizeof(uint64_t));
-      std::unordered_set<uint64_t> fileNums;
-      for (const auto& entry : entries_) {
-        const auto fileNum = entry.first.fileNum.id();
-        if (fileNums.insert(fileNum).second) {
-          state.write(asChar(&fileNum), sizeof(fileNum));
-          const auto name = fileIds().string(fileNum);
-          const int32_t length = name.size();
-          state.write(asChar(&length), sizeof(length));
-          state.write(name.data(), length);
-        }
+      state.write(asChar(&numRegions), sizeof(numRegions));
+      state.write(asChar(scores.data()), maxRegions_ * sizeof(uint64_t));
+      for (const auto& [fileNum, name] : fileNames) {
+        state.write(asChar(&fileNum), sizeof(fileNum));
+        const int32_t length = name.size();
+        state.write(asChar(&length), sizeof(length));
+        state.write(name.data(), length);
       }
 
       const auto mapMarker = kCheckpointMapMarker;
       state.write(asChar(&mapMarker), sizeof(mapMarker));
-      for (auto& pair : entries_) {
-        const auto id = pair.first.fileNum.id();
-        state.write(asChar(&id), sizeof(id));
-        state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
-        const auto offsetAndSize = pair.second.fileBits();
-        state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      for (const auto& entry : entries) {
+        state.write(asChar(&entry.fileNum), sizeof(entry.fileNum));
+        state.write(asChar(&entry.offset), sizeof(entry.offset));
+        state.write(asChar(&entry.fileBits), sizeof(entry.fileBits));
         if (checksumEnabled_) {
-          const auto checksum = pair.second.checksum();
-          state.write(asChar(&checksum), sizeof(checksum));
+          state.write(asChar(&entry.checksum), sizeof(entry.checksum));
+        }
+        if (compressionKind_ != common::CompressionKind_NONE) {
+          state.write(asChar(&entry.rawSize), sizeof(entry.rawSize));
         }
       }
     } catch (const std::exception& e) {
@@ -811,8 +1028,6 @@ void SsdFile::checkpoint(bool force) {
     if (state.bad()) {
       ++stats_.writeCheckpointErrors;
       checkRc(-1, "Write of checkpoint file");
-    } else {
-      ++stats_.checkpointsWritten;
     }
     state.close();
 
@@ -830,13 +1045,27 @@ void SsdFile::checkpoint(bool force) {
     checkRc(::fsync(checkpointFd), "Sync of checkpoint file");
     ::close(checkpointFd);
 
+    const auto relockUs = getCurrentTimeMicro();
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    SCOPE_EXIT {
+      const auto endUs = getCurrentTimeMicro();
+      stats_.checkpointStallUs += endUs - relockUs;
+      stats_.checkpointDurationUs += endUs - startUs;
+    };
+    if (checkpointDeleted_) {
+      // The checkpoint was deleted after an error in logging an eviction
+      // while it was written. The evictions are then not in the log.
+      ::unlink(checkpointPath.c_str());
+      return;
+    }
+    ++stats_.checkpointsWritten;
     // NOTE: we shall truncate eviction log after checkpoint file sync
     // completes so that we never recover from an old checkpoint file without
     // log evictions. The latter might lead to data consistent issue.
-    checkRc(::ftruncate(evictLogFd_, 0), "Truncate of event log");
-    checkRc(::fsync(evictLogFd_), "Sync of evict log");
+    truncateEvictLogLocked(evictLogOffset);
   } catch (const std::exception& e) {
     try {
+      std::lock_guard<std::shared_mutex> l(mutex_);
       checkpointError(-1, e.what());
     } catch (const std::exception&) {
     }
@@ -844,13 +1073,45 @@ void SsdFile::checkpoint(bool force) {
   }
 }
 
+void SsdFile::truncateEvictLogLocked(off_t offset) {
+  const auto checkRc = [&](int64_t rc, const std::string& errMsg) {
+    if (rc < 0) {
+      VELOX_FAIL("{} with rc {} :{}", errMsg, rc, folly::errnoStr(errno));
+    }
+    return rc;
+  };
+  const auto end = checkRc(::lseek(evictLogFd_, 0, SEEK_CUR), "Seek of log");
+  VELOX_CHECK_GE(end, offset);
+  std::string tail(end - offset, '\0');
+  if (!tail.empty()) {
+    const auto rc = checkRc(
+        folly::preadFull(evictLogFd_, tail.data(), tail.size(), offset),
+        "Read of evict log");
+    VELOX_CHECK_EQ(rc, tail.size(), "Short read of evict log");
+    // Until the truncate, the tail moved to the start is followed by older
+    // evictions. Applying these again at recovery drops more cached data than
+    // needed but never recovers an evicted entry.
+    checkRc(
+        folly::pwriteFull(evictLogFd_, tail.data(), tail.size(), 0),
+        "Write of evict log");
+  }
+  checkRc(::ftruncate(evictLogFd_, tail.size()), "Truncate of event log");
+  checkRc(::lseek(evictLogFd_, tail.size(), SEEK_SET), "Seek of evict log");
+  checkRc(::fsync(evictLogFd_), "Sync of evict log");
+}
+
 void SsdFile::initializeCheckpoint() {
   if (!checkpointEnabled()) {
     return;
   }
 
   bool hasCheckpoint = true;
-  std::ifstream state(getCheckpointFilePath());
+  // The checkpoint is read in small fields. A large stream buffer turns these
+  // into few large reads.
+  std::vector<char> stateBuffer(kCheckpointReadBufferSize);
+  std::ifstream state;
+  state.rdbuf()->pubsetbuf(stateBuffer.data(), stateBuffer.size());
+  state.open(getCheckpointFilePath());
   if (!state.is_open()) {
     hasCheckpoint = false;
     ++stats_.openCheckpointErrors;
@@ -916,12 +1177,12 @@ void SsdFile::maybeVerifyChecksum(
   if (!checksumReadVerificationEnabled_) {
     return;
   }
-  VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
-  if (ssdRun.size() != entry.size()) {
+  VELOX_DCHECK_EQ(ssdRun.rawSize(), entry.size());
+  if (ssdRun.rawSize() != entry.size()) {
     ++stats_.readWithoutChecksumChecks;
     VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
         << "SSD read without checksum due to cache request size mismatch, SSD cache size "
-        << ssdRun.size() << " request size " << entry.size()
+        << ssdRun.rawSize() << " request size " << entry.size()
         << ", cache request: " << entry.toString();
     return;
   }
@@ -975,6 +1236,20 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
         shardId_);
     return;
   }
+  const auto checkpointHasCompression =
+      isCompressionEnabledOnCheckpointVersion(std::string(versionMagic, 4));
+  if (checkpointHasCompression) {
+    const auto compressionKind = readNumber<int32_t>(state);
+    if (compressionKind != compressionKind_) {
+      VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+          "Starting shard {} without checkpoint: the checkpoint was made with compression {}, which differs from {}.",
+          shardId_,
+          common::compressionKindToString(
+              static_cast<common::CompressionKind>(compressionKind)),
+          common::compressionKindToString(compressionKind_));
+      return;
+    }
+  }
 
   const auto maxRegions = readNumber<int32_t>(state);
   VELOX_CHECK_EQ(
@@ -1016,7 +1291,11 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     if (checkpoinHasChecksum) {
       checksum = readNumber<uint32_t>(state);
     }
-    const auto run = SsdRun(fileBits, checksum);
+    uint32_t rawSize = 0;
+    if (checkpointHasCompression) {
+      rawSize = readNumber<uint32_t>(state);
+    }
+    const auto run = SsdRun(fileBits, checksum, rawSize);
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
       // The file may have a different id on restore.
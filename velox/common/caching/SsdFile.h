@@ -18,32 +18,45 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/IoUring.h"
 
 #include <gflags/gflags.h>
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_bool(ssd_use_io_uring);
 
 namespace facebook::velox::cache {
 
 /// A 64 bit word describing a SSD cache entry in an SsdFile. The low 23 bits
 /// are the size, for a maximum entry size of 8MB. The high bits are the offset.
+/// A compressed entry also records its uncompressed size.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() : fileBits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
-      : fileBits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
+  /// 'size' is the size of the data at 'offset'. 'rawSize' is the size of the
+  /// entry after decompression or 0 if the data is not compressed.
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      uint32_t rawSize = 0)
+      : fileBits_((offset << kSizeBits) | ((size - 1))),
+        checksum_(checksum),
+        rawSize_(rawSize) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
+    VELOX_CHECK_LE(rawSize, 1 << kSizeBits);
   }
 
-  SsdRun(uint64_t fileBits, uint32_t checksum)
-      : fileBits_(fileBits), checksum_(checksum) {}
+  SsdRun(uint64_t fileBits, uint32_t checksum, uint32_t rawSize = 0)
+      : fileBits_(fileBits), checksum_(checksum), rawSize_(rawSize) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
@@ -51,10 +64,12 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    rawSize_ = other.rawSize_;
   }
   void operator=(SsdRun&& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    rawSize_ = other.rawSize_;
   }
 
   uint64_t offset() const {
@@ -65,7 +80,17 @@ class SsdRun {
     return (fileBits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
-  /// Returns the checksum computed with crc32.
+  /// Returns the size of the cache entry, which is size() unless the entry is
+  /// compressed.
+  uint32_t rawSize() const {
+    return rawSize_ == 0 ? size() : rawSize_;
+  }
+
+  bool compressed() const {
+    return rawSize_ != 0;
+  }
+
+  /// Returns the checksum computed with crc32 over the uncompressed data.
   uint32_t checksum() const {
     return checksum_;
   }
@@ -79,6 +104,8 @@ class SsdRun {
   // Contains the file offset and size.
   uint64_t fileBits_;
   uint32_t checksum_;
+  // Uncompressed size of a compressed entry, 0 if not compressed.
+  uint32_t rawSize_{0};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -139,6 +166,8 @@ struct SsdCacheStats {
   void operator=(const SsdCacheStats& other) {
     entriesWritten = tsanAtomicValue(other.entriesWritten);
     bytesWritten = tsanAtomicValue(other.bytesWritten);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    bytesSavedByCompression = tsanAtomicValue(other.bytesSavedByCompression);
     checkpointsWritten = tsanAtomicValue(other.checkpointsWritten);
     entriesRead = tsanAtomicValue(other.entriesRead);
     bytesRead = tsanAtomicValue(other.bytesRead);
@@ -164,12 +193,17 @@ struct SsdCacheStats {
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
     readWithoutChecksumChecks =
         tsanAtomicValue(other.readWithoutChecksumChecks);
+    checkpointDurationUs = tsanAtomicValue(other.checkpointDurationUs);
+    checkpointStallUs = tsanAtomicValue(other.checkpointStallUs);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
     SsdCacheStats result;
     result.entriesWritten = entriesWritten - other.entriesWritten;
     result.bytesWritten = bytesWritten - other.bytesWritten;
+    result.entriesCompressed = entriesCompressed - other.entriesCompressed;
+    result.bytesSavedByCompression =
+        bytesSavedByCompression - other.bytesSavedByCompression;
     result.checkpointsWritten = checkpointsWritten - other.checkpointsWritten;
     result.entriesRead = entriesRead - other.entriesRead;
     result.bytesRead = bytesRead - other.bytesRead;
@@ -194,6 +228,9 @@ struct SsdCacheStats {
         readCheckpointErrors - other.readCheckpointErrors;
     result.readWithoutChecksumChecks =
         readWithoutChecksumChecks - other.readWithoutChecksumChecks;
+    result.checkpointDurationUs =
+        checkpointDurationUs - other.checkpointDurationUs;
+    result.checkpointStallUs = checkpointStallUs - other.checkpointStallUs;
     return result;
   }
 
@@ -206,6 +243,9 @@ struct SsdCacheStats {
   /// Cumulative stats
   tsan_atomic<uint64_t> entriesWritten{0};
   tsan_atomic<uint64_t> bytesWritten{0};
+  /// Entries written compressed and the bytes the compression saved.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  tsan_atomic<uint64_t> bytesSavedByCompression{0};
   tsan_atomic<uint64_t> checkpointsWritten{0};
   tsan_atomic<uint64_t> entriesRead{0};
   tsan_atomic<uint64_t> bytesRead{0};
@@ -225,6 +265,11 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
   tsan_atomic<uint32_t> readWithoutChecksumChecks{0};
+  /// Total time spent in writing checkpoints.
+  tsan_atomic<uint64_t> checkpointDurationUs{0};
+  /// Part of 'checkpointDurationUs' during which reads and writes of the SSD
+  /// file were blocked.
+  tsan_atomic<uint64_t> checkpointStallUs{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -244,7 +289,8 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        common::CompressionKind _compressionKind = common::CompressionKind_NONE)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -253,7 +299,8 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -279,10 +326,17 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// Codec for compressing the entries written to the file. An entry is
+    /// written as is if compression does not make it smaller by at least
+    /// kMinCompressionSavingPct.
+    common::CompressionKind compressionKind;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
 
+  static constexpr int32_t kMinCompressionSavingPct = 10;
+
   /// Constructs a cache backed by filename. Discards any previous contents of
   /// filename.
   SsdFile(const Config& config);
@@ -347,10 +401,13 @@ class SsdFile {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
-  /// Writes a checkpoint state that can be recovered from. The
-  /// checkpoint is serialized on 'mutex_'. If 'force' is false,
-  /// rechecks that at least 'checkpointIntervalBytes_' have been
-  /// written since last checkpoint and silently returns if not.
+  /// Writes a checkpoint state that can be recovered from. The state is
+  /// copied under 'mutex_' and written and synced after releasing it, so
+  /// that reads and writes of 'this' are not blocked by the checkpoint IO.
+  /// Checkpoints of 'this' are serialized. If 'force' is false, rechecks that
+  /// at least 'checkpointIntervalBytes_' have been written since last
+  /// checkpoint and silently returns if not or if another checkpoint is in
+  /// progress.
   void checkpoint(bool force = false);
 
   /// Deletes checkpoint files. If 'keepLog' is true, truncates and syncs the
@@ -407,12 +464,19 @@ class SsdFile {
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
   // Magic number at end of completed checkpoint file.
   static constexpr int64_t kCheckpointEndMarker = 0xcbedf11e;
+  // Size of the stream buffer for reading a checkpoint file at startup.
+  static constexpr int32_t kCheckpointReadBufferSize = 1 << 20; // 1MB
 
   static constexpr int kMaxErasedSizePct = 50;
 
   // The first 4 bytes of a checkpoint file contains version string to indicate
-  // if checksum write is enabled or not.
+  // if checksum write is enabled or not. A checkpoint of a file with
+  // compression has a distinct version, followed by the compression kind, and
+  // records the uncompressed size of each entry.
   std::string checkpointVersion() const {
+    if (compressionKind_ != common::CompressionKind_NONE) {
+      return checksumEnabled_ ? "CPZ2" : "CPZ1";
+    }
     return checksumEnabled_ ? "CPT2" : "CPT1";
   }
 
@@ -426,8 +490,9 @@ class SsdFile {
   // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
   // if there is no space. The space does not necessarily cover all the pins, so
   // multiple calls starting at the first unwritten pin may be needed.
+  // 'sizes' are the sizes of the data of 'pins' to write.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& sizes,
       int32_t begin);
 
   // Removes all 'entries_' that reference data in regions described by
@@ -441,9 +506,27 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Starts reading the backing file with ReadFile::preadvAsync().
+  folly::SemiFuture<uint64_t> readAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
+  // Returns the compressed data of 'entry' or nullptr if compression is not
+  // enabled or does not save at least kMinCompressionSavingPct.
+  std::unique_ptr<folly::IOBuf> compressEntry(
+      const AsyncDataCacheEntry& entry,
+      folly::io::Codec* codec) const;
+
+  // Reads the data at 'run' and copies it into 'entry', decompressing it if
+  // 'run' is compressed.
+  void loadEntry(
+      const SsdRun& run,
+      AsyncDataCacheEntry& entry,
+      folly::io::Codec* codec);
+
   // Reads a checkpoint state file and sets 'this' accordingly if read is
   // successful. Return true for successful read. A failed read deletes the
   // checkpoint and leaves the log truncated open.
@@ -453,6 +536,11 @@ class SsdFile {
   // checkpoints.
   void checkpointError(int32_t rc, const std::string& error);
 
+  // Drops the part of the eviction log before 'offset' after a checkpoint
+  // that includes these evictions has been synced. The evictions logged at and
+  // after 'offset' took place while the checkpoint was written and are kept.
+  void truncateEvictLogLocked(off_t offset);
+
   // Looks for a checkpointed state and sets the state of 'this' by
   // the checkpointed state iif the state is complete and
   // readable. Does not modify 'this' if the state is corrupt,
@@ -492,7 +580,14 @@ class SsdFile {
   // Returns true if checksum write is enabled for the given version.
   static bool isChecksumEnabledOnCheckpointVersion(
       const std::string& checkpointVersion) {
-    return checkpointVersion == "CPT2";
+    return checkpointVersion == "CPT2" || checkpointVersion == "CPZ2";
+  }
+
+  // Returns true if the checkpoint of the given version was made with
+  // compression.
+  static bool isCompressionEnabledOnCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion == "CPZ1" || checkpointVersion == "CPZ2";
   }
 
   static constexpr const char* kLogExtension = ".log";
@@ -513,12 +608,19 @@ class SsdFile {
   // If true, checksum read verification from SSD is enabled.
   const bool checksumReadVerificationEnabled_;
 
+  // Codec for the entries written to the file.
+  const common::CompressionKind compressionKind_;
+
   // Shard index within 'cache_'.
   const int32_t shardId_;
 
   // Serializes access to all private data members.
   mutable std::shared_mutex mutex_;
 
+  // Serializes checkpoints. Held while writing a checkpoint, without holding
+  // 'mutex_' for the file IO.
+  std::mutex checkpointMutex_;
+
   // Number of kRegionSize regions in the file.
   int32_t numRegions_{0};
 
@@ -555,6 +657,10 @@ class SsdFile {
   // ReadFile made from 'fd_'.
   std::unique_ptr<ReadFile> readFile_;
 
+  // Submits the reads and writes of 'fd_' if io_uring is used. The coalesced
+  // reads of a load() are then submitted together.
+  IoUring* ioUring_{nullptr};
+
   // Counters.
   SsdCacheStats stats_;
 
@@ -1388,6 +1388,94 @@ TEST_P(AsyncDataCacheTest, makeEvictable) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, frequencyAdmission) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr int32_t kDataSize = 1 << 20;
+  initializeCache(
+      kRamBytes, 0, 0, AsyncDataCache::Options(0.7, 0.125, 1 << 24, 2));
+  auto key = [&](int32_t index) {
+    return RawFileCacheKey{
+        filenames_[0].id(), static_cast<uint64_t>(index) * kDataSize};
+  };
+  auto load = [&](int32_t index, bool dense = false) {
+    folly::SemiFuture<bool> wait(false);
+    auto pin = cache_->findOrCreate(key(index), kDataSize, &wait);
+    VELOX_CHECK(!pin.empty());
+    if (pin.entry()->isExclusive()) {
+      if (dense) {
+        pin.entry()->setDense();
+      }
+      pin.entry()->setExclusiveToShared(false);
+    }
+    return pin;
+  };
+
+  // A second access admits an entry.
+  ASSERT_TRUE(load(0).entry()->isProbation());
+  ASSERT_FALSE(load(0).entry()->isProbation());
+  // A densely read column is admitted on first access.
+  ASSERT_FALSE(load(1, true).entry()->isProbation());
+
+  // A one-off scan of the size of the cache does not evict the admitted
+  // entries.
+  for (auto i = 2; i < 66; ++i) {
+    ASSERT_TRUE(load(i).entry()->isProbation());
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_GT(stats.numProbationEvict, 0);
+  ASSERT_EQ(stats.numReadmit, 0);
+  ASSERT_TRUE(cache_->exists(key(0)));
+  ASSERT_TRUE(cache_->exists(key(1)));
+
+  // A miss on a recently accessed key is admitted right away.
+  cache_->testingClear();
+  ASSERT_FALSE(load(0).entry()->isProbation());
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numReadmit, 1);
+  ASSERT_EQ(stats.numHit, 1);
+}
+
+TEST_P(AsyncDataCacheTest, numaLocal) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr int32_t kDataSize = 1 << 20;
+  initializeCache(
+      kRamBytes,
+      0,
+      0,
+      AsyncDataCache::Options(0.7, 0.125, 1 << 24, 0, true));
+  const auto numNodes = process::numaNodeCount();
+  for (auto node = 0; node < numNodes; ++node) {
+    std::thread thread([&]() {
+      const bool bound = process::bindCurrentThreadToNumaNode(node);
+      const RawFileCacheKey key{
+          filenames_[0].id(), static_cast<uint64_t>(node) * kDataSize};
+      auto pin = cache_->findOrCreate(key, kDataSize, nullptr);
+      ASSERT_TRUE(pin.entry()->isExclusive());
+      if (bound) {
+        ASSERT_EQ(node, pin.entry()->numaNode());
+      }
+      initializeContents(key.fileNum + key.offset, pin.entry()->data());
+      pin.entry()->setExclusiveToShared();
+      checkContents(*pin.entry());
+    });
+    thread.join();
+  }
+  // Hits from the node of the creator are not counted.
+  for (auto node = 0; node < numNodes; ++node) {
+    std::thread thread([&]() {
+      if (!process::bindCurrentThreadToNumaNode(node)) {
+        return;
+      }
+      const RawFileCacheKey key{
+          filenames_[0].id(), static_cast<uint64_t>(node) * kDataSize};
+      auto pin = cache_->findOrCreate(key, kDataSize, nullptr);
+      ASSERT_FALSE(pin.entry()->isExclusive());
+    });
+    thread.join();
+  }
+  ASSERT_EQ(cache_->refreshStats().numCrossNodeHit, 0);
+}
+
 TEST_P(AsyncDataCacheTest, ssdWriteOptions) {
   constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
   constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
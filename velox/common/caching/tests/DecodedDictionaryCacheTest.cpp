@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/DecodedDictionaryCache.h"
+#include "velox/common/memory/Memory.h"
+
+#include <fmt/format.h>
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+class DecodedDictionaryCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Inserts a dictionary of 'numValues' strings of 20 characters for 'key'.
+  std::shared_ptr<DecodedDictionary> insert(
+      DecodedDictionaryCache& cache,
+      const DecodedDictionaryKey& key,
+      int32_t numValues,
+      char fill = 'a') {
+    std::string strings;
+    std::vector<StringView> values;
+    for (auto i = 0; i < numValues; ++i) {
+      strings += std::string(19, fill) + static_cast<char>('0' + i % 10);
+    }
+    for (auto i = 0; i < numValues; ++i) {
+      values.emplace_back(strings.data() + i * 20, 20);
+    }
+    return cache.insert(
+        key, values.data(), numValues, strings.data(), strings.size());
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+};
+
+TEST_F(DecodedDictionaryCacheTest, findAndInsert) {
+  DecodedDictionaryCache cache(pool_.get(), 10'000);
+  const DecodedDictionaryKey key{1, 100};
+  EXPECT_EQ(cache.find(key), nullptr);
+
+  auto inserted = insert(cache, key, 10);
+  ASSERT_NE(inserted, nullptr);
+  auto dictionary = cache.find(key);
+  EXPECT_EQ(dictionary, inserted);
+  ASSERT_EQ(dictionary->numValues(), 10);
+  // The values point into the copied strings.
+  auto* values = dictionary->values()->as<StringView>();
+  auto* strings = dictionary->strings()->as<char>();
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_EQ(values[i].data(), strings + i * 20);
+    EXPECT_EQ(values[i].str(), std::string(19, 'a') + char('0' + i));
+  }
+
+  // The same offset in another file is a different dictionary.
+  EXPECT_EQ(cache.find({2, 100}), nullptr);
+
+  // Inserting a cached dictionary returns the first copy.
+  EXPECT_EQ(insert(cache, key, 10, 'b'), inserted);
+  EXPECT_EQ(cache.stats().numElements, 1);
+  EXPECT_EQ(cache.stats().curSize, 10 * (sizeof(StringView) + 20));
+}
+
+TEST_F(DecodedDictionaryCacheTest, evict) {
+  const int64_t size = 10 * (sizeof(StringView) + 20);
+  DecodedDictionaryCache cache(pool_.get(), 2 * size + 1);
+  insert(cache, {1, 0}, 10);
+  insert(cache, {1, 1}, 10);
+  // Makes the first dictionary the most recently used.
+  auto dictionary = cache.find({1, 0});
+  insert(cache, {1, 2}, 10);
+  EXPECT_NE(cache.find({1, 0}), nullptr);
+  EXPECT_EQ(cache.find({1, 1}), nullptr);
+  EXPECT_NE(cache.find({1, 2}), nullptr);
+
+  // A dictionary larger than the budget is not cached.
+  EXPECT_EQ(insert(cache, {1, 3}, 100), nullptr);
+  EXPECT_EQ(cache.find({1, 3}), nullptr);
+
+  // A dictionary that was returned stays valid after it is evicted.
+  cache.clear();
+  EXPECT_EQ(cache.find({1, 0}), nullptr);
+  EXPECT_EQ(cache.stats().curSize, 0);
+  EXPECT_EQ(
+      dictionary->values()->as<StringView>()[9].str(),
+      std::string(19, 'a') + '9');
+}
+
+TEST_F(DecodedDictionaryCacheTest, filterResults) {
+  DecodedDictionaryCache cache(pool_.get(), 10'000);
+  auto dictionary = insert(cache, {1, 0}, 4);
+  std::vector<uint8_t> results(4);
+  EXPECT_FALSE(dictionary->getFilterResults("f1", results.data()));
+
+  const std::vector<uint8_t> f1Results = {0, 0x80, 0x40, 0x80};
+  dictionary->setFilterResults("f1", f1Results.data());
+  EXPECT_TRUE(dictionary->getFilterResults("f1", results.data()));
+  EXPECT_EQ(results, f1Results);
+  EXPECT_FALSE(dictionary->getFilterResults("f2", results.data()));
+
+  // The results of all filters are dropped past kMaxFilters.
+  for (auto i = 0; i < DecodedDictionary::kMaxFilters; ++i) {
+    dictionary->setFilterResults(fmt::format("g{}", i), f1Results.data());
+  }
+  EXPECT_FALSE(dictionary->getFilterResults("f1", results.data()));
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/DecompressedCache.h"
+#include "velox/common/memory/Memory.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+class DecompressedCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  static std::string blockData(int32_t size, char fill) {
+    return std::string(size, fill);
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+};
+
+TEST_F(DecompressedCacheTest, findAndInsert) {
+  DecompressedCache cache(pool_.get(), 1'000);
+  const DecompressedBlockKey key{1, 100};
+  EXPECT_EQ(cache.find(key), nullptr);
+  EXPECT_FALSE(cache.contains(key));
+
+  const auto data = blockData(300, 'a');
+  cache.insert(key, data.data(), data.size());
+  EXPECT_TRUE(cache.contains(key));
+  auto block = cache.find(key);
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(std::string_view(block->as<char>(), block->size()), data);
+
+  // The same offset in another file is a different block.
+  EXPECT_EQ(cache.find({2, 100}), nullptr);
+
+  // Inserting a cached block keeps the first copy.
+  const auto other = blockData(300, 'b');
+  cache.insert(key, other.data(), other.size());
+  EXPECT_EQ(cache.find(key)->as<char>()[0], 'a');
+
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numElements, 1);
+  EXPECT_EQ(stats.curSize, 300);
+  EXPECT_EQ(stats.numLookups, 4);
+  EXPECT_EQ(stats.numHits, 2);
+}
+
+TEST_F(DecompressedCacheTest, evict) {
+  DecompressedCache cache(pool_.get(), 1'000);
+  const auto data = blockData(400, 'a');
+  cache.insert({1, 0}, data.data(), data.size());
+  cache.insert({1, 400}, data.data(), data.size());
+  // Makes the first block the most recently used.
+  auto block = cache.find({1, 0});
+  cache.insert({1, 800}, data.data(), data.size());
+  EXPECT_TRUE(cache.contains({1, 0}));
+  EXPECT_FALSE(cache.contains({1, 400}));
+  EXPECT_TRUE(cache.contains({1, 800}));
+
+  // A block larger than the budget is not cached.
+  const auto large = blockData(2'000, 'b');
+  cache.insert({1, 1'200}, large.data(), large.size());
+  EXPECT_FALSE(cache.contains({1, 1'200}));
+
+  // A block that was returned stays valid after it is evicted.
+  cache.clear();
+  EXPECT_FALSE(cache.contains({1, 0}));
+  EXPECT_EQ(cache.stats().curSize, 0);
+  EXPECT_EQ(std::string_view(block->as<char>(), block->size()), data);
+}
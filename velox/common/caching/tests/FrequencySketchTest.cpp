@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <folly/hash/Hash.h>
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox::cache;
+
+namespace {
+uint64_t keyHash(uint64_t key) {
+  return folly::hasher<uint64_t>()(key);
+}
+} // namespace
+
+TEST(FrequencySketchTest, counts) {
+  FrequencySketch sketch(1'000);
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 0);
+  for (auto i = 0; i < 5; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  sketch.increment(keyHash(2));
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 5);
+  EXPECT_EQ(sketch.estimate(keyHash(2)), 1);
+
+  // Counts saturate.
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  EXPECT_EQ(sketch.estimate(keyHash(1)), FrequencySketch::kMaxCount);
+}
+
+TEST(FrequencySketchTest, overestimateIsRare) {
+  FrequencySketch sketch(1'000);
+  for (auto key = 0; key < 1'000; ++key) {
+    sketch.increment(keyHash(key));
+  }
+  int32_t numOver = 0;
+  for (auto key = 0; key < 1'000; ++key) {
+    const auto count = sketch.estimate(keyHash(key));
+    // A count-min sketch never underestimates.
+    EXPECT_GE(count, 1);
+    numOver += count > 1;
+  }
+  EXPECT_LT(numOver, 10);
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch(100);
+  for (auto i = 0; i < 8; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 8);
+  // Other accesses age out the old counts. The sample is 10 accesses per key
+  // of capacity.
+  for (uint64_t key = 100; key < 100 + 10 * sketch.capacity(); ++key) {
+    sketch.increment(keyHash(key));
+  }
+  EXPECT_LT(sketch.estimate(keyHash(1)), 8);
+
+  sketch.ensureCapacity(10 * sketch.capacity());
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 0);
+}
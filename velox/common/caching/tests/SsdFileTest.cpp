@@ -63,7 +63,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -74,7 +75,8 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        disableFileCow);
+        disableFileCow,
+        compressionKind);
   }
 
   void initializeSsdFile(
@@ -82,7 +84,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -90,7 +93,9 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         disableFileCow,
         checksumEnabled,
-        checksumReadVerificationEnabled);
+        checksumReadVerificationEnabled,
+        nullptr,
+        compressionKind);
     ssdFile_ = std::make_unique<SsdFile>(config);
   }
 
@@ -404,6 +409,11 @@ TEST_F(SsdFileTest, checkpoint) {
 
   // Re-initialize SSD file from checkpoint.
   ssdFile_->checkpoint(true);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_GT(stats.checkpointsWritten, 0);
+  EXPECT_GT(stats.checkpointDurationUs, 0);
+  EXPECT_LE(stats.checkpointStallUs, stats.checkpointDurationUs);
   initializeSsdFile(kSsdSize, checkpointIntervalBytes);
   const auto recoveredRegionScores = ssdFile_->testingCopyScores();
   EXPECT_EQ(recoveredRegionScores.size(), 16);
@@ -626,6 +636,53 @@ TEST_F(SsdFileTest, recoverFromCheckpointWithChecksum) {
   }
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 3 * SsdFile::kRegionSize;
+  initializeCache(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_LZ4);
+
+  std::vector<TestEntry> allEntries;
+  for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    };
+  }
+  auto stats = ssdFile_->testingStats();
+  ASSERT_GT(stats.entriesCompressed, 0);
+  ASSERT_GT(stats.bytesSavedByCompression, 0);
+  // The entries are decompressed on load and their checksums match.
+  ASSERT_EQ(checkEntries(allEntries), allEntries.size());
+  ASSERT_EQ(ssdFile_->testingStats().readSsdCorruptions, 0);
+
+  // The compressed entries are recovered from the checkpoint.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_LZ4);
+  ASSERT_EQ(checkEntries(allEntries), allEntries.size());
+
+  // A checkpoint made with a different codec is not used.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, true);
+  ASSERT_EQ(checkEntries(allEntries), 0);
+}
+
 TEST_F(SsdFileTest, ssdReadWithoutChecksumCheck) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
 
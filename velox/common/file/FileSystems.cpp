@@ -18,6 +18,7 @@
 #include <folly/synchronization/CallOnce.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/IoUring.h"
 
 #include <cstdio>
 #include <filesystem>
@@ -86,7 +87,10 @@ class LocalFileSystem : public FileSystem {
 
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
-      const FileOptions& /*unused*/) override {
+      const FileOptions& options) override {
+    if (options.useIoUring && IoUring::instance() != nullptr) {
+      return std::make_unique<IoUringReadFile>(extractPath(path));
+    }
     return std::make_unique<LocalReadFile>(extractPath(path));
   }
 
@@ -45,6 +45,9 @@ struct FileOptions {
   memory::MemoryPool* pool{nullptr};
   /// If specified then can be trusted to be the file size.
   std::optional<int64_t> fileSize;
+  /// If true, local files are read through io_uring if available. See
+  /// IoUringReadFile.
+  bool useIoUring{false};
 };
 
 /// An abstract FileSystem
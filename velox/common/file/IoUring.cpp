@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <fcntl.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+#include <unistd.h>
+
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#else
+// Placeholder so that IoUring::ring_ has a complete type.
+struct io_uring {};
+#endif
+
+namespace facebook::velox {
+
+#ifdef VELOX_ENABLE_IO_URING
+namespace {
+
+struct Batch;
+
+// Identifies a request of a batch in the io_uring user data.
+struct Completion {
+  Batch* batch;
+  int32_t index;
+};
+
+// A set of requests submitted together. Owned by the completion thread after
+// submission and deleted when the last request completes.
+struct Batch {
+  std::vector<IoUring::Request> requests;
+  std::vector<Completion> completions;
+  std::shared_ptr<void> hold;
+  folly::Promise<uint64_t> promise;
+  int32_t numPending{0};
+  uint64_t bytes{0};
+  folly::exception_wrapper error;
+};
+
+uint64_t requestSize(const IoUring::Request& request) {
+  uint64_t size = 0;
+  for (const auto& iov : request.iovecs) {
+    size += iov.iov_len;
+  }
+  return size;
+}
+
+folly::exception_wrapper makeIoError(
+    const IoUring::Request& request,
+    const std::string& message) {
+  try {
+    VELOX_FAIL(
+        "io_uring {} of fd {} at offset {} failed: {}",
+        request.write ? "write" : "read",
+        request.fd,
+        request.offset,
+        message);
+  } catch (const std::exception&) {
+    return folly::exception_wrapper(std::current_exception());
+  }
+}
+
+// Transfers the part of 'request' after the first 'done' bytes with
+// synchronous system calls. Returns an error if the transfer fails or reaches
+// the end of file.
+folly::exception_wrapper transferRemaining(
+    IoUring::Request& request,
+    uint64_t done) {
+  std::vector<iovec> iovecs;
+  for (const auto& iov : request.iovecs) {
+    if (done >= iov.iov_len) {
+      done -= iov.iov_len;
+      continue;
+    }
+    iovecs.push_back(
+        {static_cast<char*>(iov.iov_base) + done, iov.iov_len - done});
+    done = 0;
+  }
+  uint64_t offset = request.offset + requestSize(request);
+  uint64_t remaining = 0;
+  for (const auto& iov : iovecs) {
+    remaining += iov.iov_len;
+  }
+  offset -= remaining;
+  const auto rc = request.write
+      ? folly::pwritevFull(request.fd, iovecs.data(), iovecs.size(), offset)
+      : folly::preadvFull(request.fd, iovecs.data(), iovecs.size(), offset);
+  if (rc < 0) {
+    return makeIoError(request, folly::errnoStr(errno));
+  }
+  if (rc != remaining) {
+    return makeIoError(request, "unexpected end of file");
+  }
+  return {};
+}
+
+void completeRequest(Completion& completion, int32_t result) {
+  auto* batch = completion.batch;
+  auto& request = batch->requests[completion.index];
+  const auto size = requestSize(request);
+  if (result < 0) {
+    if (!batch->error) {
+      batch->error = makeIoError(request, folly::errnoStr(-result));
+    }
+  } else {
+    if (result < size && !batch->error) {
+      batch->error = transferRemaining(request, result);
+    }
+    batch->bytes += size;
+  }
+
+  if (--batch->numPending == 0) {
+    if (batch->error) {
+      batch->promise.setException(std::move(batch->error));
+    } else {
+      batch->promise.setValue(batch->bytes);
+    }
+    delete batch;
+  }
+}
+
+} // namespace
+
+IoUring::IoUring(uint32_t queueDepth) : ring_(std::make_unique<io_uring>()) {
+  const auto rc = io_uring_queue_init(queueDepth, ring_.get(), 0);
+  VELOX_CHECK_EQ(
+      rc, 0, "Failed to initialize io_uring: {}", folly::errnoStr(-rc));
+  completionThread_ = std::thread([this]() { reapCompletions(); });
+}
+
+IoUring::~IoUring() {
+  {
+    // A nop without user data stops the completion thread.
+    std::lock_guard<std::mutex> l(submitMutex_);
+    io_uring_sqe* sqe;
+    while ((sqe = io_uring_get_sqe(ring_.get())) == nullptr) {
+      io_uring_submit(ring_.get());
+    }
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(ring_.get());
+  }
+  completionThread_.join();
+  io_uring_queue_exit(ring_.get());
+}
+
+// static
+IoUring* IoUring::instance() {
+  // Never destroyed, files may be read while static objects are destroyed.
+  static IoUring* const instance = []() -> IoUring* {
+    try {
+      return new IoUring();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "io_uring is not available: " << e.what();
+      return nullptr;
+    }
+  }();
+  return instance;
+}
+
+folly::SemiFuture<uint64_t> IoUring::submit(
+    std::vector<Request> requests,
+    std::shared_ptr<void> hold) {
+  if (requests.empty()) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+  auto* batch = new Batch();
+  batch->requests = std::move(requests);
+  batch->hold = std::move(hold);
+  batch->numPending = batch->requests.size();
+  batch->completions.reserve(batch->requests.size());
+  for (auto i = 0; i < batch->requests.size(); ++i) {
+    VELOX_CHECK_LE(batch->requests[i].iovecs.size(), IOV_MAX);
+    batch->completions.push_back({batch, i});
+  }
+  auto future = batch->promise.getSemiFuture();
+
+  std::lock_guard<std::mutex> l(submitMutex_);
+  for (auto i = 0; i < batch->requests.size(); ++i) {
+    io_uring_sqe* sqe;
+    while ((sqe = io_uring_get_sqe(ring_.get())) == nullptr) {
+      // The submission queue is full. Submitting makes room.
+      io_uring_submit(ring_.get());
+    }
+    const auto& request = batch->requests[i];
+    if (request.write) {
+      io_uring_prep_writev(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    } else {
+      io_uring_prep_readv(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    }
+    io_uring_sqe_set_data(sqe, &batch->completions[i]);
+  }
+  int rc;
+  while ((rc = io_uring_submit(ring_.get())) == -EINTR || rc == -EAGAIN) {
+  }
+  // The requests have been queued and will be submitted by the next call if
+  // this one fails, so the batch is not deleted here.
+  VELOX_CHECK_GE(
+      rc, 0, "Failed to submit to io_uring: {}", folly::errnoStr(-rc));
+  return future;
+}
+
+void IoUring::reapCompletions() {
+  for (;;) {
+    io_uring_cqe* cqe;
+    const auto rc = io_uring_wait_cqe(ring_.get(), &cqe);
+    if (rc == -EINTR) {
+      continue;
+    }
+    VELOX_CHECK_EQ(
+        rc, 0, "Failed to wait for io_uring: {}", folly::errnoStr(-rc));
+    auto* completion = static_cast<Completion*>(io_uring_cqe_get_data(cqe));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(ring_.get(), cqe);
+    if (completion == nullptr) {
+      return;
+    }
+    completeRequest(*completion, result);
+  }
+}
+
+#else
+
+IoUring::IoUring(uint32_t /*queueDepth*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+IoUring::~IoUring() = default;
+
+// static
+IoUring* IoUring::instance() {
+  return nullptr;
+}
+
+folly::SemiFuture<uint64_t> IoUring::submit(
+    std::vector<Request> /*requests*/,
+    std::shared_ptr<void> /*hold*/) {
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+}
+
+void IoUring::reapCompletions() {}
+
+#endif // VELOX_ENABLE_IO_URING
+
+IoUringReadFile::IoUringReadFile(std::string_view path, IoUring* ioUring)
+    : ioUring_(ioUring), path_(path), ownsFd_(true) {
+  VELOX_CHECK_NOT_NULL(ioUring_, "io_uring is not available");
+  fd_ = open(path_.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    if (errno == ENOENT) {
+      VELOX_FILE_NOT_FOUND_ERROR("No such file or directory: {}", path);
+    } else {
+      VELOX_FAIL(
+          "open failure in IoUringReadFile constructor, {} {} {}.",
+          fd_,
+          path,
+          folly::errnoStr(errno));
+    }
+  }
+  const off_t rc = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(
+      rc,
+      0,
+      "fseek failure in IoUringReadFile constructor, {} {} {}.",
+      rc,
+      path,
+      folly::errnoStr(errno));
+  size_ = rc;
+}
+
+IoUringReadFile::IoUringReadFile(int32_t fd, IoUring* ioUring)
+    : ioUring_(ioUring), ownsFd_(false), fd_(fd) {
+  VELOX_CHECK_NOT_NULL(ioUring_, "io_uring is not available");
+  const off_t rc = lseek(fd_, 0, SEEK_END);
+  VELOX_CHECK_GE(rc, 0, "fseek failure in IoUringReadFile constructor");
+  size_ = rc;
+}
+
+IoUringReadFile::~IoUringReadFile() {
+  if (!ownsFd_) {
+    return;
+  }
+  const int ret = close(fd_);
+  if (ret < 0) {
+    LOG(WARNING) << "close failure in IoUringReadFile destructor: " << ret
+                 << ", " << folly::errnoStr(errno);
+  }
+}
+
+std::string_view
+IoUringReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  preadv(offset, {folly::Range<char*>(static_cast<char*>(buf), length)});
+  return {static_cast<char*>(buf), length};
+}
+
+uint64_t IoUringReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  return preadvAsync(offset, buffers).get();
+}
+
+folly::SemiFuture<uint64_t> IoUringReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  // Skipped ranges are read into scratch memory shared by all their iovecs.
+  // Sized like in LocalReadFile so that a typical skip of 50K is not too many
+  // iovecs.
+  constexpr uint64_t kScratchSize = 16 << 10;
+  std::shared_ptr<char[]> scratch;
+
+  std::vector<IoUring::Request> requests;
+  IoUring::Request request{fd_, offset, {}};
+  auto addIovec = [&](char* data, uint64_t size) {
+    if (request.iovecs.size() >= IOV_MAX) {
+      requests.push_back(std::move(request));
+      request = IoUring::Request{fd_, offset, {}};
+    }
+    request.iovecs.push_back({data, size});
+    offset += size;
+  };
+
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      bytesRead_ += range.size();
+      addIovec(range.data(), range.size());
+      continue;
+    }
+    if (scratch == nullptr) {
+      scratch = std::shared_ptr<char[]>(new char[kScratchSize]);
+    }
+    for (auto skip = range.size(); skip > 0;) {
+      const auto size = std::min<uint64_t>(skip, kScratchSize);
+      addIovec(scratch.get(), size);
+      skip -= size;
+    }
+  }
+  if (!request.iovecs.empty()) {
+    requests.push_back(std::move(request));
+  }
+  return ioUring_->submit(std::move(requests), std::move(scratch));
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/futures/Future.h>
+#include <folly/portability/SysUio.h>
+
+#include <mutex>
+#include <thread>
+
+#include "velox/common/file/File.h"
+
+struct io_uring;
+
+namespace facebook::velox {
+
+/// Submits reads and writes of local files through a Linux io_uring. A batch
+/// of requests is submitted with a single system call and completes
+/// asynchronously on a completion thread owned by 'this'. Available only if
+/// Velox is built with VELOX_ENABLE_IO_URING and the kernel supports io_uring.
+/// Thread safe.
+class IoUring {
+ public:
+  /// A vectored read or write of 'iovecs' at 'offset' of 'fd'. 'iovecs' is
+  /// limited to IOV_MAX entries.
+  struct Request {
+    int32_t fd;
+    uint64_t offset;
+    std::vector<iovec> iovecs;
+    bool write{false};
+  };
+
+  /// Throws if io_uring is not available.
+  explicit IoUring(uint32_t queueDepth = kDefaultQueueDepth);
+
+  ~IoUring();
+
+  /// Returns the process wide instance or nullptr if io_uring is not
+  /// available.
+  static IoUring* instance();
+
+  /// Submits 'requests' and returns the total number of bytes transferred
+  /// when all of them are complete, or the first error. Short transfers are
+  /// completed synchronously on the completion thread. 'hold' is kept alive
+  /// until the requests complete, e.g. for scratch memory referenced by
+  /// 'requests'.
+  folly::SemiFuture<uint64_t> submit(
+      std::vector<Request> requests,
+      std::shared_ptr<void> hold = nullptr);
+
+ private:
+  static constexpr uint32_t kDefaultQueueDepth = 256;
+
+  void reapCompletions();
+
+  std::unique_ptr<io_uring> ring_;
+
+  // Serializes the use of the submission queue. The completion queue is only
+  // used by 'completionThread_'.
+  std::mutex submitMutex_;
+
+  std::thread completionThread_;
+};
+
+/// A ReadFile over a local file that reads through an IoUring and has a
+/// native preadvAsync. Unlike LocalReadFile, a preadv is split into requests
+/// of at most IOV_MAX ranges that are all submitted at once.
+class IoUringReadFile final : public ReadFile {
+ public:
+  explicit IoUringReadFile(
+      std::string_view path,
+      IoUring* ioUring = IoUring::instance());
+
+  /// Reads from 'fd' which is not owned by 'this'.
+  IoUringReadFile(int32_t fd, IoUring* ioUring = IoUring::instance());
+
+  ~IoUringReadFile() override;
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return true;
+  }
+
+  uint64_t size() const final {
+    return size_;
+  }
+
+  uint64_t memoryUsage() const final {
+    return sizeof(*this);
+  }
+
+  bool shouldCoalesce() const final {
+    return false;
+  }
+
+  std::string getName() const override {
+    if (path_.empty()) {
+      return "<IoUringReadFile>";
+    }
+    return path_;
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return 10 << 20;
+  }
+
+ private:
+  IoUring* const ioUring_;
+  const std::string path_;
+  const bool ownsFd_;
+  int32_t fd_;
+  uint64_t size_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/MemoryFileSystem.h"
+#include <folly/synchronization/CallOnce.h>
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/file/File.h"
+
+namespace facebook::velox::filesystems {
+
+namespace {
+
+// Reads an in-memory file. Keeps the content alive while the file is read,
+// also if the file is removed meanwhile.
+class MemoryReadFile final : public InMemoryReadFile {
+ public:
+  MemoryReadFile(std::string path, std::shared_ptr<MemoryFileSystem::File> file)
+      : InMemoryReadFile(std::string_view(file->data())),
+        path_(std::move(path)),
+        file_(std::move(file)) {}
+
+  std::string getName() const override {
+    return path_;
+  }
+
+ private:
+  const std::string path_;
+  const std::shared_ptr<MemoryFileSystem::File> file_;
+};
+
+folly::once_flag memoryFSInstantiationFlag;
+
+std::shared_ptr<MemoryFileSystem>& memoryFSInstance() {
+  static auto* fs = new std::shared_ptr<MemoryFileSystem>();
+  return *fs;
+}
+
+} // namespace
+
+// Appends to an in-memory file while the file system has capacity left. Moves
+// the file to the underlying file system on the first append that does not
+// fit and appends there from then on.
+class MemoryWriteFile final : public WriteFile {
+ public:
+  MemoryWriteFile(
+      MemoryFileSystem* fs,
+      std::string path,
+      std::shared_ptr<MemoryFileSystem::File> file,
+      const FileOptions& options)
+      : fs_(fs),
+        path_(std::move(path)),
+        options_(options),
+        file_(std::move(file)) {}
+
+  void append(std::string_view data) final {
+    if (delegate_ == nullptr) {
+      if (fs_->tryReserve(data.size())) {
+        file_->append(data);
+        return;
+      }
+      moveToDelegate();
+    }
+    delegate_->append(data);
+  }
+
+  void append(std::unique_ptr<folly::IOBuf> data) final {
+    for (auto rangeIter = data->begin(); rangeIter != data->end();
+         ++rangeIter) {
+      append(std::string_view(
+          reinterpret_cast<const char*>(rangeIter->data()),
+          rangeIter->size()));
+    }
+  }
+
+  void flush() final {
+    if (delegate_ != nullptr) {
+      delegate_->flush();
+    }
+  }
+
+  void close() final {
+    if (delegate_ != nullptr) {
+      delegate_->close();
+    }
+  }
+
+  uint64_t size() const final {
+    return delegate_ != nullptr ? delegate_->size() : file_->data().size();
+  }
+
+ private:
+  void moveToDelegate() {
+    delegate_ = fs_->delegate(path_)->openFileForWrite(path_, options_);
+    delegate_->append(file_->data());
+    fs_->removeFile(path_);
+    file_.reset();
+  }
+
+  MemoryFileSystem* const fs_;
+  // The path without the scheme.
+  const std::string path_;
+  const FileOptions options_;
+  std::shared_ptr<MemoryFileSystem::File> file_;
+  std::unique_ptr<WriteFile> delegate_;
+};
+
+std::string_view MemoryFileSystem::extractPath(std::string_view path) {
+  VELOX_CHECK_EQ(
+      path.find(scheme()), 0, "Not a memory file system path: {}", path);
+  return path.substr(scheme().length());
+}
+
+bool MemoryFileSystem::tryReserve(uint64_t bytes) {
+  auto used = usedBytes_.load();
+  do {
+    if (used + bytes > capacity_) {
+      return false;
+    }
+  } while (!usedBytes_.compare_exchange_weak(used, used + bytes));
+  return true;
+}
+
+std::shared_ptr<MemoryFileSystem::File> MemoryFileSystem::findFile(
+    const std::string& path) const {
+  return files_.withRLock([&](const auto& files) -> std::shared_ptr<File> {
+    auto it = files.find(path);
+    return it == files.end() ? nullptr : it->second;
+  });
+}
+
+bool MemoryFileSystem::removeFile(const std::string& path) {
+  return files_.wlock()->erase(path) > 0;
+}
+
+std::shared_ptr<FileSystem> MemoryFileSystem::delegate(
+    std::string_view path) const {
+  return getFileSystem(path, config_);
+}
+
+std::unique_ptr<ReadFile> MemoryFileSystem::openFileForRead(
+    std::string_view path,
+    const FileOptions& options) {
+  const std::string filePath(extractPath(path));
+  if (auto file = findFile(filePath)) {
+    return std::make_unique<MemoryReadFile>(std::string(path), std::move(file));
+  }
+  return delegate(filePath)->openFileForRead(filePath, options);
+}
+
+std::unique_ptr<WriteFile> MemoryFileSystem::openFileForWrite(
+    std::string_view path,
+    const FileOptions& options) {
+  const std::string filePath(extractPath(path));
+  VELOX_USER_CHECK(!exists(path), "File already exists: {}", path);
+  auto file = std::make_shared<File>(usedBytes_);
+  files_.wlock()->emplace(filePath, file);
+  return std::make_unique<MemoryWriteFile>(
+      this, filePath, std::move(file), options);
+}
+
+void MemoryFileSystem::remove(std::string_view path) {
+  const std::string filePath(extractPath(path));
+  if (!removeFile(filePath)) {
+    delegate(filePath)->remove(filePath);
+  }
+}
+
+void MemoryFileSystem::rename(
+    std::string_view oldPath,
+    std::string_view newPath,
+    bool overwrite) {
+  const std::string oldFile(extractPath(oldPath));
+  const std::string newFile(extractPath(newPath));
+  auto file = findFile(oldFile);
+  if (file == nullptr) {
+    delegate(oldFile)->rename(oldFile, newFile, overwrite);
+    return;
+  }
+  if (exists(newPath)) {
+    if (!overwrite) {
+      VELOX_USER_FAIL(
+          "Failed to rename file {} to {} as {} exists.",
+          oldFile,
+          newFile,
+          newFile);
+    }
+    if (!removeFile(newFile)) {
+      delegate(newFile)->remove(newFile);
+    }
+  }
+  files_.withWLock([&](auto& files) {
+    files.erase(oldFile);
+    files[newFile] = std::move(file);
+  });
+}
+
+bool MemoryFileSystem::exists(std::string_view path) {
+  const std::string filePath(extractPath(path));
+  return findFile(filePath) != nullptr || delegate(filePath)->exists(filePath);
+}
+
+std::vector<std::string> MemoryFileSystem::list(std::string_view path) {
+  const std::string directory(extractPath(path));
+  const auto prefix = directory + "/";
+  std::vector<std::string> paths;
+  files_.withRLock([&](const auto& files) {
+    for (const auto& [filePath, file] : files) {
+      if (filePath.find(prefix) == 0) {
+        paths.push_back(scheme() + filePath);
+      }
+    }
+  });
+  auto fs = delegate(directory);
+  if (fs->exists(directory)) {
+    for (const auto& filePath : fs->list(directory)) {
+      paths.push_back(scheme() + filePath);
+    }
+  }
+  return paths;
+}
+
+void MemoryFileSystem::mkdir(std::string_view path) {
+  const std::string directory(extractPath(path));
+  delegate(directory)->mkdir(directory);
+}
+
+void MemoryFileSystem::rmdir(std::string_view path) {
+  const std::string directory(extractPath(path));
+  const auto prefix = directory + "/";
+  files_.withWLock([&](auto& files) {
+    for (auto it = files.begin(); it != files.end();) {
+      if (it->first.find(prefix) == 0) {
+        it = files.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  });
+  delegate(directory)->rmdir(directory);
+}
+
+void registerMemoryFileSystem(uint64_t capacity) {
+  folly::call_once(memoryFSInstantiationFlag, [&]() {
+    memoryFSInstance() = std::make_shared<MemoryFileSystem>(nullptr, capacity);
+    registerFileSystem(
+        [](std::string_view filePath) {
+          return filePath.find(MemoryFileSystem::scheme()) == 0;
+        },
+        [](std::shared_ptr<const Config> /*unused*/,
+           std::string_view /*unused*/) -> std::shared_ptr<FileSystem> {
+          return memoryFSInstance();
+        });
+  });
+  memoryFSInstance()->setCapacity(capacity);
+}
+
+std::shared_ptr<MemoryFileSystem> memoryFileSystem() {
+  VELOX_CHECK_NOT_NULL(
+      memoryFSInstance(), "The memory file system is not registered");
+  return memoryFSInstance();
+}
+
+} // namespace facebook::velox::filesystems
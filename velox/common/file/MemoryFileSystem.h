@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/file/FileSystems.h"
+
+#include <atomic>
+
+namespace facebook::velox::filesystems {
+
+/// A file system that keeps files in process memory, up to a capacity shared
+/// by all its files. Paths have the form "memory:<path>". A file that would
+/// grow the memory held beyond the capacity is moved to the file system of
+/// <path>, e.g. the local disk, and is appended there from then on.
+///
+/// This is meant as the first tier for spill files, which are written once,
+/// read back once and then removed. With spill compression enabled, cold
+/// operator state stays compressed in memory and only goes to disk when the
+/// capacity is used up. The memory is not tracked by the query memory pools.
+class MemoryFileSystem : public FileSystem {
+ public:
+  MemoryFileSystem(std::shared_ptr<const Config> config, uint64_t capacity)
+      : FileSystem(std::move(config)), capacity_(capacity) {}
+
+  static inline std::string scheme() {
+    return "memory:";
+  }
+
+  std::string name() const override {
+    return "Memory FS";
+  }
+
+  /// Returns the path without the "memory:" prefix. This is the path in the
+  /// file system that files go to when the capacity is used up.
+  std::string_view extractPath(std::string_view path) override;
+
+  std::unique_ptr<ReadFile> openFileForRead(
+      std::string_view path,
+      const FileOptions& options) override;
+
+  std::unique_ptr<WriteFile> openFileForWrite(
+      std::string_view path,
+      const FileOptions& options) override;
+
+  void remove(std::string_view path) override;
+
+  void rename(
+      std::string_view oldPath,
+      std::string_view newPath,
+      bool overwrite) override;
+
+  bool exists(std::string_view path) override;
+
+  /// Returns the files in memory and in the underlying file system under
+  /// 'path'. The returned paths have the "memory:" prefix.
+  std::vector<std::string> list(std::string_view path) override;
+
+  /// Creates the directory in the underlying file system.
+  void mkdir(std::string_view path) override;
+
+  /// Removes the in-memory files under 'path' and the directory in the
+  /// underlying file system.
+  void rmdir(std::string_view path) override;
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  void setCapacity(uint64_t capacity) {
+    capacity_ = capacity;
+  }
+
+  /// Returns the bytes held by the in-memory files.
+  uint64_t usedBytes() const {
+    return usedBytes_;
+  }
+
+  /// The content of an in-memory file. The bytes are counted in 'usedBytes_'
+  /// of the file system as long as the file is referenced, i.e. a file
+  /// removed while it is being read stays counted until the reader goes away.
+  class File {
+   public:
+    explicit File(std::atomic<uint64_t>& usedBytes) : usedBytes_(usedBytes) {}
+
+    ~File() {
+      usedBytes_ -= data_.size();
+    }
+
+    const std::string& data() const {
+      return data_;
+    }
+
+    /// Appends 'data'. The caller must have reserved the bytes.
+    void append(std::string_view data) {
+      data_.append(data);
+    }
+
+   private:
+    std::atomic<uint64_t>& usedBytes_;
+    std::string data_;
+  };
+
+ private:
+  friend class MemoryWriteFile;
+
+  // Adds 'bytes' to 'usedBytes_' if the total stays within 'capacity_'.
+  // Returns false and leaves 'usedBytes_' unchanged otherwise.
+  bool tryReserve(uint64_t bytes);
+
+  // Returns the in-memory file at 'path' without the scheme or nullptr.
+  std::shared_ptr<File> findFile(const std::string& path) const;
+
+  // Removes the in-memory file at 'path' without the scheme. Returns true if
+  // there was one.
+  bool removeFile(const std::string& path);
+
+  std::shared_ptr<FileSystem> delegate(std::string_view path) const;
+
+  std::atomic<uint64_t> capacity_;
+  std::atomic<uint64_t> usedBytes_{0};
+  folly::Synchronized<folly::F14FastMap<std::string, std::shared_ptr<File>>>
+      files_;
+};
+
+/// Registers the memory file system for paths starting with "memory:".
+/// 'capacity' is the number of bytes the in-memory files may hold in total.
+/// The file system is a process wide singleton. Registering again only
+/// changes its capacity.
+void registerMemoryFileSystem(uint64_t capacity);
+
+/// Returns the memory file system. Must be called after
+/// registerMemoryFileSystem().
+std::shared_ptr<MemoryFileSystem> memoryFileSystem();
+
+} // namespace facebook::velox::filesystems
@@ -35,4 +35,32 @@ bool CoalesceIfDistanceLE::operator()(
   return shouldCoalesce;
 }
 
+folly::SemiFuture<uint64_t> readRangesAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    folly::Executor* executor,
+    std::function<void(uint64_t offset, uint64_t length, char* data)> read) {
+  VELOX_CHECK_NOT_NULL(executor);
+  auto sharedRead = std::make_shared<decltype(read)>(std::move(read));
+  std::vector<folly::SemiFuture<folly::Unit>> reads;
+  uint64_t totalSize = 0;
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr && !range.empty()) {
+      const auto rangeOffset = offset + totalSize;
+      reads.push_back(
+          folly::via(executor, [sharedRead, rangeOffset, range]() {
+            (*sharedRead)(rangeOffset, range.size(), range.data());
+          }).semi());
+    }
+    totalSize += range.size();
+  }
+  if (reads.empty()) {
+    return folly::makeSemiFuture<uint64_t>(totalSize);
+  }
+  return folly::collect(std::move(reads))
+      .deferValue([totalSize](std::vector<folly::Unit>&& /*unused*/) {
+        return totalSize;
+      });
+}
+
 } // namespace facebook::velox::file::utils
@@ -17,7 +17,10 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
 #include "folly/io/Cursor.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/Region.h"
@@ -166,4 +169,17 @@ class ReadToIOBufs {
   Reader reader_;
 };
 
+/// Reads the ranges of 'buffers' that are not gaps in parallel on 'executor',
+/// one 'read' call per range. 'buffers' has the same layout as in
+/// ReadFile::preadv() and starts at 'offset' in the file. The gaps are not
+/// read. Returns the total size of 'buffers' including the gaps, or the first
+/// read error. 'buffers' must stay valid until the returned future completes.
+/// This is a building block for ReadFile::preadvAsync() of remote files whose
+/// client can serve concurrent ranged reads.
+folly::SemiFuture<uint64_t> readRangesAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    folly::Executor* executor,
+    std::function<void(uint64_t offset, uint64_t length, char* data)> read);
+
 } // namespace facebook::velox::file::utils
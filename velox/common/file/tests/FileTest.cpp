@@ -15,10 +15,13 @@
  */
 
 #include <fcntl.h>
+#include <filesystem>
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
+#include "velox/common/file/MemoryFileSystem.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -160,6 +163,39 @@ TEST_P(LocalFileTest, writeAndRead) {
   }
 }
 
+TEST_P(LocalFileTest, ioUringRead) {
+  if (IoUring::instance() == nullptr) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  filesystems::FileOptions options;
+  options.useIoUring = true;
+  auto readFile = fs->openFileForRead(filename, options);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  // More ranges than fit in one request are split into several requests.
+  constexpr int32_t kNumRanges = 3 * IOV_MAX;
+  std::vector<char> data(kNumRanges);
+  std::vector<folly::Range<char*>> buffers;
+  for (auto i = 0; i < kNumRanges; ++i) {
+    buffers.emplace_back(&data[i], 1);
+    buffers.emplace_back(nullptr, (char*)(uint64_t)99);
+  }
+  ASSERT_EQ(readFile->preadvAsync(10, buffers).get(), kNumRanges * 100);
+  for (auto i = 0; i < kNumRanges; ++i) {
+    ASSERT_EQ(data[i], 'c');
+  }
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
@@ -697,3 +733,108 @@ TEST_F(FaultyFsTest, fileWriteFaultHookInjection) {
     fs_->remove(path2);
   }
 }
+
+class MemoryFileSystemTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    filesystems::registerLocalFileSystem();
+    filesystems::registerMemoryFileSystem(4 * kOneMB);
+  }
+
+  void SetUp() override {
+    dir_ = exec::test::TempDirectoryPath::create();
+    fs_ = filesystems::memoryFileSystem();
+    fs_->mkdir(memoryDir());
+  }
+
+  void TearDown() override {
+    fs_->rmdir(memoryDir());
+    fs_->setCapacity(4 * kOneMB);
+  }
+
+  // Returns 'dir_' in the memory file system. Files go to 'dir_' when they do
+  // not fit in memory.
+  std::string memoryDir() const {
+    return filesystems::MemoryFileSystem::scheme() + dir_->getPath();
+  }
+
+  std::string memoryPath(const std::string& name) const {
+    return fmt::format("{}/{}", memoryDir(), name);
+  }
+
+  std::shared_ptr<exec::test::TempDirectoryPath> dir_;
+  std::shared_ptr<filesystems::MemoryFileSystem> fs_;
+};
+
+TEST_F(MemoryFileSystemTest, writeAndRead) {
+  for (bool useIOBuf : {true, false}) {
+    SCOPED_TRACE(fmt::format("useIOBuf {}", useIOBuf));
+    const auto path = memoryPath("a");
+    ASSERT_EQ(filesystems::getFileSystem(path, nullptr), fs_);
+    {
+      auto writeFile = fs_->openFileForWrite(path, {});
+      writeData(writeFile.get(), useIOBuf);
+      writeFile->close();
+    }
+    ASSERT_EQ(fs_->usedBytes(), 15 + kOneMB);
+    ASSERT_TRUE(fs_->exists(path));
+    ASSERT_FALSE(std::filesystem::exists(fs_->extractPath(path)));
+    VELOX_ASSERT_THROW(fs_->openFileForWrite(path, {}), "File already exists");
+    {
+      auto readFile = fs_->openFileForRead(path, {});
+      readData(readFile.get());
+      // The content stays readable until the reader goes away.
+      fs_->remove(path);
+      ASSERT_FALSE(fs_->exists(path));
+      readData(readFile.get());
+      ASSERT_EQ(fs_->usedBytes(), 15 + kOneMB);
+    }
+    ASSERT_EQ(fs_->usedBytes(), 0);
+  }
+}
+
+TEST_F(MemoryFileSystemTest, overflow) {
+  fs_->setCapacity(kOneMB);
+  const auto path = memoryPath("a");
+  {
+    auto writeFile = fs_->openFileForWrite(path, {});
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  ASSERT_EQ(fs_->usedBytes(), 0);
+  ASSERT_TRUE(fs_->exists(path));
+  ASSERT_TRUE(std::filesystem::exists(fs_->extractPath(path)));
+  auto readFile = fs_->openFileForRead(path, {});
+  readData(readFile.get());
+  fs_->remove(path);
+  ASSERT_FALSE(fs_->exists(path));
+}
+
+TEST_F(MemoryFileSystemTest, listAndRmdir) {
+  fs_->setCapacity(kOneMB);
+  for (const auto& name : {"a", "b"}) {
+    auto writeFile = fs_->openFileForWrite(memoryPath(name), {});
+    writeFile->append(std::string(kOneMB / 2 + 1, 'a'));
+    writeFile->close();
+  }
+  // 'a' is in memory, 'b' does not fit and is on disk.
+  ASSERT_EQ(fs_->usedBytes(), kOneMB / 2 + 1);
+  ASSERT_FALSE(std::filesystem::exists(fs_->extractPath(memoryPath("a"))));
+  ASSERT_TRUE(std::filesystem::exists(fs_->extractPath(memoryPath("b"))));
+  auto paths = fs_->list(memoryDir());
+  std::sort(paths.begin(), paths.end());
+  ASSERT_EQ(
+      paths, std::vector<std::string>({memoryPath("a"), memoryPath("b")}));
+
+  fs_->rename(memoryPath("a"), memoryPath("c"), false);
+  ASSERT_FALSE(fs_->exists(memoryPath("a")));
+  ASSERT_TRUE(fs_->exists(memoryPath("c")));
+  VELOX_ASSERT_THROW(
+      fs_->rename(memoryPath("c"), memoryPath("b"), false),
+      "Failed to rename file");
+
+  fs_->rmdir(memoryDir());
+  ASSERT_EQ(fs_->usedBytes(), 0);
+  ASSERT_FALSE(fs_->exists(memoryPath("b")));
+  ASSERT_FALSE(fs_->exists(memoryPath("c")));
+}
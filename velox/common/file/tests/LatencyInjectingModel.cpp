@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/tests/LatencyInjectingModel.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::tests::utils {
+namespace {
+uint64_t transferUs(uint64_t bytes, uint64_t bytesPerSecond) {
+  if (bytesPerSecond == 0) {
+    return 0;
+  }
+  return bytes * 1'000'000 / bytesPerSecond;
+}
+
+uint64_t steadyNowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+} // namespace
+
+LatencyInjectingModel::LatencyInjectingModel(const Config& config)
+    : config_(config),
+      rng_(config.seed),
+      latency_(
+          std::log(std::max<double>(1, config.latencyUs)),
+          config.latencySigma) {
+  VELOX_CHECK_GE(config_.latencySigma, 0);
+  VELOX_CHECK_GE(config_.tailProbability, 0);
+  VELOX_CHECK_LE(config_.tailProbability, 1);
+}
+
+uint64_t LatencyInjectingModel::firstByteLatencyUs() {
+  if (config_.tailProbability > 0 &&
+      uniform_(rng_) < config_.tailProbability) {
+    ++numTailRequests_;
+    return config_.tailLatencyUs;
+  }
+  if (config_.latencySigma == 0 || config_.latencyUs == 0) {
+    return config_.latencyUs;
+  }
+  return static_cast<uint64_t>(latency_(rng_));
+}
+
+uint64_t LatencyInjectingModel::delayUs(uint64_t bytes, uint64_t nowUs) {
+  uint64_t doneUs;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto firstByteUs = nowUs + firstByteLatencyUs();
+    doneUs = firstByteUs + transferUs(bytes, config_.requestBytesPerSecond);
+    if (config_.totalBytesPerSecond != 0) {
+      // The bytes of a request go over the shared link after the ones of the
+      // requests issued before it.
+      linkFreeAtUs_ = std::max(linkFreeAtUs_, firstByteUs) +
+          transferUs(bytes, config_.totalBytesPerSecond);
+      doneUs = std::max(doneUs, linkFreeAtUs_);
+    }
+  }
+  const auto delay = doneUs - nowUs;
+  ++numRequests_;
+  bytes_ += bytes;
+  delayUs_ += delay;
+  return delay;
+}
+
+FileFaultInjectionHook LatencyInjectingModel::makeHook() {
+  return [this](FaultFileOperation* op) {
+    uint64_t bytes;
+    switch (op->type) {
+      case FaultFileOperation::Type::kRead:
+        bytes = static_cast<FaultFileReadOperation*>(op)->length;
+        break;
+      case FaultFileOperation::Type::kReadv:
+        bytes = 0;
+        for (const auto& buffer :
+             static_cast<FaultFileReadvOperation*>(op)->buffers) {
+          bytes += buffer.size();
+        }
+        break;
+      default:
+        return;
+    }
+    const auto delay = delayUs(bytes, steadyNowUs());
+    if (delay > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(delay));
+    }
+  };
+}
+
+LatencyInjectingModel::Stats LatencyInjectingModel::stats() const {
+  Stats stats;
+  stats.numRequests = numRequests_;
+  stats.numTailRequests = numTailRequests_;
+  stats.bytes = bytes_;
+  stats.delayUs = delayUs_;
+  return stats;
+}
+
+void LatencyInjectingModel::resetStats() {
+  numRequests_ = 0;
+  numTailRequests_ = 0;
+  bytes_ = 0;
+  delayUs_ = 0;
+}
+
+} // namespace facebook::velox::tests::utils
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <random>
+
+#include "velox/common/file/tests/FaultyFile.h"
+
+namespace facebook::velox::tests::utils {
+
+/// Simulates the response time of remote storage such as an object store for
+/// reads going through FaultyFileSystem. Each read request waits for a first
+/// byte latency and then for the transfer of its bytes, which is limited both
+/// per request and by a link shared by all requests. This makes the cost of
+/// many small reads versus few coalesced ones, and the benefit of prefetching,
+/// visible on local files.
+class LatencyInjectingModel {
+ public:
+  struct Config {
+    /// Median first byte latency of a request.
+    uint64_t latencyUs{0};
+
+    /// Standard deviation of the log of the first byte latency. If 0, every
+    /// request has 'latencyUs'. Typical object store latencies are log
+    /// normal with a sigma of 0.3 to 0.6.
+    double latencySigma{0};
+
+    /// Fraction of the requests that take 'tailLatencyUs' instead, e.g. for
+    /// retries or throttling.
+    double tailProbability{0};
+    uint64_t tailLatencyUs{0};
+
+    /// Transfer rate of a single request. 0 means unlimited.
+    uint64_t requestBytesPerSecond{0};
+
+    /// Transfer rate shared by all concurrent requests. 0 means unlimited.
+    uint64_t totalBytesPerSecond{0};
+
+    uint32_t seed{0};
+  };
+
+  struct Stats {
+    uint64_t numRequests{0};
+    uint64_t numTailRequests{0};
+    uint64_t bytes{0};
+    uint64_t delayUs{0};
+  };
+
+  explicit LatencyInjectingModel(const Config& config);
+
+  /// Returns the time a request for 'bytes' issued at 'nowUs' takes to
+  /// complete and accounts the request in stats(). Does not sleep.
+  uint64_t delayUs(uint64_t bytes, uint64_t nowUs);
+
+  /// Returns a hook for FaultyFileSystem::setFileInjectionHook() that sleeps
+  /// for delayUs() of each read or readv. Writes are not delayed. The hook
+  /// references 'this', which must outlive its use.
+  FileFaultInjectionHook makeHook();
+
+  Stats stats() const;
+
+  void resetStats();
+
+ private:
+  uint64_t firstByteLatencyUs();
+
+  const Config config_;
+
+  std::mutex mutex_;
+  std::mt19937 rng_;
+  std::lognormal_distribution<double> latency_;
+  std::uniform_real_distribution<double> uniform_{0, 1};
+  // The time the shared link has transferred all bytes requested so far.
+  uint64_t linkFreeAtUs_{0};
+
+  std::atomic<uint64_t> numRequests_{0};
+  std::atomic<uint64_t> numTailRequests_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint64_t> delayUs_{0};
+};
+
+} // namespace facebook::velox::tests::utils
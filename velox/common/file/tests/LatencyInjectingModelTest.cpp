@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/file/tests/LatencyInjectingModel.h"
+
+using namespace facebook::velox::tests::utils;
+
+TEST(LatencyInjectingModelTest, fixedLatencyAndRequestBandwidth) {
+  LatencyInjectingModel::Config config;
+  config.latencyUs = 1'000;
+  config.requestBytesPerSecond = 1'000'000;
+  LatencyInjectingModel model(config);
+
+  // 1ms to first byte plus 1us per byte.
+  EXPECT_EQ(model.delayUs(0, 0), 1'000);
+  EXPECT_EQ(model.delayUs(2'000, 0), 3'000);
+  EXPECT_EQ(model.delayUs(2'000, 100'000), 3'000);
+
+  const auto stats = model.stats();
+  EXPECT_EQ(stats.numRequests, 3);
+  EXPECT_EQ(stats.numTailRequests, 0);
+  EXPECT_EQ(stats.bytes, 4'000);
+  EXPECT_EQ(stats.delayUs, 7'000);
+
+  model.resetStats();
+  EXPECT_EQ(model.stats().numRequests, 0);
+  EXPECT_EQ(model.stats().bytes, 0);
+}
+
+TEST(LatencyInjectingModelTest, sharedBandwidth) {
+  LatencyInjectingModel::Config config;
+  config.latencyUs = 100;
+  config.totalBytesPerSecond = 1'000'000;
+  LatencyInjectingModel model(config);
+
+  // Concurrent requests queue on the shared link.
+  EXPECT_EQ(model.delayUs(1'000, 0), 1'100);
+  EXPECT_EQ(model.delayUs(1'000, 0), 2'100);
+  EXPECT_EQ(model.delayUs(1'000, 500), 2'600);
+
+  // Once the link is idle, a request only waits for its own bytes.
+  EXPECT_EQ(model.delayUs(1'000, 10'000), 1'100);
+}
+
+TEST(LatencyInjectingModelTest, tailLatency) {
+  LatencyInjectingModel::Config config;
+  config.latencyUs = 100;
+  config.tailProbability = 0.1;
+  config.tailLatencyUs = 50'000;
+  config.seed = 1;
+  LatencyInjectingModel model(config);
+
+  constexpr int kNumRequests = 10'000;
+  for (auto i = 0; i < kNumRequests; ++i) {
+    const auto delay = model.delayUs(0, 0);
+    ASSERT_TRUE(delay == 100 || delay == 50'000) << delay;
+  }
+  const auto stats = model.stats();
+  EXPECT_GT(stats.numTailRequests, kNumRequests / 20);
+  EXPECT_LT(stats.numTailRequests, kNumRequests / 5);
+  EXPECT_EQ(
+      stats.delayUs,
+      stats.numTailRequests * 50'000 +
+          (kNumRequests - stats.numTailRequests) * 100);
+}
+
+TEST(LatencyInjectingModelTest, logNormalLatency) {
+  LatencyInjectingModel::Config config;
+  config.latencyUs = 10'000;
+  config.latencySigma = 0.5;
+  config.seed = 1;
+  LatencyInjectingModel model(config);
+
+  constexpr int kNumRequests = 10'000;
+  int numBelowMedian = 0;
+  for (auto i = 0; i < kNumRequests; ++i) {
+    if (model.delayUs(0, 0) < config.latencyUs) {
+      ++numBelowMedian;
+    }
+  }
+  EXPECT_GT(numBelowMedian, kNumRequests * 45 / 100);
+  EXPECT_LT(numBelowMedian, kNumRequests * 55 / 100);
+}
+
+TEST(LatencyInjectingModelTest, hook) {
+  LatencyInjectingModel::Config config;
+  config.latencyUs = 10;
+  LatencyInjectingModel model(config);
+  auto hook = model.makeHook();
+
+  char buf[100];
+  FaultFileReadOperation read("file", 0, 100, buf);
+  hook(&read);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(buf, 10), folly::Range<char*>(nullptr, 20)};
+  FaultFileReadvOperation readv("file", 0, buffers);
+  hook(&readv);
+  FaultFileWriteOperation write("file", "data");
+  hook(&write);
+
+  const auto stats = model.stats();
+  EXPECT_EQ(stats.numRequests, 2);
+  EXPECT_EQ(stats.bytes, 130);
+  EXPECT_TRUE(read.delegate);
+  EXPECT_TRUE(readv.delegate);
+}
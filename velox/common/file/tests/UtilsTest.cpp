@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "velox/common/base/Exceptions.h"
 #include "velox/common/file/Utils.h"
 #include "velox/common/file/tests/TestUtils.h"
 
@@ -289,3 +291,38 @@ INSTANTIATE_TEST_SUITE_P(
     ReadToIOBufsTest,
     ValuesIn(
         std::vector<bool /* Should generated chained IOBuf */>({false, true})));
+
+TEST(ReadRangesAsyncTest, readsRangesAndSkipsGaps) {
+  const std::string data = "0123456789abcdefghij";
+  folly::CPUThreadPoolExecutor executor(4);
+  std::atomic<int32_t> numReads{0};
+  auto read = [&](uint64_t offset, uint64_t length, char* buffer) {
+    ++numReads;
+    memcpy(buffer, data.data() + offset, length);
+  };
+
+  std::string first(3, ' ');
+  std::string second(4, ' ');
+  std::string third(2, ' ');
+  std::vector<folly::Range<char*>> buffers = {
+      {first.data(), first.size()},
+      {nullptr, 5},
+      {second.data(), second.size()},
+      {third.data(), third.size()},
+      {nullptr, 2}};
+  EXPECT_EQ(readRangesAsync(1, buffers, &executor, read).get(), 16);
+  EXPECT_EQ(numReads, 3);
+  EXPECT_EQ(first, "123");
+  EXPECT_EQ(second, "9abc");
+  EXPECT_EQ(third, "de");
+
+  EXPECT_EQ(readRangesAsync(0, {{nullptr, 4}}, &executor, read).get(), 4);
+  EXPECT_EQ(numReads, 3);
+
+  auto failingRead = [](uint64_t, uint64_t, char*) {
+    VELOX_FAIL("Read failed");
+  };
+  EXPECT_THROW(
+      readRangesAsync(0, buffers, &executor, failingRead).get(),
+      VeloxRuntimeError);
+}
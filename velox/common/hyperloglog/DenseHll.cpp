@@ -15,6 +15,7 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <algorithm>
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
@@ -143,6 +144,14 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(folly::Range<const uint64_t*> hashes) {
+  for (auto hash : hashes) {
+    insert(
+        computeIndex(hash, indexBitLength_),
+        numberOfLeadingZeros(hash, indexBitLength_) + 1);
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
@@ -202,15 +211,43 @@ struct DenseHllView {
   }
 };
 
-int64_t cardinalityImpl(const DenseHllView& hll) {
-  auto numBuckets = 1 << hll.indexBitLength;
+/// Counts the buckets with each of the possible deltas. 'deltas' has 2 buckets
+/// per byte, see shiftForBucket().
+void countDeltas(
+    const int8_t* deltas,
+    int32_t numBytes,
+    int32_t (&counts)[kMaxDelta + 1]) {
+  std::fill(std::begin(counts), std::end(counts), 0);
 
-  int32_t baselineCount = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    if (hll.getDelta(i) == 0) {
-      baselineCount++;
+  constexpr auto batchSize = xsimd::batch<int8_t>::size;
+  const auto bucketMaskBatch = xsimd::broadcast(kBucketMask);
+  int32_t i = 0;
+  for (; i + batchSize <= numBytes; i += batchSize) {
+    auto batch = xsimd::load_unaligned(deltas + i);
+    auto evenBatch = xsimd::bitwise_and(
+        xsimd::kernel::bitwise_rshift(batch, 4, xsimd::default_arch{}),
+        bucketMaskBatch);
+    auto oddBatch = xsimd::bitwise_and(batch, bucketMaskBatch);
+    for (int8_t delta = 0; delta <= kMaxDelta; ++delta) {
+      const auto deltaBatch = xsimd::broadcast(delta);
+      auto evenMask = xsimd::eq(evenBatch, deltaBatch).mask();
+      auto oddMask = xsimd::eq(oddBatch, deltaBatch).mask();
+      counts[delta] += bits::countBits(&evenMask, 0, batchSize) +
+          bits::countBits(&oddMask, 0, batchSize);
     }
   }
+  for (; i < numBytes; ++i) {
+    ++counts[(deltas[i] >> 4) & kBucketMask];
+    ++counts[deltas[i] & kBucketMask];
+  }
+}
+
+int64_t cardinalityImpl(const DenseHllView& hll) {
+  auto numBuckets = 1 << hll.indexBitLength;
+
+  int32_t deltaCounts[kMaxDelta + 1];
+  countDeltas(hll.deltas, numBuckets / 2, deltaCounts);
+  const int32_t baselineCount = deltaCounts[0];
 
   // If baseline is zero, then baselineCount is the number of buckets with value
   // 0.
@@ -219,10 +256,19 @@ int64_t cardinalityImpl(const DenseHllView& hll) {
     return std::round(linearCounting(baselineCount, numBuckets));
   }
 
+  // Sums 1 / 2^value over all buckets. All buckets with the same delta add
+  // the same term. Buckets with an overflow have a value larger than baseline +
+  // kMaxDelta, which replaces their term.
   double sum = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    int value = hll.getValue(i);
-    sum += 1.0 / (1L << value);
+  for (int delta = 0; delta <= kMaxDelta; ++delta) {
+    sum += deltaCounts[delta] * std::ldexp(1.0, -(hll.baseline + delta));
+  }
+  for (int i = 0; i < hll.overflows; ++i) {
+    const auto bucket = hll.overflowBuckets[i];
+    if (hll.getDelta(bucket) == kMaxDelta) {
+      sum += std::ldexp(1.0, -hll.getValue(bucket)) -
+          std::ldexp(1.0, -(hll.baseline + kMaxDelta));
+    }
   }
 
   double estimate = (alpha(hll.indexBitLength) * numBuckets * numBuckets) / sum;
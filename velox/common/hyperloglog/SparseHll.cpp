@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/common/hyperloglog/SparseHll.h"
+
+#include <algorithm>
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -88,6 +90,54 @@ bool SparseHll::insertHash(uint64_t hash) {
   return overLimit();
 }
 
+size_t SparseHll::insertHashes(folly::Range<const uint64_t*> hashes) {
+  // Below this size, inserting into the sorted entries one by one is cheaper
+  // than sorting.
+  constexpr size_t kMinSortedBatch = 16;
+
+  std::vector<uint32_t> newEntries;
+  size_t numInserted = 0;
+  while (numInserted < hashes.size() && !overLimit()) {
+    // No more than this many entries can be added without reaching the limit,
+    // so the limit is checked after each batch like after each insertHash().
+    const auto batchSize = std::min<size_t>(
+        hashes.size() - numInserted,
+        std::max<size_t>(
+            kMinSortedBatch, softNumEntriesLimit_ - entries_.size()));
+    if (batchSize < kMinSortedBatch) {
+      for (size_t i = 0; i < batchSize; ++i) {
+        if (insertHash(hashes[numInserted++])) {
+          break;
+        }
+      }
+      continue;
+    }
+
+    newEntries.resize(batchSize);
+    for (size_t i = 0; i < batchSize; ++i) {
+      const auto hash = hashes[numInserted + i];
+      newEntries[i] = encode(
+          computeIndex(hash, kIndexBitLength),
+          numberOfLeadingZeros(hash, kIndexBitLength));
+    }
+    numInserted += batchSize;
+
+    // Entries with the same index are ordered by value. Keeps the last one,
+    // which has the largest value.
+    std::sort(newEntries.begin(), newEntries.end());
+    size_t numUnique = 0;
+    for (size_t i = 0; i < batchSize; ++i) {
+      if (i + 1 < batchSize &&
+          decodeIndex(newEntries[i]) == decodeIndex(newEntries[i + 1])) {
+        continue;
+      }
+      newEntries[numUnique++] = newEntries[i];
+    }
+    mergeWith(numUnique, newEntries.data());
+  }
+  return numInserted;
+}
+
 int64_t SparseHll::cardinality() const {
   // Estimate the cardinality using linear counting over the theoretical
   // 2^kIndexBitLength buckets available due to the fact that we're
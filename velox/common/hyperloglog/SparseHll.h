@@ -40,6 +40,14 @@ class SparseHll {
   /// Returns true if soft memory limit has been reached. False, otherwise.
   bool insertHash(uint64_t hash);
 
+  /// Inserts 'hashes' until the soft memory limit is reached. Returns the
+  /// number of hashes inserted, which is less than hashes.size() only if
+  /// overLimit() is true. Larger batches are sorted and merged into the
+  /// entries in one pass, which may go a few entries over the limit. Either
+  /// way, converting to DenseHll and inserting the remaining hashes there gives
+  /// the same result as calling insertHash() for each hash.
+  size_t insertHashes(folly::Range<const uint64_t*> hashes);
+
   int64_t cardinality() const;
 
   /// Returns cardinality estimate from the specified serialized digest.
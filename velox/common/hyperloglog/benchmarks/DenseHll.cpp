@@ -36,6 +36,9 @@ uint64_t hashOne(T value) {
 // values for hash bits. Larger values of hash bits corresponds to larger
 // digests that are more accurate, but slower to merge. The default number of
 // hash bits is 11, while in practice 16 is common.
+//
+// Also measures cardinality estimation of a serialized digest and inserting
+// hashes one at a time vs. in a batch.
 class DenseHllBenchmark {
  public:
   explicit DenseHllBenchmark(memory::MemoryPool* pool) : pool_(pool) {
@@ -43,6 +46,10 @@ class DenseHllBenchmark {
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 1));
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 2));
     }
+    hashes_.reserve(kNumHashes);
+    for (int32_t i = 0; i < kNumHashes; ++i) {
+      hashes_.push_back(hashOne(i));
+    }
   }
 
   void run(int hashBits) {
@@ -58,6 +65,32 @@ class DenseHllBenchmark {
     }
   }
 
+  int64_t runCardinality(int hashBits) {
+    int64_t sum = 0;
+    for (const auto& serialized : serializedHlls_.at(hashBits)) {
+      sum += common::hll::DenseHll::cardinality(serialized.data());
+    }
+    return sum;
+  }
+
+  void runInsert(int hashBits, bool batch) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll hll(hashBits, &allocator);
+
+    suspender.dismiss();
+
+    if (batch) {
+      hll.insertHashes(folly::Range(hashes_.data(), hashes_.size()));
+    } else {
+      for (auto hash : hashes_) {
+        hll.insertHash(hash);
+      }
+    }
+    folly::doNotOptimizeAway(hll.cardinality());
+  }
+
  private:
   std::string makeSerializedHll(int hashBits, int32_t step) {
     HashStringAllocator allocator(pool_);
@@ -77,11 +110,15 @@ class DenseHllBenchmark {
     return serialized;
   }
 
+  static constexpr int32_t kNumHashes = 100'000;
+
   memory::MemoryPool* pool_;
 
   // List of serialized HLLs to use for merging, keyed by the number of hash
   // bits.
   std::unordered_map<int, std::vector<std::string>> serializedHlls_;
+
+  std::vector<uint64_t> hashes_;
 };
 
 } // namespace
@@ -100,6 +137,38 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(cardinality11) {
+  folly::doNotOptimizeAway(benchmark->runCardinality(11));
+}
+
+BENCHMARK(cardinality12) {
+  folly::doNotOptimizeAway(benchmark->runCardinality(12));
+}
+
+BENCHMARK(cardinality16) {
+  folly::doNotOptimizeAway(benchmark->runCardinality(16));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(insertHash12) {
+  benchmark->runInsert(12, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes12) {
+  benchmark->runInsert(12, true);
+}
+
+BENCHMARK(insertHash16) {
+  benchmark->runInsert(16, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes16) {
+  benchmark->runInsert(16, true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
@@ -158,6 +158,22 @@ TEST_P(DenseHllTest, highCardinality) {
   ASSERT_EQ(denseHll.cardinality(), DenseHll::cardinality(serialized.data()));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  DenseHll expected{indexBitLength, &allocator_};
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 1'000'000; i++) {
+    hashes.push_back(hashOne(i));
+    expected.insertHash(hashes.back());
+  }
+
+  DenseHll denseHll{indexBitLength, &allocator_};
+  denseHll.insertHashes(folly::Range(hashes.data(), hashes.size()));
+  ASSERT_EQ(denseHll.cardinality(), expected.cardinality());
+  ASSERT_EQ(serialize(denseHll), serialize(expected));
+}
+
 namespace {
 template <typename T>
 std::vector<T> sequence(T start, T end) {
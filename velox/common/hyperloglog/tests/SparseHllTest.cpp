@@ -173,6 +173,30 @@ TEST_F(SparseHllTest, mergeWith) {
   testMergeWith({}, sequence(100, 300));
 }
 
+TEST_F(SparseHllTest, insertHashes) {
+  SparseHll expected{&allocator_};
+  SparseHll sparseHll{&allocator_};
+  expected.setSoftMemoryLimit(1 << 20);
+  sparseHll.setSoftMemoryLimit(1 << 20);
+
+  // Repeated values and batches below and above the sorted batch size.
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 5'000; i++) {
+    hashes.push_back(hashOne(i % 1'700));
+    expected.insertHash(hashes.back());
+  }
+  for (size_t i = 0, batchSize = 1; i < hashes.size(); batchSize *= 2) {
+    auto size = std::min(batchSize, hashes.size() - i);
+    ASSERT_EQ(
+        sparseHll.insertHashes(folly::Range(hashes.data() + i, size)), size);
+    i += size;
+  }
+
+  sparseHll.verify();
+  ASSERT_FALSE(sparseHll.overLimit());
+  ASSERT_EQ(serialize(11, sparseHll), serialize(11, expected));
+}
+
 class SparseHllToDenseTest : public ::testing::TestWithParam<int8_t> {
  protected:
   static void SetUpTestCase() {
@@ -209,6 +233,31 @@ TEST_P(SparseHllToDenseTest, toDense) {
   ASSERT_EQ(serialize(denseHll), serialize(expectedHll));
 }
 
+TEST_P(SparseHllToDenseTest, insertHashesOverLimit) {
+  int8_t indexBitLength = GetParam();
+
+  SparseHll sparseHll{&allocator_};
+  sparseHll.setSoftMemoryLimit(DenseHll::estimateInMemorySize(indexBitLength));
+  DenseHll expectedHll{indexBitLength, &allocator_};
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 100'000; i++) {
+    hashes.push_back(hashOne(i));
+    expectedHll.insertHash(hashes.back());
+  }
+
+  auto numInserted =
+      sparseHll.insertHashes(folly::Range(hashes.data(), hashes.size()));
+  ASSERT_TRUE(sparseHll.overLimit());
+  ASSERT_LT(numInserted, hashes.size());
+
+  DenseHll denseHll{indexBitLength, &allocator_};
+  sparseHll.toDense(denseHll);
+  denseHll.insertHashes(
+      folly::Range(hashes.data() + numInserted, hashes.size() - numInserted));
+  ASSERT_EQ(denseHll.cardinality(), expectedHll.cardinality());
+  ASSERT_EQ(serialize(denseHll), serialize(expectedHll));
+}
+
 TEST_P(SparseHllToDenseTest, testNumberOfZeros) {
   auto indexBitLength = GetParam();
   for (int i = 0; i < 64 - indexBitLength; ++i) {
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoConcurrencyLimiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <shared_mutex>
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+namespace facebook::velox::io {
+namespace {
+uint64_t nowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+} // namespace
+
+std::string IoConcurrencyLimiter::Config::toString() const {
+  return fmt::format(
+      "initialLimit:{} minLimit:{} maxLimit:{} additiveIncrease:{} decreaseFactor:{} targetLatencyMs:{} decreaseIntervalMs:{} maxLocations:{}",
+      initialLimit,
+      minLimit,
+      maxLimit,
+      additiveIncrease,
+      decreaseFactor,
+      targetLatencyMs,
+      decreaseIntervalMs,
+      maxLocations);
+}
+
+void IoConcurrencyLimiter::Permit::release() {
+  if (location_ == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(location_->mutex);
+  --location_->inFlight;
+  location_.reset();
+}
+
+void IoConcurrencyLimiter::init(const Config& config) {
+  std::unique_lock guard{instanceLock()};
+  auto& instance = instanceRef();
+  if (instance != nullptr) {
+    LOG(WARNING) << "IO concurrency limiter has already been set";
+    return;
+  }
+  instance =
+      std::unique_ptr<IoConcurrencyLimiter>(new IoConcurrencyLimiter(config));
+  LOG(INFO) << "IO concurrency limiter config: " << config.toString();
+}
+
+IoConcurrencyLimiter* IoConcurrencyLimiter::instance() {
+  std::shared_lock guard{instanceLock()};
+  return instanceRef().get();
+}
+
+std::string_view IoConcurrencyLimiter::location(std::string_view path) {
+  const auto scheme = path.find("://");
+  const auto begin = scheme == std::string_view::npos ? 0 : scheme + 3;
+  const auto slash = path.rfind('/');
+  if (slash == std::string_view::npos || slash < begin) {
+    return path.substr(begin);
+  }
+  return path.substr(begin, slash - begin);
+}
+
+std::shared_ptr<IoConcurrencyLimiter::Location>
+IoConcurrencyLimiter::findLocation(std::string_view path) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = locations_.find(location(path));
+  return it == locations_.end() ? nullptr : it->second;
+}
+
+std::optional<IoConcurrencyLimiter::Permit> IoConcurrencyLimiter::tryAcquire(
+    std::string_view path) {
+  auto location = findLocation(path);
+  if (location == nullptr) {
+    return Permit();
+  }
+  {
+    std::lock_guard<std::mutex> l(location->mutex);
+    if (location->inFlight >= location->limit) {
+      ++stats_.rejected;
+      return std::nullopt;
+    }
+    ++location->inFlight;
+  }
+  return Permit(std::move(location));
+}
+
+void IoConcurrencyLimiter::record(
+    std::string_view path,
+    uint64_t latencyMs,
+    bool throttled) {
+  auto location = findLocation(path);
+  if (location == nullptr) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (locations_.size() >= config_.maxLocations) {
+      // Permits in flight keep their locations alive.
+      locations_.clear();
+    }
+    auto& entry =
+        locations_[std::string(IoConcurrencyLimiter::location(path))];
+    if (entry == nullptr) {
+      entry = std::make_shared<Location>();
+      entry->limit = config_.initialLimit;
+    }
+    location = entry;
+  }
+
+  throttled |=
+      config_.targetLatencyMs > 0 && latencyMs > config_.targetLatencyMs;
+  std::lock_guard<std::mutex> l(location->mutex);
+  if (!throttled) {
+    location->limit = std::min<double>(
+        config_.maxLimit,
+        location->limit + config_.additiveIncrease / location->limit);
+    return;
+  }
+  ++stats_.throttled;
+  const auto now = nowMs();
+  if (location->lastDecreaseMs != 0 &&
+      now - location->lastDecreaseMs < config_.decreaseIntervalMs) {
+    return;
+  }
+  location->limit = std::max<double>(
+      config_.minLimit, location->limit * config_.decreaseFactor);
+  location->lastDecreaseMs = now;
+  ++stats_.decreases;
+}
+
+std::optional<uint32_t> IoConcurrencyLimiter::limit(
+    std::string_view path) const {
+  auto location = findLocation(path);
+  if (location == nullptr) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> l(location->mutex);
+  return static_cast<uint32_t>(location->limit);
+}
+
+} // namespace facebook::velox::io
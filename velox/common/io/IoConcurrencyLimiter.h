@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <folly/SharedMutex.h>
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::io {
+
+/// Limits the number of concurrent reads ahead, i.e. split preloads, file
+/// prefetches and background cache loads, per storage location. A storage
+/// location is the directory of a file, which for object stores is the prefix
+/// that the store throttles on.
+///
+/// The limit of a location adapts the way TCP congestion control does
+/// (additive increase, multiplicative decrease). The storage adapters report
+/// each request with its latency and whether the store asked to slow down,
+/// e.g. with a 503 SlowDown from S3. A throttled or slow request cuts the
+/// limit by a factor, at most once per 'decreaseIntervalMs'. Each other
+/// request raises the limit by 'additiveIncrease' / limit, i.e. by
+/// 'additiveIncrease' for a full window of requests.
+///
+/// Reads ahead that do not get a permit are not issued. The data is then
+/// read on demand by the thread that needs it. Only locations that a storage
+/// adapter has reported on are limited, so local files are not affected.
+class IoConcurrencyLimiter {
+ public:
+  struct Config {
+    /// The limit of a location on its first report.
+    uint32_t initialLimit{16};
+
+    uint32_t minLimit{1};
+
+    uint32_t maxLimit{256};
+
+    /// The increase of the limit over a window of successful requests.
+    double additiveIncrease{1};
+
+    /// The factor the limit is multiplied with on throttling.
+    double decreaseFactor{0.5};
+
+    /// Requests slower than this count as throttled. 0 means no latency
+    /// target.
+    uint64_t targetLatencyMs{0};
+
+    /// The minimum time between two decreases of the limit of a location.
+    /// Throttled requests that were in flight at the time of a decrease
+    /// should not decrease the limit again.
+    uint64_t decreaseIntervalMs{1'000};
+
+    /// The maximum number of locations tracked. All are forgotten when
+    /// exceeded.
+    uint32_t maxLocations{10'000};
+
+    std::string toString() const;
+  };
+
+  struct Stats {
+    std::atomic_uint64_t throttled{0};
+    std::atomic_uint64_t decreases{0};
+    /// The number of reads ahead not issued for lack of a permit.
+    std::atomic_uint64_t rejected{0};
+  };
+
+ private:
+  struct Location {
+    std::mutex mutex;
+    double limit;
+    uint32_t inFlight{0};
+    uint64_t lastDecreaseMs{0};
+  };
+
+ public:
+  /// Holds one of the concurrent reads of a location. Released on
+  /// destruction.
+  class Permit {
+   public:
+    Permit() = default;
+
+    Permit(Permit&& other) noexcept = default;
+
+    Permit& operator=(Permit&& other) noexcept {
+      release();
+      location_ = std::move(other.location_);
+      return *this;
+    }
+
+    ~Permit() {
+      release();
+    }
+
+   private:
+    explicit Permit(std::shared_ptr<Location> location)
+        : location_(std::move(location)) {}
+
+    void release();
+
+    // nullptr if the location is not limited.
+    std::shared_ptr<Location> location_;
+
+    friend class IoConcurrencyLimiter;
+  };
+
+  static void init(const Config& config);
+
+  /// Returns the limiter or nullptr if init() has not been called.
+  static IoConcurrencyLimiter* instance();
+
+  static void testingReset() {
+    instanceRef().reset();
+  }
+
+  /// Returns the storage location of 'path', i.e. 'path' up to its last '/'
+  /// without the scheme. The schemes that name the same store, like s3:// and
+  /// s3a://, share the location.
+  static std::string_view location(std::string_view path);
+
+  /// Returns a permit to read ahead from the file at 'path' or std::nullopt
+  /// if the location of 'path' has as many reads ahead in flight as its limit.
+  std::optional<Permit> tryAcquire(std::string_view path);
+
+  /// Adjusts the limit of the location of 'path' after a request to the file
+  /// at 'path' that took 'latencyMs'. 'throttled' is true if the storage
+  /// asked to slow down.
+  void record(std::string_view path, uint64_t latencyMs, bool throttled);
+
+  /// Returns the limit of the location of 'path' or std::nullopt if the
+  /// location is not limited.
+  std::optional<uint32_t> limit(std::string_view path) const;
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+ private:
+  static folly::SharedMutex& instanceLock() {
+    static folly::SharedMutex mu;
+    return mu;
+  }
+
+  static std::unique_ptr<IoConcurrencyLimiter>& instanceRef() {
+    static std::unique_ptr<IoConcurrencyLimiter> instance;
+    return instance;
+  }
+
+  explicit IoConcurrencyLimiter(const Config& config) : config_(config) {}
+
+  std::shared_ptr<Location> findLocation(std::string_view path) const;
+
+  const Config config_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, std::shared_ptr<Location>> locations_;
+
+  Stats stats_;
+};
+
+} // namespace facebook::velox::io
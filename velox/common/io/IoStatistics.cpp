@@ -21,6 +21,9 @@
 #include "velox/common/io/IoStatistics.h"
 
 namespace facebook::velox::io {
+namespace {
+thread_local IoStatistics* currentIoStatistics{nullptr};
+} // namespace
 
 uint64_t IoStatistics::rawBytesRead() const {
   return rawBytesRead_.load(std::memory_order_relaxed);
@@ -110,7 +113,14 @@ void IoStatistics::merge(const IoStatistics& other) {
   read_.merge(other.read_);
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
+  peerRead_.merge(other.peerRead_);
+  metadataCacheHit_.merge(other.metadataCacheHit_);
+  metadataCacheMiss_.merge(other.metadataCacheMiss_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  adaptiveCoalesceDistance_.merge(other.adaptiveCoalesceDistance_);
+  adaptiveCoalesceBytes_.merge(other.adaptiveCoalesceBytes_);
+  hedgedReads_.merge(other.hedgedReads_);
+  hedgeWins_.merge(other.hedgeWins_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
@@ -154,4 +164,17 @@ folly::dynamic IoStatistics::getOperationStatsSnapshot() const {
   return json;
 }
 
+IoStatistics* IoStatistics::current() {
+  return currentIoStatistics;
+}
+
+ScopedIoStatistics::ScopedIoStatistics(IoStatistics* stats)
+    : previous_(currentIoStatistics) {
+  currentIoStatistics = stats;
+}
+
+ScopedIoStatistics::~ScopedIoStatistics() {
+  currentIoStatistics = previous_;
+}
+
 } // namespace facebook::velox::io
@@ -117,14 +117,52 @@ class IoStatistics {
     return ssdRead_;
   }
 
+  IoCounter& peerRead() {
+    return peerRead_;
+  }
+
   IoCounter& ramHit() {
     return ramHit_;
   }
 
+  /// File tails found in the FileMetadataCache. The amount is the size of the
+  /// metadata that was not read.
+  IoCounter& metadataCacheHit() {
+    return metadataCacheHit_;
+  }
+
+  /// File tails read and parsed with the FileMetadataCache enabled.
+  IoCounter& metadataCacheMiss() {
+    return metadataCacheMiss_;
+  }
+
   IoCounter& queryThreadIoLatency() {
     return queryThreadIoLatency_;
   }
 
+  /// Coalescing gaps chosen from the observed storage latency and throughput,
+  /// one per batch of planned loads.
+  IoCounter& adaptiveCoalesceDistance() {
+    return adaptiveCoalesceDistance_;
+  }
+
+  /// Maximum coalesced request sizes chosen from the observed storage latency
+  /// and throughput, one per batch of planned loads.
+  IoCounter& adaptiveCoalesceBytes() {
+    return adaptiveCoalesceBytes_;
+  }
+
+  /// Reads for which a second, hedged request was sent because the first was
+  /// slow. The amount is the bytes of the read.
+  IoCounter& hedgedReads() {
+    return hedgedReads_;
+  }
+
+  /// Hedged reads that the hedged request completed first.
+  IoCounter& hedgeWins() {
+    return hedgeWins_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -143,6 +181,11 @@ class IoStatistics {
 
   folly::dynamic getOperationStatsSnapshot() const;
 
+  /// Returns the IoStatistics set for the current thread by
+  /// ScopedIoStatistics or nullptr. Storage adapters report IO the ReadFile
+  /// interface does not return, like hedged requests, here.
+  static IoStatistics* current();
+
  private:
   std::atomic<uint64_t> rawBytesRead_{0};
   std::atomic<uint64_t> rawBytesWritten_{0};
@@ -164,12 +207,37 @@ class IoStatistics {
   // reads.
   IoCounter ssdRead_;
 
+  // Read from the cache of another worker instead of storage.
+  IoCounter peerRead_;
+
+  // Hits and misses of the process-wide cache of parsed file tails.
+  IoCounter metadataCacheHit_;
+  IoCounter metadataCacheMiss_;
+
   // Time spent by a query processing thread waiting for synchronously issued IO
   // or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  IoCounter adaptiveCoalesceDistance_;
+  IoCounter adaptiveCoalesceBytes_;
+
+  IoCounter hedgedReads_;
+  IoCounter hedgeWins_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
 
+/// Makes 'stats' the IoStatistics::current() of the thread for the lifetime
+/// of 'this'.
+class ScopedIoStatistics {
+ public:
+  explicit ScopedIoStatistics(IoStatistics* stats);
+
+  ~ScopedIoStatistics();
+
+ private:
+  IoStatistics* const previous_;
+};
+
 } // namespace facebook::velox::io
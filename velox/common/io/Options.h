@@ -104,6 +104,14 @@ class ReaderOptions {
     return *this;
   }
 
+  /// If true, the coalescing limits are derived from the observed latency and
+  /// throughput of the storage once enough reads are seen. The maximum
+  /// coalesce distance and bytes apply until then.
+  ReaderOptions& setAdaptiveCoalescing(bool adaptive) {
+    adaptiveCoalescing_ = adaptive;
+    return *this;
+  }
+
   /// Modifies the number of row groups to prefetch.
   ReaderOptions& setPrefetchRowGroups(int32_t numPrefetch) {
     prefetchRowGroups_ = numPrefetch;
@@ -135,6 +143,10 @@ class ReaderOptions {
     return maxCoalesceBytes_;
   }
 
+  bool adaptiveCoalescing() const {
+    return adaptiveCoalescing_;
+  }
+
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
@@ -154,6 +166,7 @@ class ReaderOptions {
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
+  bool adaptiveCoalescing_{false};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
   bool noCacheRetention_{false};
 };
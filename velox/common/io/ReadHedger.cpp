@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/ReadHedger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <shared_mutex>
+
+#include <fmt/format.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <glog/logging.h>
+
+#include "velox/common/io/IoConcurrencyLimiter.h"
+#include "velox/common/io/IoStatistics.h"
+
+namespace facebook::velox::io {
+namespace {
+// The number of latest latencies a location keeps.
+constexpr size_t kMaxLatencies = 1'024;
+
+// The number of reads between two computations of the hedge delay.
+constexpr uint64_t kDelayUpdateInterval = 64;
+
+uint64_t elapsedMs(std::chrono::steady_clock::time_point startTime) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - startTime)
+      .count();
+}
+} // namespace
+
+// The state shared by the first request of a read and its hedge.
+struct ReadHedger::HedgeState {
+  enum class Winner { kNone, kFirst, kHedge };
+
+  HedgeState(uint64_t _length, ReadFunc _read)
+      : length(_length), read(std::move(_read)) {}
+
+  const uint64_t length;
+  const ReadFunc read;
+
+  // Set by the request that completes first. The other one is cancelled.
+  std::atomic<Winner> winner{Winner::kNone};
+
+  std::mutex mutex;
+  std::condition_variable hedgeDone;
+  bool hedged{false};
+  bool hedgeRunning{false};
+
+  // The data read by the hedge.
+  std::string buffer;
+};
+
+std::string ReadHedger::Config::toString() const {
+  return fmt::format(
+      "percentile:{} minDelayMs:{} minSamples:{} maxHedgeRatio:{} numThreads:{} maxLocations:{}",
+      percentile,
+      minDelayMs,
+      minSamples,
+      maxHedgeRatio,
+      numThreads,
+      maxLocations);
+}
+
+void ReadHedger::init(const Config& config) {
+  std::unique_lock guard{instanceLock()};
+  auto& instance = instanceRef();
+  if (instance != nullptr) {
+    LOG(WARNING) << "Read hedger has already been set";
+    return;
+  }
+  instance = std::unique_ptr<ReadHedger>(new ReadHedger(config));
+  LOG(INFO) << "Read hedger config: " << config.toString();
+}
+
+ReadHedger* ReadHedger::instance() {
+  std::shared_lock guard{instanceLock()};
+  return instanceRef().get();
+}
+
+ReadHedger::ReadHedger(const Config& config)
+    : config_(config),
+      executor_(std::make_unique<folly::IOThreadPoolExecutor>(
+          config.numThreads,
+          std::make_shared<folly::NamedThreadFactory>("ReadHedge"))) {}
+
+void ReadHedger::read(
+    std::string_view path,
+    uint64_t length,
+    char* buffer,
+    const ReadFunc& readRange) {
+  ++stats_.reads;
+  const auto startTime = std::chrono::steady_clock::now();
+  const auto delayMs = hedgeDelayMs(path);
+  if (!delayMs.has_value()) {
+    readRange(buffer, nullptr);
+    recordLatency(path, elapsedMs(startTime));
+    return;
+  }
+
+  using Winner = HedgeState::Winner;
+  auto state = std::make_shared<HedgeState>(length, readRange);
+  folly::futures::sleep(std::chrono::milliseconds(*delayMs))
+      .via(folly::getKeepAliveToken(executor_.get()))
+      .thenValue(
+          [this, state, hedgePath = std::string(path)](auto&& /*unused*/) {
+            hedge(state, hedgePath);
+          });
+
+  bool completed{false};
+  std::exception_ptr error;
+  try {
+    completed = readRange(
+        buffer, [&state]() { return state->winner == Winner::kHedge; });
+  } catch (...) {
+    error = std::current_exception();
+  }
+  if (completed) {
+    recordLatency(path, elapsedMs(startTime));
+  }
+
+  bool hedged;
+  bool hedgeWon;
+  {
+    std::unique_lock<std::mutex> l(state->mutex);
+    // Cancels the hedge if it is running and keeps it from starting.
+    auto expected = Winner::kNone;
+    state->winner.compare_exchange_strong(expected, Winner::kFirst);
+    state->hedgeDone.wait(l, [&]() { return !state->hedgeRunning; });
+    hedged = state->hedged;
+    hedgeWon = state->winner == Winner::kHedge;
+  }
+  if (hedged) {
+    if (auto* ioStats = IoStatistics::current()) {
+      ioStats->hedgedReads().increment(length);
+      if (hedgeWon) {
+        ioStats->hedgeWins().increment(length);
+      }
+    }
+  }
+  if (completed) {
+    return;
+  }
+  if (hedgeWon) {
+    std::memcpy(buffer, state->buffer.data(), length);
+    return;
+  }
+  // The first request is only cancelled when the hedge won.
+  DCHECK(error != nullptr);
+  std::rethrow_exception(error);
+}
+
+void ReadHedger::hedge(
+    const std::shared_ptr<HedgeState>& state,
+    std::string path) {
+  using Winner = HedgeState::Winner;
+  {
+    std::lock_guard<std::mutex> l(state->mutex);
+    if (state->winner != Winner::kNone || !tryStartHedge()) {
+      return;
+    }
+    state->hedged = true;
+    state->hedgeRunning = true;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+  bool completed{false};
+  try {
+    state->buffer.resize(state->length);
+    completed = state->read(state->buffer.data(), [&state]() {
+      return state->winner == Winner::kFirst;
+    });
+  } catch (const std::exception& e) {
+    VLOG(1) << "Hedged read of " << path << " failed: " << e.what();
+  }
+  if (completed) {
+    recordLatency(path, elapsedMs(startTime));
+  }
+
+  {
+    std::lock_guard<std::mutex> l(state->mutex);
+    auto expected = Winner::kNone;
+    if (completed &&
+        state->winner.compare_exchange_strong(expected, Winner::kHedge)) {
+      ++stats_.hedgeWins;
+    }
+    state->hedgeRunning = false;
+  }
+  state->hedgeDone.notify_all();
+}
+
+bool ReadHedger::tryStartHedge() {
+  auto hedges = stats_.hedges.load();
+  do {
+    if (hedges + 1 > config_.maxHedgeRatio * stats_.reads) {
+      return false;
+    }
+  } while (!stats_.hedges.compare_exchange_weak(hedges, hedges + 1));
+  return true;
+}
+
+std::optional<uint64_t> ReadHedger::hedgeDelayMs(std::string_view path) const {
+  std::shared_ptr<Location> location;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = locations_.find(IoConcurrencyLimiter::location(path));
+    if (it == locations_.end()) {
+      return std::nullopt;
+    }
+    location = it->second;
+  }
+  std::lock_guard<std::mutex> l(location->mutex);
+  return location->delayMs;
+}
+
+void ReadHedger::recordLatency(std::string_view path, uint64_t latencyMs) {
+  std::shared_ptr<Location> location;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto name = IoConcurrencyLimiter::location(path);
+    auto it = locations_.find(name);
+    if (it != locations_.end()) {
+      location = it->second;
+    } else {
+      if (locations_.size() >= config_.maxLocations) {
+        locations_.clear();
+      }
+      location = std::make_shared<Location>();
+      locations_.emplace(std::string(name), location);
+    }
+  }
+
+  std::lock_guard<std::mutex> l(location->mutex);
+  auto& latencies = location->latencies;
+  if (latencies.size() < kMaxLatencies) {
+    latencies.push_back(latencyMs);
+  } else {
+    latencies[location->numReads % kMaxLatencies] = latencyMs;
+  }
+  ++location->numReads;
+  if (location->numReads < config_.minSamples ||
+      (location->numReads - config_.minSamples) % kDelayUpdateInterval != 0) {
+    return;
+  }
+  auto sorted = latencies;
+  const auto nth = sorted.begin() +
+      std::min<size_t>(sorted.size() - 1, config_.percentile * sorted.size());
+  std::nth_element(sorted.begin(), nth, sorted.end());
+  location->delayMs = std::max(config_.minDelayMs, *nth);
+}
+
+} // namespace facebook::velox::io
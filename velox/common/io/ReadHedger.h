@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <folly/SharedMutex.h>
+#include <folly/container/F14Map.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+
+namespace facebook::velox::io {
+
+/// Cuts the tail latency of object store reads with hedged requests. A read
+/// that has not completed after the 'percentile' latency of its storage
+/// location gets a second request for the same range. The read completes
+/// with whichever request completes first and the other one is cancelled.
+///
+/// The latency percentile is computed per storage location, see
+/// IoConcurrencyLimiter::location(), over the latest requests. A process
+/// wide budget keeps the hedged requests below 'maxHedgeRatio' of all reads.
+/// The hedges run on a thread pool of the hedger. The first request runs on
+/// the calling thread.
+class ReadHedger {
+ public:
+  struct Config {
+    /// The latency percentile after which a read is hedged.
+    double percentile{0.95};
+
+    /// The minimum delay before hedging a read.
+    uint64_t minDelayMs{10};
+
+    /// The number of reads of a location before its reads are hedged.
+    uint32_t minSamples{100};
+
+    /// The maximum ratio of hedged requests to reads.
+    double maxHedgeRatio{0.05};
+
+    /// The number of threads issuing hedged requests.
+    uint32_t numThreads{8};
+
+    /// The maximum number of locations tracked. All are forgotten when
+    /// exceeded.
+    uint32_t maxLocations{10'000};
+
+    std::string toString() const;
+  };
+
+  struct Stats {
+    std::atomic_uint64_t reads{0};
+    std::atomic_uint64_t hedges{0};
+    std::atomic_uint64_t hedgeWins{0};
+  };
+
+  /// Returns true if the read in progress should stop.
+  using CancelCheck = std::function<bool()>;
+
+  /// Reads a range into 'buffer'. Returns false if it stopped because
+  /// 'cancelled' returned true and throws on errors. An empty 'cancelled'
+  /// never cancels.
+  using ReadFunc =
+      std::function<bool(char* buffer, const CancelCheck& cancelled)>;
+
+  static void init(const Config& config);
+
+  /// Returns the hedger or nullptr if init() has not been called.
+  static ReadHedger* instance();
+
+  static void testingReset() {
+    instanceRef().reset();
+  }
+
+  /// Reads 'length' bytes of the file at 'path' into 'buffer' with
+  /// 'readRange'. Calls 'readRange' a second time, on a thread of the hedger
+  /// and into a buffer of its own, if the first call takes longer than the
+  /// latency percentile of the location of 'path'. Neither call runs past
+  /// the return of this. Hedges are counted in IoStatistics::current() if
+  /// set.
+  void read(
+      std::string_view path,
+      uint64_t length,
+      char* buffer,
+      const ReadFunc& readRange);
+
+  /// Returns the delay after which a read of the file at 'path' is hedged or
+  /// std::nullopt if the location of 'path' has too few reads.
+  std::optional<uint64_t> hedgeDelayMs(std::string_view path) const;
+
+  /// Adds a read of the file at 'path' that took 'latencyMs'.
+  void recordLatency(std::string_view path, uint64_t latencyMs);
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+ private:
+  // The latest read latencies of a storage location.
+  struct Location {
+    std::mutex mutex;
+    std::vector<uint64_t> latencies;
+    uint64_t numReads{0};
+    // The hedge delay. Not set before 'minSamples' reads.
+    std::optional<uint64_t> delayMs;
+  };
+
+  struct HedgeState;
+
+  static folly::SharedMutex& instanceLock() {
+    static folly::SharedMutex mu;
+    return mu;
+  }
+
+  static std::unique_ptr<ReadHedger>& instanceRef() {
+    static std::unique_ptr<ReadHedger> instance;
+    return instance;
+  }
+
+  explicit ReadHedger(const Config& config);
+
+  // Counts a hedge if it fits in the budget. Returns false otherwise.
+  bool tryStartHedge();
+
+  // Called on the hedge thread 'delayMs' after the first request started.
+  void hedge(const std::shared_ptr<HedgeState>& state, std::string path);
+
+  const Config config_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, std::shared_ptr<Location>> locations_;
+
+  Stats stats_;
+
+  // Declared last so that it is joined before the other members go away.
+  std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
+};
+
+} // namespace facebook::velox::io
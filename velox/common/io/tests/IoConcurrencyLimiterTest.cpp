@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoConcurrencyLimiter.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::io;
+
+class IoConcurrencyLimiterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    IoConcurrencyLimiter::testingReset();
+  }
+
+  void TearDown() override {
+    IoConcurrencyLimiter::testingReset();
+  }
+
+  IoConcurrencyLimiter* makeLimiter(uint64_t decreaseIntervalMs = 0) {
+    IoConcurrencyLimiter::Config config;
+    config.initialLimit = 4;
+    config.minLimit = 1;
+    config.maxLimit = 8;
+    config.targetLatencyMs = 100;
+    config.decreaseIntervalMs = decreaseIntervalMs;
+    IoConcurrencyLimiter::init(config);
+    return IoConcurrencyLimiter::instance();
+  }
+};
+
+TEST_F(IoConcurrencyLimiterTest, location) {
+  EXPECT_EQ(
+      IoConcurrencyLimiter::location("s3://bucket/a/b/file"), "bucket/a/b");
+  EXPECT_EQ(
+      IoConcurrencyLimiter::location("s3a://bucket/a/b/file"), "bucket/a/b");
+  EXPECT_EQ(IoConcurrencyLimiter::location("gs://bucket"), "bucket");
+  EXPECT_EQ(IoConcurrencyLimiter::location("/tmp/file"), "/tmp");
+  EXPECT_EQ(IoConcurrencyLimiter::location("file"), "file");
+}
+
+TEST_F(IoConcurrencyLimiterTest, notInitialized) {
+  EXPECT_EQ(IoConcurrencyLimiter::instance(), nullptr);
+}
+
+TEST_F(IoConcurrencyLimiterTest, unknownLocation) {
+  auto* limiter = makeLimiter();
+  EXPECT_FALSE(limiter->limit("/local/file").has_value());
+  std::vector<IoConcurrencyLimiter::Permit> permits;
+  for (auto i = 0; i < 100; ++i) {
+    auto permit = limiter->tryAcquire("/local/file");
+    ASSERT_TRUE(permit.has_value());
+    permits.push_back(std::move(*permit));
+  }
+  EXPECT_EQ(limiter->stats().rejected, 0);
+}
+
+TEST_F(IoConcurrencyLimiterTest, permits) {
+  auto* limiter = makeLimiter();
+  limiter->record("s3://bucket/dir/file1", 10, false);
+  EXPECT_EQ(limiter->limit("s3://bucket/dir/file2").value(), 4);
+
+  std::vector<IoConcurrencyLimiter::Permit> permits;
+  for (auto i = 0; i < 4; ++i) {
+    auto permit = limiter->tryAcquire(fmt::format("s3://bucket/dir/f{}", i));
+    ASSERT_TRUE(permit.has_value());
+    permits.push_back(std::move(*permit));
+  }
+  EXPECT_FALSE(limiter->tryAcquire("s3://bucket/dir/file").has_value());
+  EXPECT_EQ(limiter->stats().rejected, 1);
+  // Other locations have their own limits.
+  EXPECT_TRUE(limiter->tryAcquire("s3://bucket/other/file").has_value());
+
+  permits.pop_back();
+  EXPECT_TRUE(limiter->tryAcquire("s3://bucket/dir/file").has_value());
+}
+
+TEST_F(IoConcurrencyLimiterTest, additiveIncreaseMultiplicativeDecrease) {
+  auto* limiter = makeLimiter();
+  const std::string path = "gs://bucket/dir/file";
+  limiter->record(path, 10, false);
+  // About 'limit' successful requests raise the limit by one.
+  for (auto i = 0; i < 5; ++i) {
+    limiter->record(path, 10, false);
+  }
+  EXPECT_EQ(limiter->limit(path).value(), 5);
+
+  limiter->record(path, 10, true);
+  EXPECT_EQ(limiter->limit(path).value(), 2);
+  // A slow request counts as throttled.
+  limiter->record(path, 200, false);
+  EXPECT_EQ(limiter->limit(path).value(), 1);
+  limiter->record(path, 10, true);
+  EXPECT_EQ(limiter->limit(path).value(), 1);
+  EXPECT_EQ(limiter->stats().throttled, 3);
+  EXPECT_EQ(limiter->stats().decreases, 3);
+
+  for (auto i = 0; i < 1'000; ++i) {
+    limiter->record(path, 10, false);
+  }
+  EXPECT_EQ(limiter->limit(path).value(), 8);
+}
+
+TEST_F(IoConcurrencyLimiterTest, decreaseInterval) {
+  auto* limiter = makeLimiter(60'000);
+  const std::string path = "s3://bucket/dir/file";
+  limiter->record(path, 10, false);
+  limiter->record(path, 10, true);
+  EXPECT_EQ(limiter->limit(path).value(), 2);
+  // The throttled requests that were in flight with the first one do not
+  // decrease the limit again.
+  limiter->record(path, 10, true);
+  limiter->record(path, 10, true);
+  EXPECT_EQ(limiter->limit(path).value(), 2);
+  EXPECT_EQ(limiter->stats().throttled, 3);
+  EXPECT_EQ(limiter->stats().decreases, 1);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/ReadHedger.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "velox/common/io/IoStatistics.h"
+
+using namespace facebook::velox::io;
+
+namespace {
+constexpr std::string_view kPath = "s3://bucket/dir/file";
+
+// Writes 'data' into 'buffer' after 'delayMs' unless cancelled before.
+bool slowRead(
+    char* buffer,
+    const ReadHedger::CancelCheck& cancelled,
+    std::string_view data,
+    uint64_t delayMs) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (cancelled && cancelled()) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+  }
+  std::memcpy(buffer, data.data(), data.size());
+  return true;
+}
+} // namespace
+
+class ReadHedgerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ReadHedger::testingReset();
+  }
+
+  void TearDown() override {
+    ReadHedger::testingReset();
+  }
+
+  ReadHedger* makeHedger(double maxHedgeRatio = 1) {
+    ReadHedger::Config config;
+    config.percentile = 0.5;
+    config.minDelayMs = 1;
+    config.minSamples = 10;
+    config.maxHedgeRatio = maxHedgeRatio;
+    config.numThreads = 2;
+    ReadHedger::init(config);
+    auto* hedger = ReadHedger::instance();
+    for (auto i = 0; i < 10; ++i) {
+      hedger->recordLatency(kPath, 10);
+    }
+    return hedger;
+  }
+};
+
+TEST_F(ReadHedgerTest, hedgeDelay) {
+  auto* hedger = makeHedger();
+  EXPECT_EQ(hedger->hedgeDelayMs(kPath).value(), 10);
+  EXPECT_EQ(hedger->hedgeDelayMs("s3a://bucket/dir/other").value(), 10);
+  EXPECT_FALSE(hedger->hedgeDelayMs("s3://bucket/other/file").has_value());
+}
+
+TEST_F(ReadHedgerTest, noHedgeBeforeDelay) {
+  auto* hedger = makeHedger();
+  IoStatistics stats;
+  ScopedIoStatistics scopedStats(&stats);
+  std::string buffer(4, '\0');
+  std::atomic_int32_t numCalls{0};
+  hedger->read(
+      kPath,
+      buffer.size(),
+      buffer.data(),
+      [&](char* data, const ReadHedger::CancelCheck& cancelled) {
+        ++numCalls;
+        return slowRead(data, cancelled, "fast", 0);
+      });
+  EXPECT_EQ(buffer, "fast");
+  EXPECT_EQ(numCalls, 1);
+  EXPECT_EQ(hedger->stats().hedges, 0);
+  EXPECT_EQ(stats.hedgedReads().count(), 0);
+}
+
+TEST_F(ReadHedgerTest, hedgeWins) {
+  auto* hedger = makeHedger();
+  IoStatistics stats;
+  ScopedIoStatistics scopedStats(&stats);
+  std::string buffer(4, '\0');
+  std::atomic_int32_t numCalls{0};
+  std::atomic_bool firstCancelled{false};
+  hedger->read(
+      kPath,
+      buffer.size(),
+      buffer.data(),
+      [&](char* data, const ReadHedger::CancelCheck& cancelled) {
+        if (numCalls++ == 0) {
+          const auto completed = slowRead(data, cancelled, "slow", 10'000);
+          firstCancelled = !completed;
+          return completed;
+        }
+        return slowRead(data, cancelled, "fast", 0);
+      });
+  EXPECT_EQ(buffer, "fast");
+  EXPECT_EQ(numCalls, 2);
+  EXPECT_TRUE(firstCancelled);
+  EXPECT_EQ(hedger->stats().hedges, 1);
+  EXPECT_EQ(hedger->stats().hedgeWins, 1);
+  EXPECT_EQ(stats.hedgedReads().count(), 1);
+  EXPECT_EQ(stats.hedgedReads().sum(), 4);
+  EXPECT_EQ(stats.hedgeWins().count(), 1);
+}
+
+TEST_F(ReadHedgerTest, firstWins) {
+  auto* hedger = makeHedger();
+  IoStatistics stats;
+  ScopedIoStatistics scopedStats(&stats);
+  std::string buffer(4, '\0');
+  std::atomic_int32_t numCalls{0};
+  std::atomic_bool hedgeCancelled{false};
+  hedger->read(
+      kPath,
+      buffer.size(),
+      buffer.data(),
+      [&](char* data, const ReadHedger::CancelCheck& cancelled) {
+        if (numCalls++ == 0) {
+          return slowRead(data, cancelled, "slow", 100);
+        }
+        const auto completed = slowRead(data, cancelled, "late", 10'000);
+        hedgeCancelled = !completed;
+        return completed;
+      });
+  EXPECT_EQ(buffer, "slow");
+  EXPECT_EQ(numCalls, 2);
+  // The hedge is cancelled and done when read() returns.
+  EXPECT_TRUE(hedgeCancelled);
+  EXPECT_EQ(hedger->stats().hedges, 1);
+  EXPECT_EQ(hedger->stats().hedgeWins, 0);
+  EXPECT_EQ(stats.hedgedReads().count(), 1);
+  EXPECT_EQ(stats.hedgeWins().count(), 0);
+}
+
+TEST_F(ReadHedgerTest, budget) {
+  // One hedge per 100 reads.
+  auto* hedger = makeHedger(0.01);
+  std::string buffer(4, '\0');
+  for (auto i = 0; i < 3; ++i) {
+    hedger->read(
+        kPath,
+        buffer.size(),
+        buffer.data(),
+        [&](char* data, const ReadHedger::CancelCheck& cancelled) {
+          return slowRead(data, cancelled, "slow", 50);
+        });
+    EXPECT_EQ(buffer, "slow");
+  }
+  EXPECT_EQ(hedger->stats().reads, 3);
+  EXPECT_EQ(hedger->stats().hedges, 0);
+}
+
+TEST_F(ReadHedgerTest, error) {
+  auto* hedger = makeHedger();
+  std::string buffer(4, '\0');
+  EXPECT_THROW(
+      hedger->read(
+          kPath,
+          buffer.size(),
+          buffer.data(),
+          [&](char* /*data*/, const ReadHedger::CancelCheck& /*cancelled*/)
+              -> bool { throw std::runtime_error("read failed"); }),
+      std::runtime_error);
+}
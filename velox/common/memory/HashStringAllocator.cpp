@@ -100,9 +100,27 @@ void HashStringAllocator::clear() {
   for (auto i = 0; i < kNumFreeLists; ++i) {
     new (&state_.freeLists()[i]) CompactDoubleList();
   }
+  std::fill(
+      std::begin(state_.sizeClassLists()),
+      std::end(state_.sizeClassLists()),
+      nullptr);
+  state_.numSizeClassBlocks() = 0;
+  state_.sizeClassBytes() = 0;
   state_.pool().clear();
 }
 
+HashStringAllocator::Stats HashStringAllocator::stats() const {
+  Stats stats;
+  stats.arenaBytes = state_.pool().allocatedBytes();
+  stats.sizeFromPool = state_.sizeFromPool();
+  stats.numFree = state_.numFree();
+  stats.freeBytes = state_.freeBytes();
+  stats.numSizeClassBlocks = state_.numSizeClassBlocks();
+  stats.sizeClassBytes = state_.sizeClassBytes();
+  stats.numSizeClassAllocs = state_.numSizeClassAllocs();
+  return stats;
+}
+
 void* HashStringAllocator::allocateFromPool(size_t size) {
   auto* ptr = pool()->allocate(size);
   state_.cumulativeBytes() += size;
@@ -354,9 +372,57 @@ void HashStringAllocator::removeFromFreeList(Header* header) {
   }
 }
 
+HashStringAllocator::Header* HashStringAllocator::allocateFromSizeClass(
+    int32_t size) {
+  if (size > kMaxSizeClassAlloc || state_.numSizeClassBlocks() == 0) {
+    return nullptr;
+  }
+  // Blocks in list i are at least i * kSizeClassGranularity bytes.
+  auto& head = state_.sizeClassLists()
+      [bits::roundUp(size, kSizeClassGranularity) / kSizeClassGranularity];
+  auto* header = head;
+  if (header == nullptr) {
+    return nullptr;
+  }
+  head = *reinterpret_cast<Header**>(header->begin());
+  --state_.numSizeClassBlocks();
+  state_.sizeClassBytes() -= header->size() + sizeof(Header);
+  ++state_.numSizeClassAllocs();
+  state_.cumulativeBytes() += header->size();
+  return header;
+}
+
+bool HashStringAllocator::freeToSizeClass(Header* header) {
+  const auto size = header->size();
+  if (!state_.sizeClasses() || size > kMaxSizeClassAlloc) {
+    return false;
+  }
+  // Bound the memory that is not coalesced to 1/8 of the arena.
+  const uint64_t maxBytes = std::max<int64_t>(
+      kMinSizeClassBytes, state_.pool().allocatedBytes() / 8);
+  if (state_.sizeClassBytes() + size + sizeof(Header) > maxBytes) {
+    return false;
+  }
+  auto& head = state_.sizeClassLists()[size / kSizeClassGranularity];
+  *reinterpret_cast<Header**>(header->begin()) = head;
+  head = header;
+  ++state_.numSizeClassBlocks();
+  state_.sizeClassBytes() += size + sizeof(Header);
+  state_.cumulativeBytes() -= size;
+  return true;
+}
+
 HashStringAllocator::Header* HashStringAllocator::allocate(
     int32_t size,
     bool exactSize) {
+  if (exactSize && state_.sizeClasses() && size <= kMaxSizeClassAlloc) {
+    // Sizes are rounded up so that a freed block is found by a request of its
+    // own size.
+    size = bits::roundUp(size, kSizeClassGranularity);
+    if (auto* header = allocateFromSizeClass(size)) {
+      return header;
+    }
+  }
   if (size > kMaxAlloc && exactSize) {
     VELOX_CHECK_LE(size, Header::kSizeMask);
     auto* header =
@@ -439,6 +505,10 @@ void HashStringAllocator::free(Header* header) {
       freeToPool(headerToFree, headerToFree->size() + sizeof(Header));
     } else {
       VELOX_CHECK(!headerToFree->isFree());
+      if (freeToSizeClass(headerToFree)) {
+        headerToFree = continued;
+        continue;
+      }
       state_.freeBytes() += headerToFree->size() + sizeof(Header);
       state_.cumulativeBytes() -= headerToFree->size();
       Header* next = headerToFree->next();
@@ -552,9 +622,18 @@ inline bool HashStringAllocator::storeStringFast(
     const char* bytes,
     int32_t numBytes,
     char* destination) {
-  const auto roundedBytes = std::max(numBytes, kMinAlloc);
+  auto roundedBytes = std::max(numBytes, kMinAlloc);
+  if (state_.sizeClasses() && roundedBytes <= kMaxSizeClassAlloc) {
+    roundedBytes = bits::roundUp(roundedBytes, kSizeClassGranularity);
+  }
 
-  Header* header = nullptr;
+  Header* header = allocateFromSizeClass(roundedBytes);
+  if (header != nullptr) {
+    simd::memcpy(header->begin(), bytes, numBytes);
+    *reinterpret_cast<StringView*>(destination) =
+        StringView(reinterpret_cast<char*>(header->begin()), numBytes);
+    return true;
+  }
   if (state_.freeLists()[kNumFreeLists - 1].empty()) {
     if (roundedBytes >= kMaxAlloc) {
       return false;
@@ -631,6 +710,11 @@ std::string HashStringAllocator::toString() const {
       << " blocks" << std::endl;
   out << "standalone allocations: " << state_.sizeFromPool() << " bytes in "
       << state_.allocationsFromPool().size() << " allocations" << std::endl;
+  if (state_.sizeClasses()) {
+    out << "size classes: " << state_.sizeClassBytes() << " bytes in "
+        << state_.numSizeClassBlocks() << " blocks, "
+        << state_.numSizeClassAllocs() << " allocations" << std::endl;
+  }
   out << "ranges: " << state_.pool().numRanges() << std::endl;
 
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
@@ -747,6 +831,23 @@ int64_t HashStringAllocator::checkConsistency() const {
 
   VELOX_CHECK_EQ(numInFreeList, state_.numFree());
   VELOX_CHECK_EQ(bytesInFreeList, state_.freeBytes());
+
+  // Blocks in size class lists are counted as allocated above.
+  uint64_t numInSizeClasses = 0;
+  uint64_t bytesInSizeClasses = 0;
+  for (auto i = 0; i < kNumSizeClasses; ++i) {
+    for (auto* header = state_.sizeClassLists()[i]; header != nullptr;
+         header = *reinterpret_cast<Header**>(header->begin())) {
+      VELOX_CHECK(!header->isFree());
+      VELOX_CHECK(!header->isContinued());
+      VELOX_CHECK_EQ(header->size() / kSizeClassGranularity, i);
+      ++numInSizeClasses;
+      bytesInSizeClasses += header->size() + sizeof(Header);
+      allocatedBytes -= header->size();
+    }
+  }
+  VELOX_CHECK_EQ(numInSizeClasses, state_.numSizeClassBlocks());
+  VELOX_CHECK_EQ(bytesInSizeClasses, state_.sizeClassBytes());
   return allocatedBytes;
 }
 
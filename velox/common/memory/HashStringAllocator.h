@@ -39,6 +39,15 @@ namespace facebook::velox {
 /// immediately below is free. In this case the uint32_t below the header has
 /// the size of the previous free block. The last word of a Allocation::PageRun
 /// backing a HashStringAllocator is set to kArenaEnd.
+///
+/// With size classes, a freed block of up to kMaxSizeClassAlloc bytes is not
+/// coalesced with its neighbors but pushed on a singly linked list of blocks of
+/// its size rounded down to kSizeClassGranularity. allocate() of a size that
+/// has a non-empty list pops its head. This makes the alloc/free churn of small
+/// accumulator state, e.g. of array_agg, set_agg and map_agg, O(1) and keeps
+/// the free lists short. A block in a size class list looks allocated to its
+/// neighbors. The bytes held in size class lists are bounded to a fraction of
+/// the arena, after which freed blocks are coalesced as usual.
 class HashStringAllocator : public StreamArena {
  public:
   /// The minimum allocation must have space after the header for the free list
@@ -50,6 +59,29 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kMaxAlloc =
       memory::AllocationTraits::kPageSize / 4 * 3;
 
+  /// Largest block size recycled through size class lists.
+  static constexpr int32_t kMaxSizeClassAlloc = 512;
+
+  /// Granularity of block sizes in size class lists.
+  static constexpr int32_t kSizeClassGranularity = 8;
+
+  /// Memory use and fragmentation of a HashStringAllocator. Byte counts of
+  /// blocks include their headers.
+  struct Stats {
+    /// Bytes of arenas, excluding standalone allocations from the pool.
+    int64_t arenaBytes{0};
+    /// Bytes of standalone allocations from the pool.
+    int64_t sizeFromPool{0};
+    /// Number and bytes of free blocks in the coalescing free lists.
+    uint64_t numFree{0};
+    uint64_t freeBytes{0};
+    /// Number and bytes of blocks held in size class lists.
+    uint64_t numSizeClassBlocks{0};
+    uint64_t sizeClassBytes{0};
+    /// Cumulative number of allocations served from size class lists.
+    uint64_t numSizeClassAllocs{0};
+  };
+
   class Header {
    public:
     static constexpr uint32_t kFree = 1U << 31;
@@ -174,8 +206,12 @@ class HashStringAllocator : public StreamArena {
     }
   };
 
-  explicit HashStringAllocator(memory::MemoryPool* pool)
-      : StreamArena(pool), state_(pool) {}
+  /// If 'sizeClasses' is true, small blocks are recycled through size class
+  /// lists. See the class comment.
+  explicit HashStringAllocator(
+      memory::MemoryPool* pool,
+      bool sizeClasses = false)
+      : StreamArena(pool), state_(pool, sizeClasses) {}
 
   ~HashStringAllocator();
 
@@ -304,10 +340,12 @@ class HashStringAllocator : public StreamArena {
   /// Returns a lower bound on bytes available without growing 'this'. This is
   /// the sum of free block sizes minus size of pointer for each. We subtract
   /// the pointer because in the worst case we would have one allocation that
-  /// chains many small free blocks together via kContinued.
+  /// chains many small free blocks together via kContinued. Blocks in size
+  /// class lists are counted as free.
   uint64_t freeSpace() const {
-    int64_t minFree = state_.freeBytes() -
-        state_.numFree() * (sizeof(Header) + sizeof(void*));
+    int64_t minFree = state_.freeBytes() + state_.sizeClassBytes() -
+        (state_.numFree() + state_.numSizeClassBlocks()) *
+            (sizeof(Header) + sizeof(void*));
     VELOX_CHECK_GE(minFree, 0, "Guaranteed free space cannot be negative");
     return minFree;
   }
@@ -323,6 +361,12 @@ class HashStringAllocator : public StreamArena {
     return state_.cumulativeBytes();
   }
 
+  bool sizeClasses() const {
+    return state_.sizeClasses();
+  }
+
+  Stats stats() const;
+
   /// Checks the free space accounting and consistency of Headers. Throws when
   /// detects corruption. Returns the number of allocated payload bytes,
   /// excluding headers, continue links and other overhead.
@@ -358,6 +402,11 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kUnitSize = 16 * memory::AllocationTraits::kPageSize;
   static constexpr int32_t kMinContiguous = 48;
   static constexpr int32_t kNumFreeLists = kMaxAlloc - kMinAlloc + 2;
+  static constexpr int32_t kNumSizeClasses =
+      kMaxSizeClassAlloc / kSizeClassGranularity + 1;
+  // Lower bound on the bytes that may be held in size class lists. Above this,
+  // the limit is a fraction of the arena.
+  static constexpr int64_t kMinSizeClassBytes = kUnitSize;
 
   void newRange(
       int32_t bytes,
@@ -372,6 +421,14 @@ class HashStringAllocator : public StreamArena {
 
   void removeFromFreeList(Header* header);
 
+  // Returns a block of at least 'size' bytes from the size class lists or
+  // nullptr if the list for 'size' is empty.
+  Header* allocateFromSizeClass(int32_t size);
+
+  // Adds 'header' to the size class lists. Returns false if 'header' is too
+  // large or the size class lists are full.
+  bool freeToSizeClass(Header* header);
+
   // Allocates a block of specified size. If exactSize is false, the block may
   // be smaller or larger. Checks free list before allocating new memory.
   Header* allocate(int32_t size, bool exactSize);
@@ -414,7 +471,8 @@ class HashStringAllocator : public StreamArena {
   /// HashStringAllocator is frozen will cause an exception to be thrown.
   class State {
    public:
-    explicit State(memory::MemoryPool* pool) : pool_(pool) {}
+    State(memory::MemoryPool* pool, bool sizeClasses)
+        : pool_(pool), sizeClasses_(sizeClasses) {}
 
     void freeze() {
       VELOX_CHECK(
@@ -462,6 +520,7 @@ class HashStringAllocator : public StreamArena {
     typedef CompactDoubleList FreeList[kNumFreeLists];
     typedef uint64_t FreeNonEmptyBitMap[bits::nwords(kNumFreeLists)];
     typedef folly::F14FastMap<void*, size_t> AllocationsFromPool;
+    typedef Header* SizeClassLists[kNumSizeClasses];
 
     // Circular list of free blocks.
     DECLARE_FIELD(FreeList, freeLists);
@@ -496,6 +555,22 @@ class HashStringAllocator : public StreamArena {
     // Sum of sizes in 'allocationsFromPool_'.
     DECLARE_FIELD_WITH_INIT_VALUE(int64_t, sizeFromPool, 0);
 
+    // True if small blocks are recycled through 'sizeClassLists_'.
+    DECLARE_FIELD_WITH_INIT_VALUE(bool, sizeClasses, false);
+
+    // Heads of singly linked lists of blocks by size divided by
+    // kSizeClassGranularity. The link is in the first word of the block.
+    DECLARE_FIELD_WITH_INIT_VALUE(SizeClassLists, sizeClassLists, {});
+
+    // Count of blocks in 'sizeClassLists_'.
+    DECLARE_FIELD_WITH_INIT_VALUE(uint64_t, numSizeClassBlocks, 0);
+
+    // Sum of the size of blocks in 'sizeClassLists_', including headers.
+    DECLARE_FIELD_WITH_INIT_VALUE(uint64_t, sizeClassBytes, 0);
+
+    // Cumulative count of allocations from 'sizeClassLists_'.
+    DECLARE_FIELD_WITH_INIT_VALUE(uint64_t, numSizeClassAllocs, 0);
+
 #undef DECLARE_FIELD_WITH_INIT_VALUE
 #undef DECLARE_FIELD
 #undef DECLARE_GETTERS
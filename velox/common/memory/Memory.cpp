@@ -52,6 +52,8 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.useHugePages = options.useHugePageSizeClasses;
+    mmapOptions.hugePagePrefaultExecutor = options.hugePagePrefaultExecutor;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -73,6 +75,8 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
        .memoryPoolTransferCapacity = options.memoryPoolTransferCapacity,
        .memoryReclaimWaitMs = options.memoryReclaimWaitMs,
        .globalArbitrationEnabled = options.globalArbitrationEnabled,
+       .globalArbitrationWaitMs = options.globalArbitrationWaitMs,
+       .proactiveReclaimWatermarkRatio = options.proactiveReclaimWatermarkRatio,
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
        .checkUsageLeak = options.checkUsageLeak});
 }
@@ -100,6 +104,7 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      poolReservationCacheBytes_(options.memoryPoolReservationCacheBytes),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -120,9 +125,12 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .trackUsage = options.trackDefaultUsage,
               .debugEnabled = options.debugEnabled,
               .coreOnAllocationFailureEnabled =
-                  options.coreOnAllocationFailureEnabled})},
+                  options.coreOnAllocationFailureEnabled,
+              .reservationCacheBytes =
+                  options.memoryPoolReservationCacheBytes})},
       spillPool_{addLeafPool("__sys_spilling__")},
-      sharedLeafPools_(createSharedLeafMemoryPools(*sysRoot_)) {
+      sharedLeafPools_(createSharedLeafMemoryPools(*sysRoot_)),
+      proactiveReclaimIntervalMs_(options.proactiveReclaimIntervalMs) {
   VELOX_CHECK_NOT_NULL(allocator_);
   VELOX_CHECK_NOT_NULL(arbitrator_);
   VELOX_USER_CHECK_GE(capacity(), 0);
@@ -137,9 +145,14 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
   VELOX_CHECK_EQ(
       sharedLeafPools_.size(),
       std::max(1, FLAGS_velox_memory_num_shared_leaf_pools));
+  if (options.proactiveReclaimWatermarkRatio > 0) {
+    VELOX_CHECK_GT(proactiveReclaimIntervalMs_, 0);
+    proactiveReclaimThread_ = std::thread([this]() { runProactiveReclaim(); });
+  }
 }
 
 MemoryManager::~MemoryManager() {
+  stopProactiveReclaim();
   if (pools_.size() != 0) {
     const auto errMsg = fmt::format(
         "pools_.size() != 0 ({} vs {}). There are unexpected alive memory "
@@ -227,6 +240,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.reservationCacheBytes = poolReservationCacheBytes_;
 
   std::unique_lock guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
@@ -275,6 +289,33 @@ uint64_t MemoryManager::shrinkPools(
       getAlivePools(), targetBytes, allowSpill, allowAbort);
 }
 
+void MemoryManager::runProactiveReclaim() {
+  std::unique_lock<std::mutex> l(proactiveReclaimMutex_);
+  while (!proactiveReclaimCv_.wait_for(
+      l, std::chrono::milliseconds(proactiveReclaimIntervalMs_), [&]() {
+        return proactiveReclaimStopped_;
+      })) {
+    l.unlock();
+    try {
+      arbitrator_->reclaimProactively(getAlivePools());
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to reclaim memory proactively: " << e.what();
+    }
+    l.lock();
+  }
+}
+
+void MemoryManager::stopProactiveReclaim() {
+  {
+    std::lock_guard<std::mutex> l(proactiveReclaimMutex_);
+    proactiveReclaimStopped_ = true;
+  }
+  proactiveReclaimCv_.notify_all();
+  if (proactiveReclaimThread_.joinable()) {
+    proactiveReclaimThread_.join();
+  }
+}
+
 void MemoryManager::dropPool(MemoryPool* pool) {
   VELOX_CHECK_NOT_NULL(pool);
   std::unique_lock guard{mutex_};
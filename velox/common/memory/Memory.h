@@ -18,10 +18,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <limits>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include <fmt/format.h>
 #include <folly/Synchronized.h>
@@ -34,6 +37,7 @@
 #include "folly/Likely.h"
 #include "folly/Random.h"
 #include "folly/SharedMutex.h"
+#include "folly/Executor.h"
 #include "velox/common/base/CheckedArithmetic.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/memory/Allocation.h"
@@ -81,6 +85,11 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// Unused reservation in bytes kept by each leaf memory pool on free to
+  /// serve later allocations without updating the ancestor pools. See
+  /// MemoryPool::Options::reservationCacheBytes. Zero disables the cache.
+  int64_t memoryPoolReservationCacheBytes{0};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -102,6 +111,19 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   bool useMmapArena{false};
 
+  /// If true, the MmapAllocator size classes of at least a huge page are
+  /// backed by transparent huge pages. Needs 'largestSizeClassPages' of at
+  /// least 512 to take effect.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool useHugePageSizeClasses{false};
+
+  /// If set, newly backed memory of huge page size classes is pre-faulted on
+  /// this executor. Must outlive the allocator.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  folly::Executor* hugePagePrefaultExecutor{nullptr};
+
   /// Used to determine MmapArena capacity. The ratio represents
   /// 'allocatorCapacity' to single MmapArena capacity ratio.
   ///
@@ -184,6 +206,22 @@ struct MemoryManagerOptions {
   /// memory pools.
   bool globalArbitrationEnabled{false};
 
+  /// Specifies the max time for a capacity growth request to wait for a global
+  /// arbitration run. The waiting requests are served in the order of their
+  /// priority classes. If it is zero, then there is no timeout.
+  uint64_t globalArbitrationWaitMs{0};
+
+  /// The soft watermark of the memory usage as a ratio of the arbitrator
+  /// capacity. If non-zero, a background thread of the memory manager checks
+  /// the memory usage every 'proactiveReclaimIntervalMs' and lets the
+  /// arbitrator spill from the running queries if the usage is forecast to
+  /// exceed the watermark, instead of waiting for a query to run out of
+  /// memory. If it is zero, then proactive reclaim is disabled.
+  double proactiveReclaimWatermarkRatio{0};
+
+  /// The interval of the proactive reclaim checks.
+  uint64_t proactiveReclaimIntervalMs{1'000};
+
   /// Provided by the query system to validate the state after a memory pool
   /// enters arbitration if not null. For instance, Prestissimo provides
   /// callback to check if a memory arbitration request is issued from a driver
@@ -308,6 +346,13 @@ class MemoryManager {
   //  Returns the shared references to all the alive memory pools in 'pools_'.
   std::vector<std::shared_ptr<MemoryPool>> getAlivePools() const;
 
+  // Runs on 'proactiveReclaimThread_' and lets 'arbitrator_' reclaim memory
+  // from the alive pools every 'proactiveReclaimIntervalMs_' until stopped.
+  void runProactiveReclaim();
+
+  // Stops and joins 'proactiveReclaimThread_' if running.
+  void stopProactiveReclaim();
+
   const std::shared_ptr<MemoryAllocator> allocator_;
   // Specifies the capacity to allocate from 'arbitrator_' for a newly created
   // root memory pool.
@@ -318,6 +363,7 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t poolReservationCacheBytes_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
@@ -332,6 +378,12 @@ class MemoryManager {
   mutable folly::SharedMutex mutex_;
   // All user root pools allocated from 'this'.
   std::unordered_map<std::string, std::weak_ptr<MemoryPool>> pools_;
+
+  const uint64_t proactiveReclaimIntervalMs_;
+  std::mutex proactiveReclaimMutex_;
+  std::condition_variable proactiveReclaimCv_;
+  bool proactiveReclaimStopped_{false};
+  std::thread proactiveReclaimThread_;
 };
 
 /// Initializes the process-wide memory manager based on the specified
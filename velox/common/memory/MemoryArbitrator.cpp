@@ -141,6 +141,32 @@ class NoopArbitrator : public MemoryArbitrator {
 thread_local MemoryArbitrationContext* arbitrationCtx{nullptr};
 } // namespace
 
+std::string arbitrationPriorityName(ArbitrationPriority priority) {
+  switch (priority) {
+    case ArbitrationPriority::kLow:
+      return "low";
+    case ArbitrationPriority::kNormal:
+      return "normal";
+    case ArbitrationPriority::kHigh:
+      return "high";
+    default:
+      return fmt::format("unknown({})", static_cast<int32_t>(priority));
+  }
+}
+
+ArbitrationPriority arbitrationPriorityFromName(const std::string& name) {
+  if (name == "low") {
+    return ArbitrationPriority::kLow;
+  }
+  if (name == "normal") {
+    return ArbitrationPriority::kNormal;
+  }
+  if (name == "high") {
+    return ArbitrationPriority::kHigh;
+  }
+  VELOX_USER_FAIL("Invalid memory arbitration priority: {}", name);
+}
+
 std::unique_ptr<MemoryArbitrator> MemoryArbitrator::create(
     const Config& config) {
   if (config.kind.empty()) {
@@ -337,7 +363,9 @@ MemoryArbitrator::Stats::Stats(
     uint64_t _reclaimTimeUs,
     uint64_t _numNonReclaimableAttempts,
     uint64_t _numReserves,
-    uint64_t _numReleases)
+    uint64_t _numReleases,
+    uint64_t _globalQueueTimeUs,
+    uint64_t _numGlobalQueueTimeouts)
     : numRequests(_numRequests),
       numSucceeded(_numSucceeded),
       numAborted(_numAborted),
@@ -352,14 +380,17 @@ MemoryArbitrator::Stats::Stats(
       reclaimTimeUs(_reclaimTimeUs),
       numNonReclaimableAttempts(_numNonReclaimableAttempts),
       numReserves(_numReserves),
-      numReleases(_numReleases) {}
+      numReleases(_numReleases),
+      globalQueueTimeUs(_globalQueueTimeUs),
+      numGlobalQueueTimeouts(_numGlobalQueueTimeouts) {}
 
 std::string MemoryArbitrator::Stats::toString() const {
   return fmt::format(
       "STATS[numRequests {} numAborted {} numFailures {} "
       "numNonReclaimableAttempts {} numReserves {} numReleases {} "
       "queueTime {} arbitrationTime {} reclaimTime {} shrunkMemory {} "
-      "reclaimedMemory {} maxCapacity {} freeCapacity {} freeReservedCapacity {}]",
+      "reclaimedMemory {} maxCapacity {} freeCapacity {} freeReservedCapacity {} "
+      "globalQueueTime {} numGlobalQueueTimeouts {}]",
       numRequests,
       numAborted,
       numFailures,
@@ -373,7 +404,9 @@ std::string MemoryArbitrator::Stats::toString() const {
       succinctBytes(numReclaimedBytes),
       succinctBytes(maxCapacityBytes),
       succinctBytes(freeCapacityBytes),
-      succinctBytes(freeReservedCapacityBytes));
+      succinctBytes(freeReservedCapacityBytes),
+      succinctMicros(globalQueueTimeUs),
+      numGlobalQueueTimeouts);
 }
 
 MemoryArbitrator::Stats MemoryArbitrator::Stats::operator-(
@@ -395,6 +428,9 @@ MemoryArbitrator::Stats MemoryArbitrator::Stats::operator-(
       numNonReclaimableAttempts - other.numNonReclaimableAttempts;
   result.numReserves = numReserves - other.numReserves;
   result.numReleases = numReleases - other.numReleases;
+  result.globalQueueTimeUs = globalQueueTimeUs - other.globalQueueTimeUs;
+  result.numGlobalQueueTimeouts =
+      numGlobalQueueTimeouts - other.numGlobalQueueTimeouts;
   return result;
 }
 
@@ -414,7 +450,9 @@ bool MemoryArbitrator::Stats::operator==(const Stats& other) const {
              reclaimTimeUs,
              numNonReclaimableAttempts,
              numReserves,
-             numReleases) ==
+             numReleases,
+             globalQueueTimeUs,
+             numGlobalQueueTimeouts) ==
       std::tie(
              other.numRequests,
              other.numSucceeded,
@@ -430,7 +468,9 @@ bool MemoryArbitrator::Stats::operator==(const Stats& other) const {
              other.reclaimTimeUs,
              other.numNonReclaimableAttempts,
              other.numReserves,
-             other.numReleases);
+             other.numReleases,
+             other.globalQueueTimeUs,
+             other.numGlobalQueueTimeouts);
 }
 
 bool MemoryArbitrator::Stats::operator!=(const Stats& other) const {
@@ -461,6 +501,8 @@ bool MemoryArbitrator::Stats::operator<(const Stats& other) const {
   UPDATE_COUNTER(numNonReclaimableAttempts);
   UPDATE_COUNTER(numReserves);
   UPDATE_COUNTER(numReleases);
+  UPDATE_COUNTER(globalQueueTimeUs);
+  UPDATE_COUNTER(numGlobalQueueTimeouts);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
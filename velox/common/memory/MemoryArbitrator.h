@@ -30,6 +30,23 @@ class MemoryPool;
 
 using MemoryArbitrationStateCheckCB = std::function<void(MemoryPool&)>;
 
+/// The priority class of a query memory pool in memory arbitration. The
+/// capacity growth requests from a higher priority class are served first if
+/// they wait for global arbitration, and the memory pools of a lower priority
+/// class are reclaimed or aborted first.
+enum class ArbitrationPriority : int32_t {
+  kLow = 0,
+  kNormal = 1,
+  kHigh = 2,
+};
+
+/// Returns the lower case name of 'priority', e.g. 'normal'.
+std::string arbitrationPriorityName(ArbitrationPriority priority);
+
+/// Returns the priority class with lower case 'name'. Throws if 'name' is not
+/// a valid priority class name.
+ArbitrationPriority arbitrationPriorityFromName(const std::string& name);
+
 /// The memory arbitrator interface. There is one memory arbitrator object per
 /// memory manager which is responsible for arbitrating memory usage among the
 /// query memory pools for query memory isolation. When a memory pool exceeds
@@ -79,6 +96,18 @@ class MemoryArbitrator {
     /// memory pools.
     bool globalArbitrationEnabled{false};
 
+    /// Specifies the max time for a capacity growth request to wait for a
+    /// global arbitration run. The waiting requests are served in the order of
+    /// their priority classes. The request fails if the wait times out. If it
+    /// is zero, then there is no timeout.
+    uint64_t globalArbitrationWaitMs{0};
+
+    /// The soft watermark of the memory usage as a ratio of 'capacity'. If the
+    /// memory usage is forecast to exceed the watermark, the arbitrator
+    /// reclaims memory from the running queries by spilling ahead of time in
+    /// reclaimProactively(). If it is zero, then proactive reclaim is disabled.
+    double proactiveReclaimWatermarkRatio{0};
+
     /// Provided by the query system to validate the state after a memory pool
     /// enters arbitration if not null. For instance, Prestissimo provides
     /// callback to check if a memory arbitration request is issued from a
@@ -174,6 +203,19 @@ class MemoryArbitrator {
       bool allowSpill = true,
       bool allowAbort = false) = 0;
 
+  /// Invoked periodically by the memory manager to reclaim used memory from
+  /// 'pools' by spilling before the memory runs out. The arbitrator forecasts
+  /// the memory usage from its growth since the last invocation, and reclaims
+  /// the usage forecast above the soft watermark. The function returns the
+  /// actual freed memory capacity in bytes.
+  ///
+  /// NOTE: the function is not thread safe and is expected to be called from a
+  /// single background thread.
+  virtual uint64_t reclaimProactively(
+      const std::vector<std::shared_ptr<MemoryPool>>& /*unused*/) {
+    return 0;
+  }
+
   /// The internal execution stats of the memory arbitrator.
   struct Stats {
     /// The number of arbitration requests.
@@ -209,6 +251,12 @@ class MemoryArbitrator {
     uint64_t numReserves{0};
     /// The total number of memory releases.
     uint64_t numReleases{0};
+    /// The sum of the times that capacity growth requests wait in the global
+    /// arbitration queue in microseconds. This is included in 'queueTimeUs'.
+    uint64_t globalQueueTimeUs{0};
+    /// The number of capacity growth requests that fail on global arbitration
+    /// queue wait timeout.
+    uint64_t numGlobalQueueTimeouts{0};
 
     Stats(
         uint64_t _numRequests,
@@ -225,7 +273,9 @@ class MemoryArbitrator {
         uint64_t _reclaimTimeUs,
         uint64_t _numNonReclaimableAttempts,
         uint64_t _numReserves,
-        uint64_t _numReleases);
+        uint64_t _numReleases,
+        uint64_t _globalQueueTimeUs,
+        uint64_t _numGlobalQueueTimeouts);
 
     Stats() = default;
 
@@ -258,9 +308,13 @@ class MemoryArbitrator {
         memoryPoolTransferCapacity_(config.memoryPoolTransferCapacity),
         memoryReclaimWaitMs_(config.memoryReclaimWaitMs),
         globalArbitrationEnabled_(config.globalArbitrationEnabled),
+        globalArbitrationWaitMs_(config.globalArbitrationWaitMs),
+        proactiveReclaimWatermarkRatio_(config.proactiveReclaimWatermarkRatio),
         arbitrationStateCheckCb_(config.arbitrationStateCheckCb),
         checkUsageLeak_(config.checkUsageLeak) {
     VELOX_CHECK_LE(reservedCapacity_, capacity_);
+    VELOX_CHECK_GE(proactiveReclaimWatermarkRatio_, 0);
+    VELOX_CHECK_LE(proactiveReclaimWatermarkRatio_, 1);
   }
 
   /// Helper utilities used by the memory arbitrator implementations to call
@@ -276,6 +330,8 @@ class MemoryArbitrator {
   const uint64_t memoryPoolTransferCapacity_;
   const uint64_t memoryReclaimWaitMs_;
   const bool globalArbitrationEnabled_;
+  const uint64_t globalArbitrationWaitMs_;
+  const double proactiveReclaimWatermarkRatio_;
   const MemoryArbitrationStateCheckCB arbitrationStateCheckCb_;
   const bool checkUsageLeak_;
 };
@@ -390,6 +446,12 @@ class MemoryReclaimer {
   /// error exposure.
   virtual void abort(MemoryPool* pool, const std::exception_ptr& error);
 
+  /// Returns the arbitration priority class of the query which owns the root
+  /// memory pool of this reclaimer. Only used for root memory pools.
+  virtual ArbitrationPriority priority() const {
+    return ArbitrationPriority::kNormal;
+  }
+
  protected:
   MemoryReclaimer() = default;
 };
@@ -222,8 +222,10 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      reservationCacheBytes_(options.reservationCacheBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
+  VELOX_CHECK_GE(reservationCacheBytes_, 0);
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
   MemoryAllocator::alignmentCheck(0, alignment_);
@@ -440,6 +442,12 @@ MemoryPoolImpl::~MemoryPoolImpl() {
   }
 
   if (isLeaf()) {
+    if (usedReservationBytes_ == 0 && minReservationBytes_ == 0 &&
+        reservationBytes_ > 0 && reservationCacheBytes_ > 0) {
+      // Returns the reservation kept by the reservation cache.
+      toImpl(parent_)->decrementReservation(reservationBytes_);
+      reservationBytes_ = 0;
+    }
     if (usedReservationBytes_ > 0) {
       VELOX_MEM_LOG(ERROR) << "Memory leak (Used memory): " << toString();
       RECORD_METRIC_VALUE(
@@ -739,7 +747,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .reservationCacheBytes = reservationCacheBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -915,7 +924,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationCacheBytes_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -924,7 +933,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = quantizedSize(newCap + reservationCacheBytes_);
     }
     freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
@@ -937,6 +946,34 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
   }
 }
 
+void MemoryPoolImpl::releaseReservationCache() {
+  if (reservationCacheBytes_ == 0 || !trackUsage_) {
+    return;
+  }
+  if (!isLeaf()) {
+    visitChildren([](MemoryPool* pool) {
+      toImpl(pool)->releaseReservationCache();
+      return true;
+    });
+    return;
+  }
+  if (!threadSafe_) {
+    return;
+  }
+  int64_t freeable = 0;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    freeable = reservationBytes_ -
+        quantizedSize(std::max(minReservationBytes_, usedReservationBytes_));
+    if (freeable <= 0) {
+      return;
+    }
+    reservationBytes_ -= freeable;
+    sanityCheckLocked();
+  }
+  toImpl(parent_)->decrementReservation(freeable);
+}
+
 void MemoryPoolImpl::decrementReservation(uint64_t size) noexcept {
   VELOX_CHECK_GT(size, 0);
 
@@ -1036,6 +1073,7 @@ uint64_t MemoryPoolImpl::reclaim(
     uint64_t targetBytes,
     uint64_t maxWaitMs,
     memory::MemoryReclaimer::Stats& stats) {
+  releaseReservationCache();
   if (reclaimer() == nullptr) {
     return 0;
   }
@@ -1058,6 +1096,7 @@ uint64_t MemoryPoolImpl::shrink(uint64_t targetBytes) {
   if (parent_ != nullptr) {
     return toImpl(parent_)->shrink(targetBytes);
   }
+  releaseReservationCache();
   std::lock_guard<std::mutex> l(mutex_);
   // We don't expect to shrink a memory pool without capacity limit.
   VELOX_CHECK_NE(capacity_, kMaxMemory);
@@ -157,6 +157,15 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// Unused reservation in bytes that a leaf memory pool keeps on a free
+    /// beyond its quantized usage, so that a driver allocating and freeing
+    /// around a quantum boundary is served from the leaf without updating
+    /// the ancestor pools each time. The kept reservation still counts in
+    /// reservedBytes() of the leaf and its ancestors, and is released by
+    /// release(), memory reclaim and shrink. Zero disables the cache. Child
+    /// pools inherit the setting of the root.
+    int64_t reservationCacheBytes{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -353,7 +362,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// If a minimum reservation has been set with maybeReserve(), resets the
   /// minimum reservation. If the current usage is below the minimum
   /// reservation, decreases reservation and usage down to the rounded actual
-  /// usage.
+  /// usage. Also releases the reservation cache of a leaf memory pool, see
+  /// Options::reservationCacheBytes.
   virtual void release() = 0;
 
   /// Memory arbitration related interfaces.
@@ -541,6 +551,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t reservationCacheBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -882,7 +893,7 @@ class MemoryPoolImpl : public MemoryPool {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationCacheBytes_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -891,7 +902,7 @@ class MemoryPoolImpl : public MemoryPool {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = quantizedSize(newCap + reservationCacheBytes_);
     }
 
     const int64_t freeable = reservationBytes_ - newQuantized;
@@ -905,6 +916,12 @@ class MemoryPoolImpl : public MemoryPool {
   // Decrements the reservation in 'this' and parents.
   void decrementReservation(uint64_t size) noexcept;
 
+  // Releases the unused reservation kept by the reservation cache of the
+  // thread-safe leaf pools in the subtree of 'this'. The non thread-safe leaf
+  // pools are skipped as they can be updated concurrently by their owner
+  // without lock, and release their cache on release().
+  void releaseReservationCache();
+
   FOLLY_ALWAYS_INLINE void sanityCheckLocked() const {
     if (FOLLY_UNLIKELY(
             (reservationBytes_ < usedReservationBytes_) ||
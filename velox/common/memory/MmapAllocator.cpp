@@ -18,12 +18,42 @@
 
 #include <sys/mman.h>
 
+#include <thread>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
+namespace {
+#ifdef __linux__
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+// Set once the kernel rejects MADV_POPULATE_WRITE, which needs Linux 5.14.
+std::atomic_bool populateUnsupported{false};
+#endif
+
+// Faults in the memory of [data, data + bytes) for writing without changing
+// its contents, so that it can run concurrently with the owner's writes.
+bool populate(void* data, uint64_t bytes) {
+#ifdef __linux__
+  if (populateUnsupported) {
+    return false;
+  }
+  if (::madvise(data, bytes, MADV_POPULATE_WRITE) == 0) {
+    return true;
+  }
+  if (errno == EINVAL) {
+    populateUnsupported = true;
+  }
+#endif
+  return false;
+}
+} // namespace
+
 MmapAllocator::MmapAllocator(const Options& options)
     : MemoryAllocator(options.largestSizeClass),
       kind_(MemoryAllocator::Kind::kMmap),
@@ -35,9 +65,15 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
+          64 * sizeClassSizes_.back())),
+      hugePagePrefaultExecutor_(
+          options.useHugePages ? options.hugePagePrefaultExecutor : nullptr) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size,
+        size,
+        options.useHugePages &&
+            size % AllocationTraits::numPagesInHugePage() == 0));
   }
 
   if (useMmapArena_) {
@@ -50,6 +86,9 @@ MmapAllocator::MmapAllocator(const Options& options)
 }
 
 MmapAllocator::~MmapAllocator() {
+  while (numPendingPrefaults_ > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+  }
   VELOX_CHECK(
       (numAllocated_ == 0) && (numExternalMapped_ == 0), "{}", toString());
 }
@@ -127,6 +166,7 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   }
   if (ensureEnoughMappedPages(newMapsNeeded)) {
     markAllMapped(out);
+    prefaultHugePages(out);
     return true;
   }
 
@@ -497,6 +537,32 @@ void MmapAllocator::markAllMapped(const Allocation& allocation) {
   }
 }
 
+void MmapAllocator::prefaultHugePages(const Allocation& allocation) {
+  if (hugePagePrefaultExecutor_ == nullptr) {
+    return;
+  }
+  std::vector<std::pair<SizeClass*, Allocation::PageRun>> runs;
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    const auto run = allocation.runAt(i);
+    for (auto& sizeClass : sizeClasses_) {
+      if (sizeClass->hugePages() && sizeClass->isInRange(run.data<uint8_t>())) {
+        runs.emplace_back(sizeClass.get(), run);
+        break;
+      }
+    }
+  }
+  if (runs.empty()) {
+    return;
+  }
+  ++numPendingPrefaults_;
+  hugePagePrefaultExecutor_->add([this, runs = std::move(runs)]() {
+    for (const auto& [sizeClass, run] : runs) {
+      numPrefaultedPages_ += sizeClass->prefault(run);
+    }
+    --numPendingPrefaults_;
+  });
+}
+
 MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   MachinePageCount numAway = 0;
   for (int32_t i = sizeClasses_.size() - 1; i >= 0; --i) {
@@ -509,7 +575,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool useHugePages)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -523,9 +592,13 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
       0,
       "Sizeclass {} must have a multiple of 64 capacity",
       unitSize_);
+  // Maps a huge page more than needed for huge pages so that the range can be
+  // aligned.
+  const auto mapBytes =
+      byteSize_ + (useHugePages ? AllocationTraits::kHugePageSize : 0);
   void* ptr = mmap(
       nullptr,
-      AllocationTraits::pageBytes(capacity_ * unitSize_),
+      mapBytes,
       PROT_READ | PROT_WRITE,
       MAP_PRIVATE | MAP_ANONYMOUS,
       -1,
@@ -538,6 +611,29 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (!useHugePages) {
+    return;
+  }
+  // Aligns the range so that every unit covers whole huge pages. Advising
+  // away a free unit then releases whole huge pages.
+  auto* aligned = reinterpret_cast<uint8_t*>(bits::roundUp(
+      reinterpret_cast<uint64_t>(address_), AllocationTraits::kHugePageSize));
+  if (aligned > address_) {
+    munmap(address_, aligned - address_);
+  }
+  auto* end = address_ + mapBytes;
+  if (end > aligned + byteSize_) {
+    munmap(aligned + byteSize_, end - (aligned + byteSize_));
+  }
+  address_ = aligned;
+#ifdef MADV_HUGEPAGE
+  if (::madvise(address_, byteSize_, MADV_HUGEPAGE) == 0) {
+    hugePages_ = true;
+  } else {
+    VELOX_MEM_LOG(WARNING) << "madvise hugepage for sizeClass " << unitSize_
+                           << " got errno " << folly::errnoStr(errno);
+  }
+#endif
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -605,6 +701,9 @@ std::string MmapAllocator::SizeClass::toString() const {
     auto mb = (AllocationTraits::pageBytes(count * unitSize_)) >> 20;
     out << "[size " << unitSize_ << ": " << count << "(" << mb
         << "MB) allocated " << mappedCount << " mapped";
+    if (hugePages_) {
+      out << " huge pages";
+    }
     if (mappedFreeCount != numMappedFreePages_) {
       out << "Mismatched count of mapped free pages "
           << ". Actual= " << mappedFreeCount
@@ -616,6 +715,35 @@ std::string MmapAllocator::SizeClass::toString() const {
   return out.str();
 }
 
+MachinePageCount MmapAllocator::SizeClass::numMappedPages() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  MachinePageCount count = 0;
+  for (int i = 0; i < pageBitmapSize_; ++i) {
+    count += __builtin_popcountll(pageMapped_[i]);
+  }
+  return count * unitSize_;
+}
+
+MachinePageCount MmapAllocator::SizeClass::prefault(Allocation::PageRun run) {
+  auto* data = run.data<uint8_t>();
+  VELOX_CHECK(isInRange(data));
+  const auto firstPage =
+      (data - address_) / AllocationTraits::pageBytes(unitSize_);
+  const auto numClassPages = run.numPages() / unitSize_;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto page = firstPage; page < firstPage + numClassPages; ++page) {
+      if (!bits::isBitSet(pageAllocated_.data(), page) ||
+          !bits::isBitSet(pageMapped_.data(), page)) {
+        return 0;
+      }
+    }
+  }
+  // The run may be freed and advised away from here on. Populating it then
+  // backs a free unit until it is advised away again.
+  return populate(data, run.numBytes()) ? run.numPages() : 0;
+}
+
 bool MmapAllocator::SizeClass::allocate(
     ClassPageCount numPages,
     MachinePageCount& numUnmapped,
@@ -966,6 +1094,19 @@ std::string MmapAllocator::toString() const {
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
       << " external mapped pages " << numExternalMapped_ << std::endl;
+  MachinePageCount numHugePageMapped = 0;
+  for (auto& sizeClass : sizeClasses_) {
+    if (sizeClass->hugePages()) {
+      numHugePageMapped += sizeClass->numMappedPages();
+    }
+  }
+  if (numHugePageMapped > 0 || numPrefaultedPages_ > 0) {
+    const auto numMapped = numMapped_.load();
+    out << "huge page mapped pages " << numHugePageMapped << " ("
+        << (numMapped == 0 ? 0 : 100 * numHugePageMapped / numMapped)
+        << "% of mapped) prefaulted pages " << numPrefaultedPages_
+        << std::endl;
+  }
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
@@ -24,6 +24,7 @@
 #include <mutex>
 #include <unordered_set>
 
+#include <folly/Executor.h>
 #include <folly/ThreadCachedInt.h>
 
 #include "velox/common/base/SimdUtil.h"
@@ -80,6 +81,19 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If true, the size classes whose unit is a multiple of the huge page
+    /// size are mapped aligned to huge pages and advised with MADV_HUGEPAGE,
+    /// so that the hash tables and row containers allocated from them are
+    /// backed by transparent huge pages. Only applies if 'largestSizeClass'
+    /// is at least AllocationTraits::numPagesInHugePage().
+    bool useHugePages = false;
+
+    /// If set and 'useHugePages' is true, the newly backed units of huge page
+    /// size classes are populated on this executor after the allocation, so
+    /// that the huge pages are faulted in ahead of the first access instead
+    /// of 4KB at a time or later by khugepaged. Must outlive the allocator.
+    folly::Executor* hugePagePrefaultExecutor = nullptr;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -168,7 +182,7 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(size_t capacity, MachinePageCount unitSize, bool useHugePages);
 
     ~SizeClass();
 
@@ -176,6 +190,19 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    // True if the address range is aligned to and advised for huge pages.
+    bool hugePages() const {
+      return hugePages_;
+    }
+
+    // Returns the number of machine pages backed by memory.
+    MachinePageCount numMappedPages() const;
+
+    // Populates the memory of 'run' if its pages are still allocated and
+    // backed. Called off the allocating thread after the allocation. Returns
+    // the number of machine pages populated.
+    MachinePageCount prefault(Allocation::PageRun run);
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -276,6 +303,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size in bytes of the address range.
     const size_t byteSize_;
 
+    // See hugePages().
+    bool hugePages_{false};
+
     // Number of meaningful words in 'pageAllocated_'/'pageMapped'. The arrays
     // themselves are padded with extra zeros for SIMD access.
     const int32_t pageBitmapSize_;
@@ -372,6 +402,10 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Populates the runs of 'allocation' from huge page size classes on
+  // 'hugePagePrefaultExecutor_'. Called after 'allocation' got new backing.
+  void prefaultHugePages(const Allocation& allocation);
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -410,10 +444,17 @@ class MmapAllocator : public MemoryAllocator {
 
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
+  folly::Executor* const hugePagePrefaultExecutor_;
+
+  // Number of prefaults scheduled and not finished. The destructor waits for
+  // them since they access the size classes.
+  std::atomic<int32_t> numPendingPrefaults_{0};
+
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
+  std::atomic<uint64_t> numPrefaultedPages_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
@@ -78,6 +78,8 @@ void sortCandidatesByReclaimableFreeCapacity(
       &candidates);
 }
 
+// Sorts the candidates of lower priority classes first, and then by their
+// reclaimable used capacity.
 void sortCandidatesByReclaimableUsedCapacity(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -85,6 +87,9 @@ void sortCandidatesByReclaimableUsedCapacity(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -93,6 +98,8 @@ void sortCandidatesByReclaimableUsedCapacity(
       &candidates);
 }
 
+// Sorts the candidates of lower priority classes first, and then by their
+// memory usage.
 void sortCandidatesByUsage(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -100,31 +107,52 @@ void sortCandidatesByUsage(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reservedBytes > rhs.reservedBytes;
       });
 }
 
-// Finds the candidate with the largest capacity. For 'requestor', the
-// capacity for comparison including its current capacity and the capacity to
-// grow.
+// Finds the candidate with the largest capacity among the candidates of the
+// lowest priority class. For 'requestor', the capacity for comparison
+// including its current capacity and the capacity to grow. Aborted pools and
+// pools of a higher priority class than 'requestor' are skipped so that the
+// requestor itself is selected if there is no other candidate left.
 const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
     MemoryPool* requestor,
     uint64_t targetBytes,
     const std::vector<SharedArbitrator::Candidate>& candidates) {
   VELOX_CHECK(!candidates.empty());
+  auto requestorPriority = ArbitrationPriority::kHigh;
+  for (const auto& candidate : candidates) {
+    if (candidate.pool == requestor) {
+      requestorPriority = candidate.priority;
+      break;
+    }
+  }
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
   for (int32_t i = 0; i < candidates.size(); ++i) {
     const bool isCandidate = candidates[i].pool == requestor;
+    if (!isCandidate &&
+        (candidates[i].pool->aborted() ||
+         candidates[i].priority > requestorPriority)) {
+      continue;
+    }
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (candidateIdx == -1 ||
+        candidates[i].priority < candidates[candidateIdx].priority) {
+      candidateIdx = i;
       maxCapacity = capacity;
       continue;
     }
+    if (candidates[i].priority > candidates[candidateIdx].priority) {
+      continue;
+    }
     if (capacity < maxCapacity) {
       continue;
     }
@@ -153,8 +181,9 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{}] PRIORITY[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
       pool->root()->name(),
+      arbitrationPriorityName(priority),
       succinctBytes(reclaimableBytes),
       succinctBytes(freeBytes));
 }
@@ -186,10 +215,21 @@ void SharedArbitrator::getCandidateStats(
         {freeCapacityOnly ? 0 : reclaimableUsedCapacity(*pool, selfCandidate),
          reclaimableFreeCapacity(*pool, selfCandidate),
          pool->reservedBytes(),
-         pool.get()});
+         pool.get(),
+         priority(*pool)});
   }
 }
 
+// static
+ArbitrationPriority SharedArbitrator::priority(const MemoryPool& pool) {
+  VELOX_DCHECK(pool.isRoot());
+  auto* reclaimer = pool.reclaimer();
+  if (reclaimer == nullptr) {
+    return ArbitrationPriority::kNormal;
+  }
+  return reclaimer->priority();
+}
+
 void SharedArbitrator::updateArbitrationRequestStats() {
   RECORD_METRIC_VALUE(kMetricArbitratorRequestsCount);
   ++numRequests_;
@@ -336,6 +376,65 @@ uint64_t SharedArbitrator::shrinkCapacity(
   return freedBytes;
 }
 
+uint64_t SharedArbitrator::reclaimProactively(
+    const std::vector<std::shared_ptr<MemoryPool>>& pools) {
+  if (proactiveReclaimWatermarkRatio_ == 0) {
+    return 0;
+  }
+  const uint64_t targetBytes = proactiveReclaimTarget(pools);
+  if (targetBytes == 0) {
+    return 0;
+  }
+  RECORD_METRIC_VALUE(kMetricArbitratorProactiveReclaimCount);
+  ArbitrationOperation op(targetBytes, pools);
+  ScopedArbitration scopedArbitration(this, &op);
+  std::lock_guard<std::shared_mutex> exclusiveLock(arbitrationLock_);
+  getCandidateStats(&op);
+  uint64_t freedBytes =
+      reclaimFreeMemoryFromCandidates(&op, targetBytes, false);
+  if (freedBytes < targetBytes) {
+    // Spills from the candidates with the most reclaimable memory while the
+    // free capacity is still there for the other queries to run.
+    freedBytes +=
+        reclaimUsedMemoryFromCandidatesBySpill(&op, targetBytes - freedBytes);
+  }
+  if (freedBytes > 0) {
+    incrementFreeCapacity(freedBytes);
+  }
+  VELOX_MEM_LOG(INFO) << "Proactively reclaimed " << succinctBytes(freedBytes)
+                      << " with target " << succinctBytes(targetBytes)
+                      << ", Arbitrator state: " << toString();
+  return freedBytes;
+}
+
+uint64_t SharedArbitrator::proactiveReclaimTarget(
+    const std::vector<std::shared_ptr<MemoryPool>>& pools) {
+  uint64_t growthBytes{0};
+  std::unordered_map<std::string, uint64_t> poolCapacities;
+  poolCapacities.reserve(pools.size());
+  for (const auto& pool : pools) {
+    const uint64_t capacity = pool->capacity();
+    poolCapacities.emplace(pool->name(), capacity);
+    auto it = lastPoolCapacities_.find(pool->name());
+    if (it != lastPoolCapacities_.end() && capacity > it->second) {
+      growthBytes += capacity - it->second;
+    }
+  }
+  lastPoolCapacities_ = std::move(poolCapacities);
+
+  uint64_t usedBytes;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    usedBytes = capacity_ - freeNonReservedCapacity_ - freeReservedCapacity_;
+  }
+  const uint64_t forecastBytes = usedBytes + growthBytes;
+  const uint64_t watermarkBytes = capacity_ * proactiveReclaimWatermarkRatio_;
+  if (forecastBytes <= watermarkBytes) {
+    return 0;
+  }
+  return forecastBytes - watermarkBytes;
+}
+
 void SharedArbitrator::testingFreeCapacity(uint64_t capacity) {
   std::lock_guard<std::mutex> l(mutex_);
   incrementFreeCapacityLocked(capacity);
@@ -450,6 +549,19 @@ bool SharedArbitrator::runLocalArbitration(
 }
 
 bool SharedArbitrator::runGlobalArbitration(ArbitrationOperation* op) {
+  if (!startGlobalArbitration(op)) {
+    ++numGlobalQueueTimeouts_;
+    updateArbitrationFailureStats();
+    VELOX_MEM_LOG(ERROR) << "Memory pool " << op->requestRoot->name()
+                         << " timed out after waiting "
+                         << succinctMicros(op->globalArbitrationQueueTimeUs)
+                         << " for global arbitration to grow "
+                         << succinctBytes(op->targetBytes);
+    return false;
+  }
+  const auto finishGuard =
+      folly::makeGuard([&]() { finishGlobalArbitration(); });
+
   incrementGlobalArbitrationCount();
   const std::chrono::steady_clock::time_point globalArbitrationStartTime =
       std::chrono::steady_clock::now();
@@ -488,6 +600,76 @@ bool SharedArbitrator::runGlobalArbitration(ArbitrationOperation* op) {
   return false;
 }
 
+bool SharedArbitrator::startGlobalArbitration(ArbitrationOperation* op) {
+  ContinueFuture waitFuture{ContinueFuture::makeEmpty()};
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!globalArbitrationRunning_) {
+      globalArbitrationRunning_ = true;
+      return true;
+    }
+    globalArbitrationWaiters_.push_back(
+        {op,
+         priority(*op->requestRoot),
+         nextGlobalArbitrationSequence_++,
+         ContinuePromise(fmt::format(
+             "Wait for global arbitration {}", op->requestRoot->name()))});
+    waitFuture = globalArbitrationWaiters_.back().promise.getSemiFuture();
+  }
+
+  TestValue::adjust(
+      "facebook::velox::memory::SharedArbitrator::startGlobalArbitration",
+      this);
+
+  {
+    MicrosecondTimer timer(&op->globalArbitrationQueueTimeUs);
+    if (globalArbitrationWaitMs_ == 0) {
+      waitFuture.wait();
+    } else {
+      waitFuture.wait(std::chrono::milliseconds(globalArbitrationWaitMs_));
+    }
+  }
+  if (waitFuture.isReady()) {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = std::find_if(
+      globalArbitrationWaiters_.begin(),
+      globalArbitrationWaiters_.end(),
+      [&](const auto& waiter) { return waiter.op == op; });
+  if (it == globalArbitrationWaiters_.end()) {
+    // The turn has been handed over to 'op' after the wait timed out.
+    return true;
+  }
+  globalArbitrationWaiters_.erase(it);
+  return false;
+}
+
+void SharedArbitrator::finishGlobalArbitration() {
+  ContinuePromise resumePromise{ContinuePromise::makeEmpty()};
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(globalArbitrationRunning_);
+    if (globalArbitrationWaiters_.empty()) {
+      globalArbitrationRunning_ = false;
+      return;
+    }
+    auto next = std::min_element(
+        globalArbitrationWaiters_.begin(),
+        globalArbitrationWaiters_.end(),
+        [](const auto& lhs, const auto& rhs) {
+          if (lhs.priority != rhs.priority) {
+            return lhs.priority > rhs.priority;
+          }
+          return lhs.sequence < rhs.sequence;
+        });
+    resumePromise = std::move(next->promise);
+    globalArbitrationWaiters_.erase(next);
+  }
+  resumePromise.setValue();
+}
+
 void SharedArbitrator::getGrowTargets(
     ArbitrationOperation* op,
     uint64_t& maxGrowTarget,
@@ -842,6 +1024,8 @@ MemoryArbitrator::Stats SharedArbitrator::statsLocked() const {
   stats.numNonReclaimableAttempts = numNonReclaimableAttempts_;
   stats.numReserves = numReserves_;
   stats.numReleases = numReleases_;
+  stats.globalQueueTimeUs = globalQueueTimeUs_;
+  stats.numGlobalQueueTimeouts = numGlobalQueueTimeouts_;
   return stats;
 }
 
@@ -911,6 +1095,15 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
             operation_->globalArbitrationLockWaitTimeUs * 1'000,
             RuntimeCounter::Unit::kNanos));
   }
+  if (operation_->globalArbitrationQueueTimeUs != 0) {
+    addThreadLocalRuntimeStat(
+        kGlobalArbitrationQueueWallNanos,
+        RuntimeCounter(
+            operation_->globalArbitrationQueueTimeUs * 1'000,
+            RuntimeCounter::Unit::kNanos));
+    arbitrator_->globalQueueTimeUs_ +=
+        operation_->globalArbitrationQueueTimeUs;
+  }
   arbitrator_->arbitrationTimeUs_ += arbitrationTimeUs;
 
   const uint64_t waitTimeUs = operation_->waitTimeUs();
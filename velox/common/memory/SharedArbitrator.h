@@ -58,6 +58,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       bool allowSpill = true,
       bool force = false) override final;
 
+  uint64_t reclaimProactively(
+      const std::vector<std::shared_ptr<MemoryPool>>& pools) final;
+
   Stats stats() const final;
 
   std::string kind() const override;
@@ -70,6 +73,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     int64_t freeBytes{0};
     int64_t reservedBytes{0};
     MemoryPool* pool;
+    ArbitrationPriority priority{ArbitrationPriority::kNormal};
 
     std::string toString() const;
   };
@@ -93,6 +97,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       "localArbitrationLockWaitWallNanos"};
   static inline const std::string kGlobalArbitrationLockWaitWallNanos{
       "globalArbitrationLockWaitWallNanos"};
+  static inline const std::string kGlobalArbitrationQueueWallNanos{
+      "globalArbitrationQueueWallNanos"};
 
  private:
   // The kind string of shared arbitrator.
@@ -119,6 +125,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     // The time that waits to acquire the global arbitration lock.
     uint64_t globalArbitrationLockWaitTimeUs{0};
 
+    // The time that waits in the global arbitration queue.
+    uint64_t globalArbitrationQueueTimeUs{0};
+
     ArbitrationOperation(
         uint64_t targetBytes,
         const std::vector<std::shared_ptr<MemoryPool>>& candidatePools)
@@ -136,7 +145,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
     uint64_t waitTimeUs() const {
       return localArbitrationQueueTimeUs + localArbitrationLockWaitTimeUs +
-          globalArbitrationLockWaitTimeUs;
+          globalArbitrationLockWaitTimeUs + globalArbitrationQueueTimeUs;
     }
 
     void enterArbitration();
@@ -173,6 +182,15 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     }
   };
 
+  // A capacity growth request waiting in the global arbitration queue.
+  struct GlobalArbitrationWaiter {
+    ArbitrationOperation* op;
+    ArbitrationPriority priority;
+    // Orders the waiters with the same priority by arrival.
+    uint64_t sequence;
+    ContinuePromise promise;
+  };
+
   // Invoked to check if the memory growth will exceed the memory pool's max
   // capacity limit or the arbitrator's node capacity limit.
   bool checkCapacityGrowth(ArbitrationOperation* op) const;
@@ -219,6 +237,15 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // on success, false on failure.
   bool runGlobalArbitration(ArbitrationOperation* op);
 
+  // Invoked to wait for the turn of 'op' to run global arbitration. The
+  // waiting requests are served by priority class and then by arrival. The
+  // function returns false if the wait exceeds 'globalArbitrationWaitMs_'.
+  bool startGlobalArbitration(ArbitrationOperation* op);
+
+  // Invoked after a global arbitration run to hand over to the waiting request
+  // with the highest priority class if any.
+  void finishGlobalArbitration();
+
   // Gets the mim/max memory capacity growth targets for 'op'.
   void getGrowTargets(
       ArbitrationOperation* op,
@@ -256,6 +283,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       ArbitrationOperation* op,
       uint64_t reclaimTargetBytes);
 
+  // Returns the arbitration priority class of root memory 'pool'.
+  static ArbitrationPriority priority(const MemoryPool& pool);
+
   // Checks if request pool has been aborted or not.
   void checkIfAborted(ArbitrationOperation* op);
 
@@ -317,6 +347,13 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   Stats statsLocked() const;
 
+  // Returns the capacity to reclaim for the memory usage forecast of the next
+  // proactive reclaim check to stay under the soft watermark. The forecast
+  // adds the capacity growth of each pool in 'pools' since the last check to
+  // the current used capacity. Updates 'lastPoolCapacities_'.
+  uint64_t proactiveReclaimTarget(
+      const std::vector<std::shared_ptr<MemoryPool>>& pools);
+
   // Returns the max reclaimable capacity from 'pool' which includes both used
   // and free capacities. If 'isSelfReclaim' true, we reclaim memory from the
   // request pool itself so that we can bypass the reserved free capacity
@@ -359,6 +396,15 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   std::unordered_map<MemoryPool*, std::unique_ptr<ArbitrationQueue>>
       arbitrationQueues_;
 
+  // True if a capacity growth request is running or about to run global
+  // arbitration. Protected by 'mutex_'.
+  bool globalArbitrationRunning_{false};
+
+  // The capacity growth requests waiting for global arbitration. Protected by
+  // 'mutex_'.
+  std::vector<GlobalArbitrationWaiter> globalArbitrationWaiters_;
+  uint64_t nextGlobalArbitrationSequence_{0};
+
   // R/W lock used to control local and global arbitration runs. A local
   // arbitration run needs to hold a shared lock while the latter needs to hold
   // an exclusive lock. Hence, multiple local arbitration runs from different
@@ -378,5 +424,11 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   tsan_atomic<uint64_t> numNonReclaimableAttempts_{0};
   tsan_atomic<uint64_t> numReserves_{0};
   tsan_atomic<uint64_t> numReleases_{0};
+  std::atomic_uint64_t globalQueueTimeUs_{0};
+  std::atomic_uint64_t numGlobalQueueTimeouts_{0};
+
+  // The capacity of each query memory pool at the last proactive reclaim
+  // check. Only accessed by reclaimProactively().
+  std::unordered_map<std::string, uint64_t> lastPoolCapacities_;
 };
 } // namespace facebook::velox::memory
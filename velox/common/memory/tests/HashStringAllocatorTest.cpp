@@ -678,6 +678,76 @@ TEST_F(HashStringAllocatorTest, clear) {
   EXPECT_EQ(allocator_->retainedSize(), 0);
 }
 
+TEST_F(HashStringAllocatorTest, sizeClasses) {
+  allocator_ = std::make_unique<HashStringAllocator>(pool_.get(), true);
+  ASSERT_TRUE(allocator_->sizeClasses());
+
+  // A freed small block is not coalesced and is reused for its size.
+  auto* first = allocate(100);
+  auto* second = allocate(100);
+  allocator_->free(first);
+  ASSERT_FALSE(first->isFree());
+  ASSERT_FALSE(second->isPreviousFree());
+  ASSERT_EQ(1, allocator_->stats().numSizeClassBlocks);
+  ASSERT_EQ(first, allocate(100));
+  ASSERT_EQ(1, allocator_->stats().numSizeClassAllocs);
+
+  // Strings of the size of a freed block reuse it.
+  allocator_->free(first);
+  std::string str(100, 'x');
+  StringView view(str);
+  allocator_->copyMultipart(view, reinterpret_cast<char*>(&view), 0);
+  ASSERT_EQ(first, HSA::headerOf(view.data()));
+  ASSERT_EQ(str, view.str());
+  allocator_->free(first);
+  allocator_->free(second);
+  EXPECT_TRUE(allocator_->isEmpty());
+
+  // The size class lists are bounded.
+  std::vector<HSA::Header*> headers;
+  for (auto i = 0; i < 10'000; ++i) {
+    headers.push_back(allocate(16 + (i % 64) * 8));
+  }
+  for (auto* header : headers) {
+    allocator_->free(header);
+  }
+  auto stats = allocator_->stats();
+  ASSERT_GT(stats.numSizeClassBlocks, 0);
+  ASSERT_GT(stats.numFree, 0);
+  ASSERT_LE(
+      stats.sizeClassBytes, std::max<int64_t>(64 << 10, stats.arenaBytes / 8));
+  EXPECT_TRUE(allocator_->isEmpty());
+
+  // Mixed sizes and multipart writes stay consistent.
+  std::vector<Multipart> data(100);
+  std::vector<HSA::Header*> blocks(data.size(), nullptr);
+  for (auto count = 0; count < 10; ++count) {
+    for (auto i = 0; i < data.size(); ++i) {
+      if (data[i].start.isSet()) {
+        checkAndFree(data[i]);
+      }
+      if (blocks[i] != nullptr) {
+        allocator_->free(blocks[i]);
+        blocks[i] = nullptr;
+      }
+      if (i % 7 == count % 7) {
+        continue;
+      }
+      data[i].reference = randomString(i % 3 == 0 ? 0 : 1 + rand32() % 400);
+      ByteOutputStream stream(allocator_.get());
+      data[i].start = allocator_->newWrite(stream);
+      stream.appendStringView(data[i].reference);
+      allocator_->finishWrite(stream, 0);
+      blocks[i] = allocate(1 + rand32() % HSA::kMaxSizeClassAlloc);
+    }
+    allocator_->checkConsistency();
+  }
+  ASSERT_GT(allocator_->stats().numSizeClassAllocs, 2);
+  allocator_->clear();
+  ASSERT_EQ(0, allocator_->stats().numSizeClassBlocks);
+  ASSERT_EQ(0, allocator_->stats().sizeClassBytes);
+}
+
 TEST_F(HashStringAllocatorTest, freezeAndExecute) {
   std::string str = "abc";
   StringView view(str.data(), str.size());
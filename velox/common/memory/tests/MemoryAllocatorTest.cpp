@@ -24,6 +24,7 @@
 
 #include <fmt/format.h>
 #include <folly/Random.h>
+#include <folly/executors/ManualExecutor.h>
 #include <folly/Range.h>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
@@ -1989,4 +1990,46 @@ TEST_F(MmapConfigTest, sizeClasses) {
   }
 }
 
+TEST_F(MmapConfigTest, hugePageSizeClasses) {
+  folly::ManualExecutor executor;
+  MmapAllocator::Options options;
+  options.capacity = 256 << 20;
+  options.largestSizeClass = AllocationTraits::numPagesInHugePage();
+  options.useHugePages = true;
+  options.hugePagePrefaultExecutor = &executor;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+
+  const MachinePageCount kNumPages =
+      2 * AllocationTraits::numPagesInHugePage() + 1;
+  Allocation allocation;
+  ASSERT_TRUE(allocator->allocateNonContiguous(kNumPages, allocation));
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    auto run = allocation.runAt(i);
+    std::fill_n(run.data<uint8_t>(), run.numBytes(), i + 1);
+  }
+  executor.drain();
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    auto run = allocation.runAt(i);
+    for (auto j = 0; j < run.numBytes(); j += AllocationTraits::kPageSize) {
+      ASSERT_EQ(run.data<uint8_t>()[j], i + 1);
+    }
+  }
+  const auto description = allocator->toString();
+  if (description.find(" huge pages") != std::string::npos) {
+    // The kernel supports transparent huge pages.
+    EXPECT_NE(
+        description.find(fmt::format(
+            "huge page mapped pages {}",
+            2 * AllocationTraits::numPagesInHugePage())),
+        std::string::npos)
+        << description;
+  }
+  // A prefault that runs after the free finds the pages not allocated.
+  Allocation other;
+  ASSERT_TRUE(allocator->allocateNonContiguous(kNumPages, other));
+  allocator->freeNonContiguous(other);
+  executor.drain();
+  allocator->freeNonContiguous(allocation);
+}
+
 } // namespace facebook::velox::memory
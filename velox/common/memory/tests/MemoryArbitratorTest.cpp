@@ -66,14 +66,16 @@ TEST_F(MemoryArbitrationTest, stats) {
       "numNonReclaimableAttempts 5 numReserves 0 numReleases 0 "
       "queueTime 230.00ms arbitrationTime 1.02ms reclaimTime 1.00ms "
       "shrunkMemory 95.37MB reclaimedMemory 9.77KB "
-      "maxCapacity 0B freeCapacity 1.95KB freeReservedCapacity 1000B]");
+      "maxCapacity 0B freeCapacity 1.95KB freeReservedCapacity 1000B "
+      "globalQueueTime 0us numGlobalQueueTimeouts 0]");
   ASSERT_EQ(
       fmt::format("{}", stats),
       "STATS[numRequests 2 numAborted 3 numFailures 100 "
       "numNonReclaimableAttempts 5 numReserves 0 numReleases 0 "
       "queueTime 230.00ms arbitrationTime 1.02ms reclaimTime 1.00ms "
       "shrunkMemory 95.37MB reclaimedMemory 9.77KB "
-      "maxCapacity 0B freeCapacity 1.95KB freeReservedCapacity 1000B]");
+      "maxCapacity 0B freeCapacity 1.95KB freeReservedCapacity 1000B "
+      "globalQueueTime 0us numGlobalQueueTimeouts 0]");
 }
 
 TEST_F(MemoryArbitrationTest, create) {
@@ -314,10 +316,10 @@ TEST_F(MemoryArbitrationTest, arbitratorStats) {
   const MemoryArbitrator::Stats emptyStats;
   ASSERT_TRUE(emptyStats.empty());
   const MemoryArbitrator::Stats anchorStats(
-      5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5);
+      5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5);
   ASSERT_FALSE(anchorStats.empty());
   const MemoryArbitrator::Stats largeStats(
-      8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8);
+      8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8);
   ASSERT_FALSE(largeStats.empty());
   ASSERT_TRUE(!(anchorStats == largeStats));
   ASSERT_TRUE(anchorStats != largeStats);
@@ -328,10 +330,11 @@ TEST_F(MemoryArbitrationTest, arbitratorStats) {
   const auto delta = largeStats - anchorStats;
   ASSERT_EQ(
       delta,
-      MemoryArbitrator::Stats(3, 3, 3, 3, 3, 3, 3, 3, 8, 8, 8, 3, 3, 3, 3));
+      MemoryArbitrator::Stats(
+          3, 3, 3, 3, 3, 3, 3, 3, 8, 8, 8, 3, 3, 3, 3, 3, 3));
 
   const MemoryArbitrator::Stats smallStats(
-      2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2);
+      2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2);
   ASSERT_TRUE(!(anchorStats == smallStats));
   ASSERT_TRUE(anchorStats != smallStats);
   ASSERT_TRUE(!(anchorStats < smallStats));
@@ -340,7 +343,7 @@ TEST_F(MemoryArbitrationTest, arbitratorStats) {
   ASSERT_TRUE(anchorStats >= smallStats);
 
   const MemoryArbitrator::Stats invalidStats(
-      2, 2, 2, 2, 2, 2, 8, 8, 8, 8, 8, 8, 2, 8, 2);
+      2, 2, 2, 2, 2, 2, 8, 8, 8, 8, 8, 8, 2, 8, 2, 2, 8);
   ASSERT_TRUE(!(anchorStats == invalidStats));
   ASSERT_TRUE(anchorStats != invalidStats);
   VELOX_ASSERT_THROW(anchorStats < invalidStats, "");
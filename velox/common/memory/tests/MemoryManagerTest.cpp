@@ -110,7 +110,8 @@ TEST_F(MemoryManagerTest, ctor) {
         "STATS[numRequests 0 numAborted 0 numFailures 0 "
         "numNonReclaimableAttempts 0 numReserves 0 numReleases 0 queueTime 0us "
         "arbitrationTime 0us reclaimTime 0us shrunkMemory 0B "
-        "reclaimedMemory 0B maxCapacity 4.00GB freeCapacity 4.00GB freeReservedCapacity 0B]]]");
+        "reclaimedMemory 0B maxCapacity 4.00GB freeCapacity 4.00GB freeReservedCapacity 0B "
+        "globalQueueTime 0us numGlobalQueueTimeouts 0]]]");
   }
 }
 
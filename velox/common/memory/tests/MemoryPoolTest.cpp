@@ -3411,6 +3411,59 @@ TEST_P(MemoryPoolTest, maybeReserve) {
   ASSERT_EQ(child->stats().numShrinks, 0);
 }
 
+TEST_P(MemoryPoolTest, reservationCache) {
+  constexpr int64_t kMaxSize = 1 << 30; // 1GB
+  setupMemory(
+      {.memoryPoolReservationCacheBytes = MB,
+       .allocatorCapacity = kMaxSize,
+       .arbitratorCapacity = kMaxSize,
+       .arbitratorReservedCapacity = kMaxSize / 8});
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("reservationCache", kMaxSize);
+  auto child = root->addLeafChild("reservationCache", isLeafThreadSafe_);
+
+  void* small = child->allocate(MB / 2);
+  ASSERT_EQ(child->reservedBytes(), MB);
+  void* large = child->allocate(MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->reservedBytes(), 2 * MB);
+
+  // Freeing below the quantum boundary keeps the reservation, so that the
+  // next allocation does not go to the root.
+  child->free(large, MB);
+  ASSERT_EQ(child->usedBytes(), MB / 2);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->reservedBytes(), 2 * MB);
+  large = child->allocate(MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->reservedBytes(), 2 * MB);
+
+  // The cache is at most one quantum above the usage.
+  child->free(large, MB);
+  child->free(small, MB / 2);
+  ASSERT_EQ(child->usedBytes(), 0);
+  ASSERT_EQ(child->reservedBytes(), MB);
+  ASSERT_EQ(child->releasableReservation(), MB);
+  ASSERT_EQ(root->reservedBytes(), MB);
+
+  child->release();
+  ASSERT_EQ(child->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+
+  // Memory reclaim releases the cache of the thread-safe leaf pools.
+  child->free(child->allocate(MB / 2), MB / 2);
+  ASSERT_EQ(root->reservedBytes(), MB);
+  ASSERT_EQ(root->reclaim(0, 0, stats_), 0);
+  ASSERT_EQ(child->reservedBytes(), isLeafThreadSafe_ ? 0 : MB);
+  ASSERT_EQ(root->reservedBytes(), isLeafThreadSafe_ ? 0 : MB);
+
+  // The cache is returned on destruction.
+  child->free(child->allocate(MB / 2), MB / 2);
+  ASSERT_EQ(root->reservedBytes(), MB);
+  child.reset();
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
 TEST_P(MemoryPoolTest, maybeReserveFailWithAbort) {
   constexpr int64_t kMaxSize = 1 * GB; // 1GB
   setupMemory(
@@ -82,17 +82,27 @@ struct Allocation {
 
 class MockTask : public std::enable_shared_from_this<MockTask> {
  public:
-  MockTask() {}
+  explicit MockTask(
+      ArbitrationPriority priority = ArbitrationPriority::kNormal)
+      : priority_(priority) {}
 
   ~MockTask();
 
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
-    MemoryReclaimer(const std::shared_ptr<MockTask>& task) : task_(task) {}
+    MemoryReclaimer(
+        const std::shared_ptr<MockTask>& task,
+        ArbitrationPriority priority)
+        : task_(task), priority_(priority) {}
 
     static std::unique_ptr<MemoryReclaimer> create(
-        const std::shared_ptr<MockTask>& task) {
-      return std::make_unique<MemoryReclaimer>(task);
+        const std::shared_ptr<MockTask>& task,
+        ArbitrationPriority priority) {
+      return std::make_unique<MemoryReclaimer>(task, priority);
+    }
+
+    ArbitrationPriority priority() const override {
+      return priority_;
     }
 
     void abort(MemoryPool* pool, const std::exception_ptr& error) override {
@@ -106,13 +116,14 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
    private:
     std::weak_ptr<MockTask> task_;
+    const ArbitrationPriority priority_;
   };
 
   void initTaskPool(MemoryManager* manager, uint64_t capacity) {
     root_ = manager->addRootPool(
         fmt::format("RootPool-{}", poolId_++),
         capacity,
-        MemoryReclaimer::create(shared_from_this()));
+        MemoryReclaimer::create(shared_from_this(), priority_));
   }
 
   MemoryPool* pool() const {
@@ -148,6 +159,7 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
  private:
   inline static std::atomic<int64_t> poolId_{0};
+  const ArbitrationPriority priority_;
   std::shared_ptr<MemoryPool> root_;
   std::atomic<uint64_t> nextOp_{0};
   std::vector<std::shared_ptr<MemoryPool>> pools_;
@@ -426,7 +438,9 @@ class MockSharedArbitrationTest : public testing::Test {
       uint64_t memoryPoolReserveCapacity = kMemoryPoolReservedCapacity,
       uint64_t memoryPoolTransferCapacity = kMemoryPoolTransferCapacity,
       std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr,
-      bool globalArtbitrationEnabled = true) {
+      bool globalArtbitrationEnabled = true,
+      double proactiveReclaimWatermarkRatio = 0,
+      uint64_t proactiveReclaimIntervalMs = 1'000) {
     MemoryManagerOptions options;
     options.allocatorCapacity = memoryCapacity;
     options.arbitratorReservedCapacity = reservedMemoryCapacity;
@@ -436,6 +450,8 @@ class MockSharedArbitrationTest : public testing::Test {
     options.memoryPoolReservedCapacity = memoryPoolReserveCapacity;
     options.memoryPoolTransferCapacity = memoryPoolTransferCapacity;
     options.globalArbitrationEnabled = globalArtbitrationEnabled;
+    options.proactiveReclaimWatermarkRatio = proactiveReclaimWatermarkRatio;
+    options.proactiveReclaimIntervalMs = proactiveReclaimIntervalMs;
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
@@ -443,8 +459,10 @@ class MockSharedArbitrationTest : public testing::Test {
     arbitrator_ = static_cast<SharedArbitrator*>(manager_->arbitrator());
   }
 
-  std::shared_ptr<MockTask> addTask(int64_t capacity = kMaxMemory) {
-    auto task = std::make_shared<MockTask>();
+  std::shared_ptr<MockTask> addTask(
+      int64_t capacity = kMaxMemory,
+      ArbitrationPriority priority = ArbitrationPriority::kNormal) {
+    auto task = std::make_shared<MockTask>(priority);
     task->initTaskPool(manager_.get(), capacity);
     return task;
   }
@@ -1540,12 +1558,13 @@ DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, multipleGlobalRuns) {
     ASSERT_EQ(runtimeStats[SharedArbitrator::kGlobalArbitrationCount].count, 1);
     ASSERT_EQ(runtimeStats[SharedArbitrator::kGlobalArbitrationCount].sum, 1);
     ASSERT_EQ(runtimeStats[SharedArbitrator::kLocalArbitrationCount].count, 0);
+    // The global arbitration runs one at a time, so this one waits in the
+    // global arbitration queue.
     ASSERT_EQ(
-        runtimeStats[SharedArbitrator::kGlobalArbitrationLockWaitWallNanos]
-            .count,
+        runtimeStats[SharedArbitrator::kGlobalArbitrationQueueWallNanos].count,
         1);
     ASSERT_GT(
-        runtimeStats[SharedArbitrator::kGlobalArbitrationLockWaitWallNanos].sum,
+        runtimeStats[SharedArbitrator::kGlobalArbitrationQueueWallNanos].sum,
         0);
     ++allocations;
   });
@@ -2339,6 +2358,67 @@ TEST_F(MockSharedArbitrationTest, noAbortOnRequestWhenArbitrationFails) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, reclaimProactively) {
+  setupMemory(
+      kMemoryCapacity,
+      0,
+      kMemoryPoolInitCapacity,
+      0,
+      kMemoryPoolTransferCapacity,
+      nullptr,
+      true,
+      0.5,
+      100);
+  auto task = addTask(kMemoryCapacity);
+  auto* memOp = addMemoryOp(task, true);
+  const int allocateSize = 8 * MB;
+  while (task->capacity() < kMemoryCapacity / 2 + kMemoryCapacity / 4) {
+    memOp->allocate(allocateSize);
+  }
+
+  // The background thread spills the memory usage above the soft watermark
+  // without any failed capacity growth request.
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (task->capacity() > kMemoryCapacity / 2 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  ASSERT_LE(task->capacity(), kMemoryCapacity / 2);
+  ASSERT_GE(memOp->reclaimer()->stats().numReclaims, 1);
+  ASSERT_EQ(arbitrator_->stats().numFailures, 0);
+  ASSERT_EQ(task->error(), nullptr);
+}
+
+TEST_F(MockSharedArbitrationTest, abortByPriority) {
+  setupMemory(kMemoryCapacity, 0);
+  auto highTask = addTask(kMemoryCapacity, ArbitrationPriority::kHigh);
+  auto* highOp = addMemoryOp(highTask, false);
+  highOp->allocate(kMemoryCapacity / 2);
+  auto lowTask = addTask(kMemoryCapacity, ArbitrationPriority::kLow);
+  auto* lowOp = addMemoryOp(lowTask, false);
+  lowOp->allocate(kMemoryCapacity / 4);
+  auto normalTask = addTask(kMemoryCapacity);
+  auto* normalOp = addMemoryOp(normalTask, false);
+  normalOp->allocate(kMemoryCapacity / 4);
+
+  // The high priority task uses the most memory but the low priority task is
+  // aborted.
+  normalOp->allocate(kMemoryCapacity / 8);
+  ASSERT_NE(lowTask->error(), nullptr);
+  ASSERT_EQ(highTask->error(), nullptr);
+  ASSERT_EQ(normalTask->error(), nullptr);
+  ASSERT_EQ(arbitrator_->stats().numAborted, 1);
+  ASSERT_EQ(arbitrator_->stats().numFailures, 0);
+
+  // A normal priority requestor does not abort a high priority task and fails
+  // instead.
+  VELOX_ASSERT_THROW(
+      normalOp->allocate(kMemoryCapacity / 2), "Exceeded memory pool cap");
+  ASSERT_EQ(highTask->error(), nullptr);
+  ASSERT_EQ(arbitrator_->stats().numAborted, 1);
+}
+
 DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, orderedArbitration) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::memory::SharedArbitrator::sortCandidatesByReclaimableFreeCapacity",
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/HardwareCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <atomic>
+
+#include <fmt/format.h>
+
+namespace facebook::velox::process {
+
+std::string HardwareCounters::toString() const {
+  return fmt::format(
+      "cycles: {}, instructions: {}, llcMisses: {}, branchMisses: {}",
+      cycles,
+      instructions,
+      llcMisses,
+      branchMisses);
+}
+
+#ifdef __linux__
+namespace {
+
+// Set once opening the counters failed on any thread, so that threads started
+// later do not retry the syscalls.
+std::atomic_bool perfEventsUnavailable{false};
+
+// The perf_event group of one thread. The group leader counts cycles, the
+// other events are optional because not all of them exist on every machine,
+// e.g. LLC misses are often missing in virtual machines.
+class ThreadCounterGroup {
+ public:
+  ThreadCounterGroup() {
+    if (perfEventsUnavailable) {
+      return;
+    }
+    leaderFd_ = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leaderFd_ < 0) {
+      perfEventsUnavailable = true;
+      return;
+    }
+    slots_[kCycles] = numEvents_++;
+    openMember(PERF_COUNT_HW_INSTRUCTIONS, kInstructions);
+    openMember(PERF_COUNT_HW_CACHE_MISSES, kLlcMisses);
+    openMember(PERF_COUNT_HW_BRANCH_MISSES, kBranchMisses);
+    ioctl(leaderFd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leaderFd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~ThreadCounterGroup() {
+    for (auto fd : memberFds_) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+    if (leaderFd_ >= 0) {
+      ::close(leaderFd_);
+    }
+  }
+
+  bool read(HardwareCounters& counters) const {
+    if (leaderFd_ < 0) {
+      return false;
+    }
+    // Layout of a PERF_FORMAT_GROUP read: the number of events followed by
+    // one value per event in the order the events were opened.
+    std::array<uint64_t, 1 + kNumCounters> buffer;
+    const auto size = (1 + numEvents_) * sizeof(uint64_t);
+    const auto bytesRead = ::read(leaderFd_, buffer.data(), size);
+    if (bytesRead != static_cast<ssize_t>(size)) {
+      return false;
+    }
+    counters.cycles = value(buffer, kCycles);
+    counters.instructions = value(buffer, kInstructions);
+    counters.llcMisses = value(buffer, kLlcMisses);
+    counters.branchMisses = value(buffer, kBranchMisses);
+    return true;
+  }
+
+ private:
+  enum Counter { kCycles, kInstructions, kLlcMisses, kBranchMisses };
+  static constexpr int32_t kNumCounters = 4;
+
+  static int open(uint64_t config, int groupFd) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.disabled = groupFd < 0 ? 1 : 0;
+    // User space only, which is allowed up to perf_event_paranoid 2.
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+  }
+
+  void openMember(uint64_t config, Counter counter) {
+    const auto fd = open(config, leaderFd_);
+    if (fd >= 0) {
+      memberFds_[numEvents_ - 1] = fd;
+      slots_[counter] = numEvents_++;
+    }
+  }
+
+  uint64_t value(
+      const std::array<uint64_t, 1 + kNumCounters>& buffer,
+      Counter counter) const {
+    return slots_[counter] < 0 ? 0 : buffer[1 + slots_[counter]];
+  }
+
+  int leaderFd_{-1};
+  std::array<int, kNumCounters - 1> memberFds_{-1, -1, -1};
+
+  // Position of each counter in the group read. -1 if not opened.
+  std::array<int32_t, kNumCounters> slots_{-1, -1, -1, -1};
+  int32_t numEvents_{0};
+};
+
+} // namespace
+
+bool readThreadHardwareCounters(HardwareCounters& counters) {
+  if (perfEventsUnavailable) {
+    return false;
+  }
+  thread_local ThreadCounterGroup group;
+  return group.read(counters);
+}
+#else
+bool readThreadHardwareCounters(HardwareCounters& /*counters*/) {
+  return false;
+}
+#endif
+
+} // namespace facebook::velox::process
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace facebook::velox::process {
+
+/// CPU hardware counters accumulated over a repeating operation.
+struct HardwareCounters {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t llcMisses{0};
+  uint64_t branchMisses{0};
+
+  void add(const HardwareCounters& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llcMisses += other.llcMisses;
+    branchMisses += other.branchMisses;
+  }
+
+  void clear() {
+    cycles = 0;
+    instructions = 0;
+    llcMisses = 0;
+    branchMisses = 0;
+  }
+
+  bool empty() const {
+    return cycles == 0 && instructions == 0;
+  }
+
+  std::string toString() const;
+};
+
+/// Reads the hardware counters of the calling thread into 'counters'. The
+/// counters are opened on the first call on each thread as one perf_event
+/// group counting user space only, so that a read is a single syscall.
+/// Returns false and leaves 'counters' unchanged if perf events are not
+/// available, e.g. not on Linux, in a container without access or with
+/// perf_event_paranoid above 2.
+bool readThreadHardwareCounters(HardwareCounters& counters);
+
+/// Reads the hardware counters of the calling thread at construction and
+/// passes the difference to 'func' at destruction. Does nothing if the
+/// counters are not available.
+template <typename F>
+class DeltaHardwareCounters {
+ public:
+  explicit DeltaHardwareCounters(F&& func)
+      : valid_(readThreadHardwareCounters(start_)), func_(std::move(func)) {}
+
+  ~DeltaHardwareCounters() {
+    HardwareCounters end;
+    if (!valid_ || !readThreadHardwareCounters(end)) {
+      return;
+    }
+    func_(HardwareCounters{
+        end.cycles - start_.cycles,
+        end.instructions - start_.instructions,
+        end.llcMisses - start_.llcMisses,
+        end.branchMisses - start_.branchMisses});
+  }
+
+ private:
+  HardwareCounters start_;
+  const bool valid_;
+  F func_;
+};
+
+} // namespace facebook::velox::process
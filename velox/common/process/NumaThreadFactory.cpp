@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/NumaThreadFactory.h"
+
+#include <glog/logging.h>
+
+#include "velox/common/process/ProcessBase.h"
+
+namespace facebook::velox::process {
+
+std::thread NumaThreadFactory::newThread(folly::Func&& func) {
+  const auto numNodes = numaNodeCount();
+  if (numNodes < 2) {
+    return factory_.newThread(std::move(func));
+  }
+  const auto node = nextNode_++ % numNodes;
+  return factory_.newThread([node, func = std::move(func)]() mutable {
+    if (!bindCurrentThreadToNumaNode(node)) {
+      LOG(WARNING) << "Failed to bind thread to NUMA node " << node;
+    }
+    func();
+  });
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+namespace facebook::velox::process {
+
+/// Thread factory that binds its threads to the NUMA nodes of the machine in
+/// round robin order. Meant for the executor of the drivers, so that the
+/// memory a driver touches, including the AsyncDataCache entries it loads,
+/// stays on the node of its thread. The threads are named like with
+/// folly::NamedThreadFactory. On a machine with one node, the threads are not
+/// bound.
+class NumaThreadFactory : public folly::ThreadFactory {
+ public:
+  explicit NumaThreadFactory(folly::StringPiece prefix) : factory_(prefix) {}
+
+  std::thread newThread(folly::Func&& func) override;
+
+  const std::string& getNamePrefix() const override {
+    return factory_.getNamePrefix();
+  }
+
+ private:
+  folly::NamedThreadFactory factory_;
+  std::atomic<int32_t> nextNode_{0};
+};
+
+} // namespace facebook::velox::process
@@ -17,13 +17,20 @@
 #include "velox/common/process/ProcessBase.h"
 
 #include <limits.h>
+#include <sched.h>
 #include <stdlib.h>
 #include <time.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
 
+#include <folly/Conv.h>
 #include <folly/CpuId.h>
 #include <folly/FileUtil.h>
 #include <folly/String.h>
+#include <fmt/format.h>
 #include <gflags/gflags.h>
 
 constexpr const char* kProcSelfCmdline = "/proc/self/cmdline";
@@ -32,6 +39,8 @@ DECLARE_bool(avx2); // Enables use of AVX2 when available NOLINT
 
 DECLARE_bool(bmi2); // Enables use of BMI2 when available NOLINT
 
+DECLARE_bool(avx512); // Enables use of AVX-512 when available NOLINT
+
 namespace facebook {
 namespace velox {
 namespace process {
@@ -106,6 +115,11 @@ uint64_t threadCpuNanos() {
 namespace {
 bool bmi2CpuFlag = folly::CpuId().bmi2();
 bool avx2CpuFlag = folly::CpuId().avx2();
+bool avx512VbmiCpuFlag = []() {
+  folly::CpuId cpuId;
+  return cpuId.avx512f() && cpuId.avx512bw() && cpuId.avx512vl() &&
+      cpuId.avx512vbmi();
+}();
 } // namespace
 
 bool hasAvx2() {
@@ -124,6 +138,119 @@ bool hasBmi2() {
 #endif
 }
 
+bool hasAvx512Vbmi() {
+#ifdef __x86_64__
+  return avx512VbmiCpuFlag && FLAGS_avx512;
+#else
+  return false;
+#endif
+}
+
+namespace {
+constexpr const char* kNumaNodeCpuList = "/sys/devices/system/node/node{}/cpulist";
+
+// Parses a list like '0-15,32-47' into the CPU numbers.
+std::vector<int32_t> parseCpuList(const std::string& list) {
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(list), ranges);
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash = range.find('-');
+    const auto first = folly::to<int32_t>(range.subpiece(0, dash));
+    const auto last = dash == folly::StringPiece::npos
+        ? first
+        : folly::to<int32_t>(range.subpiece(dash + 1));
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+struct NumaTopology {
+  // CPUs of each node. Empty for nodes with only memory.
+  std::vector<std::vector<int32_t>> nodeCpus;
+  // Node of each CPU.
+  std::vector<int32_t> cpuNode;
+};
+
+const NumaTopology& numaTopology() {
+  static const NumaTopology topology = []() {
+    NumaTopology result;
+    // Node numbers are dense on the machines of interest. Stop at the first
+    // gap.
+    for (auto node = 0;; ++node) {
+      std::string list;
+      if (!folly::readFile(fmt::format(kNumaNodeCpuList, node).c_str(), list)) {
+        break;
+      }
+      auto cpus = parseCpuList(list);
+      for (auto cpu : cpus) {
+        if (cpu >= result.cpuNode.size()) {
+          result.cpuNode.resize(cpu + 1, 0);
+        }
+        result.cpuNode[cpu] = result.nodeCpus.size();
+      }
+      result.nodeCpus.push_back(std::move(cpus));
+    }
+    return result;
+  }();
+  return topology;
+}
+} // namespace
+
+int32_t numaNodeCount() {
+  return std::max<size_t>(1, numaTopology().nodeCpus.size());
+}
+
+int32_t currentNumaNode() {
+  const auto& cpuNode = numaTopology().cpuNode;
+  const auto cpu = sched_getcpu();
+  if (cpu < 0 || cpu >= cpuNode.size()) {
+    return 0;
+  }
+  return cpuNode[cpu];
+}
+
+bool bindCurrentThreadToNumaNode(int32_t node) {
+#ifdef __linux__
+  const auto& nodeCpus = numaTopology().nodeCpus;
+  if (node < 0 || node >= nodeCpus.size() || nodeCpus[node].empty()) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : nodeCpus[node]) {
+    CPU_SET(cpu, &cpuSet);
+  }
+  return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
+bool moveToNumaNode(void* data, uint64_t bytes, int32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  if (node < 0 || node >= 64 || numaNodeCount() < 2) {
+    return false;
+  }
+  const unsigned long nodeMask = 1UL << node;
+  return syscall(
+             SYS_mbind,
+             data,
+             bytes,
+             MPOL_PREFERRED,
+             &nodeMask,
+             sizeof(nodeMask) * 8,
+             MPOL_MF_MOVE) == 0;
+#else
+  return false;
+#endif
+}
+
 } // namespace process
 } // namespace velox
 } // namespace facebook
@@ -50,4 +50,26 @@ bool hasAvx2();
 /// by flag.
 bool hasBmi2();
 
+/// True if the machine has the F, BW, VL and VBMI subsets of Intel AVX-512 and
+/// these are not disabled by flag. Unlike hasAvx2(), this does not depend on
+/// the build flags: the callers compile their AVX-512 code with function
+/// target attributes and select it at runtime.
+bool hasAvx512Vbmi();
+
+/// Number of NUMA nodes. 1 if the topology is not known.
+int32_t numaNodeCount();
+
+/// NUMA node of the CPU the calling thread runs on. 0 if not known. The thread
+/// may migrate to another node right after unless bound to one.
+int32_t currentNumaNode();
+
+/// Restricts the calling thread to the CPUs of NUMA node 'node'. Returns false
+/// if the topology is not known or the binding failed.
+bool bindCurrentThreadToNumaNode(int32_t node);
+
+/// Moves the pages of the page aligned range of 'bytes' at 'data' to NUMA node
+/// 'node' and makes it the preferred node of the range. Returns false if not
+/// supported or failed. The pages are unchanged in that case.
+bool moveToNumaNode(void* data, uint64_t bytes, int32_t node);
+
 } // namespace facebook::velox::process
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/StackSampler.h"
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <cerrno>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+#include <array>
+#include <atomic>
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <folly/experimental/symbolizer/StackTrace.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/StackTrace.h"
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+
+// Frames of the signal handler at the top of each sample.
+constexpr int32_t kSkipFrames = 1;
+
+struct RawSample {
+  int32_t label;
+  int32_t numFrames;
+  uintptr_t frames[StackSampler::kMaxFrames + kSkipFrames];
+};
+
+// Sampling state of one thread. Written by the signal handler on the same
+// thread, so that the only synchronization needed is against the compiler
+// reordering the accesses, not against other threads.
+struct ThreadState {
+  ~ThreadState() {
+    if (timerCreated) {
+      timer_delete(timer);
+    }
+  }
+
+  timer_t timer;
+  bool timerCreated{false};
+  std::atomic_bool active{false};
+  StackSampler::LabelFunc label{nullptr};
+  const void* context{nullptr};
+  std::atomic_int32_t numSamples{0};
+  std::atomic_int64_t numDropped{0};
+  std::array<RawSample, StackSampler::kMaxScopeSamples> samples;
+};
+
+// Owns the state. Only accessed outside of the signal handler.
+thread_local std::unique_ptr<ThreadState> threadStateHolder;
+
+// Trivially initialized, so that accessing it in the signal handler does not
+// run thread local constructors. Set before the first sample on the thread.
+thread_local ThreadState* threadState{nullptr};
+
+void sampleSignalHandler(int /*signal*/, siginfo_t* /*info*/, void* /*ctx*/) {
+  auto* state = threadState;
+  if (state == nullptr || !state->active.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const auto savedErrno = errno;
+  const auto index = state->numSamples.load(std::memory_order_relaxed);
+  if (index >= StackSampler::kMaxScopeSamples) {
+    state->numDropped.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    auto& sample = state->samples[index];
+    sample.label = state->label(state->context);
+    const auto numFrames = folly::symbolizer::getStackTraceSafe(
+        sample.frames, StackSampler::kMaxFrames + kSkipFrames);
+    sample.numFrames = numFrames > 0 ? numFrames : 0;
+    state->numSamples.store(index + 1, std::memory_order_relaxed);
+  }
+  errno = savedErrno;
+}
+
+void installSignalHandler() {
+  static std::once_flag installed;
+  std::call_once(installed, []() {
+    struct sigaction action {};
+    action.sa_sigaction = sampleSignalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    VELOX_CHECK_EQ(sigaction(SIGPROF, &action, nullptr), 0);
+  });
+}
+
+// Returns the state of the calling thread with a timer that signals the
+// thread itself. Returns nullptr if the timer could not be created.
+ThreadState* getThreadState() {
+  if (threadState != nullptr) {
+    return threadState;
+  }
+  if (threadStateHolder != nullptr) {
+    // Timer creation failed before.
+    return nullptr;
+  }
+  threadStateHolder = std::make_unique<ThreadState>();
+  sigevent event{};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = syscall(SYS_gettid);
+  if (timer_create(
+          CLOCK_THREAD_CPUTIME_ID, &event, &threadStateHolder->timer) != 0) {
+    LOG(WARNING) << "Failed to create stack sampling timer: "
+                 << folly::errnoStr(errno);
+    return nullptr;
+  }
+  threadStateHolder->timerCreated = true;
+  threadState = threadStateHolder.get();
+  return threadState;
+}
+
+void setTimer(ThreadState& state, int32_t intervalMs) {
+  itimerspec spec{};
+  spec.it_interval.tv_sec = intervalMs / 1'000;
+  spec.it_interval.tv_nsec = (intervalMs % 1'000) * 1'000'000;
+  spec.it_value = spec.it_interval;
+  timer_settime(state.timer, 0, &spec, nullptr);
+}
+
+} // namespace
+
+bool StackSampler::supported() {
+  return true;
+}
+
+StackSampler::ThreadScope::ThreadScope(
+    StackSampler* sampler,
+    LabelFunc label,
+    const void* context) {
+  VELOX_CHECK_NOT_NULL(sampler);
+  VELOX_CHECK_NOT_NULL(label);
+  installSignalHandler();
+  auto* state = getThreadState();
+  if (state == nullptr || state->active) {
+    return;
+  }
+  state->label = label;
+  state->context = context;
+  state->numSamples = 0;
+  state->numDropped = 0;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  state->active = true;
+  setTimer(*state, sampler->intervalMs_);
+  sampler_ = sampler;
+}
+
+StackSampler::ThreadScope::~ThreadScope() {
+  if (sampler_ == nullptr) {
+    return;
+  }
+  auto* state = threadState;
+  setTimer(*state, 0);
+  state->active = false;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+
+  const auto numSamples = state->numSamples.load();
+  std::vector<SampleKey> samples;
+  samples.reserve(numSamples);
+  for (auto i = 0; i < numSamples; ++i) {
+    const auto& sample = state->samples[i];
+    const auto* begin =
+        sample.frames + std::min(kSkipFrames, sample.numFrames);
+    samples.push_back(SampleKey{
+        sample.label,
+        std::vector<uintptr_t>(begin, sample.frames + sample.numFrames)});
+  }
+  sampler_->addSamples(std::move(samples), state->numDropped.load());
+}
+#else
+bool StackSampler::supported() {
+  return false;
+}
+
+StackSampler::ThreadScope::ThreadScope(
+    StackSampler* /*sampler*/,
+    LabelFunc /*label*/,
+    const void* /*context*/) {}
+
+StackSampler::ThreadScope::~ThreadScope() {}
+#endif
+
+StackSampler::StackSampler(int32_t intervalMs) : intervalMs_(intervalMs) {
+  VELOX_CHECK_GT(intervalMs_, 0);
+}
+
+void StackSampler::setLabelName(int32_t label, std::string name) {
+  std::lock_guard<std::mutex> l(mutex_);
+  labelNames_[label] = std::move(name);
+}
+
+void StackSampler::addSamples(
+    std::vector<SampleKey> samples,
+    int64_t numDropped) {
+  std::lock_guard<std::mutex> l(mutex_);
+  numSamples_ += samples.size();
+  numDroppedSamples_ += numDropped;
+  for (auto& sample : samples) {
+    ++counts_[std::move(sample)];
+  }
+}
+
+int64_t StackSampler::numSamples() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numSamples_;
+}
+
+int64_t StackSampler::numDroppedSamples() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numDroppedSamples_;
+}
+
+std::string StackSampler::foldedStacks() const {
+  std::map<SampleKey, int64_t> counts;
+  std::unordered_map<int32_t, std::string> labelNames;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    counts = counts_;
+    labelNames = labelNames_;
+  }
+
+  // Symbolizing is slow, so each address is symbolized once. Distinct
+  // addresses in the same function fold into the same line.
+  std::unordered_map<uintptr_t, std::string> symbols;
+  auto symbolize = [&](uintptr_t address) -> const std::string& {
+    auto it = symbols.find(address);
+    if (it == symbols.end()) {
+      auto name = StackTrace::translateFrame(reinterpret_cast<void*>(address));
+      if (name.empty()) {
+        name = fmt::format("{:#x}", address);
+      }
+      it = symbols.emplace(address, std::move(name)).first;
+    }
+    return it->second;
+  };
+
+  std::map<std::string, int64_t> lines;
+  for (const auto& [key, count] : counts) {
+    auto nameIt = labelNames.find(key.label);
+    std::string line = nameIt != labelNames.end()
+        ? nameIt->second
+        : std::to_string(key.label);
+    for (auto i = static_cast<int32_t>(key.frames.size()) - 1; i >= 0; --i) {
+      const auto& symbol = symbolize(key.frames[i]);
+      // The signal trampoline is the innermost frame below the handler when
+      // the unwinder reports it.
+      if (i == 0 && symbol.find("__restore_rt") != std::string::npos) {
+        continue;
+      }
+      line += ';';
+      line += symbol;
+    }
+    lines[line] += count;
+  }
+
+  std::string result;
+  for (const auto& [line, count] : lines) {
+    result += fmt::format("{} {}\n", line, count);
+  }
+  return result;
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Samples the stacks of the threads that run the work of one unit, e.g. one
+/// task, as opposed to Profiler, which samples the whole process. A thread is
+/// sampled only while it is inside a ThreadScope of the sampler. Sampling is
+/// driven by a timer on the CPU time of the thread that raises SIGPROF, so a
+/// thread blocked or waiting is not sampled. Each sample is tagged with an
+/// integer label read from the thread at the time of the sample, e.g. the
+/// operator running. The samples are aggregated and returned as folded stacks
+/// for flame graph tools. Only supported on Linux.
+class StackSampler {
+ public:
+  /// Returns the label of the samples taken on a thread. Called from the
+  /// signal handler, so must only read memory without locking, e.g. atomics.
+  using LabelFunc = int32_t (*)(const void* context);
+
+  /// Maximum number of frames kept per sample.
+  static constexpr int32_t kMaxFrames = 64;
+
+  /// Maximum number of samples kept per ThreadScope. Further samples are
+  /// dropped and counted in numDroppedSamples().
+  static constexpr int32_t kMaxScopeSamples = 512;
+
+  /// Samples a thread every 'intervalMs' of its CPU time.
+  explicit StackSampler(int32_t intervalMs);
+
+  /// True if stack sampling is supported on this platform.
+  static bool supported();
+
+  /// Sets the root frame of the folded stacks for samples with 'label'.
+  /// Samples with a label without a name are rooted at the label number.
+  void setLabelName(int32_t label, std::string name);
+
+  /// Samples the calling thread for the lifetime of the object. The samples
+  /// are added to 'sampler' at destruction. Does nothing if another scope is
+  /// active on the thread or sampling is not supported.
+  class ThreadScope {
+   public:
+    ThreadScope(StackSampler* sampler, LabelFunc label, const void* context);
+
+    ~ThreadScope();
+
+   private:
+    StackSampler* sampler_{nullptr};
+  };
+
+  /// Returns one line per distinct label and stack in the format
+  /// "<label name>;<outermost frame>;...;<innermost frame> <count>".
+  std::string foldedStacks() const;
+
+  int64_t numSamples() const;
+
+  int64_t numDroppedSamples() const;
+
+ private:
+  struct SampleKey {
+    int32_t label;
+    // Return addresses, innermost first.
+    std::vector<uintptr_t> frames;
+
+    bool operator<(const SampleKey& other) const {
+      return label != other.label ? label < other.label
+                                  : frames < other.frames;
+    }
+  };
+
+  void addSamples(std::vector<SampleKey> samples, int64_t numDropped);
+
+  const int32_t intervalMs_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<int32_t, std::string> labelNames_;
+  std::map<SampleKey, int64_t> counts_;
+  int64_t numSamples_{0};
+  int64_t numDroppedSamples_{0};
+};
+
+} // namespace facebook::velox::process
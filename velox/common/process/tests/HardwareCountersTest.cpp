@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/HardwareCounters.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+int64_t spin(int32_t iterations) {
+  volatile int64_t sum = 0;
+  for (auto i = 0; i < iterations; ++i) {
+    sum += i;
+  }
+  return sum;
+}
+
+TEST(HardwareCountersTest, addAndClear) {
+  HardwareCounters counters;
+  EXPECT_TRUE(counters.empty());
+  counters.add({10, 20, 1, 2});
+  counters.add({5, 6, 3, 4});
+  EXPECT_EQ(15, counters.cycles);
+  EXPECT_EQ(26, counters.instructions);
+  EXPECT_EQ(4, counters.llcMisses);
+  EXPECT_EQ(6, counters.branchMisses);
+  EXPECT_FALSE(counters.empty());
+  EXPECT_EQ(
+      "cycles: 15, instructions: 26, llcMisses: 4, branchMisses: 6",
+      counters.toString());
+  counters.clear();
+  EXPECT_TRUE(counters.empty());
+}
+
+TEST(HardwareCountersTest, delta) {
+  HardwareCounters probe;
+  if (!readThreadHardwareCounters(probe)) {
+    // Perf events are not available, the deltas must not be reported.
+    bool called = false;
+    {
+      DeltaHardwareCounters counters(
+          [&](const HardwareCounters& /*delta*/) { called = true; });
+      spin(1'000);
+    }
+    EXPECT_FALSE(called);
+    GTEST_SKIP() << "Perf events are not available";
+  }
+
+  HardwareCounters total;
+  {
+    DeltaHardwareCounters counters(
+        [&](const HardwareCounters& delta) { total.add(delta); });
+    spin(1'000'000);
+  }
+  EXPECT_GT(total.cycles, 0);
+  EXPECT_GT(total.instructions, 1'000'000);
+
+  // Each thread has its own counters.
+  HardwareCounters otherThread;
+  std::thread thread([&]() {
+    DeltaHardwareCounters counters(
+        [&](const HardwareCounters& delta) { otherThread.add(delta); });
+    spin(1'000);
+  });
+  thread.join();
+  EXPECT_LT(otherThread.instructions, total.instructions);
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/NumaThreadFactory.h"
+#include "velox/common/process/ProcessBase.h"
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <cstring>
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(NumaTest, topology) {
+  const auto numNodes = numaNodeCount();
+  ASSERT_GE(numNodes, 1);
+  const auto node = currentNumaNode();
+  ASSERT_GE(node, 0);
+  ASSERT_LT(node, numNodes);
+  EXPECT_FALSE(bindCurrentThreadToNumaNode(-1));
+  EXPECT_FALSE(bindCurrentThreadToNumaNode(numNodes));
+}
+
+TEST(NumaTest, bindAndMove) {
+  const auto numNodes = numaNodeCount();
+  std::thread thread([&]() {
+    const auto last = numNodes - 1;
+    if (bindCurrentThreadToNumaNode(last)) {
+      EXPECT_EQ(last, currentNumaNode());
+    }
+  });
+  thread.join();
+
+  constexpr uint64_t kSize = 1 << 20;
+  void* data = mmap(
+      nullptr, kSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(MAP_FAILED, data);
+  memset(data, 1, kSize);
+  // A single node machine or a kernel without NUMA support may refuse, the
+  // memory must stay usable either way.
+  moveToNumaNode(data, kSize, 0);
+  EXPECT_EQ(1, reinterpret_cast<char*>(data)[kSize - 1]);
+  EXPECT_FALSE(moveToNumaNode(data, kSize, numNodes));
+  munmap(data, kSize);
+}
+
+TEST(NumaTest, threadFactory) {
+  NumaThreadFactory factory("numa");
+  EXPECT_EQ("numa", factory.getNamePrefix());
+  std::vector<int32_t> nodes(4, -1);
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < nodes.size(); ++i) {
+    threads.push_back(
+        factory.newThread([&nodes, i]() { nodes[i] = currentNumaNode(); }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto node : nodes) {
+    EXPECT_GE(node, 0);
+    EXPECT_LT(node, numaNodeCount());
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/StackSampler.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <ctime>
+#include <sstream>
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+int32_t readLabel(const void* context) {
+  return static_cast<const std::atomic_int32_t*>(context)->load();
+}
+
+int64_t spin(int64_t iterations) {
+  volatile int64_t sum = 0;
+  for (auto i = 0; i < iterations; ++i) {
+    sum += i;
+  }
+  return sum;
+}
+
+// Spins until the thread has used 'millis' of CPU time.
+void spinFor(int32_t millis) {
+  const auto start = std::clock();
+  while ((std::clock() - start) * 1'000 / CLOCKS_PER_SEC < millis) {
+    spin(10'000);
+  }
+}
+
+TEST(StackSamplerTest, labels) {
+  if (!StackSampler::supported()) {
+    GTEST_SKIP() << "Stack sampling is not supported";
+  }
+  StackSampler sampler(1);
+  sampler.setLabelName(1, "first");
+  sampler.setLabelName(2, "second");
+
+  auto work = [&]() {
+    std::atomic_int32_t label{1};
+    StackSampler::ThreadScope scope(&sampler, readLabel, &label);
+    spinFor(50);
+    label = 2;
+    spinFor(50);
+    label = 3;
+    spinFor(50);
+  };
+  std::thread thread(work);
+  thread.join();
+  work();
+
+  ASSERT_GT(sampler.numSamples(), 0);
+  int64_t numFirst = 0;
+  int64_t numSecond = 0;
+  int64_t numUnnamed = 0;
+  int64_t total = 0;
+  std::istringstream lines(sampler.foldedStacks());
+  std::string line;
+  while (std::getline(lines, line)) {
+    const auto count = std::stoll(line.substr(line.rfind(' ') + 1));
+    total += count;
+    if (line.rfind("first;", 0) == 0) {
+      numFirst += count;
+    } else if (line.rfind("second;", 0) == 0) {
+      numSecond += count;
+    } else {
+      EXPECT_EQ(0, line.rfind("3;", 0)) << line;
+      numUnnamed += count;
+    }
+  }
+  EXPECT_EQ(sampler.numSamples(), total);
+  EXPECT_GT(numFirst, 0);
+  EXPECT_GT(numSecond, 0);
+  EXPECT_GT(numUnnamed, 0);
+}
+
+TEST(StackSamplerTest, outsideScope) {
+  StackSampler sampler(1);
+  spinFor(20);
+  {
+    std::atomic_int32_t label{0};
+    StackSampler::ThreadScope scope(&sampler, readLabel, &label);
+    // A nested scope on the same thread does nothing.
+    StackSampler::ThreadScope nested(&sampler, readLabel, &label);
+  }
+  spinFor(20);
+  EXPECT_LE(sampler.numSamples(), 1);
+  EXPECT_EQ(0, sampler.numDroppedSamples());
+}
+
+} // namespace
+} // namespace facebook::velox::process
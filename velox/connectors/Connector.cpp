@@ -131,6 +131,36 @@ std::shared_ptr<cache::ScanTracker> Connector::getTracker(
   });
 }
 
+folly::Synchronized<
+    std::unordered_map<std::string, std::weak_ptr<SharedSelectivityInfo>>>
+    Connector::sharedSelectivities_;
+
+// static
+void Connector::unregisterSharedSelectivity(SharedSelectivityInfo* info) {
+  sharedSelectivities_.withWLock([&](auto& infos) {
+    // A new instance may have replaced 'info' after its last reference
+    // went away.
+    auto it = infos.find(info->id());
+    if (it != infos.end() && it->second.expired()) {
+      infos.erase(it);
+    }
+  });
+}
+
+std::shared_ptr<SharedSelectivityInfo> Connector::getSharedSelectivity(
+    const std::string& scanId) {
+  return sharedSelectivities_.withWLock([&](auto& infos) {
+    auto& weak = infos[scanId];
+    auto info = weak.lock();
+    if (!info) {
+      info = std::make_shared<SharedSelectivityInfo>(
+          scanId, unregisterSharedSelectivity);
+      weak = info;
+    }
+    return info;
+  });
+}
+
 std::string commitStrategyToString(CommitStrategy commitStrategy) {
   switch (commitStrategy) {
     case CommitStrategy::kNoCommit:
@@ -18,6 +18,7 @@
 #include "folly/CancellationToken.h"
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/base/SharedSelectivityInfo.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/caching/AsyncDataCache.h"
@@ -51,6 +52,10 @@ struct ConnectorSplit {
 
   std::unique_ptr<AsyncSource<DataSource>> dataSource;
 
+  /// True once the file of the split is being opened ahead of the split being
+  /// read. See DataSource::prefetchSplitFile().
+  bool filePrefetched{false};
+
   explicit ConnectorSplit(
       const std::string& _connectorId,
       int64_t _splitWeight = 0)
@@ -61,6 +66,28 @@ struct ConnectorSplit {
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  /// Returns the number of the table bucket the data of this split belongs to
+  /// if the table is bucketed. Grouped execution processes the splits with the
+  /// same bucket number as one split group.
+  virtual std::optional<int32_t> bucketNumber() const {
+    return std::nullopt;
+  }
+
+  /// Returns the path of the file the split reads or an empty string. Reads
+  /// ahead of splits of the same storage location share a concurrency limit.
+  /// See io::IoConcurrencyLimiter.
+  virtual std::string storagePath() const {
+    return "";
+  }
+
+  /// Returns a key that identifies the data of the split or std::nullopt if
+  /// the data may change, e.g. if the modification time of the file is not
+  /// known. Two splits with the same key produce the same rows with the same
+  /// table handle. See exec::FragmentResultCache.
+  virtual std::optional<std::string> cacheKey() const {
+    return std::nullopt;
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -172,6 +199,18 @@ class DataSink {
   virtual void abort() = 0;
 };
 
+/// The part of a split being read by a DataSource that the DataSource has not
+/// started to read. Another DataSource of the same scan can take it over, so
+/// that an idle driver shares the work of a large split. Thread safe.
+class StealableSplit {
+ public:
+  virtual ~StealableSplit() = default;
+
+  /// Takes a part of the unread data away from the DataSource reading the
+  /// split and returns a split for it. Returns nullptr if nothing is left.
+  virtual std::shared_ptr<ConnectorSplit> steal() = 0;
+};
+
 class DataSource {
  public:
   static constexpr int64_t kUnknownRowSize = -1;
@@ -215,6 +254,17 @@ class DataSource {
     return false;
   }
 
+  /// Returns a function that opens the file of an upcoming 'split' and reads
+  /// its metadata so that a later addSplit() of 'split' finds them in the
+  /// caches of the connector. Returns nullptr if there is nothing to prefetch.
+  /// The function runs on the executor of the connector, possibly after 'this'
+  /// is destroyed, so it must not refer to 'this'. This is much cheaper than a
+  /// preload and can therefore be done further ahead in the split queue.
+  virtual std::function<void()> prefetchSplitFile(
+      const std::shared_ptr<ConnectorSplit>& /*split*/) {
+    return nullptr;
+  }
+
   /// Initializes this from 'source'. 'source' is effectively moved into 'this'
   /// Adaptation like dynamic filters stay in effect but the parts dealing with
   /// open files, prefetched data etc. are moved. 'source' is freed after the
@@ -233,6 +283,15 @@ class DataSource {
     return kUnknownRowSize;
   }
 
+  /// Returns the part of the current split that 'this' has not started to
+  /// read, for other DataSources of the same scan to take over. Returns
+  /// nullptr if the split cannot be shared. This is called after addSplit().
+  /// The returned object may be used from other threads while 'this' reads
+  /// the split.
+  virtual std::shared_ptr<StealableSplit> stealableSplit() {
+    return nullptr;
+  }
+
   /// Returns a Wave delegate that implements the Wave Operator
   /// interface for a GPU table scan. This should be called after
   /// construction and no other methods should be called on 'this'
@@ -344,6 +403,16 @@ class ConnectorQueryCtx {
     return cancellationToken_;
   }
 
+  /// If true, DataSource::next() should return std::nullopt with a future
+  /// rather than wait for IO running in the background.
+  bool asyncIo() const {
+    return asyncIo_;
+  }
+
+  void setAsyncIo(bool asyncIo) {
+    asyncIo_ = asyncIo;
+  }
+
  private:
   memory::MemoryPool* const operatorPool_;
   memory::MemoryPool* const connectorPool_;
@@ -358,6 +427,7 @@ class ConnectorQueryCtx {
   const std::string planNodeId_;
   const std::string sessionTimezone_;
   const folly::CancellationToken cancellationToken_;
+  bool asyncIo_{false};
 };
 
 class Connector {
@@ -410,6 +480,12 @@ class Connector {
       const std::string& scanId,
       int32_t loadQuantum);
 
+  /// Returns the filter selectivity shared by all ScanSpecs of the scan
+  /// identified by 'scanId'. Different splits and drivers of the scan
+  /// get the same instance as long as one of them holds it.
+  static std::shared_ptr<SharedSelectivityInfo> getSharedSelectivity(
+      const std::string& scanId);
+
   virtual folly::Executor* executor() const {
     return nullptr;
   }
@@ -417,11 +493,17 @@ class Connector {
  private:
   static void unregisterTracker(cache::ScanTracker* tracker);
 
+  static void unregisterSharedSelectivity(SharedSelectivityInfo* info);
+
   const std::string id_;
 
   static folly::Synchronized<
       std::unordered_map<std::string_view, std::weak_ptr<cache::ScanTracker>>>
       trackers_;
+
+  static folly::Synchronized<
+      std::unordered_map<std::string, std::weak_ptr<SharedSelectivityInfo>>>
+      sharedSelectivities_;
 };
 
 class ConnectorFactory {
@@ -130,6 +130,18 @@ std::optional<std::string> HiveConfig::s3RetryMode() const {
       config_->get<std::string>(kS3RetryMode));
 }
 
+bool HiveConfig::s3UploadPartAsync() const {
+  return config_->get<bool>(kS3UploadPartAsync, false);
+}
+
+uint32_t HiveConfig::s3UploadThreads() const {
+  return config_->get<uint32_t>(kS3UploadThreads, 16);
+}
+
+uint32_t HiveConfig::s3MaxInFlightUploadParts() const {
+  return config_->get<uint32_t>(kS3MaxInFlightUploadParts, 4);
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -151,6 +163,22 @@ std::optional<std::string> HiveConfig::gcsMaxRetryTime() const {
       config_->get<std::string>(kGCSMaxRetryTime));
 }
 
+uint32_t HiveConfig::gcsReadThreads() const {
+  return config_->get<uint32_t>(kGCSReadThreads, 0);
+}
+
+uint32_t HiveConfig::hdfsReadThreads() const {
+  return config_->get<uint32_t>(kHdfsReadThreads, 0);
+}
+
+uint32_t HiveConfig::abfsUploadThreads() const {
+  return config_->get<uint32_t>(kAbfsUploadThreads, 0);
+}
+
+uint32_t HiveConfig::abfsMaxInFlightUploadBlocks() const {
+  return config_->get<uint32_t>(kAbfsMaxInFlightUploadBlocks, 4);
+}
+
 bool HiveConfig::isOrcUseColumnNames(const Config* session) const {
   return session->get<bool>(
       kOrcUseColumnNamesSession, config_->get<bool>(kOrcUseColumnNames, false));
@@ -178,10 +206,22 @@ int32_t HiveConfig::maxCoalescedDistanceBytes() const {
   return config_->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+bool HiveConfig::adaptiveCoalescing() const {
+  return config_->get<bool>(kAdaptiveCoalescing, false);
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
 
+uint64_t HiveConfig::unitPrefetchBytes() const {
+  return config_->get<uint64_t>(kUnitPrefetchBytes, 0);
+}
+
+int32_t HiveConfig::decodingParallelism() const {
+  return config_->get<int32_t>(kDecodingParallelism, 0);
+}
+
 int32_t HiveConfig::loadQuantum() const {
   return config_->get<int32_t>(kLoadQuantum, 8 << 20);
 }
@@ -260,6 +300,30 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+bool HiveConfig::partitionSortedWrite(const Config* session) const {
+  return session->get<bool>(
+      kPartitionSortedWriteSession,
+      config_->get<bool>(kPartitionSortedWrite, false));
+}
+
+bool HiveConfig::fileWriteAsync() const {
+  return config_->get<bool>(kFileWriteAsync, false);
+}
+
+uint32_t HiveConfig::fileWriteThreads() const {
+  return config_->get<uint32_t>(kFileWriteThreads, 8);
+}
+
+uint64_t HiveConfig::fileWriteMaxInFlightBytes() const {
+  return toCapacity(
+      config_->get<std::string>(kFileWriteMaxInFlightBytes, "64MB"),
+      core::CapacityUnit::BYTE);
+}
+
+uint32_t HiveConfig::fileWriteEncodingParallelism() const {
+  return config_->get<uint32_t>(kFileWriteEncodingParallelism, 0);
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 1UL << 20);
 }
@@ -283,6 +347,12 @@ uint8_t HiveConfig::parquetWriteTimestampUnit(const Config* session) const {
   return unit;
 }
 
+bool HiveConfig::parquetWriteAdaptiveEncoding(const Config* session) const {
+  return session->get<bool>(
+      kParquetWriteAdaptiveEncodingSession,
+      config_->get<bool>(kParquetWriteAdaptiveEncoding, false));
+}
+
 bool HiveConfig::cacheNoRetention(const Config* session) const {
   return session->get<bool>(
       kCacheNoRetentionSession,
@@ -104,6 +104,19 @@ class HiveConfig {
   /// Retry mode for a single http client.
   static constexpr const char* kS3RetryMode = "hive.s3.retry-mode";
 
+  /// Upload the parts of S3 multipart uploads asynchronously, so that appends
+  /// to a file do not wait for the upload of the previous parts.
+  static constexpr const char* kS3UploadPartAsync = "hive.s3.upload-part-async";
+
+  /// Number of threads shared by all the files of an S3 file system for
+  /// asynchronous part uploads.
+  static constexpr const char* kS3UploadThreads = "hive.s3.upload-threads";
+
+  /// Maximum number of parts of a single file being uploaded asynchronously
+  /// at a time. Appends block when this many parts are in flight.
+  static constexpr const char* kS3MaxInFlightUploadParts =
+      "hive.s3.max-inflight-upload-parts";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -119,6 +132,26 @@ class HiveConfig {
   /// The GCS maximum time allowed to retry transient errors.
   static constexpr const char* kGCSMaxRetryTime = "hive.gcs.max-retry-time";
 
+  /// Number of threads shared by all the files of a GCS file system for
+  /// reading the ranges of a vectored read as parallel ranged GETs. 0 reads
+  /// the ranges sequentially in the calling thread.
+  static constexpr const char* kGCSReadThreads = "hive.gcs.read-threads";
+
+  /// Number of threads shared by all the files of an HDFS file system for
+  /// reading the ranges of a vectored read in parallel. 0 reads the ranges
+  /// sequentially in the calling thread.
+  static constexpr const char* kHdfsReadThreads = "hive.hdfs.read-threads";
+
+  /// Number of threads shared by all the files of an ABFS file system for
+  /// uploading the blocks of written files in parallel. 0 uploads each
+  /// append synchronously in the writing thread.
+  static constexpr const char* kAbfsUploadThreads = "hive.abfs.upload-threads";
+
+  /// Maximum number of blocks of a single ABFS file being uploaded at a time.
+  /// Appends block when this many blocks are in flight.
+  static constexpr const char* kAbfsMaxInFlightUploadBlocks =
+      "hive.abfs.max-inflight-upload-blocks";
+
   /// Maps table field names to file field names using names, not indices.
   // TODO: remove hive_orc_use_column_names since it doesn't exist in presto,
   // right now this is only used for testing.
@@ -145,9 +178,26 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// If true, the coalescing distance and request size are chosen per file
+  /// system from the observed read latency and throughput.
+  /// 'max-coalesced-bytes' and 'max-coalesced-distance-bytes' apply until
+  /// enough reads are observed.
+  static constexpr const char* kAdaptiveCoalescing =
+      "adaptive-coalescing-enabled";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
+  /// The maximum bytes of IO for the DWRF stripes or Parquet row groups that
+  /// are loaded ahead of the one being read. 0 loads the DWRF stripes on
+  /// demand.
+  static constexpr const char* kUnitPrefetchBytes = "unit-prefetch-bytes";
+
+  /// The number of threads that decode the columns without filter of a DWRF
+  /// split in parallel, including the driver thread. The other threads come
+  /// from the executor of the connector. 0 or 1 decodes on the driver thread.
+  static constexpr const char* kDecodingParallelism = "decoding-parallelism";
+
   /// The total size in bytes for a direct coalesce request. Up to 8MB load
   /// quantum size is supported when SSD cache is enabled.
   static constexpr const char* kLoadQuantum = "load-quantum";
@@ -216,6 +266,35 @@ class HiveConfig {
   static constexpr const char* kSortWriterMaxOutputBytesSession =
       "sort_writer_max_output_bytes";
 
+  /// Buffer the input of a partitioned or bucketed table writer sorted by
+  /// partition and bucket, spilling if needed, and write the partitions one
+  /// at a time when the writer is closed. Only one file writer is open at a
+  /// time, so 'max-partitions-per-writers' can be raised for high cardinality
+  /// partitioning without spreading writer memory over many small stripes.
+  static constexpr const char* kPartitionSortedWrite =
+      "partition-sorted-write";
+  static constexpr const char* kPartitionSortedWriteSession =
+      "partition_sorted_write";
+
+  /// Write the files of the table writer on a thread pool of the connector,
+  /// so that the writer encodes the next stripe while the previous one is
+  /// being written.
+  static constexpr const char* kFileWriteAsync = "file-write-async";
+
+  /// Number of threads of a connector for asynchronous file writes.
+  static constexpr const char* kFileWriteThreads = "file-write-threads";
+
+  /// Maximum bytes of a single file being written asynchronously at a time.
+  /// The writer waits for the oldest write once this many bytes are in flight.
+  static constexpr const char* kFileWriteMaxInFlightBytes =
+      "file-write-max-inflight-bytes";
+
+  /// Number of threads, including the driver thread, that encode the columns
+  /// of a write in parallel. The other threads come from the file write
+  /// thread pool of the connector. Only used by the DWRF writer.
+  static constexpr const char* kFileWriteEncodingParallelism =
+      "file-write-encoding-parallelism";
+
   static constexpr const char* kS3UseProxyFromEnv =
       "hive.s3.use-proxy-from-env";
 
@@ -225,6 +304,13 @@ class HiveConfig {
   static constexpr const char* kParquetWriteTimestampUnitSession =
       "hive.parquet.writer.timestamp_unit";
 
+  /// Choose the encoding of each Parquet column from a sample of the first row
+  /// group instead of always starting with dictionary encoding.
+  static constexpr const char* kParquetWriteAdaptiveEncoding =
+      "hive.parquet.writer.adaptive-encoding";
+  static constexpr const char* kParquetWriteAdaptiveEncodingSession =
+      "hive.parquet.writer.adaptive_encoding";
+
   static constexpr const char* kCacheNoRetention = "cache.no_retention";
   static constexpr const char* kCacheNoRetentionSession = "cache.no_retention";
 
@@ -263,6 +349,12 @@ class HiveConfig {
 
   std::optional<std::string> s3RetryMode() const;
 
+  bool s3UploadPartAsync() const;
+
+  uint32_t s3UploadThreads() const;
+
+  uint32_t s3MaxInFlightUploadParts() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
@@ -273,6 +365,14 @@ class HiveConfig {
 
   std::optional<std::string> gcsMaxRetryTime() const;
 
+  uint32_t gcsReadThreads() const;
+
+  uint32_t hdfsReadThreads() const;
+
+  uint32_t abfsUploadThreads() const;
+
+  uint32_t abfsMaxInFlightUploadBlocks() const;
+
   bool isOrcUseColumnNames(const Config* session) const;
 
   bool isFileColumnNamesReadAsLowerCase(const Config* session) const;
@@ -285,8 +385,14 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes() const;
 
+  bool adaptiveCoalescing() const;
+
   int32_t prefetchRowGroups() const;
 
+  uint64_t unitPrefetchBytes() const;
+
+  int32_t decodingParallelism() const;
+
   int32_t loadQuantum() const;
 
   int32_t numCacheFileHandles() const;
@@ -311,6 +417,16 @@ class HiveConfig {
 
   uint64_t sortWriterMaxOutputBytes(const Config* session) const;
 
+  bool partitionSortedWrite(const Config* session) const;
+
+  bool fileWriteAsync() const;
+
+  uint32_t fileWriteThreads() const;
+
+  uint64_t fileWriteMaxInFlightBytes() const;
+
+  uint32_t fileWriteEncodingParallelism() const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
@@ -321,6 +437,8 @@ class HiveConfig {
   /// through Arrow bridge. 0: second, 3: milli, 6: micro, 9: nano.
   uint8_t parquetWriteTimestampUnit(const Config* session) const;
 
+  bool parquetWriteAdaptiveEncoding(const Config* session) const;
+
   /// Returns true to evict out a query scanned data out of in-memory cache
   /// right after the access, and also skip staging to the ssd cache. This helps
   /// to prevent the cache space pollution from the one-time table scan by large
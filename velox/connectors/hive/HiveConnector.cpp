@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/HiveConnector.h"
 
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
 #include "velox/common/base/Fs.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveDataSink.h"
@@ -68,6 +70,12 @@ HiveConnector::HiveConnector(
               : nullptr,
           std::make_unique<FileHandleGenerator>(config)),
       executor_(executor) {
+  if (hiveConfig_->fileWriteAsync() ||
+      hiveConfig_->fileWriteEncodingParallelism() > 1) {
+    writeExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        hiveConfig_->fileWriteThreads(),
+        std::make_shared<folly::NamedThreadFactory>("HiveFileWrite"));
+  }
   if (hiveConfig_->isFileHandleCacheEnabled()) {
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with maximum of "
@@ -109,7 +117,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      writeExecutor_.get());
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
@@ -78,6 +80,9 @@ class HiveConnector : public Connector {
   const std::shared_ptr<HiveConfig> hiveConfig_;
   FileHandleFactory fileHandleFactory_;
   folly::Executor* executor_;
+  // Writes and encodes the files of the data sinks if 'file-write-async' or
+  // 'file-write-encoding-parallelism' is set.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> writeExecutor_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <map>
 #include <optional>
 #include <unordered_map>
 #include "velox/connectors/Connector.h"
@@ -22,6 +23,10 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/dwio/common/Options.h"
 
+namespace facebook::velox::dwio::common {
+class Reader;
+} // namespace facebook::velox::dwio::common
+
 namespace facebook::velox::connector::hive {
 
 /// A bucket conversion that should happen on the split.  This happens when we
@@ -62,6 +67,11 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   /// the file handle.
   std::optional<FileProperties> properties;
 
+  /// The reader of the file if 'this' is the unread part of a split that was
+  /// taken over from the driver reading it. The reader is shared with that
+  /// driver so that the file is not opened and its footer is not read again.
+  std::shared_ptr<dwio::common::Reader> reader;
+
   HiveConnectorSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -102,6 +112,44 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
     return fmt::format("Hive: {} {} - {}", filePath, start, length);
   }
 
+  std::optional<int32_t> bucketNumber() const override {
+    return tableBucketNumber;
+  }
+
+  std::string storagePath() const override {
+    return filePath;
+  }
+
+  /// The file must have a known modification time. The file is assumed not
+  /// to change without its modification time changing.
+  std::optional<std::string> cacheKey() const override {
+    if (!properties.has_value() || !properties->modificationTime.has_value() ||
+        bucketConversion.has_value()) {
+      return std::nullopt;
+    }
+    auto key = fmt::format(
+        "{} {} {} {} {}",
+        filePath,
+        properties->modificationTime.value(),
+        start,
+        length,
+        tableBucketNumber.value_or(-1));
+    const std::map<std::string, std::optional<std::string>> sortedKeys(
+        partitionKeys.begin(), partitionKeys.end());
+    for (const auto& [name, value] : sortedKeys) {
+      key += fmt::format(" {}={}", name, value.value_or("\\N"));
+    }
+    for (const auto* entries : {&infoColumns, &serdeParameters}) {
+      key += " |";
+      const std::map<std::string, std::string> sortedEntries(
+          entries->begin(), entries->end());
+      for (const auto& [name, value] : sortedEntries) {
+        key += fmt::format(" {}={}", name, value);
+      }
+    }
+    return key;
+  }
+
   std::string getFileName() const {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
@@ -349,6 +349,48 @@ void processFieldSpec(
   }
 }
 
+// Returns 'subfield' with the map subscript after the column name replaced by
+// a nested field named by the key, if the column is a flat map read as a
+// struct of its keys.  The filter then goes to the reader of the key.
+std::optional<common::Subfield> toFlatMapKeySubfield(
+    const common::Subfield& subfield,
+    const RowTypePtr& rowType,
+    const RowTypePtr& dataColumns) {
+  const auto& path = subfield.path();
+  if (!dataColumns || path.size() < 2) {
+    return std::nullopt;
+  }
+  std::string key;
+  switch (path[1]->kind()) {
+    case common::kStringSubscript:
+      key = static_cast<const common::Subfield::StringSubscript*>(path[1].get())
+                ->index();
+      break;
+    case common::kLongSubscript:
+      key = std::to_string(
+          static_cast<const common::Subfield::LongSubscript*>(path[1].get())
+              ->index());
+      break;
+    default:
+      return std::nullopt;
+  }
+  const auto& name = getColumnName(subfield);
+  auto outputIdx = rowType->getChildIdxIfExists(name);
+  auto dataIdx = dataColumns->getChildIdxIfExists(name);
+  if (!outputIdx.has_value() || !dataIdx.has_value() ||
+      !rowType->childAt(*outputIdx)->isRow() ||
+      !dataColumns->childAt(*dataIdx)->isMap()) {
+    return std::nullopt;
+  }
+  std::vector<std::unique_ptr<common::Subfield::PathElement>> keyPath;
+  keyPath.push_back(path[0]->clone());
+  keyPath.push_back(std::make_unique<common::Subfield::NestedField>(key));
+  for (auto i = 2; i < path.size(); ++i) {
+    keyPath.push_back(path[i]->clone());
+  }
+  return common::Subfield(std::move(keyPath));
+}
+
 } // namespace
 
 std::shared_ptr<common::ScanSpec> makeScanSpec(
@@ -364,15 +406,28 @@ std::shared_ptr<common::ScanSpec> makeScanSpec(
     const std::shared_ptr<HiveColumnHandle>& rowIndexColumn,
     memory::MemoryPool* pool) {
   auto spec = std::make_shared<common::ScanSpec>("root");
+  std::vector<common::Subfield> flatMapKeySubfields;
+  flatMapKeySubfields.reserve(filters.size());
+  std::vector<std::pair<const common::Subfield*, const common::Filter*>>
+      subfieldFilters;
+  for (auto& [subfield, filter] : filters) {
+    if (auto keySubfield =
+            toFlatMapKeySubfield(subfield, rowType, dataColumns)) {
+      flatMapKeySubfields.push_back(std::move(*keySubfield));
+      subfieldFilters.emplace_back(&flatMapKeySubfields.back(), filter.get());
+    } else {
+      subfieldFilters.emplace_back(&subfield, filter.get());
+    }
+  }
   folly::F14FastMap<std::string, std::vector<const common::Subfield*>>
       filterSubfields;
   std::vector<SubfieldSpec> subfieldSpecs;
-  for (auto& [subfield, _] : filters) {
-    if (auto name = subfield.toString();
+  for (auto& [subfield, _] : subfieldFilters) {
+    if (auto name = subfield->toString();
         !isSynthesizedColumn(name, infoColumns) &&
         !isRowIndexColumn(name, rowIndexColumn) &&
         partitionKeys.count(name) == 0) {
-      filterSubfields[getColumnName(subfield)].push_back(&subfield);
+      filterSubfields[getColumnName(*subfield)].push_back(subfield);
     }
   }
 
@@ -423,8 +478,8 @@ std::shared_ptr<common::ScanSpec> makeScanSpec(
     }
   }
 
-  for (auto& pair : filters) {
-    const auto name = pair.first.toString();
+  for (auto& [subfield, filter] : subfieldFilters) {
+    const auto name = subfield->toString();
     // SelectiveColumnReader doesn't support constant columns with filters,
     // hence, we can't have a filter for a $path or $bucket column.
     //
@@ -437,8 +492,8 @@ std::shared_ptr<common::ScanSpec> makeScanSpec(
       continue;
     }
     VELOX_CHECK(!isRowIndexColumn(name, rowIndexColumn));
-    auto fieldSpec = spec->getOrCreateChild(pair.first);
-    fieldSpec->addFilter(*pair.second);
+    auto fieldSpec = spec->getOrCreateChild(*subfield);
+    fieldSpec->addFilter(*filter);
   }
 
   return spec;
@@ -533,6 +588,7 @@ void configureReaderOptions(
   readerOptions.setLoadQuantum(hiveConfig->loadQuantum());
   readerOptions.setMaxCoalesceBytes(hiveConfig->maxCoalescedBytes());
   readerOptions.setMaxCoalesceDistance(hiveConfig->maxCoalescedDistanceBytes());
+  readerOptions.setAdaptiveCoalescing(hiveConfig->adaptiveCoalescing());
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   readerOptions.setUseColumnNamesForColumnMapping(
@@ -541,6 +597,7 @@ void configureReaderOptions(
   readerOptions.setFooterEstimatedSize(hiveConfig->footerEstimatedSize());
   readerOptions.setFilePreloadThreshold(hiveConfig->filePreloadThreshold());
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
+  readerOptions.setUnitPrefetchBytes(hiveConfig->unitPrefetchBytes());
   readerOptions.setNoCacheRetention(
       hiveConfig->cacheNoRetention(sessionProperties));
   const auto& sessionTzName = connectorQueryCtx->sessionTimezone();
@@ -681,20 +738,113 @@ bool testFilters(
   return true;
 }
 
+bool testUnitFilters(
+    const common::ScanSpec* scanSpec,
+    common::MetadataFilter* metadataFilter,
+    const dwio::common::Reader* reader,
+    uint64_t start,
+    uint64_t length,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey) {
+  const auto& rowType = reader->rowType();
+  std::vector<std::string> columns;
+  std::vector<const common::ScanSpec*> columnSpecs;
+  for (const auto& child : scanSpec->children()) {
+    const auto& name = child->fieldName();
+    if ((child->filter() || child->numMetadataFilters() > 0) &&
+        rowType->containsChild(name) && !partitionKey.count(name)) {
+      columns.push_back(name);
+      columnSpecs.push_back(child.get());
+    }
+  }
+  const auto units = reader->unitStatistics(start, length, columns);
+  if (!units.has_value()) {
+    return true;
+  }
+  if (units->empty()) {
+    // No stripe or row group starts in the range.
+    return false;
+  }
+
+  // Set bits are the units that have no rows passing the filters.
+  const auto numUnits = units->size();
+  const auto numWords = bits::nwords(numUnits);
+  std::vector<uint64_t> excluded(numWords);
+  std::vector<std::pair<
+      const common::MetadataFilter::LeafNode*,
+      std::vector<uint64_t>>>
+      metadataFilterResults;
+  for (const auto* spec : columnSpecs) {
+    for (auto i = 0; i < spec->numMetadataFilters(); ++i) {
+      metadataFilterResults.emplace_back(
+          spec->metadataFilterNodeAt(i), std::vector<uint64_t>(numWords));
+    }
+  }
+  for (auto unit = 0; unit < numUnits; ++unit) {
+    const auto& unitStats = (*units)[unit];
+    if (unitStats.numRows == 0) {
+      bits::setBit(excluded.data(), unit);
+      continue;
+    }
+    auto metadataFilterIndex = 0;
+    for (auto i = 0; i < columns.size(); ++i) {
+      const auto* spec = columnSpecs[i];
+      auto* stats = unitStats.columns[i].get();
+      if (stats == nullptr) {
+        metadataFilterIndex += spec->numMetadataFilters();
+        continue;
+      }
+      const auto& type = rowType->findChild(columns[i]);
+      if (spec->filter() &&
+          !testFilter(spec->filter(), stats, unitStats.numRows, type)) {
+        bits::setBit(excluded.data(), unit);
+      }
+      for (auto j = 0; j < spec->numMetadataFilters(); ++j) {
+        if (!testFilter(
+                spec->metadataFilterAt(j), stats, unitStats.numRows, type)) {
+          bits::setBit(
+              metadataFilterResults[metadataFilterIndex].second.data(), unit);
+        }
+        ++metadataFilterIndex;
+      }
+    }
+  }
+  if (metadataFilter != nullptr && !metadataFilterResults.empty()) {
+    metadataFilter->eval(metadataFilterResults, excluded);
+  }
+  return !bits::isAllSet(excluded.data(), 0, numUnits);
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
     folly::Executor* executor) {
-  if (connectorQueryCtx->cache()) {
+  return createBufferedInput(
+      fileHandle,
+      readerOpts,
+      connectorQueryCtx->cache(),
+      Connector::getTracker(
+          connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+      std::move(ioStats),
+      executor);
+}
+
+std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
+    const FileHandle& fileHandle,
+    const dwio::common::ReaderOptions& readerOpts,
+    cache::AsyncDataCache* cache,
+    std::shared_ptr<cache::ScanTracker> tracker,
+    std::shared_ptr<io::IoStatistics> ioStats,
+    folly::Executor* executor) {
+  if (cache) {
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid.id(),
-        connectorQueryCtx->cache(),
-        Connector::getTracker(
-            connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+        cache,
+        std::move(tracker),
         fileHandle.groupId.id(),
         ioStats,
         executor,
@@ -704,8 +854,7 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
       fileHandle.file,
       dwio::common::MetricsLog::voidLog(),
       fileHandle.uuid.id(),
-      Connector::getTracker(
-          connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+      std::move(tracker),
       fileHandle.groupId.id(),
       std::move(ioStats),
       executor,
@@ -92,6 +92,20 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Returns false if, according to their statistics, no stripe or row group
+/// that a split of [start, start + length) of 'reader' reads may have rows
+/// passing the filters of 'scanSpec' and 'metadataFilter'. Only the filters on
+/// top level file columns that are not partition keys are tested. Returns true
+/// if 'reader' does not know the statistics of its stripes or row groups.
+bool testUnitFilters(
+    const common::ScanSpec* scanSpec,
+    common::MetadataFilter* metadataFilter,
+    const dwio::common::Reader* reader,
+    uint64_t start,
+    uint64_t length,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -99,6 +113,16 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     std::shared_ptr<io::IoStatistics> ioStats,
     folly::Executor* executor);
 
+/// Same as above for use without a ConnectorQueryCtx. Reads through 'cache' if
+/// it is not null.
+std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
+    const FileHandle& fileHandle,
+    const dwio::common::ReaderOptions& readerOpts,
+    cache::AsyncDataCache* cache,
+    std::shared_ptr<cache::ScanTracker> tracker,
+    std::shared_ptr<io::IoStatistics> ioStats,
+    folly::Executor* executor);
+
 core::TypedExprPtr extractFiltersFromRemainingFilter(
     const core::TypedExprPtr& expr,
     core::ExpressionEvaluator* evaluator,
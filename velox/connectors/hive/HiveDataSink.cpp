@@ -357,7 +357,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* writeExecutor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -390,7 +391,8 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->spillConfig()) {
+      spillConfig_(connectorQueryCtx->spillConfig()),
+      writeExecutor_(writeExecutor) {
   if (isBucketed()) {
     VELOX_USER_CHECK_LT(
         bucketCount_, maxBucketCount(), "bucketCount exceeds the limit");
@@ -401,11 +403,9 @@ HiveDataSink::HiveDataSink(
       "Unsupported commit strategy: {}",
       commitStrategyToString(commitStrategy_));
 
-  if (!isBucketed()) {
-    return;
-  }
-  const auto& sortedProperty = insertTableHandle_->bucketProperty()->sortedBy();
-  if (!sortedProperty.empty()) {
+  if (isBucketed()) {
+    const auto& sortedProperty =
+        insertTableHandle_->bucketProperty()->sortedBy();
     sortColumnIndices_.reserve(sortedProperty.size());
     sortCompareFlags_.reserve(sortedProperty.size());
     for (int i = 0; i < sortedProperty.size(); ++i) {
@@ -422,6 +422,12 @@ HiveDataSink::HiveDataSink(
       }
     }
   }
+
+  if ((isPartitioned() || isBucketed()) &&
+      hiveConfig_->partitionSortedWrite(
+          connectorQueryCtx_->sessionProperties())) {
+    createPartitionSortBuffer();
+  }
 }
 
 bool HiveDataSink::canReclaim() const {
@@ -449,6 +455,11 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     input->childAt(i)->loadedVector();
   }
 
+  if (partitionSortBuffer_ != nullptr) {
+    addToPartitionSortBuffer(input);
+    return;
+  }
+
   // All inputs belong to a single non-bucketed partition. The partition id
   // must be zero.
   if (!isBucketed() && partitionIdGenerator_->numPartitions() == 1) {
@@ -480,6 +491,142 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
   writerInfo_[index]->numWrittenRows += dataInput->size();
 }
 
+void HiveDataSink::createPartitionSortBuffer() {
+  // The buffered rows are the partition id, the bucket id and the input
+  // columns.
+  std::vector<std::string> names{"$partition_id", "$bucket_id"};
+  std::vector<TypePtr> types{BIGINT(), INTEGER()};
+  for (auto i = 0; i < inputType_->size(); ++i) {
+    names.push_back(inputType_->nameOf(i));
+    types.push_back(inputType_->childAt(i));
+  }
+  constexpr column_index_t kNumIdColumns = 2;
+  const CompareFlags idCompareFlags{
+      true, true, false, CompareFlags::NullHandlingMode::kNullAsValue};
+  std::vector<column_index_t> sortColumnIndices{0, 1};
+  std::vector<CompareFlags> sortCompareFlags{idCompareFlags, idCompareFlags};
+  // Sorts the rows of a bucket here so that the bucket writers do not have to.
+  for (auto i = 0; i < sortColumnIndices_.size(); ++i) {
+    sortColumnIndices.push_back(
+        kNumIdColumns + dataChannels_[sortColumnIndices_[i]]);
+    sortCompareFlags.push_back(sortCompareFlags_[i]);
+  }
+
+  auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  partitionSortPool_ = connectorPool->addLeafChild(
+      fmt::format("{}.partitionSort", connectorPool->name()));
+  if (connectorPool->reclaimer() != nullptr) {
+    partitionSortPool_->setReclaimer(PartitionSortReclaimer::create(this));
+  }
+  partitionSortType_ = ROW(std::move(names), std::move(types));
+  partitionSortBuffer_ = std::make_unique<exec::SortBuffer>(
+      partitionSortType_,
+      sortColumnIndices,
+      sortCompareFlags,
+      partitionSortPool_.get(),
+      &nonReclaimableSection_,
+      spillConfig_ != nullptr && spillConfig_->prefixSortConfig.has_value()
+          ? spillConfig_->prefixSortConfig.value()
+          : common::PrefixSortConfig(),
+      spillConfig_,
+      &partitionSortSpillStats_);
+}
+
+void HiveDataSink::addToPartitionSortBuffer(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  auto* pool = connectorQueryCtx_->memoryPool();
+  auto partitionIds =
+      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numRows, pool);
+  auto bucketIds =
+      BaseVector::create<FlatVector<int32_t>>(INTEGER(), numRows, pool);
+  auto* rawPartitionIds = partitionIds->mutableRawValues();
+  auto* rawBucketIds = bucketIds->mutableRawValues();
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    rawPartitionIds[row] = isPartitioned() ? partitionIds_[row] : 0;
+    rawBucketIds[row] = isBucketed() ? bucketIds_[row] : 0;
+  }
+
+  std::vector<VectorPtr> children{
+      std::move(partitionIds), std::move(bucketIds)};
+  children.insert(
+      children.end(), input->children().begin(), input->children().end());
+  memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+  partitionSortBuffer_->addInput(std::make_shared<RowVector>(
+      pool, partitionSortType_, nullptr, numRows, std::move(children)));
+}
+
+void HiveDataSink::writeSortedPartitions() {
+  memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+  partitionSortBuffer_->noMoreInput();
+
+  const auto* session = connectorQueryCtx_->sessionProperties();
+  uint32_t maxOutputRows = hiveConfig_->sortWriterMaxOutputRows(session);
+  const auto rowSize = partitionSortBuffer_->estimateOutputRowSize();
+  if (rowSize.has_value() && rowSize.value() != 0) {
+    maxOutputRows = std::max<uint64_t>(
+        1,
+        std::min<uint64_t>(
+            maxOutputRows,
+            hiveConfig_->sortWriterMaxOutputBytes(session) / rowSize.value()));
+  }
+
+  std::optional<HiveWriterId> currentId;
+  for (;;) {
+    partitionSortBuffer_->ensureOutputFits(maxOutputRows);
+    const auto output = partitionSortBuffer_->getOutput(maxOutputRows);
+    if (output == nullptr) {
+      break;
+    }
+    const auto numRows = output->size();
+    const auto* partitionIds =
+        output->childAt(0)->asFlatVector<int64_t>()->rawValues();
+    const auto* bucketIds =
+        output->childAt(1)->asFlatVector<int32_t>()->rawValues();
+    const auto data = std::make_shared<RowVector>(
+        output->pool(),
+        inputType_,
+        nullptr,
+        numRows,
+        std::vector<VectorPtr>(
+            output->children().begin() + 2, output->children().end()));
+
+    vector_size_t start = 0;
+    while (start < numRows) {
+      vector_size_t end = start + 1;
+      while (end < numRows && partitionIds[end] == partitionIds[start] &&
+             bucketIds[end] == bucketIds[start]) {
+        ++end;
+      }
+      std::optional<uint32_t> partitionId;
+      if (isPartitioned()) {
+        partitionId = partitionIds[start];
+      }
+      std::optional<uint32_t> bucketId;
+      if (isBucketed()) {
+        bucketId = bucketIds[start];
+      }
+      const HiveWriterId id{partitionId, bucketId};
+      if (currentId.has_value() && !(currentId.value() == id)) {
+        // The rows of the previous partition and bucket are all written.
+        const auto index = writerIndexMap_.at(currentId.value());
+        WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+        writers_[index]->close();
+        ++numClosedWriters_;
+      }
+      currentId = id;
+      write(
+          ensureWriter(id),
+          start == 0 && end == numRows
+              ? data
+              : std::static_pointer_cast<RowVector>(
+                    data->slice(start, end - start)));
+      start = end;
+    }
+  }
+  partitionSortBuffer_.reset();
+  partitionSortPool_->release();
+}
+
 std::string HiveDataSink::stateString(State state) {
   switch (state) {
     case State::kRunning:
@@ -529,6 +676,10 @@ DataSink::Stats HiveDataSink::stats() const {
       stats.spillStats += *spillStats;
     }
   }
+  const auto partitionSortSpillStats = partitionSortSpillStats_.rlock();
+  if (!partitionSortSpillStats->empty()) {
+    stats.spillStats += *partitionSortSpillStats;
+  }
   return stats;
 }
 
@@ -578,6 +729,9 @@ void HiveDataSink::checkStateTransition(State oldState, State newState) {
 
 std::vector<std::string> HiveDataSink::close() {
   checkRunning();
+  if (partitionSortBuffer_ != nullptr) {
+    writeSortedPartitions();
+  }
   state_ = State::kClosed;
   closeInternal();
 
@@ -624,13 +778,18 @@ void HiveDataSink::closeInternal() {
   TestValue::adjust(
       "facebook::velox::connector::hive::HiveDataSink::closeInternal", this);
 
+  if (partitionSortBuffer_ != nullptr) {
+    partitionSortBuffer_.reset();
+    partitionSortPool_->release();
+  }
+
   if (state_ == State::kClosed) {
-    for (int i = 0; i < writers_.size(); ++i) {
+    for (int i = numClosedWriters_; i < writers_.size(); ++i) {
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
   } else {
-    for (int i = 0; i < writers_.size(); ++i) {
+    for (int i = numClosedWriters_; i < writers_.size(); ++i) {
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
@@ -695,6 +854,8 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       hiveConfig_->orcWriterMaxDictionaryMemory(connectorSessionProperties));
   options.parquetWriteTimestampUnit =
       hiveConfig_->parquetWriteTimestampUnit(connectorSessionProperties);
+  options.parquetAdaptiveEncoding =
+      hiveConfig_->parquetWriteAdaptiveEncoding(connectorSessionProperties);
   options.orcMinCompressionSize = std::optional(
       hiveConfig_->orcWriterMinCompressionSize(connectorSessionProperties));
   options.orcLinearStripeSizeHeuristics =
@@ -710,19 +871,27 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       compressionLevel.value_or(kDefaultZlibCompressionLevel);
   options.zstdCompressionLevel =
       compressionLevel.value_or(kDefaultZstdCompressionLevel);
+  options.encodingExecutor = writeExecutor_;
+  options.encodingParallelismFactor =
+      hiveConfig_->fileWriteEncodingParallelism();
 
   // Prevents the memory allocation during the writer creation.
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(writerInfo_.size() - 1);
-  auto writer = writerFactory_->createWriter(
-      dwio::common::FileSink::create(
-          writePath,
-          {.bufferWrite = false,
-           .connectorProperties = hiveConfig_->config(),
-           .fileCreateConfig = hiveConfig_->writeFileCreateConfig(),
-           .pool = writerInfo_.back()->sinkPool.get(),
-           .metricLogger = dwio::common::MetricsLog::voidLog(),
-           .stats = ioStats_.back().get()}),
-      options);
+  auto sink = dwio::common::FileSink::create(
+      writePath,
+      {.bufferWrite = false,
+       .connectorProperties = hiveConfig_->config(),
+       .fileCreateConfig = hiveConfig_->writeFileCreateConfig(),
+       .pool = writerInfo_.back()->sinkPool.get(),
+       .metricLogger = dwio::common::MetricsLog::voidLog(),
+       .stats = ioStats_.back().get()});
+  if (writeExecutor_ != nullptr && hiveConfig_->fileWriteAsync()) {
+    sink = std::make_unique<dwio::common::AsyncFileSink>(
+        std::move(sink),
+        writeExecutor_,
+        hiveConfig_->fileWriteMaxInFlightBytes());
+  }
+  auto writer = writerFactory_->createWriter(std::move(sink), options);
   writer = maybeCreateBucketSortWriter(std::move(writer));
   writers_.emplace_back(std::move(writer));
   // Extends the buffer used for partition rows calculations.
@@ -748,6 +917,9 @@ HiveDataSink::maybeCreateBucketSortWriter(
       sortCompareFlags_,
       sortPool,
       writerInfo_.back()->nonReclaimableSectionHolder.get(),
+      spillConfig_ != nullptr && spillConfig_->prefixSortConfig.has_value()
+          ? spillConfig_->prefixSortConfig.value()
+          : common::PrefixSortConfig(),
       spillConfig_,
       writerInfo_.back()->spillStats.get());
   return std::make_unique<dwio::common::SortingWriter>(
@@ -1035,4 +1207,55 @@ uint64_t HiveDataSink::WriterReclaimer::reclaim(
   }
   return reclaimedBytes;
 }
+
+std::unique_ptr<memory::MemoryReclaimer>
+HiveDataSink::PartitionSortReclaimer::create(HiveDataSink* dataSink) {
+  return std::unique_ptr<memory::MemoryReclaimer>(
+      new HiveDataSink::PartitionSortReclaimer(dataSink));
+}
+
+bool HiveDataSink::PartitionSortReclaimer::reclaimableBytes(
+    const memory::MemoryPool& pool,
+    uint64_t& reclaimableBytes) const {
+  VELOX_CHECK_EQ(pool.name(), dataSink_->partitionSortPool_->name());
+  reclaimableBytes = 0;
+  if (dataSink_->partitionSortBuffer_ == nullptr ||
+      !dataSink_->partitionSortBuffer_->canSpill()) {
+    return false;
+  }
+  reclaimableBytes = pool.usedBytes();
+  return true;
+}
+
+uint64_t HiveDataSink::PartitionSortReclaimer::reclaim(
+    memory::MemoryPool* pool,
+    uint64_t /*targetBytes*/,
+    uint64_t /*maxWaitMs*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK_EQ(pool->name(), dataSink_->partitionSortPool_->name());
+  auto* sortBuffer = dataSink_->partitionSortBuffer_.get();
+  if (sortBuffer == nullptr || !sortBuffer->canSpill()) {
+    return 0;
+  }
+  if (dataSink_->nonReclaimableSection_) {
+    RECORD_METRIC_VALUE(kMetricMemoryNonReclaimableCount);
+    LOG(WARNING) << "Can't reclaim from hive partition sort pool "
+                 << pool->name() << " which is under non-reclaimable section, "
+                 << " reserved memory: "
+                 << succinctBytes(pool->reservedBytes());
+    ++stats.numNonReclaimableAttempts;
+    return 0;
+  }
+  return memory::MemoryReclaimer::run(
+      [&]() {
+        int64_t reclaimedBytes{0};
+        {
+          memory::ScopedReclaimedBytesRecorder recorder(pool, &reclaimedBytes);
+          sortBuffer->spill();
+          pool->release();
+        }
+        return reclaimedBytes;
+      },
+      stats);
+}
 } // namespace facebook::velox::connector::hive
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/SortBuffer.h"
 
 namespace facebook::velox::dwrf {
 class Writer;
@@ -419,7 +420,8 @@ class HiveDataSink : public DataSink {
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* writeExecutor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -483,8 +485,36 @@ class HiveDataSink : public DataSink {
     io::IoStatistics* const ioStats_;
   };
 
+  // Spills the input buffered by partition when 'partition-sorted-write' is
+  // set.
+  class PartitionSortReclaimer : public exec::MemoryReclaimer {
+   public:
+    static std::unique_ptr<memory::MemoryReclaimer> create(
+        HiveDataSink* dataSink);
+
+    bool reclaimableBytes(
+        const memory::MemoryPool& pool,
+        uint64_t& reclaimableBytes) const override;
+
+    uint64_t reclaim(
+        memory::MemoryPool* pool,
+        uint64_t targetBytes,
+        uint64_t maxWaitMs,
+        memory::MemoryReclaimer::Stats& stats) override;
+
+   private:
+    explicit PartitionSortReclaimer(HiveDataSink* dataSink)
+        : exec::MemoryReclaimer(), dataSink_(dataSink) {
+      VELOX_CHECK_NOT_NULL(dataSink_);
+    }
+
+    HiveDataSink* const dataSink_;
+  };
+
+  // Returns true if each writer sorts its rows. Partition sorted writes sort
+  // the rows of all the buckets before writing them.
   FOLLY_ALWAYS_INLINE bool sortWrite() const {
-    return !sortColumnIndices_.empty();
+    return !sortColumnIndices_.empty() && partitionSortPool_ == nullptr;
   }
 
   // Returns true if the table is partitioned.
@@ -556,6 +586,18 @@ class HiveDataSink : public DataSink {
   // Invoked to write 'input' to the specified file writer.
   void write(size_t index, RowVectorPtr input);
 
+  // Creates 'partitionSortBuffer_', which sorts the input by partition id,
+  // bucket id and the sorting columns of the bucket property.
+  void createPartitionSortBuffer();
+
+  // Adds 'input' with the partition and bucket ids computed for it to
+  // 'partitionSortBuffer_'.
+  void addToPartitionSortBuffer(const RowVectorPtr& input);
+
+  // Writes the rows of 'partitionSortBuffer_' one partition and bucket at a
+  // time. The writer of a partition is closed before the next one is opened.
+  void writeSortedPartitions();
+
   void closeInternal();
 
   const RowTypePtr inputType_;
@@ -573,6 +615,10 @@ class HiveDataSink : public DataSink {
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
+  // If set, the files are written on this executor through an AsyncFileSink
+  // if 'file-write-async' is set, and their columns are encoded on it if
+  // 'file-write-encoding-parallelism' is set.
+  folly::Executor* const writeExecutor_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
@@ -581,6 +627,18 @@ class HiveDataSink : public DataSink {
 
   tsan_atomic<bool> nonReclaimableSection_{false};
 
+  // Set if 'partition-sorted-write' is enabled for a partitioned or bucketed
+  // table. Holds the input rows prefixed with their partition and bucket ids
+  // until close().
+  RowTypePtr partitionSortType_;
+  std::shared_ptr<memory::MemoryPool> partitionSortPool_;
+  folly::Synchronized<common::SpillStats> partitionSortSpillStats_;
+  std::unique_ptr<exec::SortBuffer> partitionSortBuffer_;
+
+  // Number of writers at the start of 'writers_' that are already closed. Only
+  // partition sorted writes close writers before close().
+  uint32_t numClosedWriters_{0};
+
   // The map from writer id to the writer index in 'writers_' and 'writerInfo_'.
   folly::F14FastMap<HiveWriterId, uint32_t, HiveWriterIdHasher, HiveWriterIdEq>
       writerIndexMap_;
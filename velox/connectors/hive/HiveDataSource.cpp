@@ -22,6 +22,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/FieldReference.h"
 
@@ -165,6 +166,8 @@ HiveDataSource::HiveDataSource(
       infoColumns_,
       rowIndexColumn_,
       pool_);
+  scanSpec_->setSharedSelectivity(
+      Connector::getSharedSelectivity(connectorQueryCtx_->scanId()));
   if (remainingFilter) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
@@ -230,6 +233,8 @@ std::unique_ptr<HivePartitionFunction> HiveDataSource::setupBucketConversion() {
         infoColumns_,
         rowIndexColumn_,
         pool_);
+    newScanSpec->setSharedSelectivity(
+        Connector::getSharedSelectivity(connectorQueryCtx_->scanId()));
     newScanSpec->moveAdaptationFrom(*scanSpec_);
     scanSpec_ = std::move(newScanSpec);
   }
@@ -237,6 +242,68 @@ std::unique_ptr<HivePartitionFunction> HiveDataSource::setupBucketConversion() {
       split_->bucketConversion->tableBucketCount, std::move(bucketChannels));
 }
 
+std::function<void()> HiveDataSource::prefetchSplitFile(
+    const std::shared_ptr<ConnectorSplit>& split) {
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  if (hiveSplit == nullptr) {
+    return nullptr;
+  }
+  auto readerOpts = std::make_shared<dwio::common::ReaderOptions>(pool_);
+  configureReaderOptions(
+      *readerOpts,
+      hiveConfig_,
+      connectorQueryCtx_,
+      hiveTableHandle_,
+      hiveSplit);
+  if (dwio::common::FileMetadataCache::getInstance() != nullptr &&
+      hiveSplit->properties.has_value() &&
+      hiveSplit->properties->modificationTime.has_value()) {
+    readerOpts->setFileMetadataCacheKey(
+        dwio::common::FileMetadataCache::makeKey(
+            hiveSplit->filePath,
+            *hiveSplit->properties->modificationTime,
+            hiveSplit->properties->fileSize.value_or(0)));
+    readerOpts->setIoStatistics(ioStats_);
+  }
+  auto* cache = connectorQueryCtx_->cache();
+  const bool readTail =
+      cache != nullptr || !readerOpts->fileMetadataCacheKey().empty();
+  if (fileHandleFactory_->maxSize() == 0 && !readTail) {
+    // Neither the file handle nor the tail would be kept for the split.
+    return nullptr;
+  }
+  auto tracker = Connector::getTracker(
+      connectorQueryCtx_->scanId(), readerOpts->loadQuantum());
+  return [fileHandleFactory = fileHandleFactory_,
+          hiveSplit = std::move(hiveSplit),
+          readerOpts = std::move(readerOpts),
+          readTail,
+          cache,
+          tracker = std::move(tracker),
+          ioStats = ioStats_,
+          executor = executor_]() {
+    try {
+      auto fileHandle = fileHandleFactory->generate(
+          hiveSplit->filePath,
+          hiveSplit->properties.has_value() ? &*hiveSplit->properties
+                                            : nullptr);
+      if (!readTail) {
+        return;
+      }
+      // Creating the reader reads and parses the file tail into the caches.
+      dwio::common::getReaderFactory(readerOpts->fileFormat())
+          ->createReader(
+              createBufferedInput(
+                  *fileHandle, *readerOpts, cache, tracker, ioStats, executor),
+              *readerOpts);
+    } catch (const std::exception& e) {
+      // The split reader gets the error again if it persists.
+      VLOG(1) << "Failed to prefetch " << hiveSplit->filePath << ": "
+              << e.what();
+    }
+  };
+}
+
 void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK_NULL(
       split_,
@@ -303,7 +370,7 @@ vector_size_t HiveDataSource::applyBucketConversion(
 
 std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
-    velox::ContinueFuture& /*future*/) {
+    velox::ContinueFuture& future) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
@@ -315,6 +382,12 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     return nullptr;
   }
 
+  if (connectorQueryCtx_->asyncIo() &&
+      splitReader_->isNextReadBlocked(future)) {
+    ++numAsyncIoWaits_;
+    return std::nullopt;
+  }
+
   if (!output_) {
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
@@ -339,7 +412,20 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     // wrapping the results.
     BufferPtr remainingIndices;
     if (remainingFilterExprSet_) {
-      if (numBucketConversion_ > 0) {
+      const auto& coalesceDistance = ioStats_->adaptiveCoalesceDistance();
+  if (coalesceDistance.count() > 0) {
+    const auto& coalesceBytes = ioStats_->adaptiveCoalesceBytes();
+    res.insert(
+        {{"adaptiveCoalesceDistance",
+          RuntimeCounter(
+              coalesceDistance.sum() / coalesceDistance.count(),
+              RuntimeCounter::Unit::kBytes)},
+         {"adaptiveMaxCoalescedBytes",
+          RuntimeCounter(
+              coalesceBytes.sum() / coalesceBytes.count(),
+              RuntimeCounter::Unit::kBytes)}});
+  }
+  if (numBucketConversion_ > 0) {
         filterRows_.resizeFill(rowVector->size());
       } else {
         filterRows_.resize(rowVector->size());
@@ -416,6 +502,10 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"localReadBytes",
         RuntimeCounter(
             ioStats_->ssdRead().sum(), RuntimeCounter::Unit::kBytes)},
+       {"numPeerRead", RuntimeCounter(ioStats_->peerRead().count())},
+       {"peerReadBytes",
+        RuntimeCounter(
+            ioStats_->peerRead().sum(), RuntimeCounter::Unit::kBytes)},
        {"numRamRead", RuntimeCounter(ioStats_->ramHit().count())},
        {"ramReadBytes",
         RuntimeCounter(ioStats_->ramHit().sum(), RuntimeCounter::Unit::kBytes)},
@@ -437,9 +527,28 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"overreadBytes",
         RuntimeCounter(
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)}});
+  const auto& metadataCacheHit = ioStats_->metadataCacheHit();
+  const auto& metadataCacheMiss = ioStats_->metadataCacheMiss();
+  if (metadataCacheHit.count() + metadataCacheMiss.count() > 0) {
+    res.insert(
+        {{"numMetadataCacheHit", RuntimeCounter(metadataCacheHit.count())},
+         {"metadataCacheHitBytes",
+          RuntimeCounter(metadataCacheHit.sum(), RuntimeCounter::Unit::kBytes)},
+         {"numMetadataCacheMiss",
+          RuntimeCounter(metadataCacheMiss.count())}});
+  }
+  const auto& hedgedReads = ioStats_->hedgedReads();
+  if (hedgedReads.count() > 0) {
+    res.insert(
+        {{"numHedgedReads", RuntimeCounter(hedgedReads.count())},
+         {"numHedgeWins", RuntimeCounter(ioStats_->hedgeWins().count())}});
+  }
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeCounter(numBucketConversion_)});
   }
+  if (numAsyncIoWaits_ > 0) {
+    res.insert({"numAsyncIoWaits", RuntimeCounter(numAsyncIoWaits_)});
+  }
   return res;
 }
 
@@ -461,6 +570,7 @@ void HiveDataSource::setFromDataSource(
   source->ioStats_->merge(*ioStats_);
   ioStats_ = std::move(source->ioStats_);
   numBucketConversion_ += source->numBucketConversion_;
+  numAsyncIoWaits_ += source->numAsyncIoWaits_;
   partitionFunction_ = std::move(source->partitionFunction_);
 }
 
@@ -471,6 +581,13 @@ int64_t HiveDataSource::estimatedRowSize() {
   return splitReader_->estimatedRowSize();
 }
 
+std::shared_ptr<StealableSplit> HiveDataSource::stealableSplit() {
+  if (split_ == nullptr || !splitReader_) {
+    return nullptr;
+  }
+  return splitReader_->stealableSplit();
+}
+
 vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   for (auto fieldIndex : multiReferencedFields_) {
     LazyVector::ensureLoadedRows(
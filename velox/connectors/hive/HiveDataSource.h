@@ -72,8 +72,17 @@ class HiveDataSource : public DataSource {
 
   void setFromDataSource(std::unique_ptr<DataSource> sourceUnique) override;
 
+  /// Opens the file of 'split' into the file handle cache and, if the file
+  /// tail can be cached, reads it by creating a reader that is then dropped.
+  std::function<void()> prefetchSplitFile(
+      const std::shared_ptr<ConnectorSplit>& split) override;
+
   int64_t estimatedRowSize() override;
 
+  /// Returns the stripes of the current split that have not been started.
+  /// Supported for DWRF and ORC files.
+  std::shared_ptr<StealableSplit> stealableSplit() override;
+
   std::shared_ptr<wave::WaveDataSource> toWaveDataSource() override;
 
   using WaveDelegateHookFunction =
@@ -173,6 +182,10 @@ class HiveDataSource : public DataSource {
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
   int64_t numBucketConversion_ = 0;
+
+  // Number of calls to next() that returned a future instead of waiting for
+  // IO running in the background.
+  int64_t numAsyncIoWaits_ = 0;
   std::unique_ptr<HivePartitionFunction> partitionFunction_;
   std::vector<uint32_t> partitions_;
 
@@ -33,10 +33,23 @@ __attribute__((no_sanitize("integer")))
 #endif
 uint32_t
 hashBytes(StringView bytes, int32_t initialValue) {
+  constexpr uint32_t k31Pow2 = 31 * 31;
+  constexpr uint32_t k31Pow3 = 31 * 31 * 31;
+  constexpr uint32_t k31Pow4 = 31 * 31 * 31 * 31;
   uint32_t hash = initialValue;
-  auto* data = bytes.data();
-  for (auto i = 0; i < bytes.size(); ++i) {
-    hash = hash * 31 + *reinterpret_cast<const int8_t*>(data + i);
+  const auto* data = reinterpret_cast<const int8_t*>(bytes.data());
+  const int32_t size = bytes.size();
+  int32_t i = 0;
+  // Folds 4 bytes per step. This is the same as 4 steps of hash * 31 + byte
+  // modulo 2^32 but the products do not depend on each other.
+  for (; i + 4 <= size; i += 4) {
+    hash = hash * k31Pow4 + static_cast<uint32_t>(data[i]) * k31Pow3 +
+        static_cast<uint32_t>(data[i + 1]) * k31Pow2 +
+        static_cast<uint32_t>(data[i + 2]) * 31 +
+        static_cast<uint32_t>(data[i + 3]);
+  }
+  for (; i < size; ++i) {
+    hash = hash * 31 + data[i];
   }
   return hash;
 }
@@ -108,12 +121,62 @@ inline uint32_t hashOne<TypeKind::UNKNOWN>(UnknownValue /*value*/) {
   VELOX_FAIL("Unknown values cannot be non-NULL");
 }
 
+void hashPrecomputed(
+    uint32_t precomputedHash,
+    vector_size_t numRows,
+    bool mix,
+    std::vector<uint32_t>& hashes) {
+  for (auto i = 0; i < numRows; ++i) {
+    hashes[i] = mix ? hashes[i] * 31 + precomputedHash : precomputedHash;
+  }
+}
+
+// Hashes 'numRows' values with no nulls. The loop has no branches or
+// indirections per row so that the compiler can vectorize it for fixed
+// width types.
+template <TypeKind kind, bool mix>
+void hashFlatNoNulls(
+    const typename TypeTraits<kind>::NativeType* rawValues,
+    vector_size_t numRows,
+    uint32_t* hashes) {
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    const uint32_t hash = hashOne<kind>(rawValues[i]);
+    hashes[i] = mix ? hashes[i] * 31 + hash : hash;
+  }
+}
+
 template <TypeKind kind>
 void hashPrimitive(
     const DecodedVector& values,
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if (values.isConstantMapping()) {
+    const uint32_t hash =
+        values.isNullAt(0) ? 0 : hashOne<kind>(values.valueAt<T>(0));
+    if (rows.isAllSelected()) {
+      hashPrecomputed(hash, rows.size(), mix, hashes);
+    } else {
+      rows.applyToSelected(
+          [&](auto row) INLINE_LAMBDA { mergeHash(mix, hash, hashes[row]); });
+    }
+    return;
+  }
+  if constexpr (kind != TypeKind::BOOLEAN && kind != TypeKind::UNKNOWN) {
+    // Flat BOOLEAN values are bits, not an array of bool.
+    if (rows.isAllSelected() && values.isIdentityMapping() &&
+        !values.mayHaveNulls()) {
+      if (mix) {
+        hashFlatNoNulls<kind, true>(
+            values.data<T>(), rows.size(), hashes.data());
+      } else {
+        hashFlatNoNulls<kind, false>(
+            values.data<T>(), rows.size(), hashes.data());
+      }
+      return;
+    }
+  }
   if (rows.isAllSelected()) {
     // The compiler seems to be a little fickle with optimizations.
     // Although rows.applyToSelected should do roughly the same thing, doing
@@ -138,16 +201,6 @@ void hashPrimitive(
     });
   }
 }
-
-void hashPrecomputed(
-    uint32_t precomputedHash,
-    vector_size_t numRows,
-    bool mix,
-    std::vector<uint32_t>& hashes) {
-  for (auto i = 0; i < numRows; ++i) {
-    hashes[i] = mix ? hashes[i] * 31 + precomputedHash : precomputedHash;
-  }
-}
 } // namespace
 
 template <>
@@ -77,25 +77,43 @@ void PartitionIdGenerator::run(
   // TODO Optimize common use case where all records belong to the same
   // partition. VectorHashers keep track of the number of unique values, hence,
   // we can find out if there is only one unique value for each partition key.
+  if (!densePartitionIds_.empty()) {
+    for (auto i = 0; i < numRows; ++i) {
+      const auto partitionId = densePartitionIds_[result[i]];
+      result[i] = partitionId != kNoPartitionId
+          ? partitionId
+          : addPartition(result[i], input, i);
+    }
+    return;
+  }
   for (auto i = 0; i < numRows; ++i) {
     auto valueId = result[i];
     auto it = partitionIds_.find(valueId);
     if (it != partitionIds_.end()) {
       result[i] = it->second;
     } else {
-      uint64_t nextPartitionId = partitionIds_.size();
-      VELOX_USER_CHECK_LT(
-          nextPartitionId,
-          maxPartitions_,
-          "Exceeded limit of {} distinct partitions.",
-          maxPartitions_);
+      result[i] = addPartition(valueId, input, i);
+    }
+  }
+}
 
-      partitionIds_.emplace(valueId, nextPartitionId);
-      savePartitionValues(nextPartitionId, input, i);
+uint64_t PartitionIdGenerator::addPartition(
+    uint64_t valueId,
+    const RowVectorPtr& input,
+    vector_size_t row) {
+  uint64_t nextPartitionId = partitionIds_.size();
+  VELOX_USER_CHECK_LT(
+      nextPartitionId,
+      maxPartitions_,
+      "Exceeded limit of {} distinct partitions.",
+      maxPartitions_);
 
-      result[i] = nextPartitionId;
-    }
+  partitionIds_.emplace(valueId, nextPartitionId);
+  if (!densePartitionIds_.empty()) {
+    densePartitionIds_[valueId] = nextPartitionId;
   }
+  savePartitionValues(nextPartitionId, input, row);
+  return nextPartitionId;
 }
 
 std::string PartitionIdGenerator::partitionName(uint64_t partitionId) const {
@@ -145,6 +163,7 @@ void PartitionIdGenerator::computeValueIds(
   }
 
   updateValueToPartitionIdMapping();
+  resetDensePartitionIds(multiplier);
 }
 
 void PartitionIdGenerator::updateValueToPartitionIdMapping() {
@@ -170,6 +189,17 @@ void PartitionIdGenerator::updateValueToPartitionIdMapping() {
   }
 }
 
+void PartitionIdGenerator::resetDensePartitionIds(uint64_t numValueIds) {
+  densePartitionIds_.clear();
+  if (numValueIds > kMaxDenseValueIds) {
+    return;
+  }
+  densePartitionIds_.resize(numValueIds, kNoPartitionId);
+  for (const auto& [valueId, partitionId] : partitionIds_) {
+    densePartitionIds_[valueId] = partitionId;
+  }
+}
+
 void PartitionIdGenerator::savePartitionValues(
     uint64_t partitionId,
     const RowVectorPtr& input,
@@ -57,6 +57,12 @@ class PartitionIdGenerator {
  private:
   static constexpr const int32_t kHasherReservePct = 20;
 
+  // Largest range of value IDs for which 'densePartitionIds_' is used.
+  static constexpr uint64_t kMaxDenseValueIds = 1 << 18;
+
+  static constexpr uint32_t kNoPartitionId =
+      std::numeric_limits<uint32_t>::max();
+
   // Computes value IDs using VectorHashers for all rows in 'input'.
   void computeValueIds(
       const RowVectorPtr& input,
@@ -68,6 +74,17 @@ class PartitionIdGenerator {
   // updated 'hashers_'.
   void updateValueToPartitionIdMapping();
 
+  // Sizes 'densePartitionIds_' to 'numValueIds' and fills it from
+  // 'partitionIds_' if the range is small enough. Clears it otherwise.
+  void resetDensePartitionIds(uint64_t numValueIds);
+
+  // Returns the partition ID for 'valueId'. Adds a partition for 'row' of
+  // 'input' if 'valueId' is new.
+  uint64_t addPartition(
+      uint64_t valueId,
+      const RowVectorPtr& input,
+      vector_size_t row);
+
   // Copies partition values of 'row' from 'input' into 'partitionId' row in
   // 'partitionValues_'.
   void savePartitionValues(
@@ -87,6 +104,11 @@ class PartitionIdGenerator {
   // A mapping from value ID produced by VectorHashers to a partition ID.
   std::unordered_map<uint64_t, uint64_t> partitionIds_;
 
+  // Same mapping as 'partitionIds_' indexed by value ID if the value IDs of
+  // 'hashers_' range over at most 'kMaxDenseValueIds'. Value IDs without a
+  // partition map to 'kNoPartitionId'. Empty if the range is larger.
+  std::vector<uint32_t> densePartitionIds_;
+
   // A vector holding unique partition key values. One row per partition. Row
   // numbers match partition IDs.
   RowVectorPtr partitionValues_;
@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/type/TimestampConversion.h"
 
@@ -60,6 +61,47 @@ VectorPtr newConstantFromString(
         pool, size, false, type, std::move(copy));
   }
 }
+
+// The stripes of a split that the SplitReader reading it has not started.
+// steal() makes a split for a part of them that shares the reader of the file.
+class HiveStealableSplit : public StealableSplit {
+ public:
+  HiveStealableSplit(
+      std::shared_ptr<const HiveConnectorSplit> split,
+      std::shared_ptr<dwio::common::Reader> reader,
+      std::shared_ptr<dwio::common::StripeCursor> cursor)
+      : split_(std::move(split)),
+        reader_(std::move(reader)),
+        cursor_(std::move(cursor)) {}
+
+  std::shared_ptr<ConnectorSplit> steal() override {
+    const auto range = cursor_->steal();
+    if (!range.has_value()) {
+      return nullptr;
+    }
+    auto stolen = std::make_shared<HiveConnectorSplit>(
+        split_->connectorId,
+        split_->filePath,
+        split_->fileFormat,
+        range->first,
+        range->second,
+        split_->partitionKeys,
+        split_->tableBucketNumber,
+        split_->customSplitInfo,
+        split_->extraFileInfo,
+        split_->serdeParameters,
+        0,
+        split_->infoColumns,
+        split_->properties);
+    stolen->reader = reader_;
+    return stolen;
+  }
+
+ private:
+  const std::shared_ptr<const HiveConnectorSplit> split_;
+  const std::shared_ptr<dwio::common::Reader> reader_;
+  const std::shared_ptr<dwio::common::StripeCursor> cursor_;
+};
 } // namespace
 
 std::unique_ptr<SplitReader> SplitReader::create(
@@ -139,6 +181,22 @@ void SplitReader::configureReaderOptions(
       hiveSplit_);
   baseReaderOpts_.setRandomSkip(std::move(randomSkip));
   baseReaderOpts_.setScanSpec(scanSpec_);
+  if (executor_ != nullptr && baseReaderOpts_.unitPrefetchBytes() > 0) {
+    // The connector owns the executor and outlives the readers.
+    baseReaderOpts_.setIOExecutor(
+        std::shared_ptr<folly::Executor>(executor_, [](folly::Executor*) {}));
+  }
+  // The cached file tail can only be reused if the file is known to be
+  // unchanged.
+  if (hiveSplit_->properties.has_value() &&
+      hiveSplit_->properties->modificationTime.has_value()) {
+    baseReaderOpts_.setFileMetadataCacheKey(
+        dwio::common::FileMetadataCache::makeKey(
+            hiveSplit_->filePath,
+            *hiveSplit_->properties->modificationTime,
+            hiveSplit_->properties->fileSize.value_or(0)));
+    baseReaderOpts_.setIoStatistics(ioStats_);
+  }
 }
 
 void SplitReader::prepareSplit(
@@ -198,11 +256,31 @@ bool SplitReader::allPrefetchIssued() const {
   return baseRowReader_ && baseRowReader_->allPrefetchIssued();
 }
 
+bool SplitReader::isNextReadBlocked(ContinueFuture& future) {
+  return baseRowReader_ && baseRowReader_->isNextReadBlocked(future);
+}
+
 void SplitReader::setConnectorQueryCtx(
     const ConnectorQueryCtx* connectorQueryCtx) {
   connectorQueryCtx_ = connectorQueryCtx;
 }
 
+std::shared_ptr<StealableSplit> SplitReader::stealableSplit() const {
+  // The random skip of the reader is not thread safe, and a bucket
+  // conversion cannot be copied to the split for the stolen part.
+  if (emptySplit_ || baseRowReader_ == nullptr ||
+      baseReaderOpts_.randomSkip() ||
+      hiveSplit_->bucketConversion.has_value()) {
+    return nullptr;
+  }
+  auto cursor = baseRowReader_->stripeCursor();
+  if (cursor == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<HiveStealableSplit>(
+      hiveSplit_, baseReader_, std::move(cursor));
+}
+
 std::string SplitReader::toString() const {
   std::string partitionKeys;
   std::for_each(
@@ -225,39 +303,44 @@ void SplitReader::createReader(
   VELOX_CHECK_NE(
       baseReaderOpts_.fileFormat(), dwio::common::FileFormat::UNKNOWN);
 
-  FileHandleCachedPtr fileHandleCachePtr;
-  try {
-    fileHandleCachePtr = fileHandleFactory_->generate(
-        hiveSplit_->filePath,
-        hiveSplit_->properties.has_value() ? &*hiveSplit_->properties
-                                           : nullptr);
-    VELOX_CHECK_NOT_NULL(fileHandleCachePtr.get());
-  } catch (const VeloxRuntimeError& e) {
-    if (e.errorCode() == error_code::kFileNotFound &&
-        hiveConfig_->ignoreMissingFiles(
-            connectorQueryCtx_->sessionProperties())) {
-      emptySplit_ = true;
-      return;
+  if (hiveSplit_->reader != nullptr) {
+    // The unread part of a split taken over from another driver.
+    baseReader_ = hiveSplit_->reader;
+  } else {
+    FileHandleCachedPtr fileHandleCachePtr;
+    try {
+      fileHandleCachePtr = fileHandleFactory_->generate(
+          hiveSplit_->filePath,
+          hiveSplit_->properties.has_value() ? &*hiveSplit_->properties
+                                             : nullptr);
+      VELOX_CHECK_NOT_NULL(fileHandleCachePtr.get());
+    } catch (const VeloxRuntimeError& e) {
+      if (e.errorCode() == error_code::kFileNotFound &&
+          hiveConfig_->ignoreMissingFiles(
+              connectorQueryCtx_->sessionProperties())) {
+        emptySplit_ = true;
+        return;
+      }
+      throw;
     }
-    throw;
-  }
 
-  // Here we keep adding new entries to CacheTTLController when new fileHandles
-  // are generated, if CacheTTLController was created. Creator of
-  // CacheTTLController needs to make sure a size control strategy was available
-  // such as removing aged out entries.
-  if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
-    cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
+    // Here we keep adding new entries to CacheTTLController when new
+    // fileHandles are generated, if CacheTTLController was created. Creator of
+    // CacheTTLController needs to make sure a size control strategy was
+    // available such as removing aged out entries.
+    if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
+      cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
+    }
+    auto baseFileInput = createBufferedInput(
+        *fileHandleCachePtr,
+        baseReaderOpts_,
+        connectorQueryCtx_,
+        ioStats_,
+        executor_);
+
+    baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
+                      ->createReader(std::move(baseFileInput), baseReaderOpts_);
   }
-  auto baseFileInput = createBufferedInput(
-      *fileHandleCachePtr,
-      baseReaderOpts_,
-      connectorQueryCtx_,
-      ioStats_,
-      executor_);
-
-  baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
-                    ->createReader(std::move(baseFileInput), baseReaderOpts_);
 
   auto& fileType = baseReader_->rowType();
   auto columnTypes = adaptColumns(fileType, baseReaderOpts_.fileSchema());
@@ -272,6 +355,13 @@ void SplitReader::createReader(
       std::move(metadataFilter),
       ROW(std::move(columnNames), std::move(columnTypes)),
       hiveSplit_);
+  const auto decodingParallelism = hiveConfig_->decodingParallelism();
+  if (executor_ != nullptr && decodingParallelism > 1) {
+    // The connector owns the executor and outlives the readers.
+    baseRowReaderOpts_.setDecodingExecutor(
+        std::shared_ptr<folly::Executor>(executor_, [](folly::Executor*) {}));
+    baseRowReaderOpts_.setDecodingParallelismFactor(decodingParallelism);
+  }
 }
 
 bool SplitReader::checkIfSplitIsEmpty(
@@ -288,12 +378,21 @@ bool SplitReader::checkIfSplitIsEmpty(
   } else {
     // Check filters and see if the whole split can be skipped. Note that this
     // doesn't apply to Hudi tables.
+    // If the file may have matching rows, checks the stripes or row groups
+    // of the split range before making any column reader for them.
     if (!testFilters(
             scanSpec_.get(),
             baseReader_.get(),
             hiveSplit_->filePath,
             hiveSplit_->partitionKeys,
-            *partitionKeys_)) {
+            *partitionKeys_) ||
+        !testUnitFilters(
+            scanSpec_.get(),
+            baseRowReaderOpts_.getMetadataFilter().get(),
+            baseReader_.get(),
+            hiveSplit_->start,
+            hiveSplit_->length,
+            hiveSplit_->partitionKeys)) {
       ++runtimeStats.skippedSplits;
       runtimeStats.skippedSplitBytes += hiveSplit_->length;
       emptySplit_ = true;
@@ -33,6 +33,7 @@ class ScanSpec;
 
 namespace facebook::velox::connector {
 class ConnectorQueryCtx;
+class StealableSplit;
 } // namespace facebook::velox::connector
 
 namespace facebook::velox::dwio::common {
@@ -108,8 +109,17 @@ class SplitReader {
 
   bool allPrefetchIssued() const;
 
+  /// Returns true if the next call to next() would wait for IO running in the
+  /// background. Sets 'future' to be realized when the IO is done.
+  bool isNextReadBlocked(ContinueFuture& future);
+
   void setConnectorQueryCtx(const ConnectorQueryCtx* connectorQueryCtx);
 
+  /// Returns the stripes of the split that have not been started, for
+  /// another driver of the scan to take over, or nullptr if the split cannot
+  /// be shared.
+  virtual std::shared_ptr<StealableSplit> stealableSplit() const;
+
   std::string toString() const;
 
  protected:
@@ -160,7 +170,7 @@ class SplitReader {
   memory::MemoryPool* const pool_;
 
   std::shared_ptr<common::ScanSpec> scanSpec_;
-  std::unique_ptr<dwio::common::Reader> baseReader_;
+  std::shared_ptr<dwio::common::Reader> baseReader_;
   std::unique_ptr<dwio::common::RowReader> baseRowReader_;
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
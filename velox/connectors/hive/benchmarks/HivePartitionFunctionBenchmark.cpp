@@ -16,6 +16,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/connectors/hive/PartitionIdGenerator.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/type/Type.h"
 #include "velox/vector/ComplexVector.h"
@@ -27,6 +28,7 @@ DEFINE_int64(fuzzer_seed, 99887766, "Seed for random input dataset generator");
 using namespace facebook::velox;
 using namespace facebook::velox::test;
 using connector::hive::HivePartitionFunction;
+using connector::hive::PartitionIdGenerator;
 
 namespace {
 
@@ -69,6 +71,41 @@ class HivePartitionFunctionBenchmark
     fewBucketsFunction_ = createHivePartitionFunction(20);
     manyBucketsFunction_ = createHivePartitionFunction(100);
 
+    // Three bucketing keys, as in tables bucketed on several columns.
+    multipleKeysVector_ = fuzzer.fuzzInputFlatRow(
+        ROW({"a", "b", "c"}, {BIGINT(), VARCHAR(), INTEGER()}));
+    multipleKeysFunction_ = std::make_unique<HivePartitionFunction>(
+        kManyBuckets, std::vector<column_index_t>{0, 1, 2});
+
+    // 2'048 partitions of a date and a string key have a small range of value
+    // IDs. The same number of partitions of two wide BIGINT keys do not.
+    const auto numRows = static_cast<vector_size_t>(vectorSize);
+    smallRangeKeysVector_ = vm.rowVector({
+        vm.flatVector<int32_t>(
+            numRows, [](auto row) { return 18'000 + row % 64; }),
+        vm.flatVector<std::string>(
+            numRows,
+            [](auto row) { return fmt::format("region-{}", row % 32); }),
+    });
+    largeRangeKeysVector_ = vm.rowVector({
+        vm.flatVector<int64_t>(
+            numRows, [](auto row) { return (row % 2'048) * 1'000'003L; }),
+        vm.flatVector<int64_t>(
+            numRows, [](auto row) { return (row % 2'048) * 7L; }),
+    });
+    smallRangeIdGenerator_ = std::make_unique<PartitionIdGenerator>(
+        asRowType(smallRangeKeysVector_->type()),
+        std::vector<column_index_t>{0, 1},
+        kMaxPartitions,
+        pool(),
+        true);
+    largeRangeIdGenerator_ = std::make_unique<PartitionIdGenerator>(
+        asRowType(largeRangeKeysVector_->type()),
+        std::vector<column_index_t>{0, 1},
+        kMaxPartitions,
+        pool(),
+        true);
+
     partitions_.resize(vectorSize);
   }
 
@@ -82,7 +119,22 @@ class HivePartitionFunctionBenchmark
     run<KIND>(manyBucketsFunction_.get());
   }
 
+  void runMultipleKeys() {
+    multipleKeysFunction_->partition(*multipleKeysVector_, partitions_);
+  }
+
+  void runPartitionIds(bool smallRange) {
+    if (smallRange) {
+      smallRangeIdGenerator_->run(smallRangeKeysVector_, partitionIds_);
+    } else {
+      largeRangeIdGenerator_->run(largeRangeKeysVector_, partitionIds_);
+    }
+  }
+
  private:
+  static constexpr int32_t kManyBuckets = 4'096;
+  static constexpr uint32_t kMaxPartitions = 4'096;
+
   std::unique_ptr<HivePartitionFunction> createHivePartitionFunction(
       size_t bucketCount) {
     std::vector<int> bucketToPartition(bucketCount);
@@ -105,7 +157,14 @@ class HivePartitionFunctionBenchmark
   std::unordered_map<TypeKind, RowVectorPtr> rowVectors_;
   std::unique_ptr<HivePartitionFunction> fewBucketsFunction_;
   std::unique_ptr<HivePartitionFunction> manyBucketsFunction_;
+  RowVectorPtr multipleKeysVector_;
+  std::unique_ptr<HivePartitionFunction> multipleKeysFunction_;
+  RowVectorPtr smallRangeKeysVector_;
+  RowVectorPtr largeRangeKeysVector_;
+  std::unique_ptr<PartitionIdGenerator> smallRangeIdGenerator_;
+  std::unique_ptr<PartitionIdGenerator> largeRangeIdGenerator_;
   std::vector<uint32_t> partitions_;
+  raw_vector<uint64_t> partitionIds_;
 };
 
 std::unique_ptr<HivePartitionFunctionBenchmark> benchmarkFew;
@@ -325,6 +384,26 @@ BENCHMARK_RELATIVE(rowManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::ROW>();
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(multipleKeysFewRows) {
+  benchmarkFew->runMultipleKeys();
+}
+
+BENCHMARK(multipleKeysManyRows) {
+  benchmarkMany->runMultipleKeys();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(partitionIdsSmallRange) {
+  benchmarkMany->runPartitionIds(true);
+}
+
+BENCHMARK_RELATIVE(partitionIdsLargeRange) {
+  benchmarkMany->runPartitionIds(false);
+}
+
 BENCHMARK_DRAW_LINE();
 } // namespace
 
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t integerValueAt(const DecodedVector& decoded, vector_size_t row) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void appendBytes(const T& value, std::string& key) {
+  key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void checkEqualityColumnType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return;
+    default:
+      // Iceberg does not allow floating point or nested equality columns.
+      VELOX_USER_FAIL(
+          "Unsupported type for Iceberg equality delete column: {}",
+          type->toString());
+  }
+}
+
+// Cached sets are pinned while in use, so the capacity only bounds the memory
+// retained by sets of scans that are no longer running.
+constexpr uint64_t kEqualityDeleteCacheBytes = 256 << 20;
+
+struct EqualityDeleteSetGenerator {
+  std::unique_ptr<EqualityDeleteSet> operator()(
+      const std::string& /*key*/,
+      const EqualityDeleteFileReader* reader) {
+    return reader->read();
+  }
+};
+
+struct EqualityDeleteSetSizer {
+  uint64_t operator()(const EqualityDeleteSet& deleteSet) {
+    return deleteSet.byteSize();
+  }
+};
+
+using EqualityDeleteSetFactory = CachedFactory<
+    std::string,
+    EqualityDeleteSet,
+    EqualityDeleteSetGenerator,
+    EqualityDeleteFileReader,
+    EqualityDeleteSetSizer>;
+
+EqualityDeleteSetFactory& equalityDeleteSetFactory() {
+  // Never destroyed so that sets pinned at process exit do not trip the cache
+  // destructor checks.
+  static auto* factory = new EqualityDeleteSetFactory(
+      std::make_unique<SimpleLRUCache<std::string, EqualityDeleteSet>>(
+          kEqualityDeleteCacheBytes),
+      std::make_unique<EqualityDeleteSetGenerator>());
+  return *factory;
+}
+
+} // namespace
+
+EqualityDeleteSet::EqualityDeleteSet(
+    std::vector<std::string> names,
+    std::vector<TypePtr> types)
+    : names_(std::move(names)),
+      types_(std::move(types)),
+      singleInteger_(types_.size() == 1 && isIntegerKind(types_[0]->kind())) {
+  VELOX_CHECK(!types_.empty(), "Equality delete needs at least one column");
+  VELOX_CHECK_EQ(names_.size(), types_.size());
+  for (const auto& type : types_) {
+    checkEqualityColumnType(type);
+  }
+}
+
+void EqualityDeleteSet::makeKey(
+    const std::vector<DecodedVector>& decodedKeys,
+    vector_size_t row,
+    std::string& key) const {
+  key.clear();
+  for (const auto& decoded : decodedKeys) {
+    if (decoded.isNullAt(row)) {
+      key.push_back('\0');
+      continue;
+    }
+    key.push_back('\1');
+    switch (decoded.base()->typeKind()) {
+      case TypeKind::BOOLEAN:
+        key.push_back(decoded.valueAt<bool>(row) ? '\1' : '\0');
+        break;
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        appendBytes(integerValueAt(decoded, row), key);
+        break;
+      case TypeKind::HUGEINT:
+        appendBytes(decoded.valueAt<int128_t>(row), key);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        const auto value = decoded.valueAt<StringView>(row);
+        appendBytes(static_cast<int32_t>(value.size()), key);
+        key.append(value.data(), value.size());
+        break;
+      }
+      case TypeKind::TIMESTAMP: {
+        const auto value = decoded.valueAt<Timestamp>(row);
+        appendBytes(value.getSeconds(), key);
+        appendBytes(value.getNanos(), key);
+        break;
+      }
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+void EqualityDeleteSet::add(const RowVector& keys) {
+  VELOX_CHECK_EQ(keys.childrenSize(), types_.size());
+  const auto numRows = keys.size();
+  SelectivityVector rows(numRows);
+  if (singleInteger_) {
+    DecodedVector decoded(*keys.childAt(0), rows);
+    for (auto row = 0; row < numRows; ++row) {
+      if (decoded.isNullAt(row)) {
+        hasNull_ = true;
+      } else {
+        values_.insert(integerValueAt(decoded, row));
+      }
+    }
+    return;
+  }
+
+  std::vector<DecodedVector> decodedKeys;
+  decodedKeys.reserve(types_.size());
+  for (const auto& child : keys.children()) {
+    decodedKeys.emplace_back(*child, rows);
+  }
+  std::string key;
+  for (auto row = 0; row < numRows; ++row) {
+    makeKey(decodedKeys, row, key);
+    if (keys_.insert(key).second) {
+      keyBytes_ += key.size();
+    }
+  }
+}
+
+void EqualityDeleteSet::removeDeleted(
+    const std::vector<VectorPtr>& keys,
+    SelectivityVector& rows) const {
+  VELOX_CHECK_EQ(keys.size(), types_.size());
+  if (singleInteger_) {
+    DecodedVector decoded(*keys[0], rows);
+    rows.applyToSelected([&](vector_size_t row) {
+      if (decoded.isNullAt(row)) {
+        if (hasNull_) {
+          rows.setValid(row, false);
+        }
+      } else if (values_.contains(integerValueAt(decoded, row))) {
+        rows.setValid(row, false);
+      }
+    });
+    rows.updateBounds();
+    return;
+  }
+
+  std::vector<DecodedVector> decodedKeys;
+  decodedKeys.reserve(keys.size());
+  for (const auto& key : keys) {
+    decodedKeys.emplace_back(*key, rows);
+  }
+  std::string key;
+  rows.applyToSelected([&](vector_size_t row) {
+    makeKey(decodedKeys, row, key);
+    if (keys_.contains(key)) {
+      rows.setValid(row, false);
+    }
+  });
+  rows.updateBounds();
+}
+
+std::unique_ptr<common::Filter> EqualityDeleteSet::toFilter(
+    size_t maxValues) const {
+  if (!singleInteger_ || values_.size() > maxValues) {
+    return nullptr;
+  }
+  if (values_.empty()) {
+    if (hasNull_) {
+      return std::make_unique<common::IsNotNull>();
+    }
+    return std::make_unique<common::AlwaysTrue>();
+  }
+  std::vector<int64_t> values(values_.begin(), values_.end());
+  return common::createNegatedBigintValues(values, !hasNull_);
+}
+
+uint64_t EqualityDeleteSet::byteSize() const {
+  return values_.getAllocatedMemorySize() + keys_.getAllocatedMemorySize() +
+      keyBytes_;
+}
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    RowTypePtr tableSchema,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile),
+      tableSchema_(std::move(tableSchema)),
+      fileHandleFactory_(fileHandleFactory),
+      connectorQueryCtx_(connectorQueryCtx),
+      executor_(executor),
+      hiveConfig_(hiveConfig),
+      ioStats_(ioStats),
+      pool_(connectorQueryCtx->memoryPool()),
+      connectorId_(connectorId) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+  VELOX_CHECK(!deleteFile_.equalityFieldIds.empty());
+}
+
+std::unique_ptr<EqualityDeleteSet> EqualityDeleteFileReader::read() const {
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId_,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  // No file schema is given so that the reader keeps the column names of the
+  // delete file instead of renaming its columns by position.
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      deleteReaderOpts, hiveConfig_, connectorQueryCtx_, nullptr, deleteSplit);
+
+  auto deleteFileHandleCachePtr =
+      fileHandleFactory_->generate(deleteFile_.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx_,
+      ioStats_,
+      executor_);
+
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  // An equality delete file has exactly the equality columns. They are
+  // matched to the table columns by name and read as the table types.
+  const auto& fileType = deleteReader->rowType();
+  VELOX_USER_CHECK_EQ(
+      fileType->size(),
+      deleteFile_.equalityFieldIds.size(),
+      "Iceberg equality delete file {} must have one column per equality field",
+      deleteFile_.filePath);
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < fileType->size(); ++i) {
+    const auto& name = fileType->nameOf(i);
+    auto tableIndex = tableSchema_->getChildIdxIfExists(name);
+    VELOX_USER_CHECK(
+        tableIndex.has_value(),
+        "Iceberg equality delete column {} of {} is not in the table",
+        name,
+        deleteFile_.filePath);
+    names.push_back(name);
+    types.push_back(tableSchema_->childAt(*tableIndex));
+  }
+  auto deleteFileSchema = ROW(std::move(names), std::move(types));
+  auto deleteSet = std::make_unique<EqualityDeleteSet>(
+      deleteFileSchema->names(), deleteFileSchema->children());
+  if (deleteFile_.recordCount == 0) {
+    return deleteSet;
+  }
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*deleteFileSchema);
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts,
+      {},
+      scanSpec,
+      nullptr,
+      deleteFileSchema,
+      deleteSplit);
+
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  constexpr uint64_t kBatchSize = 10'000;
+  VectorPtr output = BaseVector::create(deleteFileSchema, 0, pool_);
+  while (deleteRowReader->next(kBatchSize, output) > 0) {
+    if (output->size() > 0) {
+      deleteSet->add(*output->loadedVector()->as<RowVector>());
+    }
+  }
+  return deleteSet;
+}
+
+EqualityDeleteSetCachedPtr getEqualityDeleteSet(
+    const std::string& scanId,
+    const std::string& deleteFilePath,
+    const EqualityDeleteFileReader& reader) {
+  return equalityDeleteSetFactory().generate(
+      fmt::format("{}:{}", scanId, deleteFilePath), &reader);
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
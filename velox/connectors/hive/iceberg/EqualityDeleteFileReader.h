@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+#include <memory>
+
+#include "velox/common/caching/CachedFactory.h"
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/SelectivityVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// The key tuples deleted by an Iceberg equality delete file. A row of a data
+/// file is deleted if its values in the equality columns are equal to one of
+/// the tuples, where null is equal to null.
+class EqualityDeleteSet {
+ public:
+  /// 'names' and 'types' are the names and table types of the equality
+  /// columns.
+  EqualityDeleteSet(std::vector<std::string> names, std::vector<TypePtr> types);
+
+  /// Returns the names of the equality columns in the table schema.
+  const std::vector<std::string>& names() const {
+    return names_;
+  }
+
+  const std::vector<TypePtr>& types() const {
+    return types_;
+  }
+
+  /// Adds the rows of 'keys' to the set. The children of 'keys' correspond 1:1
+  /// to the equality columns.
+  void add(const RowVector& keys);
+
+  /// Deselects the rows in 'rows' whose values in 'keys' are in the set.
+  /// 'keys' correspond 1:1 to the equality columns.
+  void removeDeleted(
+      const std::vector<VectorPtr>& keys,
+      SelectivityVector& rows) const;
+
+  /// Returns a filter passing the rows not deleted by 'this' for pushdown into
+  /// the scan. Returns nullptr if there is more than one equality column, the
+  /// column is not of an integer type or there are more than 'maxValues'
+  /// deleted values.
+  std::unique_ptr<common::Filter> toFilter(size_t maxValues) const;
+
+  /// Returns the number of deleted tuples.
+  size_t size() const {
+    return singleInteger_ ? values_.size() + hasNull_ : keys_.size();
+  }
+
+  /// Returns an estimate of the memory used by 'this'.
+  uint64_t byteSize() const;
+
+ private:
+  // Serializes the values of 'row' in 'decodedKeys' into 'key'. Integer
+  // values are widened to 64 bits so that the key does not depend on the
+  // width of the integer type in the delete and data files.
+  void makeKey(
+      const std::vector<DecodedVector>& decodedKeys,
+      vector_size_t row,
+      std::string& key) const;
+
+  const std::vector<std::string> names_;
+  const std::vector<TypePtr> types_;
+
+  // True if there is a single equality column of integer type. The deleted
+  // values are then kept in 'values_' and 'hasNull_', otherwise the serialized
+  // tuples are kept in 'keys_'.
+  const bool singleInteger_;
+
+  folly::F14FastSet<int64_t> values_;
+  bool hasNull_{false};
+
+  folly::F14FastSet<std::string> keys_;
+  uint64_t keyBytes_{0};
+};
+
+/// Reads an Iceberg equality delete file into an EqualityDeleteSet.
+class EqualityDeleteFileReader {
+ public:
+  /// 'tableSchema' is the schema of the data columns of the table. The
+  /// columns of the delete file are matched to it by name, so that the
+  /// mapping is not affected by columns added or dropped since the delete
+  /// file was written.
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      RowTypePtr tableSchema,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Reads all rows of the delete file.
+  std::unique_ptr<EqualityDeleteSet> read() const;
+
+ private:
+  const IcebergDeleteFile& deleteFile_;
+  const RowTypePtr tableSchema_;
+  FileHandleFactory* const fileHandleFactory_;
+  const ConnectorQueryCtx* const connectorQueryCtx_;
+  folly::Executor* const executor_;
+  const std::shared_ptr<const HiveConfig> hiveConfig_;
+  const std::shared_ptr<io::IoStatistics> ioStats_;
+  memory::MemoryPool* const pool_;
+  const std::string connectorId_;
+};
+
+using EqualityDeleteSetCachedPtr = CachedPtr<std::string, EqualityDeleteSet>;
+
+/// Returns the EqualityDeleteSet for the delete file of 'reader', reading it
+/// only if not cached. The sets are cached by 'scanId' and delete file path so
+/// that all the splits of a table scan in a task that share a delete file read
+/// it once. Concurrent requests for the same set wait for the first one.
+EqualityDeleteSetCachedPtr getEqualityDeleteSet(
+    const std::string& scanId,
+    const std::string& deleteFilePath,
+    const EqualityDeleteFileReader& reader);
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -55,6 +55,11 @@ struct HiveIcebergSplit : public connector::hive::HiveConnectorSplit {
       std::vector<IcebergDeleteFile> deletes = {},
       const std::unordered_map<std::string, std::string>& _infoColumns = {},
       std::optional<FileProperties> fileProperties = std::nullopt);
+
+  /// The rows of the split also depend on 'deleteFiles'.
+  std::optional<std::string> cacheKey() const override {
+    return std::nullopt;
+  }
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -16,6 +16,9 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
@@ -50,6 +53,27 @@ IcebergSplitReader::IcebergSplitReader(
       baseReadOffset_(0),
       splitOffset_(0) {}
 
+IcebergSplitReader::~IcebergSplitReader() {
+  if (replacedFilters_.empty() && addedChildSpecs_.empty() &&
+      projectedChildSpecs_.empty()) {
+    return;
+  }
+  // Restore in reverse order so that a column with several pushed down delete
+  // sets gets back the filter it had before the first one.
+  for (auto it = replacedFilters_.rbegin(); it != replacedFilters_.rend();
+       ++it) {
+    it->first->setFilter(std::move(it->second));
+  }
+  for (const auto& name : addedChildSpecs_) {
+    scanSpec_->removeChild(name);
+  }
+  for (auto& [childSpec, channel] : projectedChildSpecs_) {
+    childSpec->setProjectOut(false);
+    childSpec->setChannel(channel);
+  }
+  scanSpec_->resetCachedValues(false);
+}
+
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats,
@@ -61,35 +85,186 @@ void IcebergSplitReader::prepareSplit(
     return;
   }
 
-  createRowReader();
-
   std::shared_ptr<const HiveIcebergSplit> icebergSplit =
       std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
+  const auto& deleteFiles = icebergSplit->deleteFiles;
+
+  // Equality deletes may be pushed down into the scan spec, which must happen
+  // before the row reader is created.
+  equalityDeletes_.clear();
+  for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.content == FileContent::kEqualityDeletes &&
+        deleteFile.recordCount > 0) {
+      addEqualityDeletes(deleteFile);
+    }
+  }
+
+  createRowReader();
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
-  positionalDeleteFileReaders_.clear();
 
-  const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
-    if (deleteFile.content == FileContent::kPositionalDeletes) {
-      if (deleteFile.recordCount > 0) {
-        positionalDeleteFileReaders_.push_back(
-            std::make_unique<PositionalDeleteFileReader>(
-                deleteFile,
-                hiveSplit_->filePath,
-                fileHandleFactory_,
-                connectorQueryCtx_,
-                executor_,
-                hiveConfig_,
-                ioStats_,
-                runtimeStats,
-                splitOffset_,
-                hiveSplit_->connectorId));
-      }
-    } else {
+    if (deleteFile.content != FileContent::kPositionalDeletes &&
+        deleteFile.content != FileContent::kEqualityDeletes) {
       VELOX_NYI();
     }
   }
+  loadPositionalDeletes(deleteFiles, runtimeStats);
+}
+
+void IcebergSplitReader::loadPositionalDeletes(
+    const std::vector<IcebergDeleteFile>& deleteFiles,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  positionalDeleteSets_.clear();
+  std::vector<const IcebergDeleteFile*> positionalDeleteFiles;
+  for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.content == FileContent::kPositionalDeletes &&
+        deleteFile.recordCount > 0) {
+      positionalDeleteFiles.push_back(&deleteFile);
+    }
+  }
+  if (positionalDeleteFiles.empty()) {
+    return;
+  }
+
+  // Split startup would otherwise be dominated by opening the delete files
+  // one after the other. Each file is read on 'executor_' and the ones not yet
+  // started when needed are read on this thread.
+  std::vector<dwio::common::RuntimeStatistics> deleteStats(
+      positionalDeleteFiles.size());
+  std::vector<std::shared_ptr<AsyncSource<PositionalDeleteSetCachedPtr>>>
+      loads;
+  loads.reserve(positionalDeleteFiles.size());
+  SCOPE_EXIT {
+    for (auto& load : loads) {
+      load->close();
+    }
+  };
+  for (auto i = 0; i < positionalDeleteFiles.size(); ++i) {
+    auto* deleteFile = positionalDeleteFiles[i];
+    auto* stats = &deleteStats[i];
+    loads.push_back(std::make_shared<AsyncSource<PositionalDeleteSetCachedPtr>>(
+        [this, deleteFile, stats]() {
+          PositionalDeleteFileReader reader(
+              *deleteFile,
+              hiveSplit_->filePath,
+              fileHandleFactory_,
+              connectorQueryCtx_,
+              executor_,
+              hiveConfig_,
+              ioStats_,
+              *stats,
+              hiveSplit_->connectorId);
+          return std::make_unique<PositionalDeleteSetCachedPtr>(
+              getPositionalDeleteSet(
+                  connectorQueryCtx_->scanId(),
+                  deleteFile->filePath,
+                  hiveSplit_->filePath,
+                  reader));
+        }));
+  }
+  if (executor_ != nullptr && loads.size() > 1) {
+    for (auto& load : loads) {
+      executor_->add([load]() { load->prepare(); });
+    }
+  }
+  for (auto i = 0; i < loads.size(); ++i) {
+    auto deleteSet = loads[i]->move();
+    VELOX_CHECK_NOT_NULL(deleteSet);
+    runtimeStats.skippedSplits += deleteStats[i].skippedSplits;
+    runtimeStats.skippedSplitBytes += deleteStats[i].skippedSplitBytes;
+    if ((*deleteSet)->maxPosition() >= static_cast<int64_t>(splitOffset_)) {
+      positionalDeleteSets_.push_back(std::move(*deleteSet));
+    }
+  }
+}
+
+void IcebergSplitReader::addEqualityDeletes(
+    const IcebergDeleteFile& deleteFile) {
+  // Field ids are positions in the table schema only until a column is added
+  // or dropped, so the columns of the delete file are matched by name.
+  const auto& tableSchema = hiveTableHandle_->dataColumns()
+      ? hiveTableHandle_->dataColumns()
+      : baseReader_->rowType();
+  EqualityDeleteFileReader reader(
+      deleteFile,
+      tableSchema,
+      fileHandleFactory_,
+      connectorQueryCtx_,
+      executor_,
+      hiveConfig_,
+      ioStats_,
+      hiveSplit_->connectorId);
+  auto deleteSet = getEqualityDeleteSet(
+      connectorQueryCtx_->scanId(), deleteFile.filePath, reader);
+  if (deleteSet->size() == 0) {
+    return;
+  }
+
+  const auto& names = deleteSet->names();
+  if (names.size() == 1) {
+    auto* childSpec = scanSpec_->childByName(names[0]);
+    if (childSpec != nullptr && !childSpec->isConstant()) {
+      if (auto filter =
+              deleteSet->toFilter(kMaxEqualityDeletePushdownValues)) {
+        replacedFilters_.emplace_back(
+            childSpec,
+            childSpec->filter() ? childSpec->filter()->clone() : nullptr);
+        childSpec->addFilter(*filter);
+        scanSpec_->resetCachedValues(false);
+        return;
+      }
+    }
+  }
+
+  EqualityDelete equalityDelete;
+  for (auto i = 0; i < names.size(); ++i) {
+    equalityDelete.channels.push_back(
+        equalityDeleteChannel(names[i], deleteSet->types()[i]));
+  }
+  equalityDelete.deleteSet = std::move(deleteSet);
+  equalityDeletes_.push_back(std::move(equalityDelete));
+}
+
+column_index_t IcebergSplitReader::equalityDeleteChannel(
+    const std::string& name,
+    const TypePtr& type) {
+  if (auto channel = readerOutputType_->getChildIdxIfExists(name)) {
+    return channel.value();
+  }
+  for (auto i = 0; i < equalityOnlyNames_.size(); ++i) {
+    if (equalityOnlyNames_[i] == name) {
+      return readerOutputType_->size() + i;
+    }
+  }
+
+  // The column is read with its file type, which may be narrower than the
+  // table type. Integer keys are widened when compared with the delete set.
+  const auto& fileType = baseReader_->rowType();
+  const auto fileIndex = fileType->getChildIdxIfExists(name);
+  const column_index_t channel =
+      readerOutputType_->size() + equalityOnlyNames_.size();
+  if (auto* childSpec = scanSpec_->childByName(name)) {
+    // A filter only column. Missing columns and partition keys already have
+    // their constant values.
+    VELOX_CHECK(!childSpec->projectOut());
+    projectedChildSpecs_.emplace_back(childSpec, childSpec->channel());
+    childSpec->setProjectOut(true);
+    childSpec->setChannel(channel);
+  } else {
+    auto* childSpec = scanSpec_->addField(name, channel);
+    addedChildSpecs_.push_back(name);
+    if (!fileIndex.has_value()) {
+      // Column is missing. Most likely due to schema evolution.
+      childSpec->setConstantValue(BaseVector::createNullConstant(
+          type, 1, connectorQueryCtx_->memoryPool()));
+    }
+  }
+  scanSpec_->resetCachedValues(false);
+  equalityOnlyNames_.push_back(name);
+  equalityOnlyTypes_.push_back(
+      fileIndex.has_value() ? fileType->childAt(*fileIndex) : type);
+  return channel;
 }
 
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
@@ -97,31 +272,119 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
   mutation.deletedRows = nullptr;
 
-  if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(size);
-    dwio::common::ensureCapacity<int8_t>(
-        deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool());
-    std::memset((void*)deleteBitmap_->as<int8_t>(), 0L, numBytes);
-
-    for (auto iter = positionalDeleteFileReaders_.begin();
-         iter != positionalDeleteFileReaders_.end();) {
-      (*iter)->readDeletePositions(
-          baseReadOffset_, size, deleteBitmap_->asMutable<int8_t>());
-      if ((*iter)->endOfFile()) {
-        iter = positionalDeleteFileReaders_.erase(iter);
-      } else {
-        ++iter;
-      }
+  if (!positionalDeleteSets_.empty()) {
+    // Delete sets are ored into the bitmap a word at a time, so it is sized in
+    // whole words.
+    const auto numWords = bits::nwords(size);
+    dwio::common::ensureCapacity<uint64_t>(
+        deleteBitmap_, numWords, connectorQueryCtx_->memoryPool());
+    auto* deleteBitmap = deleteBitmap_->asMutable<uint64_t>();
+    std::memset(deleteBitmap, 0, numWords * sizeof(uint64_t));
+
+    // The file position of the first row of the batch.
+    const int64_t begin = splitOffset_ + baseReadOffset_;
+    bool anyDeleted = false;
+    for (const auto& deleteSet : positionalDeleteSets_) {
+      anyDeleted |= deleteSet->apply(begin, size, deleteBitmap);
     }
 
-    deleteBitmap_->setSize(numBytes);
-    mutation.deletedRows = deleteBitmap_->as<uint64_t>();
+    if (anyDeleted) {
+      deleteBitmap_->setSize(bits::nbytes(size));
+      mutation.deletedRows = deleteBitmap;
+    }
   }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+  uint64_t rowsScanned;
+  if (equalityDeletes_.empty()) {
+    rowsScanned = baseRowReader_->next(size, output, &mutation);
+  } else {
+    if (!readerOutput_) {
+      auto names = readerOutputType_->names();
+      auto types = readerOutputType_->children();
+      names.insert(
+          names.end(), equalityOnlyNames_.begin(), equalityOnlyNames_.end());
+      types.insert(
+          types.end(), equalityOnlyTypes_.begin(), equalityOnlyTypes_.end());
+      readerOutput_ = BaseVector::create(
+          ROW(std::move(names), std::move(types)), 0, pool_);
+    }
+    rowsScanned = baseRowReader_->next(size, readerOutput_, &mutation);
+    if (rowsScanned > 0) {
+      applyEqualityDeletes(output);
+    }
+  }
   baseReadOffset_ += rowsScanned;
 
+  if (!positionalDeleteSets_.empty()) {
+    const int64_t nextPosition = splitOffset_ + baseReadOffset_;
+    positionalDeleteSets_.erase(
+        std::remove_if(
+            positionalDeleteSets_.begin(),
+            positionalDeleteSets_.end(),
+            [&](const auto& deleteSet) {
+              return deleteSet->maxPosition() < nextPosition;
+            }),
+        positionalDeleteSets_.end());
+  }
+
   return rowsScanned;
 }
 
+void IcebergSplitReader::applyEqualityDeletes(VectorPtr& output) {
+  auto* rowVector = readerOutput_->asUnchecked<RowVector>();
+  const auto numRows = rowVector->size();
+  const auto numOutputColumns = readerOutputType_->size();
+  if (numRows == 0 || equalityOnlyNames_.empty()) {
+    output = readerOutput_;
+  } else {
+    // Drops the columns read only for the equality deletes.
+    std::vector<VectorPtr> children(
+        rowVector->children().begin(),
+        rowVector->children().begin() + numOutputColumns);
+    output = std::make_shared<RowVector>(
+        pool_,
+        readerOutputType_,
+        rowVector->nulls(),
+        numRows,
+        std::move(children));
+  }
+  if (numRows == 0) {
+    return;
+  }
+
+  equalityDeleteRows_.resizeFill(numRows);
+  std::vector<VectorPtr> keys;
+  for (const auto& equalityDelete : equalityDeletes_) {
+    keys.clear();
+    for (auto channel : equalityDelete.channels) {
+      keys.push_back(
+          BaseVector::loadedVectorShared(rowVector->childAt(channel)));
+    }
+    equalityDelete.deleteSet->removeDeleted(keys, equalityDeleteRows_);
+    if (!equalityDeleteRows_.hasSelections()) {
+      break;
+    }
+  }
+
+  const auto numPassed = equalityDeleteRows_.countSelected();
+  if (numPassed == numRows) {
+    return;
+  }
+
+  auto indices = allocateIndices(numPassed, pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  equalityDeleteRows_.applyToSelected(
+      [&](vector_size_t row) { rawIndices[numIndices++] = row; });
+
+  std::vector<VectorPtr> children;
+  children.reserve(numOutputColumns);
+  for (auto i = 0; i < numOutputColumns; ++i) {
+    children.push_back(BaseVector::wrapInDictionary(
+        nullptr, indices, numPassed, rowVector->childAt(i)));
+  }
+  output = std::make_shared<RowVector>(
+      pool_, readerOutputType_, nullptr, numPassed, std::move(children));
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -39,7 +40,7 @@ class IcebergSplitReader : public SplitReader {
       folly::Executor* executor,
       const std::shared_ptr<common::ScanSpec>& scanSpec);
 
-  ~IcebergSplitReader() override = default;
+  ~IcebergSplitReader() override;
 
   void prepareSplit(
       std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -48,7 +49,47 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  /// Positional deletes are resolved against the rows of the whole split, so
+  /// the split is not shared with other drivers.
+  std::shared_ptr<StealableSplit> stealableSplit() const override {
+    return nullptr;
+  }
+
  private:
+  // An equality delete set applied to the rows produced by the base row
+  // reader. 'channels' are the positions of the equality columns in
+  // 'readerOutput_'.
+  struct EqualityDelete {
+    EqualityDeleteSetCachedPtr deleteSet;
+    std::vector<column_index_t> channels;
+  };
+
+  // Equality delete sets with at most this many values are pushed down into
+  // the scan as a filter instead of being applied after the scan.
+  static constexpr size_t kMaxEqualityDeletePushdownValues = 10'000;
+
+  // Loads the equality delete set of 'deleteFile' and either pushes it down
+  // into 'scanSpec_' or adds it to 'equalityDeletes_'.
+  void addEqualityDeletes(const IcebergDeleteFile& deleteFile);
+
+  // Returns the channel of the equality column 'name' in 'readerOutput_'. A
+  // column not in 'readerOutputType_' is added to 'scanSpec_' for this split
+  // after the output columns and is dropped from the output of next().
+  column_index_t equalityDeleteChannel(
+      const std::string& name,
+      const TypePtr& type);
+
+  // Loads the positional delete sets of the base file from 'deleteFiles' into
+  // 'positionalDeleteSets_'. The delete files are read in parallel on
+  // 'executor_'.
+  void loadPositionalDeletes(
+      const std::vector<IcebergDeleteFile>& deleteFiles,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  // Removes the rows deleted by 'equalityDeletes_' from 'readerOutput_' and
+  // returns the result in 'output'.
+  void applyEqualityDeletes(VectorPtr& output);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -56,8 +97,36 @@ class IcebergSplitReader : public SplitReader {
   // The file position for the first row in the split
   uint64_t splitOffset_;
 
-  std::list<std::unique_ptr<PositionalDeleteFileReader>>
-      positionalDeleteFileReaders_;
+  // The positions deleted from the base file by its positional delete files.
+  // Sets are dropped once the read passes their last position.
+  std::vector<PositionalDeleteSetCachedPtr> positionalDeleteSets_;
   BufferPtr deleteBitmap_;
+
+  std::vector<EqualityDelete> equalityDeletes_;
+
+  // The filters of 'scanSpec_' before equality deletes were pushed down. The
+  // scan spec is shared by all the splits of the data source, so these are
+  // restored when the split is done.
+  std::vector<std::pair<common::ScanSpec*, std::unique_ptr<common::Filter>>>
+      replacedFilters_;
+
+  // Equality columns read only to apply equality deletes. Their channels in
+  // 'readerOutput_' follow those of 'readerOutputType_'.
+  std::vector<std::string> equalityOnlyNames_;
+  std::vector<TypePtr> equalityOnlyTypes_;
+
+  // Children added to 'scanSpec_' for 'equalityOnlyNames_' and removed when
+  // the split is done.
+  std::vector<std::string> addedChildSpecs_;
+
+  // Filter only children of 'scanSpec_' projected out for
+  // 'equalityOnlyNames_' with their previous channels. These are restored
+  // when the split is done.
+  std::vector<std::pair<common::ScanSpec*, column_index_t>>
+      projectedChildSpecs_;
+
+  // Output of the base row reader when there are equality deletes to apply.
+  VectorPtr readerOutput_;
+  SelectivityVector equalityDeleteRows_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
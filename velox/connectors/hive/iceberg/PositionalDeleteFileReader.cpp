@@ -24,6 +24,189 @@
 
 namespace facebook::velox::connector::hive::iceberg {
 
+namespace {
+
+// The number of delete positions read at a time.
+constexpr uint64_t kReadBatchSize = 10'000;
+
+// Cached sets are pinned while in use, so the capacity only bounds the memory
+// retained by sets of scans that are no longer running.
+constexpr uint64_t kPositionalDeleteCacheBytes = 256 << 20;
+
+struct PositionalDeleteSetGenerator {
+  std::unique_ptr<PositionalDeleteSet> operator()(
+      const std::string& /*key*/,
+      const PositionalDeleteFileReader* reader) {
+    return reader->read();
+  }
+};
+
+struct PositionalDeleteSetSizer {
+  uint64_t operator()(const PositionalDeleteSet& deleteSet) {
+    return deleteSet.byteSize();
+  }
+};
+
+using PositionalDeleteSetFactory = CachedFactory<
+    std::string,
+    PositionalDeleteSet,
+    PositionalDeleteSetGenerator,
+    PositionalDeleteFileReader,
+    PositionalDeleteSetSizer>;
+
+PositionalDeleteSetFactory& positionalDeleteSetFactory() {
+  // Never destroyed so that sets pinned at process exit do not trip the cache
+  // destructor checks.
+  static auto* factory = new PositionalDeleteSetFactory(
+      std::make_unique<SimpleLRUCache<std::string, PositionalDeleteSet>>(
+          kPositionalDeleteCacheBytes),
+      std::make_unique<PositionalDeleteSetGenerator>());
+  return *factory;
+}
+
+} // namespace
+
+void PositionalDeleteSet::add(int64_t position) {
+  VELOX_CHECK_GE(position, 0, "Negative Iceberg delete position");
+  const auto base = position & ~(kChunkSize - 1);
+  const uint16_t offset = position - base;
+  maxPosition_ = std::max(maxPosition_, position);
+  auto& chunk = chunkFor(base);
+  if (!chunk.bits.empty()) {
+    if (!bits::isBitSet(chunk.bits.data(), offset)) {
+      bits::setBit(chunk.bits.data(), offset);
+      ++chunk.size;
+      ++size_;
+    }
+    return;
+  }
+  auto& offsets = chunk.offsets;
+  if (offsets.empty() || offsets.back() < offset) {
+    offsets.push_back(offset);
+  } else {
+    auto it = std::lower_bound(offsets.begin(), offsets.end(), offset);
+    if (*it == offset) {
+      return;
+    }
+    offsets.insert(it, offset);
+  }
+  ++chunk.size;
+  ++size_;
+  if (chunk.size > kMaxArraySize) {
+    toBitmap(chunk);
+  }
+}
+
+PositionalDeleteSet::Chunk& PositionalDeleteSet::chunkFor(int64_t base) {
+  if (chunks_.empty() || chunks_.back().base < base) {
+    chunks_.emplace_back().base = base;
+    return chunks_.back();
+  }
+  if (chunks_.back().base == base) {
+    return chunks_.back();
+  }
+  auto it = std::lower_bound(
+      chunks_.begin(), chunks_.end(), base, [](const Chunk& chunk, auto value) {
+        return chunk.base < value;
+      });
+  if (it->base != base) {
+    it = chunks_.emplace(it);
+    it->base = base;
+  }
+  return *it;
+}
+
+// static
+void PositionalDeleteSet::toBitmap(Chunk& chunk) {
+  chunk.bits.resize(bits::nwords(kChunkSize));
+  for (auto offset : chunk.offsets) {
+    bits::setBit(chunk.bits.data(), offset);
+  }
+  chunk.offsets.clear();
+  chunk.offsets.shrink_to_fit();
+}
+
+bool PositionalDeleteSet::apply(
+    int64_t begin,
+    uint64_t numRows,
+    uint64_t* deleteBitmap) const {
+  const int64_t end = begin + numRows;
+  auto it = std::lower_bound(
+      chunks_.begin(),
+      chunks_.end(),
+      begin - kChunkSize,
+      [](const Chunk& chunk, auto value) { return chunk.base <= value; });
+  bool anyDeleted = false;
+  for (; it != chunks_.end() && it->base < end; ++it) {
+    const auto& chunk = *it;
+    const auto chunkBegin = std::max(begin, chunk.base);
+    const auto chunkEnd = std::min(end, chunk.base + kChunkSize);
+    if (!chunk.bits.empty()) {
+      anyDeleted |=
+          applyBits(chunk, chunkBegin, chunkEnd, begin, deleteBitmap);
+      continue;
+    }
+    auto offset = std::lower_bound(
+        chunk.offsets.begin(), chunk.offsets.end(), chunkBegin - chunk.base);
+    for (; offset != chunk.offsets.end() && chunk.base + *offset < chunkEnd;
+         ++offset) {
+      bits::setBit(deleteBitmap, chunk.base + *offset - begin);
+      anyDeleted = true;
+    }
+  }
+  return anyDeleted;
+}
+
+// static
+bool PositionalDeleteSet::applyBits(
+    const Chunk& chunk,
+    int64_t begin,
+    int64_t end,
+    int64_t bitmapBegin,
+    uint64_t* deleteBitmap) {
+  // Ors a word of the chunk at a time, shifted to the bit position it has in
+  // 'deleteBitmap'.
+  const int32_t firstBit = begin - chunk.base;
+  const int32_t lastBit = end - chunk.base;
+  const int32_t lastWord = (lastBit - 1) / 64;
+  bool anyDeleted = false;
+  for (auto i = firstBit / 64; i <= lastWord; ++i) {
+    auto word = chunk.bits[i];
+    if (i == firstBit / 64) {
+      word &= ~0ULL << (firstBit % 64);
+    }
+    if (i == lastWord && lastBit % 64 != 0) {
+      word &= bits::lowMask(lastBit % 64);
+    }
+    if (word == 0) {
+      continue;
+    }
+    anyDeleted = true;
+    const int64_t targetBit = chunk.base + i * 64 - bitmapBegin;
+    if (targetBit < 0) {
+      // Only the first word can start before the bitmap and its bits below
+      // 'begin' are masked off.
+      deleteBitmap[0] |= word >> -targetBit;
+      continue;
+    }
+    const auto shift = targetBit % 64;
+    deleteBitmap[targetBit / 64] |= word << shift;
+    if (shift != 0 && (word >> (64 - shift)) != 0) {
+      deleteBitmap[targetBit / 64 + 1] |= word >> (64 - shift);
+    }
+  }
+  return anyDeleted;
+}
+
+uint64_t PositionalDeleteSet::byteSize() const {
+  uint64_t bytes = sizeof(*this) + chunks_.capacity() * sizeof(Chunk);
+  for (const auto& chunk : chunks_) {
+    bytes += chunk.offsets.capacity() * sizeof(uint16_t) +
+        chunk.bits.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
 PositionalDeleteFileReader::PositionalDeleteFileReader(
     const IcebergDeleteFile& deleteFile,
     const std::string& baseFilePath,
@@ -33,32 +216,28 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     const std::shared_ptr<const HiveConfig>& hiveConfig,
     const std::shared_ptr<io::IoStatistics>& ioStats,
     dwio::common::RuntimeStatistics& runtimeStats,
-    uint64_t splitOffset,
     const std::string& connectorId)
     : deleteFile_(deleteFile),
       baseFilePath_(baseFilePath),
       fileHandleFactory_(fileHandleFactory),
+      connectorQueryCtx_(connectorQueryCtx),
       executor_(executor),
       hiveConfig_(hiveConfig),
       ioStats_(ioStats),
+      runtimeStats_(runtimeStats),
       pool_(connectorQueryCtx->memoryPool()),
+      connectorId_(connectorId),
       filePathColumn_(IcebergMetadataColumn::icebergDeleteFilePathColumn()),
-      posColumn_(IcebergMetadataColumn::icebergDeletePosColumn()),
-      splitOffset_(splitOffset),
-      deleteSplit_(nullptr),
-      deleteRowReader_(nullptr),
-      deletePositionsOutput_(nullptr),
-      deletePositionsOffset_(0),
-      endOfFile_(false) {
+      posColumn_(IcebergMetadataColumn::icebergDeletePosColumn()) {
   VELOX_CHECK(deleteFile_.content == FileContent::kPositionalDeletes);
+}
 
+std::unique_ptr<PositionalDeleteSet> PositionalDeleteFileReader::read() const {
+  auto deleteSet = std::make_unique<PositionalDeleteSet>();
   if (deleteFile_.recordCount == 0) {
-    return;
+    return deleteSet;
   }
 
-  // TODO: check if the lowerbounds and upperbounds in deleteFile overlap with
-  //  this batch. If not, no need to proceed.
-
   // Create the ScanSpec for this delete file
   auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
   scanSpec->addField(posColumn_->name, 0);
@@ -75,8 +254,8 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
   RowTypePtr deleteFileSchema =
       ROW(std::move(deleteColumnNames), std::move(deleteColumnTypes));
 
-  deleteSplit_ = std::make_shared<HiveConnectorSplit>(
-      connectorId,
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId_,
       deleteFile_.filePath,
       deleteFile_.fileFormat,
       0,
@@ -88,16 +267,16 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
   configureReaderOptions(
       deleteReaderOpts,
       hiveConfig_,
-      connectorQueryCtx,
+      connectorQueryCtx_,
       deleteFileSchema,
-      deleteSplit_);
+      deleteSplit);
 
   auto deleteFileHandleCachePtr =
       fileHandleFactory_->generate(deleteFile_.filePath);
   auto deleteFileInput = createBufferedInput(
       *deleteFileHandleCachePtr,
       deleteReaderOpts,
-      connectorQueryCtx,
+      connectorQueryCtx_,
       ioStats_,
       executor_);
 
@@ -105,20 +284,17 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
           ->createReader(std::move(deleteFileInput), deleteReaderOpts);
 
-  // Check if the whole delete file split can be skipped. This could happen when
-  // 1) the delete file doesn't contain the base file that is being read; 2) The
-  // delete file does not contain the positions in the current batch for the
-  // base file.
+  // Check if the whole delete file split can be skipped. This happens when the
+  // delete file doesn't contain the base file that is being read.
   if (!testFilters(
           scanSpec.get(),
           deleteReader.get(),
-          deleteSplit_->filePath,
-          deleteSplit_->partitionKeys,
+          deleteSplit->filePath,
+          deleteSplit->partitionKeys,
           {})) {
-    ++runtimeStats.skippedSplits;
-    runtimeStats.skippedSplitBytes += deleteSplit_->length;
-    deleteSplit_.reset();
-    return;
+    ++runtimeStats_.skippedSplits;
+    runtimeStats_.skippedSplitBytes += deleteSplit->length;
+    return deleteSet;
   }
 
   dwio::common::RowReaderOptions deleteRowReaderOpts;
@@ -128,115 +304,37 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       scanSpec,
       nullptr,
       deleteFileSchema,
-      deleteSplit_);
-
-  deleteRowReader_.reset();
-  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
-}
-
-void PositionalDeleteFileReader::readDeletePositions(
-    uint64_t baseReadOffset,
-    uint64_t size,
-    int8_t* deleteBitmap) {
-  // We are going to read to the row number up to the end of the batch. For the
-  // same base file, the deleted rows are in ascending order in the same delete
-  // file
-  int64_t rowNumberUpperBound = splitOffset_ + baseReadOffset + size;
-
-  // Finish unused delete positions from last batch
-  if (deletePositionsOutput_ &&
-      deletePositionsOffset_ < deletePositionsOutput_->size()) {
-    updateDeleteBitmap(
-        std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-            ->childAt(0),
-        baseReadOffset,
-        rowNumberUpperBound,
-        deleteBitmap);
-
-    if (readFinishedForBatch(rowNumberUpperBound)) {
-      return;
-    }
-  }
+      deleteSplit);
 
-  if (!deleteRowReader_ || !deleteSplit_) {
-    return;
-  }
-
-  // Read the new delete positions for this batch into deletePositionsOutput_
-  // and update the delete bitmap
-
-  auto outputType = posColumn_->type;
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
 
   RowTypePtr outputRowType = ROW({posColumn_->name}, {posColumn_->type});
-  if (!deletePositionsOutput_) {
-    deletePositionsOutput_ = BaseVector::create(outputRowType, 0, pool_);
-  }
-
-  while (!readFinishedForBatch(rowNumberUpperBound)) {
-    auto rowsScanned = deleteRowReader_->next(size, deletePositionsOutput_);
-    if (rowsScanned > 0) {
-      VELOX_CHECK(
-          !deletePositionsOutput_->mayHaveNulls(),
-          "Iceberg delete file pos column cannot have nulls");
-
-      auto numDeletedRows = deletePositionsOutput_->size();
-      if (numDeletedRows > 0) {
-        deletePositionsOutput_->loadedVector();
-        deletePositionsOffset_ = 0;
-
-        updateDeleteBitmap(
-            std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-                ->childAt(0),
-            baseReadOffset,
-            rowNumberUpperBound,
-            deleteBitmap);
-      }
-    } else {
-      // Reaching the end of the file
-      endOfFile_ = true;
-      deleteSplit_.reset();
-      return;
+  VectorPtr output = BaseVector::create(outputRowType, 0, pool_);
+  while (deleteRowReader->next(kReadBatchSize, output) > 0) {
+    if (output->size() == 0) {
+      continue;
+    }
+    auto deletePositionsVector = BaseVector::loadedVectorShared(
+        output->asUnchecked<RowVector>()->childAt(0));
+    VELOX_CHECK(
+        !deletePositionsVector->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    const int64_t* deletePositions =
+        deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
+    for (auto i = 0; i < deletePositionsVector->size(); ++i) {
+      deleteSet->add(deletePositions[i]);
     }
   }
+  return deleteSet;
 }
 
-bool PositionalDeleteFileReader::endOfFile() {
-  return endOfFile_;
-}
-
-void PositionalDeleteFileReader::updateDeleteBitmap(
-    VectorPtr deletePositionsVector,
-    uint64_t baseReadOffset,
-    int64_t rowNumberUpperBound,
-    int8_t* deleteBitmap) {
-  // Convert the positions in file into positions relative to the start of the
-  // split.
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-  int64_t offset = baseReadOffset + splitOffset_;
-  while (deletePositionsOffset_ < deletePositionsVector->size() &&
-         deletePositions[deletePositionsOffset_] < rowNumberUpperBound) {
-    bits::setBit(
-        deleteBitmap, deletePositions[deletePositionsOffset_] - offset);
-    deletePositionsOffset_++;
-  }
-}
-
-bool PositionalDeleteFileReader::readFinishedForBatch(
-    int64_t rowNumberUpperBound) {
-  VELOX_CHECK_NOT_NULL(deletePositionsOutput_);
-
-  auto deletePositionsVector =
-      std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)->childAt(0);
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-
-  if (deletePositionsOutput_->size() != 0 &&
-      deletePositionsOffset_ < deletePositionsVector->size() &&
-      deletePositions[deletePositionsOffset_] >= rowNumberUpperBound) {
-    return true;
-  }
-  return false;
+PositionalDeleteSetCachedPtr getPositionalDeleteSet(
+    const std::string& scanId,
+    const std::string& deleteFilePath,
+    const std::string& baseFilePath,
+    const PositionalDeleteFileReader& reader) {
+  return positionalDeleteSetFactory().generate(
+      fmt::format("{}:{}:{}", scanId, deleteFilePath, baseFilePath), &reader);
 }
 
 } // namespace facebook::velox::connector::hive::iceberg
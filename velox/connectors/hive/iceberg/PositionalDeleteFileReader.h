@@ -19,6 +19,7 @@
 #include <folly/Executor.h>
 #include <memory>
 
+#include "velox/common/caching/CachedFactory.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
@@ -33,8 +34,74 @@ struct IcebergMetadataColumn;
 using SubfieldFilters =
     std::unordered_map<common::Subfield, std::unique_ptr<common::Filter>>;
 
+/// The positions of the rows of one base data file deleted by one Iceberg
+/// positional delete file. The positions are kept in a compressed bitmap in
+/// the manner of roaring bitmaps: positions are grouped in chunks of 64K rows
+/// and a chunk is a sorted array of 16 bit offsets while sparse and a bitmap
+/// once dense.
+class PositionalDeleteSet {
+ public:
+  /// Adds 'position' to the set. Positions are expected to come in ascending
+  /// order, as Iceberg requires for delete files, but any order is accepted.
+  void add(int64_t position);
+
+  /// Sets bit i of 'deleteBitmap' for each deleted position 'begin' + i for i
+  /// in [0, 'numRows'). Does not clear bits. Returns true if any bit was set.
+  bool apply(int64_t begin, uint64_t numRows, uint64_t* deleteBitmap) const;
+
+  /// Returns the number of deleted positions.
+  uint64_t size() const {
+    return size_;
+  }
+
+  /// Returns the largest deleted position or -1 if 'this' is empty.
+  int64_t maxPosition() const {
+    return maxPosition_;
+  }
+
+  /// Returns an estimate of the memory used by 'this'.
+  uint64_t byteSize() const;
+
+ private:
+  static constexpr int32_t kChunkBits = 16;
+  static constexpr int64_t kChunkSize = 1L << kChunkBits;
+  // A chunk with more positions than this is a bitmap, which is then smaller.
+  static constexpr int32_t kMaxArraySize = kChunkSize / 16;
+
+  struct Chunk {
+    // The position of the first row of the chunk, a multiple of kChunkSize.
+    int64_t base;
+    // The offsets from 'base' in ascending order if the chunk is sparse.
+    std::vector<uint16_t> offsets;
+    // kChunkSize bits if the chunk is dense.
+    std::vector<uint64_t> bits;
+    uint32_t size{0};
+  };
+
+  Chunk& chunkFor(int64_t base);
+
+  static void toBitmap(Chunk& chunk);
+
+  // Ors the bits of 'chunk' for positions [begin, end) into 'deleteBitmap',
+  // in which bit 0 is position 'bitmapBegin'.
+  static bool applyBits(
+      const Chunk& chunk,
+      int64_t begin,
+      int64_t end,
+      int64_t bitmapBegin,
+      uint64_t* deleteBitmap);
+
+  // Sorted by 'base'.
+  std::vector<Chunk> chunks_;
+  uint64_t size_{0};
+  int64_t maxPosition_{-1};
+};
+
+/// Reads the positions deleted from one base data file by one Iceberg
+/// positional delete file into a PositionalDeleteSet.
 class PositionalDeleteFileReader {
  public:
+  /// Skipped delete files are counted in 'runtimeStats' by read().
   PositionalDeleteFileReader(
       const IcebergDeleteFile& deleteFile,
       const std::string& baseFilePath,
@@ -44,42 +111,39 @@ class PositionalDeleteFileReader {
       const std::shared_ptr<const HiveConfig>& hiveConfig,
       const std::shared_ptr<io::IoStatistics>& ioStats,
       dwio::common::RuntimeStatistics& runtimeStats,
-      uint64_t splitOffset,
       const std::string& connectorId);
 
-  void readDeletePositions(
-      uint64_t baseReadOffset,
-      uint64_t size,
-      int8_t* deleteBitmap);
-
-  bool endOfFile();
+  /// Reads all the positions the delete file deletes from the base file.
+  std::unique_ptr<PositionalDeleteSet> read() const;
 
  private:
-  void updateDeleteBitmap(
-      VectorPtr deletePositionsVector,
-      uint64_t baseReadOffset,
-      int64_t rowNumberUpperBound,
-      int8_t* deleteBitmap);
-
-  bool readFinishedForBatch(int64_t rowNumberUpperBound);
-
   const IcebergDeleteFile& deleteFile_;
   const std::string& baseFilePath_;
   FileHandleFactory* const fileHandleFactory_;
+  const ConnectorQueryCtx* const connectorQueryCtx_;
   folly::Executor* const executor_;
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const std::shared_ptr<io::IoStatistics> ioStats_;
+  dwio::common::RuntimeStatistics& runtimeStats_;
   memory::MemoryPool* const pool_;
+  const std::string connectorId_;
 
   std::shared_ptr<IcebergMetadataColumn> filePathColumn_;
   std::shared_ptr<IcebergMetadataColumn> posColumn_;
-  uint64_t splitOffset_;
-
-  std::shared_ptr<HiveConnectorSplit> deleteSplit_;
-  std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
-  VectorPtr deletePositionsOutput_;
-  uint64_t deletePositionsOffset_;
-  bool endOfFile_;
 };
 
+using PositionalDeleteSetCachedPtr =
+    CachedPtr<std::string, PositionalDeleteSet>;
+
+/// Returns the PositionalDeleteSet of the base and delete files of 'reader',
+/// reading it only if not cached. The sets are cached by 'scanId', delete file
+/// path and base file path so that the splits of a base file in a table scan
+/// read each of its delete files once. Concurrent requests for the same set
+/// wait for the first one.
+PositionalDeleteSetCachedPtr getPositionalDeleteSet(
+    const std::string& scanId,
+    const std::string& deleteFilePath,
+    const std::string& baseFilePath,
+    const PositionalDeleteFileReader& reader);
+
 } // namespace facebook::velox::connector::hive::iceberg
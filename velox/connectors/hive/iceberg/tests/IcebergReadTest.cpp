@@ -14,11 +14,13 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -92,6 +94,46 @@ class HiveIcebergTest : public HiveConnectorTestBase {
         makeNotInList(deleteRowsVec) + ")";
   }
 
+  /// Deletes the values in 'deleteValuesVec' from column c0 of each of
+  /// 'splitCount' base files, with one equality delete file per inner vector.
+  void assertEqualityDeletes(
+      const std::vector<std::vector<int64_t>>& deleteValuesVec,
+      std::string duckdbSql,
+      int32_t splitCount = 1,
+      int32_t numPrefetchSplits = 0) {
+    auto dataFilePaths = writeDataFile(splitCount, rowCount);
+    // Keep the reference to the deleteFilePath, otherwise the corresponding
+    // file will be deleted.
+    std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+    std::vector<IcebergDeleteFile> deleteFiles;
+    for (const auto& deleteValues : deleteValuesVec) {
+      auto deleteFilePath = TempFilePath::create();
+      writeToFile(
+          deleteFilePath->getPath(),
+          makeRowVector(
+              {"c0"}, {vectorMaker_.flatVector<int64_t>(deleteValues)}));
+      auto path = deleteFilePath->getPath();
+      deleteFiles.emplace_back(
+          FileContent::kEqualityDeletes,
+          path,
+          fileFomat_,
+          deleteValues.size(),
+          testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+          std::vector<int32_t>{1});
+      deleteFilePaths.emplace_back(deleteFilePath);
+    }
+
+    // All the splits share the delete files.
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& dataFilePath : dataFilePaths) {
+      splits.emplace_back(
+          makeIcebergSplit(dataFilePath->getPath(), deleteFiles));
+    }
+
+    HiveConnectorTestBase::assertQuery(
+        tableScanNode(), splits, duckdbSql, numPrefetchSplits);
+  }
+
   const static int rowCount = 20000;
 
  private:
@@ -347,4 +389,161 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
       deletedRows, getQuery(deletedRows), splitCount, numPrefetchSplits);
 }
 
+TEST_F(HiveIcebergTest, densePositionalDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // Enough positions per delete file for the delete sets to become bitmaps.
+  std::vector<std::vector<int64_t>> deletedRows(3);
+  for (auto i = 0; i < 20000; ++i) {
+    if (i % 3 != 2) {
+      deletedRows[i % 3].push_back(i);
+    }
+  }
+  assertPositionalDeletes(deletedRows);
+}
+
+TEST(PositionalDeleteSetTest, apply) {
+  // Every 101st row keeps the chunks sorted arrays, every 7th row makes them
+  // bitmaps.
+  for (int64_t step : {101, 7}) {
+    SCOPED_TRACE(fmt::format("step {}", step));
+    PositionalDeleteSet deleteSet;
+    for (int64_t i = 0; i < 200'000; i += step) {
+      deleteSet.add(i);
+    }
+    // Out of order and duplicate positions.
+    deleteSet.add(5);
+    deleteSet.add(step * 2);
+    deleteSet.add(step * 1'000);
+    ASSERT_EQ(deleteSet.size(), (200'000 + step - 1) / step + 1);
+    ASSERT_EQ(deleteSet.maxPosition(), (200'000 - 1) / step * step);
+
+    for (auto [begin, numRows] : std::vector<std::pair<int64_t, uint64_t>>{
+             {0, 100}, {3, 1'000}, {65'500, 200}, {131'000, 20'000}}) {
+      std::vector<uint64_t> bitmap(bits::nwords(numRows));
+      deleteSet.apply(begin, numRows, bitmap.data());
+      for (auto i = 0; i < numRows; ++i) {
+        const auto position = begin + i;
+        ASSERT_EQ(
+            bits::isBitSet(bitmap.data(), i),
+            position % step == 0 || position == 5)
+            << position;
+      }
+    }
+  }
+}
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // Small delete sets are pushed down into the scan.
+  assertEqualityDeletes({{0, 1, 2, 3}}, getQuery({{0, 1, 2, 3}}));
+  assertEqualityDeletes(
+      {{0, 9999, 10000, 19999}}, getQuery({{0, 9999, 10000, 19999}}));
+  // Several delete files for the same column.
+  assertEqualityDeletes(
+      {{1}, {5, 7}, {19999}}, getQuery({{1}, {5, 7}, {19999}}));
+  // Values that don't exist.
+  assertEqualityDeletes({{20000, 29999}}, "SELECT * FROM tmp");
+
+  // Large delete sets are applied after the scan.
+  std::vector<int64_t> evenValues;
+  for (auto i = 0; i < 30000; i += 2) {
+    evenValues.push_back(i);
+  }
+  assertEqualityDeletes({evenValues}, "SELECT * FROM tmp WHERE c0 % 2 = 1");
+  // Delete all rows.
+  assertEqualityDeletes(
+      {makeSequenceRows(rowCount)}, "SELECT * FROM tmp WHERE 1 = 0");
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesMultipleSplits) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  constexpr int32_t splitCount = 20;
+  constexpr int32_t numPrefetchSplits = 5;
+  std::vector<std::vector<int64_t>> deletedValues = {{1}, {2}, {3, 4}};
+  assertEqualityDeletes(
+      deletedValues, getQuery(deletedValues), splitCount, numPrefetchSplits);
+
+  std::vector<int64_t> evenValues;
+  for (auto i = 0; i < 30000; i += 2) {
+    evenValues.push_back(i);
+  }
+  assertEqualityDeletes(
+      {evenValues},
+      "SELECT * FROM tmp WHERE c0 % 2 = 1",
+      splitCount,
+      numPrefetchSplits);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesOnUnprojectedColumn) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // The table had a column between c0 and c1 that was dropped, so the field
+  // id of c1 is 3 and no longer its position.
+  auto dataColumns = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto data = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(rowCount, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(rowCount, [](auto row) { return row * 10; })});
+  auto dataFilePath = TempFilePath::create();
+  writeToFile(dataFilePath->getPath(), data);
+  createDuckDbTable({data});
+
+  std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+  auto writeDeleteFile = [&](const std::vector<int64_t>& deleteValues) {
+    deleteFilePaths.push_back(TempFilePath::create());
+    auto path = deleteFilePaths.back()->getPath();
+    writeToFile(
+        path, makeRowVector({"c1"}, {makeFlatVector<int64_t>(deleteValues)}));
+    return makeIcebergSplit(
+        dataFilePath->getPath(),
+        {IcebergDeleteFile(
+            FileContent::kEqualityDeletes,
+            path,
+            fileFomat_,
+            deleteValues.size(),
+            testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+            std::vector<int32_t>{3})});
+  };
+
+  // c1 is read for the deletes but not returned.
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(ROW({"c0"}, {BIGINT()}), {}, "", dataColumns)
+                  .planNode();
+  assertQuery(
+      plan,
+      {writeDeleteFile({0, 50, 100})},
+      "SELECT c0 FROM tmp WHERE c1 NOT IN (0, 50, 100)",
+      0);
+
+  // c1 has a filter but is not projected. The small delete set is pushed down
+  // into the filter and the large one is applied after the scan.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(
+                 ROW({"c0"}, {BIGINT()}), {"c1 >= 100"}, "", dataColumns)
+             .planNode();
+  assertQuery(
+      plan,
+      {writeDeleteFile({0, 50, 100, 150})},
+      "SELECT c0 FROM tmp WHERE c1 >= 100 AND c1 NOT IN (100, 150)",
+      0);
+  std::vector<int64_t> evenValues;
+  for (auto i = 0; i < rowCount * 20; i += 20) {
+    evenValues.push_back(i);
+  }
+  assertQuery(
+      plan,
+      {writeDeleteFile(evenValues)},
+      "SELECT c0 FROM tmp WHERE c1 >= 100 AND c0 % 2 = 1",
+      0);
+
+  // A delete file column that is not in the table.
+  auto c0Type = ROW({"c0"}, {BIGINT()});
+  plan = PlanBuilder(pool_.get()).tableScan(c0Type, {}, "", c0Type).planNode();
+  VELOX_ASSERT_THROW(
+      assertQuery(plan, {writeDeleteFile({0})}, "SELECT c0 FROM tmp", 0),
+      "Iceberg equality delete column c1");
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
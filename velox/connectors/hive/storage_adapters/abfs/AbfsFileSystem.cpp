@@ -19,6 +19,7 @@
 #include <azure/storage/blobs/blob_client.hpp>
 #include <fmt/format.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <glog/logging.h>
 
 #include "velox/common/file/File.h"
@@ -225,10 +226,20 @@ uint64_t AbfsReadFile::getNaturalReadSize() const {
 class AbfsFileSystem::Impl {
  public:
   explicit Impl(const Config* config) : abfsConfig_(config) {
+    const connector::hive::HiveConfig hiveConfig(
+        std::make_shared<core::MemConfig>(config->values()));
+    if (const auto numThreads = hiveConfig.abfsUploadThreads();
+        numThreads > 0) {
+      uploadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          numThreads,
+          std::make_shared<folly::NamedThreadFactory>("AbfsUpload"));
+    }
+    maxInFlightUploadBlocks_ = hiveConfig.abfsMaxInFlightUploadBlocks();
     LOG(INFO) << "Init Azure Blob file system";
   }
 
   ~Impl() {
+    uploadExecutor_.reset();
     LOG(INFO) << "Dispose Azure Blob file system";
   }
 
@@ -237,9 +248,20 @@ class AbfsFileSystem::Impl {
     return abfsConfig_.connectionString(path);
   }
 
+  // Returns the executor for asynchronous block uploads or nullptr if
+  // appends are uploaded synchronously.
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  int32_t maxInFlightUploadBlocks() const {
+    return maxInFlightUploadBlocks_;
+  }
+
  private:
   const AbfsConfig abfsConfig_;
-  std::shared_ptr<folly::Executor> ioExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
+  int32_t maxInFlightUploadBlocks_;
 };
 
 AbfsFileSystem::AbfsFileSystem(const std::shared_ptr<const Config>& config)
@@ -262,9 +284,13 @@ std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
 
 std::unique_ptr<WriteFile> AbfsFileSystem::openFileForWrite(
     std::string_view path,
-    const FileOptions& /*unused*/) {
+    const FileOptions& options) {
   auto abfsfile = std::make_unique<AbfsWriteFile>(
-      std::string(path), impl_->connectionString(std::string(path)));
+      std::string(path),
+      impl_->connectionString(std::string(path)),
+      options.pool,
+      impl_->uploadExecutor(),
+      impl_->maxInFlightUploadBlocks());
   abfsfile->initialize();
   return abfsfile;
 }
@@ -17,6 +17,13 @@
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
 
 #include <azure/storage/files/datalake.hpp>
+#include <folly/futures/Future.h>
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "velox/dwio/common/DataBuffer.h"
 
 namespace facebook::velox::filesystems::abfs {
 class BlobStorageFileClient final : public IBlobStorageFileClient {
@@ -51,8 +58,21 @@ class BlobStorageFileClient final : public IBlobStorageFileClient {
 
 class AbfsWriteFile::Impl {
  public:
-  explicit Impl(const std::string& path, const std::string& connectStr)
-      : path_(path), connectStr_(connectStr) {
+  explicit Impl(
+      const std::string& path,
+      const std::string& connectStr,
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor,
+      int32_t maxInFlightBlocks)
+      : path_(path),
+        connectStr_(connectStr),
+        pool_(pool),
+        uploadExecutor_(pool != nullptr ? uploadExecutor : nullptr),
+        maxInFlightBlocks_(maxInFlightBlocks) {
+    VELOX_CHECK_GT(maxInFlightBlocks_, 0);
+    if (uploadExecutor_ != nullptr) {
+      currentBlock_ = newBlock();
+    }
     // Make it a no-op if invoked twice.
     if (position_ != -1) {
       return;
@@ -60,6 +80,14 @@ class AbfsWriteFile::Impl {
     position_ = 0;
   }
 
+  ~Impl() {
+    // The pending uploads write from buffers allocated from 'pool_'.
+    while (!pendingBlocks_.empty()) {
+      pendingBlocks_.front().wait();
+      pendingBlocks_.pop_front();
+    }
+  }
+
   void initialize() {
     if (!blobStorageFileClient_) {
       auto abfsAccount = AbfsAccount(path_);
@@ -85,11 +113,17 @@ class AbfsWriteFile::Impl {
       flush();
       blobStorageFileClient_->close();
       closed_ = true;
+      // Returns the block buffers to the pool.
+      currentBlock_.reset();
+      freeBlocks_.clear();
     }
   }
 
   void flush() {
     if (!closed_) {
+      if (uploadExecutor_ != nullptr) {
+        uploadBlocks();
+      }
       blobStorageFileClient_->flush(position_);
     }
   }
@@ -107,12 +141,98 @@ class AbfsWriteFile::Impl {
   }
 
   void append(const char* buffer, size_t size) {
+    if (uploadExecutor_ != nullptr) {
+      appendToBlocks(buffer, size);
+      return;
+    }
     blobStorageFileClient_->append(
         reinterpret_cast<const uint8_t*>(buffer), size, position_);
     position_ += size;
   }
 
  private:
+  using Block = dwio::common::DataBuffer<char>;
+
+  // Copies 'buffer' into 'currentBlock_' and uploads each block that fills up
+  // on 'uploadExecutor_'. 'buffer' is not valid after append() returns.
+  void appendToBlocks(const char* buffer, size_t size) {
+    while (size > 0) {
+      const auto numBytes =
+          std::min<size_t>(size, kNaturalWriteSize - currentBlock_->size());
+      currentBlock_->unsafeAppend(buffer, numBytes);
+      buffer += numBytes;
+      size -= numBytes;
+      position_ += numBytes;
+      if (currentBlock_->size() == kNaturalWriteSize) {
+        uploadBlockAsync(std::exchange(currentBlock_, newBlock()));
+      }
+    }
+  }
+
+  // Uploads 'block' at 'blockOffset_' on 'uploadExecutor_'. Waits for the
+  // oldest pending block first if 'maxInFlightBlocks_' blocks are being
+  // uploaded. The blocks are appended at increasing offsets, which the DFS
+  // endpoint accepts in any order as long as they are all uploaded before
+  // the flush that covers them.
+  void uploadBlockAsync(std::unique_ptr<Block> block) {
+    while (pendingBlocks_.size() >= maxInFlightBlocks_) {
+      waitForOldestBlock();
+    }
+    const auto offset = blockOffset_;
+    blockOffset_ += block->size();
+    auto upload = [client = blobStorageFileClient_,
+                   offset,
+                   block = std::move(block)]() mutable {
+      client->append(
+          reinterpret_cast<const uint8_t*>(block->data()),
+          block->size(),
+          offset);
+      return std::move(block);
+    };
+    pendingBlocks_.push_back(folly::via(uploadExecutor_, std::move(upload)));
+  }
+
+  // Waits for the upload of the oldest pending block and keeps its buffer
+  // for a later block.
+  void waitForOldestBlock() {
+    VELOX_CHECK(!pendingBlocks_.empty());
+    auto future = std::move(pendingBlocks_.front());
+    pendingBlocks_.pop_front();
+    auto block = std::move(future).get();
+    block->resize(0);
+    freeBlocks_.push_back(std::move(block));
+  }
+
+  // Waits for the pending uploads and uploads the rest of 'currentBlock_' so
+  // that all the data appended so far can be flushed.
+  void uploadBlocks() {
+    while (!pendingBlocks_.empty()) {
+      waitForOldestBlock();
+    }
+    if (currentBlock_->size() > 0) {
+      blobStorageFileClient_->append(
+          reinterpret_cast<const uint8_t*>(currentBlock_->data()),
+          currentBlock_->size(),
+          blockOffset_);
+      blockOffset_ += currentBlock_->size();
+      currentBlock_->resize(0);
+    }
+    VELOX_CHECK_EQ(blockOffset_, position_);
+  }
+
+  // Returns an empty block buffer, reusing the buffer of an uploaded block if
+  // there is one.
+  std::unique_ptr<Block> newBlock() {
+    if (!freeBlocks_.empty()) {
+      auto block = std::move(freeBlocks_.back());
+      freeBlocks_.pop_back();
+      return block;
+    }
+    auto block = std::make_unique<Block>(*pool_);
+    block->reserve(kNaturalWriteSize);
+    return block;
+  }
+
   bool checkIfFileExists() {
     try {
       blobStorageFileClient_->getProperties();
@@ -130,6 +250,19 @@ class AbfsWriteFile::Impl {
   std::string fileSystem_;
   std::string fileName_;
   std::shared_ptr<IBlobStorageFileClient> blobStorageFileClient_;
+  memory::MemoryPool* const pool_;
+  // Runs the block uploads if not null. Otherwise appends are uploaded
+  // synchronously in append().
+  folly::Executor* const uploadExecutor_;
+  const size_t maxInFlightBlocks_;
+  // Uploads in flight in offset order. Each returns the uploaded block.
+  std::deque<folly::Future<std::unique_ptr<Block>>> pendingBlocks_;
+  // Buffers of uploaded blocks to reuse for the next blocks.
+  std::vector<std::unique_ptr<Block>> freeBlocks_;
+  // The block being filled by append().
+  std::unique_ptr<Block> currentBlock_;
+  // File offset of 'currentBlock_'.
+  uint64_t blockOffset_ = 0;
 
   uint64_t position_ = -1;
   bool closed_ = false;
@@ -137,8 +270,12 @@ class AbfsWriteFile::Impl {
 
 AbfsWriteFile::AbfsWriteFile(
     const std::string& path,
-    const std::string& connectStr) {
-  impl_ = std::make_shared<Impl>(path, connectStr);
+    const std::string& connectStr,
+    memory::MemoryPool* pool,
+    folly::Executor* uploadExecutor,
+    int32_t maxInFlightBlocks) {
+  impl_ = std::make_shared<Impl>(
+      path, connectStr, pool, uploadExecutor, maxInFlightBlocks);
 }
 
 void AbfsWriteFile::initialize() {
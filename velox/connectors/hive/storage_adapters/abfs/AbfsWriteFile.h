@@ -16,12 +16,17 @@
 #pragma once
 
 #include "velox/common/file/File.h"
+#include "velox/common/memory/MemoryPool.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsUtil.h"
 
 namespace Azure::Storage::Files::DataLake::Models {
 class PathProperties;
 }
 
+namespace folly {
+class Executor;
+}
+
 namespace facebook::velox::filesystems::abfs {
 using namespace Azure::Storage::Files::DataLake;
 using namespace Azure::Storage::Files::DataLake::Models;
@@ -56,13 +61,30 @@ class IBlobStorageFileClient {
 
 /// Implementation of abfs write file. Nothing written to the file should be
 /// read back until it is closed.
+///
+/// Appends are uploaded synchronously unless an upload executor and a memory
+/// pool are given. Then appends are copied into blocks of kNaturalWriteSize
+/// bytes allocated from the pool and each full block is appended at its
+/// offset on the executor, with at most 'maxInFlightBlocks' uploads pending.
+/// An append that fills a block only waits when that many are in flight. The
+/// buffers of uploaded blocks are reused. flush() and close() upload the last
+/// partial block and wait for all the pending uploads before flushing, so a
+/// file that is only closed is flushed once.
 class AbfsWriteFile : public WriteFile {
  public:
   constexpr static uint64_t kNaturalWriteSize = 8 << 20; // 8M
   /// The constructor.
   /// @param path The file path to write.
   /// @param connectStr the connection string used to auth the storage account.
-  AbfsWriteFile(const std::string& path, const std::string& connectStr);
+  /// @param pool The memory pool of the block buffers.
+  /// @param uploadExecutor Runs the block uploads if not null.
+  /// @param maxInFlightBlocks Maximum number of blocks being uploaded.
+  AbfsWriteFile(
+      const std::string& path,
+      const std::string& connectStr,
+      memory::MemoryPool* pool = nullptr,
+      folly::Executor* uploadExecutor = nullptr,
+      int32_t maxInFlightBlocks = 1);
 
   /// check any issue reading file.
   void initialize();
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <atomic>
 #include <filesystem>
@@ -61,6 +62,10 @@ class AbfsFileSystemTest : public testing::Test {
  public:
   std::shared_ptr<filesystems::test::AzuriteServer> azuriteServer;
 
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
   void SetUp() override {
     auto port = facebook::velox::exec::test::getFreePort();
     azuriteServer = std::make_shared<filesystems::test::AzuriteServer>(port);
@@ -263,8 +268,7 @@ TEST_F(AbfsFileSystemTest, OpenFileForWriteTest) {
   const std::string abfsFile =
       filesystems::test::AzuriteABFSEndpoint + "writetest.txt";
   auto mockClient =
-      std::make_shared<filesystems::test::MockBlobStorageFileClient>(
-          filesystems::test::MockBlobStorageFileClient());
+      std::make_shared<filesystems::test::MockBlobStorageFileClient>();
   auto abfsWriteFile = openFileForWrite(abfsFile, mockClient);
   EXPECT_EQ(abfsWriteFile->size(), 0);
   std::string dataContent = "";
@@ -299,6 +303,42 @@ TEST_F(AbfsFileSystemTest, OpenFileForWriteTest) {
   ASSERT_EQ(fileContent, dataContent);
 }
 
+TEST_F(AbfsFileSystemTest, writeFileAsyncUpload) {
+  const std::string abfsFile =
+      filesystems::test::AzuriteABFSEndpoint + "asyncwritetest.txt";
+  auto mockClient =
+      std::make_shared<filesystems::test::MockBlobStorageFileClient>();
+  auto pool = memory::memoryManager()->addLeafPool("AbfsFileSystemTest");
+  folly::IOThreadPoolExecutor executor(4);
+  auto abfsWriteFile = std::make_unique<AbfsWriteFile>(
+      abfsFile, azuriteServer->connectionStr(), pool.get(), &executor, 2);
+  abfsWriteFile->testingSetFileClient(mockClient);
+  abfsWriteFile->initialize();
+
+  // Appends that are not a multiple of the block size so that blocks span
+  // appends, and an append spanning several blocks.
+  std::string dataContent;
+  for (int i = 0; i < 10; ++i) {
+    const auto data = generateRandomData(3 * kOneMB + 17);
+    abfsWriteFile->append(data);
+    dataContent += data;
+  }
+  auto data = generateRandomData(25 * kOneMB);
+  abfsWriteFile->append(data);
+  dataContent += data;
+  abfsWriteFile->flush();
+  EXPECT_EQ(abfsWriteFile->size(), dataContent.size());
+
+  // Appends after a flush continue at the flushed position.
+  data = generateRandomData(9 * kOneMB);
+  abfsWriteFile->append(data);
+  dataContent += data;
+  abfsWriteFile->close();
+  EXPECT_GT(pool->peakBytes(), 0);
+  EXPECT_EQ(pool->usedBytes(), 0);
+  ASSERT_EQ(mockClient->readContent(), dataContent);
+}
+
 TEST_F(AbfsFileSystemTest, renameNotImplemented) {
   auto hiveConfig = AbfsFileSystemTest::hiveConfig(
       {{"fs.azure.account.key.test.dfs.core.windows.net",
@@ -18,11 +18,14 @@
 
 #include "velox/exec/tests/utils/TempFilePath.h"
 
+#include <mutex>
+
 using namespace facebook::velox;
 using namespace facebook::velox::filesystems::abfs;
 
 namespace facebook::velox::filesystems::test {
-// A mocked blob storage file client backend with local file store.
+// A mocked blob storage file client backend with local file store. Appends
+// may come from several threads at a time, like to the DFS endpoint.
 class MockBlobStorageFileClient : public IBlobStorageFileClient {
  public:
   MockBlobStorageFileClient() {
@@ -51,6 +54,7 @@ class MockBlobStorageFileClient : public IBlobStorageFileClient {
 
  private:
   std::string filePath_;
+  std::mutex mutex_;
   std::ofstream fileStream_;
 };
 } // namespace facebook::velox::filesystems::test
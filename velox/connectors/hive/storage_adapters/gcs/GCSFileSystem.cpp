@@ -17,15 +17,22 @@
 #include "velox/connectors/hive/storage_adapters/gcs/GCSFileSystem.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
+#include "velox/common/io/IoConcurrencyLimiter.h"
+#include "velox/common/io/ReadHedger.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GCSUtil.h"
 #include "velox/core/Config.h"
 #include "velox/core/QueryConfig.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <glog/logging.h>
+#include <chrono>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 
 #include <google/cloud/storage/client.h>
 
@@ -65,8 +72,13 @@ inline void checkGCSStatus(
 
 class GCSReadFile final : public ReadFile {
  public:
-  GCSReadFile(const std::string& path, std::shared_ptr<gcs::Client> client)
-      : client_(std::move(client)) {
+  // If 'executor' is set, the ranges of preadvAsync() are fetched as parallel
+  // ranged GETs on it.
+  GCSReadFile(
+      const std::string& path,
+      std::shared_ptr<gcs::Client> client,
+      std::shared_ptr<folly::Executor> executor = nullptr)
+      : client_(std::move(client)), executor_(std::move(executor)) {
     // assumption it's a proper path
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
@@ -133,6 +145,27 @@ class GCSReadFile final : public ReadFile {
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (executor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    // Unlike preadv(), the gaps are not fetched: each range is its own GET so
+    // that the ranges are transferred concurrently over the connection pool.
+    return file::utils::readRangesAsync(
+        offset,
+        buffers,
+        executor_.get(),
+        [this](uint64_t rangeOffset, uint64_t length, char* data) {
+          preadInternal(rangeOffset, length, data);
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -148,7 +181,7 @@ class GCSReadFile final : public ReadFile {
   }
 
   std::string getName() const override {
-    return key_;
+    return gcsURI(bucket_, key_);
   }
 
   uint64_t getNaturalReadSize() const override {
@@ -159,22 +192,82 @@ class GCSReadFile final : public ReadFile {
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    if (auto* hedger = io::ReadHedger::instance()) {
+      hedger->read(
+          getName(),
+          length,
+          position,
+          [this, offset, length](
+              char* buffer, const io::ReadHedger::CancelCheck& cancelled) {
+            return readObject(offset, length, buffer, cancelled);
+          });
+    } else {
+      readObject(offset, length, position, nullptr);
+    }
+    bytesRead_ += length;
+  }
+
+  // Reads the range into 'position'. Returns false if the read stopped
+  // because 'cancelled' returned true. The stream has no way to abort a read
+  // in progress, so a cancellable read goes in chunks of
+  // 'kCancellableReadSize'.
+  bool readObject(
+      uint64_t offset,
+      uint64_t length,
+      char* position,
+      const io::ReadHedger::CancelCheck& cancelled) const {
+    static constexpr uint64_t kCancellableReadSize = 1 << 20;
+    const auto startTime = std::chrono::steady_clock::now();
     gcs::ObjectReadStream stream = client_->ReadObject(
         bucket_, key_, gcs::ReadRange(offset, offset + length));
     if (!stream) {
+      recordRead(startTime, stream.status());
       checkGCSStatus(
           stream.status(), "Failed to get GCS object", bucket_, key_);
     }
 
-    stream.read(position, length);
+    if (cancelled) {
+      for (uint64_t done = 0; done < length && stream;) {
+        if (cancelled()) {
+          stream.Close();
+          return false;
+        }
+        const auto size = std::min(kCancellableReadSize, length - done);
+        stream.read(position + done, size);
+        done += size;
+      }
+    } else {
+      stream.read(position, length);
+    }
+    recordRead(startTime, stream.status());
     if (!stream) {
       checkGCSStatus(
           stream.status(), "Failed to get read object", bucket_, key_);
     }
-    bytesRead_ += length;
+    return true;
+  }
+
+  // Reports a read that started at 'startTime' to the IO concurrency limiter.
+  // GCS asks to slow down with 429 and 503, which map to kResourceExhausted
+  // and kUnavailable.
+  void recordRead(
+      std::chrono::steady_clock::time_point startTime,
+      const gc::Status& status) const {
+    auto* limiter = io::IoConcurrencyLimiter::instance();
+    if (limiter == nullptr) {
+      return;
+    }
+    limiter->record(
+        getName(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime)
+            .count(),
+        status.code() == gc::StatusCode::kResourceExhausted ||
+            status.code() == gc::StatusCode::kUnavailable);
   }
 
   std::shared_ptr<gcs::Client> client_;
+  const std::shared_ptr<folly::Executor> executor_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> length_ = -1;
@@ -276,6 +369,16 @@ class GCSFileSystem::Impl {
     }
     options.set<gcs::UploadBufferSizeOption>(kUploadBufferSize);
 
+    const auto readThreads = hiveConfig_->gcsReadThreads();
+    if (readThreads > 0) {
+      // Each read thread holds a connection for the duration of its GET. The
+      // client library defaults to one connection per core.
+      options.set<gcs::ConnectionPoolSizeOption>(std::max<std::size_t>(
+          readThreads, std::thread::hardware_concurrency()));
+      readExecutor_ = std::make_shared<folly::CPUThreadPoolExecutor>(
+          readThreads, std::make_shared<folly::NamedThreadFactory>("GCSRead"));
+    }
+
     auto max_retry_count = hiveConfig_->gcsMaxRetryCount();
     if (max_retry_count) {
       options.set<gcs::RetryPolicyOption>(
@@ -310,9 +413,14 @@ class GCSFileSystem::Impl {
     return client_;
   }
 
+  std::shared_ptr<folly::Executor> getReadExecutor() const {
+    return readExecutor_;
+  }
+
  private:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<gcs::Client> client_;
+  std::shared_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
 };
 
 GCSFileSystem::GCSFileSystem(std::shared_ptr<const Config> config)
@@ -328,7 +436,8 @@ std::unique_ptr<ReadFile> GCSFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSReadFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSReadFile>(
+      gcspath, impl_->getClient(), impl_->getReadExecutor());
   gcsfile->initialize(options);
   return gcsfile;
 }
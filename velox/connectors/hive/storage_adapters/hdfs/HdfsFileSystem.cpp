@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <hdfs/hdfs.h>
 #include <mutex>
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/core/Config.h"
@@ -25,8 +28,13 @@ std::string_view HdfsFileSystem::kScheme("hdfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
+    const connector::hive::HiveConfig hiveConfig(
+        std::make_shared<core::MemConfig>(config->values()));
+    if (const auto numThreads = hiveConfig.hdfsReadThreads(); numThreads > 0) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          numThreads, std::make_shared<folly::NamedThreadFactory>("HdfsRead"));
+    }
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
@@ -40,6 +48,8 @@ class HdfsFileSystem::Impl {
   }
 
   ~Impl() {
+    // Join the read threads before disconnecting the client they read from.
+    readExecutor_.reset();
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = hdfsDisconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -52,8 +62,13 @@ class HdfsFileSystem::Impl {
     return hdfsClient_;
   }
 
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
  private:
   hdfsFS hdfsClient_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -77,7 +92,8 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(), path, impl_->readExecutor());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
@@ -17,11 +17,15 @@
 #include "HdfsReadFile.h"
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include "velox/common/file/Utils.h"
 
 namespace facebook::velox {
 
-HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
-    : hdfsClient_(hdfs), filePath_(path) {
+HdfsReadFile::HdfsReadFile(
+    hdfsFS hdfs,
+    const std::string_view path,
+    folly::Executor* executor)
+    : hdfsClient_(hdfs), executor_(executor), filePath_(path) {
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
   if (fileInfo_ == nullptr) {
     auto error = hdfsGetLastError();
@@ -69,6 +73,21 @@ std::string HdfsReadFile::pread(uint64_t offset, uint64_t length) const {
   return result;
 }
 
+folly::SemiFuture<uint64_t> HdfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (executor_ == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  return file::utils::readRangesAsync(
+      offset,
+      buffers,
+      executor_,
+      [this](uint64_t rangeOffset, uint64_t length, char* data) {
+        preadInternal(rangeOffset, length, data);
+      });
+}
+
 uint64_t HdfsReadFile::size() const {
   return fileInfo_->mSize;
 }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
 #include <hdfs/hdfs.h>
 #include "velox/common/file/File.h"
 
@@ -60,7 +61,14 @@ struct HdfsFile {
  */
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  /// If 'executor' is set, the ranges of preadvAsync() are read in parallel
+  /// on it, each executor thread with its own file handle. This lets
+  /// libhdfs3 issue concurrent (and hedged, if enabled in the client
+  /// configuration) block reads for the coalesced loads of a scan.
+  explicit HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      folly::Executor* executor = nullptr);
   ~HdfsReadFile() override;
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -68,6 +76,14 @@ class HdfsReadFile final : public ReadFile {
 
   std::string pread(uint64_t offset, uint64_t length) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -87,6 +103,7 @@ class HdfsReadFile final : public ReadFile {
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
   hdfsFS hdfsClient_;
+  folly::Executor* const executor_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
   folly::ThreadLocal<HdfsFile> file_;
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 #include "velox/common/file/File.h"
+#include "velox/common/io/IoConcurrencyLimiter.h"
+#include "velox/common/io/ReadHedger.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -24,7 +26,12 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -72,6 +79,21 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// Returns true if S3 asked to slow down, e.g. with a 503 SlowDown, or if the
+// SDK had to retry the request.
+template <typename Outcome>
+bool isThrottled(const Outcome& outcome) {
+  if (outcome.GetRetryCount() > 0) {
+    return true;
+  }
+  if (outcome.IsSuccess()) {
+    return false;
+  }
+  const auto code = outcome.GetError().GetResponseCode();
+  return code == Aws::Http::HttpResponseCode::SERVICE_UNAVAILABLE ||
+      code == Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS;
+}
+
 class S3ReadFile final : public ReadFile {
  public:
   S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
@@ -169,6 +191,28 @@ class S3ReadFile final : public ReadFile {
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    auto* hedger = io::ReadHedger::instance();
+    if (hedger == nullptr) {
+      getObject(offset, length, position, nullptr);
+      return;
+    }
+    hedger->read(
+        getName(),
+        length,
+        position,
+        [this, offset, length](
+            char* buffer, const io::ReadHedger::CancelCheck& cancelled) {
+          return getObject(offset, length, buffer, cancelled);
+        });
+  }
+
+  // Reads the range into 'position'. Returns false if the request was
+  // aborted because 'cancelled' returned true.
+  bool getObject(
+      uint64_t offset,
+      uint64_t length,
+      char* position,
+      const io::ReadHedger::CancelCheck& cancelled) const {
     // Read the desired range of bytes.
     Aws::S3::Model::GetObjectRequest request;
     Aws::S3::Model::GetObjectResult result;
@@ -180,8 +224,27 @@ class S3ReadFile final : public ReadFile {
     request.SetRange(awsString(ss.str()));
     request.SetResponseStreamFactory(
         AwsWriteableStreamFactory(position, length));
+    if (cancelled) {
+      request.SetContinueRequestHandler(
+          [&cancelled](const Aws::Http::HttpRequest* /*unused*/) {
+            return !cancelled();
+          });
+    }
+    const auto startTime = std::chrono::steady_clock::now();
     auto outcome = client_->GetObject(request);
+    if (!outcome.IsSuccess() && cancelled && cancelled()) {
+      return false;
+    }
+    if (auto* limiter = io::IoConcurrencyLimiter::instance()) {
+      limiter->record(
+          getName(),
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - startTime)
+              .count(),
+          isThrottled(outcome));
+    }
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    return true;
   }
 
   Aws::S3::S3Client* client_;
@@ -222,13 +285,18 @@ class S3WriteFile::Impl {
   explicit Impl(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor,
+      int32_t maxInFlightParts)
+      : client_(client),
+        pool_(pool),
+        uploadExecutor_(uploadExecutor),
+        maxInFlightParts_(maxInFlightParts) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
+    VELOX_CHECK_GT(maxInFlightParts_, 0);
     getBucketAndKeyFromS3Path(path, bucket_, key_);
-    currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
-    currentPart_->reserve(kPartUploadSize);
+    currentPart_ = newPart();
     // Check that the object doesn't exist, if it does throw an error.
     {
       Aws::S3::Model::HeadObjectRequest request;
@@ -273,6 +341,14 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The pending uploads reference 'this'.
+    while (!pendingParts_.empty()) {
+      pendingParts_.front().wait();
+      pendingParts_.pop_front();
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
@@ -298,6 +374,9 @@ class S3WriteFile::Impl {
     if (closed()) {
       return;
     }
+    while (!pendingParts_.empty()) {
+      waitForOldestPart();
+    }
     uploadPart({currentPart_->data(), currentPart_->size()}, true);
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
@@ -352,11 +431,22 @@ class S3WriteFile::Impl {
     // Fill-up the remaining currentPart_.
     auto remainingBufferSize = currentPart_->capacity() - currentPart_->size();
     currentPart_->unsafeAppend(dataPtr, remainingBufferSize);
-    uploadPart({currentPart_->data(), currentPart_->size()});
+    if (uploadExecutor_ != nullptr) {
+      uploadPartAsync(std::exchange(currentPart_, newPart()));
+    } else {
+      uploadPart({currentPart_->data(), currentPart_->size()});
+    }
     dataPtr += remainingBufferSize;
     dataSize -= remainingBufferSize;
     while (dataSize > kPartUploadSize) {
-      uploadPart({dataPtr, kPartUploadSize});
+      if (uploadExecutor_ != nullptr) {
+        // 'data' is not valid after append() returns, so the part is copied.
+        auto part = newPart();
+        part->unsafeAppend(dataPtr, kPartUploadSize);
+        uploadPartAsync(std::move(part));
+      } else {
+        uploadPart({dataPtr, kPartUploadSize});
+      }
       dataPtr += kPartUploadSize;
       dataSize -= kPartUploadSize;
     }
@@ -367,31 +457,72 @@ class S3WriteFile::Impl {
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
-    {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
-
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      uploadState_.completedParts.push_back(std::move(part));
+    // Append ETag and part number for this uploaded part.
+    // This will be needed for upload completion in Close().
+    uploadState_.completedParts.push_back(
+        doUploadPart(++uploadState_.partNumber, part));
+  }
+
+  // Uploads 'part' on 'uploadExecutor_'. Waits for the oldest pending part
+  // first if 'maxInFlightParts_' parts are being uploaded.
+  void uploadPartAsync(std::unique_ptr<dwio::common::DataBuffer<char>> part) {
+    VELOX_CHECK_EQ(part->size(), kPartUploadSize);
+    while (pendingParts_.size() >= maxInFlightParts_) {
+      waitForOldestPart();
     }
+    const auto partNumber = ++uploadState_.partNumber;
+    pendingParts_.push_back(folly::via(
+        uploadExecutor_, [this, partNumber, part = std::move(part)]() {
+          return doUploadPart(partNumber, {part->data(), part->size()});
+        }));
+  }
+
+  // Waits for the upload of the oldest pending part. The parts complete in
+  // part number order, which keeps 'completedParts' sorted.
+  void waitForOldestPart() {
+    VELOX_CHECK(!pendingParts_.empty());
+    auto future = std::move(pendingParts_.front());
+    pendingParts_.pop_front();
+    uploadState_.completedParts.push_back(std::move(future).get());
+  }
+
+  // Uploads 'part' as part 'partNumber'. Only reads members that are not
+  // modified after construction so that it can run on 'uploadExecutor_'.
+  Aws::S3::Model::CompletedPart doUploadPart(
+      int64_t partNumber,
+      const std::string_view part) const {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(part.size());
+    request.SetBody(
+        std::make_shared<StringViewStream>(part.data(), part.size()));
+    auto outcome = client_->UploadPart(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
+    auto result = outcome.GetResult();
+    Aws::S3::Model::CompletedPart completedPart;
+    completedPart.SetPartNumber(partNumber);
+    completedPart.SetETag(result.GetETag());
+    return completedPart;
+  }
+
+  // Returns an empty part buffer allocated from 'pool_'.
+  std::unique_ptr<dwio::common::DataBuffer<char>> newPart() const {
+    auto part = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+    part->reserve(kPartUploadSize);
+    return part;
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  // Runs the part uploads if not null. Otherwise parts are uploaded
+  // synchronously in append().
+  folly::Executor* const uploadExecutor_;
+  const size_t maxInFlightParts_;
+  // Uploads in flight in part number order.
+  std::deque<folly::Future<Aws::S3::Model::CompletedPart>> pendingParts_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
   std::string bucket_;
   std::string key_;
@@ -401,8 +532,11 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     const std::string& path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    folly::Executor* uploadExecutor,
+    int32_t maxInFlightParts) {
+  impl_ = std::make_shared<Impl>(
+      path, client, pool, uploadExecutor, maxInFlightParts);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -575,10 +709,17 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         hiveConfig_->s3UseVirtualAddressing());
+
+    if (hiveConfig_->s3UploadPartAsync()) {
+      uploadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          hiveConfig_->s3UploadThreads(),
+          std::make_shared<folly::NamedThreadFactory>("S3Upload"));
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -709,9 +850,20 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Returns the executor for asynchronous part uploads or nullptr if parts
+  // are uploaded synchronously.
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  int32_t maxInFlightUploadParts() const {
+    return hiveConfig_->s3MaxInFlightUploadParts();
+  }
+
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -736,8 +888,12 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(file, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      file,
+      impl_->s3Client(),
+      options.pool,
+      impl_->uploadExecutor(),
+      impl_->maxInFlightUploadParts());
   return s3file;
 }
 
@@ -23,6 +23,10 @@ namespace Aws::S3 {
 class S3Client;
 }
 
+namespace folly {
+class Executor;
+}
+
 namespace facebook::velox::filesystems {
 
 /// S3WriteFile uses the Apache Arrow implementation as a reference.
@@ -42,15 +46,20 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// UploadPart is synchronous during append unless an upload executor is given.
+/// Then full parts are copied into buffers allocated from the memory pool and
+/// uploaded on the executor, with at most 'maxInFlightParts' uploads pending.
+/// An append that completes a part only waits when that many are in flight.
+/// close() waits for all the pending uploads.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor = nullptr,
+      int32_t maxInFlightParts = 1);
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
@@ -65,7 +74,8 @@ class S3WriteFile : public WriteFile {
   /// Current file size, i.e. the sum of all previous Appends.
   uint64_t size() const override;
 
-  /// Return the number of parts uploaded so far.
+  /// Return the number of parts uploaded so far, including the parts whose
+  /// asynchronous upload is pending.
   int numPartsUploaded() const;
 
  protected:
@@ -254,6 +254,52 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, writeFileAndReadAsyncUpload) {
+  const auto bucketName = "writedataasync";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.upload-part-async", "true"},
+       {"hive.s3.upload-threads", "4"},
+       {"hive.s3.max-inflight-upload-parts", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto writeFile =
+      s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // Each chunk has a distinct fill so that parts uploaded out of order would
+  // be detected.
+  constexpr int64_t kChunkSize = 3 * 1024 * 1024;
+  constexpr int kNumChunks = 20;
+  for (int i = 0; i < kNumChunks; ++i) {
+    std::string chunk(kChunkSize, 'a' + i);
+    writeFile->append(chunk);
+  }
+  EXPECT_EQ(writeFile->size(), kNumChunks * kChunkSize);
+  // 60MiB of data make 6 full parts of 10MiB.
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 6);
+
+  // A single append spanning several parts.
+  std::string largeBuffer(25 * 1024 * 1024, 'z');
+  writeFile->append(largeBuffer);
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 8);
+
+  writeFile->close();
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 9);
+
+  const int64_t totalSize = kNumChunks * kChunkSize + largeBuffer.size();
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->size(), totalSize);
+  for (int i = 0; i < kNumChunks; ++i) {
+    ASSERT_EQ(readFile->pread(i * kChunkSize, 1), std::string(1, 'a' + i));
+    ASSERT_EQ(
+        readFile->pread((i + 1) * kChunkSize - 1, 1), std::string(1, 'a' + i));
+  }
+  ASSERT_EQ(readFile->pread(totalSize - 1, 1), "z");
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
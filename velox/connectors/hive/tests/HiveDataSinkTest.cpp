@@ -561,6 +561,58 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   verifyWrittenData(outputDirectory->getPath(), numBuckets);
 }
 
+TEST_F(HiveDataSinkTest, partitionSortedWrite) {
+  const int numBatches = 10;
+  const auto vectors = createVectors(500, numBatches);
+  const std::vector<std::string> partitionBy{"c6"};
+  const int32_t numBuckets = 4;
+  auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      numBuckets,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c1", core::SortOrder{false, false})});
+
+  std::vector<size_t> numPartitions;
+  std::vector<uint64_t> numWrittenFiles;
+  for (bool partitionSorted : {false, true}) {
+    SCOPED_TRACE(fmt::format("partitionSorted: {}", partitionSorted));
+    connectorSessionProperties_->setValue(
+        HiveConfig::kPartitionSortedWriteSession,
+        partitionSorted ? "true" : "false");
+    setupMemoryPools();
+
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        partitionBy,
+        bucketProperty);
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    // Sorted mode buffers all the input and writes nothing until close.
+    if (partitionSorted) {
+      ASSERT_EQ(dataSink->stats().numWrittenBytes, 0);
+    } else {
+      ASSERT_GT(dataSink->stats().numWrittenBytes, 0);
+    }
+
+    const auto partitions = dataSink->close();
+    const auto stats = dataSink->stats();
+    ASSERT_GT(stats.numWrittenBytes, 0);
+    numPartitions.push_back(partitions.size());
+    numWrittenFiles.push_back(stats.numWrittenFiles);
+    ASSERT_EQ(
+        listFiles(outputDirectory->getPath()).size(), stats.numWrittenFiles);
+  }
+  ASSERT_EQ(numPartitions[0], numPartitions[1]);
+  ASSERT_EQ(numWrittenFiles[0], numWrittenFiles[1]);
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
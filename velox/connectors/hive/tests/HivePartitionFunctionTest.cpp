@@ -140,6 +140,27 @@ TEST_F(HivePartitionFunctionTest, varchar) {
   assertPartitionsWithConstChannel(values, 997);
 }
 
+TEST_F(HivePartitionFunctionTest, flatAndConstantWithoutNulls) {
+  // Vectors without nulls are hashed without per row null checks.
+  auto bigints = makeFlatVector<int64_t>(
+      {300'000'000'000,
+       std::numeric_limits<int64_t>::min(),
+       std::numeric_limits<int64_t>::max()});
+  assertPartitions(bigints, 500, {497, 0, 0});
+  assertPartitions(bigints, 997, {852, 0, 0});
+  assertPartitionsWithConstChannel(bigints, 997);
+
+  auto varchars = makeFlatVector<std::string>(
+      {"", "test string", "\u5f3a\u5927\u7684Presto\u5f15\u64ce"});
+  assertPartitions(varchars, 500, {0, 211, 454});
+  assertPartitions(varchars, 997, {0, 894, 831});
+  assertPartitionsWithConstChannel(varchars, 997);
+
+  assertPartitions(
+      makeConstant<StringView>("test string", 3), 500, {211, 211, 211});
+  assertPartitions(makeConstant<int64_t>(std::nullopt, 3), 500, {0, 0, 0});
+}
+
 TEST_F(HivePartitionFunctionTest, boolean) {
   auto values =
       makeNullableFlatVector<bool>({std::nullopt, true, false, false, true});
@@ -172,6 +172,45 @@ TEST_F(PartitionIdGeneratorTest, stableIdsMultipleKeys) {
   }
 }
 
+TEST_F(PartitionIdGeneratorTest, smallAndLargeValueIdRanges) {
+  // 20 distinct values per key give a value ID range that is looked up by
+  // index. 2'000 distinct values per key give a range that is too large for
+  // that.
+  for (const auto numDistinct : {20, 2'000}) {
+    SCOPED_TRACE(fmt::format("numDistinct: {}", numDistinct));
+    PartitionIdGenerator idGenerator(
+        ROW({BIGINT(), BIGINT()}), {0, 1}, numDistinct, pool(), true);
+
+    auto makeInput = [&](bool reverse) {
+      auto key = [numDistinct, reverse](auto row) {
+        return reverse ? numDistinct - 1 - row : row;
+      };
+      return makeRowVector({
+          makeFlatVector<int64_t>(
+              numDistinct, [&](auto row) { return key(row) * 1'000'000; }),
+          makeFlatVector<int64_t>(
+              numDistinct, [&](auto row) { return key(row) * 7; }),
+      });
+    };
+
+    raw_vector<uint64_t> ids;
+    idGenerator.run(makeInput(false), ids);
+    ASSERT_EQ(idGenerator.numPartitions(), numDistinct);
+    for (auto i = 0; i < numDistinct; ++i) {
+      ASSERT_EQ(ids[i], i);
+    }
+
+    idGenerator.run(makeInput(true), ids);
+    ASSERT_EQ(idGenerator.numPartitions(), numDistinct);
+    for (auto i = 0; i < numDistinct; ++i) {
+      ASSERT_EQ(ids[i], numDistinct - 1 - i);
+    }
+    EXPECT_EQ(
+        idGenerator.partitionName(3),
+        fmt::format("c0={}/c1={}", 3'000'000, 21));
+  }
+}
+
 TEST_F(PartitionIdGeneratorTest, partitionKeysCaseSensitive) {
   PartitionIdGenerator idGenerator(
       ROW({"cc0", "Cc1"}, {BIGINT(), VARCHAR()}), {1}, 100, pool(), false);
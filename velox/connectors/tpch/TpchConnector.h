@@ -106,6 +106,8 @@ class TpchDataSource : public DataSource {
 
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
+  // Number of rows the splits divide among themselves. For lineitem, these
+  // are orders since lineitem is generated an order at a time.
   size_t tpchTableRowCount_{0};
   RowTypePtr outputType_;
 
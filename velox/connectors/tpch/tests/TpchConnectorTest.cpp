@@ -194,6 +194,29 @@ TEST_F(TpchConnectorTest, lineitemTinyRowCount) {
   EXPECT_EQ(60'175, output->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
 }
 
+// Lineitem splits divide the orders among themselves, so that each of them
+// generates a similar share of the lineitems.
+TEST_F(TpchConnectorTest, lineitemSplits) {
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(ROW({}, {}))
+                  .tableHandle(std::make_shared<TpchTableHandle>(
+                      kTpchConnectorId, Table::TBL_LINEITEM, 0.01))
+                  .endTableScan()
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+
+  constexpr size_t kTotalParts = 4;
+  int64_t total = 0;
+  for (size_t i = 0; i < kTotalParts; ++i) {
+    auto output = getResults(plan, {makeTpchSplit(kTotalParts, i)});
+    auto count = output->childAt(0)->asFlatVector<int64_t>()->valueAt(0);
+    EXPECT_GT(count, 60'175 / kTotalParts / 2);
+    total += count;
+  }
+  EXPECT_EQ(60'175, total);
+}
+
 TEST_F(TpchConnectorTest, unknownColumn) {
   EXPECT_THROW(
       {
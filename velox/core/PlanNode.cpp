@@ -224,12 +224,19 @@ void addSortingKeys(
 } // namespace
 
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: Add spilling for aggregations over distinct inputs.
+  // Aggregations over distinct inputs spill their de-duplicated inputs, which
+  // can only be merged back by hash partitioned spill. Aggregations over
+  // sorted inputs need the sorted spill, so the two can't spill together.
   // https://github.com/facebookincubator/velox/issues/7454
+  bool hasDistinct = false;
+  bool hasSorted = false;
   for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
-      return false;
-    }
+    hasDistinct |= aggregate.distinct;
+    hasSorted |= !aggregate.sortingKeys.empty();
+  }
+  if (hasDistinct &&
+      (hasSorted || !queryConfig.aggregationSpillHashPartitioned())) {
+    return false;
   }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
@@ -1894,12 +1901,16 @@ void LocalPartitionNode::addDetails(std::stringstream& stream) const {
   if (type_ != Type::kGather) {
     stream << " " << partitionFunctionSpec_->toString();
   }
+  if (rebalanceHotPartitions_) {
+    stream << " rebalance hot partitions";
+  }
 }
 
 folly::dynamic LocalPartitionNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["type"] = typeName(type_);
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
+  obj["rebalanceHotPartitions"] = rebalanceHotPartitions_;
   return obj;
 }
 
@@ -1907,12 +1918,17 @@ folly::dynamic LocalPartitionNode::serialize() const {
 PlanNodePtr LocalPartitionNode::create(
     const folly::dynamic& obj,
     void* context) {
+  bool rebalanceHotPartitions = false;
+  if (obj.count("rebalanceHotPartitions")) {
+    rebalanceHotPartitions = obj["rebalanceHotPartitions"].asBool();
+  }
   return std::make_shared<LocalPartitionNode>(
       deserializePlanNodeId(obj),
       typeFromName(obj["type"].asString()),
       ISerializable::deserialize<PartitionFunctionSpec>(
           obj["partitionFunctionSpec"]),
-      deserializeSources(obj, context));
+      deserializeSources(obj, context),
+      rebalanceHotPartitions);
 }
 
 // static
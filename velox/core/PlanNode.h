@@ -1124,21 +1124,31 @@ class LocalPartitionNode : public PlanNode {
 
   static Type typeFromName(const std::string& name);
 
+  /// @param rebalanceHotPartitions If true, the rows of partitions that
+  /// receive a skewed share of the input may be sent to any consumer. The
+  /// planner sets this only when the consumers do not need all rows of a key
+  /// in one place, e.g. partial aggregation or the probe side of a broadcast
+  /// join.
   LocalPartitionNode(
       const PlanNodeId& id,
       Type type,
       PartitionFunctionSpecPtr partitionFunctionSpec,
-      std::vector<PlanNodePtr> sources)
+      std::vector<PlanNodePtr> sources,
+      bool rebalanceHotPartitions = false)
       : PlanNode(id),
         type_{type},
         sources_{std::move(sources)},
-        partitionFunctionSpec_{std::move(partitionFunctionSpec)} {
+        partitionFunctionSpec_{std::move(partitionFunctionSpec)},
+        rebalanceHotPartitions_{rebalanceHotPartitions} {
     VELOX_USER_CHECK_GT(
         sources_.size(),
         0,
         "Local repartitioning node requires at least one source");
 
     VELOX_USER_CHECK_NOT_NULL(partitionFunctionSpec_);
+    VELOX_USER_CHECK(
+        !rebalanceHotPartitions_ || type_ == Type::kRepartition,
+        "Only REPARTITION LocalPartitionNode can rebalance hot partitions");
 
     for (auto i = 1; i < sources_.size(); ++i) {
       VELOX_USER_CHECK(
@@ -1175,6 +1185,10 @@ class LocalPartitionNode : public PlanNode {
     return *partitionFunctionSpec_;
   }
 
+  bool rebalanceHotPartitions() const {
+    return rebalanceHotPartitions_;
+  }
+
   std::string_view name() const override {
     return "LocalPartition";
   }
@@ -1189,6 +1203,7 @@ class LocalPartitionNode : public PlanNode {
   const Type type_;
   const std::vector<PlanNodePtr> sources_;
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
+  const bool rebalanceHotPartitions_;
 };
 
 class PartitionedOutputNode : public PlanNode {
@@ -1658,6 +1673,12 @@ class MergeJoinNode : public AbstractJoinNode {
     return "MergeJoin";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // Semi joins add at most one match per row to the output and don't spill.
+    return !isLeftSemiFilterJoin() && !isRightSemiFilterJoin() &&
+        queryConfig.mergeJoinSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
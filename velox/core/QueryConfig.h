@@ -73,6 +73,12 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// The priority class of the query in memory arbitration: 'low', 'normal' or
+  /// 'high'. The capacity growth requests of higher priority queries are
+  /// served first, and lower priority queries are reclaimed or aborted first.
+  static constexpr const char* kMemoryArbitrationPriority =
+      "memory_arbitration_priority";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -101,11 +107,53 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to evaluate trees of deterministic simple functions over
+  /// fixed-width types with default null behavior, e.g. a * b + c - d, as a
+  /// single expression without materializing the intermediate results for the
+  /// whole batch. False by default.
+  static constexpr const char* kExprFuseSimpleFunctions =
+      "expression.fuse_simple_functions";
+
+  /// Whether to evaluate calls of a batchable function on the same input with
+  /// different constant arguments, e.g. json_extract_scalar(c, '$.a') and
+  /// json_extract_scalar(c, '$.b'), as a single call. False by default.
+  static constexpr const char* kExprBatchFunctionCalls =
+      "expression.batch_function_calls";
+
+  /// The maximum size in bytes of the results of expressions over dictionary
+  /// encoded inputs that are shared by the drivers of a task. The results are
+  /// keyed by the base of the dictionary, so that an expression over a
+  /// dictionary seen by several drivers or in several batches is evaluated
+  /// once per distinct value. 0 disables the cache. The memory is charged to
+  /// the task.
+  static constexpr const char* kExprResultCacheMaxBytes =
+      "expression.result_cache_max_bytes";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count CPU cycles, instructions, last level cache misses and
+  /// branch misses of the addInput, getOutput and finish calls of individual
+  /// operators. Uses perf events of the driver threads and is a no-op where
+  /// these are not available. False by default.
+  static constexpr const char* kOperatorTrackHardwareCounters =
+      "track_operator_hardware_counters";
+
+  /// If greater than 0, the driver threads of each task of the query sample
+  /// their stacks every this many milliseconds of CPU time. The samples are
+  /// tagged with the pipeline and operator running and are returned by
+  /// Task::foldedStacks(). 0 disables sampling.
+  static constexpr const char* kTaskStackSamplingIntervalMs =
+      "task_stack_sampling_interval_ms";
+
+  /// Maximum number of state transitions (queued, running, blocked) kept per
+  /// driver for the driver timeline in TaskStats. The last transitions are
+  /// kept. 0 disables the timeline.
+  static constexpr const char* kDriverTimelineMaxEvents =
+      "driver_timeline_max_events";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -120,13 +168,22 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// A LocalPartitionNode with rebalanceHotPartitions() set spreads the rows
+  /// of a partition over all consumers in round-robin when the partition
+  /// received more than this multiple of the average number of rows per
+  /// partition in the last sampling window. 0 disables the rebalancing.
+  static constexpr const char* kLocalPartitionSkewThreshold =
+      "local_partition_skew_threshold";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
   /// Maximum size in bytes to accumulate among all sources of the merge
-  /// exchange. Enforced approximately, not strictly.
+  /// exchange. With more than one source, half of it is read ahead by the
+  /// sources whose next rows the merge needs first. Enforced approximately,
+  /// not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
@@ -142,6 +199,18 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If true, partial aggregation checks whether its first input batches are
+  /// clustered on the grouping keys. If so, it outputs groups as soon as the
+  /// grouping keys change instead of accumulating them in the hash table.
+  static constexpr const char* kPartialAggregationDetectClusteredInput =
+      "partial_aggregation_detect_clustered_input";
+
+  /// Number of input rows to pass through after abandoning partial
+  /// aggregation before aggregating again to re-check the reduction. 0 means
+  /// partial aggregation stays abandoned.
+  static constexpr const char* kAbandonPartialAggregationRetryRows =
+      "abandon_partial_aggregation_retry_rows";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -153,6 +222,19 @@ class QueryConfig {
 
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// If true, PartitionedOutput serializes dictionary and constant encoded
+  /// columns as dictionary blocks instead of flattening them. Only for
+  /// exchange between Velox workers.
+  static constexpr const char* kPartitionedOutputPreserveEncodings =
+      "partitioned_output_preserve_encodings";
+
+  /// Bandwidth in bytes per second of the network the output of
+  /// PartitionedOutput is sent over. If non-zero and exchange compression is
+  /// enabled, a page is compressed only if compressing it is expected to take
+  /// less time than sending the bytes saved by compression. 0 disables this.
+  static constexpr const char* kPartitionedOutputNetworkBandwidth =
+      "partitioned_output_network_bandwidth";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -172,12 +254,55 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, operators size their output batches to fit
+  /// kAdaptiveOutputBatchBytes, TableScan reads more rows per batch when a
+  /// filter after it drops most rows and small batches out of a filter before
+  /// a join, aggregation or PartitionedOutput are coalesced.
+  static constexpr const char* kAdaptiveOutputBatchSizeEnabled =
+      "adaptive_output_batch_size_enabled";
+
+  /// Target size in bytes of the output batches when
+  /// kAdaptiveOutputBatchSizeEnabled is true. Should be in the order of the
+  /// size of the L2 cache, so that a batch stays in cache between operators.
+  static constexpr const char* kAdaptiveOutputBatchBytes =
+      "adaptive_output_batch_bytes";
+
+  /// With adaptive output batch sizes, small batches out of a filter are
+  /// coalesced once the filter passes less than this fraction of its input.
+  static constexpr const char* kBatchCoalesceSelectivityThreshold =
+      "batch_coalesce_selectivity_threshold";
+
+  /// Max time in ms a small batch is held for coalescing with the next ones.
+  static constexpr const char* kBatchCoalesceMaxWaitMs =
+      "batch_coalesce_max_wait_ms";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
   static constexpr const char* kTableScanGetOutputTimeLimitMs =
       "table_scan_getoutput_time_limit_ms";
 
+  /// If true, TableScan does not wait on the driver thread for a split that is
+  /// being preloaded or, for connectors that support it, for IO running in
+  /// the background. It returns blocked and the driver is resumed when the
+  /// IO is done, so that fewer threads can keep the CPUs busy.
+  static constexpr const char* kTableScanAsyncIo = "table_scan_async_io";
+
+  /// If true, a TableScan driver that runs out of splits takes over the part
+  /// of a split that another driver of the scan has not started to read,
+  /// e.g. the tail stripes of a large DWRF file. This keeps all drivers busy
+  /// when a large split comes last.
+  static constexpr const char* kTableScanSplitStealing =
+      "table_scan_split_stealing";
+
+  /// If true, a pipeline of a TableScan, filters and projections and a
+  /// partial aggregation caches the partial results of each split in the
+  /// process wide exec::FragmentResultCache and replays them instead of
+  /// reading the split when the same pipeline runs over an unchanged split
+  /// again. Ignored if the cache has not been initialized.
+  static constexpr const char* kFragmentResultCacheEnabled =
+      "fragment_result_cache_enabled";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
@@ -195,6 +320,17 @@ class QueryConfig {
   static constexpr const char* kAggregationSpillEnabled =
       "aggregation_spill_enabled";
 
+  /// If true, a spilling aggregation writes its groups to unsorted hash
+  /// partitions instead of sorted runs, and re-aggregates one spilled partition
+  /// at a time in a new hash table. A partition that does not fit in memory is
+  /// spilled again with the next partition bits, up to "max_spill_level".
+  /// Aggregations over distinct inputs spill the de-duplicated inputs of each
+  /// group and can only spill with this flag. Aggregations with sorted inputs
+  /// and distinct aggregations use sorted runs regardless, so an aggregation
+  /// over both distinct and sorted inputs does not spill.
+  static constexpr const char* kAggregationSpillHashPartitioned =
+      "aggregation_spill_hash_partitioned";
+
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
@@ -216,6 +352,10 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// MergeJoin spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMergeJoinSpillEnabled =
+      "merge_join_spill_enabled";
+
   /// The max row numbers to fill and spill for each spill run. This is used to
   /// cap the memory used for spilling. If it is zero, then there is no limit
   /// and spilling might run out of memory.
@@ -229,13 +369,25 @@ class QueryConfig {
   /// value is set to 100 GB.
   static constexpr const char* kMaxSpillBytes = "max_spill_bytes";
 
+  /// The directory of the overflow spill tier, e.g. a prefix on remote storage
+  /// that has a registered FileSystem. If set together with
+  /// kMaxLocalSpillBytes, the spill files that are created after the query
+  /// spilled kMaxLocalSpillBytes to the task spill directory are written to a
+  /// task specific subdirectory of this directory.
+  static constexpr const char* kSpillOverflowPath = "spill_overflow_path";
+
+  /// The max bytes a query spills to the task spill directory before the new
+  /// spill files go to kSpillOverflowPath. If it is zero, then all spill files
+  /// go to the task spill directory.
+  static constexpr const char* kMaxLocalSpillBytes = "max_local_spill_bytes";
+
   /// The max allowed spilling level with zero being the initial spilling level.
-  /// This only applies for hash build spilling which might trigger recursive
-  /// spilling when the build table is too big. If it is set to -1, then there
-  /// is no limit and then some extreme large query might run out of spilling
-  /// partition bits (see kSpillPartitionBits) at the end. The max spill level
-  /// is used in production to prevent some bad user queries from using too much
-  /// io and cpu resources.
+  /// This only applies for hash build and hash partitioned aggregation spilling
+  /// which might trigger recursive spilling when the table is too big. If it
+  /// is set to -1, then there is no limit and then some extreme large query
+  /// might run out of spilling partition bits (see kSpillPartitionBits) at the
+  /// end. The max spill level is used in production to prevent some bad user
+  /// queries from using too much io and cpu resources.
   static constexpr const char* kMaxSpillLevel = "max_spill_level";
 
   /// The max allowed spill file size. If it is zero, then there is no limit.
@@ -251,11 +403,28 @@ class QueryConfig {
   static constexpr const char* kSpillWriteBufferSize =
       "spill_write_buffer_size";
 
-  /// Specifies the buffer size in bytes to read from one spilled file. If the
-  /// underlying filesystem supports async read, we do read-ahead with double
-  /// buffering, which doubles the buffer used to read from each spill file.
+  /// Specifies the buffer size in bytes to read from one spilled file. Each
+  /// spill file read stream uses one more buffer per read-ahead, see
+  /// kSpillReadAheadDepth.
   static constexpr const char* kSpillReadBufferSize = "spill_read_buffer_size";
 
+  /// The number of read buffers each spill file read stream keeps in flight
+  /// ahead of the one being consumed. The reads ahead use the async read of
+  /// the file system if it has one and the spill executor otherwise. Without
+  /// either, no reads are issued ahead. Zero disables read-ahead.
+  static constexpr const char* kSpillReadAheadDepth = "spill_read_ahead_depth";
+
+  /// The max bytes read ahead by all the spill file read streams of a task. If
+  /// it is zero, then there is no limit besides kSpillReadAheadDepth.
+  static constexpr const char* kMaxSpillReadAheadBytes =
+      "max_spill_read_ahead_bytes";
+
+  /// The max bytes of the read buffers of the spill files merged at once by
+  /// the final merge of a spilled sort. If a sort spills more files than fit,
+  /// the smallest ones are merged into larger files first. If it is zero,
+  /// then all the spill files are merged at once.
+  static constexpr const char* kMaxSpillMergeBytes = "max_spill_merge_bytes";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
@@ -321,6 +490,75 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// If true, the hash probe looks up a batch of keys in stages over groups of
+  /// rows: prefetches the buckets of all rows of a group, then loads their
+  /// tags and prefetches the first matching rows, and only then compares the
+  /// keys. Hides more of the memory latency of probes into build sides larger
+  /// than the CPU cache.
+  static constexpr const char* kHashProbeGroupPrefetch =
+      "hash_probe_group_prefetch";
+
+  /// If true, the hash probe outputs the build side columns as lazy vectors
+  /// over the matching build rows instead of copying the values out of the
+  /// hash table. The values are only extracted for the rows and columns that a
+  /// downstream operator loads. Ignored if the hash join can spill.
+  static constexpr const char* kHashProbeLazyBuildColumns =
+      "hash_probe_lazy_build_columns";
+
+  /// If true, the hash probe of an inner or semi join builds dynamic filters
+  /// on all its probe keys once the build side is complete and records them on
+  /// the Task, which serializes them for scans of the probe side that run in
+  /// other tasks. Ignored with grouped execution.
+  static constexpr const char* kExportJoinDynamicFilters =
+      "export_join_dynamic_filters";
+
+  /// If true, the parallel hash join table build scatters the build side rows
+  /// into cache sized partitions of the table before inserting them, so that
+  /// each build thread only reads the rows of its own partitions.
+  static constexpr const char* kRadixPartitionedJoinBuild =
+      "radix_partitioned_join_build";
+
+  /// If true, the hash join build stores each distinct VARCHAR or VARBINARY
+  /// key once and the rows with that key share it. This saves memory for
+  /// build sides with long string keys of few distinct values.
+  static constexpr const char* kHashBuildInternKeyStrings =
+      "hash_build_intern_key_strings";
+
+  /// Maximum number of bytes of the normalized keys of a row in prefix-sort.
+  /// The sort keys that do not fit are compared through the RowContainer.
+  /// Also limits the size of the normalized keys compared by Merge.
+  static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
+      "prefixsort_normalized_key_max_bytes";
+
+  /// Minimum number of rows to use prefix-sort. A smaller set of rows is
+  /// sorted with std::sort.
+  static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
+
+  /// If true, a final ORDER BY runs as a partial ORDER BY in each driver of
+  /// its source pipeline followed by a single threaded merge of the sorted
+  /// outputs. Otherwise, the final ORDER BY and its source pipeline run single
+  /// threaded.
+  static constexpr const char* kParallelOrderBy = "parallel_order_by";
+
+  /// Number of leading bytes of a VARCHAR or VARBINARY sort key normalized in
+  /// prefix-sort. Rows whose string prefixes are equal are compared in full.
+  /// If it is 0, string keys are not normalized.
+  static constexpr const char* kPrefixSortMaxStringPrefixLength =
+      "prefixsort_max_string_prefix_length";
+
+  /// Minimum average number of rows in the frames of an output batch of an
+  /// aggregate window function to compute the frames from a segment tree of
+  /// partial aggregates over the partition instead of from all their rows.
+  /// 0 disables segment trees.
+  static constexpr const char* kWindowSegmentTreeMinFrameSize =
+      "window_segment_tree_min_frame_size";
+
+  /// Number of threads that compute the window functions of the partitions
+  /// of a Window operator after all its input has been sorted in memory. The
+  /// output keeps the order of the partitions. 1 computes all partitions on
+  /// the driver thread.
+  static constexpr const char* kWindowParallelism = "window_parallelism";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
@@ -342,6 +580,14 @@ class QueryConfig {
   static constexpr const char* kEnableExpressionEvaluationCache =
       "enable_expression_evaluation_cache";
 
+  /// If true, the operators of a driver share one vector pool for expression
+  /// evaluation instead of one each, so that a vector released by one
+  /// operator, e.g. the input of a FilterProject produced by the FilterProject
+  /// before it, is reused by the others. Only applies if
+  /// kEnableExpressionEvaluationCache is true.
+  static constexpr const char* kSharedVectorPoolEnabled =
+      "shared_vector_pool_enabled";
+
   // For a given shared subexpression, the maximum distinct sets of inputs we
   // cache results for. Lambdas can call the same expression with different
   // inputs many times, causing the results we cache to explode in size. Putting
@@ -353,6 +599,19 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Maximum number of splits past the preloaded ones whose files are opened
+  /// ahead of reading them. This opens the file and reads its metadata into the
+  /// caches of the connector without making a data source for the split. Set to
+  /// 0 to disable.
+  static constexpr const char* kMaxSplitFilePrefetchPerDriver =
+      "max_split_file_prefetch_per_driver";
+
+  /// Maximum number of record batches the ArrowStream operator fetches ahead
+  /// of the driver on the query executor. 0 reads batches on the driver
+  /// thread.
+  static constexpr const char* kArrowStreamPrefetchBatches =
+      "arrow_stream_prefetch_batches";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
@@ -364,6 +623,10 @@ class QueryConfig {
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
   }
 
+  std::string memoryArbitrationPriority() const {
+    return get<std::string>(kMemoryArbitrationPriority, "normal");
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -382,6 +645,14 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  bool partialAggregationDetectClusteredInput() const {
+    return get<bool>(kPartialAggregationDetectClusteredInput, false);
+  }
+
+  int64_t abandonPartialAggregationRetryRows() const {
+    return get<int64_t>(kAbandonPartialAggregationRetryRows, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -400,6 +671,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxSpillBytes, kDefault);
   }
 
+  std::string spillOverflowPath() const {
+    return get<std::string>(kSpillOverflowPath, "");
+  }
+
+  uint64_t maxLocalSpillBytes() const {
+    return get<uint64_t>(kMaxLocalSpillBytes, 0);
+  }
+
   /// Returns the maximum number of bytes to buffer in PartitionedOutput
   /// operator to avoid creating tiny SerializedPages.
   ///
@@ -421,11 +700,23 @@ class QueryConfig {
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  bool partitionedOutputPreserveEncodings() const {
+    return get<bool>(kPartitionedOutputPreserveEncodings, false);
+  }
+
+  uint64_t partitionedOutputNetworkBandwidth() const {
+    return get<uint64_t>(kPartitionedOutputNetworkBandwidth, 0);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  double localPartitionSkewThreshold() const {
+    return get<double>(kLocalPartitionSkewThreshold, 4);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
@@ -449,10 +740,39 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool adaptiveOutputBatchSizeEnabled() const {
+    return get<bool>(kAdaptiveOutputBatchSizeEnabled, false);
+  }
+
+  uint64_t adaptiveOutputBatchBytes() const {
+    static constexpr uint64_t kDefault = 1UL << 20;
+    return get<uint64_t>(kAdaptiveOutputBatchBytes, kDefault);
+  }
+
+  double batchCoalesceSelectivityThreshold() const {
+    return get<double>(kBatchCoalesceSelectivityThreshold, 0.1);
+  }
+
+  uint64_t batchCoalesceMaxWaitMs() const {
+    return get<uint64_t>(kBatchCoalesceMaxWaitMs, 100);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
 
+  bool tableScanAsyncIo() const {
+    return get<bool>(kTableScanAsyncIo, false);
+  }
+
+  bool tableScanSplitStealing() const {
+    return get<bool>(kTableScanSplitStealing, false);
+  }
+
+  bool fragmentResultCacheEnabled() const {
+    return get<bool>(kFragmentResultCacheEnabled, false);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
@@ -502,6 +822,10 @@ class QueryConfig {
     return get<bool>(kAggregationSpillEnabled, true);
   }
 
+  bool aggregationSpillHashPartitioned() const {
+    return get<bool>(kAggregationSpillHashPartitioned, false);
+  }
+
   /// Returns 'is join spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool joinSpillEnabled() const {
@@ -538,6 +862,12 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for MergeJoin operator. Must also
+  /// check the spillEnabled()!
+  bool mergeJoinSpillEnabled() const {
+    return get<bool>(kMergeJoinSpillEnabled, true);
+  }
+
   int32_t maxSpillLevel() const {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
@@ -598,6 +928,18 @@ class QueryConfig {
     return get<uint64_t>(kSpillReadBufferSize, 1L << 20);
   }
 
+  uint32_t spillReadAheadDepth() const {
+    return get<uint32_t>(kSpillReadAheadDepth, 1);
+  }
+
+  uint64_t maxSpillReadAheadBytes() const {
+    return get<uint64_t>(kMaxSpillReadAheadBytes, 0);
+  }
+
+  uint64_t maxSpillMergeBytes() const {
+    return get<uint64_t>(kMaxSpillMergeBytes, 0);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
@@ -667,10 +1009,34 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFuseSimpleFunctions() const {
+    return get<bool>(kExprFuseSimpleFunctions, false);
+  }
+
+  bool exprBatchFunctionCalls() const {
+    return get<bool>(kExprBatchFunctionCalls, false);
+  }
+
+  uint64_t exprResultCacheMaxBytes() const {
+    return get<uint64_t>(kExprResultCacheMaxBytes, 0);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackHardwareCounters() const {
+    return get<bool>(kOperatorTrackHardwareCounters, false);
+  }
+
+  int32_t taskStackSamplingIntervalMs() const {
+    return get<int32_t>(kTaskStackSamplingIntervalMs, 0);
+  }
+
+  uint32_t driverTimelineMaxEvents() const {
+    return get<uint32_t>(kDriverTimelineMaxEvents, 0);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -684,6 +1050,50 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  bool hashProbeGroupPrefetch() const {
+    return get<bool>(kHashProbeGroupPrefetch, false);
+  }
+
+  bool hashProbeLazyBuildColumns() const {
+    return get<bool>(kHashProbeLazyBuildColumns, false);
+  }
+
+  bool exportJoinDynamicFilters() const {
+    return get<bool>(kExportJoinDynamicFilters, false);
+  }
+
+  bool radixPartitionedJoinBuild() const {
+    return get<bool>(kRadixPartitionedJoinBuild, false);
+  }
+
+  bool hashBuildInternKeyStrings() const {
+    return get<bool>(kHashBuildInternKeyStrings, false);
+  }
+
+  uint32_t prefixSortNormalizedKeyMaxBytes() const {
+    return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
+  }
+
+  uint32_t prefixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortMinRows, 130);
+  }
+
+  bool parallelOrderBy() const {
+    return get<bool>(kParallelOrderBy, false);
+  }
+
+  uint32_t prefixSortMaxStringPrefixLength() const {
+    return get<uint32_t>(kPrefixSortMaxStringPrefixLength, 16);
+  }
+
+  uint32_t windowSegmentTreeMinFrameSize() const {
+    return get<uint32_t>(kWindowSegmentTreeMinFrameSize, 64);
+  }
+
+  uint32_t windowParallelism() const {
+    return get<uint32_t>(kWindowParallelism, 1);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
@@ -696,6 +1106,10 @@ class QueryConfig {
     return get<bool>(kEnableExpressionEvaluationCache, true);
   }
 
+  bool sharedVectorPoolEnabled() const {
+    return get<bool>(kSharedVectorPoolEnabled, false);
+  }
+
   uint32_t maxSharedSubexprResultsCached() const {
     // 10 was chosen as a default as there are cases where a shared
     // subexpression can be called in 2 different places and a particular
@@ -716,6 +1130,14 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  int32_t maxSplitFilePrefetchPerDriver() const {
+    return get<int32_t>(kMaxSplitFilePrefetchPerDriver, 0);
+  }
+
+  int32_t arrowStreamPrefetchBatches() const {
+    return get<int32_t>(kArrowStreamPrefetchBatches, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
@@ -729,6 +1151,12 @@ class QueryConfig {
     return std::optional<T>(config_->get<T>(key));
   }
 
+  /// Returns all the properties set for the query, including the ones this
+  /// class has no accessor for.
+  const std::unordered_map<std::string, std::string>& values() const {
+    return config_->values();
+  }
+
   /// Test-only method to override the current query config properties.
   /// It is not thread safe.
   void testingOverrideConfigUnsafe(
@@ -24,6 +24,10 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
 
+namespace facebook::velox::exec {
+class ExprResultCache;
+}
+
 namespace facebook::velox::core {
 
 class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
@@ -113,6 +117,11 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Returns the aggregated spill bytes of this query.
+  uint64_t spilledBytes() const {
+    return numSpilledBytes_;
+  }
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -154,11 +163,20 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
         uint64_t maxWaitMs,
         memory::MemoryReclaimer::Stats& stats) override;
 
+    /// Returns the priority class set by the query config when 'this' was
+    /// created.
+    memory::ArbitrationPriority priority() const override {
+      return priority_;
+    }
+
    protected:
     MemoryReclaimer(
         const std::shared_ptr<QueryCtx>& queryCtx,
         memory::MemoryPool* pool)
-        : queryCtx_(queryCtx), pool_(pool) {
+        : queryCtx_(queryCtx),
+          pool_(pool),
+          priority_(memory::arbitrationPriorityFromName(
+              queryCtx->queryConfig().memoryArbitrationPriority())) {
       VELOX_CHECK_NOT_NULL(pool_);
     }
 
@@ -172,6 +190,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
 
     const std::weak_ptr<QueryCtx> queryCtx_;
     memory::MemoryPool* const pool_;
+    const memory::ArbitrationPriority priority_;
   };
 
   static Config* getEmptyConfig() {
@@ -216,15 +235,27 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
 // Represents the state of one thread of query execution.
 class ExecCtx {
  public:
-  ExecCtx(memory::MemoryPool* pool, QueryCtx* queryCtx)
+  /// If 'sharedVectorPool' is set, recycles vectors through it instead of a
+  /// vector pool of its own, e.g. to share one between the operators of a
+  /// Driver. 'sharedVectorPool' must outlive 'this' and only be used by one
+  /// thread at a time.
+  ExecCtx(
+      memory::MemoryPool* pool,
+      QueryCtx* queryCtx,
+      VectorPool* sharedVectorPool = nullptr)
       : pool_(pool),
         queryCtx_(queryCtx),
         exprEvalCacheEnabled_(
             !queryCtx ||
             queryCtx->queryConfig().isExpressionEvaluationCacheEnabled()),
+        ownedVectorPool_(
+            exprEvalCacheEnabled_ && sharedVectorPool == nullptr
+                ? std::make_unique<VectorPool>(pool)
+                : nullptr),
         vectorPool_(
-            exprEvalCacheEnabled_ ? std::make_unique<VectorPool>(pool)
-                                  : nullptr) {}
+            exprEvalCacheEnabled_ && sharedVectorPool != nullptr
+                ? sharedVectorPool
+                : ownedVectorPool_.get()) {}
 
   velox::memory::MemoryPool* pool() const {
     return pool_;
@@ -293,7 +324,7 @@ class ExecCtx {
   }
 
   VectorPool* vectorPool() {
-    return vectorPool_.get();
+    return vectorPool_;
   }
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
@@ -328,6 +359,16 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// Returns the cache of expression results over dictionary bases shared by
+  /// the drivers of the task, or nullptr if there is none.
+  exec::ExprResultCache* exprResultCache() const {
+    return exprResultCache_;
+  }
+
+  void setExprResultCache(exec::ExprResultCache* cache) {
+    exprResultCache_ = cache;
+  }
+
  private:
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
@@ -339,7 +380,9 @@ class ExecCtx {
   // A pool of preallocated SelectivityVectors for use by expressions
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
-  std::unique_ptr<VectorPool> vectorPool_;
+  std::unique_ptr<VectorPool> ownedVectorPool_;
+  VectorPool* const vectorPool_;
+  exec::ExprResultCache* exprResultCache_{nullptr};
 };
 
 } // namespace facebook::velox::core
@@ -201,6 +201,65 @@ TEST_F(PlanFragmentTest, aggregationCanSpill) {
   }
 }
 
+TEST_F(PlanFragmentTest, aggregationOverDistinctInputsCanSpill) {
+  const std::vector<FieldAccessTypedExprPtr> groupingKeys{
+      std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "c0")};
+  const std::vector<TypedExprPtr> inputs{
+      std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "c1")};
+  const std::vector<FieldAccessTypedExprPtr> sortingKeys{
+      std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "c2")};
+  const auto sum =
+      std::make_shared<core::CallTypedExpr>(BIGINT(), inputs, "sum");
+  const AggregationNode::Aggregate plainSum{sum, {BIGINT()}, nullptr, {}, {}};
+  const AggregationNode::Aggregate distinctSum{
+      sum, {BIGINT()}, nullptr, {}, {}, true};
+  const AggregationNode::Aggregate sortedSum{
+      sum, {BIGINT()}, nullptr, sortingKeys, {SortOrder{true, true}}};
+
+  struct {
+    std::vector<AggregationNode::Aggregate> aggregates;
+    bool hashPartitioned;
+    bool expectedCanSpill;
+  } testSettings[] = {
+      {{plainSum, sortedSum}, false, true},
+      {{plainSum, sortedSum}, true, true},
+      {{plainSum, distinctSum}, false, false},
+      {{plainSum, distinctSum}, true, true},
+      // GroupingSet spills aggregations over sorted inputs with the sorted
+      // spill even if hash partitioned spill is enabled, which can't restore
+      // the de-duplicated inputs.
+      {{distinctSum, sortedSum}, false, false},
+      {{distinctSum, sortedSum}, true, false}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(fmt::format(
+        "numAggregates:{} hashPartitioned:{}",
+        testData.aggregates.size(),
+        testData.hashPartitioned));
+    const auto aggregation = std::make_shared<AggregationNode>(
+        "aggregation",
+        AggregationNode::Step::kSingle,
+        groupingKeys,
+        std::vector<FieldAccessTypedExprPtr>{},
+        std::vector<std::string>{"a0", "a1"},
+        testData.aggregates,
+        false,
+        valueNode_);
+    std::unordered_map<std::string, std::string> configData({
+        {QueryConfig::kSpillEnabled, "true"},
+        {QueryConfig::kAggregationSpillEnabled, "true"},
+        {QueryConfig::kAggregationSpillHashPartitioned,
+         testData.hashPartitioned ? "true" : "false"},
+    });
+    auto queryCtx =
+        QueryCtx::create(nullptr, QueryConfig{std::move(configData)});
+    const PlanFragment planFragment{aggregation};
+    ASSERT_EQ(
+        planFragment.canSpill(queryCtx->queryConfig()),
+        testData.expectedCanSpill);
+  }
+}
+
 TEST_F(PlanFragmentTest, hashJoin) {
   const std::vector<FieldAccessTypedExprPtr> buildKeys{
       std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "c0")};
@@ -16,10 +16,189 @@
 
 #include "velox/dwio/common/BitPackDecoder.h"
 
+#include "velox/common/process/ProcessBase.h"
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
 namespace facebook::velox::dwio::common {
 
 using int128_t = __int128_t;
 
+#ifdef __x86_64__
+
+// The AVX-512 kernels are compiled for these subsets regardless of the build
+// flags and are only called if process::hasAvx512Vbmi() is true.
+#define VELOX_AVX512_TARGET \
+  __attribute__((target("avx512f,avx512bw,avx512vl,avx512vbmi")))
+
+namespace {
+
+template <typename T>
+VELOX_AVX512_TARGET inline void
+store16Ints(__m512i sixteenInts, int32_t i, T* result) {
+  if constexpr (sizeof(T) == 4) {
+    _mm512_storeu_si512(result + i, sixteenInts);
+  } else if constexpr (sizeof(T) == 8) {
+    _mm512_storeu_si512(
+        result + i,
+        _mm512_cvtepu32_epi64(_mm512_castsi512_si256(sixteenInts)));
+    _mm512_storeu_si512(
+        result + i + 8,
+        _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(sixteenInts, 1)));
+  } else {
+    static_assert(sizeof(T) == 2);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(result + i),
+        _mm512_cvtepi32_epi16(sixteenInts));
+  }
+}
+
+// Loads the fields of 16 consecutive rows starting at 'row'. Moves the 4 bytes
+// that contain each field into its lane with a byte permute, so that a
+// single masked load replaces the gather. The load does not touch the bytes
+// after the last field, which are not necessarily addressable.
+template <uint8_t width>
+VELOX_AVX512_TARGET inline __m512i
+load16Dense(const uint64_t* bits, int32_t bitOffset, int32_t row) {
+  static_assert(width <= 25, "A field and its shift must fit in 32 bits");
+  // Bytes from the first to 4 bytes after the start of the last field.
+  constexpr int32_t kNumBytes = (7 + 15 * width) / 8 + 4;
+  const int64_t bit = static_cast<int64_t>(row) * width + bitOffset;
+  auto data = _mm512_maskz_loadu_epi8(
+      (1ULL << kNumBytes) - 1,
+      reinterpret_cast<const char*>(bits) + (bit >> 3));
+  const auto laneBits = _mm512_add_epi32(
+      _mm512_mullo_epi32(
+          _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0),
+          _mm512_set1_epi32(width)),
+      _mm512_set1_epi32(bit & 7));
+  // Byte i of each lane comes from byte (laneBits >> 3) + i of 'data'.
+  const auto permute = _mm512_add_epi32(
+      _mm512_mullo_epi32(
+          _mm512_srli_epi32(laneBits, 3), _mm512_set1_epi32(0x01010101)),
+      _mm512_set1_epi32(0x03020100));
+  auto words = _mm512_permutexvar_epi8(permute, data);
+  words = _mm512_srlv_epi32(
+      words, _mm512_and_si512(laneBits, _mm512_set1_epi32(7)));
+  return _mm512_and_si512(
+      words, _mm512_set1_epi32(static_cast<int32_t>(bits::lowMask(width))));
+}
+
+// Loads the fields of the 16 rows at 'rows' with gathers.
+template <uint8_t width>
+VELOX_AVX512_TARGET inline __m512i
+gather16Sparse(const uint64_t* bits, int32_t bitOffset, const int32_t* rows) {
+  const auto mask =
+      _mm512_set1_epi32(static_cast<int32_t>(bits::lowMask(width)));
+  const auto bitIndices = _mm512_add_epi32(
+      _mm512_mullo_epi32(_mm512_loadu_si512(rows), _mm512_set1_epi32(width)),
+      _mm512_set1_epi32(bitOffset));
+  const auto byteIndices = _mm512_srli_epi32(bitIndices, 3);
+  const auto shifts = _mm512_and_si512(bitIndices, _mm512_set1_epi32(7));
+  if constexpr (width <= 25) {
+    auto data = _mm512_i32gather_epi32(byteIndices, bits, 1);
+    return _mm512_and_si512(_mm512_srlv_epi32(data, shifts), mask);
+  } else {
+    // A field and its shift may not fit in 32 bits. Gathers 64 bit words.
+    auto low = _mm512_i32gather_epi64(
+        _mm512_castsi512_si256(byteIndices), bits, 1);
+    auto high = _mm512_i32gather_epi64(
+        _mm512_extracti64x4_epi64(byteIndices, 1), bits, 1);
+    low = _mm512_srlv_epi64(
+        low, _mm512_cvtepu32_epi64(_mm512_castsi512_si256(shifts)));
+    high = _mm512_srlv_epi64(
+        high, _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(shifts, 1)));
+    auto data = _mm512_inserti64x4(
+        _mm512_castsi256_si512(_mm512_cvtepi64_epi32(low)),
+        _mm512_cvtepi64_epi32(high),
+        1);
+    return _mm512_and_si512(data, mask);
+  }
+}
+
+// Decodes 16 rows at a time and returns the number of rows decoded.
+template <uint8_t width, typename T>
+VELOX_AVX512_TARGET int32_t decode1To32Avx512(
+    const uint64_t* bits,
+    int32_t bitOffset,
+    const int32_t* rows,
+    int32_t numRows,
+    T* result) {
+  int32_t i = 0;
+  for (; i + 16 <= numRows; i += 16) {
+    __m512i sixteenInts;
+    if constexpr (width <= 25) {
+      if (rows[i + 15] - rows[i] == 15) {
+        sixteenInts = load16Dense<width>(bits, bitOffset, rows[i]);
+      } else {
+        sixteenInts = gather16Sparse<width>(bits, bitOffset, rows + i);
+      }
+    } else {
+      sixteenInts = gather16Sparse<width>(bits, bitOffset, rows + i);
+    }
+    store16Ints(sixteenInts, i, result);
+  }
+  return i;
+}
+
+#define AVX512_WIDTH_CASE(width) \
+  case width:                    \
+    return decode1To32Avx512<width>(bits, bitOffset, rows, numRows, result);
+
+template <typename T>
+int32_t decodeAvx512(
+    const uint64_t* bits,
+    int32_t bitOffset,
+    const int32_t* rows,
+    int32_t numRows,
+    uint8_t bitWidth,
+    T* result) {
+  switch (bitWidth) {
+    AVX512_WIDTH_CASE(1);
+    AVX512_WIDTH_CASE(2);
+    AVX512_WIDTH_CASE(3);
+    AVX512_WIDTH_CASE(4);
+    AVX512_WIDTH_CASE(5);
+    AVX512_WIDTH_CASE(6);
+    AVX512_WIDTH_CASE(7);
+    AVX512_WIDTH_CASE(8);
+    AVX512_WIDTH_CASE(9);
+    AVX512_WIDTH_CASE(10);
+    AVX512_WIDTH_CASE(11);
+    AVX512_WIDTH_CASE(12);
+    AVX512_WIDTH_CASE(13);
+    AVX512_WIDTH_CASE(14);
+    AVX512_WIDTH_CASE(15);
+    AVX512_WIDTH_CASE(16);
+    AVX512_WIDTH_CASE(17);
+    AVX512_WIDTH_CASE(18);
+    AVX512_WIDTH_CASE(19);
+    AVX512_WIDTH_CASE(20);
+    AVX512_WIDTH_CASE(21);
+    AVX512_WIDTH_CASE(22);
+    AVX512_WIDTH_CASE(23);
+    AVX512_WIDTH_CASE(24);
+    AVX512_WIDTH_CASE(25);
+    AVX512_WIDTH_CASE(26);
+    AVX512_WIDTH_CASE(27);
+    AVX512_WIDTH_CASE(28);
+    AVX512_WIDTH_CASE(29);
+    AVX512_WIDTH_CASE(30);
+    AVX512_WIDTH_CASE(31);
+    AVX512_WIDTH_CASE(32);
+    default:
+      return 0;
+  }
+}
+
+#undef AVX512_WIDTH_CASE
+
+} // namespace
+
+#endif // __x86_64__
+
 #if XSIMD_WITH_AVX2
 
 typedef int32_t __m256si __attribute__((__vector_size__(32), __may_alias__));
@@ -236,9 +415,21 @@ void unpack(
   }
   int32_t i = 0;
 
+#ifdef __x86_64__
+  // Prefers AVX-512 when the CPU has it, for all widths up to 32.
+  [[maybe_unused]] bool decoded = false;
+  if constexpr (sizeof(T) <= sizeof(int64_t)) {
+    if (bitWidth <= 32 && process::hasAvx512Vbmi()) {
+      i = decodeAvx512(
+          bits, bitOffset, rows.data(), numSafeRows, bitWidth, result);
+      decoded = true;
+    }
+  }
+#endif
+
 #if XSIMD_WITH_AVX2
   // Use AVX2 for specific widths.
-  switch (bitWidth) {
+  switch (decoded ? 0 : bitWidth) {
     WIDTH_CASE(1);
     WIDTH_CASE(2);
     WIDTH_CASE(3);
@@ -165,6 +165,15 @@ size_t CacheInputStream::positionSize() {
   return 1;
 }
 
+std::optional<cache::DecompressedBlockKey>
+CacheInputStream::decompressedBlockKey(uint64_t offset) const {
+  if (noCacheRetention_ || tracker_ == nullptr ||
+      !tracker_->shouldPrefetch(trackingId_, kDecompressedCacheMinReadPct)) {
+    return std::nullopt;
+  }
+  return cache::DecompressedBlockKey{fileNum_, region_.offset + offset};
+}
+
 void CacheInputStream::setRemainingBytes(uint64_t remainingBytes) {
   VELOX_CHECK_GE(region_.length, position_ + remainingBytes);
   window_ = Region{static_cast<uint64_t>(position_), remainingBytes};
@@ -246,14 +255,16 @@ void CacheInputStream::loadSync(const Region& region) {
       return;
     }
     const auto ranges = makeRanges(entry, region.length);
-    uint64_t storageReadUs{0};
-    {
-      MicrosecondTimer timer(&storageReadUs);
-      input_->read(ranges, region.offset, LogType::FILE);
+    if (!loadFromPeer(region, ranges)) {
+      uint64_t storageReadUs{0};
+      {
+        MicrosecondTimer timer(&storageReadUs);
+        input_->read(ranges, region.offset, LogType::FILE);
+      }
+      ioStats_->read().increment(region.length);
+      ioStats_->queryThreadIoLatency().increment(storageReadUs);
+      ioStats_->incTotalScanTime(storageReadUs * 1'000);
     }
-    ioStats_->read().increment(region.length);
-    ioStats_->queryThreadIoLatency().increment(storageReadUs);
-    ioStats_->incTotalScanTime(storageReadUs * 1'000);
     entry->setExclusiveToShared(!noCacheRetention_);
   } while (pin_.empty());
 }
@@ -282,11 +293,11 @@ bool CacheInputStream::loadFromSsd(
     return false;
   }
 
-  if (ssdPin.run().size() < entry.size()) {
+  if (ssdPin.run().rawSize() < entry.size()) {
     LOG(INFO) << fmt::format(
         "IOERR: Ssd entry for {} shorter than requested {}",
         entry.toString(),
-        ssdPin.run().size());
+        ssdPin.run().rawSize());
     return false;
   }
 
@@ -324,6 +335,27 @@ bool CacheInputStream::loadFromSsd(
   return true;
 }
 
+bool CacheInputStream::loadFromPeer(
+    const Region& region,
+    const std::vector<folly::Range<char*>>& ranges) {
+  auto* peer = cache_->cachePeer();
+  if (peer == nullptr) {
+    return false;
+  }
+  uint64_t peerReadUs{0};
+  bool success;
+  {
+    MicrosecondTimer timer(&peerReadUs);
+    success = peer->read(fileIds().string(fileNum_), region.offset, ranges);
+  }
+  ioStats_->queryThreadIoLatency().increment(peerReadUs);
+  if (!success) {
+    return false;
+  }
+  ioStats_->peerRead().increment(region.length);
+  return true;
+}
+
 std::string CacheInputStream::ssdFileName() const {
   auto ssdCache = cache_->ssdCache();
   if (!ssdCache) {
@@ -51,6 +51,24 @@ class CacheInputStream : public SeekableInputStream {
   std::string getName() const override;
   size_t positionSize() override;
 
+  /// Decompressed blocks are cached for streams that are retained in the
+  /// cache and read at least 'kDecompressedCacheMinReadPct' % of the times
+  /// they are referenced.
+  std::optional<cache::DecompressedBlockKey> decompressedBlockKey(
+      uint64_t offset) const override;
+
+  static constexpr int32_t kDecompressedCacheMinReadPct = 80;
+
+  /// Dictionaries decoded from streams that are retained in the cache are
+  /// kept in cache::DecodedDictionaryCache.
+  std::optional<cache::DecodedDictionaryKey> decodedDictionaryKey()
+      const override {
+    if (noCacheRetention_) {
+      return std::nullopt;
+    }
+    return cache::DecodedDictionaryKey{fileNum_, region_.offset};
+  }
+
   /// Returns a copy of 'this', ranging over the same bytes. The clone is
   /// initially positioned at the position of 'this' and can be moved
   /// independently within 'region_'.  This is used for first caching a range of
@@ -114,6 +132,12 @@ class CacheInputStream : public SeekableInputStream {
       const velox::common::Region& region,
       cache::AsyncDataCacheEntry& entry);
 
+  // Returns true if there is a cache peer and it filled 'ranges' with the data
+  // of 'region'.
+  bool loadFromPeer(
+      const velox::common::Region& region,
+      const std::vector<folly::Range<char*>>& ranges);
+
   // Invoked to clear the cache pin of the accessed cache entry and mark it as
   // immediate evictable if 'noCacheRetention_' flag is set.
   void clearCachePin();
@@ -15,9 +15,13 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/io/IoConcurrencyLimiter.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
+#include "velox/dwio/common/StorageLatencyModel.h"
 
 DEFINE_int32(
     cache_prefetch_min_pct,
@@ -185,15 +189,17 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
         auto parts = makeRequestParts(
             request, trackingData, options_.loadQuantum(), extraRequests);
         for (auto part : parts) {
+          part->dense = isPrefetchPct(readPct);
           if (cache_->exists(part->key)) {
             continue;
           }
           if (ssdFile != nullptr) {
             part->ssdPin = ssdFile->find(part->key);
             if (!part->ssdPin.empty() &&
-                part->ssdPin.run().size() < part->size) {
+                part->ssdPin.run().rawSize() < part->size) {
               LOG(INFO) << "IOERR: Ignoring SSD shorter than requested: "
-                        << part->ssdPin.run().size() << " vs " << part->size;
+                        << part->ssdPin.run().rawSize() << " vs "
+                        << part->size;
               part->ssdPin.clear();
             }
             if (!part->ssdPin.empty()) {
@@ -217,7 +223,11 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   const bool isSsd = !requests[0]->ssdPin.empty();
-  const int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  const auto coalescing = isSsd
+      ? StorageLatencyModel::Coalescing{20000, options_.maxCoalesceBytes()}
+      : StorageLatencyModel::coalescing(
+            *input_->getReadFile(), options_, ioStats_.get());
+  const int32_t maxDistance = coalescing.maxDistance;
   std::sort(
       requests.begin(),
       requests.end(),
@@ -247,7 +257,7 @@ void CachedBufferedInput::makeLoads(
         return size;
       },
       [&](int32_t index) {
-        if (coalescedBytes > options_.maxCoalesceBytes()) {
+        if (coalescedBytes > coalescing.maxBytes) {
           coalescedBytes = 0;
           return kNoCoalesce;
         }
@@ -263,19 +273,32 @@ void CachedBufferedInput::makeLoads(
           uint64_t /*offset*/,
           const std::vector<CacheRequest*>& ranges) {
         ++numNewLoads;
-        readRegion(ranges, prefetch);
+        readRegion(ranges, prefetch, maxDistance);
       });
 
   if (prefetch && (executor_ != nullptr)) {
+    auto* limiter = io::IoConcurrencyLimiter::instance();
+    const auto fileName =
+        limiter != nullptr ? input_->getReadFile()->getName() : "";
     std::vector<int32_t> doneIndices;
     for (auto i = 0; i < allCoalescedLoads_.size(); ++i) {
       auto& load = allCoalescedLoads_[i];
       if (load->state() == CoalescedLoad::State::kPlanned) {
-        executor_->add(
-            [pendingLoad = load, ssdSavable = !options_.noCacheRetention()]() {
-              process::TraceContext trace("Read Ahead");
-              pendingLoad->loadOrFuture(nullptr, ssdSavable);
-            });
+        std::optional<io::IoConcurrencyLimiter::Permit> permit;
+        if (limiter != nullptr) {
+          // A load over the limit of the storage location stays planned and
+          // is read by the first thread that needs it.
+          permit = limiter->tryAcquire(fileName);
+          if (!permit.has_value()) {
+            continue;
+          }
+        }
+        executor_->add([pendingLoad = load,
+                        ssdSavable = !options_.noCacheRetention(),
+                        permit = std::move(permit)]() {
+          process::TraceContext trace("Read Ahead");
+          pendingLoad->loadOrFuture(nullptr, ssdSavable);
+        });
       } else {
         doneIndices.push_back(i);
       }
@@ -335,7 +358,13 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   }
 
  protected:
-  void updateStats(const CoalesceIoStats& stats, bool prefetch, bool ssd) {
+  // 'peerBytes' is the part of the payload that was read from a cache peer
+  // instead of storage.
+  void updateStats(
+      const CoalesceIoStats& stats,
+      bool prefetch,
+      bool ssd,
+      uint64_t peerBytes = 0) {
     if (ioStats_ == nullptr) {
       return;
     }
@@ -343,7 +372,12 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
     if (ssd) {
       ioStats_->ssdRead().increment(stats.payloadBytes);
     } else {
-      ioStats_->read().increment(stats.payloadBytes);
+      if (stats.payloadBytes > peerBytes) {
+        ioStats_->read().increment(stats.payloadBytes - peerBytes);
+      }
+      if (peerBytes > 0) {
+        ioStats_->peerRead().increment(peerBytes);
+      }
     }
     if (prefetch) {
       ioStats_->prefetch().increment(stats.payloadBytes);
@@ -396,15 +430,20 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
-        [&](int32_t /*index*/, CachePin pin) {
+        [&](int32_t index, CachePin pin) {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          if (requests_[index].dense) {
+            pin.checkedEntry()->setDense();
+          }
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
       return pins;
     }
+    auto* peer = cache_.cachePeer();
+    uint64_t peerBytes = 0;
     auto stats = cache::readPins(
         pins,
         maxCoalesceDistance_,
@@ -415,9 +454,29 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          if (peer != nullptr &&
+              peer->read(
+                  fileIds().string(keys_[0].fileNum), offset, buffers)) {
+            for (const auto& buffer : buffers) {
+              if (buffer.data() != nullptr) {
+                peerBytes += buffer.size();
+              }
+            }
+            return;
+          }
+          uint64_t usecs = 0;
+          {
+            MicrosecondTimer timer(&usecs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          uint64_t bytes = 0;
+          for (const auto& buffer : buffers) {
+            bytes += buffer.size();
+          }
+          StorageLatencyModel::forFile(*input_->getReadFile())
+              .recordRead(bytes, usecs);
         });
-    updateStats(stats, prefetch, false);
+    updateStats(stats, prefetch, false, peerBytes);
     return pins;
   }
 
@@ -445,6 +504,9 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          if (requests_[index].dense) {
+            pin.checkedEntry()->setDense();
+          }
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
@@ -462,7 +524,8 @@ class SsdLoad : public DwioCoalescedLoadBase {
 
 void CachedBufferedInput::readRegion(
     const std::vector<CacheRequest*>& requests,
-    bool prefetch) {
+    bool prefetch,
+    int32_t maxCoalesceDistance) {
   if (requests.empty() || (requests.size() == 1 && !prefetch)) {
     return;
   }
@@ -477,7 +540,7 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        maxCoalesceDistance);
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
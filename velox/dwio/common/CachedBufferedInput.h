@@ -51,6 +51,10 @@ struct CacheRequest {
   /// accessed large columns where hitting one piece should not load the
   /// adjacent pieces.
   bool coalesces{true};
+
+  /// True if this is from a stream that is read for most of its references.
+  /// The cache retains such data preferentially.
+  bool dense{false};
   const SeekableInputStream* stream;
 };
 
@@ -178,8 +182,11 @@ class CachedBufferedInput : public BufferedInput {
   // Makes a CoalescedLoad for 'requests' to be read together, coalescing IO is
   // appropriate. If 'prefetch' is set, schedules the CoalescedLoad on
   // 'executor_'. Links the CoalescedLoad to all CacheInputStreams that it
-  // concerns.
-  void readRegion(const std::vector<CacheRequest*>& requests, bool prefetch);
+  // concerns. Ranges at most 'maxCoalesceDistance' apart are read together.
+  void readRegion(
+      const std::vector<CacheRequest*>& requests,
+      bool prefetch,
+      int32_t maxCoalesceDistance);
 
   // We only support up to 8MB load quantum size on SSD and there is no need for
   // larger SSD read size performance wise.
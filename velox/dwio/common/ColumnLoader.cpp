@@ -78,6 +78,9 @@ void ColumnLoader::loadInternal(
     effectiveRows = RowSet(selectedRows);
   }
 
+  // The parent nulls of this read were recorded in 'fieldReader_' as if it
+  // was skipped.
+  fieldReader_->retractParentNulls();
   structReader_->advanceFieldReader(fieldReader_, offset);
   fieldReader_->scanSpec()->setValueHook(hook);
   fieldReader_->read(offset, effectiveRows, incomingNulls);
@@ -18,6 +18,7 @@
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/DirectInputStream.h"
+#include "velox/dwio/common/StorageLatencyModel.h"
 
 DECLARE_int32(cache_prefetch_min_pct);
 
@@ -127,13 +128,14 @@ void DirectBufferedInput::makeLoads(
     // eligible to prefetch. This will be loaded by itself on first use.
     return;
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  const auto coalescing = StorageLatencyModel::coalescing(
+      *input_->getReadFile(), options_, ioStats_.get());
+  const int32_t maxDistance = coalescing.maxDistance;
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
   // is correlated.
-  const auto maxCoalesceBytes =
-      prefetch ? options_.maxCoalesceBytes() : loadQuantum;
+  const auto maxCoalesceBytes = prefetch ? coalescing.maxBytes : loadQuantum;
   std::sort(
       requests.begin(),
       requests.end(),
@@ -280,6 +282,8 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
     MicrosecondTimer timer(&usecs);
     input_->read(buffers, requests_[0].region.offset, LogType::FILE);
   }
+  StorageLatencyModel::forFile(*input_->getReadFile())
+      .recordRead(size + overread, usecs);
 
   ioStats_->read().increment(size + overread);
   ioStats_->incRawBytesRead(size);
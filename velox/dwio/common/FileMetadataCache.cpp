@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+FileMetadataCache*& instance() {
+  static FileMetadataCache* cache{nullptr};
+  return cache;
+}
+} // namespace
+
+FileMetadataCache::FileMetadataCache(
+    std::shared_ptr<memory::MemoryPool> pool,
+    uint64_t maxBytes)
+    : pool_{std::move(pool)}, maxBytes_{maxBytes} {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+FileMetadataCache::~FileMetadataCache() {
+  // The metadata may hold buffers from 'pool_'.
+  clear();
+}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return instance();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  instance() = cache;
+}
+
+// static
+std::string FileMetadataCache::makeKey(
+    const std::string& fileName,
+    int64_t modificationTime,
+    uint64_t fileSize) {
+  return fmt::format("{}:{}:{}", fileName, modificationTime, fileSize);
+}
+
+std::shared_ptr<const void> FileMetadataCache::getImpl(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++numMisses_;
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::putImpl(
+    const std::string& key,
+    std::shared_ptr<const void> metadata,
+    uint64_t bytes) {
+  if (bytes > maxBytes_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    eraseLocked(it->second);
+  }
+  lru_.push_front(Entry{key, std::move(metadata), bytes});
+  entries_[key] = lru_.begin();
+  bytes_ += bytes;
+  while (bytes_ > maxBytes_) {
+    eraseLocked(std::prev(lru_.end()));
+    ++numEvictions_;
+  }
+}
+
+void FileMetadataCache::eraseLocked(EntryList::iterator it) {
+  bytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return {numHits_, numMisses_, numEvictions_, entries_.size(), bytes_};
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <typeinfo>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Process-wide cache of the parsed metadata at the tail of files, e.g. the
+/// DWRF post script, footer, stripe footers and row indexes or the Parquet
+/// FileMetaData. Shared by all the readers of the same file so that the splits
+/// of a file do not each read and parse its tail. The entries are immutable
+/// and are released when the least recently used entries take more than
+/// 'maxBytes'. A reader keeps the metadata it got alive after it is evicted.
+///
+/// Entries are keyed by a string from makeKey() that changes when the file is
+/// rewritten. The readers only use the cache if a key is set in their
+/// ReaderOptions. Thread-safe.
+class FileMetadataCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+  };
+
+  /// @param pool Pool for the buffers of the cached metadata.
+  FileMetadataCache(std::shared_ptr<memory::MemoryPool> pool, uint64_t maxBytes);
+
+  ~FileMetadataCache();
+
+  /// Returns the process-wide instance or nullptr if none is set.
+  static FileMetadataCache* getInstance();
+
+  /// Sets the process-wide instance. The caller keeps the ownership.
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the key of the contents of 'fileName' as of 'modificationTime'.
+  static std::string makeKey(
+      const std::string& fileName,
+      int64_t modificationTime,
+      uint64_t fileSize);
+
+  /// Returns the metadata of type T for 'key', or nullptr if not found.
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& key) {
+    return std::static_pointer_cast<const T>(getImpl(typedKey<T>(key)));
+  }
+
+  /// Adds 'metadata' for 'key'. 'bytes' is the memory held by 'metadata'.
+  /// Replaces the entry of another reader that added the same file meanwhile.
+  template <typename T>
+  void put(
+      const std::string& key,
+      std::shared_ptr<const T> metadata,
+      uint64_t bytes) {
+    putImpl(typedKey<T>(key), std::move(metadata), bytes);
+  }
+
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  Stats stats() const;
+
+  /// Drops all the entries.
+  void clear();
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const void> metadata;
+    uint64_t bytes;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // Keeps apart the metadata of the formats if 'key' is reused.
+  template <typename T>
+  static std::string typedKey(const std::string& key) {
+    return fmt::format("{}:{}", typeid(T).name(), key);
+  }
+
+  std::shared_ptr<const void> getImpl(const std::string& key);
+
+  void putImpl(
+      const std::string& key,
+      std::shared_ptr<const void> metadata,
+      uint64_t bytes);
+
+  void eraseLocked(EntryList::iterator it);
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const uint64_t maxBytes_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  EntryList lru_;
+  folly::F14FastMap<std::string, EntryList::iterator> entries_;
+  uint64_t bytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -19,6 +19,8 @@
 #include "velox/common/base/Fs.h"
 #include "velox/dwio/common/exception/Exception.h"
 
+#include <folly/executors/SerialExecutor.h>
+
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <unistd.h>
@@ -191,6 +193,65 @@ void MemorySink::write(std::vector<DataBuffer<char>>& buffers) {
   });
 }
 
+AsyncFileSink::AsyncFileSink(
+    std::unique_ptr<FileSink> sink,
+    folly::Executor* executor,
+    uint64_t maxInFlightBytes)
+    : FileSink{sink->name(), {.metricLogger = sink->metricsLog()}},
+      sink_{std::move(sink)},
+      serialExecutor_{folly::SerialExecutor::create(
+          folly::getKeepAliveToken(executor))},
+      maxInFlightBytes_{maxInFlightBytes} {
+  VELOX_CHECK_NOT_NULL(executor);
+  VELOX_CHECK_GT(maxInFlightBytes_, 0);
+}
+
+AsyncFileSink::~AsyncFileSink() {
+  // The pending writes reference 'sink_' and must finish before it goes away.
+  for (auto& pending : pendingWrites_) {
+    pending.future.wait();
+  }
+  pendingWrites_.clear();
+  destroy();
+}
+
+void AsyncFileSink::write(std::vector<DataBuffer<char>>& buffers) {
+  DWIO_ENSURE(!isClosed(), "Cannot write to closed sink.");
+  uint64_t bytes{0};
+  for (const auto& buffer : buffers) {
+    bytes += buffer.size();
+  }
+  while (!pendingWrites_.empty() &&
+         inFlightBytes_ + bytes > maxInFlightBytes_) {
+    waitForOldestWrite();
+  }
+  size_ += bytes;
+  inFlightBytes_ += bytes;
+  pendingWrites_.push_back(
+      {folly::via(
+           serialExecutor_,
+           [this, buffers = std::move(buffers)]() mutable {
+             sink_->write(buffers);
+           }),
+       bytes});
+  buffers.clear();
+}
+
+void AsyncFileSink::waitForOldestWrite() {
+  VELOX_CHECK(!pendingWrites_.empty());
+  auto pending = std::move(pendingWrites_.front());
+  pendingWrites_.pop_front();
+  inFlightBytes_ -= pending.bytes;
+  std::move(pending.future).get();
+}
+
+void AsyncFileSink::doClose() {
+  while (!pendingWrites_.empty()) {
+    waitForOldestWrite();
+  }
+  sink_->close();
+}
+
 VELOX_REGISTER_DATA_SINK_METHOD_DEFINITION(LocalFileSink, localFileSink);
 
 void registerFileSinks() {
@@ -17,6 +17,10 @@
 #pragma once
 
 #include <chrono>
+#include <deque>
+
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
 
 #include "velox/common/file/File.h"
 #include "velox/common/io/IoStatistics.h"
@@ -201,6 +205,57 @@ class MemorySink : public FileSink {
   DataBuffer<char> data_;
 };
 
+/// Writes through to another file sink on an executor, so that the writer
+/// encodes the next stripe while the previous one is being written. Writes
+/// run in order, one at a time. The written buffers stay allocated from the
+/// memory pool of the writer until they are written, so the memory of
+/// in-flight writes is accounted to the writer. A write blocks while more than
+/// 'maxInFlightBytes' are being written. Errors of asynchronous writes are
+/// thrown by the next write or by close().
+class AsyncFileSink : public FileSink {
+ public:
+  AsyncFileSink(
+      std::unique_ptr<FileSink> sink,
+      folly::Executor* executor,
+      uint64_t maxInFlightBytes);
+
+  ~AsyncFileSink() override;
+
+  bool isBuffered() const override {
+    return sink_->isBuffered();
+  }
+
+  using FileSink::write;
+
+  void write(std::vector<DataBuffer<char>>& buffers) override;
+
+  /// Number of bytes given to write() and not yet written to the underlying
+  /// sink.
+  uint64_t inFlightBytes() const {
+    return inFlightBytes_;
+  }
+
+ protected:
+  void doClose() override;
+
+ private:
+  struct PendingWrite {
+    folly::Future<folly::Unit> future;
+    uint64_t bytes;
+  };
+
+  // Waits for the oldest pending write and throws its error if any.
+  void waitForOldestWrite();
+
+  const std::unique_ptr<FileSink> sink_;
+  // Runs the writes to 'sink_' one at a time in submission order.
+  const folly::Executor::KeepAlive<> serialExecutor_;
+  const uint64_t maxInFlightBytes_;
+
+  std::deque<PendingWrite> pendingWrites_;
+  uint64_t inFlightBytes_{0};
+};
+
 void registerFileSinks();
 
 } // namespace facebook::velox::dwio::common
@@ -27,6 +27,8 @@
 #include <string_view>
 #include <type_traits>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/LatencyHistogram.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -42,6 +44,17 @@ int64_t totalBufferSize(const std::vector<folly::Range<char*>>& buffers) {
   }
   return bufferSize;
 }
+
+// Returns the histogram of the read latencies of the file system of 'path'.
+// The file system is named by the scheme of 'path', e.g. 's3' or 'hdfs', or
+// 'local' if 'path' has no scheme.
+LatencyHistogram* readLatencyHistogram(const std::string& path) {
+  const auto schemeEnd = path.find("://");
+  const auto scheme =
+      schemeEnd == std::string::npos ? "local" : path.substr(0, schemeEnd);
+  return LatencyHistogram::get(
+      fmt::format("{}.{}", kMetricStorageReadLatencyUs.str(), scheme));
+}
 } // namespace
 
 folly::SemiFuture<uint64_t> InputStream::readAsync(
@@ -65,7 +78,8 @@ ReadFileInputStream::ReadFileInputStream(
     const MetricsLogPtr& metricsLog,
     IoStatistics* stats)
     : InputStream(readFile->getName(), metricsLog, stats),
-      readFile_(std::move(readFile)) {}
+      readFile_(std::move(readFile)),
+      readLatency_(readLatencyHistogram(path_)) {}
 
 void ReadFileInputStream::read(
     void* buf,
@@ -78,8 +92,10 @@ void ReadFileInputStream::read(
   std::string_view readData;
   {
     MicrosecondTimer timer(&readTimeUs);
+    io::ScopedIoStatistics scopedStats(stats_);
     readData = readFile_->pread(offset, length, buf);
   }
+  readLatency_->record(readTimeUs);
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime(readTimeUs * 1'000);
@@ -101,7 +117,14 @@ void ReadFileInputStream::read(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
-  const auto size = readFile_->preadv(offset, buffers);
+  uint64_t readTimeUs{0};
+  uint64_t size;
+  {
+    MicrosecondTimer timer(&readTimeUs);
+    io::ScopedIoStatistics scopedStats(stats_);
+    size = readFile_->preadv(offset, buffers);
+  }
+  readLatency_->record(readTimeUs);
   VELOX_CHECK_EQ(
       size,
       bufferSize,
@@ -137,10 +160,15 @@ void ReadFileInputStream::vread(
       [&](size_t acc, const auto& r) { return acc + r.length; });
   logRead(regions[0].offset, length, purpose);
   auto readStartMicros = getCurrentTimeMicro();
-  readFile_->preadv(regions, iobufs);
+  {
+    io::ScopedIoStatistics scopedStats(stats_);
+    readFile_->preadv(regions, iobufs);
+  }
+  const auto readTimeUs = getCurrentTimeMicro() - readStartMicros;
+  readLatency_->record(readTimeUs);
   if (stats_) {
     stats_->incRawBytesRead(length);
-    stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
+    stats_->incTotalScanTime(readTimeUs * 1000);
   }
 }
 
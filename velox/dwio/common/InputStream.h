@@ -30,6 +30,7 @@
 #include <utility>
 #include <vector>
 
+#include "velox/common/base/LatencyHistogram.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/Region.h"
 #include "velox/common/io/IoStatistics.h"
@@ -178,6 +179,8 @@ class ReadFileInputStream final : public InputStream {
 
  private:
   std::shared_ptr<velox::ReadFile> readFile_;
+  // The latencies of the reads of the file system of 'readFile_'.
+  LatencyHistogram* const readLatency_;
 };
 
 } // namespace facebook::velox::dwio::common
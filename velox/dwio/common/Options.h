@@ -23,6 +23,7 @@
 #include "velox/common/base/RandomUtil.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/ColumnSelector.h"
@@ -530,6 +531,32 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the maximum number of bytes of IO for the units, i.e. DWRF stripes
+  /// or Parquet row groups, that are loaded ahead of the unit being read. At
+  /// most prefetchRowGroups() units are loaded ahead. 0 loads the DWRF stripes
+  /// on demand and does not limit the Parquet row groups by size. DWRF only
+  /// prefetches if ioExecutor() is set.
+  ReaderOptions& setUnitPrefetchBytes(uint64_t bytes) {
+    unitPrefetchBytes_ = bytes;
+    return *this;
+  }
+
+  /// Sets the key of the file in the process-wide FileMetadataCache. The
+  /// parsed file tail is looked up and added under 'key' if the cache is set.
+  /// Empty does not use the cache. The key must change when the file is
+  /// rewritten, see FileMetadataCache::makeKey().
+  ReaderOptions& setFileMetadataCacheKey(std::string key) {
+    fileMetadataCacheKey_ = std::move(key);
+    return *this;
+  }
+
+  /// Sets the statistics that get the hits and misses of the
+  /// FileMetadataCache.
+  ReaderOptions& setIoStatistics(std::shared_ptr<io::IoStatistics> ioStats) {
+    ioStats_ = std::move(ioStats);
+    return *this;
+  }
+
   ReaderOptions& setSessionTimezone(const date::time_zone* sessionTimezone) {
     sessionTimezone_ = sessionTimezone;
     return *this;
@@ -574,6 +601,18 @@ class ReaderOptions : public io::ReaderOptions {
     return ioExecutor_;
   }
 
+  uint64_t unitPrefetchBytes() const {
+    return unitPrefetchBytes_;
+  }
+
+  const std::string& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
+
+  const std::shared_ptr<io::IoStatistics>& ioStatistics() const {
+    return ioStats_;
+  }
+
   const date::time_zone* getSessionTimezone() const {
     return sessionTimezone_;
   }
@@ -621,6 +660,9 @@ class ReaderOptions : public io::ReaderOptions {
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
+  uint64_t unitPrefetchBytes_{0};
+  std::string fileMetadataCacheKey_;
+  std::shared_ptr<io::IoStatistics> ioStats_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
   const date::time_zone* sessionTimezone_{nullptr};
@@ -638,8 +680,13 @@ struct WriterOptions {
   std::optional<uint64_t> maxDictionaryMemory{std::nullopt};
   std::map<std::string, std::string> serdeParameters;
   std::optional<uint8_t> parquetWriteTimestampUnit;
+  std::optional<bool> parquetAdaptiveEncoding;
   std::optional<uint8_t> zlibCompressionLevel;
   std::optional<uint8_t> zstdCompressionLevel;
+  /// Executor and number of threads for encoding the columns of a write in
+  /// parallel, for the formats that support it.
+  folly::Executor* encodingExecutor{nullptr};
+  size_t encodingParallelismFactor{0};
 };
 
 } // namespace facebook::velox::dwio::common
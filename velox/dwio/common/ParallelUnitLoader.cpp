@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ParallelUnitLoader.h"
+
+#include <numeric>
+
+#include <folly/ScopeGuard.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+#include "velox/dwio/common/UnitLoaderTools.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class ParallelUnitLoader : public UnitLoader {
+ public:
+  ParallelUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      std::shared_ptr<folly::Executor> ioExecutor,
+      uint32_t maxUnitsAhead,
+      uint64_t maxBytesAhead,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      uint32_t firstUnit)
+      : loadUnits_{std::move(loadUnits)},
+        ioExecutor_{std::move(ioExecutor)},
+        maxUnitsAhead_{maxUnitsAhead},
+        maxBytesAhead_{maxBytesAhead},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+        units_(loadUnits_.size()) {
+    prefetch(firstUnit);
+  }
+
+  ~ParallelUnitLoader() override {
+    // The loads in the background reference 'loadUnits_'.
+    for (auto& state : units_) {
+      if (state.future.valid()) {
+        *state.canceled = true;
+        std::move(state.future).wait();
+      }
+    }
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+
+    releaseOutsideWindow(unit);
+    prefetch(unit);
+    auto& state = units_[unit];
+    if (!state.loaded) {
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      finishLoad(state);
+    }
+    // The size of 'unit' is known now, so more units may fit in the budget.
+    prefetch(unit);
+    return *loadUnits_[unit];
+  }
+
+  bool isLoading(uint32_t unit, ContinueFuture& future) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    prefetch(unit);
+    auto& state = units_[unit];
+    if (state.loaded || !state.future.valid() || state.done->isFulfilled()) {
+      return false;
+    }
+    future = state.done->getSemiFuture();
+    return true;
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+    // The reader is past the units before 'unit'.
+    releaseOutsideWindow(unit);
+    prefetch(unit);
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+    releaseOutsideWindow(unit);
+    prefetch(unit);
+  }
+
+ private:
+  struct UnitState {
+    // Set while the unit is loading in the background. The value is the IO
+    // size of the unit, or std::nullopt if the load was canceled before it
+    // started.
+    folly::SemiFuture<std::optional<uint64_t>> future{
+        folly::SemiFuture<std::optional<uint64_t>>::makeEmpty()};
+    std::shared_ptr<std::atomic_bool> canceled;
+    // Realized when the background load is done, for waiting without taking
+    // 'future'.
+    std::shared_ptr<folly::SharedPromise<folly::Unit>> done;
+    bool loaded{false};
+    uint64_t ioSize{0};
+  };
+
+  // Starts loading 'unit' and the units after it that fit in the window and
+  // the byte budget.
+  void prefetch(uint32_t unit) {
+    const auto end =
+        std::min<uint64_t>(loadUnits_.size(), unit + maxUnitsAhead_ + 1);
+    uint64_t bytesAhead = 0;
+    for (auto i = unit; i < end; ++i) {
+      auto& state = units_[i];
+      if (!state.loaded && !state.future.valid()) {
+        startLoad(i);
+      }
+      if (i == unit) {
+        continue;
+      }
+      if (!state.loaded) {
+        if (!state.future.isReady() || state.future.hasException()) {
+          // The size of this unit is not known yet.
+          break;
+        }
+        finishLoad(state);
+      }
+      bytesAhead += state.ioSize;
+      if (bytesAhead >= maxBytesAhead_) {
+        break;
+      }
+    }
+  }
+
+  void startLoad(uint32_t unit) {
+    auto& state = units_[unit];
+    state.canceled = std::make_shared<std::atomic_bool>(false);
+    state.done = std::make_shared<folly::SharedPromise<folly::Unit>>();
+    state.future = folly::via(
+                       ioExecutor_.get(),
+                       [loadUnit = loadUnits_[unit].get(),
+                        canceled = state.canceled,
+                        done = state.done]() -> std::optional<uint64_t> {
+                         SCOPE_EXIT {
+                           done->setValue();
+                         };
+                         if (*canceled) {
+                           return std::nullopt;
+                         }
+                         loadUnit->load();
+                         return loadUnit->getIoSize();
+                       })
+                       .semi();
+  }
+
+  // Waits for the load of 'state' to finish. Throws if the load failed.
+  void finishLoad(UnitState& state) {
+    VELOX_CHECK(state.future.valid());
+    auto ioSize = std::move(state.future).get();
+    state.loaded = ioSize.has_value();
+    state.ioSize = ioSize.value_or(0);
+  }
+
+  // Unloads the units before 'unit' and after the window that starts at
+  // 'unit', and cancels their loads.
+  void releaseOutsideWindow(uint32_t unit) {
+    for (uint32_t i = 0; i < units_.size(); ++i) {
+      if (i >= unit && i <= unit + maxUnitsAhead_) {
+        continue;
+      }
+      auto& state = units_[i];
+      if (state.future.valid()) {
+        *state.canceled = true;
+        auto ioSize = std::move(state.future).getTry();
+        state.loaded = ioSize.hasValue() && ioSize.value().has_value();
+      }
+      if (state.loaded) {
+        loadUnits_[i]->unload();
+        state.loaded = false;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  const std::shared_ptr<folly::Executor> ioExecutor_;
+  const uint32_t maxUnitsAhead_;
+  const uint64_t maxBytesAhead_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  // 1:1 to 'loadUnits_'.
+  std::vector<UnitState> units_;
+};
+
+} // namespace
+
+ParallelUnitLoaderFactory::ParallelUnitLoaderFactory(
+    std::shared_ptr<folly::Executor> ioExecutor,
+    uint32_t maxUnitsAhead,
+    uint64_t maxBytesAhead,
+    std::function<void(std::chrono::high_resolution_clock::duration)>
+        blockedOnIoCallback)
+    : ioExecutor_{std::move(ioExecutor)},
+      maxUnitsAhead_{maxUnitsAhead},
+      maxBytesAhead_{maxBytesAhead},
+      blockedOnIoCallback_{std::move(blockedOnIoCallback)} {
+  VELOX_CHECK_NOT_NULL(ioExecutor_);
+}
+
+std::unique_ptr<UnitLoader> ParallelUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  const auto totalRows = std::accumulate(
+      loadUnits.cbegin(), loadUnits.cend(), 0UL, [](uint64_t sum, auto& unit) {
+        return sum + unit->getNumRows();
+      });
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  std::vector<uint64_t> rowsPerUnit;
+  rowsPerUnit.reserve(loadUnits.size());
+  for (const auto& unit : loadUnits) {
+    rowsPerUnit.push_back(unit->getNumRows());
+  }
+  const auto firstUnit = unit_loader_tools::howMuchToSkip(
+                             rowsToSkip, rowsPerUnit.cbegin(), rowsPerUnit.cend())
+                             .first;
+  return std::make_unique<ParallelUnitLoader>(
+      std::move(loadUnits),
+      ioExecutor_,
+      maxUnitsAhead_,
+      maxBytesAhead_,
+      blockedOnIoCallback_,
+      firstUnit);
+}
+
+} // namespace facebook::velox::dwio::common
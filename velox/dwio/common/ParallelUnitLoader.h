@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Creates UnitLoaders that load the units following the one being read in
+/// the background on 'ioExecutor', so that the reader does not stall on IO at
+/// each unit boundary. At most 'maxUnitsAhead' units after the one being read
+/// are loaded or loading at any time. A unit is only started if the units
+/// between it and the one being read take less than 'maxBytesAhead' bytes of
+/// IO. The loaded units allocate from the memory pool of the reader.
+///
+/// A unit is unloaded as soon as the reader moves past it, and the loads of
+/// the units that are out of the window after a seek are canceled.
+class ParallelUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  ParallelUnitLoaderFactory(
+      std::shared_ptr<folly::Executor> ioExecutor,
+      uint32_t maxUnitsAhead,
+      uint64_t maxBytesAhead,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback);
+
+  ~ParallelUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  const std::shared_ptr<folly::Executor> ioExecutor_;
+  const uint32_t maxUnitsAhead_;
+  const uint64_t maxBytesAhead_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -20,12 +20,15 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <vector>
 
+#include "velox/common/future/VeloxPromise.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/common/StripeCursor.h"
 #include "velox/dwio/common/TypeWithId.h"
 #include "velox/type/Type.h"
 #include "velox/vector/BaseVector.h"
@@ -106,6 +109,21 @@ class RowReader {
     return false;
   }
 
+  // Returns true if the next call to next() would wait for IO running in the
+  // background, e.g. the load of the next stripe. Sets 'future' to be realized
+  // when the IO is done, so that the caller can wait without blocking a
+  // thread.
+  virtual bool isNextReadBlocked(ContinueFuture& /*future*/) {
+    return false;
+  }
+
+  // Returns the cursor through which the stripes of 'this' that have not been
+  // started can be handed over to another reader of the file, or nullptr if
+  // the format does not support this.
+  virtual std::shared_ptr<StripeCursor> stripeCursor() const {
+    return nullptr;
+  }
+
   enum class FetchResult {
     kFetched, // This function did the fetch
     kInProgress, // Another thread already started the IO
@@ -187,6 +205,26 @@ class Reader {
   virtual std::unique_ptr<ColumnStatistics> columnStatistics(
       uint32_t index) const = 0;
 
+  /// The number of rows and the column statistics of a stripe or row group.
+  struct UnitStatistics {
+    uint64_t numRows{0};
+    /// One entry per requested column. Null if the unit has no statistics for
+    /// the column.
+    std::vector<std::unique_ptr<ColumnStatistics>> columns;
+  };
+
+  /// Returns the statistics of the top level 'columns' in each of the stripes
+  /// or row groups that start in [offset, offset + length), i.e. the ones a
+  /// split of this range reads. Only uses the metadata read with the file
+  /// tail, so this is much cheaper than making a row reader. Returns
+  /// std::nullopt if the units are not known from the file tail.
+  virtual std::optional<std::vector<UnitStatistics>> unitStatistics(
+      uint64_t /*offset*/,
+      uint64_t /*length*/,
+      const std::vector<std::string>& /*columns*/) const {
+    return std::nullopt;
+  }
+
   /**
    * Get the file schema.
    * @return file schema
@@ -33,6 +33,8 @@ ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
       container->children_.push_back(std::make_unique<ScanSpec>(*element));
       auto* child = container->children_.back().get();
       container->childByFieldName_[child->fieldName()] = child;
+      container->stableChildren_.clear();
+      container->hasFilter_.reset();
       container = child;
     }
   }
@@ -40,6 +42,7 @@ ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
 }
 
 uint64_t ScanSpec::newRead() {
+  syncSharedSelectivity();
   if (!numReads_) {
     reorder();
   } else if (enableFilterReorder_) {
@@ -57,6 +60,41 @@ uint64_t ScanSpec::newRead() {
   return numReads_++;
 }
 
+void ScanSpec::setSharedSelectivity(
+    std::shared_ptr<SharedSelectivityInfo> shared) {
+  VELOX_CHECK_NOT_NULL(shared);
+  attachSharedSelectivity(*shared, "");
+  sharedSelectivity_ = std::move(shared);
+}
+
+void ScanSpec::attachSharedSelectivity(
+    SharedSelectivityInfo& shared,
+    const std::string& prefix) {
+  for (auto& child : children_) {
+    auto path = prefix.empty()
+        ? child->fieldName_
+        : fmt::format("{}.{}", prefix, child->fieldName_);
+    if (child->hasFilter()) {
+      child->sharedSelectivityEntry_ = shared.entry(path);
+      child->selectivity_ = child->sharedSelectivityEntry_->snapshot();
+      child->publishedSelectivity_ = child->selectivity_;
+    }
+    child->attachSharedSelectivity(shared, path);
+  }
+}
+
+void ScanSpec::syncSharedSelectivity() {
+  for (auto& child : children_) {
+    auto* entry = child->sharedSelectivityEntry_;
+    if (!entry) {
+      continue;
+    }
+    entry->add(child->selectivity_, child->publishedSelectivity_);
+    child->selectivity_ = entry->snapshot();
+    child->publishedSelectivity_ = child->selectivity_;
+  }
+}
+
 void ScanSpec::reorder() {
   if (children_.empty()) {
     return;
@@ -131,6 +169,9 @@ bool ScanSpec::hasFilter() const {
 
 void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
   // moves the filters and filter order from 'other'.
+  if (!sharedSelectivity_) {
+    sharedSelectivity_ = other.sharedSelectivity_;
+  }
   for (auto& child : children_) {
     auto it = other.childByFieldName_.find(child->fieldName_);
     if (it == other.childByFieldName_.end()) {
@@ -144,6 +185,8 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
       // received.
       child->filter_ = std::move(otherChild->filter_);
       child->selectivity_ = otherChild->selectivity_;
+      child->publishedSelectivity_ = otherChild->publishedSelectivity_;
+      child->sharedSelectivityEntry_ = otherChild->sharedSelectivityEntry_;
     }
   }
 }
@@ -375,6 +418,19 @@ ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
   return child;
 }
 
+void ScanSpec::removeChild(const std::string& name) {
+  auto it = childByFieldName_.find(name);
+  VELOX_CHECK(it != childByFieldName_.end(), "No child named {}", name);
+  auto* child = it->second;
+  childByFieldName_.erase(it);
+  children_.erase(std::find_if(
+      children_.begin(), children_.end(), [&](const auto& other) {
+        return other.get() == child;
+      }));
+  stableChildren_.clear();
+  hasFilter_.reset();
+}
+
 ScanSpec* ScanSpec::addFieldRecursively(
     const std::string& name,
     const Type& type,
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/base/SharedSelectivityInfo.h"
 #include "velox/dwio/common/MetadataFilter.h"
 #include "velox/type/Filter.h"
 #include "velox/type/Subfield.h"
@@ -214,6 +215,15 @@ class ScanSpec {
     return selectivity_;
   }
 
+  // Makes the filtered fields of 'this' and its descendants share
+  // their selectivity with all other ScanSpecs attached to the same
+  // 'shared'. A field is identified by its path from 'this', so the
+  // ScanSpecs of different splits and drivers of one scan see each
+  // other's numbers. The fields start with the numbers learned so far
+  // and newRead() merges the numbers of each batch into 'shared'. Must
+  // be called on the root after the tree is complete.
+  void setSharedSelectivity(std::shared_ptr<SharedSelectivityInfo> shared);
+
   ValueHook* valueHook() const {
     return valueHook_;
   }
@@ -287,6 +297,10 @@ class ScanSpec {
   // Add a field to this ScanSpec, with content projected out.
   ScanSpec* addField(const std::string& name, column_index_t channel);
 
+  // Removes the child 'name' added by addField() or getOrCreateChild(). Used
+  // to undo columns added for a single split.
+  void removeChild(const std::string& name);
+
   // Add a field and its children recursively to this ScanSpec, all projected
   // out.
   ScanSpec* addFieldRecursively(
@@ -339,6 +353,15 @@ class ScanSpec {
  private:
   void reorder();
 
+  void attachSharedSelectivity(
+      SharedSelectivityInfo& shared,
+      const std::string& prefix);
+
+  // Merges the numbers of the filtered children measured since the
+  // last call into the shared numbers and continues from the merged
+  // numbers, which include what other ScanSpecs have measured.
+  void syncSharedSelectivity();
+
   // Serializes stableChildren().
   std::mutex mutex_;
 
@@ -377,6 +400,19 @@ class ScanSpec {
       metadataFilters_;
 
   SelectivityInfo selectivity_;
+
+  // Set on the root by setSharedSelectivity() to keep the entries of
+  // the descendants alive.
+  std::shared_ptr<SharedSelectivityInfo> sharedSelectivity_;
+
+  // The shared numbers of the field if it has a filter and
+  // setSharedSelectivity() has been called.
+  SharedSelectivityInfo::Entry* sharedSelectivityEntry_{nullptr};
+
+  // The part of 'selectivity_' that is already merged into
+  // 'sharedSelectivityEntry_'.
+  SelectivityInfo publishedSelectivity_;
+
   // Sort children by filtering efficiency.
   bool enableFilterReorder_ = true;
 
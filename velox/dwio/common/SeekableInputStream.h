@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
+#include "velox/common/caching/DecodedDictionaryCache.h"
+#include "velox/common/caching/DecompressedCache.h"
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/wrap/zero-copy-stream-wrapper.h"
@@ -63,6 +66,23 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
     return SkipInt64(count);
   }
 
+  // Returns the key of the compressed block whose header is at 'offset' in
+  // this stream if decompressed blocks of this stream are worth keeping in
+  // cache::DecompressedCache. Returns std::nullopt by default.
+  virtual std::optional<cache::DecompressedBlockKey> decompressedBlockKey(
+      uint64_t /*offset*/) const {
+    return std::nullopt;
+  }
+
+  // Returns the key of the dictionary decoded from this stream in
+  // cache::DecodedDictionaryCache, i.e. the file and the offset of the
+  // stream in the file, if the stream is read through the cache. Returns
+  // std::nullopt by default.
+  virtual std::optional<cache::DecodedDictionaryKey> decodedDictionaryKey()
+      const {
+    return std::nullopt;
+  }
+
   void readFully(char* buffer, size_t bufferSize);
 };
 
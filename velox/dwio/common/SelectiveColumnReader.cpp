@@ -79,6 +79,7 @@ void SelectiveColumnReader::seekTo(vector_size_t offset, bool readsNullsOnly) {
     auto distance = offset - readOffset_ - numParentNulls_;
     numParentNulls_ = 0;
     parentNullsRecordedTo_ = 0;
+    lastParentNulls_.reset();
     if (readsNullsOnly) {
       formatData_->skipNulls(distance, true);
     } else {
@@ -423,11 +424,20 @@ void SelectiveColumnReader::addParentNulls(
     RowSet rows) {
   int32_t firstNullIndex =
       readOffset_ < firstRowInNulls ? 0 : readOffset_ - firstRowInNulls;
+  lastParentNulls_ = std::make_pair(numParentNulls_, parentNullsRecordedTo_);
   numParentNulls_ +=
       nulls ? bits::countNulls(nulls, firstNullIndex, rows.back() + 1) : 0;
   parentNullsRecordedTo_ = firstRowInNulls + rows.back() + 1;
 }
 
+void SelectiveColumnReader::retractParentNulls() {
+  if (!lastParentNulls_.has_value()) {
+    return;
+  }
+  std::tie(numParentNulls_, parentNullsRecordedTo_) = *lastParentNulls_;
+  lastParentNulls_.reset();
+}
+
 void SelectiveColumnReader::addSkippedParentNulls(
     vector_size_t from,
     vector_size_t to,
@@ -445,6 +455,7 @@ void SelectiveColumnReader::addSkippedParentNulls(
   }
   numParentNulls_ += numNulls;
   parentNullsRecordedTo_ = to;
+  lastParentNulls_.reset();
 }
 
 } // namespace facebook::velox::dwio::common
@@ -202,6 +202,7 @@ class SelectiveColumnReader {
     VELOX_TRACE_HISTORY_PUSH("seekToRowGroup %u", index);
     numParentNulls_ = 0;
     parentNullsRecordedTo_ = 0;
+    lastParentNulls_.reset();
   }
 
   const TypePtr& requestedType() const {
@@ -378,6 +379,15 @@ class SelectiveColumnReader {
     return isTopLevel_;
   }
 
+  // Recursively sets 'isUnderNullableStructs_'. Recurses down structs.
+  virtual void setIsUnderNullableStructs() {
+    isUnderNullableStructs_ = true;
+  }
+
+  bool isUnderNullableStructs() const {
+    return isUnderNullableStructs_;
+  }
+
   uint64_t initTimeClocks() const {
     return initTimeClocks_;
   }
@@ -451,6 +461,12 @@ class SelectiveColumnReader {
   void
   addParentNulls(int32_t firstRowInNulls, const uint64_t* nulls, RowSet rows);
 
+  // Undoes the last addParentNulls() so that 'this' can be read for the rows
+  // passed to it. Used when 'this' is loaded lazily after the enclosing
+  // struct recorded its nulls in all its children. No-op if there was no
+  // addParentNulls() since the last call.
+  void retractParentNulls();
+
   // When skipping rows in a struct, records how many parent nulls at
   // any level there are between top level row 'from' and 'to'. If
   // called many times, the 'from' of the next should be the 'to' of
@@ -624,6 +640,10 @@ class SelectiveColumnReader {
   // 'numParentNulls_' applies.
   int32_t parentNullsRecordedTo_{0};
 
+  // Parent nulls and 'parentNullsRecordedTo_' before the last
+  // addParentNulls(), for retractParentNulls().
+  std::optional<std::pair<int32_t, int32_t>> lastParentNulls_;
+
   // The rows to process in read(). References memory supplied by
   // caller. The values must remain live until the next call to read().
   RowSet inputRows_;
@@ -658,9 +678,16 @@ class SelectiveColumnReader {
   // the file. This is false inside lists, maps and nullable
   // structs. If true, a skip of n rows can use row group indices to
   // skip long distances. Lazy vectors will only be made for results
-  // of top level readers.
+  // of top level readers and of readers under nullable structs.
   bool isTopLevel_{false};
 
+  // True if 'this' is reached from a top level column through structs only,
+  // at least one of which may be null. Such a reader can be read after the
+  // enclosing struct, for the rows of the struct, so that its result can be
+  // a LazyVector. Only for formats where parent nulls are recorded at each
+  // nesting level.
+  bool isUnderNullableStructs_{false};
+
   // Maps from position in non-null rows to a position in value
   // sequence with nulls included. Empty if no nulls.
   raw_vector<int32_t> outerNonNullRows_;
@@ -100,6 +100,19 @@ void SelectiveRepeatedColumnReader::makeNestedRowSet(
   // Reads the lengths, leaves an uninitialized gap for a null
   // map/list. Reading these checks the null mask.
   readLengths(allLengths_, maxRow + 1, nulls);
+  if (rows.size() == maxRow + 1 &&
+      scanSpec_->maxArrayElementsCount() ==
+          std::numeric_limits<vector_size_t>::max()) {
+    // All rows of the range are read with all their elements, so the nested
+    // rows are one run and there is no need to go row by row.
+    const auto nestedLength = sumLengths(allLengths_, nulls, 0, maxRow + 1);
+    nestedRowsHolder_.resize(nestedLength);
+    std::iota(
+        nestedRowsHolder_.data(), nestedRowsHolder_.data() + nestedLength, 0);
+    childTargetReadOffset_ += nestedLength;
+    nestedRows_ = nestedRowsHolder_;
+    return;
+  }
   vector_size_t nestedLength = 0;
   for (auto row : rows) {
     if (!nulls || !bits::isBitNull(nulls, row)) {
@@ -141,6 +154,28 @@ void SelectiveRepeatedColumnReader::makeOffsetsAndSizes(
       result.mutableOffsets(rows.size())->asMutable<vector_size_t>();
   auto* rawSizes = result.mutableSizes(rows.size())->asMutable<vector_size_t>();
   auto* nulls = nullsInReadRange_ ? nullsInReadRange_->as<uint64_t>() : nullptr;
+  if (!rows.empty() && rows.back() == rows.size() - 1 &&
+      (nestedRows_.empty() || nestedRows_.back() == nestedRows_.size() - 1) &&
+      sumLengths(allLengths_, nulls, 0, rows.size()) == nestedRows_.size()) {
+    // The rows and their nested rows are both dense, so the offsets are the
+    // running sum of the lengths.
+    vector_size_t offset = 0;
+    for (vector_size_t i = 0; i < rows.size(); ++i) {
+      rawOffsets[i] = offset;
+      if (nulls && bits::isBitNull(nulls, i)) {
+        rawSizes[i] = 0;
+        if (!returnReaderNulls_) {
+          bits::setNull(rawResultNulls_, i);
+        }
+        anyNulls_ = true;
+      } else {
+        rawSizes[i] = allLengths_[i];
+        offset += allLengths_[i];
+      }
+    }
+    numValues_ = rows.size();
+    return;
+  }
   vector_size_t currentRow = 0;
   vector_size_t currentOffset = 0;
   vector_size_t nestedRowIndex = 0;
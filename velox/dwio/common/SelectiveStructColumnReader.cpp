@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -168,6 +169,8 @@ void SelectiveStructColumnReaderBase::read(
 
   auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
+  // The children without filter, decoded in parallel after the filters.
+  std::vector<SelectiveColumnReader*> parallelReaders;
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
     VELOX_TRACE_HISTORY_PUSH("read %s", childSpec->fieldName().c_str());
@@ -176,11 +179,14 @@ void SelectiveStructColumnReaderBase::read(
     }
     auto fieldIndex = childSpec->subscript();
     auto reader = children_.at(fieldIndex);
-    if (reader->isTopLevel() && childSpec->projectOut() &&
-        !childSpec->hasFilter() && !childSpec->extractValues()) {
+    if (isChildLazy(*childSpec, *reader)) {
       // Will make a LazyVector.
       continue;
     }
+    if (parallelDecoding() && !childSpec->hasFilter()) {
+      parallelReaders.push_back(reader);
+      continue;
+    }
     advanceFieldReader(reader, offset);
     if (childSpec->hasFilter()) {
       {
@@ -202,6 +208,9 @@ void SelectiveStructColumnReaderBase::read(
       reader->read(offset, activeRows, structNulls);
     }
   }
+  if (!parallelReaders.empty() && !activeRows.empty()) {
+    readInParallel(parallelReaders, offset, activeRows, structNulls);
+  }
 
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
@@ -240,6 +249,10 @@ bool SelectiveStructColumnReaderBase::isChildConstant(
   // Returns true if the child has a constant set in the ScanSpec, or if the
   // file doesn't have this child (in which case it will be treated as null).
   return childSpec.isConstant() ||
+      // A flat map read as struct has no reader for the keys that are not in
+      // the stripe.
+      (fileType_->type()->kind() == TypeKind::MAP &&
+       childSpec.subscript() == kConstantChildSpecSubscript) ||
       // The below check is trying to determine if this is a missing field in a
       // struct that should be constant null.
       (!isRoot_ && // If we're in the root struct channel is meaningless in this
@@ -334,6 +347,20 @@ void setNullField(
 
 } // namespace
 
+void SelectiveStructColumnReaderBase::readInParallel(
+    const std::vector<SelectiveColumnReader*>& readers,
+    vector_size_t offset,
+    RowSet rows,
+    const uint64_t* structNulls) {
+  // The readers have their own streams and buffers, so they only share 'rows'
+  // and 'structNulls', which are not modified while they read.
+  ParallelFor(decodingExecutor_, 0, readers.size(), decodingParallelismFactor_)
+      .execute([&](size_t i) {
+        advanceFieldReader(readers[i], offset);
+        readers[i]->read(offset, rows, structNulls);
+      });
+}
+
 void SelectiveStructColumnReaderBase::getValues(
     RowSet rows,
     VectorPtr* result) {
@@ -392,8 +419,7 @@ void SelectiveStructColumnReaderBase::getValues(
       setNullField(rows.size(), childResult, childType, resultRow->pool());
       continue;
     }
-    if (childSpec->extractValues() || childSpec->hasFilter() ||
-        !children_[index]->isTopLevel()) {
+    if (!isChildLazy(*childSpec, *children_[index])) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
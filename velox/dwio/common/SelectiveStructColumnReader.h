@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 
 namespace facebook::velox::dwio::common {
@@ -77,6 +79,17 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
       for (auto& child : children_) {
         child->setIsTopLevel();
       }
+    } else if (!formatData_->parentNullsInLeaves()) {
+      for (auto& child : children_) {
+        child->setIsUnderNullableStructs();
+      }
+    }
+  }
+
+  void setIsUnderNullableStructs() override {
+    isUnderNullableStructs_ = true;
+    for (auto& child : children_) {
+      child->setIsUnderNullableStructs();
     }
   }
 
@@ -102,6 +115,17 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     fillMutatedOutputRows_ = value;
   }
 
+  /// Makes read() decode the children without a filter on up to
+  /// 'parallelismFactor' threads of 'executor' after the children with a
+  /// filter have produced the final row set. These children are then decoded
+  /// eagerly instead of being returned as LazyVectors. Only used on the root.
+  void setDecodingExecutor(
+      folly::Executor* executor,
+      size_t parallelismFactor) {
+    decodingExecutor_ = executor;
+    decodingParallelismFactor_ = parallelismFactor;
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -137,6 +161,30 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   void fillOutputRowsFromMutation(vector_size_t size);
 
+  bool parallelDecoding() const {
+    return decodingExecutor_ != nullptr && decodingParallelismFactor_ > 1;
+  }
+
+  // Returns true if the child for 'childSpec' is returned as a LazyVector
+  // that is loaded after read(). The children of nullable structs are also
+  // lazy, so that only the fields that are accessed are decoded and only for
+  // the rows that are accessed.
+  bool isChildLazy(
+      const velox::common::ScanSpec& childSpec,
+      const SelectiveColumnReader& reader) const {
+    return !parallelDecoding() &&
+        (reader.isTopLevel() || reader.isUnderNullableStructs()) &&
+        childSpec.projectOut() && !childSpec.hasFilter() &&
+        !childSpec.extractValues();
+  }
+
+  // Reads 'readers' for 'rows' in parallel on 'decodingExecutor_'.
+  void readInParallel(
+      const std::vector<SelectiveColumnReader*>& readers,
+      vector_size_t offset,
+      RowSet rows,
+      const uint64_t* structNulls);
+
   std::vector<SelectiveColumnReader*> children_;
 
   // Sequence number of output batch. Checked against ColumnLoaders
@@ -166,6 +214,11 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // Whether or not this is the root Struct that represents entire rows of the
   // table.
   const bool isRoot_;
+
+  // Executor and number of threads for decoding the children without filter
+  // in parallel. Not owned.
+  folly::Executor* decodingExecutor_{nullptr};
+  size_t decodingParallelismFactor_{0};
 };
 
 struct SelectiveStructColumnReader : SelectiveStructColumnReaderBase {
@@ -56,9 +56,14 @@ void SortingWriter::close() {
 
   sortBuffer_->noMoreInput();
   const auto maxOutputBatchRows = outputBatchRows();
+  // The rows are written one batch at a time while the output writer flushes
+  // stripes. If there is no memory for the next batch, the rows not yet
+  // written are spilled and the rest of the output is merged from disk.
+  sortBuffer_->ensureOutputFits(maxOutputBatchRows);
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputBatchRows);
   while (output != nullptr) {
     outputWriter_->write(output);
+    sortBuffer_->ensureOutputFits(maxOutputBatchRows);
     output = sortBuffer_->getOutput(maxOutputBatchRows);
   }
 
@@ -523,6 +523,10 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of string dictionaries taken from cache::DecodedDictionaryCache
+  // instead of being decoded.
+  int64_t cachedStringDictionaries{0};
 };
 
 struct RuntimeStatistics {
@@ -535,16 +539,27 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of rows inside read strides skipped based on page-level
+  // statistics.
+  int64_t skippedPageRows{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
-    return {
+    std::unordered_map<std::string, RuntimeCounter> result = {
         {"skippedSplits", RuntimeCounter(skippedSplits)},
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"skippedPageRows", RuntimeCounter(skippedPageRows)},
         {"flattenStringDictionaryValues",
          RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
+    if (columnReaderStatistics.cachedStringDictionaries > 0) {
+      result.emplace(
+          "cachedStringDictionaries",
+          RuntimeCounter(columnReaderStatistics.cachedStringDictionaries));
+    }
+    return result;
   }
 };
 
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/StorageLatencyModel.h"
+
+#include <algorithm>
+#include <typeindex>
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+// The sizes are fitted in MB to keep the sums of squares well conditioned.
+constexpr double kBytesPerMB = 1 << 20;
+} // namespace
+
+// static
+StorageLatencyModel& StorageLatencyModel::forFile(const ReadFile& file) {
+  // The entries are never removed, so references to them stay valid.
+  static folly::Synchronized<folly::F14FastMap<
+      std::type_index,
+      std::unique_ptr<StorageLatencyModel>>>
+      models;
+  const std::type_index type(typeid(file));
+  {
+    auto readModels = models.rlock();
+    auto it = readModels->find(type);
+    if (it != readModels->end()) {
+      return *it->second;
+    }
+  }
+  auto writeModels = models.wlock();
+  auto& model = (*writeModels)[type];
+  if (model == nullptr) {
+    model = std::make_unique<StorageLatencyModel>();
+  }
+  return *model;
+}
+
+// static
+StorageLatencyModel::Coalescing StorageLatencyModel::coalescing(
+    const ReadFile& file,
+    const io::ReaderOptions& options,
+    io::IoStatistics* ioStats) {
+  if (options.adaptiveCoalescing()) {
+    if (auto adaptive = forFile(file).coalescing()) {
+      if (ioStats != nullptr) {
+        ioStats->adaptiveCoalesceDistance().increment(adaptive->maxDistance);
+        ioStats->adaptiveCoalesceBytes().increment(adaptive->maxBytes);
+      }
+      return *adaptive;
+    }
+  }
+  return {options.maxCoalesceDistance(), options.maxCoalesceBytes()};
+}
+
+void StorageLatencyModel::recordRead(uint64_t bytes, uint64_t micros) {
+  const double x = bytes / kBytesPerMB;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numReads_;
+  weight_ = weight_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumMicros_ = sumMicros_ * kDecay + y;
+  sumBytes2_ = sumBytes2_ * kDecay + x * x;
+  sumBytesMicros_ = sumBytesMicros_ * kDecay + x * y;
+}
+
+std::optional<std::pair<double, double>> StorageLatencyModel::estimate()
+    const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numReads_ < kMinReads) {
+    return std::nullopt;
+  }
+  const double variance = weight_ * sumBytes2_ - sumBytes_ * sumBytes_;
+  // Reads of near equal size do not separate latency from transfer time.
+  if (variance <= 1e-9 * weight_ * sumBytes2_) {
+    return std::nullopt;
+  }
+  const double microsPerMB =
+      (weight_ * sumBytesMicros_ - sumBytes_ * sumMicros_) / variance;
+  if (microsPerMB <= 0) {
+    return std::nullopt;
+  }
+  const double latency =
+      std::max(0.0, (sumMicros_ - microsPerMB * sumBytes_) / weight_);
+  return std::make_pair(latency, microsPerMB / kBytesPerMB);
+}
+
+std::optional<StorageLatencyModel::Coalescing>
+StorageLatencyModel::coalescing() const {
+  const auto fit = estimate();
+  if (!fit.has_value()) {
+    return std::nullopt;
+  }
+  // The number of bytes that transfer in the time of one request latency.
+  const double breakEvenBytes = fit->first / fit->second;
+  return Coalescing{
+      static_cast<int32_t>(std::clamp<double>(
+          breakEvenBytes, kMinDistance, kMaxDistance)),
+      static_cast<int64_t>(std::clamp<double>(
+          9 * breakEvenBytes, kMinRequestBytes, kMaxRequestBytes))};
+}
+
+void StorageLatencyModel::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  numReads_ = 0;
+  weight_ = 0;
+  sumBytes_ = 0;
+  sumMicros_ = 0;
+  sumBytes2_ = 0;
+  sumBytesMicros_ = 0;
+}
+
+} // namespace facebook::velox::dwio::common
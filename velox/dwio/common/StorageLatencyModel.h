@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+
+#include "velox/common/file/File.h"
+#include "velox/common/io/IoStatistics.h"
+#include "velox/common/io/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Running estimate of the per-request latency and of the transfer time per
+/// byte of a storage system. It is a least squares fit of 'time = latency +
+/// bytes * timePerByte' to the coalesced reads that CachedBufferedInput and
+/// DirectBufferedInput issue, with older reads weighted down so that the
+/// estimate follows changes in load. There is one process-wide instance per
+/// ReadFile implementation, i.e. per file system. Thread-safe.
+class StorageLatencyModel {
+ public:
+  /// Coalescing limits for reads from the modeled storage.
+  struct Coalescing {
+    /// Maximum gap in bytes between two ranges that are read in one request.
+    int32_t maxDistance;
+    /// Maximum size in bytes of a coalesced request.
+    int64_t maxBytes;
+  };
+
+  /// Number of reads needed before the estimates are used.
+  static constexpr int32_t kMinReads = 16;
+
+  static constexpr int32_t kMinDistance = 4 << 10;
+  static constexpr int32_t kMaxDistance = 64 << 20;
+  static constexpr int64_t kMinRequestBytes = 1 << 20;
+  static constexpr int64_t kMaxRequestBytes = 256 << 20;
+
+  /// Returns the instance for the storage of 'file'.
+  static StorageLatencyModel& forFile(const ReadFile& file);
+
+  /// Returns the coalescing limits for reading from 'file'. These are from the
+  /// model of the storage of 'file' if 'options' enable adaptive coalescing
+  /// and the model has seen enough reads, otherwise from 'options'. Records
+  /// the adaptive choices in 'ioStats' if not nullptr.
+  static Coalescing coalescing(
+      const ReadFile& file,
+      const io::ReaderOptions& options,
+      io::IoStatistics* ioStats);
+
+  /// Records a read request of 'bytes', including coalesced gaps, that took
+  /// 'micros'.
+  void recordRead(uint64_t bytes, uint64_t micros);
+
+  /// Returns the limits that minimize the expected read time, or std::nullopt
+  /// if there are too few reads or their sizes are too uniform for a fit.
+  /// Skipping a gap saves reading it but costs a request, so the gap is
+  /// worth reading while it takes less than the latency. A request is long
+  /// enough once the latency is a tenth of its time. Making it longer saves
+  /// little and takes away parallelism from the loads.
+  std::optional<Coalescing> coalescing() const;
+
+  /// Returns the fitted latency in us and transfer time in us per byte.
+  std::optional<std::pair<double, double>> estimate() const;
+
+  /// Forgets the recorded reads. For testing.
+  void clear();
+
+ private:
+  // Weight of the previous reads relative to a new read.
+  static constexpr double kDecay = 0.99;
+
+  mutable std::mutex mutex_;
+  int64_t numReads_{0};
+  // Decayed sums of the weights, sizes (MB), times (us) and their products.
+  double weight_{0};
+  double sumBytes_{0};
+  double sumMicros_{0};
+  double sumBytes2_{0};
+  double sumBytesMicros_{0};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace facebook::velox::dwio::common {
+
+/// Hands out the stripes of a split to the RowReader that reads them and lets
+/// another reader of the same file take over the stripes that have not been
+/// started. The owner claims each stripe before loading it. A thief takes the
+/// second half of the unclaimed stripes and gets their byte range, which it
+/// reads as a split of its own. The unclaimed range is one atomic word, so
+/// neither side takes a lock.
+class StripeCursor {
+ public:
+  /// 'stripeOffsets' are the file offsets of the stripes of the split in
+  /// ascending order.
+  explicit StripeCursor(std::vector<uint64_t> stripeOffsets)
+      : stripeOffsets_(std::move(stripeOffsets)),
+        state_(pack(0, stripeOffsets_.size())) {}
+
+  /// Claims the stripe at 'index' in the split for the owner. Returns false
+  /// if the stripe has been taken by steal(). Unclaimed stripes before
+  /// 'index' are skipped.
+  bool claim(uint32_t index) {
+    auto state = state_.load();
+    for (;;) {
+      const auto [next, end] = unpack(state);
+      if (index < next) {
+        return true;
+      }
+      if (index >= end) {
+        return false;
+      }
+      if (state_.compare_exchange_weak(state, pack(index + 1, end))) {
+        return true;
+      }
+    }
+  }
+
+  /// Takes the second half of the unclaimed stripes, or the last one if only
+  /// one is left. Returns the offset and the length of the byte range that
+  /// contains the offsets of the taken stripes, or std::nullopt if all
+  /// stripes are claimed.
+  std::optional<std::pair<uint64_t, uint64_t>> steal() {
+    auto state = state_.load();
+    for (;;) {
+      const auto [next, end] = unpack(state);
+      if (next >= end) {
+        return std::nullopt;
+      }
+      const uint32_t begin = end - std::max<uint32_t>(1, (end - next) / 2);
+      if (state_.compare_exchange_weak(state, pack(next, begin))) {
+        return std::make_pair(
+            stripeOffsets_[begin],
+            stripeOffsets_[end - 1] + 1 - stripeOffsets_[begin]);
+      }
+    }
+  }
+
+  /// Returns the number of stripes neither claimed nor stolen.
+  uint32_t numUnclaimed() const {
+    const auto [next, end] = unpack(state_.load());
+    return next < end ? end - next : 0;
+  }
+
+ private:
+  static uint64_t pack(uint32_t next, uint32_t end) {
+    return (static_cast<uint64_t>(next) << 32) | end;
+  }
+
+  static std::pair<uint32_t, uint32_t> unpack(uint64_t state) {
+    return {static_cast<uint32_t>(state >> 32), static_cast<uint32_t>(state)};
+  }
+
+  const std::vector<uint64_t> stripeOffsets_;
+
+  // The index of the next stripe to claim in the high and the end of the
+  // stripes left to the owner in the low 32 bits.
+  std::atomic<uint64_t> state_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -20,6 +20,8 @@
 #include <memory>
 #include <vector>
 
+#include "velox/common/future/VeloxPromise.h"
+
 namespace facebook::velox::dwio::common {
 
 class LoadUnit {
@@ -56,6 +58,13 @@ class UnitLoader {
   // Reader reports seek calling this method.
   // The call must be done **before** getLoadedUnit for the new unit
   virtual void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) = 0;
+
+  // Returns true if the unit is loading in the background, so that
+  // getLoadedUnit(unit) would wait. Sets 'future' to be realized when the load
+  // is done. Loaders that load on the calling thread return false.
+  virtual bool isLoading(uint32_t /*unit*/, ContinueFuture& /*future*/) {
+    return false;
+  }
 };
 
 class UnitLoaderFactory {
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/compression/DecompressionBackend.h"
+
+#include <folly/Synchronized.h>
+
+namespace facebook::velox::dwio::common::compression {
+namespace {
+folly::Synchronized<std::shared_ptr<DecompressionBackend>>& backendHolder() {
+  static folly::Synchronized<std::shared_ptr<DecompressionBackend>> backend;
+  return backend;
+}
+} // namespace
+
+folly::SemiFuture<uint64_t> ExecutorDecompressionBackend::decompress(
+    Decompressor& decompressor,
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  auto [promise, future] = folly::makePromiseContract<uint64_t>();
+  executor_->add([&decompressor,
+                  src,
+                  srcLength,
+                  dest,
+                  destLength,
+                  promise = std::move(promise)]() mutable {
+    promise.setWith([&]() {
+      return decompressor.decompress(src, srcLength, dest, destLength);
+    });
+  });
+  return std::move(future);
+}
+
+void registerDecompressionBackend(
+    std::shared_ptr<DecompressionBackend> backend) {
+  *backendHolder().wlock() = std::move(backend);
+}
+
+std::shared_ptr<DecompressionBackend> decompressionBackend() {
+  return *backendHolder().rlock();
+}
+
+} // namespace facebook::velox::dwio::common::compression
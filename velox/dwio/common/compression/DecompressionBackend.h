@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
+
+#include "velox/dwio/common/compression/Compression.h"
+
+namespace facebook::velox::dwio::common::compression {
+
+/// Decompresses blocks asynchronously so that decompression of the next block
+/// of a stream overlaps with decoding the current one. Implementations may run
+/// the decompressor on a thread pool or submit the block to a hardware
+/// accelerator.
+class DecompressionBackend {
+ public:
+  virtual ~DecompressionBackend() = default;
+
+  /// Starts decompressing 'srcLength' bytes at 'src' into 'dest', which has
+  /// space for 'destLength' bytes. 'decompressor' gives the format and may be
+  /// used to do the work. 'decompressor', 'src' and 'dest' stay valid and are
+  /// not otherwise used until the returned future completes. The future is
+  /// set to the decompressed size or to the error from decompressing.
+  virtual folly::SemiFuture<uint64_t> decompress(
+      Decompressor& decompressor,
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) = 0;
+};
+
+/// Runs the decompressor on the threads of 'executor'.
+class ExecutorDecompressionBackend : public DecompressionBackend {
+ public:
+  explicit ExecutorDecompressionBackend(folly::Executor* executor)
+      : executor_(executor) {
+    VELOX_CHECK_NOT_NULL(executor_);
+  }
+
+  folly::SemiFuture<uint64_t> decompress(
+      Decompressor& decompressor,
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override;
+
+ private:
+  folly::Executor* const executor_;
+};
+
+/// Sets the backend that PagedInputStreams created after this call use to
+/// decompress the next block ahead of the reader. nullptr, the default,
+/// decompresses each block synchronously when it is read.
+void registerDecompressionBackend(
+    std::shared_ptr<DecompressionBackend> backend);
+
+/// Returns the backend set by registerDecompressionBackend().
+std::shared_ptr<DecompressionBackend> decompressionBackend();
+
+} // namespace facebook::velox::dwio::common::compression
@@ -179,23 +179,47 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   if (state_ == State::START) {
     DWIO_ENSURE_NOT_NULL(decompressor_.get(), "invalid stream state");
     DWIO_ENSURE_NOT_NULL(input);
-    auto [decompressedLength, exact] =
-        decompressor_->getDecompressedLength(input, remainingLength_);
-    if (!data && exact && decompressedLength <= pendingSkip_) {
-      *size = decompressedLength;
-      outputBufferPtr_ = nullptr;
-    } else {
-      prepareOutputBuffer(decompressedLength);
-      outputBufferLength_ = decompressor_->decompress(
-          input,
-          remainingLength_,
-          outputBuffer_->data(),
-          outputBuffer_->capacity());
+    // Takes the block if it was decompressed ahead. Otherwise drops any
+    // prefetch before using 'decompressor_'.
+    const auto prefetched = takePrefetch(input);
+    const auto cacheKey = decompressedBlockKey(lastHeaderOffset_);
+    cachedBlock_ = !prefetched.has_value() && cacheKey.has_value()
+        ? decompressedCache_->find(cacheKey.value())
+        : nullptr;
+    if (cachedBlock_) {
       if (data) {
-        *data = outputBuffer_->data();
+        *data = cachedBlock_->as<char>();
+      }
+      *size = static_cast<int32_t>(cachedBlock_->size());
+      outputBufferPtr_ = cachedBlock_->as<char>() + cachedBlock_->size();
+    } else {
+      auto [decompressedLength, exact] = prefetched.has_value()
+          ? std::pair<int64_t, bool>{prefetched.value(), true}
+          : decompressor_->getDecompressedLength(input, remainingLength_);
+      if (!data && exact && decompressedLength <= pendingSkip_) {
+        *size = decompressedLength;
+        outputBufferPtr_ = nullptr;
+      } else {
+        if (prefetched.has_value()) {
+          outputBufferLength_ = prefetched.value();
+        } else {
+          prepareOutputBuffer(decompressedLength);
+          outputBufferLength_ = decompressor_->decompress(
+              input,
+              remainingLength_,
+              outputBuffer_->data(),
+              outputBuffer_->capacity());
+        }
+        if (cacheKey.has_value()) {
+          decompressedCache_->insert(
+              cacheKey.value(), outputBuffer_->data(), outputBufferLength_);
+        }
+        if (data) {
+          *data = outputBuffer_->data();
+        }
+        *size = static_cast<int32_t>(outputBufferLength_);
+        outputBufferPtr_ = outputBuffer_->data() + outputBufferLength_;
       }
-      *size = static_cast<int32_t>(outputBufferLength_);
-      outputBufferPtr_ = outputBuffer_->data() + outputBufferLength_;
     }
     // release decryption buffer
     decryptionBuffer_ = nullptr;
@@ -204,6 +228,9 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   if (!original) {
     remainingLength_ = 0;
     state_ = State::HEADER;
+    if (decompressionBackend_) {
+      maybePrefetch();
+    }
   }
 
   outputBufferLength_ = 0;
@@ -265,7 +292,79 @@ bool PagedInputStream::SkipInt64(int64_t count) {
   return true;
 }
 
+void PagedInputStream::maybePrefetch() {
+  if (prefetchInput_ != nullptr || !inputBufferPtr_) {
+    return;
+  }
+  constexpr int32_t kHeaderSize = 3;
+  const auto available = inputBufferPtrEnd_ - inputBufferPtr_;
+  if (available < kHeaderSize) {
+    return;
+  }
+  const auto* header = reinterpret_cast<const uint8_t*>(inputBufferPtr_);
+  const uint32_t value = header[0] | (header[1] << 8) | (header[2] << 16);
+  const uint64_t length = value >> 1;
+  if ((value & 1) != 0 || length == 0 || kHeaderSize + length > available) {
+    // The block is not compressed or not entirely in the window.
+    return;
+  }
+  const auto key = decompressedBlockKey(input_->ByteCount() - available);
+  if (key.has_value() && decompressedCache_->contains(key.value())) {
+    // The block will be read from the cache.
+    return;
+  }
+  const char* input = inputBufferPtr_ + kHeaderSize;
+  const auto decompressedLength =
+      decompressor_->getDecompressedLength(input, length).first;
+  if (!prefetchBuffer_ || decompressedLength > prefetchBuffer_->capacity()) {
+    prefetchBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
+        pool_, decompressedLength);
+  }
+  prefetchInput_ = input;
+  prefetchSize_ = decompressionBackend_->decompress(
+      *decompressor_,
+      input,
+      length,
+      prefetchBuffer_->data(),
+      prefetchBuffer_->capacity());
+}
+
+std::optional<uint64_t> PagedInputStream::takePrefetch(const char* input) {
+  if (prefetchInput_ == nullptr) {
+    return std::nullopt;
+  }
+  if (prefetchInput_ != input) {
+    dropPrefetch();
+    return std::nullopt;
+  }
+  prefetchInput_ = nullptr;
+  const auto size = std::move(prefetchSize_).get();
+  std::swap(outputBuffer_, prefetchBuffer_);
+  return size;
+}
+
+void PagedInputStream::dropPrefetch() {
+  if (prefetchInput_ == nullptr) {
+    return;
+  }
+  prefetchInput_ = nullptr;
+  // The decompression uses 'decompressor_' and 'prefetchBuffer_' until it is
+  // done. Errors are ignored since the block is not returned.
+  prefetchSize_.wait();
+  prefetchSize_ = folly::SemiFuture<uint64_t>::makeEmpty();
+}
+
+std::optional<cache::DecompressedBlockKey>
+PagedInputStream::decompressedBlockKey(uint64_t offset) const {
+  if (!decompressedCache_) {
+    return std::nullopt;
+  }
+  return input_->decompressedBlockKey(offset);
+}
+
 void PagedInputStream::clearDecompressionState() {
+  dropPrefetch();
+  cachedBlock_ = nullptr;
   state_ = State::HEADER;
   outputBufferLength_ = 0;
   remainingLength_ = 0;
@@ -299,6 +398,8 @@ void PagedInputStream::seekToPosition(
   if (compressedOffset != lastHeaderOffset_ || outsideOriginalWindow()) {
     std::vector<uint64_t> positions = {compressedOffset};
     auto provider = dwio::common::PositionProvider(positions);
+    // A prefetch reads from the current window of 'input_'.
+    dropPrefetch();
     input_->seekToPosition(provider);
     clearDecompressionState();
     pendingSkip_ = uncompressedOffset;
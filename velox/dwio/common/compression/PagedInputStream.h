@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/common/compression/DecompressionBackend.h"
 
 namespace facebook::velox::dwio::common::compression {
 
@@ -48,6 +49,14 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
       state_ = State::START;
       remainingLength_ = compressedLength;
     }
+    if (decompressor_ && !decrypter_ && !useRawDecompression) {
+      decompressionBackend_ = decompressionBackend();
+      decompressedCache_ = cache::DecompressedCache::getInstance();
+    }
+  }
+
+  ~PagedInputStream() override {
+    dropPrefetch();
   }
 
   bool Next(const void** data, int32_t* size) override;
@@ -80,6 +89,11 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
     return 2;
   }
 
+  std::optional<cache::DecodedDictionaryKey> decodedDictionaryKey()
+      const override {
+    return input_->decodedDictionaryKey();
+  }
+
  protected:
   // Special constructor used by ZlibDecompressionStream
   PagedInputStream(
@@ -180,6 +194,46 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
  private:
   bool skipAllPending();
 
+  // Starts decompressing the block after the current one with
+  // 'decompressionBackend_' if the block is compressed and entirely in the
+  // current window of 'input_'. The window stays valid until the next
+  // readOrSkip() or seek, which take or drop the prefetch.
+  void maybePrefetch();
+
+  // If the prefetched block starts at 'input', waits for it, makes its output
+  // the current output buffer and returns its size. Otherwise drops the
+  // prefetch and returns std::nullopt.
+  std::optional<uint64_t> takePrefetch(const char* input);
+
+  // Waits for a pending prefetch and discards it.
+  void dropPrefetch();
+
+  // Decompresses the next block ahead of the reader if set.
+  std::shared_ptr<DecompressionBackend> decompressionBackend_;
+
+  // Output of the prefetched block. Swapped with 'outputBuffer_' when taken.
+  std::unique_ptr<dwio::common::DataBuffer<char>> prefetchBuffer_;
+
+  // Start of the compressed data of the prefetched block in the window of
+  // 'input_'. nullptr if there is no prefetch.
+  const char* prefetchInput_{nullptr};
+
+  // Decompressed size of the prefetched block.
+  folly::SemiFuture<uint64_t> prefetchSize_{
+      folly::SemiFuture<uint64_t>::makeEmpty()};
+
+  // Returns the key of the block with the header at 'offset' in 'input_' if
+  // its decompressed form is to be cached.
+  std::optional<cache::DecompressedBlockKey> decompressedBlockKey(
+      uint64_t offset) const;
+
+  // Keeps decompressed blocks of hot streams if set.
+  cache::DecompressedCache* decompressedCache_{nullptr};
+
+  // The current block if it came from 'decompressedCache_'. Keeps the memory
+  // of the last returned window alive for BackUp().
+  BufferPtr cachedBlock_;
+
   // Stream Debug Info
   const std::string streamDebugInfo_;
 };
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/FileSink.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+class FailingSink : public FileSink {
+ public:
+  explicit FailingSink(const Options& options)
+      : FileSink{"FailingSink", options} {}
+
+  ~FailingSink() override {
+    markClosed();
+  }
+
+  using FileSink::write;
+
+  void write(std::vector<DataBuffer<char>>& /*buffers*/) override {
+    VELOX_FAIL("Injected write error");
+  }
+};
+
+class AsyncFileSinkTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  DataBuffer<char> makeBuffer(const std::string& data) {
+    DataBuffer<char> buffer(*pool_);
+    buffer.append(0, data.data(), data.size());
+    return buffer;
+  }
+
+  std::shared_ptr<velox::memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  folly::CPUThreadPoolExecutor executor_{4};
+};
+
+TEST_F(AsyncFileSinkTest, write) {
+  auto memorySink = std::make_unique<MemorySink>(
+      1 << 20, FileSink::Options{.pool = pool_.get()});
+  auto* rawMemorySink = memorySink.get();
+  constexpr uint64_t kMaxInFlightBytes = 100;
+  AsyncFileSink sink(std::move(memorySink), &executor_, kMaxInFlightBytes);
+  ASSERT_TRUE(sink.isBuffered());
+
+  std::string expected;
+  for (auto i = 0; i < 1'000; ++i) {
+    const auto data = fmt::format("{}-", i);
+    expected += data;
+    std::vector<DataBuffer<char>> buffers;
+    buffers.push_back(makeBuffer(data));
+    buffers.push_back(makeBuffer(data));
+    expected += data;
+    sink.write(buffers);
+    ASSERT_TRUE(buffers.empty());
+    ASSERT_EQ(sink.size(), expected.size());
+    ASSERT_LE(sink.inFlightBytes(), kMaxInFlightBytes);
+  }
+  sink.close();
+  ASSERT_EQ(sink.inFlightBytes(), 0);
+  ASSERT_EQ(rawMemorySink->size(), expected.size());
+  ASSERT_EQ(
+      std::string_view(rawMemorySink->data(), rawMemorySink->size()),
+      expected);
+}
+
+TEST_F(AsyncFileSinkTest, writeError) {
+  {
+    AsyncFileSink sink(
+        std::make_unique<FailingSink>(FileSink::Options{.pool = pool_.get()}),
+        &executor_,
+        1 << 20);
+    sink.write(makeBuffer("abc"));
+    VELOX_ASSERT_THROW(sink.close(), "Injected write error");
+  }
+  {
+    AsyncFileSink sink(
+        std::make_unique<FailingSink>(FileSink::Options{.pool = pool_.get()}),
+        &executor_,
+        1);
+    sink.write(makeBuffer("abc"));
+    VELOX_ASSERT_THROW(sink.write(makeBuffer("def")), "Injected write error");
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
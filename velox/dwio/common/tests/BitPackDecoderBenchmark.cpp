@@ -28,9 +28,12 @@
 #include <folly/Benchmark.h>
 #include <folly/Random.h>
 #include <folly/init/Init.h>
+#include <gflags/gflags.h>
 
 #include <duckdb.hpp> // @manual
 
+DECLARE_bool(avx512);
+
 using namespace folly;
 using namespace facebook::velox;
 
@@ -325,6 +328,14 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
       duckInputBuffer, bitpack_pos, result, kNumValues, bitWidth);
 }
 
+// Decodes 'rows' with the AVX-512 kernels if 'avx512' is true and the CPU has
+// them, otherwise with AVX2 or scalar code.
+void unpackRows(RowSet rows, uint8_t bitWidth, bool avx512) {
+  FLAGS_avx512 = avx512;
+  legacyUnpackFast<uint32_t>(rows, bitWidth, result32.data());
+  FLAGS_avx512 = true;
+}
+
 #define BENCHMARK_UNPACK_FULLROWS_CASE_8(width)                  \
   BENCHMARK(velox_unpack_fullrows_##width##_8) {                 \
     veloxBitUnpack<uint8_t>(width, result8.data());              \
@@ -500,6 +511,33 @@ BENCHMARK_UNPACK_ODDROWS_CASE_32(22)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(24)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(31)
 
+#define BENCHMARK_UNPACK_AVX512_CASE(width)                      \
+  BENCHMARK(velox_unpack_avx512_allrows_##width) {               \
+    unpackRows(allRows, width, true);                            \
+  }                                                              \
+  BENCHMARK_RELATIVE(velox_unpack_no_avx512_allrows_##width) {   \
+    unpackRows(allRows, width, false);                           \
+  }                                                              \
+  BENCHMARK(velox_unpack_avx512_oddrows_##width) {               \
+    unpackRows(oddRows, width, true);                            \
+  }                                                              \
+  BENCHMARK_RELATIVE(velox_unpack_no_avx512_oddrows_##width) {   \
+    unpackRows(oddRows, width, false);                           \
+  }                                                              \
+  BENCHMARK_DRAW_LINE();
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_UNPACK_AVX512_CASE(1)
+BENCHMARK_UNPACK_AVX512_CASE(4)
+BENCHMARK_UNPACK_AVX512_CASE(8)
+BENCHMARK_UNPACK_AVX512_CASE(12)
+BENCHMARK_UNPACK_AVX512_CASE(16)
+BENCHMARK_UNPACK_AVX512_CASE(20)
+BENCHMARK_UNPACK_AVX512_CASE(25)
+BENCHMARK_UNPACK_AVX512_CASE(28)
+BENCHMARK_UNPACK_AVX512_CASE(32)
+
 void populateBitPacked() {
   bitPackedData.resize(33);
   for (auto bitWidth = 1; bitWidth <= 32; ++bitWidth) {
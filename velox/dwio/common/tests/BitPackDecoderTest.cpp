@@ -19,8 +19,12 @@
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
+DECLARE_bool(avx512);
+
 using namespace facebook::velox::dwio::common;
 using namespace facebook::velox;
 
@@ -155,6 +159,22 @@ TEST_F(BitPackDecoderTest, allWidths) {
   }
 }
 
+TEST_F(BitPackDecoderTest, allWidthsWithoutAvx512) {
+  // Covers the AVX2 and scalar paths on machines with AVX-512 and width 32,
+  // which only the AVX-512 path decodes with SIMD.
+  FLAGS_avx512 = false;
+  SCOPE_EXIT {
+    FLAGS_avx512 = true;
+  };
+  for (auto width = 0; width < bitPackedData_.size(); ++width) {
+    testUnpack<int32_t>(width, allRows_);
+    testUnpack<int64_t>(width, oddRows_);
+  }
+  FLAGS_avx512 = true;
+  testUnpack<int32_t>(32, allRows_);
+  testUnpack<int64_t>(32, oddRows_);
+}
+
 TEST_F(BitPackDecoderTest, uint8AllRows) {
   for (auto width = 1; width <= 8; ++width) {
     testUnpack<uint8_t>(width);
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+class FileMetadataCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::unique_ptr<FileMetadataCache> makeCache(uint64_t maxBytes) {
+    return std::make_unique<FileMetadataCache>(
+        memory::memoryManager()->addLeafPool(), maxBytes);
+  }
+};
+
+TEST_F(FileMetadataCacheTest, getAndPut) {
+  auto cache = makeCache(1'000);
+  const auto key = FileMetadataCache::makeKey("/a", 1, 100);
+  EXPECT_EQ(cache->get<std::string>(key), nullptr);
+
+  cache->put(key, std::make_shared<const std::string>("footer"), 10);
+  auto footer = cache->get<std::string>(key);
+  ASSERT_NE(footer, nullptr);
+  EXPECT_EQ(*footer, "footer");
+
+  // Another type or another version of the file does not hit.
+  EXPECT_EQ(cache->get<int32_t>(key), nullptr);
+  EXPECT_EQ(
+      cache->get<std::string>(FileMetadataCache::makeKey("/a", 2, 100)),
+      nullptr);
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.numHits, 1);
+  EXPECT_EQ(stats.numMisses, 3);
+  EXPECT_EQ(stats.numEntries, 1);
+  EXPECT_EQ(stats.bytes, 10);
+
+  // Replacing an entry does not count its bytes twice.
+  cache->put(key, std::make_shared<const std::string>("footer2"), 20);
+  EXPECT_EQ(*cache->get<std::string>(key), "footer2");
+  EXPECT_EQ(cache->stats().bytes, 20);
+}
+
+TEST_F(FileMetadataCacheTest, evict) {
+  auto cache = makeCache(100);
+  for (auto i = 0; i < 3; ++i) {
+    cache->put(
+        FileMetadataCache::makeKey("/a", i, 100),
+        std::make_shared<const int32_t>(i),
+        40);
+  }
+  // The least recently used entry is evicted.
+  EXPECT_EQ(
+      cache->get<int32_t>(FileMetadataCache::makeKey("/a", 0, 100)), nullptr);
+  auto entry = cache->get<int32_t>(FileMetadataCache::makeKey("/a", 1, 100));
+  ASSERT_NE(entry, nullptr);
+  cache->put(
+      FileMetadataCache::makeKey("/a", 3, 100),
+      std::make_shared<const int32_t>(3),
+      40);
+  EXPECT_EQ(
+      cache->get<int32_t>(FileMetadataCache::makeKey("/a", 2, 100)), nullptr);
+  EXPECT_EQ(*cache->get<int32_t>(FileMetadataCache::makeKey("/a", 1, 100)), 1);
+  EXPECT_EQ(cache->stats().numEvictions, 2);
+  EXPECT_EQ(cache->stats().bytes, 80);
+
+  // Entries larger than the cache are not added.
+  cache->put(
+      FileMetadataCache::makeKey("/b", 0, 100),
+      std::make_shared<const int32_t>(0),
+      200);
+  EXPECT_EQ(
+      cache->get<int32_t>(FileMetadataCache::makeKey("/b", 0, 100)), nullptr);
+  EXPECT_EQ(cache->stats().numEntries, 2);
+
+  // Evicted metadata stays valid for its users.
+  cache->clear();
+  EXPECT_EQ(*entry, 1);
+  EXPECT_EQ(cache->stats().bytes, 0);
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
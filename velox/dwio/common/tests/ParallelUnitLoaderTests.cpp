@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/executors/ManualExecutor.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/ParallelUnitLoader.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using namespace ::testing;
+using facebook::velox::dwio::common::LoadUnit;
+using facebook::velox::dwio::common::ParallelUnitLoaderFactory;
+using facebook::velox::dwio::common::test::getUnitsLoadedWithFalse;
+using facebook::velox::dwio::common::test::LoadUnitMock;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+namespace {
+
+// Runs the loads when they are scheduled, so that the test can check which
+// units are loaded at each step.
+std::shared_ptr<folly::Executor> inlineExecutor() {
+  return std::make_shared<folly::InlineExecutor>();
+}
+
+} // namespace
+
+TEST(ParallelUnitLoaderTests, LoadsAhead) {
+  size_t blockedOnIoCount = 0;
+  ParallelUnitLoaderFactory factory(
+      inlineExecutor(), 1, 100, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+  // The first unit and the one after it are loaded on creation.
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(7)); // Unit: 0, rows: 3-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  // The reader never waited for a unit.
+  EXPECT_EQ(blockedOnIoCount, 0);
+}
+
+TEST(ParallelUnitLoaderTests, BytesBudget) {
+  ParallelUnitLoaderFactory factory(inlineExecutor(), 3, 150, nullptr);
+  ReaderMock readerMock{{10, 10, 10, 10}, {100, 100, 100, 100}, factory, 0};
+  // Unit 3 is in the window but the units before it exceed the budget.
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({true, true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, rows: 0-9
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 1, rows: 0-9, unload(0), load(3)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({false, true, true, true}));
+}
+
+TEST(ParallelUnitLoaderTests, CanSeek) {
+  ParallelUnitLoaderFactory factory(inlineExecutor(), 1, 100, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  // The units before the target of the seek are unloaded.
+  EXPECT_NO_THROW(readerMock.seek(30););
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 2, rows: 0-2
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  EXPECT_NO_THROW(readerMock.seek(5););
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(5)); // Unit: 0, rows: 5-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+}
+
+TEST(ParallelUnitLoaderTests, InitialSkip) {
+  ParallelUnitLoaderFactory factory(inlineExecutor(), 1, 100, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 15};
+  // Loading starts at the unit of the first row to read.
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 1, rows: 5-14
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_THAT(
+      [&]() {
+        ReaderMock{{10, 20, 30}, {1, 1, 1}, factory, 61};
+      },
+      Throws<facebook::velox::VeloxRuntimeError>(Property(
+          &facebook::velox::VeloxRuntimeError::message,
+          HasSubstr("Can only skip up to the past-the-end row of the file."))));
+}
+
+TEST(ParallelUnitLoaderTests, UnitOutOfRange) {
+  ParallelUnitLoaderFactory factory(inlineExecutor(), 1, 100, nullptr);
+  std::vector<std::atomic_bool> unitsLoaded(getUnitsLoadedWithFalse(1));
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  units.push_back(std::make_unique<LoadUnitMock>(10, 0, unitsLoaded, 0));
+
+  auto unitLoader = factory.create(std::move(units), 0);
+  unitLoader->getLoadedUnit(0);
+  unitLoader->getLoadedUnit(0);
+  EXPECT_THAT(
+      [&]() { unitLoader->getLoadedUnit(1); },
+      Throws<facebook::velox::VeloxRuntimeError>(Property(
+          &facebook::velox::VeloxRuntimeError::message,
+          HasSubstr("Unit out of range"))));
+}
+
+TEST(ParallelUnitLoaderTests, IsLoading) {
+  auto executor = std::make_shared<folly::ManualExecutor>();
+  ParallelUnitLoaderFactory factory(executor, 1, 100, nullptr);
+  std::vector<std::atomic_bool> unitsLoaded(getUnitsLoadedWithFalse(2));
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  units.push_back(std::make_unique<LoadUnitMock>(10, 1, unitsLoaded, 0));
+  units.push_back(std::make_unique<LoadUnitMock>(10, 1, unitsLoaded, 1));
+
+  auto unitLoader = factory.create(std::move(units), 0);
+  facebook::velox::ContinueFuture future =
+      facebook::velox::ContinueFuture::makeEmpty();
+  // The loads of both units are scheduled but have not run.
+  ASSERT_TRUE(unitLoader->isLoading(0, future));
+  EXPECT_FALSE(future.isReady());
+  facebook::velox::ContinueFuture secondFuture =
+      facebook::velox::ContinueFuture::makeEmpty();
+  ASSERT_TRUE(unitLoader->isLoading(1, secondFuture));
+  executor->run();
+  EXPECT_TRUE(future.isReady());
+  EXPECT_TRUE(secondFuture.isReady());
+  EXPECT_FALSE(unitLoader->isLoading(0, future));
+  unitLoader->getLoadedUnit(0);
+  EXPECT_FALSE(unitLoader->isLoading(1, future));
+  unitLoader->getLoadedUnit(1);
+  EXPECT_EQ(
+      std::vector<bool>({false, true}),
+      std::vector<bool>(unitsLoaded.begin(), unitsLoaded.end()));
+}
+
+TEST(ParallelUnitLoaderTests, LoadsCorrectlyWithThreadPool) {
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  ParallelUnitLoaderFactory factory(executor, 2, 1 << 20, nullptr);
+  std::vector<uint64_t> rowsPerUnit(20, 10);
+  std::vector<uint64_t> ioSizes(20, 1);
+  ReaderMock readerMock{rowsPerUnit, ioSizes, factory, 0};
+
+  uint64_t numReads = 0;
+  while (readerMock.read(7)) {
+    ++numReads;
+    if (numReads == 10) {
+      readerMock.seek(150);
+    }
+  }
+  auto unitsLoaded = readerMock.unitsLoaded();
+  EXPECT_TRUE(unitsLoaded.back());
+  for (size_t i = 0; i + 1 < unitsLoaded.size(); ++i) {
+    EXPECT_FALSE(unitsLoaded[i]) << i;
+  }
+}
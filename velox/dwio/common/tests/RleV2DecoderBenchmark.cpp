@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+constexpr size_t kNumValues = 1'000'000;
+constexpr size_t kRunLength = 512;
+constexpr size_t kBatchSize = 1'000;
+
+const std::vector<uint32_t> kWidths = {
+    1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+    17, 18, 19, 20, 21, 22, 23, 24, 26, 28, 30, 32, 40, 48, 56, 64};
+
+std::shared_ptr<memory::MemoryPool> pool;
+
+std::vector<unsigned char> direct7;
+std::vector<unsigned char> direct16;
+std::vector<unsigned char> direct24;
+std::vector<unsigned char> direct40;
+std::vector<unsigned char> delta10;
+
+std::vector<int64_t> result(kBatchSize);
+std::vector<int32_t> result32(kBatchSize);
+
+uint8_t encodeWidth(uint32_t bitWidth) {
+  return std::find(kWidths.begin(), kWidths.end(), bitWidth) - kWidths.begin();
+}
+
+void appendVarint(uint64_t value, std::vector<unsigned char>& bytes) {
+  while (value >= 0x80) {
+    bytes.push_back(0x80 | (value & 0x7f));
+    value >>= 7;
+  }
+  bytes.push_back(value);
+}
+
+// Packs 'values' in 'bitWidth' bits, most significant bit first.
+void appendPacked(
+    const std::vector<uint64_t>& values,
+    uint32_t bitWidth,
+    std::vector<unsigned char>& bytes) {
+  uint32_t numBits = 0;
+  for (auto value : values) {
+    for (int32_t bit = bitWidth - 1; bit >= 0; --bit) {
+      if (numBits % 8 == 0) {
+        bytes.push_back(0);
+      }
+      bytes.back() |= ((value >> bit) & 1) << (7 - numBits % 8);
+      ++numBits;
+    }
+  }
+}
+
+// Returns DIRECT runs of random unsigned 'bitWidth' bit values.
+std::vector<unsigned char> makeDirect(uint32_t bitWidth) {
+  std::vector<unsigned char> bytes;
+  for (size_t i = 0; i < kNumValues; i += kRunLength) {
+    std::vector<uint64_t> values(kRunLength);
+    for (auto& value : values) {
+      value = folly::Random::rand64() >> (64 - bitWidth);
+    }
+    bytes.push_back(0x40 | (encodeWidth(bitWidth) << 1) | 1);
+    bytes.push_back((kRunLength - 1) & 0xff);
+    appendPacked(values, bitWidth, bytes);
+  }
+  return bytes;
+}
+
+// Returns DELTA runs of ascending values with random 'bitWidth' bit deltas.
+std::vector<unsigned char> makeDelta(uint32_t bitWidth) {
+  std::vector<unsigned char> bytes;
+  uint64_t value = 0;
+  for (size_t i = 0; i < kNumValues; i += kRunLength) {
+    bytes.push_back(0xc0 | (encodeWidth(bitWidth) << 1) | 1);
+    bytes.push_back((kRunLength - 1) & 0xff);
+    appendVarint(value, bytes);
+    // The delta base is a zigzag encoded varint.
+    appendVarint(2, bytes);
+    value += 1;
+    std::vector<uint64_t> deltas(kRunLength - 2);
+    for (auto& delta : deltas) {
+      delta = folly::Random::rand64() >> (64 - bitWidth);
+      value += delta;
+    }
+    ++value;
+    appendPacked(deltas, bitWidth, bytes);
+  }
+  return bytes;
+}
+
+std::unique_ptr<IntDecoder<false>> makeDecoder(
+    const std::vector<unsigned char>& bytes) {
+  return dwrf::createRleDecoder<false>(
+      std::make_unique<SeekableArrayInputStream>(bytes.data(), bytes.size()),
+      dwrf::RleVersion_2,
+      *pool,
+      false,
+      INT_BYTE_SIZE);
+}
+
+// Decodes in batches of 'kBatchSize' values.
+void decode(const std::vector<unsigned char>& bytes) {
+  auto decoder = makeDecoder(bytes);
+  for (size_t i = 0; i < kNumValues; i += kBatchSize) {
+    decoder->next(result.data(), kBatchSize, nullptr);
+  }
+  folly::doNotOptimizeAway(result);
+}
+
+// Decodes one value at a time, like a visitor with a filter does.
+void decodeByValue(const std::vector<unsigned char>& bytes) {
+  auto decoder = makeDecoder(bytes);
+  for (size_t i = 0; i < kNumValues; i += kBatchSize) {
+    decoder->nextLengths(result32.data(), kBatchSize);
+  }
+  folly::doNotOptimizeAway(result32);
+}
+} // namespace
+
+BENCHMARK(direct7ByValue) {
+  decodeByValue(direct7);
+}
+
+BENCHMARK_RELATIVE(direct7) {
+  decode(direct7);
+}
+
+BENCHMARK(direct16ByValue) {
+  decodeByValue(direct16);
+}
+
+BENCHMARK_RELATIVE(direct16) {
+  decode(direct16);
+}
+
+BENCHMARK(direct24ByValue) {
+  decodeByValue(direct24);
+}
+
+BENCHMARK_RELATIVE(direct24) {
+  decode(direct24);
+}
+
+BENCHMARK(direct40) {
+  decode(direct40);
+}
+
+BENCHMARK(delta10ByValue) {
+  decodeByValue(delta10);
+}
+
+BENCHMARK_RELATIVE(delta10) {
+  decode(delta10);
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  pool = memory::memoryManager()->addLeafPool();
+
+  direct7 = makeDirect(7);
+  direct16 = makeDirect(16);
+  direct24 = makeDirect(24);
+  direct40 = makeDirect(40);
+  delta10 = makeDelta(10);
+
+  folly::runBenchmarks();
+  return 0;
+}
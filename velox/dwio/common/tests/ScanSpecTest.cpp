@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ScanSpec.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::common {
+namespace {
+
+std::unique_ptr<ScanSpec> makeSpec() {
+  auto spec = std::make_unique<ScanSpec>("<root>");
+  spec->addField("c0", 0)->setFilter(createBigintValues({1, 2}, false));
+  spec->addField("c1", 1)->setFilter(createBigintValues({1, 2}, false));
+  spec->addField("c2", 2);
+  return spec;
+}
+
+// Records 'numIn' rows of which 'numOut' pass, taking 'timeClocks'.
+void addSelectivity(
+    ScanSpec& spec,
+    uint64_t numIn,
+    uint64_t numOut,
+    uint64_t timeClocks) {
+  auto& selectivity = spec.selectivity();
+  selectivity = SelectivityInfo(
+      selectivity.numIn() + numIn,
+      selectivity.numOut() + numOut,
+      selectivity.timeClocks() + timeClocks);
+}
+
+TEST(ScanSpecTest, sharedSelectivity) {
+  auto shared = std::make_shared<SharedSelectivityInfo>("scan", nullptr);
+  auto first = makeSpec();
+  first->setSharedSelectivity(shared);
+  first->newRead();
+
+  // 'c1' is cheap and drops most rows, 'c0' is expensive and drops none.
+  addSelectivity(*first->childByName("c0"), 100, 100, 100'000);
+  addSelectivity(*first->childByName("c1"), 100, 10, 1'000);
+  first->newRead();
+  ASSERT_EQ(first->children()[0]->fieldName(), "c1");
+
+  // A new ScanSpec, e.g. for the next split on another driver, starts with the
+  // learned order.
+  auto second = makeSpec();
+  second->setSharedSelectivity(shared);
+  second->newRead();
+  ASSERT_EQ(second->children()[0]->fieldName(), "c1");
+  ASSERT_EQ(second->childByName("c1")->selectivity().numIn(), 100);
+  ASSERT_EQ(second->childByName("c1")->selectivity().numOut(), 10);
+  ASSERT_EQ(second->childByName("c2")->selectivity().numIn(), 0);
+
+  // The numbers measured by both are merged and seen by both.
+  addSelectivity(*second->childByName("c1"), 50, 5, 500);
+  second->newRead();
+  addSelectivity(*first->childByName("c1"), 20, 2, 200);
+  first->newRead();
+  for (auto* spec : {first.get(), second.get()}) {
+    spec->newRead();
+    auto& selectivity = spec->childByName("c1")->selectivity();
+    EXPECT_EQ(selectivity.numIn(), 170);
+    EXPECT_EQ(selectivity.numOut(), 17);
+    EXPECT_EQ(selectivity.timeClocks(), 1'700);
+  }
+}
+
+TEST(ScanSpecTest, sharedSelectivityNested) {
+  auto shared = std::make_shared<SharedSelectivityInfo>("scan", nullptr);
+  auto makeNested = [] {
+    auto spec = std::make_unique<ScanSpec>("<root>");
+    spec->getOrCreateChild(Subfield("c0.a"))
+        ->setFilter(createBigintValues({1}, false));
+    return spec;
+  };
+  auto first = makeNested();
+  first->setSharedSelectivity(shared);
+  addSelectivity(*first->childByName("c0")->childByName("a"), 10, 1, 100);
+  first->childByName("c0")->newRead();
+
+  auto second = makeNested();
+  second->setSharedSelectivity(shared);
+  EXPECT_EQ(
+      second->childByName("c0")->childByName("a")->selectivity().numIn(), 10);
+  // The parent struct is filtered through its child and has its own entry.
+  EXPECT_EQ(second->childByName("c0")->selectivity().numIn(), 0);
+}
+
+} // namespace
+} // namespace facebook::velox::common
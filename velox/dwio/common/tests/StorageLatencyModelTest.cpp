@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/StorageLatencyModel.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+// Records reads from a storage with 'latency' us per request that transfers
+// 'bytesPerMicro' bytes per us.
+void recordReads(
+    StorageLatencyModel& model,
+    int32_t numReads,
+    double latency,
+    double bytesPerMicro) {
+  for (auto i = 0; i < numReads; ++i) {
+    const uint64_t bytes = (64 << 10) * (1 + i % 32);
+    model.recordRead(bytes, latency + bytes / bytesPerMicro);
+  }
+}
+
+TEST(StorageLatencyModelTest, fit) {
+  StorageLatencyModel model;
+  recordReads(model, StorageLatencyModel::kMinReads - 1, 1'000, 1'000);
+  EXPECT_FALSE(model.coalescing().has_value());
+
+  recordReads(model, 100, 1'000, 1'000);
+  const auto fit = model.estimate();
+  ASSERT_TRUE(fit.has_value());
+  EXPECT_NEAR(fit->first, 1'000, 1);
+  EXPECT_NEAR(fit->second, 0.001, 1e-6);
+
+  // 1MB transfers in the time of one request.
+  auto coalescing = model.coalescing();
+  ASSERT_TRUE(coalescing.has_value());
+  EXPECT_NEAR(coalescing->maxDistance, 1'000'000, 1'000);
+  EXPECT_NEAR(coalescing->maxBytes, 9'000'000, 9'000);
+
+  // A slower storage is followed after the older reads decay.
+  recordReads(model, 2'000, 50'000, 100);
+  coalescing = model.coalescing();
+  ASSERT_TRUE(coalescing.has_value());
+  EXPECT_NEAR(coalescing->maxDistance, 5'000'000, 50'000);
+  EXPECT_NEAR(coalescing->maxBytes, 45'000'000, 450'000);
+
+  // A fast local disk gets the minimum limits.
+  model.clear();
+  recordReads(model, 100, 10, 10'000);
+  coalescing = model.coalescing();
+  ASSERT_TRUE(coalescing.has_value());
+  EXPECT_NEAR(coalescing->maxDistance, 100'000, 10);
+  EXPECT_EQ(coalescing->maxBytes, StorageLatencyModel::kMinRequestBytes);
+}
+
+TEST(StorageLatencyModelTest, uniformReads) {
+  StorageLatencyModel model;
+  for (auto i = 0; i < 100; ++i) {
+    model.recordRead(1 << 20, 2'000);
+  }
+  EXPECT_FALSE(model.estimate().has_value());
+  EXPECT_FALSE(model.coalescing().has_value());
+}
+
+TEST(StorageLatencyModelTest, readerOptions) {
+  InMemoryReadFile file(std::string(10, 'x'));
+  auto& model = StorageLatencyModel::forFile(file);
+  EXPECT_EQ(&model, &StorageLatencyModel::forFile(file));
+  model.clear();
+  recordReads(model, 100, 1'000, 1'000);
+
+  io::ReaderOptions options(nullptr);
+  options.setMaxCoalesceDistance(1'000);
+  options.setMaxCoalesceBytes(2'000);
+  io::IoStatistics ioStats;
+  auto coalescing = StorageLatencyModel::coalescing(file, options, &ioStats);
+  EXPECT_EQ(coalescing.maxDistance, 1'000);
+  EXPECT_EQ(coalescing.maxBytes, 2'000);
+  EXPECT_EQ(ioStats.adaptiveCoalesceDistance().count(), 0);
+
+  options.setAdaptiveCoalescing(true);
+  coalescing = StorageLatencyModel::coalescing(file, options, &ioStats);
+  EXPECT_NEAR(coalescing.maxDistance, 1'000'000, 1'000);
+  EXPECT_EQ(ioStats.adaptiveCoalesceDistance().count(), 1);
+  EXPECT_EQ(
+      ioStats.adaptiveCoalesceDistance().sum(), coalescing.maxDistance);
+  EXPECT_EQ(ioStats.adaptiveCoalesceBytes().sum(), coalescing.maxBytes);
+
+  // Too few reads fall back to the configured limits.
+  model.clear();
+  coalescing = StorageLatencyModel::coalescing(file, options, &ioStats);
+  EXPECT_EQ(coalescing.maxDistance, 1'000);
+  EXPECT_EQ(ioStats.adaptiveCoalesceDistance().count(), 1);
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
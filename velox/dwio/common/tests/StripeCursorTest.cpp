@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/StripeCursor.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::velox::dwio::common;
+
+TEST(StripeCursorTest, claimAndSteal) {
+  // 6 stripes at offsets 100, 200, ..., 600.
+  StripeCursor cursor({100, 200, 300, 400, 500, 600});
+  EXPECT_EQ(6, cursor.numUnclaimed());
+  EXPECT_TRUE(cursor.claim(0));
+  // Claiming a stripe again is a no-op.
+  EXPECT_TRUE(cursor.claim(0));
+  EXPECT_EQ(5, cursor.numUnclaimed());
+
+  // Takes the second half of stripes 1-5, i.e. 4 and 5.
+  auto range = cursor.steal();
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(500, range->first);
+  EXPECT_EQ(101, range->second);
+  EXPECT_EQ(3, cursor.numUnclaimed());
+
+  EXPECT_TRUE(cursor.claim(1));
+  range = cursor.steal();
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(400, range->first);
+  EXPECT_EQ(1, range->second);
+
+  // The last stripe left can be taken.
+  range = cursor.steal();
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(300, range->first);
+  EXPECT_EQ(1, range->second);
+  EXPECT_EQ(0, cursor.numUnclaimed());
+  EXPECT_FALSE(cursor.steal().has_value());
+  EXPECT_FALSE(cursor.claim(2));
+  EXPECT_TRUE(cursor.claim(1));
+}
+
+TEST(StripeCursorTest, claimSkipsStripes) {
+  StripeCursor cursor({0, 10, 20, 30});
+  EXPECT_TRUE(cursor.claim(2));
+  EXPECT_EQ(1, cursor.numUnclaimed());
+  auto range = cursor.steal();
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(30, range->first);
+  EXPECT_FALSE(cursor.claim(3));
+}
+
+TEST(StripeCursorTest, concurrent) {
+  constexpr int32_t kNumStripes = 10'000;
+  std::vector<uint64_t> offsets(kNumStripes);
+  for (auto i = 0; i < kNumStripes; ++i) {
+    offsets[i] = i;
+  }
+  StripeCursor cursor(offsets);
+  // Every stripe goes either to the owner or to exactly one thief.
+  std::vector<std::atomic<int32_t>> numReads(kNumStripes);
+  std::thread owner([&]() {
+    for (auto i = 0; i < kNumStripes && cursor.claim(i); ++i) {
+      ++numReads[i];
+    }
+  });
+  std::vector<std::thread> thieves;
+  for (auto i = 0; i < 4; ++i) {
+    thieves.emplace_back([&]() {
+      while (auto range = cursor.steal()) {
+        for (uint64_t j = 0; j < range->second; ++j) {
+          ++numReads[range->first + j];
+        }
+      }
+    });
+  }
+  owner.join();
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+  for (auto i = 0; i < kNumStripes; ++i) {
+    ASSERT_EQ(1, numReads[i]) << i;
+  }
+}
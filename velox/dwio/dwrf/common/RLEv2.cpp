@@ -18,6 +18,8 @@
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 
+#include <folly/lang/Bits.h>
+
 namespace facebook::velox::dwrf {
 
 using memory::MemoryPool;
@@ -119,6 +121,91 @@ int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   return ret;
 }
 
+namespace {
+template <typename T>
+void unpackBytes(const char* input, uint64_t numValues, int64_t* result) {
+  for (uint64_t i = 0; i < numValues; ++i) {
+    result[i] = static_cast<int64_t>(
+        folly::Endian::big(folly::loadUnaligned<T>(input + i * sizeof(T))));
+  }
+}
+
+// Unpacks 'numValues' values of 'bitWidth' bits, packed most significant bit
+// first, from 'input' into 'result'. Each value is extracted from an 8 byte
+// load, so up to 7 bytes past the last value are read. 'bitWidth' is one of
+// the widths of decodeBitWidth(), so a value and its offset in its first byte
+// fit in the load.
+void unpackBigEndian(
+    const char* input,
+    uint64_t numValues,
+    uint32_t bitWidth,
+    int64_t* result) {
+  switch (bitWidth) {
+    case 8:
+      for (uint64_t i = 0; i < numValues; ++i) {
+        result[i] = static_cast<uint8_t>(input[i]);
+      }
+      return;
+    case 16:
+      unpackBytes<uint16_t>(input, numValues, result);
+      return;
+    case 32:
+      unpackBytes<uint32_t>(input, numValues, result);
+      return;
+    case 64:
+      unpackBytes<uint64_t>(input, numValues, result);
+      return;
+    default:
+      break;
+  }
+  DCHECK_LE(bitWidth, 56);
+  const uint32_t shift = 64 - bitWidth;
+  uint64_t bit = 0;
+  for (uint64_t i = 0; i < numValues; ++i, bit += bitWidth) {
+    const auto word =
+        folly::Endian::big(folly::loadUnaligned<uint64_t>(input + bit / 8));
+    result[i] = static_cast<int64_t>((word << (bit % 8)) >> shift);
+  }
+}
+} // namespace
+
+template <bool isSigned>
+uint64_t RleDecoderV2<isSigned>::readLongs(
+    int64_t* data,
+    uint64_t offset,
+    uint64_t len,
+    uint64_t fb,
+    const uint64_t* nulls) {
+  if (nulls) {
+    return readLongsSlow(data, offset, len, fb, nulls);
+  }
+  const uint64_t end = offset + len;
+  uint64_t i = offset;
+  // A run starts at a byte boundary, so at most 7 values are read bit by bit
+  // before the next one.
+  while (i < end && bitsLeft > 0) {
+    readLongsSlow(data, i++, 1, fb);
+  }
+  auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+  const uint64_t available =
+      dwio::common::IntDecoder<isSigned>::bufferEnd - bufferStart;
+  if (i < end && available >= sizeof(uint64_t)) {
+    // Unpacks groups of 8 values, which end at a byte boundary, as long as
+    // the last load stays within the buffer.
+    const uint64_t maxBulk = (available - sizeof(uint64_t) + 1) * 8 / fb;
+    const uint64_t numBulk = std::min(maxBulk, end - i) & ~7UL;
+    if (numBulk > 0) {
+      unpackBigEndian(bufferStart, numBulk, fb, data + i);
+      bufferStart += numBulk * fb / 8;
+      i += numBulk;
+    }
+  }
+  if (i < end) {
+    readLongsSlow(data, i, end - i, fb);
+  }
+  return len;
+}
+
 template <bool isSigned>
 RleDecoderV2<isSigned>::RleDecoderV2(
     std::unique_ptr<dwio::common::SeekableInputStream> input,
@@ -143,7 +230,8 @@ RleDecoderV2<isSigned>::RleDecoderV2(
       patchMask(0),
       actualGap(0),
       unpacked(pool, 0),
-      unpackedPatch(pool, 0) {
+      unpackedPatch(pool, 0),
+      bulkValues(pool, 0) {
   // PASS
 }
 
@@ -199,6 +287,37 @@ void RleDecoderV2<isSigned>::next(
   doNext(data, numValues, nulls);
 }
 
+template <bool isSigned>
+uint64_t RleDecoderV2<isSigned>::nextValues(
+    int64_t* const data,
+    uint64_t offset,
+    uint64_t numValues,
+    const uint64_t* const nulls) {
+  switch (type) {
+    case SHORT_REPEAT:
+      return nextShortRepeats(data, offset, numValues, nulls);
+    case DIRECT:
+      return nextDirect(data, offset, numValues, nulls);
+    case PATCHED_BASE:
+      return nextPatched(data, offset, numValues, nulls);
+    case DELTA:
+      return nextDelta(data, offset, numValues, nulls);
+    default:
+      DWIO_RAISE("unknown encoding");
+  }
+}
+
+template uint64_t RleDecoderV2<true>::nextValues(
+    int64_t* const data,
+    uint64_t offset,
+    uint64_t numValues,
+    const uint64_t* const nulls);
+template uint64_t RleDecoderV2<false>::nextValues(
+    int64_t* const data,
+    uint64_t offset,
+    uint64_t numValues,
+    const uint64_t* const nulls);
+
 template <bool isSigned>
 void RleDecoderV2<isSigned>::doNext(
     int64_t* const data,
@@ -218,24 +337,7 @@ void RleDecoderV2<isSigned>::doNext(
       resetRun();
     }
 
-    uint64_t offset = nRead, length = numValues - nRead;
-
-    switch (type) {
-      case SHORT_REPEAT:
-        nRead += nextShortRepeats(data, offset, length, nulls);
-        break;
-      case DIRECT:
-        nRead += nextDirect(data, offset, length, nulls);
-        break;
-      case PATCHED_BASE:
-        nRead += nextPatched(data, offset, length, nulls);
-        break;
-      case DELTA:
-        nRead += nextDelta(data, offset, length, nulls);
-        break;
-      default:
-        DWIO_RAISE("unknown encoding");
-    }
+    nRead += nextValues(data, nRead, numValues - nRead, nulls);
   }
 }
 
@@ -435,6 +537,39 @@ uint64_t RleDecoderV2<isSigned>::nextPatched(
 
   uint64_t nRead = std::min(runLength - runRead, numValues);
 
+  if (!nulls) {
+    uint64_t pos = offset;
+    const uint64_t end = offset + nRead;
+    while (pos < end) {
+      // Adds the base to the values up to the next patch in bulk. After the
+      // last patch 'actualGap' stays behind 'unpackedIdx'.
+      uint64_t numUnpatched = end - pos;
+      if (actualGap >= static_cast<int64_t>(unpackedIdx)) {
+        numUnpatched =
+            std::min<uint64_t>(numUnpatched, actualGap - unpackedIdx);
+      }
+      const int64_t* source = unpacked.data() + unpackedIdx;
+      for (uint64_t i = 0; i < numUnpatched; ++i) {
+        data[pos + i] = base + source[i];
+      }
+      pos += numUnpatched;
+      runRead += numUnpatched;
+      unpackedIdx += numUnpatched;
+      if (pos == end) {
+        break;
+      }
+      data[pos++] = base + (unpacked[unpackedIdx] | (curPatch << bitSize));
+      ++patchIdx;
+      if (patchIdx < unpackedPatch.size()) {
+        adjustGapAndPatch();
+        actualGap += unpackedIdx;
+      }
+      ++runRead;
+      ++unpackedIdx;
+    }
+    return nRead;
+  }
+
   for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
     // skip null positions
     if (nulls && bits::isBitNull(nulls, pos)) {
@@ -598,24 +733,8 @@ int64_t RleDecoderV2<isSigned>::readValue() {
     resetRun();
   }
 
-  uint64_t nRead = 0;
   int64_t value = 0;
-  switch (type) {
-    case SHORT_REPEAT:
-      nRead = nextShortRepeats(&value, 0, 1, nullptr);
-      break;
-    case DIRECT:
-      nRead = nextDirect(&value, 0, 1, nullptr);
-      break;
-    case PATCHED_BASE:
-      nRead = nextPatched(&value, 0, 1, nullptr);
-      break;
-    case DELTA:
-      nRead = nextDelta(&value, 0, 1, nullptr);
-      break;
-    default:
-      DWIO_RAISE("unknown encoding");
-  }
+  const uint64_t nRead = nextValues(&value, 0, 1, nullptr);
   VELOX_CHECK(nRead == (uint64_t)1);
   return value;
 }
@@ -19,6 +19,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -62,6 +63,10 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     skipPending();
+    if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
 
@@ -100,6 +105,204 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
+             !hasFilter &&
+            !hasHook >
+                (nulls,
+                 rowsAsRange,
+                 *innerVector,
+                 *outerVector,
+                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                 tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          this->template skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        this->template skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Decodes the values of the current run up to and including the last of
+  // 'numRows' rows starting at rows[rowIndex] and passes the values of these
+  // rows to 'visitor'.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void processRun(
+      const int32_t* rows,
+      int32_t rowIndex,
+      int32_t currentRow,
+      int32_t numRows,
+      int32_t numAdvanced,
+      const int32_t* scatterRows,
+      int32_t* filterHits,
+      typename Visitor::DataType* values,
+      int32_t& numValues,
+      Visitor& visitor) {
+    using T = typename Visitor::DataType;
+    constexpr bool kInPlace = std::is_same_v<T, int64_t> && Visitor::dense;
+    int64_t* decoded;
+    if constexpr (kInPlace) {
+      decoded = values + numValues;
+    } else {
+      bulkValues.reserve(numAdvanced);
+      decoded = bulkValues.data();
+    }
+    nextValues(decoded, 0, numAdvanced, nullptr);
+    if constexpr (!kInPlace) {
+      auto* output = values + numValues;
+      if (Visitor::dense) {
+        for (auto i = 0; i < numRows; ++i) {
+          output[i] = decoded[i];
+        }
+      } else {
+        for (auto i = 0; i < numRows; ++i) {
+          output[i] = decoded[rows[rowIndex + i] - currentRow];
+        }
+      }
+    }
+    visitor.template processRun<hasFilter, hasHook, scatter>(
+        values + numValues,
+        numRows,
+        scatterRows,
+        filterHits,
+        values,
+        numValues);
+  }
+
+  // Returns 1. how many of 'rows' are in the current run 2. the
+  // distance in rows from the current row to the first row after the
+  // last in rows that falls in the current run.
+  template <bool dense>
+  std::pair<int32_t, std::int32_t> findNumInRun(
+      const int32_t* rows,
+      int32_t rowIndex,
+      int32_t numRows,
+      int32_t currentRow) {
+    DCHECK_LT(rowIndex, numRows);
+    const int64_t remainingValues = runLength - runRead;
+    if (dense) {
+      auto left = std::min<int64_t>(remainingValues, numRows - rowIndex);
+      return std::make_pair(left, left);
+    }
+    if (rows[rowIndex] - currentRow >= remainingValues) {
+      return std::make_pair(0, 0);
+    }
+    if (rows[numRows - 1] - currentRow < remainingValues) {
+      return std::pair(numRows - rowIndex, rows[numRows - 1] - currentRow + 1);
+    }
+    auto range = folly::Range<const int32_t*>(
+        rows + rowIndex,
+        std::min<int64_t>(remainingValues, numRows - rowIndex));
+    auto endOfRun = currentRow + remainingValues;
+    auto bound = std::lower_bound(range.begin(), range.end(), endOfRun);
+    return std::make_pair(bound - range.begin(), bound[-1] - currentRow + 1);
+  }
+
+  // Visits the rows of 'visitor' run by run. SHORT_REPEAT runs and DELTA runs
+  // with a fixed delta are passed to the visitor without decoding. The other
+  // runs are decoded in bulk.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowIndex = 0;
+    int32_t currentRow = 0;
+    auto values = visitor.rawValues(numRows);
+    auto filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    for (;;) {
+      if (runRead < runLength) {
+        auto [numInRun, numAdvanced] =
+            findNumInRun<Visitor::dense>(rows, rowIndex, numRows, currentRow);
+        if (!numInRun) {
+          // We are not at end and the next row of interest is after this run.
+          VELOX_CHECK(!numAdvanced, "Would advance past end of RLEv2 run");
+        } else if (type == SHORT_REPEAT || (type == DELTA && bitSize == 0)) {
+          const int64_t delta = type == DELTA ? deltaBase : 0;
+          visitor.template processRle<hasFilter, hasHook, scatter>(
+              firstValue + static_cast<int64_t>(runRead) * delta,
+              delta,
+              numInRun,
+              currentRow,
+              scatterRows,
+              filterHits,
+              values,
+              numValues);
+          runRead += numAdvanced;
+          prevValue = firstValue + static_cast<int64_t>(runRead - 1) * delta;
+        } else {
+          processRun<hasFilter, hasHook, scatter>(
+              rows,
+              rowIndex,
+              currentRow,
+              numInRun,
+              numAdvanced,
+              scatterRows,
+              filterHits,
+              values,
+              numValues,
+              visitor);
+        }
+        currentRow += numAdvanced;
+        rowIndex += numInRun;
+        if (visitor.atEnd()) {
+          visitor.setNumValues(hasFilter ? numValues : numAllRows);
+          return;
+        }
+        if (runRead < runLength) {
+          const auto remainingValues = runLength - runRead;
+          currentRow += remainingValues;
+          this->template skip<false>(remainingValues, -1, nullptr);
+        }
+      }
+      readHeader();
+    }
+  }
+
+  // Starts the next run and reads its header.
+  void readHeader() {
+    resetRun();
+    nextValues(nullptr, 0, 0, nullptr);
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap = static_cast<uint64_t>(unpackedPatch[patchIdx]) >> patchBitSize;
@@ -152,7 +355,19 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
   int64_t readLongBE(uint64_t bsz);
+
+  // Reads 'len' 'fb' bit values into 'data' starting at 'offset'. Values at
+  // null positions of 'nulls' are not read. Without nulls, the values in
+  // whole bytes of the current buffer are unpacked in bulk.
   uint64_t readLongs(
+      int64_t* data,
+      uint64_t offset,
+      uint64_t len,
+      uint64_t fb,
+      const uint64_t* nulls = nullptr);
+
+  // Reads values one by one, bit by bit.
+  uint64_t readLongsSlow(
       int64_t* data,
       uint64_t offset,
       uint64_t len,
@@ -160,7 +375,6 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
 
-    // TODO: unroll to improve performance
     for (uint64_t i = offset; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
@@ -210,6 +424,14 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t numValues,
       const uint64_t* nulls);
 
+  // Reads up to 'numValues' values of the current run. Returns the number
+  // of values read, including nulls.
+  uint64_t nextValues(
+      int64_t* data,
+      uint64_t offset,
+      uint64_t numValues,
+      const uint64_t* nulls);
+
   int64_t readValue();
 
   void doNext(
@@ -238,6 +460,7 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   EncodingType type;
   dwio::common::DataBuffer<int64_t> unpacked; // Used by PATCHED_BASE
   dwio::common::DataBuffer<int64_t> unpackedPatch; // Used by PATCHED_BASE
+  dwio::common::DataBuffer<int64_t> bulkValues; // Used by bulkScan
 };
 
 } // namespace facebook::velox::dwrf
@@ -19,6 +19,7 @@
 #include <chrono>
 
 #include "velox/dwio/common/OnDemandUnitLoader.h"
+#include "velox/dwio/common/ParallelUnitLoader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -272,6 +273,16 @@ DwrfRowReader::DwrfRowReader(
     stripeCeiling_ = firstStripe_;
   }
 
+  if (stripeCeiling_ - firstStripe_ > 1) {
+    std::vector<uint64_t> stripeOffsets;
+    stripeOffsets.reserve(stripeCeiling_ - firstStripe_);
+    for (auto i = firstStripe_; i < stripeCeiling_; ++i) {
+      stripeOffsets.push_back(fileFooter.stripes(i).offset());
+    }
+    stripeCursor_ =
+        std::make_shared<dwio::common::StripeCursor>(std::move(stripeOffsets));
+  }
+
   auto stripeCountCallback = options_.getStripeCountCallback();
   if (stripeCountCallback) {
     stripeCountCallback(stripeCeiling_ - firstStripe_);
@@ -561,6 +572,12 @@ int64_t DwrfRowReader::nextRowNumber() {
   auto strideSize = getReader().getFooter().rowIndexStride();
   while (currentStripe_ < stripeCeiling_) {
     if (currentRowInStripe_ == 0) {
+      if (stripeCursor_ != nullptr && currentUnit_ == nullptr &&
+          !stripeCursor_->claim(currentStripe_ - firstStripe_)) {
+        // Another reader has taken over the stripes from here on.
+        stripeCeiling_ = currentStripe_;
+        break;
+      }
       if (getReader().randomSkip()) {
         auto numStripeRows =
             getReader().getFooter().stripes(currentStripe_).numberOfRows();
@@ -641,6 +658,24 @@ void DwrfRowReader::resetFilterCaches() {
   // For columnReader_, this is no-op.
 }
 
+bool DwrfRowReader::isNextReadBlocked(ContinueFuture& future) {
+  if (nextRowNumber_.has_value()) {
+    // The stripe of the next row is loaded.
+    return false;
+  }
+  auto stripe = currentStripe_;
+  if (currentUnit_ != nullptr) {
+    if (currentRowInStripe_ < rowsInCurrentStripe_) {
+      return false;
+    }
+    ++stripe;
+  }
+  if (stripe >= stripeCeiling_) {
+    return false;
+  }
+  return unitLoader_->isLoading(stripe - firstStripe_, future);
+}
+
 void DwrfRowReader::loadCurrentStripe() {
   if (currentUnit_ || currentStripe_ >= stripeCeiling_) {
     return;
@@ -790,7 +825,9 @@ DwrfReader::DwrfReader(
                                                   : FileFormat::DWRF,
           options.fileColumnNamesReadAsLowerCase(),
           options.randomSkip(),
-          options.scanSpec())),
+          options.scanSpec(),
+          options.fileMetadataCacheKey(),
+          options.ioStatistics())),
       options_(options) {
   // If we are not using column names to map table columns to file columns,
   // then we use indices. In that case we need to ensure the names completely
@@ -916,6 +953,28 @@ std::unique_ptr<StripeInformation> DwrfReader::getStripe(
       stripeInfo.numberOfRows());
 }
 
+std::optional<std::vector<dwio::common::Reader::UnitStatistics>>
+DwrfReader::unitStatistics(
+    uint64_t offset,
+    uint64_t length,
+    const std::vector<std::string>& columns) const {
+  const auto& footer = readerBase_->getFooter();
+  const auto limit = std::numeric_limits<uint64_t>::max() - offset > length
+      ? offset + length
+      : std::numeric_limits<uint64_t>::max();
+  std::vector<UnitStatistics> units;
+  for (auto i = 0; i < footer.stripesSize(); ++i) {
+    const auto stripe = footer.stripes(i);
+    // Same range check as in DwrfRowReader.
+    if (stripe.offset() >= offset && stripe.offset() < limit) {
+      auto& unit = units.emplace_back();
+      unit.numRows = stripe.numberOfRows();
+      unit.columns.resize(columns.size());
+    }
+  }
+  return units;
+}
+
 std::vector<std::string> DwrfReader::getMetadataKeys() const {
   std::vector<std::string> result;
   auto& fileFooter = readerBase_->getFooter();
@@ -1110,7 +1169,21 @@ std::unique_ptr<dwio::common::RowReader> DwrfReader::createRowReader(
 
 std::unique_ptr<DwrfRowReader> DwrfReader::createDwrfRowReader(
     const RowReaderOptions& opts) const {
-  auto rowReader = std::make_unique<DwrfRowReader>(readerBase_, opts);
+  std::unique_ptr<DwrfRowReader> rowReader;
+  if (opts.getUnitLoaderFactory() == nullptr &&
+      options_.unitPrefetchBytes() > 0 && options_.ioExecutor() != nullptr) {
+    // Loads the next stripes in the background while reading the current one.
+    auto prefetchOpts = opts;
+    prefetchOpts.setUnitLoaderFactory(
+        std::make_shared<dwio::common::ParallelUnitLoaderFactory>(
+            options_.ioExecutor(),
+            std::max<int64_t>(options_.prefetchRowGroups(), 1),
+            options_.unitPrefetchBytes(),
+            opts.getBlockedOnIoCallback()));
+    rowReader = std::make_unique<DwrfRowReader>(readerBase_, prefetchOpts);
+  } else {
+    rowReader = std::make_unique<DwrfRowReader>(readerBase_, opts);
+  }
   if (opts.getEagerFirstStripeLoad()) {
     // Load the first stripe on construction so that readers created in
     // background have a reader tree and can preload the first
@@ -112,6 +112,8 @@ class DwrfRowReader : public StrideIndexProvider,
     stats.skippedStrides += skippedStrides_;
     stats.columnReaderStatistics.flattenStringDictionaryValues +=
         columnReaderStatistics_.flattenStringDictionaryValues;
+    stats.columnReaderStatistics.cachedStringDictionaries +=
+        columnReaderStatistics_.cachedStringDictionaries;
   }
 
   void resetFilterCaches() override;
@@ -120,6 +122,12 @@ class DwrfRowReader : public StrideIndexProvider,
     return true;
   }
 
+  bool isNextReadBlocked(ContinueFuture& future) override;
+
+  std::shared_ptr<dwio::common::StripeCursor> stripeCursor() const override {
+    return stripeCursor_;
+  }
+
   // Returns the skipped strides for 'stripe'. Used for testing.
   std::optional<std::vector<uint64_t>> stridesToSkip(uint32_t stripe) const {
     auto it = stripeStridesToSkip_.find(stripe);
@@ -185,6 +193,10 @@ class DwrfRowReader : public StrideIndexProvider,
   // The the stripe AFTER the last one that should be read. e.g. if the highest
   // stripe in the RowReader's bounds is 3, then stripeCeiling_ is 4.
   uint32_t stripeCeiling_;
+  // Hands the stripes not started yet over to another reader. Null if there
+  // are less than 2 stripes to read. When the stripes from 'currentStripe_'
+  // on have been taken, 'stripeCeiling_' is lowered to 'currentStripe_'.
+  std::shared_ptr<dwio::common::StripeCursor> stripeCursor_;
   uint64_t currentRowInStripe_;
   uint64_t rowsInCurrentStripe_;
   uint64_t strideIndex_;
@@ -276,6 +288,13 @@ class DwrfReader : public dwio::common::Reader {
     return readerBase_->getColumnStatistics(nodeId);
   }
 
+  /// DWRF keeps no per stripe column statistics in the file tail, so only the
+  /// stripes and their row counts are returned.
+  std::optional<std::vector<UnitStatistics>> unitStatistics(
+      uint64_t offset,
+      uint64_t length,
+      const std::vector<std::string>& columns) const override;
+
   const std::shared_ptr<const RowType>& rowType() const override {
     return readerBase_->getSchema();
   }
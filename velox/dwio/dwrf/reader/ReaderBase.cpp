@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -97,9 +98,10 @@ ReaderBase::ReaderBase(
     FileFormat fileFormat,
     bool fileColumnNamesReadAsLowerCase,
     std::shared_ptr<random::RandomSkipTracker> randomSkip,
-    std::shared_ptr<velox::common::ScanSpec> scanSpec)
+    std::shared_ptr<velox::common::ScanSpec> scanSpec,
+    const std::string& fileMetadataCacheKey,
+    std::shared_ptr<io::IoStatistics> ioStats)
     : pool_{pool},
-      arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
       footerEstimatedSize_(footerEstimatedSize),
       filePreloadThreshold_(filePreloadThreshold),
@@ -113,6 +115,71 @@ ReaderBase::ReaderBase(
   VELOX_CHECK_GE(fileLength_, 4, "File size too small");
 
   const auto preloadFile = fileLength_ <= filePreloadThreshold_;
+  auto* metadataCache = fileMetadataCacheKey.empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::getInstance();
+  std::shared_ptr<const FileTail> tail;
+  if (metadataCache != nullptr) {
+    tail = metadataCache->get<FileTail>(fileMetadataCacheKey);
+  }
+  if (tail != nullptr) {
+    arena_ = tail->arena;
+    postScript_ = tail->postScript;
+    footer_ = tail->footer;
+    cache_ = tail->cache;
+    psLength_ = tail->psLength;
+    if (ioStats != nullptr) {
+      ioStats->metadataCacheHit().increment(tail->bytes);
+    }
+    if (preloadFile && input_->supportSyncLoad()) {
+      input_->enqueue({0, fileLength_, "file"});
+      input_->load(LogType::FILE);
+    }
+  } else {
+    readTail(
+        fileFormat,
+        preloadFile,
+        metadataCache != nullptr ? metadataCache->pool() : nullptr);
+    if (metadataCache != nullptr) {
+      const uint64_t bytes = arena_->SpaceUsed() + 1 + psLength_ +
+          (postScript_->hasCacheSize() ? postScript_->cacheSize() : 0);
+      metadataCache->put<FileTail>(
+          fileMetadataCacheKey,
+          std::make_shared<const FileTail>(
+              FileTail{arena_, postScript_, footer_, cache_, psLength_, bytes}),
+          bytes);
+      if (ioStats != nullptr) {
+        ioStats->metadataCacheMiss().increment(bytes);
+      }
+    }
+  }
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
+
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    const auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes > 0) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+void ReaderBase::readTail(
+    FileFormat fileFormat,
+    bool preloadFile,
+    MemoryPool* sharedPool) {
+  arena_ = std::make_shared<google::protobuf::Arena>();
   const uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, footerEstimatedSize_);
   if (input_->supportSyncLoad()) {
@@ -189,44 +256,26 @@ ReaderBase::ReaderBase(
     footer_ = std::make_unique<FooterWrapper>(footer);
   }
 
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
-
   // load stripe index/footer cache
   if (cacheSize > 0) {
     VELOX_CHECK_EQ(format(), DwrfFormat::kDwrf);
     const uint64_t cacheOffset = fileLength_ - tailSize;
-    if (input_->shouldPrefetchStripes()) {
+    // The streams of the input are not shared with other readers.
+    if (sharedPool == nullptr && input_->shouldPrefetchStripes()) {
       cache_ = std::make_unique<StripeMetadataCache>(
           postScript_->cacheMode(),
           *footer_,
           input_->read(cacheOffset, cacheSize, LogType::FOOTER));
       input_->load(LogType::FOOTER);
     } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      auto cacheBuffer = std::make_shared<dwio::common::DataBuffer<char>>(
+          sharedPool != nullptr ? *sharedPool : pool_, cacheSize);
       input_->read(cacheOffset, cacheSize, LogType::FOOTER)
           ->readFully(cacheBuffer->data(), cacheSize);
       cache_ = std::make_unique<StripeMetadataCache>(
           postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
     }
   }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    const auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes > 0) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
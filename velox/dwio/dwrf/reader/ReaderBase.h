@@ -73,7 +73,9 @@ class ReaderBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       bool fileColumnNamesReadAsLowerCase = false,
       std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr,
-      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr);
+      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr,
+      const std::string& fileMetadataCacheKey = "",
+      std::shared_ptr<io::IoStatistics> ioStats = nullptr);
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -145,7 +147,7 @@ class ReaderBase {
     return *input_;
   }
 
-  const std::unique_ptr<StripeMetadataCache>& getMetadataCache() const {
+  const std::shared_ptr<StripeMetadataCache>& getMetadataCache() const {
     return cache_;
   }
 
@@ -242,16 +244,37 @@ class ReaderBase {
   }
 
  private:
+  // The parsed tail of a file. Shared with the other readers of the file
+  // through the FileMetadataCache.
+  struct FileTail {
+    std::shared_ptr<google::protobuf::Arena> arena;
+    std::shared_ptr<PostScript> postScript;
+    std::shared_ptr<FooterWrapper> footer;
+    std::shared_ptr<StripeMetadataCache> cache;
+    uint64_t psLength;
+    uint64_t bytes;
+  };
+
+  // Reads and parses the post script, the footer and the stripe metadata
+  // cache of the file into 'this'. 'sharedPool' is the pool for the stripe
+  // metadata cache if the tail is shared with other readers.
+  void readTail(
+      dwio::common::FileFormat fileFormat,
+      bool preloadFile,
+      memory::MemoryPool* sharedPool);
+
   static std::shared_ptr<const Type> convertType(
       const FooterWrapper& footer,
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
   memory::MemoryPool& pool_;
-  std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_ = nullptr;
-  std::unique_ptr<StripeMetadataCache> cache_;
+  // Shared with the other readers of the file if the FileMetadataCache is
+  // used.
+  std::shared_ptr<google::protobuf::Arena> arena_;
+  std::shared_ptr<PostScript> postScript_;
+  std::shared_ptr<FooterWrapper> footer_ = nullptr;
+  std::shared_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
   std::unique_ptr<encryption::DecryptionHandler> handler_;
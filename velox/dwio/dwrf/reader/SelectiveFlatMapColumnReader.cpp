@@ -165,6 +165,26 @@ std::vector<KeyNode<T>> getKeyNodes(
   return keyNodes;
 }
 
+// Returns true if a null value passes the filters of 'spec' and of the fields
+// under it.  Filters under map and array children do not apply to a null.
+bool nullPassesFilters(const common::ScanSpec& spec) {
+  if (spec.filter() && !spec.filter()->testNull()) {
+    return false;
+  }
+  for (auto& child : spec.children()) {
+    const auto& name = child->fieldName();
+    if (name == common::ScanSpec::kMapKeysFieldName ||
+        name == common::ScanSpec::kMapValuesFieldName ||
+        name == common::ScanSpec::kArrayElementsFieldName) {
+      continue;
+    }
+    if (!nullPassesFilters(*child)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <typename T>
 class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
  public:
@@ -181,17 +201,46 @@ class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
         keyNodes_(
             getKeyNodes<T>(requestedType, fileType, params, scanSpec, true)) {
     VELOX_CHECK(
-        !keyNodes_.empty(),
+        !scanSpec.children().empty(),
         "For struct encoding, keys to project must be configured");
+    // The keys that are not in the stripe are null.  Their subscript may be
+    // left from the previous stripe.
+    for (auto& childSpec : scanSpec.children()) {
+      childSpec->setSubscript(kConstantChildSpecSubscript);
+    }
     children_.resize(keyNodes_.size());
     for (int i = 0; i < keyNodes_.size(); ++i) {
       keyNodes_[i].reader->scanSpec()->setSubscript(i);
       children_[i] = keyNodes_[i].reader.get();
     }
+    for (auto& childSpec : scanSpec.children()) {
+      if (childSpec->subscript() == kConstantChildSpecSubscript &&
+          !childSpec->isConstant() && !nullPassesFilters(*childSpec)) {
+        missingKeyFiltersFail_ = true;
+        break;
+      }
+    }
+  }
+
+  void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
+      override {
+    if (!missingKeyFiltersFail_) {
+      SelectiveStructColumnReaderBase::read(offset, rows, incomingNulls);
+      return;
+    }
+    // A filter on a key that is not in the stripe drops all rows, without
+    // reading the streams of the other keys.
+    numReads_ = scanSpec_->newRead();
+    prepareRead<char>(offset, rows, incomingNulls);
+    setOutputRows({});
+    recordParentNullsInChildren(offset, rows);
+    lazyVectorReadOffset_ = offset;
+    readOffset_ = offset + rows.back() + 1;
   }
 
  private:
   std::vector<KeyNode<T>> keyNodes_;
+  bool missingKeyFiltersFail_{false};
 };
 
 template <typename T>
@@ -15,6 +15,9 @@
  */
 
 #include "velox/dwio/dwrf/reader/SelectiveStringDictionaryColumnReader.h"
+
+#include <folly/json.h>
+
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
 
@@ -88,6 +91,21 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
   scanState_.updateRawState();
 }
 
+SelectiveStringDictionaryColumnReader::
+    ~SelectiveStringDictionaryColumnReader() {
+  if (cachedDictionary_ && !filterCacheKey_.empty()) {
+    cachedDictionary_->setFilterResults(
+        filterCacheKey_, scanState_.filterCache.data());
+  }
+}
+
+void SelectiveStringDictionaryColumnReader::resetFilterCaches() {
+  SelectiveColumnReader::resetFilterCaches();
+  // The filter changed, the results are no longer those of the filter in
+  // 'filterCacheKey_'.
+  filterCacheKey_.clear();
+}
+
 uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
   numValues = SelectiveColumnReader::skip(numValues);
   dictIndex_->skip(numValues);
@@ -324,6 +342,38 @@ void SelectiveStringDictionaryColumnReader::getValues(
       &memoryPool_, resultNulls(), numValues_, dictionaryValues_, values_);
 }
 
+void SelectiveStringDictionaryColumnReader::loadStripeDictionary() {
+  auto& dictionary = scanState_.dictionary;
+  auto* dictionaryCache = cache::DecodedDictionaryCache::getInstance();
+  std::optional<cache::DecodedDictionaryKey> cacheKey;
+  if (dictionaryCache && blobStream_) {
+    cacheKey = blobStream_->decodedDictionaryKey();
+  }
+  if (!cacheKey.has_value()) {
+    loadDictionary(*blobStream_, *lengthDecoder_, dictionary);
+    return;
+  }
+  cachedDictionary_ = dictionaryCache->find(cacheKey.value());
+  if (cachedDictionary_ &&
+      cachedDictionary_->numValues() == dictionary.numValues) {
+    dictionary.values = cachedDictionary_->values();
+    dictionary.strings = cachedDictionary_->strings();
+    ++statistics_.cachedStringDictionaries;
+    return;
+  }
+  loadDictionary(*blobStream_, *lengthDecoder_, dictionary);
+  cachedDictionary_ = dictionaryCache->insert(
+      cacheKey.value(),
+      dictionary.values->as<StringView>(),
+      dictionary.numValues,
+      dictionary.strings->as<char>(),
+      dictionary.strings->size());
+  if (cachedDictionary_ &&
+      cachedDictionary_->numValues() != dictionary.numValues) {
+    cachedDictionary_ = nullptr;
+  }
+}
+
 void SelectiveStringDictionaryColumnReader::ensureInitialized() {
   if (LIKELY(initialized_)) {
     return;
@@ -331,7 +381,7 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   Timer timer;
 
-  loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  loadStripeDictionary();
 
   if (DictionaryValues::hasFilter(scanSpec_->filter())) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
@@ -339,6 +389,11 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
         scanState_.filterCache.data(),
         FilterResult::kUnknown,
         scanState_.dictionary.numValues);
+    if (cachedDictionary_) {
+      filterCacheKey_ = folly::toJson(scanSpec_->filter()->serialize());
+      cachedDictionary_->getFilterResults(
+          filterCacheKey_, scanState_.filterCache.data());
+    }
   }
 
   // handle in dictionary stream
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/DecodedDictionaryCache.h"
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/reader/DwrfData.h"
@@ -32,6 +33,8 @@ class SelectiveStringDictionaryColumnReader
       DwrfParams& params,
       common::ScanSpec& scanSpec);
 
+  ~SelectiveStringDictionaryColumnReader() override;
+
   void seekToRowGroup(uint32_t index) override {
     SelectiveColumnReader::seekToRowGroup(index);
     auto positionsProvider = formatData_->as<DwrfData>().seekToRowGroup(index);
@@ -58,6 +61,8 @@ class SelectiveStringDictionaryColumnReader
 
   void getValues(RowSet rows, VectorPtr* result) override;
 
+  void resetFilterCaches() override;
+
  private:
   void loadStrideDictionary();
   void makeDictionaryBaseVector();
@@ -82,6 +87,10 @@ class SelectiveStringDictionaryColumnReader
       dwio::common::DictionaryValues& values);
   void ensureInitialized();
 
+  // Takes the stripe dictionary from cache::DecodedDictionaryCache if there.
+  // Loads it and adds it to the cache otherwise.
+  void loadStripeDictionary();
+
   void makeFlat(VectorPtr* result);
 
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> dictIndex_;
@@ -105,6 +114,14 @@ class SelectiveStringDictionaryColumnReader
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
   bool initialized_{false};
   vector_size_t numRowsScanned_;
+
+  // The stripe dictionary in cache::DecodedDictionaryCache. nullptr if it is
+  // not cached.
+  std::shared_ptr<cache::DecodedDictionary> cachedDictionary_;
+
+  // The serialized filter under which the filter results on the stripe
+  // dictionary are shared in 'cachedDictionary_'. Empty if not shared.
+  std::string filterCacheKey_;
 };
 
 template <typename TVisitor>
@@ -69,6 +69,12 @@ SelectiveStructColumnReader::SelectiveStructColumnReader(
         childRequestedType, childFileType, childParams, *childSpec));
     childSpec->setSubscript(children_.size() - 1);
   }
+  if (isRoot) {
+    const auto& options = stripe.getRowReaderOptions();
+    setDecodingExecutor(
+        options.getDecodingExecutor().get(),
+        options.getDecodingParallelismFactor());
+  }
 }
 
 void SelectiveStructColumnReaderBase::seekTo(
@@ -98,6 +104,7 @@ void SelectiveStructColumnReaderBase::seekTo(
     }
     numParentNulls_ = 0;
     parentNullsRecordedTo_ = 0;
+    lastParentNulls_.reset();
     readOffset_ = offset;
   } else {
     VELOX_FAIL("Seeking backward on a ColumnReader");
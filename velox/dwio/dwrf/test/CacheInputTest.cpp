@@ -18,6 +18,7 @@
 #include <folly/container/F14Map.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/CachePeer.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/io/IoStatistics.h"
@@ -848,6 +849,60 @@ TEST_F(CacheTest, noCacheRetention) {
   }
 }
 
+namespace {
+// Cache peer that serves the data a TestReadFile would return, as if another
+// worker had cached the whole file.
+class TestCachePeer : public cache::CachePeer {
+ public:
+  bool read(
+      std::string_view fileName,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) override {
+    ++numReads_;
+    if (!available_) {
+      return false;
+    }
+    StringIdLease lease(fileIds(), fileName);
+    TestReadFile(lease.id(), 1UL << 63, nullptr).preadv(offset, buffers);
+    return true;
+  }
+
+  void setAvailable(bool available) {
+    available_ = available;
+  }
+
+  int64_t numReads() const {
+    return numReads_;
+  }
+
+ private:
+  std::atomic_bool available_{true};
+  std::atomic<int64_t> numReads_{0};
+};
+} // namespace
+
+TEST_F(CacheTest, cachePeer) {
+  initializeCache(64 << 20);
+  auto peer = std::make_shared<TestCachePeer>();
+  cache_->setCachePeer(peer);
+
+  // All misses are served by the peer.
+  readLoop("testfile", 30, 70, 10, 10, 4, /*noCacheRetention=*/false, ioStats_);
+  ASSERT_GT(peer->numReads(), 0);
+  ASSERT_GT(ioStats_->peerRead().sum(), 0);
+  ASSERT_EQ(ioStats_->read().sum(), 0);
+
+  // Misses fall back to storage when the peer does not have the data.
+  peer->setAvailable(false);
+  const auto prevPeerRead = ioStats_->peerRead().sum();
+  const auto prevNumPeerReads = peer->numReads();
+  readLoop(
+      "testfile2", 30, 70, 10, 10, 4, /*noCacheRetention=*/false, ioStats_);
+  ASSERT_GT(peer->numReads(), prevNumPeerReads);
+  ASSERT_EQ(ioStats_->peerRead().sum(), prevPeerRead);
+  ASSERT_GT(ioStats_->read().sum(), 0);
+}
+
 TEST_F(CacheTest, loadQuotumTooLarge) {
   initializeCache(64 << 20, 256 << 20);
   auto fileId = std::make_unique<StringIdLease>(fileIds(), "foo");
@@ -22,8 +22,11 @@
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/common/compression/Compression.h"
+#include "velox/dwio/common/compression/DecompressionBackend.h"
 
 #include <algorithm>
 
@@ -285,6 +288,134 @@ TEST_P(CompressionTest, compressProtoBuf) {
   verifyProto(memSink, kind_, block, *pool_, ps, decrypter_);
 }
 
+TEST_P(CompressionTest, decompressionBackend) {
+  namespace compression = facebook::velox::dwio::common::compression;
+  struct CountingBackend : public compression::ExecutorDecompressionBackend {
+    using compression::ExecutorDecompressionBackend::
+        ExecutorDecompressionBackend;
+
+    folly::SemiFuture<uint64_t> decompress(
+        compression::Decompressor& decompressor,
+        const char* src,
+        uint64_t srcLength,
+        char* dest,
+        uint64_t destLength) override {
+      ++numBlocks;
+      return ExecutorDecompressionBackend::decompress(
+          decompressor, src, srcLength, dest, destLength);
+    }
+
+    std::atomic<int32_t> numBlocks{0};
+  };
+  folly::CPUThreadPoolExecutor executor(2);
+  auto backend = std::make_shared<CountingBackend>(&executor);
+  compression::registerDecompressionBackend(backend);
+  SCOPE_EXIT {
+    compression::registerDecompressionBackend(nullptr);
+  };
+
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+  constexpr uint64_t block = 1024;
+  constexpr size_t dataSize = 256 * 1024;
+  std::vector<char> testData(dataSize);
+  generateRandomData(testData.data(), dataSize, true);
+  compressAndVerify(
+      kind_, memSink, block, *pool_, testData.data(), dataSize, encrypter_);
+  decompressAndVerify(
+      memSink, kind_, block, testData.data(), dataSize, *pool_, decrypter_);
+
+  // Skips over whole and partial blocks, which takes or drops the blocks
+  // decompressed ahead.
+  auto decompressStream = createDecompressor(
+      kind_,
+      std::make_unique<SeekableArrayInputStream>(
+          memSink.data(), memSink.size()),
+      block,
+      *pool_,
+      "Test Compression",
+      decrypter_);
+  const char* buffer;
+  int32_t size;
+  size_t pos = 0;
+  while (decompressStream->Next(
+      reinterpret_cast<const void**>(&buffer), &size)) {
+    ASSERT_LE(pos + size, dataSize);
+    ASSERT_EQ(0, memcmp(buffer, testData.data() + pos, size)) << pos;
+    pos += size;
+    decompressStream->SkipInt64(2'500);
+    pos += 2'500;
+  }
+  ASSERT_GE(pos, dataSize);
+
+  if (kind_ == CompressionKind_ZSTD && decrypter_ == nullptr) {
+    EXPECT_GT(backend->numBlocks, 0);
+  } else {
+    EXPECT_EQ(backend->numBlocks, 0);
+  }
+}
+
+TEST_P(CompressionTest, decompressedCache) {
+  using facebook::velox::cache::DecompressedBlockKey;
+  using facebook::velox::cache::DecompressedCache;
+  // A stream whose blocks are all worth caching.
+  struct HotStream : public SeekableArrayInputStream {
+    using SeekableArrayInputStream::SeekableArrayInputStream;
+
+    std::optional<DecompressedBlockKey> decompressedBlockKey(
+        uint64_t offset) const override {
+      return DecompressedBlockKey{1, offset};
+    }
+  };
+  DecompressedCache cache(pool_.get(), 1 << 20);
+  DecompressedCache::setInstance(&cache);
+  SCOPE_EXIT {
+    DecompressedCache::setInstance(nullptr);
+  };
+
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+  constexpr uint64_t block = 1024;
+  constexpr size_t dataSize = 64 * 1024;
+  std::vector<char> testData(dataSize);
+  generateRandomData(testData.data(), dataSize, true);
+  compressAndVerify(
+      kind_, memSink, block, *pool_, testData.data(), dataSize, encrypter_);
+
+  // The first pass fills the cache and the second reads from it. Backing up
+  // rereads the window of a cached block.
+  for (auto pass = 0; pass < 2; ++pass) {
+    auto decompressStream = createDecompressor(
+        kind_,
+        std::make_unique<HotStream>(memSink.data(), memSink.size()),
+        block,
+        *pool_,
+        "Test Compression",
+        decrypter_);
+    const char* buffer;
+    int32_t size;
+    size_t pos = 0;
+    while (decompressStream->Next(
+        reinterpret_cast<const void**>(&buffer), &size)) {
+      ASSERT_LE(pos + size, dataSize);
+      ASSERT_EQ(0, memcmp(buffer, testData.data() + pos, size)) << pos;
+      pos += size;
+      if (size > 1) {
+        decompressStream->BackUp(size / 2);
+        pos -= size / 2;
+      }
+    }
+    ASSERT_EQ(pos, dataSize);
+  }
+
+  const auto stats = cache.stats();
+  if (kind_ == CompressionKind_ZSTD && decrypter_ == nullptr) {
+    EXPECT_GT(stats.numElements, 0);
+    EXPECT_EQ(stats.numHits, stats.numElements);
+  } else {
+    EXPECT_EQ(stats.numElements, 0);
+    EXPECT_EQ(stats.numLookups, 0);
+  }
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     TestCompression,
     CompressionTest,
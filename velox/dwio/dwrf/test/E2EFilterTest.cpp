@@ -21,6 +21,7 @@
 #include "velox/dwio/dwrf/writer/FlushPolicy.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 using namespace facebook::velox::dwio::common;
@@ -96,6 +97,10 @@ class E2EFilterTest : public E2EFilterTestBase {
     for (auto& field : flatMapAsStructFields_) {
       spec->childByName(field)->setFlatMapAsStruct(true);
     }
+    if (decodingExecutor_ != nullptr) {
+      opts.setDecodingExecutor(decodingExecutor_);
+      opts.setDecodingParallelismFactor(kDecodingParallelism);
+    }
   }
 
   std::unique_ptr<dwio::common::Reader> makeReader(
@@ -104,7 +109,11 @@ class E2EFilterTest : public E2EFilterTestBase {
     return std::make_unique<DwrfReader>(opts, std::move(input));
   }
 
+  static constexpr size_t kDecodingParallelism = 3;
+
   std::unordered_set<std::string> flatMapColumns_;
+  // Decodes the columns without filter in parallel if set.
+  std::shared_ptr<folly::Executor> decodingExecutor_;
 
  private:
   dwrf::WriterOptions createWriterOptions(const TypePtr& type) {
@@ -351,6 +360,25 @@ TEST_F(E2EFilterTest, lazyStruct) {
       false);
 }
 
+TEST_F(E2EFilterTest, parallelDecoding) {
+  decodingExecutor_ =
+      std::make_shared<folly::CPUThreadPoolExecutor>(kDecodingParallelism);
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "array_val:array<bigint>,"
+      "struct_val:struct<nested1:bigint, nested2:string>",
+      [&]() {},
+      true,
+      {"short_val", "long_val", "string_val"},
+      20,
+      true,
+      false);
+}
+
 TEST_F(E2EFilterTest, filterStruct) {
 #ifdef TSAN_BUILD
   // The test is running slow under TSAN; reduce the number of combinations to
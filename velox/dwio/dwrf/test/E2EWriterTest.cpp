@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -1034,6 +1035,50 @@ TEST_F(E2EWriterTest, OversizeBatches) {
       false);
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "bool_val:boolean,"
+      "int_val:int,"
+      "bigint_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "list_val:array<bigint>,"
+      "map_val:map<int, string>,"
+      "struct_val:struct<a:bigint,b:string>"
+      ">");
+  auto batches = dwrf::E2EWriterTestUtil::generateBatches(
+      type, 20, 1'000, /*seed=*/1, *leafPool_);
+  folly::CPUThreadPoolExecutor executor(4);
+
+  auto writeFile = [&](size_t parallelismFactor) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * kSizeMB,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = std::make_shared<dwrf::Config>();
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = &executor;
+    options.encodingParallelismFactor = parallelismFactor;
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  // The file does not depend on the number of threads encoding the columns.
+  const auto expected = writeFile(0);
+  for (auto parallelismFactor : {2, 3, 8}) {
+    SCOPED_TRACE(fmt::format("parallelismFactor: {}", parallelismFactor));
+    ASSERT_EQ(writeFile(parallelismFactor), expected);
+  }
+}
+
 TEST_F(E2EWriterTest, OverflowLengthIncrements) {
   auto pool = facebook::velox::memory::memoryManager()->addLeafPool();
 
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <fmt/format.h>
+#include <folly/Random.h>
 #include <gtest/gtest.h>
 
 #include "velox/common/base/Nulls.h"
@@ -73,6 +75,33 @@ void checkResults(
   }
 }
 
+// Appends a DIRECT run of 'values', each zigzag encoded in 'bitWidth' bits,
+// to 'bytes'.
+void appendDirectRun(
+    const std::vector<int64_t>& values,
+    uint32_t bitWidth,
+    std::vector<unsigned char>& bytes) {
+  static const std::vector<uint32_t> kWidths = {
+      1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+      17, 18, 19, 20, 21, 22, 23, 24, 26, 28, 30, 32, 40, 48, 56, 64};
+  const auto widthCode =
+      std::find(kWidths.begin(), kWidths.end(), bitWidth) - kWidths.begin();
+  const auto length = values.size() - 1;
+  bytes.push_back(0x40 | (widthCode << 1) | (length >> 8));
+  bytes.push_back(length & 0xff);
+  uint32_t numBits = 0;
+  for (auto value : values) {
+    const auto zigzag = (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+    for (int32_t bit = bitWidth - 1; bit >= 0; --bit) {
+      if (numBits % 8 == 0) {
+        bytes.push_back(0);
+      }
+      bytes.back() |= ((zigzag >> bit) & 1) << (7 - numBits % 8);
+      ++numBits;
+    }
+  }
+}
+
 class RLEv2Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -419,6 +448,30 @@ TEST_F(RLEv2Test, overflowDirect) {
       values.size());
 };
 
+TEST_F(RLEv2Test, directAllWidths) {
+  for (uint32_t bitWidth :
+       {1, 2, 3, 5, 7, 8, 9, 12, 16, 17, 24, 26, 28, 30, 32, 40, 48, 56, 64}) {
+    SCOPED_TRACE(fmt::format("bitWidth {}", bitWidth));
+    std::vector<int64_t> values;
+    std::vector<unsigned char> bytes;
+    // Runs of the largest length and an odd one, which ends inside a byte.
+    for (auto runLength : {512, 37, 512}) {
+      std::vector<int64_t> run;
+      for (auto i = 0; i < runLength; ++i) {
+        const auto zigzag = folly::Random::rand64() >> (64 - bitWidth);
+        run.push_back((zigzag >> 1) ^ -(zigzag & 1));
+      }
+      appendDirectRun(run, bitWidth, bytes);
+      values.insert(values.end(), run.begin(), run.end());
+    }
+    const size_t count = values.size();
+    for (size_t n : std::vector<size_t>{1, 3, 7, 100, count}) {
+      checkResults(
+          values, decodeRLEv2(bytes.data(), bytes.size(), n, count), n);
+    }
+  }
+}
+
 TEST_F(RLEv2Test, basicPatched0) {
   long v[] = {2030, 2000, 2020, 1000000, 2040, 2050, 2060, 2070, 2080, 2090};
   std::vector<int64_t> values;
@@ -312,3 +312,78 @@ TEST_F(TestStatisticsBuilderUtils, addBinaryValues) {
     EXPECT_EQ(106, binStats->getTotalLength().value());
   }
 }
+
+TEST_F(TestStatisticsBuilderUtils, batch) {
+  {
+    IntegerStatisticsBuilder single{options};
+    IntegerStatisticsBuilder batched{options};
+    IntegerStatisticsBuilder::Batch batch;
+    for (int64_t value : {5, -3, 17, 0, 11}) {
+      single.addValues(value);
+      batch.add(value);
+    }
+    batched.addValues(batch);
+    EXPECT_EQ(single.getNumberOfValues(), batched.getNumberOfValues());
+    EXPECT_EQ(single.getMinimum(), batched.getMinimum());
+    EXPECT_EQ(single.getMaximum(), batched.getMaximum());
+    EXPECT_EQ(single.getSum(), batched.getSum());
+
+    // An overflowing sum is dropped, the min and max are kept.
+    IntegerStatisticsBuilder::Batch overflow;
+    overflow.add(std::numeric_limits<int64_t>::max());
+    overflow.add(1);
+    batched.addValues(overflow);
+    EXPECT_EQ(7, batched.getNumberOfValues());
+    EXPECT_EQ(-3, batched.getMinimum());
+    EXPECT_EQ(std::numeric_limits<int64_t>::max(), batched.getMaximum());
+    EXPECT_FALSE(batched.getSum().has_value());
+  }
+
+  {
+    DoubleStatisticsBuilder single{options};
+    DoubleStatisticsBuilder batched{options};
+    DoubleStatisticsBuilder::Batch batch;
+    for (double value : {1.5, -2.25, 8.0, 0.5}) {
+      single.addValues(value);
+      batch.add(value);
+    }
+    batched.addValues(batch);
+    EXPECT_EQ(single.getNumberOfValues(), batched.getNumberOfValues());
+    EXPECT_EQ(single.getMinimum(), batched.getMinimum());
+    EXPECT_EQ(single.getMaximum(), batched.getMaximum());
+    EXPECT_EQ(single.getSum(), batched.getSum());
+
+    // A NaN clears the min, max and sum.
+    DoubleStatisticsBuilder::Batch withNan;
+    withNan.add(1.0);
+    withNan.add(std::nan(""));
+    batched.addValues(withNan);
+    EXPECT_EQ(6, batched.getNumberOfValues());
+    EXPECT_FALSE(batched.getMinimum().has_value());
+    EXPECT_FALSE(batched.getMaximum().has_value());
+    EXPECT_FALSE(batched.getSum().has_value());
+  }
+
+  {
+    StringStatisticsBuilder single{options};
+    StringStatisticsBuilder batched{options};
+    std::vector<std::string> values{
+        "pear", "apple", "a somewhat longer string", "zebra", "", "apples"};
+    for (auto i = 0; i < 2; ++i) {
+      // The second batch is added to a non-empty builder.
+      StringStatisticsBuilder::Batch batch;
+      for (const auto& value : values) {
+        single.addValues(folly::StringPiece{value});
+        batch.add(StringView(value));
+      }
+      batched.addValues(batch);
+      EXPECT_EQ(single.getNumberOfValues(), batched.getNumberOfValues());
+      EXPECT_EQ(single.getMinimum(), batched.getMinimum());
+      EXPECT_EQ(single.getMaximum(), batched.getMaximum());
+      EXPECT_EQ(single.getTotalLength(), batched.getTotalLength());
+      values = {"b", "zz", "aa"};
+    }
+    EXPECT_EQ("", batched.getMinimum().value());
+    EXPECT_EQ("zz", batched.getMaximum().value());
+  }
+}
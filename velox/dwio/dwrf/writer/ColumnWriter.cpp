@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,16 +36,16 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  selected_.resize(slice->size());
   // initialize
-  selected.clearAll();
+  selected_.clearAll();
   for (auto& range : ranges.getRanges()) {
-    selected.setValidRange(std::get<0>(range), std::get<1>(range), true);
+    selected_.setValidRange(std::get<0>(range), std::get<1>(range), true);
   }
-  selected.updateBounds();
+  selected_.updateBounds();
   // decode
   auto localDecoded = context_.getLocalDecodedVector();
-  localDecoded.get().decode(*slice, selected);
+  localDecoded.get().decode(*slice, selected_);
   return localDecoded;
 }
 
@@ -508,10 +509,11 @@ uint64_t IntegerColumnWriter<T>::writeDict(
   writeNulls(decodedVector, ranges);
   // make sure we have enough space
   rows_.reserve(rows_.size() + ranges.size());
+  IntegerStatisticsBuilder::Batch statsBatch;
   auto processRow = [&](vector_size_t pos) {
     T value = decodedVector.valueAt<T>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(value));
-    statsBuilder.addValues(value);
+    statsBatch.add(value);
   };
 
   uint64_t nullCount = 0;
@@ -529,6 +531,8 @@ uint64_t IntegerColumnWriter<T>::writeDict(
     }
   }
 
+  statsBuilder.addValues(statsBatch);
+
   uint64_t rawSize = (ranges.size() - nullCount) * sizeof(T);
   if (nullCount > 0) {
     statsBuilder.setHasNull();
@@ -1113,10 +1117,11 @@ uint64_t StringColumnWriter::writeDict(
   rows_.reserve(rows_.size() + ranges.size());
   size_t strideIndex = strideOffsets_.size() - 1;
   uint64_t rawSize = 0;
+  StringStatisticsBuilder::Batch statsBatch;
   auto processRow = [&](size_t pos) {
     auto sp = decodedVector.valueAt<StringView>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
-    statsBuilder.addValues(sp);
+    statsBatch.add(sp);
     rawSize += sp.size();
   };
 
@@ -1134,6 +1139,7 @@ uint64_t StringColumnWriter::writeDict(
       processRow(pos);
     }
   }
+  statsBuilder.addValues(statsBatch);
 
   if (nullCount > 0) {
     statsBuilder.setHasNull();
@@ -1157,11 +1163,12 @@ uint64_t StringColumnWriter::writeDirect(
   lengths.reserve(ranges.size());
 
   uint64_t rawSize = 0;
+  StringStatisticsBuilder::Batch statsBatch;
   auto processRow = [&](size_t pos) {
     auto sp = decodedVector.valueAt<StringView>(pos);
     auto size = sp.size();
     dataDirect_->write(sp.data(), size);
-    statsBuilder.addValues(sp);
+    statsBatch.add(sp);
     rawSize += size;
     lengths.unsafeAppend(size);
   };
@@ -1180,6 +1187,7 @@ uint64_t StringColumnWriter::writeDirect(
       processRow(pos);
     }
   }
+  statsBuilder.addValues(statsBatch);
   if (lengths.size() > 0) {
     dataDirectLength_->add(
         lengths.data(), common::Ranges::of(0, lengths.size()), nullptr);
@@ -1389,6 +1397,7 @@ uint64_t FloatColumnWriter<T>::write(
       dynamic_cast<DoubleStatisticsBuilder&>(*indexStatsBuilder_);
 
   uint64_t nullCount = 0;
+  DoubleStatisticsBuilder::Batch statsBatch;
   if (slice->encoding() == VectorEncoding::Simple::FLAT) {
     auto flatVector = slice->asFlatVector<T>();
     VELOX_CHECK_NOT_NULL(flatVector, "unexpected vector type");
@@ -1408,7 +1417,7 @@ uint64_t FloatColumnWriter<T>::write(
       auto processRow = [&](size_t pos) {
         auto val = data[pos];
         writer.add(val);
-        statsBuilder.addValues(val);
+        statsBatch.add(val);
       };
       for (auto& pos : ranges) {
         if (bits::isBitNull(nulls, pos)) {
@@ -1422,7 +1431,7 @@ uint64_t FloatColumnWriter<T>::write(
       writer.close();
     } else {
       for (auto& pos : ranges) {
-        statsBuilder.addValues(data[pos]);
+        statsBatch.add(data[pos]);
       }
       for (const auto& [start, end] : ranges.getRanges()) {
         const char* srcPtr = reinterpret_cast<const char*>(data + start);
@@ -1447,7 +1456,7 @@ uint64_t FloatColumnWriter<T>::write(
     auto processRow = [&](size_t pos) {
       auto val = decodedVector.template valueAt<T>(pos);
       writer.add(val);
-      statsBuilder.addValues(val);
+      statsBatch.add(val);
     };
     if (decodedVector.mayHaveNulls()) {
       for (auto& pos : ranges) {
@@ -1467,6 +1476,8 @@ uint64_t FloatColumnWriter<T>::write(
     writer.close();
   }
 
+  statsBuilder.addValues(statsBatch);
+
   uint64_t rawSize = (ranges.size() - nullCount) * sizeof(T);
   if (nullCount > 0) {
     statsBuilder.setHasNull();
@@ -1631,8 +1642,27 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    // The writers of top level columns share no state besides the context,
+    // except for flat maps, which add streams and share dictionaries on the
+    // fly.
+    if (isRoot() && context_.encodingParallelismFactor() > 1 &&
+        !context_.getConfig(Config::FLATTEN_MAP)) {
+      std::vector<uint64_t> rawSizes(children_.size());
+      dwio::common::ParallelFor(
+          context_.encodingExecutor(),
+          0,
+          children_.size(),
+          context_.encodingParallelismFactor())
+          .execute([&](size_t i) {
+            rawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+          });
+      for (auto size : rawSizes) {
+        rawSize += size;
+      }
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
@@ -263,6 +263,9 @@ class BaseColumnWriter : public ColumnWriter {
   std::unique_ptr<StatisticsBuilder> indexStatsBuilder_;
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
   std::unique_ptr<ByteRleEncoder> present_;
+  // Rows to decode in decode(). Owned by each writer so that the top level
+  // columns can be encoded in parallel.
+  SelectivityVector selected_;
   bool hasNull_ = false;
   // callback used to inject the logic that captures positions for flat map
   // in_map stream
@@ -231,6 +231,47 @@ class IntegerStatisticsBuilder : public StatisticsBuilder,
     addWithOverflowCheck(sum_, value, count);
   }
 
+  /// Stats of a batch of values kept in plain locals. Cheaper to update per
+  /// value than the builder, whose members are all optional.
+  class Batch {
+   public:
+    void add(int64_t value) {
+      min_ = std::min(min_, value);
+      max_ = std::max(max_, value);
+      sumOverflow_ |= __builtin_add_overflow(sum_, value, &sum_);
+      ++count_;
+    }
+
+   private:
+    int64_t min_{std::numeric_limits<int64_t>::max()};
+    int64_t max_{std::numeric_limits<int64_t>::min()};
+    int64_t sum_{0};
+    bool sumOverflow_{false};
+    uint64_t count_{0};
+
+    friend class IntegerStatisticsBuilder;
+  };
+
+  /// Adds the values of 'batch'. The count, min and max are the same as when
+  /// adding the values one by one. The sum is exact if present.
+  void addValues(const Batch& batch) {
+    if (batch.count_ == 0) {
+      return;
+    }
+    increaseValueCount(batch.count_);
+    if (min_.has_value() && batch.min_ < min_.value()) {
+      min_ = batch.min_;
+    }
+    if (max_.has_value() && batch.max_ > max_.value()) {
+      max_ = batch.max_;
+    }
+    if (batch.sumOverflow_) {
+      sum_.reset();
+    } else {
+      mergeWithOverflowCheck(sum_, std::optional<int64_t>(batch.sum_));
+    }
+  }
+
   void merge(
       const dwio::common::ColumnStatistics& other,
       bool ignoreSize = false) override;
@@ -290,6 +331,57 @@ class DoubleStatisticsBuilder : public StatisticsBuilder,
     }
   }
 
+  /// Stats of a batch of values kept in plain locals. See
+  /// IntegerStatisticsBuilder::Batch.
+  class Batch {
+   public:
+    void add(double value) {
+      hasNan_ |= std::isnan(value);
+      if (value < min_) {
+        min_ = value;
+      }
+      if (value > max_) {
+        max_ = value;
+      }
+      sum_ += value;
+      ++count_;
+    }
+
+   private:
+    double min_{std::numeric_limits<double>::infinity()};
+    double max_{-std::numeric_limits<double>::infinity()};
+    double sum_{0};
+    bool hasNan_{false};
+    uint64_t count_{0};
+
+    friend class DoubleStatisticsBuilder;
+  };
+
+  /// Adds the values of 'batch'. The count, min and max are the same as when
+  /// adding the values one by one.
+  void addValues(const Batch& batch) {
+    if (batch.count_ == 0) {
+      return;
+    }
+    increaseValueCount(batch.count_);
+    if (batch.hasNan_) {
+      clear();
+      return;
+    }
+    if (min_.has_value() && batch.min_ < min_.value()) {
+      min_ = batch.min_;
+    }
+    if (max_.has_value() && batch.max_ > max_.value()) {
+      max_ = batch.max_;
+    }
+    if (sum_.has_value()) {
+      sum_.value() += batch.sum_;
+      if (std::isnan(sum_.value())) {
+        sum_.reset();
+      }
+    }
+  }
+
   void merge(
       const dwio::common::ColumnStatistics& other,
       bool ignoreSize = false) override;
@@ -346,6 +438,57 @@ class StringStatisticsBuilder : public StatisticsBuilder,
     addWithOverflowCheck<uint64_t>(length_, value.size(), count);
   }
 
+  /// Stats of a batch of values kept in plain locals. Keeps views of the min
+  /// and max values instead of copying each new min or max into the builder.
+  /// The values must stay alive until the batch is added to the builder.
+  class Batch {
+   public:
+    void add(StringView value) {
+      if (count_ == 0) {
+        min_ = value;
+        max_ = value;
+      } else if (value < min_) {
+        min_ = value;
+      } else if (value > max_) {
+        max_ = value;
+      }
+      length_ += value.size();
+      ++count_;
+    }
+
+   private:
+    StringView min_;
+    StringView max_;
+    uint64_t length_{0};
+    uint64_t count_{0};
+
+    friend class StringStatisticsBuilder;
+  };
+
+  /// Adds the values of 'batch'. The stats are the same as when adding the
+  /// values one by one.
+  void addValues(const Batch& batch) {
+    if (batch.count_ == 0) {
+      return;
+    }
+    const auto isSelfEmpty = isEmpty(*this);
+    increaseValueCount(batch.count_);
+    const folly::StringPiece min{batch.min_};
+    const folly::StringPiece max{batch.max_};
+    if (isSelfEmpty) {
+      min_ = min;
+      max_ = max;
+    } else {
+      if (min_.has_value() && min < folly::StringPiece{min_.value()}) {
+        min_ = min;
+      }
+      if (max_.has_value() && max > folly::StringPiece{max_.value()}) {
+        max_ = max;
+      }
+    }
+    addWithOverflowCheck<uint64_t>(length_, batch.length_, 1);
+  }
+
   void merge(
       const dwio::common::ColumnStatistics& other,
       bool ignoreSize = false) override;
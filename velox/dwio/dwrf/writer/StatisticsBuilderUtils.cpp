@@ -82,19 +82,21 @@ void StatisticsBuilderUtils::addValues(
     const common::Ranges& ranges) {
   auto nulls = vector->rawNulls();
   auto data = vector->asFlatVector<StringView>()->rawValues();
+  StringStatisticsBuilder::Batch batch;
   if (vector->mayHaveNulls()) {
     for (auto& pos : ranges) {
       if (bits::isBitNull(nulls, pos)) {
         builder.setHasNull();
       } else {
-        builder.addValues(folly::StringPiece{data[pos]});
+        batch.add(data[pos]);
       }
     }
   } else {
     for (auto& pos : ranges) {
-      builder.addValues(folly::StringPiece{data[pos]});
+      batch.add(data[pos]);
     }
   }
+  builder.addValues(batch);
 }
 
 void StatisticsBuilderUtils::addValues(
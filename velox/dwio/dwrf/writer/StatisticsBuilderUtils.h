@@ -76,19 +76,21 @@ void StatisticsBuilderUtils::addValues(
     const common::Ranges& ranges) {
   auto nulls = vector->rawNulls();
   auto vals = vector->asFlatVector<INT>()->rawValues();
+  IntegerStatisticsBuilder::Batch batch;
   if (vector->mayHaveNulls()) {
     for (auto& pos : ranges) {
       if (bits::isBitNull(nulls, pos)) {
         builder.setHasNull();
       } else {
-        builder.addValues(vals[pos]);
+        batch.add(vals[pos]);
       }
     }
   } else {
     for (auto& pos : ranges) {
-      builder.addValues(vals[pos]);
+      batch.add(vals[pos]);
     }
   }
+  builder.addValues(batch);
 }
 
 template <typename INT>
@@ -96,19 +98,21 @@ void StatisticsBuilderUtils::addValues(
     IntegerStatisticsBuilder& builder,
     const DecodedVector& vector,
     const common::Ranges& ranges) {
+  IntegerStatisticsBuilder::Batch batch;
   if (vector.mayHaveNulls()) {
     for (auto& pos : ranges) {
       if (vector.isNullAt(pos)) {
         builder.setHasNull();
       } else {
-        builder.addValues(vector.valueAt<INT>(pos));
+        batch.add(vector.valueAt<INT>(pos));
       }
     }
   } else {
     for (auto& pos : ranges) {
-      builder.addValues(vector.valueAt<INT>(pos));
+      batch.add(vector.valueAt<INT>(pos));
     }
   }
+  builder.addValues(batch);
 }
 
 template <typename FLOAT>
@@ -118,19 +122,21 @@ void StatisticsBuilderUtils::addValues(
     const common::Ranges& ranges) {
   auto nulls = vector->rawNulls();
   auto vals = vector->asFlatVector<FLOAT>()->rawValues();
+  DoubleStatisticsBuilder::Batch batch;
   if (vector->mayHaveNulls()) {
     for (auto& pos : ranges) {
       if (bits::isBitNull(nulls, pos)) {
         builder.setHasNull();
       } else {
-        builder.addValues(vals[pos]);
+        batch.add(vals[pos]);
       }
     }
   } else {
     for (auto& pos : ranges) {
-      builder.addValues(vals[pos]);
+      batch.add(vals[pos]);
     }
   }
+  builder.addValues(batch);
 }
 
 } // namespace facebook::velox::dwrf
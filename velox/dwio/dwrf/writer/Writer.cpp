@@ -76,6 +76,8 @@ Writer::Writer(
   writerBase_->initContext(options.config, pool, std::move(handler));
 
   auto& context = writerBase_->getContext();
+  context.setEncodingExecutor(
+      options.encodingExecutor, options.encodingParallelismFactor);
   VELOX_CHECK_EQ(
       context.getTotalMemoryUsage(),
       0,
@@ -838,6 +840,8 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.memoryPool = options.memoryPool;
   dwrfOptions.spillConfig = options.spillConfig;
   dwrfOptions.nonReclaimableSection = options.nonReclaimableSection;
+  dwrfOptions.encodingExecutor = options.encodingExecutor;
+  dwrfOptions.encodingParallelismFactor = options.encodingParallelismFactor;
   return dwrfOptions;
 }
 
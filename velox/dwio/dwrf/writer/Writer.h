@@ -51,6 +51,12 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If not null and 'encodingParallelismFactor' is greater than 1, the top
+  /// level columns of each write are encoded on up to
+  /// 'encodingParallelismFactor' threads, including the writing thread. The
+  /// output does not depend on the parallelism. Not used with flat maps.
+  folly::Executor* encodingExecutor{nullptr};
+  size_t encodingParallelismFactor{0};
 };
 
 class Writer : public dwio::common::Writer {
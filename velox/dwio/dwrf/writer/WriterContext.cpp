@@ -160,7 +160,6 @@ void WriterContext::abort() {
   dictEncoders_.clear();
   decodedVectorPool_.clear();
   decodedVectorPool_.shrink_to_fit();
-  selectivityVector_.reset();
   releaseMemoryReservation();
 }
 } // namespace facebook::velox::dwrf
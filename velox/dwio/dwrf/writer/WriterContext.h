@@ -17,6 +17,10 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+
+#include <folly/Executor.h>
+
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -254,8 +258,16 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns the compression buffer. If it is in use by another column being
+  /// encoded in parallel, returns a new buffer of the same size.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compressionBuffer_ == nullptr && encodingParallelismFactor_ > 1) {
+      VELOX_CHECK_NE(compression_, common::CompressionKind_NONE);
+      return std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -264,10 +276,32 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compressionBuffer_ != nullptr) {
+      VELOX_CHECK_GT(encodingParallelismFactor_, 1);
+      return;
+    }
     compressionBuffer_ = std::move(buffer);
   }
 
+  /// Encodes the top level columns of each write on up to
+  /// 'parallelismFactor' threads, including the calling thread, with the
+  /// other threads coming from 'executor'.
+  void setEncodingExecutor(
+      folly::Executor* executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = executor;
+    encodingParallelismFactor_ = executor != nullptr ? parallelismFactor : 0;
+  }
+
+  folly::Executor* encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
+  }
+
   void incrementNodeSize(uint32_t node, uint64_t size) {
     nodeSize_[node] += size;
   }
@@ -580,15 +614,6 @@ class WriterContext : public CompressionBufferPool {
     return LocalDecodedVector{*this};
   }
 
-  SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
-    if (FOLLY_UNLIKELY(selectivityVector_ == nullptr)) {
-      selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
-    } else {
-      selectivityVector_->resize(size);
-    }
-    return *selectivityVector_;
-  }
-
   void abort();
 
   dwio::common::DataBuffer<char>* testingCompressionBuffer() const {
@@ -599,6 +624,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(mutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -608,6 +634,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -649,8 +676,11 @@ class WriterContext : public CompressionBufferPool {
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
-  // Reusable SelectivityVector
-  std::unique_ptr<velox::SelectivityVector> selectivityVector_;
+  // Serializes access to 'compressionBuffer_' and 'decodedVectorPool_' from
+  // the threads encoding columns in parallel.
+  std::mutex mutex_;
+  folly::Executor* encodingExecutor_{nullptr};
+  size_t encodingParallelismFactor_{0};
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+
+#include <xsimd/xsimd.hpp>
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+using Bytes = xsimd::batch<uint8_t>;
+using Shorts = xsimd::batch<uint16_t>;
+using Ints = xsimd::batch<uint32_t>;
+
+constexpr int32_t kBatchSize = Bytes::size;
+
+// Transposes the 4 byte streams of 'kBatchSize' values starting at 'input'.
+// The streams are 'stride' bytes apart.
+void transpose4(const uint8_t* input, int64_t stride, uint8_t* output) {
+  auto b0 = Bytes::load_unaligned(input);
+  auto b1 = Bytes::load_unaligned(input + stride);
+  auto b2 = Bytes::load_unaligned(input + 2 * stride);
+  auto b3 = Bytes::load_unaligned(input + 3 * stride);
+  // Pairs of bytes 0-1 and 2-3 of each value.
+  auto low01 = xsimd::bitwise_cast<uint16_t>(xsimd::zip_lo(b0, b1));
+  auto high01 = xsimd::bitwise_cast<uint16_t>(xsimd::zip_hi(b0, b1));
+  auto low23 = xsimd::bitwise_cast<uint16_t>(xsimd::zip_lo(b2, b3));
+  auto high23 = xsimd::bitwise_cast<uint16_t>(xsimd::zip_hi(b2, b3));
+  xsimd::zip_lo(low01, low23).store_unaligned(
+      reinterpret_cast<uint16_t*>(output));
+  xsimd::zip_hi(low01, low23).store_unaligned(
+      reinterpret_cast<uint16_t*>(output + kBatchSize));
+  xsimd::zip_lo(high01, high23)
+      .store_unaligned(reinterpret_cast<uint16_t*>(output + 2 * kBatchSize));
+  xsimd::zip_hi(high01, high23)
+      .store_unaligned(reinterpret_cast<uint16_t*>(output + 3 * kBatchSize));
+}
+
+// 8 byte version of transpose4(). Bytes are first zipped into pairs, then
+// the pairs into quads and the quads into whole values.
+void transpose8(const uint8_t* input, int64_t stride, uint8_t* output) {
+  Shorts pairs[2][4];
+  for (auto i = 0; i < 4; ++i) {
+    auto even = Bytes::load_unaligned(input + 2 * i * stride);
+    auto odd = Bytes::load_unaligned(input + (2 * i + 1) * stride);
+    pairs[0][i] = xsimd::bitwise_cast<uint16_t>(xsimd::zip_lo(even, odd));
+    pairs[1][i] = xsimd::bitwise_cast<uint16_t>(xsimd::zip_hi(even, odd));
+  }
+  // 'half' selects the first or second half of the values, 'quarter' the
+  // first or second half of that.
+  for (auto half = 0; half < 2; ++half) {
+    Ints quads[2][2];
+    for (auto i = 0; i < 2; ++i) {
+      quads[0][i] = xsimd::bitwise_cast<uint32_t>(
+          xsimd::zip_lo(pairs[half][2 * i], pairs[half][2 * i + 1]));
+      quads[1][i] = xsimd::bitwise_cast<uint32_t>(
+          xsimd::zip_hi(pairs[half][2 * i], pairs[half][2 * i + 1]));
+    }
+    for (auto quarter = 0; quarter < 2; ++quarter) {
+      auto* out = reinterpret_cast<uint32_t*>(
+          output + (4 * half + 2 * quarter) * kBatchSize);
+      xsimd::zip_lo(quads[quarter][0], quads[quarter][1]).store_unaligned(out);
+      xsimd::zip_hi(quads[quarter][0], quads[quarter][1])
+          .store_unaligned(out + Ints::size);
+    }
+  }
+}
+
+void decodeScalar(
+    const uint8_t* input,
+    int64_t begin,
+    int64_t numValues,
+    int32_t valueSize,
+    uint8_t* output) {
+  for (auto i = begin; i < numValues; ++i) {
+    for (auto b = 0; b < valueSize; ++b) {
+      output[i * valueSize + b] = input[b * numValues + i];
+    }
+  }
+}
+
+} // namespace
+
+void decodeByteStreamSplit(
+    const char* input,
+    int64_t numValues,
+    int32_t valueSize,
+    char* output) {
+  auto* in = reinterpret_cast<const uint8_t*>(input);
+  auto* out = reinterpret_cast<uint8_t*>(output);
+  int64_t i = 0;
+  if (valueSize == 4) {
+    for (; i + kBatchSize <= numValues; i += kBatchSize) {
+      transpose4(in + i, numValues, out + i * 4);
+    }
+  } else if (valueSize == 8) {
+    for (; i + kBatchSize <= numValues; i += kBatchSize) {
+      transpose8(in + i, numValues, out + i * 8);
+    }
+  }
+  decodeScalar(in, i, numValues, valueSize, out);
+}
+
+} // namespace facebook::velox::parquet
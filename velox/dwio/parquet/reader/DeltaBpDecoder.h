@@ -43,6 +43,30 @@ class DeltaBpDecoder {
     }
   }
 
+  // Returns the number of values in the page as given by the header.
+  uint64_t totalValueCount() const {
+    return totalValueCount_;
+  }
+
+  // Decodes the next 'numValues' values into 'values'.
+  template <typename T>
+  void readValues(uint64_t numValues, T* values) {
+    for (uint64_t i = 0; i < numValues; ++i) {
+      values[i] = readLong();
+    }
+  }
+
+  // Returns the first byte after the encoded values. Valid only after all
+  // 'totalValueCount()' values have been read. Used by encodings that store
+  // other data after a DELTA_BINARY_PACKED run.
+  const char* bufferEnd() const {
+    if (firstBlockInitialized_ && valuesRemainingCurrentMiniBlock_ > 0) {
+      // The last miniblock is padded to full size.
+      return bufferStart_ + bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+    }
+    return bufferStart_;
+  }
+
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     int32_t current = visitor.start();
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include <folly/Range.h>
+
+namespace facebook::velox::parquet {
+
+// Decodes DELTA_LENGTH_BYTE_ARRAY: the lengths of all values encoded with
+// DELTA_BINARY_PACKED, followed by the concatenated bytes of the values. The
+// lengths are decoded in bulk when the page is opened so that reading and
+// skipping a value is a single addition.
+class DeltaLengthByteArrayDecoder {
+ public:
+  DeltaLengthByteArrayDecoder(const char* start, const char* end) {
+    DeltaBpDecoder lengthDecoder(start);
+    lengths_.resize(lengthDecoder.totalValueCount());
+    lengthDecoder.readValues(lengths_.size(), lengths_.data());
+    bufferStart_ = lengthDecoder.bufferEnd();
+    bufferEnd_ = end;
+    VELOX_CHECK_LE(bufferStart_, bufferEnd_);
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(lengthIndex_ + numValues, lengths_.size());
+    for (auto i = 0; i < numValues; ++i) {
+      bufferStart_ += lengths_[lengthIndex_++];
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  // Returns the next value. The returned range points into the page.
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(lengthIndex_, lengths_.size());
+    const auto length = lengths_[lengthIndex_++];
+    VELOX_DCHECK_LE(bufferStart_ + length, bufferEnd_);
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+ private:
+  std::vector<int32_t> lengths_;
+  int32_t lengthIndex_{0};
+  const char* bufferStart_;
+  const char* bufferEnd_;
+};
+
+// Decodes DELTA_BYTE_ARRAY, also known as incremental encoding: the length of
+// the prefix each value shares with the previous one, encoded with
+// DELTA_BINARY_PACKED, followed by the remaining suffixes encoded with
+// DELTA_LENGTH_BYTE_ARRAY. Each value depends on the previous one, so skipped
+// values are still reconstructed.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(const char* start, const char* end) {
+    DeltaBpDecoder prefixDecoder(start);
+    prefixLengths_.resize(prefixDecoder.totalValueCount());
+    prefixDecoder.readValues(prefixLengths_.size(), prefixLengths_.data());
+    suffixDecoder_ = std::make_unique<DeltaLengthByteArrayDecoder>(
+        prefixDecoder.bufferEnd(), end);
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  // Returns the next value. The returned range is valid until the next call.
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(valueIndex_, prefixLengths_.size());
+    const auto prefixLength = prefixLengths_[valueIndex_++];
+    VELOX_CHECK_LE(
+        prefixLength, lastValue_.size(), "Invalid DELTA_BYTE_ARRAY prefix");
+    const auto suffix = suffixDecoder_->readString();
+    lastValue_.resize(prefixLength);
+    lastValue_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(lastValue_);
+  }
+
+  std::vector<int32_t> prefixLengths_;
+  int32_t valueIndex_{0};
+  std::unique_ptr<DeltaLengthByteArrayDecoder> suffixDecoder_;
+  std::string lastValue_;
+};
+
+} // namespace facebook::velox::parquet
@@ -21,6 +21,18 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Converts the thrift 'columnChunkStats' of a column of 'type' with
+/// 'numRowsInRowGroup' rows to ColumnStatistics. Used for both column chunk
+/// and page level statistics.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -65,6 +77,27 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of both the ColumnIndex and the OffsetIndex of the
+  /// column chunk. Page-level pruning needs both.
+  bool hasPageIndex() const;
+
+  /// File offset and length of the serialized ColumnIndex. Must check for
+  /// presence using hasPageIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// File offset and length of the serialized OffsetIndex. Must check for
+  /// presence using hasPageIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
+  /// Check the presence of a bloom filter for the column chunk.
+  bool hasBloomFilter() const;
+
+  /// File offset of the bloom filter header. Must check for presence using
+  /// hasBloomFilter().
+  int64_t bloomFilterOffset() const;
+
  private:
   const void* ptr_;
 };
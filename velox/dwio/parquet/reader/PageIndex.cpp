@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Reads 'length' bytes at 'offset' of 'input' and deserializes them into
+// 'result'.
+template <typename T>
+void readThrift(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length,
+    T& result) {
+  auto stream =
+      input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  std::vector<char> copy(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, stream.get(), copy.data(), bufferStart, bufferEnd);
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      copy.data(), length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  result.read(&protocol);
+}
+
+void appendRange(RowRanges& ranges, RowRange range) {
+  if (range.begin >= range.end) {
+    return;
+  }
+  if (!ranges.empty() && ranges.back().end >= range.begin) {
+    ranges.back().end = std::max(ranges.back().end, range.end);
+    return;
+  }
+  ranges.push_back(range);
+}
+
+} // namespace
+
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right) {
+  RowRanges result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    appendRange(
+        result,
+        {std::max(left[i].begin, right[j].begin),
+         std::min(left[i].end, right[j].end)});
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+ColumnPageIndex::ColumnPageIndex(
+    std::unique_ptr<thrift::ColumnIndex> columnIndex,
+    std::unique_ptr<thrift::OffsetIndex> offsetIndex,
+    int64_t numRowsInRowGroup)
+    : columnIndex_(std::move(columnIndex)),
+      offsetIndex_(std::move(offsetIndex)),
+      numRowsInRowGroup_(numRowsInRowGroup) {}
+
+ColumnPageIndex::~ColumnPageIndex() = default;
+
+// static
+std::unique_ptr<ColumnPageIndex> ColumnPageIndex::read(
+    const ColumnChunkMetaDataPtr& columnChunk,
+    int64_t numRowsInRowGroup,
+    dwio::common::BufferedInput& input) {
+  if (!columnChunk.hasPageIndex()) {
+    return nullptr;
+  }
+  auto columnIndex = std::make_unique<thrift::ColumnIndex>();
+  readThrift(
+      input,
+      columnChunk.columnIndexOffset(),
+      columnChunk.columnIndexLength(),
+      *columnIndex);
+  auto offsetIndex = std::make_unique<thrift::OffsetIndex>();
+  readThrift(
+      input,
+      columnChunk.offsetIndexOffset(),
+      columnChunk.offsetIndexLength(),
+      *offsetIndex);
+
+  // Ignore indexes that do not describe the same pages. Such files do exist
+  // and stats-based pruning must never drop rows.
+  const auto numPages = offsetIndex->page_locations.size();
+  if (numPages == 0 || columnIndex->null_pages.size() != numPages ||
+      columnIndex->min_values.size() != numPages ||
+      columnIndex->max_values.size() != numPages ||
+      (columnIndex->__isset.null_counts &&
+       columnIndex->null_counts.size() != numPages) ||
+      offsetIndex->page_locations[0].first_row_index != 0) {
+    return nullptr;
+  }
+  return std::make_unique<ColumnPageIndex>(
+      std::move(columnIndex), std::move(offsetIndex), numRowsInRowGroup);
+}
+
+int32_t ColumnPageIndex::numPages() const {
+  return offsetIndex_->page_locations.size();
+}
+
+RowRange ColumnPageIndex::pageRows(int32_t page) const {
+  const auto& locations = offsetIndex_->page_locations;
+  VELOX_DCHECK_LT(page, locations.size());
+  const int64_t end = page + 1 < locations.size()
+      ? locations[page + 1].first_row_index
+      : numRowsInRowGroup_;
+  return {locations[page].first_row_index, end};
+}
+
+bool ColumnPageIndex::pageMatches(
+    int32_t page,
+    common::Filter* filter,
+    const TypePtr& type) const {
+  if (columnIndex_->null_pages[page]) {
+    return filter->testNull();
+  }
+  // Page statistics are encoded the same way as column chunk statistics.
+  thrift::Statistics stats;
+  stats.__set_min_value(columnIndex_->min_values[page]);
+  stats.__set_max_value(columnIndex_->max_values[page]);
+  if (columnIndex_->__isset.null_counts) {
+    stats.__set_null_count(columnIndex_->null_counts[page]);
+  }
+  const auto rows = pageRows(page);
+  const auto numRows = rows.end - rows.begin;
+  auto columnStats = buildColumnStatisticsFromThrift(stats, *type, numRows);
+  return common::testFilter(filter, columnStats.get(), numRows, type);
+}
+
+RowRanges ColumnPageIndex::matchingRows(
+    common::Filter* filter,
+    const TypePtr& type) const {
+  RowRanges ranges;
+  for (auto page = 0; page < numPages(); ++page) {
+    if (pageMatches(page, filter, type)) {
+      appendRange(ranges, pageRows(page));
+    }
+  }
+  return ranges;
+}
+
+} // namespace facebook::velox::parquet
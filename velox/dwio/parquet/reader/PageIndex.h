@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+namespace thrift {
+class ColumnIndex;
+class OffsetIndex;
+} // namespace thrift
+
+/// A half open range [begin, end) of row numbers within a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Sorted, non-overlapping row ranges of a row group.
+using RowRanges = std::vector<RowRange>;
+
+/// Returns the ranges covered by both 'left' and 'right'.
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right);
+
+/// Page-level min/max, null and location information of one column chunk,
+/// deserialized from the ColumnIndex and OffsetIndex structures the writer
+/// places after the row groups.
+class ColumnPageIndex {
+ public:
+  ColumnPageIndex(
+      std::unique_ptr<thrift::ColumnIndex> columnIndex,
+      std::unique_ptr<thrift::OffsetIndex> offsetIndex,
+      int64_t numRowsInRowGroup);
+
+  ~ColumnPageIndex();
+
+  /// Reads the page index of 'columnChunk' from 'input'. Returns nullptr if
+  /// the chunk has no page index or the index is inconsistent.
+  static std::unique_ptr<ColumnPageIndex> read(
+      const ColumnChunkMetaDataPtr& columnChunk,
+      int64_t numRowsInRowGroup,
+      dwio::common::BufferedInput& input);
+
+  int32_t numPages() const;
+
+  /// Row range covered by the 'page'th data page.
+  RowRange pageRows(int32_t page) const;
+
+  /// Returns the row ranges of the pages whose statistics do not rule out
+  /// values passing 'filter'. Adjacent ranges are merged.
+  RowRanges matchingRows(common::Filter* filter, const TypePtr& type) const;
+
+ private:
+  bool pageMatches(int32_t page, common::Filter* filter, const TypePtr& type)
+      const;
+
+  const std::unique_ptr<thrift::ColumnIndex> columnIndex_;
+  const std::unique_ptr<thrift::OffsetIndex> offsetIndex_;
+  const int64_t numRowsInRowGroup_;
+};
+
+} // namespace facebook::velox::parquet
@@ -16,9 +16,11 @@
 
 #include "velox/dwio/parquet/reader/PageReader.h"
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
 
@@ -468,15 +470,51 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   }
 }
 
-void PageReader::makeFilterCache(dwio::common::ScanState& state) {
+void PageReader::makeFilterCache(
+    dwio::common::ScanState& state,
+    const common::Filter* filter) {
   VELOX_CHECK(
       !state.dictionary2.values, "Parquet supports only one dictionary");
   state.filterCache.resize(state.dictionary.numValues);
+  state.rawState.filterCache = state.filterCache.data();
+  if (shouldPrefillFilterCache(state, filter)) {
+    // The filter is applied to each distinct string once here instead of once
+    // per dictionary index on the first hits. The decoding then only gathers
+    // from the cache and never compares strings.
+    auto* values = state.dictionary.values->as<StringView>();
+    for (auto i = 0; i < state.dictionary.numValues; ++i) {
+      state.filterCache[i] =
+          filter->testBytes(values[i].data(), values[i].size())
+          ? dwio::common::FilterResult::kSuccess
+          : dwio::common::FilterResult::kFailure;
+    }
+    return;
+  }
   simd::memset(
       state.filterCache.data(),
       dwio::common::FilterResult::kUnknown,
       state.filterCache.size());
-  state.rawState.filterCache = state.filterCache.data();
+}
+
+bool PageReader::shouldPrefillFilterCache(
+    const dwio::common::ScanState& state,
+    const common::Filter* filter) const {
+  if (!filter || !filter->isDeterministic() ||
+      type_->parquetType_ != thrift::Type::BYTE_ARRAY) {
+    return false;
+  }
+  switch (filter->kind()) {
+    case common::FilterKind::kBytesRange:
+    case common::FilterKind::kNegatedBytesRange:
+    case common::FilterKind::kBytesValues:
+    case common::FilterKind::kNegatedBytesValues:
+      break;
+    default:
+      return false;
+  }
+  // Testing every entry only pays off if the read visits at least as many
+  // indices as there are entries. Otherwise the entries are tested lazily.
+  return state.dictionary.numValues <= numVisitorRows_ - currentVisitorRow_;
 }
 
 namespace {
@@ -543,6 +581,18 @@ void PageReader::decodeRepDefs(int32_t numTopLevelRows) {
   int32_t topFound = 0;
   int32_t i = repDefBegin_;
   if (maxRepeat_ > 0) {
+    // Counts the starts of top level rows a batch of repetition levels at a
+    // time. The batch with the end of the range is scanned level by level.
+    using Batch = xsimd::batch<int16_t>;
+    for (; i + Batch::size <= numLevels; i += Batch::size) {
+      const auto starts = simd::toBitMask(
+          Batch::load_unaligned(repetitionLevels_.data() + i) == Batch(0));
+      const int32_t numStarts = __builtin_popcountll(starts);
+      if (topFound + numStarts > numTopLevelRows) {
+        break;
+      }
+      topFound += numStarts;
+    }
     for (; i < numLevels; ++i) {
       if (repetitionLevels_[i] == 0) {
         ++topFound;
@@ -614,37 +664,7 @@ void PageReader::makeDecoder() {
           pageData_ + 1, pageData_ + encodedDataSize_, pageData_[0]);
       break;
     case Encoding::PLAIN:
-      switch (parquetType) {
-        case thrift::Type::BOOLEAN:
-          booleanDecoder_ = std::make_unique<BooleanDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::BYTE_ARRAY:
-          stringDecoder_ = std::make_unique<StringDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
-          if (type_->type()->isVarbinary()) {
-            stringDecoder_ = std::make_unique<StringDecoder>(
-                pageData_, pageData_ + encodedDataSize_, type_->typeLength_);
-          } else {
-            directDecoder_ =
-                std::make_unique<dwio::common::DirectDecoder<true>>(
-                    std::make_unique<dwio::common::SeekableArrayInputStream>(
-                        pageData_, encodedDataSize_),
-                    false,
-                    type_->typeLength_,
-                    true);
-          }
-          break;
-        default: {
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              parquetTypeBytes(type_->parquetType_.value()));
-        }
-      }
+      makePlainDecoder(parquetType);
       break;
     case Encoding::DELTA_BINARY_PACKED:
       switch (parquetType) {
@@ -657,11 +677,96 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      VELOX_CHECK_EQ(
+          parquetType,
+          thrift::Type::BYTE_ARRAY,
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      VELOX_CHECK_EQ(
+          parquetType,
+          thrift::Type::BYTE_ARRAY,
+          "DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      decodeByteStreamSplit(parquetType);
+      makePlainDecoder(parquetType);
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::makePlainDecoder(thrift::Type::type parquetType) {
+  switch (parquetType) {
+    case thrift::Type::BOOLEAN:
+      booleanDecoder_ = std::make_unique<BooleanDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      stringDecoder_ = std::make_unique<StringDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      if (type_->type()->isVarbinary()) {
+        stringDecoder_ = std::make_unique<StringDecoder>(
+            pageData_, pageData_ + encodedDataSize_, type_->typeLength_);
+      } else {
+        directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                pageData_, encodedDataSize_),
+            false,
+            type_->typeLength_,
+            true);
+      }
+      break;
+    default: {
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              pageData_, encodedDataSize_),
+          false,
+          parquetTypeBytes(parquetType));
+    }
+  }
+}
+
+void PageReader::decodeByteStreamSplit(thrift::Type::type parquetType) {
+  int32_t valueSize;
+  switch (parquetType) {
+    case thrift::Type::INT32:
+    case thrift::Type::INT64:
+    case thrift::Type::FLOAT:
+    case thrift::Type::DOUBLE:
+      valueSize = parquetTypeBytes(parquetType);
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      valueSize = type_->typeLength_;
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "BYTE_STREAM_SPLIT decoder does not support Parquet type {}",
+          parquetType);
+  }
+  VELOX_CHECK_GT(valueSize, 0);
+  VELOX_CHECK_EQ(
+      encodedDataSize_ % valueSize,
+      0,
+      "BYTE_STREAM_SPLIT page size is not a multiple of the value size");
+  const auto numValues = encodedDataSize_ / valueSize;
+  // The padding allows full width loads at the end of the values.
+  dwio::common::ensureCapacity<char>(
+      byteStreamSplitBuffer_, encodedDataSize_ + simd::kPadding, &pool_);
+  auto* values = byteStreamSplitBuffer_->asMutable<char>();
+  parquet::decodeByteStreamSplit(pageData_, numValues, valueSize, values);
+  pageData_ = values;
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -683,6 +788,10 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
@@ -813,7 +922,7 @@ bool PageReader::rowsForPage(
     if (scanState.dictionary.values != dictionary_.values) {
       scanState.dictionary = dictionary_;
       if (hasFilter) {
-        makeFilterCache(scanState);
+        makeFilterCache(scanState, reader.scanSpec()->filter());
       }
       scanState.updateRawState();
     }
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -163,13 +164,32 @@ class PageReader {
   // current page.
   int32_t skipNulls(int32_t numRows);
 
-  // Initializes a filter result cache for the dictionary in 'state'.
-  void makeFilterCache(dwio::common::ScanState& state);
+  // Initializes a filter result cache for the dictionary in 'state'. If
+  // shouldPrefillFilterCache() is true, 'filter' is applied to all dictionary
+  // entries up front, otherwise the entries are marked unknown and the visitor
+  // tests them on first use.
+  void makeFilterCache(
+      dwio::common::ScanState& state,
+      const common::Filter* filter);
+
+  // Returns true if 'filter' is a deterministic string filter and the
+  // dictionary in 'state' has no more entries than the rows left to visit.
+  bool shouldPrefillFilterCache(
+      const dwio::common::ScanState& state,
+      const common::Filter* filter) const;
 
   // Makes a decoder based on 'encoding_' for bytes from ''pageData_' to
   // 'pageData_' + 'encodedDataSize_'.
   void makedecoder();
 
+  // Makes a decoder for PLAIN encoded values of 'parquetType' in 'pageData_'.
+  void makePlainDecoder(thrift::Type::type parquetType);
+
+  // Transposes the BYTE_STREAM_SPLIT encoded values of the page into
+  // 'byteStreamSplitBuffer_' and points 'pageData_' and 'encodedDataSize_' to
+  // the result, which has the PLAIN layout.
+  void decodeByteStreamSplit(thrift::Type::type parquetType);
+
   // Reads and skips pages until finding a data page that contains
   // 'row'. Reads and sets 'rowOfPage_' and 'numRowsInPage_' and
   // initializes a decoder for the found page. row kRepDefOnly means
@@ -305,6 +325,12 @@ class PageReader {
         nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor);
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -313,6 +339,10 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -489,6 +519,11 @@ class PageReader {
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
+
+  // Values of a BYTE_STREAM_SPLIT page in PLAIN layout.
+  BufferPtr byteStreamSplitBuffer_;
   // Add decoders for other encodings here.
 };
 
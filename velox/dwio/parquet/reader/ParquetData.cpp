@@ -30,8 +30,11 @@ std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
     uint64_t /*rowsPerRowGroup*/,
-    const dwio::common::StatsContext& /*writerContext*/,
+    const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
+  auto* parquetContext =
+      dynamic_cast<const ParquetStatsContext*>(&writerContext);
+  auto* bloomFilters = parquetContext ? parquetContext->bloomFilters : nullptr;
   result.totalCount =
       std::max<int>(result.totalCount, fileMetaDataPtr_.numRowGroups());
   auto nwords = bits::nwords(result.totalCount);
@@ -45,13 +48,14 @@ void ParquetData::filterRowGroups(
   }
   if (scanSpec.filter() || scanSpec.numMetadataFilters() > 0) {
     for (auto i = 0; i < fileMetaDataPtr_.numRowGroups(); ++i) {
-      if (scanSpec.filter() && !rowGroupMatches(i, scanSpec.filter())) {
+      if (scanSpec.filter() &&
+          !rowGroupMatches(i, scanSpec.filter(), bloomFilters)) {
         bits::setBit(result.filterResult.data(), i);
         continue;
       }
       for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
         auto* metadataFilter = scanSpec.metadataFilterAt(j);
-        if (!rowGroupMatches(i, metadataFilter)) {
+        if (!rowGroupMatches(i, metadataFilter, nullptr)) {
           bits::setBit(
               result.metadataFilterResults[metadataFiltersStartIndex + j]
                   .second.data(),
@@ -62,7 +66,10 @@ void ParquetData::filterRowGroups(
   }
 }
 
-bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
+bool ParquetData::rowGroupMatches(
+    uint32_t rowGroupId,
+    common::Filter* filter,
+    BloomFilterReader* bloomFilters) {
   auto column = type_->column();
   auto type = type_->type();
   auto rowGroup = fileMetaDataPtr_.rowGroup(rowGroupId);
@@ -76,11 +83,109 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   if (columnChunk.hasStatistics()) {
     auto columnStats =
         columnChunk.getColumnStatistics(type, rowGroup.numRows());
-    return testFilter(filter, columnStats.get(), rowGroup.numRows(), type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.numRows(), type)) {
+      return false;
+    }
+  }
+  if (bloomFilters && columnChunk.hasBloomFilter() && !filter->testNull()) {
+    if (auto* bloomFilter = bloomFilters->bloomFilter(rowGroupId, column)) {
+      return bloomFilterMatches(*bloomFilter, filter);
+    }
   }
   return true;
 }
 
+namespace {
+
+// Above this many values an IN list is unlikely to be ruled out and testing
+// each value costs more than reading the row group.
+constexpr size_t kMaxBloomFilterProbes = 1'000;
+
+template <typename T>
+bool mayContainAny(
+    const SplitBlockBloomFilter& bloomFilter,
+    const std::vector<int64_t>& values) {
+  for (auto value : values) {
+    if (bloomFilter.mayContain(
+            SplitBlockBloomFilter::hash(static_cast<T>(value)))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+bool ParquetData::bloomFilterMatches(
+    const SplitBlockBloomFilter& bloomFilter,
+    common::Filter* filter) const {
+  if (!type_->parquetType_.has_value() || type_->type()->isDecimal()) {
+    return true;
+  }
+  const auto physicalType = type_->parquetType_.value();
+
+  std::vector<int64_t> bigintValues;
+  switch (filter->kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = static_cast<const common::BigintRange*>(filter);
+      if (!range->isSingleValue()) {
+        return true;
+      }
+      bigintValues.push_back(range->lower());
+      break;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      bigintValues =
+          static_cast<const common::BigintValuesUsingHashTable*>(filter)
+              ->values();
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      bigintValues =
+          static_cast<const common::BigintValuesUsingBitmask*>(filter)
+              ->values();
+      break;
+    case common::FilterKind::kBytesValues: {
+      if (physicalType != thrift::Type::BYTE_ARRAY) {
+        return true;
+      }
+      const auto& values =
+          static_cast<const common::BytesValues*>(filter)->values();
+      if (values.size() > kMaxBloomFilterProbes) {
+        return true;
+      }
+      for (const auto& value : values) {
+        if (bloomFilter.mayContain(SplitBlockBloomFilter::hash(value))) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case common::FilterKind::kBytesRange: {
+      auto* range = static_cast<const common::BytesRange*>(filter);
+      if (physicalType != thrift::Type::BYTE_ARRAY || !range->isSingleValue()) {
+        return true;
+      }
+      return bloomFilter.mayContain(SplitBlockBloomFilter::hash(
+          std::string_view(range->lower())));
+    }
+    default:
+      return true;
+  }
+
+  if (bigintValues.size() > kMaxBloomFilterProbes) {
+    return true;
+  }
+  // Values are hashed in the plain encoding of the physical type.
+  switch (physicalType) {
+    case thrift::Type::INT32:
+      return mayContainAny<int32_t>(bloomFilter, bigintValues);
+    case thrift::Type::INT64:
+      return mayContainAny<int64_t>(bloomFilter, bigintValues);
+    default:
+      return true;
+  }
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -122,6 +227,20 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
   return dwio::common::PositionProvider(empty);
 }
 
+std::optional<RowRanges> ParquetData::filterPages(
+    uint32_t index,
+    common::Filter* filter,
+    dwio::common::BufferedInput& input) const {
+  VELOX_CHECK_NOT_NULL(filter);
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto pageIndex = ColumnPageIndex::read(
+      rowGroup.columnChunk(type_->column()), rowGroup.numRows(), input);
+  if (!pageIndex) {
+    return std::nullopt;
+  }
+  return pageIndex->matchingRows(filter, type_->type());
+}
+
 std::pair<int64_t, int64_t> ParquetData::getRowGroupRegion(
     uint32_t index) const {
   auto rowGroup = fileMetaDataPtr_.rowGroup(index);
@@ -18,7 +18,9 @@
 
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
 
 namespace facebook::velox::common {
 class ScanSpec;
@@ -30,6 +32,16 @@ class BufferedInput;
 
 namespace facebook::velox::parquet {
 
+/// Context for filtering the row groups of a file.
+struct ParquetStatsContext : dwio::common::StatsContext {
+  explicit ParquetStatsContext(BloomFilterReader* bloomFilters = nullptr)
+      : bloomFilters(bloomFilters) {}
+
+  /// Source of column chunk bloom filters for point filters. nullptr disables
+  /// bloom filter pruning.
+  BloomFilterReader* const bloomFilters;
+};
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
@@ -192,10 +204,28 @@ class ParquetData : public dwio::common::FormatData {
   // Returns the <offset, length> of the row group.
   std::pair<int64_t, int64_t> getRowGroupRegion(uint32_t index) const;
 
+  /// Returns the rows of row group 'index' that may pass 'filter' according
+  /// to the page index of the column chunk. Returns std::nullopt if the chunk
+  /// has no usable page index. Reads the index from 'input'.
+  std::optional<RowRanges> filterPages(
+      uint32_t index,
+      common::Filter* filter,
+      dwio::common::BufferedInput& input) const;
+
  private:
   /// True if 'filter' may have hits for the column of 'this' according to the
-  /// stats in 'rowGroup'.
-  bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
+  /// stats in 'rowGroup'. Point filters are also checked against the bloom
+  /// filter of the column chunk if 'bloomFilters' is set.
+  bool rowGroupMatches(
+      uint32_t rowGroupId,
+      common::Filter* filter,
+      BloomFilterReader* bloomFilters);
+
+  /// False if 'filter' only accepts specific non-null values and none of these
+  /// is in 'bloomFilter'.
+  bool bloomFilterMatches(
+      const SplitBlockBloomFilter& bloomFilter,
+      common::Filter* filter) const;
 
  protected:
   memory::MemoryPool& pool_;
@@ -19,12 +19,25 @@
 #include <boost/algorithm/string.hpp>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+// Returns the file offset that decides which split reads 'rowGroup'.
+int64_t rowGroupOffset(const thrift::RowGroup& rowGroup) {
+  VELOX_CHECK_GT(rowGroup.columns.size(), 0);
+  return rowGroup.__isset.file_offset ? rowGroup.file_offset
+      : rowGroup.columns[0].meta_data.__isset.dictionary_page_offset
+      ? rowGroup.columns[0].meta_data.dictionary_page_offset
+      : rowGroup.columns[0].meta_data.data_page_offset;
+}
+} // namespace
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -88,6 +101,14 @@ class ReaderBase {
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
  private:
+  // The parsed footer of a file. Shared with the other readers of the file
+  // through the FileMetadataCache.
+  struct FileTail {
+    std::shared_ptr<const thrift::FileMetaData> fileMetaData;
+    // Size of the serialized footer.
+    uint64_t bytes;
+  };
+
   // Reads and parses file footer.
   void loadFileMetaData();
 
@@ -115,7 +136,9 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Shared with the other readers of the file if the FileMetadataCache is
+  // used.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -145,6 +168,22 @@ ReaderBase::ReaderBase(
 void ReaderBase::loadFileMetaData() {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
+  const auto& cacheKey = options_.fileMetadataCacheKey();
+  auto* metadataCache = cacheKey.empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::getInstance();
+  if (metadataCache != nullptr) {
+    if (auto tail = metadataCache->get<FileTail>(cacheKey)) {
+      fileMetaData_ = tail->fileMetaData;
+      if (options_.ioStatistics() != nullptr) {
+        options_.ioStatistics()->metadataCacheHit().increment(tail->bytes);
+      }
+      if (preloadFile) {
+        input_->loadCompleteFile();
+      }
+      return;
+    }
+  }
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
 
   std::unique_ptr<dwio::common::SeekableInputStream> stream;
@@ -189,8 +228,18 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
+  if (metadataCache != nullptr) {
+    metadataCache->put<FileTail>(
+        cacheKey,
+        std::make_shared<const FileTail>(FileTail{fileMetaData_, footerLength}),
+        footerLength);
+    if (options_.ioStatistics() != nullptr) {
+      options_.ioStatistics()->metadataCacheMiss().increment(footerLength);
+    }
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -693,11 +742,23 @@ void ReaderBase::scheduleRowGroups(
   auto numRowGroupsToLoad = std::min(
       options_.prefetchRowGroups() + 1,
       static_cast<int64_t>(rowGroupIds.size() - currentGroup));
+  const auto maxBytesAhead = options_.unitPrefetchBytes();
+  uint64_t bytesAhead = 0;
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
+    if (i > 1 && maxBytesAhead > 0 && bytesAhead >= maxBytesAhead) {
+      // The row groups being prefetched already take the budget.
+      break;
+    }
     if (!inputs_[thisGroup]) {
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
     }
+    if (i > 0) {
+      const auto& rowGroup = fileMetaData_->row_groups[thisGroup];
+      bytesAhead += rowGroup.__isset.total_compressed_size
+          ? rowGroup.total_compressed_size
+          : rowGroup.total_byte_size;
+    }
   }
 
   if (currentGroup >= 1) {
@@ -727,10 +788,6 @@ bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return inputs_.count(rowGroupIndex) != 0;
 }
 
-namespace {
-struct ParquetStatsContext : dwio::common::StatsContext {};
-} // namespace
-
 class ParquetRowReader::Impl {
  public:
   Impl(
@@ -788,43 +845,110 @@ class ParquetRowReader::Impl {
     rowGroupIds_.reserve(rowGroups_.size());
     firstRowOfRowGroup_.reserve(rowGroups_.size());
 
+    std::vector<bool> rowGroupsInRange(rowGroups_.size());
+    for (auto i = 0; i < rowGroups_.size(); i++) {
+      const auto fileOffset = rowGroupOffset(rowGroups_[i]);
+      VELOX_CHECK_GT(fileOffset, 0);
+      rowGroupsInRange[i] =
+          (fileOffset >= options_.getOffset() &&
+           fileOffset < options_.getLimit());
+    }
+
     ParquetData::FilterRowGroupsResult res;
-    columnReader_->filterRowGroups(0, ParquetStatsContext(), res);
+    BloomFilterReader bloomFilters(
+        readerBase_->fileMetaData(),
+        readerBase_->bufferedInput(),
+        readerBase_->fileLength(),
+        rowGroupsInRange);
+    columnReader_->filterRowGroups(0, ParquetStatsContext(&bloomFilters), res);
     if (auto& metadataFilter = options_.getMetadataFilter()) {
       metadataFilter->eval(res.metadataFilterResults, res.filterResult);
     }
 
     uint64_t rowNumber = 0;
     for (auto i = 0; i < rowGroups_.size(); i++) {
-      VELOX_CHECK_GT(rowGroups_[i].columns.size(), 0);
-      auto fileOffset = rowGroups_[i].__isset.file_offset
-          ? rowGroups_[i].file_offset
-          : rowGroups_[i].columns[0].meta_data.__isset.dictionary_page_offset
-          ? rowGroups_[i].columns[0].meta_data.dictionary_page_offset
-          : rowGroups_[i].columns[0].meta_data.data_page_offset;
-      VELOX_CHECK_GT(fileOffset, 0);
-      auto rowGroupInRange =
-          (fileOffset >= options_.getOffset() &&
-           fileOffset < options_.getLimit());
-
       auto isExcluded =
           (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i));
       auto isEmpty = rowGroups_[i].num_rows == 0;
 
       // Add a row group to read if it is within range and not empty and not in
       // the excluded list.
-      if (rowGroupInRange && !isExcluded && !isEmpty) {
+      if (rowGroupsInRange[i] && !isExcluded && !isEmpty) {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
       }
       rowNumber += rowGroups_[i].num_rows;
     }
+    filterPages();
+  }
+
+  // Computes the rows of each selected row group that may pass the filters
+  // according to the page indexes of the filtered columns. Row groups where
+  // no page matches are dropped.
+  void filterPages() {
+    matchingRows_.clear();
+    matchingRows_.resize(rowGroupIds_.size());
+    std::vector<const dwio::common::SelectiveColumnReader*> filteredColumns;
+    for (auto* child : columnReader_->children()) {
+      if (!child) {
+        continue;
+      }
+      // Skipping in nested readers depends on repdefs of all pages, so
+      // only prune when all projected columns are flat.
+      if (!child->fileType().type()->isPrimitiveType()) {
+        return;
+      }
+      if (child->scanSpec()->filter()) {
+        filteredColumns.push_back(child);
+      }
+    }
+    if (filteredColumns.empty()) {
+      return;
+    }
+
+    auto& input = readerBase_->bufferedInput();
+    int32_t numKept = 0;
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      std::optional<RowRanges> ranges;
+      for (auto* column : filteredColumns) {
+        auto columnRanges =
+            column->formatData().as<ParquetData>().filterPages(
+                rowGroupIds_[i], column->scanSpec()->filter(), input);
+        if (!columnRanges.has_value()) {
+          continue;
+        }
+        if (ranges.has_value()) {
+          ranges = intersectRowRanges(ranges.value(), columnRanges.value());
+        } else {
+          ranges = std::move(columnRanges);
+        }
+      }
+      const auto numRows = rowGroups_[rowGroupIds_[i]].num_rows;
+      if (ranges.has_value() && ranges->empty()) {
+        continue;
+      }
+      rowGroupIds_[numKept] = rowGroupIds_[i];
+      firstRowOfRowGroup_[numKept] = firstRowOfRowGroup_[i];
+      if (ranges.has_value() &&
+          !(ranges->size() == 1 && ranges->front() == RowRange{0, numRows})) {
+        matchingRows_[numKept] = std::move(ranges);
+      }
+      ++numKept;
+    }
+    rowGroupIds_.resize(numKept);
+    firstRowOfRowGroup_.resize(numKept);
+    matchingRows_.resize(numKept);
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      if (skipToMatchingRows()) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -834,7 +958,11 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    uint64_t end = rowsInCurrentRowGroup_;
+    if (const auto& ranges = matchingRows_[nextRowGroupIdsIdx_ - 1]) {
+      end = (*ranges)[nextRangeIdx_].end;
+    }
+    return std::min(size, end - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -872,6 +1000,7 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.skippedPageRows += skippedPageRows_;
   }
 
   void resetFilterCaches() {
@@ -897,10 +1026,37 @@ class ParquetRowReader::Impl {
     rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
+    nextRangeIdx_ = 0;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
     return true;
   }
 
+  // Moves past the rows of the current row group that the page indexes rule
+  // out. The skipped pages are not decompressed or decoded. Returns false if
+  // no matching rows remain in the row group.
+  bool skipToMatchingRows() {
+    const auto& ranges = matchingRows_[nextRowGroupIdsIdx_ - 1];
+    if (!ranges.has_value()) {
+      return true;
+    }
+    while (nextRangeIdx_ < ranges->size() &&
+           (*ranges)[nextRangeIdx_].end <= currentRowInGroup_) {
+      ++nextRangeIdx_;
+    }
+    if (nextRangeIdx_ == ranges->size()) {
+      skippedPageRows_ += rowsInCurrentRowGroup_ - currentRowInGroup_;
+      currentRowInGroup_ = rowsInCurrentRowGroup_;
+      return false;
+    }
+    const uint64_t begin = (*ranges)[nextRangeIdx_].begin;
+    if (begin > currentRowInGroup_) {
+      columnReader_->seekTo(begin, false);
+      skippedPageRows_ += begin - currentRowInGroup_;
+      currentRowInGroup_ = begin;
+    }
+    return true;
+  }
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -915,6 +1071,15 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Rows that may pass the filters according to the page indexes, parallel to
+  // 'rowGroupIds_'. std::nullopt means all rows of the row group are read.
+  std::vector<std::optional<RowRanges>> matchingRows_;
+  // Index of the first range in 'matchingRows_' of the current row group that
+  // ends after 'currentRowInGroup_'.
+  size_t nextRangeIdx_{0};
+  // Number of rows skipped inside row groups based on page indexes.
+  int64_t skippedPageRows_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   TypePtr requestedType_;
@@ -982,6 +1147,57 @@ ParquetReader::typeWithId() const {
   return readerBase_->schemaWithId();
 }
 
+std::optional<std::vector<dwio::common::Reader::UnitStatistics>>
+ParquetReader::unitStatistics(
+    uint64_t offset,
+    uint64_t length,
+    const std::vector<std::string>& columns) const {
+  const auto& schema = readerBase_->schema();
+  const auto& schemaWithId = readerBase_->schemaWithId();
+  // The leaf columns of 'columns' or nullptr for missing and nested columns.
+  std::vector<const ParquetTypeWithId*> leaves(columns.size(), nullptr);
+  for (auto i = 0; i < columns.size(); ++i) {
+    const auto index = schema->getChildIdxIfExists(columns[i]);
+    if (!index.has_value()) {
+      continue;
+    }
+    const auto* type = static_cast<const ParquetTypeWithId*>(
+        schemaWithId->childAt(index.value()).get());
+    if (type->isLeaf()) {
+      leaves[i] = type;
+    }
+  }
+
+  const auto limit = std::numeric_limits<uint64_t>::max() - offset > length
+      ? offset + length
+      : std::numeric_limits<uint64_t>::max();
+  const auto& rowGroups = readerBase_->thriftFileMetaData().row_groups;
+  const auto fileMetaData = readerBase_->fileMetaData();
+  std::vector<UnitStatistics> units;
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    // Same range check as in ParquetRowReader.
+    const uint64_t fileOffset = rowGroupOffset(rowGroups[i]);
+    if (fileOffset < offset || fileOffset >= limit) {
+      continue;
+    }
+    const auto rowGroup = fileMetaData.rowGroup(i);
+    auto& unit = units.emplace_back();
+    unit.numRows = rowGroup.numRows();
+    unit.columns.resize(columns.size());
+    for (auto j = 0; j < columns.size(); ++j) {
+      if (leaves[j] == nullptr) {
+        continue;
+      }
+      auto columnChunk = rowGroup.columnChunk(leaves[j]->column());
+      if (columnChunk.hasStatistics()) {
+        unit.columns[j] =
+            columnChunk.getColumnStatistics(leaves[j]->type(), unit.numRows);
+      }
+    }
+  }
+  return units;
+}
+
 std::unique_ptr<dwio::common::RowReader> ParquetReader::createRowReader(
     const dwio::common::RowReaderOptions& options) const {
   return std::make_unique<ParquetRowReader>(readerBase_, options);
@@ -95,6 +95,11 @@ class ParquetReader : public dwio::common::Reader {
     return nullptr;
   }
 
+  std::optional<std::vector<UnitStatistics>> unitStatistics(
+      uint64_t offset,
+      uint64_t length,
+      const std::vector<std::string>& columns) const override;
+
   const velox::RowTypePtr& rowType() const override;
 
   const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// Upper bound for the size of a bloom filter header.
+constexpr int64_t kMaxHeaderSize = 64;
+
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(std::vector<uint32_t> blocks)
+    : blocks_(std::move(blocks)),
+      numBlocks_(blocks_.size() * sizeof(uint32_t) / kBytesPerBlock) {
+  VELOX_CHECK_GT(numBlocks_, 0);
+  VELOX_CHECK_EQ(blocks_.size() * sizeof(uint32_t), numBlocks_ * kBytesPerBlock);
+}
+
+// static
+std::unique_ptr<SplitBlockBloomFilter> SplitBlockBloomFilter::deserialize(
+    const char* data,
+    int64_t size) {
+  thrift::BloomFilterHeader header;
+  uint32_t headerSize;
+  try {
+    auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+        data, std::min(size, kMaxHeaderSize));
+    apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+        protocol(transport);
+    headerSize = header.read(&protocol);
+  } catch (const std::exception&) {
+    // A truncated or corrupt header only disables pruning for this filter.
+    return nullptr;
+  }
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes > kMaxBytes || header.numBytes % kBytesPerBlock != 0 ||
+      headerSize + header.numBytes > size) {
+    return nullptr;
+  }
+  std::vector<uint32_t> blocks(header.numBytes / sizeof(uint32_t));
+  std::memcpy(blocks.data(), data + headerSize, header.numBytes);
+  return std::make_unique<SplitBlockBloomFilter>(std::move(blocks));
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(const void* data, int32_t size) {
+  return XXH64(data, size, 0);
+}
+
+bool SplitBlockBloomFilter::mayContain(uint64_t hash) const {
+  const auto blockIndex = ((hash >> 32) * numBlocks_) >> 32;
+  const auto key = static_cast<uint32_t>(hash);
+  const auto* block = blocks_.data() + blockIndex * 8;
+  for (auto i = 0; i < 8; ++i) {
+    const uint32_t mask = 1U << ((key * kSalt[i]) >> 27);
+    if ((block[i] & mask) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+BloomFilterReader::BloomFilterReader(
+    FileMetaDataPtr fileMetaData,
+    dwio::common::BufferedInput& input,
+    uint64_t fileLength,
+    std::vector<bool> rowGroupsToLoad)
+    : fileMetaData_(fileMetaData),
+      input_(input),
+      fileLength_(fileLength),
+      rowGroupsToLoad_(std::move(rowGroupsToLoad)) {
+  VELOX_CHECK_EQ(rowGroupsToLoad_.size(), fileMetaData_.numRowGroups());
+}
+
+const std::vector<int64_t>& BloomFilterReader::boundaries() {
+  if (!boundaries_.empty()) {
+    return boundaries_;
+  }
+  for (auto i = 0; i < fileMetaData_.numRowGroups(); ++i) {
+    auto rowGroup = fileMetaData_.rowGroup(i);
+    for (auto j = 0; j < rowGroup.numColumns(); ++j) {
+      auto chunk = rowGroup.columnChunk(j);
+      if (!chunk.hasMetadata()) {
+        continue;
+      }
+      boundaries_.push_back(chunk.dataPageOffset());
+      if (chunk.hasDictionaryPageOffset()) {
+        boundaries_.push_back(chunk.dictionaryPageOffset());
+      }
+      if (chunk.hasPageIndex()) {
+        boundaries_.push_back(chunk.columnIndexOffset());
+        boundaries_.push_back(chunk.offsetIndexOffset());
+      }
+      if (chunk.hasBloomFilter()) {
+        boundaries_.push_back(chunk.bloomFilterOffset());
+      }
+    }
+  }
+  // Bloom filters are written before the footer, which ends with the footer
+  // length and the magic bytes.
+  boundaries_.push_back(fileLength_ - 8);
+  std::sort(boundaries_.begin(), boundaries_.end());
+  return boundaries_;
+}
+
+void BloomFilterReader::loadColumn(uint32_t column) {
+  const auto numRowGroups = fileMetaData_.numRowGroups();
+  auto& filters = columns_[column];
+  filters.resize(numRowGroups);
+
+  const auto& ends = boundaries();
+  std::unique_ptr<dwio::common::BufferedInput> newInput;
+  std::vector<std::pair<uint32_t, common::Region>> regions;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams;
+  for (auto i = 0; i < numRowGroups; ++i) {
+    if (!rowGroupsToLoad_[i]) {
+      continue;
+    }
+    auto chunk = fileMetaData_.rowGroup(i).columnChunk(column);
+    if (!chunk.hasBloomFilter()) {
+      continue;
+    }
+    const auto offset = chunk.bloomFilterOffset();
+    auto end = std::upper_bound(ends.begin(), ends.end(), offset);
+    if (end == ends.end()) {
+      continue;
+    }
+    const auto length = std::min<int64_t>(
+        *end - offset, SplitBlockBloomFilter::kMaxBytes + kMaxHeaderSize);
+    common::Region region{static_cast<uint64_t>(offset), uint64_t(length)};
+    regions.emplace_back(i, region);
+    if (input_.isBuffered(region.offset, region.length)) {
+      streams.push_back(input_.read(
+          region.offset, region.length, dwio::common::LogType::FOOTER));
+    } else {
+      if (!newInput) {
+        newInput = input_.clone();
+      }
+      streams.push_back(newInput->enqueue(region));
+    }
+  }
+  if (newInput) {
+    newInput->load(dwio::common::LogType::FOOTER);
+  }
+
+  std::vector<char> buffer;
+  for (auto i = 0; i < regions.size(); ++i) {
+    const auto& [rowGroup, region] = regions[i];
+    buffer.resize(region.length);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        region.length, streams[i].get(), buffer.data(), bufferStart, bufferEnd);
+    filters[rowGroup] =
+        SplitBlockBloomFilter::deserialize(buffer.data(), region.length);
+  }
+}
+
+const SplitBlockBloomFilter* BloomFilterReader::bloomFilter(
+    uint32_t rowGroup,
+    uint32_t column) {
+  auto it = columns_.find(column);
+  if (it == columns_.end()) {
+    loadColumn(column);
+    it = columns_.find(column);
+  }
+  VELOX_CHECK_LT(rowGroup, it->second.size());
+  return it->second[rowGroup].get();
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+
+namespace facebook::velox::parquet {
+
+/// Reader side of the Parquet split block bloom filter. The filter consists of
+/// 256 bit blocks of eight 32 bit words. A value is hashed with XXH64 over its
+/// plain encoding; the upper 32 bits of the hash select the block and the lower
+/// 32 bits, multiplied by eight salts, select one bit in each word. See
+/// https://github.com/apache/parquet-format/blob/master/BloomFilter.md.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// Files can declare arbitrary sizes. Larger filters are ignored.
+  static constexpr int32_t kMaxBytes = 128 << 20;
+
+  /// 'blocks' is the bitset as stored in the file. Its size must be a
+  /// multiple of kBytesPerBlock.
+  explicit SplitBlockBloomFilter(std::vector<uint32_t> blocks);
+
+  /// Deserializes the filter header and bitset from the first 'size' bytes of
+  /// 'data'. Returns nullptr if the filter uses an algorithm, hash or
+  /// compression other than the ones defined by the specification or if the
+  /// bitset does not fit in 'size'.
+  static std::unique_ptr<SplitBlockBloomFilter> deserialize(
+      const char* data,
+      int64_t size);
+
+  /// Returns the hash of a value with plain encoding 'data'.
+  static uint64_t hash(const void* data, int32_t size);
+
+  template <typename T>
+  static uint64_t hash(T value) {
+    static_assert(std::is_arithmetic_v<T>);
+    return hash(&value, sizeof(T));
+  }
+
+  static uint64_t hash(std::string_view value) {
+    return hash(value.data(), value.size());
+  }
+
+  /// Returns false if the value with 'hash' was definitely not inserted.
+  bool mayContain(uint64_t hash) const;
+
+  int32_t numBlocks() const {
+    return numBlocks_;
+  }
+
+ private:
+  const std::vector<uint32_t> blocks_;
+  const int32_t numBlocks_;
+};
+
+/// Loads and keeps the bloom filters of the column chunks of a file. The
+/// filters of a column are fetched for all row groups in one coalesced load on
+/// first access. The load goes through 'input' so that the filters are served
+/// from an already loaded file or footer tail or from AsyncDataCache when the
+/// input is cache backed.
+class BloomFilterReader {
+ public:
+  /// Only filters of row groups set in 'rowGroupsToLoad' are fetched.
+  BloomFilterReader(
+      FileMetaDataPtr fileMetaData,
+      dwio::common::BufferedInput& input,
+      uint64_t fileLength,
+      std::vector<bool> rowGroupsToLoad);
+
+  /// Returns the filter of 'column' in 'rowGroup' or nullptr if the column
+  /// chunk has none, it cannot be used or the row group is not loaded.
+  const SplitBlockBloomFilter* bloomFilter(uint32_t rowGroup, uint32_t column);
+
+ private:
+  // Returns the file offsets that may follow a bloom filter, sorted.
+  const std::vector<int64_t>& boundaries();
+
+  void loadColumn(uint32_t column);
+
+  const FileMetaDataPtr fileMetaData_;
+  dwio::common::BufferedInput& input_;
+  const uint64_t fileLength_;
+  const std::vector<bool> rowGroupsToLoad_;
+
+  // Start offsets of all column chunk data, indexes and bloom filters in the
+  // file. The end of a bloom filter is bounded by the next one of these.
+  std::vector<int64_t> boundaries_;
+
+  // Filters of loaded columns, indexed by row group. nullptr for row groups
+  // without a usable filter.
+  folly::F14FastMap<
+      uint32_t,
+      std::vector<std::unique_ptr<SplitBlockBloomFilter>>>
+      columns_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/init/Init.h>
+#include <vector>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#include "velox/dwio/parquet/RegisterParquetWriter.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class ParquetTpcdsTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    memory::MemoryManager::testingSetInstance({});
+
+    duckDb_ = std::make_shared<DuckDbQueryRunner>();
+    tempDirectory_ = TempDirectoryPath::create();
+    tpcdsBuilder_ =
+        std::make_shared<TpcdsQueryBuilder>(dwio::common::FileFormat::PARQUET);
+
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+
+    parse::registerTypeResolver();
+    filesystems::registerLocalFileSystem();
+
+    parquet::registerParquetReaderFactory();
+    parquet::registerParquetWriterFactory();
+
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(hiveConnector);
+
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+
+    saveTpcdsTablesAsParquet();
+    tpcdsBuilder_->initialize(tempDirectory_->getPath());
+  }
+
+  static void TearDownTestSuite() {
+    connector::unregisterConnector(kHiveConnectorId);
+    connector::unregisterConnector(kTpcdsConnectorId);
+    parquet::unregisterParquetReaderFactory();
+    parquet::unregisterParquetWriterFactory();
+  }
+
+  static void saveTpcdsTablesAsParquet() {
+    std::shared_ptr<memory::MemoryPool> rootPool{
+        memory::memoryManager()->addRootPool()};
+    std::shared_ptr<memory::MemoryPool> pool{rootPool->addLeafChild("leaf")};
+
+    for (const auto& table : tpcds::tables) {
+      auto tableName = tpcds::toTableName(table);
+      auto tableDirectory =
+          fmt::format("{}/{}", tempDirectory_->getPath(), tableName);
+      auto tableSchema = tpcds::getTableSchema(table);
+      auto columnNames = tableSchema->names();
+      auto plan = PlanBuilder()
+                      .tpcdsTableScan(table, std::move(columnNames), 0.01)
+                      .planNode();
+      auto split =
+          exec::Split(std::make_shared<connector::tpcds::TpcdsConnectorSplit>(
+              kTpcdsConnectorId, 1, 0));
+
+      auto rows =
+          AssertQueryBuilder(plan).splits({split}).copyResults(pool.get());
+      duckDb_->createTable(tableName.data(), {rows});
+
+      plan = PlanBuilder()
+                 .values({rows})
+                 .tableWrite(tableDirectory, dwio::common::FileFormat::PARQUET)
+                 .planNode();
+
+      AssertQueryBuilder(plan).copyResults(pool.get());
+    }
+  }
+
+  void assertQuery(
+      int queryId,
+      const std::optional<std::vector<uint32_t>>& sortingKeys = {}) {
+    auto queryPlan = tpcdsBuilder_->getQueryPlan(queryId);
+    auto duckDbSql = tpcds::getQuery(queryId);
+    assertQuery(queryPlan, duckDbSql, sortingKeys);
+  }
+
+  std::shared_ptr<Task> assertQuery(
+      const TpchPlan& queryPlan,
+      const std::string& duckQuery,
+      const std::optional<std::vector<uint32_t>>& sortingKeys) const {
+    bool noMoreSplits = false;
+    constexpr int kNumSplits = 10;
+    constexpr int kNumDrivers = 4;
+    auto addSplits = [&](Task* task) {
+      if (!noMoreSplits) {
+        for (const auto& entry : queryPlan.dataFiles) {
+          for (const auto& path : entry.second) {
+            auto const splits = HiveConnectorTestBase::makeHiveConnectorSplits(
+                path, kNumSplits, queryPlan.dataFileFormat);
+            for (const auto& split : splits) {
+              task->addSplit(entry.first, Split(split));
+            }
+          }
+          task->noMoreSplits(entry.first);
+        }
+      }
+      noMoreSplits = true;
+    };
+    CursorParameters params;
+    params.maxDrivers = kNumDrivers;
+    params.planNode = queryPlan.plan;
+    return exec::test::assertQuery(
+        params, addSplits, duckQuery, *duckDb_, sortingKeys);
+  }
+
+  static std::shared_ptr<DuckDbQueryRunner> duckDb_;
+  static std::shared_ptr<TempDirectoryPath> tempDirectory_;
+  static std::shared_ptr<TpcdsQueryBuilder> tpcdsBuilder_;
+
+  static constexpr char const* kTpcdsConnectorId{"test-tpcds"};
+};
+
+std::shared_ptr<DuckDbQueryRunner> ParquetTpcdsTest::duckDb_ = nullptr;
+std::shared_ptr<TempDirectoryPath> ParquetTpcdsTest::tempDirectory_ = nullptr;
+std::shared_ptr<TpcdsQueryBuilder> ParquetTpcdsTest::tpcdsBuilder_ = nullptr;
+
+TEST_F(ParquetTpcdsTest, Q3) {
+  std::vector<uint32_t> sortingKeys{0, 3};
+  assertQuery(3, std::move(sortingKeys));
+}
+
+TEST_F(ParquetTpcdsTest, Q19) {
+  std::vector<uint32_t> sortingKeys{4};
+  assertQuery(19, std::move(sortingKeys));
+}
+
+TEST_F(ParquetTpcdsTest, Q27) {
+  std::vector<uint32_t> sortingKeys{0};
+  assertQuery(27, std::move(sortingKeys));
+}
+
+TEST_F(ParquetTpcdsTest, Q55) {
+  std::vector<uint32_t> sortingKeys{2};
+  assertQuery(55, std::move(sortingKeys));
+}
+
+TEST_F(ParquetTpcdsTest, Q98) {
+  std::vector<uint32_t> sortingKeys{2, 3, 0};
+  assertQuery(98, std::move(sortingKeys));
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::Init init{&argc, &argv, false};
+  return RUN_ALL_TESTS();
+}
@@ -131,6 +131,28 @@ TEST_F(E2EFilterTest, integerDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 4 * 1024;
+
+  // Ascending values give each page a narrow min/max range so that range
+  // filters can prune pages inside the row groups.
+  testWithTypes(
+      "long_val:bigint,"
+      "int_val:int",
+      [&]() {
+        for (auto i = 0; i < batchCount_; ++i) {
+          std::vector<int64_t> values(batchSize_);
+          std::iota(values.begin(), values.end(), i * batchSize_);
+          useSuppliedValues<int64_t>("long_val", i, values);
+        }
+      },
+      false,
+      {"long_val", "int_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, integerDeltaBinaryPack) {
   options_.enableDictionary = false;
   options_.encoding =
@@ -277,6 +299,28 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::BYTE_STREAM_SPLIT;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      true,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -449,6 +493,42 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaLengthByteArray) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringDistribution("string_val_2", 170, false, true);
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, stringDeltaByteArray) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BYTE_ARRAY;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringDistribution("string_val_2", 170, false, true);
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -464,6 +544,89 @@ TEST_F(E2EFilterTest, stringDictionary) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDictionaryFilterCache) {
+  // A dictionary with no more entries than the rows of a read has the filter
+  // results of all entries computed when it is loaded. Reads of fewer rows
+  // test the entries on first use. Both must select the same rows.
+  constexpr int32_t kNumRows = 20'000;
+  constexpr int32_t kNumDistinct = 500;
+  const std::vector<std::string> filterValues = {
+      "dictionary value 1",
+      "dictionary value 17",
+      "dictionary value 499",
+      "not in the data"};
+  std::vector<std::unique_ptr<Filter>> filters;
+  filters.push_back(std::make_unique<BytesValues>(filterValues, false));
+  filters.push_back(std::make_unique<BytesValues>(filterValues, true));
+  filters.push_back(std::make_unique<NegatedBytesValues>(filterValues, false));
+  filters.push_back(std::make_unique<NegatedBytesValues>(filterValues, true));
+
+  rowType_ = ROW({"c0"}, {VARCHAR()});
+  const auto read = [&](const Filter& filter, int32_t readSize) {
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->childByName("c0")->setFilter(filter.clone());
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(sinkData_),
+        readerOpts.memoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    dwio::common::RowReaderOptions rowReaderOpts;
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    std::vector<std::optional<std::string>> result;
+    auto batch = BaseVector::create(rowType_, 0, leafPool_.get());
+    while (rowReader->next(readSize, batch) > 0) {
+      auto* values = batch->as<RowVector>()
+                         ->childAt(0)
+                         ->loadedVector()
+                         ->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < batch->size(); ++i) {
+        if (values->isNullAt(i)) {
+          result.push_back(std::nullopt);
+        } else {
+          result.push_back(values->valueAt(i).str());
+        }
+      }
+    }
+    return result;
+  };
+
+  for (const bool withNulls : {false, true}) {
+    SCOPED_TRACE(fmt::format("withNulls {}", withNulls));
+    auto data = makeRowVector({makeFlatVector<std::string>(
+        kNumRows,
+        [](auto row) {
+          return fmt::format("dictionary value {}", row % kNumDistinct);
+        },
+        withNulls ? nullEvery(13) : nullptr)});
+    writeToMemory(rowType_, {data}, false);
+    auto* values = data->childAt(0)->asFlatVector<StringView>();
+
+    for (const auto& filter : filters) {
+      SCOPED_TRACE(filter->toString());
+      std::vector<std::optional<std::string>> expected;
+      for (auto i = 0; i < kNumRows; ++i) {
+        if (values->isNullAt(i)) {
+          if (filter->testNull()) {
+            expected.push_back(std::nullopt);
+          }
+        } else if (filter->testBytes(
+                       values->valueAt(i).data(), values->valueAt(i).size())) {
+          expected.push_back(values->valueAt(i).str());
+        }
+      }
+      // Reads below and above the dictionary size.
+      for (const auto readSize :
+           {100, kNumDistinct - 1, kNumDistinct, 10'000}) {
+        SCOPED_TRACE(fmt::format("readSize {}", readSize));
+        EXPECT_EQ(read(*filter, readSize), expected);
+      }
+    }
+  }
+}
+
 TEST_F(E2EFilterTest, dedictionarize) {
   rowsInRowGroup_ = 10'000;
   options_.dictionaryPageSizeLimit = 20'000;
@@ -1229,3 +1229,155 @@ TEST_F(ParquetReaderTest, testEmptyV2DataPage) {
   assertReadWithReaderAndExpected(
       outputRowType, *rowReader, expected, *leafPool_);
 }
+
+TEST_F(ParquetReaderTest, pageIndexFilter) {
+  const auto rowType = ROW({"a", "b"}, {BIGINT(), VARCHAR()});
+  const int64_t kRows = 20'000;
+  auto data = makeRowVector(
+      rowType->names(),
+      {makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           kRows, [](auto row) { return fmt::format("s{}", row); })});
+
+  const auto filePath = tempPath_->getPath() + "/pageIndex.parquet";
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.enablePageIndex = true;
+  writerOptions.dataPageSize = 4 * 1024;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(filePath, readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 1);
+  ASSERT_TRUE(
+      reader->fileMetaData().rowGroup(0).columnChunk(0).hasPageIndex());
+
+  auto scanSpec = makeScanSpec(rowType);
+  scanSpec->childByName("a")->setFilter(
+      std::make_unique<BigintRange>(12'000, 12'099, false));
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  auto expected = makeRowVector(
+      rowType->names(),
+      {makeFlatVector<int64_t>(100, [](auto row) { return 12'000 + row; }),
+       makeFlatVector<std::string>(
+           100, [](auto row) { return fmt::format("s{}", 12'000 + row); })});
+  assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.skippedStrides, 0);
+  EXPECT_GT(stats.skippedPageRows, kRows / 2);
+}
+
+TEST_F(ParquetReaderTest, unitStatistics) {
+  const auto rowType = ROW({"a", "b"}, {BIGINT(), VARCHAR()});
+  constexpr int kNumRowGroups = 4;
+  constexpr int64_t kRows = kRowsInRowGroup;
+  const auto filePath = tempPath_->getPath() + "/unitStatistics.parquet";
+  auto writer = createWriter(
+      createSink(filePath),
+      [&]() {
+        return std::make_unique<DefaultFlushPolicy>(
+            kRowsInRowGroup, kBytesInRowGroup);
+      },
+      rowType);
+  for (auto i = 0; i < kNumRowGroups; ++i) {
+    writer->write(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(
+             kRows, [&](auto row) { return i * kRows + row; }),
+         makeFlatVector<std::string>(
+             kRows, [](auto row) { return fmt::format("s{}", row); })}));
+  }
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(filePath, readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), kNumRowGroups);
+
+  auto units = reader->unitStatistics(
+      0, std::numeric_limits<uint64_t>::max(), {"a", "missing"});
+  ASSERT_TRUE(units.has_value());
+  ASSERT_EQ(units->size(), kNumRowGroups);
+  for (auto i = 0; i < kNumRowGroups; ++i) {
+    const auto& unit = (*units)[i];
+    EXPECT_EQ(unit.numRows, kRows);
+    ASSERT_EQ(unit.columns.size(), 2);
+    auto* stats =
+        dynamic_cast<IntegerColumnStatistics*>(unit.columns[0].get());
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->getMinimum(), i * kRows);
+    EXPECT_EQ(stats->getMaximum(), (i + 1) * kRows - 1);
+    EXPECT_EQ(unit.columns[1], nullptr);
+  }
+
+  // No row group starts in the magic number at the start of the file.
+  units = reader->unitStatistics(0, 1, {"a"});
+  ASSERT_TRUE(units.has_value());
+  EXPECT_TRUE(units->empty());
+}
+
+TEST_F(ParquetReaderTest, nestedArraysInBatches) {
+  // Arrays of arrays with nulls and empty arrays on both levels. The batches
+  // end inside the repdefs of a page, and the filter on 'c' makes the rows of
+  // the arrays sparse.
+  constexpr vector_size_t kRows = 5'000;
+  std::vector<vector_size_t> offsets(kRows);
+  std::vector<vector_size_t> nulls;
+  vector_size_t numInner = 0;
+  for (auto i = 0; i < kRows; ++i) {
+    offsets[i] = numInner;
+    if (i % 17 == 0) {
+      nulls.push_back(i);
+    } else {
+      numInner += i % 5;
+    }
+  }
+  auto inner = makeArrayVector<int64_t>(
+      numInner,
+      [](auto row) { return row % 4; },
+      [](vector_size_t idx) { return idx; },
+      nullEvery(11),
+      nullEvery(13));
+  auto data = makeRowVector(
+      {"a", "c"},
+      {makeArrayVector(offsets, inner, nulls),
+       makeFlatVector<int64_t>(kRows, [](auto row) { return row % 3; })});
+  auto rowType = asRowType(data->type());
+
+  const auto filePath = tempPath_->getPath() + "/nestedArrays.parquet";
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.dataPageSize = 4 * 1024;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(filePath, readerOptions);
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  assertReadWithReaderAndExpected(rowType, *rowReader, data, *leafPool_);
+
+  auto scanSpec = makeScanSpec(rowType);
+  scanSpec->childByName("c")->setFilter(
+      std::make_unique<BigintRange>(0, 0, false));
+  rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  rowReader = reader->createRowReader(rowReaderOpts);
+  auto indices = makeIndices((kRows + 2) / 3, [](auto row) { return row * 3; });
+  auto expected = makeRowVector(
+      {"a", "c"},
+      {wrapInDictionary(indices, data->childAt(0)),
+       wrapInDictionary(indices, data->childAt(1))});
+  assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+}
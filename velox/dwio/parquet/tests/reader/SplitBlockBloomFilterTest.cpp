@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+
+using namespace facebook::velox::parquet;
+
+namespace {
+
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// Writer side of the split block bloom filter as given in the Parquet
+// specification.
+void insert(std::vector<uint32_t>& blocks, uint64_t hash) {
+  const uint64_t numBlocks = blocks.size() / 8;
+  const auto blockIndex = ((hash >> 32) * numBlocks) >> 32;
+  const auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < 8; ++i) {
+    blocks[blockIndex * 8 + i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+}
+
+// Returns the header and bitset as they are laid out in a file.
+std::string serialize(const std::vector<uint32_t>& blocks) {
+  thrift::BloomFilterHeader header;
+  header.__set_numBytes(blocks.size() * sizeof(uint32_t));
+  header.algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+  header.hash.__set_XXHASH(thrift::XxHash());
+  header.compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(buffer);
+  header.write(&protocol);
+  auto result = buffer->getBufferAsString();
+  result.append(
+      reinterpret_cast<const char*>(blocks.data()),
+      blocks.size() * sizeof(uint32_t));
+  return result;
+}
+
+} // namespace
+
+TEST(SplitBlockBloomFilterTest, roundTrip) {
+  std::vector<uint32_t> blocks(64 * 8);
+  for (int64_t i = 0; i < 1'000; i += 2) {
+    insert(blocks, SplitBlockBloomFilter::hash(i));
+    insert(blocks, SplitBlockBloomFilter::hash(fmt::format("key{}", i)));
+  }
+  auto serialized = serialize(blocks);
+  // Trailing bytes belong to the next structure in the file.
+  serialized.append(100, 'x');
+
+  auto filter =
+      SplitBlockBloomFilter::deserialize(serialized.data(), serialized.size());
+  ASSERT_NE(filter, nullptr);
+  EXPECT_EQ(filter->numBlocks(), 64);
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    const bool inserted = i % 2 == 0;
+    auto mayContain =
+        filter->mayContain(SplitBlockBloomFilter::hash(i)) &&
+        filter->mayContain(
+            SplitBlockBloomFilter::hash(fmt::format("key{}", i)));
+    if (inserted) {
+      EXPECT_TRUE(mayContain) << i;
+    } else if (mayContain) {
+      ++numFalsePositives;
+    }
+  }
+  EXPECT_LT(numFalsePositives, 50);
+}
+
+TEST(SplitBlockBloomFilterTest, int32Encoding) {
+  std::vector<uint32_t> blocks(8 * 8);
+  insert(blocks, SplitBlockBloomFilter::hash<int32_t>(17));
+  auto serialized = serialize(blocks);
+  auto filter =
+      SplitBlockBloomFilter::deserialize(serialized.data(), serialized.size());
+  ASSERT_NE(filter, nullptr);
+  EXPECT_TRUE(filter->mayContain(SplitBlockBloomFilter::hash<int32_t>(17)));
+}
+
+TEST(SplitBlockBloomFilterTest, truncated) {
+  std::vector<uint32_t> blocks(8 * 8);
+  auto serialized = serialize(blocks);
+  EXPECT_EQ(
+      SplitBlockBloomFilter::deserialize(
+          serialized.data(), serialized.size() - 1),
+      nullptr);
+  EXPECT_EQ(SplitBlockBloomFilter::deserialize(serialized.data(), 3), nullptr);
+}
+
+TEST(SplitBlockBloomFilterTest, unsupportedHeader) {
+  thrift::BloomFilterHeader header;
+  header.__set_numBytes(32);
+  // No algorithm, hash or compression set.
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(buffer);
+  header.write(&protocol);
+  auto serialized = buffer->getBufferAsString();
+  serialized.append(32, '\0');
+  EXPECT_EQ(
+      SplitBlockBloomFilter::deserialize(serialized.data(), serialized.size()),
+      nullptr);
+}
@@ -136,6 +136,60 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, adaptiveEncoding) {
+  auto schema =
+      ROW({"c0", "c1", "c2", "c3", "c4"},
+          {INTEGER(), BIGINT(), DOUBLE(), VARCHAR(), VARCHAR()});
+  const int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int32_t>(kRows, [](auto row) { return row % 10; }),
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row * 3; }),
+      makeFlatVector<double>(kRows, [](auto row) { return row * 0.1; }),
+      makeFlatVector<StringView>(
+          kRows,
+          [](auto row) {
+            return StringView::makeInline(fmt::format("value {}", row % 7));
+          }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("unique value {}", row); }),
+  });
+
+  for (bool adaptiveEncoding : {false, true}) {
+    SCOPED_TRACE(fmt::format("adaptiveEncoding {}", adaptiveEncoding));
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.adaptiveEncoding = adaptiveEncoding;
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(data);
+    writer->close();
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kRows);
+
+    // Only the columns with few distinct values are dictionary encoded.
+    const std::vector<bool> expectDictionary = {
+        true, false, false, true, false};
+    for (auto i = 0; i < schema->size(); ++i) {
+      EXPECT_EQ(
+          reader->fileMetaData()
+              .rowGroup(0)
+              .columnChunk(i)
+              .hasDictionaryPageOffset(),
+          !adaptiveEncoding || expectDictionary[i])
+          << i;
+    }
+
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+  }
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
@@ -123,14 +123,22 @@ Compression::type getArrowParquetCompression(
 
 namespace {
 
+// The columns for which adaptive encoding chose not to use a dictionary, with
+// the encoding to use instead.
+using ColumnEncodings = std::unordered_map<std::string, arrow::Encoding::type>;
+
 std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     const parquet::WriterOptions& options,
-    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy) {
+    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy,
+    const ColumnEncodings& columnEncodings = {}) {
   auto builder = WriterProperties::Builder();
   WriterProperties::Builder* properties = &builder;
   if (!options.enableDictionary) {
     properties = properties->disable_dictionary();
   }
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties =
       properties->compression(getArrowParquetCompression(options.compression));
   for (const auto& columnCompressionValues : options.columnCompressionsMap) {
@@ -139,6 +147,10 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
         getArrowParquetCompression(columnCompressionValues.second));
   }
   properties = properties->encoding(options.encoding);
+  for (const auto& [path, encoding] : columnEncodings) {
+    properties = properties->disable_dictionary(path);
+    properties = properties->encoding(path, encoding);
+  }
   properties = properties->data_pagesize(options.dataPageSize);
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
@@ -213,6 +225,92 @@ std::shared_ptr<::arrow::Field> updateFieldNameRecursive(
   }
 }
 
+// Maximum number of non-null values of a column sampled for choosing its
+// encoding.
+constexpr int64_t kMaxSampledValues = 10'000;
+
+// Dictionary encoding is chosen if at most this fraction of the sampled values
+// is distinct. Same as the defaults of the DWRF writer.
+constexpr double kNumericDictionaryThreshold = 0.7;
+constexpr double kStringDictionaryThreshold = 0.8;
+
+// Returns the fraction of distinct values among up to 'kMaxSampledValues'
+// non-null values of 'chunks', or std::nullopt if there is no non-null value.
+std::optional<double> sampleDistinctFraction(
+    const std::vector<std::shared_ptr<::arrow::Array>>& chunks) {
+  folly::F14FastSet<uint64_t> hashes;
+  int64_t numSampled = 0;
+  for (const auto& chunk : chunks) {
+    const auto& type = *chunk->type();
+    const auto isBinary = type.id() == ::arrow::Type::STRING ||
+        type.id() == ::arrow::Type::BINARY;
+    const auto byteWidth = isBinary
+        ? 0
+        : static_cast<const ::arrow::FixedWidthType&>(type).bit_width() / 8;
+    for (int64_t i = 0; i < chunk->length() && numSampled < kMaxSampledValues;
+         ++i) {
+      if (chunk->IsNull(i)) {
+        continue;
+      }
+      std::string_view value;
+      if (isBinary) {
+        value = static_cast<const ::arrow::BinaryArray&>(*chunk).GetView(i);
+      } else {
+        value = std::string_view(
+            reinterpret_cast<const char*>(
+                chunk->data()->GetValues<uint8_t>(1, 0)) +
+                (chunk->offset() + i) * byteWidth,
+            byteWidth);
+      }
+      hashes.insert(folly::hasher<std::string_view>()(value));
+      ++numSampled;
+    }
+  }
+  if (numSampled == 0) {
+    return std::nullopt;
+  }
+  return static_cast<double>(hashes.size()) / numSampled;
+}
+
+// Chooses the encodings of the top level primitive columns of 'schema' from
+// the staged data of the first row group in 'stagingChunks'.
+ColumnEncodings selectColumnEncodings(
+    const ::arrow::Schema& schema,
+    const std::vector<std::vector<std::shared_ptr<::arrow::Array>>>&
+        stagingChunks) {
+  ColumnEncodings encodings;
+  for (auto i = 0; i < schema.num_fields(); ++i) {
+    const auto& field = *schema.field(i);
+    arrow::Encoding::type nonDictionaryEncoding;
+    double threshold = kNumericDictionaryThreshold;
+    switch (field.type()->id()) {
+      case ::arrow::Type::INT8:
+      case ::arrow::Type::INT16:
+      case ::arrow::Type::INT32:
+      case ::arrow::Type::INT64:
+      case ::arrow::Type::DATE32:
+        nonDictionaryEncoding = arrow::Encoding::DELTA_BINARY_PACKED;
+        break;
+      case ::arrow::Type::FLOAT:
+      case ::arrow::Type::DOUBLE:
+        nonDictionaryEncoding = arrow::Encoding::BYTE_STREAM_SPLIT;
+        break;
+      case ::arrow::Type::STRING:
+      case ::arrow::Type::BINARY:
+        nonDictionaryEncoding = arrow::Encoding::PLAIN;
+        threshold = kStringDictionaryThreshold;
+        break;
+      default:
+        continue;
+    }
+    const auto distinctFraction = sampleDistinctFraction(stagingChunks[i]);
+    if (distinctFraction.has_value() && distinctFraction.value() > threshold) {
+      encodings.emplace(field.name(), nonDictionaryEncoding);
+    }
+  }
+  return encodings;
+}
+
 } // namespace
 
 Writer::Writer(
@@ -239,6 +337,10 @@ Writer::Writer(
       static_cast<TimestampUnit>(options.parquetWriteTimestampUnit);
   arrowContext_->properties =
       getArrowParquetWriterOptions(options, flushPolicy_);
+  if (options.adaptiveEncoding && options.enableDictionary &&
+      options.encoding == arrow::Encoding::PLAIN) {
+    adaptiveEncodingOptions_ = std::make_unique<WriterOptions>(options);
+  }
   setMemoryReclaimers();
 }
 
@@ -257,6 +359,14 @@ Writer::Writer(
 void Writer::flush() {
   if (arrowContext_->stagingRows > 0) {
     if (!arrowContext_->writer) {
+      if (adaptiveEncodingOptions_ != nullptr) {
+        arrowContext_->properties = getArrowParquetWriterOptions(
+            *adaptiveEncodingOptions_,
+            flushPolicy_,
+            selectColumnEncodings(
+                *arrowContext_->schema, arrowContext_->stagingChunks));
+        adaptiveEncodingOptions_.reset();
+      }
       auto arrowProperties = ArrowWriterProperties::Builder().build();
       PARQUET_ASSIGN_OR_THROW(
           arrowContext_->writer,
@@ -394,6 +504,9 @@ parquet::WriterOptions getParquetOptions(
     parquetOptions.parquetWriteTimestampUnit =
         options.parquetWriteTimestampUnit.value();
   }
+  if (options.parquetAdaptiveEncoding.has_value()) {
+    parquetOptions.adaptiveEncoding = options.parquetAdaptiveEncoding.value();
+  }
   return parquetOptions;
 }
 
@@ -88,6 +88,9 @@ class LambdaFlushPolicy : public DefaultFlushPolicy {
 
 struct WriterOptions {
   bool enableDictionary = true;
+  // Writes the ColumnIndex and OffsetIndex structures readers use to skip
+  // pages based on page-level min/max statistics.
+  bool enablePageIndex = false;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
@@ -105,6 +108,13 @@ struct WriterOptions {
       columnCompressionsMap;
   uint8_t parquetWriteTimestampUnit =
       static_cast<uint8_t>(TimestampUnit::kNano);
+  // If true, the encoding of each top level primitive column is chosen from a
+  // sample of the first row group, as the DWRF writer does with its
+  // EntropyEncodingSelector: dictionary if few values are distinct, otherwise
+  // DELTA_BINARY_PACKED for integers, BYTE_STREAM_SPLIT for floating point and
+  // PLAIN for strings. Not used if dictionary encoding is disabled or a
+  // non-PLAIN encoding is configured.
+  bool adaptiveEncoding = false;
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -160,6 +170,9 @@ class Writer : public dwio::common::Writer {
 
   std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
 
+  // Set if the column encodings are chosen at the first flush.
+  std::unique_ptr<WriterOptions> adaptiveEncodingOptions_;
+
   const RowTypePtr schema_;
 
   ArrowOptions options_{.flattenDictionary = true, .flattenConstant = true};
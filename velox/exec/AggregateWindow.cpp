@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+#include <folly/ScopeGuard.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -28,7 +29,9 @@ namespace {
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
-// to frameEnd boundaries at that row using singleGroup.
+// to frameEnd boundaries at that row using singleGroup. If the frames are
+// large, the aggregation for a frame combines the partial aggregates of a
+// segment tree over the partition with the rows at the frame edges instead.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -39,7 +42,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
       velox::memory::MemoryPool* pool,
       HashStringAllocator* stringAllocator,
       const core::QueryConfig& config)
-      : WindowFunction(resultType, pool, stringAllocator) {
+      : WindowFunction(resultType, pool, stringAllocator),
+        name_(name),
+        segmentTreeMinFrameSize_(config.windowSegmentTreeMinFrameSize()) {
     VELOX_USER_CHECK(
         !ignoreNulls, "Aggregate window functions do not support IGNORE NULLS");
     argTypes_.reserve(args.size());
@@ -116,6 +121,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_.clear();
+    segmentTreeSlices_.clear();
+    segmentTreeBuilt_ = false;
+  }
+
+  RowAccess rowAccess() const override {
+    return RowAccess::kIncrementalFrame;
   }
 
   void apply(
@@ -164,6 +176,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
           resultOffset,
           result);
     } else {
+      const bool useSegmentTree =
+          shouldUseSegmentTree(validRows, rawFrameStarts, rawFrameEnds);
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
           validRows,
@@ -171,6 +185,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
           frameMetadata.lastRow,
           rawFrameStarts,
           rawFrameEnds,
+          useSegmentTree,
           resultOffset,
           result);
     }
@@ -178,6 +193,10 @@ class AggregateWindowFunction : public exec::WindowFunction {
   }
 
  private:
+  // Number of rows or lower level nodes aggregated by a node of the segment
+  // tree.
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
   struct FrameMetadata {
     // Min frame start row required for aggregation.
     vector_size_t firstRow;
@@ -195,6 +214,14 @@ class AggregateWindowFunction : public exec::WindowFunction {
     bool usePreviousAggregate;
   };
 
+  // A range of rows of the partition if 'level' is -1, or of nodes of
+  // 'segmentTree_[level]' otherwise, that is added to the aggregate of a frame.
+  struct Segment {
+    int32_t level;
+    vector_size_t begin;
+    vector_size_t end;
+  };
+
   bool handleAllEmptyFrames(
       const SelectivityVector& validRows,
       vector_size_t resultOffset,
@@ -318,12 +345,17 @@ class AggregateWindowFunction : public exec::WindowFunction {
       vector_size_t maxFrame,
       const vector_size_t* frameStartsVector,
       const vector_size_t* frameEndsVector,
+      bool useSegmentTree,
       vector_size_t resultOffset,
       const VectorPtr& result) {
     SelectivityVector rows;
     rows.resize(maxFrame + 1 - minFrame);
     static auto kSingleGroup = std::vector<vector_size_t>{0};
 
+    if (useSegmentTree) {
+      sliceSegmentTree(minFrame, maxFrame);
+    }
+
     validRows.applyToSelected([&](auto i) {
       // This is a very naive algorithm.
       // It evaluates the entire aggregation for each row by iterating over
@@ -335,9 +367,14 @@ class AggregateWindowFunction : public exec::WindowFunction {
       aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
       aggregateInitialized_ = true;
 
-      auto frameStartIndex = frameStartsVector[i] - minFrame;
-      auto frameEndIndex = frameEndsVector[i] - minFrame + 1;
-      computeAggregate(rows, frameStartIndex, frameEndIndex);
+      if (useSegmentTree) {
+        computeAggregateFromSegmentTree(
+            frameStartsVector[i], frameEndsVector[i], minFrame);
+      } else {
+        auto frameStartIndex = frameStartsVector[i] - minFrame;
+        auto frameEndIndex = frameEndsVector[i] - minFrame + 1;
+        computeAggregate(rows, frameStartIndex, frameEndIndex);
+      }
       result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
     });
 
@@ -345,6 +382,178 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are large enough on average to
+  // compute these from the segment tree. Builds the segment tree for the
+  // partition on first use.
+  bool shouldUseSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* frameStarts,
+      const vector_size_t* frameEnds) {
+    // The segment tree covers the whole partition, which a partial partition
+    // does not hold in memory.
+    if (segmentTreeMinFrameSize_ == 0 || partition_->partial() ||
+        partition_->numRows() < kSegmentTreeFanout ||
+        (segmentTreeBuilt_ && segmentTree_.empty())) {
+      return false;
+    }
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected(
+        [&](auto i) { numFrameRows += frameEnds[i] + 1 - frameStarts[i]; });
+    if (numFrameRows <
+        static_cast<int64_t>(segmentTreeMinFrameSize_) *
+            validRows.countSelected()) {
+      return false;
+    }
+    if (!segmentTreeBuilt_) {
+      buildSegmentTree();
+    }
+    return !segmentTree_.empty();
+  }
+
+  // Fills 'segmentTree_' with the intermediate results of the aggregate over
+  // the partition. 'segmentTree_[i]' has one row per consecutive range of
+  // kSegmentTreeFanout^(i + 1) rows of the partition. Ranges at the end of the
+  // partition that are not full are left out since no frame can use these.
+  // Leaves 'segmentTree_' empty if a partial aggregate fails, e.g. with an
+  // overflow that the frames themselves might not reach.
+  void buildSegmentTree() {
+    segmentTreeBuilt_ = true;
+    segmentTree_.clear();
+    if (intermediateType_ == nullptr) {
+      intermediateType_ = Aggregate::intermediateType(name_, argTypes_);
+    }
+    fillArgVectors(0, partition_->numRows() - 1);
+    aggregate_->clear();
+    try {
+      auto numNodes = partition_->numRows() / kSegmentTreeFanout;
+      while (numNodes > 0) {
+        segmentTree_.push_back(aggregateSegments(numNodes));
+        numNodes /= kSegmentTreeFanout;
+      }
+    } catch (const VeloxUserError&) {
+      segmentTree_.clear();
+    }
+  }
+
+  // Returns the intermediate results of 'numNodes' nodes of the next level of
+  // 'segmentTree_'. Each node aggregates kSegmentTreeFanout consecutive rows
+  // of 'argVectors_' for the first level or of the last level otherwise.
+  VectorPtr aggregateSegments(vector_size_t numNodes) {
+    const auto rowSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    auto nodesBuffer = AlignedBuffer::allocate<char>(
+        static_cast<size_t>(numNodes) * rowSize, pool_, 0);
+    std::vector<char*> nodes(numNodes);
+    std::vector<vector_size_t> indices(numNodes);
+    for (auto i = 0; i < numNodes; ++i) {
+      nodes[i] = nodesBuffer->asMutable<char>() + i * rowSize;
+      indices[i] = i;
+    }
+    const auto numInputs = numNodes * kSegmentTreeFanout;
+    std::vector<char*> groups(numInputs);
+    for (auto i = 0; i < numInputs; ++i) {
+      groups[i] = nodes[i / kSegmentTreeFanout];
+    }
+    SelectivityVector rows(numInputs);
+
+    aggregate_->initializeNewGroups(nodes.data(), indices);
+    SCOPE_EXIT {
+      aggregate_->destroy(folly::Range(nodes.data(), numNodes));
+    };
+    if (segmentTree_.empty()) {
+      aggregate_->addRawInput(groups.data(), rows, argVectors_, false);
+    } else {
+      aggregate_->addIntermediateResults(
+          groups.data(), rows, {segmentTree_.back()}, false);
+    }
+    auto result = BaseVector::create(intermediateType_, numNodes, pool_);
+    aggregate_->extractAccumulators(nodes.data(), numNodes, &result);
+    return result;
+  }
+
+  // Sets 'segmentTreeSlices_' to the nodes of each level of 'segmentTree_'
+  // that frames within 'firstRow' and 'lastRow' may use.
+  void sliceSegmentTree(vector_size_t firstRow, vector_size_t lastRow) {
+    segmentTreeSlices_.resize(segmentTree_.size());
+    firstSliceNodes_.resize(segmentTree_.size());
+    int64_t nodeSize = 1;
+    for (auto level = 0; level < segmentTree_.size(); ++level) {
+      nodeSize *= kSegmentTreeFanout;
+      const auto& nodes = segmentTree_[level];
+      const vector_size_t first = firstRow / nodeSize;
+      const vector_size_t end =
+          std::min<int64_t>(nodes->size(), (lastRow + 1) / nodeSize);
+      if (end > first) {
+        firstSliceNodes_[level] = first;
+        segmentTreeSlices_[level] = {nodes->slice(first, end - first)};
+      } else {
+        firstSliceNodes_[level] = 0;
+        segmentTreeSlices_[level] = {nodes};
+      }
+    }
+  }
+
+  // Computes the aggregate of the frame from 'frameStart' to 'frameEnd'
+  // into the single group. The frame is covered by the highest nodes of the
+  // segment tree that fit in it, and the rows and lower nodes at its edges.
+  // These are added in the order of the rows they cover so that order
+  // sensitive aggregates see the rows in frame order. 'argVectors_' start at
+  // 'minFrame'.
+  void computeAggregateFromSegmentTree(
+      vector_size_t frameStart,
+      vector_size_t frameEnd,
+      vector_size_t minFrame) {
+    segments_.clear();
+    rightSegments_.clear();
+    int32_t level = -1;
+    vector_size_t begin = frameStart;
+    vector_size_t end = frameEnd + 1;
+    for (;;) {
+      const auto parentBegin =
+          (begin + kSegmentTreeFanout - 1) / kSegmentTreeFanout;
+      const auto parentEnd = end / kSegmentTreeFanout;
+      if (level + 1 == segmentTree_.size() || parentBegin >= parentEnd) {
+        segments_.push_back({level, begin, end});
+        break;
+      }
+      segments_.push_back({level, begin, parentBegin * kSegmentTreeFanout});
+      rightSegments_.push_back({level, parentEnd * kSegmentTreeFanout, end});
+      begin = parentBegin;
+      end = parentEnd;
+      ++level;
+    }
+    segments_.insert(
+        segments_.end(), rightSegments_.rbegin(), rightSegments_.rend());
+
+    for (const auto& segment : segments_) {
+      if (segment.begin == segment.end) {
+        continue;
+      }
+      if (segment.level < 0) {
+        selectSegmentRows(segment.begin - minFrame, segment.end - minFrame);
+        aggregate_->addSingleGroupRawInput(
+            rawSingleGroupRow_, segmentRows_, argVectors_, false);
+      } else {
+        const auto firstNode = firstSliceNodes_[segment.level];
+        selectSegmentRows(segment.begin - firstNode, segment.end - firstNode);
+        aggregate_->addSingleGroupIntermediateResults(
+            rawSingleGroupRow_,
+            segmentRows_,
+            segmentTreeSlices_[segment.level],
+            false);
+      }
+    }
+
+    BaseVector::prepareForReuse(aggregateResultVector_, 1);
+    aggregate_->extractValues(&rawSingleGroupRow_, 1, &aggregateResultVector_);
+  }
+
+  void selectSegmentRows(vector_size_t begin, vector_size_t end) {
+    segmentRows_.resizeFill(end, false);
+    segmentRows_.setValidRange(begin, end, true);
+    segmentRows_.updateBounds();
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -358,6 +567,12 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregate_->clear();
   }
 
+  const std::string name_;
+
+  // Minimum average frame size to use the segment tree. 0 disables the
+  // segment tree.
+  const uint32_t segmentTreeMinFrameSize_;
+
   // Aggregate function object required for this window function evaluation.
   std::unique_ptr<exec::Aggregate> aggregate_;
 
@@ -393,6 +608,28 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // Intermediate type of the aggregate. Set when the first segment tree is
+  // built.
+  TypePtr intermediateType_;
+
+  // Levels of intermediate results of the aggregate over the current
+  // partition. See buildSegmentTree().
+  std::vector<VectorPtr> segmentTree_;
+
+  // True if 'segmentTree_' has been built for the current partition.
+  bool segmentTreeBuilt_{false};
+
+  // The nodes of each level of 'segmentTree_' used by the current output
+  // block, each as the single argument of addSingleGroupIntermediateResults,
+  // and the index of the first of these nodes in the level.
+  std::vector<std::vector<VectorPtr>> segmentTreeSlices_;
+  std::vector<vector_size_t> firstSliceNodes_;
+
+  // Reusable memory for computeAggregateFromSegmentTree().
+  std::vector<Segment> segments_;
+  std::vector<Segment> rightSegments_;
+  SelectivityVector segmentRows_;
 };
 
 } // namespace
@@ -18,6 +18,17 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+void releaseBatch(ArrowSchema& schema, ArrowArray& array) {
+  if (schema.release) {
+    schema.release(&schema);
+  }
+  if (array.release) {
+    array.release(&array);
+  }
+}
+} // namespace
+
 ArrowStream::ArrowStream(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -27,7 +38,13 @@ ArrowStream::ArrowStream(
           arrowStreamNode->outputType(),
           operatorId,
           arrowStreamNode->id(),
-          "ArrowStream") {
+          "ArrowStream"),
+      maxPrefetchBatches_(
+          driverCtx->task->queryCtx()->executor() != nullptr
+              ? std::max<int32_t>(
+                    driverCtx->queryConfig().arrowStreamPrefetchBatches(), 0)
+              : 0),
+      executor_(driverCtx->task->queryCtx()->executor()) {
   arrowStream_ = arrowStreamNode->arrowStream();
 }
 
@@ -35,7 +52,7 @@ ArrowStream::~ArrowStream() {
   close();
 }
 
-RowVectorPtr ArrowStream::getOutput() {
+std::optional<ArrowStream::Batch> ArrowStream::nextBatch() {
   // Get Arrow array.
   struct ArrowArray arrowArray;
   if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
@@ -47,8 +64,7 @@ RowVectorPtr ArrowStream::getOutput() {
   }
   if (arrowArray.release == nullptr) {
     // End of Stream.
-    finished_ = true;
-    return nullptr;
+    return std::nullopt;
   }
 
   // Get Arrow schema.
@@ -64,10 +80,102 @@ RowVectorPtr ArrowStream::getOutput() {
         "Failed to call get_schema on ArrowStream: {}",
         std::string(getError()));
   }
+  return Batch{arrowSchema, arrowArray};
+}
+
+RowVectorPtr ArrowStream::getOutput() {
+  std::optional<Batch> batch;
+  if (maxPrefetchBatches_ == 0) {
+    batch = nextBatch();
+    if (!batch.has_value()) {
+      finished_ = true;
+      return nullptr;
+    }
+  } else {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (prefetchError_) {
+      std::rethrow_exception(prefetchError_);
+    }
+    if (prefetched_.empty()) {
+      finished_ = streamAtEnd_;
+      maybeStartPrefetchLocked();
+      return nullptr;
+    }
+    batch = prefetched_.front();
+    prefetched_.pop_front();
+    // Refills the buffer while the driver processes this batch.
+    maybeStartPrefetchLocked();
+  }
 
   // Convert Arrow Array into RowVector and return.
   return std::dynamic_pointer_cast<RowVector>(
-      importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+      importFromArrowAsOwner(batch->schema, batch->array, pool()));
+}
+
+BlockingReason ArrowStream::isBlocked(ContinueFuture* future) {
+  if (maxPrefetchBatches_ == 0) {
+    return BlockingReason::kNotBlocked;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!prefetched_.empty() || streamAtEnd_ || prefetchError_) {
+    return BlockingReason::kNotBlocked;
+  }
+  maybeStartPrefetchLocked();
+  consumerPromise_ = ContinuePromise("ArrowStream::isBlocked");
+  *future = consumerPromise_->getSemiFuture();
+  return BlockingReason::kWaitForProducer;
+}
+
+bool ArrowStream::maybeStartPrefetchLocked() {
+  if (prefetchRunning_ || streamAtEnd_ || closed_ || prefetchError_ ||
+      prefetched_.size() >= maxPrefetchBatches_) {
+    return false;
+  }
+  prefetchRunning_ = true;
+  executor_->add([this]() { prefetch(); });
+  return true;
+}
+
+void ArrowStream::prefetch() {
+  for (;;) {
+    std::optional<Batch> batch;
+    std::exception_ptr error;
+    try {
+      batch = nextBatch();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+
+    std::optional<ContinuePromise> promise;
+    bool stop;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (error) {
+        prefetchError_ = error;
+      } else if (!batch.has_value()) {
+        streamAtEnd_ = true;
+      } else if (closed_) {
+        releaseBatch(batch->schema, batch->array);
+      } else {
+        prefetched_.push_back(*batch);
+      }
+      promise = std::move(consumerPromise_);
+      consumerPromise_.reset();
+      stop = prefetchError_ || streamAtEnd_ || closed_ ||
+          prefetched_.size() >= maxPrefetchBatches_;
+      if (stop) {
+        prefetchRunning_ = false;
+        prefetchDone_.notify_all();
+      }
+    }
+    // 'this' may be destroyed once 'prefetchRunning_' is cleared.
+    if (promise.has_value()) {
+      promise->setValue();
+    }
+    if (stop) {
+      return;
+    }
+  }
 }
 
 bool ArrowStream::isFinished() {
@@ -81,6 +189,20 @@ const char* ArrowStream::getError() const {
 }
 
 void ArrowStream::close() {
+  {
+    // Waits for a running prefetch to stop before releasing the stream.
+    std::unique_lock<std::mutex> l(mutex_);
+    closed_ = true;
+    prefetchDone_.wait(l, [&]() { return !prefetchRunning_; });
+    for (auto& batch : prefetched_) {
+      releaseBatch(batch.schema, batch.array);
+    }
+    prefetched_.clear();
+    if (consumerPromise_.has_value()) {
+      consumerPromise_->setValue();
+      consumerPromise_.reset();
+    }
+  }
   if (arrowStream_->release) {
     arrowStream_->release(arrowStream_.get());
   }
@@ -13,6 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <folly/Executor.h>
+
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 
@@ -20,6 +26,14 @@
 
 namespace facebook::velox::exec {
 
+/// Produces the record batches of an Arrow C stream as RowVectors. The
+/// batches are imported without copying the Arrow buffers.
+///
+/// If 'arrow_stream_prefetch_batches' is positive and the query has an
+/// executor, batches are fetched from the stream on the executor while the
+/// driver processes earlier ones. At most that many batches are buffered, so a
+/// slow consumer stops the fetching. This pipelines network bound streams,
+/// e.g. a Flight client exported as a C stream, with the rest of the query.
 class ArrowStream : public SourceOperator {
  public:
   ArrowStream(
@@ -31,20 +45,51 @@ class ArrowStream : public SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
   void close() override;
 
  private:
+  // A batch read from the stream with the schema that describes it.
+  struct Batch {
+    ArrowSchema schema;
+    ArrowArray array;
+  };
+
   /// Return last error in Arrow array stream.
   const char* getError() const;
 
+  // Reads the next batch from 'arrowStream_'. Returns std::nullopt at the end
+  // of the stream. Throws if the stream fails.
+  std::optional<Batch> nextBatch();
+
+  // Starts fetching batches on 'executor_' if there is room in 'prefetched_'
+  // and no fetch is running. Returns true if the fetch was started.
+  bool maybeStartPrefetchLocked();
+
+  // Fetches batches into 'prefetched_' until it is full or the stream ends.
+  void prefetch();
+
   bool finished_ = false;
   std::shared_ptr<ArrowArrayStream> arrowStream_;
+
+  // Maximum number of prefetched batches. 0 if batches are read on the driver
+  // thread.
+  const size_t maxPrefetchBatches_;
+  folly::Executor* const executor_;
+
+  std::mutex mutex_;
+  // Notified when a running prefetch stops.
+  std::condition_variable prefetchDone_;
+  std::deque<Batch> prefetched_;
+  bool prefetchRunning_{false};
+  bool streamAtEnd_{false};
+  bool closed_{false};
+  std::exception_ptr prefetchError_;
+  // Fulfilled when a batch is prefetched or the prefetch stops.
+  std::optional<ContinuePromise> consumerPromise_;
 };
 
 } // namespace facebook::velox::exec
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/BatchCoalesce.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+
+BatchCoalesce::BatchCoalesce(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const FilterProject* filter)
+    : Operator(
+          driverCtx,
+          filter->outputType(),
+          operatorId,
+          filter->planNodeId(),
+          "BatchCoalesce"),
+      filter_(filter),
+      selectivityThreshold_(
+          driverCtx->queryConfig().batchCoalesceSelectivityThreshold()),
+      maxWaitMs_(driverCtx->queryConfig().batchCoalesceMaxWaitMs()),
+      targetRows_(outputBatchRows()) {
+  // Lets dynamic filters from a join after 'this' pass through.
+  for (column_index_t i = 0; i < outputType_->size(); ++i) {
+    identityProjections_.emplace_back(i, i);
+  }
+  isIdentityProjection_ = true;
+}
+
+void BatchCoalesce::addInput(RowVectorPtr input) {
+  const auto size = input->size();
+  if (pending_.empty() &&
+      (filter_->selectivity() >= selectivityThreshold_ ||
+       size >= targetRows_ / kCoalesceFraction)) {
+    input_ = std::move(input);
+    return;
+  }
+  if (pending_.empty()) {
+    pendingStartMs_ = getCurrentTimeMs();
+  }
+  pending_.push_back(std::move(input));
+  pendingRows_ += size;
+}
+
+RowVectorPtr BatchCoalesce::getOutput() {
+  if (input_ != nullptr) {
+    return std::move(input_);
+  }
+  if (pending_.empty()) {
+    return nullptr;
+  }
+  if (readyToFlush() || noMoreInput_ ||
+      getCurrentTimeMs() - pendingStartMs_ >= maxWaitMs_) {
+    return flush();
+  }
+  return nullptr;
+}
+
+RowVectorPtr BatchCoalesce::flush() {
+  RowVectorPtr output;
+  if (pending_.size() == 1) {
+    output = std::move(pending_[0]);
+  } else {
+    output = BaseVector::create<RowVector>(outputType_, pendingRows_, pool());
+    vector_size_t offset = 0;
+    for (const auto& batch : pending_) {
+      // Copies the rows, which also loads lazy columns.
+      output->copy(batch.get(), offset, 0, batch->size());
+      offset += batch->size();
+    }
+    const auto rowSize =
+        std::max<uint64_t>(output->estimateFlatSize() / output->size(), 1);
+    targetRows_ = outputBatchRows(rowSize);
+  }
+  addRuntimeStat("coalescedBatches", RuntimeCounter(pending_.size()));
+  addRuntimeStat("coalescedBatchRows", RuntimeCounter(pendingRows_));
+  pending_.clear();
+  pendingRows_ = 0;
+  return output;
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/FilterProject.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Concatenates the small batches coming out of a selective filter before
+/// they reach an operator with a high fixed cost per batch, e.g. a hash join,
+/// an aggregation or a PartitionedOutput. Added by the LocalPlanner after such
+/// a FilterProject with adaptive output batch sizes. Passes the batches
+/// through unchanged while the filter keeps more than
+/// batch_coalesce_selectivity_threshold of its input. Below that, holds
+/// batches with fewer than a quarter of the rows of an output batch until
+/// the held rows make half an output batch, the input is at end or the first
+/// held batch waited for batch_coalesce_max_wait_ms. The rows of an output
+/// batch follow from the average row size of the coalesced batches.
+class BatchCoalesce : public Operator {
+ public:
+  BatchCoalesce(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const FilterProject* filter);
+
+  bool preservesOrder() const override {
+    return true;
+  }
+
+  bool needsInput() const override {
+    return input_ == nullptr && !readyToFlush();
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr && pending_.empty();
+  }
+
+ private:
+  // A batch with fewer than 1 / kCoalesceFraction of the target rows is
+  // coalesced with the next ones.
+  static constexpr int32_t kCoalesceFraction = 4;
+
+  bool readyToFlush() const {
+    return pendingRows_ >= targetRows_ / 2;
+  }
+
+  // Returns the batches in 'pending_' as one batch. The batch is returned as
+  // is if there is only one.
+  RowVectorPtr flush();
+
+  // The filter before 'this'. Lives as long as 'this' in the same Driver.
+  const FilterProject* const filter_;
+
+  const double selectivityThreshold_;
+  const uint64_t maxWaitMs_;
+
+  // Rows in a batch, from the average row size of the coalesced batches.
+  vector_size_t targetRows_;
+
+  std::vector<RowVectorPtr> pending_;
+  vector_size_t pendingRows_{0};
+
+  // Time the first batch in 'pending_' was added.
+  uint64_t pendingStartMs_{0};
+};
+} // namespace facebook::velox::exec
@@ -36,16 +36,17 @@ class TypedDistinctAggregations : public DistinctAggregations {
 
   using AccumulatorType = aggregate::prestosql::SetAccumulator<T>;
 
-  /// Returns metadata about the accumulator used to store unique inputs.
+  /// Returns metadata about the accumulator used to store unique inputs. The
+  /// unique inputs of a group are spilled as an array.
   Accumulator accumulator() const override {
     return {
         false, // isFixedSize
         sizeof(AccumulatorType),
         false, // usesExternalMemory
         1, // alignment
-        nullptr,
-        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
-          VELOX_UNREACHABLE();
+        ARRAY(inputType_),
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
         },
         [this](folly::Range<char**> groups) {
           for (auto* group : groups) {
@@ -89,6 +90,29 @@ class TypedDistinctAggregations : public DistinctAggregations {
     inputForAccumulator_.reset();
   }
 
+  void addSpilledInput(
+      char** groups,
+      const VectorPtr& input,
+      const SelectivityVector& rows) override {
+    decodedSpill_.decode(*input, rows);
+    const auto* arrays = decodedSpill_.base()->template as<ArrayVector>();
+    VELOX_CHECK_NOT_NULL(arrays);
+    decodedInput_.decode(*arrays->elements());
+
+    rows.applyToSelected([&](vector_size_t i) {
+      if (decodedSpill_.isNullAt(i)) {
+        return;
+      }
+      auto* group = groups[i];
+      auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+
+      RowSizeTracker<char, uint32_t> tracker(
+          group[rowSizeOffset_], *allocator_);
+      accumulator->addValues(
+          *arrays, decodedSpill_.index(i), decodedInput_, allocator_);
+    });
+  }
+
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
       override {
     SelectivityVector rows;
@@ -189,6 +213,40 @@ class TypedDistinctAggregations : public DistinctAggregations {
         pool_, inputType_, nullptr, input->size(), newChildren);
   }
 
+  // Copies the unique inputs of each group into an array of 'result'. Only
+  // the distinct values are spilled, not the raw input rows.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    auto* arrays = result->as<ArrayVector>();
+    VELOX_CHECK_NOT_NULL(arrays);
+    arrays->resize(groups.size());
+
+    vector_size_t numValues{0};
+    for (auto* group : groups) {
+      numValues += reinterpret_cast<AccumulatorType*>(group + offset_)->size();
+    }
+    auto& elements = arrays->elements();
+    elements->resize(numValues);
+
+    auto* rawOffsets = arrays->mutableOffsets(groups.size())
+                           ->template asMutable<vector_size_t>();
+    auto* rawSizes =
+        arrays->mutableSizes(groups.size())->template asMutable<vector_size_t>();
+    vector_size_t offset{0};
+    for (auto i = 0; i < groups.size(); ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      arrays->setNull(i, false);
+      rawOffsets[i] = offset;
+      if constexpr (std::is_same_v<T, ComplexType>) {
+        rawSizes[i] = accumulator->extractValues(*elements, offset);
+      } else {
+        rawSizes[i] = accumulator->extractValues(
+            *(elements->template as<FlatVector<T>>()), offset);
+      }
+      offset += rawSizes[i];
+    }
+  }
+
   std::vector<VectorPtr> makeInputForAggregation(const VectorPtr& input) const {
     if (isSingleInputAggregate()) {
       return {std::move(input)};
@@ -203,6 +261,9 @@ class TypedDistinctAggregations : public DistinctAggregations {
 
   DecodedVector decodedInput_;
   VectorPtr inputForAccumulator_;
+
+  // Decodes the spilled arrays in addSpilledInput().
+  DecodedVector decodedSpill_;
 };
 
 } // namespace
@@ -86,6 +86,14 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the de-duplicated inputs of 'groups' read back from spill. 'input'
+  /// has an array of inputs per row produced by the spill extract function of
+  /// accumulator(). The arrays are merged into the sets of 'groups'.
+  virtual void addSpilledInput(
+      char** groups,
+      const VectorPtr& input,
+      const SelectivityVector& rows) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
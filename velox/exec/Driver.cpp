@@ -16,6 +16,7 @@
 
 #include "Driver.h"
 #include <folly/ScopeGuard.h>
+#include <folly/hash/Hash.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
 #include <gflags/gflags.h>
@@ -24,6 +25,7 @@
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/DriverExecutor.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Task.h"
 
@@ -142,6 +144,17 @@ const core::QueryConfig& DriverCtx::queryConfig() const {
   return task->queryCtx()->queryConfig();
 }
 
+VectorPool* DriverCtx::sharedVectorPool(const core::PlanNodeId& planNodeId) {
+  if (!queryConfig().sharedVectorPoolEnabled()) {
+    return nullptr;
+  }
+  if (sharedVectorPool_ == nullptr) {
+    sharedVectorPool_ = std::make_unique<VectorPool>(
+        addOperatorPool(planNodeId, "SharedVectorPool"));
+  }
+  return sharedVectorPool_.get();
+}
+
 velox::memory::MemoryPool* DriverCtx::addOperatorPool(
     const core::PlanNodeId& planNodeId,
     const std::string& operatorType) {
@@ -168,6 +181,12 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
+  common::GetSpillDirectoryPathCB getOverflowSpillDirPathCb;
+  if (!queryConfig.spillOverflowPath().empty()) {
+    getOverflowSpillDirPathCb = [this]() -> std::string_view {
+      return task->getOverflowSpillDirectory();
+    };
+  }
   return common::SpillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
@@ -184,7 +203,20 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.maxSpillRunRows(),
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      prefixSortConfig(),
+      std::move(getOverflowSpillDirPathCb),
+      queryConfig.spillReadAheadDepth(),
+      task->spillReadAheadBudget(),
+      queryConfig.maxSpillMergeBytes());
+}
+
+common::PrefixSortConfig DriverCtx::prefixSortConfig() const {
+  const auto& queryConfig = task->queryCtx()->queryConfig();
+  return common::PrefixSortConfig(
+      queryConfig.prefixSortNormalizedKeyMaxBytes(),
+      queryConfig.prefixSortMinRows(),
+      queryConfig.prefixSortMaxStringPrefixLength());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -221,6 +253,10 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          driver->recordBlockedTime(
+              state->sinceMicros_,
+              state->reason_,
+              state->operator_->operatorId());
         }
         VELOX_CHECK(!driver->state().suspended());
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -280,8 +316,17 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* driverExecutor = dynamic_cast<DriverExecutor*>(executor)) {
+    // Keeps the drivers of a task on the same thread unless stolen.
+    driverExecutor->add(
+        driver->task()->queryCtx()->queryId(),
+        folly::hash::twang_mix64(
+            reinterpret_cast<uintptr_t>(driver->task().get())),
+        [driver]() { Driver::run(driver); });
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -294,6 +339,9 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorHardwareCounters_ =
+      ctx_->queryConfig().operatorTrackHardwareCounters();
+  timeline_ = DriverTimeline(ctx_->queryConfig().driverTimelineMaxEvents());
 }
 
 void Driver::initializeOperators() {
@@ -361,6 +409,7 @@ RowVectorPtr Driver::next(std::shared_ptr<BlockingState>& blockingState) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
+  auto stackSampling = self->startStackSampling();
   RowVectorPtr result;
   auto stop = runInternal(self, blockingState, result);
 
@@ -428,6 +477,55 @@ size_t OpCallStatusRaw::callDuration() const {
       : fmt::format("null::{}", operatorMethod);
 }
 
+void Driver::addHardwareCounters(
+    Operator& op,
+    const process::HardwareCounters& counters) {
+  op.stats().wlock()->hardwareCounters.add(counters);
+}
+
+namespace {
+// Stack sampling label of a call of the operator at 'operatorId' in the
+// pipeline, or of the driver itself between operator calls if 'operatorId' is
+// -1.
+int32_t makeStackSamplingLabel(int32_t pipelineId, int32_t operatorId) {
+  return (pipelineId << 16) | (operatorId + 1);
+}
+} // namespace
+
+std::unique_ptr<process::StackSampler::ThreadScope>
+Driver::startStackSampling() {
+  auto* sampler = task()->stackSampler();
+  if (sampler == nullptr) {
+    return nullptr;
+  }
+  const auto pipelineId = ctx_->pipelineId;
+  if (!stackSamplingLabelsSet_) {
+    sampler->setLabelName(
+        makeStackSamplingLabel(pipelineId, -1),
+        fmt::format("Pipeline {};Driver", pipelineId));
+    for (auto i = 0; i < operators_.size(); ++i) {
+      sampler->setLabelName(
+          makeStackSamplingLabel(pipelineId, i),
+          fmt::format(
+              "Pipeline {};{} {}",
+              pipelineId,
+              operators_[i]->operatorType(),
+              operators_[i]->planNodeId()));
+    }
+    stackSamplingLabelsSet_ = true;
+  }
+  return std::make_unique<process::StackSampler::ThreadScope>(
+      sampler, &Driver::stackSamplingLabel, this);
+}
+
+// static
+int32_t Driver::stackSamplingLabel(const void* driver) {
+  const auto* self = static_cast<const Driver*>(driver);
+  const auto status = self->opCallStatus_();
+  return makeStackSamplingLabel(
+      self->ctx_->pipelineId, status.empty() ? -1 : status.opId);
+}
+
 CpuWallTiming Driver::processLazyTiming(
     Operator& op,
     const CpuWallTiming& timing) {
@@ -522,6 +620,11 @@ StopReason Driver::runInternal(
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricDriverQueueTimeMs, queuedTimeUs / 1'000);
   }
+  if (timeline_.enabled()) {
+    timeline_.add(
+        {DriverTimelineEvent::Kind::kQueued, queueTimeStartUs_, queuedTimeUs});
+    runStartUs_ = now;
+  }
 
   CancelGuard guard(task().get(), &state_, [&](StopReason reason) {
     // This is run on error or cancel exit.
@@ -538,6 +641,8 @@ StopReason Driver::runInternal(
     }
     close();
   });
+  // Ends the run on the timeline before 'guard' takes the driver off thread.
+  auto runEndGuard = folly::makeGuard([this]() { recordRunEnd(); });
 
   try {
     // Invoked to initialize the operators once before driver starts execution.
@@ -632,6 +737,7 @@ StopReason Driver::runInternal(
                     auto elapsedSelfTime = processLazyTiming(*op, elapsedTime);
                     op->stats().wlock()->getOutputTiming.add(elapsedSelfTime);
                   });
+              auto counters = createDeltaHardwareCounters(op);
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
               CALL_OPERATOR(
@@ -665,6 +771,7 @@ StopReason Driver::runInternal(
                     nextOp->stats().wlock()->addInputTiming.add(
                         elapsedSelfTime);
                   });
+              auto counters = createDeltaHardwareCounters(nextOp);
               {
                 auto lockedStats = nextOp->stats().wlock();
                 lockedStats->addInputVector(
@@ -722,6 +829,7 @@ StopReason Driver::runInternal(
                           processLazyTiming(*op, elapsedTime);
                       op->stats().wlock()->finishTiming.add(elapsedSelfTime);
                     });
+                auto counters = createDeltaHardwareCounters(op);
                 TestValue::adjust(
                     "facebook::velox::exec::Driver::runInternal::noMoreInput",
                     nextOp);
@@ -745,6 +853,7 @@ StopReason Driver::runInternal(
                   auto elapsedSelfTime = processLazyTiming(*op, elapsedTime);
                   op->stats().wlock()->getOutputTiming.add(elapsedSelfTime);
                 });
+            auto counters = createDeltaHardwareCounters(op);
             CALL_OPERATOR(
                 result = op->getOutput(),
                 op,
@@ -820,7 +929,10 @@ void Driver::run(std::shared_ptr<Driver> self) {
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
-  auto reason = self->runInternal(self, blockingState, nullResult);
+  auto reason = [&]() {
+    auto stackSampling = self->startStackSampling();
+    return self->runInternal(self, blockingState, nullResult);
+  }();
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -899,9 +1011,49 @@ void Driver::updateStats() {
     stats.runtimeStats[DriverStats::kTotalOffThreadTime] = RuntimeMetric(
         1'000'000 * state_.totalOffThreadTimeMs, RuntimeCounter::Unit::kNanos);
   }
+  stats.driverId = ctx_->driverId;
+  if (timeline_.enabled()) {
+    stats.runtimeStats[DriverStats::kTotalQueuedTime] = RuntimeMetric(
+        1'000 * timeline_.queuedMicros(), RuntimeCounter::Unit::kNanos);
+    stats.runtimeStats[DriverStats::kTotalOnThreadTime] = RuntimeMetric(
+        1'000 * timeline_.runningMicros(), RuntimeCounter::Unit::kNanos);
+    for (const auto& [reason, micros] : timeline_.blockedMicros()) {
+      stats.runtimeStats[fmt::format(
+          "totalDriverBlocked{}WallNanos",
+          blockingReasonToString(reason).substr(1))] =
+          RuntimeMetric(1'000 * micros, RuntimeCounter::Unit::kNanos);
+    }
+    stats.timeline = timeline_.events();
+  }
   task()->addDriverStats(ctx_->pipelineId, std::move(stats));
 }
 
+void Driver::recordRunEnd() {
+  if (runStartUs_ == 0) {
+    return;
+  }
+  const uint64_t now = getCurrentTimeMicro();
+  timeline_.add(
+      {DriverTimelineEvent::Kind::kRunning, runStartUs_, now - runStartUs_});
+  runStartUs_ = 0;
+}
+
+void Driver::recordBlockedTime(
+    uint64_t startMicros,
+    BlockingReason reason,
+    int32_t operatorId) {
+  if (!timeline_.enabled()) {
+    return;
+  }
+  const uint64_t now = getCurrentTimeMicro();
+  timeline_.add(
+      {DriverTimelineEvent::Kind::kBlocked,
+       startMicros,
+       now > startMicros ? now - startMicros : 0,
+       reason,
+       operatorId});
+}
+
 void Driver::close() {
   if (closed_) {
     // Already closed.
@@ -911,6 +1063,7 @@ void Driver::close() {
     LOG(FATAL) << "Driver::close is only allowed from the Driver's thread";
   }
   closeOperators();
+  recordRunEnd();
   updateStats();
   closed_ = true;
   Task::removeDriver(ctx_->task, this);
@@ -1095,6 +1248,55 @@ std::string Driver::label() const {
   return fmt::format("<Driver {}:{}>", task()->taskId(), ctx_->driverId);
 }
 
+std::string driverTimelineEventKindString(DriverTimelineEvent::Kind kind) {
+  switch (kind) {
+    case DriverTimelineEvent::Kind::kQueued:
+      return "Queued";
+    case DriverTimelineEvent::Kind::kRunning:
+      return "Running";
+    case DriverTimelineEvent::Kind::kBlocked:
+      return "Blocked";
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void DriverTimeline::add(const DriverTimelineEvent& event) {
+  if (!enabled()) {
+    return;
+  }
+  switch (event.kind) {
+    case DriverTimelineEvent::Kind::kQueued:
+      queuedMicros_ += event.durationMicros;
+      break;
+    case DriverTimelineEvent::Kind::kRunning:
+      runningMicros_ += event.durationMicros;
+      break;
+    case DriverTimelineEvent::Kind::kBlocked:
+      blockedMicros_[event.blockingReason] += event.durationMicros;
+      break;
+  }
+  if (events_.size() < maxEvents_) {
+    events_.push_back(event);
+  } else {
+    events_[numEvents_ % maxEvents_] = event;
+  }
+  ++numEvents_;
+}
+
+std::vector<DriverTimelineEvent> DriverTimeline::events() const {
+  if (numEvents_ <= maxEvents_) {
+    return events_;
+  }
+  // The oldest event is in the slot the next event would overwrite.
+  const auto oldest = numEvents_ % maxEvents_;
+  std::vector<DriverTimelineEvent> events;
+  events.reserve(events_.size());
+  events.insert(events.end(), events_.begin() + oldest, events_.end());
+  events.insert(events.end(), events_.begin(), events_.begin() + oldest);
+  return events;
+}
+
 std::string blockingReasonToString(BlockingReason reason) {
   switch (reason) {
     case BlockingReason::kNotBlocked:
@@ -1121,6 +1323,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kYield";
     case BlockingReason::kWaitForArbitration:
       return "kWaitForArbitration";
+    case BlockingReason::kWaitForDynamicFilter:
+      return "kWaitForDynamicFilter";
   }
   VELOX_UNREACHABLE();
   return "";
@@ -22,6 +22,8 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/HardwareCounters.h"
+#include "velox/common/process/StackSampler.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
@@ -62,14 +64,6 @@ std::string stopReasonString(StopReason reason);
 
 std::ostream& operator<<(std::ostream& out, const StopReason& reason);
 
-struct DriverStats {
-  static constexpr const char* kTotalPauseTime = "totalDriverPauseWallNanos";
-  static constexpr const char* kTotalOffThreadTime =
-      "totalDriverOffThreadWallNanos";
-
-  std::unordered_map<std::string, RuntimeMetric> runtimeStats;
-};
-
 /// Represents a Driver's state. This is used for cancellation, forcing
 /// release of and for waiting for memory. The fields are serialized on
 /// the mutex of the Driver's Task.
@@ -214,10 +208,100 @@ enum class BlockingReason {
   /// Operator is blocked waiting for its associated query memory arbitration to
   /// finish.
   kWaitForArbitration,
+  /// TableScan is blocked waiting for dynamic filters from joins in other tasks
+  /// before reading its first split.
+  kWaitForDynamicFilter,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
 
+/// A time interval in the life of a Driver. See DriverTimeline.
+struct DriverTimelineEvent {
+  enum class Kind : uint8_t {
+    /// Enqueued on the executor, waiting for a thread.
+    kQueued,
+    /// On thread.
+    kRunning,
+    /// Off thread, waiting for the future of a blocked operator.
+    kBlocked,
+  };
+
+  Kind kind;
+  /// Start time in microseconds since epoch.
+  uint64_t startMicros;
+  uint64_t durationMicros;
+  /// Why the driver was blocked. kNotBlocked unless 'kind' is kBlocked.
+  BlockingReason blockingReason{BlockingReason::kNotBlocked};
+  /// Id of the operator that blocked the driver. -1 unless 'kind' is kBlocked.
+  int32_t operatorId{-1};
+};
+
+std::string driverTimelineEventKindString(DriverTimelineEvent::Kind kind);
+
+/// Records the state transitions of a Driver. Keeps the last 'maxEvents'
+/// events in a ring buffer, so that the memory is bounded for long running
+/// drivers, and the total time spent in each state over the life of the
+/// driver. Disabled if 'maxEvents' is 0. Events are added by the thread that
+/// runs the driver or, for blocked intervals, by the thread that resumes it,
+/// which never overlap.
+class DriverTimeline {
+ public:
+  explicit DriverTimeline(uint32_t maxEvents = 0) : maxEvents_(maxEvents) {}
+
+  bool enabled() const {
+    return maxEvents_ > 0;
+  }
+
+  void add(const DriverTimelineEvent& event);
+
+  /// Returns the retained events, oldest first.
+  std::vector<DriverTimelineEvent> events() const;
+
+  /// Number of events added, including the ones no longer retained.
+  uint64_t numEvents() const {
+    return numEvents_;
+  }
+
+  uint64_t queuedMicros() const {
+    return queuedMicros_;
+  }
+
+  uint64_t runningMicros() const {
+    return runningMicros_;
+  }
+
+  /// Total blocked time by blocking reason.
+  const std::unordered_map<BlockingReason, uint64_t>& blockedMicros() const {
+    return blockedMicros_;
+  }
+
+ private:
+  uint32_t maxEvents_;
+  std::vector<DriverTimelineEvent> events_;
+  uint64_t numEvents_{0};
+  uint64_t queuedMicros_{0};
+  uint64_t runningMicros_{0};
+  std::unordered_map<BlockingReason, uint64_t> blockedMicros_;
+};
+
+struct DriverStats {
+  static constexpr const char* kTotalPauseTime = "totalDriverPauseWallNanos";
+  static constexpr const char* kTotalOffThreadTime =
+      "totalDriverOffThreadWallNanos";
+  static constexpr const char* kTotalQueuedTime = "totalDriverQueuedWallNanos";
+  static constexpr const char* kTotalOnThreadTime =
+      "totalDriverOnThreadWallNanos";
+
+  std::unordered_map<std::string, RuntimeMetric> runtimeStats;
+
+  /// Id of the driver in its pipeline.
+  int32_t driverId{0};
+
+  /// The last state transitions of the driver, oldest first. Empty unless
+  /// QueryConfig::kDriverTimelineMaxEvents is set.
+  std::vector<DriverTimelineEvent> timeline;
+};
+
 class BlockingState {
  public:
   BlockingState(
@@ -294,6 +378,18 @@ struct DriverCtx {
 
   /// Builds the spill config for the operator with specified 'operatorId'.
   std::optional<common::SpillConfig> makeSpillConfig(int32_t operatorId) const;
+
+  /// Builds the prefix-sort config from the query config.
+  common::PrefixSortConfig prefixSortConfig() const;
+
+  /// Returns the vector pool shared by the operators of the driver if enabled
+  /// by QueryConfig::sharedVectorPoolEnabled(), else nullptr. Created by the
+  /// first call, on a leaf memory pool of its own under the node of
+  /// 'planNodeId'.
+  VectorPool* sharedVectorPool(const core::PlanNodeId& planNodeId);
+
+ private:
+  std::unique_ptr<VectorPool> sharedVectorPool_;
 };
 
 constexpr const char* kOpMethodNone = "";
@@ -430,6 +526,13 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   folly::dynamic toJson() const;
 
+  /// Adds an interval of being blocked by the operator at 'operatorId' to the
+  /// timeline. Called by the thread that resumes the driver.
+  void recordBlockedTime(
+      uint64_t startMicros,
+      BlockingReason reason,
+      int32_t operatorId);
+
   OpCallStatusRaw opCallStatus() const {
     return opCallStatus_();
   }
@@ -484,6 +587,10 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   void updateStats();
 
+  // Adds the interval since the start of the current run on thread, if any,
+  // to the timeline.
+  void recordRunEnd();
+
   void close();
 
   // Push down dynamic filters produced by the operator at the specified
@@ -501,6 +608,31 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  // If 'trackOperatorHardwareCounters_' is true, returns initialized object to
+  // count the CPU hardware events of an operation. The counts are added to the
+  // stats of 'op' upon destruction. Returns null otherwise.
+  auto createDeltaHardwareCounters(Operator* op) {
+    auto func = [op, this](const process::HardwareCounters& counters) {
+      addHardwareCounters(*op, counters);
+    };
+    return trackOperatorHardwareCounters_
+        ? std::make_unique<process::DeltaHardwareCounters<decltype(func)>>(
+              std::move(func))
+        : nullptr;
+  }
+
+  void addHardwareCounters(
+      Operator& op,
+      const process::HardwareCounters& counters);
+
+  // If the task samples stacks, returns an object that samples the calling
+  // thread until destruction. Returns null otherwise.
+  std::unique_ptr<process::StackSampler::ThreadScope> startStackSampling();
+
+  // Returns the stack sampling label of the operator call 'driver' is in.
+  // Called from the sampling signal handler, so only reads atomics.
+  static int32_t stackSamplingLabel(const void* driver);
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -525,6 +657,13 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   // Timer used to track down the time we are sitting in the driver queue.
   size_t queueTimeStartUs_{0};
+
+  // Start of the current run on thread if the timeline is enabled, 0
+  // otherwise.
+  uint64_t runStartUs_{0};
+
+  // State transitions of this driver.
+  DriverTimeline timeline_;
   // Id (index in the vector) of the current operator to run (or the 1st one if
   // we haven't started yet). Used to determine which operator's queueTime we
   // should update.
@@ -537,6 +676,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool trackOperatorHardwareCounters_;
+
+  // True once the names of the stack sampling labels of this driver have been
+  // given to the task's sampler.
+  bool stackSamplingLabelsSet_{false};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DriverExecutor.h"
+
+#include <chrono>
+#include <cmath>
+
+#include <fmt/format.h>
+#include <folly/system/ThreadName.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/process/ProcessBase.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+namespace {
+// A query that has not added work for this long loses its accumulated run
+// time once the executor prunes its shares.
+constexpr uint64_t kShareIdleMs = 60'000;
+
+std::vector<uint64_t> toNanos(const std::vector<uint64_t>& millis) {
+  std::vector<uint64_t> nanos;
+  nanos.reserve(millis.size());
+  for (auto i = 0; i < millis.size(); ++i) {
+    VELOX_CHECK(
+        i == 0 || millis[i] > millis[i - 1],
+        "Level thresholds must be increasing");
+    nanos.push_back(millis[i] * 1'000'000);
+  }
+  return nanos;
+}
+
+uint64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void updateMax(std::atomic_uint64_t& max, uint64_t value) {
+  auto current = max.load(std::memory_order_relaxed);
+  while (value > current &&
+         !max.compare_exchange_weak(
+             current, value, std::memory_order_relaxed)) {
+  }
+}
+} // namespace
+
+std::string DriverExecutor::Stats::toString() const {
+  std::string out;
+  for (auto i = 0; i < levels.size(); ++i) {
+    const auto& level = levels[i];
+    out += fmt::format(
+        "Level {}: runs {}, wall {}, cpu {}, avg queued {}, max queued {}\n",
+        i,
+        level.numRuns,
+        succinctNanos(level.wallNanos),
+        succinctNanos(level.cpuNanos),
+        succinctNanos(
+            level.numRuns == 0 ? 0 : level.queuedNanos / level.numRuns),
+        succinctNanos(level.maxQueuedNanos));
+  }
+  out += fmt::format("Steals: {}", numSteals);
+  return out;
+}
+
+DriverExecutor::DriverExecutor(Options options)
+    : levelThresholdsNanos_(toNanos(options.levelThresholdsMs)),
+      levels_(options.levelThresholdsMs.size() + 1) {
+  VELOX_CHECK_GT(options.numThreads, 0);
+  VELOX_CHECK_GE(options.levelTimeMultiplier, 1);
+  for (auto i = 0; i < levels_.size(); ++i) {
+    levelWeights_.push_back(std::pow(options.levelTimeMultiplier, i));
+  }
+  for (auto i = 0; i < options.numThreads; ++i) {
+    auto worker = std::make_unique<Worker>();
+    worker->queues.resize(levels_.size());
+    workers_.push_back(std::move(worker));
+  }
+  for (auto i = 0; i < options.numThreads; ++i) {
+    workers_[i]->thread = std::thread([this, i]() {
+      folly::setThreadName(fmt::format("DriverExec{}", i));
+      workerLoop(i);
+    });
+  }
+}
+
+DriverExecutor::~DriverExecutor() {
+  {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    stop_ = true;
+  }
+  idleCondition_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void DriverExecutor::add(folly::Func func) {
+  enqueue(
+      Item{std::move(func), nullptr, 0, nowNanos()},
+      nextWorker_++ % workers_.size());
+}
+
+void DriverExecutor::add(
+    const std::string& queryId,
+    uint64_t affinity,
+    folly::Func func) {
+  auto share = getShare(queryId);
+  const auto level = levelOf(share->wallNanos);
+  enqueue(
+      Item{std::move(func), std::move(share), level, nowNanos()},
+      affinity % workers_.size());
+}
+
+int32_t DriverExecutor::levelOf(uint64_t wallNanos) const {
+  return std::upper_bound(
+             levelThresholdsNanos_.begin(),
+             levelThresholdsNanos_.end(),
+             wallNanos) -
+      levelThresholdsNanos_.begin();
+}
+
+int32_t DriverExecutor::queryLevel(const std::string& queryId) const {
+  std::lock_guard<std::mutex> l(sharesMutex_);
+  auto it = shares_.find(queryId);
+  return it == shares_.end() ? 0 : levelOf(it->second->wallNanos);
+}
+
+std::shared_ptr<DriverExecutor::QueryShare> DriverExecutor::getShare(
+    const std::string& queryId) {
+  const auto nowMs = getCurrentTimeMs();
+  std::lock_guard<std::mutex> l(sharesMutex_);
+  auto& share = shares_[queryId];
+  if (share == nullptr) {
+    share = std::make_shared<QueryShare>();
+  }
+  share->lastAddMs = nowMs;
+  auto result = share;
+  if (shares_.size() >= sharesPruneSize_) {
+    // Drops the shares of the queries that have no queued or running work and
+    // have not added any for a while, e.g. finished ones.
+    for (auto it = shares_.begin(); it != shares_.end();) {
+      if (it->second.use_count() == 1 &&
+          nowMs - it->second->lastAddMs > kShareIdleMs) {
+        it = shares_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    sharesPruneSize_ = std::max<size_t>(64, 2 * shares_.size());
+  }
+  return result;
+}
+
+void DriverExecutor::enqueue(Item item, int32_t workerIndex) {
+  auto& level = levels_[item.level];
+  if (level.numQueued.fetch_add(1) == 0) {
+    // A level that had no work gets no credit for the time it was idle.
+    // Otherwise it would run alone until its run time caught up.
+    double minScaled = -1;
+    for (auto i = 0; i < levels_.size(); ++i) {
+      if (i != item.level && levels_[i].numQueued > 0) {
+        const auto scaled = levels_[i].scheduledNanos * levelWeights_[i];
+        if (minScaled < 0 || scaled < minScaled) {
+          minScaled = scaled;
+        }
+      }
+    }
+    if (minScaled > 0) {
+      updateMax(
+          level.scheduledNanos,
+          static_cast<uint64_t>(minScaled / levelWeights_[item.level]));
+    }
+  }
+  {
+    auto& worker = *workers_[workerIndex];
+    std::lock_guard<std::mutex> l(worker.mutex);
+    worker.queues[item.level].push_back(std::move(item));
+  }
+  numQueued_++;
+  {
+    // Serializes with the check of an idle thread before it waits.
+    std::lock_guard<std::mutex> l(idleMutex_);
+  }
+  idleCondition_.notify_one();
+}
+
+bool DriverExecutor::take(Worker& worker, bool front, Item& item) {
+  std::lock_guard<std::mutex> l(worker.mutex);
+  int32_t best = -1;
+  double bestScaled = 0;
+  for (auto i = 0; i < worker.queues.size(); ++i) {
+    if (worker.queues[i].empty()) {
+      continue;
+    }
+    const auto scaled = levels_[i].scheduledNanos * levelWeights_[i];
+    if (best < 0 || scaled < bestScaled) {
+      best = i;
+      bestScaled = scaled;
+    }
+  }
+  if (best < 0) {
+    return false;
+  }
+  auto& queue = worker.queues[best];
+  if (front) {
+    item = std::move(queue.front());
+    queue.pop_front();
+  } else {
+    item = std::move(queue.back());
+    queue.pop_back();
+  }
+  levels_[best].numQueued--;
+  numQueued_--;
+  return true;
+}
+
+void DriverExecutor::run(Item& item) {
+  auto& level = levels_[item.level];
+  const auto startNanos = nowNanos();
+  const auto queuedNanos =
+      startNanos > item.addNanos ? startNanos - item.addNanos : 0;
+  const auto startCpuNanos = process::threadCpuNanos();
+  try {
+    item.func();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "DriverExecutor function threw: " << e.what();
+  }
+  const auto wallNanos = nowNanos() - startNanos;
+  level.numRuns++;
+  level.scheduledNanos += wallNanos;
+  level.wallNanos += wallNanos;
+  level.cpuNanos += process::threadCpuNanos() - startCpuNanos;
+  level.queuedNanos += queuedNanos;
+  updateMax(level.maxQueuedNanos, queuedNanos);
+  if (item.share != nullptr) {
+    item.share->wallNanos += wallNanos;
+  }
+}
+
+void DriverExecutor::workerLoop(int32_t index) {
+  auto& self = *workers_[index];
+  const auto numWorkers = workers_.size();
+  Item item;
+  for (;;) {
+    bool found = take(self, true, item);
+    for (auto i = 1; !found && i < numWorkers; ++i) {
+      found = take(*workers_[(index + i) % numWorkers], false, item);
+      if (found) {
+        numSteals_++;
+      }
+    }
+    if (found) {
+      run(item);
+      item = Item{};
+      continue;
+    }
+    std::unique_lock<std::mutex> l(idleMutex_);
+    idleCondition_.wait(l, [&]() { return stop_ || numQueued_ > 0; });
+    if (stop_ && numQueued_ == 0) {
+      return;
+    }
+  }
+}
+
+DriverExecutor::Stats DriverExecutor::stats() const {
+  Stats stats;
+  stats.levels.resize(levels_.size());
+  for (auto i = 0; i < levels_.size(); ++i) {
+    auto& level = stats.levels[i];
+    level.numRuns = levels_[i].numRuns;
+    level.wallNanos = levels_[i].wallNanos;
+    level.cpuNanos = levels_[i].cpuNanos;
+    level.queuedNanos = levels_[i].queuedNanos;
+    level.maxQueuedNanos = levels_[i].maxQueuedNanos;
+  }
+  stats.numSteals = numSteals_;
+  return stats;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/Executor.h>
+
+namespace facebook::velox::exec {
+
+/// Executor for Drivers that shares the threads fairly between queries. Pass
+/// it as the executor of the QueryCtx. A generic executor runs drivers in FIFO
+/// order, so that a query with many drivers delays all others. Here each query
+/// accumulates the wall time its drivers ran and moves down a multi-level
+/// feedback queue as it does, like the levels of the Presto task executor. A
+/// level gets 'levelTimeMultiplier' times the run time of the next level
+/// while both have work, so short
+/// interactive queries stay on the first level and run ahead of long ones,
+/// which still progress. Drivers yield at kDriverCpuTimeSliceLimitMs, which
+/// bounds how long a run at a lower level can delay a higher one.
+///
+/// Each thread has its own queues. Drivers of a task are added to the thread
+/// chosen by the task, so that the runs of a task stay on the same core while
+/// the threads are balanced. An idle thread steals from the others.
+class DriverExecutor : public folly::Executor {
+ public:
+  struct Options {
+    /// Number of threads.
+    int32_t numThreads{
+        static_cast<int32_t>(std::thread::hardware_concurrency())};
+
+    /// Accumulated run time in ms of a query at which it enters each level
+    /// after the first. Must be increasing.
+    std::vector<uint64_t> levelThresholdsMs{1'000, 10'000, 60'000, 300'000};
+
+    /// Ratio between the run time of a level and the next one when both have
+    /// work.
+    double levelTimeMultiplier{2};
+  };
+
+  struct LevelStats {
+    uint64_t numRuns{0};
+    uint64_t wallNanos{0};
+    uint64_t cpuNanos{0};
+
+    /// Sum and max of the time from add() to the start of the runs.
+    uint64_t queuedNanos{0};
+    uint64_t maxQueuedNanos{0};
+  };
+
+  struct Stats {
+    std::vector<LevelStats> levels;
+
+    /// Number of runs taken from the queues of another thread.
+    uint64_t numSteals{0};
+
+    std::string toString() const;
+  };
+
+  explicit DriverExecutor(Options options);
+
+  /// Runs the work already added and joins the threads.
+  ~DriverExecutor() override;
+
+  /// Runs 'func' on the first level. The time is not charged to a query.
+  void add(folly::Func func) override;
+
+  /// Runs 'func' on behalf of 'queryId' at the level of the query. Prefers the
+  /// thread selected by 'affinity', e.g. a hash of the task.
+  void add(const std::string& queryId, uint64_t affinity, folly::Func func);
+
+  Stats stats() const;
+
+  int32_t numLevels() const {
+    return levels_.size();
+  }
+
+  /// Returns the level of the next runs of 'queryId'.
+  int32_t queryLevel(const std::string& queryId) const;
+
+ private:
+  // Run time of the drivers of one query.
+  struct QueryShare {
+    std::atomic_uint64_t wallNanos{0};
+    std::atomic_uint64_t lastAddMs{0};
+  };
+
+  struct Item {
+    folly::Func func;
+    std::shared_ptr<QueryShare> share;
+    int32_t level;
+    uint64_t addNanos;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    // Queue per level.
+    std::vector<std::deque<Item>> queues;
+    std::thread thread;
+  };
+
+  struct Level {
+    // Run time of the level, scaled by its weight when picking a level. Raised
+    // when the level gets work after being idle.
+    std::atomic_uint64_t scheduledNanos{0};
+    std::atomic_int64_t numQueued{0};
+
+    std::atomic_uint64_t numRuns{0};
+    std::atomic_uint64_t wallNanos{0};
+    std::atomic_uint64_t cpuNanos{0};
+    std::atomic_uint64_t queuedNanos{0};
+    std::atomic_uint64_t maxQueuedNanos{0};
+  };
+
+  int32_t levelOf(uint64_t wallNanos) const;
+
+  std::shared_ptr<QueryShare> getShare(const std::string& queryId);
+
+  void enqueue(Item item, int32_t workerIndex);
+
+  // Takes the item of the level that is furthest behind its share from the
+  // queues of 'worker'. Takes the oldest item if 'front', else the newest.
+  bool take(Worker& worker, bool front, Item& item);
+
+  void run(Item& item);
+
+  void workerLoop(int32_t index);
+
+  const std::vector<uint64_t> levelThresholdsNanos_;
+
+  // Multiplier of the run time of each level when picking the level to run.
+  std::vector<double> levelWeights_;
+
+  std::vector<Level> levels_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::atomic_uint64_t nextWorker_{0};
+
+  std::atomic_uint64_t numSteals_{0};
+
+  // Number of items in all queues. Idle threads wait on 'idleCondition_' for
+  // this to become positive.
+  std::atomic_int64_t numQueued_{0};
+  std::mutex idleMutex_;
+  std::condition_variable idleCondition_;
+  bool stop_{false};
+
+  mutable std::mutex sharesMutex_;
+  std::unordered_map<std::string, std::shared_ptr<QueryShare>> shares_;
+  size_t sharesPruneSize_{64};
+};
+
+} // namespace facebook::velox::exec
@@ -114,6 +114,10 @@ RowVectorPtr Exchange::getOutput() {
     return nullptr;
   }
 
+  if (currentPages_.size() > 1) {
+    presizeResult();
+  }
+
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
   for (const auto& page : currentPages_) {
@@ -140,6 +144,31 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+void Exchange::presizeResult() {
+  int64_t numRows{0};
+  for (const auto& page : currentPages_) {
+    auto pageRows = page->numRows();
+    if (!pageRows.has_value()) {
+      auto inputStream = page->prepareStreamForDeserialize();
+      pageRows = getSerde()->numSerializedRows(&inputStream);
+      if (!pageRows.has_value()) {
+        return;
+      }
+    }
+    numRows += pageRows.value();
+  }
+  if (numRows == 0 || numRows > std::numeric_limits<vector_size_t>::max()) {
+    return;
+  }
+  if (result_ == nullptr) {
+    result_ = BaseVector::create<RowVector>(outputType_, numRows, pool());
+    return;
+  }
+  VectorPtr result = std::move(result_);
+  BaseVector::prepareForReuse(result, numRows);
+  result_ = std::static_pointer_cast<RowVector>(result);
+}
+
 void Exchange::close() {
   SourceOperator::close();
   currentPages_.clear();
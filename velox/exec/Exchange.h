@@ -92,6 +92,11 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  /// Sizes 'result_' for the rows of all of 'currentPages_', so that the
+  /// pages are deserialized into it without growing it page by page. Does
+  /// nothing if the number of rows of a page is not known.
+  void presizeResult();
+
   const uint64_t preferredOutputBatchBytes_;
 
   /// True if this operator is responsible for fetching splits from the Task and
@@ -15,6 +15,8 @@
  */
 #include "velox/exec/ExchangeClient.h"
 
+#include <numeric>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 
@@ -143,6 +145,23 @@ ExchangeClient::next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future) {
   return pages;
 }
 
+void ExchangeClient::setMaxQueuedBytes(int64_t maxQueuedBytes) {
+  VELOX_CHECK_GT(maxQueuedBytes, 0);
+  std::vector<RequestSpec> requestSpecs;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    const bool grows = maxQueuedBytes > maxQueuedBytes_;
+    maxQueuedBytes_ = maxQueuedBytes;
+    if (!grows) {
+      return;
+    }
+    requestSpecs = pickSourcesToRequestLocked();
+  }
+
+  // Outside of lock
+  request(std::move(requestSpecs));
+}
+
 void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   auto self = shared_from_this();
   for (auto& spec : requestSpecs) {
@@ -176,14 +195,18 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
             if (self->closed_) {
               return;
             }
+            if (spec.maxBytes > 0) {
+              self->updateThroughputLocked(
+                  spec.source.get(), response.bytes, requestTimeMs);
+            }
             if (!response.atEnd) {
               if (!response.remainingBytes.empty()) {
                 for (auto bytes : response.remainingBytes) {
                   VELOX_CHECK_GT(bytes, 0);
                 }
-                self->producingSources_.push(
-                    {std::move(spec.source),
-                     std::move(response.remainingBytes)});
+                self->addProducingSourceLocked(
+                    std::move(spec.source),
+                    std::move(response.remainingBytes));
               } else {
                 self->emptySources_.push(std::move(spec.source));
               }
@@ -200,6 +223,51 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   }
 }
 
+void ExchangeClient::addProducingSourceLocked(
+    std::shared_ptr<ExchangeSource> source,
+    std::vector<int64_t> remainingBytes) {
+  const auto totalRemainingBytes =
+      std::accumulate(remainingBytes.begin(), remainingBytes.end(), int64_t{0});
+  producingSources_.push_back(
+      {std::move(source), std::move(remainingBytes), totalRemainingBytes});
+  std::push_heap(
+      producingSources_.begin(), producingSources_.end(), lessRemainingBytes);
+}
+
+ExchangeClient::ProducingSource ExchangeClient::popProducingSourceLocked() {
+  std::pop_heap(
+      producingSources_.begin(), producingSources_.end(), lessRemainingBytes);
+  auto producing = std::move(producingSources_.back());
+  producingSources_.pop_back();
+  return producing;
+}
+
+int64_t ExchangeClient::maxRequestBytesLocked(
+    const ExchangeSource* source) const {
+  auto it = sourceBytesPerMs_.find(source);
+  if (it == sourceBytesPerMs_.end()) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  return it->second * kRequestDataMaxWait.count();
+}
+
+void ExchangeClient::updateThroughputLocked(
+    const ExchangeSource* source,
+    int64_t bytes,
+    uint64_t requestTimeMs) {
+  if (bytes == 0) {
+    // Timed out or at end. Says nothing about the throughput.
+    return;
+  }
+  constexpr double kWeight = 0.5;
+  const double bytesPerMs =
+      static_cast<double>(bytes) / std::max<uint64_t>(1, requestTimeMs);
+  auto [it, inserted] = sourceBytesPerMs_.emplace(source, bytesPerMs);
+  if (!inserted) {
+    it->second = kWeight * bytesPerMs + (1 - kWeight) * it->second;
+  }
+}
+
 std::vector<ExchangeClient::RequestSpec>
 ExchangeClient::pickSourcesToRequestLocked() {
   if (closed_) {
@@ -215,9 +283,13 @@ ExchangeClient::pickSourcesToRequestLocked() {
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
   while (availableSpace > 0 && !producingSources_.empty()) {
-    auto& source = producingSources_.front().source;
+    const auto& producing = producingSources_.front();
+    const auto maxRequestBytes = maxRequestBytesLocked(producing.source.get());
     int64_t requestBytes = 0;
-    for (auto bytes : producingSources_.front().remainingBytes) {
+    for (auto bytes : producing.remainingBytes) {
+      if (requestBytes > 0 && requestBytes + bytes > maxRequestBytes) {
+        break;
+      }
       availableSpace -= bytes;
       if (availableSpace < 0) {
         break;
@@ -228,22 +300,21 @@ ExchangeClient::pickSourcesToRequestLocked() {
       VELOX_CHECK_LT(availableSpace, 0);
       break;
     }
+    auto source = popProducingSourceLocked().source;
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
     totalPendingBytes_ += requestBytes;
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
     // We have full capacity but still cannot initiate one single data transfer.
     // Let the transfer happen in this case to avoid getting stuck.
-    auto& source = producingSources_.front().source;
-    auto requestBytes = producingSources_.front().remainingBytes.at(0);
+    auto producing = popProducingSourceLocked();
+    auto requestBytes = producing.remainingBytes.at(0);
     LOG(INFO) << "Requesting large single page " << requestBytes
               << " bytes, exceeding capacity " << maxQueuedBytes_;
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    VELOX_CHECK(producing.source->shouldRequestLocked());
+    requestSpecs.push_back({std::move(producing.source), requestBytes});
     totalPendingBytes_ += requestBytes;
   }
   return requestSpecs;
@@ -82,6 +82,16 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
     return queue_;
   }
 
+  /// Sets the number of bytes to queue from the producers. If this grows, the
+  /// producers are asked for more data right away. Used to move a shared
+  /// buffer budget between clients, see MergeExchange.
+  void setMaxQueuedBytes(int64_t maxQueuedBytes);
+
+  int64_t maxQueuedBytes() const {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    return maxQueuedBytes_;
+  }
+
   /// Returns up to 'maxBytes' pages of data, but no less than one.
   ///
   /// If no data is available returns empty list and sets 'atEnd' to true if no
@@ -109,8 +119,38 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   struct ProducingSource {
     std::shared_ptr<ExchangeSource> source;
     std::vector<int64_t> remainingBytes;
+    // Sum of 'remainingBytes'.
+    int64_t totalRemainingBytes;
   };
 
+  // Orders 'producingSources_' as a max heap on the bytes buffered at the
+  // source.
+  static bool lessRemainingBytes(
+      const ProducingSource& left,
+      const ProducingSource& right) {
+    return left.totalRemainingBytes < right.totalRemainingBytes;
+  }
+
+  void addProducingSourceLocked(
+      std::shared_ptr<ExchangeSource> source,
+      std::vector<int64_t> remainingBytes);
+
+  // Removes and returns the source with the most bytes buffered.
+  ProducingSource popProducingSourceLocked();
+
+  // Returns the maximum number of bytes to request at once from 'source'.
+  // This is what 'source' has delivered within kRequestDataMaxWait at its
+  // measured throughput, so that slow sources do not hold up the space in
+  // the queue that faster ones could fill.
+  int64_t maxRequestBytesLocked(const ExchangeSource* source) const;
+
+  // Updates the throughput of 'source' with a response of 'bytes' that took
+  // 'requestTimeMs'.
+  void updateThroughputLocked(
+      const ExchangeSource* source,
+      int64_t bytes,
+      uint64_t requestTimeMs);
+
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
   void request(std::vector<RequestSpec>&& requestSpecs);
@@ -118,7 +158,9 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
-  const int64_t maxQueuedBytes_;
+  // The max bytes in 'queue_' and in flight. Guarded by the mutex of
+  // 'queue_'.
+  int64_t maxQueuedBytes_;
   memory::MemoryPool* const pool_;
   folly::Executor* const executor_;
   const std::shared_ptr<ExchangeQueue> queue_;
@@ -130,9 +172,12 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // Total number of bytes in flight.
   int64_t totalPendingBytes_{0};
 
-  // A queue of sources that have returned non-empty response from the latest
-  // request.
-  std::queue<ProducingSource> producingSources_;
+  // A max heap of sources that have returned non-empty response from the
+  // latest request. Sources with the most bytes buffered are requested first.
+  std::vector<ProducingSource> producingSources_;
+  // Exponential moving average of the throughput of each source in bytes per
+  // millisecond, measured on the data requests.
+  folly::F14FastMap<const ExchangeSource*, double> sourceBytesPerMs_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
 };
@@ -111,12 +111,24 @@ bool FilterProject::allInputProcessed() {
     return true;
   }
   if (numProcessedInputRows_ == input_->size()) {
-    input_ = nullptr;
+    releaseInput();
     return true;
   }
   return false;
 }
 
+void FilterProject::releaseInput() {
+  auto* vectorPool = operatorCtx_->execCtx()->vectorPool();
+  if (vectorPool != nullptr && input_.use_count() == 1) {
+    for (auto& child : input_->children()) {
+      if (child != nullptr && child->pool() == vectorPool->pool()) {
+        vectorPool->release(child);
+      }
+    }
+  }
+  input_ = nullptr;
+}
+
 bool FilterProject::isFinished() {
   return noMoreInput_ && allInputProcessed();
 }
@@ -150,8 +162,10 @@ RowVectorPtr FilterProject::getOutput() {
   // evaluate filter
   auto numOut = filter(evalCtx, *rows);
   numProcessedInputRows_ = size;
+  numInputRows_ += size;
+  numOutputRows_ += numOut;
   if (numOut == 0) { // no rows passed the filer
-    input_ = nullptr;
+    releaseInput();
     return nullptr;
   }
 
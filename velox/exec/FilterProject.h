@@ -73,12 +73,24 @@ class FilterProject : public Operator {
 
   void initialize() override;
 
+  /// Returns the fraction of the input rows that passed the filter so far. 1
+  /// if there is no filter or no input yet.
+  double selectivity() const {
+    return numInputRows_ == 0 ? 1.0 : 1.0 * numOutputRows_ / numInputRows_;
+  }
+
  private:
   // Tests if 'numProcessedRows_' equals to the length of input_ and clears
   // outstanding references to input_ if done. Returns true if getOutput
   // should return nullptr.
   bool allInputProcessed();
 
+  // Clears 'input_'. Moves the columns of 'input_' that are allocated from the
+  // vector pool of the operator and no longer referenced elsewhere to the
+  // vector pool. With a vector pool shared by the driver, these are the
+  // results of the FilterProject before this one.
+  void releaseInput();
+
   // Evaluate filter on all rows. Return number of rows that passed the filter.
   // Populate filterEvalCtx_.selectedBits and selectedIndices with the indices
   // of the passing rows if only some rows pass the filter. If all or no rows
@@ -117,5 +129,9 @@ class FilterProject : public Operator {
   // will load c1 only for rows where f(c0) is true. However, c1 identity
   // projection needs all rows.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // Rows in and out of the filter.
+  int64_t numInputRows_{0};
+  int64_t numOutputRows_{0};
 };
 } // namespace facebook::velox::exec
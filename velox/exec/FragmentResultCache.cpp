@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FragmentResultCache.h"
+
+#include <map>
+#include <set>
+#include <shared_mutex>
+
+#include <fmt/format.h>
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/json.h>
+#include <glog/logging.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/ByteStream.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::exec {
+namespace {
+// The prefix of the names of the cache files.
+constexpr std::string_view kFilePrefix = "fragment_result_";
+
+// Removes the plan node ids from the serialized plan node 'node' and its
+// sources.
+void removePlanNodeIds(folly::dynamic& node) {
+  node.erase("id");
+  if (node.count("sources")) {
+    for (auto& source : node["sources"]) {
+      removePlanNodeIds(source);
+    }
+  }
+}
+
+// Adds the ids of the connectors scanned by 'node' and its sources to 'ids'.
+void addConnectorIds(const core::PlanNode& node, std::set<std::string>& ids) {
+  if (auto* scan = dynamic_cast<const core::TableScanNode*>(&node)) {
+    ids.insert(scan->tableHandle()->connectorId());
+  }
+  for (const auto& source : node.sources()) {
+    addConnectorIds(*source, ids);
+  }
+}
+
+// Returns 'values' sorted by key, so that equal configs serialize equally.
+folly::dynamic sortedValues(
+    const std::unordered_map<std::string, std::string>& values) {
+  std::map<std::string, std::string> sorted(values.begin(), values.end());
+  folly::dynamic result = folly::dynamic::array;
+  for (const auto& [key, value] : sorted) {
+    result.push_back(folly::dynamic::array(key, value));
+  }
+  return result;
+}
+} // namespace
+
+std::string FragmentResultCache::Config::toString() const {
+  return fmt::format(
+      "directory:{} maxBytes:{} maxEntryBytes:{}",
+      directory,
+      maxBytes,
+      maxEntryBytes);
+}
+
+void FragmentResultCache::init(const Config& config) {
+  std::unique_lock guard{instanceLock()};
+  auto& instance = instanceRef();
+  if (instance != nullptr) {
+    LOG(WARNING) << "Fragment result cache has already been set";
+    return;
+  }
+  instance =
+      std::unique_ptr<FragmentResultCache>(new FragmentResultCache(config));
+  LOG(INFO) << "Fragment result cache config: " << config.toString();
+}
+
+FragmentResultCache* FragmentResultCache::instance() {
+  std::shared_lock guard{instanceLock()};
+  return instanceRef().get();
+}
+
+FragmentResultCache::FragmentResultCache(const Config& config)
+    : config_(config) {
+  VELOX_CHECK(!config_.directory.empty());
+  filesystems::getFileSystem(config_.directory, nullptr)
+      ->mkdir(config_.directory);
+  removeStaleFiles();
+}
+
+void FragmentResultCache::removeStaleFiles() {
+  auto fs = filesystems::getFileSystem(config_.directory, nullptr);
+  for (const auto& path : fs->list(config_.directory)) {
+    const auto name = path.substr(path.rfind('/') + 1);
+    if (name.compare(0, kFilePrefix.size(), kFilePrefix) == 0) {
+      fs->remove(path);
+    }
+  }
+}
+
+// static
+std::string FragmentResultCache::fragmentKey(
+    const core::PlanNode& fragment,
+    const core::QueryCtx& queryCtx) {
+  auto serialized = fragment.serialize();
+  removePlanNodeIds(serialized);
+  folly::dynamic key = folly::dynamic::object;
+  key["plan"] = std::move(serialized);
+  key["queryConfig"] = sortedValues(queryCtx.queryConfig().values());
+  std::set<std::string> connectorIds;
+  addConnectorIds(fragment, connectorIds);
+  folly::dynamic sessionProperties = folly::dynamic::object;
+  for (const auto& connectorId : connectorIds) {
+    sessionProperties[connectorId] = sortedValues(
+        queryCtx.connectorSessionProperties(connectorId)->values());
+  }
+  key["sessionProperties"] = std::move(sessionProperties);
+  const auto json = folly::toJson(key);
+  uint64_t hash1{0};
+  uint64_t hash2{0};
+  folly::hash::SpookyHashV2::Hash128(json.data(), json.size(), &hash1, &hash2);
+  return fmt::format("{:016x}{:016x}", hash1, hash2);
+}
+
+// static
+std::unique_ptr<folly::IOBuf> FragmentResultCache::serialize(
+    const RowVectorPtr& vector,
+    memory::MemoryPool* pool) {
+  VectorStreamGroup group(pool);
+  group.createStreamTree(asRowType(vector->type()), vector->size());
+  group.append(vector);
+  IOBufOutputStream out(*pool, nullptr, group.size());
+  group.flush(&out);
+  return out.getIOBuf();
+}
+
+std::optional<std::vector<RowVectorPtr>> FragmentResultCache::get(
+    const std::string& key,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) {
+  std::string path;
+  uint64_t size;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      ++stats_.misses;
+      return std::nullopt;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+    path = it->second.path;
+    size = it->second.size;
+  }
+
+  std::string data;
+  try {
+    auto file =
+        filesystems::getFileSystem(path, nullptr)->openFileForRead(path);
+    data = file->pread(0, size);
+  } catch (const std::exception& e) {
+    // The entry may have been evicted while being read.
+    VLOG(1) << "Failed to read fragment result cache file " << path << ": "
+            << e.what();
+    remove(key, path);
+    ++stats_.misses;
+    return std::nullopt;
+  }
+
+  std::vector<RowVectorPtr> vectors;
+  if (!data.empty()) {
+    ByteInputStream input({ByteRange{
+        reinterpret_cast<uint8_t*>(data.data()),
+        static_cast<int32_t>(data.size()),
+        0}});
+    while (!input.atEnd()) {
+      RowVectorPtr vector;
+      VectorStreamGroup::read(&input, pool, type, &vector);
+      vectors.push_back(std::move(vector));
+    }
+  }
+  ++stats_.hits;
+  return vectors;
+}
+
+void FragmentResultCache::put(
+    const std::string& key,
+    const folly::IOBuf& data) {
+  const auto size = data.computeChainDataLength();
+  if (size > config_.maxEntryBytes || size > config_.maxBytes) {
+    return;
+  }
+  std::string path;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (entries_.count(key)) {
+      return;
+    }
+    path = fmt::format("{}/{}{}", config_.directory, kFilePrefix, numFiles_++);
+  }
+
+  auto fs = filesystems::getFileSystem(path, nullptr);
+  try {
+    auto file = fs->openFileForWrite(path);
+    for (const auto& range : data) {
+      file->append(std::string_view(
+          reinterpret_cast<const char*>(range.data()), range.size()));
+    }
+    file->close();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to write fragment result cache file " << path
+                 << ": " << e.what();
+    return;
+  }
+
+  std::vector<std::string> evictedPaths;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (entries_.count(key)) {
+      // Another driver has added the same results.
+      evictedPaths.push_back(path);
+    } else {
+      while (bytes_ + size > config_.maxBytes) {
+        auto it = entries_.find(lru_.back());
+        evictedPaths.push_back(it->second.path);
+        bytes_ -= it->second.size;
+        entries_.erase(it);
+        lru_.pop_back();
+        ++stats_.evictions;
+      }
+      lru_.push_front(key);
+      entries_.emplace(key, Entry{path, size, lru_.begin()});
+      bytes_ += size;
+      ++stats_.writes;
+    }
+  }
+  for (const auto& evictedPath : evictedPaths) {
+    try {
+      fs->remove(evictedPath);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to remove fragment result cache file "
+                   << evictedPath << ": " << e.what();
+    }
+  }
+}
+
+void FragmentResultCache::remove(
+    const std::string& key,
+    const std::string& path) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end() || it->second.path != path) {
+    return;
+  }
+  bytes_ -= it->second.size;
+  lru_.erase(it->second.lruPosition);
+  entries_.erase(it);
+}
+
+uint64_t FragmentResultCache::bytes() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return bytes_;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <folly/SharedMutex.h>
+#include <folly/container/F14Map.h>
+#include <folly/io/IOBuf.h>
+
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryCtx.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Caches the partial aggregation results of single splits in files on local
+/// disk, e.g. on the SSD that backs the SsdCache. A pipeline of a TableScan,
+/// filters and projections and a partial aggregation produces the same
+/// partial results for the same split of an unchanged file. When the same
+/// plan fragment runs again over the split, the results are read from the
+/// cache and the split is not read. See HashAggregation::startSplit().
+///
+/// An entry is keyed on the plan fragment and the split, see makeKey(). The
+/// entries are evicted in LRU order when the total size exceeds 'maxBytes'.
+/// The cache does not outlive the process. The files of earlier processes
+/// are removed by init().
+class FragmentResultCache {
+ public:
+  struct Config {
+    /// The directory of the cache files.
+    std::string directory;
+
+    /// The maximum total size of the cache files.
+    uint64_t maxBytes{10UL << 30};
+
+    /// The maximum serialized size of the results of one split. Larger
+    /// results are not cached.
+    uint64_t maxEntryBytes{64UL << 20};
+
+    std::string toString() const;
+  };
+
+  struct Stats {
+    std::atomic_uint64_t hits{0};
+    std::atomic_uint64_t misses{0};
+    std::atomic_uint64_t writes{0};
+    std::atomic_uint64_t evictions{0};
+  };
+
+  static void init(const Config& config);
+
+  /// Returns the cache or nullptr if init() has not been called.
+  static FragmentResultCache* instance();
+
+  static void testingReset() {
+    instanceRef().reset();
+  }
+
+  /// Returns the part of the cache key that identifies 'fragment', the plan
+  /// node at the end of the cached pipeline, and its sources. The ids of the
+  /// plan nodes are not part of the key. The query config of 'queryCtx' and
+  /// the session properties of the connectors scanned by 'fragment' are, since
+  /// e.g. the session time zone or the legacy behavior flags change the
+  /// results. Throws if a plan node of 'fragment' can't be serialized or the
+  /// session properties of a connector can't be listed. The results are then
+  /// not cached.
+  static std::string fragmentKey(
+      const core::PlanNode& fragment,
+      const core::QueryCtx& queryCtx);
+
+  /// Returns the key of the results of the split with 'splitKey', see
+  /// connector::ConnectorSplit::cacheKey(), in the fragment with
+  /// 'fragmentKey'.
+  static std::string makeKey(
+      const std::string& fragmentKey,
+      const std::string& splitKey) {
+    return fragmentKey + splitKey;
+  }
+
+  /// Returns 'vector' serialized in the format of the cache entries. The
+  /// serialized vectors of a split are chained into one entry.
+  static std::unique_ptr<folly::IOBuf> serialize(
+      const RowVectorPtr& vector,
+      memory::MemoryPool* pool);
+
+  /// Returns the vectors cached for 'key' or std::nullopt if there is no
+  /// entry for 'key'.
+  std::optional<std::vector<RowVectorPtr>> get(
+      const std::string& key,
+      const RowTypePtr& type,
+      memory::MemoryPool* pool);
+
+  /// Adds 'data', a chain of serialized vectors, for 'key'. Does nothing if
+  /// 'key' is already cached or 'data' is larger than 'maxEntryBytes'.
+  void put(const std::string& key, const folly::IOBuf& data);
+
+  uint64_t maxEntryBytes() const {
+    return config_.maxEntryBytes;
+  }
+
+  /// Returns the total size of the cache files.
+  uint64_t bytes() const;
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+ private:
+  struct Entry {
+    std::string path;
+    uint64_t size;
+    // Position in 'lru_'.
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  static folly::SharedMutex& instanceLock() {
+    static folly::SharedMutex mu;
+    return mu;
+  }
+
+  static std::unique_ptr<FragmentResultCache>& instanceRef() {
+    static std::unique_ptr<FragmentResultCache> instance;
+    return instance;
+  }
+
+  explicit FragmentResultCache(const Config& config);
+
+  // Removes the files of an earlier cache in 'config_.directory'.
+  void removeStaleFiles();
+
+  // Removes the entry of 'key' if the cache is still the same as when it was
+  // looked up. Called when the file of the entry can't be read.
+  void remove(const std::string& key, const std::string& path);
+
+  const Config config_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Entry> entries_;
+  // The keys of 'entries_', the most recently used first.
+  std::list<std::string> lru_;
+  uint64_t bytes_{0};
+  // The number of files written. Makes the file names unique.
+  uint64_t numFiles_{0};
+
+  Stats stats_;
+};
+
+} // namespace facebook::velox::exec
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/GroupingSet.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
 
@@ -54,7 +56,8 @@ GroupingSet::GroupingSet(
     tsan_atomic<bool>* nonReclaimableSection,
     OperatorCtx* operatorCtx,
     folly::Synchronized<common::SpillStats>* spillStats)
-    : preGroupedKeyChannels_(std::move(preGroupedKeys)),
+    : inputType_(inputType),
+      preGroupedKeyChannels_(std::move(preGroupedKeys)),
       hashers_(std::move(hashers)),
       isGlobal_(hashers_.empty()),
       isPartial_(isPartial),
@@ -67,7 +70,7 @@ GroupingSet::GroupingSet(
       groupIdChannel_(groupIdChannel),
       spillConfig_(spillConfig),
       nonReclaimableSection_(nonReclaimableSection),
-      stringAllocator_(operatorCtx->pool()),
+      stringAllocator_(operatorCtx->pool(), /*sizeClasses=*/true),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
       pool_(*operatorCtx->pool()),
@@ -108,6 +111,13 @@ GroupingSet::GroupingSet(
       distinctAggregations_.push_back(nullptr);
     }
   }
+
+  // Groups with sorted inputs can't be merged from unsorted spill. Distinct
+  // aggregation needs the sorted merge to tell the groups produced before
+  // spilling. Aggregations over distinct inputs spill their de-duplicated sets
+  // which are merged when a partition is restored.
+  hashPartitionedSpill_ = queryConfig_.aggregationSpillHashPartitioned() &&
+      !isDistinct() && sortedAggregations_ == nullptr;
 }
 
 GroupingSet::~GroupingSet() {
@@ -187,6 +197,26 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   addInputForActiveRows(input, mayPushdown);
 }
 
+vector_size_t GroupingSet::numKeyRuns(const RowVectorPtr& input) const {
+  const auto numRows = input->size();
+  if (numRows == 0) {
+    return 0;
+  }
+  vector_size_t numRuns = 1;
+  for (auto i = 1; i < numRows; ++i) {
+    if (!equalKeys(keyChannels_, input, i - 1, i)) {
+      ++numRuns;
+    }
+  }
+  return numRuns;
+}
+
+void GroupingSet::setInputClustered() {
+  VELOX_CHECK(isPartial_);
+  VELOX_CHECK(!isGlobal_);
+  preGroupedKeyChannels_ = keyChannels_;
+}
+
 void GroupingSet::noMoreInput() {
   noMoreInput_ = true;
 
@@ -790,6 +820,35 @@ void GroupingSet::extractGroups(
   }
 }
 
+void GroupingSet::extractAggregateValues(
+    int32_t aggregateIndex,
+    VectorPtr& result) {
+  VELOX_CHECK(!isPartial_);
+  VELOX_CHECK_LT(aggregateIndex, aggregates_.size());
+  auto& function = aggregates_[aggregateIndex].function;
+  if (result == nullptr) {
+    result = BaseVector::create(function->resultType(), 0, &pool_);
+  }
+  if (table_ == nullptr || table_->numDistinct() == 0) {
+    result->resize(0);
+    return;
+  }
+
+  std::vector<char*> groups(table_->numDistinct());
+  RowContainerIterator iterator;
+  vector_size_t numGroups = 0;
+  while (numGroups < groups.size()) {
+    const auto numListed = table_->rows()->listRows(
+        &iterator, groups.size() - numGroups, groups.data() + numGroups);
+    if (numListed == 0) {
+      break;
+    }
+    numGroups += numListed;
+  }
+  result->resize(numGroups);
+  function->extractValues(groups.data(), numGroups, &result);
+}
+
 void GroupingSet::resetTable() {
   if (table_ != nullptr) {
     table_->clear();
@@ -963,9 +1022,23 @@ void GroupingSet::spill() {
   }
 
   auto* rows = table_->rows();
-  if (!hasSpilled()) {
+  if (!hasSpilled() && hashPartitionedSpill_) {
+    VELOX_DCHECK(pool_.trackUsage());
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kAggregateHashPartitioned,
+        rows,
+        makeSpillType(),
+        HashBitRange(
+            spillConfig_->startPartitionBit,
+            spillConfig_->startPartitionBit + spillConfig_->numPartitionBits),
+        spillConfig_,
+        spillStats_);
+  } else if (!hasSpilled()) {
     VELOX_DCHECK(pool_.trackUsage());
     VELOX_CHECK(numDistinctSpillFilesPerPartition_.empty());
+    VELOX_CHECK(
+        !hasDistinctAggregations(),
+        "Aggregations over distinct inputs only support hash partitioned spill");
     spiller_ = std::make_unique<Spiller>(
         Spiller::Type::kAggregateInput,
         rows,
@@ -1034,6 +1107,9 @@ bool GroupingSet::getOutputWithSpill(
     int32_t maxOutputRows,
     int32_t maxOutputBytes,
     const RowVectorPtr& result) {
+  if (spiller_->type() == Spiller::Type::kAggregateHashPartitioned) {
+    return getOutputWithHashSpill(maxOutputRows, maxOutputBytes, result);
+  }
   if (outputSpillPartition_ == -1) {
     VELOX_CHECK_NULL(mergeRows_);
     VELOX_CHECK(mergeArgs_.empty());
@@ -1075,6 +1151,173 @@ bool GroupingSet::getOutputWithSpill(
   return mergeNext(maxOutputRows, maxOutputBytes, result);
 }
 
+bool GroupingSet::getOutputWithHashSpill(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    const RowVectorPtr& result) {
+  if (outputSpillPartition_ == -1) {
+    VELOX_CHECK_EQ(table_->rows()->numRows(), 0);
+    spiller_->finishSpill(spillPartitionSet_);
+    removeEmptyPartitions(spillPartitionSet_);
+    if (!restoreNextSpillPartition()) {
+      return false;
+    }
+  }
+
+  // @lint-ignore CLANGTIDY
+  char* groups[maxOutputRows];
+  for (;;) {
+    const int32_t numGroups = table_->rows()->listRows(
+        &restoreIterator_, maxOutputRows, maxOutputBytes, groups);
+    if (numGroups > 0) {
+      extractGroups(folly::Range<char**>(groups, numGroups), result);
+      return true;
+    }
+    if (!restoreNextSpillPartition()) {
+      return false;
+    }
+  }
+}
+
+bool GroupingSet::restoreNextSpillPartition() {
+  table_->clear();
+  restoreIterator_.reset();
+  while (!spillPartitionSet_.empty()) {
+    auto it = spillPartitionSet_.begin();
+    const auto startPartitionBit =
+        it->first.partitionBitOffset() + spillConfig_->numPartitionBits;
+    outputSpillPartition_ = it->first.partitionNumber();
+    auto reader = it->second->createUnorderedReader(
+        spillConfig_->readBufferSize,
+        &pool_,
+        spillStats_,
+        SpillReadAheadOptions::fromSpillConfig(*spillConfig_));
+    spillPartitionSet_.erase(it);
+
+    restoreSpillLevelExceeded_ = false;
+    RowVectorPtr input;
+    while (reader->nextBatch(input)) {
+      if (!restoredInputFits(input)) {
+        spillRestoredPartition(startPartitionBit);
+      }
+      addRestoredInput(input);
+    }
+    if (restoreSpiller_ == nullptr) {
+      return true;
+    }
+
+    // The partition did not fit in memory. Its groups are now split between
+    // 'table_' and the sub-partitions, which are aggregated before the
+    // remaining partitions since they have higher partition bits.
+    spillRestoredPartition(startPartitionBit);
+    restoreSpiller_->finishSpill(spillPartitionSet_);
+    restoreSpiller_.reset();
+    removeEmptyPartitions(spillPartitionSet_);
+  }
+  return false;
+}
+
+bool GroupingSet::restoredInputFits(const RowVectorPtr& input) {
+  if (restoreSpillLevelExceeded_ || table_->numDistinct() == 0) {
+    return true;
+  }
+
+  // Test-only spill path.
+  if (testingTriggerSpill(pool_.name())) {
+    return false;
+  }
+
+  // The memory arbitration can't reclaim from 'this' during output, so the
+  // partition is spilled again if the reservation can't be increased.
+  const auto incrementBytes =
+      table_->rows()->sizeIncrement(input->size(), input->estimateFlatSize()) +
+      table_->hashTableSizeIncrease(input->size());
+  if (pool_.availableReservation() > 2 * incrementBytes) {
+    return true;
+  }
+  return pool_.maybeReserve(2 * incrementBytes);
+}
+
+void GroupingSet::addRestoredInput(const RowVectorPtr& input) {
+  // The hashers read the keys from their input channels. The spilled keys are
+  // the leading columns of 'input'.
+  std::vector<VectorPtr> keys(inputType_->size());
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    keys[keyChannels_[i]] = input->childAt(i);
+  }
+  auto keyInput = std::make_shared<RowVector>(
+      &pool_, inputType_, nullptr, input->size(), std::move(keys));
+
+  activeRows_.resize(input->size());
+  activeRows_.setAll();
+  table_->prepareForGroupProbe(
+      *lookup_,
+      keyInput,
+      activeRows_,
+      false,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (lookup_->rows.empty()) {
+    return;
+  }
+  table_->groupProbe(*lookup_);
+
+  auto* groups = lookup_->hits.data();
+  const auto& newGroups = lookup_->newGroups;
+  // The de-duplicated inputs of the distinct aggregations follow the
+  // accumulators of all the aggregates.
+  column_index_t distinctChannel = keyChannels_.size() + aggregates_.size();
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (aggregates_[i].distinct) {
+      if (!newGroups.empty()) {
+        distinctAggregations_[i]->initializeNewGroups(groups, newGroups);
+      }
+      distinctAggregations_[i]->addSpilledInput(
+          groups, input->childAt(distinctChannel++), activeRows_);
+      continue;
+    }
+    auto& function = aggregates_[i].function;
+    if (!newGroups.empty()) {
+      function->initializeNewGroups(groups, newGroups);
+    }
+    tempVectors_ = {input->childAt(keyChannels_.size() + i)};
+    function->addIntermediateResults(groups, activeRows_, tempVectors_, false);
+  }
+  tempVectors_.clear();
+}
+
+void GroupingSet::spillRestoredPartition(uint8_t startPartitionBit) {
+  if (table_->numDistinct() == 0) {
+    return;
+  }
+
+  auto* rows = table_->rows();
+  if (restoreSpiller_ == nullptr) {
+    // Disable spilling if exceeding the max spill level and the query might
+    // run out of memory if the restored partition still can't fit in memory.
+    if (spillConfig_->exceedSpillLevelLimit(startPartitionBit)) {
+      RECORD_METRIC_VALUE(kMetricMaxSpillLevelExceededCount);
+      FB_LOG_EVERY_MS(WARNING, 1'000)
+          << "Exceeded spill level limit: " << spillConfig_->maxSpillLevel
+          << ", and disable spilling for memory pool: " << pool_.name();
+      ++spillStats_->wlock()->spillMaxLevelExceededCount;
+      restoreSpillLevelExceeded_ = true;
+      return;
+    }
+    restoreSpiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kAggregateHashPartitioned,
+        rows,
+        makeSpillType(),
+        HashBitRange(
+            startPartitionBit,
+            startPartitionBit + spillConfig_->numPartitionBits),
+        spillConfig_,
+        spillStats_);
+  }
+  rows->stringAllocator().freezeAndExecute(
+      [&]() { restoreSpiller_->spill(); });
+  table_->clear();
+}
+
 bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_EQ(merge_ == nullptr, outputSpillPartition_ == -1);
   merge_ = nullptr;
@@ -1084,8 +1327,13 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   auto it = spillPartitionSet_.begin();
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
+  // NOTE: all the files are merged at once. mergeNext() needs unique keys in
+  // each file, which the files of an intermediate merge pass don't have.
   merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+      spillConfig_->readBufferSize,
+      &pool_,
+      spillStats_,
+      SpillReadAheadOptions::fromSpillConfig(*spillConfig_));
   spillPartitionSet_.erase(it);
   return true;
 }
@@ -1276,9 +1524,31 @@ void GroupingSet::abandonPartialAggregation() {
       &pool_,
       table_->rows()->stringAllocatorShared());
   initializeAggregates(aggregates_, *intermediateRows_, true);
+
+  // Keep hashers for the same keys in case partial aggregation is resumed.
+  // The table owns the current ones.
+  hashers_.clear();
+  for (const auto& hasher : table_->hashers()) {
+    hashers_.push_back(VectorHasher::create(hasher->type(), hasher->channel()));
+  }
   table_.reset();
 }
 
+void GroupingSet::resumePartialAggregation() {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK_NULL(table_);
+  VELOX_CHECK(!hashers_.empty());
+  abandonedPartialAggregation_ = false;
+  intermediateRows_.reset();
+  intermediateGroups_.clear();
+  intermediateRowNumbers_.clear();
+  firstGroup_.clear();
+  for (auto& aggregate : aggregates_) {
+    aggregate.function->clear();
+  }
+  createHashTable();
+}
+
 namespace {
 // Recursive resize all children.
 
@@ -94,6 +94,12 @@ class GroupingSet {
     return table_ ? table_->numDistinct() : 0;
   }
 
+  /// Extracts the final values of the aggregate at 'aggregateIndex' for all
+  /// the groups in the hash table into 'result'. Leaves the accumulators
+  /// intact, so it must only be used with aggregates whose extractValues()
+  /// has no side effects, e.g. min and max. Not supported for partial output.
+  void extractAggregateValues(int32_t aggregateIndex, VectorPtr& result);
+
   /// Returns number of global grouping sets rows if there is default output.
   std::optional<vector_size_t> numDefaultGlobalGroupingSetRows() const {
     if (hasDefaultGlobalGroupingSetOutput()) {
@@ -111,6 +117,12 @@ class GroupingSet {
   /// 'rowIterator'.
   void spill(const RowContainerIterator& rowIterator);
 
+  /// Returns true if spill(rowIterator) is supported. The spilled output of
+  /// aggregations over distinct inputs can't be merged back.
+  bool canSpillOutput() const {
+    return !hasDistinctAggregations();
+  }
+
   /// Returns the spiller stats including total bytes and rows spilled so far.
   std::optional<common::SpillStats> spilledStats() const {
     if (spiller_ == nullptr) {
@@ -127,6 +139,13 @@ class GroupingSet {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Returns the stats of the allocator of the variable width accumulator
+  /// state.
+  HashStringAllocator::Stats stringAllocatorStats() const {
+    return table_ ? table_->rows()->stringAllocator().stats()
+                  : stringAllocator_.stats();
+  }
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
@@ -136,6 +155,26 @@ class GroupingSet {
   // non-productive. Must be called before toIntermediate() is used.
   void abandonPartialAggregation();
 
+  /// Creates a new hash table after abandonPartialAggregation() so that the
+  /// input is aggregated again. Used to re-check the reduction in case the
+  /// input has become more clustered.
+  void resumePartialAggregation();
+
+  /// Returns the number of runs of equal grouping keys in 'input'.
+  vector_size_t numKeyRuns(const RowVectorPtr& input) const;
+
+  /// Treats the input as clustered on all grouping keys from now on. The
+  /// groups are output whenever the grouping keys change, like for pre-grouped
+  /// keys, so the hash table only holds the groups of the current batch. Only
+  /// valid for partial aggregation since a group that shows up again later is
+  /// output more than once.
+  void setInputClustered();
+
+  /// Returns true if partial aggregation has been abandoned and not resumed.
+  bool abandonedPartialAggregation() const {
+    return abandonedPartialAggregation_;
+  }
+
   /// Translates the raw input in input to accumulators initialized from a
   /// single input row. Passes grouping keys through.
   void toIntermediate(const RowVectorPtr& input, RowVectorPtr& result);
@@ -159,6 +198,14 @@ class GroupingSet {
     return aggregates_.empty();
   }
 
+  // Returns true if any aggregate is computed over distinct inputs.
+  bool hasDistinctAggregations() const {
+    return std::any_of(
+        distinctAggregations_.begin(),
+        distinctAggregations_.end(),
+        [](const auto& aggregation) { return aggregation != nullptr; });
+  }
+
   void addInputForActiveRows(const RowVectorPtr& input, bool mayPushdown);
 
   void addRemainingInput();
@@ -213,6 +260,33 @@ class GroupingSet {
       int32_t maxOutputBytes,
       const RowVectorPtr& result);
 
+  // Produces output from hash partitioned spill. Aggregates one spilled
+  // partition at a time in 'table_' and returns its groups. Returns false when
+  // all the spilled partitions have been processed.
+  bool getOutputWithHashSpill(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      const RowVectorPtr& result);
+
+  // Clears 'table_' and aggregates the next spilled partition into it. A
+  // partition that does not fit in memory is spilled again with the next
+  // partition bits and its sub-partitions are processed first. Returns false
+  // if there are no more spilled partitions.
+  bool restoreNextSpillPartition();
+
+  // Returns true if the groups of spilled 'input' likely fit in memory when
+  // added to 'table_' or if the partition can't be spilled again.
+  bool restoredInputFits(const RowVectorPtr& input);
+
+  // Adds spilled 'input' to 'table_', merging the spilled accumulators into the
+  // groups.
+  void addRestoredInput(const RowVectorPtr& input);
+
+  // Spills 'table_' to the sub-partitions of the spilled partition being
+  // restored, which start at 'startPartitionBit'. Does not spill and disables
+  // further spilling of the partition if this exceeds the max spill level.
+  void spillRestoredPartition(uint8_t startPartitionBit);
+
   // Prepares for the next spill partition for output. It sets
   // 'outputSpillPartition_' to the number of the next spill partition, and
   // creates 'merge_' to read from it. The function returns false if all the
@@ -269,10 +343,13 @@ class GroupingSet {
   // 'toIntermediate'.
   std::vector<Accumulator> accumulators(bool excludeToIntermediate);
 
+  const RowTypePtr inputType_;
+
   std::vector<column_index_t> keyChannels_;
 
-  /// A subset of grouping keys on which the input is clustered.
-  const std::vector<column_index_t> preGroupedKeyChannels_;
+  /// A subset of grouping keys on which the input is clustered. Set to all
+  /// grouping keys by setInputClustered().
+  std::vector<column_index_t> preGroupedKeyChannels_;
 
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   const bool isGlobal_;
@@ -346,6 +423,21 @@ class GroupingSet {
   std::vector<size_t> numDistinctSpillFilesPerPartition_;
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
+  // True if the input is spilled to unsorted hash partitions that are
+  // aggregated one at a time for output instead of merged from sorted runs.
+  bool hashPartitionedSpill_{false};
+
+  // Spills the partition being restored in hash partitioned spill if it does
+  // not fit in memory.
+  std::unique_ptr<Spiller> restoreSpiller_;
+
+  // True if the partition being restored exceeds the max spill level and is
+  // aggregated in memory.
+  bool restoreSpillLevelExceeded_{false};
+
+  // Iterates over the groups of the restored partition in 'table_' for output.
+  RowContainerIterator restoreIterator_;
+
   // Container for materializing batches of output from spilling.
   std::unique_ptr<RowContainer> mergeRows_;
 
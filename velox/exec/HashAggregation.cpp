@@ -15,15 +15,21 @@
  */
 #include "velox/exec/HashAggregation.h"
 #include <optional>
+#include "velox/exec/FilterProject.h"
+#include "velox/exec/FragmentResultCache.h"
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/TableScan.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
+#include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
 
 HashAggregation::HashAggregation(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    const std::shared_ptr<const core::AggregationNode>& aggregationNode)
+    const std::shared_ptr<const core::AggregationNode>& aggregationNode,
+    const std::shared_ptr<const core::TopNNode>& topNNode)
     : Operator(
           driverCtx,
           aggregationNode->outputType(),
@@ -36,6 +42,7 @@ HashAggregation::HashAggregation(
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       aggregationNode_(aggregationNode),
+      topNNode_(topNNode),
       isPartialOutput_(isPartialOutput(aggregationNode->step())),
       isGlobal_(aggregationNode->groupingKeys().empty()),
       isDistinct_(!isGlobal_ && aggregationNode->aggregates().empty()),
@@ -45,6 +52,8 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      abandonPartialAggregationRetryRows_(
+          driverCtx->queryConfig().abandonPartialAggregationRetryRows()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -109,9 +118,130 @@ void HashAggregation::initialize() {
       operatorCtx_.get(),
       &spillStats_);
 
+  initializeTopNPruning(inputType);
+
+  if (isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+      aggregationNode_->preGroupedKeys().empty() &&
+      !aggregationNode_->groupId().has_value() &&
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .partialAggregationDetectClusteredInput()) {
+    numClusteringSampleBatches_ = kNumClusteringSampleBatches;
+  }
+
+  initializeResultCache();
+
   aggregationNode_.reset();
 }
 
+void HashAggregation::initializeResultCache() {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  // A split taken over by another driver is read in parts.
+  if (!queryConfig.fragmentResultCacheEnabled() ||
+      queryConfig.tableScanSplitStealing() || !isPartialOutput_ ||
+      isGlobal_ || isDistinct_ || FragmentResultCache::instance() == nullptr ||
+      !isRegisteredVectorSerde()) {
+    return;
+  }
+  auto* driver = operatorCtx_->driver();
+  auto* tableScan = dynamic_cast<TableScan*>(driver->findOperator(0));
+  if (tableScan == nullptr) {
+    return;
+  }
+  for (auto i = 1; i < operatorId(); ++i) {
+    auto* filterProject = dynamic_cast<FilterProject*>(driver->findOperator(i));
+    if (filterProject == nullptr) {
+      return;
+    }
+    const auto* exprs = filterProject->exprsAndProjection().exprs;
+    if (exprs == nullptr) {
+      return;
+    }
+    for (const auto& expr : exprs->exprs()) {
+      if (!expr->isDeterministic()) {
+        return;
+      }
+    }
+  }
+  try {
+    resultCacheFragmentKey_ = FragmentResultCache::fragmentKey(
+        *aggregationNode_, *operatorCtx_->driverCtx()->task->queryCtx());
+  } catch (const std::exception& e) {
+    VLOG(1) << "Not caching the results of " << planNodeId() << ": "
+            << e.what();
+    return;
+  }
+  tableScan->setResultCacheAggregation(this);
+}
+
+void HashAggregation::initializeTopNPruning(const RowTypePtr& inputType) {
+  if (topNNode_ == nullptr) {
+    return;
+  }
+  const auto topNNode = std::move(topNNode_);
+  if (topNNode->sources()[0].get() != aggregationNode_.get() ||
+      isPartialOutput_ || isGlobal_ || isDistinct_ || topNNode->count() <= 0 ||
+      aggregationNode_->groupId().has_value() ||
+      !aggregationNode_->preGroupedKeys().empty()) {
+    return;
+  }
+
+  const auto& names = aggregationNode_->aggregateNames();
+  const auto it = std::find(
+      names.begin(), names.end(), topNNode->sortingKeys()[0]->name());
+  if (it == names.end()) {
+    return;
+  }
+  const column_index_t aggregateIndex = it - names.begin();
+  const auto& aggregate = aggregationNode_->aggregates()[aggregateIndex];
+  if (aggregate.distinct || aggregate.mask != nullptr ||
+      !aggregate.sortingKeys.empty() || aggregate.call->inputs().size() != 1) {
+    return;
+  }
+
+  // Function names may be qualified with a catalog and schema prefix.
+  auto name = aggregate.call->name();
+  const auto pos = name.rfind('.');
+  if (pos != std::string::npos) {
+    name = name.substr(pos + 1);
+  }
+  const auto& sortOrder = topNNode->sortingOrders()[0];
+  if (!(name == "max" && !sortOrder.isAscending()) &&
+      !(name == "min" && sortOrder.isAscending())) {
+    return;
+  }
+
+  // The dropped rows must not change any other aggregate of the groups that
+  // make it into the top N. This holds only if every aggregate is the same max
+  // or min over the same column.
+  for (const auto& other : aggregationNode_->aggregates()) {
+    if (other.distinct || other.mask != nullptr ||
+        !other.sortingKeys.empty() ||
+        other.call->toString() != aggregate.call->toString()) {
+      return;
+    }
+  }
+
+  const auto field = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+      aggregate.call->inputs()[0]);
+  if (field == nullptr) {
+    return;
+  }
+  const auto inputChannel = exprToChannel(field.get(), inputType);
+  const auto& resultType = outputType_->childAt(
+      aggregationNode_->groupingKeys().size() + aggregateIndex);
+  if (!resultType->isPrimitiveType() ||
+      !inputType->childAt(inputChannel)->equivalent(*resultType)) {
+    return;
+  }
+
+  topNPruning_ = TopNPruning{
+      aggregateIndex,
+      inputChannel,
+      topNNode->count(),
+      CompareFlags{sortOrder.isNullsFirst(), sortOrder.isAscending(), false}};
+}
+
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
   VELOX_CHECK(isPartialOutput_ && !isGlobal_);
   return numInputRows_ > abandonPartialAggregationMinRows_ &&
@@ -124,12 +254,28 @@ void HashAggregation::addInput(RowVectorPtr input) {
     pushdownChecked_ = true;
   }
   if (abandonedPartialAggregation_) {
-    input_ = input;
+    if (abandonPartialAggregationRetryRows_ == 0 ||
+        numInputRows_ < abandonPartialAggregationRetryRows_) {
+      input_ = input;
+      numInputRows_ += input->size();
+      return;
+    }
+    resumePartialAggregation();
+  }
+  if (topNPruning_.has_value()) {
+    const auto numInput = input->size();
+    numInputRows_ += numInput;
+    input = pruneTopNInput(input);
+    if (input == nullptr) {
+      updateRuntimeStats();
+      return;
+    }
+    groupingSet_->addInput(input, mayPushdown_);
+    maybeUpdateTopNThreshold(numInput);
+  } else {
+    groupingSet_->addInput(input, mayPushdown_);
     numInputRows_ += input->size();
-    return;
   }
-  groupingSet_->addInput(input, mayPushdown_);
-  numInputRows_ += input->size();
 
   updateRuntimeStats();
 
@@ -144,6 +290,8 @@ void HashAggregation::addInput(RowVectorPtr input) {
     partialFull_ = true;
   }
 
+  maybeDetectClusteredInput(input);
+
   if (isDistinct_) {
     newDistincts_ = !groupingSet_->hasSpilled() &&
         !groupingSet_->hashLookup().newGroups.empty();
@@ -160,6 +308,118 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+void HashAggregation::maybeDetectClusteredInput(const RowVectorPtr& input) {
+  if (numClusteringSampleBatches_ == 0) {
+    return;
+  }
+  // A flush resets the hash table, so the groups seen so far are no longer
+  // known.
+  if (partialFull_) {
+    numClusteringSampleBatches_ = 0;
+    return;
+  }
+  numKeyRuns_ += groupingSet_->numKeyRuns(input);
+  if (--numClusteringSampleBatches_ > 0) {
+    return;
+  }
+  // With clustered input each group is a single run, except for the runs that
+  // continue from one batch to the next.
+  if (numKeyRuns_ <=
+      groupingSet_->numDistinct() + kNumClusteringSampleBatches - 1) {
+    groupingSet_->setInputClustered();
+    addRuntimeStat("clusteredInput", RuntimeCounter(1));
+  }
+}
+
+RowVectorPtr HashAggregation::pruneTopNInput(const RowVectorPtr& input) {
+  auto& pruning = topNPruning_.value();
+  if (pruning.threshold == nullptr) {
+    return input;
+  }
+
+  const auto numInput = input->size();
+  topNDecoded_.decode(*input->childAt(pruning.inputChannel));
+  const auto* base = topNDecoded_.base();
+  auto indices = allocateIndices(numInput, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numPassed = 0;
+  for (auto i = 0; i < numInput; ++i) {
+    bool keep;
+    if (topNDecoded_.isNullAt(i)) {
+      // Nulls don't change a max or min. A group with no other values ends up
+      // null and stays out of the top N unless nulls sort first.
+      keep = pruning.flags.nullsFirst;
+    } else {
+      keep = base->compare(
+                     pruning.threshold.get(),
+                     topNDecoded_.index(i),
+                     0,
+                     pruning.flags)
+                 .value() <= 0;
+    }
+    if (keep) {
+      rawIndices[numPassed++] = i;
+    }
+  }
+
+  pruning.numPrunedRows += numInput - numPassed;
+  if (numPassed == numInput) {
+    return input;
+  }
+  if (numPassed == 0) {
+    return nullptr;
+  }
+  return wrap(numPassed, std::move(indices), input);
+}
+
+void HashAggregation::maybeUpdateTopNThreshold(vector_size_t numInputRows) {
+  auto& pruning = topNPruning_.value();
+  pruning.numRowsSinceUpdate += numInputRows;
+  const auto numGroups = groupingSet_->numDistinct();
+  if (numGroups < pruning.count ||
+      pruning.numRowsSinceUpdate <
+          std::max(numGroups, kMinTopNThresholdUpdateRows)) {
+    return;
+  }
+  pruning.numRowsSinceUpdate = 0;
+
+  VectorPtr values;
+  groupingSet_->extractAggregateValues(pruning.aggregateIndex, values);
+  std::vector<vector_size_t> candidates;
+  candidates.reserve(values->size());
+  for (auto i = 0; i < values->size(); ++i) {
+    if (!values->isNullAt(i)) {
+      candidates.push_back(i);
+    }
+  }
+  if (candidates.size() < static_cast<size_t>(pruning.count)) {
+    return;
+  }
+
+  std::nth_element(
+      candidates.begin(),
+      candidates.begin() + pruning.count - 1,
+      candidates.end(),
+      [&](vector_size_t left, vector_size_t right) {
+        return values->compare(values.get(), left, right, pruning.flags)
+                   .value() < 0;
+      });
+  const auto nth = candidates[pruning.count - 1];
+
+  // The previous threshold stays valid since group values only move towards
+  // the front of the order, so keep whichever of the two is more selective.
+  // The new one may be less selective after the table has been spilled.
+  if (pruning.threshold != nullptr &&
+      values->compare(pruning.threshold.get(), nth, 0, pruning.flags)
+              .value() >= 0) {
+    return;
+  }
+  if (pruning.threshold == nullptr) {
+    pruning.threshold = BaseVector::create(values->type(), 1, pool());
+  }
+  pruning.threshold->copy(values.get(), 0, nth, 1);
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -188,6 +448,32 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (topNPruning_.has_value() && topNPruning_->numPrunedRows != 0) {
+    runtimeStats["topNPrunedRows"] =
+        RuntimeMetric(topNPruning_->numPrunedRows);
+  }
+  if (hashTableStats.numProbeCostRehashes != 0) {
+    runtimeStats[BaseHashTable::kNumProbeCostRehashes] =
+        RuntimeMetric(hashTableStats.numProbeCostRehashes);
+  }
+  const auto allocatorStats = groupingSet_->stringAllocatorStats();
+  if (allocatorStats.numSizeClassAllocs != 0) {
+    runtimeStats["stringAllocator.freeBytes"] = RuntimeMetric(
+        allocatorStats.freeBytes, RuntimeCounter::Unit::kBytes);
+    runtimeStats["stringAllocator.sizeClassBytes"] = RuntimeMetric(
+        allocatorStats.sizeClassBytes, RuntimeCounter::Unit::kBytes);
+    runtimeStats["stringAllocator.numSizeClassAllocs"] =
+        RuntimeMetric(allocatorStats.numSizeClassAllocs);
+  }
+  const auto& probeCost = groupingSet_->hashLookup().probeCost;
+  if (probeCost.numProbes != 0) {
+    runtimeStats[BaseHashTable::kNumSampledProbes] =
+        RuntimeMetric(probeCost.numProbes);
+    runtimeStats[BaseHashTable::kProbeBucketHops] =
+        RuntimeMetric(probeCost.numBucketHops);
+    runtimeStats[BaseHashTable::kProbeTagMismatches] =
+        RuntimeMetric(probeCost.numTagMismatches);
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -263,7 +549,97 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
           maxPartialAggregationMemoryUsage_, RuntimeCounter::Unit::kBytes));
 }
 
+void HashAggregation::resumePartialAggregation() {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK_NULL(input_);
+  groupingSet_->resumePartialAggregation();
+  abandonedPartialAggregation_ = false;
+  // The reduction is measured again from scratch. If it is still too low,
+  // partial aggregation is abandoned after 'abandonPartialAggregationMinRows_'
+  // input rows.
+  numInputRows_ = 0;
+  numOutputRows_ = 0;
+  addRuntimeStat("resumedPartialAggregation", RuntimeCounter(1));
+}
+
 RowVectorPtr HashAggregation::getOutput() {
+  if (!cachedOutput_.empty()) {
+    auto output = std::move(cachedOutput_.front());
+    cachedOutput_.pop_front();
+    return output;
+  }
+  auto output = getAggregationOutput();
+  if (output != nullptr) {
+    recordSplitResult(output);
+  }
+  maybeFinishSplit();
+  return output;
+}
+
+bool HashAggregation::startSplit(const std::string& splitKey) {
+  VELOX_CHECK(!resultCacheFragmentKey_.empty());
+  VELOX_CHECK(readyForSplit());
+  VELOX_CHECK(splitResultKey_.empty());
+  auto key = FragmentResultCache::makeKey(resultCacheFragmentKey_, splitKey);
+  auto cached = FragmentResultCache::instance()->get(key, outputType_, pool());
+  if (cached.has_value()) {
+    cachedOutput_.insert(
+        cachedOutput_.end(),
+        std::make_move_iterator(cached->begin()),
+        std::make_move_iterator(cached->end()));
+    return true;
+  }
+  splitResultKey_ = std::move(key);
+  return false;
+}
+
+void HashAggregation::finishSplit() {
+  finishingSplit_ = true;
+  if (!abandonedPartialAggregation_ && groupingSet_->numDistinct() > 0) {
+    partialFull_ = true;
+  }
+  maybeFinishSplit();
+}
+
+void HashAggregation::abandonSplitResult() {
+  splitResultKey_.clear();
+  splitResult_.reset();
+  splitResultBytes_ = 0;
+}
+
+void HashAggregation::recordSplitResult(const RowVectorPtr& output) {
+  if (splitResultKey_.empty()) {
+    return;
+  }
+  auto serialized = FragmentResultCache::serialize(output, pool());
+  splitResultBytes_ += serialized->computeChainDataLength();
+  if (splitResultBytes_ > FragmentResultCache::instance()->maxEntryBytes()) {
+    abandonSplitResult();
+    return;
+  }
+  if (splitResult_ == nullptr) {
+    splitResult_ = std::move(serialized);
+  } else {
+    splitResult_->prependChain(std::move(serialized));
+  }
+}
+
+void HashAggregation::maybeFinishSplit() {
+  // The input passed through after abandoning partial aggregation is still
+  // to be returned.
+  if (!finishingSplit_ || partialFull_ || input_ != nullptr) {
+    return;
+  }
+  finishingSplit_ = false;
+  if (!splitResultKey_.empty()) {
+    FragmentResultCache::instance()->put(
+        splitResultKey_,
+        splitResult_ != nullptr ? *splitResult_ : folly::IOBuf());
+  }
+  abandonSplitResult();
+}
+
+RowVectorPtr HashAggregation::getAggregationOutput() {
   if (finished_) {
     input_ = nullptr;
     return nullptr;
@@ -391,6 +767,19 @@ bool HashAggregation::isFinished() {
   return finished_;
 }
 
+bool HashAggregation::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  if (!Operator::reclaimableBytes(reclaimableBytes)) {
+    return false;
+  }
+  // Mirrors the cases in which reclaim() returns without releasing memory.
+  if (noMoreInput_ && groupingSet_ != nullptr &&
+      (groupingSet_->hasSpilled() ||
+       (!isDistinct_ && !groupingSet_->canSpillOutput()))) {
+    reclaimableBytes = 0;
+  }
+  return true;
+}
+
 void HashAggregation::reclaim(
     uint64_t targetBytes,
     memory::MemoryReclaimer::Stats& stats) {
@@ -420,6 +809,15 @@ void HashAggregation::reclaim(
       return;
     }
 
+    if (!groupingSet_->canSpillOutput()) {
+      LOG(WARNING)
+          << "Can't reclaim from aggregation operator over distinct inputs which is under output processing, pool "
+          << pool()->name()
+          << ", memory usage: " << succinctBytes(pool()->usedBytes())
+          << ", reservation: " << succinctBytes(pool()->reservedBytes());
+      return;
+    }
+
     // Spill all the rows starting from the next output row pointed by
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
@@ -438,6 +836,8 @@ void HashAggregation::close() {
   Operator::close();
 
   output_ = nullptr;
+  cachedOutput_.clear();
+  splitResult_.reset();
   groupingSet_.reset();
 }
 
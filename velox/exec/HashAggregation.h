@@ -15,6 +15,10 @@
  */
 #pragma once
 
+#include <deque>
+
+#include <folly/io/IOBuf.h>
+
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -25,7 +29,8 @@ class HashAggregation : public Operator {
   HashAggregation(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      const std::shared_ptr<const core::AggregationNode>& aggregationNode);
+      const std::shared_ptr<const core::AggregationNode>& aggregationNode,
+      const std::shared_ptr<const core::TopNNode>& topNNode = nullptr);
 
   void initialize() override;
 
@@ -45,11 +50,37 @@ class HashAggregation : public Operator {
 
   bool isFinished() override;
 
+  /// Reports no reclaimable bytes while producing output if reclaim() can't
+  /// free any memory so that the memory arbitrator picks another victim.
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
   void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
       override;
 
   void close() override;
 
+  /// Called by the TableScan at the start of the pipeline before it reads a
+  /// split with 'splitKey', see connector::ConnectorSplit::cacheKey(), if the
+  /// results of single splits are cached. Returns true if the results of the
+  /// split are in FragmentResultCache. getOutput() then returns them and the
+  /// split is not read. Otherwise the output of this until finishSplit() is
+  /// cached for the split.
+  bool startSplit(const std::string& splitKey);
+
+  /// Called by the TableScan after the last row of each split. Flushes the
+  /// partial results, so that the results of the next split can be cached.
+  void finishSplit();
+
+  /// Stops recording the output for the split being read, e.g. when a dynamic
+  /// filter drops some of its rows.
+  void abandonSplitResult();
+
+  /// Returns false while the output for an earlier split is pending. The
+  /// TableScan does not start a split before then.
+  bool readyForSplit() const {
+    return cachedOutput_.empty() && !finishingSplit_;
+  }
+
  private:
   void updateRuntimeStats();
 
@@ -70,12 +101,56 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Counts the runs of equal grouping keys in the first input batches of a
+  // partial aggregation. If every group seen so far forms a single run,
+  // switches the grouping set to output groups whenever the keys change.
+  void maybeDetectClusteredInput(const RowVectorPtr& input);
+
+  // Goes back to aggregating the input after partial aggregation has been
+  // abandoned for 'abandonPartialAggregationRetryRows_' input rows.
+  void resumePartialAggregation();
+
   RowVectorPtr getDistinctOutput();
 
+  // Returns the next batch of aggregation results. getOutput() returns the
+  // cached results of splits before these.
+  RowVectorPtr getAggregationOutput();
+
+  // Caches the results of single splits if enabled and the pipeline is a
+  // TableScan, deterministic filters and projections and this. Called from
+  // initialize() while 'aggregationNode_' is still set.
+  void initializeResultCache();
+
+  // Adds 'output' to the results of the split being recorded, if any.
+  void recordSplitResult(const RowVectorPtr& output);
+
+  // Caches the results of the split being recorded once the flush started by
+  // finishSplit() is done.
+  void maybeFinishSplit();
+
   void updateEstimatedOutputRowSize();
 
+  // Enables top-N pruning if 'topNNode_' orders first by a max aggregate
+  // descending or by a min aggregate ascending and there are no other
+  // aggregates over different inputs. Called from initialize() while
+  // 'aggregationNode_' is still set.
+  void initializeTopNPruning(const RowTypePtr& inputType);
+
+  // Returns the rows of 'input' that may still change the top N groups, i.e.
+  // the rows whose aggregate input doesn't sort after the pruning threshold.
+  // Returns nullptr if no rows are left.
+  RowVectorPtr pruneTopNInput(const RowVectorPtr& input);
+
+  // Recomputes the pruning threshold from the groups in the hash table once
+  // enough input has been added since the last update.
+  void maybeUpdateTopNThreshold(vector_size_t numInputRows);
+
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
 
+  // TopN consuming the output of this aggregation in the same pipeline. Only
+  // used in initialize() to set up 'topNPruning_'.
+  std::shared_ptr<const core::TopNNode> topNNode_;
+
   const bool isPartialOutput_;
   const bool isGlobal_;
   const bool isDistinct_;
@@ -86,6 +161,18 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Number of input rows to pass through after abandoning partial aggregation
+  // before trying it again. 0 means never.
+  const int64_t abandonPartialAggregationRetryRows_;
+
+  // Number of input batches to check for clustering on the grouping keys.
+  static constexpr int32_t kNumClusteringSampleBatches = 4;
+
+  // Number of input batches left to check for clustering. 0 if the check is
+  // disabled or has finished.
+  int32_t numClusteringSampleBatches_{0};
+  // Number of runs of equal grouping keys in the checked input batches.
+  int64_t numKeyRuns_{0};
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -114,6 +201,53 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // The part of the FragmentResultCache keys that identifies the pipeline
+  // ending at this. Empty if the results of splits are not cached.
+  std::string resultCacheFragmentKey_;
+
+  // The cache key of the split whose results are being recorded. Empty if
+  // none.
+  std::string splitResultKey_;
+
+  // The serialized output since the start of the split being recorded.
+  std::unique_ptr<folly::IOBuf> splitResult_;
+  uint64_t splitResultBytes_{0};
+
+  // True from finishSplit() until the partial results have been flushed.
+  bool finishingSplit_{false};
+
+  // The cached results of a split. Returned before anything else.
+  std::deque<RowVectorPtr> cachedOutput_;
+
+  // Min number of input rows between updates of the top-N pruning threshold.
+  static constexpr int64_t kMinTopNThresholdUpdateRows = 10'000;
+
+  // State for dropping the input rows of a final aggregation that can't change
+  // the top N groups of the TopN that follows. With a max aggregate and a
+  // descending order, a group's value only grows as input is added. Once N
+  // groups have a value of at least T, any row with a value that sorts after T
+  // can't bring its group into the top N, so it can be dropped.
+  struct TopNPruning {
+    // Index of the max or min aggregate in the grouping set.
+    column_index_t aggregateIndex;
+    // Input channel of the aggregate argument.
+    column_index_t inputChannel;
+    // Number of rows kept by the TopN.
+    int32_t count;
+    // Ordering of the first TopN sorting key.
+    CompareFlags flags;
+    // Single row vector with the N-th best non-null aggregate value across the
+    // groups in the hash table. Null until there are at least N such groups.
+    VectorPtr threshold;
+    // Number of input rows added since the last threshold update.
+    int64_t numRowsSinceUpdate{0};
+    // Number of input rows dropped so far.
+    int64_t numPrunedRows{0};
+  };
+
+  std::optional<TopNPruning> topNPruning_;
+  DecodedVector topNDecoded_;
 };
 
 } // namespace facebook::velox::exec
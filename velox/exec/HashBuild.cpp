@@ -57,7 +57,8 @@ HashBuild::HashBuild(
           operatorId,
           joinNode->id(),
           "HashBuild",
-          joinNode->canSpill(driverCtx->queryConfig())
+          joinNode->canSpill(driverCtx->queryConfig()) &&
+                  !driverCtx->task->isSharedHashBuild(joinNode->id())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       joinNode_(std::move(joinNode)),
@@ -72,6 +73,12 @@ HashBuild::HashBuild(
   VELOX_CHECK_NOT_NULL(joinBridge_);
 
   joinBridge_->addBuilder();
+  // Probes of a shared table would set probed flags in each other's rows.
+  VELOX_USER_CHECK(
+      !operatorCtx_->task()->isSharedHashBuild(planNodeId()) ||
+          !needRightSideJoin(joinType_),
+      "{} join can't share its hash table with other tasks",
+      core::joinTypeName(joinType_));
 
   auto inputType = joinNode_->sources()[1]->outputType();
 
@@ -153,7 +160,13 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        pool(),
+        operatorCtx_->driverCtx()
+            ->queryConfig()
+            .radixPartitionedJoinBuild(),
+        operatorCtx_->driverCtx()
+            ->queryConfig()
+            .hashBuildInternKeyStrings());
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -173,7 +186,13 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .radixPartitionedJoinBuild(),
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .hashBuildInternKeyStrings());
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -184,7 +203,13 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .radixPartitionedJoinBuild(),
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .hashBuildInternKeyStrings());
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
@@ -213,7 +238,10 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   uint8_t startPartitionBit = config->startPartitionBit;
   if (spillPartition != nullptr) {
     spillInputReader_ = spillPartition->createUnorderedReader(
-        config->readBufferSize, pool(), &spillStats_);
+        config->readBufferSize,
+        pool(),
+        &spillStats_,
+        SpillReadAheadOptions::fromSpillConfig(*config));
     startPartitionBit =
         spillPartition->id().partitionBitOffset() + config->numPartitionBits;
     // Disable spilling if exceeding the max spill level and the query might run
@@ -313,6 +341,10 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
 
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
+  if (joinBridge_->reusesSharedTable()) {
+    // The same input is built into a table by another task of the query.
+    return;
+  }
   ensureInputFits(input);
 
   TestValue::adjust("facebook::velox::exec::HashBuild::addInput", this);
@@ -670,6 +702,10 @@ bool HashBuild::finishHashBuild() {
     }
   });
 
+  if (joinBridge_->reusesSharedTable()) {
+    return true;
+  }
+
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -42,6 +42,7 @@ void HashJoinBridge::setHashTable(
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
 
   std::vector<ContinuePromise> promises;
+  std::shared_ptr<BaseHashTable> builtTable;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(started_);
@@ -66,10 +67,13 @@ void HashJoinBridge::setHashTable(
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
         hasNullKeys);
+    builtTable = buildResult_->table;
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
   }
   notify(std::move(promises));
+  maybeShareResult(HashBuildResult(
+      std::move(builtTable), std::nullopt, {}, hasNullKeys));
 }
 
 void HashJoinBridge::setSpilledHashTable(SpillPartitionSet spillPartitionSet) {
@@ -103,6 +107,42 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
     promises = std::move(promises_);
   }
   notify(std::move(promises));
+  maybeShareResult(HashBuildResult{});
+}
+
+void HashJoinBridge::setSharedBuild(
+    std::shared_ptr<SharedHashBuild> sharedBuild,
+    bool builder) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  VELOX_CHECK_NULL(sharedBuild_);
+  sharedBuild_ = std::move(sharedBuild);
+  sharedBuilder_ = builder;
+}
+
+void HashJoinBridge::setSharedHashTable(HashBuildResult result) {
+  VELOX_CHECK(reusesSharedTable());
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!buildResult_.has_value());
+    buildResult_ = std::move(result);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+void HashJoinBridge::maybeShareResult(const HashBuildResult& result) {
+  if (sharedBuild_ != nullptr && sharedBuilder_) {
+    sharedBuild_->setBuildResult(result);
+  }
+}
+
+void HashJoinBridge::cancel() {
+  JoinBridge::cancel();
+  if (sharedBuild_ != nullptr && sharedBuilder_) {
+    sharedBuild_->cancel();
+  }
 }
 
 std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
@@ -185,6 +225,126 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   return SpillInput(std::move(spillShard));
 }
 
+folly::Synchronized<
+    std::unordered_map<std::string, std::weak_ptr<SharedHashBuild>>>
+    SharedHashBuild::instances_;
+
+// static
+std::shared_ptr<SharedHashBuild> SharedHashBuild::getInstance(
+    const std::string& queryId,
+    const core::PlanNodeId& planNodeId) {
+  VELOX_CHECK(!queryId.empty(), "Sharing a hash table needs a query id");
+  auto id = fmt::format("{}:{}", queryId, planNodeId);
+  return instances_.withWLock([&](auto& instances) {
+    auto& weak = instances[id];
+    auto instance = weak.lock();
+    if (!instance) {
+      instance = std::make_shared<SharedHashBuild>(std::move(id), unregister);
+      weak = instance;
+    }
+    return instance;
+  });
+}
+
+// static
+void SharedHashBuild::unregister(SharedHashBuild* sharedBuild) {
+  instances_.withWLock([&](auto& instances) {
+    // A new instance may have replaced 'sharedBuild' after its last reference
+    // went away.
+    auto it = instances.find(sharedBuild->id());
+    if (it != instances.end() && it->second.expired()) {
+      instances.erase(it);
+    }
+  });
+}
+
+SharedHashBuild::~SharedHashBuild() {
+  if (unregisterer_) {
+    unregisterer_(this);
+  }
+}
+
+void SharedHashBuild::addBridge(
+    const std::shared_ptr<HashJoinBridge>& bridge,
+    std::shared_ptr<Task> task) {
+  std::optional<HashJoinBridge::HashBuildResult> result;
+  bool cancelled{false};
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const bool builder = builderTask_ == nullptr;
+    bridge->setSharedBuild(shared_from_this(), builder);
+    if (builder) {
+      VELOX_CHECK_NOT_NULL(task);
+      builderTask_ = std::move(task);
+      return;
+    }
+    if (result_.has_value()) {
+      result = shareResult(result_.value());
+    } else if (cancelled_) {
+      cancelled = true;
+    } else {
+      waitingBridges_.push_back(bridge);
+    }
+  }
+  if (result.has_value()) {
+    bridge->setSharedHashTable(std::move(result.value()));
+  } else if (cancelled) {
+    bridge->cancel();
+  }
+}
+
+void SharedHashBuild::setBuildResult(
+    const HashJoinBridge::HashBuildResult& result) {
+  std::vector<std::shared_ptr<HashJoinBridge>> bridges;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!result_.has_value());
+    VELOX_CHECK(!cancelled_);
+    result_ = result;
+    for (auto& weakBridge : waitingBridges_) {
+      if (auto bridge = weakBridge.lock()) {
+        bridges.push_back(std::move(bridge));
+      }
+    }
+    waitingBridges_.clear();
+  }
+  for (auto& bridge : bridges) {
+    bridge->setSharedHashTable(shareResult(result));
+  }
+}
+
+void SharedHashBuild::cancel() {
+  std::vector<std::shared_ptr<HashJoinBridge>> bridges;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (result_.has_value() || cancelled_) {
+      return;
+    }
+    cancelled_ = true;
+    for (auto& weakBridge : waitingBridges_) {
+      if (auto bridge = weakBridge.lock()) {
+        bridges.push_back(std::move(bridge));
+      }
+    }
+    waitingBridges_.clear();
+  }
+  for (auto& bridge : bridges) {
+    bridge->cancel();
+  }
+}
+
+HashJoinBridge::HashBuildResult SharedHashBuild::shareResult(
+    const HashJoinBridge::HashBuildResult& result) {
+  auto sharedResult = result;
+  if (result.table != nullptr) {
+    // Shares ownership with 'this', which holds the table and the task whose
+    // pools the table is allocated from.
+    sharedResult.table =
+        std::shared_ptr<BaseHashTable>(shared_from_this(), result.table.get());
+  }
+  return sharedResult;
+}
+
 bool isLeftNullAwareJoinWithFilter(
     const std::shared_ptr<const core::HashJoinNode>& joinNode) {
   return (joinNode->isAntiJoin() || joinNode->isLeftSemiProjectJoin() ||
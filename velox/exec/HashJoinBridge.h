@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Synchronized.h>
+
 #include "velox/exec/HashTable.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -26,6 +28,9 @@ namespace test {
 class HashJoinBridgeTestHelper;
 }
 
+class SharedHashBuild;
+class Task;
+
 /// Hands over a hash table from a multi-threaded build pipeline to a
 /// multi-threaded probe pipeline. This is owned by shared_ptr by all the build
 /// and probe Operator instances concerned. Corresponds to the Presto concept of
@@ -55,6 +60,24 @@ class HashJoinBridge : public JoinBridge {
 
   void setAntiJoinHasNullKeys();
 
+  /// Invoked by SharedHashBuild when the task of 'this' joins in sharing the
+  /// table of a broadcast join. If 'builder' is true, the task builds the table
+  /// and also hands it to 'sharedBuild'. Otherwise, the table comes from
+  /// 'sharedBuild' and the HashBuild operators of the task drop their input.
+  void setSharedBuild(
+      std::shared_ptr<SharedHashBuild> sharedBuild,
+      bool builder);
+
+  /// Returns true if the table is built by another task of the same query and
+  /// received through setSharedHashTable().
+  bool reusesSharedTable() const {
+    return sharedBuild_ != nullptr && !sharedBuilder_;
+  }
+
+  /// Cancels 'this' and, if the task of 'this' builds a shared table that has
+  /// not been set yet, the tasks waiting for the table.
+  void cancel() override;
+
   /// Represents the result of HashBuild operators: a hash table, an optional
   /// restored spill partition id associated with the table, and the spilled
   /// partitions while building the table if not empty. In case of an anti join,
@@ -112,9 +135,24 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartition' will be set to null in the returned SpillInput.
   std::optional<SpillInput> spillInputOrFuture(ContinueFuture* future);
 
+  /// Invoked by SharedHashBuild to set the table built by another task of the
+  /// query. This may happen before start().
+  void setSharedHashTable(HashBuildResult result);
+
  private:
+  // Hands 'result' over to 'sharedBuild_' if the task of 'this' builds the
+  // shared table.
+  void maybeShareResult(const HashBuildResult& result);
+
   uint32_t numBuilders_{0};
 
+  // Set if the table is shared with other tasks of the query. Not changed
+  // after the task starts.
+  std::shared_ptr<SharedHashBuild> sharedBuild_;
+
+  // True if the task of 'this' builds the shared table.
+  bool sharedBuilder_{false};
+
   std::optional<HashBuildResult> buildResult_;
 
   // restoringSpillPartitionXxx member variables are populated by the
@@ -140,6 +178,79 @@ class HashJoinBridge : public JoinBridge {
   friend test::HashJoinBridgeTestHelper;
 };
 
+/// Shares the hash table of a broadcast join between the tasks of one query
+/// that run the same plan fragment in this process. All these tasks receive the
+/// same build side input. The first task to start builds the table and the
+/// others probe it read-only instead of building copies of their own, so that
+/// the table is built once and its memory is charged once, to the building
+/// task. Dynamic filters are still made by each probe from the shared table.
+///
+/// Instances are owned by shared_ptr by the HashJoinBridges of the
+/// participating tasks and referenced from a process-wide map from query and
+/// plan node id to weak_ptr. The building task is kept alive until the last
+/// participant is done since the table memory belongs to its pools. Spilling
+/// is disabled for shared tables and joins that mark probed build rows cannot
+/// share a table.
+class SharedHashBuild : public std::enable_shared_from_this<SharedHashBuild> {
+ public:
+  /// Returns the instance for the join 'planNodeId' of 'queryId'. Different
+  /// tasks of the query get the same instance as long as one of them holds it.
+  static std::shared_ptr<SharedHashBuild> getInstance(
+      const std::string& queryId,
+      const core::PlanNodeId& planNodeId);
+
+  SharedHashBuild(
+      std::string id,
+      std::function<void(SharedHashBuild*)> unregisterer)
+      : id_(std::move(id)), unregisterer_(std::move(unregisterer)) {}
+
+  ~SharedHashBuild();
+
+  const std::string& id() const {
+    return id_;
+  }
+
+  /// Adds 'bridge' of 'task'. The first task to be added builds the table. The
+  /// others get the table set on their bridge once it is built.
+  void addBridge(
+      const std::shared_ptr<HashJoinBridge>& bridge,
+      std::shared_ptr<Task> task);
+
+  /// Invoked by the bridge of the building task with the built table.
+  void setBuildResult(const HashJoinBridge::HashBuildResult& result);
+
+  /// Invoked by the bridge of the building task if it is cancelled. Cancels the
+  /// bridges waiting for the table if the table has not been set.
+  void cancel();
+
+ private:
+  static void unregister(SharedHashBuild* sharedBuild);
+
+  // Returns 'result' with a table that keeps 'this' alive.
+  HashJoinBridge::HashBuildResult shareResult(
+      const HashJoinBridge::HashBuildResult& result);
+
+  static folly::Synchronized<
+      std::unordered_map<std::string, std::weak_ptr<SharedHashBuild>>>
+      instances_;
+
+  const std::string id_;
+  const std::function<void(SharedHashBuild*)> unregisterer_;
+
+  std::mutex mutex_;
+
+  // The building task. Declared before 'result_' so that the table is freed
+  // before the pools it is allocated from.
+  std::shared_ptr<Task> builderTask_;
+
+  std::optional<HashJoinBridge::HashBuildResult> result_;
+
+  bool cancelled_{false};
+
+  // The bridges of the tasks waiting for the table.
+  std::vector<std::weak_ptr<HashJoinBridge>> waitingBridges_;
+};
+
 // Indicates if 'joinNode' is null-aware anti or left semi project join type and
 // has filter set.
 bool isLeftNullAwareJoinWithFilter(
@@ -17,6 +17,26 @@
 #include <velox/exec/VectorHasher.h>
 
 namespace facebook::velox::exec {
+namespace {
+// Returns the multiplier for fastMod() by 'divisor'.
+uint128_t fastModMultiplier(uint64_t divisor) {
+  return static_cast<uint128_t>(-1) / divisor + 1;
+}
+
+// Returns 'value' % 'divisor' with three multiplications instead of a 64 bit
+// division, using the multiplier from fastModMultiplier(). Exact for all
+// 64 bit 'value' and 'divisor'. See Lemire, Kaser, Kurz: Faster Remainder by
+// Direct Computation.
+FOLLY_ALWAYS_INLINE uint64_t
+fastMod(uint64_t value, uint128_t multiplier, uint64_t divisor) {
+  const uint128_t lowBits = multiplier * value;
+  const uint128_t bottom =
+      ((lowBits & std::numeric_limits<uint64_t>::max()) * divisor) >> 64;
+  const uint128_t top = (lowBits >> 64) * divisor;
+  return (bottom + top) >> 64;
+}
+} // namespace
+
 HashPartitionFunction::HashPartitionFunction(
     int numPartitions,
     const RowTypePtr& inputType,
@@ -42,6 +62,9 @@ void HashPartitionFunction::init(
     const RowTypePtr& inputType,
     const std::vector<column_index_t>& keyChannels,
     const std::vector<VectorPtr>& constValues) {
+  if (!hashBitRange_.has_value() && numPartitions_ > 0) {
+    modMultiplier_ = fastModMultiplier(numPartitions_);
+  }
   hashers_.reserve(keyChannels.size());
   size_t constChannel{0};
   for (const auto channel : keyChannels) {
@@ -83,9 +106,14 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     for (auto i = 0; i < size; ++i) {
       partitions[i] = hashBitRange_->partition(hashes_[i]);
     }
+  } else if (bits::isPowerOfTwo(numPartitions_)) {
+    const uint64_t mask = numPartitions_ - 1;
+    for (auto i = 0; i < size; ++i) {
+      partitions[i] = hashes_[i] & mask;
+    }
   } else {
     for (auto i = 0; i < size; ++i) {
-      partitions[i] = hashes_[i] % numPartitions_;
+      partitions[i] = fastMod(hashes_[i], modMultiplier_, numPartitions_);
     }
   }
 
@@ -18,6 +18,7 @@
 #include <velox/exec/HashBitRange.h>
 #include <velox/exec/VectorHasher.h>
 #include "velox/core/PlanNode.h"
+#include "velox/type/HugeInt.h"
 
 namespace facebook::velox::exec {
 
@@ -59,6 +60,9 @@ class HashPartitionFunction : public core::PartitionFunction {
 
   const int numPartitions_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
+  // Multiplier for computing hash % 'numPartitions_' without a division. Used
+  // if 'hashBitRange_' is not set and 'numPartitions_' is not a power of 2.
+  uint128_t modMultiplier_{0};
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
   // Reusable memory.
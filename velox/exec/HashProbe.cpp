@@ -21,6 +21,7 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/vector/LazyVector.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -83,6 +84,58 @@ void extractColumns(
   }
 }
 
+// Loads a build side column of the probe output from the rows of a hash
+// table. Holds a reference to the table so that the rows stay valid as long
+// as the LazyVector is referenced.
+class BuildColumnLoader : public VectorLoader {
+ public:
+  BuildColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      std::shared_ptr<const std::vector<char*>> rows,
+      column_index_t column,
+      memory::MemoryPool* pool)
+      : table_(std::move(table)),
+        rows_(std::move(rows)),
+        column_(column),
+        pool_(pool) {}
+
+ protected:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    // Aggregation pushdown only applies to the columns of a table scan
+    // followed by filters.
+    VELOX_CHECK_NULL(hook, "BuildColumnLoader doesn't support ValueHook");
+    VELOX_CHECK_LE(resultSize, rows_->size());
+    const auto& type = table_->rows()->columnTypes()[column_];
+    if (!*result || !result->unique() || !(*result)->isFlatEncoding()) {
+      *result = BaseVector::create(type, resultSize, pool_);
+    } else {
+      (*result)->resize(resultSize);
+    }
+    if (rows.size() == resultSize) {
+      table_->rows()->extractColumn(
+          rows_->data(), resultSize, column_, *result);
+      return;
+    }
+    // Only extracts the requested rows. The rest are left null.
+    std::vector<char*> selectedRows(resultSize, nullptr);
+    for (auto row : rows) {
+      selectedRows[row] = (*rows_)[row];
+    }
+    table_->rows()->extractColumn(
+        selectedRows.data(), resultSize, column_, *result);
+  }
+
+ private:
+  const std::shared_ptr<BaseHashTable> table_;
+  const std::shared_ptr<const std::vector<char*>> rows_;
+  const column_index_t column_;
+  memory::MemoryPool* const pool_;
+};
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -120,7 +173,8 @@ HashProbe::HashProbe(
           operatorId,
           joinNode->id(),
           "HashProbe",
-          joinNode->canSpill(driverCtx->queryConfig())
+          joinNode->canSpill(driverCtx->queryConfig()) &&
+                  !driverCtx->task->isSharedHashBuild(joinNode->id())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       outputBatchSize_{outputBatchRows()},
@@ -150,6 +204,11 @@ void HashProbe::initialize() {
 
   VELOX_CHECK_NULL(lookup_);
   lookup_ = std::make_unique<HashLookup>(hashers_);
+  lookup_->groupPrefetch =
+      operatorCtx_->driverCtx()->queryConfig().hashProbeGroupPrefetch();
+  lazyBuildColumns_ =
+      operatorCtx_->driverCtx()->queryConfig().hashProbeLazyBuildColumns() &&
+      !canSpill();
   auto buildType = joinNode_->sources()[1]->outputType();
   auto tableType = makeTableType(buildType.get(), joinNode_->rightKeys());
   if (joinNode_->filter()) {
@@ -279,7 +338,10 @@ void HashProbe::maybeSetupSpillInputReader(
   auto partition = std::move(iter->second);
   VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
   spillInputReader_ = partition->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      SpillReadAheadOptions::fromSpillConfig(*spillConfig_));
   spillPartitionSet_.erase(iter);
 }
 
@@ -310,6 +372,7 @@ void HashProbe::asyncWaitForHashTable() {
 
   table_ = std::move(hashBuildResult->table);
   VELOX_CHECK_NOT_NULL(table_);
+  resetDictionaryHits();
 
   maybeSetupSpillInputReader(hashBuildResult->restoredPartitionId);
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
@@ -331,11 +394,12 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
-    // push down.
+    // push down. The keys of a table in kHash mode are not tracked by the
+    // hashers. These and keys with too many distinct values get a bloom
+    // filter built from the table instead.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
@@ -349,14 +413,43 @@ void HashProbe::asyncWaitForHashTable() {
     // nulls on the probe side. Hence, cannot filter these out.
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
+    auto makeKeyFilter = [&](auto keyIndex) {
+      std::unique_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[keyIndex]->getFilter(nullAllowed);
+      }
+      if (filter == nullptr) {
+        filter = table_->keyBloomFilter(keyIndex, nullAllowed);
+      }
+      return filter;
+    };
+
     for (auto i = 0; i < keyChannels_.size(); ++i) {
       if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
+        if (auto filter = makeKeyFilter(i)) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
         }
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
+
+    // Record filters on all the join keys for probe side scans in other
+    // tasks. The table covers only one split group with grouped execution.
+    auto* task = operatorCtx_->task().get();
+    if (operatorCtx_->driverCtx()->queryConfig().exportJoinDynamicFilters() &&
+        task->isUngroupedExecution()) {
+      std::map<std::string, std::shared_ptr<common::Filter>> exportedFilters;
+      for (auto i = 0; i < keyChannels_.size(); ++i) {
+        if (auto filter = makeKeyFilter(i)) {
+          exportedFilters.emplace(
+              probeType_->nameOf(keyChannels_[i]), std::move(filter));
+        }
+      }
+      if (!exportedFilters.empty()) {
+        task->addExportedDynamicFilters(
+            planNodeId(), std::move(exportedFilters));
+      }
+    }
   }
 }
 
@@ -536,9 +629,12 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBigintValuesUsingBloomFilter) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -644,7 +740,7 @@ void HashProbe::addInput(RowVectorPtr input) {
     hits.resize(numInput);
     std::fill(hits.data(), hits.data() + numInput, nullptr);
     if (!lookup_->rows.empty()) {
-      table_->joinProbe(*lookup_);
+      joinProbe();
     }
 
     // Update lookup_->rows to include all input rows, not just
@@ -658,11 +754,81 @@ void HashProbe::addInput(RowVectorPtr input) {
       return;
     }
     lookup_->hits.resize(lookup_->rows.back() + 1);
-    table_->joinProbe(*lookup_);
+    joinProbe();
   }
   results_.reset(*lookup_);
 }
 
+void HashProbe::joinProbe() {
+  if (!probeDictionaryKey()) {
+    table_->joinProbe(*lookup_);
+  }
+}
+
+bool HashProbe::probeDictionaryKey() {
+  if (hashers_.size() != 1) {
+    return false;
+  }
+  const auto& decoded = hashers_[0]->decodedVector();
+  if (decoded.isIdentityMapping() || decoded.isConstantMapping()) {
+    return false;
+  }
+  const auto* key = input_->childAt(hashers_[0]->channel())->loadedVector();
+  if (key->encoding() != VectorEncoding::Simple::DICTIONARY ||
+      key->valueVector().get() != decoded.base()) {
+    return false;
+  }
+
+  const auto& dictionary = key->valueVector();
+  const auto numEntries = dictionary->size();
+  auto& rows = lookup_->rows;
+  if (dictionaryHits_.dictionary.lock() != dictionary) {
+    resetDictionaryHits();
+    dictionaryHits_.dictionary = dictionary;
+    // For the first batch over a dictionary, probing per entry pays off only
+    // if the batch has more rows than the dictionary has entries.
+    if (rows.size() <= numEntries) {
+      return false;
+    }
+  }
+  if (dictionaryHits_.hits.size() != numEntries) {
+    dictionaryHits_.hits.resize(numEntries);
+    dictionaryHits_.probed.assign(bits::nwords(numEntries), 0);
+  }
+
+  const auto* indices = decoded.indices();
+  auto* probed = dictionaryHits_.probed.data();
+  auto& probeRows = dictionaryHits_.probeRows;
+  probeRows.clear();
+  for (auto row : rows) {
+    const auto index = indices[row];
+    if (!bits::isBitSet(probed, index)) {
+      bits::setBit(probed, index);
+      probeRows.push_back(row);
+    }
+  }
+
+  auto* hits = lookup_->hits.data();
+  if (!probeRows.empty()) {
+    std::swap(rows, probeRows);
+    table_->joinProbe(*lookup_);
+    std::swap(rows, probeRows);
+    for (auto row : probeRows) {
+      dictionaryHits_.hits[indices[row]] = hits[row];
+    }
+  }
+  for (auto row : rows) {
+    hits[row] = dictionaryHits_.hits[indices[row]];
+  }
+  return true;
+}
+
+void HashProbe::resetDictionaryHits() {
+  dictionaryHits_.dictionary.reset();
+  dictionaryHits_.probed.clear();
+  dictionaryHits_.hits.clear();
+}
+
 void HashProbe::prepareOutput(vector_size_t size) {
   // Try to re-use memory for the output vectors that contain build-side data.
   // We expect output vectors containing probe-side data to be null (reset in
@@ -729,6 +895,13 @@ void HashProbe::fillLeftSemiProjectMatchColumn(vector_size_t size) {
 }
 
 void HashProbe::fillOutput(vector_size_t size) {
+  if (lazyBuildColumns_ && output_ != nullptr) {
+    // The LazyVectors are not reusable. Drops them so that 'prepareOutput'
+    // does not allocate flat vectors in their place.
+    for (const auto& projection : tableOutputProjections_) {
+      output_->childAt(projection.outputChannel) = nullptr;
+    }
+  }
   prepareOutput(size);
 
   for (auto projection : identityProjections_) {
@@ -743,6 +916,8 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
+  } else if (lazyBuildColumns_) {
+    fillLazyBuildColumns(size);
   } else {
     extractColumns(
         table_.get(),
@@ -754,6 +929,24 @@ void HashProbe::fillOutput(vector_size_t size) {
   }
 }
 
+void HashProbe::fillLazyBuildColumns(vector_size_t size) {
+  if (tableOutputProjections_.empty()) {
+    return;
+  }
+  // 'outputTableRows_' is overwritten by the next batch, so the loaders share
+  // a copy of the rows of this batch.
+  auto rows = std::make_shared<const std::vector<char*>>(
+      outputTableRows_.begin(), outputTableRows_.begin() + size);
+  for (const auto& projection : tableOutputProjections_) {
+    output_->childAt(projection.outputChannel) = std::make_shared<LazyVector>(
+        pool(),
+        outputType_->childAt(projection.outputChannel),
+        size,
+        std::make_unique<BuildColumnLoader>(
+            table_, rows, projection.inputChannel, pool()));
+  }
+}
+
 RowVectorPtr HashProbe::getBuildSideOutput() {
   outputTableRows_.resize(outputBatchSize_);
   int32_t numOut;
@@ -1643,6 +1836,7 @@ void HashProbe::reclaim(
       VELOX_CHECK(hasMoreProbeInput);
       probeOp->maybeSetupInputSpiller(spillPartitionIdSet);
     }
+    probeOp->resetDictionaryHits();
     probeOp->pool()->release();
   }
 
@@ -1749,7 +1943,10 @@ void HashProbe::spillOutput() {
     return;
   }
   spillOutputReader_ = outputSpillSet.begin()->second->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      SpillReadAheadOptions::fromSpillConfig(*spillConfig_));
 }
 
 SpillPartitionSet HashProbe::spillTable() {
@@ -1888,6 +2085,18 @@ void HashProbe::prepareTableSpill(
 }
 
 void HashProbe::close() {
+  if (lookup_ != nullptr && lookup_->probeCost.numProbes != 0) {
+    const auto& probeCost = lookup_->probeCost;
+    auto lockedStats = stats_.wlock();
+    lockedStats->addRuntimeStat(
+        BaseHashTable::kNumSampledProbes, RuntimeCounter(probeCost.numProbes));
+    lockedStats->addRuntimeStat(
+        BaseHashTable::kProbeBucketHops,
+        RuntimeCounter(probeCost.numBucketHops));
+    lockedStats->addRuntimeStat(
+        BaseHashTable::kProbeTagMismatches,
+        RuntimeCounter(probeCost.numTagMismatches));
+  }
   Operator::close();
 
   // Free up major memory usage.
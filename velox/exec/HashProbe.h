@@ -109,6 +109,11 @@ class HashProbe : public Operator {
   // Populate output columns.
   void fillOutput(vector_size_t size);
 
+  // Sets the build side columns of 'output_' to LazyVectors that extract the
+  // values of the first 'size' rows in 'outputTableRows_' from 'table_' when
+  // loaded. Used if 'lazyBuildColumns_' is true.
+  void fillLazyBuildColumns(vector_size_t size);
+
   // Populate 'match' output column for the left semi join project,
   void fillLeftSemiProjectMatchColumn(vector_size_t size);
 
@@ -266,6 +271,17 @@ class HashProbe : public Operator {
   /// Decode join key inputs and populate 'nonNullInputRows_'.
   void decodeAndDetectNonNullKeys();
 
+  // Probes 'table_' with the rows of 'lookup_' and sets their hits.
+  void joinProbe();
+
+  // Sets the hits of the rows of 'lookup_' if the single join key is a
+  // dictionary, probing one row per dictionary entry not probed by a previous
+  // batch over the same dictionary. Returns false if the key is not a
+  // dictionary or if probing per entry is not expected to pay off.
+  bool probeDictionaryKey();
+
+  void resetDictionaryHits();
+
   // Invoked when there is no more input from either upstream task or spill
   // input. If there is remaining spilled data, then the last finished probe
   // operator is responsible for notifying the hash build operators to build the
@@ -344,6 +360,24 @@ class HashProbe : public Operator {
 
   std::unique_ptr<HashLookup> lookup_;
 
+  // Hits of the entries of the dictionary of a single dictionary encoded join
+  // key. Readers return consecutive batches of a dictionary encoded column as
+  // dictionaries over the same stripe or row group dictionary, so that each
+  // entry is probed once for all the batches. Reset when 'table_' changes.
+  struct DictionaryHits {
+    std::weak_ptr<BaseVector> dictionary;
+
+    // Bit per dictionary entry, set if the entry has been probed.
+    std::vector<uint64_t> probed;
+
+    // The hit of each probed dictionary entry.
+    raw_vector<char*> hits;
+
+    // The first row of each entry probed by the current batch.
+    raw_vector<vector_size_t> probeRows;
+  };
+  DictionaryHits dictionaryHits_;
+
   // Channel of probe keys in 'input_'.
   std::vector<column_index_t> keyChannels_;
 
@@ -433,6 +467,12 @@ class HashProbe : public Operator {
   // Rows of table found by join probe, later filtered by 'filter_'.
   std::vector<char*> outputTableRows_;
 
+  // If true, the build side columns of the probe output are LazyVectors over a
+  // copy of the matching row pointers. These keep 'table_' alive and are only
+  // extracted if a downstream operator loads them. Not used with spilling
+  // since the table rows are freed when the table is spilled.
+  bool lazyBuildColumns_{false};
+
   // Indicates probe-side rows which should produce a NULL in left semi project
   // with filter.
   SelectivityVector leftSemiProjectIsNull_;
@@ -43,6 +43,98 @@ std::string BaseHashTable::modeString(HashMode mode) {
   }
 }
 
+namespace {
+// Inserts the non-null values of the key at 'keyIndex' of type 'T' in
+// 'rowContainers' into 'bloomFilter' and updates 'min' and 'max'.
+template <typename T>
+void addKeysToBloomFilter(
+    const std::vector<RowContainer*>& rowContainers,
+    int32_t keyIndex,
+    BloomFilter<>& bloomFilter,
+    int64_t& min,
+    int64_t& max) {
+  constexpr int32_t kBatchSize = 1024;
+  std::vector<char*> rows(kBatchSize);
+  for (auto* rowContainer : rowContainers) {
+    const auto column = rowContainer->columnAt(keyIndex);
+    RowContainerIterator iter;
+    while (auto numRows =
+               rowContainer->listRows(&iter, kBatchSize, rows.data())) {
+      for (auto i = 0; i < numRows; ++i) {
+        if (RowContainer::isNullAt(rows[i], column)) {
+          continue;
+        }
+        const int64_t value =
+            *reinterpret_cast<const T*>(rows[i] + column.offset());
+        bloomFilter.insert(common::BigintValuesUsingBloomFilter::hash(value));
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+  }
+}
+
+std::unique_ptr<common::Filter> makeKeyBloomFilter(
+    const std::vector<RowContainer*>& rowContainers,
+    int32_t keyIndex,
+    TypeKind kind,
+    uint64_t numDistinct) {
+  if (numDistinct == 0 ||
+      numDistinct > BaseHashTable::kMaxKeyBloomFilterSize) {
+    return nullptr;
+  }
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(numDistinct);
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  switch (kind) {
+    case TypeKind::TINYINT:
+      addKeysToBloomFilter<int8_t>(
+          rowContainers, keyIndex, *bloomFilter, min, max);
+      break;
+    case TypeKind::SMALLINT:
+      addKeysToBloomFilter<int16_t>(
+          rowContainers, keyIndex, *bloomFilter, min, max);
+      break;
+    case TypeKind::INTEGER:
+      addKeysToBloomFilter<int32_t>(
+          rowContainers, keyIndex, *bloomFilter, min, max);
+      break;
+    case TypeKind::BIGINT:
+      addKeysToBloomFilter<int64_t>(
+          rowContainers, keyIndex, *bloomFilter, min, max);
+      break;
+    default:
+      return nullptr;
+  }
+  if (min > max) {
+    // All keys are null.
+    return nullptr;
+  }
+  return std::make_unique<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), false);
+}
+} // namespace
+
+std::unique_ptr<common::Filter> BaseHashTable::keyBloomFilter(
+    int32_t keyIndex,
+    bool nullAllowed) {
+  VELOX_CHECK_LT(keyIndex, hashers_.size());
+  std::lock_guard<std::mutex> l(keyBloomFiltersMutex_);
+  if (keyBloomFilters_.empty()) {
+    keyBloomFilters_.resize(hashers_.size());
+  }
+  auto& filter = keyBloomFilters_[keyIndex];
+  if (!filter.has_value()) {
+    filter = makeKeyBloomFilter(
+        allRows(), keyIndex, hashers_[keyIndex]->typeKind(), numDistinct());
+  }
+  if (filter.value() == nullptr) {
+    return nullptr;
+  }
+  return filter.value()->clone(nullAllowed);
+}
+
 template <bool ignoreNullKeys>
 HashTable<ignoreNullKeys>::HashTable(
     std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -53,9 +145,12 @@ HashTable<ignoreNullKeys>::HashTable(
     bool hasProbedFlag,
     uint32_t minTableSizeForParallelJoinBuild,
     memory::MemoryPool* pool,
-    const std::shared_ptr<velox::HashStringAllocator>& stringArena)
+    const std::shared_ptr<velox::HashStringAllocator>& stringArena,
+    bool radixPartitionedJoinBuild,
+    bool internKeyStrings)
     : BaseHashTable(std::move(hashers)),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
+      radixPartitionedJoinBuild_(radixPartitionedJoinBuild),
       isJoinBuild_(isJoinBuild) {
   std::vector<TypePtr> keys;
   for (auto& hasher : hashers_) {
@@ -75,7 +170,8 @@ HashTable<ignoreNullKeys>::HashTable(
       hasProbedFlag,
       hashMode_ != HashMode::kHash,
       pool,
-      stringArena);
+      stringArena,
+      internKeyStrings);
   nextOffset_ = rows_->nextOffset();
 }
 
@@ -372,6 +468,16 @@ bool HashTable<ignoreNullKeys>::compareKeys(
   auto numKeys = hashers_.size();
   int32_t i = 0;
   do {
+    if (rows_->internsKeyStrings()) {
+      const auto kind = hashers_[i]->typeKind();
+      if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+        if (!rows_->equalsInternedString(
+                group, inserted, i, otherTables_.empty())) {
+          return false;
+        }
+        continue;
+      }
+    }
     if (rows_->compare(group, inserted, i, CompareFlags{true, true})) {
       return false;
     }
@@ -460,9 +566,15 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   // Do size-based rehash before mixing hashes from normalized keys
   // because the size of the table affects the mixing.
   checkSize(lookup.rows.size(), false);
+  maybeRehashOnProbeCost(lookup);
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
     groupNormalizedKeyProbe(lookup);
+    sampleProbeCost(lookup);
+    return;
+  }
+  if (tryGroupSingleKeyProbe(lookup)) {
+    sampleProbeCost(lookup);
     return;
   }
   ProbeState state1;
@@ -498,6 +610,7 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
     state1.firstProbe(*this, 0);
     fullProbe<false>(lookup, state1, false);
   }
+  sampleProbeCost(lookup);
 }
 
 template <bool ignoreNullKeys>
@@ -537,6 +650,101 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::tryGroupSingleKeyProbe(HashLookup& lookup) {
+  if (hashers_.size() != 1) {
+    return false;
+  }
+  switch (hashers_[0]->typeKind()) {
+    case TypeKind::TINYINT:
+      groupSingleKeyProbe<int8_t>(lookup);
+      return true;
+    case TypeKind::SMALLINT:
+      groupSingleKeyProbe<int16_t>(lookup);
+      return true;
+    case TypeKind::INTEGER:
+      groupSingleKeyProbe<int32_t>(lookup);
+      return true;
+    case TypeKind::BIGINT:
+      groupSingleKeyProbe<int64_t>(lookup);
+      return true;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      groupSingleKeyProbe<StringView>(lookup);
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <bool ignoreNullKeys>
+template <typename T>
+void HashTable<ignoreNullKeys>::groupSingleKeyProbe(HashLookup& lookup) {
+  const auto column = rows_->columnAt(0);
+  const auto offset = column.offset();
+  const auto& decoded = lookup.hashers[0]->decodedVector();
+  auto compare = [&](char* group, int32_t row) INLINE_LAMBDA {
+    if constexpr (!ignoreNullKeys) {
+      const bool groupIsNull = RowContainer::isNullAt(group, column);
+      const bool rowIsNull = decoded.isNullAt(row);
+      if (groupIsNull || rowIsNull) {
+        return groupIsNull == rowIsNull;
+      }
+    }
+    const auto key = decoded.valueAt<T>(row);
+    if constexpr (std::is_same_v<T, StringView>) {
+      // An inline key only equals an inline string of the same size, so it
+      // can be compared as a StringView. Longer strings in the row may be
+      // non-contiguous and go through the generic comparison.
+      if (!key.isInline()) {
+        return compareKeys(group, lookup, row);
+      }
+    }
+    return RowContainer::valueAt<T>(group, offset) == key;
+  };
+  auto insert = [&](int32_t row, uint64_t index) {
+    return insertEntry(lookup, index, row);
+  };
+  auto probe = [&](ProbeState& state, bool extraCheck) INLINE_LAMBDA {
+    lookup.hits[state.row()] = state.fullProbe<ProbeState::Operation::kInsert>(
+        *this, 0, compare, insert, numTombstones_, extraCheck);
+  };
+
+  ProbeState state1;
+  ProbeState state2;
+  ProbeState state3;
+  ProbeState state4;
+  int32_t probeIndex = 0;
+  int32_t numProbes = lookup.rows.size();
+  auto rows = lookup.rows.data();
+  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    int32_t row = rows[probeIndex];
+    state1.preProbe(*this, lookup.hashes[row], row);
+    row = rows[probeIndex + 1];
+    state2.preProbe(*this, lookup.hashes[row], row);
+    row = rows[probeIndex + 2];
+    state3.preProbe(*this, lookup.hashes[row], row);
+    row = rows[probeIndex + 3];
+    state4.preProbe(*this, lookup.hashes[row], row);
+
+    state1.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    state2.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    state3.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    state4.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+
+    probe(state1, false);
+    probe(state2, true);
+    probe(state3, true);
+    probe(state4, true);
+  }
+  for (; probeIndex < numProbes; ++probeIndex) {
+    int32_t row = rows[probeIndex];
+    state1.preProbe(*this, lookup.hashes[row], row);
+    state1.firstProbe(*this, 0);
+    probe(state1, false);
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
   VELOX_DCHECK(!lookup.hashes.empty());
@@ -597,6 +805,12 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
     joinNormalizedKeyProbe(lookup);
+    sampleProbeCost(lookup);
+    return;
+  }
+  if (lookup.groupPrefetch) {
+    groupPrefetchJoinProbe(lookup);
+    sampleProbeCost(lookup);
     return;
   }
   int32_t probeIndex = 0;
@@ -630,6 +844,89 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     state1.firstProbe(*this, 0);
     fullProbe<true>(lookup, state1, false);
   }
+  sampleProbeCost(lookup);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::sampleProbeCost(HashLookup& lookup) const {
+  VELOX_DCHECK_NE(hashMode_, HashMode::kArray);
+  if (lookup.rows.empty() ||
+      (lookup.numProbeBatches++ % kProbeCostSampleInterval) != 0) {
+    return;
+  }
+  // Repeats the probes of evenly spaced rows. The probes are complete, so the
+  // first tag match with the row in 'hits' ends a probe. A probe without a hit
+  // ends at the first bucket with an empty slot.
+  const auto kEmptyGroup = TagVector::broadcast(ProbeState::kEmptyTag);
+  const int32_t numRows = lookup.rows.size();
+  const int32_t step = std::max(1, numRows / kProbeCostSampleRows);
+  auto& cost = lookup.probeCost;
+  for (auto i = 0; i < numRows; i += step) {
+    const auto probeRow = lookup.rows[i];
+    const auto hash = lookup.hashes[probeRow];
+    const char* hit = lookup.hits[probeRow];
+    const auto wantedTags = TagVector::broadcast(hashTag(hash));
+    auto offset = bucketOffset(hash);
+    ++cost.numProbes;
+    for (int64_t numProbedBuckets = 0; numProbedBuckets < numBuckets_;
+         ++numProbedBuckets) {
+      const auto tags = loadTags(offset);
+      uint16_t hits =
+          simd::toBitMask(tags == wantedTags) & ProbeState::kFullMask;
+      bool found = false;
+      while (hits > 0) {
+        const auto index = bits::getAndClearLastSetBit(hits);
+        if (row(offset, index) == hit) {
+          found = true;
+          break;
+        }
+        ++cost.numTagMismatches;
+      }
+      if (found || simd::toBitMask(tags == kEmptyGroup) != 0) {
+        break;
+      }
+      offset = nextBucketOffset(offset);
+      ++cost.numBucketHops;
+    }
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::maybeRehashOnProbeCost(HashLookup& lookup) {
+  if (!probeCostAtRehashValid_) {
+    probeCostAtRehash_ = lookup.probeCost;
+    probeCostAtRehashValid_ = true;
+    return;
+  }
+  const auto cost = lookup.probeCost - probeCostAtRehash_;
+  if (cost.numProbes < kMinProbeCostSamples) {
+    return;
+  }
+  probeCostAtRehash_ = lookup.probeCost;
+  if (cost.missesPerProbe() <= kMaxMissesPerProbe) {
+    return;
+  }
+  // Long probe sequences in a sparse table come from the distribution of the
+  // hashes, which a larger table does not fix. Otherwise they come from runs
+  // of occupied and tombstone slots that a rehash at up to a quarter load
+  // breaks up.
+  if (numDistinct_ == 0) {
+    return;
+  }
+  const auto newCapacity = bits::nextPowerOfTwo(numDistinct_ * 4);
+  if (newCapacity <= capacity_ && numTombstones_ * 4 < capacity_) {
+    return;
+  }
+  // The operators reserve memory only for the growth from new keys. The
+  // table is still usable, so the rehash is skipped if the memory for the new
+  // table can't be reserved.
+  const uint64_t capacity = std::max<uint64_t>(newCapacity, capacity_);
+  if (!rows_->pool()->maybeReserve(capacity * tableSlotSize())) {
+    return;
+  }
+  allocateTables(capacity);
+  ++numProbeCostRehashes_;
+  rehash(false);
 }
 
 template <bool ignoreNullKeys>
@@ -705,6 +1002,29 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::groupPrefetchJoinProbe(HashLookup& lookup) {
+  int32_t probeIndex = 0;
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  ProbeState states[kPrefetchSize];
+  const uint64_t* hashes = lookup.hashes.data();
+  while (probeIndex < numProbes) {
+    const int32_t numStates = std::min(kPrefetchSize, numProbes - probeIndex);
+    for (int32_t i = 0; i < numStates; ++i) {
+      const int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    for (int32_t i = 0; i < numStates; ++i) {
+      states[i].firstProbe(*this, 0);
+    }
+    for (int32_t i = 0; i < numStates; ++i) {
+      fullProbe<true>(lookup, states[i], false);
+    }
+    probeIndex += numStates;
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   VELOX_CHECK(bits::isPowerOfTwo(size), "Size is not a power of two: {}", size);
@@ -875,6 +1195,10 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   process::TraceContext trace("HashTable::parallelJoinBuild");
   TestValue::adjust(
       "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
+  if (radixPartitionedJoinBuild_) {
+    radixParallelJoinBuild();
+    return;
+  }
   VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
   const uint8_t numPartitions = 1 + otherTables_.size();
   VELOX_CHECK_GT(
@@ -1059,6 +1383,173 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::radixParallelJoinBuild() {
+  const int32_t numTables = 1 + otherTables_.size();
+  const uint64_t tableBytes = sizeMask_ + 1;
+  const int32_t numPartitions = std::min<uint64_t>(
+      numBuckets_,
+      std::max<uint64_t>(
+          bits::nextPowerOfTwo(numTables),
+          std::min<uint64_t>(
+              kMaxRadixPartitions,
+              bits::nextPowerOfTwo(tableBytes / kRadixPartitionBytes))));
+  VELOX_CHECK(bits::isPowerOfTwo(numPartitions));
+  const uint64_t partitionBytes = tableBytes / numPartitions;
+  const int32_t partitionShift = __builtin_ctzll(partitionBytes);
+  buildPartitionBounds_.resize(numPartitions + 1);
+  for (auto i = 0; i <= numPartitions; ++i) {
+    buildPartitionBounds_[i] = partitionBytes * i;
+    VELOX_CHECK_GE(
+        buildPartitionBounds_[i],
+        0,
+        "Turn on VELOX_ENABLE_INT64_BUILD_PARTITION_BOUND to avoid integer overflow in buildPartitionBounds_");
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> partitionSteps;
+  std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
+  // The partitions are used in the async threads, so declare them before the
+  // sync guard.
+  std::vector<std::vector<RadixPartition>> partitions(numTables);
+  std::vector<std::vector<char*>> overflowPerPartition(numPartitions);
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw.
+    std::exception_ptr error;
+    syncWorkItems(partitionSteps, error, offThreadBuildTiming_, true);
+    syncWorkItems(buildSteps, error, offThreadBuildTiming_, true);
+  });
+
+  const auto getTable = [this](size_t i) INLINE_LAMBDA {
+    return i == 0 ? this : otherTables_[i - 1].get();
+  };
+
+  for (auto i = 0; i < numTables; ++i) {
+    partitions[i].reserve(numPartitions);
+    for (auto j = 0; j < numPartitions; ++j) {
+      partitions[i].emplace_back(*rows_->pool());
+    }
+  }
+
+  // The parallel scatter step.
+  for (auto i = 0; i < numTables; ++i) {
+    auto* table = getTable(i);
+    partitionSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, table, partitionShift, tablePartitions = &partitions[i]]() {
+          radixPartitionRows(*table, *tablePartitions, partitionShift);
+          return std::make_unique<bool>(true);
+        }));
+    buildExecutor_->add([step = partitionSteps.back()]() { step->prepare(); });
+  }
+
+  std::exception_ptr error;
+  syncWorkItems(partitionSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  // The parallel table building step. Build step 'i' allocates from the
+  // RowContainer of table 'i', so the partitions are divided between the
+  // tables.
+  for (auto i = 0; i < numTables; ++i) {
+    buildSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, i, numTables, numPartitions, &partitions, &overflowPerPartition,
+         &getTable]() {
+          auto* rowContainer = getTable(i)->rows();
+          for (auto partition = i; partition < numPartitions;
+               partition += numTables) {
+            buildRadixJoinPartition(
+                partition,
+                rowContainer,
+                partitions,
+                overflowPerPartition[partition]);
+          }
+          return std::make_unique<bool>(true);
+        }));
+    buildExecutor_->add([step = buildSteps.back()]() { step->prepare(); });
+  }
+  syncWorkItems(buildSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  raw_vector<uint64_t> hashes;
+  for (auto i = 0; i < numPartitions; ++i) {
+    auto& overflows = overflowPerPartition[i];
+    if (overflows.empty()) {
+      continue;
+    }
+    hashes.resize(overflows.size());
+    hashRows(
+        folly::Range<char**>(overflows.data(), overflows.size()),
+        false,
+        hashes);
+    insertForJoin(
+        getTable(i % numTables)->rows(),
+        overflows.data(),
+        hashes.data(),
+        overflows.size(),
+        nullptr);
+  }
+  for (auto i = 0; i < numTables; ++i) {
+    auto* table = getTable(i);
+    VELOX_CHECK_EQ(table->rows()->numRows(), table->numParallelBuildRows_);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::radixPartitionRows(
+    HashTable<ignoreNullKeys>& subtable,
+    std::vector<RadixPartition>& partitions,
+    int32_t partitionShift) {
+  constexpr int32_t kBatch = 1024;
+  raw_vector<char*> rows(kBatch);
+  raw_vector<uint64_t> hashes(kBatch);
+  RowContainerIterator iter;
+  while (auto numRows = subtable.rows_->listRows(
+             &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+    hashRows(folly::Range<char**>(rows.data(), numRows), true, hashes);
+    for (auto i = 0; i < numRows; ++i) {
+      auto& partition = partitions[bucketOffset(hashes[i]) >> partitionShift];
+      partition.rows.push_back(rows[i]);
+      partition.hashes.push_back(hashes[i]);
+    }
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::buildRadixJoinPartition(
+    int32_t partition,
+    RowContainer* rowContainer,
+    std::vector<std::vector<RadixPartition>>& partitions,
+    std::vector<char*>& overflow) {
+  constexpr int32_t kBatch = 1024;
+  TableInsertPartitionInfo partitionInfo{
+      buildPartitionBounds_[partition],
+      buildPartitionBounds_[partition + 1],
+      overflow};
+  for (auto i = 0; i < partitions.size(); ++i) {
+    auto* table = i == 0 ? this : otherTables_[i - 1].get();
+    auto& tablePartition = partitions[i][partition];
+    const int64_t numRows = tablePartition.rows.size();
+    for (int64_t offset = 0; offset < numRows; offset += kBatch) {
+      const int32_t numBatchRows = std::min<int64_t>(kBatch, numRows - offset);
+      insertForJoin(
+          rowContainer,
+          tablePartition.rows.data() + offset,
+          tablePartition.hashes.data() + offset,
+          numBatchRows,
+          &partitionInfo);
+    }
+    table->numParallelBuildRows_ += numRows;
+    // Frees the buffers as soon as they are inserted.
+    tablePartition.rows.clear();
+    tablePartition.rows.shrink_to_fit();
+    tablePartition.hashes.clear();
+    tablePartition.hashes.shrink_to_fit();
+  }
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::insertBatch(
     char** groups,
@@ -1277,6 +1768,7 @@ void HashTable<ignoreNullKeys>::insertForJoin(
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
   ++numRehashes_;
+  probeCostAtRehashValid_ = false;
   constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
     parallelJoinBuild();
@@ -53,6 +53,35 @@ struct TableInsertPartitionInfo {
   }
 };
 
+/// Sampled cost of probes into a kHash or kNormalizedKey mode table. A bucket
+/// hop or a tag mismatch is a likely cache miss in addition to the first
+/// bucket and the hit of a probe.
+struct HashProbeCost {
+  /// Number of sampled probes.
+  int64_t numProbes{0};
+
+  /// Number of buckets visited after the first bucket of a probe.
+  int64_t numBucketHops{0};
+
+  /// Number of tag matches whose row is not the probed key.
+  int64_t numTagMismatches{0};
+
+  HashProbeCost operator-(const HashProbeCost& other) const {
+    return {
+        numProbes - other.numProbes,
+        numBucketHops - other.numBucketHops,
+        numTagMismatches - other.numTagMismatches};
+  }
+
+  /// Returns the average number of bucket hops and tag mismatches per probe.
+  double missesPerProbe() const {
+    if (numProbes == 0) {
+      return 0;
+    }
+    return static_cast<double>(numBucketHops + numTagMismatches) / numProbes;
+  }
+};
+
 /// Contains input and output parameters for groupProbe and joinProbe APIs.
 struct HashLookup {
   explicit HashLookup(const std::vector<std::unique_ptr<VectorHasher>>& h)
@@ -95,6 +124,19 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Cost of the probes sampled by groupProbe and joinProbe. Not cleared by
+  /// reset().
+  HashProbeCost probeCost;
+
+  /// Number of groupProbe and joinProbe calls with this lookup into a kHash
+  /// or kNormalizedKey mode table. Selects the calls to sample.
+  int64_t numProbeBatches{0};
+
+  /// If true, joinProbe into a kHash mode table probes the rows in groups,
+  /// finishing each stage of the probe for all rows of a group before
+  /// starting the next. kNormalizedKey mode probes always do this.
+  bool groupPrefetch{false};
 };
 
 struct HashTableStats {
@@ -103,6 +145,8 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Counts the rehashes made because of a high sampled probe cost.
+  int64_t numProbeCostRehashes{0};
 };
 
 class BaseHashTable {
@@ -129,6 +173,17 @@ class BaseHashTable {
   static inline const std::string kNumRehashes{"hashtable.numRehashes"};
   static inline const std::string kNumDistinct{"hashtable.numDistinct"};
   static inline const std::string kNumTombstones{"hashtable.numTombstones"};
+  static inline const std::string kNumProbeCostRehashes{
+      "hashtable.numProbeCostRehashes"};
+
+  /// The sampled probe cost reported by HashAggregation and HashProbe. See
+  /// HashProbeCost.
+  static inline const std::string kNumSampledProbes{
+      "hashtable.numSampledProbes"};
+  static inline const std::string kProbeBucketHops{
+      "hashtable.probeBucketHops"};
+  static inline const std::string kProbeTagMismatches{
+      "hashtable.probeTagMismatches"};
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
@@ -344,6 +399,22 @@ class BaseHashTable {
   /// join use.
   virtual std::vector<RowContainer*> allRows() const = 0;
 
+  /// Returns a filter passing a superset of the values of the integer key at
+  /// 'keyIndex'. The filter is backed by a bloom filter over the keys in all
+  /// the row containers of 'this' and is used for pushing down join dynamic
+  /// filters when the keys are too many or too sparse for
+  /// VectorHasher::getFilter(). Returns nullptr if the key is not of an
+  /// integer type or if there are more than kMaxKeyBloomFilterSize distinct
+  /// keys. The bloom filter is built on first use and shared by the filters
+  /// returned from subsequent calls. Thread safe.
+  std::unique_ptr<common::Filter> keyBloomFilter(
+      int32_t keyIndex,
+      bool nullAllowed);
+
+  /// Maximum number of distinct keys for which keyBloomFilter() builds a
+  /// filter. The bloom filter takes 2 bytes per key.
+  static constexpr uint64_t kMaxKeyBloomFilterSize = 4 << 20;
+
   /// Static functions for processing internals. Public because used in
   /// structs that define probe and insert algorithms.
 
@@ -410,6 +481,14 @@ class BaseHashTable {
 
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
+
+  // Serializes the lazy construction of 'keyBloomFilters_'.
+  std::mutex keyBloomFiltersMutex_;
+
+  // Filters returned by keyBloomFilter(), indexed by key. An entry is unset
+  // if not built yet and nullptr if no filter can be built for the key.
+  std::vector<std::optional<std::unique_ptr<common::Filter>>>
+      keyBloomFilters_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -435,6 +514,8 @@ class HashTable : public BaseHashTable {
   // not occur. In this case the row does not need a link to the next
   // match. 'hasProbedFlag' adds an extra bit in every row for tracking rows
   // that matches join condition for right and full outer joins.
+  // 'internKeyStrings' stores each distinct string key once in the
+  // RowContainer, see RowContainer.
   HashTable(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
@@ -444,7 +525,9 @@ class HashTable : public BaseHashTable {
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
       memory::MemoryPool* pool,
-      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr);
+      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr,
+      bool radixPartitionedJoinBuild = false,
+      bool internKeyStrings = false);
 
   ~HashTable() override {
     if (otherTables_.size() > 0) {
@@ -479,7 +562,9 @@ class HashTable : public BaseHashTable {
       bool allowDuplicates,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool radixPartitionedJoinBuild = false,
+      bool internKeyStrings = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -488,7 +573,10 @@ class HashTable : public BaseHashTable {
         true, // isJoinBuild
         hasProbedFlag,
         minTableSizeForParallelJoinBuild,
-        pool);
+        pool,
+        nullptr,
+        radixPartitionedJoinBuild,
+        internKeyStrings);
   }
 
   void groupProbe(HashLookup& lookup) override;
@@ -546,7 +634,11 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_,
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        numProbeCostRehashes_};
   }
 
   bool hasDuplicateKeys() const override {
@@ -633,6 +725,27 @@ class HashTable : public BaseHashTable {
   static constexpr bool kTrackLoads = true;
 #endif
 
+  // Target size of the bucket range of a partition of a radix partitioned
+  // parallel join build. Sized to stay in the cache of a core while built.
+  static constexpr uint64_t kRadixPartitionBytes = 2 << 20;
+
+  // Maximum number of partitions of a radix partitioned parallel join build.
+  static constexpr int32_t kMaxRadixPartitions = 1'024;
+
+  // Samples the probe cost of one in this many probe batches.
+  static constexpr int64_t kProbeCostSampleInterval = 16;
+
+  // Maximum number of probes sampled in a batch.
+  static constexpr int32_t kProbeCostSampleRows = 64;
+
+  // Minimum number of sampled probes since the last rehash before the probe
+  // cost is acted on.
+  static constexpr int64_t kMinProbeCostSamples = 1'024;
+
+  // Average bucket hops and tag mismatches per probe above which a group by
+  // table is rehashed into a larger one.
+  static constexpr double kMaxMissesPerProbe = 2.0;
+
   // The table in non-kArray mode has a power of two number of buckets each with
   // 16 slots. Each slot has a 1 byte tag (a field of hash number) and a 48 bit
   // pointer. All the tags are in a 16 byte SIMD word followed by the 6 byte
@@ -734,6 +847,24 @@ class HashTable : public BaseHashTable {
   void clearUseRange(std::vector<bool>& useRange);
 
   void rehash(bool initNormalizedKeys);
+
+  // Probes 'lookup' into a kHash mode table in groups of rows like
+  // joinNormalizedKeyProbe(). The first bucket of each row of a group is
+  // prefetched, then the tags of each are loaded and the first row with a
+  // matching tag is prefetched, and then the keys are compared. Keeps more
+  // loads in flight than the 4 way interleaved probe in joinProbe().
+  void groupPrefetchJoinProbe(HashLookup& lookup);
+
+  // Samples the cost of the probes of 'lookup' after groupProbe or joinProbe
+  // into a kHash or kNormalizedKey mode table and adds it to
+  // 'lookup.probeCost'. Samples one in kProbeCostSampleInterval calls.
+  void sampleProbeCost(HashLookup& lookup) const;
+
+  // Rehashes a group by table into a larger table if the probe cost sampled
+  // since the last rehash shows long probe sequences. This happens between
+  // input batches, before the table is probed with new keys.
+  void maybeRehashOnProbeCost(HashLookup& lookup);
+
   void storeKeys(HashLookup& lookup, vector_size_t row);
 
   void storeRowPointer(uint64_t index, uint64_t hash, char* row);
@@ -797,6 +928,46 @@ class HashTable : public BaseHashTable {
   // else.
   void parallelJoinBuild();
 
+  // The rows of one build side table that fall in one partition of a radix
+  // partitioned parallel join build, with their hashes.
+  struct RadixPartition {
+    explicit RadixPartition(memory::MemoryPool& pool)
+        : rows(pool), hashes(pool) {}
+
+    std::vector<char*, memory::StlAllocator<char*>> rows;
+    std::vector<uint64_t, memory::StlAllocator<uint64_t>> hashes;
+  };
+
+  // Variant of parallelJoinBuild() used if 'radixPartitionedJoinBuild_' is
+  // set. The table is divided into a power of two number of equal ranges of
+  // buckets, so that the partition of a row is given by the top bits of its
+  // bucket offset. There are at least as many partitions as build side tables
+  // and more if needed to keep each range near kRadixPartitionBytes. Each
+  // build side table first scatters its rows and their hashes into per
+  // partition buffers. Then one thread per build side table inserts the rows
+  // of a disjoint set of partitions, each from the buffers of all tables.
+  // Unlike parallelJoinBuild(), no thread scans the rows of other partitions.
+  void radixParallelJoinBuild();
+
+  // Scatters the rows of 'subtable' with their hashes into 'partitions'. The
+  // partition of a row is its bucket offset shifted right by
+  // 'partitionShift'. If 'hashMode_' is kNormalizedKeys, records the
+  // normalized key of each row below the row in its container.
+  void radixPartitionRows(
+      HashTable<ignoreNullKeys>& subtable,
+      std::vector<RadixPartition>& partitions,
+      int32_t partitionShift);
+
+  // Inserts the rows of 'partition' from the buffers of all build side tables
+  // in 'partitions' into 'this'. New duplicate row links are allocated from
+  // 'rowContainer'. The rows that would have gone past the end of the
+  // partition are returned in 'overflow'.
+  void buildRadixJoinPartition(
+      int32_t partition,
+      RowContainer* rowContainer,
+      std::vector<std::vector<RadixPartition>>& partitions,
+      std::vector<char*>& overflow);
+
   // Inserts the rows in 'partition' from this and 'otherTables' into 'this'.
   // The rows that would have gone past the end of the partition are returned in
   // 'overflow'.
@@ -827,6 +998,8 @@ class HashTable : public BaseHashTable {
 
   bool compareKeys(const char* group, HashLookup& lookup, vector_size_t row);
 
+  // Compares the keys of two rows of the table. 'inserted' is in 'rows_' if
+  // there are no 'otherTables_'.
   bool compareKeys(const char* group, const char* inserted);
 
   template <bool isJoin, bool isNormalizedKey = false>
@@ -835,6 +1008,16 @@ class HashTable : public BaseHashTable {
   // Shortcut path for group by with normalized keys.
   void groupNormalizedKeyProbe(HashLookup& lookup);
 
+  // Shortcut path for group by in kHash mode with a single key of integer or
+  // string type. Compares the key as a 'T' instead of dispatching on the type
+  // in compareKeys() for every probed row.
+  template <typename T>
+  void groupSingleKeyProbe(HashLookup& lookup);
+
+  // Runs groupSingleKeyProbe() if the table has a single key of a supported
+  // type. Returns false if the generic probe must be used.
+  bool tryGroupSingleKeyProbe(HashLookup& lookup);
+
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
@@ -947,6 +1130,9 @@ class HashTable : public BaseHashTable {
   // The min table size in row to trigger parallel join table build.
   const uint32_t minTableSizeForParallelJoinBuild_;
 
+  // If true, a parallel join build is made by radixParallelJoinBuild().
+  const bool radixPartitionedJoinBuild_;
+
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
@@ -976,6 +1162,12 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+  // Counts the rehashes made by maybeRehashOnProbeCost().
+  int64_t numProbeCostRehashes_{0};
+  // The probe cost of the group by lookup at the last rehash. Reset by the
+  // first probe after a rehash if 'probeCostAtRehashValid_' is false.
+  HashProbeCost probeCostAtRehash_;
+  bool probeCostAtRehashValid_{false};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+InProcessExchangeSource::InProcessExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool)
+    : ExchangeSource(taskId, destination, std::move(queue), pool),
+      bufferManager_(OutputBufferManager::getInstance()) {}
+
+// static
+ExchangeSource::Factory InProcessExchangeSource::factory(
+    TaskResolver resolver) {
+  return [resolver = std::move(resolver)](
+             const std::string& taskLocation,
+             int destination,
+             std::shared_ptr<ExchangeQueue> queue,
+             memory::MemoryPool* pool) -> std::shared_ptr<ExchangeSource> {
+    const auto taskId = resolver(taskLocation);
+    if (!taskId.has_value()) {
+      return nullptr;
+    }
+    // Leaves the producer to the other factories if it has no output buffers
+    // in this process, e.g. if it is not started yet.
+    auto buffers = OutputBufferManager::getInstance().lock();
+    if (buffers == nullptr || buffers->getBufferIfExists(*taskId) == nullptr) {
+      return nullptr;
+    }
+    return std::make_shared<InProcessExchangeSource>(
+        *taskId, destination, std::move(queue), pool);
+  };
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_ || closed_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds /*maxWait*/) {
+  auto buffers = bufferManager_.lock();
+  VELOX_CHECK_NOT_NULL(buffers, "OutputBufferManager was already destructed");
+
+  folly::SemiFuture<Response> future{folly::SemiFuture<Response>::makeEmpty()};
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    VELOX_CHECK(requestPending_);
+    promise_ = VeloxPromise<Response>("InProcessExchangeSource::request");
+    future = promise_.getSemiFuture();
+    requestedSequence = sequence_;
+  }
+
+  auto self = shared_from_this();
+  // The callback may run before getData() returns if the data is available.
+  const bool found = buffers->getData(
+      taskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [self, this, requestedSequence](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        processData(
+            requestedSequence,
+            std::move(data),
+            sequence,
+            std::move(remainingBytes));
+      });
+  if (!found) {
+    VeloxPromise<Response> promise;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+      promise = std::move(promise_);
+    }
+    promise.setException(std::runtime_error(fmt::format(
+        "Output buffers of task {} are not found in this process", taskId_)));
+  }
+  return future;
+}
+
+folly::SemiFuture<ExchangeSource::Response>
+InProcessExchangeSource::requestDataSizes(std::chrono::microseconds maxWait) {
+  return request(0, maxWait);
+}
+
+void InProcessExchangeSource::processData(
+    int64_t requestedSequence,
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  if (requestedSequence > sequence && !data.empty()) {
+    // Drops the pages that were already received.
+    const auto numReceived = requestedSequence - sequence;
+    VELOX_CHECK_LT(numReceived, data.size());
+    data.erase(data.begin(), data.begin() + numReceived);
+    sequence = requestedSequence;
+  }
+  if (data.empty()) {
+    sequence = requestedSequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  pages.reserve(data.size());
+  bool atEnd{false};
+  int64_t totalBytes{0};
+  for (auto& iobuf : data) {
+    if (iobuf == nullptr) {
+      // There could be more than one end marker.
+      atEnd = true;
+      continue;
+    }
+    totalBytes += iobuf->computeChainDataLength();
+    pages.push_back(std::make_unique<SerializedPage>(std::move(iobuf)));
+  }
+  const auto numPages = pages.size();
+  numPages_ += numPages;
+  totalBytes_ += totalBytes;
+
+  VeloxPromise<Response> promise;
+  std::vector<ContinuePromise> queuePromises;
+  int64_t ackSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (closed_) {
+      return;
+    }
+    requestPending_ = false;
+    promise = std::move(promise_);
+    for (auto& page : pages) {
+      queue_->enqueueLocked(std::move(page), queuePromises);
+    }
+    if (atEnd) {
+      queue_->enqueueLocked(nullptr, queuePromises);
+      atEnd_ = true;
+    }
+    sequence_ = sequence + numPages;
+    ackSequence = sequence_;
+  }
+  for (auto& queuePromise : queuePromises) {
+    queuePromise.setValue();
+  }
+
+  if (auto buffers = bufferManager_.lock()) {
+    if (atEnd) {
+      buffers->deleteResults(taskId_, destination_);
+    } else if (numPages > 0) {
+      buffers->acknowledge(taskId_, destination_, ackSequence);
+    }
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{totalBytes, atEnd, std::move(remainingBytes)});
+  }
+}
+
+void InProcessExchangeSource::close() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (closed_) {
+      return;
+    }
+    closed_ = true;
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+  if (auto buffers = bufferManager_.lock()) {
+    buffers->deleteResults(taskId_, destination_);
+  }
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {kNumPages, RuntimeMetric(numPages_)},
+      {kTotalBytes, RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+  };
+}
+
+} // namespace facebook::velox::exec
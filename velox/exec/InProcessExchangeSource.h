@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource that fetches pages from a producer task running in the same
+/// process directly from the process wide OutputBufferManager, without going
+/// through the network. The pages are not copied: the consumer gets the
+/// IOBufs of the producer's OutputBuffer, which stay charged to the memory
+/// pool of the producer and keep the producer task alive until the consumer
+/// releases them. The consumer's ExchangeQueue still accounts for their bytes
+/// so that the flow control of ExchangeClient is unchanged.
+///
+/// A request completes as soon as the producer has data, reaches the end or
+/// 'this' is closed, so 'maxWait' is not enforced.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  /// Returns the id of the task in this process that produces the data at
+  /// 'taskLocation', or std::nullopt if the producer is not in this process.
+  using TaskResolver = std::function<std::optional<std::string>(
+      const std::string& taskLocation)>;
+
+  /// @param taskId The id of the producer task in the OutputBufferManager.
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// Returns a factory to register with ExchangeSource::registerFactory()
+  /// ahead of the factories of the remote sources. The factory creates an
+  /// InProcessExchangeSource for the task locations that 'resolver' resolves
+  /// to a task in this process, and returns nullptr for the others.
+  static Factory factory(TaskResolver resolver);
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+  static inline const std::string kNumPages = "inProcessExchangeSource.numPages";
+  static inline const std::string kTotalBytes =
+      "inProcessExchangeSource.totalBytes";
+
+ private:
+  // Called by the OutputBufferManager with the pages starting at 'sequence'
+  // for the request of 'requestedSequence'.
+  void processData(
+      int64_t requestedSequence,
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  const std::weak_ptr<OutputBufferManager> bufferManager_;
+
+  // Guarded by queue_->mutex().
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+  bool closed_{false};
+
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+};
+
+} // namespace facebook::velox::exec
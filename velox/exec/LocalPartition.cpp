@@ -29,78 +29,90 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  // The counter is raised before re-checking the size so that a consumer that
+  // releases memory concurrently either sees this producer or is seen by it.
+  ++numBlockedProducers_;
+  if (bufferedBytes_ < continueBufferSize_) {
+    --numBlockedProducers_;
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
+  if (bufferedBytes_.fetch_sub(removed) - removed >= continueBufferSize_ ||
+      numBlockedProducers_ == 0) {
+    return {};
+  }
+
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
-    if (bufferedBytes_ < maxBufferSize_) {
+    if (bufferedBytes_ < continueBufferSize_) {
       promises = std::move(promises_);
+      numBlockedProducers_ = 0;
     }
   }
   return promises;
 }
 
 void LocalExchangeQueue::addProducer() {
-  queue_.withWLock([&](auto& /*queue*/) {
-    VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
-    ++pendingProducers_;
-  });
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
+  ++pendingProducers_;
 }
 
 void LocalExchangeQueue::noMoreProducers() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!noMoreProducers_, "noMoreProducers can be called only once");
     noMoreProducers_ = true;
     if (pendingProducers_ == 0) {
       // No more data will be produced.
-      consumerPromises = std::move(consumerPromises_);
+      consumerPromises = takeConsumerPromisesLocked();
     }
-  });
+  }
   notify(consumerPromises);
 }
 
 BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     ContinueFuture* future) {
-  auto inputBytes = input->estimateFlatSize();
-
-  std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
-  bool isClosed = queue_.withWLock([&](auto& queue) {
-    if (closed_) {
-      return true;
-    }
-    queue.push(std::move(input));
-    consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
+  if (closed_) {
+    return BlockingReason::kNotBlocked;
+  }
 
-    return false;
-  });
+  const auto inputBytes = input->estimateFlatSize();
+  const bool blockedOnConsumer =
+      memoryManager_->increaseMemoryUsage(future, inputBytes);
+  queue_.enqueue(std::move(input));
 
-  if (isClosed) {
+  if (closed_) {
+    // close() may have drained the queue before 'input' was added.
+    dropData();
     return BlockingReason::kNotBlocked;
   }
 
-  notify(consumerPromises);
+  // Pairs with the fence in next() so that either the producer sees the
+  // blocked consumer or the consumer sees the new data.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (numBlockedConsumers_ > 0) {
+    std::vector<ContinuePromise> consumerPromises;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      consumerPromises = takeConsumerPromisesLocked();
+    }
+    notify(consumerPromises);
+  }
 
   if (blockedOnConsumer) {
     return BlockingReason::kWaitForConsumer;
@@ -111,13 +123,14 @@ BlockingReason LocalExchangeQueue::enqueue(
 
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK_GT(pendingProducers_, 0);
     --pendingProducers_;
     if (noMoreProducers_ && pendingProducers_ == 0) {
-      consumerPromises = std::move(consumerPromises_);
+      consumerPromises = takeConsumerPromisesLocked();
     }
-  });
+  }
   notify(consumerPromises);
 }
 
@@ -125,11 +138,14 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
-  auto blockingReason = queue_.withWLock([&](auto& queue) {
-    *data = nullptr;
-    if (queue.empty()) {
-      if (isFinishedLocked(queue)) {
+  *data = nullptr;
+  if (!queue_.try_dequeue(*data)) {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++numBlockedConsumers_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!queue_.try_dequeue(*data)) {
+      if (isFinishedLocked()) {
+        --numBlockedConsumers_;
         return BlockingReason::kNotBlocked;
       }
 
@@ -138,26 +154,43 @@ BlockingReason LocalExchangeQueue::next(
 
       return BlockingReason::kWaitForProducer;
     }
+    --numBlockedConsumers_;
+  }
 
-    *data = queue.front();
-    queue.pop();
-
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+  releaseMemory(*data);
+  return BlockingReason::kNotBlocked;
+}
 
-    return BlockingReason::kNotBlocked;
-  });
+void LocalExchangeQueue::releaseMemory(const RowVectorPtr& data) {
+  auto memoryPromises =
+      memoryManager_->decreaseMemoryUsage(data->estimateFlatSize());
   notify(memoryPromises);
-  return blockingReason;
 }
 
-bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+void LocalExchangeQueue::dropData() {
+  int64_t freedBytes = 0;
+  RowVectorPtr data;
+  while (queue_.try_dequeue(data)) {
+    freedBytes += data->estimateFlatSize();
+  }
+
+  if (freedBytes > 0) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
+    notify(memoryPromises);
+  }
+}
+
+std::vector<ContinuePromise> LocalExchangeQueue::takeConsumerPromisesLocked() {
+  numBlockedConsumers_ = 0;
+  return std::move(consumerPromises_);
+}
+
+bool LocalExchangeQueue::isFinishedLocked() const {
   if (closed_) {
     return true;
   }
 
-  if (noMoreProducers_ && pendingProducers_ == 0 && queue.empty()) {
+  if (noMoreProducers_ && pendingProducers_ == 0 && queue_.empty()) {
     return true;
   }
 
@@ -165,28 +198,20 @@ bool LocalExchangeQueue::isFinishedLocked(
 }
 
 bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+  std::lock_guard<std::mutex> l(mutex_);
+  return isFinishedLocked();
 }
 
 void LocalExchangeQueue::close() {
-  std::vector<ContinuePromise> consumerPromises;
-  std::vector<ContinuePromise> memoryPromises;
-  queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
-    while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
-      queue.pop();
-    }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
+  closed_ = true;
+  dropData();
 
-    consumerPromises = std::move(consumerPromises_);
-    closed_ = true;
-  });
+  std::vector<ContinuePromise> consumerPromises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    consumerPromises = takeConsumerPromisesLocked();
+  }
   notify(consumerPromises);
-  notify(memoryPromises);
 }
 
 LocalExchange::LocalExchange(
@@ -251,8 +276,16 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      skewThreshold_{
+          numPartitions_ == 1 || !planNode->rebalanceHotPartitions()
+              ? 0
+              : ctx->queryConfig().localPartitionSkewThreshold()} {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
+  if (skewThreshold_ > 0) {
+    windowPartitionRows_.resize(numPartitions_, 0);
+    hotPartitions_.resize(numPartitions_, false);
+  }
 
   for (auto& queue : queues_) {
     queue->addProducer();
@@ -316,8 +349,16 @@ void LocalPartition::addInput(RowVectorPtr input) {
     return;
   }
 
-  const auto singlePartition =
-      partitionFunction_->partition(*input, partitions_);
+  const auto numInput = input->size();
+  auto singlePartition = partitionFunction_->partition(*input, partitions_);
+  if (skewThreshold_ > 0) {
+    if (singlePartition.has_value()) {
+      partitions_.assign(numInput, singlePartition.value());
+    }
+    if (rebalanceHotPartitions(numInput)) {
+      singlePartition.reset();
+    }
+  }
   if (singlePartition.has_value()) {
     ContinueFuture future;
     auto blockingReason =
@@ -329,7 +370,6 @@ void LocalPartition::addInput(RowVectorPtr input) {
     return;
   }
 
-  const auto numInput = input->size();
   std::vector<vector_size_t> maxIndex(numPartitions_, 0);
   for (auto i = 0; i < numInput; ++i) {
     ++maxIndex[partitions_[i]];
@@ -362,6 +402,46 @@ void LocalPartition::addInput(RowVectorPtr input) {
   }
 }
 
+bool LocalPartition::rebalanceHotPartitions(vector_size_t numRows) {
+  for (auto i = 0; i < numRows; ++i) {
+    ++windowPartitionRows_[partitions_[i]];
+  }
+  windowRows_ += numRows;
+
+  vector_size_t numRebalancedRows = 0;
+  if (numHotPartitions_ > 0) {
+    for (auto i = 0; i < numRows; ++i) {
+      if (!hotPartitions_[partitions_[i]]) {
+        continue;
+      }
+      partitions_[i] = nextRebalancedPartition_;
+      if (++nextRebalancedPartition_ == numPartitions_) {
+        nextRebalancedPartition_ = 0;
+      }
+      ++numRebalancedRows;
+    }
+  }
+
+  if (windowRows_ >= kSkewWindowRows) {
+    const double maxPartitionRows =
+        skewThreshold_ * windowRows_ / numPartitions_;
+    numHotPartitions_ = 0;
+    for (auto i = 0; i < numPartitions_; ++i) {
+      hotPartitions_[i] = windowPartitionRows_[i] > maxPartitionRows;
+      numHotPartitions_ += hotPartitions_[i];
+    }
+    std::fill(windowPartitionRows_.begin(), windowPartitionRows_.end(), 0);
+    windowRows_ = 0;
+    addRuntimeStat("numHotPartitions", RuntimeCounter(numHotPartitions_));
+  }
+
+  if (numRebalancedRows == 0) {
+    return false;
+  }
+  addRuntimeStat("rebalancedRows", RuntimeCounter(numRebalancedRows));
+  return true;
+}
+
 BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
   if (!futures_.empty()) {
     auto blockingReason = blockingReasons_.front();
@@ -382,10 +462,19 @@ void LocalPartition::noMoreInput() {
 }
 
 bool LocalPartition::isFinished() {
-  if (!futures_.empty() || !noMoreInput_) {
+  if (!futures_.empty()) {
     return false;
   }
+  if (noMoreInput_) {
+    return true;
+  }
 
-  return true;
+  // The consumers closed all the queues, e.g. a downstream LIMIT has all the
+  // rows it needs. Finishing early closes the upstream operators of this
+  // pipeline, so that the scans stop reading and cancel their pending IO
+  // instead of producing data that the queues drop.
+  return std::all_of(queues_.begin(), queues_.end(), [](const auto& queue) {
+    return queue->isClosed();
+  });
 }
 } // namespace facebook::velox::exec
@@ -15,31 +15,44 @@
  */
 #pragma once
 
+#include <folly/concurrency/UnboundedQueue.h>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. Producers are blocked when the size reaches the limit
+/// and resumed when it goes below kContinuePct % of the limit. The size is
+/// updated without locking, the mutex is only taken when producers block or
+/// are resumed.
 class LocalExchangeMemoryManager {
  public:
+  static constexpr int32_t kContinuePct = 90;
+
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
-      : maxBufferSize_{maxBufferSize} {}
+      : maxBufferSize_{maxBufferSize},
+        continueBufferSize_{
+            std::max<int64_t>(1, maxBufferSize * kContinuePct / 100)} {}
 
   /// Returns 'true' if memory limit is reached or exceeded and sets future that
   /// will be complete when memory usage is update to be below the limit.
   bool increaseMemoryUsage(ContinueFuture* future, int64_t added);
 
   /// Decreases the memory usage by 'removed' bytes. If the memory usage goes
-  /// below the limit after the decrease, the function returns 'promises_' to
-  /// caller to fulfill.
+  /// below kContinuePct % of the limit after the decrease, the function returns
+  /// 'promises_' to caller to fulfill.
   std::vector<ContinuePromise> decreaseMemoryUsage(int64_t removed);
 
  private:
   const int64_t maxBufferSize_;
+  const int64_t continueBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // Number of producers in 'promises_'. Lets the consumers skip 'mutex_' when
+  // no producer is blocked.
+  std::atomic<int32_t> numBlockedProducers_{0};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -49,6 +62,9 @@ class LocalExchangeMemoryManager {
 /// must be called after all producers have been registered. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
 /// Consumers call 'next' repeatedly to fetch the data.
+///
+/// The data is kept in a lock-free queue. The mutex is only taken to block
+/// and wake up consumers and to track the producers.
 class LocalExchangeQueue {
  public:
   LocalExchangeQueue(
@@ -84,23 +100,45 @@ class LocalExchangeQueue {
 
   bool isFinished();
 
+  /// Returns true after close(), e.g. when the consumers need no more data.
+  bool isClosed() const {
+    return closed_;
+  }
+
   /// Drop remaining data from the queue and notify consumers and producers if
   /// called before all the data has been processed. No-op otherwise.
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  bool isFinishedLocked() const;
+
+  // Removes 'data' from the memory usage and resumes the blocked producers if
+  // the usage goes below the limit.
+  void releaseMemory(const RowVectorPtr& data);
+
+  // Drops the data in 'queue_' after close().
+  void dropData();
+
+  // Returns the promises of the blocked consumers. Must be called with
+  // 'mutex_' held.
+  std::vector<ContinuePromise> takeConsumerPromisesLocked();
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::UMPMCQueue<RowVectorPtr, /*MayBlock=*/false> queue_;
+  std::atomic_bool closed_{false};
+
+  // Guards the members below.
+  std::mutex mutex_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
   std::vector<ContinuePromise> consumerPromises_;
+  // Number of consumers in 'consumerPromises_'. Lets the producers skip
+  // 'mutex_' when no consumer is blocked. Modified with 'mutex_' held.
+  std::atomic<int32_t> numBlockedConsumers_{0};
   int pendingProducers_{0};
   bool noMoreProducers_{false};
-  bool closed_{false};
 };
 
 /// Fetches data for a single partition produced by local exchange from
@@ -142,8 +180,16 @@ class LocalExchange : public SourceOperator {
 
 /// Hash partitions the data using specified keys. The number of partitions is
 /// determined by the number of LocalExchangeQueues(s) found in the task.
+///
+/// If the plan node allows rebalancing hot partitions, the rows sent to each
+/// partition are counted over windows of kSkewWindowRows input rows. The rows
+/// of the partitions that got more than
+/// QueryConfig::localPartitionSkewThreshold() times the average in the last
+/// window are spread round-robin over all partitions.
 class LocalPartition : public Operator {
  public:
+  static constexpr int64_t kSkewWindowRows = 64 << 10;
+
   LocalPartition(
       int32_t operatorId,
       DriverCtx* ctx,
@@ -176,11 +222,26 @@ class LocalPartition : public Operator {
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
 
+  // Counts the first 'numRows' rows of 'partitions_' into the current
+  // sampling window and reassigns the rows of the hot partitions. Returns true
+  // if any row was reassigned.
+  bool rebalanceHotPartitions(vector_size_t numRows);
+
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
 
   /// Reusable memory for hash calculation.
   std::vector<uint32_t> partitions_;
+
+  // Zero if skew rebalancing is disabled.
+  const double skewThreshold_;
+  // Number of rows per partition in the current sampling window.
+  std::vector<int64_t> windowPartitionRows_;
+  int64_t windowRows_{0};
+  // True for the partitions that were hot in the last sampling window.
+  std::vector<bool> hotPartitions_;
+  int32_t numHotPartitions_{0};
+  uint32_t nextRebalancedPartition_{0};
 };
 
 } // namespace facebook::velox::exec
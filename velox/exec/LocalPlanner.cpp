@@ -17,6 +17,7 @@
 #include "velox/core/PlanFragment.h"
 #include "velox/exec/ArrowStream.h"
 #include "velox/exec/AssignUniqueId.h"
+#include "velox/exec/BatchCoalesce.h"
 #include "velox/exec/CallbackSink.h"
 #include "velox/exec/EnforceSingleRow.h"
 #include "velox/exec/Exchange.h"
@@ -133,12 +134,49 @@ OperatorSupplier makeConsumerSupplier(
   return Operator::operatorSupplierFromPlanNode(planNode);
 }
 
+// Returns a LocalMerge over a partial OrderBy to run a final 'orderBy' in
+// parallel. The partial OrderBy runs in the multi-threaded pipeline of the
+// source of 'orderBy' and each of its drivers sorts its own input, spilled or
+// not, into a stream that the LocalMerge merges in order. Both nodes keep the
+// id of 'orderBy' so that their stats are reported for it.
+std::shared_ptr<const core::PlanNode> makeParallelOrderBy(
+    const std::shared_ptr<const core::OrderByNode>& orderBy) {
+  auto partialOrderBy = std::make_shared<core::OrderByNode>(
+      orderBy->id(),
+      orderBy->sortingKeys(),
+      orderBy->sortingOrders(),
+      true, // isPartial
+      orderBy->sources()[0]);
+  return std::make_shared<core::LocalMergeNode>(
+      orderBy->id(),
+      orderBy->sortingKeys(),
+      orderBy->sortingOrders(),
+      std::vector<core::PlanNodePtr>{std::move(partialOrderBy)});
+}
+
 void plan(
     const std::shared_ptr<const core::PlanNode>& planNode,
     std::vector<std::shared_ptr<const core::PlanNode>>* currentPlanNodes,
     const std::shared_ptr<const core::PlanNode>& consumerNode,
     OperatorSupplier consumerSupplier,
-    std::vector<std::unique_ptr<DriverFactory>>* driverFactories) {
+    std::vector<std::unique_ptr<DriverFactory>>* driverFactories,
+    const core::QueryConfig& queryConfig) {
+  if (queryConfig.parallelOrderBy()) {
+    if (auto orderBy =
+            std::dynamic_pointer_cast<const core::OrderByNode>(planNode)) {
+      if (!orderBy->isPartial()) {
+        plan(
+            makeParallelOrderBy(orderBy),
+            currentPlanNodes,
+            consumerNode,
+            std::move(consumerSupplier),
+            driverFactories,
+            queryConfig);
+        return;
+      }
+    }
+  }
+
   if (!currentPlanNodes) {
     driverFactories->push_back(std::make_unique<DriverFactory>());
     currentPlanNodes = &driverFactories->back()->planNodes;
@@ -156,7 +194,8 @@ void plan(
           mustStartNewPipeline(planNode, i) ? nullptr : currentPlanNodes,
           planNode,
           makeConsumerSupplier(planNode),
-          driverFactories);
+          driverFactories,
+          queryConfig);
     }
   }
 
@@ -280,7 +319,8 @@ void LocalPlanner::plan(
       nullptr,
       nullptr,
       detail::makeConsumerSupplier(consumerSupplier),
-      driverFactories);
+      driverFactories,
+      queryConfig);
 
   (*driverFactories)[0]->outputDriver = true;
 
@@ -404,6 +444,14 @@ bool eagerFlush(const core::PlanNode& node) {
   return eagerFlush(*node.sources()[0]);
 }
 
+// Returns true if the operator for 'node' has a high fixed cost per input
+// batch, so that small batches out of a filter before it are coalesced.
+bool coalesceBatchesBefore(const core::PlanNodePtr& node) {
+  return std::dynamic_pointer_cast<const core::HashJoinNode>(node) ||
+      std::dynamic_pointer_cast<const core::AggregationNode>(node) ||
+      std::dynamic_pointer_cast<const core::PartitionedOutputNode>(node);
+}
+
 } // namespace
 
 std::shared_ptr<Driver> DriverFactory::createDriver(
@@ -415,6 +463,25 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
   std::vector<std::unique_ptr<Operator>> operators;
   operators.reserve(planNodes.size());
 
+  // Adds a BatchCoalesce after the FilterProject at the end of 'operators' if
+  // the node at 'nextIndex', or the consumer after the last node, benefits
+  // from larger batches.
+  const bool adaptiveBatchSize =
+      ctx->queryConfig().adaptiveOutputBatchSizeEnabled();
+  auto maybeAddBatchCoalesce = [&](int32_t nextIndex) {
+    if (!adaptiveBatchSize) {
+      return;
+    }
+    const auto& next =
+        nextIndex < planNodes.size() ? planNodes[nextIndex] : consumerNode;
+    if (next == nullptr || !coalesceBatchesBefore(next)) {
+      return;
+    }
+    auto* filter = static_cast<FilterProject*>(operators.back().get());
+    operators.push_back(
+        std::make_unique<BatchCoalesce>(operators.size(), ctx.get(), filter));
+  };
+
   for (int32_t i = 0; i < planNodes.size(); i++) {
     // Id of the Operator being made. This is not the same as 'i'
     // because some PlanNodes may get fused.
@@ -429,11 +496,13 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
           operators.push_back(std::make_unique<FilterProject>(
               id, ctx.get(), filterNode, projectNode));
           i++;
+          maybeAddBatchCoalesce(i + 1);
           continue;
         }
       }
       operators.push_back(
           std::make_unique<FilterProject>(id, ctx.get(), filterNode, nullptr));
+      maybeAddBatchCoalesce(i + 1);
     } else if (
         auto projectNode =
             std::dynamic_pointer_cast<const core::ProjectNode>(planNode)) {
@@ -500,8 +569,15 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
         operators.push_back(std::make_unique<StreamingAggregation>(
             id, ctx.get(), aggregationNode));
       } else {
-        operators.push_back(
-            std::make_unique<HashAggregation>(id, ctx.get(), aggregationNode));
+        // A TopN right after the aggregation lets a final aggregation drop
+        // input that can't make it into the top N groups.
+        std::shared_ptr<const core::TopNNode> topNNode;
+        if (i < planNodes.size() - 1) {
+          topNNode =
+              std::dynamic_pointer_cast<const core::TopNNode>(planNodes[i + 1]);
+        }
+        operators.push_back(std::make_unique<HashAggregation>(
+            id, ctx.get(), aggregationNode, topNNode));
       }
     } else if (
         auto expandNode =
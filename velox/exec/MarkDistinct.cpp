@@ -64,6 +64,18 @@ RowVectorPtr MarkDistinct::getOutput() {
   }
 
   auto outputSize = input_->size();
+  const auto& newGroups = groupingSet_->hashLookup().newGroups;
+
+  // When all or none of the rows are distinct, e.g. for all but the first
+  // batches of low cardinality keys, the mask is a constant.
+  if (newGroups.empty() || newGroups.size() == outputSize) {
+    results_[0] = BaseVector::createConstant(
+        BOOLEAN(), !newGroups.empty(), outputSize, operatorCtx_->pool());
+    auto output = fillOutput(outputSize, nullptr);
+    input_ = nullptr;
+    return output;
+  }
+
   // Re-use memory for the ID vector if possible.
   VectorPtr& result = results_[0];
   if (result && result.unique()) {
@@ -79,7 +91,7 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
+  for (const auto i : newGroups) {
     bits::setBit(resultBits, i, true);
   }
   auto output = fillOutput(outputSize, nullptr);
@@ -15,8 +15,10 @@
  */
 
 #include "velox/exec/Merge.h"
+#include <folly/lang/Bits.h>
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
+#include "velox/vector/DecodedVector.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -53,6 +55,10 @@ Merge::Merge(
             sortingOrders[i].isAscending(),
             false});
   }
+  keyLayout_ = MergeKeyLayout::make(
+      outputType_,
+      sortingKeys_,
+      driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes());
 }
 
 void Merge::initializeTreeOfLosers() {
@@ -60,7 +66,10 @@ void Merge::initializeTreeOfLosers() {
   sourceCursors.reserve(sources_.size());
   for (auto& source : sources_) {
     sourceCursors.push_back(std::make_unique<SourceStream>(
-        source.get(), sortingKeys_, outputBatchSize_));
+        source.get(),
+        sortingKeys_,
+        keyLayout_.has_value() ? &keyLayout_.value() : nullptr,
+        outputBatchSize_));
   }
 
   // Save the pointers to cursors before moving these into the TreeOfLosers.
@@ -154,6 +163,19 @@ RowVectorPtr Merge::getOutput() {
       return std::move(output_);
     }
 
+    if (stream == lastStream_) {
+      // The same stream won twice in a row. Take the rows that are not greater
+      // than the first rows of the other streams as one run without going
+      // through the tree for each row.
+      const auto numRows = stream->runLength(
+          treeOfLosers_->runnerUp(), outputBatchSize_ - outputSize_);
+      if (numRows > 1) {
+        stream->addRun(numRows, outputSize_, output_);
+        outputSize_ += numRows - 1;
+      }
+    }
+    lastStream_ = stream;
+
     if (stream->setOutputRow(outputSize_)) {
       // The stream is at end of input batch. Need to copy out the rows before
       // fetching next batch in 'pop'.
@@ -172,38 +194,148 @@ RowVectorPtr Merge::getOutput() {
       }
 
       outputSize_ = 0;
+      sourcesAdvanced();
       return std::move(output_);
     }
 
     if (!sourceBlockingFutures_.empty()) {
+      sourcesAdvanced();
       return nullptr;
     }
   }
 }
 
+std::vector<uint32_t> Merge::sourcesInMergeOrder() const {
+  std::vector<uint32_t> waiting;
+  std::vector<uint32_t> ready;
+  for (uint32_t i = 0; i < streams_.size(); ++i) {
+    if (!streams_[i]->hasData()) {
+      continue;
+    }
+    if (streams_[i]->needsData()) {
+      waiting.push_back(i);
+    } else {
+      ready.push_back(i);
+    }
+  }
+  std::sort(ready.begin(), ready.end(), [&](uint32_t left, uint32_t right) {
+    return *streams_[left] < *streams_[right];
+  });
+  waiting.insert(waiting.end(), ready.begin(), ready.end());
+  return waiting;
+}
+
 void Merge::close() {
   for (auto& source : sources_) {
     source->close();
   }
 }
 
-bool SourceStream::operator<(const MergeStream& other) const {
-  const auto& otherCursor = static_cast<const SourceStream&>(other);
+// static
+std::optional<MergeKeyLayout> MergeKeyLayout::make(
+    const RowTypePtr& type,
+    const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+    uint32_t maxBytes) {
+  MergeKeyLayout layout;
+  uint32_t numBytes = 0;
+  for (const auto& [channel, compareFlags] : sortingKeys) {
+    const auto kind = type->childAt(channel)->kind();
+    const auto size = prefixsort::PrefixSortEncoder::encodedSize(kind);
+    if (!size.has_value()) {
+      return std::nullopt;
+    }
+    layout.encoders.emplace_back(
+        compareFlags.ascending, compareFlags.nullsFirst);
+    layout.kinds.push_back(kind);
+    layout.offsets.push_back(numBytes);
+    numBytes += size.value();
+  }
+  if (numBytes == 0 || numBytes > maxBytes) {
+    return std::nullopt;
+  }
+  layout.numWords =
+      bits::roundUp(numBytes, sizeof(uint64_t)) / sizeof(uint64_t);
+  return layout;
+}
+
+int32_t SourceStream::compareKeys(
+    vector_size_t row,
+    const SourceStream& other,
+    vector_size_t otherRow) const {
   for (auto i = 0; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
-    if (auto result = keyColumns_[i]
-                          ->compare(
-                              otherCursor.keyColumns_[i],
-                              currentSourceRow_,
-                              otherCursor.currentSourceRow_,
-                              compareFlags)
-                          .value()) {
-      return result < 0;
+    if (auto result =
+            keyColumns_[i]
+                ->compare(other.keyColumns_[i], row, otherRow, compareFlags)
+                .value()) {
+      return result;
     }
   }
-  return false;
+  return 0;
+}
+
+vector_size_t SourceStream::runLength(
+    const SourceStream* bound,
+    vector_size_t maxRows) const {
+  const vector_size_t endRow =
+      std::min<int64_t>(data_->size(), currentSourceRow_ + maxRows);
+  if (bound == nullptr) {
+    return endRow - currentSourceRow_;
+  }
+  const auto greater = [&](vector_size_t row) {
+    return keyLayout_ != nullptr
+        ? compareNormalized(row, *bound, bound->currentSourceRow_) > 0
+        : compareKeys(row, *bound, bound->currentSourceRow_) > 0;
+  };
+  // The rows are sorted. Find the first row greater than 'bound' with an
+  // exponential search from the current row followed by a binary search, so
+  // that short runs cost few comparisons.
+  vector_size_t low = currentSourceRow_;
+  vector_size_t step = 1;
+  vector_size_t high = low + step;
+  while (high < endRow && !greater(high)) {
+    low = high;
+    step *= 2;
+    high = std::min<int64_t>(endRow, low + step);
+  }
+  high = std::min(high, endRow);
+  while (high - low > 1) {
+    const auto middle = low + (high - low) / 2;
+    if (greater(middle)) {
+      high = middle;
+    } else {
+      low = middle;
+    }
+  }
+  return high - currentSourceRow_;
+}
+
+void SourceStream::addRun(
+    vector_size_t numRows,
+    vector_size_t outputRow,
+    RowVectorPtr& output) {
+  VELOX_DCHECK_GT(numRows, 0);
+  VELOX_DCHECK_LE(currentSourceRow_ + numRows, data_->size());
+  const auto numRunRows = numRows - 1;
+  if (numRunRows >= kMinCopyRangeRows) {
+    // Copy out the rows recorded so far, so that the first row not copied out
+    // is the current row, and then the run as one range.
+    copyToOutput(output);
+    VELOX_DCHECK_EQ(firstSourceRow_, currentSourceRow_);
+    for (auto i = 0; i < output->type()->size(); ++i) {
+      output->childAt(i)->copy(
+          data_->childAt(i).get(), outputRow, currentSourceRow_, numRunRows);
+    }
+    currentSourceRow_ += numRunRows;
+    firstSourceRow_ = currentSourceRow_;
+    return;
+  }
+  for (auto i = 0; i < numRunRows; ++i) {
+    outputRows_.setValid(outputRow + i, true);
+  }
+  currentSourceRow_ += numRunRows;
 }
 
 bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
@@ -263,10 +395,66 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    if (keyLayout_ != nullptr) {
+      normalizeKeys();
+    }
   }
   return false;
 }
 
+void SourceStream::normalizeKeys() {
+  const auto numWords = data_->size() * keyLayout_->numWords;
+  // The bytes between and after the keys stay zero.
+  normalizedKeys_.assign(numWords, 0);
+  auto* words = normalizedKeys_.data();
+  for (auto i = 0; i < keyLayout_->kinds.size(); ++i) {
+    switch (keyLayout_->kinds[i]) {
+      case TypeKind::INTEGER:
+        normalizeKey<int32_t>(i, words);
+        break;
+      case TypeKind::BIGINT:
+        normalizeKey<int64_t>(i, words);
+        break;
+      case TypeKind::REAL:
+        normalizeKey<float>(i, words);
+        break;
+      case TypeKind::DOUBLE:
+        normalizeKey<double>(i, words);
+        break;
+      case TypeKind::TIMESTAMP:
+        normalizeKey<Timestamp>(i, words);
+        break;
+      case TypeKind::HUGEINT:
+        normalizeKey<int128_t>(i, words);
+        break;
+      default:
+        VELOX_UNREACHABLE(
+            "Unexpected normalized merge key type: {}",
+            keyLayout_->kinds[i]);
+    }
+  }
+  // The encoded bytes compare like the keys. Load these as big endian words
+  // so that comparing the words gives the same result.
+  for (auto i = 0; i < numWords; ++i) {
+    words[i] = folly::Endian::big(words[i]);
+  }
+}
+
+template <typename T>
+void SourceStream::normalizeKey(int32_t keyIndex, uint64_t* words) {
+  const auto& encoder = keyLayout_->encoders[keyIndex];
+  const auto rowBytes = keyLayout_->numWords * sizeof(uint64_t);
+  auto* dest = reinterpret_cast<char*>(words) + keyLayout_->offsets[keyIndex];
+  DecodedVector decoded(*keyColumns_[keyIndex]);
+  for (auto row = 0; row < data_->size(); ++row, dest += rowBytes) {
+    if (decoded.isNullAt(row)) {
+      encoder.encode<T>(std::nullopt, dest);
+    } else {
+      encoder.encode<T>(decoded.valueAt<T>(row), dest);
+    }
+  }
+}
+
 LocalMerge::LocalMerge(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -328,15 +516,22 @@ BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
       } else {
         noMoreSplits_ = true;
         if (!remoteSourceTaskIds_.empty()) {
-          const auto maxMergeExchangeBufferSize =
-              operatorCtx_->driverCtx()
-                  ->queryConfig()
-                  .maxMergeExchangeBufferSize();
-          const auto maxQueuedBytesPerSource = std::min<int64_t>(
+          maxBufferedBytes_ = operatorCtx_->driverCtx()
+                                  ->queryConfig()
+                                  .maxMergeExchangeBufferSize();
+          // With more than one source, half of the budget is spread over the
+          // sources and the other half is read ahead for the sources the merge
+          // needs data from first, see sourcesAdvanced().
+          const int64_t numShares = remoteSourceTaskIds_.size() == 1
+              ? 1
+              : 2 * remoteSourceTaskIds_.size();
+          minQueuedBytesPerSource_ = std::min<int64_t>(
               std::max<int64_t>(
-                  maxMergeExchangeBufferSize / remoteSourceTaskIds_.size(),
+                  maxBufferedBytes_ / numShares,
                   MergeSource::kMaxQueuedBytesLowerLimit),
               MergeSource::kMaxQueuedBytesUpperLimit);
+          sourceMaxQueuedBytes_.assign(
+              remoteSourceTaskIds_.size(), minQueuedBytesPerSource_);
           for (uint32_t remoteSourceIndex = 0;
                remoteSourceIndex < remoteSourceTaskIds_.size();
                ++remoteSourceIndex) {
@@ -348,7 +543,7 @@ BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
                 this,
                 remoteSourceTaskIds_[remoteSourceIndex],
                 operatorCtx_->task()->destination(),
-                maxQueuedBytesPerSource,
+                minQueuedBytesPerSource_,
                 pool,
                 operatorCtx_->task()->queryCtx()->executor()));
           }
@@ -364,4 +559,31 @@ BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   }
 }
 
+void MergeExchange::sourcesAdvanced() {
+  if (sourceMaxQueuedBytes_.size() < 2) {
+    return;
+  }
+  const auto sourceOrder = sourcesInMergeOrder();
+  std::vector<int64_t> maxQueuedBytes(
+      sourceMaxQueuedBytes_.size(), minQueuedBytesPerSource_);
+  int64_t readAheadBytes =
+      maxBufferedBytes_ - minQueuedBytesPerSource_ * sourceOrder.size();
+  for (auto index : sourceOrder) {
+    if (readAheadBytes <= 0) {
+      break;
+    }
+    const auto sourceReadAheadBytes = std::min<int64_t>(
+        readAheadBytes,
+        MergeSource::kMaxQueuedBytesUpperLimit - minQueuedBytesPerSource_);
+    maxQueuedBytes[index] += sourceReadAheadBytes;
+    readAheadBytes -= sourceReadAheadBytes;
+  }
+  for (auto i = 0; i < sources_.size(); ++i) {
+    if (maxQueuedBytes[i] != sourceMaxQueuedBytes_[i]) {
+      sources_[i]->setMaxQueuedBytes(maxQueuedBytes[i]);
+      sourceMaxQueuedBytes_[i] = maxQueuedBytes[i];
+    }
+  }
+}
+
 } // namespace facebook::velox::exec
@@ -18,11 +18,38 @@
 #include "velox/exec/Exchange.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/TreeOfLosers.h"
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
 
 namespace facebook::velox::exec {
 
 class SourceStream;
 
+/// Layout of the sorting keys of a merge when all keys are of fixed width
+/// types supported by PrefixSortEncoder. The keys of each source row are
+/// encoded with the PrefixSort encoding into 'numWords' 64 bit words that
+/// compare like the keys, so that the streams are compared without going
+/// through BaseVector::compare.
+struct MergeKeyLayout {
+  /// Returns the layout for 'sortingKeys' of 'type' or std::nullopt if some
+  /// key is not fixed width or the encoded keys take more than 'maxBytes'.
+  static std::optional<MergeKeyLayout> make(
+      const RowTypePtr& type,
+      const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+      uint32_t maxBytes);
+
+  /// One encoder per sorting key.
+  std::vector<prefixsort::PrefixSortEncoder> encoders;
+
+  /// Type kind of each sorting key.
+  std::vector<TypeKind> kinds;
+
+  /// Byte offset of each sorting key in the encoded row.
+  std::vector<uint32_t> offsets;
+
+  /// Number of words per encoded row.
+  int32_t numWords;
+};
+
 // Merge operator Implementation: This implementation uses priority queue
 // to perform a k-way merge of its inputs. It stops merging if any one of
 // its inputs is blocked.
@@ -46,13 +73,19 @@ class Merge : public SourceOperator {
 
   void close() override;
 
-  const RowTypePtr& outputType() const {
-    return outputType_;
-  }
-
  protected:
   virtual BlockingReason addMergeSources(ContinueFuture* future) = 0;
 
+  /// Called when the merge has produced a batch of output or waits for a
+  /// source.
+  virtual void sourcesAdvanced() {}
+
+  /// Returns the indices in 'sources_' of the sources that are not at end,
+  /// in the order the merge needs more data from them: first the sources the
+  /// merge waits for, then the others in the order of their current rows.
+  /// Empty if there is only one source.
+  std::vector<uint32_t> sourcesInMergeOrder() const;
+
   std::vector<std::shared_ptr<MergeSource>> sources_;
 
  private:
@@ -63,6 +96,9 @@ class Merge : public SourceOperator {
 
   std::vector<std::pair<column_index_t, CompareFlags>> sortingKeys_;
 
+  /// Set if the sorting keys are compared in normalized form.
+  std::optional<MergeKeyLayout> keyLayout_;
+
   /// A list of cursors over batches of ordered source data. One per source.
   /// Aligned with 'sources'.
   std::vector<SourceStream*> streams_;
@@ -75,6 +111,11 @@ class Merge : public SourceOperator {
   /// Number of rows accumulated in 'output_' so far.
   vector_size_t outputSize_{0};
 
+  /// The stream that produced the previous output row. If the same stream
+  /// wins twice in a row, the rows that sort before the other streams are
+  /// taken from it as one run.
+  SourceStream* lastStream_{nullptr};
+
   bool finished_{false};
 
   /// A list of blocking futures for sources. These are populates when a given
@@ -87,9 +128,11 @@ class SourceStream final : public MergeStream {
   SourceStream(
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+      const MergeKeyLayout* keyLayout,
       uint32_t outputBatchSize)
       : source_{source},
         sortingKeys_{sortingKeys},
+        keyLayout_{keyLayout},
         outputRows_(outputBatchSize, false),
         sourceRows_(outputBatchSize) {
     keyColumns_.reserve(sortingKeys.size());
@@ -108,9 +151,43 @@ class SourceStream final : public MergeStream {
     return !atEnd_;
   }
 
+  /// Returns true if the stream ran out of rows and waits for the source.
+  bool needsData() const {
+    return needData_;
+  }
+
   /// Returns true if current source row is less then current source row in
   /// 'other'.
-  bool operator<(const MergeStream& other) const override;
+  bool operator<(const MergeStream& other) const override {
+    const auto& otherStream = static_cast<const SourceStream&>(other);
+    if (keyLayout_ != nullptr) {
+      return compareNormalized(
+                 currentSourceRow_, otherStream, otherStream.currentSourceRow_) <
+          0;
+    }
+    return compareKeys(
+               currentSourceRow_, otherStream, otherStream.currentSourceRow_) <
+        0;
+  }
+
+  /// Returns the number of rows starting at the current row that are not
+  /// greater than the current row of 'bound', or all the remaining rows of
+  /// the current batch if 'bound' is nullptr. The result is at least 1 and at
+  /// most 'maxRows'. The current row must not be greater than the current row
+  /// of 'bound'.
+  vector_size_t runLength(const SourceStream* bound, vector_size_t maxRows)
+      const;
+
+  /// Copies 'numRows' - 1 rows starting at the current row to 'output'
+  /// starting at 'outputRow' and makes the last row of the run the current
+  /// row. The rows are copied as one range if there are at least
+  /// 'kMinCopyRangeRows' of them, otherwise these are recorded like with
+  /// setOutputRow(). The caller then adds the current row with
+  /// setOutputRow() and pop(). 'numRows' must not be more than runLength().
+  void addRun(
+      vector_size_t numRows,
+      vector_size_t outputRow,
+      RowVectorPtr& output);
 
   /// Advances to the next row. Returns true and appends a future to 'futures'
   /// if runs out of rows in the current batch and needs to wait for the
@@ -134,12 +211,58 @@ class SourceStream final : public MergeStream {
   void copyToOutput(RowVectorPtr& output);
 
  private:
+  /// Minimum number of rows in a run to copy these as one range instead of
+  /// row by row.
+  static constexpr vector_size_t kMinCopyRangeRows = 16;
+
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  /// Fills 'normalizedKeys_' with the encoded keys of all rows in 'data_'.
+  void normalizeKeys();
+
+  template <typename T>
+  void normalizeKey(int32_t keyIndex, uint64_t* words);
+
+  const uint64_t* normalizedKey(vector_size_t row) const {
+    return normalizedKeys_.data() + row * keyLayout_->numWords;
+  }
+
+  /// Compares the keys of 'row' to the keys of 'otherRow' in 'other' with
+  /// BaseVector::compare.
+  int32_t compareKeys(
+      vector_size_t row,
+      const SourceStream& other,
+      vector_size_t otherRow) const;
+
+  /// Compares the normalized keys of 'row' to the ones of 'otherRow' in
+  /// 'other'.
+  FOLLY_ALWAYS_INLINE int32_t compareNormalized(
+      vector_size_t row,
+      const SourceStream& other,
+      vector_size_t otherRow) const {
+    const auto* left = normalizedKey(row);
+    const auto* right = other.normalizedKey(otherRow);
+    for (auto i = 0; i < keyLayout_->numWords; ++i) {
+      if (left[i] != right[i]) {
+        return left[i] < right[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
 
+  /// Layout of normalized keys. nullptr if keys are compared with
+  /// BaseVector::compare.
+  const MergeKeyLayout* const keyLayout_;
+
+  /// Normalized keys of the rows of 'data_', 'keyLayout_->numWords' words per
+  /// row. The words hold the encoded bytes in big endian order, so that
+  /// comparing words compares the keys.
+  std::vector<uint64_t> normalizedKeys_;
+
   /// Ordered source rows.
   RowVectorPtr data_;
 
@@ -194,10 +317,25 @@ class MergeExchange : public Merge {
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
+  /// Moves the read-ahead budget to the sources the merge needs data from
+  /// first.
+  void sourcesAdvanced() override;
+
  private:
   bool noMoreSplits_ = false;
   // Task Ids from all the splits we took to process so far.
   std::vector<std::string> remoteSourceTaskIds_;
+
+  // The max bytes buffered by all the sources, see
+  // QueryConfig::kMaxMergeExchangeBufferSize.
+  int64_t maxBufferedBytes_{0};
+
+  // The max bytes buffered by each source. The rest of 'maxBufferedBytes_'
+  // is read ahead by the sources that come first in sourcesInMergeOrder().
+  int64_t minQueuedBytesPerSource_{0};
+
+  // The max bytes last set for each source in 'sources_'.
+  std::vector<int64_t> sourceMaxQueuedBytes_;
 };
 
 } // namespace facebook::velox::exec
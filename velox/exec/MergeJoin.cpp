@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/MergeJoin.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -29,7 +30,10 @@ MergeJoin::MergeJoin(
           joinNode->outputType(),
           operatorId,
           joinNode->id(),
-          "MergeJoin"),
+          "MergeJoin",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       outputBatchSize_{static_cast<vector_size_t>(outputBatchRows())},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
@@ -469,6 +473,16 @@ bool MergeJoin::addToOutput() {
     auto leftEnd = l == numLefts - 1 ? leftMatch_->endIndex : left->size();
 
     for (auto i = leftStart; i < leftEnd; ++i) {
+      // The spilled rows of the right side match precede the ones in memory.
+      // Skip them if resuming from the rows in memory.
+      if (spilledRightMatch_.has_value() &&
+          (spilledRightMatch_->reader != nullptr ||
+           !(l == firstLeftBatch && i == leftStart && rightMatch_->cursor))) {
+        if (addSpilledRightToOutput(left, l, i)) {
+          return true;
+        }
+      }
+
       auto firstRightBatch =
           (l == firstLeftBatch && i == leftStart && rightMatch_->cursor)
           ? rightMatch_->cursor->batchIndex
@@ -523,6 +537,7 @@ bool MergeJoin::addToOutput() {
 
   leftMatch_.reset();
   rightMatch_.reset();
+  spilledRightMatch_.reset();
 
   // If the current key match finished, but there are still records to be
   // processed in the left, we need to load lazy vectors (see comment above).
@@ -532,6 +547,150 @@ bool MergeJoin::addToOutput() {
   return outputSize_ == outputBatchSize_;
 }
 
+bool MergeJoin::addSpilledRightToOutput(
+    const RowVectorPtr& left,
+    size_t leftBatchIndex,
+    vector_size_t leftIndex) {
+  auto& spilled = spilledRightMatch_.value();
+  if (spilled.reader == nullptr) {
+    if (spilled.writer != nullptr) {
+      auto files = spilled.writer->finish();
+      spilled.files.insert(spilled.files.end(), files.begin(), files.end());
+      spilled.writer.reset();
+    }
+    // The spilled rows are read once for each row on the left side.
+    std::vector<std::unique_ptr<BatchStream>> streams;
+    streams.reserve(spilled.files.size());
+    for (const auto& file : spilled.files) {
+      streams.push_back(FileSpillBatchStream::create(SpillReadFile::create(
+          file,
+          spillConfig_->readBufferSize,
+          pool(),
+          &spillStats_,
+          SpillReadAheadOptions::fromSpillConfig(*spillConfig_))));
+    }
+    spilled.reader = std::make_unique<UnorderedStreamReader<BatchStream>>(
+        std::move(streams));
+    spilled.batch = nullptr;
+    spilled.index = 0;
+  }
+
+  // Resumes with the rows in memory after the spilled rows.
+  auto setCursors = [&]() {
+    leftMatch_->setCursor(leftBatchIndex, leftIndex);
+    rightMatch_->setCursor(0, rightMatch_->startIndex);
+  };
+
+  for (;;) {
+    if (spilled.batch == nullptr || spilled.index == spilled.batch->size()) {
+      // Reads into a new vector since output_ may wrap the previous one.
+      RowVectorPtr batch;
+      if (!spilled.reader->nextBatch(batch)) {
+        spilled.reader.reset();
+        spilled.batch = nullptr;
+        return false;
+      }
+      spilled.batch = std::move(batch);
+      spilled.index = 0;
+    }
+
+    if (prepareOutput(left, spilled.batch)) {
+      output_->resize(outputSize_);
+      setCursors();
+      return true;
+    }
+
+    for (; spilled.index < spilled.batch->size(); ++spilled.index) {
+      if (outputSize_ == outputBatchSize_) {
+        loadColumns(currentLeft_, *operatorCtx_->execCtx());
+        setCursors();
+        return true;
+      }
+      addOutputRow(left, leftIndex, spilled.batch, spilled.index);
+    }
+  }
+}
+
+bool MergeJoin::canSpillRightMatch() const {
+  // The last batch is kept to find the end of the match and is likely still
+  // referenced by 'rightInput_'. The batches are not spilled while the match
+  // is being added to the output since the cursors index into them.
+  return rightMatch_.has_value() && rightMatch_->inputs.size() > 1 &&
+      !rightMatch_->cursor.has_value();
+}
+
+void MergeJoin::spillRightMatch() {
+  VELOX_CHECK(canSpillRightMatch());
+  if (!spilledRightMatch_.has_value()) {
+    spilledRightMatch_ = SpilledRightMatch{};
+  }
+  auto& spilled = spilledRightMatch_.value();
+  auto& inputs = rightMatch_->inputs;
+  if (spilled.writer == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    auto updateAndCheckSpillLimitCb = spillConfig.updateAndCheckSpillLimitCb;
+    spilled.writer = std::make_unique<SpillWriter>(
+        asRowType(inputs.front()->type()),
+        0,
+        std::vector<CompareFlags>{},
+        spillConfig.compressionKind,
+        spillConfig.getSpillDirPathCb(),
+        fmt::format("{}-right-match", spillConfig.fileNamePrefix),
+        spillConfig.maxFileSize,
+        spillConfig.writeBufferSize,
+        spillConfig.fileCreateConfig,
+        updateAndCheckSpillLimitCb,
+        memory::spillMemoryPool(),
+        &spillStats_,
+        spillConfig.getOverflowSpillDirPathCb);
+  }
+
+  const auto numSpilledInputs = inputs.size() - 1;
+  for (size_t i = 0; i < numSpilledInputs; ++i) {
+    const auto begin = i == 0 ? rightMatch_->startIndex : 0;
+    IndexRange range{begin, inputs[i]->size() - begin};
+    spilled.writer->write(inputs[i], folly::Range<IndexRange*>(&range, 1));
+  }
+  inputs.erase(inputs.begin(), inputs.begin() + numSpilledInputs);
+  rightMatch_->startIndex = 0;
+}
+
+bool MergeJoin::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim()) {
+    return false;
+  }
+  // The right side batches are allocated from the memory pools of the right
+  // side pipeline, so the reservation of this operator doesn't reflect them.
+  if (canSpillRightMatch()) {
+    const auto& inputs = rightMatch_->inputs;
+    for (size_t i = 0; i < inputs.size() - 1; ++i) {
+      reclaimableBytes += inputs[i]->retainedSize();
+    }
+  }
+  return true;
+}
+
+void MergeJoin::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (!canSpillRightMatch()) {
+    // Nothing to spill.
+    return;
+  }
+  spillRightMatch();
+}
+
+void MergeJoin::testingMaybeTriggerSpill() {
+  if (canSpill() && testingTriggerSpill(pool()->name())) {
+    Operator::ReclaimableSectionGuard guard(this);
+    memory::testingRunArbitration(pool());
+  }
+}
+
 namespace {
 vector_size_t firstNonNull(
     const RowVectorPtr& rowVector,
@@ -682,6 +841,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
       if (!findEndOfMatch(rightMatch_.value(), rightInput_, rightKeys_)) {
         // Continue looking for the end of the match.
         rightInput_ = nullptr;
+        testingMaybeTriggerSpill();
         return nullptr;
       }
       if (rightMatch_->inputs.back() == rightInput_) {
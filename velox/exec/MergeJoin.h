@@ -18,6 +18,7 @@
 
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spill.h"
 
 namespace facebook::velox::exec {
 
@@ -42,6 +43,12 @@ namespace facebook::velox::exec {
 /// Dictionaries for right projections are optimistically created; we start by
 /// wrapping the current right vector, but if the output happens to span more
 /// than one right vector, it gets copied and flattened.
+///
+/// If spilling is enabled, the memory arbitrator can reclaim the batches of a
+/// key match on the right side. These are written to spill files, except for
+/// the last batch, and streamed back from the files for each row of the key
+/// match on the left side when producing the cartesian product. Semi joins are
+/// not spilled.
 class MergeJoin : public Operator {
  public:
   MergeJoin(
@@ -61,10 +68,18 @@ class MergeJoin : public Operator {
 
   bool isFinished() override;
 
+  /// Reports the retained size of the right side batches that reclaim() can
+  /// spill.
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   void close() override {
     if (rightSource_) {
       rightSource_->close();
     }
+    spilledRightMatch_.reset();
     Operator::close();
   }
 
@@ -188,6 +203,28 @@ class MergeJoin : public Operator {
   // rightMatchCursor_ if output_ filled up before all rows were added.
   bool addToOutput();
 
+  // Appends the spilled rows of the right side match for row 'leftIndex' of
+  // the left side batch 'left' to output_, resuming from where the previous
+  // call stopped if the spilled rows are being read. 'leftBatchIndex' is the
+  // index of 'left' in leftMatch_. Returns true if output_ filled up before
+  // all spilled rows were added and sets the cursors of leftMatch_ and
+  // rightMatch_ so that addToOutput() continues with the spilled rows.
+  bool addSpilledRightToOutput(
+      const RowVectorPtr& left,
+      size_t leftBatchIndex,
+      vector_size_t leftIndex);
+
+  // Returns true if reclaim() can spill some batches of rightMatch_.
+  bool canSpillRightMatch() const;
+
+  // Writes all but the last batch of rightMatch_ to spill files and removes
+  // them from rightMatch_.
+  void spillRightMatch();
+
+  // Runs the memory arbitration if spilling is enabled and the test-only spill
+  // injection fires, so that tests can spill the right side match.
+  void testingMaybeTriggerSpill();
+
   // Adds one row of output by writing to the indices of the output
   // dictionaries. By default, this operator returns dictionaries wrapped around
   // the input columns from the left and right. If `isRightFlattened_`, the
@@ -471,6 +508,26 @@ class MergeJoin : public Operator {
   // A set of rows with matching keys on the right side.
   std::optional<Match> rightMatch_;
 
+  // The rows of rightMatch_ spilled by reclaim(). These precede the rows in
+  // rightMatch_->inputs.
+  struct SpilledRightMatch {
+    // Writes the spilled rows. Finished into 'files' before the rows are read
+    // back.
+    std::unique_ptr<SpillWriter> writer;
+
+    SpillFiles files;
+
+    // Reads 'files' for the left side row being joined. Set from the first to
+    // the last spilled row added to the output for that row.
+    std::unique_ptr<UnorderedStreamReader<BatchStream>> reader;
+
+    // The batch read last from 'reader' and the next row to add from it.
+    RowVectorPtr batch;
+    vector_size_t index{0};
+  };
+
+  std::optional<SpilledRightMatch> spilledRightMatch_;
+
   RowVectorPtr output_;
 
   // Number of rows accumulated in the output_.
@@ -188,6 +188,12 @@ class MergeExchangeSource : public MergeSource {
     }
   }
 
+  void setMaxQueuedBytes(int64_t maxQueuedBytes) override {
+    if (client_) {
+      client_->setMaxQueuedBytes(maxQueuedBytes);
+    }
+  }
+
  private:
   MergeExchange* const mergeExchange_;
   std::shared_ptr<ExchangeClient> client_;
@@ -36,6 +36,10 @@ class MergeSource {
 
   virtual void close() = 0;
 
+  /// Sets the max bytes the source buffers ahead of next(). Only the sources
+  /// of a MergeExchange buffer ahead, so this does nothing for others.
+  virtual void setMaxQueuedBytes(int64_t /*maxQueuedBytes*/) {}
+
   // Factory methods to create MergeSources.
   static std::shared_ptr<MergeSource> createLocalMergeSource();
 
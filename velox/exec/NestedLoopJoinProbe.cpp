@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinProbe.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -42,6 +43,41 @@ std::vector<IdentityProjection> extractProjections(
   }
   return projections;
 }
+
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  if (auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr)) {
+    if (call->name() == "and") {
+      for (const auto& input : call->inputs()) {
+        flattenConjuncts(input, conjuncts);
+      }
+      return;
+    }
+  }
+  conjuncts.push_back(expr);
+}
+
+bool isRangeJoinKeyType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Bounds of a build column by probe columns.
+struct RangeBounds {
+  std::optional<column_index_t> lower;
+  std::optional<column_index_t> upper;
+};
 } // namespace
 
 NestedLoopJoinProbe::NestedLoopJoinProbe(
@@ -72,6 +108,10 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    initializeRangeJoin(
+        joinNode_->joinCondition(),
+        joinNode_->sources()[0]->outputType(),
+        joinNode_->sources()[1]->outputType());
   }
 
   joinNode_.reset();
@@ -103,6 +143,9 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
           buildMatched_[i].resizeFill(buildVectors_.value()[i]->size(), false);
         }
       }
+      if (rangeJoin_.has_value()) {
+        rangeJoin_->sortedBuildRows.resize(buildVectors_->size());
+      }
 
       setState(ProbeOperatorState::kRunning);
       return BlockingReason::kNotBlocked;
@@ -181,6 +224,16 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
+    if (rangeJoin_.has_value()) {
+      output = doRangeMatch();
+      if (advanceProbeRows(0)) {
+        if (!needsProbeMismatch(joinType_)) {
+          finishProbeInput();
+        }
+      }
+      continue;
+    }
+
     const vector_size_t probeCnt = getNumProbeRows();
     output = doMatch(probeCnt);
     if (advanceProbeRows(probeCnt)) {
@@ -235,6 +288,227 @@ void NestedLoopJoinProbe::initializeFilter(
   filterInputType_ = ROW(std::move(names), std::move(types));
 }
 
+void NestedLoopJoinProbe::initializeRangeJoin(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConjuncts(filter, conjuncts);
+
+  // Build channels in the order they are first bounded and their bounds.
+  std::vector<column_index_t> buildChannels;
+  std::unordered_map<column_index_t, RangeBounds> bounds;
+
+  // Returns the channel of 'expr' in 'type' if it is a column of a range join
+  // key type.
+  auto toChannel = [](const core::TypedExprPtr& expr,
+                      const RowTypePtr& type) -> std::optional<column_index_t> {
+    auto field = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+        expr);
+    if (field == nullptr || !field->isInputColumn() ||
+        !isRangeJoinKeyType(field->type())) {
+      return std::nullopt;
+    }
+    return type->getChildIdxIfExists(field->name());
+  };
+  // Records that 'probeChannel' is a lower or upper bound of 'buildChannel'.
+  auto addBound = [&](column_index_t probeChannel,
+                      column_index_t buildChannel,
+                      bool isLower) {
+    if (!probeType->childAt(probeChannel)
+             ->equivalent(*buildType->childAt(buildChannel))) {
+      return;
+    }
+    auto [it, inserted] = bounds.try_emplace(buildChannel);
+    if (inserted) {
+      buildChannels.push_back(buildChannel);
+    }
+    (isLower ? it->second.lower : it->second.upper) = probeChannel;
+  };
+
+  for (const auto& conjunct : conjuncts) {
+    auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(conjunct);
+    if (call == nullptr) {
+      continue;
+    }
+    const auto& name = call->name();
+    const auto& inputs = call->inputs();
+    if ((name == "lt" || name == "lte" || name == "gt" || name == "gte") &&
+        inputs.size() == 2) {
+      const bool isLess = name == "lt" || name == "lte";
+      const auto leftProbe = toChannel(inputs[0], probeType);
+      const auto rightBuild = toChannel(inputs[1], buildType);
+      if (leftProbe.has_value() && rightBuild.has_value()) {
+        // probe < build bounds the build column from below.
+        addBound(leftProbe.value(), rightBuild.value(), isLess);
+        continue;
+      }
+      const auto leftBuild = toChannel(inputs[0], buildType);
+      const auto rightProbe = toChannel(inputs[1], probeType);
+      if (leftBuild.has_value() && rightProbe.has_value()) {
+        // build < probe bounds the build column from above.
+        addBound(rightProbe.value(), leftBuild.value(), !isLess);
+      }
+    } else if (name == "between" && inputs.size() == 3) {
+      const auto valueBuild = toChannel(inputs[0], buildType);
+      const auto lowerProbe = toChannel(inputs[1], probeType);
+      const auto upperProbe = toChannel(inputs[2], probeType);
+      if (valueBuild.has_value()) {
+        if (lowerProbe.has_value()) {
+          addBound(lowerProbe.value(), valueBuild.value(), true);
+        }
+        if (upperProbe.has_value()) {
+          addBound(upperProbe.value(), valueBuild.value(), false);
+        }
+        continue;
+      }
+      // probe BETWEEN build.lower AND build.upper bounds 'build.lower' from
+      // above and 'build.upper' from below.
+      const auto valueProbe = toChannel(inputs[0], probeType);
+      if (!valueProbe.has_value()) {
+        continue;
+      }
+      if (const auto lowerBuild = toChannel(inputs[1], buildType)) {
+        addBound(valueProbe.value(), lowerBuild.value(), false);
+      }
+      if (const auto upperBuild = toChannel(inputs[2], buildType)) {
+        addBound(valueProbe.value(), upperBuild.value(), true);
+      }
+    }
+  }
+
+  if (buildChannels.empty()) {
+    return;
+  }
+  // Prefer a build column bounded from both sides.
+  auto buildChannel = buildChannels[0];
+  for (auto channel : buildChannels) {
+    const auto& channelBounds = bounds[channel];
+    if (channelBounds.lower.has_value() && channelBounds.upper.has_value()) {
+      buildChannel = channel;
+      break;
+    }
+  }
+  rangeJoin_ = RangeJoin{};
+  rangeJoin_->buildChannel = buildChannel;
+  rangeJoin_->lowerChannel = bounds[buildChannel].lower;
+  rangeJoin_->upperChannel = bounds[buildChannel].upper;
+}
+
+const std::vector<vector_size_t>& NestedLoopJoinProbe::sortedBuildRows() {
+  auto& sortedRows = rangeJoin_->sortedBuildRows[buildIndex_];
+  if (!sortedRows.has_value()) {
+    const auto& key =
+        buildVectors_.value()[buildIndex_]->childAt(rangeJoin_->buildChannel);
+    sortedRows.emplace();
+    sortedRows->reserve(key->size());
+    for (auto row = 0; row < key->size(); ++row) {
+      if (!key->isNullAt(row)) {
+        sortedRows->push_back(row);
+      }
+    }
+    std::sort(
+        sortedRows->begin(),
+        sortedRows->end(),
+        [&](vector_size_t left, vector_size_t right) {
+          return key->compare(key.get(), left, right, CompareFlags{}).value() <
+              0;
+        });
+  }
+  return sortedRows.value();
+}
+
+RowVectorPtr NestedLoopJoinProbe::doRangeMatch() {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  const auto& sortedRows = sortedBuildRows();
+  const auto& key =
+      buildVectors_.value()[buildIndex_]->childAt(rangeJoin_->buildChannel);
+  const auto* lower = rangeJoin_->lowerChannel.has_value()
+      ? input_->childAt(rangeJoin_->lowerChannel.value())->loadedVector()
+      : nullptr;
+  const auto* upper = rangeJoin_->upperChannel.has_value()
+      ? input_->childAt(rangeJoin_->upperChannel.value())->loadedVector()
+      : nullptr;
+
+  const vector_size_t maxCandidates = filterBatchSize();
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, maxCandidates, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, maxCandidates, pool());
+  vector_size_t numCandidates{0};
+  const auto numProbeRows = input_->size();
+  while (probeRow_ < numProbeRows && numCandidates < maxCandidates) {
+    auto& range = rangeJoin_.value();
+    if (!range.hasRange) {
+      // Build rows with a key in [lower, upper]. Comparisons with a null bound
+      // never pass.
+      auto begin = sortedRows.begin();
+      auto end = sortedRows.end();
+      if (lower != nullptr) {
+        if (lower->isNullAt(probeRow_)) {
+          end = begin;
+        } else {
+          begin = std::partition_point(begin, end, [&](vector_size_t row) {
+            return key->compare(lower, row, probeRow_, CompareFlags{})
+                       .value() < 0;
+          });
+        }
+      }
+      if (upper != nullptr && begin != end) {
+        if (upper->isNullAt(probeRow_)) {
+          end = begin;
+        } else {
+          end = std::partition_point(begin, end, [&](vector_size_t row) {
+            return key->compare(upper, row, probeRow_, CompareFlags{})
+                       .value() <= 0;
+          });
+        }
+      }
+      range.cursor = begin - sortedRows.begin();
+      range.end = end - sortedRows.begin();
+      range.hasRange = true;
+    }
+
+    const auto numRows =
+        std::min(range.end - range.cursor, maxCandidates - numCandidates);
+    for (auto i = 0; i < numRows; ++i) {
+      rawProbeIndices[numCandidates] = probeRow_;
+      rawBuildIndices[numCandidates] = sortedRows[range.cursor++];
+      ++numCandidates;
+    }
+    if (range.cursor == range.end) {
+      range.hasRange = false;
+      ++probeRow_;
+    }
+  }
+
+  if (numCandidates == 0) {
+    return nullptr;
+  }
+
+  std::vector<VectorPtr> projectedChildren(filterInputType_->size());
+  projectChildren(
+      projectedChildren,
+      input_,
+      filterProbeProjections_,
+      numCandidates,
+      probeIndices_);
+  projectChildren(
+      projectedChildren,
+      buildVectors_.value()[buildIndex_],
+      filterBuildProjections_,
+      numCandidates,
+      buildIndices_);
+  return evalJoinCondition(std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numCandidates,
+      std::move(projectedChildren)));
+}
+
 RowVectorPtr NestedLoopJoinProbe::getMismatchedOutput(
     const RowVectorPtr& data,
     const SelectivityVector& matched,
@@ -356,16 +630,32 @@ vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
 
   const auto inputSize = input_->size();
   auto numBuildRows = buildVectors_.value()[buildIndex_]->size();
+  const auto batchSize = joinCondition_ == nullptr
+      ? static_cast<vector_size_t>(outputBatchSize_)
+      : filterBatchSize();
   vector_size_t numProbeRows;
-  if (numBuildRows > outputBatchSize_) {
+  if (numBuildRows > batchSize) {
     numProbeRows = 1;
   } else {
-    numProbeRows = std::min(
-        (vector_size_t)outputBatchSize_ / numBuildRows, inputSize - probeRow_);
+    numProbeRows = std::min(batchSize / numBuildRows, inputSize - probeRow_);
   }
   return numProbeRows;
 }
 
+vector_size_t NestedLoopJoinProbe::filterBatchSize() const {
+  if (numFilterInputRows_ == 0) {
+    return outputBatchSize_;
+  }
+  // Sizes the pairs to evaluate so that the expected number of passing pairs
+  // fills an output batch.
+  const auto expectedBatchSize = outputBatchSize_ * numFilterInputRows_ /
+      std::max<int64_t>(numFilterPassedRows_, 1);
+  return std::clamp<int64_t>(
+      expectedBatchSize,
+      outputBatchSize_,
+      std::max<int64_t>(outputBatchSize_, kMaxFilterBatchSize));
+}
+
 RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
     vector_size_t probeCnt,
     const RowTypePtr& outputType,
@@ -424,6 +714,9 @@ bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
   }
   probeRow_ = 0;
   numPrevProbedRows_ = 0;
+  if (rangeJoin_.has_value()) {
+    rangeJoin_->hasRange = false;
+  }
   do {
     ++buildIndex_;
   } while (!hasProbedAllBuildData() &&
@@ -445,7 +738,11 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       filterInputType_,
       filterProbeProjections_,
       filterBuildProjections_);
+  return evalJoinCondition(filterInput);
+}
 
+RowVectorPtr NestedLoopJoinProbe::evalJoinCondition(
+    const RowVectorPtr& filterInput) {
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
   }
@@ -455,10 +752,8 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
   EvalCtx evalCtx(
       operatorCtx_->execCtx(), joinCondition_.get(), filterInput.get());
   joinCondition_->eval(0, 1, true, filterInputRows_, evalCtx, filterResult);
-  DecodedVector decodedFilterResult;
-  decodedFilterResult.decode(*filterResult[0], filterInputRows_);
 
-  const vector_size_t maxOutputRows = decodedFilterResult.size();
+  const vector_size_t maxOutputRows = filterInput->size();
   auto rawProbeOutMapping =
       initializeRowNumberMapping(probeOutMapping_, maxOutputRows, pool());
   auto rawBuildOutMapping =
@@ -466,14 +761,42 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
   auto* probeIndices = probeIndices_->asMutable<vector_size_t>();
   auto* buildIndices = buildIndices_->asMutable<vector_size_t>();
   int32_t numOutputRows{0};
-  for (auto i = 0; i < maxOutputRows; ++i) {
-    if (!decodedFilterResult.isNullAt(i) &&
-        decodedFilterResult.valueAt<bool>(i)) {
-      rawProbeOutMapping[numOutputRows] = probeIndices[i];
-      rawBuildOutMapping[numOutputRows] = buildIndices[i];
-      ++numOutputRows;
+  const auto& result = filterResult[0];
+  if (result->encoding() == VectorEncoding::Simple::FLAT) {
+    // Extracts the positions of the passing rows from the result bits a word
+    // at a time instead of testing the rows one by one.
+    const auto* passed =
+        result->asUnchecked<FlatVector<bool>>()->rawValues<uint64_t>();
+    if (result->mayHaveNulls()) {
+      const auto numWords = bits::nwords(maxOutputRows);
+      filterPassedBits_.resize(numWords);
+      const auto* nulls = result->rawNulls();
+      for (auto i = 0; i < numWords; ++i) {
+        filterPassedBits_[i] = passed[i] & nulls[i];
+      }
+      passed = filterPassedBits_.data();
+    }
+    numOutputRows = simd::indicesOfSetBits(
+        passed, 0, maxOutputRows, rawProbeOutMapping.data());
+    for (auto i = 0; i < numOutputRows; ++i) {
+      const auto row = rawProbeOutMapping[i];
+      rawBuildOutMapping[i] = buildIndices[row];
+      rawProbeOutMapping[i] = probeIndices[row];
+    }
+  } else {
+    DecodedVector decodedFilterResult;
+    decodedFilterResult.decode(*result, filterInputRows_);
+    for (auto i = 0; i < maxOutputRows; ++i) {
+      if (!decodedFilterResult.isNullAt(i) &&
+          decodedFilterResult.valueAt<bool>(i)) {
+        rawProbeOutMapping[numOutputRows] = probeIndices[i];
+        rawBuildOutMapping[numOutputRows] = buildIndices[i];
+        ++numOutputRows;
+      }
     }
   }
+  numFilterInputRows_ += maxOutputRows;
+  numFilterPassedRows_ += numOutputRows;
   if (needsProbeMismatch(joinType_)) {
     for (auto i = 0; i < numOutputRows; ++i) {
       probeMatched_.setValid(rawProbeOutMapping[i], true);
@@ -62,6 +62,12 @@ class NestedLoopJoinProbe : public Operator {
   // given the output batch size limit.
   vector_size_t getNumProbeRows() const;
 
+  // Returns the number of probe and build row pairs to evaluate the join
+  // condition on at a time. This is the output batch size scaled by the
+  // inverse selectivity of the join condition so far, so that a selective
+  // condition is evaluated on larger batches, up to 'kMaxFilterBatchSize'.
+  vector_size_t filterBatchSize() const;
+
   // Generates cross product of next 'probeCnt' rows of input_, and all rows of
   // build side vector at 'buildIndex_' in 'buildData_'.
   // 'outputType' specifies the type of output.
@@ -82,6 +88,29 @@ class NestedLoopJoinProbe : public Operator {
   // buildMatched_ accordingly.
   RowVectorPtr doMatch(vector_size_t probeCnt);
 
+  // Evaluates joinCondition against 'filterInput', whose rows pair the probe
+  // and build rows in 'probeIndices_' and 'buildIndices_'. Returns the pairs
+  // that passed joinCondition, updates probeMatched_, buildMatched_
+  // accordingly.
+  RowVectorPtr evalJoinCondition(const RowVectorPtr& filterInput);
+
+  // Sets 'rangeJoin_' if the join condition bounds a build column by probe
+  // columns, e.g. 'b.start <= a.ts AND a.ts < b.end' or 'a.x < b.y'.
+  void initializeRangeJoin(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // Returns the rows of the build vector at 'buildIndex_' with a non-null
+  // range key, sorted on the range key.
+  const std::vector<vector_size_t>& sortedBuildRows();
+
+  // Range join counterpart of doMatch(). Pairs the probe rows starting at
+  // 'probeRow_' only with the build rows whose range key is within the bounds
+  // of the probe row, up to filterBatchSize() pairs. Evaluates joinCondition
+  // on these and advances 'probeRow_' past the completed probe rows.
+  RowVectorPtr doRangeMatch();
+
   // Updates 'probeRow_' and 'buildIndex_' by advancing 'probeRow_' by probeCnt.
   // Returns true if 'buildIndex_' points to the end of 'buildData_'.
   bool advanceProbeRows(vector_size_t probeCnt);
@@ -121,6 +150,10 @@ class NestedLoopJoinProbe : public Operator {
   }
 
  private:
+  // Upper bound on filterBatchSize(). Keeps the join condition input and the
+  // index buffers for the pairs within the L2 cache.
+  static constexpr vector_size_t kMaxFilterBatchSize = 64 << 10;
+
   // Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
   std::shared_ptr<const core::NestedLoopJoinNode> joinNode_;
@@ -133,6 +166,12 @@ class NestedLoopJoinProbe : public Operator {
   std::unique_ptr<ExprSet> joinCondition_;
   RowTypePtr filterInputType_;
   SelectivityVector filterInputRows_;
+  // Number of pairs the join condition was evaluated on and the number of
+  // these that passed.
+  int64_t numFilterInputRows_{0};
+  int64_t numFilterPassedRows_{0};
+  // Passing rows of a join condition result with nulls.
+  std::vector<uint64_t> filterPassedBits_;
 
   // Probe side state
   // Input row to process on next call to getOutput().
@@ -164,6 +203,27 @@ class NestedLoopJoinProbe : public Operator {
   std::vector<SelectivityVector> buildMatched_;
   std::vector<IdentityProjection> filterBuildProjections_;
   BufferPtr buildOutMapping_;
+
+  // Set if the join condition bounds a build column by probe columns. Then
+  // only the build rows within the bounds of a probe row are paired with it
+  // instead of all build rows. Pairs outside the bounds fail the join
+  // condition since it is a conjunction that includes the bounds.
+  struct RangeJoin {
+    // Build column bounded by the probe columns.
+    column_index_t buildChannel;
+    // Probe columns with a lower and an upper bound of the build column.
+    std::optional<column_index_t> lowerChannel;
+    std::optional<column_index_t> upperChannel;
+    // Per build vector, the rows with a non-null range key sorted on it.
+    // Filled on first use.
+    std::vector<std::optional<std::vector<vector_size_t>>> sortedBuildRows;
+    // True if 'cursor' and 'end' are set for 'probeRow_'.
+    bool hasRange{false};
+    // Next and end position in the sorted build rows for 'probeRow_'.
+    vector_size_t cursor{0};
+    vector_size_t end{0};
+  };
+  std::optional<RangeJoin> rangeJoin_;
 };
 
 } // namespace facebook::velox::exec
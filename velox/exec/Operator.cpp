@@ -42,7 +42,10 @@ OperatorCtx::OperatorCtx(
 core::ExecCtx* OperatorCtx::execCtx() const {
   if (!execCtx_) {
     execCtx_ = std::make_unique<core::ExecCtx>(
-        pool_, driverCtx_->task->queryCtx().get());
+        pool_,
+        driverCtx_->task->queryCtx().get(),
+        driverCtx_->sharedVectorPool(planNodeId_));
+    execCtx_->setExprResultCache(driverCtx_->task->exprResultCache());
   }
   return execCtx_.get();
 }
@@ -265,13 +268,15 @@ uint32_t Operator::outputBatchRows(
   }
 
   const uint64_t rowSize = averageRowSize.value();
+  auto batchBytes = queryConfig.preferredOutputBatchBytes();
+  if (queryConfig.adaptiveOutputBatchSizeEnabled()) {
+    batchBytes = std::min(batchBytes, queryConfig.adaptiveOutputBatchBytes());
+  }
 
-  if (rowSize * queryConfig.maxOutputBatchRows() <
-      queryConfig.preferredOutputBatchBytes()) {
+  if (rowSize * queryConfig.maxOutputBatchRows() < batchBytes) {
     return queryConfig.maxOutputBatchRows();
   }
-  return std::max<uint32_t>(
-      queryConfig.preferredOutputBatchBytes() / rowSize, 1);
+  return std::max<uint32_t>(batchBytes / rowSize, 1);
 }
 
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
@@ -356,6 +361,21 @@ void Operator::recordSpillStats() {
     common::updateGlobalSpillRunStats(lockedSpillStats->spillRuns);
   }
 
+  if (lockedSpillStats->spilledOverflowBytes != 0) {
+    lockedStats->addRuntimeStat(
+        kSpilledOverflowBytes,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledOverflowBytes),
+            RuntimeCounter::Unit::kBytes});
+  }
+
+  if (lockedSpillStats->spilledOverflowFiles != 0) {
+    lockedStats->addRuntimeStat(
+        kSpilledOverflowFiles,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledOverflowFiles)});
+  }
+
   if (lockedSpillStats->spillMaxLevelExceededCount != 0) {
     lockedStats->addRuntimeStat(
         kExceededMaxSpillLevel,
@@ -487,6 +507,8 @@ void OperatorStats::add(const OperatorStats& other) {
 
   backgroundTiming.add(other.backgroundTiming);
 
+  hardwareCounters.add(other.hardwareCounters);
+
   memoryStats.add(other.memoryStats);
 
   for (const auto& [name, stats] : other.runtimeStats) {
@@ -530,6 +552,8 @@ void OperatorStats::clear() {
 
   backgroundTiming.clear();
 
+  hardwareCounters.clear();
+
   memoryStats.clear();
 
   runtimeStats.clear();
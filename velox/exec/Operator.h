@@ -16,6 +16,7 @@
 #pragma once
 #include <folly/Synchronized.h>
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/process/HardwareCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Driver.h"
@@ -154,6 +155,11 @@ struct OperatorStats {
   // CPU time at a reasonable time granularity.
   CpuWallTiming backgroundTiming;
 
+  /// CPU hardware counters of the addInput, getOutput and finish calls. Only
+  /// collected if QueryConfig::kOperatorTrackHardwareCounters is set. Unlike
+  /// the timings, these include the lazy loads triggered by the operator.
+  process::HardwareCounters hardwareCounters;
+
   MemoryStats memoryStats;
 
   // Total bytes in memory for spilling
@@ -341,6 +347,11 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillRuns{"spillRuns"};
   static inline const std::string kExceededMaxSpillLevel{
       "exceededMaxSpillLevel"};
+  /// The part of the spill write stats in the overflow spill directory.
+  static inline const std::string kSpilledOverflowBytes{
+      "spilledOverflowBytes"};
+  static inline const std::string kSpilledOverflowFiles{
+      "spilledOverflowFiles"};
   /// The spill read stats.
   static inline const std::string kSpillReadBytes{"spillReadBytes"};
   static inline const std::string kSpillReads{"spillReads"};
@@ -559,6 +570,10 @@ class Operator : public BaseRuntimeStatWriter {
     return operatorCtx_->operatorType();
   }
 
+  const RowTypePtr& outputType() const {
+    return outputType_;
+  }
+
   const std::string& taskId() const {
     return operatorCtx_->taskId();
   }
@@ -738,7 +753,9 @@ class Operator : public BaseRuntimeStatWriter {
   /// number of rows at 10K and returns at least one row. The averageRowSize
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
-  /// preferredOutputBatchRows.
+  /// preferredOutputBatchRows. With adaptive output batch sizes, the rows
+  /// fit in the smaller of preferredOutputBatchBytes and
+  /// adaptiveOutputBatchBytes.
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
@@ -350,6 +350,7 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
     return;
   }
 
+  std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
   bool isFinished;
   {
@@ -365,10 +366,11 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
 
     noMoreBuffers_ = true;
     isFinished = isFinishedLocked();
-    updateAfterAcknowledgeLocked(dataToBroadcast_, promises);
+    freed.swap(dataToBroadcast_);
+    updateAfterAcknowledgeLocked(freed, promises);
   }
 
-  releaseAfterAcknowledge(dataToBroadcast_, promises);
+  releaseAfterAcknowledge(freed, promises);
   if (isFinished) {
     task_->setAllOutputConsumed();
   }
@@ -644,16 +646,26 @@ void OutputBuffer::acknowledge(int destination, int64_t sequence) {
 }
 
 void OutputBuffer::updateAfterAcknowledgeLocked(
-    const std::vector<std::shared_ptr<SerializedPage>>& freed,
+    std::vector<std::shared_ptr<SerializedPage>>& freed,
     std::vector<ContinuePromise>& promises) {
   uint64_t freedBytes{0};
   int freedPages{0};
-  for (const auto& free : freed) {
-    if (free.unique()) {
-      ++freedPages;
-      freedBytes += free->size();
-    }
-  }
+  // A reference to a shared page left in 'freed' past the mutex would make the
+  // destination that releases the page last see it as still in use, and the
+  // page would never leave 'bufferedBytes_'.
+  freed.erase(
+      std::remove_if(
+          freed.begin(),
+          freed.end(),
+          [&](const auto& page) {
+            if (page.use_count() > 1) {
+              return true;
+            }
+            ++freedPages;
+            freedBytes += page->size();
+            return false;
+          }),
+      freed.end());
   if (freedPages == 0) {
     VELOX_CHECK_EQ(freedBytes, 0);
     return;
@@ -343,9 +343,12 @@ class OutputBuffer {
   void checkIfDone(bool oneDriverFinished);
 
   // Updates buffered size and returns possibly continuable producer promises
-  // in 'promises'.
+  // in 'promises'. A broadcast page is shared by all destination buffers and
+  // is freed by the last of them to release it. Drops the references in
+  // 'freed' to pages that are still held elsewhere, so that 'freed' keeps
+  // only the pages to free outside of the mutex.
   void updateAfterAcknowledgeLocked(
-      const std::vector<std::shared_ptr<SerializedPage>>& freed,
+      std::vector<std::shared_ptr<SerializedPage>>& freed,
       std::vector<ContinuePromise>& promises);
 
   /// Given an updated total number of broadcast buffers, add any missing ones
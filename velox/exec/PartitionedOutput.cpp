@@ -58,6 +58,8 @@ BlockingReason Destination::advance(
     options.compressionKind =
         OutputBufferManager::getInstance().lock()->compressionKind();
     options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    options.preserveEncodings = preserveEncodings_;
+    options.networkBandwidth = networkBandwidth_;
     current_->createStreamTree(rowType, rowsInCurrent_, &options);
   }
   current_->append(
@@ -155,7 +157,13 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      preserveEncodings_(ctx->task->queryCtx()
+                             ->queryConfig()
+                             .partitionedOutputPreserveEncodings()),
+      networkBandwidth_(ctx->task->queryCtx()
+                            ->queryConfig()
+                            .partitionedOutputNetworkBandwidth()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -197,7 +205,13 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          preserveEncodings_,
+          networkBandwidth_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
           }));
@@ -279,14 +293,40 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
       } else {
-        for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
-        }
+        addRowsByPartition();
       }
     }
   }
 }
 
+void PartitionedOutput::addRowsByPartition() {
+  const auto numInput = input_->size();
+  partitionOffsets_.assign(numDestinations_, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionOffsets_[partitions_[i]];
+  }
+  vector_size_t offset = 0;
+  for (auto& partitionOffset : partitionOffsets_) {
+    const auto numRows = partitionOffset;
+    partitionOffset = offset;
+    offset += numRows;
+  }
+  // Moves each offset to the end of its partition.
+  partitionedRows_.resize(numInput);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    partitionedRows_[partitionOffsets_[partitions_[i]]++] = i;
+  }
+  vector_size_t begin = 0;
+  for (auto partition = 0; partition < numDestinations_; ++partition) {
+    const auto end = partitionOffsets_[partition];
+    if (end > begin) {
+      destinations_[partition]->addRows(
+          folly::Range(partitionedRows_.data() + begin, end - begin));
+    }
+    begin = end;
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
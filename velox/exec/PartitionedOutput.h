@@ -27,16 +27,25 @@ class Destination {
  public:
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param preserveEncodings Serialize dictionary and constant encoded
+  /// columns as dictionary blocks. See
+  /// PrestoVectorSerde::PrestoOptions::preserveEncodings.
+  /// @param networkBandwidth See
+  /// PrestoVectorSerde::PrestoOptions::networkBandwidth.
   Destination(
       const std::string& taskId,
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
+      bool preserveEncodings,
+      uint64_t networkBandwidth,
       std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
+        preserveEncodings_(preserveEncodings),
+        networkBandwidth_(networkBandwidth),
         recordEnqueued_(std::move(recordEnqueued)) {
     setTargetSizePct();
   }
@@ -57,6 +66,10 @@ class Destination {
     }
   }
 
+  void addRows(folly::Range<const vector_size_t*> rows) {
+    rows_.insert(rows_.end(), rows.begin(), rows.end());
+  }
+
   // Serializes row from 'output' till either 'maxBytes' have been serialized or
   BlockingReason advance(
       uint64_t maxBytes,
@@ -106,6 +119,8 @@ class Destination {
   const int destination_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
+  const uint64_t networkBandwidth_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
 
   // Bytes serialized in 'current_'
@@ -205,6 +220,11 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Adds the rows of 'input_' to their destinations in 'partitions_'. Groups
+  // the rows by destination with a counting sort to hand each destination its
+  // rows at once instead of appending them one by one to many destinations.
+  void addRowsByPartition();
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -219,6 +239,8 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
+  const uint64_t networkBandwidth_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -233,6 +255,9 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // End offsets of the destinations' rows in 'partitionedRows_'.
+  std::vector<vector_size_t> partitionOffsets_;
+  std::vector<vector_size_t> partitionedRows_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
@@ -51,6 +51,8 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
 
   backgroundTiming.add(stats.backgroundTiming);
 
+  hardwareCounters.add(stats.hardwareCounters);
+
   blockedWallNanos += stats.blockedWallNanos;
 
   peakMemoryBytes += stats.memoryStats.peakTotalMemoryReservation;
@@ -109,6 +111,19 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
     out << ", Splits: " << numSplits;
   }
 
+  if (!hardwareCounters.empty()) {
+    out << ", Cycles: " << hardwareCounters.cycles
+        << ", Instructions: " << hardwareCounters.instructions << " (IPC "
+        << fmt::format(
+               "{:.2f}",
+               hardwareCounters.cycles == 0
+                   ? 0.0
+                   : (double)hardwareCounters.instructions /
+                       hardwareCounters.cycles)
+        << "), LLC misses: " << hardwareCounters.llcMisses
+        << ", Branch misses: " << hardwareCounters.branchMisses;
+  }
+
   if (spilledRows > 0) {
     out << ", Spilled: " << spilledRows << " rows ("
         << succinctBytes(spilledBytes) << ", " << spilledFiles << " files)";
@@ -160,6 +175,8 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       stat["outputVectors"] = operatorStat.second->outputVectors;
       stat["outputBytes"] = operatorStat.second->outputBytes;
       stat["cpuWallTiming"] = operatorStat.second->cpuWallTiming.toString();
+      stat["hardwareCounters"] =
+          operatorStat.second->hardwareCounters.toString();
       stat["blockedWallNanos"] = operatorStat.second->blockedWallNanos;
       stat["peakMemoryBytes"] = operatorStat.second->peakMemoryBytes;
       stat["numMemoryAllocations"] = operatorStat.second->numMemoryAllocations;
@@ -183,6 +200,55 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
   return jsonStats;
 }
 
+folly::dynamic toChromeTrace(const TaskStats& stats) {
+  folly::dynamic events = folly::dynamic::array;
+  for (auto pipelineId = 0; pipelineId < stats.pipelineStats.size();
+       ++pipelineId) {
+    const auto& pipelineStats = stats.pipelineStats[pipelineId];
+    folly::dynamic processName = folly::dynamic::object;
+    processName["name"] = "process_name";
+    processName["ph"] = "M";
+    processName["pid"] = pipelineId;
+    processName["args"] = folly::dynamic::object(
+        "name", fmt::format("Pipeline {}", pipelineId));
+    events.push_back(std::move(processName));
+
+    for (const auto& driverStats : pipelineStats.driverStats) {
+      for (const auto& event : driverStats.timeline) {
+        folly::dynamic traceEvent = folly::dynamic::object;
+        folly::dynamic args = folly::dynamic::object;
+        auto name = driverTimelineEventKindString(event.kind);
+        if (event.kind == DriverTimelineEvent::Kind::kBlocked) {
+          name = blockingReasonToString(event.blockingReason).substr(1);
+          args["blockingReason"] = name;
+          args["operatorId"] = event.operatorId;
+          if (event.operatorId >= 0 &&
+              event.operatorId < pipelineStats.operatorStats.size()) {
+            const auto& operatorStats =
+                pipelineStats.operatorStats[event.operatorId];
+            args["operator"] = operatorStats.operatorType;
+            args["planNodeId"] = operatorStats.planNodeId;
+            name = fmt::format("{} ({})", name, operatorStats.operatorType);
+          }
+        }
+        traceEvent["name"] = name;
+        traceEvent["cat"] = driverTimelineEventKindString(event.kind);
+        traceEvent["ph"] = "X";
+        traceEvent["ts"] = event.startMicros;
+        traceEvent["dur"] = event.durationMicros;
+        traceEvent["pid"] = pipelineId;
+        traceEvent["tid"] = driverStats.driverId;
+        traceEvent["args"] = std::move(args);
+        events.push_back(std::move(traceEvent));
+      }
+    }
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(events);
+  trace["displayTimeUnit"] = "ms";
+  return trace;
+}
+
 namespace {
 void printCustomStats(
     const std::unordered_map<std::string, RuntimeMetric>& stats,
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <folly/dynamic.h>
+#include "velox/common/process/HardwareCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/exec/Operator.h"
 
@@ -86,6 +87,11 @@ struct PlanNodeStats {
   /// operators.
   CpuWallTiming backgroundTiming;
 
+  /// Sum of CPU hardware counters for all corresponding operators. Empty unless
+  /// QueryConfig::kOperatorTrackHardwareCounters is set and perf events are
+  /// available.
+  process::HardwareCounters hardwareCounters;
+
   /// Sum of blocked wall time for all corresponding operators.
   uint64_t blockedWallNanos{0};
 
@@ -142,6 +148,14 @@ std::unordered_map<core::PlanNodeId, PlanNodeStats> toPlanStats(
 
 folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats);
 
+/// Returns the driver timelines in 'stats' in the Chrome trace event format,
+/// which chrome://tracing and Perfetto display. Each pipeline is shown as a
+/// process and each driver as a thread with one slice per queued, running and
+/// blocked interval. Blocked slices are named after the blocking reason and
+/// the operator. The trace has no events unless the query set
+/// QueryConfig::kDriverTimelineMaxEvents.
+folly::dynamic toChromeTrace(const TaskStats& stats);
+
 /// Returns human-friendly representation of the plan augmented with runtime
 /// statistics. The result has the same plan representation as in
 /// PlanNode::toString(true, true), but each plan node includes an additional
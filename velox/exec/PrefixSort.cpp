@@ -43,13 +43,33 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+FOLLY_ALWAYS_INLINE void encodeRowStringColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix,
+    std::string& storage) {
+  std::optional<StringView> value;
+  if (!RowContainer::isNullAt(
+          row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = HashStringAllocator::contiguousString(
+        *reinterpret_cast<StringView*>(row + rowColumn.offset()), storage);
+  }
+  prefixSortLayout.encoders[index].encodeString(
+      value,
+      prefixSortLayout.maxStringPrefixLength,
+      prefix + prefixSortLayout.prefixOffsets[index]);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
     const uint32_t index,
     const RowColumn& rowColumn,
     char* const row,
-    char* const prefix) {
+    char* const prefix,
+    std::string& storage) {
   switch (typeKind) {
     case TypeKind::INTEGER: {
       encodeRowColumn<int32_t>(prefixSortLayout, index, rowColumn, row, prefix);
@@ -72,6 +92,17 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::HUGEINT: {
+      encodeRowColumn<int128_t>(prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY: {
+      encodeRowStringColumn(
+          prefixSortLayout, index, rowColumn, row, prefix, storage);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -115,9 +146,11 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    uint32_t maxStringPrefixLength) {
   uint32_t normalizedKeySize = 0;
   uint32_t numNormalizedKeys = 0;
+  std::optional<uint32_t> truncatedKeyIndex;
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   std::vector<PrefixSortEncoder> encoders;
@@ -128,18 +161,32 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
     }
-    std::optional<uint32_t> encodedSize =
-        PrefixSortEncoder::encodedSize(types[i]->kind());
-    if (encodedSize.has_value()) {
-      prefixOffsets.push_back(normalizedKeySize);
-      encoders.push_back(
-          {compareFlags[i].ascending, compareFlags[i].nullsFirst});
-      normalizedKeySize += encodedSize.value();
-      numNormalizedKeys++;
+    const bool isString = PrefixSortEncoder::isStringKind(types[i]->kind());
+    std::optional<uint32_t> encodedSize;
+    if (isString) {
+      if (maxStringPrefixLength > 0) {
+        encodedSize =
+            PrefixSortEncoder::encodedStringSize(maxStringPrefixLength);
+      }
     } else {
+      encodedSize = PrefixSortEncoder::encodedSize(types[i]->kind());
+    }
+    if (!encodedSize.has_value()) {
+      break;
+    }
+    prefixOffsets.push_back(normalizedKeySize);
+    encoders.push_back({compareFlags[i].ascending, compareFlags[i].nullsFirst});
+    normalizedKeySize += encodedSize.value();
+    numNormalizedKeys++;
+    if (isString) {
+      // Strings that tie on the prefix are compared in full, which must come
+      // before comparing any later key.
+      truncatedKeyIndex = i;
       break;
     }
   }
+  const uint32_t nonPrefixSortStartIndex =
+      truncatedKeyIndex.value_or(numNormalizedKeys);
   auto padding = alignmentPadding(normalizedKeySize, kAlignment);
   normalizedKeySize += padding;
   return PrefixSortLayout{
@@ -149,7 +196,9 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numKeys,
       compareFlags,
       numNormalizedKeys == 0,
-      numNormalizedKeys < numKeys,
+      nonPrefixSortStartIndex < numKeys,
+      nonPrefixSortStartIndex,
+      maxStringPrefixLength,
       std::move(prefixOffsets),
       std::move(encoders),
       padding};
@@ -170,7 +219,8 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   // If prefixes are equal, compare the left sort keys with rowContainer.
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
+  for (auto i = sortLayout_.nonPrefixSortStartIndex; i < sortLayout_.numKeys;
+       ++i) {
     result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
@@ -184,7 +234,7 @@ PrefixSort::PrefixSort(
     memory::MemoryPool* pool,
     RowContainer* rowContainer,
     const std::vector<CompareFlags>& keyCompareFlags,
-    const PrefixSortConfig& config,
+    const common::PrefixSortConfig& config,
     const PrefixSortLayout& sortLayout)
     : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {}
 
@@ -196,7 +246,8 @@ void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
         i,
         rowContainer_->columnAt(i),
         row,
-        prefix);
+        prefix,
+        stringStorage_);
   }
   simd::memset(
       prefix + sortLayout_.normalizedBufferSize - sortLayout_.padding,
@@ -213,7 +264,7 @@ void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
   getAddressFromPrefix(prefix) = row;
 }
 
-void PrefixSort::sortInternal(std::vector<char*>& rows) {
+void PrefixSort::sortInternal(folly::Range<char**> rows) {
   const auto numRows = rows.size();
   const auto entrySize = sortLayout_.entrySize;
   memory::ContiguousAllocation prefixAllocation;
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
@@ -24,8 +25,9 @@ namespace facebook::velox::exec {
 
 namespace detail {
 
+template <typename Allocator>
 FOLLY_ALWAYS_INLINE void stdSort(
-    std::vector<char*>& rows,
+    std::vector<char*, Allocator>& rows,
     RowContainer* rowContainer,
     const std::vector<CompareFlags>& compareFlags) {
   std::sort(
@@ -41,26 +43,12 @@ FOLLY_ALWAYS_INLINE void stdSort(
 }
 }; // namespace detail
 
-struct PrefixSortConfig {
-  PrefixSortConfig(uint32_t maxNormalizedKeySize, uint32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
-
-  /// Max number of bytes can store normalized keys in prefix-sort buffer per
-  /// entry.
-  const uint32_t maxNormalizedKeySize;
-
-  /// PrefixSort will have performance regression when the dateset is too small.
-  /// The threshold is set to 100 according to the benchmark test results by
-  /// default.
-  const int64_t threshold;
-};
-
 /// The layout of prefix-sort buffer, a prefix entry includes:
-/// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
-/// prefix.
+/// 1. normalized keys, of which a string key has a fixed length prefix of its
+/// value and is the last.
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
+/// prefix. Keys that are not normalized and strings that tie on their prefix
+/// are compared through it.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
   /// normalizedKeySize_ + 8 (non-normalized-ptr) + 8(row address).
@@ -82,9 +70,19 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys == 0', a little faster.
   const bool noNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether the sort keys contains non-normalized key, or a normalized key
+  /// whose prefix may be truncated.
   const bool hasNonNormalizedKey;
 
+  /// Index of the first key to compare with RowContainer when the normalized
+  /// keys of two rows are equal. This is 'numNormalizedKeys' unless the last
+  /// normalized key is a string, whose truncated prefix may tie for different
+  /// strings. Then it is the index of the string key.
+  const uint32_t nonPrefixSortStartIndex;
+
+  /// Number of bytes of a string key in the prefix, excluding the null byte.
+  const uint32_t maxStringPrefixLength;
+
   /// Offsets of normalized keys, used to find write locations when
   /// extracting columns
   const std::vector<uint32_t> prefixOffsets;
@@ -96,10 +94,14 @@ struct PrefixSortLayout {
   /// during ‘memcmp’
   const int32_t padding;
 
+  /// A VARCHAR or VARBINARY key is normalized to its first
+  /// 'maxStringPrefixLength' bytes and ends the normalized keys. String keys
+  /// are not normalized if 'maxStringPrefixLength' is 0.
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      uint32_t maxStringPrefixLength);
 };
 
 class PrefixSort {
@@ -108,7 +110,7 @@ class PrefixSort {
       memory::MemoryPool* pool,
       RowContainer* rowContainer,
       const std::vector<CompareFlags>& keyCompareFlags,
-      const PrefixSortConfig& config,
+      const common::PrefixSortConfig& config,
       const PrefixSortLayout& sortLayout);
 
   /// Follow the steps below to sort the data in RowContainer:
@@ -133,20 +135,25 @@ class PrefixSort {
   /// them in the prefix buffer) into the input rows vector.
   ///
   /// @param rows The result of RowContainer::listRows(), assuming that the
-  /// caller (SortBuffer etc.) has already got the result.
+  /// caller (SortBuffer etc.) has already got the result. May be a subset of
+  /// the rows of 'rowContainer', e.g. a spill run.
+  template <typename Allocator>
   FOLLY_ALWAYS_INLINE static void sort(
-      std::vector<char*>& rows,
+      std::vector<char*, Allocator>& rows,
       memory::MemoryPool* pool,
       RowContainer* rowContainer,
       const std::vector<CompareFlags>& compareFlags,
-      const PrefixSortConfig& config) {
-    if (rowContainer->numRows() < config.threshold) {
+      const common::PrefixSortConfig& config) {
+    if (rows.size() < config.threshold) {
       detail::stdSort(rows, rowContainer, compareFlags);
       return;
     }
     VELOX_DCHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        rowContainer->keyTypes(),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with inline std-sort.
     if (sortLayout.noNormalizedKeys) {
@@ -155,11 +162,11 @@ class PrefixSort {
     }
 
     PrefixSort prefixSort(pool, rowContainer, compareFlags, config, sortLayout);
-    prefixSort.sortInternal(rows);
+    prefixSort.sortInternal(folly::Range<char**>(rows.data(), rows.size()));
   }
 
  private:
-  void sortInternal(std::vector<char*>& rows);
+  void sortInternal(folly::Range<char**> rows);
 
   int compareAllNormalizedKeys(char* left, char* right);
 
@@ -175,5 +182,7 @@ class PrefixSort {
   memory::MemoryPool* const pool_;
   const PrefixSortLayout sortLayout_;
   RowContainer* const rowContainer_;
+  // Owns the copy of a non-contiguous string while its prefix is extracted.
+  std::string stringStorage_;
 };
 } // namespace facebook::velox::exec
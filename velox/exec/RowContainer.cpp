@@ -140,16 +140,20 @@ RowContainer::RowContainer(
     bool hasProbedFlag,
     bool hasNormalizedKeys,
     memory::MemoryPool* pool,
-    std::shared_ptr<HashStringAllocator> stringAllocator)
+    std::shared_ptr<HashStringAllocator> stringAllocator,
+    bool internKeyStrings)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       isJoinBuild_(isJoinBuild),
+      internKeyStrings_(internKeyStrings),
       accumulators_(accumulators),
       hasNormalizedKeys_(hasNormalizedKeys),
       rows_(pool),
       stringAllocator_(
           stringAllocator ? stringAllocator
-                          : std::make_shared<HashStringAllocator>(pool)) {
+                          : std::make_shared<HashStringAllocator>(
+                                pool,
+                                /*sizeClasses=*/!accumulators.empty())) {
   // Compute the layout of the payload row.  The row has keys, null flags,
   // accumulators, dependent fields. All fields are fixed width. If variable
   // width data is referenced, this is done with StringView(for VARCHAR) and
@@ -163,13 +167,15 @@ RowContainer::RowContainer(
   // for each dependent field follows that.  If hasProbedFlag is true, there is
   // an extra bit to track if the row has been selected by a hash join probe.
   // This is followed by a free bit which is set if the row is in a free list.
-  // The accumulators come next, with size given by
+  // If this is a hash join build side, the pointer to the next rows with the
+  // same key comes next. The keys, flags and next pointer are what a hash
+  // join probe reads for every candidate row, so these come first and share
+  // cache lines, while the dependent fields are only read for the rows that
+  // match. The accumulators come next, with size given by
   // Aggregate::accumulatorFixedWidthSize(). Dependent fields follow. These are
   // non-key columns for hash join or order by. If there are variable length
   // columns or accumulators, i.e. ones that allocate extra space, this space is
-  // tracked by a uint32_t after the dependent columns. If this is a hash join
-  // build side, the pointer to the next row with the same key is after the
-  // optional row size.
+  // tracked by a uint32_t after the dependent columns.
   //
   // In most cases, rows are prefixed with a normalized_key_t at index
   // -1, 8 bytes below the pointer. This space is reserved for a 64
@@ -236,6 +242,10 @@ RowContainer::RowContainer(
     nullOffsets_[i] += firstAggregateOffset * 8;
   }
   offset += flagBytes_;
+  if (hasNext) {
+    nextOffset_ = offset;
+    offset += sizeof(void*);
+  }
   for (const auto& accumulator : accumulators) {
     // Accumulator offset must be aligned by their alignment size.
     offset = bits::roundUp(offset, accumulator.alignment());
@@ -250,10 +260,6 @@ RowContainer::RowContainer(
     rowSizeOffset_ = offset;
     offset += sizeof(uint32_t);
   }
-  if (hasNext) {
-    nextOffset_ = offset;
-    offset += sizeof(void*);
-  }
   fixedRowSize_ = bits::roundUp(offset, alignment_);
   // A distinct hash table has no aggregates and if the hash table has
   // no nulls, it may be that there are no null flags.
@@ -615,8 +621,11 @@ int32_t RowContainer::storeVariableSizeAt(
 
   if (typeKind == TypeKind::VARCHAR || typeKind == TypeKind::VARBINARY) {
     if (size > 0) {
-      stringAllocator_->copyMultipart(
-          StringView(data + 4, size), row, rowColumn.offset());
+      storeString(
+          StringView(data + 4, size),
+          column < keyTypes_.size(),
+          row,
+          rowColumn.offset());
     } else {
       valueAt<StringView>(row, rowColumn.offset()) = StringView();
     }
@@ -903,6 +912,7 @@ void RowContainer::clear() {
       freeRowsExtraMemory(folly::Range<char**>(rows.data(), numRows), true);
     }
   }
+  clearInternedStrings(checkFree_ || sharedStringAllocator);
   rows_.clear();
   if (!sharedStringAllocator) {
     if (checkFree_) {
@@ -917,6 +927,36 @@ void RowContainer::clear() {
   firstFreeRow_ = nullptr;
 }
 
+void RowContainer::internString(
+    const StringView& value,
+    char* row,
+    int32_t offset) {
+  if (internedStrings_ == nullptr) {
+    internedStrings_ = std::make_unique<InternedStrings>(
+        AlignedStlAllocator<StringView, 16>(stringAllocator_.get()));
+  }
+  auto it = internedStrings_->find(value);
+  if (it == internedStrings_->end()) {
+    auto* header = stringAllocator_->allocate(value.size());
+    ::memcpy(header->begin(), value.data(), value.size());
+    it = internedStrings_->insert(StringView(header->begin(), value.size()))
+             .first;
+  }
+  valueAt<StringView>(row, offset) = *it;
+}
+
+void RowContainer::clearInternedStrings(bool freeStrings) {
+  if (internedStrings_ == nullptr) {
+    return;
+  }
+  if (freeStrings) {
+    for (const auto& value : *internedStrings_) {
+      stringAllocator_->free(HashStringAllocator::headerOf(value.data()));
+    }
+  }
+  internedStrings_.reset();
+}
+
 void RowContainer::clearNextRowVectors() {
   if (hasDuplicateRows_) {
     constexpr int32_t kBatch = 1000;
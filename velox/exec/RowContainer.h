@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/core/PlanNode.h"
@@ -230,6 +232,10 @@ class RowContainer {
   /// 'stringAllocator' allows sharing the variable length data arena with
   /// another RowContainer. This is needed for spilling where the same
   /// aggregates are used for reading one container and merging into another.
+  /// 'internKeyStrings' specifies that the non-inline strings of VARCHAR and
+  /// VARBINARY keys are stored once per distinct value and shared by all the
+  /// rows with that value. This is for hash join builds with few distinct
+  /// long keys. The interned strings are freed by clear(), not eraseRows().
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -240,7 +246,13 @@ class RowContainer {
       bool hasProbedFlag,
       bool hasNormalizedKey,
       memory::MemoryPool* pool,
-      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr);
+      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr,
+      bool internKeyStrings = false);
+
+  /// Largest string interned if 'internKeyStrings' is set. Longer strings
+  /// are stored for each row.
+  static constexpr int32_t kMaxInternedStringSize =
+      HashStringAllocator::kMaxAlloc;
 
   /// Allocates a new row and initializes possible aggregates to null.
   char* newRow();
@@ -620,6 +632,47 @@ class RowContainer {
     return rowColumns_[index];
   }
 
+  /// Returns true if the string keys are interned. See the constructor.
+  bool internsKeyStrings() const {
+    return internKeyStrings_;
+  }
+
+  /// Returns the number of distinct strings interned so far.
+  size_t numInternedStrings() const {
+    return internedStrings_ == nullptr ? 0 : internedStrings_->size();
+  }
+
+  /// Returns true if the VARCHAR or VARBINARY key at 'columnIndex' is equal in
+  /// 'left' and 'right'. Requires interned key strings. Equal interned strings
+  /// share their bytes, so this compares addresses instead of bytes when
+  /// possible. 'sameContainer' specifies that both rows are in 'this'. Then
+  /// interned strings at different addresses are known to differ. Otherwise
+  /// 'right' may come from another container with its own interned strings.
+  bool equalsInternedString(
+      const char* left,
+      const char* right,
+      int32_t columnIndex,
+      bool sameContainer) const {
+    VELOX_DCHECK(internKeyStrings_);
+    VELOX_DCHECK_LT(columnIndex, keyTypes_.size());
+    const auto column = rowColumns_[columnIndex];
+    const bool leftIsNull = isNullAt(left, column);
+    const bool rightIsNull = isNullAt(right, column);
+    if (leftIsNull || rightIsNull) {
+      return leftIsNull == rightIsNull;
+    }
+    const auto leftValue = valueAt<StringView>(left, column.offset());
+    const auto rightValue = valueAt<StringView>(right, column.offset());
+    if (leftValue.data() == rightValue.data()) {
+      return true;
+    }
+    if (sameContainer && leftValue.size() == rightValue.size() &&
+        !leftValue.isInline() && leftValue.size() <= kMaxInternedStringSize) {
+      return false;
+    }
+    return leftValue == rightValue;
+  }
+
   /// Bit offset of the probed flag for a full or right outer join  payload.
   /// 0 if not applicable.
   int32_t probedFlagOffset() const {
@@ -888,7 +941,7 @@ class RowContainer {
     }
     if constexpr (std::is_same_v<T, StringView>) {
       RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
-      stringAllocator_->copyMultipart(decoded.valueAt<T>(index), row, offset);
+      storeString(decoded.valueAt<T>(index), isKey, row, offset);
     } else {
       *reinterpret_cast<T*>(row + offset) = decoded.valueAt<T>(index);
     }
@@ -904,12 +957,31 @@ class RowContainer {
     using T = typename TypeTraits<Kind>::NativeType;
     if constexpr (std::is_same_v<T, StringView>) {
       RowSizeTracker tracker(group[rowSizeOffset_], *stringAllocator_);
-      stringAllocator_->copyMultipart(decoded.valueAt<T>(index), group, offset);
+      storeString(decoded.valueAt<T>(index), isKey, group, offset);
     } else {
       *reinterpret_cast<T*>(group + offset) = decoded.valueAt<T>(index);
     }
   }
 
+  // Copies 'value' into 'row' at 'offset'. Interns the string if 'isKey' and
+  // key strings are interned.
+  void
+  storeString(const StringView& value, bool isKey, char* row, int32_t offset) {
+    if (isKey && internKeyStrings_ && !value.isInline() &&
+        value.size() <= kMaxInternedStringSize) {
+      internString(value, row, offset);
+    } else {
+      stringAllocator_->copyMultipart(value, row, offset);
+    }
+  }
+
+  // Stores the interned copy of 'value' into 'row' at 'offset', copying
+  // 'value' into 'internedStrings_' if not there yet.
+  void internString(const StringView& value, char* row, int32_t offset);
+
+  // Frees the interned strings and 'internedStrings_'.
+  void clearInternedStrings(bool freeStrings);
+
   template <bool useRowNumbers, typename T>
   static void extractValuesWithNulls(
       const char* const* rows,
@@ -1202,6 +1274,8 @@ class RowContainer {
         std::is_same_v<FieldType, StringView> ||
         std::is_same_v<FieldType, std::string_view>);
 
+    // Interned strings are shared between rows and freed by clear().
+    const bool interned = internKeyStrings_ && column_index < keyTypes_.size();
     const auto column = columnAt(column_index);
     for (auto row : rows) {
       if (isNullAt(row, column.nullByte(), column.nullMask())) {
@@ -1210,7 +1284,8 @@ class RowContainer {
 
       auto& view = valueAt<FieldType>(row, column.offset());
       if constexpr (std::is_same_v<FieldType, StringView>) {
-        if (view.isInline()) {
+        if (view.isInline() ||
+            (interned && view.size() <= kMaxInternedStringSize)) {
           continue;
         }
       } else {
@@ -1242,6 +1317,7 @@ class RowContainer {
   const std::vector<TypePtr> keyTypes_;
   const bool nullableKeys_;
   const bool isJoinBuild_;
+  const bool internKeyStrings_;
 
   // Indicates if we can add new row to this row container. It is set to false
   // after user calls 'getRowPartitions()' to create 'rowPartitions' object for
@@ -1298,6 +1374,16 @@ class RowContainer {
   memory::AllocationPool rows_;
   std::shared_ptr<HashStringAllocator> stringAllocator_;
 
+  using InternedStrings = folly::F14FastSet<
+      StringView,
+      std::hash<StringView>,
+      std::equal_to<StringView>,
+      AlignedStlAllocator<StringView, 16>>;
+
+  // The distinct interned key strings if 'internKeyStrings_'. Allocated from
+  // 'stringAllocator_' on first use.
+  std::unique_ptr<InternedStrings> internedStrings_;
+
   int alignment_ = 1;
 };
 
@@ -128,13 +128,19 @@ void RowNumber::restoreNextSpillPartition() {
 
   auto it = spillInputPartitionSet_.begin();
   spillInputReader_ = it->second->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      SpillReadAheadOptions::fromSpillConfig(*spillConfig_));
 
   // Find matching partition for the hash table.
   auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
   if (hashTableIt != spillHashTablePartitionSet_.end()) {
     spillHashTableReader_ = hashTableIt->second->createUnorderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        SpillReadAheadOptions::fromSpillConfig(*spillConfig_));
 
     RowVectorPtr data;
     while (spillHashTableReader_->nextBatch(data)) {
@@ -260,6 +266,12 @@ RowVectorPtr RowNumber::getOutput() {
     return getOutputForSinglePartition();
   }
 
+  if (limit_ == 1) {
+    auto output = getOutputForFirstRows();
+    advanceInput();
+    return output;
+  }
+
   const auto numInput = input_->size();
 
   BufferPtr mapping;
@@ -306,6 +318,38 @@ RowVectorPtr RowNumber::getOutput() {
     output = fillOutput(numInput, nullptr);
   }
 
+  advanceInput();
+  return output;
+}
+
+RowVectorPtr RowNumber::getOutputForFirstRows() {
+  const auto numInput = input_->size();
+
+  auto mapping = allocateIndices(numInput, pool());
+  auto* rawMapping = mapping->asMutable<vector_size_t>();
+  vector_size_t numOutput = 0;
+
+  // Rows of partitions that already have a row are dropped. There is no row
+  // number to compute for the rows that pass.
+  for (auto i = 0; i < numInput; ++i) {
+    auto* partition = lookup_->hits[i];
+    if (numRows(partition) == 0) {
+      setNumRows(partition, 1);
+      rawMapping[numOutput++] = i;
+    }
+  }
+
+  if (numOutput == 0) {
+    return nullptr;
+  }
+
+  if (generateRowNumber_) {
+    results_[0] = BaseVector::createConstant(BIGINT(), 1, numInput, pool());
+  }
+  return fillOutput(numOutput, mapping);
+}
+
+void RowNumber::advanceInput() {
   if (spillInputReader_ != nullptr) {
     if (spillInputReader_->nextBatch(input_)) {
       addSpillInput();
@@ -318,8 +362,6 @@ RowVectorPtr RowNumber::getOutput() {
   } else {
     input_ = nullptr;
   }
-
-  return output;
 }
 
 RowVectorPtr RowNumber::getOutputForSinglePartition() {
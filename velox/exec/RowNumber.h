@@ -76,6 +76,13 @@ class RowNumber : public Operator {
 
   RowVectorPtr getOutputForSinglePartition();
 
+  // Returns the first row of each partition in 'input_'. Used when 'limit_' is
+  // 1, i.e. for deduplication, where all row numbers are 1.
+  RowVectorPtr getOutputForFirstRows();
+
+  // Moves to the next batch of spilled input or clears 'input_'.
+  void advanceInput();
+
   FlatVector<int64_t>& getOrCreateRowNumberVector(vector_size_t size);
 
   const std::optional<int32_t> limit_;
@@ -38,6 +38,19 @@ using arg_type = typename VectorExec::template resolver<T>::in_type;
 template <typename T>
 using optional_arg_type = OptionalAccessor<T>;
 
+// The accumulators of a batch of rows passed to the optional batched addInput
+// of a simple UDAF. The accumulator of the i-th row of the batch is at 'offset'
+// in groups[i].
+template <typename TAccumulator>
+struct AccumulatorBatch {
+  char** groups;
+  int32_t offset;
+
+  TAccumulator& operator[](vector_size_t i) const {
+    return *reinterpret_cast<TAccumulator*>(groups[i] + offset);
+  }
+};
+
 template <typename FUNC>
 class SimpleAggregateAdapter : public Aggregate {
  public:
@@ -157,6 +170,32 @@ class SimpleAggregateAdapter : public Aggregate {
   struct accumulator_is_aligned<T, std::void_t<decltype(T::is_aligned_)>>
       : std::integral_constant<bool, T::is_aligned_> {};
 
+  // Whether the function defines batched addInput. Functions with default null
+  // behavior, a fixed-size accumulator and one fixed-width numeric argument T
+  // can define
+  //     static void addInputBatch(
+  //         HashStringAllocator* allocator,
+  //         exec::AccumulatorBatch<AccumulatorType> accumulators,
+  //         const T* values,
+  //         vector_size_t numRows)
+  //     static void addSingleGroupInputBatch(
+  //         HashStringAllocator* allocator,
+  //         AccumulatorType& accumulator,
+  //         const T* values,
+  //         vector_size_t numRows)
+  // to add values[i] to accumulators[i], respectively all values to
+  // 'accumulator', in a tight loop instead of a call per row. The values are
+  // non-null. For flat input without nulls and all rows selected, 'values'
+  // point to the input vector and 'accumulators' to the groups of the rows.
+  // Otherwise, the non-null selected rows are gathered into a batch first.
+  // Intermediate results are still combined row by row.
+  template <typename T, typename = void>
+  struct support_input_batch : std::false_type {};
+
+  template <typename T>
+  struct support_input_batch<T, std::void_t<decltype(&T::addInputBatch)>>
+      : std::true_type {};
+
   static constexpr bool aggregate_default_null_behavior_ =
       aggregate_default_null_behavior<FUNC>::value;
 
@@ -175,6 +214,8 @@ class SimpleAggregateAdapter : public Aggregate {
   static constexpr bool accumulator_is_aligned_ =
       accumulator_is_aligned<typename FUNC::AccumulatorType>::value;
 
+  static constexpr bool support_input_batch_ = support_input_batch<FUNC>::value;
+
   bool isFixedSize() const override {
     return accumulator_is_fixed_size_;
   }
@@ -210,8 +251,12 @@ class SimpleAggregateAdapter : public Aggregate {
       inputDecoded_[i].decode(*args[i], rows);
     }
 
-    addRawInputImpl(
-        groups, rows, std::make_index_sequence<FUNC::InputType::size_>{});
+    if constexpr (support_input_batch_) {
+      addRawInputBatch(groups, rows);
+    } else {
+      addRawInputImpl(
+          groups, rows, std::make_index_sequence<FUNC::InputType::size_>{});
+    }
   }
 
   // Similar to addRawInput, but add inputs to one single accumulator.
@@ -228,8 +273,12 @@ class SimpleAggregateAdapter : public Aggregate {
       inputDecoded_[i].decode(*args[i], rows);
     }
 
-    addSingleGroupRawInputImpl(
-        group, rows, std::make_index_sequence<FUNC::InputType::size_>{});
+    if constexpr (support_input_batch_) {
+      addSingleGroupRawInputBatch(group, rows);
+    } else {
+      addSingleGroupRawInputImpl(
+          group, rows, std::make_index_sequence<FUNC::InputType::size_>{});
+    }
   }
 
   bool supportsToIntermediate() const override {
@@ -368,6 +417,108 @@ class SimpleAggregateAdapter : public Aggregate {
   }
 
  private:
+  template <typename T, bool batch>
+  struct batch_input_type {
+    using type = int64_t;
+  };
+
+  template <typename T>
+  struct batch_input_type<T, true> {
+    using type = typename T::InputType::template type_at<0>;
+  };
+
+  using BatchInputType =
+      typename batch_input_type<FUNC, support_input_batch_>::type;
+
+  static void checkInputBatch() {
+    static_assert(FUNC::InputType::size_ == 1);
+    static_assert(aggregate_default_null_behavior_);
+    static_assert(accumulator_is_fixed_size_);
+    static_assert(
+        std::is_arithmetic_v<BatchInputType> &&
+        !std::is_same_v<BatchInputType, bool>);
+  }
+
+  // Returns the values of the rows of 'decoded' if these are flat, non-null and
+  // all selected. Otherwise, returns nullptr.
+  static const BatchInputType* denseValues(
+      const DecodedVector& decoded,
+      const SelectivityVector& rows) {
+    if (rows.isAllSelected() && decoded.isIdentityMapping() &&
+        !decoded.mayHaveNulls()) {
+      return decoded.data<BatchInputType>();
+    }
+    return nullptr;
+  }
+
+  // Gathers the non-null selected values of the first argument into
+  // 'batchValues_' and, if 'groups' is set, their groups into 'batchGroups_'.
+  void gatherInputBatch(char** groups, const SelectivityVector& rows) {
+    const auto& decoded = inputDecoded_[0];
+    batchValues_.resize(rows.countSelected());
+    if (groups != nullptr) {
+      batchGroups_.resize(batchValues_.size());
+    }
+    vector_size_t numValues = 0;
+    rows.applyToSelected([&](auto row) {
+      if (decoded.isNullAt(row)) {
+        return;
+      }
+      batchValues_[numValues] = decoded.valueAt<BatchInputType>(row);
+      if (groups != nullptr) {
+        batchGroups_[numValues] = groups[row];
+      }
+      ++numValues;
+    });
+    batchValues_.resize(numValues);
+    if (groups != nullptr) {
+      batchGroups_.resize(numValues);
+    }
+  }
+
+  void addRawInputBatch(char** groups, const SelectivityVector& rows) {
+    checkInputBatch();
+    if (const auto* values = denseValues(inputDecoded_[0], rows)) {
+      FUNC::addInputBatch(
+          allocator_,
+          AccumulatorBatch<typename FUNC::AccumulatorType>{groups, offset_},
+          values,
+          rows.end());
+      for (auto row = 0; row < rows.end(); ++row) {
+        clearNull(groups[row]);
+      }
+      return;
+    }
+    gatherInputBatch(groups, rows);
+    FUNC::addInputBatch(
+        allocator_,
+        AccumulatorBatch<typename FUNC::AccumulatorType>{
+            batchGroups_.data(), offset_},
+        batchValues_.data(),
+        batchValues_.size());
+    for (auto* group : batchGroups_) {
+      clearNull(group);
+    }
+  }
+
+  void addSingleGroupRawInputBatch(char* group, const SelectivityVector& rows) {
+    checkInputBatch();
+    auto* accumulator = value<typename FUNC::AccumulatorType>(group);
+    const auto* values = denseValues(inputDecoded_[0], rows);
+    vector_size_t numValues = rows.end();
+    if (values == nullptr) {
+      gatherInputBatch(nullptr, rows);
+      values = batchValues_.data();
+      numValues = batchValues_.size();
+    }
+    if (numValues == 0) {
+      return;
+    }
+    FUNC::addSingleGroupInputBatch(
+        allocator_, *accumulator, values, numValues);
+    clearNull(group);
+  }
+
   template <std::size_t... Is>
   void addRawInputImpl(
       char** groups,
@@ -571,6 +722,10 @@ class SimpleAggregateAdapter : public Aggregate {
 
   std::vector<DecodedVector> inputDecoded_;
   DecodedVector intermediateDecoded_;
+
+  // Gathered input of batched addInput. See support_input_batch.
+  std::vector<BatchInputType> batchValues_;
+  std::vector<char*> batchGroups_;
 };
 
 } // namespace facebook::velox::exec
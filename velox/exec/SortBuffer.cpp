@@ -25,12 +25,14 @@ SortBuffer::SortBuffer(
     const std::vector<CompareFlags>& sortCompareFlags,
     velox::memory::MemoryPool* pool,
     tsan_atomic<bool>* nonReclaimableSection,
+    const common::PrefixSortConfig& prefixSortConfig,
     const common::SpillConfig* spillConfig,
     folly::Synchronized<velox::common::SpillStats>* spillStats)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
+      prefixSortConfig_(prefixSortConfig),
       spillConfig_(spillConfig),
       spillStats_(spillStats) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
@@ -112,19 +114,8 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
+    PrefixSort::sort(
+        sortedRows_, pool_, data_.get(), sortCompareFlags_, prefixSortConfig_);
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -172,6 +163,39 @@ void SortBuffer::spill() {
   }
 }
 
+void SortBuffer::ensureOutputFits(uint32_t maxOutputRows) {
+  VELOX_CHECK(noMoreInput_);
+  // Nothing to spill if spilling is not enabled, the output is already merged
+  // from spilled runs or all the output has been produced.
+  if (spillConfig_ == nullptr || spiller_ != nullptr ||
+      numOutputRows_ == numInputRows_) {
+    return;
+  }
+
+  // Test-only spill path.
+  if (testingTriggerSpill(pool_->name())) {
+    spill();
+    return;
+  }
+
+  if (!estimatedOutputRowSize_.has_value()) {
+    return;
+  }
+  const uint64_t outputBytes = estimatedOutputRowSize_.value() *
+      std::min<uint64_t>(maxOutputRows, numInputRows_ - numOutputRows_);
+  {
+    memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
+    if (pool_->maybeReserve(outputBytes)) {
+      return;
+    }
+  }
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(outputBytes)
+               << " for the output of memory pool " << pool()->name()
+               << ", usage: " << succinctBytes(pool()->usedBytes())
+               << ", reservation: " << succinctBytes(pool()->reservedBytes());
+  spill();
+}
+
 std::optional<uint64_t> SortBuffer::estimateOutputRowSize() const {
   return estimatedOutputRowSize_;
 }
@@ -324,14 +348,25 @@ void SortBuffer::prepareOutput(uint32_t maxOutputRows) {
 
 void SortBuffer::getOutputWithoutSpill() {
   VELOX_DCHECK_EQ(numInputRows_, sortedRows_.size());
-  for (const auto& columnProjection : columnMap_) {
-    data_->extractColumn(
-        sortedRows_.data() + numOutputRows_,
-        output_->size(),
-        columnProjection.inputChannel,
-        output_->childAt(columnProjection.outputChannel));
+  // The sorted rows are scattered over 'data_'. Extracting the columns over
+  // chunks of rows that fit in the cache reads each row from memory once
+  // instead of once per column when the rows are wide.
+  const auto* rows = sortedRows_.data() + numOutputRows_;
+  const vector_size_t numRows = output_->size();
+  const vector_size_t chunkRows =
+      std::max<int32_t>(1, kExtractChunkBytes / data_->fixedRowSize());
+  for (vector_size_t offset = 0; offset < numRows; offset += chunkRows) {
+    const auto numChunkRows = std::min(chunkRows, numRows - offset);
+    for (const auto& columnProjection : columnMap_) {
+      data_->extractColumn(
+          rows + offset,
+          numChunkRows,
+          columnProjection.inputChannel,
+          offset,
+          output_->childAt(columnProjection.outputChannel));
+    }
   }
-  numOutputRows_ += output_->size();
+  numOutputRows_ += numRows;
 }
 
 void SortBuffer::getOutputWithSpill() {
@@ -385,7 +420,7 @@ void SortBuffer::finishSpill() {
   spiller_->finishSpill(spillPartitionSet);
   VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
   spillMerger_ = spillPartitionSet.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      *spillConfig_, pool(), spillStats_);
 }
 
 } // namespace facebook::velox::exec
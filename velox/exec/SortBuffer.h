@@ -19,6 +19,7 @@
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/Spill.h"
 #include "velox/vector/BaseVector.h"
@@ -36,6 +37,7 @@ class SortBuffer {
       const std::vector<CompareFlags>& sortCompareFlags,
       velox::memory::MemoryPool* pool,
       tsan_atomic<bool>* nonReclaimableSection,
+      const common::PrefixSortConfig& prefixSortConfig,
       const common::SpillConfig* spillConfig = nullptr,
       folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
 
@@ -58,6 +60,13 @@ class SortBuffer {
   /// Invoked to spill all the rows from 'data_'.
   void spill();
 
+  /// Invoked after noMoreInput() and before getOutput() to reserve memory for
+  /// an output batch of up to 'maxOutputRows' rows. If the reservation fails
+  /// while the output is still produced from the in-memory sorted rows, spills
+  /// the rows not yet returned, so that the rest of the output is merged from
+  /// disk and the memory of 'data_' is freed.
+  void ensureOutputFits(uint32_t maxOutputRows);
+
   memory::MemoryPool* pool() const {
     return pool_;
   }
@@ -80,6 +89,11 @@ class SortBuffer {
   // there is only one hash partition for SortBuffer.
   void finishSpill();
 
+  // Target size of the fixed parts of the rows that getOutputWithoutSpill()
+  // extracts all the columns of before moving on to the next rows. Small
+  // enough for the rows to stay in the CPU cache between columns.
+  static constexpr int32_t kExtractChunkBytes = 256 << 10;
+
   const RowTypePtr input_;
   const std::vector<CompareFlags> sortCompareFlags_;
   velox::memory::MemoryPool* const pool_;
@@ -87,6 +101,8 @@ class SortBuffer {
   // TableWriter to indicate if this sort buffer object is under non-reclaimable
   // execution section or not.
   tsan_atomic<bool>* const nonReclaimableSection_;
+  // Configs for the prefix-sort of the rows in 'data_'.
+  const common::PrefixSortConfig prefixSortConfig_;
   const common::SpillConfig* const spillConfig_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
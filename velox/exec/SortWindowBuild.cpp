@@ -16,6 +16,7 @@
 
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -44,19 +45,16 @@ SortWindowBuild::SortWindowBuild(
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection,
+    const common::PrefixSortConfig& prefixSortConfig,
     folly::Synchronized<common::SpillStats>* spillStats)
     : WindowBuild(node, pool, spillConfig, nonReclaimableSection),
       numPartitionKeys_{node->partitionKeys().size()},
       spillCompareFlags_{
           makeSpillCompareFlags(numPartitionKeys_, node->sortingOrders())},
+      prefixSortConfig_(prefixSortConfig),
       pool_(pool),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(pool_);
-  allKeyInfo_.reserve(partitionKeyInfo_.size() + sortKeyInfo_.size());
-  allKeyInfo_.insert(
-      allKeyInfo_.cend(), partitionKeyInfo_.begin(), partitionKeyInfo_.end());
-  allKeyInfo_.insert(
-      allKeyInfo_.cend(), sortKeyInfo_.begin(), sortKeyInfo_.end());
   partitionStartRows_.resize(0);
 }
 
@@ -209,20 +207,15 @@ void SortWindowBuild::computePartitionStartRows() {
 }
 
 void SortWindowBuild::sortPartitions() {
-  // This is a very inefficient but easy implementation to order the input rows
-  // by partition keys + sort keys.
+  // Order the input rows by partition keys + sort keys.
   // Sort the pointers to the rows in RowContainer (data_) instead of sorting
   // the rows.
   sortedRows_.resize(numRows_);
   RowContainerIterator iter;
   data_->listRows(&iter, numRows_, sortedRows_.data());
 
-  std::sort(
-      sortedRows_.begin(),
-      sortedRows_.end(),
-      [this](const char* leftRow, const char* rightRow) {
-        return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
-      });
+  PrefixSort::sort(
+      sortedRows_, pool_, data_.get(), spillCompareFlags_, prefixSortConfig_);
 
   computePartitionStartRows();
 }
@@ -242,7 +235,7 @@ void SortWindowBuild::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool_, spillStats_);
+        *spillConfig_, pool_, spillStats_);
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -256,33 +249,39 @@ void SortWindowBuild::noMoreInput() {
 void SortWindowBuild::loadNextPartitionFromSpill() {
   sortedRows_.clear();
   data_->clear();
+  lastSpilledRow_ = nullptr;
+  spilledPartition_ = nullptr;
+  spilledPartitionEnded_ = readSpilledPartitionRows(
+      rowStreaming_ ? numRowsPerLoad_
+                    : std::numeric_limits<vector_size_t>::max());
+}
 
+bool SortWindowBuild::readSpilledPartitionRows(vector_size_t maxRows) {
+  vector_size_t numRows = 0;
   for (;;) {
     auto next = merge_->next();
     if (next == nullptr) {
-      break;
+      return true;
     }
 
-    bool newPartition = false;
-    if (!sortedRows_.empty()) {
+    if (lastSpilledRow_ != nullptr) {
       CompareFlags compareFlags =
           CompareFlags::equality(CompareFlags::NullHandlingMode::kNullAsValue);
 
       for (auto i = 0; i < numPartitionKeys_; ++i) {
         if (data_->compare(
-                sortedRows_.back(),
+                lastSpilledRow_,
                 data_->columnAt(i),
                 next->decoded(i),
                 next->currentIndex(),
                 compareFlags)) {
-          newPartition = true;
-          break;
+          return true;
         }
       }
     }
 
-    if (newPartition) {
-      break;
+    if (numRows == maxRows) {
+      return false;
     }
 
     auto* newRow = data_->newRow();
@@ -290,15 +289,25 @@ void SortWindowBuild::loadNextPartitionFromSpill() {
       data_->store(next->decoded(i), next->currentIndex(), newRow, i);
     }
     sortedRows_.push_back(newRow);
+    lastSpilledRow_ = newRow;
+    ++numRows;
     next->pop();
   }
 }
 
-std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
+std::shared_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   if (merge_ != nullptr) {
     VELOX_CHECK(!sortedRows_.empty(), "No window partitions available")
+    if (!spilledPartitionEnded_) {
+      // The partition has more rows than a load. Its rows are added by
+      // loadMoreRows() while the Window operator processes it.
+      spilledPartition_ = std::make_shared<WindowPartition>(
+          data_.get(), inversedInputChannels_, sortKeyInfo_);
+      spilledPartition_->addRows(sortedRows_);
+      return spilledPartition_;
+    }
     auto partition = folly::Range(sortedRows_.data(), sortedRows_.size());
-    return std::make_unique<WindowPartition>(
+    return std::make_shared<WindowPartition>(
         data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
   }
 
@@ -316,7 +325,46 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   auto partition = folly::Range(
       sortedRows_.data() + partitionStartRows_[currentPartition_],
       partitionSize);
-  return std::make_unique<WindowPartition>(
+  return std::make_shared<WindowPartition>(
+      data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
+}
+
+bool SortWindowBuild::loadMoreRows() {
+  if (spilledPartition_ == nullptr) {
+    return false;
+  }
+  sortedRows_.clear();
+  const bool ended = readSpilledPartitionRows(numRowsPerLoad_);
+  if (!sortedRows_.empty()) {
+    spilledPartition_->addRows(sortedRows_);
+  }
+  if (ended) {
+    spilledPartition_->setComplete();
+    spilledPartition_ = nullptr;
+  }
+  return ended || !sortedRows_.empty();
+}
+
+std::vector<vector_size_t> SortWindowBuild::partitionSizes() const {
+  std::vector<vector_size_t> sizes;
+  if (merge_ != nullptr || partitionStartRows_.size() < 2) {
+    return sizes;
+  }
+  sizes.reserve(partitionStartRows_.size() - 1);
+  for (auto i = 0; i < partitionStartRows_.size() - 1; ++i) {
+    sizes.push_back(partitionStartRows_[i + 1] - partitionStartRows_[i]);
+  }
+  return sizes;
+}
+
+std::shared_ptr<WindowPartition> SortWindowBuild::partitionAt(
+    vector_size_t index) const {
+  VELOX_CHECK_NULL(merge_, "Spilled window partitions must be read in order");
+  VELOX_CHECK_LT(index, partitionStartRows_.size() - 1);
+  auto partition = folly::Range(
+      const_cast<char**>(sortedRows_.data()) + partitionStartRows_[index],
+      partitionStartRows_[index + 1] - partitionStartRows_[index]);
+  return std::make_shared<WindowPartition>(
       data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
 }
 
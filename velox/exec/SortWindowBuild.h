@@ -31,6 +31,7 @@ class SortWindowBuild : public WindowBuild {
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection,
+      const common::PrefixSortConfig& prefixSortConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   bool needsInput() override {
@@ -53,7 +54,16 @@ class SortWindowBuild : public WindowBuild {
 
   bool hasNextPartition() override;
 
-  std::unique_ptr<WindowPartition> nextPartition() override;
+  std::shared_ptr<WindowPartition> nextPartition() override;
+
+  bool loadMoreRows() override;
+
+  // Returns the partition sizes if the partitions are sorted in memory, or an
+  // empty vector if the input was spilled.
+  std::vector<vector_size_t> partitionSizes() const override;
+
+  std::shared_ptr<WindowPartition> partitionAt(
+      vector_size_t index) const override;
 
  private:
   void ensureInputFits(const RowVectorPtr& input);
@@ -74,26 +84,29 @@ class SortWindowBuild : public WindowBuild {
   vector_size_t findNextPartitionStartRow(vector_size_t start);
 
   // Reads next partition from spilled data into 'data_' and 'sortedRows_'.
+  // With row streaming, reads at most 'numRowsPerLoad_' rows of it.
   void loadNextPartitionFromSpill();
 
+  // Appends the rows of the current spilled partition to 'sortedRows_' until
+  // the partition ends or 'maxRows' rows have been read. Returns true if the
+  // partition has no more rows.
+  bool readSpilledPartitionRows(vector_size_t maxRows);
+
   const size_t numPartitionKeys_;
 
   // Compare flags for partition and sorting keys. Compare flags for partition
   // keys are set to default values. Compare flags for sorting keys match
   // sorting order specified in the plan node.
   //
-  // Used to sort 'data_' while spilling.
+  // Used to sort 'data_' in memory and while spilling.
   const std::vector<CompareFlags> spillCompareFlags_;
 
+  // Configs for the prefix-sort of the rows in 'data_'.
+  const common::PrefixSortConfig prefixSortConfig_;
+
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
-  // allKeyInfo_ is a combination of (partitionKeyInfo_ and sortKeyInfo_).
-  // It is used to perform a full sorting of the input rows to be able to
-  // separate partitions and sort the rows in it. The rows are output in
-  // this order by the operator.
-  std::vector<std::pair<column_index_t, core::SortOrder>> allKeyInfo_;
-
   // Vector of pointers to each input row in the data_ RowContainer.
   // The rows are sorted by partitionKeys + sortKeys. This total
   // ordering can be used to split partitions (with the correct
@@ -114,6 +127,16 @@ class SortWindowBuild : public WindowBuild {
 
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
+
+  // The last row read from spill. Compared with the next row to detect the
+  // end of the partition.
+  char* lastSpilledRow_ = nullptr;
+
+  // True if the rows read from spill in 'sortedRows_' end their partition.
+  bool spilledPartitionEnded_ = false;
+
+  // The partial partition read from spill that is not yet complete.
+  std::shared_ptr<WindowPartition> spilledPartition_;
 };
 
 } // namespace facebook::velox::exec
@@ -18,6 +18,7 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -76,8 +77,10 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb)
     : getSpillDirPathCb_(getSpillDirPathCb),
+      getOverflowSpillDirPathCb_(getOverflowSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
       maxPartitions_(maxPartitions),
@@ -126,13 +129,15 @@ uint64_t SpillState::appendToPartition(
         numSortKeys_,
         sortCompareFlags_,
         compressionKind_,
-        fmt::format("{}/{}-spill-{}", spillDir, fileNamePrefix_, partition),
+        spillDir,
+        fmt::format("{}-spill-{}", fileNamePrefix_, partition),
         targetFileSize_,
         writeBufferSize_,
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        getOverflowSpillDirPathCb_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -242,13 +247,14 @@ std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createUnorderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const SpillReadAheadOptions& readAheadOptions) {
   VELOX_CHECK_NOT_NULL(pool);
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillBatchStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillBatchStream::create(SpillReadFile::create(
+        fileInfo, bufferSize, pool, spillStats, readAheadOptions)));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
@@ -259,12 +265,13 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const SpillReadAheadOptions& readAheadOptions) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo, bufferSize, pool, spillStats, readAheadOptions)));
   }
   files_.clear();
   // Check if the partition is empty or not.
@@ -274,6 +281,171 @@ SpillPartition::createOrderedReader(
   return std::make_unique<TreeOfLosers<SpillMergeStream>>(std::move(streams));
 }
 
+std::unique_ptr<TreeOfLosers<SpillMergeStream>>
+SpillPartition::createOrderedReader(
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  mergeFiles(maxMergeFanIn(spillConfig), spillConfig, pool, spillStats);
+  return createOrderedReader(
+      spillConfig.readBufferSize,
+      pool,
+      spillStats,
+      SpillReadAheadOptions::fromSpillConfig(spillConfig));
+}
+
+// static
+uint32_t SpillPartition::maxMergeFanIn(
+    const common::SpillConfig& spillConfig) {
+  if (spillConfig.maxMergeBytes == 0) {
+    return std::numeric_limits<uint32_t>::max();
+  }
+  const uint64_t streamBytes =
+      std::max<uint64_t>(spillConfig.readBufferSize, 1) *
+      (1 + spillConfig.readAheadDepth);
+  return std::min<uint64_t>(
+      std::max<uint64_t>(spillConfig.maxMergeBytes / streamBytes, 2),
+      std::numeric_limits<uint32_t>::max());
+}
+
+void SpillPartition::mergeFiles(
+    uint32_t maxFanIn,
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  VELOX_CHECK_GE(maxFanIn, 2);
+  if (files_.size() <= maxFanIn) {
+    return;
+  }
+  uint32_t nextId{0};
+  for (const auto& file : files_) {
+    nextId = std::max(nextId, file.id + 1);
+  }
+  // Keeps the smallest file at the front of 'files_'.
+  const auto greaterSize = [](const SpillFileInfo& lhs,
+                              const SpillFileInfo& rhs) {
+    return lhs.size > rhs.size;
+  };
+  std::make_heap(files_.begin(), files_.end(), greaterSize);
+  size_t numRunFiles = (files_.size() - 2) % (maxFanIn - 1) + 2;
+  while (files_.size() > maxFanIn) {
+    SpillFiles runFiles;
+    runFiles.reserve(numRunFiles);
+    for (size_t i = 0; i < numRunFiles; ++i) {
+      std::pop_heap(files_.begin(), files_.end(), greaterSize);
+      size_ -= files_.back().size;
+      runFiles.push_back(std::move(files_.back()));
+      files_.pop_back();
+    }
+    files_.push_back(mergeRun(
+        std::move(runFiles), nextId++, spillConfig, pool, spillStats));
+    size_ += files_.back().size;
+    std::push_heap(files_.begin(), files_.end(), greaterSize);
+    numRunFiles = maxFanIn;
+  }
+}
+
+SpillFileInfo SpillPartition::mergeRun(
+    SpillFiles files,
+    uint32_t id,
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  VELOX_CHECK_GT(files.size(), 1);
+  VELOX_CHECK_NOT_NULL(
+      spillConfig.getSpillDirPathCb, "Spill directory callback not specified.");
+  const auto spillDir = spillConfig.getSpillDirPathCb();
+  VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
+  const auto type = files[0].type;
+
+  std::vector<std::unique_ptr<SpillMergeStream>> streams;
+  streams.reserve(files.size());
+  const auto readAheadOptions =
+      SpillReadAheadOptions::fromSpillConfig(spillConfig);
+  for (const auto& fileInfo : files) {
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo,
+        spillConfig.readBufferSize,
+        pool,
+        spillStats,
+        readAheadOptions)));
+  }
+  TreeOfLosers<SpillMergeStream> merge(std::move(streams));
+
+  auto updateAndCheckSpillLimitCb = spillConfig.updateAndCheckSpillLimitCb;
+  SpillWriter writer(
+      type,
+      files[0].numSortKeys,
+      files[0].sortFlags,
+      files[0].compressionKind,
+      spillDir,
+      fmt::format(
+          "{}-merge-{}-{}-{}",
+          spillConfig.fileNamePrefix,
+          id_.partitionBitOffset(),
+          id_.partitionNumber(),
+          id),
+      std::numeric_limits<uint64_t>::max(),
+      spillConfig.writeBufferSize,
+      spillConfig.fileCreateConfig,
+      updateAndCheckSpillLimitCb,
+      pool,
+      spillStats,
+      spillConfig.getOverflowSpillDirPathCb);
+
+  constexpr vector_size_t kBatchRows = 1'024;
+  auto output = BaseVector::create<RowVector>(type, kBatchRows, pool);
+  std::vector<const RowVector*> sources(kBatchRows);
+  std::vector<vector_size_t> sourceRows(kBatchRows);
+  vector_size_t numOutputRows{0};
+  vector_size_t numSourceRows{0};
+  const auto copySourceRows = [&]() {
+    if (numSourceRows > 0) {
+      gatherCopy(
+          output.get(), numOutputRows, numSourceRows, sources, sourceRows);
+      numOutputRows += numSourceRows;
+      numSourceRows = 0;
+    }
+  };
+  const auto writeOutput = [&]() {
+    IndexRange range{0, numOutputRows};
+    writer.write(output, folly::Range<IndexRange*>(&range, 1));
+    numOutputRows = 0;
+  };
+  bool isEndOfBatch{false};
+  while (auto* stream = merge.next()) {
+    sources[numSourceRows] = &stream->current();
+    sourceRows[numSourceRows] = stream->currentIndex(&isEndOfBatch);
+    ++numSourceRows;
+    // Copies out the rows of a stream batch before 'pop' replaces it.
+    if (isEndOfBatch || numOutputRows + numSourceRows == kBatchRows) {
+      copySourceRows();
+    }
+    if (numOutputRows == kBatchRows) {
+      writeOutput();
+    }
+    stream->pop();
+  }
+  copySourceRows();
+  if (numOutputRows > 0) {
+    writeOutput();
+  }
+  auto mergedFiles = writer.finish();
+  VELOX_CHECK_EQ(mergedFiles.size(), 1);
+  mergedFiles[0].id = id;
+
+  // The merged files are not read again.
+  for (const auto& file : files) {
+    try {
+      filesystems::getFileSystem(file.path, nullptr)->remove(file.path);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to remove merged spill file " << file.path
+                   << ": " << e.what();
+    }
+  }
+  return std::move(mergedFiles[0]);
+}
+
 uint32_t FileSpillMergeStream::id() const {
   return spillFile_->id();
 }
@@ -277,6 +277,11 @@ class SpillPartition {
     return files_.size();
   }
 
+  /// Returns the spill files that have not been handed to a reader.
+  const SpillFiles& files() const {
+    return files_;
+  }
+
   /// Returns the total file byte size of this spilled partition.
   uint64_t size() const {
     return size_;
@@ -290,29 +295,69 @@ class SpillPartition {
 
   /// Invoked to create an unordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
-  /// 'bufferSize' specifies the read size from the storage. If the file system
-  /// supports async read mode, then reader allocates two buffers with one
-  /// buffer prefetch ahead. 'spillStats' is provided to collect the spill stats
-  /// when reading data from spilled files.
+  /// 'bufferSize' specifies the read size from the storage.
+  /// 'readAheadOptions' specifies how many more buffers each file stream reads
+  /// ahead. 'spillStats' is provided to collect the spill stats when reading
+  /// data from spilled files.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createUnorderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const SpillReadAheadOptions& readAheadOptions = {});
 
   /// Invoked to create an ordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
-  /// 'bufferSize' specifies the read size from the storage. If the file system
-  /// supports async read mode, then reader allocates two buffers with one
-  /// buffer prefetch ahead. 'spillStats' is provided to collect the spill stats
-  /// when reading data from spilled files.
+  /// 'bufferSize' specifies the read size from the storage.
+  /// 'readAheadOptions' specifies how many more buffers each file stream reads
+  /// ahead. 'spillStats' is provided to collect the spill stats when reading
+  /// data from spilled files.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const SpillReadAheadOptions& readAheadOptions = {});
+
+  /// Invoked to create an ordered stream reader from this spill partition
+  /// which reads at most maxMergeFanIn('spillConfig') files at once. If there
+  /// are more files, they are first merged into fewer, larger files in the
+  /// spill directory, see mergeFiles(). The read buffer size and read-ahead
+  /// options are taken from 'spillConfig'.
+  ///
+  /// NOTE: the merged files have duplicate keys if the original files have
+  /// the same key. This can't be used if the files must have unique keys,
+  /// e.g. for TreeOfLosers::nextWithEquals().
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
+      const common::SpillConfig& spillConfig,
+      memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* spillStats);
 
+  /// Returns the number of spill files whose read buffers fit in
+  /// 'spillConfig.maxMergeBytes', but at least 2. Each file takes one read
+  /// buffer plus one per read-ahead.
+  static uint32_t maxMergeFanIn(const common::SpillConfig& spillConfig);
+
   std::string toString() const;
 
  private:
+  // Merges the files of this partition until there are at most 'maxFanIn'
+  // left. Each pass merges the smallest files into one, as in a 'maxFanIn'-ary
+  // Huffman tree, which rewrites the fewest bytes. The first pass merges just
+  // enough files for every later pass and the final merge to read 'maxFanIn'
+  // files.
+  void mergeFiles(
+      uint32_t maxFanIn,
+      const common::SpillConfig& spillConfig,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
+  // Merges 'files' into one sorted file with 'id' and removes them.
+  SpillFileInfo mergeRun(
+      SpillFiles files,
+      uint32_t id,
+      const common::SpillConfig& spillConfig,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
   SpillPartitionId id_;
   SpillFiles files_;
   // Counts the total file size in bytes from this spilled partition.
@@ -332,7 +377,9 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'getOverflowSpillDirPathCb' is set, it is called before
+  /// creating a spill file and the file is created in the returned directory
+  /// if not empty.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -345,7 +392,9 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb =
+          nullptr);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -427,6 +476,10 @@ class SpillState {
   // can use it to ensure the path exists before returning.
   common::GetSpillDirectoryPathCB getSpillDirPathCb_;
 
+  // Returns the overflow spill directory path if the next spill file should be
+  // created there.
+  common::GetSpillDirectoryPathCB getOverflowSpillDirPathCb_;
+
   // Updates the aggregated spill bytes of this query, and throws if exceeds
   // the max spill bytes limit.
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
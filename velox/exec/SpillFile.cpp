@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/SpillFile.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 
@@ -26,62 +27,101 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// Returns true if 'rows' has a column that the batch serializer may write
+// without flattening.
+bool hasEncodedColumn(const RowVector& rows) {
+  for (const auto& child : rows.children()) {
+    const auto encoding = child->encoding();
+    if (encoding == VectorEncoding::Simple::DICTIONARY ||
+        encoding == VectorEncoding::Simple::CONSTANT) {
+      return true;
+    }
+  }
+  return false;
+}
 } // namespace
 
+// static
+SpillReadAheadOptions SpillReadAheadOptions::fromSpillConfig(
+    const common::SpillConfig& spillConfig) {
+  return SpillReadAheadOptions{
+      spillConfig.readAheadDepth,
+      spillConfig.executor,
+      spillConfig.readAheadBudget};
+}
+
 SpillInputStream::SpillInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    const SpillReadAheadOptions& readAheadOptions)
     : file_(std::move(file)),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize - AlignedBuffer::kPaddedSize)),
       pool_(pool),
-      readaEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()),
+      readAheadExecutor_(
+          file_->hasPreadvAsync() ? nullptr : readAheadOptions.executor),
+      readAheadBudget_(readAheadOptions.budget),
+      readAheadDepth_(
+          (bufferSize_ < fileSize_) &&
+                  (file_->hasPreadvAsync() || readAheadExecutor_ != nullptr)
+              ? std::min<uint64_t>(
+                    readAheadOptions.depth,
+                    bits::divRoundUp(fileSize_, bufferSize_) - 1)
+              : 0),
       stats_(stats) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(
       bufferSize, AlignedBuffer::kPaddedSize, "Buffer size is too small");
-  buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
-  if (readaEnabled_) {
+  for (auto i = 0; i <= readAheadDepth_; ++i) {
     buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
   }
   next(/*throwIfPastEnd=*/true);
 }
 
 SpillInputStream::~SpillInputStream() {
-  if (!readaWait_.valid()) {
-    return;
-  }
-  try {
-    readaWait_.wait();
-  } catch (const std::exception& ex) {
-    // ignore any prefetch error when query has failed.
-    LOG(WARNING) << "Spill read-ahead failed on destruction " << ex.what();
+  for (auto& readAhead : readAheads_) {
+    try {
+      readAhead.future.wait();
+    } catch (const std::exception& ex) {
+      // ignore any prefetch error when query has failed.
+      LOG(WARNING) << "Spill read-ahead failed on destruction " << ex.what();
+    }
+    if (readAheadBudget_ != nullptr) {
+      readAheadBudget_->release(readAhead.reservedBytes);
+    }
   }
 }
 
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
   int32_t readBytes{0};
   uint64_t readTimeUs{0};
-  if (readaWait_.valid()) {
+  if (!readAheads_.empty()) {
+    auto readAhead = std::move(readAheads_.front());
+    readAheads_.pop_front();
     {
       MicrosecondTimer timer{&readTimeUs};
-      readBytes = std::move(readaWait_)
+      readBytes = std::move(readAhead.future)
                       .via(&folly::QueuedImmediateExecutor::instance())
                       .wait()
                       .value();
-      VELOX_CHECK(!readaWait_.valid());
+    }
+    if (readAheadBudget_ != nullptr) {
+      readAheadBudget_->release(readAhead.reservedBytes);
     }
     VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
     advanceBuffer();
   } else {
-    readBytes = readSize();
+    VELOX_CHECK_EQ(offset_, readAheadOffset_);
+    readBytes = readSize(offset_);
     VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
     {
       MicrosecondTimer timer{&readTimeUs};
       file_->pread(offset_, readBytes, buffer()->asMutable<char>());
     }
+    readAheadOffset_ += readBytes;
   }
   setRange({buffer()->asMutable<uint8_t>(), readBytes, 0});
   updateSpillStats(readBytes, readTimeUs);
@@ -90,23 +130,40 @@ void SpillInputStream::next(bool /*throwIfPastEnd*/) {
   maybeIssueReadahead();
 }
 
-uint64_t SpillInputStream::readSize() const {
-  return std::min(fileSize_ - offset_, bufferSize_);
+uint64_t SpillInputStream::readSize(uint64_t offset) const {
+  return std::min(fileSize_ - offset, bufferSize_);
 }
 
 void SpillInputStream::maybeIssueReadahead() {
-  VELOX_CHECK(!readaWait_.valid());
-  if (!readaEnabled_) {
-    return;
+  while (readAheads_.size() < readAheadDepth_) {
+    const auto size = readSize(readAheadOffset_);
+    if (size == 0) {
+      return;
+    }
+    if (readAheadBudget_ != nullptr && !readAheadBudget_->tryReserve(size)) {
+      return;
+    }
+    auto* readBuffer =
+        buffers_[nextBufferIndex(readAheads_.size() + 1)]->asMutable<char>();
+    readAheads_.push_back(
+        {readAsync(readAheadOffset_, size, readBuffer),
+         readAheadBudget_ != nullptr ? size : 0});
+    VELOX_CHECK(readAheads_.back().future.valid());
+    readAheadOffset_ += size;
   }
-  const auto size = readSize();
-  if (size == 0) {
-    return;
+}
+
+folly::SemiFuture<uint64_t>
+SpillInputStream::readAsync(uint64_t offset, uint64_t size, char* buffer) {
+  if (readAheadExecutor_ == nullptr) {
+    std::vector<folly::Range<char*>> ranges;
+    ranges.emplace_back(buffer, size);
+    return file_->preadvAsync(offset, ranges);
   }
-  std::vector<folly::Range<char*>> ranges;
-  ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
-  readaWait_ = file_->preadvAsync(offset_, ranges);
-  VELOX_CHECK(readaWait_.valid());
+  return folly::via(readAheadExecutor_, [this, offset, size, buffer]() {
+           file_->pread(offset, size, buffer);
+           return size;
+         }).semi();
 }
 
 void SpillInputStream::updateSpillStats(uint64_t readBytes, uint64_t readTimeUs)
@@ -166,24 +223,28 @@ SpillWriter::SpillWriter(
     const uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
-    const std::string& pathPrefix,
+    std::string_view spillDir,
+    const std::string& fileNamePrefix,
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
-      pathPrefix_(pathPrefix),
+      spillDir_(spillDir),
+      fileNamePrefix_(fileNamePrefix),
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      getOverflowSpillDirPathCb_(getOverflowSpillDirPathCb) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
@@ -195,9 +256,19 @@ SpillWriteFile* SpillWriter::ensureFile() {
     closeFile();
   }
   if (currentFile_ == nullptr) {
+    std::string_view spillDir = spillDir_;
+    currentFileOverflow_ = false;
+    if (getOverflowSpillDirPathCb_ != nullptr) {
+      const auto overflowDir = getOverflowSpillDirPathCb_();
+      if (!overflowDir.empty()) {
+        spillDir = overflowDir;
+        currentFileOverflow_ = true;
+      }
+    }
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format(
+            "{}/{}-{}", spillDir, fileNamePrefix_, finishedFiles_.size()),
         fileCreateConfig_);
   }
   return currentFile_.get();
@@ -224,31 +295,46 @@ size_t SpillWriter::numFinishedFiles() const {
   return finishedFiles_.size();
 }
 
-uint64_t SpillWriter::flush() {
-  if (batch_ == nullptr) {
-    return 0;
-  }
-
-  auto* file = ensureFile();
-  VELOX_CHECK_NOT_NULL(file);
-
+void SpillWriter::flushBatch() {
   IOBufOutputStream out(
       *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
-  uint64_t flushTimeUs{0};
   {
-    MicrosecondTimer timer(&flushTimeUs);
+    MicrosecondTimer timer(&pendingFlushTimeUs_);
     batch_->flush(&out);
   }
   batch_.reset();
+  appendPage(out.getIOBuf());
+}
+
+void SpillWriter::appendPage(std::unique_ptr<folly::IOBuf> page) {
+  pendingPagesBytes_ += page->computeChainDataLength();
+  if (pendingPages_ == nullptr) {
+    pendingPages_ = std::move(page);
+  } else {
+    pendingPages_->prependChain(std::move(page));
+  }
+}
+
+uint64_t SpillWriter::flush() {
+  if (batch_ != nullptr) {
+    flushBatch();
+  }
+  if (pendingPages_ == nullptr) {
+    return 0;
+  }
+
+  auto* file = ensureFile();
+  VELOX_CHECK_NOT_NULL(file);
 
   uint64_t writeTimeUs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     MicrosecondTimer timer(&writeTimeUs);
-    writtenBytes = file->write(std::move(iobuf));
+    writtenBytes = file->write(std::move(pendingPages_));
   }
-  updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
+  pendingPagesBytes_ = 0;
+  updateWriteStats(writtenBytes, pendingFlushTimeUs_, writeTimeUs);
+  pendingFlushTimeUs_ = 0;
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
 }
@@ -258,6 +344,10 @@ uint64_t SpillWriter::write(
     const folly::Range<IndexRange*>& indices) {
   checkNotFinished();
 
+  if (hasEncodedColumn(*rows)) {
+    return writeEncoded(rows, indices);
+  }
+
   uint64_t timeUs{0};
   {
     MicrosecondTimer timer(&timeUs);
@@ -273,7 +363,38 @@ uint64_t SpillWriter::write(
     batch_->append(rows, indices);
   }
   updateAppendStats(rows->size(), timeUs);
-  if (batch_->size() < writeBufferSize_) {
+  if (batch_->size() + pendingPagesBytes_ < writeBufferSize_) {
+    return 0;
+  }
+  return flush();
+}
+
+uint64_t SpillWriter::writeEncoded(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  // Pages are written in order, so the buffered rows go first.
+  if (batch_ != nullptr) {
+    flushBatch();
+  }
+
+  IOBufOutputStream out(*pool_, nullptr, 64 * 1024);
+  uint64_t timeUs{0};
+  {
+    MicrosecondTimer timer(&timeUs);
+    if (encodedSerializer_ == nullptr) {
+      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+      encodedSerializer_ =
+          getVectorSerde()->createBatchSerializer(pool_, &options);
+    }
+    encodedSerializer_->serialize(
+        rows,
+        folly::Range<const IndexRange*>(indices.data(), indices.size()),
+        &out);
+  }
+  appendPage(out.getIOBuf());
+  updateAppendStats(rows->size(), timeUs);
+  if (pendingPagesBytes_ < writeBufferSize_) {
     return 0;
   }
   return flush();
@@ -297,12 +418,21 @@ void SpillWriter::updateWriteStats(
   statsLocked->spillFlushTimeUs += flushTimeUs;
   statsLocked->spillWriteTimeUs += fileWriteTimeUs;
   ++statsLocked->spillWrites;
+  if (currentFileOverflow_) {
+    statsLocked->spilledOverflowBytes += spilledBytes;
+  }
   common::updateGlobalSpillWriteStats(
       spilledBytes, flushTimeUs, fileWriteTimeUs);
 }
 
 void SpillWriter::updateSpilledFileStats(uint64_t fileSize) {
-  ++stats_->wlock()->spilledFiles;
+  {
+    auto statsLocked = stats_->wlock();
+    ++statsLocked->spilledFiles;
+    if (currentFileOverflow_) {
+      ++statsLocked->spilledOverflowFiles;
+    }
+  }
   addThreadLocalRuntimeStat(
       "spillFileSize", RuntimeCounter(fileSize, RuntimeCounter::Unit::kBytes));
   common::incrementGlobalSpilledFiles();
@@ -353,7 +483,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    const SpillReadAheadOptions& readAheadOptions) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -364,7 +495,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.sortFlags,
       fileInfo.compressionKind,
       pool,
-      stats));
+      stats,
+      readAheadOptions));
 }
 
 SpillReadFile::SpillReadFile(
@@ -377,7 +509,8 @@ SpillReadFile::SpillReadFile(
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    const SpillReadAheadOptions& readAheadOptions)
     : id_(id),
       path_(path),
       size_(size),
@@ -392,9 +525,11 @@ SpillReadFile::SpillReadFile(
       pool_(pool),
       stats_(stats) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
-  auto file = fs->openFileForRead(path_);
+  filesystems::FileOptions options;
+  options.useIoUring = true;
+  auto file = fs->openFileForRead(path_, options);
   input_ = std::make_unique<SpillInputStream>(
-      std::move(file), bufferSize, pool_, stats_);
+      std::move(file), bufferSize, pool_, stats_, readAheadOptions);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+#include <deque>
 
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
@@ -99,8 +100,10 @@ using SpillFiles = std::vector<SpillFileInfo>;
 class SpillWriter {
  public:
   /// 'type' is a RowType describing the content. 'numSortKeys' is the number
-  /// of leading columns on which the data is sorted. 'path' is a file path
-  /// prefix. ' 'targetFileSize' is the target byte size of a single file.
+  /// of leading columns on which the data is sorted. The files are created in
+  /// 'spillDir' with 'fileNamePrefix' as file name prefix, or in the directory
+  /// returned by 'getOverflowSpillDirPathCb' if set and the returned path is not
+  /// empty. 'targetFileSize' is the target byte size of a single file.
   /// 'writeBufferSize' specifies the size limit of the buffered data before
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
@@ -114,19 +117,24 @@ class SpillWriter {
       const uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
-      const std::string& pathPrefix,
+      std::string_view spillDir,
+      const std::string& fileNamePrefix,
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb =
+          nullptr);
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
   /// Consecutive calls must have sorted data so that the first row of the
   /// next call is not less than the last row of the previous call.
-  /// Returns the size to write.
+  /// Returns the size to write. If 'rows' has dictionary or constant encoded
+  /// columns, they are written in a separate page that keeps the encodings
+  /// where they make the page smaller, and are read back encoded.
   uint64_t write(
       const RowVectorPtr& rows,
       const folly::Range<IndexRange*>& indices);
@@ -161,10 +169,22 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Writes data from 'batch_' and 'pendingPages_' to the current output file.
+  // Returns the actual written size.
   uint64_t flush();
 
+  // Serializes 'batch_' into a page appended to 'pendingPages_'.
+  void flushBatch();
+
+  void appendPage(std::unique_ptr<folly::IOBuf> page);
+
+  // Serializes 'rows' for the positions in 'indices' into a page of their own
+  // that keeps their encodings. Returns the written size if this triggers a
+  // flush, 0 otherwise.
+  uint64_t writeEncoded(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -181,7 +201,8 @@ class SpillWriter {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
-  const std::string pathPrefix_;
+  const std::string spillDir_;
+  const std::string fileNamePrefix_;
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const std::string fileCreateConfig_;
@@ -191,14 +212,42 @@ class SpillWriter {
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  const common::GetSpillDirectoryPathCB getOverflowSpillDirPathCb_;
 
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // Serializes the pages of encoded spill data. Created on first use.
+  std::unique_ptr<BatchVectorSerializer> encodedSerializer_;
+  // Serialized pages not yet written to the current output file.
+  std::unique_ptr<folly::IOBuf> pendingPages_;
+  uint64_t pendingPagesBytes_{0};
+  // Time spent flushing 'batch_' into 'pendingPages_'.
+  uint64_t pendingFlushTimeUs_{0};
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // True if 'currentFile_' is in the overflow spill directory.
+  bool currentFileOverflow_{false};
   SpillFiles finishedFiles_;
 };
 
+/// Controls the read-ahead of a spill file read stream.
+struct SpillReadAheadOptions {
+  /// The number of buffers read ahead of the one being consumed. Zero disables
+  /// read-ahead.
+  uint32_t depth{1};
+
+  /// Runs the reads ahead if the file has no native async read. If nullptr,
+  /// only files with a native async read are read ahead.
+  folly::Executor* executor{nullptr};
+
+  /// If set, a read is issued ahead only if it fits in the budget.
+  std::shared_ptr<common::SpillReadAheadBudget> budget;
+
+  /// Returns the read-ahead options specified by 'spillConfig'.
+  static SpillReadAheadOptions fromSpillConfig(
+      const common::SpillConfig& spillConfig);
+};
+
 /// Input stream backed by spill file.
 ///
 /// TODO Usage of ByteInputStream as base class is hacky and just happens to
@@ -206,12 +255,14 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
+  /// Reads from 'input' using 'buffer' for buffering reads. Keeps up to
+  /// 'readAheadOptions.depth' more buffers of 'bufferSize' in flight.
   SpillInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      const SpillReadAheadOptions& readAheadOptions = {});
 
   ~SpillInputStream() override;
 
@@ -221,22 +272,33 @@ class SpillInputStream : public ByteInputStream {
   }
 
  private:
+  // A read issued ahead into the buffer after the ones of the previous reads
+  // in 'readAheads_'.
+  struct ReadAhead {
+    folly::SemiFuture<uint64_t> future;
+    // The bytes reserved from the read-ahead budget.
+    uint64_t reservedBytes;
+  };
+
   void updateSpillStats(uint64_t readBytes, uint64_t readTimeUs) const;
 
   void next(bool throwIfPastEnd) override;
 
-  // Issues readahead if underlying fs supports async mode read.
-  //
-  // TODO: we might consider to use AsyncSource to support read-ahead on
-  // filesystem which doesn't support async mode read.
+  // Issues reads ahead until 'readAheadDepth_' reads are in flight, the end of
+  // file is reached or the read-ahead budget is exhausted.
   void maybeIssueReadahead();
 
+  // Reads 'size' bytes at 'offset' into 'buffer' asynchronously.
+  folly::SemiFuture<uint64_t>
+  readAsync(uint64_t offset, uint64_t size, char* buffer);
+
   inline uint32_t bufferIndex() const {
     return bufferIndex_;
   }
 
-  inline uint32_t nextBufferIndex() const {
-    return (bufferIndex_ + 1) % buffers_.size();
+  // Returns the index of the buffer 'distance' buffers after 'buffer()'.
+  inline uint32_t nextBufferIndex(uint32_t distance = 1) const {
+    return (bufferIndex_ + distance) % buffers_.size();
   }
 
   // Advances buffer index to point to the next buffer for read.
@@ -248,27 +310,27 @@ class SpillInputStream : public ByteInputStream {
     return buffers_[bufferIndex()].get();
   }
 
-  inline Buffer* nextBuffer() const {
-    return buffers_[nextBufferIndex()].get();
-  }
-
-  // Returns the next read size in bytes.
-  inline uint64_t readSize() const;
+  // Returns the next read size in bytes at 'offset'.
+  inline uint64_t readSize(uint64_t offset) const;
 
   const std::unique_ptr<ReadFile> file_;
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
-  const bool readaEnabled_;
+  folly::Executor* const readAheadExecutor_;
+  const std::shared_ptr<common::SpillReadAheadBudget> readAheadBudget_;
+  // The max number of reads in flight. Zero if read-ahead is disabled.
+  const uint32_t readAheadDepth_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
   std::vector<BufferPtr> buffers_;
   uint32_t bufferIndex_{0};
-  // Sets to read-ahead future if valid.
-  folly::SemiFuture<uint64_t> readaWait_{
-      folly::SemiFuture<uint64_t>::makeEmpty()};
+  // The reads in flight in file order.
+  std::deque<ReadAhead> readAheads_;
   // Offset of first byte not in 'buffer()'.
   uint64_t offset_ = 0;
+  // Offset of first byte not in 'buffer()' or 'readAheads_'.
+  uint64_t readAheadOffset_ = 0;
 };
 
 /// Represents a spill file for read which turns the serialized spilled data on
@@ -284,7 +346,8 @@ class SpillReadFile {
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      const SpillReadAheadOptions& readAheadOptions = {});
 
   uint32_t id() const {
     return id_;
@@ -320,7 +383,8 @@ class SpillReadFile {
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      const SpillReadAheadOptions& readAheadOptions);
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
@@ -20,6 +20,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/external/timsort/TimSort.hpp"
 
 using facebook::velox::common::testutil::TestValue;
@@ -50,6 +51,7 @@ Spiller::Spiller(
           sortCompareFlags,
           false,
           spillConfig->getSpillDirPathCb,
+          spillConfig->getOverflowSpillDirPathCb,
           spillConfig->updateAndCheckSpillLimitCb,
           spillConfig->fileNamePrefix,
           std::numeric_limits<uint64_t>::max(),
@@ -58,6 +60,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -85,6 +88,7 @@ Spiller::Spiller(
           sortCompareFlags,
           false,
           spillConfig->getSpillDirPathCb,
+          spillConfig->getOverflowSpillDirPathCb,
           spillConfig->updateAndCheckSpillLimitCb,
           spillConfig->fileNamePrefix,
           std::numeric_limits<uint64_t>::max(),
@@ -93,6 +97,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
@@ -116,6 +121,7 @@ Spiller::Spiller(
           {},
           false,
           spillConfig->getSpillDirPathCb,
+          spillConfig->getOverflowSpillDirPathCb,
           spillConfig->updateAndCheckSpillLimitCb,
           spillConfig->fileNamePrefix,
           std::numeric_limits<uint64_t>::max(),
@@ -124,6 +130,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
@@ -148,6 +155,7 @@ Spiller::Spiller(
           {},
           false,
           spillConfig->getSpillDirPathCb,
+          spillConfig->getOverflowSpillDirPathCb,
           spillConfig->updateAndCheckSpillLimitCb,
           spillConfig->fileNamePrefix,
           spillConfig->maxFileSize,
@@ -156,6 +164,7 @@ Spiller::Spiller(
           spillConfig->executor,
           0,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -181,6 +190,7 @@ Spiller::Spiller(
           {},
           needRightSideJoin(joinType),
           spillConfig->getSpillDirPathCb,
+          spillConfig->getOverflowSpillDirPathCb,
           spillConfig->updateAndCheckSpillLimitCb,
           spillConfig->fileNamePrefix,
           spillConfig->maxFileSize,
@@ -189,6 +199,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
   VELOX_CHECK(isHashJoinTableSpillType(rowType_, joinType));
@@ -210,6 +221,7 @@ Spiller::Spiller(
           {},
           false,
           spillConfig->getSpillDirPathCb,
+          spillConfig->getOverflowSpillDirPathCb,
           spillConfig->updateAndCheckSpillLimitCb,
           spillConfig->fileNamePrefix,
           spillConfig->maxFileSize,
@@ -218,8 +230,12 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
           spillStats) {
-  VELOX_CHECK_EQ(type_, Type::kRowNumber);
+  VELOX_CHECK(
+      type_ == Type::kRowNumber || type_ == Type::kAggregateHashPartitioned,
+      "Unexpected spiller type: {}",
+      typeName(type_));
 }
 
 Spiller::Spiller(
@@ -231,6 +247,7 @@ Spiller::Spiller(
     const std::vector<CompareFlags>& sortCompareFlags,
     bool recordProbedFlag,
     const common::GetSpillDirectoryPathCB& getSpillDirPathCb,
+    const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb,
     const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     const std::string& fileNamePrefix,
     uint64_t targetFileSize,
@@ -239,6 +256,7 @@ Spiller::Spiller(
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     folly::Synchronized<common::SpillStats>* spillStats)
     : type_(type),
       container_(container),
@@ -247,6 +265,7 @@ Spiller::Spiller(
       rowType_(std::move(rowType)),
       spillProbedFlag_(recordProbedFlag),
       maxSpillRunRows_(maxSpillRunRows),
+      prefixSortConfig_(prefixSortConfig),
       spillStats_(spillStats),
       state_(
           getSpillDirPathCb,
@@ -260,7 +279,8 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          getOverflowSpillDirPathCb) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
@@ -416,13 +436,27 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeUs{0};
   {
     MicrosecondTimer timer(&sortTimeUs);
-    gfx::timsort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    if (prefixSortConfig_.has_value()) {
+      // PrefixSort needs the flags of all keys, which default to ascending
+      // with nulls first like in RowContainer::compareRows().
+      const auto& sortCompareFlags = state_.sortCompareFlags();
+      PrefixSort::sort(
+          run.rows,
+          memory::spillMemoryPool(),
+          container_,
+          sortCompareFlags.empty()
+              ? std::vector<CompareFlags>(container_->keyTypes().size())
+              : sortCompareFlags,
+          prefixSortConfig_.value());
+    } else {
+      gfx::timsort(
+          run.rows.begin(),
+          run.rows.end(),
+          [&](const char* left, const char* right) {
+            return container_->compareRows(
+                       left, right, state_.sortCompareFlags()) < 0;
+          });
+    }
     run.sorted = true;
   }
 
@@ -538,7 +572,8 @@ void Spiller::updateSpillSortTime(uint64_t timeUs) {
 bool Spiller::needSort() const {
   return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild &&
       type_ != Type::kRowNumber && type_ != Type::kAggregateOutput &&
-      type_ != Type::kOrderByOutput;
+      type_ != Type::kOrderByOutput &&
+      type_ != Type::kAggregateHashPartitioned;
 }
 
 void Spiller::spill() {
@@ -601,7 +636,7 @@ void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK(
       type_ == Type::kHashJoinProbe || type_ == Type::kHashJoinBuild ||
-          type_ == Type::kRowNumber,
+          type_ == Type::kRowNumber || type_ == Type::kAggregateHashPartitioned,
       "Unexpected spiller type: {}",
       typeName(type_));
   if (FOLLY_UNLIKELY(!state_.isPartitionSpilled(partition))) {
@@ -736,6 +771,8 @@ std::string Spiller::typeName(Type type) {
       return "AGGREGATE_OUTPUT";
     case Type::kRowNumber:
       return "ROW_NUMBER";
+    case Type::kAggregateHashPartitioned:
+      return "AGGREGATE_HASH_PARTITIONED";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
   }
@@ -41,8 +41,11 @@ class Spiller {
     kOrderByOutput = 5,
     // Used for row number.
     kRowNumber = 6,
+    // Used for hash partitioned aggregation spill, which writes the groups
+    // unsorted and aggregates one spilled partition at a time.
+    kAggregateHashPartitioned = 7,
     // Number of spiller types.
-    kNumTypes = 7,
+    kNumTypes = 8,
   };
 
   static std::string typeName(Type);
@@ -99,7 +102,7 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
-  /// type == Type::kRowNumber
+  /// type == Type::kRowNumber || type == Type::kAggregateHashPartitioned
   Spiller(
       Type type,
       RowContainer* container,
@@ -210,6 +213,7 @@ class Spiller {
       const std::vector<CompareFlags>& sortCompareFlags,
       bool spillProbedFlag,
       const common::GetSpillDirectoryPathCB& getSpillDirPathCb,
+      const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       const std::string& fileNamePrefix,
       uint64_t targetFileSize,
@@ -218,6 +222,7 @@ class Spiller {
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
@@ -329,6 +334,8 @@ class Spiller {
   const RowTypePtr rowType_;
   const bool spillProbedFlag_;
   const uint64_t maxSpillRunRows_;
+  // If set, the spill runs are sorted with prefix-sort instead of timsort.
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
@@ -31,6 +31,19 @@ void StreamingWindowBuild::buildNextPartition() {
   inputRows_.clear();
 }
 
+void StreamingWindowBuild::addRowsToPartialPartition() {
+  if (inputRows_.empty()) {
+    return;
+  }
+  if (inputPartition_ == nullptr) {
+    inputPartition_ = std::make_shared<WindowPartition>(
+        data_.get(), inversedInputChannels_, sortKeyInfo_);
+    partialPartitions_.push_back(inputPartition_);
+  }
+  inputPartition_->addRows(inputRows_);
+  inputRows_.clear();
+}
+
 void StreamingWindowBuild::addInput(RowVectorPtr input) {
   for (auto i = 0; i < inputChannels_.size(); ++i) {
     decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
@@ -45,22 +58,49 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
 
     if (previousRow_ != nullptr &&
         compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
-      buildNextPartition();
+      if (rowStreaming_) {
+        addRowsToPartialPartition();
+        inputPartition_->setComplete();
+        inputPartition_ = nullptr;
+      } else {
+        buildNextPartition();
+      }
     }
 
     inputRows_.push_back(newRow);
     previousRow_ = newRow;
   }
+
+  if (rowStreaming_) {
+    addRowsToPartialPartition();
+  }
 }
 
 void StreamingWindowBuild::noMoreInput() {
+  if (rowStreaming_) {
+    addRowsToPartialPartition();
+    if (inputPartition_ != nullptr) {
+      inputPartition_->setComplete();
+      inputPartition_ = nullptr;
+    }
+    return;
+  }
+
   buildNextPartition();
 
   // Help for last partition related calculations.
   partitionStartRows_.push_back(sortedRows_.size());
 }
 
-std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
+std::shared_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
+  if (rowStreaming_) {
+    VELOX_CHECK(
+        !partialPartitions_.empty(), "No window partitions available");
+    auto partition = std::move(partialPartitions_.front());
+    partialPartitions_.pop_front();
+    return partition;
+  }
+
   VELOX_CHECK_GT(
       partitionStartRows_.size(), 0, "No window partitions available")
 
@@ -89,11 +129,14 @@ std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
       sortedRows_.data() + partitionStartRows_[currentPartition_],
       partitionSize);
 
-  return std::make_unique<WindowPartition>(
+  return std::make_shared<WindowPartition>(
       data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
 }
 
 bool StreamingWindowBuild::hasNextPartition() {
+  if (rowStreaming_) {
+    return !partialPartitions_.empty();
+  }
   return partitionStartRows_.size() > 0 &&
       currentPartition_ < int(partitionStartRows_.size() - 2);
 }
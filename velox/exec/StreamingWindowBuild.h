@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/WindowBuild.h"
 
 namespace facebook::velox::exec {
@@ -23,7 +25,10 @@ namespace facebook::velox::exec {
 /// The StreamingWindowBuild is used when the input data is already sorted by
 /// {partition keys + order by keys}. The logic identifies partition changes
 /// when receiving input rows and splits out WindowPartitions for the Window
-/// operator to process.
+/// operator to process. With row streaming, a partition is handed out as a
+/// partial partition as soon as its first rows arrive. Its rows are added as
+/// input is received and released by the Window operator once computed, so
+/// that a single partition does not have to fit in memory.
 class StreamingWindowBuild : public WindowBuild {
  public:
   StreamingWindowBuild(
@@ -46,9 +51,13 @@ class StreamingWindowBuild : public WindowBuild {
 
   bool hasNextPartition() override;
 
-  std::unique_ptr<WindowPartition> nextPartition() override;
+  std::shared_ptr<WindowPartition> nextPartition() override;
 
   bool needsInput() override {
+    if (rowStreaming_) {
+      // The partition receiving input has been handed out.
+      return partialPartitions_.empty();
+    }
     // No partitions are available or the currentPartition is the last available
     // one, so can consume input rows.
     return partitionStartRows_.size() == 0 ||
@@ -58,6 +67,9 @@ class StreamingWindowBuild : public WindowBuild {
  private:
   void buildNextPartition();
 
+  // Adds 'inputRows_' to 'inputPartition_' with row streaming.
+  void addRowsToPartialPartition();
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // Rows are erased from data_ when they are output from the
   // Window operator.
@@ -77,6 +89,13 @@ class StreamingWindowBuild : public WindowBuild {
   // Current partition being output. Used to construct WindowPartitions
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
+
+  // With row streaming, the partial partition that receives the input rows.
+  std::shared_ptr<WindowPartition> inputPartition_;
+
+  // With row streaming, the partial partitions not yet returned by
+  // nextPartition(). These are the partitions started by the last input.
+  std::deque<std::shared_ptr<WindowPartition>> partialPartitions_;
 };
 
 } // namespace facebook::velox::exec
@@ -14,14 +14,29 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include "velox/common/io/IoConcurrencyLimiter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/FilterProject.h"
+#include "velox/exec/HashAggregation.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
+namespace {
+// Returns a permit to read ahead of 'split' or std::nullopt if the storage
+// location of 'split' has as many reads ahead in flight as it allows.
+std::optional<io::IoConcurrencyLimiter::Permit> tryAcquireReadAhead(
+    const connector::ConnectorSplit& split) {
+  auto* limiter = io::IoConcurrencyLimiter::instance();
+  if (limiter == nullptr) {
+    return io::IoConcurrencyLimiter::Permit();
+  }
+  return limiter->tryAcquire(split.storagePath());
+}
+} // namespace
 
 TableScan::TableScan(
     int32_t operatorId,
@@ -44,10 +59,16 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      maxSplitFilePrefetchPerDriver_(
+          driverCtx_->queryConfig().maxSplitFilePrefetchPerDriver()),
+      asyncIo_(driverCtx_->queryConfig().tableScanAsyncIo()),
+      splitStealing_(driverCtx_->queryConfig().tableScanSplitStealing()),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       getOutputTimeLimitMs_(
-          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()) {
+          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()),
+      adaptiveBatchSize_(
+          driverCtx_->queryConfig().adaptiveOutputBatchSizeEnabled()) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
 }
 
@@ -80,6 +101,7 @@ RowVectorPtr TableScan::getOutput() {
   }
 
   curStatus_ = "getOutput: enter";
+  addRemoteDynamicFilters();
   const auto startTimeMs = getCurrentTimeMs();
   for (;;) {
     if (needNewSplit_) {
@@ -101,19 +123,58 @@ RowVectorPtr TableScan::getOutput() {
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
-      exec::Split split;
-      curStatus_ = "getOutput: task->getSplitOrFuture";
-      blockingReason_ = driverCtx_->task->getSplitOrFuture(
-          driverCtx_->splitGroupId,
-          planNodeId(),
-          split,
-          blockingFuture_,
-          maxPreloadedSplits_,
-          splitPreloader_);
-      if (blockingReason_ != BlockingReason::kNotBlocked) {
+      if (!remoteDynamicFiltersWaitDone_) {
+        curStatus_ = "getOutput: task->waitForRemoteDynamicFilters";
+        blockingReason_ = driverCtx_->task->waitForRemoteDynamicFilters(
+            planNodeId(), blockingFuture_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          return nullptr;
+        }
+        remoteDynamicFiltersWaitDone_ = true;
+        addRemoteDynamicFilters();
+      }
+
+      if (resultCacheAggregation_ != nullptr &&
+          !resultCacheAggregation_->readyForSplit()) {
+        // The aggregation first produces the results of the previous split.
+        curStatus_ = "getOutput: waiting for split results";
         return nullptr;
       }
 
+      exec::Split split;
+      if (pendingSplit_.hasConnectorSplit()) {
+        split = std::move(pendingSplit_);
+        pendingSplit_ = exec::Split();
+      } else {
+        curStatus_ = "getOutput: task->getSplitOrFuture";
+        blockingReason_ = driverCtx_->task->getSplitOrFuture(
+            driverCtx_->splitGroupId,
+            planNodeId(),
+            split,
+            blockingFuture_,
+            maxPreloadedSplits_,
+            splitPreloader_,
+            maxFilePrefetchSplits_,
+            splitFilePrefetcher_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          return nullptr;
+        }
+      }
+
+      stolenSplit_ = false;
+      if (!split.hasConnectorSplit() && splitStealing_) {
+        curStatus_ = "getOutput: task->stealSplit";
+        // A point for test code injection.
+        TestValue::adjust(
+            "facebook::velox::exec::TableScan::getOutput::stealSplit", this);
+        if (auto stolen = driverCtx_->task->stealSplit(
+                driverCtx_->splitGroupId, planNodeId())) {
+          split = exec::Split(std::move(stolen));
+          stolenSplit_ = true;
+          ++numStolenSplits_;
+        }
+      }
+
       if (!split.hasConnectorSplit()) {
         noMoreSplits_ = true;
         dynamicFilters_.clear();
@@ -135,6 +196,21 @@ RowVectorPtr TableScan::getOutput() {
         return nullptr;
       }
 
+      if (asyncIo_ && split.connectorSplit->dataSource != nullptr &&
+          split.connectorSplit->dataSource->isMaking(blockingFuture_)) {
+        // Waits for the preload off the driver thread.
+        pendingSplit_ = std::move(split);
+        blockingReason_ = BlockingReason::kWaitForSplit;
+        stats_.wlock()->addRuntimeStat(
+            "asyncSplitPreloadWaits", RuntimeCounter(1));
+        return nullptr;
+      }
+
+      if (resultCacheAggregation_ != nullptr &&
+          replaySplitResult(*split.connectorSplit)) {
+        continue;
+      }
+
       const auto& connectorSplit = split.connectorSplit;
       currentSplitWeight_ = connectorSplit->splitWeight;
       needNewSplit_ = false;
@@ -152,6 +228,7 @@ RowVectorPtr TableScan::getOutput() {
         curStatus_ = "getOutput: creating dataSource_";
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
             connectorSplit->connectorId, planNodeId(), connectorPool_);
+        connectorQueryCtx_->setAsyncIo(asyncIo_);
         dataSource_ = connector_->createDataSource(
             outputType_,
             tableHandle_,
@@ -160,6 +237,7 @@ RowVectorPtr TableScan::getOutput() {
         for (const auto& entry : dynamicFilters_) {
           dataSource_->addDynamicFilter(entry.first, entry.second);
         }
+        checkFilePrefetch();
       }
 
       debugString_ = fmt::format(
@@ -200,8 +278,22 @@ RowVectorPtr TableScan::getOutput() {
             RuntimeCounter(
                 addSplitTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
       }
+      if (splitStealing_) {
+        stealableSplit_ = dataSource_->stealableSplit();
+        if (stealableSplit_ != nullptr) {
+          driverCtx_->task->addStealableSplit(
+              driverCtx_->splitGroupId, planNodeId(), stealableSplit_);
+          // A point for test code injection.
+          TestValue::adjust(
+              "facebook::velox::exec::TableScan::getOutput::addStealableSplit",
+              this);
+        }
+      }
+
       curStatus_ = "getOutput: updating stats_.numSplits";
-      ++stats_.wlock()->numSplits;
+      if (!stolenSplit_) {
+        ++stats_.wlock()->numSplits;
+      }
 
       curStatus_ = "getOutput: dataSource_->estimatedRowSize";
       const auto estimatedRowSize = dataSource_->estimatedRowSize();
@@ -230,6 +322,9 @@ RowVectorPtr TableScan::getOutput() {
           maxReadBatchSize_,
           static_cast<int32_t>(readBatchSize / maxFilteringRatio_));
     }
+    if (adaptiveBatchSize_) {
+      readBatchSize = adaptReadBatchSize(readBatchSize);
+    }
     curStatus_ = "getOutput: dataSource_->next";
     uint64_t ioTimeUs{0};
     std::optional<RowVectorPtr> dataOptional;
@@ -283,10 +378,31 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (numFilePrefetchedSplits_ > 0) {
+        lockedStats->addRuntimeStat(
+            "filePrefetchedSplits", RuntimeCounter(numFilePrefetchedSplits_));
+        numFilePrefetchedSplits_ = 0;
+      }
+      if (numLimitedReadAheads_ > 0) {
+        lockedStats->addRuntimeStat(
+            "limitedReadAheads", RuntimeCounter(numLimitedReadAheads_));
+        numLimitedReadAheads_ = 0;
+      }
+      if (numStolenSplits_ > 0) {
+        lockedStats->addRuntimeStat(
+            "stolenSplits", RuntimeCounter(numStolenSplits_));
+        numStolenSplits_ = 0;
+      }
     }
 
-    curStatus_ = "getOutput: task->splitFinished";
-    driverCtx_->task->splitFinished(true, currentSplitWeight_);
+    if (resultCacheAggregation_ != nullptr) {
+      resultCacheAggregation_->finishSplit();
+    }
+    stealableSplit_.reset();
+    if (!stolenSplit_) {
+      curStatus_ = "getOutput: task->splitFinished";
+      driverCtx_->task->splitFinished(true, currentSplitWeight_);
+    }
     needNewSplit_ = true;
   }
 }
@@ -298,13 +414,15 @@ void TableScan::preload(
   // a shared_ptr to it. This is required to keep memory pools live
   // for the duration. The callback checks for task cancellation to
   // avoid needless work.
+  auto connectorQueryCtx = operatorCtx_->createConnectorQueryCtx(
+      split->connectorId, planNodeId(), connectorPool_);
+  connectorQueryCtx->setAsyncIo(asyncIo_);
   split->dataSource = std::make_unique<AsyncSource<connector::DataSource>>(
       [type = outputType_,
        table = tableHandle_,
        columns = columnHandles_,
        connector = connector_,
-       ctx = operatorCtx_->createConnectorQueryCtx(
-           split->connectorId, planNodeId(), connectorPool_),
+       ctx = std::move(connectorQueryCtx),
        task = operatorCtx_->task(),
        dynamicFilters = dynamicFilters_,
        split]() -> std::unique_ptr<connector::DataSource> {
@@ -332,6 +450,47 @@ void TableScan::preload(
       });
 }
 
+bool TableScan::replaySplitResult(const connector::ConnectorSplit& split) {
+  // With dynamic filters the results are not those of the whole split.
+  if (stolenSplit_ || !dynamicFilters_.empty()) {
+    return false;
+  }
+  const auto splitKey = split.cacheKey();
+  if (!splitKey.has_value() ||
+      !resultCacheAggregation_->startSplit(splitKey.value())) {
+    return false;
+  }
+  if (split.dataSource != nullptr) {
+    split.dataSource->close();
+  }
+  {
+    auto lockedStats = stats_.wlock();
+    ++lockedStats->numSplits;
+    lockedStats->addRuntimeStat("cachedSplitResults", RuntimeCounter(1));
+  }
+  driverCtx_->task->splitFinished(true, split.splitWeight);
+  return true;
+}
+
+int32_t TableScan::adaptReadBatchSize(int32_t readBatchSize) {
+  if (!downstreamFilterResolved_) {
+    downstreamFilter_ = dynamic_cast<FilterProject*>(
+        operatorCtx_->driver()->findOperatorNoThrow(operatorId() + 1));
+    downstreamFilterResolved_ = true;
+  }
+  if (downstreamFilter_ != nullptr) {
+    // Same bound as for the filters pushed into the scan.
+    constexpr double kMinSelectivity = 0.25;
+    readBatchSize = std::min(
+        maxReadBatchSize_,
+        static_cast<int32_t>(
+            readBatchSize /
+            std::max(kMinSelectivity, downstreamFilter_->selectivity())));
+  }
+  addRuntimeStat("readBatchRows", RuntimeCounter(readBatchSize));
+  return readBatchSize;
+}
+
 void TableScan::checkPreload() {
   auto* executor = connector_->executor();
   if (maxSplitPreloadPerDriver_ == 0 || !executor ||
@@ -345,9 +504,16 @@ void TableScan::checkPreload() {
       splitPreloader_ =
           [executor,
            this](const std::shared_ptr<connector::ConnectorSplit>& split) {
+            auto permit = tryAcquireReadAhead(*split);
+            if (!permit.has_value()) {
+              // The Task offers the split again on the next getSplit.
+              ++numLimitedReadAheads_;
+              return;
+            }
             preload(split);
 
-            executor->add([connectorSplit = split]() mutable {
+            executor->add([connectorSplit = split,
+                           permit = std::move(*permit)]() mutable {
               connectorSplit->dataSource->prepare();
               connectorSplit.reset();
             });
@@ -356,10 +522,54 @@ void TableScan::checkPreload() {
   }
 }
 
+void TableScan::checkFilePrefetch() {
+  auto* executor = connector_->executor();
+  if (maxSplitFilePrefetchPerDriver_ == 0 || !executor) {
+    return;
+  }
+  maxFilePrefetchSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
+      maxSplitFilePrefetchPerDriver_;
+  splitFilePrefetcher_ = [executor, this](const auto& split) {
+    auto permit = tryAcquireReadAhead(*split);
+    if (!permit.has_value()) {
+      // Lets the Task offer the split again on the next getSplit.
+      split->filePrefetched = false;
+      ++numLimitedReadAheads_;
+      return;
+    }
+    auto prefetch = dataSource_->prefetchSplitFile(split);
+    if (prefetch == nullptr) {
+      return;
+    }
+    ++numFilePrefetchedSplits_;
+    // The prefetch may outlive 'this'. It keeps the Task for its memory pools
+    // and the connector for its caches.
+    executor->add([task = operatorCtx_->task(),
+                   connector = connector_,
+                   prefetch = std::move(prefetch),
+                   permit = std::move(*permit)]() {
+      if (!task->isCancelled()) {
+        prefetch();
+      }
+    });
+  };
+}
+
 bool TableScan::isFinished() {
   return noMoreSplits_;
 }
 
+void TableScan::close() {
+  if (pendingSplit_.hasConnectorSplit() &&
+      pendingSplit_.connectorSplit->dataSource != nullptr) {
+    // The Task only closes the preloads of the splits it still has.
+    pendingSplit_.connectorSplit->dataSource->close();
+  }
+  pendingSplit_ = Split();
+  stealableSplit_.reset();
+  SourceOperator::close();
+}
+
 void TableScan::addDynamicFilter(
     const core::PlanNodeId& producer,
     column_index_t outputChannel,
@@ -367,8 +577,30 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  if (resultCacheAggregation_ != nullptr) {
+    // The filter drops rows of the split being read.
+    resultCacheAggregation_->abandonSplitResult();
+  }
+  auto [it, inserted] = dynamicFilters_.emplace(outputChannel, filter);
+  if (!inserted) {
+    it->second = it->second->mergeWith(filter.get());
+  }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
 
+void TableScan::addRemoteDynamicFilters() {
+  const auto numFilters = driverCtx_->task->numRemoteDynamicFilters();
+  if (numFilters == numSeenRemoteDynamicFilters_ || !canAddDynamicFilter()) {
+    return;
+  }
+  numSeenRemoteDynamicFilters_ = numFilters;
+  const auto filters = driverCtx_->task->remoteDynamicFilters(
+      planNodeId(), numAddedRemoteDynamicFilters_);
+  numAddedRemoteDynamicFilters_ += filters.size();
+  for (const auto& filter : filters) {
+    addDynamicFilter(filter.producer, filter.channel, filter.filter);
+    addRuntimeStat("remoteDynamicFiltersAccepted", RuntimeCounter(1));
+  }
+}
+
 } // namespace facebook::velox::exec
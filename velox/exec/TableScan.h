@@ -17,9 +17,13 @@
 
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Split.h"
 
 namespace facebook::velox::exec {
 
+class FilterProject;
+class HashAggregation;
+
 class TableScan : public SourceOperator {
  public:
   TableScan(
@@ -41,6 +45,8 @@ class TableScan : public SourceOperator {
 
   bool isFinished() override;
 
+  void close() override;
+
   bool canAddDynamicFilter() const override {
     return connector_->canAddDynamicFilter();
   }
@@ -50,6 +56,12 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  /// Sets the partial aggregation at the end of the pipeline that caches its
+  /// results per split. See HashAggregation::startSplit().
+  void setResultCacheAggregation(HashAggregation* aggregation) {
+    resultCacheAggregation_ = aggregation;
+  }
+
  private:
   // Checks if this table scan operator needs to yield before processing the
   // next split.
@@ -64,12 +76,29 @@ class TableScan : public SourceOperator {
   // of the Task's split queue for 'this' when getting splits.
   void checkPreload();
 
+  // Sets 'maxFilePrefetchSplits_' and 'splitFilePrefetcher_' if the data source
+  // can open the files of upcoming splits ahead of reading them.
+  void checkFilePrefetch();
+
+  // Scales 'readBatchSize' up by the selectivity of a FilterProject right
+  // after the scan, so that the filtered batches are not tiny. Used with
+  // adaptive output batch sizes.
+  int32_t adaptReadBatchSize(int32_t readBatchSize);
+
+  // Adds the dynamic filters from joins in other tasks that arrived since the
+  // last call. No-op if the connector does not accept dynamic filters.
+  void addRemoteDynamicFilters();
+
   // Sets 'split->dataSource' to be an AsyncSource that makes a DataSource to
   // read 'split'. This source will be prepared in the background on the
   // executor of the connector. If the DataSource is needed before prepare is
   // done, it will be made when needed.
   void preload(const std::shared_ptr<connector::ConnectorSplit>& split);
 
+  // Starts 'split' in 'resultCacheAggregation_'. Returns true if the results
+  // of 'split' are cached and 'split' is done without being read.
+  bool replaySplitResult(const connector::ConnectorSplit& split);
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
@@ -88,10 +117,42 @@ class TableScan : public SourceOperator {
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
 
+  // Value of Task::numRemoteDynamicFilters() at the last check for new remote
+  // dynamic filters.
+  uint64_t numSeenRemoteDynamicFilters_{0};
+
+  // Number of the remote dynamic filters of this scan added so far.
+  size_t numAddedRemoteDynamicFilters_{0};
+
+  // True once the wait for remote dynamic filters before the first split is
+  // over.
+  bool remoteDynamicFiltersWaitDone_{false};
+
   int32_t maxPreloadedSplits_{0};
 
   const int32_t maxSplitPreloadPerDriver_{0};
 
+  // See QueryConfig::kTableScanAsyncIo.
+  const bool asyncIo_;
+
+  // See QueryConfig::kTableScanSplitStealing.
+  const bool splitStealing_;
+
+  // The unread part of the current split, offered to the other drivers of
+  // the scan while the split is read.
+  std::shared_ptr<connector::StealableSplit> stealableSplit_;
+
+  // True if the current split was taken over from another driver and did not
+  // come from the Task.
+  bool stolenSplit_{false};
+
+  // Count of splits taken over from other drivers.
+  int32_t numStolenSplits_{0};
+
+  // A split whose preload was in progress when it was taken from the Task. Read
+  // by the next getOutput() after the preload is done.
+  Split pendingSplit_;
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -99,6 +160,27 @@ class TableScan : public SourceOperator {
   std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>
       splitPreloader_{nullptr};
 
+  int32_t maxFilePrefetchSplits_{0};
+
+  const int32_t maxSplitFilePrefetchPerDriver_{0};
+
+  // Callback passed to getSplitOrFuture() for opening the files of the splits
+  // after the preloading ones on the executor of the connector. Same lifetime
+  // rules as for 'splitPreloader_'.
+  std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>
+      splitFilePrefetcher_{nullptr};
+
+  // Count of splits whose files were opened in the background.
+  int32_t numFilePrefetchedSplits_{0};
+
+  // Count of split preloads and file prefetches not started because the
+  // storage location of the split had its limit of reads ahead in flight.
+  int32_t numLimitedReadAheads_{0};
+
+  // The partial aggregation that caches the results of the splits of this,
+  // if any.
+  HashAggregation* resultCacheAggregation_{nullptr};
+
   // Count of splits that started background preload.
   int32_t numPreloadedSplits_{0};
 
@@ -114,6 +196,13 @@ class TableScan : public SourceOperator {
 
   double maxFilteringRatio_{0};
 
+  const bool adaptiveBatchSize_;
+
+  // The FilterProject after the scan, if any. Set on first use, after all
+  // operators of the driver are made.
+  FilterProject* downstreamFilter_{nullptr};
+  bool downstreamFilterResolved_{false};
+
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 
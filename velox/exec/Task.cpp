@@ -32,6 +32,7 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/TopNFilter.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -304,6 +305,18 @@ Task::Task(
     VELOX_CHECK_NULL(
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx_->executor()));
   }
+  const auto maxSpillReadAheadBytes =
+      queryCtx_->queryConfig().maxSpillReadAheadBytes();
+  if (maxSpillReadAheadBytes > 0) {
+    spillReadAheadBudget_ =
+        std::make_shared<common::SpillReadAheadBudget>(maxSpillReadAheadBytes);
+  }
+  const auto stackSamplingIntervalMs =
+      queryCtx_->queryConfig().taskStackSamplingIntervalMs();
+  if (stackSamplingIntervalMs > 0 && process::StackSampler::supported()) {
+    stackSampler_ =
+        std::make_unique<process::StackSampler>(stackSamplingIntervalMs);
+  }
 }
 
 Task::~Task() {
@@ -339,6 +352,7 @@ Task::~Task() {
   CLEAR(exchangeClientByPlanNode_.clear());
   CLEAR(exchangeClients_.clear());
   CLEAR(exception_ = nullptr);
+  CLEAR(exprResultCache_.reset());
   CLEAR(nodePools_.clear());
   CLEAR(childPools_.clear());
   CLEAR(pool_.reset());
@@ -405,16 +419,59 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
-void Task::removeSpillDirectoryIfExists() {
-  if (spillDirectory_.empty() || !spillDirectoryCreated_) {
-    return;
+const std::string& Task::getOverflowSpillDirectory() {
+  static const std::string kEmpty;
+  if (overflowSpillDirectoryCreated_) {
+    return overflowSpillDirectory_;
+  }
+  const auto& queryConfig = queryCtx_->queryConfig();
+  const auto maxLocalSpillBytes = queryConfig.maxLocalSpillBytes();
+  if (maxLocalSpillBytes == 0 ||
+      queryCtx_->spilledBytes() < maxLocalSpillBytes) {
+    return kEmpty;
+  }
+  const auto overflowSpillPath = queryConfig.spillOverflowPath();
+  if (overflowSpillPath.empty()) {
+    return kEmpty;
   }
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  if (overflowSpillDirectoryCreated_) {
+    return overflowSpillDirectory_;
+  }
+  const auto overflowSpillDirectory =
+      fmt::format("{}/{}", overflowSpillPath, taskId());
   try {
-    auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fs->rmdir(spillDirectory_);
+    auto fileSystem =
+        filesystems::getFileSystem(overflowSpillDirectory, nullptr);
+    fileSystem->mkdir(overflowSpillDirectory);
   } catch (const std::exception& e) {
-    LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
-               << "' for Task " << taskId() << ": " << e.what();
+    VELOX_FAIL(
+        "Failed to create overflow spill directory '{}' for Task {}: {}",
+        overflowSpillDirectory,
+        taskId(),
+        e.what());
+  }
+  overflowSpillDirectory_ = overflowSpillDirectory;
+  overflowSpillDirectoryCreated_ = true;
+  return overflowSpillDirectory_;
+}
+
+void Task::removeSpillDirectoryIfExists() {
+  auto removeDirectory = [&](const std::string& directory) {
+    try {
+      auto fs = filesystems::getFileSystem(directory, nullptr);
+      fs->rmdir(directory);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove spill directory '" << directory
+                 << "' for Task " << taskId() << ": " << e.what();
+    }
+  };
+  if (!spillDirectory_.empty() && spillDirectoryCreated_) {
+    removeDirectory(spillDirectory_);
+  }
+  if (overflowSpillDirectoryCreated_) {
+    removeDirectory(overflowSpillDirectory_);
   }
 }
 
@@ -428,6 +485,12 @@ void Task::initTaskPool() {
   VELOX_CHECK_NULL(pool_);
   pool_ = queryCtx_->pool()->addAggregateChild(
       fmt::format("task.{}", taskId_.c_str()), createTaskReclaimer());
+  const auto exprResultCacheMaxBytes =
+      queryCtx_->queryConfig().exprResultCacheMaxBytes();
+  if (exprResultCacheMaxBytes > 0) {
+    exprResultCache_ = std::make_unique<ExprResultCache>(
+        pool_->addLeafChild("exprResultCache"), exprResultCacheMaxBytes);
+  }
 }
 
 velox::memory::MemoryPool* Task::getOrAddNodePool(
@@ -552,11 +615,17 @@ bool Task::supportsSingleThreadedExecution() const {
     return false;
   }
 
-  std::vector<std::unique_ptr<DriverFactory>> driverFactories;
-  LocalPlanner::plan(
-      planFragment_, nullptr, &driverFactories, queryCtx_->queryConfig(), 1);
+  if (singleThreadedDriverFactories_.empty()) {
+    MicrosecondTimer timer(&singleThreadedPlanningTimeUs_);
+    LocalPlanner::plan(
+        planFragment_,
+        nullptr,
+        &singleThreadedDriverFactories_,
+        queryCtx_->queryConfig(),
+        1);
+  }
 
-  for (const auto& factory : driverFactories) {
+  for (const auto& factory : singleThreadedDriverFactories_) {
     if (!factory->supportsSingleThreadedExecution()) {
       return false;
     }
@@ -596,8 +665,18 @@ RowVectorPtr Task::next(ContinueFuture* future) {
         "callback");
 
     taskStats_.executionStartTimeMs = getCurrentTimeMs();
-    LocalPlanner::plan(
-        planFragment_, nullptr, &driverFactories_, queryCtx_->queryConfig(), 1);
+    if (!singleThreadedDriverFactories_.empty()) {
+      driverFactories_ = std::move(singleThreadedDriverFactories_);
+      taskStats_.planningTimeUs = singleThreadedPlanningTimeUs_;
+    } else {
+      MicrosecondTimer timer(&taskStats_.planningTimeUs);
+      LocalPlanner::plan(
+          planFragment_,
+          nullptr,
+          &driverFactories_,
+          queryCtx_->queryConfig(),
+          1);
+    }
     exchangeClients_.resize(driverFactories_.size());
 
     // In Task::next() we always assume ungrouped execution.
@@ -740,12 +819,15 @@ void Task::createDriverFactoriesLocked(uint32_t maxDrivers) {
   VELOX_CHECK(driverFactories_.empty());
 
   // Create driver factories.
-  LocalPlanner::plan(
-      planFragment_,
-      consumerSupplier(),
-      &driverFactories_,
-      queryCtx_->queryConfig(),
-      maxDrivers);
+  {
+    MicrosecondTimer timer(&taskStats_.planningTimeUs);
+    LocalPlanner::plan(
+        planFragment_,
+        consumerSupplier(),
+        &driverFactories_,
+        queryCtx_->queryConfig(),
+        maxDrivers);
+  }
 
   // Calculates total number of drivers and create pipeline stats.
   for (auto& factory : driverFactories_) {
@@ -1031,6 +1113,7 @@ std::vector<std::shared_ptr<Driver>> Task::createDriversLocked(
 
   std::vector<std::shared_ptr<Driver>> drivers;
   auto self = shared_from_this();
+  MicrosecondTimer timer(&taskStats_.driverCreationTimeUs);
   for (auto pipeline = 0; pipeline < numPipelines; ++pipeline) {
     auto& factory = driverFactories_[pipeline];
     // We either create drivers for grouped execution or ungrouped.
@@ -1205,6 +1288,7 @@ bool Task::addSplitWithSequence(
     const core::PlanNodeId& planNodeId,
     exec::Split&& split,
     long sequenceId) {
+  maybeSetSplitGroupFromBucket(planNodeId, split);
   std::unique_ptr<ContinuePromise> promise;
   bool added = false;
   bool isTaskRunning;
@@ -1237,6 +1321,7 @@ bool Task::addSplitWithSequence(
 }
 
 void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
+  maybeSetSplitGroupFromBucket(planNodeId, split);
   bool isTaskRunning;
   std::unique_ptr<ContinuePromise> promise;
   {
@@ -1273,6 +1358,20 @@ void Task::addRemoteSplit(
   }
 }
 
+void Task::maybeSetSplitGroupFromBucket(
+    const core::PlanNodeId& planNodeId,
+    exec::Split& split) const {
+  if (split.hasGroup() || !split.hasConnectorSplit() ||
+      !planFragment_.leafNodeRunsGroupedExecution(planNodeId)) {
+    return;
+  }
+  const auto bucketNumber = split.connectorSplit->bucketNumber();
+  if (bucketNumber.has_value()) {
+    VELOX_CHECK_GE(bucketNumber.value(), 0);
+    split.groupId = bucketNumber.value();
+  }
+}
+
 std::unique_ptr<ContinuePromise> Task::addSplitLocked(
     SplitsState& splitsState,
     exec::Split&& split) {
@@ -1447,7 +1546,9 @@ BlockingReason Task::getSplitOrFuture(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t maxFilePrefetchSplits,
+    const ConnectorSplitPreloadFunc& filePrefetch) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
   return getSplitOrFutureLocked(
@@ -1456,7 +1557,9 @@ BlockingReason Task::getSplitOrFuture(
       split,
       future,
       maxPreloadSplits,
-      preload);
+      preload,
+      maxFilePrefetchSplits,
+      filePrefetch);
 }
 
 BlockingReason Task::getSplitOrFutureLocked(
@@ -1465,7 +1568,9 @@ BlockingReason Task::getSplitOrFutureLocked(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t maxFilePrefetchSplits,
+    const ConnectorSplitPreloadFunc& filePrefetch) {
   if (splitsStore.splits.empty()) {
     if (splitsStore.noMoreSplits) {
       return BlockingReason::kNotBlocked;
@@ -1477,7 +1582,13 @@ BlockingReason Task::getSplitOrFutureLocked(
     return BlockingReason::kWaitForSplit;
   }
 
-  split = getSplitLocked(forTableScan, splitsStore, maxPreloadSplits, preload);
+  split = getSplitLocked(
+      forTableScan,
+      splitsStore,
+      maxPreloadSplits,
+      preload,
+      maxFilePrefetchSplits,
+      filePrefetch);
   return BlockingReason::kNotBlocked;
 }
 
@@ -1485,16 +1596,21 @@ exec::Split Task::getSplitLocked(
     bool forTableScan,
     SplitsStore& splitsStore,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t maxFilePrefetchSplits,
+    const ConnectorSplitPreloadFunc& filePrefetch) {
   int32_t readySplitIndex = -1;
   if (maxPreloadSplits > 0) {
     for (auto i = 0; i < splitsStore.splits.size() && i < maxPreloadSplits;
          ++i) {
       auto& connectorSplit = splitsStore.splits[i].connectorSplit;
       if (!connectorSplit->dataSource) {
-        // Initializes split->dataSource.
+        // Initializes split->dataSource unless the split may not be read
+        // ahead yet.
         preload(connectorSplit);
-        preloadingSplits_.emplace(connectorSplit);
+        if (connectorSplit->dataSource) {
+          preloadingSplits_.emplace(connectorSplit);
+        }
       } else if (
           (readySplitIndex == -1) && (connectorSplit->dataSource->hasValue())) {
         readySplitIndex = i;
@@ -1502,6 +1618,20 @@ exec::Split Task::getSplitLocked(
       }
     }
   }
+  if (maxFilePrefetchSplits > 0) {
+    // The splits past the preloading ones only get their files opened. The
+    // split taken below is not prefetched since it is read right away.
+    const auto begin = std::max<int32_t>(1, maxPreloadSplits);
+    const auto end = begin + maxFilePrefetchSplits;
+    for (auto i = begin; i < splitsStore.splits.size() && i < end; ++i) {
+      auto& connectorSplit = splitsStore.splits[i].connectorSplit;
+      if (connectorSplit != nullptr && !connectorSplit->dataSource &&
+          !connectorSplit->filePrefetched) {
+        connectorSplit->filePrefetched = true;
+        filePrefetch(connectorSplit);
+      }
+    }
+  }
   if (readySplitIndex == -1) {
     readySplitIndex = 0;
   }
@@ -1555,6 +1685,120 @@ void Task::multipleSplitsFinished(
   }
 }
 
+void Task::addExportedDynamicFilters(
+    const core::PlanNodeId& producer,
+    std::map<std::string, std::shared_ptr<common::Filter>> filters) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  exportedDynamicFilters_.emplace(producer, std::move(filters));
+}
+
+folly::dynamic Task::exportedDynamicFilters() const {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto filters = folly::dynamic::array();
+  for (const auto& [producer, columnFilters] : exportedDynamicFilters_) {
+    for (const auto& [column, filter] : columnFilters) {
+      folly::dynamic obj = folly::dynamic::object;
+      obj["producer"] = producer;
+      obj["column"] = column;
+      obj["filter"] = filter->serialize();
+      filters.push_back(std::move(obj));
+    }
+  }
+  return filters;
+}
+
+void Task::addRemoteDynamicFilter(
+    const core::PlanNodeId& scanNodeId,
+    const std::string& column,
+    const core::PlanNodeId& producer,
+    std::shared_ptr<common::Filter> filter) {
+  VELOX_CHECK_NOT_NULL(filter);
+  const auto* scanNode = dynamic_cast<const core::TableScanNode*>(
+      core::PlanNode::findFirstNode(
+          planFragment_.planNode.get(), [&](const core::PlanNode* node) {
+            return node->id() == scanNodeId;
+          }));
+  VELOX_USER_CHECK_NOT_NULL(
+      scanNode, "TableScan plan node not found: {}", scanNodeId);
+  const auto channel = scanNode->outputType()->getChildIdxIfExists(column);
+  VELOX_USER_CHECK(
+      channel.has_value(),
+      "Column {} not found in the output of TableScan {}",
+      column,
+      scanNodeId);
+
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    auto& state = remoteDynamicFilters_[scanNodeId];
+    state.filters.push_back({producer, channel.value(), std::move(filter)});
+    ++numRemoteDynamicFilters_;
+    if (state.filters.size() >= state.numExpected) {
+      promises = std::move(state.promises);
+    }
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+void Task::expectRemoteDynamicFilters(
+    const core::PlanNodeId& scanNodeId,
+    uint32_t numFilters,
+    uint64_t maxWaitMs) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto& state = remoteDynamicFilters_[scanNodeId];
+  state.numExpected = numFilters;
+  state.maxWaitMs = maxWaitMs;
+}
+
+BlockingReason Task::waitForRemoteDynamicFilters(
+    const core::PlanNodeId& scanNodeId,
+    ContinueFuture& future) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto it = remoteDynamicFilters_.find(scanNodeId);
+  if (it == remoteDynamicFilters_.end() || !isRunningLocked()) {
+    return BlockingReason::kNotBlocked;
+  }
+  auto& state = it->second;
+  if (state.filters.size() >= state.numExpected || state.maxWaitMs == 0) {
+    return BlockingReason::kNotBlocked;
+  }
+  const auto nowMs = getCurrentTimeMs();
+  if (state.waitUntilMs == 0) {
+    state.waitUntilMs = nowMs + state.maxWaitMs;
+  }
+  if (nowMs >= state.waitUntilMs) {
+    return BlockingReason::kNotBlocked;
+  }
+
+  auto [promise, promiseFuture] = makeVeloxContinuePromiseContract(
+      fmt::format("Task::waitForRemoteDynamicFilters {}", taskId_));
+  state.promises.push_back(std::move(promise));
+  // Reading without the filters gives the same result, so the end of the wait
+  // is not an error.
+  future = std::move(promiseFuture)
+               .within(std::chrono::milliseconds(state.waitUntilMs - nowMs))
+               .deferError(
+                   folly::tag_t<folly::FutureTimeout>{},
+                   [](const folly::FutureTimeout&) {});
+  return BlockingReason::kWaitForDynamicFilter;
+}
+
+std::vector<RemoteDynamicFilter> Task::remoteDynamicFilters(
+    const core::PlanNodeId& scanNodeId,
+    size_t begin) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto it = remoteDynamicFilters_.find(scanNodeId);
+  if (it == remoteDynamicFilters_.end() ||
+      begin >= it->second.filters.size()) {
+    return {};
+  }
+  const auto& filters = it->second.filters;
+  return std::vector<RemoteDynamicFilter>(
+      filters.begin() + begin, filters.end());
+}
+
 bool Task::isGroupedExecution() const {
   return planFragment_.isGroupedExecution();
 }
@@ -1742,11 +1986,28 @@ void Task::addHashJoinBridgesLocked(
     const std::vector<core::PlanNodeId>& planNodeIds) {
   auto& splitGroupState = splitGroupStates_[splitGroupId];
   for (const auto& planNodeId : planNodeIds) {
-    splitGroupState.bridges.emplace(
-        planNodeId, std::make_shared<HashJoinBridge>());
+    auto bridge = std::make_shared<HashJoinBridge>();
+    if (splitGroupId == kUngroupedGroupId && isSharedHashBuild(planNodeId)) {
+      SharedHashBuild::getInstance(queryCtx_->queryId(), planNodeId)
+          ->addBridge(bridge, shared_from_this());
+    }
+    splitGroupState.bridges.emplace(planNodeId, std::move(bridge));
   }
 }
 
+void Task::setSharedHashBuild(const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  VELOX_CHECK_EQ(
+      taskStats_.executionStartTimeMs,
+      0,
+      "Hash table sharing must be set before the task starts");
+  VELOX_USER_CHECK(
+      !queryCtx_->queryId().empty(),
+      "Sharing the hash table of join {} needs a query id",
+      planNodeId);
+  sharedHashBuildNodeIds_.insert(planNodeId);
+}
+
 void Task::addCustomJoinBridgesLocked(
     uint32_t splitGroupId,
     const std::vector<core::PlanNodePtr>& planNodes) {
@@ -1950,6 +2211,10 @@ ContinueFuture Task::terminate(TaskState terminalState) {
       splitGroupStates.push_back(std::move(splitGroupState.second));
     }
 
+    for (auto& [planNodeId, state] : remoteDynamicFilters_) {
+      movePromisesOut(state.promises, splitPromises);
+    }
+
     // Collect all outstanding split promises from all splits state structures.
     for (auto& pair : splitsStates_) {
       auto& splitState = pair.second;
@@ -2400,6 +2665,45 @@ void Task::createMergeJoinSource(
       {planNodeId, std::make_shared<MergeJoinSource>()});
 }
 
+std::shared_ptr<TopNThreshold> Task::getOrAddTopNThreshold(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    bool ascending) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto& threshold = splitGroupStates_[splitGroupId].topNThresholds[planNodeId];
+  if (threshold == nullptr) {
+    threshold = std::make_shared<TopNThreshold>(ascending);
+  }
+  return threshold;
+}
+
+void Task::addStealableSplit(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    const std::shared_ptr<connector::StealableSplit>& split) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  splitGroupStates_[splitGroupId].stealableSplits[planNodeId].push_back(split);
+}
+
+std::shared_ptr<connector::ConnectorSplit> Task::stealSplit(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto& splits = splitGroupStates_[splitGroupId].stealableSplits[planNodeId];
+  for (auto it = splits.begin(); it != splits.end();) {
+    auto split = it->lock();
+    if (split == nullptr) {
+      it = splits.erase(it);
+      continue;
+    }
+    if (auto stolen = split->steal()) {
+      return stolen;
+    }
+    ++it;
+  }
+  return nullptr;
+}
+
 std::shared_ptr<MergeJoinSource> Task::getMergeJoinSource(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId) {
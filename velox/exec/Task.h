@@ -23,6 +23,7 @@
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
+#include "velox/expression/ExprResultCache.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
@@ -194,6 +195,19 @@ class Task : public std::enable_shared_from_this<Task> {
   /// be off-thread and there must be no 'exception_'
   static void resume(std::shared_ptr<Task> self);
 
+  /// Makes the tasks of this query that run the join 'planNodeId' share one
+  /// hash table, built by the first of them to start. The build side input of
+  /// the join must be the same in all these tasks, e.g. a broadcast. Only
+  /// applies to ungrouped execution. Must be called before start(). See
+  /// SharedHashBuild.
+  void setSharedHashBuild(const core::PlanNodeId& planNodeId);
+
+  /// Returns true if the join 'planNodeId' shares its hash table with the other
+  /// tasks of the query.
+  bool isSharedHashBuild(const core::PlanNodeId& planNodeId) const {
+    return sharedHashBuildNodeIds_.count(planNodeId) != 0;
+  }
+
   /// Sets the (so far) max split sequence id, so all splits with sequence id
   /// equal or below that, will be ignored in the 'addSplitWithSequence' call.
   /// Note, that 'addSplitWithSequence' does not update max split sequence id
@@ -218,6 +232,8 @@ class Task : public std::enable_shared_from_this<Task> {
   /// Adds split for a source operator corresponding to plan node with
   /// specified ID. Does not require sequential id.
   /// Note that, the operation is silently ignored if Task is not running.
+  /// In grouped execution, a split without a group is added to the group of
+  /// its table bucket number if the connector split has one.
   void addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split);
 
   /// We mark that for the given group there would be no more splits coming.
@@ -401,14 +417,21 @@ class Task : public std::enable_shared_from_this<Task> {
   /// that will complete when split becomes available or no-more-splits
   /// signal is received. If 'maxPreloadSplits' is given, ensures that
   /// so many of splits at the head of the queue are preloading. If
-  /// they are not, calls preload on them to start preload.
+  /// they are not, calls preload on them to start preload. 'preload' may
+  /// leave the split without a data source, e.g. when the storage does not
+  /// take more reads ahead, and is called again on the next call. If
+  /// 'maxFilePrefetchSplits' is given, calls 'filePrefetch' once on each of
+  /// so many splits that follow the preloading ones, unless 'filePrefetch'
+  /// resets ConnectorSplit::filePrefetched.
   BlockingReason getSplitOrFuture(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
       exec::Split& split,
       ContinueFuture& future,
       int32_t maxPreloadSplits = 0,
-      const ConnectorSplitPreloadFunc& preload = nullptr);
+      const ConnectorSplitPreloadFunc& preload = nullptr,
+      int32_t maxFilePrefetchSplits = 0,
+      const ConnectorSplitPreloadFunc& filePrefetch = nullptr);
 
   void splitFinished(bool fromTableScan, int64_t splitWeight);
 
@@ -417,6 +440,57 @@ class Task : public std::enable_shared_from_this<Task> {
       int32_t numSplits,
       int64_t splitsWeight);
 
+  /// Records 'filters' built by the join 'producer' once its build side is
+  /// complete, keyed on the names of the probe side columns they apply to.
+  /// Only the first call for each join is kept, as all probe drivers of a join
+  /// build the same filters.
+  void addExportedDynamicFilters(
+      const core::PlanNodeId& producer,
+      std::map<std::string, std::shared_ptr<common::Filter>> filters);
+
+  /// Returns the filters recorded by addExportedDynamicFilters() as an array
+  /// of objects with the keys "producer", "column" and "filter", where
+  /// "filter" is the serialized Filter. A coordinator forwards these to the
+  /// tasks that scan the probe side of the joins, which add them with
+  /// addRemoteDynamicFilter().
+  folly::dynamic exportedDynamicFilters() const;
+
+  /// Adds 'filter' produced by the join 'producer' of another task on the
+  /// output column 'column' of the TableScan 'scanNodeId'. The scans apply the
+  /// filter before reading their next batch.
+  void addRemoteDynamicFilter(
+      const core::PlanNodeId& scanNodeId,
+      const std::string& column,
+      const core::PlanNodeId& producer,
+      std::shared_ptr<common::Filter> filter);
+
+  /// Makes the TableScan 'scanNodeId' wait before reading its first split
+  /// until 'numFilters' remote dynamic filters have been added for it, but no
+  /// longer than 'maxWaitMs'.
+  void expectRemoteDynamicFilters(
+      const core::PlanNodeId& scanNodeId,
+      uint32_t numFilters,
+      uint64_t maxWaitMs);
+
+  /// Returns kWaitForDynamicFilter and sets 'future' if the TableScan
+  /// 'scanNodeId' is to wait for remote dynamic filters. The future is
+  /// realized when the expected filters have arrived or the wait time is over.
+  BlockingReason waitForRemoteDynamicFilters(
+      const core::PlanNodeId& scanNodeId,
+      ContinueFuture& future);
+
+  /// Returns the number of remote dynamic filters added for all the scans of
+  /// this task. Lets a scan check for new filters without locking.
+  uint64_t numRemoteDynamicFilters() const {
+    return numRemoteDynamicFilters_;
+  }
+
+  /// Returns the remote dynamic filters of the TableScan 'scanNodeId' in the
+  /// order of arrival, starting at position 'begin'.
+  std::vector<RemoteDynamicFilter> remoteDynamicFilters(
+      const core::PlanNodeId& scanNodeId,
+      size_t begin);
+
   /// Adds a MergeSource for the specified splitGroupId and planNodeId.
   std::shared_ptr<MergeSource> addLocalMergeSource(
       uint32_t splitGroupId,
@@ -428,6 +502,27 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Returns the leading key threshold shared by the drivers of the TopN
+  /// 'planNodeId' in the split group. Creates it on first call.
+  std::shared_ptr<TopNThreshold> getOrAddTopNThreshold(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      bool ascending);
+
+  /// Lets the other drivers of the TableScan 'planNodeId' in the split group
+  /// take over the unread part of 'split' through stealSplit(). 'split' is
+  /// offered as long as the caller holds it.
+  void addStealableSplit(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      const std::shared_ptr<connector::StealableSplit>& split);
+
+  /// Takes over a part of a split added by addStealableSplit(). Returns
+  /// nullptr if no split has an unread part left.
+  std::shared_ptr<connector::ConnectorSplit> stealSplit(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
   void createMergeJoinSource(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
@@ -654,6 +749,41 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  /// Returns the overflow spill directory path if the query has configured an
+  /// overflow spill path and has spilled at least max_local_spill_bytes, and
+  /// an empty string otherwise. The overflow spill directory is a task
+  /// specific subdirectory of the overflow spill path, created on first use.
+  /// Is thread safe.
+  const std::string& getOverflowSpillDirectory();
+
+  /// Returns the budget for the bytes read ahead by the spill file read streams
+  /// of this task, or nullptr if there is no limit.
+  const std::shared_ptr<common::SpillReadAheadBudget>& spillReadAheadBudget()
+      const {
+    return spillReadAheadBudget_;
+  }
+
+  /// Returns the sampler of the stacks of the driver threads of this task, or
+  /// nullptr if the query does not sample stacks.
+  process::StackSampler* stackSampler() const {
+    return stackSampler_.get();
+  }
+
+  /// Returns the stack samples taken so far as folded stacks, one line per
+  /// distinct stack with the number of samples, rooted at the pipeline and
+  /// operator of the sample. Returns an empty string if the query does not
+  /// sample stacks. See QueryConfig::kTaskStackSamplingIntervalMs.
+  std::string foldedStacks() const {
+    return stackSampler_ == nullptr ? "" : stackSampler_->foldedStacks();
+  }
+
+  /// Returns the cache of expression results over dictionary bases shared by
+  /// the drivers of this task, or nullptr if
+  /// QueryConfig::exprResultCacheMaxBytes() is zero.
+  ExprResultCache* exprResultCache() const {
+    return exprResultCache_.get();
+  }
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -855,7 +985,9 @@ class Task : public std::enable_shared_from_this<Task> {
       exec::Split& split,
       ContinueFuture& future,
       int32_t maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload);
+      const ConnectorSplitPreloadFunc& preload,
+      int32_t maxFilePrefetchSplits,
+      const ConnectorSplitPreloadFunc& filePrefetch);
 
   /// Returns next split from the store. The caller must ensure the store is not
   /// empty.
@@ -863,7 +995,9 @@ class Task : public std::enable_shared_from_this<Task> {
       bool forTableScan,
       SplitsStore& splitsStore,
       int32_t maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload);
+      const ConnectorSplitPreloadFunc& preload,
+      int32_t maxFilePrefetchSplits = 0,
+      const ConnectorSplitPreloadFunc& filePrefetch = nullptr);
 
   // Creates for the given split group and fills up the 'SplitGroupState'
   // structure, which stores inter-operator state (local exchange, bridges).
@@ -902,6 +1036,15 @@ class Task : public std::enable_shared_from_this<Task> {
       SplitsState& splitsState,
       exec::Split&& split);
 
+  // Sets the split group of 'split' to the table bucket number of its
+  // connector split if 'split' has no group and the plan node with
+  // 'planNodeId' runs grouped execution. Then the splits of tables bucketed
+  // the same way are processed one bucket at a time, e.g. a hash join builds
+  // the table for one bucket at a time.
+  void maybeSetSplitGroupFromBucket(
+      const core::PlanNodeId& planNodeId,
+      exec::Split& split) const;
+
   std::unique_ptr<ContinuePromise> addSplitToStoreLocked(
       SplitsStore& splitsStore,
       exec::Split&& split);
@@ -1015,6 +1158,9 @@ class Task : public std::enable_shared_from_this<Task> {
   // NOTE: 'childPools_' holds the ownerships of node memory pools.
   std::unordered_map<std::string, memory::MemoryPool*> nodePools_;
 
+  // Allocates from a leaf child of 'pool_'. Set by initTaskPool() if enabled.
+  std::unique_ptr<ExprResultCache> exprResultCache_;
+
   // Set to true by OutputBufferManager when all output is
   // acknowledged. If this happens before Drivers are at end, the last
   // Driver to finish will set state_ to kFinished. If Drivers have
@@ -1048,6 +1194,12 @@ class Task : public std::enable_shared_from_this<Task> {
   std::function<void(std::exception_ptr)> onError_;
 
   std::vector<std::unique_ptr<DriverFactory>> driverFactories_;
+  // The DriverFactories planned by supportsSingleThreadedExecution() and the
+  // time it took to plan them. next() takes these over instead of planning
+  // the fragment a second time.
+  mutable std::vector<std::unique_ptr<DriverFactory>>
+      singleThreadedDriverFactories_;
+  mutable uint64_t singleThreadedPlanningTimeUs_{0};
   std::vector<std::shared_ptr<Driver>> drivers_;
   // When Drivers are closed by the Task, there is a chance that race and/or
   // bugs can cause such Drivers to be held forever, in turn holding a pointer
@@ -1101,6 +1253,9 @@ class Task : public std::enable_shared_from_this<Task> {
   // groups for different nodes and to determine how many split groups we to
   // process in total.
   std::unordered_set<uint32_t> seenSplitGroups_;
+
+  // The hash joins whose tables are shared with the other tasks of the query.
+  std::unordered_set<core::PlanNodeId> sharedHashBuildNodeIds_;
   // Split groups for which we have received splits but haven't started
   // processing. It grows with arrival of the 1st split of a previously not seen
   // split group and depletes with creating new sets of drivers to process
@@ -1115,6 +1270,21 @@ class Task : public std::enable_shared_from_this<Task> {
   // nodes that expect splits.
   std::unordered_map<core::PlanNodeId, SplitsState> splitsStates_;
 
+  // Dynamic filters of the joins of this task for probe side scans in other
+  // tasks, keyed on the join plan node id and the probe side column name.
+  std::map<
+      core::PlanNodeId,
+      std::map<std::string, std::shared_ptr<common::Filter>>>
+      exportedDynamicFilters_;
+
+  // Dynamic filters from joins of other tasks, keyed on the TableScan plan
+  // node id.
+  std::unordered_map<core::PlanNodeId, RemoteDynamicFiltersState>
+      remoteDynamicFilters_;
+
+  // Number of filters in 'remoteDynamicFilters_'.
+  std::atomic<uint64_t> numRemoteDynamicFilters_{0};
+
   // Promises that are fulfilled when the task is completed (terminated).
   std::vector<ContinuePromise> taskCompletionPromises_;
 
@@ -1166,6 +1336,19 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Overflow spill directory for this task. Set on first use under
+  // 'spillDirCreateMutex_'.
+  std::string overflowSpillDirectory_;
+  std::atomic<bool> overflowSpillDirectoryCreated_{false};
+
+  // Bounds the bytes read ahead by the spill file read streams of this task.
+  // Set on construction if the query config limits the read-ahead bytes.
+  std::shared_ptr<common::SpillReadAheadBudget> spillReadAheadBudget_;
+
+  // Samples the stacks of the driver threads. Set on construction if the query
+  // config enables stack sampling.
+  std::unique_ptr<process::StackSampler> stackSampler_;
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
@@ -88,6 +88,15 @@ struct TaskStats {
   /// being cancelled or aborted.
   uint64_t terminationTimeMs{0};
 
+  /// Time (us) spent planning the DriverFactories for the plan fragment. This
+  /// and 'driverCreationTimeUs' are the task setup cost, which matters for
+  /// short queries.
+  uint64_t planningTimeUs{0};
+
+  /// Time (us) spent creating Drivers, including their Operators and memory
+  /// pools. Accumulates over split groups in grouped execution.
+  uint64_t driverCreationTimeUs{0};
+
   /// Total number of drivers.
   uint64_t numTotalDrivers{0};
   /// The number of completed drivers (which slots are null in Task 'drivers_'
@@ -18,6 +18,12 @@
 #include <unordered_set>
 #include <vector>
 
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::connector {
+class StealableSplit;
+} // namespace facebook::velox::connector
+
 namespace facebook::velox::exec {
 
 class Driver;
@@ -26,6 +32,7 @@ class LocalExchangeMemoryManager;
 class MergeSource;
 class MergeJoinSource;
 struct Split;
+class TopNThreshold;
 
 /// Corresponds to Presto TaskState, needed for reporting query completion.
 enum TaskState { kRunning, kFinished, kCanceled, kAborted, kFailed };
@@ -79,6 +86,37 @@ struct SplitsState {
   SplitsState& operator=(SplitsState const&) = delete;
 };
 
+/// A dynamic filter produced by a join in another task on an output column of a
+/// TableScan of this task.
+struct RemoteDynamicFilter {
+  /// Plan node id of the join that produced the filter.
+  core::PlanNodeId producer;
+  /// Output channel of the TableScan the filter applies to.
+  column_index_t channel;
+  std::shared_ptr<common::Filter> filter;
+};
+
+/// Remote dynamic filters of a TableScan plan node.
+struct RemoteDynamicFiltersState {
+  /// Filters in the order of arrival. Only appended to, so that a TableScan
+  /// can remember how many of them it has applied.
+  std::vector<RemoteDynamicFilter> filters;
+
+  /// Number of filters the scan waits for before reading its first split.
+  uint32_t numExpected{0};
+
+  /// Maximum time the scan waits for 'numExpected' filters before it reads
+  /// without them.
+  uint64_t maxWaitMs{0};
+
+  /// Time in ms since epoch at which the wait ends. Set when the first scan
+  /// starts waiting.
+  uint64_t waitUntilMs{0};
+
+  /// Promises given to the scans waiting for 'numExpected' filters.
+  std::vector<ContinuePromise> promises;
+};
+
 /// Stores local exchange queues with the memory manager.
 struct LocalExchangeState {
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager;
@@ -105,6 +143,19 @@ struct SplitGroupState {
   /// Map of local exchanges keyed on LocalPartition plan node ID.
   std::unordered_map<core::PlanNodeId, LocalExchangeState> localExchanges;
 
+  /// Leading key thresholds shared by the drivers of a TopN, keyed on TopN
+  /// plan node ID.
+  std::unordered_map<core::PlanNodeId, std::shared_ptr<TopNThreshold>>
+      topNThresholds;
+
+  /// The splits being read by the drivers of a TableScan whose unread part
+  /// other drivers can take over, keyed on TableScan plan node ID. Expired
+  /// entries are for splits that are done.
+  std::unordered_map<
+      core::PlanNodeId,
+      std::vector<std::weak_ptr<connector::StealableSplit>>>
+      stealableSplits;
+
   /// Drivers created and still running for this split group.
   /// The split group is finished when this numbers reaches zero.
   uint32_t numRunningDrivers{0};
@@ -130,6 +181,8 @@ struct SplitGroupState {
     localMergeSources.clear();
     mergeJoinSources.clear();
     localExchanges.clear();
+    topNThresholds.clear();
+    stealableSplits.clear();
   }
 };
 
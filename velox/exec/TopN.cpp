@@ -16,10 +16,23 @@
 #include <folly/container/F14Map.h>
 
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/Task.h"
 #include "velox/exec/TopN.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Returns true if 'node' is a table scan under zero or more filters and
+// projections.
+bool isScanUnderFilterProject(const core::PlanNode* node) {
+  while (dynamic_cast<const core::FilterNode*>(node) != nullptr ||
+         dynamic_cast<const core::ProjectNode*>(node) != nullptr) {
+    node = node->sources()[0].get();
+  }
+  return dynamic_cast<const core::TableScanNode*>(node) != nullptr;
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -55,10 +68,55 @@ TopN::TopN(
       }
     }
   }
+  filter_ = TopNFilter::create(
+      outputType_->childAt(sortingKeyColumns_[0]),
+      data_->columnAt(sortingKeyColumns_[0]),
+      topNNode->sortingOrders()[0]);
+  if (filter_ != nullptr && count_ > 0) {
+    sharedThreshold_ = driverCtx->task->getOrAddTopNThreshold(
+        driverCtx->splitGroupId,
+        planNodeId(),
+        topNNode->sortingOrders()[0].isAscending());
+    pushdownThreshold_ = isScanUnderFilterProject(topNNode->sources()[0].get());
+  }
 }
 
 void TopN::addInput(RowVectorPtr input) {
-  for (const auto col : sortingKeyColumns_) {
+  const auto numInput = input->size();
+  const auto leadingKeyColumn = sortingKeyColumns_[0];
+  decodedVectors_[leadingKeyColumn].decode(*input->childAt(leadingKeyColumn));
+
+  // Once the heap of any driver is full, drop the rows that lose to its top
+  // row on the leading key before decoding the other keys. The shared
+  // threshold is at least as tight as the top row of this driver unless the
+  // leading key of that row is null.
+  vector_size_t numRows = numInput;
+  const vector_size_t* rows = nullptr;
+  if (filter_ != nullptr && count_ > 0) {
+    const auto threshold = sharedThreshold_->get();
+    if (threshold.has_value() || topRows_.size() == count_) {
+      candidateRows_.resize(numInput);
+      numRows = threshold.has_value()
+          ? filter_->filter(
+                decodedVectors_[leadingKeyColumn],
+                numInput,
+                threshold.value(),
+                candidateRows_.data())
+          : filter_->filter(
+                decodedVectors_[leadingKeyColumn],
+                numInput,
+                topRows_.top(),
+                candidateRows_.data());
+      if (numRows == 0) {
+        updateThreshold();
+        return;
+      }
+      rows = candidateRows_.data();
+    }
+  }
+
+  for (auto i = 1; i < sortingKeyColumns_.size(); ++i) {
+    const auto col = sortingKeyColumns_[i];
     decodedVectors_[col].decode(*input->childAt(col));
   }
 
@@ -66,7 +124,8 @@ void TopN::addInput(RowVectorPtr input) {
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
-  for (auto row = 0; row < input->size(); ++row) {
+  for (auto i = 0; i < numRows; ++i) {
+    const auto row = rows != nullptr ? rows[i] : i;
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -104,6 +163,38 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+  updateThreshold();
+}
+
+void TopN::updateThreshold() {
+  if (sharedThreshold_ == nullptr) {
+    return;
+  }
+  if (topRows_.size() == count_) {
+    const auto topKey = filter_->leadingKey(topRows_.top());
+    if (topKey.has_value()) {
+      sharedThreshold_->update(topKey.value());
+    }
+  }
+
+  if (!pushdownThreshold_) {
+    return;
+  }
+  const auto threshold = sharedThreshold_->get();
+  if (!threshold.has_value() || threshold == pushedThreshold_) {
+    return;
+  }
+  if (!pushdownChecked_) {
+    pushdownChecked_ = true;
+    auto* driver = operatorCtx_->driverCtx()->driver;
+    pushdownThreshold_ = driver != nullptr &&
+        !driver->canPushdownFilters(this, {sortingKeyColumns_[0]}).empty();
+    if (!pushdownThreshold_) {
+      return;
+    }
+  }
+  dynamicFilters_[sortingKeyColumns_[0]] = filter_->makeFilter(*threshold);
+  pushedThreshold_ = threshold;
 }
 
 RowVectorPtr TopN::getOutput() {
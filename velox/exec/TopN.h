@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/TopNFilter.h"
 
 namespace facebook::velox::exec {
 
@@ -68,5 +69,32 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Drops input rows whose leading sorting key sorts after the one of the top
+  // row once 'topRows_' is full. Null if the leading key type is not
+  // supported.
+  std::unique_ptr<TopNFilter> filter_;
+  // Numbers of the input rows that passed 'filter_'.
+  std::vector<vector_size_t> candidateRows_;
+
+  // Publishes the leading key of the top row once 'topRows_' is full and
+  // pushes the tightest published key down to the table scan as a dynamic
+  // filter when it changes.
+  void updateThreshold();
+
+  // Leading key threshold shared with the TopN operators of the other
+  // drivers. Null if 'filter_' is null.
+  std::shared_ptr<TopNThreshold> sharedThreshold_;
+
+  // True if the leading key comes from a table scan through filters and
+  // projections only, so that the scan may drop the rows that do not pass
+  // the threshold. Set to false if the scan does not accept dynamic filters.
+  bool pushdownThreshold_{false};
+
+  // True once 'pushdownThreshold_' has been checked with the Driver.
+  bool pushdownChecked_{false};
+
+  // The threshold last pushed down to the table scan.
+  std::optional<int64_t> pushedThreshold_;
 };
 } // namespace facebook::velox::exec
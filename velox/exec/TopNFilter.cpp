@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/TopNFilter.h"
+
+#include <numeric>
+
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+vector_size_t selectAll(vector_size_t numRows, vector_size_t* rows) {
+  std::iota(rows, rows + numRows, 0);
+  return numRows;
+}
+} // namespace
+
+// static
+std::unique_ptr<TopNFilter> TopNFilter::create(
+    const TypePtr& type,
+    RowColumn column,
+    const core::SortOrder& sortOrder) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return std::make_unique<TopNFilter>(type->kind(), column, sortOrder);
+    default:
+      return nullptr;
+  }
+}
+
+vector_size_t TopNFilter::filter(
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    const char* topRow,
+    vector_size_t* rows) const {
+  if (RowContainer::isNullAt(topRow, column_)) {
+    if (!sortOrder_.isNullsFirst()) {
+      // Every row sorts before or ties with a null that sorts last.
+      return selectAll(numRows, rows);
+    }
+    // Only nulls may tie with a null that sorts first.
+    vector_size_t numPassed = 0;
+    if (decoded.mayHaveNulls()) {
+      for (auto row = 0; row < numRows; ++row) {
+        if (decoded.isNullAt(row)) {
+          rows[numPassed++] = row;
+        }
+      }
+    }
+    return numPassed;
+  }
+
+  switch (kind_) {
+    case TypeKind::TINYINT:
+      return filter<int8_t>(
+          decoded,
+          numRows,
+          *reinterpret_cast<const int8_t*>(topRow + column_.offset()),
+          rows);
+    case TypeKind::SMALLINT:
+      return filter<int16_t>(
+          decoded,
+          numRows,
+          *reinterpret_cast<const int16_t*>(topRow + column_.offset()),
+          rows);
+    case TypeKind::INTEGER:
+      return filter<int32_t>(
+          decoded,
+          numRows,
+          *reinterpret_cast<const int32_t*>(topRow + column_.offset()),
+          rows);
+    case TypeKind::BIGINT:
+      return filter<int64_t>(
+          decoded,
+          numRows,
+          *reinterpret_cast<const int64_t*>(topRow + column_.offset()),
+          rows);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+vector_size_t TopNFilter::filter(
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    int64_t threshold,
+    vector_size_t* rows) const {
+  switch (kind_) {
+    case TypeKind::TINYINT:
+      return filter<int8_t>(decoded, numRows, threshold, rows);
+    case TypeKind::SMALLINT:
+      return filter<int16_t>(decoded, numRows, threshold, rows);
+    case TypeKind::INTEGER:
+      return filter<int32_t>(decoded, numRows, threshold, rows);
+    case TypeKind::BIGINT:
+      return filter<int64_t>(decoded, numRows, threshold, rows);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+std::optional<int64_t> TopNFilter::leadingKey(const char* row) const {
+  if (RowContainer::isNullAt(row, column_)) {
+    return std::nullopt;
+  }
+  const auto* key = row + column_.offset();
+  switch (kind_) {
+    case TypeKind::TINYINT:
+      return *reinterpret_cast<const int8_t*>(key);
+    case TypeKind::SMALLINT:
+      return *reinterpret_cast<const int16_t*>(key);
+    case TypeKind::INTEGER:
+      return *reinterpret_cast<const int32_t*>(key);
+    case TypeKind::BIGINT:
+      return *reinterpret_cast<const int64_t*>(key);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+std::shared_ptr<common::Filter> TopNFilter::makeFilter(
+    int64_t threshold) const {
+  const bool nullAllowed = sortOrder_.isNullsFirst();
+  if (sortOrder_.isAscending()) {
+    return std::make_shared<common::BigintRange>(
+        std::numeric_limits<int64_t>::min(), threshold, nullAllowed);
+  }
+  return std::make_shared<common::BigintRange>(
+      threshold, std::numeric_limits<int64_t>::max(), nullAllowed);
+}
+
+template <typename T>
+vector_size_t TopNFilter::filter(
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    T threshold,
+    vector_size_t* rows) const {
+  const bool ascending = sortOrder_.isAscending();
+  const bool nullsFirst = sortOrder_.isNullsFirst();
+  auto passes = [&](T value) {
+    return ascending ? value <= threshold : value >= threshold;
+  };
+
+  if (decoded.isConstantMapping()) {
+    const bool passed =
+        decoded.isNullAt(0) ? nullsFirst : passes(decoded.valueAt<T>(0));
+    return passed ? selectAll(numRows, rows) : 0;
+  }
+
+  vector_size_t numPassed = 0;
+  if (!decoded.isIdentityMapping() || decoded.mayHaveNulls()) {
+    for (auto row = 0; row < numRows; ++row) {
+      if (decoded.isNullAt(row) ? nullsFirst
+                                : passes(decoded.valueAt<T>(row))) {
+        rows[numPassed++] = row;
+      }
+    }
+    return numPassed;
+  }
+
+  using Batch = xsimd::batch<T>;
+  const auto* data = decoded.data<T>();
+  const auto thresholds = Batch::broadcast(threshold);
+  vector_size_t row = 0;
+  for (; row + Batch::size <= numRows; row += Batch::size) {
+    const auto values = Batch::load_unaligned(data + row);
+    uint64_t mask = ascending ? simd::toBitMask(values <= thresholds)
+                              : simd::toBitMask(values >= thresholds);
+    while (mask) {
+      rows[numPassed++] = row + __builtin_ctzll(mask);
+      mask &= mask - 1;
+    }
+  }
+  for (; row < numRows; ++row) {
+    if (passes(data[row])) {
+      rows[numPassed++] = row;
+    }
+  }
+  return numPassed;
+}
+
+void TopNThreshold::update(int64_t value) {
+  auto current = value_.load(std::memory_order_relaxed);
+  while (ascending_ ? value < current : value > current) {
+    if (value_.compare_exchange_weak(current, value)) {
+      break;
+    }
+  }
+  hasValue_.store(true, std::memory_order_release);
+}
+
+} // namespace facebook::velox::exec
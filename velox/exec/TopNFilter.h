@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <optional>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/RowContainer.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::exec {
+
+/// Prepass for TopN and TopNRowNumber. Once a top-N heap is full, a new row
+/// enters it only if it sorts before the row at the top of the heap. The
+/// filter checks this for the leading sorting key of a whole batch at once and
+/// drops the rows whose leading key sorts strictly after the leading key of
+/// the top row. The remaining rows still need a full comparison with the top
+/// row since they may tie on the leading key. Flat leading keys without nulls
+/// are compared with SIMD.
+class TopNFilter {
+ public:
+  /// Returns a filter for a leading key of 'type' stored in 'column' of the
+  /// heap rows, or nullptr if the type is not supported. Only integer types
+  /// are supported.
+  static std::unique_ptr<TopNFilter> create(
+      const TypePtr& type,
+      RowColumn column,
+      const core::SortOrder& sortOrder);
+
+  TopNFilter(TypeKind kind, RowColumn column, const core::SortOrder& sortOrder)
+      : kind_(kind), column_(column), sortOrder_(sortOrder) {}
+
+  /// Stores in 'rows' the numbers of the rows in [0, numRows) of 'decoded'
+  /// that may sort before 'topRow'. Returns the number of stored rows.
+  vector_size_t filter(
+      const DecodedVector& decoded,
+      vector_size_t numRows,
+      const char* topRow,
+      vector_size_t* rows) const;
+
+  /// Same as above for a top row whose leading key is 'threshold'.
+  vector_size_t filter(
+      const DecodedVector& decoded,
+      vector_size_t numRows,
+      int64_t threshold,
+      vector_size_t* rows) const;
+
+  /// Returns the leading key of 'row' or std::nullopt if it is null.
+  std::optional<int64_t> leadingKey(const char* row) const;
+
+  /// Returns a filter on the leading key that passes the values that may sort
+  /// before or tie with 'threshold'.
+  std::shared_ptr<common::Filter> makeFilter(int64_t threshold) const;
+
+ private:
+  template <typename T>
+  vector_size_t filter(
+      const DecodedVector& decoded,
+      vector_size_t numRows,
+      T threshold,
+      vector_size_t* rows) const;
+
+  const TypeKind kind_;
+  const RowColumn column_;
+  const core::SortOrder sortOrder_;
+};
+
+/// Leading key threshold shared by the TopN operators of all the drivers of a
+/// pipeline. Once the heap of one driver is full, no row whose leading key
+/// sorts strictly after the leading key of its top row is in the top N of the
+/// pipeline. Each driver publishes the leading key of its top row and filters
+/// its input by the tightest key published by any driver.
+class TopNThreshold {
+ public:
+  explicit TopNThreshold(bool ascending)
+      : ascending_(ascending),
+        value_(
+            ascending ? std::numeric_limits<int64_t>::max()
+                      : std::numeric_limits<int64_t>::min()) {}
+
+  /// Sets the threshold to 'value' if 'value' sorts before the threshold.
+  void update(int64_t value);
+
+  /// Returns the threshold or std::nullopt if no driver has published one.
+  std::optional<int64_t> get() const {
+    if (!hasValue_.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    return value_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const bool ascending_;
+  std::atomic<bool> hasValue_{false};
+  std::atomic<int64_t> value_;
+};
+
+} // namespace facebook::velox::exec
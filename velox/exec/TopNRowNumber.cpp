@@ -168,6 +168,8 @@ TopNRowNumber::TopNRowNumber(
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
     singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    filter_ = TopNFilter::create(
+        inputType_->childAt(0), data_->columnAt(0), node->sortingOrders()[0]);
   }
 
   if (generateRowNumber_) {
@@ -218,6 +220,18 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
       outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
       outputRows_.resize(outputBatchSize_);
     }
+  } else if (
+      filter_ != nullptr && limit_ > 0 &&
+      singlePartition_->rows.size() == limit_) {
+    candidateRows_.resize(numInput);
+    const auto numRows = filter_->filter(
+        decodedVectors_[0],
+        numInput,
+        singlePartition_->rows.top(),
+        candidateRows_.data());
+    for (auto i = 0; i < numRows; ++i) {
+      processInputRow(candidateRows_[i], *singlePartition_);
+    }
   } else {
     for (auto i = 0; i < numInput; ++i) {
       processInputRow(i, *singlePartition_);
@@ -290,7 +304,7 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        *spillConfig_, pool(), &spillStats_);
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/TopNFilter.h"
 
 namespace facebook::velox::exec {
 
@@ -186,6 +187,13 @@ class TopNRowNumber : public Operator {
   std::unique_ptr<HashStringAllocator> allocator_;
   std::unique_ptr<TopRows> singlePartition_;
 
+  // Drops input rows that lose to the top row of a full 'singlePartition_' on
+  // the leading sorting key. Null if there are partitioning keys or the
+  // leading key type is not supported.
+  std::unique_ptr<TopNFilter> filter_;
+  // Numbers of the input rows that passed 'filter_'.
+  std::vector<vector_size_t> candidateRows_;
+
   // Stores input data. For each partition, only up to 'limit_' rows are stored.
   // Order of columns matches 'inputChannels_': partition keys, sorting keys,
   // the rest.
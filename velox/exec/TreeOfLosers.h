@@ -151,6 +151,30 @@ class TreeOfLosers {
         : std::make_pair(streams_[lastIndex_].get(), result.second);
   }
 
+  /// Returns the stream with the lowest first element among the streams other
+  /// than the one last returned by next(), or nullptr if there is no such
+  /// stream with data. This is the lowest of the losers on the path from the
+  /// last returned stream to the root. The caller may take elements from the
+  /// last returned stream for as long as these are not greater than the
+  /// first element of the returned stream before calling next() again.
+  Stream* runnerUp() const {
+    if (values_.empty() || lastIndex_ == kEmpty) {
+      return nullptr;
+    }
+    TIndex lowest = kEmpty;
+    for (auto node = parent(firstStream_ + lastIndex_);; node = parent(node)) {
+      const auto value = values_[node];
+      if (value != kEmpty &&
+          (lowest == kEmpty || *streams_[value] < *streams_[lowest])) {
+        lowest = value;
+      }
+      if (node == 0) {
+        break;
+      }
+    }
+    return lowest == kEmpty ? nullptr : streams_[lowest].get();
+  }
+
  private:
   static constexpr TIndex kEmpty = std::numeric_limits<TIndex>::max();
 
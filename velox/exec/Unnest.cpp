@@ -114,13 +114,22 @@ RowVectorPtr Unnest::getOutput() {
   const auto maxOutputSize = outputBatchRows();
 
   // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
+  // 'maxOutputSize'. The output of a row with more elements than fit in the
+  // batch continues in the next batch, so that large arrays or maps do not
+  // produce huge batches.
+  RowRange range{nextInputRow_, 0, nextInputRowStart_, 0};
   vector_size_t numElements = 0;
   for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
+    const auto rowStart = row == nextInputRow_ ? nextInputRowStart_ : 0;
+    const auto rowSize = rawMaxSizes_[row] - rowStart;
+    ++range.size;
+    if (numElements + rowSize > maxOutputSize) {
+      range.lastRowEnd = rowStart + (maxOutputSize - numElements);
+      numElements = maxOutputSize;
+      break;
+    }
+    numElements += rowSize;
+    range.lastRowEnd = rawMaxSizes_[row];
 
     if (numElements >= maxOutputSize) {
       break;
@@ -131,12 +140,20 @@ RowVectorPtr Unnest::getOutput() {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextInputRowStart_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(range, numElements);
 
-  nextInputRow_ += numInput;
+  const auto lastRow = range.start + range.size - 1;
+  if (range.lastRowEnd < rawMaxSizes_[lastRow]) {
+    nextInputRow_ = lastRow;
+    nextInputRowStart_ = range.lastRowEnd;
+  } else {
+    nextInputRow_ = lastRow + 1;
+    nextInputRowStart_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -147,20 +164,29 @@ RowVectorPtr Unnest::getOutput() {
 }
 
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements,
     std::vector<VectorPtr>& outputs) {
+  if (range.size == 1) {
+    // All output rows repeat the same input row, e.g. for a large array whose
+    // output is split across batches.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          numElements, range.start, input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    for (auto i = begin; i < end; ++i) {
       rawRepeatedIndices[index++] = row;
     }
-  }
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
@@ -174,55 +200,70 @@ void Unnest::generateRepeatedColumns(
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
+  auto& currentDecoded = unnestDecoded_[channel];
+  auto* currentSizes = rawSizes_[channel];
+  auto* currentOffsets = rawOffsets_[channel];
+  auto* currentIndices = rawIndices_[channel];
+
+  // The elements are contiguous in the base if consecutive rows have adjacent
+  // elements and no row needs padding with nulls.
+  bool contiguous = true;
+  std::optional<vector_size_t> sliceOffset;
+  vector_size_t nextOffset = 0;
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    if (!contiguous || begin == end) {
+      return;
+    }
+    if (currentDecoded.isNullAt(row) ||
+        currentSizes[currentIndices[row]] < end) {
+      contiguous = false;
+      return;
+    }
+    const auto offset = currentOffsets[currentIndices[row]];
+    if (!sliceOffset.has_value()) {
+      sliceOffset = offset + begin;
+    } else if (offset + begin != nextOffset) {
+      contiguous = false;
+      return;
+    }
+    nextOffset = offset + end;
+  });
+  if (contiguous) {
+    VELOX_CHECK(sliceOffset.has_value());
+    return {nullptr, nullptr, true, sliceOffset.value()};
+  }
+
   BufferPtr elementIndices = allocateIndices(numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
   auto nulls = allocateNulls(numElements, pool());
   auto rawNulls = nulls->asMutable<uint64_t>();
 
-  auto& currentDecoded = unnestDecoded_[channel];
-  auto* currentSizes = rawSizes_[channel];
-  auto* currentOffsets = rawOffsets_[channel];
-  auto* currentIndices = rawIndices_[channel];
-
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
-  bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    vector_size_t offset = 0;
+    vector_size_t unnestSize = 0;
     if (!currentDecoded.isNullAt(row)) {
-      const auto offset = currentOffsets[currentIndices[row]];
-      const auto unnestSize = currentSizes[currentIndices[row]];
-
-      if (index != offset || unnestSize < maxSize) {
-        identityMapping = false;
-      }
-
-      for (auto i = 0; i < unnestSize; i++) {
-        rawElementIndices[index++] = offset + i;
-      }
-
-      for (auto i = unnestSize; i < maxSize; ++i) {
-        bits::setNull(rawNulls, index++, true);
-      }
-    } else if (maxSize > 0) {
-      identityMapping = false;
+      offset = currentOffsets[currentIndices[row]];
+      unnestSize = currentSizes[currentIndices[row]];
+    }
 
-      for (auto i = 0; i < maxSize; ++i) {
-        bits::setNull(rawNulls, index++, true);
-      }
+    auto i = begin;
+    for (; i < std::min(end, unnestSize); ++i) {
+      rawElementIndices[index++] = offset + i;
     }
-  }
-  return {elementIndices, nulls, identityMapping};
+    for (; i < end; ++i) {
+      bits::setNull(rawNulls, index++, true);
+    }
+  });
+  return {elementIndices, nulls, false, 0};
 }
 
 VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   auto ordinalityVector =
       BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
@@ -230,27 +271,25 @@ VectorPtr Unnest::generateOrdinalityVector(
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto* rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto begin, auto end) {
+    std::iota(rawOrdinality, rawOrdinality + end - begin, begin + 1);
+    rawOrdinality += end - begin;
+  });
 
   return ordinalityVector;
 }
 
 RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, numElements, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+        generateEncodingForChannel(channel, range, numElements);
 
     auto& currentDecoded = unnestDecoded_[channel];
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
@@ -272,7 +311,7 @@ RowVectorPtr Unnest::generateOutput(
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range, numElements);
   }
 
   return std::make_shared<RowVector>(
@@ -282,8 +321,11 @@ RowVectorPtr Unnest::generateOutput(
 VectorPtr Unnest::UnnestChannelEncoding::wrap(
     const VectorPtr& base,
     vector_size_t wrapSize) const {
-  if (identityMapping) {
-    return base;
+  if (contiguous) {
+    if (sliceOffset == 0 && wrapSize == base->size()) {
+      return base;
+    }
+    return base->slice(sliceOffset, wrapSize);
   }
 
   const auto result =
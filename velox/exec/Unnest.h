@@ -39,28 +39,54 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
+  // The input rows and elements to include in one output batch. The first and
+  // last rows may be covered in part when the output of a row with many
+  // elements is split across batches.
+  struct RowRange {
+    // First input row.
+    vector_size_t start;
+    // Number of input rows.
+    vector_size_t size;
+    // Index of the first element to include for the first row.
+    vector_size_t firstRowStart;
+    // Index past the last element to include for the last row.
+    vector_size_t lastRowEnd;
+
+    // Invokes 'func(row, begin, end)' for each row, where [begin, end) is the
+    // range of element indices to include for 'row'.
+    template <typename Func>
+    void forEachRow(const vector_size_t* rawMaxSizes, Func func) const {
+      const auto last = start + size - 1;
+      for (auto row = start; row <= last; ++row) {
+        func(
+            row,
+            row == start ? firstRowStart : 0,
+            row == last ? lastRowEnd : rawMaxSizes[row]);
+      }
+    }
+  };
+
+  // Generate output for 'range' of input rows.
   //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
+  // @param range Input rows and elements to include in the output.
   // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  RowVectorPtr generateOutput(const RowRange& range, vector_size_t outputSize);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
     BufferPtr indices;
     BufferPtr nulls;
-    bool identityMapping;
+    // True if the output elements are a contiguous range of the base elements
+    // starting at 'sliceOffset'. 'indices' and 'nulls' are not set and the
+    // output is a zero-copy slice of the base.
+    bool contiguous;
+    vector_size_t sliceOffset;
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
@@ -69,14 +95,12 @@ class Unnest : public Operator {
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements);
 
   // Invoked by generateOutput for the ordinality column.
   VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements);
 
   const bool withOrdinality_;
@@ -93,5 +117,9 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // Number of elements of 'nextInputRow_' produced by previous getOutput()
+  // calls. Non-zero when the output of a row is split across batches.
+  vector_size_t nextInputRowStart_{0};
 };
 } // namespace facebook::velox::exec
@@ -20,45 +20,43 @@ bool VectorHasher::tryMapToRangeSimd(
     const T* values,
     const SelectivityVector& rows,
     uint64_t* result) {
-  bool inRange = true;
+  // Checks all values before writing any id, so that 'result' is unchanged if
+  // some value is out of range. This matters when 'multiplier_' is not 1 and
+  // the ids are added to the ids of the previous keys.
   auto allLow = xsimd::broadcast<T>(min_);
   auto allHigh = xsimd::broadcast<T>(max_);
-  auto allOne = xsimd::broadcast<T>(1);
   vector_size_t row = rows.begin();
   constexpr int kWidth = xsimd::batch<T>::size;
   for (; row + kWidth <= rows.end(); row += kWidth) {
     auto data = xsimd::load_unaligned(values + row);
     int32_t gtMax = simd::toBitMask(data > allHigh);
     int32_t ltMin = simd::toBitMask(data < allLow);
-    // value - (low - 1) doesn't work when low is the lowest possible (e.g.
-    // std::numeric_limits<int64_t>::min())
-    if constexpr (sizeof(T) == sizeof(uint64_t)) {
-      (data - allLow + allOne).store_unaligned(result + row);
-    }
     if ((gtMax | ltMin) != 0) {
-      inRange = false;
-      break;
+      return false;
+    }
+  }
+  for (; row < rows.end(); row++) {
+    auto value = values[row];
+    if (value > max_ || value < min_) {
+      return false;
     }
   }
 
-  if (inRange) {
-    for (; row < rows.end(); row++) {
-      auto value = values[row];
-      if (value > max_ || value < min_) {
-        inRange = false;
-        break;
-      }
-      if constexpr (sizeof(T) == sizeof(uint64_t)) {
-        result[row] = value - min_ + 1;
-      }
+  // The ids are computed in unsigned arithmetic. value - (low - 1) doesn't work
+  // when low is the lowest possible (e.g. std::numeric_limits<int64_t>::min()).
+  // The loops have no branches and are vectorized by the compiler.
+  const uint64_t low = min_;
+  if (multiplier_ == 1) {
+    for (row = rows.begin(); row < rows.end(); row++) {
+      result[row] = static_cast<uint64_t>(values[row]) - low + 1;
     }
-    if constexpr (sizeof(T) != sizeof(uint64_t)) {
-      for (row = rows.begin(); row < rows.end(); row++) {
-        result[row] = values[row] - min_ + 1;
-      }
+  } else {
+    for (row = rows.begin(); row < rows.end(); row++) {
+      result[row] +=
+          multiplier_ * (static_cast<uint64_t>(values[row]) - low + 1);
     }
   }
-  return inRange;
+  return true;
 }
 
 } // namespace facebook::velox::exec
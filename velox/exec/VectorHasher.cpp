@@ -85,22 +85,31 @@ void VectorHasher::hashValues(
     });
   } else if (
       !decoded_.isIdentityMapping() &&
-      rows.countSelected() > decoded_.base()->size()) {
-    cachedHashes_.resize(decoded_.base()->size());
-    std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
+      (dictionaryReused_ || rows.countSelected() > decoded_.base()->size())) {
+    // The hashes of a dictionary seen in a previous batch are kept for the
+    // next batches.
+    auto& hashes = dictionaryReused_ ? dictionaryHashes_ : cachedHashes_;
+    if (!dictionaryReused_ || hashes.size() != decoded_.base()->size()) {
+      hashes.resize(decoded_.base()->size());
+      std::fill(hashes.begin(), hashes.end(), kNullHash);
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
         return;
       }
       auto baseIndex = decoded_.index(row);
-      uint64_t hash = cachedHashes_[baseIndex];
+      uint64_t hash = hashes[baseIndex];
       if (hash == kNullHash) {
         hash = hashOne<Kind>(decoded_, row);
-        cachedHashes_[baseIndex] = hash;
+        hashes[baseIndex] = hash;
       }
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
+  } else if (
+      decoded_.isIdentityMapping() && !decoded_.mayHaveNulls() &&
+      std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+    hashFlatNoNulls<T>(rows, mix, result);
   } else {
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
@@ -113,6 +122,31 @@ void VectorHasher::hashValues(
   }
 }
 
+template <typename T>
+void VectorHasher::hashFlatNoNulls(
+    const SelectivityVector& rows,
+    bool mix,
+    uint64_t* result) {
+  if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+    // No null checks, no indirection and 'mix' hoisted out of the loop, so
+    // that the hashing of consecutive values is vectorized by the compiler
+    // when all rows are selected.
+    const auto* values = decoded_.data<T>();
+    if (mix) {
+      rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
+        result[row] =
+            bits::hashMix(result[row], folly::hasher<T>()(values[row]));
+      });
+    } else {
+      rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
+        result[row] = folly::hasher<T>()(values[row]);
+      });
+    }
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 template <TypeKind Kind>
 bool VectorHasher::makeValueIds(
     const SelectivityVector& rows,
@@ -141,6 +175,16 @@ bool VectorHasher::makeValueIds(
     }
   }
 
+  if constexpr (!std::is_same_v<T, bool>) {
+    if (dictionaryReused_) {
+      if (decoded_.mayHaveNulls()) {
+        return makeValueIdsCachedDictionary<T, true>(rows, result);
+      } else {
+        return makeValueIdsCachedDictionary<T, false>(rows, result);
+      }
+    }
+  }
+
   if (decoded_.mayHaveNulls()) {
     return makeValueIdsDecoded<T, true>(rows, result);
   } else {
@@ -302,6 +346,53 @@ bool VectorHasher::makeValueIdsDecoded(
   return success;
 }
 
+template <typename T, bool mayHaveNulls>
+bool VectorHasher::makeValueIdsCachedDictionary(
+    const SelectivityVector& rows,
+    uint64_t* result) {
+  auto indices = decoded_.indices();
+  auto values = decoded_.data<T>();
+  if (dictionaryIds_.size() != decoded_.base()->size()) {
+    dictionaryIds_.resize(decoded_.base()->size());
+    std::fill(dictionaryIds_.begin(), dictionaryIds_.end(), 0);
+  }
+
+  bool success = true;
+  rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
+    if constexpr (mayHaveNulls) {
+      if (decoded_.isNullAt(row)) {
+        if (multiplier_ == 1) {
+          result[row] = 0;
+        }
+        return;
+      }
+    }
+
+    auto baseIndex = indices[row];
+    uint64_t id = dictionaryIds_[baseIndex];
+    if (id == 0) {
+      // Unmappable entries are not cached. They are analyzed for each row
+      // until the mapping is changed to include them.
+      T value = values[baseIndex];
+      if (!success) {
+        analyzeValue(value);
+        return;
+      }
+      id = valueId(value);
+      if (id == kUnmappable) {
+        success = false;
+        analyzeValue(value);
+        return;
+      }
+      dictionaryIds_[baseIndex] = id;
+    }
+    if (success) {
+      result[row] = multiplier_ == 1 ? id : result[row] + multiplier_ * id;
+    }
+  });
+  return success;
+}
+
 template <>
 bool VectorHasher::makeValueIdsDecoded<bool, true>(
     const SelectivityVector& rows,
@@ -534,6 +625,30 @@ void VectorHasher::lookupValueIds(
       result.data());
 }
 
+void VectorHasher::trackDictionary(const BaseVector& vector) {
+  const auto* loaded = vector.loadedVector();
+  if (decoded_.isIdentityMapping() || decoded_.isConstantMapping() ||
+      loaded->encoding() != VectorEncoding::Simple::DICTIONARY ||
+      loaded->valueVector().get() != decoded_.base()) {
+    dictionaryReused_ = false;
+    if (dictionary_ != nullptr) {
+      dictionary_.reset();
+      dictionaryHashes_.clear();
+      dictionaryIds_.clear();
+    }
+    return;
+  }
+  const auto& base = loaded->valueVector();
+  if (dictionary_ == base) {
+    dictionaryReused_ = true;
+    return;
+  }
+  dictionary_ = base;
+  dictionaryReused_ = false;
+  dictionaryHashes_.clear();
+  dictionaryIds_.clear();
+}
+
 void VectorHasher::hash(
     const SelectivityVector& rows,
     bool mix,
@@ -787,6 +902,7 @@ uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
       typeKind_,
       TypeKind::BOOLEAN,
       "A boolean VectorHasher should  always be by range");
+  dictionaryIds_.clear();
   multiplier_ = multiplier;
   rangeSize_ = addIdReserve(uniqueValues_.size(), reservePct) + 1;
   isRange_ = false;
@@ -800,6 +916,7 @@ uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
 uint64_t VectorHasher::enableValueRange(
     uint64_t multiplier,
     int32_t reservePct) {
+  dictionaryIds_.clear();
   multiplier_ = multiplier;
   VELOX_CHECK_LE(0, reservePct);
   VELOX_CHECK(hasRange_);
@@ -819,6 +936,7 @@ uint64_t VectorHasher::enableValueRange(
 }
 
 void VectorHasher::copyStatsFrom(const VectorHasher& other) {
+  dictionaryIds_.clear();
   hasRange_ = other.hasRange_;
   rangeOverflow_ = other.rangeOverflow_;
   distinctOverflow_ = other.distinctOverflow_;
@@ -829,6 +947,7 @@ void VectorHasher::copyStatsFrom(const VectorHasher& other) {
 }
 
 void VectorHasher::merge(const VectorHasher& other) {
+  dictionaryIds_.clear();
   if (typeKind_ == TypeKind::BOOLEAN) {
     return;
   }
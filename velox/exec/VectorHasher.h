@@ -171,6 +171,7 @@ class VectorHasher {
         type_->toString(),
         vector.type()->toString());
     decoded_.decode(vector, rows);
+    trackDictionary(vector);
   }
 
   DecodedVector& decodedVector() {
@@ -247,6 +248,7 @@ class VectorHasher {
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
+    dictionaryIds_.clear();
   }
 
   // Sets 'this' to range mode and adds 'reservePct' values to the
@@ -358,6 +360,13 @@ class VectorHasher {
   template <typename T, bool mayHaveNulls>
   bool makeValueIdsDecoded(const SelectivityVector& rows, uint64_t* result);
 
+  // Makes value ids for a dictionary seen in a previous batch, reusing the
+  // ids of the dictionary entries mapped by previous batches.
+  template <typename T, bool mayHaveNulls>
+  bool makeValueIdsCachedDictionary(
+      const SelectivityVector& rows,
+      uint64_t* result);
+
   template <TypeKind Kind>
   bool makeValueIdsForRows(
       char** groups,
@@ -451,7 +460,7 @@ class VectorHasher {
     if constexpr (
         std::is_same_v<T, std::int64_t> || std::is_same_v<T, std::int32_t> ||
         std::is_same_v<T, std::int16_t>) {
-      if (rows.isAllSelected() && multiplier_ == 1) {
+      if (rows.isAllSelected()) {
         return tryMapToRangeSimd(values, rows, result);
       }
     }
@@ -540,9 +549,19 @@ class VectorHasher {
     return *reinterpret_cast<const T*>(group + offset);
   }
 
+  // Sets 'dictionaryReused_' if 'vector' is a dictionary over the same base
+  // as the dictionary decoded by the previous call. Otherwise, releases the
+  // previous dictionary and forgets the hashes and ids of its entries.
+  void trackDictionary(const BaseVector& vector);
+
   template <TypeKind Kind>
   void hashValues(const SelectivityVector& rows, bool mix, uint64_t* result);
 
+  // Hashes flat integer values without nulls.
+  template <typename T>
+  void
+  hashFlatNoNulls(const SelectivityVector& rows, bool mix, uint64_t* result);
+
   const column_index_t channel_;
   const TypePtr type_;
   const TypeKind typeKind_;
@@ -550,6 +569,24 @@ class VectorHasher {
   DecodedVector decoded_;
   raw_vector<uint64_t> cachedHashes_;
 
+  // Base of the last decoded dictionary. Readers return consecutive batches
+  // of a dictionary encoded column as dictionaries over the same stripe or
+  // row group dictionary, so that the hashes and value ids of its entries can
+  // be computed once for all the batches. This is a strong reference so that
+  // the reader cannot reuse the vector in place for a different dictionary.
+  VectorPtr dictionary_;
+
+  // True if 'decoded_' is a dictionary over 'dictionary_' and 'dictionary_'
+  // was also decoded by a previous call.
+  bool dictionaryReused_{false};
+
+  // Hashes of the entries of 'dictionary_', kNullHash if not computed yet.
+  raw_vector<uint64_t> dictionaryHashes_;
+
+  // Value ids of the entries of 'dictionary_', 0 if not computed yet. Cleared
+  // when the mapping of values to ids changes.
+  raw_vector<uint64_t> dictionaryIds_;
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
@@ -35,9 +35,9 @@ Window::Window(
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       numInputColumns_(windowNode->inputType()->size()),
-      windowNode_(windowNode),
-      currentPartition_(nullptr),
-      stringAllocator_(pool()) {
+      parallelism_(
+          std::max<uint32_t>(1, driverCtx->queryConfig().windowParallelism())),
+      windowNode_(windowNode) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (windowNode->inputsSorted()) {
@@ -45,7 +45,12 @@ Window::Window(
         windowNode, pool(), spillConfig, &nonReclaimableSection_);
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        driverCtx->prefixSortConfig(),
+        &spillStats_);
   }
 }
 
@@ -53,7 +58,13 @@ void Window::initialize() {
   Operator::initialize();
   VELOX_CHECK_NOT_NULL(windowNode_);
   createWindowFunctions();
-  createPeerAndFrameBuffers();
+  // TODO: This computation needs to be revised. It only takes into account
+  // the input columns size. We need to also account for the output columns.
+  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
+  evaluators_.push_back(createEvaluator());
+  if (canStreamRows(*windowNode_)) {
+    windowBuild_->enableRowStreaming(numRowsPerOutput_);
+  }
   windowNode_.reset();
 }
 
@@ -155,7 +166,7 @@ Window::WindowFrame Window::createWindowFrame(
 
 void Window::createWindowFunctions() {
   VELOX_CHECK_NOT_NULL(windowNode_);
-  VELOX_CHECK(windowFunctions_.empty());
+  VELOX_CHECK(windowFunctionSpecs_.empty());
   VELOX_CHECK(windowFrames_.empty());
 
   const auto& inputType = windowNode_->sources()[0]->outputType();
@@ -173,20 +184,120 @@ void Window::createWindowFunctions() {
       }
     }
 
-    windowFunctions_.push_back(WindowFunction::create(
-        windowNodeFunction.functionCall->name(),
-        functionArgs,
-        windowNodeFunction.functionCall->type(),
-        windowNodeFunction.ignoreNulls,
-        operatorCtx_->pool(),
-        &stringAllocator_,
-        operatorCtx_->driverCtx()->queryConfig()));
+    windowFunctionSpecs_.push_back(
+        {windowNodeFunction.functionCall->name(),
+         std::move(functionArgs),
+         windowNodeFunction.functionCall->type(),
+         windowNodeFunction.ignoreNulls});
 
     windowFrames_.push_back(
         createWindowFrame(windowNode_, windowNodeFunction.frame, inputType));
   }
 }
 
+std::unique_ptr<Window::Evaluator> Window::createEvaluator() {
+  auto evaluator = std::make_unique<Evaluator>();
+  evaluator->stringAllocator = std::make_unique<HashStringAllocator>(pool());
+
+  // Each evaluator reads k frame values into its own vectors.
+  auto copyFrameChannelArg = [&](const std::optional<FrameChannelArg>& arg)
+      -> std::optional<FrameChannelArg> {
+    if (!arg.has_value() || arg->value == nullptr) {
+      return arg;
+    }
+    return std::make_optional(FrameChannelArg{
+        arg->index,
+        BaseVector::create(arg->value->type(), 0, pool()),
+        arg->constant});
+  };
+
+  for (auto i = 0; i < windowFunctionSpecs_.size(); ++i) {
+    const auto& spec = windowFunctionSpecs_[i];
+    evaluator->windowFunctions.push_back(WindowFunction::create(
+        spec.name,
+        spec.args,
+        spec.resultType,
+        spec.ignoreNulls,
+        operatorCtx_->pool(),
+        evaluator->stringAllocator.get(),
+        operatorCtx_->driverCtx()->queryConfig()));
+
+    const auto& frame = windowFrames_[i];
+    evaluator->windowFrames.push_back(WindowFrame(
+        {frame.type,
+         frame.startType,
+         frame.endType,
+         copyFrameChannelArg(frame.start),
+         copyFrameChannelArg(frame.end)}));
+  }
+
+  createPeerAndFrameBuffers(*evaluator);
+  return evaluator;
+}
+
+bool Window::canStreamRows(const core::WindowNode& windowNode) {
+  // Without ORDER BY, all the rows of a partition are peers.
+  if (windowNode.sortingKeys().empty()) {
+    return false;
+  }
+
+  using RowAccess = WindowFunction::RowAccess;
+  int64_t maxPrecedingRows = 0;
+  int64_t maxFollowingRows = 0;
+  const auto& windowFunctions = evaluators_[0]->windowFunctions;
+  for (auto i = 0; i < windowFunctions.size(); ++i) {
+    const auto rowAccess = windowFunctions[i]->rowAccess();
+    if (rowAccess == RowAccess::kPartition) {
+      return false;
+    }
+    if (rowAccess == RowAccess::kPeers) {
+      continue;
+    }
+
+    const auto& frame = windowFrames_[i];
+    // k RANGE frames search their bounds from the start or to the end of the
+    // partition.
+    if (frame.type == core::WindowNode::WindowType::kRange &&
+        (frame.start.has_value() || frame.end.has_value())) {
+      return false;
+    }
+    if (frame.startType == core::WindowNode::BoundType::kUnboundedFollowing ||
+        frame.endType == core::WindowNode::BoundType::kUnboundedFollowing) {
+      return false;
+    }
+    if (frame.startType == core::WindowNode::BoundType::kUnboundedPreceding &&
+        (rowAccess != RowAccess::kIncrementalFrame ||
+         frame.endType != core::WindowNode::BoundType::kCurrentRow)) {
+      return false;
+    }
+
+    auto addBound = [&](core::WindowNode::BoundType boundType,
+                        const std::optional<FrameChannelArg>& arg) {
+      if (boundType != core::WindowNode::BoundType::kPreceding &&
+          boundType != core::WindowNode::BoundType::kFollowing) {
+        return true;
+      }
+      if (!arg->constant.has_value()) {
+        return false;
+      }
+      if (boundType == core::WindowNode::BoundType::kPreceding) {
+        maxPrecedingRows = std::max(maxPrecedingRows, arg->constant.value());
+      } else {
+        maxFollowingRows = std::max(maxFollowingRows, arg->constant.value());
+      }
+      return true;
+    };
+    if (!addBound(frame.startType, frame.start) ||
+        !addBound(frame.endType, frame.end)) {
+      return false;
+    }
+  }
+
+  maxPrecedingRows_ = maxPrecedingRows;
+  maxFollowingRows_ = maxFollowingRows;
+  return true;
+}
+
 void Window::addInput(RowVectorPtr input) {
   windowBuild_->addInput(input);
   numRows_ += input->size();
@@ -211,29 +322,25 @@ void Window::reclaim(
   windowBuild_->spill();
 }
 
-void Window::createPeerAndFrameBuffers() {
-  // TODO: This computation needs to be revised. It only takes into account
-  // the input columns size. We need to also account for the output columns.
-  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
-
-  peerStartBuffer_ = AlignedBuffer::allocate<vector_size_t>(
+void Window::createPeerAndFrameBuffers(Evaluator& evaluator) {
+  evaluator.peerStartBuffer = AlignedBuffer::allocate<vector_size_t>(
       numRowsPerOutput_, operatorCtx_->pool());
-  peerEndBuffer_ = AlignedBuffer::allocate<vector_size_t>(
+  evaluator.peerEndBuffer = AlignedBuffer::allocate<vector_size_t>(
       numRowsPerOutput_, operatorCtx_->pool());
 
-  auto numFuncs = windowFunctions_.size();
-  frameStartBuffers_.reserve(numFuncs);
-  frameEndBuffers_.reserve(numFuncs);
-  validFrames_.reserve(numFuncs);
+  auto numFuncs = evaluator.windowFunctions.size();
+  evaluator.frameStartBuffers.reserve(numFuncs);
+  evaluator.frameEndBuffers.reserve(numFuncs);
+  evaluator.validFrames.reserve(numFuncs);
 
   for (auto i = 0; i < numFuncs; i++) {
     BufferPtr frameStartBuffer = AlignedBuffer::allocate<vector_size_t>(
         numRowsPerOutput_, operatorCtx_->pool());
     BufferPtr frameEndBuffer = AlignedBuffer::allocate<vector_size_t>(
         numRowsPerOutput_, operatorCtx_->pool());
-    frameStartBuffers_.push_back(frameStartBuffer);
-    frameEndBuffers_.push_back(frameEndBuffer);
-    validFrames_.push_back(SelectivityVector(numRowsPerOutput_));
+    evaluator.frameStartBuffers.push_back(frameStartBuffer);
+    evaluator.frameEndBuffers.push_back(frameEndBuffer);
+    evaluator.validFrames.push_back(SelectivityVector(numRowsPerOutput_));
   }
 }
 
@@ -242,15 +349,37 @@ void Window::noMoreInput() {
   windowBuild_->noMoreInput();
 }
 
-void Window::callResetPartition() {
-  partitionOffset_ = 0;
-  peerStartRow_ = 0;
-  peerEndRow_ = 0;
-  currentPartition_ = nullptr;
-  if (windowBuild_->hasNextPartition()) {
-    currentPartition_ = windowBuild_->nextPartition();
-    for (int i = 0; i < windowFunctions_.size(); i++) {
-      windowFunctions_[i]->resetPartition(currentPartition_.get());
+void Window::close() {
+  for (auto& groupOutput : groupOutputs_) {
+    if (groupOutput != nullptr) {
+      groupOutput->close();
+    }
+  }
+  groupOutputs_.clear();
+  Operator::close();
+}
+
+void Window::callResetPartition(Evaluator& evaluator) {
+  if (evaluator.currentPartition != nullptr &&
+      evaluator.currentPartition->partial()) {
+    evaluator.currentPartition->removeRowsBefore(
+        evaluator.currentPartition->numRows());
+  }
+  evaluator.partitionOffset = 0;
+  evaluator.peerStartRow = 0;
+  evaluator.peerEndRow = 0;
+  evaluator.currentPartition = nullptr;
+  if (evaluator.hasPartitionRange) {
+    if (evaluator.nextPartition < evaluator.endPartition) {
+      evaluator.currentPartition =
+          windowBuild_->partitionAt(evaluator.nextPartition++);
+    }
+  } else if (windowBuild_->hasNextPartition()) {
+    evaluator.currentPartition = windowBuild_->nextPartition();
+  }
+  if (evaluator.currentPartition != nullptr) {
+    for (auto& windowFunction : evaluator.windowFunctions) {
+      windowFunction->resetPartition(evaluator.currentPartition.get());
     }
   }
 }
@@ -297,6 +426,7 @@ void updateKRowsOffsetsColumn(
 } // namespace
 
 void Window::updateKRowsFrameBounds(
+    Evaluator& evaluator,
     bool isKPreceding,
     const FrameChannelArg& frameArg,
     vector_size_t startRow,
@@ -342,8 +472,8 @@ void Window::updateKRowsFrameBounds(
     }
     std::iota(rawFrameBounds, rawFrameBounds + numRows, startValue);
   } else {
-    currentPartition_->extractColumn(
-        frameArg.index, partitionOffset_, numRows, 0, frameArg.value);
+    evaluator.currentPartition->extractColumn(
+        frameArg.index, evaluator.partitionOffset, numRows, 0, frameArg.value);
     if (frameArg.value->typeKind() == TypeKind::INTEGER) {
       updateKRowsOffsetsColumn<int32_t>(
           isKPreceding, frameArg.value, startRow, numRows, rawFrameBounds);
@@ -355,6 +485,7 @@ void Window::updateKRowsFrameBounds(
 }
 
 void Window::updateFrameBounds(
+    Evaluator& evaluator,
     const WindowFrame& windowFrame,
     const bool isStartBound,
     const vector_size_t startRow,
@@ -364,7 +495,7 @@ void Window::updateFrameBounds(
     vector_size_t* rawFrameBounds) {
   auto windowType = windowFrame.type;
   auto boundType = isStartBound ? windowFrame.startType : windowFrame.endType;
-  auto frameArg = isStartBound ? windowFrame.start : windowFrame.end;
+  const auto& frameArg = isStartBound ? windowFrame.start : windowFrame.end;
 
   const vector_size_t* rawPeerBuffer =
       isStartBound ? rawPeerStarts : rawPeerEnds;
@@ -373,7 +504,8 @@ void Window::updateFrameBounds(
       std::fill_n(rawFrameBounds, numRows, 0);
       break;
     case core::WindowNode::BoundType::kUnboundedFollowing:
-      std::fill_n(rawFrameBounds, numRows, currentPartition_->numRows() - 1);
+      std::fill_n(
+          rawFrameBounds, numRows, evaluator.currentPartition->numRows() - 1);
       break;
     case core::WindowNode::BoundType::kCurrentRow: {
       if (windowType == core::WindowNode::WindowType::kRange) {
@@ -389,9 +521,14 @@ void Window::updateFrameBounds(
     case core::WindowNode::BoundType::kPreceding: {
       if (windowType == core::WindowNode::WindowType::kRows) {
         updateKRowsFrameBounds(
-            true, frameArg.value(), startRow, numRows, rawFrameBounds);
+            evaluator,
+            true,
+            frameArg.value(),
+            startRow,
+            numRows,
+            rawFrameBounds);
       } else {
-        currentPartition_->computeKRangeFrameBounds(
+        evaluator.currentPartition->computeKRangeFrameBounds(
             isStartBound,
             true,
             frameArg.value().index,
@@ -405,9 +542,14 @@ void Window::updateFrameBounds(
     case core::WindowNode::BoundType::kFollowing: {
       if (windowType == core::WindowNode::WindowType::kRows) {
         updateKRowsFrameBounds(
-            false, frameArg.value(), startRow, numRows, rawFrameBounds);
+            evaluator,
+            false,
+            frameArg.value(),
+            startRow,
+            numRows,
+            rawFrameBounds);
       } else {
-        currentPartition_->computeKRangeFrameBounds(
+        evaluator.currentPartition->computeKRangeFrameBounds(
             isStartBound,
             false,
             frameArg.value().index,
@@ -459,41 +601,50 @@ void computeValidFrames(
 } // namespace
 
 void Window::computePeerAndFrameBuffers(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow) {
   vector_size_t numRows = endRow - startRow;
-  vector_size_t numFuncs = windowFunctions_.size();
+  vector_size_t numFuncs = evaluator.windowFunctions.size();
 
   // Size buffers for the call to WindowFunction::apply.
   auto bufferSize = numRows * sizeof(vector_size_t);
-  peerStartBuffer_->setSize(bufferSize);
-  peerEndBuffer_->setSize(bufferSize);
-  auto rawPeerStarts = peerStartBuffer_->asMutable<vector_size_t>();
-  auto rawPeerEnds = peerEndBuffer_->asMutable<vector_size_t>();
+  evaluator.peerStartBuffer->setSize(bufferSize);
+  evaluator.peerEndBuffer->setSize(bufferSize);
+  auto rawPeerStarts = evaluator.peerStartBuffer->asMutable<vector_size_t>();
+  auto rawPeerEnds = evaluator.peerEndBuffer->asMutable<vector_size_t>();
 
   std::vector<vector_size_t*> rawFrameStarts;
   std::vector<vector_size_t*> rawFrameEnds;
   rawFrameStarts.reserve(numFuncs);
   rawFrameEnds.reserve(numFuncs);
   for (auto w = 0; w < numFuncs; w++) {
-    frameStartBuffers_[w]->setSize(bufferSize);
-    frameEndBuffers_[w]->setSize(bufferSize);
+    evaluator.frameStartBuffers[w]->setSize(bufferSize);
+    evaluator.frameEndBuffers[w]->setSize(bufferSize);
 
-    auto rawFrameStart = frameStartBuffers_[w]->asMutable<vector_size_t>();
-    auto rawFrameEnd = frameEndBuffers_[w]->asMutable<vector_size_t>();
+    auto rawFrameStart =
+        evaluator.frameStartBuffers[w]->asMutable<vector_size_t>();
+    auto rawFrameEnd = evaluator.frameEndBuffers[w]->asMutable<vector_size_t>();
     rawFrameStarts.push_back(rawFrameStart);
     rawFrameEnds.push_back(rawFrameEnd);
   }
 
-  std::tie(peerStartRow_, peerEndRow_) = currentPartition_->computePeerBuffers(
-      startRow, endRow, peerStartRow_, peerEndRow_, rawPeerStarts, rawPeerEnds);
+  std::tie(evaluator.peerStartRow, evaluator.peerEndRow) =
+      evaluator.currentPartition->computePeerBuffers(
+          startRow,
+          endRow,
+          evaluator.peerStartRow,
+          evaluator.peerEndRow,
+          rawPeerStarts,
+          rawPeerEnds);
 
   for (auto i = 0; i < numFuncs; i++) {
-    const auto& windowFrame = windowFrames_[i];
+    const auto& windowFrame = evaluator.windowFrames[i];
     // Default all rows to have validFrames. The invalidity of frames is only
     // computed for k rows/range frames at a later point.
-    validFrames_[i].resizeFill(numRows, true);
+    evaluator.validFrames[i].resizeFill(numRows, true);
     updateFrameBounds(
+        evaluator,
         windowFrame,
         true,
         startRow,
@@ -502,6 +653,7 @@ void Window::computePeerAndFrameBuffers(
         rawPeerEnds,
         rawFrameStarts[i]);
     updateFrameBounds(
+        evaluator,
         windowFrame,
         false,
         startRow,
@@ -509,7 +661,7 @@ void Window::computePeerAndFrameBuffers(
         rawPeerStarts,
         rawPeerEnds,
         rawFrameEnds[i]);
-    if (windowFrames_[i].start || windowFrames_[i].end) {
+    if (windowFrame.start || windowFrame.end) {
       // k preceding and k following bounds can be problematic. They can
       // go over the partition limits or result in empty frames. Fix the
       // frame boundaries and compute the validFrames SelectivityVector
@@ -517,53 +669,83 @@ void Window::computePeerAndFrameBuffers(
       // Ranking functions do not care about frames. So the function decides
       // further what to do with empty frames.
       computeValidFrames(
-          currentPartition_->numRows() - 1,
+          evaluator.currentPartition->numRows() - 1,
           numRows,
           rawFrameStarts[i],
           rawFrameEnds[i],
-          validFrames_[i]);
+          evaluator.validFrames[i]);
     }
   }
 }
 
 void Window::getInputColumns(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
     const RowVectorPtr& result) {
   auto numRows = endRow - startRow;
   for (int i = 0; i < numInputColumns_; ++i) {
-    currentPartition_->extractColumn(
-        i, partitionOffset_, numRows, resultOffset, result->childAt(i));
+    evaluator.currentPartition->extractColumn(
+        i,
+        evaluator.partitionOffset,
+        numRows,
+        resultOffset,
+        result->childAt(i));
   }
 }
 
 void Window::callApplyForPartitionRows(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
     const RowVectorPtr& result) {
-  getInputColumns(startRow, endRow, resultOffset, result);
+  getInputColumns(evaluator, startRow, endRow, resultOffset, result);
 
-  computePeerAndFrameBuffers(startRow, endRow);
-  vector_size_t numFuncs = windowFunctions_.size();
+  computePeerAndFrameBuffers(evaluator, startRow, endRow);
+  vector_size_t numFuncs = evaluator.windowFunctions.size();
   for (auto w = 0; w < numFuncs; w++) {
-    windowFunctions_[w]->apply(
-        peerStartBuffer_,
-        peerEndBuffer_,
-        frameStartBuffers_[w],
-        frameEndBuffers_[w],
-        validFrames_[w],
+    evaluator.windowFunctions[w]->apply(
+        evaluator.peerStartBuffer,
+        evaluator.peerEndBuffer,
+        evaluator.frameStartBuffers[w],
+        evaluator.frameEndBuffers[w],
+        evaluator.validFrames[w],
         resultOffset,
         result->childAt(numInputColumns_ + w));
   }
 
-  vector_size_t numRows = endRow - startRow;
-  numProcessedRows_ += numRows;
-  partitionOffset_ += numRows;
+  evaluator.partitionOffset += endRow - startRow;
+}
+
+vector_size_t Window::numRowsForProcessing(const Evaluator& evaluator) const {
+  const auto& partition = *evaluator.currentPartition;
+  if (partition.complete()) {
+    return partition.numRows() - evaluator.partitionOffset;
+  }
+  if (partition.numRows() == partition.offsetInPartition()) {
+    return 0;
+  }
+  // The last peer group may continue in rows not added yet.
+  const int64_t endRow = std::min<int64_t>(
+      partition.lastPeerGroupStart(), partition.numRows() - maxFollowingRows_);
+  return std::max<int64_t>(0, endRow - evaluator.partitionOffset);
+}
+
+void Window::removeProcessedRows(Evaluator& evaluator) {
+  // The frames of the next rows start at most 'maxPrecedingRows_' rows before
+  // them, or at the start of their peer group, which is not before the peer
+  // group of the last computed row.
+  const int64_t firstNeededRow = std::min<int64_t>(
+      evaluator.partitionOffset - maxPrecedingRows_, evaluator.peerStartRow);
+  if (firstNeededRow > evaluator.currentPartition->offsetInPartition()) {
+    evaluator.currentPartition->removeRowsBefore(firstNeededRow);
+  }
 }
 
 vector_size_t Window::callApplyLoop(
+    Evaluator& evaluator,
     vector_size_t numOutputRows,
     const RowVectorPtr& result) {
   // Compute outputs by traversing as many partitions as possible. This
@@ -571,23 +753,48 @@ vector_size_t Window::callApplyLoop(
   vector_size_t resultIndex = 0;
   vector_size_t numOutputRowsLeft = numOutputRows;
 
-  // This function requires that the currentPartition_ is available for output.
-  VELOX_DCHECK_NOT_NULL(currentPartition_);
+  // This function requires that the currentPartition is available for output.
+  VELOX_DCHECK_NOT_NULL(evaluator.currentPartition);
   while (numOutputRowsLeft > 0) {
+    if (!evaluator.currentPartition->complete()) {
+      // A partial partition whose rows are still being added. Computes the
+      // rows that can be computed and releases the rows no longer needed.
+      auto numRows = numRowsForProcessing(evaluator);
+      if (numRows == 0) {
+        if (windowBuild_->loadMoreRows()) {
+          continue;
+        }
+        // More input is needed.
+        break;
+      }
+      numRows = std::min(numRows, numOutputRowsLeft);
+      callApplyForPartitionRows(
+          evaluator,
+          evaluator.partitionOffset,
+          evaluator.partitionOffset + numRows,
+          resultIndex,
+          result);
+      resultIndex += numRows;
+      numOutputRowsLeft -= numRows;
+      removeProcessedRows(evaluator);
+      continue;
+    }
+
     auto rowsForCurrentPartition =
-        currentPartition_->numRows() - partitionOffset_;
+        evaluator.currentPartition->numRows() - evaluator.partitionOffset;
     if (rowsForCurrentPartition <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
       callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + rowsForCurrentPartition,
+          evaluator,
+          evaluator.partitionOffset,
+          evaluator.partitionOffset + rowsForCurrentPartition,
           resultIndex,
           result);
       resultIndex += rowsForCurrentPartition;
       numOutputRowsLeft -= rowsForCurrentPartition;
-      callResetPartition();
-      if (!currentPartition_) {
+      callResetPartition(evaluator);
+      if (!evaluator.currentPartition) {
         // The WindowBuild doesn't have any more partitions to process right
         // now. So break until the next getOutput call.
         break;
@@ -597,8 +804,9 @@ vector_size_t Window::callApplyLoop(
       // Call apply for the rows that can fit in the buffer and break from
       // outputting.
       callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + numOutputRowsLeft,
+          evaluator,
+          evaluator.partitionOffset,
+          evaluator.partitionOffset + numOutputRowsLeft,
           resultIndex,
           result);
       numOutputRowsLeft = 0;
@@ -610,6 +818,109 @@ vector_size_t Window::callApplyLoop(
   return numOutputRows - numOutputRowsLeft;
 }
 
+bool Window::startParallelEvaluation() {
+  if (parallelEvaluationChecked_) {
+    return !partitionGroups_.empty();
+  }
+  parallelEvaluationChecked_ = true;
+  if (parallelism_ <= 1 || numProcessedRows_ > 0) {
+    return false;
+  }
+  auto* executor = operatorCtx_->task()->queryCtx()->executor();
+  if (executor == nullptr) {
+    return false;
+  }
+  const auto partitionSizes = windowBuild_->partitionSizes();
+  if (partitionSizes.size() < 2) {
+    return false;
+  }
+
+  // Groups contiguous partitions into tasks of at least an output batch. Aims
+  // at several tasks per thread to even out partitions of different sizes.
+  const vector_size_t targetGroupRows = std::max<vector_size_t>(
+      numRowsPerOutput_, numRows_ / (4 * parallelism_));
+  PartitionGroup group{0, 0, 0};
+  for (auto i = 0; i < partitionSizes.size(); ++i) {
+    group.numRows += partitionSizes[i];
+    group.end = i + 1;
+    if (group.numRows >= targetGroupRows) {
+      partitionGroups_.push_back(group);
+      group = {group.end, group.end, 0};
+    }
+  }
+  if (group.numRows > 0) {
+    partitionGroups_.push_back(group);
+  }
+  if (partitionGroups_.size() < 2) {
+    partitionGroups_.clear();
+    return false;
+  }
+
+  const auto numEvaluators =
+      std::min<size_t>(parallelism_, partitionGroups_.size());
+  while (evaluators_.size() < numEvaluators) {
+    evaluators_.push_back(createEvaluator());
+  }
+  groupOutputs_.resize(partitionGroups_.size());
+  for (auto i = 0; i < numEvaluators; ++i) {
+    scheduleGroup(i);
+  }
+  return true;
+}
+
+void Window::scheduleGroup(size_t group) {
+  if (group >= partitionGroups_.size()) {
+    return;
+  }
+  // Group 'group' reuses the evaluator of the group 'evaluators_.size()'
+  // before it, which has been consumed by the time this is called.
+  auto* evaluator = evaluators_[group % evaluators_.size()].get();
+  groupOutputs_[group] = std::make_shared<AsyncSource<GroupOutput>>(
+      [this, evaluator, partitionGroup = partitionGroups_[group]]() {
+        return evaluateGroup(*evaluator, partitionGroup);
+      });
+  operatorCtx_->task()->queryCtx()->executor()->add(
+      [source = groupOutputs_[group]]() { source->prepare(); });
+}
+
+std::unique_ptr<Window::GroupOutput> Window::evaluateGroup(
+    Evaluator& evaluator,
+    const PartitionGroup& group) {
+  evaluator.hasPartitionRange = true;
+  evaluator.nextPartition = group.begin;
+  evaluator.endPartition = group.end;
+  callResetPartition(evaluator);
+
+  auto output = std::make_unique<GroupOutput>();
+  auto numRowsLeft = group.numRows;
+  while (numRowsLeft > 0) {
+    auto numOutputRows = std::min(numRowsPerOutput_, numRowsLeft);
+    auto result = BaseVector::create<RowVector>(
+        outputType_, numOutputRows, operatorCtx_->pool());
+    auto numResultRows = callApplyLoop(evaluator, numOutputRows, result);
+    VELOX_CHECK_EQ(numResultRows, numOutputRows);
+    output->push_back(std::move(result));
+    numRowsLeft -= numResultRows;
+  }
+  return output;
+}
+
+RowVectorPtr Window::getParallelOutput() {
+  if (nextPendingOutput_ == pendingOutput_.size()) {
+    VELOX_CHECK_LT(nextGroup_, partitionGroups_.size());
+    auto output = groupOutputs_[nextGroup_]->move();
+    VELOX_CHECK_NOT_NULL(output);
+    groupOutputs_[nextGroup_] = nullptr;
+    scheduleGroup(nextGroup_ + evaluators_.size());
+    ++nextGroup_;
+    pendingOutput_ = std::move(*output);
+    nextPendingOutput_ = 0;
+  }
+  auto result = std::move(pendingOutput_[nextPendingOutput_++]);
+  numProcessedRows_ += result->size();
+  return result;
+}
+
 RowVectorPtr Window::getOutput() {
   if (numRows_ == 0) {
     return nullptr;
@@ -620,9 +931,14 @@ RowVectorPtr Window::getOutput() {
     return nullptr;
   }
 
-  if (!currentPartition_) {
-    callResetPartition();
-    if (!currentPartition_) {
+  if (noMoreInput_ && startParallelEvaluation()) {
+    return getParallelOutput();
+  }
+
+  auto& evaluator = *evaluators_[0];
+  if (!evaluator.currentPartition) {
+    callResetPartition(evaluator);
+    if (!evaluator.currentPartition) {
       // WindowBuild doesn't have a partition to output.
       return nullptr;
     }
@@ -633,7 +949,11 @@ RowVectorPtr Window::getOutput() {
       outputType_, numOutputRows, operatorCtx_->pool());
 
   // Compute the output values of window functions.
-  auto numResultRows = callApplyLoop(numOutputRows, result);
+  auto numResultRows = callApplyLoop(evaluator, numOutputRows, result);
+  numProcessedRows_ += numResultRows;
+  if (numResultRows == 0) {
+    return nullptr;
+  }
   return numResultRows < numOutputRows
       ? std::dynamic_pointer_cast<RowVector>(result->slice(0, numResultRows))
       : result;
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/WindowBuild.h"
@@ -67,6 +68,8 @@ class Window : public Operator {
   void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
       override;
 
+  void close() override;
+
  private:
   // Used for k preceding/following frames. Index is the column index if k is a
   // column. value is used to read column values from the column index when k
@@ -88,6 +91,92 @@ class Window : public Operator {
     const std::optional<FrameChannelArg> end;
   };
 
+  // Arguments to create a WindowFunction. Kept after 'windowNode_' is reset
+  // to create the functions of parallel evaluators.
+  struct WindowFunctionSpec {
+    std::string name;
+    std::vector<WindowFunctionArg> args;
+    TypePtr resultType;
+    bool ignoreNulls;
+  };
+
+  // The window functions and the state to compute them over a sequence of
+  // partitions. The driver thread uses the first evaluator. Parallel
+  // evaluation uses one evaluator per thread, each over its own range of
+  // partitions.
+  struct Evaluator {
+    // HashStringAllocator required by functions that allocate out of line
+    // buffers.
+    std::unique_ptr<HashStringAllocator> stringAllocator;
+
+    // Vector of WindowFunction objects. WindowFunction is the base API
+    // implemented by all the window functions. The functions are ordered by
+    // their positions in the output columns.
+    std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions;
+
+    // Vector of WindowFrames corresponding to each windowFunction above.
+    // It represents the frame spec for the function computation.
+    std::vector<WindowFrame> windowFrames;
+
+    // The following 4 Buffers are used to pass peer and frame start and
+    // end values to the WindowFunction::apply method. These
+    // buffers can be allocated once and reused across all the getOutput
+    // calls.
+    // Only a single peer start and peer end buffer is needed across all
+    // functions (as the peer values are based on the ORDER BY clause).
+    BufferPtr peerStartBuffer;
+    BufferPtr peerEndBuffer;
+    // A separate BufferPtr is required for the frame indexes of each
+    // function. Each function has its own frame clause and style. So we
+    // have as many buffers as the number of functions.
+    std::vector<BufferPtr> frameStartBuffers;
+    std::vector<BufferPtr> frameEndBuffers;
+
+    // Frame types for kPreceding or kFollowing could result in empty
+    // frames if the frameStart > frameEnds, or frameEnds < firstPartitionRow
+    // or frameStarts > lastPartitionRow. Such frames usually evaluate to NULL
+    // in the window function.
+    // This SelectivityVector captures the valid (non-empty) frames in the
+    // buffer being worked on. The window function can use this to compute
+    // output values.
+    // There is one SelectivityVector per window function.
+    std::vector<SelectivityVector> validFrames;
+
+    // Used to access window partition rows and columns by the window
+    // operator and functions. The rows are owned by the WindowBuild.
+    std::shared_ptr<WindowPartition> currentPartition;
+
+    // Tracks how far along the partition rows have been output.
+    vector_size_t partitionOffset = 0;
+
+    // When traversing input partition rows, the peers are the rows
+    // with the same values for the ORDER BY clause. These rows
+    // are equal in some ways and affect the results of ranking functions.
+    // Since all rows between the peerStartRow and peerEndRow have the same
+    // values for peerStartRow and peerEndRow, we needn't compute
+    // them for each row independently. Since these rows might
+    // cross getOutput boundaries and be called in subsequent calls to
+    // computePeerBuffers they are saved here.
+    vector_size_t peerStartRow = 0;
+    vector_size_t peerEndRow = 0;
+
+    // Set for parallel evaluation. The evaluator reads the partitions at
+    // [nextPartition, endPartition) with WindowBuild::partitionAt() instead
+    // of WindowBuild::nextPartition().
+    bool hasPartitionRange = false;
+    vector_size_t nextPartition = 0;
+    vector_size_t endPartition = 0;
+  };
+
+  // A range of contiguous partitions computed by one parallel task.
+  struct PartitionGroup {
+    vector_size_t begin;
+    vector_size_t end;
+    vector_size_t numRows;
+  };
+
+  using GroupOutput = std::vector<RowVectorPtr>;
+
   // Creates WindowFunction and frame objects for this operator.
   void createWindowFunctions();
 
@@ -97,16 +186,23 @@ class Window : public Operator {
       const core::WindowNode::Frame& frame,
       const RowTypePtr& inputType);
 
+  // Creates an Evaluator with its own window functions, frame scratch vectors
+  // and buffers.
+  std::unique_ptr<Evaluator> createEvaluator();
+
   // Creates the buffers for peer and frame row
   // indices to send in window function apply invocations.
-  void createPeerAndFrameBuffers();
+  void createPeerAndFrameBuffers(Evaluator& evaluator);
 
   // Compute the peer and frame buffers for rows between
   // startRow and endRow in the current partition.
-  void computePeerAndFrameBuffers(vector_size_t startRow, vector_size_t endRow);
+  void computePeerAndFrameBuffers(
+      Evaluator& evaluator,
+      vector_size_t startRow,
+      vector_size_t endRow);
 
   // Updates all the state for the next partition.
-  void callResetPartition();
+  void callResetPartition(Evaluator& evaluator);
 
   // Computes the result vector for a subset of the current
   // partition rows starting from startRow to endRow. A single partition
@@ -115,6 +211,7 @@ class Window : public Operator {
   // offset in the result vector corresponding to the current range of
   // partition rows.
   void callApplyForPartitionRows(
+      Evaluator& evaluator,
       vector_size_t startRow,
       vector_size_t endRow,
       vector_size_t resultOffset,
@@ -123,6 +220,7 @@ class Window : public Operator {
   // Gets the input columns of the current window partition
   // between startRow and endRow in result at resultOffset.
   void getInputColumns(
+      Evaluator& evaluator,
       vector_size_t startRow,
       vector_size_t endRow,
       vector_size_t resultOffset,
@@ -133,11 +231,13 @@ class Window : public Operator {
   // window function.
   // @return The number of rows processed in the loop.
   vector_size_t callApplyLoop(
+      Evaluator& evaluator,
       vector_size_t numOutputRows,
       const RowVectorPtr& result);
 
   // Update frame bounds for kPreceding, kFollowing row frames.
   void updateKRowsFrameBounds(
+      Evaluator& evaluator,
       bool isKPreceding,
       const FrameChannelArg& frameArg,
       vector_size_t startRow,
@@ -145,6 +245,7 @@ class Window : public Operator {
       vector_size_t* rawFrameBounds);
 
   void updateFrameBounds(
+      Evaluator& evaluator,
       const WindowFrame& windowFrame,
       const bool isStartBound,
       const vector_size_t startRow,
@@ -153,8 +254,43 @@ class Window : public Operator {
       const vector_size_t* rawPeerEnds,
       vector_size_t* rawFrameBounds);
 
+  // Returns true if all window functions can be computed over partial
+  // partitions. Sets 'maxPrecedingRows_' and 'maxFollowingRows_'.
+  bool canStreamRows(const core::WindowNode& windowNode);
+
+  // Returns the number of rows of the current partition of 'evaluator'
+  // starting at its 'partitionOffset' that can be computed with the rows in
+  // memory. For an incomplete partial partition, these are the rows whose
+  // peer groups and frames end before the last row added so far.
+  vector_size_t numRowsForProcessing(const Evaluator& evaluator) const;
+
+  // Removes the rows of a partial partition that the frames and peer groups
+  // of the next rows to compute cannot reach.
+  void removeProcessedRows(Evaluator& evaluator);
+
+  // Returns true if the partitions are computed in parallel. Groups the
+  // partitions and starts the first tasks on the first call after all input
+  // has been received. Returns false if 'parallelism_' is 1 or the
+  // WindowBuild cannot hand out partitions in any order.
+  bool startParallelEvaluation();
+
+  // Starts computing 'partitionGroups_[group]' on the executor if there is
+  // such a group.
+  void scheduleGroup(size_t group);
+
+  // Computes the output of the partitions in 'group' with 'evaluator'.
+  std::unique_ptr<GroupOutput> evaluateGroup(
+      Evaluator& evaluator,
+      const PartitionGroup& group);
+
+  // Returns the next output of parallel evaluation in partition order.
+  RowVectorPtr getParallelOutput();
+
   const vector_size_t numInputColumns_;
 
+  // Maximum number of threads that compute partitions in parallel.
+  const uint32_t parallelism_;
+
   // WindowBuild is used to store input rows and return WindowPartitions
   // for the processing.
   std::unique_ptr<WindowBuild> windowBuild_;
@@ -163,72 +299,48 @@ class Window : public Operator {
   // reset after the initialization.
   std::shared_ptr<const core::WindowNode> windowNode_;
 
-  // Used to access window partition rows and columns by the window
-  // operator and functions. This structure is owned by the WindowBuild.
-  std::unique_ptr<WindowPartition> currentPartition_;
+  std::vector<WindowFunctionSpec> windowFunctionSpecs_;
+
+  // The frames of the window functions. Each Evaluator has a copy with its
+  // own scratch vectors for k frame values.
+  std::vector<WindowFrame> windowFrames_;
 
-  // HashStringAllocator required by functions that allocate out of line
-  // buffers.
-  HashStringAllocator stringAllocator_;
+  // Evaluators. The first one computes the partitions on the driver thread.
+  // The others are created for parallel evaluation.
+  std::vector<std::unique_ptr<Evaluator>> evaluators_;
 
-  // Vector of WindowFunction objects required by this operator.
-  // WindowFunction is the base API implemented by all the window functions.
-  // The functions are ordered by their positions in the output columns.
-  std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions_;
+  // Contiguous partition ranges that are computed in parallel.
+  std::vector<PartitionGroup> partitionGroups_;
 
-  // Vector of WindowFrames corresponding to each windowFunction above.
-  // It represents the frame spec for the function computation.
-  std::vector<WindowFrame> windowFrames_;
+  // The pending outputs of 'partitionGroups_'. At most 'parallelism_' groups
+  // are in flight. An entry is reset after its output is returned.
+  std::vector<std::shared_ptr<AsyncSource<GroupOutput>>> groupOutputs_;
+
+  // Index of the group in 'partitionGroups_' whose output is returned next.
+  size_t nextGroup_ = 0;
 
-  // The following 4 Buffers are used to pass peer and frame start and
-  // end values to the WindowFunction::apply method. These
-  // buffers can be allocated once and reused across all the getOutput
-  // calls.
-  // Only a single peer start and peer end buffer is needed across all
-  // functions (as the peer values are based on the ORDER BY clause).
-  BufferPtr peerStartBuffer_;
-  BufferPtr peerEndBuffer_;
-  // A separate BufferPtr is required for the frame indexes of each
-  // function. Each function has its own frame clause and style. So we
-  // have as many buffers as the number of functions.
-  std::vector<BufferPtr> frameStartBuffers_;
-  std::vector<BufferPtr> frameEndBuffers_;
-
-  // Frame types for kPreceding or kFollowing could result in empty
-  // frames if the frameStart > frameEnds, or frameEnds < firstPartitionRow
-  // or frameStarts > lastPartitionRow. Such frames usually evaluate to NULL
-  // in the window function.
-  // This SelectivityVector captures the valid (non-empty) frames in the
-  // buffer being worked on. The window function can use this to compute
-  // output values.
-  // There is one SelectivityVector per window function.
-  std::vector<SelectivityVector> validFrames_;
+  // Output vectors of the current group not yet returned.
+  GroupOutput pendingOutput_;
+  size_t nextPendingOutput_ = 0;
+
+  // True after startParallelEvaluation() decided between parallel and
+  // serial evaluation.
+  bool parallelEvaluationChecked_ = false;
 
   // Number of input rows.
   vector_size_t numRows_ = 0;
 
+  // For partial partitions: the maximum number of rows a frame starts before
+  // or ends after its row.
+  int64_t maxPrecedingRows_ = 0;
+  int64_t maxFollowingRows_ = 0;
+
   // Number of rows that be fit into an output block.
   vector_size_t numRowsPerOutput_;
 
   // Number of rows output from the WindowOperator so far. The rows
-  // are output in the same order of the pointers in sortedRows. This
-  // value is updated as the WindowFunction::apply() function is
-  // called on the partition blocks.
+  // are output in the same order of the pointers in sortedRows.
   vector_size_t numProcessedRows_ = 0;
-
-  // Tracks how far along the partition rows have been output.
-  vector_size_t partitionOffset_ = 0;
-
-  // When traversing input partition rows, the peers are the rows
-  // with the same values for the ORDER BY clause. These rows
-  // are equal in some ways and affect the results of ranking functions.
-  // Since all rows between the peerStartRow_ and peerEndRow_ have the same
-  // values for peerStartRow_ and peerEndRow_, we needn't compute
-  // them for each row independently. Since these rows might
-  // cross getOutput boundaries and be called in subsequent calls to
-  // computePeerBuffers they are saved here.
-  vector_size_t peerStartRow_ = 0;
-  vector_size_t peerEndRow_ = 0;
 };
 
 } // namespace facebook::velox::exec
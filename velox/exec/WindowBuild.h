@@ -68,7 +68,44 @@ class WindowBuild {
   // the underlying columns of Window partition data.
   // Check hasNextPartition() before invoking this function. This function fails
   // if called when no partition is available.
-  virtual std::unique_ptr<WindowPartition> nextPartition() = 0;
+  // If row streaming is enabled, the partition may be partial. Its rows are
+  // then added as they are read and it is completed once all are read.
+  virtual std::shared_ptr<WindowPartition> nextPartition() = 0;
+
+  // Enables handing out partial partitions from nextPartition(). Called by
+  // the Window operator before any input if all its window functions can be
+  // computed over rows that are loaded and released incrementally (see
+  // WindowFunction::RowAccess). 'numRowsPerLoad' is the number of rows by
+  // which a partial partition read from spill grows at a time.
+  void enableRowStreaming(vector_size_t numRowsPerLoad) {
+    VELOX_CHECK_GT(numRowsPerLoad, 0);
+    rowStreaming_ = true;
+    numRowsPerLoad_ = numRowsPerLoad;
+  }
+
+  // Adds rows to the incomplete partial partition last returned by
+  // nextPartition() if more of its rows are available without more input,
+  // and completes the partition after its last row. Returns false if nothing
+  // was added or completed.
+  virtual bool loadMoreRows() {
+    return false;
+  }
+
+  // Returns the number of rows of each partition if the partitions can be
+  // accessed in any order with partitionAt(). Returns an empty vector if the
+  // partitions can only be read in order with nextPartition(). Called after
+  // noMoreInput().
+  virtual std::vector<vector_size_t> partitionSizes() const {
+    return {};
+  }
+
+  // Returns the partition at 'index' in the order of nextPartition(). May be
+  // called from multiple threads at the same time. Must not be mixed with
+  // nextPartition().
+  virtual std::shared_ptr<WindowPartition> partitionAt(
+      vector_size_t /*index*/) const {
+    VELOX_UNSUPPORTED("Window build does not support random access partitions");
+  }
 
   // Returns the average size of input rows in bytes stored in the
   // data container of the WindowBuild.
@@ -113,6 +150,13 @@ class WindowBuild {
 
   // Number of input rows.
   vector_size_t numRows_ = 0;
+
+  // True if nextPartition() may return partial partitions.
+  bool rowStreaming_ = false;
+
+  // Number of rows by which a partial partition grows at a time when read
+  // from spill.
+  vector_size_t numRowsPerLoad_ = 0;
 };
 
 } // namespace facebook::velox::exec
@@ -47,6 +47,27 @@ class WindowFunction {
   // value.
   static constexpr vector_size_t kNullRow = -1;
 
+  /// Describes which rows of a partition a function reads. The Window operator
+  /// computes a partial partition, whose rows are added and removed while it
+  /// is processed, only if all its functions allow it.
+  enum class RowAccess {
+    /// Reads any row of the partition or depends on its number of rows.
+    kPartition,
+    /// Reads only the rows in the frames of the rows it is applied to.
+    kFrame,
+    /// Like kFrame, but reads each row only once while consecutive frames
+    /// share their start. Frames from UNBOUNDED PRECEDING to CURRENT ROW are
+    /// computed without going back to the first row of the partition.
+    kIncrementalFrame,
+    /// Reads no rows and ignores the frames. The result depends only on the
+    /// order of the rows and their peer groups.
+    kPeers,
+  };
+
+  virtual RowAccess rowAccess() const {
+    return RowAccess::kPartition;
+  }
+
   const TypePtr& resultType() const {
     return resultType_;
   }
@@ -24,6 +24,8 @@ WindowPartition::WindowPartition(
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
     : data_(data),
       partition_(rows),
+      partial_(false),
+      complete_(true),
       inputMapping_(inputMapping),
       sortKeyInfo_(sortKeyInfo) {
   for (int i = 0; i < inputMapping_.size(); i++) {
@@ -31,11 +33,72 @@ WindowPartition::WindowPartition(
   }
 }
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    const std::vector<column_index_t>& inputMapping,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : data_(data),
+      partial_(true),
+      complete_(false),
+      inputMapping_(inputMapping),
+      sortKeyInfo_(sortKeyInfo) {
+  for (int i = 0; i < inputMapping_.size(); i++) {
+    columns_.emplace_back(data_->columnAt(inputMapping_[i]));
+  }
+}
+
+void WindowPartition::addRows(const std::vector<char*>& rows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK(!complete_, "Cannot add rows to a complete window partition");
+  partialRows_.insert(partialRows_.end(), rows.begin(), rows.end());
+  updatePartialRows();
+}
+
+void WindowPartition::removeRowsBefore(vector_size_t row) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK_LE(row, numRows());
+  if (row <= startRow_) {
+    return;
+  }
+  const auto numRemoved = row - startRow_;
+  data_->eraseRows(folly::Range<char**>(partition_.data(), numRemoved));
+  firstPartialRow_ += numRemoved;
+  startRow_ = row;
+  peerBoundaries_.erase(
+      peerBoundaries_.begin(),
+      peerBoundaries_.begin() +
+          std::min<size_t>(numRemoved, peerBoundaries_.size()));
+  if (firstPartialRow_ > partialRows_.size() / 2) {
+    partialRows_.erase(
+        partialRows_.begin(), partialRows_.begin() + firstPartialRow_);
+    firstPartialRow_ = 0;
+  }
+  updatePartialRows();
+}
+
+vector_size_t WindowPartition::lastPeerGroupStart() const {
+  VELOX_CHECK(!partition_.empty());
+  computePeerBoundaries(numRows());
+  auto start = numRows() - 1;
+  while (start > startRow_ && !peerBoundaries_[start - startRow_]) {
+    --start;
+  }
+  return start;
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  if (startRow_ > 0) {
+    rowNumbers_.resize(rowNumbers.size());
+    for (auto i = 0; i < rowNumbers.size(); ++i) {
+      rowNumbers_[i] = rowNumbers[i] < 0 ? -1 : rowNumbers[i] - startRow_;
+    }
+    rowNumbers = folly::Range<const vector_size_t*>(
+        rowNumbers_.data(), rowNumbers_.size());
+  }
   RowContainer::extractColumn(
       partition_.data(),
       rowNumbers,
@@ -50,8 +113,9 @@ void WindowPartition::extractColumn(
     vector_size_t numRows,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  VELOX_CHECK_GE(partitionOffset, startRow_);
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -63,8 +127,9 @@ void WindowPartition::extractNulls(
     vector_size_t partitionOffset,
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
+  VELOX_CHECK_GE(partitionOffset, startRow_);
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -113,21 +178,113 @@ WindowPartition::extractNulls(
                    : std::nullopt;
 }
 
-bool WindowPartition::compareRowsWithSortKeys(const char* lhs, const char* rhs)
-    const {
-  if (lhs == rhs) {
-    return false;
+namespace {
+
+// The number of rows whose peer boundaries are computed together.
+constexpr vector_size_t kPeerBatchSize = 512;
+
+// Sets 'boundaries[i]' if rows[i + 1] has a different value of 'column' than
+// rows[i]. The values are gathered first so that the adjacent compare is a
+// loop over flat arrays the compiler vectorizes.
+template <typename T>
+void setFixedWidthBoundaries(
+    RowColumn column,
+    char* const* rows,
+    vector_size_t numRows,
+    uint8_t* boundaries) {
+  T values[kPeerBatchSize + 1];
+  uint8_t nulls[kPeerBatchSize + 1];
+  const auto offset = column.offset();
+  const auto nullByte = column.nullByte();
+  const auto nullMask = column.nullMask();
+  for (auto i = 0; i <= numRows; ++i) {
+    values[i] = *reinterpret_cast<const T*>(rows[i] + offset);
+    nulls[i] = (rows[i][nullByte] & nullMask) != 0;
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    // The values of null rows are not defined.
+    boundaries[i] |= (nulls[i] != nulls[i + 1]) |
+        (!nulls[i] & (values[i] != values[i + 1]));
+  }
+}
+
+} // namespace
+
+void WindowPartition::setKeyBoundaries(
+    column_index_t column,
+    char* const* rows,
+    vector_size_t numRows,
+    uint8_t* boundaries) const {
+  const auto rowColumn = data_->columnAt(column);
+  switch (data_->columnTypes()[column]->kind()) {
+    case TypeKind::TINYINT:
+      return setFixedWidthBoundaries<int8_t>(
+          rowColumn, rows, numRows, boundaries);
+    case TypeKind::SMALLINT:
+      return setFixedWidthBoundaries<int16_t>(
+          rowColumn, rows, numRows, boundaries);
+    case TypeKind::INTEGER:
+      return setFixedWidthBoundaries<int32_t>(
+          rowColumn, rows, numRows, boundaries);
+    case TypeKind::BIGINT:
+      return setFixedWidthBoundaries<int64_t>(
+          rowColumn, rows, numRows, boundaries);
+    case TypeKind::HUGEINT:
+      return setFixedWidthBoundaries<int128_t>(
+          rowColumn, rows, numRows, boundaries);
+    case TypeKind::TIMESTAMP:
+      return setFixedWidthBoundaries<Timestamp>(
+          rowColumn, rows, numRows, boundaries);
+    default:
+      // Floating point values equal by compare() may differ in their bits,
+      // e.g. NaNs, and strings and complex types are not inline. Compares the
+      // rows not already known to be boundaries one by one.
+      CompareFlags flags;
+      flags.equalsOnly = true;
+      for (auto i = 0; i < numRows; ++i) {
+        if (!boundaries[i]) {
+          boundaries[i] =
+              data_->compare(rows[i], rows[i + 1], column, flags) != 0;
+        }
+      }
+  }
+}
+
+void WindowPartition::computePeerBoundaries(vector_size_t end) const {
+  auto row = startRow_ + static_cast<vector_size_t>(peerBoundaries_.size());
+  if (row >= end) {
+    return;
+  }
+  peerBoundaries_.resize(end - startRow_, 0);
+  if (row == startRow_) {
+    // The row before the first row in memory is not available.
+    peerBoundaries_[0] = 1;
+    ++row;
+  }
+  for (; row < end; row += kPeerBatchSize) {
+    const auto numRows = std::min(kPeerBatchSize, end - row);
+    // Each row is compared with the row before it.
+    auto* rows = partition_.data() + row - 1 - startRow_;
+    auto* boundaries = peerBoundaries_.data() + row - startRow_;
+    for (const auto& key : sortKeyInfo_) {
+      setKeyBoundaries(key.first, rows, numRows, boundaries);
+    }
   }
-  for (auto& key : sortKeyInfo_) {
-    if (auto result = data_->compare(
-            lhs,
-            rhs,
-            key.first,
-            {key.second.isNullsFirst(), key.second.isAscending(), false})) {
-      return result < 0;
+}
+
+vector_size_t WindowPartition::nextPeerGroupStart(vector_size_t row) const {
+  const auto lastRow = numRows();
+  for (auto next = row + 1; next < lastRow; ++next) {
+    const auto numBoundaries =
+        static_cast<vector_size_t>(peerBoundaries_.size());
+    if (next - startRow_ >= numBoundaries) {
+      computePeerBoundaries(std::min(lastRow, next + kPeerBatchSize));
+    }
+    if (peerBoundaries_[next - startRow_]) {
+      return next;
     }
   }
-  return false;
+  return lastRow;
 }
 
 std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
@@ -137,13 +294,8 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
     vector_size_t prevPeerEnd,
     vector_size_t* rawPeerStarts,
     vector_size_t* rawPeerEnds) const {
-  auto peerCompare = [&](const char* lhs, const char* rhs) -> bool {
-    return compareRowsWithSortKeys(lhs, rhs);
-  };
-
   VELOX_CHECK_LE(end, numRows());
 
-  auto lastPartitionRow = numRows() - 1;
   auto peerStart = prevPeerStart;
   auto peerEnd = prevPeerEnd;
   for (auto i = start, j = 0; i < end; i++, j++) {
@@ -158,15 +310,10 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
 
     if (i == 0 || i >= peerEnd) {
       // Compute peerStart and peerEnd rows for the first row of the partition
-      // or when past the previous peerGroup.
+      // or when past the previous peerGroup. The peer group ends at the next
+      // row that differs from the row before it in the ORDER BY keys.
       peerStart = i;
-      peerEnd = i;
-      while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
-          break;
-        }
-        peerEnd++;
-      }
+      peerEnd = nextPeerGroupStart(i);
     }
 
     rawPeerStarts[j] = peerStart;
@@ -192,13 +339,13 @@ vector_size_t WindowPartition::searchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = rowAt(currentRow);
   vector_size_t begin = start;
   vector_size_t finish = end;
   while (finish - begin >= 2) {
     auto mid = (begin + finish) / 2;
     auto compareResult = data_->compare(
-        partition_[mid], current, orderByColumn, frameColumn, flags);
+        rowAt(mid), current, orderByColumn, frameColumn, flags);
 
     if (compareResult >= 0) {
       // Search in the first half of the column.
@@ -221,10 +368,10 @@ vector_size_t WindowPartition::linearSearchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = rowAt(currentRow);
   for (vector_size_t i = start; i < end; ++i) {
     auto compareResult = data_->compare(
-        partition_[i], current, orderByColumn, frameColumn, flags);
+        rowAt(i), current, orderByColumn, frameColumn, flags);
 
     // The bound value was found. Return if firstMatch required.
     // If the last match is required, then we need to find the first row that
@@ -271,7 +418,7 @@ void WindowPartition::updateKRangeFrameBounds(
   RowColumn orderByRowColumn = columns_[inputMapping_[orderByColumn]];
   for (auto i = 0; i < numRows; i++) {
     auto currentRow = startRow + i;
-    auto* partitionRow = partition_[currentRow];
+    auto* partitionRow = rowAt(currentRow);
 
     // The user is expected to set the frame column equal to NULL when the
     // ORDER BY value is NULL and not in any other case. Validate this
@@ -299,11 +446,11 @@ void WindowPartition::updateKRangeFrameBounds(
       // [0, currentRow] are examined. For following bounds, rows between
       // [currentRow, numRows()) are checked.
       if (isPreceding) {
-        start = 0;
+        start = startRow_;
         end = currentRow + 1;
       } else {
         start = currentRow;
-        end = partition_.size();
+        end = numRows();
       }
       rawFrameBounds[i] = searchFrameValue(
           firstMatch,
@@ -19,8 +19,11 @@
 #include "velox/vector/BaseVector.h"
 
 /// Simple WindowPartition that builds over the RowContainer used for storing
-/// the input rows in the Window Operator. This works completely in-memory.
-/// TODO: This implementation will be revised for Spill to disk semantics.
+/// the input rows in the Window Operator. A partition is either complete, with
+/// all its rows in memory, or partial. The rows of a partial partition are
+/// added in row number order as they are read from the input or from spill,
+/// and are removed once the Window operator no longer needs them. Row numbers
+/// are always relative to the start of the whole partition.
 
 namespace facebook::velox::exec {
 class WindowPartition {
@@ -42,11 +45,57 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Constructs a partial partition without rows. Rows are added with
+  /// addRows() until setComplete() is called.
+  WindowPartition(
+      RowContainer* data,
+      const std::vector<column_index_t>& inputMapping,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  /// Returns the number of rows in the current WindowPartition. For a partial
+  /// partition, this is the number of rows added so far, including the rows
+  /// already removed.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
+  }
+
+  /// Returns true if the rows of this partition are added and removed
+  /// incrementally.
+  bool partial() const {
+    return partial_;
+  }
+
+  /// Returns true if all the rows of the partition have been added.
+  bool complete() const {
+    return complete_;
+  }
+
+  /// Returns the row number of the first row held in memory. Rows before it
+  /// have been removed. Always 0 for a partition that is not partial.
+  vector_size_t offsetInPartition() const {
+    return startRow_;
+  }
+
+  /// Appends 'rows' to a partial partition. 'rows' are owned by 'data'.
+  void addRows(const std::vector<char*>& rows);
+
+  /// Marks a partial partition as having all its rows.
+  void setComplete() {
+    VELOX_CHECK(partial_);
+    complete_ = true;
   }
 
+  /// Erases the rows of a partial partition before row number 'row' from the
+  /// partition and from the RowContainer. These rows must not be accessed
+  /// afterwards.
+  void removeRowsBefore(vector_size_t row);
+
+  /// Returns the row number of the first row of the last peer group of the
+  /// rows in memory. More rows of that peer group may follow if the partition
+  /// is not complete.
+  vector_size_t lastPeerGroupStart() const;
+
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
   /// array from the partition input data.
@@ -128,7 +177,34 @@ class WindowPartition {
       vector_size_t* rawFrameBounds) const;
 
  private:
-  bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
+  // Sets 'boundaries[i]' if rows[i + 1] differs from rows[i] in 'column'.
+  // 'rows' has 'numRows' + 1 rows.
+  void setKeyBoundaries(
+      column_index_t column,
+      char* const* rows,
+      vector_size_t numRows,
+      uint8_t* boundaries) const;
+
+  // Extends 'peerBoundaries_' to the rows before row number 'end'.
+  void computePeerBoundaries(vector_size_t end) const;
+
+  // Returns the row number of the first row after 'row' that is not a peer of
+  // 'row', or numRows() if all the following rows in memory are its peers.
+  vector_size_t nextPeerGroupStart(vector_size_t row) const;
+
+  // Returns the row at partition row number 'row'.
+  char* rowAt(vector_size_t row) const {
+    VELOX_DCHECK_GE(row, startRow_);
+    return partition_[row - startRow_];
+  }
+
+  // Updates 'partition_' after adding or removing rows of a partial
+  // partition.
+  void updatePartialRows() {
+    partition_ = folly::Range<char**>(
+        partialRows_.data() + firstPartialRow_,
+        partialRows_.size() - firstPartialRow_);
+  }
 
   // Searches for 'currentRow[frameColumn]' in 'orderByColumn' of rows between
   // 'start' and 'end' in the partition. 'firstMatch' specifies if first or last
@@ -169,9 +245,33 @@ class WindowPartition {
   // folly::Range is for the partition rows iterator provided by the
   // Window operator. The pointers are to rows from a RowContainer owned
   // by the operator. We can assume these are valid values for the lifetime
-  // of WindowPartition.
+  // of WindowPartition. For a partial partition, these are the rows in
+  // memory, starting at row number 'startRow_'.
   folly::Range<char**> partition_;
 
+  const bool partial_;
+
+  bool complete_;
+
+  // Number of rows removed from the start of a partial partition.
+  vector_size_t startRow_ = 0;
+
+  // Rows of a partial partition. The first 'firstPartialRow_' rows have been
+  // removed and are compacted away once they make up half of the vector.
+  std::vector<char*> partialRows_;
+  vector_size_t firstPartialRow_ = 0;
+
+  // Row numbers relative to 'partition_' for extractColumn() of a partial
+  // partition.
+  mutable std::vector<vector_size_t> rowNumbers_;
+
+  // peerBoundaries_[i] is 1 if the row at row number 'startRow_' + i differs
+  // from the row before it in the ORDER BY keys, i.e. starts a peer group.
+  // Computed for batches of rows at a time by comparing the keys of adjacent
+  // rows column by column, instead of comparing all the keys of two rows at a
+  // time. The first row in memory always starts a peer group.
+  mutable std::vector<uint8_t> peerBoundaries_;
+
   // Mapping from window input column -> index in data_. This is required
   // because the WindowBuild reorders data_ to place partition and sort keys
   // before other columns in data_. But the Window Operator and Function code
@@ -36,8 +36,23 @@ DEFINE_int32(custom_key_spacing, 1, "Spacing between key values");
 
 DEFINE_int32(custom_num_ways, 10, "Number of build threads");
 
+DEFINE_bool(
+    include_1b,
+    false,
+    "Include the 1B row kHash mode cases. Needs about 100GB of memory");
+
+DEFINE_int64(
+    allocator_capacity_gb,
+    10,
+    "Capacity of the memory allocator in GB");
+
 DEFINE_bool(profile, false, "Generate perf profiles and memory stats");
 
+DEFINE_bool(
+    use_huge_pages,
+    false,
+    "Allocate the tables from size classes backed by transparent huge pages");
+
 DECLARE_bool(velox_time_allocations);
 
 using namespace facebook::velox;
@@ -89,13 +104,17 @@ struct HashTableBenchmarkParams {
   // VectorHasher.
   int32_t keySpacing{1};
 
+  // Sets HashLookup::groupPrefetch for the probe.
+  bool groupPrefetch{false};
+
   std::string toString() const {
     return fmt::format(
-        "{}: Rows={} Hit%={} NumProbes={}",
+        "{}: Rows={} Hit%={} NumProbes={}{}",
         title,
         buildSize,
         insertPct,
-        size * numWays);
+        size * numWays,
+        groupPrefetch ? " GroupPrefetch" : "");
   }
 };
 
@@ -277,6 +296,60 @@ class HashTableBenchmark : public VectorTestBase {
     table.groupProbe(lookup);
   }
 
+  // Inserts 'numBatches' batches of 'batchSize' keys of 'keyType' into a
+  // group by table. The keys cycle through 'numDistinct' values spread over
+  // the whole int64 range, or 12 character strings for VARCHAR, so that the
+  // table is in kHash mode. Returns the clocks per row for hashing and
+  // probing.
+  float groupByClocksPerRow(
+      const TypePtr& keyType,
+      int32_t numDistinct,
+      int32_t batchSize,
+      int32_t numBatches) {
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    keyHashers.emplace_back(std::make_unique<VectorHasher>(keyType, 0));
+    auto table = HashTable<false>::createForAggregation(
+        std::move(keyHashers), std::vector<Accumulator>{}, pool_.get());
+    auto lookup = std::make_unique<HashLookup>(table->hashers());
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < numBatches; ++i) {
+      auto keyOf = [&](auto row) {
+        return (static_cast<int64_t>(i) * batchSize + row) % numDistinct;
+      };
+      VectorPtr keys;
+      if (keyType->kind() == TypeKind::VARCHAR) {
+        keys = vectorMaker_->flatVector<std::string>(batchSize, [&](auto row) {
+          return fmt::format("key-{:08}", keyOf(row));
+        });
+      } else {
+        keys = vectorMaker_->flatVector<int64_t>(batchSize, [&](auto row) {
+          return static_cast<int64_t>(keyOf(row) * 0x9E3779B97F4A7C15ULL);
+        });
+        if (keyType->kind() == TypeKind::ROW) {
+          keys = vectorMaker_->rowVector({keys});
+        }
+      }
+      batches.push_back(vectorMaker_->rowVector({keys}));
+    }
+    SelectivityInfo groupByTime;
+    {
+      SelectivityTimer timer(groupByTime, 0);
+      for (auto& batch : batches) {
+        insertGroups(*batch, *lookup, *table);
+      }
+    }
+    const auto clocksPerRow =
+        groupByTime.timeToDropValue() / (batchSize * numBatches);
+    std::cout << fmt::format(
+                     "Group by {}: mode={} numDistinct={} clocks/row={}",
+                     keyType->toString(),
+                     BaseHashTable::modeString(table->hashMode()),
+                     table->numDistinct(),
+                     clocksPerRow)
+              << std::endl;
+    return clocksPerRow;
+  }
+
   void copyVectorsToTable(
       const std::vector<RowVectorPtr>& batches,
       int32_t tableOffset,
@@ -413,6 +486,7 @@ class HashTableBenchmark : public VectorTestBase {
 
   void testProbe() {
     auto lookup = std::make_unique<HashLookup>(topTable_->hashers());
+    lookup->groupPrefetch = params_.groupPrefetch;
     auto batchSize = batches_[0]->size();
     SelectivityVector rows(batchSize);
     auto mode = topTable_->hashMode();
@@ -619,9 +693,17 @@ int main(int argc, char** argv) {
   folly::Init init{&argc, &argv};
   memory::MemoryManagerOptions options;
   options.useMmapAllocator = true;
-  options.allocatorCapacity = 10UL << 30;
+  options.allocatorCapacity = FLAGS_allocator_capacity_gb << 30;
   options.useMmapArena = true;
   options.mmapArenaCapacityRatio = 1;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> prefaultExecutor;
+  if (FLAGS_use_huge_pages) {
+    prefaultExecutor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+    options.largestSizeClassPages =
+        memory::AllocationTraits::numPagesInHugePage();
+    options.useHugePageSizeClasses = true;
+    options.hugePagePrefaultExecutor = prefaultExecutor.get();
+  }
   memory::MemoryManager::initialize(options);
   if (FLAGS_profile) {
     auto allocator = memory::MemoryManager::getInstance()->allocator();
@@ -652,6 +734,26 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
       HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+
+  // A struct key makes a kHash mode table. These compare the default probe to
+  // the group prefetching one for build sides from 1M to 1B rows.
+  std::vector<std::pair<std::string, int64_t>> hashSizes = {
+      {"1M", 1'000'000}, {"16M", 16'000'000}, {"128M", 128'000'000}};
+  if (FLAGS_include_1b) {
+    hashSizes.push_back({"1B", 1'000'000'000});
+  }
+  for (const auto& [name, size] : hashSizes) {
+    for (auto groupPrefetch : {false, true}) {
+      HashTableBenchmarkParams hashParams(
+          fmt::format("HashHit{}{}", name, groupPrefetch ? "Prefetch" : ""),
+          size,
+          100);
+      hashParams.mode = BaseHashTable::HashMode::kHash;
+      hashParams.buildType = ROW({"k1"}, {ROW({"s1"}, {BIGINT()})});
+      hashParams.groupPrefetch = groupPrefetch;
+      params.push_back(std::move(hashParams));
+    }
+  }
   if (FLAGS_custom_size != 0) {
     params.push_back(HashTableBenchmarkParams(
         "Custom",
@@ -673,10 +775,35 @@ int main(int argc, char** argv) {
       return 1;
     });
   }
+  // Group by on a single key with a large range makes a kHash mode table.
+  // The BIGINT and VARCHAR keys take the single key probe while the struct
+  // key with the same BIGINT values goes through the generic key comparison.
+  std::vector<std::pair<std::string, float>> groupByResults;
+  const std::vector<std::pair<std::string, TypePtr>> groupByKeys = {
+      {"Bigint", BIGINT()},
+      {"Varchar", VARCHAR()},
+      {"Struct", ROW({"s1"}, {BIGINT()})}};
+  for (const auto& key : groupByKeys) {
+    const auto& type = key.second;
+    for (auto numDistinct : {100'000, 4'000'000}) {
+      const auto title = fmt::format("GroupBy{}{}", key.first, numDistinct);
+      folly::addBenchmark(
+          __FILE__, title, [title, type, numDistinct, &bm, &groupByResults]() {
+            groupByResults.emplace_back(
+                title,
+                bm->groupByClocksPerRow(type, numDistinct, 10'000, 800));
+            return 1;
+          });
+    }
+  }
+
   folly::runBenchmarks();
   std::cout << "*** Results:" << std::endl;
   for (auto& result : results) {
     std::cout << result.toString() << std::endl;
   }
+  for (const auto& [title, clocksPerRow] : groupByResults) {
+    std::cout << title << ": clocks/row=" << clocksPerRow << std::endl;
+  }
   return 0;
 }
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <thread>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/LocalPartition.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Moves small batches from many producer threads to many consumer threads
+// through a single LocalExchangeQueue, the way a local exchange after a
+// partial aggregation with many drivers does.
+class LocalExchangeQueueBenchmark
+    : public facebook::velox::test::VectorTestBase {
+ public:
+  void setup() {
+    batch_ = makeRowVector({makeFlatVector<int64_t>(64, folly::identity)});
+  }
+
+  void run(int32_t numProducers, int32_t numConsumers, int64_t maxBufferSize) {
+    constexpr int32_t kBatchesPerProducer = 10'000;
+
+    auto memoryManager =
+        std::make_shared<LocalExchangeMemoryManager>(maxBufferSize);
+    auto queue = std::make_shared<LocalExchangeQueue>(memoryManager, 0);
+    for (auto i = 0; i < numProducers; ++i) {
+      queue->addProducer();
+    }
+    queue->noMoreProducers();
+
+    std::vector<std::thread> threads;
+    threads.reserve(numProducers + numConsumers);
+    for (auto i = 0; i < numProducers; ++i) {
+      threads.emplace_back([&]() {
+        for (auto j = 0; j < kBatchesPerProducer; ++j) {
+          ContinueFuture future;
+          if (queue->enqueue(batch_, &future) != BlockingReason::kNotBlocked) {
+            future.wait();
+          }
+        }
+        queue->noMoreData();
+      });
+    }
+
+    std::atomic<int64_t> numBatches{0};
+    for (auto i = 0; i < numConsumers; ++i) {
+      threads.emplace_back([&]() {
+        for (;;) {
+          ContinueFuture future;
+          RowVectorPtr data;
+          if (queue->next(&future, pool(), &data) !=
+              BlockingReason::kNotBlocked) {
+            future.wait();
+            continue;
+          }
+          if (data == nullptr) {
+            break;
+          }
+          ++numBatches;
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    VELOX_CHECK_EQ(numBatches, numProducers * kBatchesPerProducer);
+  }
+
+ private:
+  RowVectorPtr batch_;
+};
+
+std::unique_ptr<LocalExchangeQueueBenchmark> bm;
+
+BENCHMARK(producers4_consumers4) {
+  bm->run(4, 4, 32 << 20);
+}
+
+BENCHMARK(producers16_consumers16) {
+  bm->run(16, 16, 32 << 20);
+}
+
+BENCHMARK(producers32_consumers4) {
+  bm->run(32, 4, 32 << 20);
+}
+
+// Producers block on the memory limit most of the time.
+BENCHMARK(producers16_consumers16_smallBuffer) {
+  bm->run(16, 16, 64 << 10);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  memory::MemoryManager::initialize({});
+
+  bm = std::make_unique<LocalExchangeQueueBenchmark>();
+  bm->setup();
+
+  folly::runBenchmarks();
+
+  bm.reset();
+
+  return 0;
+}
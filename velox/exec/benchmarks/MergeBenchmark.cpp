@@ -20,11 +20,69 @@
 #include <gflags/gflags.h>
 
 #include "velox/exec/TreeOfLosers.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/MergeTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
+namespace {
+/// Runs a LocalMerge over sorted sources with a bigint key and a double
+/// payload, with the keys compared either normalized or with
+/// BaseVector::compare.
+class LocalMergeBenchmark : public facebook::velox::test::VectorTestBase {
+ public:
+  static constexpr int32_t kNumSources = 16;
+  static constexpr int32_t kNumBatches = 20;
+  static constexpr vector_size_t kBatchSize = 10'000;
+
+  /// Makes the plan for merging 'kNumSources' sources. The keys of each
+  /// source come in runs of 'runSize' consecutive rows that sort between the
+  /// runs of the other sources. With 'runSize' 1 the sources interleave row
+  /// by row.
+  core::PlanNodePtr makePlan(int32_t runSize) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<core::PlanNodePtr> sources;
+    for (auto source = 0; source < kNumSources; ++source) {
+      std::vector<RowVectorPtr> vectors;
+      for (auto batch = 0; batch < kNumBatches; ++batch) {
+        vectors.push_back(makeRowVector({
+            makeFlatVector<int64_t>(
+                kBatchSize,
+                [&](auto row) {
+                  const int64_t index = batch * kBatchSize + row;
+                  return (index / runSize) * runSize * kNumSources +
+                      source * runSize + index % runSize;
+                }),
+            makeFlatVector<double>(
+                kBatchSize, [](auto row) { return row * 0.1; }),
+        }));
+      }
+      sources.push_back(
+          PlanBuilder(planNodeIdGenerator).values(vectors).planNode());
+    }
+    return PlanBuilder(planNodeIdGenerator)
+        .localMerge({"c0"}, std::move(sources))
+        .planNode();
+  }
+
+  void run(const core::PlanNodePtr& plan, bool normalizedKeys) {
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kPrefixSortNormalizedKeyMaxBytes,
+            normalizedKeys ? "128" : "0")
+        .assertTypeAndNumRows(
+            plan->outputType(), kNumSources * kNumBatches * kBatchSize);
+  }
+};
+
+std::unique_ptr<LocalMergeBenchmark> localMerge;
+core::PlanNodePtr interleavedPlan;
+core::PlanNodePtr runsPlan;
+} // namespace
+
 TestData narrow;
 TestData medium;
 TestData wide;
@@ -53,14 +111,37 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK(localMergeInterleaved) {
+  localMerge->run(interleavedPlan, false);
+}
+
+BENCHMARK_RELATIVE(localMergeInterleavedNormalized) {
+  localMerge->run(interleavedPlan, true);
+}
+
+BENCHMARK(localMergeRuns) {
+  localMerge->run(runsPlan, false);
+}
+
+BENCHMARK_RELATIVE(localMergeRunsNormalized) {
+  localMerge->run(runsPlan, true);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  memory::MemoryManager::initialize({});
+  localMerge = std::make_unique<LocalMergeBenchmark>();
+  interleavedPlan = localMerge->makePlan(1);
+  runsPlan = localMerge->makePlan(100);
   MergeTestBase test;
   test.seed(1);
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
   folly::runBenchmarks();
+  interleavedPlan.reset();
+  runsPlan.reset();
+  localMerge.reset();
   return 0;
 }
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <gflags/gflags.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+namespace {
+/// Runs a NestedLoopJoin of bigint columns with join conditions of different
+/// selectivity. The join condition is evaluated on every pair of probe and
+/// build rows, so the cost is dominated by evaluating the condition and
+/// gathering the passing pairs.
+class NestedLoopJoinBenchmark : public facebook::velox::test::VectorTestBase {
+ public:
+  static constexpr int32_t kNumProbeBatches = 4;
+  static constexpr vector_size_t kProbeBatchSize = 1'000;
+  static constexpr int32_t kNumBuildBatches = 4;
+  static constexpr vector_size_t kBuildBatchSize = 2'500;
+
+  NestedLoopJoinBenchmark() {
+    for (auto i = 0; i < kNumProbeBatches; ++i) {
+      probeVectors_.push_back(makeRowVector(
+          {"t0", "t1"},
+          {
+              makeFlatVector<int64_t>(
+                  kProbeBatchSize,
+                  [&](auto row) { return i * kProbeBatchSize + row; }),
+              makeFlatVector<int64_t>(
+                  kProbeBatchSize,
+                  [](auto row) { return row % 7; },
+                  [](auto row) { return row % 11 == 0; }),
+          }));
+    }
+    for (auto i = 0; i < kNumBuildBatches; ++i) {
+      buildVectors_.push_back(makeRowVector(
+          {"u0", "u1"},
+          {
+              makeFlatVector<int64_t>(
+                  kBuildBatchSize,
+                  [&](auto row) { return (i * kBuildBatchSize + row) * 3; }),
+              makeFlatVector<int64_t>(
+                  kBuildBatchSize, [](auto row) { return row % 5; }),
+          }));
+    }
+  }
+
+  /// Makes a plan that counts the pairs passing 'joinCondition'.
+  core::PlanNodePtr makePlan(const std::string& joinCondition) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probeVectors_)
+        .nestedLoopJoin(
+            PlanBuilder(planNodeIdGenerator).values(buildVectors_).planNode(),
+            joinCondition,
+            {"t0", "u0"})
+        .singleAggregation({}, {"count(1)"})
+        .planNode();
+  }
+
+  void run(const core::PlanNodePtr& plan) {
+    AssertQueryBuilder(plan).copyResults(pool());
+  }
+
+ private:
+  std::vector<RowVectorPtr> probeVectors_;
+  std::vector<RowVectorPtr> buildVectors_;
+};
+
+std::unique_ptr<NestedLoopJoinBenchmark> nestedLoopJoin;
+// About one pair in 1000 passes.
+core::PlanNodePtr selectivePlan;
+// About one pair in 10 passes.
+core::PlanNodePtr mediumPlan;
+// About half of the pairs pass.
+core::PlanNodePtr nonSelectivePlan;
+// The condition is null for the probe rows with a null 't1'.
+core::PlanNodePtr nullsPlan;
+} // namespace
+
+BENCHMARK(selective) {
+  nestedLoopJoin->run(selectivePlan);
+}
+
+BENCHMARK(medium) {
+  nestedLoopJoin->run(mediumPlan);
+}
+
+BENCHMARK(nonSelective) {
+  nestedLoopJoin->run(nonSelectivePlan);
+}
+
+BENCHMARK(nulls) {
+  nestedLoopJoin->run(nullsPlan);
+}
+
+int main(int argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+  nestedLoopJoin = std::make_unique<NestedLoopJoinBenchmark>();
+  selectivePlan = nestedLoopJoin->makePlan("(t0 + u0) % 1000 = 0");
+  mediumPlan = nestedLoopJoin->makePlan("(t0 + u0) % 10 = 0");
+  nonSelectivePlan = nestedLoopJoin->makePlan("t0 * 3 < u0");
+  nullsPlan = nestedLoopJoin->makePlan("t1 = u1");
+  folly::runBenchmarks();
+  selectivePlan.reset();
+  mediumPlan.reset();
+  nonSelectivePlan.reset();
+  nullsPlan.reset();
+  nestedLoopJoin.reset();
+  return 0;
+}
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <folly/String.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <iostream>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/compression/Compression.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Spiller.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_string(
+    spill_path,
+    "",
+    "Directory to spill to. Use a directory on the disk to evaluate. A "
+    "temporary directory if empty");
+DEFINE_string(
+    compression_kinds,
+    "none,lz4,zstd",
+    "Spill compression kinds to try");
+DEFINE_string(
+    write_buffer_kb,
+    "256,1024,4096",
+    "Values of spill_write_buffer_size in KB to try");
+DEFINE_string(
+    read_buffer_kb,
+    "256,1024,4096",
+    "Values of spill_read_buffer_size in KB to try");
+DEFINE_string(
+    read_ahead_depths,
+    "0,1,4",
+    "Numbers of buffers to read ahead of the one being consumed to try");
+DEFINE_string(
+    partition_bits,
+    "0,3",
+    "Numbers of spill partition bits to try. The input vectors are spread "
+    "round robin over the 2^bits partitions");
+DEFINE_string(
+    row_widths,
+    "4,32",
+    "Numbers of columns to try. The column types cycle through BIGINT, "
+    "VARCHAR, DOUBLE and INTEGER");
+DEFINE_uint32(string_length, 20, "Length of the VARCHAR values");
+DEFINE_uint64(
+    spill_mb,
+    1'024,
+    "Approximate in-memory size of the data to spill in each run");
+DEFINE_uint32(vector_size, 1'024, "Number of rows per spilled vector");
+DEFINE_uint32(num_io_threads, 8, "Threads for spill read-ahead");
+DEFINE_bool(
+    drop_page_cache,
+    true,
+    "Evict the spill files from the OS page cache before reading them back, "
+    "so that the reads go to the disk. Only for local files");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+template <typename T>
+std::vector<T> parseList(const std::string& flag) {
+  std::vector<T> values;
+  folly::split(',', flag, values, true);
+  VELOX_USER_CHECK(!values.empty(), "Empty list of values: '{}'", flag);
+  return values;
+}
+
+RowTypePtr makeRowType(uint32_t numColumns) {
+  static const std::vector<TypePtr> kTypes = {
+      BIGINT(), VARCHAR(), DOUBLE(), INTEGER()};
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < numColumns; ++i) {
+    names.push_back(fmt::format("c{}", i));
+    types.push_back(kTypes[i % kTypes.size()]);
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+// Writes the dirty pages of the files in 'path' and evicts them from the page
+// cache.
+void dropPageCache(filesystems::FileSystem& fs, const std::string& path) {
+  for (const auto& file : fs.list(path)) {
+    const auto fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+      continue;
+    }
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+  }
+}
+
+/// One combination of the spill settings to measure.
+struct SpillBenchmarkConfig {
+  std::string compressionKind;
+  uint64_t writeBufferKB;
+  uint64_t readBufferKB;
+  uint32_t readAheadDepth;
+  uint8_t partitionBits;
+  uint32_t numColumns;
+
+  std::string toString() const {
+    return fmt::format(
+        "{} columns, {} partition bits, {}, write buffer {}KB, read buffer "
+        "{}KB, read ahead {}",
+        numColumns,
+        partitionBits,
+        compressionKind,
+        writeBufferKB,
+        readBufferKB,
+        readAheadDepth);
+  }
+};
+
+/// Spills fuzzed vectors through a hash join probe Spiller and reads them
+/// back through SpillPartition::createUnorderedReader() for each combination
+/// of the settings in the flags. Prints the wall time of each phase and the
+/// serialization, compression and IO times from SpillStats, which show
+/// whether a setting is bound by CPU or by the disk.
+class SpillBenchmark {
+ public:
+  void initialize() {
+    memory::MemoryManager::initialize({});
+    serializer::presto::PrestoVectorSerde::registerVectorSerde();
+    filesystems::registerLocalFileSystem();
+    pool_ = memory::memoryManager()->addLeafPool("SpillBenchmark");
+    executor_ =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    if (FLAGS_spill_path.empty()) {
+      tempDir_ = exec::test::TempDirectoryPath::create();
+      spillRoot_ = tempDir_->getPath();
+    } else {
+      spillRoot_ = FLAGS_spill_path;
+    }
+    fs_ = filesystems::getFileSystem(spillRoot_, nullptr);
+  }
+
+  void run() {
+    // Configurations differing only in the read settings reuse the spilled
+    // files.
+    for (auto numColumns : parseList<uint32_t>(FLAGS_row_widths)) {
+      const auto input = makeInput(makeRowType(numColumns));
+      for (auto bits : parseList<uint32_t>(FLAGS_partition_bits)) {
+        for (const auto& kind :
+             parseList<std::string>(FLAGS_compression_kinds)) {
+          for (auto writeKB : parseList<uint64_t>(FLAGS_write_buffer_kb)) {
+            SpillBenchmarkConfig config{
+                kind, writeKB, 0, 0, static_cast<uint8_t>(bits), numColumns};
+            runWriteAndReads(config, input);
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  std::vector<RowVectorPtr> makeInput(const RowTypePtr& rowType) {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_vector_size;
+    options.stringLength = FLAGS_string_length;
+    options.stringVariableLength = false;
+    options.nullRatio = 0.05;
+    VectorFuzzer fuzzer(options, pool_.get());
+
+    // Fuzzing all the data would dominate the run time. The spilled vectors
+    // are repeated from a sample.
+    constexpr int32_t kNumSampleVectors = 16;
+    std::vector<RowVectorPtr> samples;
+    uint64_t sampleBytes = 0;
+    for (auto i = 0; i < kNumSampleVectors; ++i) {
+      samples.push_back(fuzzer.fuzzInputRow(rowType));
+      sampleBytes += samples.back()->estimateFlatSize();
+    }
+    const auto numVectors = std::max<uint64_t>(
+        1, (FLAGS_spill_mb << 20) * kNumSampleVectors / sampleBytes);
+    std::vector<RowVectorPtr> input;
+    input.reserve(numVectors);
+    for (auto i = 0; i < numVectors; ++i) {
+      input.push_back(samples[i % kNumSampleVectors]);
+    }
+    return input;
+  }
+
+  void runWriteAndReads(
+      SpillBenchmarkConfig config,
+      const std::vector<RowVectorPtr>& input) {
+    const auto spillDir = fmt::format("{}/spill-{}", spillRoot_, runId_++);
+    fs_->mkdir(spillDir);
+
+    common::SpillConfig spillConfig;
+    spillConfig.getSpillDirPathCb = [&]() -> std::string_view {
+      return spillDir;
+    };
+    spillConfig.updateAndCheckSpillLimitCb = [](uint64_t) {};
+    spillConfig.fileNamePrefix = "SpillBenchmark";
+    spillConfig.maxFileSize = 0;
+    spillConfig.writeBufferSize = config.writeBufferKB << 10;
+    spillConfig.executor = executor_.get();
+    spillConfig.compressionKind =
+        common::stringToCompressionKind(config.compressionKind);
+    spillConfig.maxSpillRunRows = 0;
+    spillConfig.startPartitionBit = 29;
+    spillConfig.numPartitionBits = config.partitionBits;
+
+    folly::Synchronized<common::SpillStats> writeStats;
+    const uint32_t numPartitions = 1 << config.partitionBits;
+    SpillPartitionSet partitionSet;
+    uint64_t writeUs{0};
+    {
+      MicrosecondTimer timer(&writeUs);
+      Spiller spiller(
+          Spiller::Type::kHashJoinProbe,
+          asRowType(input[0]->type()),
+          HashBitRange{
+              spillConfig.startPartitionBit,
+              static_cast<uint8_t>(
+                  spillConfig.startPartitionBit + config.partitionBits)},
+          &spillConfig,
+          &writeStats);
+      SpillPartitionNumSet partitions;
+      for (auto i = 0; i < numPartitions; ++i) {
+        partitions.insert(i);
+      }
+      spiller.setPartitionsSpilled(partitions);
+      for (auto i = 0; i < input.size(); ++i) {
+        spiller.spill(i % numPartitions, input[i]);
+      }
+      spiller.finishSpill(partitionSet);
+    }
+    printWrite(config, writeUs, writeStats.copy());
+
+    for (auto readKB : parseList<uint64_t>(FLAGS_read_buffer_kb)) {
+      for (auto depth : parseList<uint32_t>(FLAGS_read_ahead_depths)) {
+        config.readBufferKB = readKB;
+        config.readAheadDepth = depth;
+        if (FLAGS_drop_page_cache) {
+          dropPageCache(*fs_, spillDir);
+        }
+        runRead(config, partitionSet);
+      }
+    }
+    fs_->rmdir(spillDir);
+  }
+
+  void runRead(
+      const SpillBenchmarkConfig& config,
+      const SpillPartitionSet& partitionSet) {
+    SpillReadAheadOptions readAheadOptions;
+    readAheadOptions.depth = config.readAheadDepth;
+    readAheadOptions.executor = executor_.get();
+
+    folly::Synchronized<common::SpillStats> readStats;
+    uint64_t readUs{0};
+    uint64_t numRows{0};
+    {
+      MicrosecondTimer timer(&readUs);
+      for (const auto& [id, partition] : partitionSet) {
+        // The reader takes ownership of the files of the partition. Reads a
+        // copy so that the files can be read again with other settings.
+        SpillPartition copy(id);
+        copy.addFiles(partition->files());
+        auto reader = copy.createUnorderedReader(
+            config.readBufferKB << 10,
+            pool_.get(),
+            &readStats,
+            readAheadOptions);
+        RowVectorPtr batch;
+        while (reader->nextBatch(batch)) {
+          numRows += batch->size();
+        }
+      }
+    }
+    const auto stats = readStats.copy();
+    std::cout << fmt::format(
+                     "read {}: {} rows in {}, {} reads, io {}, "
+                     "deserialization {}",
+                     config.toString(),
+                     numRows,
+                     succinctMicros(readUs),
+                     stats.spillReads,
+                     succinctMicros(stats.spillReadTimeUs),
+                     succinctMicros(stats.spillDeserializationTimeUs))
+              << std::endl;
+  }
+
+  void printWrite(
+      const SpillBenchmarkConfig& config,
+      uint64_t writeUs,
+      const common::SpillStats& stats) const {
+    std::cout << fmt::format(
+                     "write {} columns, {} partition bits, {}, write buffer "
+                     "{}KB: {} rows, {} to {} in {} files in {}, {} writes, "
+                     "serialization {}, flush {}, io {}",
+                     config.numColumns,
+                     config.partitionBits,
+                     config.compressionKind,
+                     config.writeBufferKB,
+                     stats.spilledRows,
+                     succinctBytes(stats.spilledInputBytes),
+                     succinctBytes(stats.spilledBytes),
+                     stats.spilledFiles,
+                     succinctMicros(writeUs),
+                     stats.spillWrites,
+                     succinctMicros(stats.spillSerializationTimeUs),
+                     succinctMicros(stats.spillFlushTimeUs),
+                     succinctMicros(stats.spillWriteTimeUs))
+              << std::endl;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
+  std::shared_ptr<exec::test::TempDirectoryPath> tempDir_;
+  std::string spillRoot_;
+  std::shared_ptr<filesystems::FileSystem> fs_;
+  int32_t runId_{0};
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string kUsage(
+      "Writes and reads back spill files for each combination of compression "
+      "kind, buffer sizes, read-ahead depth, partition bits and row width "
+      "and reports the time spent in serialization, compression and IO.\n");
+  gflags::SetUsageMessage(kUsage);
+  folly::Init init{&argc, &argv, false};
+
+  SpillBenchmark benchmark;
+  benchmark.initialize();
+  benchmark.run();
+  return 0;
+}
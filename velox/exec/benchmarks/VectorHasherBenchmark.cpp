@@ -114,6 +114,86 @@ BENCHMARK_RELATIVE(computeValueIdsSmallintWithNulls) {
   benchmarkComputeValueIds<int16_t>(true);
 }
 
+// Computes the value ids of two keys in range mode. The ids of the second key
+// are multiplied by the range of the first and added to them.
+template <typename T>
+void benchmarkComputeValueIdsTwoKeys() {
+  folly::BenchmarkSuspender suspender;
+  vector_size_t size = 1'000;
+  BenchmarkBase base;
+  std::vector<VectorPtr> vectors = {
+      base.vectorMaker().flatVector<T>(
+          size, [](vector_size_t row) { return row % 17; }),
+      base.vectorMaker().flatVector<T>(
+          size, [](vector_size_t row) { return row % 5; })};
+
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  raw_vector<uint64_t> hashes(size);
+  SelectivityVector rows(size);
+  uint64_t multiplier = 1;
+  for (auto i = 0; i < vectors.size(); ++i) {
+    hashers.push_back(VectorHasher::create(CppToType<T>::create(), i));
+    hashers.back()->decode(*vectors[i], rows);
+    hashers.back()->computeValueIds(rows, hashes);
+    multiplier = hashers.back()->enableValueRange(multiplier, 0);
+  }
+  suspender.dismiss();
+
+  for (int i = 0; i < 10'000; i++) {
+    for (auto j = 0; j < vectors.size(); ++j) {
+      hashers[j]->decode(*vectors[j], rows);
+      bool ok = hashers[j]->computeValueIds(rows, hashes);
+      folly::doNotOptimizeAway(ok);
+    }
+  }
+}
+
+template <typename T>
+void benchmarkHash(bool withNulls) {
+  folly::BenchmarkSuspender suspender;
+  vector_size_t size = 1'000;
+  BenchmarkBase base;
+  VectorHasher hasher(CppToType<T>::create(), 0);
+  auto values = base.vectorMaker().flatVector<T>(
+      size,
+      [](vector_size_t row) { return row * 31; },
+      withNulls ? test::VectorMaker::nullEvery(7) : nullptr);
+
+  raw_vector<uint64_t> hashes(size);
+  SelectivityVector rows(size);
+  suspender.dismiss();
+
+  for (int i = 0; i < 10'000; i++) {
+    hasher.decode(*values, rows);
+    hasher.hash(rows, false, hashes);
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+BENCHMARK(computeValueIdsBigintTwoKeys) {
+  benchmarkComputeValueIdsTwoKeys<int64_t>();
+}
+
+BENCHMARK(computeValueIdsIntegerTwoKeys) {
+  benchmarkComputeValueIdsTwoKeys<int32_t>();
+}
+
+BENCHMARK(hashBigintNoNulls) {
+  benchmarkHash<int64_t>(false);
+}
+
+BENCHMARK_RELATIVE(hashBigintWithNulls) {
+  benchmarkHash<int64_t>(true);
+}
+
+BENCHMARK(hashIntegerNoNulls) {
+  benchmarkHash<int32_t>(false);
+}
+
+BENCHMARK_RELATIVE(hashIntegerWithNulls) {
+  benchmarkHash<int32_t>(true);
+}
+
 void benchmarkComputeValueIdsForStrings(bool flattenDictionaries) {
   folly::BenchmarkSuspender suspender;
   BenchmarkBase base;
@@ -22,6 +22,8 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/HugeInt.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
 
@@ -34,7 +36,8 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, int128_t, float, double, Timestamp). Strings are encoded by
+  /// encodeString().
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
@@ -54,10 +57,37 @@ class PrefixSortEncoder {
   }
 
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
+  /// int32_t, int128_t, float, double, Timestamp. TODO Add support for int16_t,
+  /// uint16_t.
   template <typename T>
   FOLLY_ALWAYS_INLINE void encodeNoNulls(T value, char* dest) const;
 
+  /// Encodes the first 'prefixLength' bytes of a string into 1 + 'prefixLength'
+  /// bytes, with the null byte first like encode(). A string shorter than
+  /// 'prefixLength' is padded with zeros. Comparing the encoded bytes gives
+  /// the order of the strings by their unsigned bytes if the prefixes differ.
+  /// If they are equal, the strings may still differ after the prefix or in
+  /// trailing zeros, so the caller must compare the full strings.
+  FOLLY_ALWAYS_INLINE void encodeString(
+      std::optional<StringView> value,
+      uint32_t prefixLength,
+      char* dest) const {
+    if (!value.has_value()) {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, prefixLength);
+      return;
+    }
+    dest[0] = nullsFirst_ ? 1 : 0;
+    const auto size = std::min<uint32_t>(value->size(), prefixLength);
+    std::memcpy(dest + 1, value->data(), size);
+    simd::memset(dest + 1 + size, 0, prefixLength - size);
+    if (!ascending_) {
+      for (auto i = 1; i <= prefixLength; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   bool isAscending() const {
     return ascending_;
   }
@@ -86,11 +116,26 @@ class PrefixSortEncoder {
       case ::facebook::velox::TypeKind::TIMESTAMP: {
         return 17;
       }
+      case ::facebook::velox::TypeKind::HUGEINT: {
+        return 17;
+      }
       default:
         return std::nullopt;
     }
   }
 
+  /// Returns the encoded size of a string key with a prefix of
+  /// 'prefixLength' bytes, assume nullable.
+  FOLLY_ALWAYS_INLINE static uint32_t encodedStringSize(
+      uint32_t prefixLength) {
+    return 1 + prefixLength;
+  }
+
+  /// Returns true if 'typeKind' is encoded by encodeString().
+  FOLLY_ALWAYS_INLINE static bool isStringKind(TypeKind typeKind) {
+    return typeKind == TypeKind::VARCHAR || typeKind == TypeKind::VARBINARY;
+  }
+
  private:
   const bool ascending_;
   const bool nullsFirst_;
@@ -147,6 +192,17 @@ FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
   encodeNoNulls((uint64_t)(value ^ (1ull << 63)), dest);
 }
 
+/// The high 64 bits are compared as a signed integer, then the low 64 bits as
+/// an unsigned integer. Long decimals of the same type compare like their
+/// unscaled int128_t values.
+template <>
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
+    int128_t value,
+    char* dest) const {
+  encodeNoNulls(static_cast<int64_t>(HugeInt::upper(value)), dest);
+  encodeNoNulls(HugeInt::lower(value), dest + 8);
+}
+
 namespace detail {
 /// Convert double to a uint64_t, their value comparison semantics remain
 /// consistent.
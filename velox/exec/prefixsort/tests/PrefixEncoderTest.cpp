@@ -337,6 +337,86 @@ TEST_F(PrefixEncoderTest, compare) {
   testCompare<Timestamp>();
 }
 
+TEST_F(PrefixEncoderTest, encodeString) {
+  constexpr uint32_t kPrefixLength = 4;
+  const auto encodedSize =
+      PrefixSortEncoder::encodedStringSize(kPrefixLength);
+  ASSERT_EQ(encodedSize, 5);
+
+  auto encode = [&](const PrefixSortEncoder& encoder,
+                    std::optional<StringView> value) {
+    std::string encoded(encodedSize, '\xff');
+    encoder.encodeString(value, kPrefixLength, encoded.data());
+    return encoded;
+  };
+
+  ASSERT_EQ(
+      encode(ascNullsFirstEncoder_, StringView("abc")),
+      std::string("\x01" "abc" "\x00", 5));
+  ASSERT_EQ(
+      encode(ascNullsLastEncoder_, StringView("abcdef")),
+      std::string("\x00" "abcd", 5));
+  ASSERT_EQ(
+      encode(descNullsFirstEncoder_, StringView("ab")),
+      std::string("\x01\x9e\x9d\xff\xff", 5));
+  ASSERT_EQ(
+      encode(ascNullsFirstEncoder_, std::nullopt), std::string(5, '\0'));
+  ASSERT_EQ(
+      encode(ascNullsLastEncoder_, std::nullopt),
+      std::string("\x01\x00\x00\x00\x00", 5));
+
+  // Prefixes that differ give the order of the strings.
+  const std::vector<std::string> ordered = {"", "a", "ab", "abc", "abd", "b"};
+  for (const auto* encoder :
+       {&ascNullsFirstEncoder_, &descNullsFirstEncoder_}) {
+    for (auto i = 1; i < ordered.size(); ++i) {
+      const auto left = encode(*encoder, StringView(ordered[i - 1]));
+      const auto right = encode(*encoder, StringView(ordered[i]));
+      const auto result =
+          std::memcmp(left.data(), right.data(), encodedSize);
+      if (encoder->isAscending()) {
+        ASSERT_LT(result, 0);
+      } else {
+        ASSERT_GT(result, 0);
+      }
+    }
+  }
+
+  // Strings that differ after the prefix or in trailing zeros tie.
+  ASSERT_EQ(
+      encode(ascNullsFirstEncoder_, StringView("abcdx")),
+      encode(ascNullsFirstEncoder_, StringView("abcdy")));
+  ASSERT_EQ(
+      encode(ascNullsFirstEncoder_, StringView("ab")),
+      encode(ascNullsFirstEncoder_, StringView(std::string("ab\0", 3))));
+}
+
+TEST_F(PrefixEncoderTest, encodeHugeint) {
+  const std::vector<int128_t> ordered = {
+      HugeInt::build(1ULL << 63, 0),
+      HugeInt::build(-1, 0),
+      -1,
+      0,
+      1,
+      HugeInt::build(1, 0),
+      HugeInt::build(~(1ULL << 63), ~0ULL)};
+  for (const auto* encoder :
+       {&ascNullsFirstEncoder_, &descNullsFirstEncoder_}) {
+    for (auto i = 1; i < ordered.size(); ++i) {
+      char left[sizeof(int128_t)];
+      char right[sizeof(int128_t)];
+      encoder->encodeNoNulls(ordered[i - 1], left);
+      encoder->encodeNoNulls(ordered[i], right);
+      const auto result = std::memcmp(left, right, sizeof(int128_t));
+      if (encoder->isAscending()) {
+        ASSERT_LT(result, 0);
+      } else {
+        ASSERT_GT(result, 0);
+      }
+    }
+  }
+}
+
 TEST_F(PrefixEncoderTest, fuzzyInteger) {
   testFuzz<TypeKind::INTEGER>();
 }
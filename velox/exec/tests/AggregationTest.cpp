@@ -955,6 +955,94 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationResumeAfterAbandon) {
+  // The first two batches have unique keys, the rest have only 10 keys.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    const int32_t offset = i * 1'000;
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000,
+            [&](auto row) { return i < 2 ? offset + row : row % 10; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId partialAggNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                  .capturePlanNodeId(partialAggNodeId)
+                  .finalAggregation()
+                  .planNode();
+  const std::string duckDbSql =
+      "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0";
+
+  for (const int64_t retryRows : {0, 1'000}) {
+    SCOPED_TRACE(fmt::format("retryRows: {}", retryRows));
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, 100)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 50)
+            .config(QueryConfig::kAbandonPartialAggregationRetryRows, retryRows)
+            .config("max_drivers_per_task", 1)
+            .plan(plan)
+            .assertResults(duckDbSql);
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(partialAggNodeId).customStats;
+    ASSERT_EQ(1, runtimeStats.at("abandonedPartialAggregation").sum);
+    if (retryRows == 0) {
+      ASSERT_EQ(0, runtimeStats.count("resumedPartialAggregation"));
+    } else {
+      ASSERT_EQ(1, runtimeStats.at("resumedPartialAggregation").sum);
+    }
+  }
+}
+
+TEST_F(AggregationTest, partialAggregationClusteredInput) {
+  // c0 is clustered, each value shows up in a run of 10 rows. c1 repeats its
+  // values in every batch.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    const int32_t offset = i * 1'000;
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (offset + row) / 10; }),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 100; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto& key : {"c0", "c1"}) {
+    SCOPED_TRACE(key);
+    core::PlanNodeId partialAggNodeId;
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .partialAggregation({key}, {"sum(c2)", "count(1)"})
+                    .capturePlanNodeId(partialAggNodeId)
+                    .finalAggregation()
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kPartialAggregationDetectClusteredInput, true)
+            .config("max_drivers_per_task", 1)
+            .plan(plan)
+            .assertResults(fmt::format(
+                "SELECT {0}, sum(c2), count(1) FROM tmp GROUP BY {0}", key));
+    const auto planStats = toPlanStats(task->taskStats());
+    const auto& runtimeStats = planStats.at(partialAggNodeId).customStats;
+    if (std::string(key) == "c0") {
+      ASSERT_EQ(1, runtimeStats.at("clusteredInput").sum);
+      // Groups are output as the keys change, so no group is output twice.
+      ASSERT_EQ(1'000, planStats.at(partialAggNodeId).outputRows);
+    } else {
+      ASSERT_EQ(0, runtimeStats.count("clusteredInput"));
+    }
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1172,6 +1260,125 @@ TEST_F(AggregationTest, spillAll) {
   }
 }
 
+TEST_F(AggregationTest, hashPartitionedSpill) {
+  auto inputs = makeVectors(rowType_, 1024, 10);
+  createDuckDbTable(inputs);
+
+  core::PlanNodeId aggrNodeId;
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation(
+                      {"c0", "c2"}, {"sum(c1)", "count(c3)", "max(c6)"})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  const auto duckDbSql =
+      "SELECT c0, c2, sum(c1), count(c3), max(c6) FROM tmp GROUP BY 1, 2";
+
+  for (int maxSpillLevel : {0, 1, 3}) {
+    SCOPED_TRACE(fmt::format("maxSpillLevel: {}", maxSpillLevel));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(tempDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillHashPartitioned, true)
+            .config(QueryConfig::kMaxSpillLevel, maxSpillLevel)
+            .assertResults(duckDbSql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.customStats[Operator::kSpillRuns].count, 0);
+    // The spilled groups are hash partitioned, not sorted.
+    ASSERT_EQ(stats.customStats[Operator::kSpillSortTime].sum, 0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
+TEST_F(AggregationTest, hashPartitionedSpillDistinctInputs) {
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 10; ++i) {
+    inputs.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'024, [](auto row) { return row % 17; }),
+        makeFlatVector<int32_t>(
+            1'024,
+            [](auto row) { return row % 31; },
+            [](auto row) { return row % 101 == 0; }),
+        makeFlatVector<std::string>(
+            1'024, [](auto row) { return std::string(row % 13, 'x'); }),
+    }));
+  }
+  createDuckDbTable(inputs);
+
+  core::PlanNodeId aggrNodeId;
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation(
+                      {"c0"},
+                      {"count(distinct c1)",
+                       "sum(distinct c1)",
+                       "count(distinct c2)",
+                       "sum(c1)"})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  const auto duckDbSql =
+      "SELECT c0, count(distinct c1), sum(distinct c1), count(distinct c2), "
+      "sum(c1) FROM tmp GROUP BY 1";
+
+  for (int maxSpillLevel : {0, 3}) {
+    SCOPED_TRACE(fmt::format("maxSpillLevel: {}", maxSpillLevel));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(tempDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillHashPartitioned, true)
+            .config(QueryConfig::kMaxSpillLevel, maxSpillLevel)
+            .assertResults(duckDbSql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    ASSERT_GT(stats.spilledRows, 0);
+    // Only the groups are spilled, each with its de-duplicated inputs.
+    ASSERT_LT(stats.spilledRows, 10 * 1'024);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+
+  // Without hash partitioned spill, aggregations over distinct inputs don't
+  // spill.
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(tempDirectory->getPath())
+                  .config(QueryConfig::kSpillEnabled, true)
+                  .config(QueryConfig::kAggregationSpillEnabled, true)
+                  .assertResults(duckDbSql);
+  ASSERT_EQ(exec::toPlanStats(task->taskStats()).at(aggrNodeId).spilledRows, 0);
+
+  // Aggregations over sorted inputs use the sorted spill, so aggregations over
+  // distinct inputs next to them don't spill even with hash partitioned spill.
+  plan = PlanBuilder()
+             .values(inputs)
+             .singleAggregation(
+                 {"c0"}, {"count(distinct c1)", "array_agg(c2 ORDER BY c2)"})
+             .capturePlanNodeId(aggrNodeId)
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .spillDirectory(tempDirectory->getPath())
+             .config(QueryConfig::kSpillEnabled, true)
+             .config(QueryConfig::kAggregationSpillEnabled, true)
+             .config(QueryConfig::kAggregationSpillHashPartitioned, true)
+             .assertResults(
+                 "SELECT c0, count(distinct c1), array_agg(c2 ORDER BY c2) "
+                 "FROM tmp GROUP BY 1");
+  ASSERT_EQ(exec::toPlanStats(task->taskStats()).at(aggrNodeId).spilledRows, 0);
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -1325,6 +1532,88 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data, data});
+
+  const std::vector<std::string> aggregates = {
+      "count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"};
+
+  // Rollup.
+  auto plan =
+      PlanBuilder()
+          .values({data, data})
+          .groupingSetsAggregation({{"k1", "k2"}, {"k1"}, {}}, aggregates)
+          .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+          .planNode();
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
+
+  // Cube.
+  plan = PlanBuilder()
+             .values({data, data})
+             .groupingSetsAggregation(
+                 {{"k1", "k2"}, {"k1"}, {"k2"}, {}}, aggregates)
+             .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+             .planNode();
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY CUBE (k1, k2)");
+
+  // The global grouping set produces a row for empty input.
+  auto emptyPlan = PlanBuilder()
+                       .values({data})
+                       .filter("a < 0")
+                       .groupingSetsAggregation({{"k1"}, {}}, aggregates)
+                       .project({"k1", "count_1", "sum_a", "max_b"})
+                       .planNode();
+  assertQuery(
+      emptyPlan,
+      "SELECT k1, count(1), sum(a), max(b) FROM tmp WHERE a < 0 "
+      "GROUP BY GROUPING SETS ((k1), ())");
+
+  // The final aggregation spills.
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(tempDirectory->getPath())
+                  .config(QueryConfig::kSpillEnabled, true)
+                  .config(QueryConfig::kAggregationSpillEnabled, true)
+                  .assertResults(
+                      "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp "
+                      "GROUP BY CUBE (k1, k2)");
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+
+  // The GroupIdNode replicates the groups of the finest grouping set rather
+  // than the input rows.
+  core::PlanNodeId aggregationId;
+  plan = PlanBuilder()
+             .values({data, data})
+             .groupingSetsAggregation({{"k1", "k2"}, {"k1"}, {}}, aggregates)
+             .capturePlanNodeId(aggregationId)
+             .planNode();
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(aggregationId).inputRows, 3 * 11 * 17);
+
+  VELOX_ASSERT_THROW(
+      PlanBuilder()
+          .values({data})
+          .groupingSetsAggregation({{"k1"}, {}}, {"count(distinct a)"}),
+      "Grouping sets aggregation doesn't support DISTINCT, masks or ORDER BY");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -3707,4 +3996,109 @@ TEST_F(AggregationTest, nanKeys) {
       {makeRowVector({e0, e1}), e1});
 }
 
+TEST_F(AggregationTest, topNPruning) {
+  // 1'000 groups. c1 decreases and c2 increases over the input, so once the
+  // threshold is known the later rows can't enter the top 10 of max(c1) or
+  // min(c2). Nulls in c2 are spread so that no group is all nulls.
+  constexpr int32_t kBatchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 30; ++i) {
+    const int64_t offset = i * kBatchSize;
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(kBatchSize, [](auto row) { return row; }),
+        makeFlatVector<int64_t>(
+            kBatchSize, [&](auto row) { return -(offset + row); }),
+        makeFlatVector<int64_t>(
+            kBatchSize,
+            [&](auto row) { return offset + row; },
+            [&](auto row) { return (offset + row) % 7 == 0; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  struct {
+    std::string aggregate;
+    std::string order;
+    std::string duckDbSql;
+  } testSettings[] = {
+      {"max(c1)",
+       "a0 DESC",
+       "SELECT c0, max(c1) FROM tmp GROUP BY 1 ORDER BY 2 DESC LIMIT 10"},
+      {"min(c2)",
+       "a0",
+       "SELECT c0, min(c2) FROM tmp GROUP BY 1 ORDER BY 2 LIMIT 10"},
+      {"min(c2)",
+       "a0 ASC NULLS FIRST",
+       "SELECT c0, min(c2) FROM tmp GROUP BY 1 ORDER BY 2 NULLS FIRST LIMIT 10"},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.aggregate + " " + testData.order);
+    core::PlanNodeId aggNodeId;
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation({"c0"}, {testData.aggregate})
+                    .capturePlanNodeId(aggNodeId)
+                    .topN({testData.order}, 10, false)
+                    .planNode();
+    auto task = assertQuery(plan, testData.duckDbSql);
+    const auto& runtimeStats =
+        toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+    ASSERT_EQ(1, runtimeStats.count("topNPrunedRows"));
+    ASSERT_LT(0, runtimeStats.at("topNPrunedRows").sum);
+  }
+
+  // Sums can still grow past the threshold, so they are not pruned.
+  core::PlanNodeId aggNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, {"sum(c2)"})
+                  .capturePlanNodeId(aggNodeId)
+                  .topN({"a0 DESC"}, 10, false)
+                  .planNode();
+  auto task = assertQuery(
+      plan, "SELECT c0, sum(c2) FROM tmp GROUP BY 1 ORDER BY 2 DESC LIMIT 10");
+  ASSERT_EQ(
+      0,
+      toPlanStats(task->taskStats())
+          .at(aggNodeId)
+          .customStats.count("topNPrunedRows"));
+
+  // The rows dropped for max(c1) would be missing from the other aggregates of
+  // the top 10 groups, so nothing is pruned.
+  plan = PlanBuilder()
+             .values(vectors)
+             .singleAggregation(
+                 {"c0"}, {"max(c1)", "count(1)", "sum(c2)", "min(c1)"})
+             .capturePlanNodeId(aggNodeId)
+             .topN({"a0 DESC"}, 10, false)
+             .planNode();
+  task = assertQuery(
+      plan,
+      "SELECT c0, max(c1), count(1), sum(c2), min(c1) FROM tmp GROUP BY 1 "
+      "ORDER BY 2 DESC LIMIT 10");
+  ASSERT_EQ(
+      0,
+      toPlanStats(task->taskStats())
+          .at(aggNodeId)
+          .customStats.count("topNPrunedRows"));
+
+  // The same max twice is still pruned.
+  plan = PlanBuilder()
+             .values(vectors)
+             .singleAggregation({"c0"}, {"max(c1)", "max(c1)"})
+             .capturePlanNodeId(aggNodeId)
+             .topN({"a0 DESC"}, 10, false)
+             .planNode();
+  task = assertQuery(
+      plan,
+      "SELECT c0, max(c1), max(c1) FROM tmp GROUP BY 1 "
+      "ORDER BY 2 DESC LIMIT 10");
+  ASSERT_LT(
+      0,
+      toPlanStats(task->taskStats())
+          .at(aggNodeId)
+          .customStats.at("topNPrunedRows")
+          .sum);
+}
+
 } // namespace facebook::velox::exec::test
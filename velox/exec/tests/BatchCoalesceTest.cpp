@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+class BatchCoalesceTest : public OperatorTestBase {
+ protected:
+  // Max wait for coalescing that is not reached in the tests.
+  static constexpr const char* kNoWaitLimit = "1000000";
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    for (int32_t i = 0; i < 10; ++i) {
+      vectors_.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              1'000, [&](auto row) { return i * 1'000 + row; }),
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+      }));
+    }
+    createDuckDbTable(vectors_);
+  }
+
+  std::vector<RowVectorPtr> vectors_;
+};
+
+TEST_F(BatchCoalesceTest, beforeAggregation) {
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .values(vectors_)
+                  .filter("c0 % 100 = 0")
+                  .capturePlanNodeId(filterId)
+                  .singleAggregation({"c1"}, {"sum(c0)"})
+                  .planNode();
+  for (const auto enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled {}", enabled));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kAdaptiveOutputBatchSizeEnabled,
+                enabled ? "true" : "false")
+            .config(core::QueryConfig::kBatchCoalesceMaxWaitMs, kNoWaitLimit)
+            .assertResults(
+                "SELECT c1, sum(c0) FROM tmp WHERE c0 % 100 = 0 GROUP BY 1");
+    auto planStats = toPlanStats(task->taskStats()).at(filterId);
+    if (!enabled) {
+      ASSERT_EQ(0, planStats.operatorStats.count("BatchCoalesce"));
+      continue;
+    }
+    // The 10 rows passing the filter in each batch are passed on in one
+    // batch at the end.
+    const auto& customStats = planStats.customStats;
+    ASSERT_EQ(10, customStats.at("coalescedBatches").sum);
+    ASSERT_EQ(1, customStats.at("coalescedBatchRows").count);
+    ASSERT_EQ(100, customStats.at("coalescedBatchRows").sum);
+    ASSERT_EQ(1, planStats.operatorStats.at("BatchCoalesce")->outputVectors);
+  }
+}
+
+TEST_F(BatchCoalesceTest, beforeHashJoin) {
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(7, [](auto row) { return row; }),
+          makeFlatVector<int64_t>(7, [](auto row) { return row * 10; }),
+      });
+  createDuckDbTable("u", {build});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeFilterId;
+  core::PlanNodeId buildFilterId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(vectors_)
+                  .filter("c0 % 100 = 0")
+                  .capturePlanNodeId(probeFilterId)
+                  .hashJoin(
+                      {"c1"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build, build, build})
+                          .filter("u0 < 3")
+                          .capturePlanNodeId(buildFilterId)
+                          .planNode(),
+                      "",
+                      {"c0", "u1"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kAdaptiveOutputBatchSizeEnabled, "true")
+          .config(core::QueryConfig::kBatchCoalesceMaxWaitMs, kNoWaitLimit)
+          .assertResults(
+              "SELECT c0, u1 FROM tmp, (SELECT * FROM u UNION ALL "
+              "SELECT * FROM u UNION ALL SELECT * FROM u) "
+              "WHERE c1 = u0 AND c0 % 100 = 0 AND u0 < 3");
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      10, planStats.at(probeFilterId).customStats.at("coalescedBatches").sum);
+  // The build side filter passes 3 of 7 rows, which is above the selectivity
+  // threshold.
+  ASSERT_EQ(
+      0, planStats.at(buildFilterId).customStats.count("coalescedBatches"));
+  ASSERT_EQ(
+      3,
+      planStats.at(buildFilterId)
+          .operatorStats.at("BatchCoalesce")
+          ->outputVectors);
+}
+
+TEST_F(BatchCoalesceTest, passThrough) {
+  // Half of the rows pass the filter, so batches are passed on unchanged.
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .values(vectors_)
+                  .filter("c0 % 2 = 0")
+                  .capturePlanNodeId(filterId)
+                  .singleAggregation({"c1"}, {"count(1)"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kAdaptiveOutputBatchSizeEnabled, "true")
+          .assertResults(
+              "SELECT c1, count(1) FROM tmp WHERE c0 % 2 = 0 GROUP BY 1");
+  auto planStats = toPlanStats(task->taskStats()).at(filterId);
+  ASSERT_EQ(0, planStats.customStats.count("coalescedBatches"));
+  ASSERT_EQ(10, planStats.operatorStats.at("BatchCoalesce")->outputVectors);
+}
+
+TEST_F(BatchCoalesceTest, maxWait) {
+  // With no wait, each small batch is passed on by itself.
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .values(vectors_)
+                  .filter("c0 % 100 = 0")
+                  .capturePlanNodeId(filterId)
+                  .singleAggregation({"c1"}, {"count(1)"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kAdaptiveOutputBatchSizeEnabled, "true")
+          .config(core::QueryConfig::kBatchCoalesceMaxWaitMs, "0")
+          .assertResults(
+              "SELECT c1, count(1) FROM tmp WHERE c0 % 100 = 0 GROUP BY 1");
+  const auto& customStats =
+      toPlanStats(task->taskStats()).at(filterId).customStats;
+  ASSERT_EQ(10, customStats.at("coalescedBatches").sum);
+  ASSERT_EQ(10, customStats.at("coalescedBatchRows").count);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DriverExecutor.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <fmt/format.h>
+
+namespace facebook::velox::exec {
+namespace {
+
+void spinFor(std::chrono::microseconds duration) {
+  const auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+DriverExecutor::Options makeOptions(
+    int32_t numThreads,
+    std::vector<uint64_t> levelThresholdsMs = {1'000, 10'000}) {
+  DriverExecutor::Options options;
+  options.numThreads = numThreads;
+  options.levelThresholdsMs = std::move(levelThresholdsMs);
+  return options;
+}
+
+TEST(DriverExecutorTest, runAll) {
+  std::atomic_int32_t numRuns{0};
+  {
+    DriverExecutor executor(makeOptions(4));
+    for (auto i = 0; i < 1'000; ++i) {
+      if (i % 2 == 0) {
+        executor.add([&]() { ++numRuns; });
+      } else {
+        executor.add(
+            fmt::format("query{}", i % 5), i % 3, [&]() { ++numRuns; });
+      }
+    }
+    // The destructor runs the queued work.
+  }
+  EXPECT_EQ(1'000, numRuns);
+}
+
+TEST(DriverExecutorTest, levels) {
+  DriverExecutor executor(makeOptions(1, {10, 50}));
+  EXPECT_EQ(3, executor.numLevels());
+  EXPECT_EQ(0, executor.queryLevel("long"));
+
+  std::atomic_bool done{false};
+  executor.add("long", 0, [&]() {
+    spinFor(std::chrono::milliseconds(20));
+    done = true;
+  });
+  while (!done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // The run is charged after the function returns.
+  while (executor.stats().levels[0].numRuns == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(1, executor.queryLevel("long"));
+  EXPECT_EQ(0, executor.queryLevel("short"));
+}
+
+// A query that has used a lot of time yields the thread to a new one.
+TEST(DriverExecutorTest, fairShare) {
+  DriverExecutor executor(makeOptions(1, {20}));
+
+  // Simulates a query with many drivers that yield after each time slice and
+  // are enqueued again.
+  std::atomic_int32_t numLongRuns{0};
+  std::atomic_bool stop{false};
+  std::function<void()> longDriver = [&]() {
+    spinFor(std::chrono::milliseconds(1));
+    ++numLongRuns;
+    if (!stop) {
+      executor.add("long", 0, longDriver);
+    }
+  };
+  for (auto i = 0; i < 20; ++i) {
+    executor.add("long", 0, longDriver);
+  }
+  // The runs added before the query reached level 1 stay on level 0. Waits
+  // for them to finish, which they do while level 1 runs as long.
+  while (executor.stats().levels[1].numRuns < 60) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(1, executor.queryLevel("long"));
+
+  // Each run of the short query is queued behind at most the runs already
+  // picked before it was added.
+  for (auto i = 0; i < 10; ++i) {
+    std::atomic_int32_t longRunsAtStart{-1};
+    const auto longRunsAtAdd = numLongRuns.load();
+    executor.add("short", 0, [&]() { longRunsAtStart = numLongRuns.load(); });
+    while (longRunsAtStart < 0) {
+      std::this_thread::yield();
+    }
+    EXPECT_LE(longRunsAtStart - longRunsAtAdd, 2);
+  }
+  stop = true;
+
+  const auto stats = executor.stats();
+  ASSERT_EQ(2, stats.levels.size());
+  EXPECT_GE(stats.levels[0].numRuns, 10);
+  EXPECT_GT(stats.levels[1].numRuns, 0);
+  EXPECT_GT(stats.levels[1].cpuNanos, 0);
+  EXPECT_EQ(0, stats.numSteals);
+}
+
+TEST(DriverExecutorTest, steal) {
+  DriverExecutor executor(makeOptions(4));
+  std::atomic_int32_t numRuns{0};
+  // All work prefers the first thread and the others steal it.
+  for (auto i = 0; i < 100; ++i) {
+    executor.add("query", 0, [&]() {
+      spinFor(std::chrono::microseconds(500));
+      ++numRuns;
+    });
+  }
+  while (numRuns < 100) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_GT(executor.stats().numSteals, 0);
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -13,9 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/executors/ManualExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -428,6 +430,189 @@ TEST_F(ExchangeClientTest, sourceTimeout) {
   client->close();
 }
 
+TEST_F(ExchangeClientTest, inProcessExchangeSource) {
+  auto& factories = ExchangeSource::factories();
+  factories.insert(
+      factories.begin(),
+      InProcessExchangeSource::factory(
+          [](const std::string& location) -> std::optional<std::string> {
+            if (location.rfind("inproc://", 0) != 0) {
+              return std::nullopt;
+            }
+            return location.substr(9);
+          }));
+
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .partitionedOutput({"c0"}, 100)
+                  .planNode();
+  const std::string taskId = "inproc.t1";
+  auto task = makeTask(taskId, plan);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 1);
+
+  auto client = std::make_shared<ExchangeClient>(
+      "t", 17, ExchangeClient::kDefaultMaxQueuedBytes, pool(), executor());
+  client->addRemoteTaskId("inproc://" + taskId);
+  client->noMoreRemoteTasks();
+
+  std::vector<const uint8_t*> pageData;
+  for (auto i = 0; i < 3; ++i) {
+    auto page = toSerializedPage(data);
+    pageData.push_back(page->getIOBuf()->data());
+    ContinueFuture unused;
+    ASSERT_FALSE(
+        bufferManager_->enqueue(taskId, 17, std::move(page), &unused));
+  }
+  bufferManager_->noMoreData(taskId);
+
+  // The consumer gets the pages of the producer without a copy.
+  auto pages = fetchPages(*client, 3);
+  for (auto i = 0; i < pages.size(); ++i) {
+    ASSERT_EQ(pageData[i], pages[i]->getIOBuf()->data());
+  }
+
+  bool atEnd;
+  ContinueFuture future;
+  pages = client->next(1, &atEnd, &future);
+  if (!atEnd) {
+    auto& exec = folly::QueuedImmediateExecutor::instance();
+    std::move(future).via(&exec).wait();
+    pages = client->next(1, &atEnd, &future);
+  }
+  ASSERT_TRUE(pages.empty());
+  ASSERT_TRUE(atEnd);
+
+  const auto stats = client->stats();
+  ASSERT_EQ(3, stats.at(InProcessExchangeSource::kNumPages).sum);
+  ASSERT_EQ(0, stats.count(ExchangeClient::kBackgroundCpuTimeMs));
+
+  pages.clear();
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+  client->close();
+}
+
+// ExchangeSource that has a fixed set of pages buffered and records the
+// order in which its data is requested. The data requests complete on close.
+class BufferedPagesExchangeSource : public ExchangeSource {
+ public:
+  BufferedPagesExchangeSource(
+      const std::string& taskId,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool,
+      std::vector<int64_t> remainingBytes,
+      std::vector<std::string>& requestedTaskIds)
+      : ExchangeSource(taskId, 0, std::move(queue), pool),
+        remainingBytes_(std::move(remainingBytes)),
+        requestedTaskIds_(requestedTaskIds) {}
+
+  bool shouldRequestLocked() override {
+    return !requestPending_.exchange(true);
+  }
+
+  folly::SemiFuture<Response> request(
+      uint32_t /*maxBytes*/,
+      std::chrono::microseconds /*maxWait*/) override {
+    requestedTaskIds_.push_back(taskId_);
+    promise_ = VeloxPromise<Response>("BufferedPagesExchangeSource::request");
+    return promise_.getSemiFuture();
+  }
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds /*maxWait*/) override {
+    requestPending_ = false;
+    return folly::makeSemiFuture(Response{0, false, remainingBytes_});
+  }
+
+  void close() override {
+    if (promise_.valid() && !promise_.isFulfilled()) {
+      promise_.setValue(Response{0, true, {}});
+    }
+  }
+
+ private:
+  const std::vector<int64_t> remainingBytes_;
+  std::vector<std::string>& requestedTaskIds_;
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+};
+
+TEST_F(ExchangeClientTest, largestRemainingBytesFirst) {
+  const std::unordered_map<std::string, std::vector<int64_t>> sources = {
+      {"a", {100}}, {"b", {400, 200}}, {"c", {300}}};
+  std::vector<std::string> requestedTaskIds;
+  ExchangeSource::factories().clear();
+  ExchangeSource::registerFactory(
+      [&](const auto& taskId, auto /*destination*/, auto queue, auto pool)
+          -> std::shared_ptr<ExchangeSource> {
+        return std::make_shared<BufferedPagesExchangeSource>(
+            taskId, queue, pool, sources.at(taskId), requestedTaskIds);
+      });
+
+  folly::ManualExecutor executor;
+  auto client =
+      std::make_shared<ExchangeClient>("t", 0, 1'000, pool(), &executor);
+  for (const auto& taskId : {"a", "b", "c"}) {
+    client->addRemoteTaskId(taskId);
+  }
+  client->noMoreRemoteTasks();
+
+  // Fill up the queue so that the data sizes of all sources are known before
+  // any data is requested.
+  enqueue(*client->queue(), makePage(2'000));
+  executor.drain();
+  ASSERT_TRUE(requestedTaskIds.empty());
+
+  bool atEnd;
+  ContinueFuture future;
+  auto pages = client->next(1, &atEnd, &future);
+  ASSERT_EQ(1, pages.size());
+  ASSERT_EQ(
+      requestedTaskIds, (std::vector<std::string>{"b", "c", "a"}));
+
+  client->close();
+  executor.drain();
+}
+
+TEST_F(ExchangeClientTest, setMaxQueuedBytes) {
+  const std::unordered_map<std::string, std::vector<int64_t>> sources = {
+      {"a", {300}}, {"b", {400, 200}}};
+  std::vector<std::string> requestedTaskIds;
+  ExchangeSource::factories().clear();
+  ExchangeSource::registerFactory(
+      [&](const auto& taskId, auto /*destination*/, auto queue, auto pool)
+          -> std::shared_ptr<ExchangeSource> {
+        return std::make_shared<BufferedPagesExchangeSource>(
+            taskId, queue, pool, sources.at(taskId), requestedTaskIds);
+      });
+
+  folly::ManualExecutor executor;
+  auto client =
+      std::make_shared<ExchangeClient>("t", 0, 1'000, pool(), &executor);
+  for (const auto& taskId : {"a", "b"}) {
+    client->addRemoteTaskId(taskId);
+  }
+  client->noMoreRemoteTasks();
+  enqueue(*client->queue(), makePage(2'000));
+  executor.drain();
+  ASSERT_TRUE(requestedTaskIds.empty());
+
+  // Shrinking does not request data.
+  client->setMaxQueuedBytes(500);
+  ASSERT_EQ(client->maxQueuedBytes(), 500);
+  ASSERT_TRUE(requestedTaskIds.empty());
+
+  // Growing requests data for the added space right away.
+  client->setMaxQueuedBytes(2'500);
+  ASSERT_EQ(requestedTaskIds, (std::vector<std::string>{"b"}));
+  client->setMaxQueuedBytes(3'000);
+  ASSERT_EQ(requestedTaskIds, (std::vector<std::string>{"b", "a"}));
+
+  client->close();
+  executor.drain();
+}
+
 TEST_F(ExchangeClientTest, callNextAfterClose) {
   constexpr int32_t kNumSources = 3;
   common::testutil::TestValue::enable();
@@ -229,6 +229,36 @@ TEST_F(FilterProjectTest, filterProject) {
   assertQuery(plan, "SELECT c0, c1, c0 + c1 FROM tmp WHERE c1 % 10 > 0");
 }
 
+TEST_F(FilterProjectTest, sharedVectorPool) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+        makeFlatVector<std::string>(
+            100, [&](auto row) { return std::string(20 + row % 7, 'a' + i); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // The second projection releases the computed columns of the first one to
+  // the vector pool shared by both.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 * 2 AS a", "concat(c1, c1) AS b"})
+                  .filter("a % 3 > 0")
+                  .project({"a + 1", "length(b)"})
+                  .planNode();
+  for (const auto enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled {}", enabled));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kSharedVectorPoolEnabled,
+            enabled ? "true" : "false")
+        .assertResults(
+            "SELECT c0 * 2 + 1, length(c1) * 2 FROM tmp WHERE c0 * 2 % 3 > 0");
+  }
+}
+
 TEST_F(FilterProjectTest, dereference) {
   std::vector<RowVectorPtr> vectors;
   for (int32_t i = 0; i < 10; ++i) {
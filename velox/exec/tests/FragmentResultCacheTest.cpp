@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FragmentResultCache.h"
+
+#include <folly/io/IOBuf.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class FragmentResultCacheTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    FragmentResultCache::testingReset();
+    directory_ = TempDirectoryPath::create();
+  }
+
+  void TearDown() override {
+    FragmentResultCache::testingReset();
+    OperatorTestBase::TearDown();
+  }
+
+  FragmentResultCache* makeCache(uint64_t maxBytes = 1 << 20) {
+    FragmentResultCache::Config config;
+    config.directory = directory_->getPath();
+    config.maxBytes = maxBytes;
+    config.maxEntryBytes = maxBytes;
+    FragmentResultCache::init(config);
+    return FragmentResultCache::instance();
+  }
+
+  RowVectorPtr makeVector(int32_t size, int64_t start = 0) {
+    return makeRowVector(
+        {makeFlatVector<int64_t>(size, [&](auto row) { return start + row; }),
+         makeFlatVector<std::string>(
+             size, [](auto row) { return std::string(row % 30, 'x'); })});
+  }
+
+  // Returns 'vectors' serialized into one entry.
+  std::unique_ptr<folly::IOBuf> serialize(
+      const std::vector<RowVectorPtr>& vectors) {
+    std::unique_ptr<folly::IOBuf> data;
+    for (const auto& vector : vectors) {
+      auto serialized = FragmentResultCache::serialize(vector, pool());
+      if (data == nullptr) {
+        data = std::move(serialized);
+      } else {
+        data->prependChain(std::move(serialized));
+      }
+    }
+    return data;
+  }
+
+  std::shared_ptr<TempDirectoryPath> directory_;
+};
+
+TEST_F(FragmentResultCacheTest, putAndGet) {
+  auto* cache = makeCache();
+  const std::vector<RowVectorPtr> vectors = {
+      makeVector(100), makeVector(10, 100)};
+  const auto type = asRowType(vectors[0]->type());
+
+  EXPECT_FALSE(cache->get("key", type, pool()).has_value());
+  cache->put("key", *serialize(vectors));
+  cache->put("empty", folly::IOBuf());
+
+  auto cached = cache->get("key", type, pool());
+  ASSERT_TRUE(cached.has_value());
+  ASSERT_EQ(cached->size(), 2);
+  for (auto i = 0; i < vectors.size(); ++i) {
+    facebook::velox::test::assertEqualVectors(vectors[i], (*cached)[i]);
+  }
+  cached = cache->get("empty", type, pool());
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_TRUE(cached->empty());
+  EXPECT_EQ(cache->stats().hits, 2);
+  EXPECT_EQ(cache->stats().misses, 1);
+  EXPECT_EQ(cache->stats().writes, 2);
+}
+
+TEST_F(FragmentResultCacheTest, evict) {
+  auto data = serialize({makeVector(1'000)});
+  const auto size = data->computeChainDataLength();
+  auto* cache = makeCache(3 * size);
+  const auto type = asRowType(makeVector(1)->type());
+
+  for (auto i = 0; i < 3; ++i) {
+    cache->put(fmt::format("key{}", i), *data);
+  }
+  EXPECT_EQ(cache->bytes(), 3 * size);
+  // Makes 'key0' the most recently used.
+  EXPECT_TRUE(cache->get("key0", type, pool()).has_value());
+  cache->put("key3", *data);
+  EXPECT_EQ(cache->stats().evictions, 1);
+  EXPECT_EQ(cache->bytes(), 3 * size);
+  EXPECT_FALSE(cache->get("key1", type, pool()).has_value());
+  EXPECT_TRUE(cache->get("key0", type, pool()).has_value());
+  EXPECT_TRUE(cache->get("key3", type, pool()).has_value());
+
+  auto fs = filesystems::getFileSystem(directory_->getPath(), nullptr);
+  EXPECT_EQ(fs->list(directory_->getPath()).size(), 3);
+}
+
+TEST_F(FragmentResultCacheTest, removeStaleFiles) {
+  makeCache()->put("key", *serialize({makeVector(10)}));
+  auto fs = filesystems::getFileSystem(directory_->getPath(), nullptr);
+  fs->openFileForWrite(directory_->getPath() + "/other")->close();
+  EXPECT_EQ(fs->list(directory_->getPath()).size(), 2);
+
+  FragmentResultCache::testingReset();
+  auto* cache = makeCache();
+  EXPECT_EQ(fs->list(directory_->getPath()).size(), 1);
+  EXPECT_FALSE(
+      cache->get("key", asRowType(makeVector(1)->type()), pool()).has_value());
+}
+
+TEST_F(FragmentResultCacheTest, fragmentKey) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto makePlan = [&](const std::string& filter) {
+    return PlanBuilder(planNodeIdGenerator)
+        .values({makeVector(10)})
+        .filter(filter)
+        .partialAggregation({"c1"}, {"sum(c0)"})
+        .planNode();
+  };
+  auto queryCtx = core::QueryCtx::create();
+  const auto key =
+      FragmentResultCache::fragmentKey(*makePlan("c0 > 1"), *queryCtx);
+  // The plan node ids are not part of the key.
+  EXPECT_EQ(
+      key, FragmentResultCache::fragmentKey(*makePlan("c0 > 1"), *queryCtx));
+  EXPECT_NE(
+      key, FragmentResultCache::fragmentKey(*makePlan("c0 > 2"), *queryCtx));
+
+  // Query configs that may change the results are part of the key.
+  auto otherQueryCtx = core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(
+          {{core::QueryConfig::kSessionTimezone, "America/Los_Angeles"}}));
+  EXPECT_NE(
+      key,
+      FragmentResultCache::fragmentKey(*makePlan("c0 > 1"), *otherQueryCtx));
+}
+
+TEST_F(FragmentResultCacheTest, fragmentKeySessionProperties) {
+  auto makePlan = []() {
+    return PlanBuilder()
+        .tableScan(ROW({"c0"}, {BIGINT()}))
+        .partialAggregation({}, {"sum(c0)"})
+        .planNode();
+  };
+  auto queryCtx = core::QueryCtx::create();
+  const auto key = FragmentResultCache::fragmentKey(*makePlan(), *queryCtx);
+  EXPECT_EQ(key, FragmentResultCache::fragmentKey(*makePlan(), *queryCtx));
+
+  // The session properties of the scanned connector are part of the key.
+  queryCtx->setConnectorSessionOverridesUnsafe(
+      "test-hive", {{"ignore_missing_files", "true"}});
+  EXPECT_NE(key, FragmentResultCache::fragmentKey(*makePlan(), *queryCtx));
+}
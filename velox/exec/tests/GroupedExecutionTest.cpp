@@ -800,4 +800,95 @@ TEST_F(GroupedExecutionTest, allGroupSplitsReceivedBeforeTaskStart) {
   ASSERT_EQ(task->state(), exec::TaskState::kFinished);
   ASSERT_EQ(numSplits * 10'000, numReadRows);
 }
+
+// Joins two tables bucketed the same way on the join key. The splits carry
+// the table bucket number and no split group, and each bucket is joined as a
+// separate split group.
+TEST_F(GroupedExecutionTest, bucketedHashJoin) {
+  constexpr int32_t kNumBuckets = 4;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  std::vector<std::shared_ptr<TempFilePath>> probeFiles;
+  std::vector<std::shared_ptr<TempFilePath>> buildFiles;
+  for (auto bucket = 0; bucket < kNumBuckets; ++bucket) {
+    probeVectors.push_back(makeRowVector(
+        {"c0", "c1"},
+        {
+            makeFlatVector<int64_t>(
+                100, [&](auto row) { return row * kNumBuckets + bucket; }),
+            makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+        }));
+    probeFiles.push_back(TempFilePath::create());
+    writeToFile(probeFiles.back()->getPath(), probeVectors.back());
+
+    buildVectors.push_back(makeRowVector(
+        {"c0", "c1"},
+        {
+            makeFlatVector<int64_t>(
+                50, [&](auto row) { return row * 2 * kNumBuckets + bucket; }),
+            makeFlatVector<int64_t>(50, [](auto row) { return row * 10; }),
+        }));
+    buildFiles.push_back(TempFilePath::create());
+    writeToFile(buildFiles.back()->getPath(), buildVectors.back());
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanNodeId;
+  core::PlanNodeId buildScanNodeId;
+  CursorParameters params;
+  params.planNode = PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .tableScan(rowType)
+                        .capturePlanNodeId(probeScanNodeId)
+                        .hashJoin(
+                            {"c0"},
+                            {"u_c0"},
+                            PlanBuilder(planNodeIdGenerator, pool_.get())
+                                .tableScan(rowType)
+                                .capturePlanNodeId(buildScanNodeId)
+                                .project({"c0 as u_c0", "c1 as u_c1"})
+                                .planNode(),
+                            "",
+                            {"c0", "c1", "u_c1"})
+                        .planNode();
+  params.maxDrivers = 2;
+  params.executionStrategy = core::ExecutionStrategy::kGrouped;
+  params.groupedExecutionLeafNodeIds = {probeScanNodeId, buildScanNodeId};
+  params.numSplitGroups = kNumBuckets;
+  params.numConcurrentSplitGroups = 1;
+
+  bool splitsAdded{false};
+  auto task = test::assertQuery(
+      params,
+      [&](Task* task) {
+        if (splitsAdded) {
+          return;
+        }
+        splitsAdded = true;
+        for (auto bucket = 0; bucket < kNumBuckets; ++bucket) {
+          task->addSplit(
+              probeScanNodeId,
+              exec::Split(HiveConnectorSplitBuilder(
+                              probeFiles[bucket]->getPath())
+                              .tableBucketNumber(bucket)
+                              .build()));
+          task->addSplit(
+              buildScanNodeId,
+              exec::Split(HiveConnectorSplitBuilder(
+                              buildFiles[bucket]->getPath())
+                              .tableBucketNumber(bucket)
+                              .build()));
+        }
+        task->noMoreSplits(probeScanNodeId);
+        task->noMoreSplits(buildScanNodeId);
+      },
+      "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0",
+      duckDbQueryRunner_);
+
+  ASSERT_EQ(
+      std::unordered_set<int32_t>({0, 1, 2, 3}),
+      getCompletedSplitGroups(task));
+}
 } // namespace facebook::velox::exec::test
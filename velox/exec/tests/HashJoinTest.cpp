@@ -1100,6 +1100,41 @@ TEST_P(MultiThreadedHashJoinTest, normalizedKeyOverflow) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, internKeyStrings) {
+  // Long string keys with few distinct values, nulls and keys too long to be
+  // interned.
+  const auto makeKeys = [&](const std::string& name) {
+    return makeBatches(3, [&](int32_t batch) {
+      return makeRowVector(
+          {name + "0", name + "1"},
+          {makeFlatVector<std::string>(
+               100,
+               [&](auto row) {
+                 if (row % 30 == 0) {
+                   return std::string(
+                       RowContainer::kMaxInternedStringSize + row, 'x');
+                 }
+                 return fmt::format("https://www.example.com/{}", row % 20);
+               },
+               nullEvery(13)),
+           makeFlatVector<int32_t>(
+               100, [&](auto row) { return batch * 100 + row; })});
+    });
+  };
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"t0"})
+      .probeVectors(makeKeys("t"))
+      .buildKeys({"u0"})
+      .buildVectors(makeKeys("u"))
+      .joinOutputLayout({"t1", "u1", "t0"})
+      .config(core::QueryConfig::kHashBuildInternKeyStrings, "true")
+      .config(core::QueryConfig::kMinTableRowsForParallelJoinBuild, "0")
+      .referenceQuery("SELECT t1, u1, t0 FROM t, u WHERE t0 = u0")
+      .run();
+}
+
 DEBUG_ONLY_TEST_P(MultiThreadedHashJoinTest, parallelJoinBuildCheck) {
   std::atomic<bool> isParallelBuild{false};
   SCOPED_TESTVALUE_SET(
@@ -1314,6 +1349,55 @@ TEST_P(MultiThreadedHashJoinTest, arrayBasedLookup) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, dictionaryProbeKeys) {
+  // Probe batches over two dictionaries of 100 strings, half of which match.
+  // The batches over the same dictionary are probed once per dictionary entry.
+  std::vector<VectorPtr> dictionaries = {
+      makeFlatVector<std::string>(
+          100, [](auto row) { return fmt::format("key_{}", row); }),
+      makeFlatVector<std::string>(
+          100, [](auto row) { return fmt::format("key_{}", row + 25); })};
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 6; ++i) {
+    const vector_size_t size = i % 2 == 0 ? 50 : 500;
+    auto indices =
+        makeIndices(size, [i](auto row) { return (row * 7 + i) % 100; });
+    probeVectors.push_back(makeRowVector({
+        BaseVector::wrapInDictionary(
+            makeNulls(size, nullEvery(11)),
+            indices,
+            size,
+            dictionaries[i / 3]),
+        makeFlatVector<int64_t>(
+            size, [i](auto row) { return i * 1'000 + row; }),
+    }));
+  }
+
+  // 50 keys in the build side, each twice.
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u_c0", "u_c1"},
+      {makeFlatVector<std::string>(
+           100, [](auto row) { return fmt::format("key_{}", row % 50); }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row; })})};
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .probeKeys({"c0"})
+        .probeVectors(std::vector<RowVectorPtr>(probeVectors))
+        .buildKeys({"u_c0"})
+        .buildVectors(std::vector<RowVectorPtr>(buildVectors))
+        .joinType(joinType)
+        .joinOutputLayout({"c1", "u_c1"})
+        .referenceQuery(
+            joinType == core::JoinType::kInner
+                ? "SELECT t.c1, u.u_c1 FROM t, u WHERE t.c0 = u.u_c0"
+                : "SELECT t.c1, u.u_c1 FROM t LEFT JOIN u ON t.c0 = u.u_c0")
+        .run();
+  }
+}
+
 TEST_P(MultiThreadedHashJoinTest, joinSidesDifferentSchema) {
   // In this join, the tables have different schema. LHS table t has schema
   // {INTEGER, VARCHAR, INTEGER}. RHS table u has schema {INTEGER, REAL,
@@ -2695,6 +2779,74 @@ TEST_P(MultiThreadedHashJoinTest, leftJoinWithFilter) {
   }
 }
 
+TEST_P(MultiThreadedHashJoinTest, lazyBuildColumns) {
+  const std::vector<RowVectorPtr> probeVectors =
+      makeBatches(5, [&](int32_t batch) {
+        return makeRowVector(
+            {"c0", "c1"},
+            {
+                makeFlatVector<int32_t>(
+                    211, [](auto row) { return row % 23; }, nullEvery(17)),
+                makeFlatVector<int32_t>(
+                    211, [batch](auto row) { return batch * 211 + row; }),
+            });
+      });
+  std::string str;
+  const std::vector<RowVectorPtr> buildVectors =
+      makeBatches(3, [&](int32_t batch) {
+        return makeRowVector(
+            {"u_c0", "u_c1", "u_c2"},
+            {
+                makeFlatVector<int32_t>(
+                    67, [](auto row) { return row % 31; }, nullEvery(11)),
+                makeFlatVector<int64_t>(
+                    67, [batch](auto row) { return batch * 67 + row; }),
+                makeFlatVector<StringView>(
+                    67,
+                    [&](auto row) {
+                      str = fmt::format("non-inlined build string {}", row);
+                      return StringView(str);
+                    },
+                    nullEvery(5)),
+            });
+      });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  // A selective filter after the join only loads the build side columns of
+  // the few rows that pass.
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors, true)
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors, true)
+                            .planNode(),
+                        "",
+                        {"c0", "c1", "u_c1", "u_c2"},
+                        joinType)
+                    .filter("c1 % 13 = 0")
+                    .project({"c0", "c1", "u_c1 + 1 AS u_c1", "u_c2"})
+                    .planNode();
+    const auto joinSql = joinType == core::JoinType::kInner ? "INNER" : "LEFT";
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .planNode(std::move(plan))
+        .config(core::QueryConfig::kHashProbeLazyBuildColumns, "true")
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+        .referenceQuery(fmt::format(
+            "SELECT c0, c1, u_c1 + 1, u_c2 FROM t {} JOIN u ON c0 = u_c0 "
+            "WHERE c1 % 13 = 0",
+            joinSql))
+        .injectSpill(false)
+        .run();
+  }
+}
+
 /// Tests left join with a filter that may evaluate to true, false or null.
 /// Makes sure that null filter results are handled correctly, e.g. as if the
 /// filter returned false.
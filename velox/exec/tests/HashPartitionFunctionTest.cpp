@@ -120,6 +120,29 @@ TEST_F(HashPartitionFunctionTest, function) {
   }
 }
 
+TEST_F(HashPartitionFunctionTest, modulo) {
+  const int numRows = 10'000;
+  auto vector = makeRowVector({makeFlatVector<int64_t>(
+      numRows, [](auto row) { return row * 7'919; })});
+  auto rowType = asRowType(vector->type());
+
+  SelectivityVector rows(numRows);
+  raw_vector<uint64_t> hashes(numRows);
+  auto hasher = VectorHasher::create(BIGINT(), 0);
+  hasher->decode(*vector->childAt(0), rows);
+  hasher->hash(rows, false, hashes);
+
+  for (const int numPartitions : {1, 3, 7, 64, 100, 1'000, 1'024, 4'099}) {
+    SCOPED_TRACE(fmt::format("numPartitions: {}", numPartitions));
+    std::vector<uint32_t> partitions(numRows);
+    HashPartitionFunction function(numPartitions, rowType, {0});
+    function.partition(*vector, partitions);
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(hashes[i] % numPartitions, partitions[i]);
+    }
+  }
+}
+
 TEST_F(HashPartitionFunctionTest, spec) {
   Type::registerSerDe();
   core::ITypedExpr::registerSerDe();
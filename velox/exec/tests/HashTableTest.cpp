@@ -136,7 +136,13 @@ class HashTableTest : public testing::TestWithParam<bool>,
             buildType->childAt(channel), channel));
       }
       auto table = HashTable<true>::createForJoin(
-          std::move(keyHashers), dependentTypes, true, false, 1'000, pool());
+          std::move(keyHashers),
+          dependentTypes,
+          true,
+          false,
+          1'000,
+          pool(),
+          radixPartitionedJoinBuild_);
 
       makeRows(size, 1, sequence, buildType, batches);
       copyVectorsToTable(batches, startOffset, table.get());
@@ -447,6 +453,7 @@ class HashTableTest : public testing::TestWithParam<bool>,
 
   void testProbe() {
     auto lookup = std::make_unique<HashLookup>(topTable_->hashers());
+    lookup->groupPrefetch = groupPrefetch_;
     const auto batchSize = batches_[0]->size();
     SelectivityVector rows(batchSize);
     const auto mode = topTable_->hashMode();
@@ -567,6 +574,10 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Sets HashLookup::groupPrefetch for join probes.
+  bool groupPrefetch_ = false;
+  // Makes the parallel join build of testCycle() radix partitioned.
+  bool radixPartitionedJoinBuild_ = false;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -611,6 +622,30 @@ TEST_P(HashTableTest, structKey) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 1);
 }
 
+TEST_P(HashTableTest, structKeyGroupPrefetch) {
+  auto type =
+      ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  groupPrefetch_ = true;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 1);
+}
+
+TEST_P(HashTableTest, int2SparseNormalizedRadixBuild) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  radixPartitionedJoinBuild_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 4, type, 2);
+}
+
+TEST_P(HashTableTest, structKeyRadixBuild) {
+  auto type =
+      ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
+  keySpacing_ = 1000;
+  radixPartitionedJoinBuild_ = true;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 3, type, 1);
+}
+
 TEST_P(HashTableTest, mixed6Sparse) {
   auto type =
       ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
@@ -832,6 +867,92 @@ TEST_P(HashTableTest, checkSizeValidation) {
   ASSERT_EQ(table->capacity(), 512 << 10);
 }
 
+TEST_P(HashTableTest, sampledProbeCost) {
+  auto table = createHashTableForAggregation(ROW({"a"}, {BIGINT()}), 1);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  auto testHelper = HashTableTestHelper<false>::create(table.get());
+  testHelper.setHashMode(BaseHashTable::HashMode::kHash, 10'000);
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row * 7; })});
+  for (auto i = 0; i < 32; ++i) {
+    insertGroups(*data, *lookup, *table);
+  }
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+  ASSERT_EQ(table->numDistinct(), 10'000);
+
+  // Every 16th batch is sampled.
+  const auto& cost = lookup->probeCost;
+  EXPECT_GE(cost.numProbes, 2 * 64);
+  EXPECT_LE(cost.numProbes, 2 * 10'000);
+  // A table with a good hash distribution has short probe sequences and is
+  // not rehashed for its probe cost.
+  EXPECT_LT(cost.missesPerProbe(), 1.0);
+  EXPECT_EQ(table->stats().numProbeCostRehashes, 0);
+}
+
+TEST_P(HashTableTest, singleKeyGroupProbe) {
+  // Keys repeat every kPeriod rows.
+  constexpr int32_t kPeriod = 1000;
+  auto testSingleKey = [&](const VectorPtr& keys, int32_t numDistinct) {
+    SCOPED_TRACE(keys->type()->toString());
+    auto table = createHashTableForAggregation(ROW({"k"}, {keys->type()}), 1);
+    auto lookup = std::make_unique<HashLookup>(table->hashers());
+    auto testHelper = HashTableTestHelper<false>::create(table.get());
+    testHelper.setHashMode(BaseHashTable::HashMode::kHash, keys->size());
+
+    auto data = makeRowVector({keys});
+    insertGroups(*data, *lookup, *table);
+    ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+    ASSERT_EQ(table->numDistinct(), numDistinct);
+    const std::vector<char*> groups(
+        lookup->hits.begin(), lookup->hits.begin() + keys->size());
+
+    // Rows with equal keys, including null keys, share a group.
+    for (auto i = 0; i + 1 < keys->size(); ++i) {
+      ASSERT_EQ(
+          groups[i] == groups[i + 1], keys->equalValueAt(keys.get(), i, i + 1))
+          << i;
+      if (i + kPeriod < keys->size()) {
+        ASSERT_EQ(groups[i], groups[i + kPeriod]) << i;
+      }
+    }
+    // Probing the same keys again finds the same groups.
+    insertGroups(*data, *lookup, *table);
+    ASSERT_EQ(table->numDistinct(), numDistinct);
+    for (auto i = 0; i < keys->size(); ++i) {
+      ASSERT_EQ(lookup->hits[i], groups[i]) << i;
+    }
+  };
+
+  // Keys are spread over a large range so that the table stays in kHash
+  // mode. Every 100th row is null.
+  constexpr int32_t kSize = 10'000;
+  auto isNull = [](auto row) { return row % 100 == 0; };
+  testSingleKey(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row % kPeriod) * 1'000'000'007L; },
+          isNull),
+      991);
+  testSingleKey(
+      makeFlatVector<int32_t>(
+          kSize, [](auto row) { return (row % kPeriod) * 1'000'003; }, isNull),
+      991);
+  // A mix of inline and out of line strings, including strings with the same
+  // prefix and size.
+  testSingleKey(
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) {
+            const auto key = row % kPeriod;
+            return key % 2 == 0 ? fmt::format("s{}", key)
+                                : fmt::format("long string key {}", key);
+          },
+          isNull),
+      991);
+}
+
 TEST_P(HashTableTest, listNullKeyRows) {
   VectorPtr keys = makeFlatVector<int64_t>(500, folly::identity);
   testListNullKeyRows(keys, BaseHashTable::HashMode::kArray);
@@ -1077,6 +1198,54 @@ TEST_P(HashTableTest, toStringSingleKey) {
   ASSERT_NO_THROW(table->toString(31, 5));
 }
 
+TEST_P(HashTableTest, keyBloomFilter) {
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  hashers.push_back(std::make_unique<VectorHasher>(VARCHAR(), 1));
+
+  auto table = HashTable<false>::createForJoin(
+      std::move(hashers),
+      {}, /*dependentTypes*/
+      true /*allowDuplicates*/,
+      false /*hasProbedFlag*/,
+      1 /*minTableSizeForParallelJoinBuild*/,
+      pool());
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          10'000, [](auto row) { return (row / 2) * 1'000'003; }),
+      makeFlatVector<std::string>(
+          10'000, [](auto row) { return std::to_string(row); }),
+  });
+
+  store(*table->rows(), data);
+
+  table->prepareJoinTable({});
+
+  auto filter = table->keyBloomFilter(0, false);
+  ASSERT_NE(filter, nullptr);
+  ASSERT_EQ(filter->kind(), common::FilterKind::kBigintValuesUsingBloomFilter);
+  ASSERT_FALSE(filter->testNull());
+  for (auto i = 0; i < 5'000; ++i) {
+    ASSERT_TRUE(filter->testInt64(i * 1'000'003));
+  }
+  ASSERT_FALSE(filter->testInt64(-1));
+  ASSERT_FALSE(filter->testInt64(5'000 * 1'000'003LL));
+
+  // The bloom filter is shared between the returned filters.
+  auto nullAllowedFilter = table->keyBloomFilter(0, true);
+  ASSERT_TRUE(nullAllowedFilter->testNull());
+  ASSERT_EQ(
+      &static_cast<const common::BigintValuesUsingBloomFilter*>(filter.get())
+           ->bloomFilter(),
+      &static_cast<const common::BigintValuesUsingBloomFilter*>(
+           nullAllowedFilter.get())
+           ->bloomFilter());
+
+  // No filter for non-integer keys.
+  ASSERT_EQ(table->keyBloomFilter(1, false), nullptr);
+}
+
 TEST_P(HashTableTest, toStringMultipleKeys) {
   std::vector<std::unique_ptr<VectorHasher>> hashers;
   hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
@@ -194,6 +194,71 @@ TEST_F(LocalPartitionTest, partition) {
   verifyExchangeSourceOperatorStats(task, 300, 6);
 }
 
+TEST_F(LocalPartitionTest, skewRebalancing) {
+  // 90% of the rows have key 0.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int32_t>(
+        10'000, [](auto row) { return row % 10 == 0 ? row : 0; })}));
+  }
+  createDuckDbTable(vectors);
+
+  // The partial aggregation tolerates a key split over several drivers.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId partitionNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localPartition(
+                      {"c0"},
+                      {PlanBuilder(planNodeIdGenerator)
+                           .values(vectors)
+                           .planNode()},
+                      true)
+                  .capturePlanNodeId(partitionNodeId)
+                  .partialAggregation({"c0"}, {"count(1)"})
+                  .localPartition(std::vector<std::string>{})
+                  .finalAggregation()
+                  .planNode();
+
+  for (const auto& threshold : {"0", "2"}) {
+    SCOPED_TRACE(fmt::format("threshold: {}", threshold));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .maxDrivers(4)
+            .config(core::QueryConfig::kLocalPartitionSkewThreshold, threshold)
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+    const auto& stats =
+        exec::toPlanStats(task->taskStats()).at(partitionNodeId).customStats;
+    if (std::string(threshold) == "0") {
+      ASSERT_EQ(stats.count("rebalancedRows"), 0);
+    } else {
+      ASSERT_GT(stats.at("numHotPartitions").max, 0);
+      ASSERT_GT(stats.at("rebalancedRows").sum, 0);
+    }
+  }
+
+  // A final aggregation needs all rows of a key in one driver, so the planner
+  // does not enable rebalancing and the skewed key stays in one partition.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .localPartition(
+                 {"c0"},
+                 {PlanBuilder(planNodeIdGenerator)
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"count(1)"})
+                      .planNode()})
+             .capturePlanNodeId(partitionNodeId)
+             .finalAggregation()
+             .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .maxDrivers(4)
+          .config(core::QueryConfig::kLocalPartitionSkewThreshold, "2")
+          .assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+  const auto& stats =
+      exec::toPlanStats(task->taskStats()).at(partitionNodeId).customStats;
+  ASSERT_EQ(stats.count("numHotPartitions"), 0);
+  ASSERT_EQ(stats.count("rebalancedRows"), 0);
+}
+
 TEST_F(LocalPartitionTest, maxBufferSizeGather) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
@@ -484,6 +549,39 @@ TEST_F(LocalPartitionTest, earlyCompletion) {
   assertTaskReferenceCount(task, 1);
 }
 
+TEST_F(LocalPartitionTest, earlyCompletionStopsProducer) {
+  std::vector<RowVectorPtr> data = {
+      makeRowVector({makeFlatSequence(3, 100)}),
+  };
+
+  // The producer would emit 10'000 vectors. The limit needs only one, so the
+  // producer must stop soon after the consumer closes the queue.
+  const int32_t kRepeatTimes = 10'000;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId valuesNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localPartition(
+                      {},
+                      {PlanBuilder(planNodeIdGenerator)
+                           .values(data, false, kRepeatTimes)
+                           .capturePlanNodeId(valuesNodeId)
+                           .planNode()})
+                  .limit(0, 2, true)
+                  .planNode();
+
+  // A small buffer blocks the producer after each vector until the consumer
+  // takes it.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kMaxLocalExchangeBufferSize, "100")
+                  .assertResults("VALUES (3), (4)");
+
+  const auto valuesStats =
+      exec::toPlanStats(task->taskStats()).at(valuesNodeId);
+  ASSERT_LT(valuesStats.outputVectors, 10);
+
+  assertTaskReferenceCount(task, 1);
+}
+
 TEST_F(LocalPartitionTest, earlyCancelation) {
   std::vector<RowVectorPtr> data = {
       makeRowVector({makeFlatSequence(3, 100)}),
@@ -625,3 +723,25 @@ TEST_F(LocalPartitionTest, unionAllLocalExchange) {
       "   SELECT * FROM (VALUES ('y')) as t2(c0)"
       ")");
 }
+
+TEST_F(LocalPartitionTest, memoryManagerWatermarks) {
+  LocalExchangeMemoryManager memoryManager(1000);
+
+  ContinueFuture future;
+  ASSERT_FALSE(memoryManager.increaseMemoryUsage(&future, 500));
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&future, 500));
+  ASSERT_FALSE(future.isReady());
+
+  // Below the limit but above the low watermark: producers stay blocked.
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(50).empty());
+
+  auto promises = memoryManager.decreaseMemoryUsage(100);
+  ASSERT_EQ(promises.size(), 1);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  ASSERT_TRUE(future.isReady());
+
+  // No producer is blocked.
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(850).empty());
+}
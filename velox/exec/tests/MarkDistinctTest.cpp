@@ -106,6 +106,28 @@ TEST_F(MarkDistinctTest, row) {
   runBasicTest(base);
 }
 
+TEST_F(MarkDistinctTest, allOrNoneDistinct) {
+  // The first batch is all distinct, the second has no distinct rows and the
+  // third has some.
+  std::vector<RowVectorPtr> batches = {
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}),
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}),
+      makeRowVector({makeFlatVector<int32_t>({3, 4, 2})}),
+  };
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .markDistinct("c0_distinct", {"c0"})
+                  .planNode();
+
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 3, 1, 2, 3, 3, 4, 2}),
+      makeFlatVector<bool>(
+          {true, true, true, false, false, false, false, true, false}),
+  });
+  assertEqualVectors(expected, AssertQueryBuilder(plan).copyResults(pool()));
+}
+
 TEST_F(MarkDistinctTest, aggregation) {
   // Simulate the input over 3 splits.
   std::vector<RowVectorPtr> vectors = {
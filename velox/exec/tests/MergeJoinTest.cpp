@@ -18,7 +18,9 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include "folly/experimental/EventCount.h"
 
@@ -220,6 +222,87 @@ TEST_F(MergeJoinTest, allRowsMatch) {
   testJoin(rightKeys, leftKeys);
 }
 
+TEST_F(MergeJoinTest, spillRightMatch) {
+  // Each key has 40 rows on the left side and 400 rows on the right side. The
+  // rows of a key span several batches on the right side.
+  std::vector<RowVectorPtr> left;
+  for (auto i = 0; i < 3; ++i) {
+    left.push_back(makeRowVector(
+        {"t0", "t1"},
+        {
+            makeFlatVector<int32_t>(40, [&](auto /*row*/) { return i; }),
+            makeFlatVector<int32_t>(
+                40, [&](auto row) { return i * 40 + row; }),
+        }));
+  }
+  std::vector<RowVectorPtr> right;
+  for (auto i = 0; i < 12; ++i) {
+    right.push_back(makeRowVector(
+        {"u0", "u1"},
+        {
+            makeFlatVector<int32_t>(
+                100, [&](auto row) { return (i * 100 + row) / 400; }),
+            makeFlatVector<int32_t>(
+                100, [&](auto row) { return i * 100 + row; }),
+        }));
+  }
+  createDuckDbTable("t", left);
+  createDuckDbTable("u", right);
+
+  struct {
+    core::JoinType joinType;
+    std::string filter;
+    std::string sql;
+
+    std::string debugString() const {
+      return fmt::format(
+          "joinType {}, filter '{}'", core::joinTypeName(joinType), filter);
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "",
+       "SELECT t0, t1, u1 FROM t, u WHERE t0 = u0"},
+      {core::JoinType::kInner,
+       "(t1 + u1) % 7 = 0",
+       "SELECT t0, t1, u1 FROM t, u WHERE t0 = u0 AND (t1 + u1) % 7 = 0"},
+      {core::JoinType::kLeft,
+       "u1 < t1 * 3",
+       "SELECT t0, t1, u1 FROM t LEFT JOIN u ON t0 = u0 AND u1 < t1 * 3"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values(left)
+            .mergeJoin(
+                {"t0"},
+                {"u0"},
+                PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+                testData.filter,
+                {"t0", "t1", "u1"},
+                testData.joinType)
+            .capturePlanNodeId(joinNodeId)
+            .planNode();
+
+    // A small output batch size makes the output fill up in the middle of the
+    // spilled rows.
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(core::QueryConfig::kSpillEnabled, true)
+                    .config(core::QueryConfig::kMergeJoinSpillEnabled, true)
+                    .config(core::QueryConfig::kPreferredOutputBatchRows, 37)
+                    .assertResults(testData.sql);
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_GT(planStats.at(joinNodeId).spilledBytes, 0);
+    ASSERT_GT(planStats.at(joinNodeId).spilledRows, 0);
+  }
+}
+
 TEST_F(MergeJoinTest, aggregationOverJoin) {
   auto left =
       makeRowVector({"t_c0"}, {makeFlatVector<int32_t>({1, 2, 3, 4, 5})});
@@ -152,6 +152,36 @@ TEST_F(MergeTest, localMerge) {
   testTwoKeys(vectors, "c3", "c0");
 }
 
+/// Verifies merging sources that have runs of rows that sort between the rows
+/// of the other sources. Runs of enough rows are copied as one range.
+TEST_F(MergeTest, runs) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    const vector_size_t batchSize = 1000 + 300 * i;
+    const auto runSize = 5 + 40 * i;
+    auto c0 = makeFlatVector<int32_t>(
+        batchSize,
+        [&](auto row) { return (row / runSize) * 4 + i; },
+        nullEvery(301));
+    auto c1 = makeFlatVector<double>(
+        batchSize,
+        [&](auto row) { return (row % 7) * 0.5 - i; },
+        nullEvery(13));
+    auto c2 = makeFlatVector<int64_t>(
+        batchSize, [&](auto row) { return row / 3; }, nullEvery(17));
+    auto c3 = makeFlatVector<StringView>(batchSize, [](auto row) {
+      return StringView::makeInline(std::to_string(row));
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c0");
+  testSingleKey(vectors, "c2");
+  testTwoKeys(vectors, "c0", "c1");
+  testTwoKeys(vectors, "c2", "c3");
+}
+
 /// Verifies an edge case where output batch fills up when one of the sources
 /// has only one row left.
 TEST_F(MergeTest, offByOne) {
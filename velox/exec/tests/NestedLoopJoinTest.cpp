@@ -455,6 +455,42 @@ TEST_F(NestedLoopJoinTest, bigintArray) {
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
 
+TEST_F(NestedLoopJoinTest, rangeConditions) {
+  // Join conditions that bound a build column by probe columns only pair each
+  // probe row with the build rows within the bounds.
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             100, [&](auto row) { return (row + i * 31) % 97; }, nullEvery(11)),
+         makeFlatVector<int64_t>(
+             100,
+             [&](auto row) { return (row + i * 31) % 97 + row % 7; },
+             nullEvery(17))}));
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             80, [&](auto row) { return (row + i * 17) % 50; }, nullEvery(13)),
+         makeFlatVector<int64_t>(
+             80,
+             [&](auto row) { return (row + i * 17) % 50 + row % 13; },
+             nullEvery(19))}));
+  }
+
+  setComparisons({
+      "t0 BETWEEN u0 AND u1",
+      "u0 BETWEEN t0 AND t1",
+      "t0 >= u0 AND t0 < u1",
+      "u1 > t1 AND t0 <> u0",
+      "u0 <= t0 AND u0 + u1 > t1",
+  });
+  setJoinConditionStr("{}");
+  setQueryStr("SELECT t0, u0 FROM t {0} JOIN u ON {1}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
 TEST_F(NestedLoopJoinTest, allTypes) {
   RowTypePtr probeType = ROW(
       {{"t0", BIGINT()},
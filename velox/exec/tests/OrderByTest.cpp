@@ -525,6 +525,50 @@ TEST_F(OrderByTest, spill) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(OrderByTest, parallelOrderBy) {
+  const auto rowType =
+      ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
+  const auto vectors = createVectors(rowType, 1024, 4 << 20);
+  createDuckDbTable(vectors);
+
+  const int32_t numDrivers = 4;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId orderNodeId;
+  // Each driver of the parallel values node produces all of 'vectors'.
+  const auto plan = PlanBuilder(planNodeIdGenerator)
+                        .values(vectors, true)
+                        .orderBy({"c0 ASC NULLS LAST", "c1 DESC"}, false)
+                        .capturePlanNodeId(orderNodeId)
+                        .planNode();
+  const auto duckDbSql =
+      "SELECT * FROM (SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+      "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp) "
+      "ORDER BY c0 NULLS LAST, c1 DESC";
+
+  for (const bool spill : {false, true}) {
+    SCOPED_TRACE(fmt::format("spill: {}", spill));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(spill ? 100 : 0);
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .maxDrivers(numDrivers)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(core::QueryConfig::kParallelOrderBy, true)
+                    .config(core::QueryConfig::kSpillEnabled, spill)
+                    .config(core::QueryConfig::kOrderBySpillEnabled, spill)
+                    .assertResults(duckDbSql, {{0, 1}});
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& planStats = taskStats.at(orderNodeId);
+    ASSERT_EQ(planStats.operatorStats.at("OrderBy")->numDrivers, numDrivers);
+    ASSERT_EQ(planStats.operatorStats.at("LocalMerge")->numDrivers, 1);
+    if (spill) {
+      ASSERT_GT(planStats.spilledRows, 0);
+    } else {
+      ASSERT_EQ(planStats.spilledRows, 0);
+    }
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
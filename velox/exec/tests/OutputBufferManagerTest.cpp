@@ -1144,6 +1144,52 @@ TEST_F(OutputBufferManagerTest, broadcastWithDynamicAddedDestination) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, broadcastConcurrentAcks) {
+  const vector_size_t size = 10;
+  const int numDestinations = 8;
+  const int numPages = 1'000;
+  const std::string taskId = "t0";
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kBroadcast,
+      numDestinations,
+      1);
+  bufferManager_->updateOutputBuffers(taskId, numDestinations, true);
+
+  for (int i = 0; i < numPages; ++i) {
+    enqueue(taskId, rowType_, size);
+  }
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedPages, numPages);
+  ASSERT_GT(stats.bufferedBytes, 0);
+
+  // The destinations release the same pages at the same time. Each page must
+  // leave the buffered bytes exactly once.
+  std::vector<std::thread> threads;
+  for (int destination = 0; destination < numDestinations; ++destination) {
+    threads.emplace_back([&, destination]() {
+      for (int i = 0; i < numPages; ++i) {
+        fetchOneAndAck(taskId, destination, i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedPages, 0);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+
+  noMoreData(taskId);
+  for (int destination = 0; destination < numDestinations; ++destination) {
+    fetchEndMarker(taskId, destination, numPages);
+  }
+  ASSERT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+  EXPECT_TRUE(task->isFinished());
+}
+
 TEST_F(OutputBufferManagerTest, arbitraryWithDynamicAddedDestination) {
   const vector_size_t size = 100;
   int numDestinations = 5;
@@ -219,6 +219,9 @@ TEST_F(PlanNodeSerdeTest, localPartition) {
 
   plan = PlanBuilder().values({data_}).localPartition({"c0", "c1"}).planNode();
   testSerde(plan);
+
+  plan = PlanBuilder().values({data_}).localPartition({"c0"}, true).planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, limit) {
@@ -570,6 +570,12 @@ TEST_F(PlanNodeToStringTest, localPartition) {
       "-- LocalPartition[1][REPARTITION HASH(c0)] -> c0:SMALLINT, c1:INTEGER, c2:BIGINT\n",
       plan->toString(true, false));
 
+  plan = PlanBuilder().values({data_}).localPartition({"c0"}, true).planNode();
+
+  ASSERT_EQ(
+      "-- LocalPartition[1][REPARTITION HASH(c0) rebalance hot partitions] -> c0:SMALLINT, c1:INTEGER, c2:BIGINT\n",
+      plan->toString(true, false));
+
   plan = PlanBuilder()
              .values({data_})
              .localPartition(std::vector<std::string>{})
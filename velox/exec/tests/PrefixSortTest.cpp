@@ -229,7 +229,9 @@ TEST_F(PrefixSortTest, fuzz) {
       DOUBLE(),
       TIMESTAMP(),
       VARCHAR(),
-      VARBINARY()};
+      VARBINARY(),
+      DECIMAL(12, 2),
+      DECIMAL(38, 5)};
   for (const auto& type : keyTypes) {
     SCOPED_TRACE(fmt::format("{}", type->toString()));
     VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = 0.1}, pool());
@@ -240,6 +242,28 @@ TEST_F(PrefixSortTest, fuzz) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefixTies) {
+  // Many strings are equal on the normalized prefix and are only ordered by
+  // the full comparison, which must also come before the second key.
+  const std::vector<std::string> prefixes = {
+      "", "a", "abcdefghijklmnop", "abcdefghijklmnopq", "abcdefghijklmnopz"};
+  const vector_size_t numRows = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          numRows,
+          [&](auto row) {
+            return fmt::format(
+                "{}{}", prefixes[row % prefixes.size()], (row * 7) % 13);
+          },
+          nullEvery(17)),
+      makeFlatVector<int64_t>(numRows, [](auto row) { return row % 11; }),
+  });
+
+  testPrefixSort({kAsc, kAsc}, data);
+  testPrefixSort({kDesc, kAsc}, data);
+  testPrefixSort({kAsc, kDesc}, data);
+}
+
 TEST_F(PrefixSortTest, fuzzMulti) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -252,7 +276,9 @@ TEST_F(PrefixSortTest, fuzzMulti) {
       DOUBLE(),
       TIMESTAMP(),
       VARCHAR(),
-      VARBINARY()};
+      VARBINARY(),
+      DECIMAL(12, 2),
+      DECIMAL(38, 5)};
 
   VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = 0.1}, pool());
 
@@ -1124,9 +1124,9 @@ TEST_F(RowContainerTest, erase) {
   auto data = makeRowContainer({SMALLINT()}, {SMALLINT()});
 
   // The layout is expected to be smallint - 6 bytes of padding - 1 byte of bits
-  // - smallint - next pointer. The bits are a null flag for the second
+  // - next pointer - smallint. The bits are a null flag for the second
   // smallint, a probed flag and a free flag.
-  EXPECT_EQ(data->nextOffset(), 11);
+  EXPECT_EQ(data->nextOffset(), 9);
   // 2nd bit in first byte of flags.
   EXPECT_EQ(data->probedFlagOffset(), 8 * 8 + 1);
   std::unordered_set<char*> rowSet;
@@ -1172,6 +1172,52 @@ TEST_F(RowContainerTest, erase) {
   data->checkConsistency();
 }
 
+TEST_F(RowContainerTest, hotColumnsFirst) {
+  // A hash join build side with wide dependents. The keys, flags and next
+  // pointer that a probe reads for every candidate row come before the
+  // dependents so that these share the first cache line of the row.
+  std::vector<TypePtr> dependents(8, VARCHAR());
+  auto data = makeRowContainer({BIGINT(), BIGINT()}, dependents);
+  ASSERT_LT(data->columnAt(1).offset(), data->nextOffset());
+  const auto firstDependentOffset = data->columnAt(2).offset();
+  EXPECT_EQ(data->nextOffset() + sizeof(void*), firstDependentOffset);
+  EXPECT_LE(firstDependentOffset, 64);
+  EXPECT_LT(firstDependentOffset, data->rowSizeOffset());
+
+  // Values round trip through the reordered layout.
+  constexpr vector_size_t kNumRows = 100;
+  std::vector<VectorPtr> children;
+  children.push_back(makeFlatVector<int64_t>(kNumRows, folly::identity));
+  children.push_back(
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 2; }));
+  std::string str;
+  for (auto i = 0; i < dependents.size(); ++i) {
+    children.push_back(makeFlatVector<StringView>(
+        kNumRows,
+        [&](auto row) {
+          str = fmt::format("{}-{}", i, row);
+          return StringView(str);
+        },
+        nullEvery(7)));
+  }
+  std::vector<char*> rows(kNumRows);
+  SelectivityVector allRows(kNumRows);
+  for (auto column = 0; column < children.size(); ++column) {
+    DecodedVector decoded(*children[column], allRows);
+    for (auto row = 0; row < kNumRows; ++row) {
+      if (column == 0) {
+        rows[row] = data->newRow();
+      }
+      data->store(decoded, row, rows[row], column);
+    }
+  }
+  for (auto column = 0; column < children.size(); ++column) {
+    auto result = BaseVector::create(children[column]->type(), kNumRows, pool());
+    data->extractColumn(rows.data(), kNumRows, column, result);
+    assertEqualVectors(children[column], result);
+  }
+}
+
 TEST_F(RowContainerTest, initialNulls) {
   std::vector<TypePtr> keys{INTEGER()};
   std::vector<TypePtr> dependent{INTEGER()};
@@ -1197,10 +1243,10 @@ TEST_F(RowContainerTest, rowSize) {
   auto data = makeRowContainer({SMALLINT()}, {VARCHAR()});
 
   // The layout is expected to be smallint - 6 bytes of padding - 1 byte of bits
-  // - StringView - rowSize - next pointer. The bits are a null flag for the
+  // - next pointer - StringView - rowSize. The bits are a null flag for the
   // second smallint, a probed flag and a free flag.
-  EXPECT_EQ(25, data->rowSizeOffset());
-  EXPECT_EQ(29, data->nextOffset());
+  EXPECT_EQ(9, data->nextOffset());
+  EXPECT_EQ(33, data->rowSizeOffset());
   // 2nd bit in first byte of flags.
   EXPECT_EQ(data->probedFlagOffset(), 8 * 8 + 1);
   std::vector<char*> rows;
@@ -1889,7 +1935,7 @@ DEBUG_ONLY_TEST_F(RowContainerTest, eraseAfterOomStoringString) {
 TEST_F(RowContainerTest, nextRowVector) {
   int32_t numRows = 100;
   auto data = makeRowContainer({SMALLINT()}, {SMALLINT()});
-  EXPECT_EQ(data->nextOffset(), 11);
+  EXPECT_EQ(data->nextOffset(), 9);
   std::unordered_set<char*> rowSet;
   std::vector<char*> rows;
 
@@ -2016,3 +2062,106 @@ TEST_F(RowContainerTest, hugeIntStoreWithNulls) {
   data->extractColumn(rows.data(), kNumRows, kColumnIndex, extracted);
   assertEqualVectors(source, extracted);
 }
+
+TEST_F(RowContainerTest, internKeyStrings) {
+  constexpr int32_t kNumRows = 1'000;
+  const auto longString =
+      std::string(RowContainer::kMaxInternedStringSize + 1, 'x');
+  auto keys = makeFlatVector<std::string>(
+      kNumRows,
+      [&](auto row) {
+        if (row % 100 == 0) {
+          return longString;
+        }
+        if (row % 10 == 1) {
+          return std::string("short");
+        }
+        return fmt::format("https://www.example.com/{}", row % 5);
+      },
+      nullEvery(7));
+  auto dependents = makeFlatVector<std::string>(kNumRows, [](auto row) {
+    return fmt::format("dependent value {}", row);
+  });
+
+  const auto makeContainer = [&](bool internKeyStrings) {
+    auto container = std::make_unique<RowContainer>(
+        std::vector<TypePtr>{VARCHAR()},
+        true, // nullableKeys
+        std::vector<Accumulator>{},
+        std::vector<TypePtr>{VARCHAR()},
+        true, // hasNext
+        true, // isJoinBuild
+        false, // hasProbedFlag
+        false, // hasNormalizedKey
+        pool_.get(),
+        nullptr,
+        internKeyStrings);
+    std::vector<char*> rows(kNumRows);
+    DecodedVector decodedKeys(*keys);
+    DecodedVector decodedDependents(*dependents);
+    for (auto i = 0; i < kNumRows; ++i) {
+      rows[i] = container->newRow();
+      container->store(decodedKeys, i, rows[i], 0);
+      container->store(decodedDependents, i, rows[i], 1);
+    }
+    return std::make_pair(std::move(container), rows);
+  };
+
+  auto [container, rows] = makeContainer(true);
+  auto [copyContainer, copyRows] = makeContainer(false);
+  EXPECT_TRUE(container->internsKeyStrings());
+  EXPECT_FALSE(copyContainer->internsKeyStrings());
+  // The 5 URLs. The short and long keys are not interned.
+  EXPECT_EQ(container->numInternedStrings(), 5);
+  EXPECT_EQ(copyContainer->numInternedStrings(), 0);
+  EXPECT_LT(
+      container->stringAllocator().cumulativeBytes(),
+      copyContainer->stringAllocator().cumulativeBytes());
+
+  auto extracted = BaseVector::create(VARCHAR(), kNumRows, pool());
+  container->extractColumn(rows.data(), kNumRows, 0, extracted);
+  assertEqualVectors(keys, extracted);
+  container->extractColumn(rows.data(), kNumRows, 1, extracted);
+  assertEqualVectors(dependents, extracted);
+
+  for (auto i = 0; i < kNumRows; i += 3) {
+    for (auto j = 0; j < kNumRows; j += 7) {
+      const bool equal = keys->equalValueAt(keys.get(), i, j);
+      ASSERT_EQ(
+          container->equalsInternedString(rows[i], rows[j], 0, true), equal)
+          << i << " " << j;
+      // The rows of another container do not share the interned strings.
+      ASSERT_EQ(
+          container->equalsInternedString(rows[i], copyRows[j], 0, false),
+          equal)
+          << i << " " << j;
+    }
+  }
+
+  // The long keys are not interned and are freed with their rows.
+  std::vector<char*> longKeyRows;
+  std::vector<char*> otherRows;
+  int32_t numLongKeys = 0;
+  for (auto i = 0; i < kNumRows / 2; ++i) {
+    if (i % 100 == 0) {
+      longKeyRows.push_back(rows[i]);
+      numLongKeys += !keys->isNullAt(i);
+    } else {
+      otherRows.push_back(rows[i]);
+    }
+  }
+  ASSERT_GT(numLongKeys, 0);
+  const auto bytesBeforeErase = container->stringAllocator().cumulativeBytes();
+  container->eraseRows(folly::Range<char**>(
+      longKeyRows.data(), longKeyRows.size()));
+  EXPECT_GE(
+      bytesBeforeErase - container->stringAllocator().cumulativeBytes(),
+      numLongKeys * longString.size());
+
+  // Erasing rows keeps the interned strings of the other rows.
+  container->eraseRows(
+      folly::Range<char**>(otherRows.data(), otherRows.size()));
+  EXPECT_EQ(container->numInternedStrings(), 5);
+  container->clear();
+  EXPECT_EQ(container->numInternedStrings(), 0);
+}
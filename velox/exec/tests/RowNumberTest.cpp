@@ -248,6 +248,38 @@ TEST_F(RowNumberTest, spill) {
   }
 }
 
+TEST_F(RowNumberTest, deduplicateWithSpill) {
+  std::vector<RowVectorPtr> vectors = createVectors(8, rowType_, fuzzerOpts_);
+  createDuckDbTable(vectors);
+  const auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+  for (const auto generateRowNumber : {true, false}) {
+    SCOPED_TRACE(fmt::format("generateRowNumber {}", generateRowNumber));
+    TestScopedSpillInjection scopedSpillInjection(100);
+
+    core::PlanNodeId rowNumberPlanNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kRowNumberSpillEnabled, true)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .rowNumber({"c0"}, 1, generateRowNumber)
+                      .capturePlanNodeId(rowNumberPlanNodeId)
+                      .planNode())
+            .assertResults(fmt::format(
+                "SELECT {} FROM (SELECT *, row_number() over "
+                "(partition by c0) as rn FROM tmp) WHERE rn <= 1",
+                generateRowNumber ? "*" : "c0, c1, c2, c3"));
+    auto taskStats = toPlanStats(task->taskStats());
+    ASSERT_GT(taskStats.at(rowNumberPlanNodeId).spilledBytes, 0);
+
+    task.reset();
+    waitForAllTasksToBeDeleted();
+  }
+}
+
 TEST_F(RowNumberTest, maxSpillBytes) {
   const auto rowType =
       ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
@@ -29,6 +29,7 @@ namespace {
 const char* const kSimpleAvg = "simple_avg";
 const char* const kSimpleArrayAgg = "simple_array_agg";
 const char* const kSimpleCountNulls = "simple_count_nulls";
+const char* const kSimpleBatchSum = "simple_batch_sum";
 
 class SimpleAverageAggregationTest : public AggregationTestBase {
  protected:
@@ -469,5 +470,132 @@ TEST_F(SimpleCountNullsAggregationTest, basic) {
   testAggregations({vectors}, {}, {"simple_count_nulls(c2)"}, {expected});
 }
 
+// A testing sum of bigint that defines batched addInput.
+class BatchSumAggregate {
+ public:
+  using InputType = Row<int64_t>;
+  using IntermediateType = int64_t;
+  using OutputType = int64_t;
+
+  struct AccumulatorType {
+    int64_t sum_{0};
+
+    AccumulatorType() = delete;
+
+    explicit AccumulatorType(HashStringAllocator* /*allocator*/) {}
+
+    void addInput(HashStringAllocator* /*allocator*/, int64_t value) {
+      sum_ += value;
+    }
+
+    void combine(HashStringAllocator* /*allocator*/, int64_t other) {
+      sum_ += other;
+    }
+
+    bool writeFinalResult(exec::out_type<OutputType>& out) {
+      out = sum_;
+      return true;
+    }
+
+    bool writeIntermediateResult(exec::out_type<IntermediateType>& out) {
+      out = sum_;
+      return true;
+    }
+  };
+
+  static void addInputBatch(
+      HashStringAllocator* /*allocator*/,
+      exec::AccumulatorBatch<AccumulatorType> accumulators,
+      const int64_t* values,
+      vector_size_t numRows) {
+    for (auto i = 0; i < numRows; ++i) {
+      accumulators[i].sum_ += values[i];
+    }
+  }
+
+  static void addSingleGroupInputBatch(
+      HashStringAllocator* /*allocator*/,
+      AccumulatorType& accumulator,
+      const int64_t* values,
+      vector_size_t numRows) {
+    for (auto i = 0; i < numRows; ++i) {
+      accumulator.sum_ += values[i];
+    }
+  }
+};
+
+class SimpleBatchSumAggregationTest : public AggregationTestBase {
+ protected:
+  void SetUp() override {
+    AggregationTestBase::SetUp();
+
+    std::vector<std::shared_ptr<exec::AggregateFunctionSignature>> signatures{
+        exec::AggregateFunctionSignatureBuilder()
+            .returnType("bigint")
+            .intermediateType("bigint")
+            .argumentType("bigint")
+            .build()};
+    exec::registerAggregateFunction(
+        kSimpleBatchSum,
+        std::move(signatures),
+        [](core::AggregationNode::Step /*step*/,
+           const std::vector<TypePtr>& /*argTypes*/,
+           const TypePtr& resultType,
+           const core::QueryConfig& /*config*/)
+            -> std::unique_ptr<exec::Aggregate> {
+          static_assert(
+              SimpleAggregateAdapter<BatchSumAggregate>::support_input_batch_);
+          return std::make_unique<SimpleAggregateAdapter<BatchSumAggregate>>(
+              resultType);
+        },
+        false /*registerCompanionFunctions*/,
+        true /*overwrite*/);
+  }
+};
+
+TEST_F(SimpleBatchSumAggregationTest, basic) {
+  auto keys = makeFlatVector<int32_t>(1'000, [](auto row) { return row % 7; });
+  // Flat without nulls, flat with nulls and dictionary encoded input.
+  auto values =
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row * 3; });
+  auto nullableValues = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; }, nullEvery(5));
+  auto dictionaryValues = wrapInDictionary(
+      makeIndicesInReverse(1'000), 1'000, nullableValues);
+  std::vector<RowVectorPtr> vectors = {
+      makeRowVector({keys, values, nullableValues, dictionaryValues})};
+  createDuckDbTable(vectors);
+
+  testAggregations(
+      vectors,
+      {"c0"},
+      {"simple_batch_sum(c1)", "simple_batch_sum(c2)", "simple_batch_sum(c3)"},
+      "SELECT c0, sum(c1), sum(c2), sum(c3) FROM tmp GROUP BY c0");
+  testAggregations(
+      vectors,
+      {},
+      {"simple_batch_sum(c1)", "simple_batch_sum(c2)", "simple_batch_sum(c3)"},
+      "SELECT sum(c1), sum(c2), sum(c3) FROM tmp");
+
+  // Masks select a subset of the rows.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0", "c1", "c2", "c0 % 2 = 0 AS m"})
+                  .singleAggregation(
+                      {"c0"},
+                      {"simple_batch_sum(c1)", "simple_batch_sum(c2)"},
+                      {"m", "m"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0, sum(c1) FILTER (WHERE c0 % 2 = 0), "
+      "sum(c2) FILTER (WHERE c0 % 2 = 0) FROM tmp GROUP BY c0");
+
+  // All null input leaves the groups null.
+  auto nulls = makeRowVector({makeAllNullFlatVector<int64_t>(10)});
+  auto expected = makeRowVector({makeAllNullFlatVector<int64_t>(1)});
+  testAggregations({nulls}, {}, {"simple_batch_sum(c0)"}, {expected});
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::test
@@ -82,6 +82,9 @@ class SortBufferTest : public OperatorTestBase {
       std::make_shared<folly::CPUThreadPoolExecutor>(
           std::thread::hardware_concurrency())};
 
+  // Sorts even the smallest inputs with prefix-sort.
+  const common::PrefixSortConfig prefixSortConfig_{1024, 0};
+
   tsan_atomic<bool> nonReclaimableSection_{false};
   folly::Random::DefaultGenerator rng_;
 };
@@ -123,7 +126,8 @@ TEST_F(SortBufferTest, singleKey) {
         sortColumnIndices_,
         testData.sortCompareFlags,
         pool_.get(),
-        &nonReclaimableSection_);
+        &nonReclaimableSection_,
+        prefixSortConfig_);
 
     RowVectorPtr data = makeRowVector(
         {makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
@@ -147,13 +151,52 @@ TEST_F(SortBufferTest, singleKey) {
   }
 }
 
+TEST_F(SortBufferTest, wideRows) {
+  // Rows this wide are extracted in several chunks per output batch.
+  const int32_t numColumns = 300;
+  const vector_size_t numRows = 1'000;
+  auto makeData = [&](bool sorted) {
+    std::vector<VectorPtr> children;
+    // The input has the sort key in descending order.
+    auto sourceRow = [&](auto row) { return sorted ? row : numRows - 1 - row; };
+    children.push_back(makeFlatVector<int64_t>(
+        numRows, [&](auto row) { return sourceRow(row); }));
+    for (auto i = 1; i < numColumns; ++i) {
+      children.push_back(makeFlatVector<int64_t>(
+          numRows,
+          [&](auto row) { return sourceRow(row) * i; },
+          [&](auto row) { return (sourceRow(row) + i) % 7 == 0; }));
+    }
+    children.push_back(makeFlatVector<std::string>(numRows, [&](auto row) {
+      return std::string(sourceRow(row) % 50, 'x');
+    }));
+    return makeRowVector(children);
+  };
+  auto input = makeData(false);
+
+  auto sortBuffer = std::make_unique<SortBuffer>(
+      asRowType(input->type()),
+      std::vector<column_index_t>{0},
+      std::vector<CompareFlags>{
+          {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue}},
+      pool_.get(),
+      &nonReclaimableSection_,
+      prefixSortConfig_);
+  sortBuffer->addInput(input);
+  sortBuffer->noMoreInput();
+  auto output = sortBuffer->getOutput(numRows);
+  ASSERT_EQ(output->size(), numRows);
+  velox::test::assertEqualVectors(makeData(true), output);
+}
+
 TEST_F(SortBufferTest, multipleKeys) {
   auto sortBuffer = std::make_unique<SortBuffer>(
       inputType_,
       sortColumnIndices_,
       sortCompareFlags_,
       pool_.get(),
-      &nonReclaimableSection_);
+      &nonReclaimableSection_,
+      prefixSortConfig_);
 
   RowVectorPtr data = makeRowVector(
       {makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
@@ -233,7 +276,8 @@ TEST_F(SortBufferTest, DISABLED_randomData) {
         testData.sortColumnIndices,
         testData.sortCompareFlags,
         pool_.get(),
-        &nonReclaimableSection_);
+        &nonReclaimableSection_,
+        prefixSortConfig_);
 
     const std::shared_ptr<memory::MemoryPool> fuzzerPool =
         memory::memoryManager()->addLeafPool("VectorFuzzer");
@@ -307,6 +351,7 @@ TEST_F(SortBufferTest, batchOutput) {
         sortCompareFlags_,
         pool_.get(),
         &nonReclaimableSection_,
+        prefixSortConfig_,
         testData.triggerSpill ? &spillConfig : nullptr,
         &spillStats);
     ASSERT_EQ(sortBuffer->canSpill(), testData.triggerSpill);
@@ -402,6 +447,7 @@ TEST_F(SortBufferTest, spill) {
         sortCompareFlags_,
         pool_.get(),
         &nonReclaimableSection_,
+        prefixSortConfig_,
         testData.spillEnabled ? &spillConfig : nullptr,
         &spillStats);
 
@@ -463,6 +509,7 @@ TEST_F(SortBufferTest, emptySpill) {
         sortCompareFlags_,
         pool_.get(),
         &nonReclaimableSection_,
+        prefixSortConfig_,
         &spillConfig,
         &spillStats);
 
@@ -475,4 +522,150 @@ TEST_F(SortBufferTest, emptySpill) {
     ASSERT_TRUE(spillStats.rlock()->empty());
   }
 }
+
+TEST_F(SortBufferTest, prefixSortSpillRuns) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("prefixSortSpillRuns");
+
+  for (bool spillEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("spillEnabled {}", spillEnabled));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto spillConfig = getSpillConfig(spillDirectory->getPath());
+    spillConfig.prefixSortConfig = prefixSortConfig_;
+    folly::Synchronized<common::SpillStats> spillStats;
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        prefixSortConfig_,
+        spillEnabled ? &spillConfig : nullptr,
+        &spillStats);
+
+    VectorFuzzer fuzzer({.vectorSize = 1024}, fuzzerPool.get());
+    uint64_t numInputRows{0};
+    for (auto i = 0; i < 4; ++i) {
+      sortBuffer->addInput(fuzzer.fuzzRow(inputType_));
+      numInputRows += 1024;
+      if (spillEnabled) {
+        sortBuffer->spill();
+      }
+    }
+    sortBuffer->noMoreInput();
+    ASSERT_EQ(spillStats.rlock()->empty(), !spillEnabled);
+
+    // Returns the comparison of 'leftRow' of 'left' and 'rightRow' of 'right'
+    // on the sort keys.
+    const auto compareKeys = [&](const RowVectorPtr& left,
+                                 vector_size_t leftRow,
+                                 const RowVectorPtr& right,
+                                 vector_size_t rightRow) {
+      for (auto i = 0; i < sortColumnIndices_.size(); ++i) {
+        const auto channel = sortColumnIndices_[i];
+        const auto result = left->childAt(channel)->compare(
+            right->childAt(channel).get(),
+            leftRow,
+            rightRow,
+            sortCompareFlags_[i]);
+        VELOX_CHECK(result.has_value());
+        if (result.value() != 0) {
+          return result.value();
+        }
+      }
+      return 0;
+    };
+
+    // The output vector is reused, so the last row of the previous output is
+    // copied.
+    RowVectorPtr lastRow;
+    uint64_t numOutputRows{0};
+    while (auto output = sortBuffer->getOutput(1000)) {
+      if (lastRow != nullptr) {
+        ASSERT_LE(compareKeys(lastRow, 0, output, 0), 0);
+      }
+      for (vector_size_t row = 1; row < output->size(); ++row) {
+        ASSERT_LE(compareKeys(output, row - 1, output, row), 0);
+      }
+      lastRow = BaseVector::create<RowVector>(inputType_, 1, pool_.get());
+      lastRow->copy(output.get(), 0, output->size() - 1, 1);
+      numOutputRows += output->size();
+    }
+    ASSERT_EQ(numOutputRows, numInputRows);
+  }
+}
+
+TEST_F(SortBufferTest, spillDuringOutput) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("spillDuringOutput");
+
+  for (bool spillEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("spillEnabled {}", spillEnabled));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto spillConfig = getSpillConfig(spillDirectory->getPath());
+    folly::Synchronized<common::SpillStats> spillStats;
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        prefixSortConfig_,
+        spillEnabled ? &spillConfig : nullptr,
+        &spillStats);
+
+    VectorFuzzer fuzzer({.vectorSize = 1024}, fuzzerPool.get());
+    for (auto i = 0; i < 3; ++i) {
+      sortBuffer->addInput(fuzzer.fuzzRow(inputType_));
+    }
+    sortBuffer->noMoreInput();
+    ASSERT_TRUE(spillStats.rlock()->empty());
+
+    const auto compareKeys = [&](const RowVectorPtr& left,
+                                 vector_size_t leftRow,
+                                 const RowVectorPtr& right,
+                                 vector_size_t rightRow) {
+      for (auto i = 0; i < sortColumnIndices_.size(); ++i) {
+        const auto channel = sortColumnIndices_[i];
+        const auto result = left->childAt(channel)->compare(
+            right->childAt(channel).get(),
+            leftRow,
+            rightRow,
+            sortCompareFlags_[i]);
+        VELOX_CHECK(result.has_value());
+        if (result.value() != 0) {
+          return result.value();
+        }
+      }
+      return 0;
+    };
+
+    // The first batch comes from memory. The next ensureOutputFits() spills
+    // the remaining rows, which are then merged from disk.
+    RowVectorPtr lastRow;
+    uint64_t numOutputRows{0};
+    sortBuffer->ensureOutputFits(1000);
+    auto output = sortBuffer->getOutput(1000);
+    while (output != nullptr) {
+      if (lastRow != nullptr) {
+        ASSERT_LE(compareKeys(lastRow, 0, output, 0), 0);
+      }
+      for (vector_size_t row = 1; row < output->size(); ++row) {
+        ASSERT_LE(compareKeys(output, row - 1, output, row), 0);
+      }
+      lastRow = BaseVector::create<RowVector>(inputType_, 1, pool_.get());
+      lastRow->copy(output.get(), 0, output->size() - 1, 1);
+      numOutputRows += output->size();
+
+      TestScopedSpillInjection scopedSpillInjection(100);
+      sortBuffer->ensureOutputFits(1000);
+      output = sortBuffer->getOutput(1000);
+    }
+    ASSERT_EQ(numOutputRows, 3 * 1024);
+    ASSERT_EQ(spillStats.rlock()->empty(), !spillEnabled);
+    if (spillEnabled) {
+      ASSERT_EQ(spillStats.rlock()->spilledRows, 3 * 1024 - 1000);
+    }
+  }
+}
 } // namespace facebook::velox::functions::test
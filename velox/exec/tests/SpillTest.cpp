@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -519,6 +520,251 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, spillEncodedColumns) {
+  // Verify that dictionary and constant encoded columns are read back with
+  // their encodings and in append order with flat batches.
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      0,
+      emptyCompareFlags,
+      1 << 20,
+      1 << 20,
+      compressionKind_,
+      pool(),
+      &spillStats_);
+  state.setPartitionSpilled(0);
+
+  constexpr vector_size_t kSize = 1'000;
+  auto flat = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeFlatVector<StringView>(kSize, [](auto /*row*/) { return "flat"; }),
+  });
+  auto encoded = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(kSize, [](auto row) { return row % 2; }),
+          kSize,
+          makeFlatVector<StringView>(
+              {"a long dictionary value 0", "a long dictionary value 1"})),
+  });
+  auto constant = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeConstant<StringView>("a long constant value", kSize),
+  });
+  const std::vector<RowVectorPtr> inputs = {flat, encoded, constant, flat};
+  for (const auto& input : inputs) {
+    state.appendToPartition(0, input);
+  }
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  auto reader =
+      spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+  RowVectorPtr output;
+  for (const auto& input : inputs) {
+    ASSERT_TRUE(reader->nextBatch(output));
+    assertEqualVectors(input, output);
+    ASSERT_EQ(output->childAt(1)->encoding(), input->childAt(1)->encoding());
+  }
+  ASSERT_FALSE(reader->nextBatch(output));
+  // All batches are buffered and written with one write at the end.
+  ASSERT_EQ(spillStats_.rlock()->spillWrites, 1);
+}
+
+TEST_P(SpillTest, overflowSpillDirectory) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto overflowDirectory = exec::test::TempDirectoryPath::create();
+  const std::string overflowPath = overflowDirectory->getPath();
+  bool overflow{false};
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      0,
+      emptyCompareFlags,
+      1 << 20,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      "",
+      [&]() -> std::string_view {
+        return overflow ? std::string_view(overflowPath) : std::string_view();
+      });
+  state.setPartitionSpilled(0);
+
+  auto input = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  state.appendToPartition(0, input);
+  state.finishFile(0);
+  ASSERT_EQ(spillStats_.rlock()->spilledOverflowBytes, 0);
+  ASSERT_EQ(spillStats_.rlock()->spilledOverflowFiles, 0);
+
+  // The next file goes to the overflow directory.
+  overflow = true;
+  state.appendToPartition(0, input);
+  const auto filePaths = state.testingSpilledFilePaths();
+  ASSERT_EQ(filePaths.size(), 2);
+  ASSERT_EQ(filePaths[0].find(tempDirectory->getPath()), 0);
+  ASSERT_EQ(filePaths[1].find(overflowPath), 0);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  {
+    const auto stats = spillStats_.copy();
+    ASSERT_EQ(stats.spilledFiles, 2);
+    ASSERT_EQ(stats.spilledOverflowFiles, 1);
+    ASSERT_GT(stats.spilledOverflowBytes, 0);
+    ASSERT_LT(stats.spilledOverflowBytes, stats.spilledBytes);
+  }
+
+  auto reader =
+      spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+  RowVectorPtr output;
+  for (auto i = 0; i < 2; ++i) {
+    ASSERT_TRUE(reader->nextBatch(output));
+    assertEqualVectors(input, output);
+  }
+  ASSERT_FALSE(reader->nextBatch(output));
+}
+
+TEST_P(SpillTest, readAhead) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      0,
+      emptyCompareFlags,
+      1 << 30,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_);
+  state.setPartitionSpilled(0);
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 20; ++i) {
+    inputs.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [i](auto row) { return i * 1'000 + row; })}));
+    state.appendToPartition(0, inputs.back());
+  }
+  const auto files = state.finish(0);
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  constexpr uint64_t kReadSize = 1 << 10;
+  constexpr uint64_t kBufferSize = kReadSize + AlignedBuffer::kPaddedSize;
+  for (const uint32_t depth : {0, 1, 4}) {
+    for (const bool withBudget : {false, true}) {
+      SCOPED_TRACE(fmt::format("depth {} withBudget {}", depth, withBudget));
+      SpillReadAheadOptions readAheadOptions{
+          depth,
+          executor.get(),
+          withBudget
+              ? std::make_shared<common::SpillReadAheadBudget>(2 * kReadSize)
+              : nullptr};
+      {
+        SpillPartition spillPartition(SpillPartitionId{0, 0}, files);
+        auto reader = spillPartition.createUnorderedReader(
+            kBufferSize, pool(), &spillStats_, readAheadOptions);
+        RowVectorPtr output;
+        for (const auto& input : inputs) {
+          ASSERT_TRUE(reader->nextBatch(output));
+          assertEqualVectors(input, output);
+          if (withBudget) {
+            ASSERT_LE(
+                readAheadOptions.budget->reservedBytes(),
+                readAheadOptions.budget->capacity());
+          }
+        }
+        ASSERT_FALSE(reader->nextBatch(output));
+      }
+      if (withBudget) {
+        ASSERT_EQ(readAheadOptions.budget->reservedBytes(), 0);
+      }
+    }
+  }
+}
+
+TEST_P(SpillTest, boundedMergeFanIn) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      emptyCompareFlags,
+      1 << 30,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_);
+  state.setPartitionSpilled(0);
+  // Spills 10 sorted files of different sizes.
+  constexpr int32_t kNumFiles = 10;
+  std::vector<int64_t> expected;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    auto input = makeRowVector({makeFlatVector<int64_t>(
+        (i + 1) * 100, [i](auto row) { return i + kNumFiles * row; })});
+    for (auto row = 0; row < input->size(); ++row) {
+      expected.push_back(i + kNumFiles * row);
+    }
+    state.appendToPartition(0, input);
+    state.finishFile(0);
+  }
+  std::sort(expected.begin(), expected.end());
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  ASSERT_EQ(spillPartition.numFiles(), kNumFiles);
+  ASSERT_EQ(spillStats_.rlock()->spilledFiles, kNumFiles);
+
+  common::SpillConfig spillConfig;
+  spillConfig.getSpillDirPathCb = [&]() -> const std::string& {
+    return tempDirectory->getPath();
+  };
+  spillConfig.updateAndCheckSpillLimitCb = updateSpilledBytesCb_;
+  spillConfig.fileNamePrefix = "test";
+  spillConfig.writeBufferSize = 0;
+  spillConfig.readBufferSize = 1 << 20;
+  spillConfig.executor = nullptr;
+  spillConfig.readAheadDepth = 0;
+  spillConfig.maxMergeBytes = 3 << 20;
+  ASSERT_EQ(SpillPartition::maxMergeFanIn(spillConfig), 3);
+  spillConfig.maxMergeBytes = 0;
+  ASSERT_EQ(
+      SpillPartition::maxMergeFanIn(spillConfig),
+      std::numeric_limits<uint32_t>::max());
+  spillConfig.maxMergeBytes = 1;
+  ASSERT_EQ(SpillPartition::maxMergeFanIn(spillConfig), 2);
+  spillConfig.maxMergeBytes = 3 << 20;
+
+  auto merge =
+      spillPartition.createOrderedReader(spillConfig, pool(), &spillStats_);
+  // The first pass merges the 2 smallest files and each of the 3 later passes
+  // merges 3 files, which leaves 3 files for the final merge.
+  ASSERT_EQ(spillStats_.rlock()->spilledFiles, kNumFiles + 4);
+  auto fs = filesystems::getFileSystem(tempDirectory->getPath(), nullptr);
+  ASSERT_EQ(fs->list(tempDirectory->getPath()).size(), 3);
+  for (const auto value : expected) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(
+        stream->current().childAt(0)->asFlatVector<int64_t>()->valueAt(
+            stream->currentIndex()),
+        value);
+    stream->pop();
+  }
+  ASSERT_EQ(merge->next(), nullptr);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -583,7 +583,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
         type_ == Spiller::Type::kOrderByOutput) {
       spiller_ = std::make_unique<Spiller>(
           type_, rowContainer_.get(), rowType_, &spillConfig_, &spillStats_);
-    } else if (type_ == Spiller::Type::kRowNumber) {
+    } else if (
+        type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kAggregateHashPartitioned) {
       spiller_ = std::make_unique<Spiller>(
           type_,
           rowContainer_.get(),
@@ -771,7 +773,8 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kHashJoinProbe ||
-        type_ == Spiller::Type::kRowNumber);
+        type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kAggregateHashPartitioned);
 
     const int numSpillPartitions = type_ != Spiller::Type::kHashJoinProbe
         ? numPartitions_
@@ -853,7 +856,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
           ASSERT_GT(stats.spilledRows, 0);
           ASSERT_GT(stats.spilledBytes, 0);
           ASSERT_GT(stats.spillWriteTimeUs, 0);
-          ASSERT_GT(stats.spillFlushTimeUs, 0);
+          // The partitioned inputs are dictionary encoded and serialized into
+          // encoded pages on append, so there is no flush time.
+          ASSERT_EQ(stats.spillFlushTimeUs, 0);
           ASSERT_GT(stats.spillSerializationTimeUs, 0);
           ASSERT_GT(stats.spillWrites, 0);
         }
@@ -868,7 +873,8 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       ASSERT_GT(stats.spilledPartitions, 0);
       ASSERT_EQ(stats.spillSortTimeUs, 0);
       if (type_ == Spiller::Type::kHashJoinBuild ||
-          type_ == Spiller::Type::kRowNumber) {
+          type_ == Spiller::Type::kRowNumber ||
+          type_ == Spiller::Type::kAggregateHashPartitioned) {
         ASSERT_GT(stats.spillFillTimeUs, 0);
       } else {
         ASSERT_EQ(stats.spillFillTimeUs, 0);
@@ -922,6 +928,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kAggregateHashPartitioned ||
         type_ == Spiller::Type::kHashJoinProbe);
 
     SpillPartitionSet spillPartitionSet;
@@ -994,6 +1001,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     ASSERT_TRUE(
         type_ == Spiller::Type::kHashJoinBuild ||
         type_ == Spiller::Type::kRowNumber ||
+        type_ == Spiller::Type::kAggregateHashPartitioned ||
         type_ == Spiller::Type::kHashJoinProbe);
 
     SpillPartitionSet spillPartitionSet;
@@ -1211,6 +1219,7 @@ class NoHashJoin : public SpillerTest,
             {Spiller::Type::kHashJoinProbe,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kRowNumber,
+             Spiller::Type::kAggregateHashPartitioned,
              Spiller::Type::kOrderByOutput}}
         .getTestParams();
   }
@@ -1362,6 +1371,7 @@ class AggregationOutputOnly : public SpillerTest,
             {Spiller::Type::kAggregateInput,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kRowNumber,
+             Spiller::Type::kAggregateHashPartitioned,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kOrderByInput,
              Spiller::Type::kOrderByOutput}}
@@ -1483,6 +1493,7 @@ class OrderByOutputOnly : public SpillerTest,
              Spiller::Type::kHashJoinBuild,
              Spiller::Type::kHashJoinProbe,
              Spiller::Type::kRowNumber,
+             Spiller::Type::kAggregateHashPartitioned,
              Spiller::Type::kOrderByInput}}
         .getTestParams();
   }
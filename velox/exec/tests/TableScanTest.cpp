@@ -31,6 +31,7 @@
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/FragmentResultCache.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -1505,6 +1506,32 @@ TEST_F(TableScanTest, preloadingSplitClose) {
   latch.wait();
 }
 
+TEST_F(TableScanTest, splitFilePrefetch) {
+  auto filePaths = makeFilePaths(100);
+  auto vectors = makeVectors(100, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto numPreloadSplits : {0, 2}) {
+    SCOPED_TRACE(fmt::format("numPreloadSplits {}", numPreloadSplits));
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kMaxSplitPreloadPerDriver,
+                std::to_string(numPreloadSplits))
+            .config(core::QueryConfig::kMaxSplitFilePrefetchPerDriver, "4")
+            .splits(makeHiveConnectorSplits(filePaths))
+            .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    ASSERT_GT(stats.at("filePrefetchedSplits").sum, 10);
+  }
+
+  auto task = assertQuery(tableScanNode(), filePaths, "SELECT * FROM tmp");
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("filePrefetchedSplits"), 0);
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
@@ -1694,6 +1721,24 @@ TEST_F(TableScanTest, splitOffsetAndLength) {
       "SELECT * FROM tmp LIMIT 0");
 }
 
+TEST_F(TableScanTest, skipSplitRangeWithoutStripes) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  // The file has a single stripe, so only the split that has its start has
+  // rows. The other ones are skipped before making a row reader.
+  constexpr int kNumSplits = 10;
+  auto hiveSplits = makeHiveConnectorSplits(
+      filePath->getPath(), kNumSplits, dwio::common::FileFormat::DWRF);
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits(
+      hiveSplits.begin(), hiveSplits.end());
+  auto task = OperatorTestBase::assertQuery(
+      tableScanNode(), splits, "SELECT * FROM tmp");
+  EXPECT_EQ(getSkippedSplitsStat(task), kNumSplits - 1);
+}
+
 TEST_F(TableScanTest, fileNotFound) {
   auto split = HiveConnectorSplitBuilder("/path/to/nowhere.orc").build();
   auto assertMissingFile = [&](bool ignoreMissingFiles) {
@@ -3622,6 +3667,96 @@ TEST_F(TableScanTest, lazyVectorAccessTwiceWithDifferentRows) {
       "SELECT c0, c1 from tmp where ([c0 + c1, if(c1 >= 0, c1, 0)])[1] > 0");
 }
 
+TEST_F(TableScanTest, nullableStructLazy) {
+  constexpr vector_size_t kSize = 2'000;
+  auto data = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<int64_t>(kSize, folly::identity),
+          makeRowVector(
+              {"a", "s"},
+              {
+                  makeFlatVector<int64_t>(
+                      kSize, folly::identity, nullEvery(7)),
+                  makeRowVector(
+                      {"x"},
+                      {makeFlatVector<int64_t>(
+                          kSize, [](auto row) { return row * 10; })},
+                      nullEvery(3)),
+              },
+              nullEvery(5)),
+      });
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {data});
+  auto rowType = asRowType(data->type());
+
+  // The fields of the nullable struct are LazyVectors that load only the
+  // rows that are accessed.
+  {
+    CursorParameters params;
+    params.planNode = PlanBuilder().tableScan(rowType).planNode();
+    auto cursor = TaskCursor::create(params);
+    cursor->task()->addSplit("0", makeHiveSplit(filePath->getPath()));
+    cursor->task()->noMoreSplits("0");
+    ASSERT_TRUE(cursor->moveNext());
+    auto result = cursor->current();
+    auto& c1 = result->childAt(1);
+    ASSERT_TRUE(c1->isLazy());
+    std::vector<vector_size_t> rows;
+    for (auto i = 0; i < result->size(); i += 2) {
+      rows.push_back(i);
+    }
+    auto* lazy = c1->asUnchecked<LazyVector>();
+    lazy->load(RowSet(rows), nullptr);
+    auto& loaded = lazy->loadedVectorShared();
+    auto* struct1 = loaded->wrappedVector()->asUnchecked<RowVector>();
+    ASSERT_TRUE(struct1->childAt(0)->isLazy());
+    ASSERT_TRUE(struct1->childAt(1)->isLazy());
+    loaded->loadedVector();
+    for (auto row : rows) {
+      ASSERT_TRUE(loaded->equalValueAt(data->childAt(1).get(), row, row))
+          << row;
+    }
+    while (cursor->moveNext()) {
+    }
+  }
+
+  // Some batches are not accessed, so that the unloaded fields skip over
+  // the parent nulls when the next batch is loaded.
+  const std::vector<std::pair<std::string, std::function<bool(int32_t)>>>
+      filters = {
+          {"(c0 / 100) % 2 = 1", [](auto row) { return (row / 100) % 2 == 1; }},
+          {"c0 % 3 = 0", [](auto row) { return row % 3 == 0; }},
+      };
+  for (const auto& [filter, passes] : filters) {
+    SCOPED_TRACE(filter);
+    auto plan = PlanBuilder()
+                    .tableScan(rowType)
+                    .filter(filter)
+                    .project({"c1.a", "c1.s.x"})
+                    .planNode();
+    std::vector<std::optional<int64_t>> a;
+    std::vector<std::optional<int64_t>> x;
+    for (auto row = 0; row < kSize; ++row) {
+      if (!passes(row)) {
+        continue;
+      }
+      a.push_back(
+          row % 5 == 0 || row % 7 == 0 ? std::nullopt
+                                       : std::optional<int64_t>(row));
+      x.push_back(
+          row % 5 == 0 || row % 3 == 0 ? std::nullopt
+                                       : std::optional<int64_t>(row * 10));
+    }
+    AssertQueryBuilder(plan)
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+        .config(core::QueryConfig::kMaxOutputBatchRows, "100")
+        .split(makeHiveConnectorSplit(filePath->getPath()))
+        .assertResults(makeRowVector(
+            {makeNullableFlatVector(a), makeNullableFlatVector(x)}));
+  }
+}
+
 TEST_F(TableScanTest, structInArrayOrMap) {
   vector_size_t size = 1'000;
 
@@ -3760,6 +3895,164 @@ TEST_F(TableScanTest, parallelPrepare) {
       .copyResults(pool_.get());
 }
 
+TEST_F(TableScanTest, asyncIo) {
+  auto rows = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  auto writeConfig = std::make_shared<dwrf::Config>();
+  writeConfig->set<uint64_t>(
+      dwrf::Config::STRIPE_SIZE, rows->size() * sizeof(int64_t));
+  std::vector<RowVectorPtr> vectors(20, rows);
+  auto filePaths = makeFilePaths(4);
+  std::vector<RowVectorPtr> allVectors;
+  for (const auto& filePath : filePaths) {
+    writeToFile(filePath->getPath(), vectors, writeConfig);
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  // Loads the stripes after the one being read on the IO executor.
+  std::unordered_map<std::string, std::string> hiveConfig{
+      {connector::hive::HiveConfig::kUnitPrefetchBytes, "1000000"}};
+  resetHiveConnector(std::make_shared<core::MemConfig>(hiveConfig));
+
+  for (const auto asyncIo : {false, true}) {
+    SCOPED_TRACE(fmt::format("asyncIo {}", asyncIo));
+    auto task =
+        AssertQueryBuilder(tableScanNode(asRowType(rows->type())),
+                           duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kTableScanAsyncIo,
+                asyncIo ? "true" : "false")
+            .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "2")
+            .splits(makeHiveConnectorSplits(filePaths))
+            .assertResults("SELECT * FROM tmp");
+    if (!asyncIo) {
+      // Waits only happen in the async mode. Whether a read finds its IO done
+      // depends on timing, so the async run does not check the counts.
+      const auto stats = task->taskStats().pipelineStats[0].operatorStats[0];
+      EXPECT_EQ(0, stats.runtimeStats.count("numAsyncIoWaits"));
+      EXPECT_EQ(0, stats.runtimeStats.count("asyncSplitPreloadWaits"));
+    }
+  }
+}
+
+DEBUG_ONLY_TEST_F(TableScanTest, splitStealing) {
+  auto rows = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  auto writeConfig = std::make_shared<dwrf::Config>();
+  writeConfig->set<uint64_t>(
+      dwrf::Config::STRIPE_SIZE, rows->size() * sizeof(int64_t));
+  std::vector<RowVectorPtr> vectors(20, rows);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors, writeConfig);
+  createDuckDbTable(vectors);
+
+  // The driver that gets the only split waits after offering its stripes
+  // until the other driver has taken over a part of them.
+  folly::Baton<> added;
+  folly::Baton<> stolen;
+  std::atomic_int32_t numAdded{0};
+  std::atomic_int32_t numGotSplits{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::TableScan::getOutput::addStealableSplit",
+      std::function<void(const TableScan*)>(([&](const TableScan*) {
+        if (++numAdded == 1) {
+          added.post();
+        }
+        stolen.try_wait_for(std::chrono::seconds(10));
+      })));
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::TableScan::getOutput::stealSplit",
+      std::function<void(const TableScan*)>(([&](const TableScan*) {
+        added.try_wait_for(std::chrono::seconds(10));
+      })));
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::TableScan::getOutput::gotSplit",
+      std::function<void(const TableScan*)>(([&](const TableScan*) {
+        if (++numGotSplits == 2) {
+          stolen.post();
+        }
+      })));
+
+  auto task =
+      AssertQueryBuilder(tableScanNode(asRowType(rows->type())),
+                         duckDbQueryRunner_)
+          .config(core::QueryConfig::kTableScanSplitStealing, "true")
+          .maxDrivers(2)
+          .split(makeHiveConnectorSplit(filePath->getPath()))
+          .assertResults("SELECT * FROM tmp");
+  const auto stats = task->taskStats().pipelineStats[0].operatorStats[0];
+  EXPECT_EQ(1, stats.numSplits);
+  EXPECT_LE(1, stats.runtimeStats.at("stolenSplits").sum);
+}
+
+TEST_F(TableScanTest, fragmentResultCache) {
+  auto cacheDirectory = exec::test::TempDirectoryPath::create();
+  FragmentResultCache::testingReset();
+  FragmentResultCache::Config config;
+  config.directory = cacheDirectory->getPath();
+  FragmentResultCache::init(config);
+  auto resetCache =
+      folly::makeGuard([]() { FragmentResultCache::testingReset(); });
+  auto* cache = FragmentResultCache::instance();
+
+  auto vectors = makeVectors(10, 1'000);
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < 2; ++i) {
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), vectors);
+  }
+  createDuckDbTable(vectors);
+
+  auto makeSplits = [&](int64_t modificationTime) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(HiveConnectorSplitBuilder(filePath->getPath())
+                           .fileProperties({std::nullopt, modificationTime})
+                           .build());
+    }
+    return splits;
+  };
+  auto makePlan = [&](const std::string& filter) {
+    return PlanBuilder()
+        .tableScan(rowType_)
+        .filter(filter)
+        .partialAggregation({"c6"}, {"max(c0)", "count(1)"})
+        .finalAggregation()
+        .planNode();
+  };
+  auto runQuery = [&](const std::string& filter,
+                      int64_t modificationTime,
+                      bool enabled = true) {
+    auto task =
+        AssertQueryBuilder(makePlan(filter), duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kFragmentResultCacheEnabled,
+                enabled ? "true" : "false")
+            .splits(makeSplits(modificationTime))
+            .assertResults(fmt::format(
+                "SELECT c6, max(c0), count(1) * 2 FROM tmp WHERE {} "
+                "GROUP BY c6",
+                filter));
+    const auto stats = task->taskStats().pipelineStats[0].operatorStats[0];
+    EXPECT_EQ(2, stats.numSplits);
+    auto it = stats.runtimeStats.find("cachedSplitResults");
+    return it == stats.runtimeStats.end() ? 0 : it->second.sum;
+  };
+
+  EXPECT_EQ(0, runQuery("c0 % 3 = 0", 1));
+  EXPECT_EQ(2, cache->stats().writes);
+  EXPECT_EQ(2, runQuery("c0 % 3 = 0", 1));
+  EXPECT_EQ(2, cache->stats().hits);
+
+  // Another plan or a changed file does not use the cached results.
+  EXPECT_EQ(0, runQuery("c0 % 3 = 1", 1));
+  EXPECT_EQ(0, runQuery("c0 % 3 = 0", 2));
+  EXPECT_EQ(6, cache->stats().writes);
+  EXPECT_EQ(0, runQuery("c0 % 3 = 0", 1, false));
+  EXPECT_EQ(2, runQuery("c0 % 3 = 1", 1));
+}
+
 TEST_F(TableScanTest, dictionaryMemo) {
   constexpr int kSize = 100;
   const char* baseStrings[] = {
@@ -4457,6 +4750,71 @@ TEST_F(TableScanTest, readFlatMapAsStruct) {
   AssertQueryBuilder(plan).split(split).assertResults(vector);
 }
 
+TEST_F(TableScanTest, readFlatMapAsStructWithKeyFilter) {
+  constexpr int kSize = 10;
+  std::vector<std::string> keys = {"1", "2", "3"};
+  auto vector = makeRowVector({makeRowVector(
+      keys,
+      {
+          makeFlatVector<int64_t>(kSize, folly::identity),
+          makeFlatVector<int64_t>(kSize, folly::identity, nullEvery(5)),
+          makeFlatVector<int64_t>(kSize, folly::identity, nullEvery(7)),
+      })});
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set<const std::vector<uint32_t>>(dwrf::Config::MAP_FLAT_COLS, {0});
+  config->set<const std::vector<std::vector<std::string>>>(
+      dwrf::Config::MAP_FLAT_COLS_STRUCT_KEYS, {keys});
+  auto file = TempFilePath::create();
+  auto writeSchema = ROW({"c0"}, {MAP(INTEGER(), BIGINT())});
+  writeToFile(file->getPath(), {vector}, config, writeSchema);
+
+  // Key 2 is filtered but not projected out.  Key 4 is not in the file.
+  auto readSchema = ROW({"c0"}, {ROW({"1", "4"}, {BIGINT(), BIGINT()})});
+  auto makePlan = [&](std::unique_ptr<common::Filter> filter,
+                      const std::string& key) {
+    auto tableHandle = makeTableHandle(
+        SubfieldFiltersBuilder()
+            .add(fmt::format("c0[{}]", key), std::move(filter))
+            .build(),
+        nullptr,
+        "hive_table",
+        writeSchema);
+    return PlanBuilder()
+        .startTableScan()
+        .outputType(readSchema)
+        .tableHandle(tableHandle)
+        .assignments(allRegularColumns(readSchema))
+        .endTableScan()
+        .planNode();
+  };
+  auto split = makeHiveConnectorSplit(file->getPath());
+
+  auto expected = makeRowVector({makeRowVector(
+      {"1", "4"},
+      {
+          makeFlatVector<int64_t>({6, 7, 8, 9}),
+          makeAllNullFlatVector<int64_t>(4),
+      })});
+  AssertQueryBuilder(makePlan(greaterThanOrEqual(6), "2"))
+      .split(split)
+      .assertResults(expected);
+
+  // A key that is not in the file is null in all rows.
+  AssertQueryBuilder(makePlan(greaterThanOrEqual(0), "4"))
+      .split(split)
+      .assertEmptyResults();
+  expected = makeRowVector({makeRowVector(
+      {"1", "4"},
+      {
+          makeFlatVector<int64_t>(kSize, folly::identity),
+          makeAllNullFlatVector<int64_t>(kSize),
+      })});
+  AssertQueryBuilder(makePlan(isNull(), "4"))
+      .split(split)
+      .assertResults(expected);
+}
+
 // TODO: re-enable this test once we add back driver suspension support for
 // table scan.
 TEST_F(TableScanTest, DISABLED_memoryArbitrationWithSlowTableScan) {
@@ -4672,3 +5030,112 @@ DEBUG_ONLY_TEST_F(TableScanTest, cancellationToken) {
   }
   queryThread.join();
 }
+
+TEST_F(TableScanTest, topNThreshold) {
+  // Files with increasing values of 'c0'. Once the heap of the TopN is full,
+  // the leading key of its top row is pushed down to the scan, which then
+  // drops the rows of the later files.
+  const vector_size_t size = 1'000;
+  const int32_t numFiles = 10;
+  auto filePaths = makeFilePaths(numFiles);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < numFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return i * size + row; }, nullEvery(7)),
+        makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+    }));
+    writeToFile(filePaths[i]->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId scanNodeId;
+  core::PlanNodeId topNNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(vectors[0]->type()))
+                  .capturePlanNodeId(scanNodeId)
+                  .topN({"c0"}, 10, false)
+                  .capturePlanNodeId(topNNodeId)
+                  .planNode();
+  auto task =
+      assertQuery(plan, filePaths, "SELECT * FROM tmp ORDER BY c0 LIMIT 10");
+  const auto scanStats = toPlanStats(task->taskStats()).at(scanNodeId);
+  ASSERT_EQ(
+      scanStats.dynamicFilterStats.producerNodeIds,
+      std::unordered_set<core::PlanNodeId>({topNNodeId}));
+  ASSERT_LT(scanStats.outputRows, 2 * size);
+}
+
+TEST_F(TableScanTest, remoteDynamicFilter) {
+  common::Filter::registerSerDe();
+  auto data = makeRowVector(
+      {"c0"}, {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {data});
+
+  // A join in another task exports a filter on its probe key 't0'.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  auto joinPlan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({makeRowVector(
+              {"t0"}, {makeFlatVector<int64_t>({10, 11, 12})})})
+          .hashJoin(
+              {"t0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator)
+                  .values({makeRowVector(
+                      {"u0"}, {makeFlatVector<int64_t>({10, 20, 30, 40})})})
+                  .planNode(),
+              "",
+              {"t0"})
+          .capturePlanNodeId(joinNodeId)
+          .planNode();
+  std::shared_ptr<Task> joinTask;
+  AssertQueryBuilder(joinPlan)
+      .config(core::QueryConfig::kExportJoinDynamicFilters, "true")
+      .copyResults(pool(), joinTask);
+  const auto exported = joinTask->exportedDynamicFilters();
+  ASSERT_EQ(exported.size(), 1);
+  ASSERT_EQ(exported[0]["producer"].asString(), joinNodeId);
+  ASSERT_EQ(exported[0]["column"].asString(), "t0");
+
+  // The scan of column 'c0' waits for the filter before reading its split, so
+  // that all of its output is filtered.
+  core::PlanNodeId scanNodeId;
+  CursorParameters params;
+  params.planNode = PlanBuilder()
+                        .tableScan(asRowType(data->type()))
+                        .capturePlanNodeId(scanNodeId)
+                        .planNode();
+  std::thread producer;
+  bool splitsAdded{false};
+  auto [cursor, results] = readCursor(params, [&](Task* task) {
+    if (splitsAdded) {
+      return;
+    }
+    splitsAdded = true;
+    task->expectRemoteDynamicFilters(scanNodeId, 1, 60'000);
+    task->addSplit(scanNodeId, makeHiveSplit(filePath->getPath()));
+    task->noMoreSplits(scanNodeId);
+    producer = std::thread([&, task]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      task->addRemoteDynamicFilter(
+          scanNodeId,
+          "c0",
+          exported[0]["producer"].asString(),
+          ISerializable::deserialize<common::Filter>(exported[0]["filter"])
+              ->clone());
+    });
+  });
+  producer.join();
+
+  assertEqualResults(
+      {makeRowVector(
+          {"c0"}, {makeFlatVector<int64_t>({10, 20, 30, 40})})},
+      results);
+  const auto scanStats =
+      toPlanStats(cursor->task()->taskStats()).at(scanNodeId);
+  ASSERT_EQ(
+      scanStats.customStats.at("remoteDynamicFiltersAccepted").sum, 1);
+}
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/Task.h"
+#include "folly/ScopeGuard.h"
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/future/VeloxPromise.h"
@@ -858,6 +859,119 @@ TEST_F(TaskTest, singleThreadedHashJoin) {
   }
 }
 
+TEST_F(TaskTest, sharedHashBuild) {
+  auto left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int64_t>({1, 2, 3, 4}),
+          makeFlatVector<int64_t>({10, 20, 30, 40}),
+      });
+  auto leftPath = TempFilePath::create();
+  writeToFile(leftPath->getPath(), {left});
+
+  auto right = makeRowVector(
+      {"u_c0"},
+      {
+          makeFlatVector<int64_t>({0, 1, 3, 5}),
+      });
+
+  auto makePlan = [&](core::JoinType joinType,
+                      core::PlanNodeId& scanId,
+                      core::PlanNodeId& joinId) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .tableScan(asRowType(left->type()))
+        .capturePlanNodeId(scanId)
+        .hashJoin(
+            {"t_c0"},
+            {"u_c0"},
+            PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+            "",
+            {"t_c0", "t_c1", "u_c0"},
+            joinType)
+        .capturePlanNodeId(joinId)
+        .planFragment();
+  };
+
+  auto queryCtx = core::QueryCtx::create(
+      driverExecutor_.get(),
+      core::QueryConfig({}),
+      {},
+      cache::AsyncDataCache::getInstance(),
+      nullptr,
+      nullptr,
+      "sharedHashBuild");
+
+  core::PlanNodeId scanId;
+  core::PlanNodeId joinId;
+  const auto plan = makePlan(core::JoinType::kInner, scanId, joinId);
+
+  std::mutex mutex;
+  std::vector<RowVectorPtr> results;
+  auto consumer = [&](RowVectorPtr vector, ContinueFuture* /*future*/) {
+    if (vector != nullptr) {
+      std::lock_guard<std::mutex> l(mutex);
+      results.push_back(vector);
+    }
+    return BlockingReason::kNotBlocked;
+  };
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 3; ++i) {
+    tasks.push_back(Task::create(
+        fmt::format("sharedHashBuild.{}", i),
+        plan,
+        0,
+        queryCtx,
+        Task::ExecutionMode::kParallel,
+        consumer));
+    tasks.back()->setSharedHashBuild(joinId);
+  }
+  for (auto& task : tasks) {
+    task->start(2);
+  }
+  // The probes of all tasks wait for splits, so the tasks that start later
+  // find the table of the first one.
+  for (auto& task : tasks) {
+    task->addSplit(
+        scanId, exec::Split(makeHiveConnectorSplit(leftPath->getPath())));
+    task->noMoreSplits(scanId);
+  }
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  }
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({1, 3}),
+      makeFlatVector<int64_t>({10, 30}),
+      makeFlatVector<int64_t>({1, 3}),
+  });
+  assertEqualResults({expected, expected, expected}, results);
+
+  // Only the first task builds the table.
+  for (auto i = 0; i < tasks.size(); ++i) {
+    const auto& stats = toPlanStats(tasks[i]->taskStats()).at(joinId);
+    EXPECT_EQ(
+        stats.customStats.count(BaseHashTable::kBuildWallNanos),
+        i == 0 ? 1 : 0)
+        << i;
+  }
+  tasks.clear();
+
+  // A right join marks the build rows it matches and can't share its table.
+  const auto rightJoinPlan = makePlan(core::JoinType::kRight, scanId, joinId);
+  auto task = Task::create(
+      "sharedHashBuild.right",
+      rightJoinPlan,
+      0,
+      queryCtx,
+      Task::ExecutionMode::kParallel,
+      consumer);
+  task->setSharedHashBuild(joinId);
+  VELOX_ASSERT_THROW(
+      task->start(1), "RIGHT join can't share its hash table with other tasks");
+}
+
 TEST_F(TaskTest, singleThreadedCrossJoin) {
   auto left = makeRowVector({"t_c0"}, {makeFlatVector<int64_t>({1, 2, 3})});
   auto leftPath = TempFilePath::create();
@@ -985,6 +1099,39 @@ TEST_F(TaskTest, supportsSingleThreadedExecution) {
   ASSERT_FALSE(task->supportsSingleThreadedExecution());
 }
 
+TEST_F(TaskTest, singleThreadedPlanReuse) {
+  // Counts the plannings of the fragment with an adapter that only inspects.
+  const auto savedAdapters = DriverFactory::adapters;
+  SCOPE_EXIT {
+    DriverFactory::adapters = savedAdapters;
+  };
+  int32_t numPlannings = 0;
+  DriverFactory::registerAdapter(DriverAdapter{
+      "countPlannings",
+      [&](const core::PlanFragment&) { ++numPlannings; },
+      [](const DriverFactory&, Driver&) { return false; }});
+
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto plan = PlanBuilder().values({data}).project({"c0 * 2"}).planFragment();
+  auto task = Task::create(
+      "single.execution.task.0",
+      plan,
+      0,
+      core::QueryCtx::create(),
+      Task::ExecutionMode::kSerial);
+  ASSERT_TRUE(task->supportsSingleThreadedExecution());
+  ASSERT_EQ(numPlannings, 1);
+
+  int32_t numRows = 0;
+  while (auto result = task->next()) {
+    numRows += result->size();
+  }
+  EXPECT_EQ(numRows, 3);
+  // next() reuses the DriverFactories planned above.
+  EXPECT_EQ(numPlannings, 1);
+  EXPECT_EQ(task->taskStats().pipelineStats.size(), 1);
+}
+
 TEST_F(TaskTest, updateBroadCastOutputBuffers) {
   auto plan = PlanBuilder()
                   .tableScan(ROW({"c0"}, {BIGINT()}))
@@ -2068,6 +2215,144 @@ DEBUG_ONLY_TEST_F(TaskTest, driverEnqueAfterFailedAndPausedTask) {
   waitForAllTasksToBeDeleted();
 }
 
+TEST_F(TaskTest, stackSampling) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  const auto plan = PlanBuilder()
+                        .values({data}, false, 200)
+                        .project({"c0 * 7 + c0 % 13 AS a"})
+                        .singleAggregation({}, {"sum(a)"})
+                        .planNode();
+
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  EXPECT_EQ(nullptr, task->stackSampler());
+  EXPECT_EQ("", task->foldedStacks());
+
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kTaskStackSamplingIntervalMs, "1")
+      .copyResults(pool(), task);
+  if (!process::StackSampler::supported()) {
+    EXPECT_EQ(nullptr, task->stackSampler());
+    return;
+  }
+  ASSERT_NE(nullptr, task->stackSampler());
+  ASSERT_GT(task->stackSampler()->numSamples(), 0);
+  const auto folded = task->foldedStacks();
+  std::vector<std::string> lines;
+  folly::split('\n', folded, lines, true);
+  ASSERT_FALSE(lines.empty());
+  int64_t numSamples = 0;
+  for (const auto& line : lines) {
+    // Each line is rooted at the pipeline and ends with the sample count.
+    EXPECT_EQ(0, line.find("Pipeline 0;")) << line;
+    numSamples += folly::to<int64_t>(line.substr(line.rfind(' ') + 1));
+  }
+  EXPECT_EQ(task->stackSampler()->numSamples(), numSamples);
+}
+
+TEST_F(TaskTest, driverTimelineRingBuffer) {
+  DriverTimeline disabled;
+  disabled.add({DriverTimelineEvent::Kind::kRunning, 1, 1});
+  EXPECT_FALSE(disabled.enabled());
+  EXPECT_EQ(0, disabled.numEvents());
+  EXPECT_TRUE(disabled.events().empty());
+
+  DriverTimeline timeline(3);
+  for (auto i = 0; i < 5; ++i) {
+    timeline.add({DriverTimelineEvent::Kind::kQueued, 10u * i, 1});
+    timeline.add({DriverTimelineEvent::Kind::kRunning, 10u * i + 1, 2});
+  }
+  timeline.add(
+      {DriverTimelineEvent::Kind::kBlocked,
+       50,
+       7,
+       BlockingReason::kWaitForProducer,
+       2});
+  EXPECT_EQ(11, timeline.numEvents());
+  EXPECT_EQ(5, timeline.queuedMicros());
+  EXPECT_EQ(10, timeline.runningMicros());
+  EXPECT_EQ(7, timeline.blockedMicros().at(BlockingReason::kWaitForProducer));
+
+  // The last 3 events are kept, oldest first.
+  const auto events = timeline.events();
+  ASSERT_EQ(3, events.size());
+  EXPECT_EQ(40, events[0].startMicros);
+  EXPECT_EQ(41, events[1].startMicros);
+  EXPECT_EQ(50, events[2].startMicros);
+  EXPECT_EQ(DriverTimelineEvent::Kind::kBlocked, events[2].kind);
+  EXPECT_EQ(2, events[2].operatorId);
+}
+
+TEST_F(TaskTest, driverTimeline) {
+  auto probe = makeRowVector(
+      {"t0"}, {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  auto build = makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>(100, [](auto row) { return row * 3; })});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({probe}, true, 10)
+          .hashJoin(
+              {"t0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator)
+                  .values({build}, true)
+                  .planNode(),
+              "",
+              {"t0", "u0"})
+          .planNode();
+
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan).maxDrivers(2).copyResults(pool(), task);
+  for (const auto& pipelineStats : task->taskStats().pipelineStats) {
+    for (const auto& driverStats : pipelineStats.driverStats) {
+      EXPECT_TRUE(driverStats.timeline.empty());
+      EXPECT_EQ(
+          0, driverStats.runtimeStats.count(DriverStats::kTotalQueuedTime));
+    }
+  }
+
+  AssertQueryBuilder(plan)
+      .maxDrivers(2)
+      .config(core::QueryConfig::kDriverTimelineMaxEvents, "1000")
+      .copyResults(pool(), task);
+  const auto taskStats = task->taskStats();
+  int32_t numEvents = 0;
+  for (const auto& pipelineStats : taskStats.pipelineStats) {
+    ASSERT_EQ(2, pipelineStats.driverStats.size());
+    for (const auto& driverStats : pipelineStats.driverStats) {
+      ASSERT_FALSE(driverStats.timeline.empty());
+      EXPECT_EQ(
+          1, driverStats.runtimeStats.count(DriverStats::kTotalQueuedTime));
+      EXPECT_EQ(
+          1, driverStats.runtimeStats.count(DriverStats::kTotalOnThreadTime));
+      // A driver is queued before its first run and the events are in the
+      // order of their start.
+      EXPECT_EQ(
+          DriverTimelineEvent::Kind::kQueued,
+          driverStats.timeline.front().kind);
+      for (auto i = 1; i < driverStats.timeline.size(); ++i) {
+        EXPECT_LE(
+            driverStats.timeline[i - 1].startMicros,
+            driverStats.timeline[i].startMicros);
+      }
+      numEvents += driverStats.timeline.size();
+    }
+  }
+
+  const auto trace = toChromeTrace(taskStats);
+  const auto& traceEvents = trace["traceEvents"];
+  // One process name per pipeline and one slice per timeline event.
+  EXPECT_EQ(taskStats.pipelineStats.size() + numEvents, traceEvents.size());
+  for (const auto& event : traceEvents) {
+    if (event["ph"] == "X" && event["cat"] == "Blocked") {
+      EXPECT_TRUE(event["args"].count("blockingReason"));
+    }
+  }
+}
+
 DEBUG_ONLY_TEST_F(TaskTest, taskReclaimFailure) {
   const auto rowType =
       ROW({"c0", "c1", "c2"}, {INTEGER(), DOUBLE(), INTEGER()});
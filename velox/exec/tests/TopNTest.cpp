@@ -284,6 +284,81 @@ TEST_F(TopNTest, onlyKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+// Integer leading keys are prefiltered against the top row once the heap is
+// full. Covers all integer widths, ties on the leading key, flat batches with
+// and without nulls and constant batches.
+TEST_F(TopNTest, leadingKeyFilter) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto valueAt = [&](vector_size_t row) { return (row * 7 + i * 13) % 101; };
+    auto isNullAt = [&](vector_size_t row) {
+      return i % 3 == 1 && row % 9 == 0;
+    };
+    if (i == 5) {
+      vectors.push_back(makeRowVector({
+          makeConstant<int8_t>(50, batchSize),
+          makeConstant<int16_t>(50, batchSize),
+          makeConstant<int32_t>(std::nullopt, batchSize),
+          makeConstant<int64_t>(50, batchSize),
+          makeFlatVector<int32_t>(batchSize, [](auto row) { return row; }),
+      }));
+      continue;
+    }
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int8_t>(batchSize, valueAt, isNullAt),
+        makeFlatVector<int16_t>(batchSize, valueAt, isNullAt),
+        makeFlatVector<int32_t>(batchSize, valueAt, isNullAt),
+        makeFlatVector<int64_t>(batchSize, valueAt, isNullAt),
+        makeFlatVector<int32_t>(batchSize, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto& key : {"c0", "c1", "c2", "c3"}) {
+    testTwoKeys(vectors, key, "c4", 25);
+  }
+}
+
+TEST_F(TopNTest, sharedThreshold) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize,
+            [&](auto row) { return (row * 7 + i * 13) % 1'001; },
+            nullEvery(17)),
+        makeFlatVector<int32_t>(
+            batchSize, [&](auto row) { return i * batchSize + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // Each driver of the parallel values node produces all of 'vectors'. The
+  // partial TopN operators of all the drivers filter their input by the
+  // tightest top row of any of them.
+  for (const auto& sortOrderSql : getSortOrderSqls()) {
+    const auto key = fmt::format("c0 {}", sortOrderSql);
+    SCOPED_TRACE(key);
+    auto plan = PlanBuilder()
+                    .values(vectors, true)
+                    .topN({key, "c1"}, 25, true)
+                    .localMerge({key, "c1"})
+                    .topN({key, "c1"}, 25, false)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(4)
+        .assertResults(
+            fmt::format(
+                "SELECT * FROM (SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+                "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp) "
+                "ORDER BY {}, c1 LIMIT 25",
+                key),
+            {{0, 1}});
+  }
+}
+
 TEST_F(TopNTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b"},
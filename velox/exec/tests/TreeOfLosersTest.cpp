@@ -252,3 +252,33 @@ TEST_F(TreeOfLosersTest, randomWithDuplicates) {
     }
   }
 }
+
+TEST_F(TreeOfLosersTest, runnerUp) {
+  for (auto numStreams : {1, 2, 7, 16, 33}) {
+    TestData testData = makeTestData(2000, numStreams);
+    std::vector<TestingStream*> streams;
+    for (auto& source : testData.sources) {
+      streams.push_back(source.get());
+    }
+    TreeOfLosers<TestingStream> merge(std::move(testData.sources));
+    while (auto* stream = merge.next()) {
+      std::optional<uint32_t> expected;
+      for (auto* other : streams) {
+        if (other != stream && other->hasData()) {
+          expected = std::min(
+              expected.value_or(std::numeric_limits<uint32_t>::max()),
+              other->current()->value());
+        }
+      }
+      auto* runnerUp = merge.runnerUp();
+      if (!expected.has_value()) {
+        ASSERT_TRUE(runnerUp == nullptr);
+      } else {
+        ASSERT_TRUE(runnerUp != nullptr);
+        ASSERT_NE(runnerUp, stream);
+        ASSERT_EQ(runnerUp->current()->value(), expected.value());
+      }
+      stream->pop();
+    }
+  }
+}
@@ -424,7 +424,8 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // 17 rows per output. The output of an input row may be split across
+  // batches so that all batches but the last have 17 rows.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
@@ -432,10 +433,10 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(1 + 30'000 / 17, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // 2 rows per output splits each input row in two batches.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
@@ -443,7 +444,7 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(15'000, stats.at(unnestId).outputVectors);
   }
 
   // 100K rows per output allows to unnest all at once.
@@ -458,3 +459,52 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
 }
+
+TEST_F(UnnestTest, splitLargeArrays) {
+  // Arrays of 1, 2'500 and 7'000 elements with a null in between.
+  const std::vector<vector_size_t> sizes = {1, 2'500, 0, 7'000};
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({10, 20, 30, 40}),
+      makeArrayVector<int32_t>(
+          sizes.size(),
+          [&](auto row) { return sizes[row]; },
+          [](auto row, auto index) { return row * 10'000 + index; },
+          [](auto row) { return row == 2; }),
+  });
+  const vector_size_t numRows = 1 + 2'500 + 7'000;
+  std::vector<int64_t> keys;
+  std::vector<int32_t> elements;
+  std::vector<int64_t> ordinals;
+  for (auto row = 0; row < sizes.size(); ++row) {
+    for (auto i = 0; i < sizes[row]; ++i) {
+      keys.push_back((row + 1) * 10);
+      elements.push_back(row * 10'000 + i);
+      ordinals.push_back(i + 1);
+    }
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(keys),
+      makeFlatVector<int32_t>(elements),
+      makeFlatVector<int64_t>(ordinals),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1"}, "ordinal")
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+  for (auto batchRows : {1'000, 3'000, 10'000}) {
+    SCOPED_TRACE(fmt::format("batchRows: {}", batchRows));
+    auto task = AssertQueryBuilder(plan)
+                    .config(
+                        core::QueryConfig::kPreferredOutputBatchRows,
+                        std::to_string(batchRows))
+                    .assertResults({expected});
+    auto stats = exec::toPlanStats(task->taskStats());
+    ASSERT_EQ(numRows, stats.at(unnestId).outputRows);
+    ASSERT_EQ(
+        bits::roundUp(numRows, batchRows) / batchRows,
+        stats.at(unnestId).outputVectors);
+  }
+}
@@ -364,6 +364,63 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+TEST_F(VectorHasherTest, reusedDictionary) {
+  auto base = makeNullableFlatVector<std::string>(
+      {"apple", std::nullopt, "orange", "grapefruit", "banana"});
+  vector_size_t size = 100;
+  auto first = makeDictionary(size, base);
+  auto second = BaseVector::wrapInDictionary(
+      BufferPtr(nullptr),
+      makeIndices(size, [](auto row) { return (row * 7) % 5; }),
+      size,
+      base);
+  SelectivityVector rows(size);
+
+  // Hashes and value ids of the batches over the same dictionary match those
+  // of the same values in flat vectors.
+  auto hashesOf = [&](exec::VectorHasher& hasher, const VectorPtr& vector) {
+    raw_vector<uint64_t> hashes(size);
+    hasher.decode(*vector, rows);
+    hasher.hash(rows, false, hashes);
+    return std::vector<uint64_t>(hashes.begin(), hashes.end());
+  };
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0);
+  auto flatHasher = exec::VectorHasher::create(VARCHAR(), 0);
+  for (const auto& vector : {first, second, first}) {
+    auto flat = BaseVector::copy(*vector);
+    EXPECT_EQ(hashesOf(*hasher, vector), hashesOf(*flatHasher, flat));
+  }
+
+  raw_vector<uint64_t> ids(size);
+  raw_vector<uint64_t> flatIds(size);
+  hasher->decode(*first, rows);
+  ASSERT_FALSE(hasher->computeValueIds(rows, ids));
+  hasher->enableValueIds(1, 0);
+  for (const auto& vector : {first, second, first}) {
+    hasher->decode(*vector, rows);
+    ASSERT_TRUE(hasher->computeValueIds(rows, ids));
+    auto flat = BaseVector::copy(*vector);
+    hasher->decode(*flat, rows);
+    ASSERT_TRUE(hasher->computeValueIds(rows, flatIds));
+    for (auto i = 0; i < size; ++i) {
+      EXPECT_EQ(ids[i], flatIds[i]) << "at " << i;
+    }
+  }
+
+  // A new dictionary is not mapped by the ids of the previous one.
+  auto third = makeDictionary(size, makeFlatVector<StringView>({"potato"}));
+  hasher->decode(*third, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, ids));
+
+  // The hasher holds the last dictionary so that it cannot be reused in
+  // place, and releases it on input that is not over it.
+  std::weak_ptr<BaseVector> thirdBase = third->valueVector();
+  third.reset();
+  EXPECT_FALSE(thirdBase.expired());
+  hasher->decode(*BaseVector::copy(*first), rows);
+  EXPECT_TRUE(thirdBase.expired());
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
@@ -1058,6 +1115,76 @@ TEST_F(VectorHasherTest, simdRange) {
   }
 }
 
+TEST_F(VectorHasherTest, simdRangeMultipleKeys) {
+  // Tests the SIMD path of computeValueIds() for keys after the first, whose
+  // ids are multiplied and added to the ids of the previous keys.
+  constexpr int32_t kNumRows = 1001;
+  using exec::VectorHasher;
+
+  auto intValues =
+      makeFlatVector<int32_t>(kNumRows, [](auto i) { return i % 100; });
+  auto int64Values =
+      makeFlatVector<int64_t>(kNumRows, [](auto i) { return i % 7 - 3; });
+
+  auto intHasher = VectorHasher::create(INTEGER(), 0);
+  auto int64Hasher = VectorHasher::create(BIGINT(), 1);
+
+  raw_vector<uint64_t> result(kNumRows);
+  SelectivityVector rows(kNumRows);
+  intHasher->decode(*intValues, rows);
+  intHasher->computeValueIds(rows, result);
+  int64Hasher->decode(*int64Values, rows);
+  int64Hasher->computeValueIds(rows, result);
+
+  auto multiplier = intHasher->enableValueRange(1, 0);
+  int64Hasher->enableValueRange(multiplier, 0);
+
+  ASSERT_TRUE(intHasher->computeValueIds(rows, result));
+  ASSERT_TRUE(int64Hasher->computeValueIds(rows, result));
+  for (auto i = 0; i < kNumRows; ++i) {
+    EXPECT_EQ(
+        intValues->valueAt(i) + 1 + (int64Values->valueAt(i) + 3 + 1) * 101,
+        result[i])
+        << "at " << i;
+  }
+
+  // A value out of range fails the SIMD path, which must not have added
+  // anything to 'result' before the rows are processed one by one.
+  int64Values->set(kNumRows - 1, 100);
+  ASSERT_TRUE(intHasher->computeValueIds(rows, result));
+  int64Hasher->decode(*int64Values, rows);
+  ASSERT_FALSE(int64Hasher->computeValueIds(rows, result));
+  for (auto i = 0; i < kNumRows - 1; ++i) {
+    EXPECT_EQ(
+        intValues->valueAt(i) + 1 + (int64Values->valueAt(i) + 3 + 1) * 101,
+        result[i])
+        << "at " << i;
+  }
+}
+
+TEST_F(VectorHasherTest, flatNoNulls) {
+  auto hasher = exec::VectorHasher::create(INTEGER(), 0);
+  auto vector = makeFlatVector<int32_t>(100, [](auto i) { return i * 3; });
+
+  raw_vector<uint64_t> hashes(100);
+  std::fill(hashes.begin(), hashes.end(), 0);
+  hasher->decode(*vector, oddRows_);
+  hasher->hash(oddRows_, false, hashes);
+  for (int32_t i = 0; i < 100; i++) {
+    auto expected = i % 2 == 0 ? 0 : folly::hasher<int32_t>()(i * 3);
+    EXPECT_EQ(hashes[i], expected) << "at " << i;
+  }
+
+  hasher->decode(*vector, allRows_);
+  hasher->hash(allRows_, true, hashes);
+  for (int32_t i = 0; i < 100; i++) {
+    auto previous = i % 2 == 0 ? 0 : folly::hasher<int32_t>()(i * 3);
+    EXPECT_EQ(
+        hashes[i], bits::hashMix(previous, folly::hasher<int32_t>()(i * 3)))
+        << "at " << i;
+  }
+}
+
 TEST_F(VectorHasherTest, typeMismatch) {
   auto hasher = VectorHasher::create(BIGINT(), 0);
 
@@ -79,6 +79,178 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, parallelPartitions) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 97; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row % 13; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s, d)",
+      "rank() over (partition by p order by s)",
+      "first_value(d) over (partition by p order by s, d rows between 2 preceding and current row)",
+  };
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(functions)
+                  .planNode();
+
+  for (const auto& parallelism : {"1", "4"}) {
+    SCOPED_TRACE(fmt::format("parallelism: {}", parallelism));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .config(core::QueryConfig::kWindowParallelism, parallelism)
+        .assertResults(fmt::format(
+            "SELECT *, {}, {}, {} FROM tmp",
+            functions[0],
+            functions[1],
+            functions[2]));
+  }
+}
+
+TEST_F(WindowTest, partialPartitionsFromSortedInput) {
+  const vector_size_t size = 100'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+          // Partition key. One large and one small partition.
+          makeFlatVector<int16_t>(
+              size, [](auto row) { return row < 90'000 ? 0 : 1; }),
+          // Sorting key with peer groups of 3 rows.
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 3; }),
+      });
+
+  createDuckDbTable({data});
+
+  auto peakMemory = [&](const std::vector<std::string>& functions) {
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 100))
+                    .streamingWindow(functions)
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+    std::string sql = "SELECT *";
+    for (const auto& function : functions) {
+      sql += ", " + function;
+    }
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(core::QueryConfig::kPreferredOutputBatchRows, "512")
+                    .assertResults(sql + " FROM tmp");
+    return exec::toPlanStats(task->taskStats()).at(windowId).peakMemoryBytes;
+  };
+
+  // These functions are computed over partial partitions.
+  const auto streamingPeakMemory = peakMemory({
+      "row_number() over (partition by p order by s)",
+      "rank() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s)",
+      "sum(d) over (partition by p order by s rows between 5 preceding and 2 following)",
+      "first_value(d) over (partition by p order by s rows between 1 preceding and current row)",
+  });
+
+  // percent_rank() needs the number of rows of the partition.
+  const auto fullPeakMemory = peakMemory({
+      "row_number() over (partition by p order by s)",
+      "percent_rank() over (partition by p order by s)",
+  });
+
+  ASSERT_LT(streamingPeakMemory * 4, fullPeakMemory);
+}
+
+TEST_F(WindowTest, partialPartitionsFromSpill) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          // Partition key. Most rows are in a null partition.
+          makeFlatVector<int16_t>(
+              size,
+              [](auto row) { return row % 3; },
+              [](auto row) { return row % 10 != 0; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s)",
+      "dense_rank() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s rows between unbounded preceding and current row)",
+      "nth_value(d, 2) over (partition by p order by s rows between 3 preceding and 3 following)",
+  };
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(functions)
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+                  .config(core::QueryConfig::kSpillEnabled, "true")
+                  .config(core::QueryConfig::kWindowSpillEnabled, "true")
+                  .spillDirectory(spillDirectory->getPath())
+                  .assertResults(fmt::format(
+                      "SELECT *, {}, {}, {}, {} FROM tmp",
+                      functions[0],
+                      functions[1],
+                      functions[2],
+                      functions[3]));
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  ASSERT_GT(taskStats.at(windowId).spilledRows, 0);
+}
+
+TEST_F(WindowTest, peerGroups) {
+  const vector_size_t size = 5'000;
+  auto data = makeRowVector(
+      {"p", "s0", "s1", "s2"},
+      {
+          makeFlatVector<int32_t>(size, [](auto row) { return row % 2; }),
+          // Peer groups longer than the batches of rows whose peer
+          // boundaries are computed together.
+          makeFlatVector<int64_t>(
+              size,
+              [](auto row) { return row / 1'500; },
+              [](auto row) { return row % 1'500 == 7; }),
+          makeFlatVector<std::string>(
+              size,
+              [](auto row) { return std::string(row % 700 / 300, 'x'); }),
+          makeFlatVector<double>(size, [](auto row) { return row % 5 / 2; }),
+      });
+
+  createDuckDbTable({data});
+
+  for (const auto& orderBy :
+       {"s0", "s0, s1", "s1, s2 desc", "s0 nulls first, s2"}) {
+    const std::vector<std::string> functions = {
+        fmt::format("rank() over (partition by p order by {})", orderBy),
+        fmt::format("dense_rank() over (partition by p order by {})", orderBy),
+    };
+    auto plan =
+        PlanBuilder().values(split(data, 10)).window(functions).planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .assertResults(fmt::format(
+            "SELECT *, {}, {} FROM tmp", functions[0], functions[1]));
+  }
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -278,6 +278,11 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& fileProperties(FileProperties fileProperties) {
+    fileProperties_ = std::move(fileProperties);
+    return *this;
+  }
+
   std::shared_ptr<connector::hive::HiveConnectorSplit> build() const {
     static const std::unordered_map<std::string, std::string> customSplitInfo;
     static const std::shared_ptr<std::string> extraFileInfo;
@@ -295,7 +300,7 @@ class HiveConnectorSplitBuilder {
         serdeParameters,
         splitWeight_,
         infoColumns_,
-        std::nullopt);
+        fileProperties_);
   }
 
  private:
@@ -311,6 +316,7 @@ class HiveConnectorSplitBuilder {
   std::unordered_map<std::string, std::string> infoColumns_ = {};
   std::string connectorId_ = kHiveConnectorId;
   int64_t splitWeight_{0};
+  std::optional<FileProperties> fileProperties_;
 };
 
 } // namespace facebook::velox::exec::test
@@ -17,6 +17,7 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
 #include "velox/connectors/tpch/TpchConnector.h"
 #include "velox/duckdb/conversion/DuckParser.h"
 #include "velox/exec/Aggregate.h"
@@ -43,6 +44,7 @@ namespace {
 // TODO Avoid duplication.
 static const std::string kHiveConnectorId = "test-hive";
 static const std::string kTpchConnectorId = "test-tpch";
+static const std::string kTpcdsConnectorId = "test-tpcds";
 
 core::TypedExprPtr parseExpr(
     const std::string& text,
@@ -137,6 +139,32 @@ PlanBuilder& PlanBuilder::tpchTableScan(
       .endTableScan();
 }
 
+PlanBuilder& PlanBuilder::tpcdsTableScan(
+    tpcds::Table table,
+    std::vector<std::string>&& columnNames,
+    double scaleFactor) {
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignmentsMap;
+  std::vector<TypePtr> outputTypes;
+
+  assignmentsMap.reserve(columnNames.size());
+  outputTypes.reserve(columnNames.size());
+
+  for (const auto& columnName : columnNames) {
+    assignmentsMap.emplace(
+        columnName,
+        std::make_shared<connector::tpcds::TpcdsColumnHandle>(columnName));
+    outputTypes.emplace_back(resolveTpcdsColumn(table, columnName));
+  }
+  auto rowType = ROW(std::move(columnNames), std::move(outputTypes));
+  return TableScanBuilder(*this)
+      .outputType(rowType)
+      .tableHandle(std::make_shared<connector::tpcds::TpcdsTableHandle>(
+          kTpcdsConnectorId, table, scaleFactor))
+      .assignments(assignmentsMap)
+      .endTableScan();
+}
+
 core::PlanNodePtr PlanBuilder::TableScanBuilder::build(core::PlanNodeId id) {
   VELOX_CHECK_NOT_NULL(outputType_, "outputType must be specified");
   std::unordered_map<std::string, core::TypedExprPtr> typedMapping;
@@ -594,11 +622,28 @@ core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
     const core::AggregationNode* partialAggNode) {
   // Create intermediate or final aggregation using same grouping keys and same
   // aggregate function names.
-  const auto& partialAggregates = partialAggNode->aggregates();
   const auto& groupingKeys = partialAggNode->groupingKeys();
+  auto aggregates = createIntermediateOrFinalAggregates(
+      step, partialAggNode, groupingKeys.size());
 
+  return std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      step,
+      groupingKeys,
+      partialAggNode->preGroupedKeys(),
+      partialAggNode->aggregateNames(),
+      aggregates,
+      partialAggNode->ignoreNullKeys(),
+      planNode_);
+}
+
+std::vector<core::AggregationNode::Aggregate>
+PlanBuilder::createIntermediateOrFinalAggregates(
+    core::AggregationNode::Step step,
+    const core::AggregationNode* partialAggNode,
+    size_t numGroupingKeys) {
+  const auto& partialAggregates = partialAggNode->aggregates();
   auto numAggregates = partialAggregates.size();
-  auto numGroupingKeys = groupingKeys.size();
 
   std::vector<core::AggregationNode::Aggregate> aggregates;
   aggregates.reserve(numAggregates);
@@ -628,16 +673,7 @@ core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
         std::make_shared<core::CallTypedExpr>(type, std::move(inputs), name);
     aggregates.emplace_back(aggregate);
   }
-
-  return std::make_shared<core::AggregationNode>(
-      nextPlanNodeId(),
-      step,
-      groupingKeys,
-      partialAggNode->preGroupedKeys(),
-      partialAggNode->aggregateNames(),
-      aggregates,
-      partialAggNode->ignoreNullKeys(),
-      planNode_);
+  return aggregates;
 }
 
 namespace {
@@ -846,6 +882,69 @@ PlanBuilder& PlanBuilder::aggregation(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    std::string groupIdName) {
+  std::vector<std::string> groupingKeys;
+  std::vector<vector_size_t> globalGroupingSets;
+  for (auto i = 0; i < groupingSets.size(); ++i) {
+    for (const auto& key : groupingSets[i]) {
+      if (std::find(groupingKeys.begin(), groupingKeys.end(), key) ==
+          groupingKeys.end()) {
+        groupingKeys.push_back(key);
+      }
+    }
+    if (groupingSets[i].empty()) {
+      globalGroupingSets.push_back(i);
+    }
+  }
+
+  // Aggregate the input once on all the keys.
+  partialAggregation(groupingKeys, aggregates);
+  auto partialAggNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+  for (const auto& aggregate : partialAggNode->aggregates()) {
+    VELOX_USER_CHECK(
+        !aggregate.distinct && aggregate.mask == nullptr &&
+            aggregate.sortingKeys.empty(),
+        "Grouping sets aggregation doesn't support DISTINCT, masks or "
+        "ORDER BY: {}",
+        aggregate.call->toString());
+  }
+
+  // Replicate the groups for each grouping set. The intermediate results
+  // follow the keys in the output of the GroupIdNode.
+  groupId(
+      groupingKeys,
+      groupingSets,
+      partialAggNode->aggregateNames(),
+      groupIdName);
+
+  auto finalKeys = fields(groupingKeys);
+  finalKeys.push_back(field(groupIdName));
+  auto finalAggregates = createIntermediateOrFinalAggregates(
+      core::AggregationNode::Step::kFinal,
+      partialAggNode.get(),
+      groupingKeys.size());
+  std::optional<core::FieldAccessTypedExprPtr> groupIdField;
+  if (!globalGroupingSets.empty()) {
+    groupIdField = field(groupIdName);
+  }
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      core::AggregationNode::Step::kFinal,
+      std::move(finalKeys),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      partialAggNode->aggregateNames(),
+      std::move(finalAggregates),
+      globalGroupingSets,
+      groupIdField,
+      false,
+      planNode_);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::streamingAggregation(
     const std::vector<std::string>& groupingKeys,
     const std::vector<std::string>& aggregates,
@@ -1114,6 +1213,7 @@ core::PlanNodePtr createLocalPartitionNode(
     const core::PlanNodeId& planNodeId,
     const std::vector<core::TypedExprPtr>& keys,
     const std::vector<core::PlanNodePtr>& sources,
+    bool rebalanceHotPartitions,
     memory::MemoryPool* pool) {
   auto partitionFunctionFactory =
       createPartitionFunctionSpec(sources[0]->outputType(), keys, pool);
@@ -1122,7 +1222,8 @@ core::PlanNodePtr createLocalPartitionNode(
       keys.empty() ? core::LocalPartitionNode::Type::kGather
                    : core::LocalPartitionNode::Type::kRepartition,
       partitionFunctionFactory,
-      sources);
+      sources,
+      rebalanceHotPartitions);
 }
 } // namespace
 
@@ -1199,18 +1300,26 @@ PlanBuilder& PlanBuilder::partitionedOutputArbitrary(
 
 PlanBuilder& PlanBuilder::localPartition(
     const std::vector<std::string>& keys,
-    const std::vector<core::PlanNodePtr>& sources) {
+    const std::vector<core::PlanNodePtr>& sources,
+    bool rebalanceHotPartitions) {
   VELOX_CHECK_NULL(planNode_, "localPartition() must be the first call");
   planNode_ = createLocalPartitionNode(
-      nextPlanNodeId(), exprs(keys, sources[0]->outputType()), sources, pool_);
+      nextPlanNodeId(),
+      exprs(keys, sources[0]->outputType()),
+      sources,
+      rebalanceHotPartitions,
+      pool_);
   return *this;
 }
 
-PlanBuilder& PlanBuilder::localPartition(const std::vector<std::string>& keys) {
+PlanBuilder& PlanBuilder::localPartition(
+    const std::vector<std::string>& keys,
+    bool rebalanceHotPartitions) {
   planNode_ = createLocalPartitionNode(
       nextPlanNodeId(),
       exprs(keys, planNode_->outputType()),
       {planNode_},
+      rebalanceHotPartitions,
       pool_);
   return *this;
 }
@@ -31,6 +31,10 @@ namespace facebook::velox::tpch {
 enum class Table : uint8_t;
 }
 
+namespace facebook::velox::tpcds {
+enum class Table : uint8_t;
+}
+
 namespace facebook::velox::exec::test {
 
 /// A builder class with fluent API for building query plans. Plans are built
@@ -164,6 +168,16 @@ class PlanBuilder {
       std::vector<std::string>&& columnNames,
       double scaleFactor = 1);
 
+  /// Add a TableScanNode to scan a TPC-DS table.
+  ///
+  /// @param table The target TPC-DS table.
+  /// @param columnNames The columns to be returned from that table.
+  /// @param scaleFactor The TPC-DS scale factor.
+  PlanBuilder& tpcdsTableScan(
+      tpcds::Table table,
+      std::vector<std::string>&& columnNames,
+      double scaleFactor = 1);
+
   /// Helper class to build a custom TableScanNode.
   /// Uses a planBuilder instance to get the next plan id, memory pool, and
   /// parse options.
@@ -620,6 +634,23 @@ class PlanBuilder {
         false);
   }
 
+  /// Add an aggregation over 'groupingSets' that aggregates the input once.
+  /// Adds a partial aggregation on the union of the keys in 'groupingSets', a
+  /// GroupIdNode that replicates its groups for each grouping set and a final
+  /// aggregation on the keys and the group id column 'groupIdName'. Compared to
+  /// groupId() followed by singleAggregation(), this replicates the groups of
+  /// the finest grouping rather than every input row. The output has the keys
+  /// in order of first appearance in 'groupingSets', 'groupIdName' and the
+  /// aggregates. Aggregates can't use DISTINCT, masks or ORDER BY.
+  ///
+  /// For example, a rollup on k1 and k2:
+  ///
+  ///     groupingSetsAggregation({{"k1", "k2"}, {"k1"}, {}}, {"sum(a)"})
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      std::string groupIdName = "group_id");
+
   /// Add an AggregationNode assuming input is clustered on all grouping keys.
   PlanBuilder& streamingAggregation(
       const std::vector<std::string>& groupingKeys,
@@ -781,13 +812,19 @@ class PlanBuilder {
   /// @param keys Partitioning keys. May be empty, in which case all input will
   /// be places in a single partition.
   /// @param sources One or more plan nodes that produce input data.
+  /// @param rebalanceHotPartitions If true, rows of hot partitions may be sent
+  /// to any consumer. Only for consumers that do not need all rows of a key,
+  /// e.g. partial aggregation.
   PlanBuilder& localPartition(
       const std::vector<std::string>& keys,
-      const std::vector<core::PlanNodePtr>& sources);
+      const std::vector<core::PlanNodePtr>& sources,
+      bool rebalanceHotPartitions = false);
 
   /// A convenience method to add a LocalPartitionNode with a single source (the
   /// current plan node).
-  PlanBuilder& localPartition(const std::vector<std::string>& keys);
+  PlanBuilder& localPartition(
+      const std::vector<std::string>& keys,
+      bool rebalanceHotPartitions = false);
 
   /// A convenience method to add a LocalPartitionNode with a single source (the
   /// current plan node) and hive bucket property.
@@ -1043,6 +1080,15 @@ class PlanBuilder {
       core::AggregationNode::Step step,
       const core::AggregationNode* partialAggNode);
 
+  // Returns the intermediate or final aggregates matching the aggregates of
+  // 'partialAggNode'. The intermediate results must follow the
+  // 'numGroupingKeys' grouping keys in the output of the current plan node.
+  std::vector<core::AggregationNode::Aggregate>
+  createIntermediateOrFinalAggregates(
+      core::AggregationNode::Step step,
+      const core::AggregationNode* partialAggNode,
+      size_t numGroupingKeys);
+
   struct AggregatesAndNames {
     std::vector<core::AggregationNode::Aggregate> aggregates;
     std::vector<std::string> names;
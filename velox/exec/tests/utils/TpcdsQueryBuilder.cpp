@@ -0,0 +1,645 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+namespace facebook::velox::exec::test {
+
+void TpcdsQueryBuilder::initialize(const std::string& dataPath) {
+  tableMetadata_ = readTableMetadata(dataPath, kTables_, format_, pool_.get());
+}
+
+const std::vector<std::string>& TpcdsQueryBuilder::getTableNames() {
+  return kTableNames_;
+}
+
+const std::vector<int>& TpcdsQueryBuilder::getQueryIds() {
+  static const std::vector<int> kQueryIds = {3, 19, 27, 55, 98};
+  return kQueryIds;
+}
+
+TpchPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 19:
+      return getQ19Plan();
+    case 27:
+      return getQ27Plan();
+    case 55:
+      return getQ55Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+TpchPlan TpcdsQueryBuilder::getQ3Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_year", "d_moy"};
+  std::vector<std::string> itemColumns = {
+      "i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesScanNodeId;
+  core::PlanNodeId dateDimScanNodeId;
+  core::PlanNodeId itemScanNodeId;
+
+  auto dateDim = PlanBuilder(planNodeIdGenerator, pool_.get())
+                     .tableScan(
+                         kDateDim,
+                         getRowType(kDateDim, dateDimColumns),
+                         getFileColumnNames(kDateDim),
+                         {"d_moy = 11"})
+                     .capturePlanNodeId(dateDimScanNodeId)
+                     .planNode();
+
+  auto item = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kItem,
+                      getRowType(kItem, itemColumns),
+                      getFileColumnNames(kItem),
+                      {"i_manufact_id = 128"})
+                  .capturePlanNodeId(itemScanNodeId)
+                  .planNode();
+
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kStoreSales,
+              getRowType(kStoreSales, storeSalesColumns),
+              getFileColumnNames(kStoreSales))
+          .capturePlanNodeId(storeSalesScanNodeId)
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              {"ss_sold_date_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) as sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"d_year",
+               "i_brand_id as brand_id",
+               "i_brand as brand",
+               "sum_agg"})
+          .orderBy({"d_year", "sum_agg DESC", "brand_id"}, false)
+          .limit(0, 100, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesScanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[dateDimScanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[itemScanNodeId] = getTableFilePaths(kItem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ19Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk",
+      "ss_item_sk",
+      "ss_customer_sk",
+      "ss_store_sk",
+      "ss_ext_sales_price"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_year", "d_moy"};
+  std::vector<std::string> itemColumns = {
+      "i_item_sk",
+      "i_brand_id",
+      "i_brand",
+      "i_manufact_id",
+      "i_manufact",
+      "i_manager_id"};
+  std::vector<std::string> customerColumns = {
+      "c_customer_sk", "c_current_addr_sk"};
+  std::vector<std::string> customerAddressColumns = {
+      "ca_address_sk", "ca_zip"};
+  std::vector<std::string> storeColumns = {"s_store_sk", "s_zip"};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesScanNodeId;
+  core::PlanNodeId dateDimScanNodeId;
+  core::PlanNodeId itemScanNodeId;
+  core::PlanNodeId customerScanNodeId;
+  core::PlanNodeId customerAddressScanNodeId;
+  core::PlanNodeId storeScanNodeId;
+
+  auto dateDim = PlanBuilder(planNodeIdGenerator, pool_.get())
+                     .tableScan(
+                         kDateDim,
+                         getRowType(kDateDim, dateDimColumns),
+                         getFileColumnNames(kDateDim),
+                         {"d_moy = 11", "d_year = 1998"})
+                     .capturePlanNodeId(dateDimScanNodeId)
+                     .planNode();
+
+  auto item = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kItem,
+                      getRowType(kItem, itemColumns),
+                      getFileColumnNames(kItem),
+                      {"i_manager_id = 8"})
+                  .capturePlanNodeId(itemScanNodeId)
+                  .planNode();
+
+  auto store = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kStore,
+                       getRowType(kStore, storeColumns),
+                       getFileColumnNames(kStore))
+                   .capturePlanNodeId(storeScanNodeId)
+                   .planNode();
+
+  auto customerAddress =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kCustomerAddress,
+              getRowType(kCustomerAddress, customerAddressColumns),
+              getFileColumnNames(kCustomerAddress))
+          .capturePlanNodeId(customerAddressScanNodeId)
+          .planNode();
+
+  auto customerJoinAddress =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kCustomer,
+              getRowType(kCustomer, customerColumns),
+              getFileColumnNames(kCustomer))
+          .capturePlanNodeId(customerScanNodeId)
+          .hashJoin(
+              {"c_current_addr_sk"},
+              {"ca_address_sk"},
+              customerAddress,
+              "",
+              {"c_customer_sk", "ca_zip"})
+          .planNode();
+
+  // Joins the most selective dimensions first.
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kStoreSales,
+              getRowType(kStoreSales, storeSalesColumns),
+              getFileColumnNames(kStoreSales))
+          .capturePlanNodeId(storeSalesScanNodeId)
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              {"ss_sold_date_sk",
+               "ss_customer_sk",
+               "ss_store_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand",
+               "i_manufact_id",
+               "i_manufact"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"ss_customer_sk",
+               "ss_store_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand",
+               "i_manufact_id",
+               "i_manufact"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              store,
+              "",
+              {"ss_customer_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand",
+               "i_manufact_id",
+               "i_manufact",
+               "s_zip"})
+          .hashJoin(
+              {"ss_customer_sk"},
+              {"c_customer_sk"},
+              customerJoinAddress,
+              "substr(ca_zip, 1, 5) <> substr(s_zip, 1, 5)",
+              {"ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand",
+               "i_manufact_id",
+               "i_manufact"})
+          .partialAggregation(
+              {"i_brand", "i_brand_id", "i_manufact_id", "i_manufact"},
+              {"sum(ss_ext_sales_price) as ext_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"i_brand_id as brand_id",
+               "i_brand as brand",
+               "i_manufact_id",
+               "i_manufact",
+               "ext_price"})
+          .orderBy(
+              {"ext_price DESC",
+               "brand",
+               "brand_id",
+               "i_manufact_id",
+               "i_manufact"},
+              false)
+          .limit(0, 100, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesScanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[dateDimScanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[itemScanNodeId] = getTableFilePaths(kItem);
+  context.dataFiles[customerScanNodeId] = getTableFilePaths(kCustomer);
+  context.dataFiles[customerAddressScanNodeId] =
+      getTableFilePaths(kCustomerAddress);
+  context.dataFiles[storeScanNodeId] = getTableFilePaths(kStore);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ27Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk",
+      "ss_item_sk",
+      "ss_cdemo_sk",
+      "ss_store_sk",
+      "ss_quantity",
+      "ss_list_price",
+      "ss_sales_price",
+      "ss_coupon_amt"};
+  std::vector<std::string> customerDemographicsColumns = {
+      "cd_demo_sk",
+      "cd_gender",
+      "cd_marital_status",
+      "cd_education_status"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_year"};
+  std::vector<std::string> storeColumns = {"s_store_sk", "s_state"};
+  std::vector<std::string> itemColumns = {"i_item_sk", "i_item_id"};
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesScanNodeId;
+  core::PlanNodeId customerDemographicsScanNodeId;
+  core::PlanNodeId dateDimScanNodeId;
+  core::PlanNodeId storeScanNodeId;
+  core::PlanNodeId itemScanNodeId;
+
+  auto customerDemographics =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kCustomerDemographics,
+              getRowType(kCustomerDemographics, customerDemographicsColumns),
+              getFileColumnNames(kCustomerDemographics),
+              {"cd_gender = 'M'",
+               "cd_marital_status = 'S'",
+               "cd_education_status = 'College'"})
+          .capturePlanNodeId(customerDemographicsScanNodeId)
+          .planNode();
+
+  auto dateDim = PlanBuilder(planNodeIdGenerator, pool_.get())
+                     .tableScan(
+                         kDateDim,
+                         getRowType(kDateDim, dateDimColumns),
+                         getFileColumnNames(kDateDim),
+                         {"d_year = 2002"})
+                     .capturePlanNodeId(dateDimScanNodeId)
+                     .planNode();
+
+  auto store = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kStore,
+                       getRowType(kStore, storeColumns),
+                       getFileColumnNames(kStore),
+                       {"s_state = 'TN'"})
+                   .capturePlanNodeId(storeScanNodeId)
+                   .planNode();
+
+  auto item = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kItem,
+                      getRowType(kItem, itemColumns),
+                      getFileColumnNames(kItem))
+                  .capturePlanNodeId(itemScanNodeId)
+                  .planNode();
+
+  auto withMeasures = [&](std::vector<std::string> columns) {
+    columns.insert(columns.end(), measures.begin(), measures.end());
+    return columns;
+  };
+
+  // ROLLUP (i_item_id, s_state) is a GroupId with the grouping sets
+  // (i_item_id, s_state), (i_item_id) and (). grouping(s_state) is 1 in the
+  // last two.
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kStoreSales,
+              getRowType(kStoreSales, storeSalesColumns),
+              getFileColumnNames(kStoreSales))
+          .capturePlanNodeId(storeSalesScanNodeId)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              customerDemographics,
+              "",
+              withMeasures({"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              withMeasures({"ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              store,
+              "",
+              withMeasures({"ss_item_sk", "s_state"}))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              withMeasures({"i_item_id", "s_state"}))
+          .groupId(
+              {"i_item_id", "s_state"},
+              {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+              measures)
+          .partialAggregation(
+              {"i_item_id", "s_state", "group_id"},
+              {"avg(ss_quantity) as agg1",
+               "avg(ss_list_price) as agg2",
+               "avg(ss_coupon_amt) as agg3",
+               "avg(ss_sales_price) as agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"i_item_id",
+               "s_state",
+               "cast(group_id > 0 as bigint) as g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .orderBy({"i_item_id", "s_state"}, false)
+          .limit(0, 100, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesScanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[customerDemographicsScanNodeId] =
+      getTableFilePaths(kCustomerDemographics);
+  context.dataFiles[dateDimScanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[storeScanNodeId] = getTableFilePaths(kStore);
+  context.dataFiles[itemScanNodeId] = getTableFilePaths(kItem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ55Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_year", "d_moy"};
+  std::vector<std::string> itemColumns = {
+      "i_item_sk", "i_brand_id", "i_brand", "i_manager_id"};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesScanNodeId;
+  core::PlanNodeId dateDimScanNodeId;
+  core::PlanNodeId itemScanNodeId;
+
+  auto dateDim = PlanBuilder(planNodeIdGenerator, pool_.get())
+                     .tableScan(
+                         kDateDim,
+                         getRowType(kDateDim, dateDimColumns),
+                         getFileColumnNames(kDateDim),
+                         {"d_moy = 11", "d_year = 1999"})
+                     .capturePlanNodeId(dateDimScanNodeId)
+                     .planNode();
+
+  auto item = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kItem,
+                      getRowType(kItem, itemColumns),
+                      getFileColumnNames(kItem),
+                      {"i_manager_id = 28"})
+                  .capturePlanNodeId(itemScanNodeId)
+                  .planNode();
+
+  auto plan = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kStoreSales,
+                      getRowType(kStoreSales, storeSalesColumns),
+                      getFileColumnNames(kStoreSales))
+                  .capturePlanNodeId(storeSalesScanNodeId)
+                  .hashJoin(
+                      {"ss_sold_date_sk"},
+                      {"d_date_sk"},
+                      dateDim,
+                      "",
+                      {"ss_item_sk", "ss_ext_sales_price"})
+                  .hashJoin(
+                      {"ss_item_sk"},
+                      {"i_item_sk"},
+                      item,
+                      "",
+                      {"i_brand_id", "i_brand", "ss_ext_sales_price"})
+                  .partialAggregation(
+                      {"i_brand", "i_brand_id"},
+                      {"sum(ss_ext_sales_price) as ext_price"})
+                  .localPartition(std::vector<std::string>{})
+                  .finalAggregation()
+                  .project(
+                      {"i_brand_id as brand_id",
+                       "i_brand as brand",
+                       "ext_price"})
+                  .orderBy({"ext_price DESC", "brand_id"}, false)
+                  .limit(0, 100, false)
+                  .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesScanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[dateDimScanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[itemScanNodeId] = getTableFilePaths(kItem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ98Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_date"};
+  std::vector<std::string> itemColumns = {
+      "i_item_sk",
+      "i_item_id",
+      "i_item_desc",
+      "i_current_price",
+      "i_class",
+      "i_category"};
+
+  const auto dateDimSelectedRowType = getRowType(kDateDim, dateDimColumns);
+  // DWRF does not support Date type and Varchar is used.
+  const auto dateSuffix =
+      dateDimSelectedRowType->findChild("d_date")->isVarchar() ? "" : "::DATE";
+  const auto dateFilter = fmt::format(
+      "d_date between '1999-02-22'{} and '1999-03-24'{}",
+      dateSuffix,
+      dateSuffix);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesScanNodeId;
+  core::PlanNodeId dateDimScanNodeId;
+  core::PlanNodeId itemScanNodeId;
+
+  auto dateDim = PlanBuilder(planNodeIdGenerator, pool_.get())
+                     .tableScan(
+                         kDateDim,
+                         dateDimSelectedRowType,
+                         getFileColumnNames(kDateDim),
+                         {dateFilter})
+                     .capturePlanNodeId(dateDimScanNodeId)
+                     .planNode();
+
+  auto item = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kItem,
+                      getRowType(kItem, itemColumns),
+                      getFileColumnNames(kItem),
+                      {"i_category IN ('Sports', 'Books', 'Home')"})
+                  .capturePlanNodeId(itemScanNodeId)
+                  .planNode();
+
+  // The revenue ratio of an item is a window function over the aggregated
+  // revenues of the items of the same class.
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kStoreSales,
+              getRowType(kStoreSales, storeSalesColumns),
+              getFileColumnNames(kStoreSales))
+          .capturePlanNodeId(storeSalesScanNodeId)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dateDim,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              item,
+              "",
+              {"i_item_id",
+               "i_item_desc",
+               "i_category",
+               "i_class",
+               "i_current_price",
+               "ss_ext_sales_price"})
+          .partialAggregation(
+              {"i_item_id",
+               "i_item_desc",
+               "i_category",
+               "i_class",
+               "i_current_price"},
+              {"sum(ss_ext_sales_price) as itemrevenue"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .window({"sum(itemrevenue) over (partition by i_class) as total"})
+          .project(
+              {"i_item_id",
+               "i_item_desc",
+               "i_category",
+               "i_class",
+               "i_current_price",
+               "itemrevenue",
+               "itemrevenue * 100 / total as revenueratio"})
+          .orderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"},
+              false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesScanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[dateDimScanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[itemScanNodeId] = getTableFilePaths(kItem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+const std::vector<std::string> TpcdsQueryBuilder::kTableNames_ = {
+    kStoreSales,
+    kDateDim,
+    kItem,
+    kStore,
+    kCustomer,
+    kCustomerAddress,
+    kCustomerDemographics};
+
+const std::unordered_map<std::string, std::vector<std::string>>
+    TpcdsQueryBuilder::kTables_ = {
+        std::make_pair(
+            "store_sales",
+            tpcds::getTableSchema(tpcds::Table::TBL_STORE_SALES)->names()),
+        std::make_pair(
+            "date_dim",
+            tpcds::getTableSchema(tpcds::Table::TBL_DATE_DIM)->names()),
+        std::make_pair(
+            "item", tpcds::getTableSchema(tpcds::Table::TBL_ITEM)->names()),
+        std::make_pair(
+            "store", tpcds::getTableSchema(tpcds::Table::TBL_STORE)->names()),
+        std::make_pair(
+            "customer",
+            tpcds::getTableSchema(tpcds::Table::TBL_CUSTOMER)->names()),
+        std::make_pair(
+            "customer_address",
+            tpcds::getTableSchema(tpcds::Table::TBL_CUSTOMER_ADDRESS)
+                ->names()),
+        std::make_pair(
+            "customer_demographics",
+            tpcds::getTableSchema(tpcds::Table::TBL_CUSTOMER_DEMOGRAPHICS)
+                ->names())};
+
+} // namespace facebook::velox::exec::test
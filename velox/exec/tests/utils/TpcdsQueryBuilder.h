@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Builds TPC-DS queries over the store sales star schema using data files
+/// located in the specified directory. The data layout is the same as for
+/// TpchQueryBuilder, with a sub-directory per table, e.g. store_sales, item
+/// and date_dim. The columns must be in the order of the tables made by
+/// tpcds::genTpcdsData().
+///
+/// The queries cover plan shapes that TPC-H does not: star joins of the fact
+/// table with up to five dimensions, aggregation over a ROLLUP and a window
+/// function over an aggregation.
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(dwio::common::FileFormat format)
+      : format_(format) {}
+
+  /// Read each data file, initialize row types, and determine data paths for
+  /// each table.
+  /// @param dataPath path to the data files
+  void initialize(const std::string& dataPath);
+
+  /// Get the query plan for a given TPC-DS query number.
+  /// @param queryId TPC-DS query number
+  TpchPlan getQueryPlan(int queryId) const;
+
+  /// Returns the numbers of the TPC-DS queries getQueryPlan() supports.
+  static const std::vector<int>& getQueryIds();
+
+  /// Get the TPC-DS table names present.
+  static const std::vector<std::string>& getTableNames();
+
+ private:
+  TpchPlan getQ3Plan() const;
+  TpchPlan getQ19Plan() const;
+  TpchPlan getQ27Plan() const;
+  TpchPlan getQ55Plan() const;
+  TpchPlan getQ98Plan() const;
+
+  const std::vector<std::string>& getTableFilePaths(
+      const std::string& tableName) const {
+    return tableMetadata_.at(tableName).dataFiles;
+  }
+
+  std::shared_ptr<const RowType> getRowType(
+      const std::string& tableName,
+      const std::vector<std::string>& columnNames) const {
+    auto columnSelector = std::make_shared<dwio::common::ColumnSelector>(
+        tableMetadata_.at(tableName).type, columnNames);
+    return columnSelector->buildSelectedReordered();
+  }
+
+  const std::unordered_map<std::string, std::string>& getFileColumnNames(
+      const std::string& tableName) const {
+    return tableMetadata_.at(tableName).fileColumnNames;
+  }
+
+  std::unordered_map<std::string, TpchTableMetadata> tableMetadata_;
+  const dwio::common::FileFormat format_;
+  static const std::unordered_map<std::string, std::vector<std::string>>
+      kTables_;
+  static const std::vector<std::string> kTableNames_;
+
+  static constexpr const char* kStoreSales = "store_sales";
+  static constexpr const char* kDateDim = "date_dim";
+  static constexpr const char* kItem = "item";
+  static constexpr const char* kStore = "store";
+  static constexpr const char* kCustomer = "customer";
+  static constexpr const char* kCustomerAddress = "customer_address";
+  static constexpr const char* kCustomerDemographics = "customer_demographics";
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+} // namespace facebook::velox::exec::test
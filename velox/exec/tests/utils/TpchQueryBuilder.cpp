@@ -64,14 +64,17 @@ std::vector<std::string> mergeColumnNames(
       secondColumnVector.end());
   return mergedColumnVector;
 };
-} // namespace
 
-void TpchQueryBuilder::readFileSchema(
-    const std::string& tableName,
+// Initializes the schema information in 'metadata' from sample file at
+// 'filePath'.
+void readFileSchema(
     const std::string& filePath,
-    const std::vector<std::string>& columns) {
-  dwio::common::ReaderOptions readerOptions{pool_.get()};
-  readerOptions.setFileFormat(format_);
+    const std::vector<std::string>& columns,
+    dwio::common::FileFormat format,
+    memory::MemoryPool* pool,
+    TpchTableMetadata& metadata) {
+  dwio::common::ReaderOptions readerOptions{pool};
+  readerOptions.setFileFormat(format);
   auto uniqueReadFile =
       filesystems::getFileSystem(filePath, nullptr)->openFileForRead(filePath);
   std::shared_ptr<ReadFile> readFile;
@@ -96,13 +99,20 @@ void TpchQueryBuilder::readFileSchema(
   auto columnNames = columns;
   auto types = fileType->children();
   types.resize(columnNames.size());
-  tableMetadata_[tableName].type =
+  metadata.type =
       std::make_shared<RowType>(std::move(columnNames), std::move(types));
-  tableMetadata_[tableName].fileColumnNames = std::move(fileColumnNamesMap);
+  metadata.fileColumnNames = std::move(fileColumnNamesMap);
 }
+} // namespace
 
-void TpchQueryBuilder::initialize(const std::string& dataPath) {
-  for (const auto& [tableName, columns] : kTables_) {
+std::unordered_map<std::string, TpchTableMetadata> readTableMetadata(
+    const std::string& dataPath,
+    const std::unordered_map<std::string, std::vector<std::string>>& tables,
+    dwio::common::FileFormat format,
+    memory::MemoryPool* pool) {
+  std::unordered_map<std::string, TpchTableMetadata> tableMetadata;
+  for (const auto& [tableName, columns] : tables) {
+    TpchTableMetadata metadata;
     const fs::path tablePath{dataPath + "/" + tableName};
     std::error_code error;
     bool anyFound = false;
@@ -115,23 +125,32 @@ void TpchQueryBuilder::initialize(const std::string& dataPath) {
       if (dirEntry.path().filename().c_str()[0] == '.') {
         continue;
       }
-      if (tableMetadata_[tableName].dataFiles.empty()) {
+      if (metadata.dataFiles.empty()) {
         anyFound = true;
-        readFileSchema(tableName, dirEntry.path().string(), columns);
+        readFileSchema(
+            dirEntry.path().string(), columns, format, pool, metadata);
       }
-      tableMetadata_[tableName].dataFiles.push_back(dirEntry.path());
+      metadata.dataFiles.push_back(dirEntry.path());
     }
     if (!anyFound && error) {
       std::ifstream file(tablePath);
       std::string line;
       while (std::getline(file, line)) {
-        if (tableMetadata_[tableName].dataFiles.empty()) {
-          readFileSchema(tableName, line, columns);
+        if (metadata.dataFiles.empty()) {
+          readFileSchema(line, columns, format, pool, metadata);
         }
-        tableMetadata_[tableName].dataFiles.push_back(line);
+        metadata.dataFiles.push_back(line);
       }
     }
+    if (!metadata.dataFiles.empty()) {
+      tableMetadata[tableName] = std::move(metadata);
+    }
   }
+  return tableMetadata;
+}
+
+void TpchQueryBuilder::initialize(const std::string& dataPath) {
+  tableMetadata_ = readTableMetadata(dataPath, kTables_, format_, pool_.get());
 }
 
 const std::vector<std::string>& TpchQueryBuilder::getTableNames() {
@@ -146,6 +165,8 @@ TpchPlan TpchQueryBuilder::getQueryPlan(int queryId) const {
       return getQ2Plan();
     case 3:
       return getQ3Plan();
+    case 4:
+      return getQ4Plan();
     case 5:
       return getQ5Plan();
     case 6:
@@ -529,6 +550,66 @@ TpchPlan TpchQueryBuilder::getQ3Plan() const {
   return context;
 }
 
+TpchPlan TpchQueryBuilder::getQ4Plan() const {
+  std::vector<std::string> lineitemColumns = {
+      "l_orderkey", "l_commitdate", "l_receiptdate"};
+  std::vector<std::string> ordersColumns = {
+      "o_orderkey", "o_orderdate", "o_orderpriority"};
+
+  const auto lineitemSelectedRowType = getRowType(kLineitem, lineitemColumns);
+  const auto& lineitemFileColumns = getFileColumnNames(kLineitem);
+  const auto ordersSelectedRowType = getRowType(kOrders, ordersColumns);
+  const auto& ordersFileColumns = getFileColumnNames(kOrders);
+
+  const auto orderDate = "o_orderdate";
+  auto orderDateFilter = formatDateFilter(
+      orderDate, ordersSelectedRowType, "'1993-07-01'", "'1993-09-30'");
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId lineitemScanNodeId;
+  core::PlanNodeId ordersScanNodeId;
+
+  auto orders = PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(
+                        kOrders,
+                        ordersSelectedRowType,
+                        ordersFileColumns,
+                        {orderDateFilter})
+                    .capturePlanNodeId(ordersScanNodeId)
+                    .planNode();
+
+  // The EXISTS subquery is a semi join that keeps the orders with a late
+  // lineitem. The orders are the smaller side and are built.
+  auto plan = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kLineitem,
+                      lineitemSelectedRowType,
+                      lineitemFileColumns,
+                      {},
+                      "l_commitdate < l_receiptdate")
+                  .capturePlanNodeId(lineitemScanNodeId)
+                  .hashJoin(
+                      {"l_orderkey"},
+                      {"o_orderkey"},
+                      orders,
+                      "",
+                      {"o_orderpriority"},
+                      core::JoinType::kRightSemiFilter)
+                  .partialAggregation(
+                      {"o_orderpriority"}, {"count(0) as order_count"})
+                  .localPartition(std::vector<std::string>{})
+                  .finalAggregation()
+                  .orderBy({"o_orderpriority"}, false)
+                  .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[lineitemScanNodeId] = getTableFilePaths(kLineitem);
+  context.dataFiles[ordersScanNodeId] = getTableFilePaths(kOrders);
+  context.dataFileFormat = format_;
+  return context;
+}
+
 TpchPlan TpchQueryBuilder::getQ5Plan() const {
   std::vector<std::string> customerColumns = {"c_custkey", "c_nationkey"};
   std::vector<std::string> ordersColumns = {
@@ -40,6 +40,16 @@ struct TpchTableMetadata {
   std::unordered_map<std::string, std::string> fileColumnNames;
 };
 
+/// Reads the schema from the first data file of each table in 'tables' under
+/// 'dataPath' and lists the data files of the table. 'tables' maps the table
+/// names to the standard names of their columns. The layout of 'dataPath' is
+/// described at TpchQueryBuilder.
+std::unordered_map<std::string, TpchTableMetadata> readTableMetadata(
+    const std::string& dataPath,
+    const std::unordered_map<std::string, std::vector<std::string>>& tables,
+    dwio::common::FileFormat format,
+    memory::MemoryPool* pool);
+
 /// Builds TPC-H queries using TPC-H data files located in the specified
 /// directory. Each table data must be placed in hive-style partitioning. That
 /// is, the top-level directory is expected to contain a sub-directory per table
@@ -83,16 +93,10 @@ class TpchQueryBuilder {
   static const std::vector<std::string>& getTableNames();
 
  private:
-  // Initializes the schema information for 'tableName' from sample file at
-  // 'filePath'.
-  void readFileSchema(
-      const std::string& tableName,
-      const std::string& filePath,
-      const std::vector<std::string>& columns);
-
   TpchPlan getQ1Plan() const;
   TpchPlan getQ2Plan() const;
   TpchPlan getQ3Plan() const;
+  TpchPlan getQ4Plan() const;
   TpchPlan getQ5Plan() const;
   TpchPlan getQ6Plan() const;
   TpchPlan getQ7Plan() const;
@@ -42,21 +42,25 @@ void SplitStaging::registerPointerInternal(
 }
 
 // Starts the transfers registered with add(). 'stream' is set to a stream
-// where operations depending on the transfer may be queued.
+// where operations depending on the transfer may be queued. The data is
+// gathered into pinned host memory and copied with one asynchronous DMA, so
+// that the copy overlaps with kernels on other streams instead of migrating
+// pages of unified memory on first touch.
 void SplitStaging::transfer(WaveStream& waveStream, Stream& stream) {
   if (fill_ == 0) {
     return;
   }
   deviceBuffer_ = waveStream.arena().allocate<char>(fill_);
-  auto universal = deviceBuffer_->as<char>();
+  hostBuffer_ = waveStream.hostArena().allocate<char>(fill_);
+  auto host = hostBuffer_->as<char>();
   for (auto i = 0; i < offsets_.size(); ++i) {
-    memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+    memcpy(host + offsets_[i], staging_[i].hostData, staging_[i].size);
   }
-  stream.prefetch(
-      getDevice(), deviceBuffer_->as<char>(), deviceBuffer_->size());
+  auto device = deviceBuffer_->as<char>();
+  stream.hostToDeviceAsync(device, host, fill_);
   for (auto& pair : patch_) {
     *reinterpret_cast<int64_t*>(pair.second) +=
-        reinterpret_cast<int64_t>(universal) + offsets_[pair.first];
+        reinterpret_cast<int64_t>(device) + offsets_[pair.first];
   }
 }
 
@@ -79,8 +79,8 @@ class SplitStaging {
  private:
   void registerPointerInternal(BufferId id, void** ptr, bool clear);
 
-  // Pinned host memory for transfer to device. May be nullptr if using unified
-  // memory.
+  // Pinned host memory the staged data is gathered into for the asynchronous
+  // copy to device. Must stay alive until the copy is done.
   WaveBufferPtr hostBuffer_;
 
   // Device accessible memory (device or unified) with the data to read.
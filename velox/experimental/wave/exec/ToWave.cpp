@@ -26,6 +26,19 @@
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
 
+DEFINE_double(
+    velox_wave_min_work_per_byte,
+    0,
+    "Minimum estimated expression work per byte copied between host and "
+    "device for placing a pipeline on the device. 0 places all supported "
+    "pipelines on the device");
+
+DEFINE_int64(
+    velox_wave_min_rows,
+    0,
+    "Pipelines over fewer input rows than this, when known at plan time, stay "
+    "on the CPU");
+
 namespace facebook::velox::wave {
 
 using exec::Expr;
@@ -457,6 +470,80 @@ bool isProjectedThrough(
   return false;
 }
 
+namespace {
+// Bytes assumed per row for a variable width value. Strings are copied with
+// their headers and moved less efficiently on the device.
+constexpr int32_t kVariableWidthBytes = 32;
+
+int64_t rowBytes(const RowType& type) {
+  int64_t bytes = 0;
+  for (auto& child : type.children()) {
+    bytes += child->isFixedWidth() ? child->cppSizeInBytes()
+                                   : kVariableWidthBytes;
+  }
+  return bytes;
+}
+
+int32_t countExprNodes(const Expr& expr) {
+  int32_t count = 1;
+  for (auto& input : expr.inputs()) {
+    count += countExprNodes(*input);
+  }
+  return count;
+}
+
+bool isWaveOperator(const std::string& name) {
+  return name == "Values" || name == "FilterProject" ||
+      name == "Aggregation" || name == "TableScan";
+}
+
+// Estimates the per row cost of running 'operators' up to 'end' on the
+// device. The source output is copied to the device and the result of the
+// last operator is copied back unless it is an aggregation.
+PipelineCost estimateCost(
+    const std::vector<exec::Operator*>& operators,
+    int32_t end,
+    const std::vector<core::PlanNodePtr>& planNodes) {
+  PipelineCost cost;
+  int32_t nodeIndex = 0;
+  for (auto i = 0; i < end; ++i, ++nodeIndex) {
+    auto* op = operators[i];
+    auto& name = op->operatorType();
+    if (i == 0) {
+      cost.transferBytes += rowBytes(*op->outputType());
+    }
+    if (name == "Values") {
+      auto* values =
+          dynamic_cast<const core::ValuesNode*>(planNodes[nodeIndex].get());
+      VELOX_CHECK_NOT_NULL(values);
+      cost.numRows = 0;
+      for (auto& vector : values->values()) {
+        cost.numRows += vector->size();
+      }
+      cost.numRows *= values->repeatTimes();
+    } else if (name == "FilterProject") {
+      auto data = reinterpret_cast<exec::FilterProject*>(op)
+                      ->exprsAndProjection();
+      for (auto& expr : data.exprs->exprs()) {
+        cost.work += countExprNodes(*expr);
+      }
+      if (data.hasFilter) {
+        ++nodeIndex;
+      }
+    } else if (name == "Aggregation") {
+      auto* node = dynamic_cast<const core::AggregationNode*>(
+          planNodes[nodeIndex].get());
+      VELOX_CHECK_NOT_NULL(node);
+      cost.work += node->aggregates().size() + node->groupingKeys().size();
+    }
+  }
+  if (operators[end - 1]->operatorType() != "Aggregation") {
+    cost.transferBytes += rowBytes(*operators[end - 1]->outputType());
+  }
+  return cost;
+}
+} // namespace
+
 bool CompileState::compile() {
   auto operators = driver_.operators();
   auto& nodes = driverFactory_.planNodes;
@@ -468,6 +555,9 @@ bool CompileState::compile() {
   // Make sure operator states are initialized.  We will need to inspect some of
   // them during the transformation.
   driver_.initializeOperators();
+  if (!placeOnDevice(operators)) {
+    return false;
+  }
   RowTypePtr inputType;
   for (; operatorIndex < operators.size(); ++operatorIndex) {
     int32_t previousNumOperators = operators_.size();
@@ -543,9 +633,38 @@ bool CompileState::compile() {
   auto replaced = driverFactory_.replaceOperators(
       driver_, first, operatorIndex, std::move(added));
   waveOp->setReplaced(std::move(replaced));
+  waveOp->setPipelineCost(cost_);
   return true;
 }
 
+bool CompileState::placeOnDevice(
+    const std::vector<exec::Operator*>& operators) {
+  int32_t end = 0;
+  while (end < operators.size() &&
+         isWaveOperator(operators[end]->operatorType())) {
+    ++end;
+  }
+  if (end == 0) {
+    return false;
+  }
+  cost_ = estimateCost(operators, end, driverFactory_.planNodes);
+  const bool tooFewRows =
+      cost_.numRows >= 0 && cost_.numRows < FLAGS_velox_wave_min_rows;
+  if (!tooFewRows &&
+      cost_.workPerByte() >= FLAGS_velox_wave_min_work_per_byte) {
+    return true;
+  }
+  // The pipeline stays on the CPU. Records the estimate on the first
+  // Operator so that the decision shows up in the PlanNodeStats.
+  auto* first = operators[0];
+  first->addRuntimeStat("wave.cpuPlacement", RuntimeCounter(1));
+  first->addRuntimeStat(
+      "wave.estimatedTransferBytesPerRow",
+      RuntimeCounter(cost_.transferBytes, RuntimeCounter::Unit::kBytes));
+  first->addRuntimeStat("wave.estimatedWorkPerRow", RuntimeCounter(cost_.work));
+  return false;
+}
+
 bool waveDriverAdapter(
     const exec::DriverFactory& factory,
     exec::Driver& driver) {
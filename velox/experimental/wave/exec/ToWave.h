@@ -91,6 +91,11 @@ class CompileState {
 
   bool reserveMemory();
 
+  // Estimates the cost of running the leading Wave compatible 'operators' on
+  // the device. Returns false and records the estimate in the runtime stats of
+  // the first Operator if the pipeline should stay on the CPU.
+  bool placeOnDevice(const std::vector<exec::Operator*>& operators);
+
   // Adds 'instruction' to the suitable program and records the result
   // of the instruction to the right program. The set of programs
   // 'instruction's operands depend is in 'programs'. If 'instruction'
@@ -139,6 +144,9 @@ class CompileState {
   // The Wave operators generated so far.
   std::vector<std::unique_ptr<WaveOperator>> operators_;
 
+  // Estimate on which the Driver was placed on the device.
+  PipelineCost cost_;
+
   // The program being generated.
   std::shared_ptr<Program> currentProgram_;
 
@@ -101,6 +101,25 @@ struct WaveStats {
   void add(const WaveStats& other);
 };
 
+/// Per row cost estimate of running a sequence of Operators on the device.
+/// The device pays off when there is enough expression work per byte that is
+/// copied between host and device.
+struct PipelineCost {
+  /// Bytes per row copied to the device for the source plus bytes per row
+  /// copied back to the host for the result.
+  int64_t transferBytes{0};
+
+  /// Number of expression nodes and aggregates evaluated per row.
+  int64_t work{0};
+
+  /// Number of input rows if known at plan time, e.g. for Values, else -1.
+  int64_t numRows{-1};
+
+  double workPerByte() const {
+    return static_cast<double>(work) / std::max<int64_t>(1, transferBytes);
+  }
+};
+
 // A value a kernel can depend on. Either a dedupped exec::Expr or a dedupped
 // subfield. Subfield between operators, Expr inside  an Expr.
 struct Value {
@@ -466,6 +485,11 @@ class WaveStream {
     return arena_;
   }
 
+  /// Pinned host memory, e.g. for staging host to device copies.
+  GpuArena& hostArena() {
+    return hostArena_;
+  }
+
   /// Sets nullability of a source column. This is runtime, since may depend on
   /// the actual presence of nulls in the source, e.g. file. Nullability
   /// defaults to nullable.
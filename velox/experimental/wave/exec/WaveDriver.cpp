@@ -247,6 +247,12 @@ void WaveDriver::updateStats() {
       "wave.waitTime",
       RuntimeCounter(
           waveStats_.waitTime.micros * 1000, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.estimatedTransferBytesPerRow",
+      RuntimeCounter(
+          pipelineCost_.transferBytes, RuntimeCounter::Unit::kBytes));
+  lockedStats->addRuntimeStat(
+      "wave.estimatedWorkPerRow", RuntimeCounter(pipelineCost_.work));
 }
 
 } // namespace facebook::velox::wave
@@ -53,6 +53,12 @@ class WaveDriver : public exec::SourceOperator {
     cpuOperators_ = std::move(original);
   }
 
+  /// Sets the estimate on which the pipeline was placed on the device. It is
+  /// reported in the runtime stats.
+  void setPipelineCost(const PipelineCost& cost) {
+    pipelineCost_ = cost;
+  }
+
   GpuArena& arena() const {
     return *arena_;
   }
@@ -145,6 +151,7 @@ class WaveDriver : public exec::SourceOperator {
   // Operands handed over by compilation.
   std::vector<std::unique_ptr<AbstractOperand>> operands_;
   WaveStats waveStats_;
+  PipelineCost pipelineCost_;
 };
 
 } // namespace facebook::velox::wave
@@ -21,6 +21,9 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/experimental/wave/exec/ToWave.h"
 
+DECLARE_double(velox_wave_min_work_per_byte);
+DECLARE_int64(velox_wave_min_rows);
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
@@ -133,3 +136,37 @@ TEST_F(FilterProjectTest, filterProject) {
       std::vector<std::string>{"c0", "c1", "c1 + c0 as s", "c2", "c3"},
       vectors);
 }
+
+TEST_F(FilterProjectTest, cpuPlacement) {
+  gflags::FlagSaver flagSaver;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    makeNotNull(vector, 1000000000);
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  // One addition over 4 input and 3 output columns is too little work per
+  // transferred byte, so the pipeline stays on the CPU.
+  FLAGS_velox_wave_min_work_per_byte = 1;
+  auto task = assertQuery(
+      PlanBuilder().values(vectors).project({"c0", "c1", "c0 + c1"}).planNode(),
+      "SELECT c0, c1, c0 + c1 FROM tmp");
+  auto& stats =
+      task->taskStats().pipelineStats[0].operatorStats[0].runtimeStats;
+  ASSERT_EQ(stats.count("wave.cpuPlacement"), 1);
+  EXPECT_GT(stats.at("wave.estimatedTransferBytesPerRow").sum, 0);
+
+  // The same pipeline is placed on the device if it is large enough.
+  FLAGS_velox_wave_min_work_per_byte = 0;
+  FLAGS_velox_wave_min_rows = 100;
+  task = assertQuery(
+      PlanBuilder().values(vectors).project({"c0", "c1", "c0 + c1"}).planNode(),
+      "SELECT c0, c1, c0 + c1 FROM tmp");
+  EXPECT_EQ(
+      task->taskStats().pipelineStats[0].operatorStats[0].runtimeStats.count(
+          "wave.cpuPlacement"),
+      0);
+}
@@ -668,6 +668,42 @@ VectorPtr CastExpr::applyDecimalToVarcharCast(
   return result;
 }
 
+template <typename FromNativeType>
+void CastExpr::applyIntegerToVarcharCast(
+    const SelectivityVector& rows,
+    exec::EvalCtx& context,
+    const BaseVector& input,
+    VectorPtr& result) {
+  result->clearNulls(rows);
+  auto* flatResult = result->asFlatVector<StringView>();
+  const auto* simpleInput = input.as<SimpleVector<FromNativeType>>();
+
+  // Values of up to 12 characters are inlined in their StringView, which
+  // covers all but BIGINT.
+  if constexpr (sizeof(FromNativeType) <= sizeof(int32_t)) {
+    char inlined[util::kMaxDecimalDigitsSize];
+    applyToSelectedNoThrowLocal(context, rows, result, [&](vector_size_t row) {
+      const auto size =
+          util::formatDecimalDigits(simpleInput->valueAt(row), inlined);
+      flatResult->setNoCopy(row, StringView(inlined, size));
+    });
+    return;
+  }
+
+  Buffer* buffer = flatResult->getBufferWithSpace(
+      rows.countSelected() * util::kMaxDecimalDigitsSize);
+  char* rawBuffer = buffer->asMutable<char>() + buffer->size();
+  applyToSelectedNoThrowLocal(context, rows, result, [&](vector_size_t row) {
+    const auto size =
+        util::formatDecimalDigits(simpleInput->valueAt(row), rawBuffer);
+    flatResult->setNoCopy(row, StringView(rawBuffer, size));
+    if (!StringView::isInline(size)) {
+      rawBuffer += size;
+    }
+  });
+  buffer->setSize(rawBuffer - buffer->asMutable<char>());
+}
+
 template <typename FromNativeType>
 VectorPtr CastExpr::applyDecimalToPrimitiveCast(
     const SelectivityVector& rows,
@@ -712,6 +748,15 @@ void CastExpr::applyCastPrimitives(
     VectorPtr& result) {
   using To = typename TypeTraits<ToKind>::NativeType;
   using From = typename TypeTraits<FromKind>::NativeType;
+  if constexpr (
+      ToKind == TypeKind::VARCHAR &&
+      (FromKind == TypeKind::TINYINT || FromKind == TypeKind::SMALLINT ||
+       FromKind == TypeKind::INTEGER || FromKind == TypeKind::BIGINT)) {
+    // Formats into the string buffer of 'result' without a temporary
+    // std::string per row. The text is the same for all policies.
+    applyIntegerToVarcharCast<From>(rows, context, input, result);
+    return;
+  }
   auto* resultFlatVector = result->as<FlatVector<To>>();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
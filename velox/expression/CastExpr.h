@@ -271,6 +271,13 @@ class CastExpr : public SpecialForm {
       const BaseVector& input,
       VectorPtr& result);
 
+  template <typename FromNativeType>
+  void applyIntegerToVarcharCast(
+      const SelectivityVector& rows,
+      exec::EvalCtx& context,
+      const BaseVector& input,
+      VectorPtr& result);
+
   template <typename FromNativeType>
   VectorPtr applyDecimalToVarcharCast(
       const SelectivityVector& rows,
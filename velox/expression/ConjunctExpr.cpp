@@ -131,16 +131,20 @@ void ConjunctExpr::evalSpecialForm(
       context.swapErrors(errors);
     }
 
-    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
-    if (evaluatesArgumentsOnNonIncreasingSelection()) {
-      // Exclude loading rows that we know for sure will have a false result.
-      for (auto* field : inputs_[inputOrder_[i]]->distinctFields()) {
-        if (multiplyReferencedFields_.count(field) > 0) {
-          context.ensureFieldLoaded(field->index(context), *activeRows);
+    {
+      // Times the evaluation of the input only, so that the bookkeeping of
+      // 'this' does not make the cheap inputs look more expensive.
+      SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
+      if (evaluatesArgumentsOnNonIncreasingSelection()) {
+        // Exclude loading rows that we know for sure will have a false result.
+        for (auto* field : inputs_[inputOrder_[i]]->distinctFields()) {
+          if (multiplyReferencedFields_.count(field) > 0) {
+            context.ensureFieldLoaded(field->index(context), *activeRows);
+          }
         }
       }
+      inputs_[inputOrder_[i]]->eval(*activeRows, context, inputResult);
     }
-    inputs_[inputOrder_[i]]->eval(*activeRows, context, inputResult);
     if (context.errors()) {
       handleErrors = true;
     }
@@ -179,21 +183,33 @@ void ConjunctExpr::evalSpecialForm(
 }
 
 void ConjunctExpr::maybeReorderInputs() {
+  // The inputs are ranked by the time they take to decide a row, i.e. to drop
+  // it from the active rows. For AND these are the rows that are false and for
+  // OR the rows that are true, so that the same ranking applies to both.
+  if (inputs_.size() < 2) {
+    return;
+  }
+  if (selectivity_[inputOrder_[0]].numIn() > kDecayRows) {
+    // Ages the statistics so that the order follows changes in the data.
+    for (auto& selectivity : selectivity_) {
+      selectivity.decay();
+    }
+  }
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
+    if (selectivity_[inputOrder_[i - 1]].costPerDroppedRow() >
+        selectivity_[inputOrder_[i]].costPerDroppedRow()) {
       reorder = true;
       break;
     }
   }
   if (reorder) {
-    std::sort(
+    std::stable_sort(
         inputOrder_.begin(),
         inputOrder_.end(),
         [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
+          return selectivity_[left].costPerDroppedRow() <
+              selectivity_[right].costPerDroppedRow();
         });
   }
 }
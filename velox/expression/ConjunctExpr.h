@@ -74,6 +74,8 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Sorts 'inputOrder_' by the cost per dropped row of the inputs, cheapest
+  // first. Called after each batch if adaptive filter reordering is enabled.
   void maybeReorderInputs();
 
   void updateResult(
@@ -86,6 +88,10 @@ class ConjunctExpr : public SpecialForm {
     return isAnd_;
   }
 
+  // Number of rows seen by the first input after which the statistics of all
+  // inputs are halved.
+  static constexpr uint64_t kDecayRows = 1 << 20;
+
   // true if conjunction (and), false if disjunction (or).
   const bool isAnd_;
 
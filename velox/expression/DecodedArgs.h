@@ -30,26 +30,36 @@ namespace facebook::velox::exec {
 ///        std::pow(base->valueAt<double>(row), exp->valueAt<double>(row));
 ///    });
 ///
+/// Nested dictionaries are decoded once per EvalCtx and shared with the other
+/// functions that decode the same argument for the same rows. See
+/// EvalCtx::getCachedDecoded().
 class DecodedArgs {
  public:
   DecodedArgs(
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       exec::EvalCtx& context) {
+    decoded_.reserve(args.size());
     for (auto& arg : args) {
-      holders_.emplace_back(context, *arg, rows);
+      if (auto* cached = context.getCachedDecoded(arg, rows)) {
+        decoded_.push_back(cached);
+      } else {
+        holders_.emplace_back(context, *arg, rows);
+        decoded_.push_back(holders_.back().get());
+      }
     }
   }
 
   DecodedVector* at(int i) const {
-    return const_cast<exec::LocalDecodedVector*>(&holders_[i])->get();
+    return decoded_[i];
   }
 
   size_t size() const {
-    return holders_.size();
+    return decoded_.size();
   }
 
  private:
   std::vector<exec::LocalDecodedVector> holders_;
+  std::vector<DecodedVector*> decoded_;
 };
 } // namespace facebook::velox::exec
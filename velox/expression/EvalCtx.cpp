@@ -66,6 +66,49 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
   VELOX_CHECK_NOT_NULL(execCtx);
 }
 
+EvalCtx::~EvalCtx() {
+  for (auto& entry : decodeCache_) {
+    execCtx_->releaseSelectivityVector(std::move(entry.rows));
+    execCtx_->releaseDecodedVector(std::move(entry.decoded));
+  }
+}
+
+DecodedVector* EvalCtx::getCachedDecoded(
+    const VectorPtr& vector,
+    const SelectivityVector& rows) {
+  // A vector referenced only by the caller may be reused for a result once
+  // the caller is done with it, so that a later decoding of the same
+  // pointer would see different values.
+  if (!cacheEnabled_ ||
+      vector->encoding() != VectorEncoding::Simple::DICTIONARY ||
+      vector->valueVector()->encoding() !=
+          VectorEncoding::Simple::DICTIONARY ||
+      vector.use_count() <= 1) {
+    return nullptr;
+  }
+  DecodeCacheEntry* freeEntry = nullptr;
+  for (auto& entry : decodeCache_) {
+    auto cached = entry.vector.lock();
+    if (cached == nullptr) {
+      freeEntry = &entry;
+    } else if (cached == vector && *entry.rows == rows) {
+      return entry.decoded.get();
+    }
+  }
+  if (freeEntry == nullptr) {
+    if (decodeCache_.size() >= kMaxDecodeCacheEntries) {
+      return nullptr;
+    }
+    freeEntry = &decodeCache_.emplace_back();
+    freeEntry->rows = execCtx_->getSelectivityVector();
+    freeEntry->decoded = execCtx_->getDecodedVector();
+  }
+  freeEntry->vector = vector;
+  *freeEntry->rows = rows;
+  freeEntry->decoded->decode(*vector, rows);
+  return freeEntry->decoded.get();
+}
+
 void EvalCtx::saveAndReset(ContextSaver& saver, const SelectivityVector& rows) {
   if (saver.context) {
     return;
@@ -170,7 +213,9 @@ auto throwError(const std::exception_ptr& exceptionPtr) {
   std::rethrow_exception(toVeloxException(exceptionPtr));
 }
 
-std::exception_ptr toVeloxUserError(const std::string& message) {
+std::exception_ptr toVeloxUserError(
+    const std::string& message,
+    std::string_view errorCode = error_code::kInvalidArgument) {
   return std::make_exception_ptr(VeloxUserError(
       __FILE__,
       __LINE__,
@@ -178,7 +223,7 @@ std::exception_ptr toVeloxUserError(const std::string& message) {
       "",
       message,
       error_source::kErrorSourceUser,
-      error_code::kInvalidArgument,
+      errorCode,
       false /*retriable*/));
 }
 
@@ -196,6 +241,18 @@ void EvalCtx::setStatus(vector_size_t index, const Status& status) {
     } else {
       addError(index, errors_);
     }
+  } else if (status.isArithmeticError()) {
+    if (throwOnError_) {
+      VELOX_ARITHMETIC_ERROR(status.message());
+    }
+    if (captureErrorDetails_) {
+      addError(
+          index,
+          toVeloxUserError(status.message(), error_code::kArithmeticError),
+          errors_);
+    } else {
+      addError(index, errors_);
+    }
   } else {
     VELOX_FAIL(status.message());
   }
@@ -224,6 +224,8 @@ class EvalCtx {
   /// For testing only.
   explicit EvalCtx(core::ExecCtx* execCtx);
 
+  ~EvalCtx();
+
   const RowVector* row() const {
     return row_;
   }
@@ -518,6 +520,16 @@ class EvalCtx {
     return maxSharedSubexprResultsCached_;
   }
 
+  /// Returns 'vector' decoded for 'rows', shared between the callers that
+  /// decode the same vector for the same rows while 'this' lives, e.g.
+  /// several functions over one input column. Only nested dictionaries are
+  /// cached, where decoding combines the indices of all levels. Returns
+  /// nullptr if the decoding is not cached and the caller must decode by
+  /// itself. The result must not be decoded again.
+  DecodedVector* getCachedDecoded(
+      const VectorPtr& vector,
+      const SelectivityVector& rows);
+
  private:
   void ensureErrorsVectorSize(EvalErrorsPtr& errors, vector_size_t size) const;
 
@@ -534,6 +546,17 @@ class EvalCtx {
       EvalErrorsPtr& to,
       vector_size_t toIndex) const;
 
+  // Decoding of a vector for a set of rows in getCachedDecoded().
+  struct DecodeCacheEntry {
+    // Does not keep the vector alive. An expired entry is not matched.
+    std::weak_ptr<BaseVector> vector;
+    std::unique_ptr<SelectivityVector> rows;
+    std::unique_ptr<DecodedVector> decoded;
+  };
+
+  // Max number of entries in 'decodeCache_'.
+  static constexpr int32_t kMaxDecodeCacheEntries = 8;
+
   core::ExecCtx* const execCtx_;
   ExprSet* const exprSet_;
   const RowVector* row_;
@@ -568,6 +591,8 @@ class EvalCtx {
   // If 'captureErrorDetails()' is false, stores flags indicating which rows had
   // errors without storing actual exceptions.
   EvalErrorsPtr errors_;
+
+  std::vector<DecodeCacheEntry> decodeCache_;
 };
 
 /// Utility wrapper struct that is used to temporarily reset the value of the
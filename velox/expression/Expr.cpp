@@ -20,6 +20,7 @@
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/testutil/TestValue.h"
@@ -28,6 +29,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprCompiler.h"
+#include "velox/expression/ExprResultCache.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/expression/PeeledEncoding.h"
 #include "velox/expression/ScopedVarSetter.h"
@@ -1185,6 +1187,12 @@ void Expr::evalWithMemo(
   VectorPtr base;
   distinctFields_[0]->evalSpecialForm(rows, context, base);
 
+  if (auto* cache = context.execCtx()->exprResultCache()) {
+    evalWithSharedMemo(*cache, base, rows, context, result);
+    context.releaseVector(base);
+    return;
+  }
+
   if (base.get() != baseOfDictionaryRawPtr_ ||
       baseOfDictionaryWeakPtr_.expired()) {
     baseOfDictionaryRepeats_ = 0;
@@ -1218,6 +1226,8 @@ void Expr::evalWithMemo(
     if (cached->hasSelections()) {
       context.ensureWritable(rows, type(), result);
       result->copy(dictionaryCache_.get(), *cached, nullptr);
+      addThreadLocalRuntimeStat(
+          kMemoHitRows, RuntimeCounter(cached->countSelected()));
     }
   }
   LocalSelectivityVector uncachedHolder(context, rows);
@@ -1264,6 +1274,39 @@ void Expr::evalWithMemo(
   context.releaseVector(base);
 }
 
+void Expr::evalWithSharedMemo(
+    ExprResultCache& cache,
+    const VectorPtr& base,
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (sharedMemoKey_.empty()) {
+    sharedMemoKey_ = fmt::format("{}:{}", toString(), type()->toString());
+  }
+
+  LocalSelectivityVector missingHolder(context, rows);
+  auto missing = missingHolder.get();
+  VELOX_DCHECK(missing != nullptr);
+  cache.get(
+      sharedMemoKey_, base, rows, type(), context.pool(), result, *missing);
+  const auto numMissing = missing->countSelected();
+  const auto numRows = rows.countSelected();
+  if (numMissing < numRows) {
+    addThreadLocalRuntimeStat(
+        kMemoHitRows, RuntimeCounter(numRows - numMissing));
+  }
+  if (numMissing == 0) {
+    return;
+  }
+
+  // Keeps the values found in the cache, like in evalWithMemo().
+  ScopedFinalSelectionSetter scopedFinalSelectionSetter(
+      context, &rows, numMissing < numRows);
+  evalWithNulls(*missing, context, result);
+  context.deselectErrors(*missing);
+  cache.put(sharedMemoKey_, base, *missing, *result);
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -44,6 +44,7 @@ DECLARE_string(velox_save_input_on_expression_system_failure_path);
 
 namespace facebook::velox::exec {
 
+class ExprResultCache;
 class ExprSet;
 class FieldReference;
 class VectorFunction;
@@ -147,6 +148,12 @@ class MutableRemainingRows {
 // An executable expression.
 class Expr {
  public:
+  /// Name of the runtime stat with the number of rows whose values were taken
+  /// from the results memoized for the base of a dictionary encoded input
+  /// instead of being computed again. Reported to the operator running the
+  /// expression.
+  static inline const std::string kMemoHitRows{"exprMemoHitRows"};
+
   Expr(
       TypePtr type,
       std::vector<std::shared_ptr<Expr>>&& inputs,
@@ -428,6 +435,15 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Memoizes the results for the rows of 'base' in the ExprResultCache of the
+  // Task instead of in 'this', so that they are shared with the other drivers.
+  void evalWithSharedMemo(
+      ExprResultCache& cache,
+      const VectorPtr& base,
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -638,6 +654,9 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // Identifies 'this' in the ExprResultCache. Set on first use.
+  std::string sharedMemoKey_;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -85,6 +86,9 @@ struct Scope {
 
   std::vector<TypedExprPtr> rewrittenExpressions;
 
+  // Simple function Exprs that can be part of a FusedExpr.
+  std::unordered_set<const Expr*> fusableExprs;
+
   Scope(std::vector<std::string>&& _locals, Scope* _parent, ExprSet* _exprSet)
       : locals(_locals), parent(_parent), exprSet(_exprSet) {}
 
@@ -95,6 +99,22 @@ struct Scope {
   }
 };
 
+// Returns true if a call of a simple function with 'metadata' can be part of a
+// FusedExpr.
+bool isFusable(
+    const VectorFunctionMetadata& metadata,
+    const TypePtr& resultType,
+    const std::vector<TypePtr>& inputTypes) {
+  if (!metadata.deterministic || !metadata.defaultNullBehavior) {
+    return false;
+  }
+  auto isFixedWidthPrimitive = [](const TypePtr& type) {
+    return type->isPrimitiveType() && type->isFixedWidth();
+  };
+  return isFixedWidthPrimitive(resultType) &&
+      std::all_of(inputTypes.begin(), inputTypes.end(), isFixedWidthPrimitive);
+}
+
 // Utility method to check eligibility for flattening.
 bool allInputTypesEquivalent(const TypedExprPtr& expr) {
   const auto& inputs = expr->inputs();
@@ -441,6 +461,18 @@ ExprPtr compileRewrittenExpression(
           simpleFunctionEntry->metadata(),
           call->name(),
           trackCpuUsage);
+      if (config.exprFuseSimpleFunctions() &&
+          isFusable(simpleFunctionEntry->metadata(), resultType, inputTypes)) {
+        scope->fusableExprs.insert(result.get());
+        if (auto fused = FusedExpr::tryFuse(
+                result,
+                [&](const Expr& input) {
+                  return scope->fusableExprs.count(&input) > 0;
+                },
+                trackCpuUsage)) {
+          result = std::move(fused);
+        }
+      }
     } else {
       const auto& functionName = call->name();
       auto vectorFunctionSignatures = getVectorFunctionSignatures(functionName);
@@ -574,6 +606,202 @@ std::unordered_set<std::string> collectFlatteningCandidates(
     return flatteningCandidates;
   });
 }
+
+/// Replaces the calls of batchable functions that share their first input with
+/// field accesses on a single batched call, e.g. json_extract_scalar(c, '$.a')
+/// and json_extract_scalar(c, '$.b') with dereferences of
+/// $internal$json_extract_scalar_batch(c, ARRAY['$.a', '$.b']). The batched
+/// call is a common subexpression that is evaluated once per batch. Calls in
+/// lambda bodies are not batched.
+class FunctionCallBatcher {
+ public:
+  std::vector<TypedExprPtr> batch(const std::vector<TypedExprPtr>& exprs) {
+    for (const auto& expr : exprs) {
+      collect(expr);
+    }
+    if (std::none_of(batches_.begin(), batches_.end(), [](const auto& batch) {
+          return batch.constants.size() > 1;
+        })) {
+      return exprs;
+    }
+    std::vector<TypedExprPtr> rewritten;
+    rewritten.reserve(exprs.size());
+    for (const auto& expr : exprs) {
+      rewritten.push_back(rewrite(expr));
+    }
+    return rewritten;
+  }
+
+ private:
+  // Calls of one function on the same input.
+  struct CallBatch {
+    std::string name;
+    const BatchableFunction* function;
+    // Distinct constant arguments in the order of first appearance.
+    std::vector<const core::ConstantTypedExpr*> constants;
+    // Result types of the calls. 1:1 with 'constants'.
+    std::vector<TypePtr> types;
+    // The batched call over the rewritten input. Created on first use.
+    TypedExprPtr batchedCall;
+  };
+
+  // Returns the batchable function called by 'expr' if the call can be
+  // batched.
+  static const BatchableFunction* batchableFunction(const ITypedExpr& expr) {
+    auto* call = dynamic_cast<const core::CallTypedExpr*>(&expr);
+    if (call == nullptr || call->inputs().size() != 2) {
+      return nullptr;
+    }
+    auto* constant =
+        dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+    if (constant == nullptr || constant->hasValueVector() ||
+        constant->value().isNull()) {
+      return nullptr;
+    }
+    auto& functions = batchableFunctions();
+    auto it = functions.find(sanitizeName(call->name()));
+    if (it == functions.end() ||
+        (it->second.canBatch &&
+         !it->second.canBatch(call->inputs()[0]->type(), *constant))) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  CallBatch* findBatch(const core::CallTypedExpr& call) {
+    auto it = batchesByInput_.find(call.inputs()[0].get());
+    if (it == batchesByInput_.end()) {
+      return nullptr;
+    }
+    const auto name = sanitizeName(call.name());
+    for (auto index : it->second) {
+      if (batches_[index].name == name) {
+        return &batches_[index];
+      }
+    }
+    return nullptr;
+  }
+
+  static std::optional<uint32_t> findConstant(
+      const CallBatch& batch,
+      const ITypedExpr& constant) {
+    for (auto i = 0; i < batch.constants.size(); ++i) {
+      if (*batch.constants[i] == constant) {
+        return i;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void collect(const TypedExprPtr& expr) {
+    if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+      return;
+    }
+    for (const auto& input : expr->inputs()) {
+      collect(input);
+    }
+    auto* function = batchableFunction(*expr);
+    if (function == nullptr) {
+      return;
+    }
+    const auto& call = static_cast<const core::CallTypedExpr&>(*expr);
+    auto* constant =
+        static_cast<const core::ConstantTypedExpr*>(call.inputs()[1].get());
+    auto* batch = findBatch(call);
+    if (batch == nullptr) {
+      batchesByInput_[call.inputs()[0].get()].push_back(batches_.size());
+      batches_.push_back({sanitizeName(call.name()), function, {}, {}, {}});
+      batch = &batches_.back();
+    } else if (!batch->constants[0]->type()->equivalent(*constant->type())) {
+      return;
+    }
+    if (!findConstant(*batch, *constant).has_value()) {
+      batch->constants.push_back(constant);
+      batch->types.push_back(call.type());
+    }
+  }
+
+  // Returns the batched call for 'batch' over 'input', the rewritten first
+  // input of the calls.
+  const TypedExprPtr& batchedCall(CallBatch& batch, const TypedExprPtr& input) {
+    if (batch.batchedCall == nullptr) {
+      std::vector<std::string> names;
+      std::vector<variant> values;
+      for (auto i = 0; i < batch.constants.size(); ++i) {
+        names.push_back(fmt::format("c{}", i));
+        values.push_back(batch.constants[i]->value());
+      }
+      batch.batchedCall = std::make_shared<core::CallTypedExpr>(
+          ROW(std::move(names), std::vector<TypePtr>(batch.types)),
+          std::vector<TypedExprPtr>{
+              input,
+              std::make_shared<core::ConstantTypedExpr>(
+                  ARRAY(batch.constants[0]->type()),
+                  variant::array(std::move(values)))},
+          batch.function->batchedName);
+    }
+    return batch.batchedCall;
+  }
+
+  TypedExprPtr rewrite(const TypedExprPtr& expr) {
+    if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+      return expr;
+    }
+    std::vector<TypedExprPtr> inputs;
+    bool changed = false;
+    for (const auto& input : expr->inputs()) {
+      inputs.push_back(rewrite(input));
+      changed |= inputs.back() != input;
+    }
+
+    if (batchableFunction(*expr) != nullptr) {
+      const auto& call = static_cast<const core::CallTypedExpr&>(*expr);
+      auto* batch = findBatch(call);
+      if (batch != nullptr && batch->constants.size() > 1) {
+        if (auto index = findConstant(*batch, *call.inputs()[1])) {
+          return std::make_shared<core::DereferenceTypedExpr>(
+              expr->type(), batchedCall(*batch, inputs[0]), *index);
+        }
+      }
+    }
+
+    if (!changed) {
+      return expr;
+    }
+    if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+      return std::make_shared<core::CallTypedExpr>(
+          expr->type(), std::move(inputs), call->name());
+    }
+    if (auto cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+      return std::make_shared<core::CastTypedExpr>(
+          expr->type(), inputs, cast->nullOnFailure());
+    }
+    if (auto access =
+            dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+      return std::make_shared<core::FieldAccessTypedExpr>(
+          expr->type(), inputs[0], access->name());
+    }
+    if (auto dereference =
+            dynamic_cast<const core::DereferenceTypedExpr*>(expr.get())) {
+      return std::make_shared<core::DereferenceTypedExpr>(
+          expr->type(), inputs[0], dereference->index());
+    }
+    if (dynamic_cast<const core::ConcatTypedExpr*>(expr.get())) {
+      return std::make_shared<core::ConcatTypedExpr>(
+          expr->type()->asRow().names(), inputs);
+    }
+    VELOX_UNSUPPORTED("Unknown typed expression: {}", expr->toString());
+  }
+
+  std::vector<CallBatch> batches_;
+  // Indices in 'batches_' of the batches of each first input.
+  folly::F14FastMap<
+      const ITypedExpr*,
+      std::vector<size_t>,
+      ITypedExprHasher,
+      ITypedExprComparer>
+      batchesByInput_;
+};
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
@@ -585,15 +813,24 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  const auto& config = execCtx->queryCtx()->queryConfig();
+  // Keeps the rewritten expressions alive while compiling, as 'scope' refers to
+  // them.
+  std::vector<TypedExprPtr> batchedSources;
+  if (config.exprBatchFunctionCalls() && !batchableFunctions().empty()) {
+    batchedSources = FunctionCallBatcher().batch(sources);
+  }
+  const auto& toCompile = batchedSources.empty() ? sources : batchedSources;
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(toCompile);
 
-  for (auto& source : sources) {
+  for (auto& source : toCompile) {
     exprs.push_back(compileExpression(
         source,
         &scope,
-        execCtx->queryCtx()->queryConfig(),
+        config,
         execCtx->pool(),
         flatteningCandidates,
         enableConstantFolding));
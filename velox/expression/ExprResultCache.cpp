@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprResultCache.h"
+
+namespace facebook::velox::exec {
+
+ExprResultCache::ExprResultCache(
+    std::shared_ptr<memory::MemoryPool> pool,
+    uint64_t maxBytes)
+    : pool_{std::move(pool)}, maxBytes_{maxBytes} {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+ExprResultCache::~ExprResultCache() {
+  // The cached values must be freed before 'pool_'.
+  entries_.clear();
+  lru_.clear();
+}
+
+ExprResultCache::EntryList::iterator ExprResultCache::findLocked(
+    const Key& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return lru_.end();
+  }
+  auto entryIt = it->second;
+  lru_.splice(lru_.begin(), lru_, entryIt);
+  return entryIt;
+}
+
+void ExprResultCache::eraseLocked(EntryList::iterator it) {
+  bytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+void ExprResultCache::evictLocked(EntryList::iterator keep) {
+  auto it = lru_.end();
+  while (bytes_ > maxBytes_ && it != lru_.begin()) {
+    --it;
+    if (it == keep) {
+      continue;
+    }
+    auto evict = it++;
+    eraseLocked(evict);
+    ++stats_.numEvictions;
+  }
+}
+
+void ExprResultCache::get(
+    const std::string& expr,
+    const VectorPtr& base,
+    const SelectivityVector& rows,
+    const TypePtr& type,
+    memory::MemoryPool* pool,
+    VectorPtr& result,
+    SelectivityVector& missingRows) {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto numRows = rows.countSelected();
+  auto it = findLocked({expr, base.get()});
+  if (it == lru_.end()) {
+    stats_.numMissRows += numRows;
+    return;
+  }
+
+  missingRows.deselect(it->validRows);
+  const auto numMissing = missingRows.countSelected();
+  stats_.numMissRows += numMissing;
+  stats_.numHitRows += numRows - numMissing;
+  if (numMissing == numRows) {
+    return;
+  }
+
+  BaseVector::ensureWritable(rows, type, pool, result);
+  SelectivityVector hitRows(rows);
+  hitRows.deselect(missingRows);
+  result->copy(it->values.get(), hitRows, nullptr);
+}
+
+void ExprResultCache::put(
+    const std::string& expr,
+    const VectorPtr& base,
+    const SelectivityVector& rows,
+    const BaseVector& result) {
+  if (!rows.hasSelections()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  const Key key{expr, base.get()};
+  auto it = findLocked(key);
+  if (it == lru_.end()) {
+    lru_.push_front(Entry{
+        key,
+        base,
+        BaseVector::create(result.type(), base->size(), pool_.get()),
+        SelectivityVector(base->size(), false),
+        0});
+    it = lru_.begin();
+    entries_[key] = it;
+  }
+
+  // Another driver may have added some of the rows meanwhile.
+  SelectivityVector newRows(rows);
+  newRows.deselect(it->validRows);
+  if (!newRows.hasSelections()) {
+    return;
+  }
+  it->values->copy(&result, newRows, nullptr);
+  it->validRows.select(newRows);
+
+  bytes_ -= it->bytes;
+  it->bytes = it->values->retainedSize();
+  bytes_ += it->bytes;
+  evictLocked(it);
+}
+
+ExprResultCache::Stats ExprResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+uint64_t ExprResultCache::bytes() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return bytes_;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/vector/BaseVector.h"
+#include "velox/vector/SelectivityVector.h"
+
+namespace facebook::velox::exec {
+
+/// Results of deterministic expressions over the base of a dictionary encoded
+/// input, shared by all the drivers of a Task. An entry is keyed by the
+/// expression and the identity of the base vector, so that an expression that
+/// reads the same dictionary from several batches, drivers or ExprSets is
+/// evaluated once per distinct value. This complements the memoization of each
+/// Expr, which only covers consecutive batches of one ExprSet.
+///
+/// The cached values are copied into 'pool', which is charged to the query.
+/// The least recently used entries are evicted when the size of the cached
+/// values exceeds 'maxBytes'. An entry holds a strong reference to its base
+/// vector, like the memo of Expr. A base with a single owner may otherwise be
+/// reused in place for new values, e.g. by a VectorPool, while keeping its
+/// address, and the entry would return stale results. The bases are therefore
+/// kept alive until their entries are evicted. Thread-safe.
+class ExprResultCache {
+ public:
+  struct Stats {
+    /// Number of rows found in the cache.
+    uint64_t numHitRows{0};
+    /// Number of rows looked up and not found.
+    uint64_t numMissRows{0};
+    uint64_t numEvictions{0};
+  };
+
+  ExprResultCache(std::shared_ptr<memory::MemoryPool> pool, uint64_t maxBytes);
+
+  ~ExprResultCache();
+
+  /// Copies into 'result' the values of 'expr' cached for 'rows' of 'base' and
+  /// deselects these rows from 'missingRows'. 'missingRows' must be a copy of
+  /// 'rows' on entry. 'result' is made writable for 'rows' if any row is found.
+  void get(
+      const std::string& expr,
+      const VectorPtr& base,
+      const SelectivityVector& rows,
+      const TypePtr& type,
+      memory::MemoryPool* pool,
+      VectorPtr& result,
+      SelectivityVector& missingRows);
+
+  /// Adds the values of 'expr' in 'result' for 'rows' of 'base'.
+  void put(
+      const std::string& expr,
+      const VectorPtr& base,
+      const SelectivityVector& rows,
+      const BaseVector& result);
+
+  Stats stats() const;
+
+  /// Total size of the cached values.
+  uint64_t bytes() const;
+
+ private:
+  using Key = std::pair<std::string, const BaseVector*>;
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return folly::hash::hash_combine(
+          std::hash<std::string>()(key.first), key.second);
+    }
+  };
+
+  struct Entry {
+    Key key;
+    // Keeps 'base' from being reused in place or its address from being
+    // reused by another vector while the entry exists.
+    VectorPtr base;
+    VectorPtr values;
+    // The rows of 'base' with a value in 'values'.
+    SelectivityVector validRows;
+    uint64_t bytes{0};
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // Returns the entry for 'key' after moving it to the front of 'lru_'.
+  EntryList::iterator findLocked(const Key& key);
+
+  void eraseLocked(EntryList::iterator it);
+
+  // Evicts the least recently used entries other than 'keep' until 'bytes_'
+  // is at most 'maxBytes_'.
+  void evictLocked(EntryList::iterator keep);
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const uint64_t maxBytes_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  EntryList lru_;
+  folly::F14FastMap<Key, EntryList::iterator, KeyHasher> entries_;
+  uint64_t bytes_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox::exec
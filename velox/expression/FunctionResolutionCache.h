@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/type/Type.h"
+
+namespace facebook::velox::exec {
+
+/// Caches the outcome of resolving a function by name and argument types.
+/// Expressions of the same shape are compiled again for every task that runs
+/// them, and binding the argument types to each signature of each function
+/// dominates the compilation of short queries. The cache is process wide and
+/// bounded. It is cleared when full.
+template <typename Value>
+class FunctionResolutionCache {
+ public:
+  /// Returns the value cached for 'name' and 'argTypes' or std::nullopt.
+  std::optional<Value> find(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes) const {
+    return entries_.withRLock([&](const auto& entries) -> std::optional<Value> {
+      auto it = entries.find(KeyView{name, argTypes});
+      if (it == entries.end()) {
+        return std::nullopt;
+      }
+      return it->second;
+    });
+  }
+
+  void insert(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes,
+      Value value) {
+    entries_.withWLock([&](auto& entries) {
+      if (entries.size() >= kMaxEntries) {
+        entries.clear();
+      }
+      entries.insert_or_assign(Key{name, argTypes}, std::move(value));
+    });
+  }
+
+  void clear() {
+    entries_.wlock()->clear();
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 10'000;
+
+  struct Key {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+  };
+
+  struct KeyView {
+    const std::string& name;
+    const std::vector<TypePtr>& argTypes;
+  };
+
+  struct Hasher {
+    using is_transparent = void;
+
+    template <typename K>
+    size_t operator()(const K& key) const {
+      auto hash = folly::hasher<std::string>()(key.name);
+      for (const auto& type : key.argTypes) {
+        hash = folly::hash::hash_combine(hash, type->hashKind());
+      }
+      return hash;
+    }
+  };
+
+  struct KeyEqual {
+    using is_transparent = void;
+
+    template <typename K1, typename K2>
+    bool operator()(const K1& left, const K2& right) const {
+      if (left.name != right.name ||
+          left.argTypes.size() != right.argTypes.size()) {
+        return false;
+      }
+      for (auto i = 0; i < left.argTypes.size(); ++i) {
+        if (*left.argTypes[i] != *right.argTypes[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  folly::Synchronized<folly::F14FastMap<Key, Value, Hasher, KeyEqual>>
+      entries_;
+};
+
+} // namespace facebook::velox::exec
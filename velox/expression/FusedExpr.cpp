@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// One function of the fused tree.
+struct FusedStep {
+  // An argument is either a leaf of the tree, e.g. an input of the FusedExpr,
+  // or the result of a previous step.
+  struct Arg {
+    bool isStep;
+    int32_t index;
+  };
+
+  std::shared_ptr<VectorFunction> function;
+  TypePtr type;
+  std::vector<Arg> args;
+};
+
+// Applies the steps of a fused tree in order. The last step is the root.
+class FusedFunction : public VectorFunction {
+ public:
+  explicit FusedFunction(std::vector<FusedStep> steps)
+      : steps_{std::move(steps)} {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      EvalCtx& context,
+      VectorPtr& result) const override {
+    std::vector<VectorPtr> stepResults(steps_.size());
+    if (!context.throwOnError() || rows.end() <= FusedExpr::kBlockSize) {
+      applySteps(rows, args, context, stepResults, result);
+      return;
+    }
+
+    context.ensureWritable(rows, outputType, result);
+    LocalSelectivityVector blockRowsHolder(context, FusedExpr::kBlockSize);
+    auto& blockRows = *blockRowsHolder;
+    std::vector<VectorPtr> blockArgs(args.size());
+    VectorPtr blockResult;
+    std::vector<BaseVector::CopyRange> ranges;
+    const auto* rawRows = rows.asRange().bits();
+    // Blocks start at multiples of kBlockSize so that their bits in 'rows' are
+    // word aligned.
+    for (vector_size_t begin = 0; begin < rows.end();
+         begin += FusedExpr::kBlockSize) {
+      const auto end = std::min(begin + FusedExpr::kBlockSize, rows.end());
+      if (bits::findFirstBit(rawRows, begin, end) < 0) {
+        continue;
+      }
+      const auto size = end - begin;
+      blockRows.setFromBits(rawRows + begin / 64, size);
+      for (auto i = 0; i < args.size(); ++i) {
+        blockArgs[i] = args[i]->slice(begin, size);
+      }
+
+      applySteps(blockRows, blockArgs, context, stepResults, blockResult);
+
+      ranges.clear();
+      blockRows.applyToSelected([&](auto row) {
+        if (!ranges.empty() &&
+            ranges.back().sourceIndex + ranges.back().count == row) {
+          ++ranges.back().count;
+        } else {
+          ranges.push_back({row, begin + row, 1});
+        }
+      });
+      result->copyRanges(blockResult.get(), ranges);
+    }
+  }
+
+  bool supportsFlatNoNullsFastPath() const override {
+    for (const auto& step : steps_) {
+      if (!step.function->supportsFlatNoNullsFastPath()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  int32_t numSteps() const {
+    return steps_.size();
+  }
+
+ private:
+  // Applies the steps on 'rows' of 'args'. The result of the last step goes to
+  // 'result', the others to 'stepResults'.
+  void applySteps(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      EvalCtx& context,
+      std::vector<VectorPtr>& stepResults,
+      VectorPtr& result) const {
+    LocalSelectivityVector remainingRowsHolder(context);
+    std::vector<VectorPtr> stepArgs;
+    for (auto i = 0; i < steps_.size(); ++i) {
+      const auto& step = steps_[i];
+      auto& stepResult = i == steps_.size() - 1 ? result : stepResults[i];
+
+      // The leaves have no nulls in 'rows' because the tree has default null
+      // behavior. The results of the steps are flat but may have nulls.
+      const SelectivityVector* stepRows = &rows;
+      stepArgs.clear();
+      for (const auto& arg : step.args) {
+        if (!arg.isStep) {
+          stepArgs.push_back(args[arg.index]);
+          continue;
+        }
+        const auto& input = stepResults[arg.index];
+        if (input->mayHaveNulls()) {
+          VELOX_DCHECK(input->isFlatEncoding());
+          if (stepRows == &rows) {
+            stepRows = remainingRowsHolder.get(rows);
+          }
+          remainingRowsHolder->deselectNulls(
+              input->rawNulls(), rows.begin(), rows.end());
+        }
+        stepArgs.push_back(input);
+      }
+      if (context.errors() != nullptr) {
+        // Like Expr, does not apply a function to the rows where its arguments
+        // failed.
+        if (stepRows == &rows) {
+          stepRows = remainingRowsHolder.get(rows);
+        }
+        context.deselectErrors(*remainingRowsHolder);
+      }
+
+      // Sized for all 'rows' so that the nulls can be set below.
+      context.ensureWritable(rows, step.type, stepResult);
+      if (stepRows->hasSelections()) {
+        step.function->apply(*stepRows, stepArgs, step.type, context, stepResult);
+      }
+      if (stepRows != &rows) {
+        rows.applyToSelected([&](auto row) {
+          if (!stepRows->isValid(row)) {
+            stepResult->setNull(row, true);
+          }
+        });
+      }
+    }
+  }
+
+  const std::vector<FusedStep> steps_;
+};
+
+class FusedTreeBuilder {
+ public:
+  explicit FusedTreeBuilder(const std::function<bool(const Expr&)>& isFusable)
+      : isFusable_{isFusable} {}
+
+  // Adds the steps of the tree rooted at 'expr' and returns the index of the
+  // step of 'expr'.
+  int32_t addStep(const Expr& expr) {
+    FusedStep step{expr.vectorFunction(), expr.type(), {}};
+    for (const auto& input : expr.inputs()) {
+      if (const auto* fusable = asFusable(input)) {
+        step.args.push_back({true, addStep(*fusable)});
+      } else {
+        step.args.push_back({false, addLeaf(input)});
+      }
+    }
+    steps_.push_back(std::move(step));
+    return steps_.size() - 1;
+  }
+
+  std::vector<FusedStep>& steps() {
+    return steps_;
+  }
+
+  std::vector<ExprPtr>& leaves() {
+    return leaves_;
+  }
+
+ private:
+  // Returns the unfused simple function Expr for 'input' if it can be part of
+  // the tree.
+  const Expr* asFusable(const ExprPtr& input) const {
+    if (input->isMultiplyReferenced()) {
+      return nullptr;
+    }
+    if (const auto* fused = input->as<FusedExpr>()) {
+      return fused->original().get();
+    }
+    return isFusable_(*input) ? input.get() : nullptr;
+  }
+
+  int32_t addLeaf(const ExprPtr& input) {
+    for (auto i = 0; i < leaves_.size(); ++i) {
+      if (leaves_[i].get() == input.get()) {
+        return i;
+      }
+    }
+    leaves_.push_back(input);
+    return leaves_.size() - 1;
+  }
+
+  const std::function<bool(const Expr&)>& isFusable_;
+  std::vector<FusedStep> steps_;
+  std::vector<ExprPtr> leaves_;
+};
+
+} // namespace
+
+FusedExpr::FusedExpr(
+    std::shared_ptr<Expr> original,
+    std::vector<std::shared_ptr<Expr>>&& leaves,
+    std::shared_ptr<VectorFunction> function,
+    bool trackCpuUsage)
+    : Expr(
+          original->type(),
+          std::move(leaves),
+          std::move(function),
+          VectorFunctionMetadataBuilder()
+              .deterministic(true)
+              .defaultNullBehavior(true)
+              .build(),
+          original->name(),
+          trackCpuUsage),
+      original_{std::move(original)} {}
+
+// static
+std::shared_ptr<Expr> FusedExpr::tryFuse(
+    const std::shared_ptr<Expr>& expr,
+    const std::function<bool(const Expr&)>& isFusable,
+    bool trackCpuUsage) {
+  FusedTreeBuilder builder(isFusable);
+  builder.addStep(*expr);
+  if (builder.steps().size() < 2) {
+    return nullptr;
+  }
+  return std::make_shared<FusedExpr>(
+      expr,
+      std::move(builder.leaves()),
+      std::make_shared<FusedFunction>(std::move(builder.steps())),
+      trackCpuUsage);
+}
+
+int32_t FusedExpr::numFusedFunctions() const {
+  return static_cast<const FusedFunction*>(vectorFunction().get())->numSteps();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/Expr.h"
+
+namespace facebook::velox::exec {
+
+/// A tree of simple functions over fixed-width types, e.g. a * b + c - d,
+/// evaluated as a single Expr. The inputs of the FusedExpr are the leaves of
+/// the tree. The functions of the tree are applied one after the other on
+/// blocks of kBlockSize rows, so that the intermediate results are vectors of
+/// at most kBlockSize rows reused from block to block and stay in the CPU
+/// cache, instead of vectors of the size of the batch. All the functions must
+/// be deterministic and have default null behavior, so the tree as a whole is
+/// too.
+///
+/// Rows with an error are only reported at block-relative positions, so the
+/// blocks are only used when errors are thrown. Under TRY, the tree is
+/// evaluated over the batch at once, still without the per-Expr overhead of
+/// the intermediate nodes.
+class FusedExpr : public Expr {
+ public:
+  static constexpr vector_size_t kBlockSize = 1024;
+
+  /// @param original The unfused tree.
+  /// @param leaves The inputs of 'function'.
+  /// @param function Evaluates 'original' from the values of 'leaves'.
+  FusedExpr(
+      std::shared_ptr<Expr> original,
+      std::vector<std::shared_ptr<Expr>>&& leaves,
+      std::shared_ptr<VectorFunction> function,
+      bool trackCpuUsage);
+
+  /// Returns a FusedExpr for the tree rooted at 'expr', or nullptr if fewer
+  /// than two functions can be fused. 'isFusable' tells whether a simple
+  /// function Expr, that is not a FusedExpr, can be part of a fused tree.
+  /// Multiply referenced inputs are not fused and become leaves.
+  static std::shared_ptr<Expr> tryFuse(
+      const std::shared_ptr<Expr>& expr,
+      const std::function<bool(const Expr&)>& isFusable,
+      bool trackCpuUsage);
+
+  /// Returns the unfused tree.
+  const std::shared_ptr<Expr>& original() const {
+    return original_;
+  }
+
+  /// Number of functions evaluated by 'this'.
+  int32_t numFusedFunctions() const;
+
+  std::string toString(bool recursive = true) const override {
+    return original_->toString(recursive);
+  }
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override {
+    return original_->toSql(complexConstants);
+  }
+
+ private:
+  const std::shared_ptr<Expr> original_;
+};
+
+} // namespace facebook::velox::exec
@@ -40,6 +40,7 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
     bool overwrite) {
   const auto sanitizedName = sanitizeName(name);
   return registeredFunctions_.withWLock([&](auto& map) {
+    resolutionCache_.clear();
     SignatureMap& signatureMap = map[sanitizedName];
     auto& functions = signatureMap[*metadata->signature()];
 
@@ -151,6 +152,10 @@ SimpleFunctionRegistry::resolveFunction(
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
   registeredFunctions_.withRLock([&](const auto& map) {
+    if (auto cached = resolutionCache_.find(name, argTypes)) {
+      std::tie(selectedCandidate, selectedCandidateType) = *cached;
+      return;
+    }
     if (const auto* signatureMap = getSignatureMap(name, map)) {
       for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
         SignatureBinder binder(candidateSignature, argTypes);
@@ -190,6 +195,8 @@ SimpleFunctionRegistry::resolveFunction(
         }
       }
     }
+    resolutionCache_.insert(
+        name, argTypes, {selectedCandidate, selectedCandidateType});
   });
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/core/SimpleFunctionMetadata.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
 #include "velox/type/Type.h"
@@ -104,7 +105,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolutionCache_.clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -167,6 +171,13 @@ class SimpleFunctionRegistry {
       bool overwrite);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // Function entry and return type selected for a name and argument types.
+  // The entry is nullptr if no function matches. Accessed and cleared only
+  // under a lock on 'registeredFunctions_', so that entries never outlive the
+  // registrations they point to.
+  mutable FunctionResolutionCache<std::pair<const FunctionEntry*, TypePtr>>
+      resolutionCache_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
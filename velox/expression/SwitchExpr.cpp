@@ -25,6 +25,43 @@ namespace {
 bool hasElseClause(const std::vector<ExprPtr>& inputs) {
   return inputs.size() % 2 == 1;
 }
+
+// Minimum number of conditions for which a lookup table is faster than
+// evaluating the conditions one at a time.
+constexpr size_t kMinCasesForLookup = 4;
+
+// Returns true if 'expr' is a call to 'eq', possibly qualified with catalog
+// and schema, e.g. 'presto.default.eq'.
+bool isEqualityCall(const Expr& expr) {
+  if (expr.isSpecialForm() || expr.inputs().size() != 2) {
+    return false;
+  }
+  std::string_view name = expr.name();
+  if (const auto pos = name.rfind('.'); pos != std::string_view::npos) {
+    name = name.substr(pos + 1);
+  }
+  return name == "eq";
+}
+
+bool isSameInput(const ExprPtr& left, const ExprPtr& right) {
+  if (left == right) {
+    return true;
+  }
+  const auto* leftField = left->as<FieldReference>();
+  const auto* rightField = right->as<FieldReference>();
+  return leftField != nullptr && rightField != nullptr &&
+      leftField->inputs().empty() && rightField->inputs().empty() &&
+      leftField->field() == rightField->field();
+}
+
+// Types for which equality of values is equality of their representation.
+bool isLookupType(const TypePtr& type) {
+  static const std::vector<TypePtr> kTypes = {
+      TINYINT(), SMALLINT(), INTEGER(), BIGINT(), VARCHAR(), VARBINARY()};
+  return std::any_of(kTypes.begin(), kTypes.end(), [&](const auto& other) {
+    return *type == *other;
+  });
+}
 } // namespace
 
 SwitchExpr::SwitchExpr(
@@ -38,7 +75,8 @@ SwitchExpr::SwitchExpr(
           hasElseClause(inputs) && inputsSupportFlatNoNullsFastPath,
           false /* trackCpuUsage */),
       numCases_{inputs_.size() / 2},
-      hasElseClause_{hasElseClause(inputs_)} {
+      hasElseClause_{hasElseClause(inputs_)},
+      caseLookup_{makeCaseLookup()} {
   std::vector<TypePtr> inputTypes;
   inputTypes.reserve(inputs_.size());
   std::transform(
@@ -84,56 +122,60 @@ void SwitchExpr::evalSpecialForm(
     }
   }
 
-  VectorPtr condition;
-  const uint64_t* values;
+  if (caseLookup_.has_value()) {
+    evalCaseLookup(*remainingRows.get(), context, localResult);
+  } else {
+    VectorPtr condition;
+    const uint64_t* values;
 
-  for (auto i = 0; i < numCases_; i++) {
-    context.releaseVector(condition);
+    for (auto i = 0; i < numCases_; i++) {
+      context.releaseVector(condition);
 
-    if (!remainingRows.get()->hasSelections()) {
-      break;
-    }
+      if (!remainingRows.get()->hasSelections()) {
+        break;
+      }
 
-    // evaluate the case condition
-    inputs_[2 * i]->eval(*remainingRows.get(), context, condition);
+      // evaluate the case condition
+      inputs_[2 * i]->eval(*remainingRows.get(), context, condition);
 
-    if (context.errors()) {
-      context.deselectErrors(*remainingRows);
-      if (!remainingRows->hasSelections()) {
-        break;
+      if (context.errors()) {
+        context.deselectErrors(*remainingRows);
+        if (!remainingRows->hasSelections()) {
+          break;
+        }
       }
-    }
 
-    const auto booleanMix = getFlatBool(
-        condition.get(),
-        *remainingRows.get(),
-        context,
-        &tempValues_,
-        nullptr,
-        true,
-        &values,
-        nullptr);
-    switch (booleanMix) {
-      case BooleanMix::kAllTrue:
-        inputs_[2 * i + 1]->eval(*remainingRows.get(), context, localResult);
-        remainingRows->clearAll();
-        continue;
-      case BooleanMix::kAllNull:
-      case BooleanMix::kAllFalse:
-        continue;
-      default: {
-        thenRows.get(remainingRows->end(), false);
-        bits::andBits(
-            thenRows.get()->asMutableRange().bits(),
-            remainingRows.get()->asRange().bits(),
-            values,
-            0,
-            remainingRows->end());
-        thenRows.get()->updateBounds();
-
-        if (thenRows.get()->hasSelections()) {
-          inputs_[2 * i + 1]->eval(*thenRows.get(), context, localResult);
-          remainingRows.get()->deselect(*thenRows.get());
+      const auto booleanMix = getFlatBool(
+          condition.get(),
+          *remainingRows.get(),
+          context,
+          &tempValues_,
+          nullptr,
+          true,
+          &values,
+          nullptr);
+      switch (booleanMix) {
+        case BooleanMix::kAllTrue:
+          inputs_[2 * i + 1]->eval(*remainingRows.get(), context, localResult);
+          remainingRows->clearAll();
+          continue;
+        case BooleanMix::kAllNull:
+        case BooleanMix::kAllFalse:
+          continue;
+        default: {
+          thenRows.get(remainingRows->end(), false);
+          bits::andBits(
+              thenRows.get()->asMutableRange().bits(),
+              remainingRows.get()->asRange().bits(),
+              values,
+              0,
+              remainingRows->end());
+          thenRows.get()->updateBounds();
+
+          if (thenRows.get()->hasSelections()) {
+            inputs_[2 * i + 1]->eval(*thenRows.get(), context, localResult);
+            remainingRows.get()->deselect(*thenRows.get());
+          }
         }
       }
     }
@@ -171,6 +213,179 @@ void SwitchExpr::evalSpecialForm(
   context.moveOrCopyResult(localResult, rows, finalResult);
 }
 
+std::optional<SwitchExpr::CaseLookup> SwitchExpr::makeCaseLookup() const {
+  if (numCases_ < kMinCasesForLookup) {
+    return std::nullopt;
+  }
+
+  CaseLookup lookup;
+  for (auto i = 0; i < numCases_; ++i) {
+    const auto& condition = inputs_[2 * i];
+    if (!isEqualityCall(*condition)) {
+      return std::nullopt;
+    }
+    auto input = condition->inputs()[0];
+    auto constant = condition->inputs()[1]->as<ConstantExpr>();
+    if (constant == nullptr) {
+      input = condition->inputs()[1];
+      constant = condition->inputs()[0]->as<ConstantExpr>();
+    }
+    if (constant == nullptr || input->as<ConstantExpr>() != nullptr ||
+        !isLookupType(input->type()) ||
+        *constant->type() != *input->type()) {
+      return std::nullopt;
+    }
+    if (lookup.input == nullptr) {
+      lookup.input = input;
+    } else if (!isSameInput(lookup.input, input)) {
+      return std::nullopt;
+    }
+
+    // A comparison with null is never true.
+    const auto& value = constant->value();
+    if (value->isNullAt(0)) {
+      continue;
+    }
+    // Only the first condition with a given constant can be true.
+    switch (value->typeKind()) {
+      case TypeKind::TINYINT:
+        lookup.integers.emplace(
+            value->asUnchecked<SimpleVector<int8_t>>()->valueAt(0), i);
+        break;
+      case TypeKind::SMALLINT:
+        lookup.integers.emplace(
+            value->asUnchecked<SimpleVector<int16_t>>()->valueAt(0), i);
+        break;
+      case TypeKind::INTEGER:
+        lookup.integers.emplace(
+            value->asUnchecked<SimpleVector<int32_t>>()->valueAt(0), i);
+        break;
+      case TypeKind::BIGINT:
+        lookup.integers.emplace(
+            value->asUnchecked<SimpleVector<int64_t>>()->valueAt(0), i);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        lookup.strings.emplace(
+            value->asUnchecked<SimpleVector<StringView>>()->valueAt(0).str(),
+            i);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  return lookup;
+}
+
+template <typename T>
+void SwitchExpr::lookupCases(
+    const DecodedVector& input,
+    const SelectivityVector& rows) {
+  rows.applyToSelected([&](auto row) {
+    caseIndices_[row] = -1;
+    if (input.isNullAt(row)) {
+      return;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = input.valueAt<StringView>(row);
+      const auto it = caseLookup_->strings.find(
+          folly::StringPiece(value.data(), value.size()));
+      if (it != caseLookup_->strings.end()) {
+        caseIndices_[row] = it->second;
+      }
+    } else {
+      const auto it = caseLookup_->integers.find(input.valueAt<T>(row));
+      if (it != caseLookup_->integers.end()) {
+        caseIndices_[row] = it->second;
+      }
+    }
+  });
+}
+
+void SwitchExpr::evalCaseLookup(
+    SelectivityVector& remainingRows,
+    EvalCtx& context,
+    VectorPtr& localResult) {
+  if (!remainingRows.hasSelections()) {
+    return;
+  }
+
+  VectorPtr input;
+  caseLookup_->input->eval(remainingRows, context, input);
+  if (context.errors()) {
+    context.deselectErrors(remainingRows);
+  }
+  if (!remainingRows.hasSelections()) {
+    return;
+  }
+
+  const auto numRows = remainingRows.end();
+  caseIndices_.resize(numRows);
+  {
+    LocalDecodedVector decoded(context, *input, remainingRows);
+    switch (input->typeKind()) {
+      case TypeKind::TINYINT:
+        lookupCases<int8_t>(*decoded, remainingRows);
+        break;
+      case TypeKind::SMALLINT:
+        lookupCases<int16_t>(*decoded, remainingRows);
+        break;
+      case TypeKind::INTEGER:
+        lookupCases<int32_t>(*decoded, remainingRows);
+        break;
+      case TypeKind::BIGINT:
+        lookupCases<int64_t>(*decoded, remainingRows);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        lookupCases<StringView>(*decoded, remainingRows);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  context.releaseVector(input);
+
+  // Group the rows by case with a counting sort, then evaluate each 'then'
+  // clause once for its rows.
+  caseOffsets_.assign(numCases_ + 1, 0);
+  remainingRows.applyToSelected([&](auto row) {
+    if (caseIndices_[row] >= 0) {
+      ++caseOffsets_[caseIndices_[row] + 1];
+    }
+  });
+  for (auto i = 0; i < numCases_; ++i) {
+    caseOffsets_[i + 1] += caseOffsets_[i];
+  }
+  caseRows_.resize(caseOffsets_[numCases_]);
+  remainingRows.applyToSelected([&](auto row) {
+    if (caseIndices_[row] >= 0) {
+      caseRows_[caseOffsets_[caseIndices_[row]]++] = row;
+    }
+  });
+  for (auto row : caseRows_) {
+    remainingRows.setValid(row, false);
+  }
+  remainingRows.updateBounds();
+
+  // 'caseOffsets_[i]' is now the end of the rows of case 'i'.
+  LocalSelectivityVector thenRows(context);
+  vector_size_t begin = 0;
+  for (auto i = 0; i < numCases_; ++i) {
+    const auto end = caseOffsets_[i];
+    if (begin == end) {
+      continue;
+    }
+    auto* rows = thenRows.get(numRows, false);
+    for (auto j = begin; j < end; ++j) {
+      rows->setValid(caseRows_[j], true);
+    }
+    rows->updateBounds();
+    inputs_[2 * i + 1]->eval(*rows, context, localResult);
+    begin = end;
+  }
+}
+
 // This is safe to call only after all metadata is computed for input
 // expressions.
 void SwitchExpr::computePropagatesNulls() {
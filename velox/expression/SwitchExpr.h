@@ -34,6 +34,11 @@ namespace facebook::velox::exec {
 ///
 /// IF expression can be represented as a CASE expression with a single
 /// condition.
+///
+/// A CASE where every condition compares the same input to a constant, e.g.
+/// case x when 'a' then 1 when 'b' then 2 ... end, is evaluated by looking up
+/// the value of the input in a hash table from constant to the first matching
+/// condition, instead of evaluating the conditions one at a time.
 class SwitchExpr : public SpecialForm {
  public:
   /// Inputs are concatenated conditions and results with an optional "else" at
@@ -57,10 +62,40 @@ class SwitchExpr : public SpecialForm {
 
   void computePropagatesNulls() override;
 
+  // Maps the constants in conditions 'input = constant' to the index of the
+  // first such condition. Integer constants are widened to int64_t.
+  struct CaseLookup {
+    ExprPtr input;
+    folly::F14FastMap<int64_t, int32_t> integers;
+    folly::F14FastMap<std::string, int32_t> strings;
+  };
+
+  // Returns the lookup table if all conditions compare the same input of a
+  // supported type to constants.
+  std::optional<CaseLookup> makeCaseLookup() const;
+
+  // Evaluates the conditions for 'remainingRows' using 'caseLookup_' and the
+  // 'then' clauses for the rows that satisfy them. Removes these rows from
+  // 'remainingRows'.
+  void evalCaseLookup(
+      SelectivityVector& remainingRows,
+      EvalCtx& context,
+      VectorPtr& localResult);
+
+  // Sets 'caseIndices_[row]' to the index of the first true condition for
+  // 'rows' or to -1 if none is true.
+  template <typename T>
+  void lookupCases(const DecodedVector& input, const SelectivityVector& rows);
+
   const size_t numCases_;
   const bool hasElseClause_;
   BufferPtr tempValues_;
 
+  const std::optional<CaseLookup> caseLookup_;
+  std::vector<int32_t> caseIndices_;
+  std::vector<vector_size_t> caseRows_;
+  std::vector<vector_size_t> caseOffsets_;
+
   friend class SwitchCallToSpecialForm;
 };
 
@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include "folly/Singleton.h"
 #include "folly/Synchronized.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
@@ -55,6 +56,42 @@ std::vector<VectorFunctionArg> toVectorFunctionArgs(
 
   return args;
 }
+
+// Signature that matched a function name and argument types, and the return
+// type it resolved to. Only matches are cached. A cached signature is used
+// only while it is still among the signatures of the function, which protects
+// against re-registration and direct changes to vectorFunctionFactories().
+using SignatureMatch = std::pair<FunctionSignaturePtr, TypePtr>;
+
+FunctionResolutionCache<SignatureMatch>& signatureMatches() {
+  static FunctionResolutionCache<SignatureMatch> cache;
+  return cache;
+}
+
+// Returns the first signature of 'entry' that 'argTypes' bind to, together
+// with the resolved return type.
+std::optional<SignatureMatch> bindSignature(
+    const std::string& sanitizedName,
+    const VectorFunctionEntry& entry,
+    const std::vector<TypePtr>& argTypes) {
+  if (auto cached = signatureMatches().find(sanitizedName, argTypes)) {
+    for (const auto& signature : entry.signatures) {
+      if (signature == cached->first) {
+        return cached;
+      }
+    }
+  }
+
+  for (const auto& signature : entry.signatures) {
+    exec::SignatureBinder binder(*signature, argTypes);
+    if (binder.tryBind()) {
+      SignatureMatch match{signature, binder.tryResolveReturnType()};
+      signatureMatches().insert(sanitizedName, argTypes, match);
+      return match;
+    }
+  }
+  return std::nullopt;
+}
 } // namespace
 
 VectorFunctionMap& vectorFunctionFactories() {
@@ -87,13 +124,10 @@ resolveVectorFunctionWithMetadata(
     const std::vector<TypePtr>& argTypes) {
   return applyToVectorFunctionEntry<std::pair<TypePtr, VectorFunctionMetadata>>(
       functionName,
-      [&](const auto& /*name*/, const auto& entry)
+      [&](const auto& sanitizedName, const auto& entry)
           -> std::optional<std::pair<TypePtr, VectorFunctionMetadata>> {
-        for (const auto& signature : entry.signatures) {
-          exec::SignatureBinder binder(*signature, argTypes);
-          if (binder.tryBind()) {
-            return {{binder.tryResolveReturnType(), entry.metadata}};
-          }
+        if (auto match = bindSignature(sanitizedName, entry, argTypes)) {
+          return {{match->second, entry.metadata}};
         }
         return std::nullopt;
       });
@@ -130,15 +164,12 @@ getVectorFunctionWithMetadata(
           -> std::optional<std::pair<
               std::shared_ptr<VectorFunction>,
               VectorFunctionMetadata>> {
-        for (const auto& signature : entry.signatures) {
-          exec::SignatureBinder binder(*signature, inputTypes);
-          if (binder.tryBind()) {
-            auto inputArgs = toVectorFunctionArgs(inputTypes, constantInputs);
-
-            return {
-                {entry.factory(sanitizedName, inputArgs, config),
-                 entry.metadata}};
-          }
+        if (bindSignature(sanitizedName, entry, inputTypes)) {
+          auto inputArgs = toVectorFunctionArgs(inputTypes, constantInputs);
+
+          return {
+              {entry.factory(sanitizedName, inputArgs, config),
+               entry.metadata}};
         }
         return std::nullopt;
       });
@@ -197,4 +228,15 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::unordered_map<std::string, BatchableFunction>& batchableFunctions() {
+  static std::unordered_map<std::string, BatchableFunction> functions;
+  return functions;
+}
+
+void registerBatchableFunction(
+    const std::string& name,
+    BatchableFunction function) {
+  batchableFunctions()[sanitizeName(name)] = std::move(function);
+}
+
 } // namespace facebook::velox::exec
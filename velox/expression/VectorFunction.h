@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <functional>
+#include <unordered_map>
 #include <vector>
 #include "velox/core/Expressions.h"
 #include "velox/expression/EvalCtx.h"
@@ -285,6 +287,33 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// Describes a function 'name'(x, c) whose calls on the same input x with
+/// different constants c can be evaluated together by a single call
+/// 'batchedName'(x, ARRAY[c1, ..., cn]). The batched function returns a ROW
+/// whose field i is the result of 'name'(x, ci). The ROW itself is never null.
+/// E.g. several json_extract_scalar calls on the same column can parse each
+/// document once.
+struct BatchableFunction {
+  std::string batchedName;
+
+  /// Tells whether a call with an input x of type 'inputType' and constant 'c'
+  /// can be batched, e.g. whether 'c' is valid so that batching does not change
+  /// which rows fail.
+  std::function<
+      bool(const TypePtr& inputType, const core::ConstantTypedExpr& c)>
+      canBatch;
+};
+
+/// Returns the registered batchable functions keyed by function name.
+std::unordered_map<std::string, BatchableFunction>& batchableFunctions();
+
+/// Registers 'function' as the batched form of calls to 'name'. ExprCompiler
+/// replaces calls to 'name' of an ExprSet with field accesses on a shared
+/// batched call when 'expression.batch_function_calls' is true.
+void registerBatchableFunction(
+    const std::string& name,
+    BatchableFunction function);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
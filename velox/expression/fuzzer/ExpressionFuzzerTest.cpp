@@ -66,6 +66,13 @@ int main(int argc, char** argv) {
       "regexp_like",
       "regexp_replace",
       "regexp_split",
+      // Used by expression compilation only. The number of fields of the
+      // result depends on the constant array argument.
+      "$internal$json_extract_scalar_batch",
+      "$internal$map_subscript_batch",
+      // Used by expression compilation only. Same issue as regexp_like.
+      "$internal$regexp_like_any",
+      "$internal$regexp_like_first",
   };
   size_t initialSeed = FLAGS_seed == 0 ? std::time(nullptr) : FLAGS_seed;
   return FuzzerRunner::run(initialSeed, skipFunctions, {{}});
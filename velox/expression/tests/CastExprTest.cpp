@@ -356,6 +356,51 @@ TEST_F(CastExprTest, basics) {
       {"1.888", "2.5", "3.6", "100.44", "-100.101", "1", "-2"});
 }
 
+TEST_F(CastExprTest, integerToVarchar) {
+  testCast<int8_t, std::string>(
+      "string", {0, 9, -10, 127, -128}, {"0", "9", "-10", "127", "-128"});
+  testCast<int32_t, std::string>(
+      "string",
+      {99, 100, 2147483647, -2147483648},
+      {"99", "100", "2147483647", "-2147483648"});
+  // BIGINT values longer than 12 characters are written to the string buffer.
+  testCast<int64_t, std::string>(
+      "string",
+      {123456789012,
+       -123456789012,
+       1000000000000000000,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min()},
+      {"123456789012",
+       "-123456789012",
+       "1000000000000000000",
+       "9223372036854775807",
+       "-9223372036854775808"});
+}
+
+TEST_F(CastExprTest, varcharToInteger) {
+  // Up to 18 digits are parsed 8 at a time, longer strings and other forms by
+  // the complete parser.
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"12345678",
+       "-123456789012345678",
+       "000000000000000042",
+       "1234567890123456789",
+       "-9223372036854775808",
+       "+12345678"},
+      {12345678,
+       -123456789012345678,
+       42,
+       1234567890123456789,
+       std::numeric_limits<int64_t>::min(),
+       12345678});
+  testCast<std::string, int16_t>(
+      "smallint", {"32767", "-32768"}, {32767, -32768});
+  testTryCast<std::string, int16_t>(
+      "smallint", {"32768", "1234567a"}, {std::nullopt, std::nullopt});
+}
+
 TEST_F(CastExprTest, fromUnknownType) {
   testCast<UnknownValue, int8_t>(
       "tinyint", {std::nullopt, std::nullopt}, {std::nullopt, std::nullopt});
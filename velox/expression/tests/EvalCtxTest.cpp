@@ -228,3 +228,59 @@ TEST_F(EvalCtxTest, localSingleRow) {
     }
   }
 }
+
+TEST_F(EvalCtxTest, decodeCache) {
+  EvalCtx context(&execCtx_);
+  const vector_size_t size = 100;
+  auto flat = makeFlatVector<int64_t>(size, [](auto row) { return row; });
+  auto indices = makeIndicesInReverse(size);
+  auto nested =
+      wrapInDictionary(indices, size, wrapInDictionary(indices, size, flat));
+  // Held by the caller and by the input of the expression.
+  auto input = nested;
+
+  SelectivityVector rows(size);
+  auto* decoded = context.getCachedDecoded(nested, rows);
+  ASSERT_NE(decoded, nullptr);
+  ASSERT_EQ(decoded, context.getCachedDecoded(nested, rows));
+  for (auto i = 0; i < size; ++i) {
+    ASSERT_EQ(i, decoded->valueAt<int64_t>(i));
+  }
+
+  // Different rows are decoded separately.
+  SelectivityVector someRows(size);
+  someRows.setValidRange(50, size, false);
+  someRows.updateBounds();
+  auto* decodedSome = context.getCachedDecoded(nested, someRows);
+  ASSERT_NE(decodedSome, nullptr);
+  ASSERT_NE(decodedSome, decoded);
+
+  // Flat and single level dictionaries are cheap to decode and not cached.
+  auto flatInput = flat;
+  ASSERT_EQ(context.getCachedDecoded(flat, rows), nullptr);
+  auto dictionary = wrapInDictionary(indices, size, flat);
+  auto dictionaryInput = dictionary;
+  ASSERT_EQ(context.getCachedDecoded(dictionary, rows), nullptr);
+
+  // A vector that only the caller references may be reused for a result.
+  auto temporary =
+      wrapInDictionary(indices, size, wrapInDictionary(indices, size, flat));
+  ASSERT_EQ(context.getCachedDecoded(temporary, rows), nullptr);
+
+  // The entry of a released vector is reused.
+  input.reset();
+  nested.reset();
+  auto other = wrapInDictionary(
+      indices,
+      size,
+      wrapInDictionary(
+          indices,
+          size,
+          makeFlatVector<int64_t>(size, [](auto row) { return row * 2; })));
+  auto otherInput = other;
+  auto* decodedOther = context.getCachedDecoded(other, rows);
+  ASSERT_NE(decodedOther, nullptr);
+  for (auto i = 0; i < size; ++i) {
+    ASSERT_EQ(i * 2, decodedOther->valueAt<int64_t>(i));
+  }
+}
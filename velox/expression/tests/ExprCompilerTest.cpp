@@ -17,6 +17,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 #include "velox/parse/Expressions.h"
@@ -102,6 +103,14 @@ class ExprCompilerTest : public testing::Test,
         std::vector<core::TypedExprPtr>{expr}, execCtx_.get());
   }
 
+  VectorPtr evaluate(ExprSet& exprSet, const RowVectorPtr& input) {
+    EvalCtx context(execCtx_.get(), &exprSet, input.get());
+    SelectivityVector rows(input->size());
+    std::vector<VectorPtr> result(1);
+    exprSet.eval(rows, context, result);
+    return result[0];
+  }
+
   std::shared_ptr<core::QueryCtx> queryCtx_{velox::core::QueryCtx::create()};
   std::unique_ptr<core::ExecCtx> execCtx_{
       std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get())};
@@ -334,3 +343,58 @@ TEST_F(ExprCompilerTest, lambdaExpr) {
 }
 
 } // namespace facebook::velox::exec::test
+
+TEST_F(ExprCompilerTest, fuseSimpleFunctions) {
+  // More rows than FusedExpr::kBlockSize to evaluate in several blocks.
+  constexpr vector_size_t kSize = 5'000;
+  auto data = makeRowVector({
+      makeFlatVector<double>(
+          kSize, [](auto row) { return row * 0.5; }, nullEvery(7)),
+      makeFlatVector<double>(kSize, [](auto row) { return row % 11; }),
+      makeFlatVector<double>(
+          kSize, [](auto row) { return row * 1.5; }, nullEvery(13)),
+      makeFlatVector<int64_t>(kSize, [](auto row) {
+        return row % 3 == 0 ? std::numeric_limits<int64_t>::max() / 2 : row;
+      }),
+  });
+  auto rowType = asRowType(data->type());
+
+  struct {
+    std::string sql;
+    int32_t numFusedFunctions;
+    int32_t numLeaves;
+  } testSettings[] = {
+      {"c0 * c1 + c2 - c0", 3, 3},
+      {"c0 * c1 + c2 - c1 * 2.0", 4, 4},
+      // Overflow errors are turned into nulls row by row.
+      {"try(c3 * 3 + c3)", 2, 2},
+  };
+
+  for (const auto& test : testSettings) {
+    SCOPED_TRACE(test.sql);
+    auto expression = makeTypedExpr(test.sql, rowType);
+    queryCtx_->testingOverrideConfigUnsafe({});
+    auto unfused = compile(expression);
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kExprFuseSimpleFunctions, "true"}});
+    auto fused = compile(expression);
+    ASSERT_EQ(fused->toString(), unfused->toString());
+
+    const FusedExpr* fusedExpr = nullptr;
+    std::function<void(const ExprPtr&)> findFused = [&](const ExprPtr& expr) {
+      if (auto* candidate = expr->as<FusedExpr>()) {
+        fusedExpr = candidate;
+        return;
+      }
+      for (const auto& input : expr->inputs()) {
+        findFused(input);
+      }
+    };
+    findFused(fused->expr(0));
+    ASSERT_NE(fusedExpr, nullptr);
+    ASSERT_EQ(fusedExpr->numFusedFunctions(), test.numFusedFunctions);
+    ASSERT_EQ(fusedExpr->inputs().size(), test.numLeaves);
+
+    assertEqualVectors(evaluate(*unfused, data), evaluate(*fused, data));
+  }
+}
@@ -29,6 +29,7 @@
 #include "velox/expression/CoalesceExpr.h"
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
+#include "velox/expression/ExprResultCache.h"
 #include "velox/expression/SwitchExpr.h"
 #include "velox/functions/Udf.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -467,13 +468,41 @@ TEST_P(ParameterizedExprTest, reorder) {
 
   // Verify that more efficient filter is first.
   for (auto i = 1; i < condition->inputs().size(); ++i) {
-    std::cout << condition->selectivityAt(i - 1).timeToDropValue() << std::endl;
     EXPECT_LE(
-        condition->selectivityAt(i - 1).timeToDropValue(),
-        condition->selectivityAt(i).timeToDropValue());
+        condition->selectivityAt(i - 1).costPerDroppedRow(),
+        condition->selectivityAt(i).costPerDroppedRow());
   }
 }
 
+TEST_F(ExprTest, reorderOr) {
+  constexpr int32_t kTestSize = 10'000;
+
+  // The expensive regular expression is first and decides no row. The cheap
+  // comparison decides 90% of the rows.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kTestSize,
+          [](auto row) { return std::string(50 + row % 10, 'a') + "b"; }),
+  });
+  auto exprSet = compileExpression(
+      "regexp_like(c1, '^(a|aa)*c$') or c0 % 10 < 9", asRowType(data->type()));
+  auto condition =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(condition != nullptr);
+
+  auto expectedResult =
+      makeFlatVector<bool>(kTestSize, [](auto row) { return row % 10 < 9; });
+  for (auto i = 0; i < 2; ++i) {
+    assertEqualVectors(expectedResult, evaluate(exprSet.get(), data));
+  }
+
+  // After the first batch the comparison is first and the regular expression
+  // only sees the rows that the comparison does not decide.
+  EXPECT_EQ(condition->selectivityAt(0).numIn(), 2 * kTestSize);
+  EXPECT_EQ(condition->selectivityAt(1).numIn(), kTestSize + kTestSize / 10);
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -1761,6 +1790,58 @@ TEST_P(ParameterizedExprTest, switchExprWithNull) {
   assertEqualVectors(expected, result);
 }
 
+TEST_P(ParameterizedExprTest, switchExprLookup) {
+  // Ladders of equality conditions on the same input are evaluated with a
+  // lookup table.
+  vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 13; }, nullEvery(7)),
+      makeFlatVector<std::string>(
+          size,
+          [](auto row) { return fmt::format("s{}", row % 13); },
+          nullEvery(7)),
+  });
+
+  auto expectedValueAt = [](auto row) -> std::optional<int64_t> {
+    if (row % 7 == 0) {
+      return std::nullopt;
+    }
+    switch (row % 13) {
+      case 1:
+        return 10;
+      case 3:
+        return 30;
+      case 5:
+        return 50;
+      case 12:
+        return 1'200;
+      default:
+        return std::nullopt;
+    }
+  };
+
+  // The constant 3 appears twice. Only the first condition can be true.
+  auto result = evaluate(
+      "case c0 when 1 then 10 when 3 then 30 when 5 then 50 when 3 then 0 "
+      "when 12 then c0 * 100 else -1 end",
+      data);
+  auto expected = makeFlatVector<int64_t>(
+      size, [&](auto row) { return expectedValueAt(row).value_or(-1); });
+  assertEqualVectors(expected, result);
+
+  // Strings, constants on either side and no else clause.
+  result = evaluate(
+      "case when c1 = 's1' then 10 when 's3' = c1 then 30 "
+      "when c1 = 's5' then 50 when c1 = 's12' then 1200 end",
+      data);
+  expected = makeFlatVector<int64_t>(
+      size,
+      [&](auto row) { return expectedValueAt(row).value_or(0); },
+      [&](auto row) { return !expectedValueAt(row).has_value(); });
+  assertEqualVectors(expected, result);
+}
+
 TEST_P(ParameterizedExprTest, ifWithConstant) {
   vector_size_t size = 4;
 
@@ -2155,6 +2236,112 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK(base.unique());
 }
 
+TEST_F(ExprTest, sharedMemo) {
+  // Verify that the results over a dictionary base are shared by ExprSets
+  // through the ExprResultCache and that only the rows not in the cache are
+  // evaluated.
+  auto base = makeArrayVector<int64_t>(
+      1'000,
+      [](auto row) { return row % 5 + 1; },
+      [](auto row, auto index) { return (row % 3) + index; });
+  auto evenIndices = makeIndices(100, [](auto row) { return 8 + row * 2; });
+  auto oddIndices = makeIndices(100, [](auto row) { return 9 + row * 2; });
+
+  exec::ExprResultCache cache(
+      rootPool_->addLeafChild("exprResultCache"), 1 << 20);
+  execCtx_->setExprResultCache(&cache);
+
+  auto rowType = ROW({"c0"}, {base->type()});
+  auto exprSet = compileExpression("c0[1] = 1", rowType);
+  auto otherExprSet = compileExpression("c0[1] = 1", rowType);
+
+  auto [result, stats] = evaluateWithStats(
+      exprSet.get(), makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  auto expectedResult = makeFlatVector<bool>(
+      100, [](auto row) { return (8 + row * 2) % 3 == 1; });
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["eq"].numProcessedRows, 100);
+  ASSERT_EQ(cache.stats().numHitRows, 0);
+  ASSERT_EQ(cache.stats().numMissRows, 100);
+  // The cache holds the base so that it is not reused in place for other
+  // values while its results are cached.
+  ASSERT_FALSE(base.unique());
+
+  // The other ExprSet finds all the rows in the cache.
+  std::tie(result, stats) = evaluateWithStats(
+      otherExprSet.get(),
+      makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["eq"].numProcessedRows, 0);
+  ASSERT_EQ(cache.stats().numHitRows, 100);
+
+  // Half of the rows are in the cache.
+  auto everyOther = makeIndices(100, [](auto row) { return 8 + row; });
+  std::tie(result, stats) = evaluateWithStats(
+      otherExprSet.get(),
+      makeRowVector({wrapInDictionary(everyOther, 100, base)}));
+  expectedResult =
+      makeFlatVector<bool>(100, [](auto row) { return (8 + row) % 3 == 1; });
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["eq"].numProcessedRows, 50);
+  ASSERT_EQ(cache.stats().numHitRows, 150);
+
+  // A new base does not hit the entries of the old one. The old base is held
+  // by the cache, so the new one can't be allocated at the same address.
+  base = makeArrayVector<int64_t>(
+      1'000,
+      [](auto row) { return row % 5 + 2; },
+      [](auto row, auto index) { return (row % 3) + index + 1; });
+  std::tie(result, stats) = evaluateWithStats(
+      exprSet.get(), makeRowVector({wrapInDictionary(oddIndices, 100, base)}));
+  expectedResult = makeFlatVector<bool>(
+      100, [](auto row) { return (9 + row * 2) % 3 + 1 == 1; });
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["eq"].numProcessedRows, 200);
+  ASSERT_EQ(cache.stats().numHitRows, 150);
+  ASSERT_GT(cache.bytes(), 0);
+  execCtx_->setExprResultCache(nullptr);
+}
+
+TEST_F(ExprTest, memoHitRowsStat) {
+  // Verify that the rows taken from the memoized results are reported as a
+  // runtime stat to the operator running the expression.
+  class TestRuntimeStatWriter : public BaseRuntimeStatWriter {
+   public:
+    void addRuntimeStat(const std::string& name, const RuntimeCounter& value)
+        override {
+      stats[name].addValue(value.value);
+    }
+
+    std::unordered_map<std::string, RuntimeMetric> stats;
+  };
+
+  TestRuntimeStatWriter writer;
+  RuntimeStatWriterScopeGuard guard(&writer);
+
+  auto base = makeFlatVector<std::string>(
+      1'000, [](auto row) { return fmt::format("{{\"a\": {}}}", row); });
+  auto indices = makeIndices(100, [](auto row) { return row * 3; });
+  auto halfIndices = makeIndices(100, [](auto row) { return row * 6; });
+  auto rowType = ROW({"c0"}, {VARCHAR()});
+  auto exprSet = compileExpression("length(c0)", rowType);
+
+  // The results are cached once the same base is seen twice.
+  for (auto i = 0; i < 2; ++i) {
+    evaluate(exprSet.get(), makeRowVector({wrapInDictionary(indices, base)}));
+  }
+  ASSERT_EQ(writer.stats.count(exec::Expr::kMemoHitRows), 0);
+
+  evaluate(exprSet.get(), makeRowVector({wrapInDictionary(indices, base)}));
+  ASSERT_EQ(writer.stats[exec::Expr::kMemoHitRows].sum, 100);
+
+  // Half of the rows are in the cache.
+  evaluate(
+      exprSet.get(), makeRowVector({wrapInDictionary(halfIndices, base)}));
+  ASSERT_EQ(writer.stats[exec::Expr::kMemoHitRows].sum, 150);
+  ASSERT_EQ(writer.stats[exec::Expr::kMemoHitRows].count, 2);
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -57,6 +57,12 @@ DEFINE_bool(avx2, true, "Enables use of AVX2 when available");
 
 DEFINE_bool(bmi2, true, "Enables use of BMI2 when available");
 
+DEFINE_bool(
+    avx512,
+    true,
+    "Enables use of the AVX-512 kernels that are selected at runtime when "
+    "available");
+
 // Used in exec/Expr.cpp
 
 DEFINE_string(
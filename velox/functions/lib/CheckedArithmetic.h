@@ -18,61 +18,114 @@
 #include <functional>
 #include <limits>
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/lib/CheckedArithmeticImpl.h"
 
 namespace facebook::velox::functions {
 
+// The functions below report errors through Status instead of throwing, so
+// that rows failing under TRY do not cost an exception each. Error details are
+// not formatted when the caller discards them.
+
 template <typename T>
 struct CheckedPlusFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedPlus(a, b);
+    if (UNLIKELY(__builtin_add_overflow(a, b, &result))) {
+      if (threadSkipErrorDetails()) {
+        return Status::ArithmeticError();
+      }
+      return Status::ArithmeticError("integer overflow: {} + {}", a, b);
+    }
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedMinusFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedMinus(a, b);
+    if (UNLIKELY(__builtin_sub_overflow(a, b, &result))) {
+      if (threadSkipErrorDetails()) {
+        return Status::ArithmeticError();
+      }
+      return Status::ArithmeticError("integer overflow: {} - {}", a, b);
+    }
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedMultiplyFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedMultiply(a, b);
+    if (UNLIKELY(__builtin_mul_overflow(a, b, &result))) {
+      if (threadSkipErrorDetails()) {
+        return Status::ArithmeticError();
+      }
+      return Status::ArithmeticError("integer overflow: {} * {}", a, b);
+    }
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedDivideFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedDivide(a, b);
+    if (UNLIKELY(b == 0)) {
+      if (threadSkipErrorDetails()) {
+        return Status::ArithmeticError();
+      }
+      return Status::ArithmeticError("division by zero");
+    }
+    // TInput can not represent abs(std::numeric_limits<TInput>::min()).
+    if constexpr (std::is_integral_v<TInput>) {
+      if (UNLIKELY(a == std::numeric_limits<TInput>::min() && b == -1)) {
+        if (threadSkipErrorDetails()) {
+          return Status::ArithmeticError();
+        }
+        return Status::ArithmeticError("integer overflow: {} / {}", a, b);
+      }
+    }
+    result = a / b;
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedModulusFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
+    if (UNLIKELY(b == 0)) {
+      if (threadSkipErrorDetails()) {
+        return Status::ArithmeticError();
+      }
+      return Status::ArithmeticError("Cannot divide by 0");
+    }
     result = checkedModulus(a, b);
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedNegateFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void call(TInput& result, const TInput& a) {
-    result = checkedNegate(a);
+  FOLLY_ALWAYS_INLINE Status call(TInput& result, const TInput& a) {
+    if (UNLIKELY(a == std::numeric_limits<TInput>::min())) {
+      if (threadSkipErrorDetails()) {
+        return Status::ArithmeticError();
+      }
+      return Status::ArithmeticError("Cannot negate minimum value");
+    }
+    result = std::negate<TInput>()(a);
+    return Status::OK();
   }
 };
 
@@ -1092,6 +1092,40 @@ int32_t DateTimeFormatter::format(
 
     offset = t.getSeconds() - utcSeconds;
   }
+  return formatLocal(
+      t, offset, timezone, maxResultSize, result, allowOverflow);
+}
+
+int32_t DateTimeFormatter::format(
+    const Timestamp& timestamp,
+    TimeZoneOffsetCache& timezoneCache,
+    const uint32_t maxResultSize,
+    char* result,
+    bool allowOverflow) const {
+  int64_t offset = 0;
+  Timestamp t = timestamp;
+  if (timezoneCache.zone() != nullptr) {
+    const auto localSeconds =
+        timezoneCache.toTimezone(timestamp, allowOverflow);
+    offset = localSeconds - timestamp.getSeconds();
+    t = Timestamp(localSeconds, timestamp.getNanos());
+  }
+  return formatLocal(
+      t,
+      offset,
+      timezoneCache.zone(),
+      maxResultSize,
+      result,
+      allowOverflow);
+}
+
+int32_t DateTimeFormatter::formatLocal(
+    const Timestamp& t,
+    int64_t offset,
+    const date::time_zone* timezone,
+    const uint32_t maxResultSize,
+    char* result,
+    bool allowOverflow) const {
   const auto timePoint = t.toTimePoint(allowOverflow);
   const auto daysTimePoint = date::floor<date::days>(timePoint);
 
@@ -196,7 +196,27 @@ class DateTimeFormatter {
       char* result,
       bool allowOverflow = false) const;
 
+  /// Same as above, but converts to the time zone of 'timezoneCache', which
+  /// skips the time zone lookup for timestamps near the previously formatted
+  /// one. Prefer this when formatting many timestamps in the same time zone.
+  int32_t format(
+      const Timestamp& timestamp,
+      TimeZoneOffsetCache& timezoneCache,
+      const uint32_t maxResultSize,
+      char* result,
+      bool allowOverflow = false) const;
+
  private:
+  // Formats 't', which is already converted to 'timezone' and is 'offset'
+  // seconds ahead of GMT.
+  int32_t formatLocal(
+      const Timestamp& t,
+      int64_t offset,
+      const date::time_zone* timezone,
+      const uint32_t maxResultSize,
+      char* result,
+      bool allowOverflow) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
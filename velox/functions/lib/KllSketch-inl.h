@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <queue>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -31,7 +33,11 @@ constexpr uint8_t kMaxLevel = 60;
 // serialization format changes, this needs to be increased and a new
 // deserializer should be added.  An adapter to convert serialization of
 // previous version to serialization of current version should also be added.
-constexpr int16_t kVersion = 1;
+//
+// Version 1 writes the fields and the item and level vectors as they are in
+// memory. Version 2 writes only the retained items, the level sizes instead of
+// the level offsets and encodes integers as varints.
+constexpr int16_t kVersion = 2;
 
 uint32_t computeTotalCapacity(uint32_t k, uint8_t numLevels);
 
@@ -253,18 +259,124 @@ void readRange(const char* data, size_t& offset, folly::Range<const T*>& out) {
   offset += bytes;
 }
 
+inline size_t varintSize(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+inline void writeVarint(uint64_t value, char* out, size_t& offset) {
+  while (value >= 0x80) {
+    out[offset++] = static_cast<char>(value | 0x80);
+    value >>= 7;
+  }
+  out[offset++] = static_cast<char>(value);
+}
+
+inline uint64_t readVarint(const char* data, size_t& offset) {
+  uint64_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    const auto byte = static_cast<uint8_t>(data[offset++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+}
+
+// Returns the zigzag encoded difference of integral 'value' to 'previous'.
+// The arithmetic wraps around, so any two values have a difference.
+template <typename T>
+uint64_t encodeDelta(T value, T previous) {
+  const auto delta = static_cast<uint64_t>(static_cast<int64_t>(value)) -
+      static_cast<uint64_t>(static_cast<int64_t>(previous));
+  return (delta << 1) ^
+      static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+}
+
+template <typename T>
+T decodeDelta(uint64_t encoded, T previous) {
+  const auto delta = (encoded >> 1) ^ (~(encoded & 1) + 1);
+  return static_cast<T>(static_cast<int64_t>(
+      static_cast<uint64_t>(static_cast<int64_t>(previous)) + delta));
+}
+
+template <typename T>
+size_t encodedItemsSize(const T* items, size_t count) {
+  if constexpr (std::is_integral_v<T>) {
+    size_t size = 0;
+    T previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+      size += varintSize(encodeDelta(items[i], previous));
+      previous = items[i];
+    }
+    return size;
+  } else {
+    return sizeof(T) * count;
+  }
+}
+
+template <typename T>
+void encodeItems(const T* items, size_t count, char* out, size_t& offset) {
+  if constexpr (std::is_integral_v<T>) {
+    T previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+      writeVarint(encodeDelta(items[i], previous), out, offset);
+      previous = items[i];
+    }
+  } else {
+    memcpy(out + offset, items, sizeof(T) * count);
+    offset += sizeof(T) * count;
+  }
+}
+
 template <typename T>
-void View<T>::deserialize(const char* data) {
+void decodeItems(const char* data, size_t& offset, size_t count, T* items) {
+  if constexpr (std::is_integral_v<T>) {
+    T previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+      items[i] = decodeDelta(readVarint(data, offset), previous);
+      previous = items[i];
+    }
+  } else {
+    memcpy(items, data + offset, sizeof(T) * count);
+    offset += sizeof(T) * count;
+  }
+}
+
+template <typename T>
+void View<T>::deserialize(const char* data, ViewBuffer<T>& buffer) {
   size_t i = 0;
   int16_t version;
   detail::read(data, i, version);
+  if (version == 1) {
+    detail::read(data, i, k);
+    detail::read(data, i, n);
+    detail::read(data, i, minValue);
+    detail::read(data, i, maxValue);
+    detail::readRange(data, i, items);
+    detail::readRange(data, i, levels);
+    return;
+  }
   VELOX_CHECK_EQ(version, detail::kVersion, "Unsupported version: {}", version);
-  detail::read(data, i, k);
-  detail::read(data, i, n);
+  k = readVarint(data, i);
+  n = readVarint(data, i);
   detail::read(data, i, minValue);
   detail::read(data, i, maxValue);
-  detail::readRange(data, i, items);
-  detail::readRange(data, i, levels);
+  uint8_t numLevels;
+  detail::read(data, i, numLevels);
+  buffer.levels.resize(numLevels + 1);
+  buffer.levels[0] = 0;
+  for (uint8_t level = 0; level < numLevels; ++level) {
+    buffer.levels[level + 1] = buffer.levels[level] + readVarint(data, i);
+  }
+  buffer.items.resize(buffer.levels.back());
+  decodeItems(data, i, buffer.items.size(), buffer.items.data());
+  items = {buffer.items.data(), buffer.items.size()};
+  levels = {buffer.levels.data(), buffer.levels.size()};
 }
 
 } // namespace detail
@@ -307,6 +419,22 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  T minValue = n_ == 0 ? values[0] : minValue_;
+  T maxValue = n_ == 0 ? values[0] : maxValue_;
+  for (auto value : values) {
+    minValue = std::min(minValue, value, C());
+    maxValue = std::max(maxValue, value, C());
+  }
+  minValue_ = minValue;
+  maxValue_ = maxValue;
+  doInsert(values.data(), values.size());
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -323,6 +451,41 @@ void KllSketch<T, A, C>::doInsert(T value) {
   isLevelZeroSorted_ = false;
 }
 
+// Produces the same sketch as calling doInsert(T) for each value. Instead of
+// one value at a time, copies as many values as there is free space for.
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::doInsert(const T* values, size_t count) {
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  if (count == 0) {
+    return;
+  }
+  // A compaction while inserting must sort level zero.
+  isLevelZeroSorted_ = false;
+  size_t i = 0;
+  while (i < count) {
+    if (items_.size() < k_ && numLevels() == 1) {
+      const auto numToAppend = std::min<size_t>(count - i, k_ - items_.size());
+      items_.insert(items_.end(), values + i, values + i + numToAppend);
+      levels_[1] += numToAppend;
+      i += numToAppend;
+    } else if (levels_[0] == 0) {
+      // Level zero is full, insertPosition() compacts.
+      items_[insertPosition()] = values[i++];
+    } else {
+      // Level zero grows downwards, so the values are stored in reverse.
+      const auto numToCopy = std::min<size_t>(count - i, levels_[0]);
+      std::reverse_copy(
+          values + i,
+          values + i + numToCopy,
+          items_.data() + levels_[0] - numToCopy);
+      levels_[0] -= numToCopy;
+      i += numToCopy;
+    }
+  }
+  n_ += count;
+}
+
 template <typename T, typename A, typename C>
 uint32_t KllSketch<T, A, C>::insertPosition() {
   if (levels_[0] == 0) {
@@ -612,9 +775,7 @@ void KllSketch<T, A, C>::mergeViews(
     if (other.n == 0) {
       continue;
     }
-    for (uint32_t j = other.levels[0]; j < other.levels[1]; ++j) {
-      doInsert(other.items[j]);
-    }
+    doInsert(other.items.data() + other.levels[0], other.safeLevelSize(0));
   }
   // Merge higher levels.
   auto tmpNumItems = getNumRetained();
@@ -639,36 +800,51 @@ void KllSketch<T, A, C>::mergeViews(
         items_.data() + levels_[0], items_.data() + levels_[1], workbuf.data());
     worklevels[1] = safeLevelSize(0);
     // Merge each level, each level in all sketches are already sorted.
+    using Entry = std::pair<const T*, const T*>;
+    using AllocEntry =
+        typename std::allocator_traits<A>::template rebind_alloc<Entry>;
     for (uint8_t lvl = 1; lvl < provisionalNumLevels; ++lvl) {
-      using Entry = std::pair<const T*, const T*>;
-      using AllocEntry =
-          typename std::allocator_traits<A>::template rebind_alloc<Entry>;
-      auto gt = [](const Entry& x, const Entry& y) {
-        return C()(*y.first, *x.first);
-      };
-      std::priority_queue<Entry, std::vector<Entry, AllocEntry>, decltype(gt)>
-          pq(gt, AllocEntry(allocator_));
+      std::vector<Entry, AllocEntry> runs{AllocEntry(allocator_)};
       if (auto sz = safeLevelSize(lvl); sz > 0) {
-        pq.emplace(
+        runs.emplace_back(
             items_.data() + levels_[lvl], items_.data() + levels_[lvl] + sz);
       }
       for (auto& other : others) {
         if (auto sz = other.safeLevelSize(lvl); sz > 0) {
-          pq.emplace(
-              &other.items[other.levels[lvl]],
-              &other.items[other.levels[lvl]] + sz);
+          runs.emplace_back(
+              other.items.data() + other.levels[lvl],
+              other.items.data() + other.levels[lvl] + sz);
         }
       }
-      int outIndex = worklevels[lvl];
-      while (!pq.empty()) {
-        auto [s, t] = pq.top();
-        pq.pop();
-        workbuf[outIndex++] = *s++;
-        if (s < t) {
-          pq.emplace(s, t);
+      T* out = workbuf.data() + worklevels[lvl];
+      if (runs.size() == 1) {
+        out = std::copy(runs[0].first, runs[0].second, out);
+      } else if (runs.size() == 2) {
+        // Merging one sketch into another is the common case and needs no
+        // heap.
+        out = std::merge(
+            runs[0].first,
+            runs[0].second,
+            runs[1].first,
+            runs[1].second,
+            out,
+            C());
+      } else if (!runs.empty()) {
+        auto gt = [](const Entry& x, const Entry& y) {
+          return C()(*y.first, *x.first);
+        };
+        std::priority_queue<Entry, std::vector<Entry, AllocEntry>, decltype(gt)>
+            pq(gt, std::move(runs));
+        while (!pq.empty()) {
+          auto [s, t] = pq.top();
+          pq.pop();
+          *out++ = *s++;
+          if (s < t) {
+            pq.emplace(s, t);
+          }
         }
       }
-      worklevels[lvl + 1] = outIndex;
+      worklevels[lvl + 1] = out - workbuf.data();
     }
     auto result = detail::generalCompress<T, C>(
         k_,
@@ -716,18 +892,20 @@ void KllSketch<T, A, C>::merge(const folly::Range<Iter>& others) {
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::mergeDeserialized(const char* data) {
   detail::View<T> view;
-  view.deserialize(data);
+  detail::ViewBuffer<T> buffer;
+  view.deserialize(data, buffer);
   return mergeViews(folly::Range(&view, 1));
 }
 
 template <typename T, typename A, typename C>
 template <typename Iter>
 void KllSketch<T, A, C>::mergeDeserialized(const folly::Range<Iter>& others) {
-  std::vector<detail::View<T>> views;
-  views.reserve(others.size());
+  std::vector<detail::View<T>> views(others.size());
+  std::vector<detail::ViewBuffer<T>> buffers(others.size());
+  size_t i = 0;
   for (auto& other : others) {
-    views.emplace_back();
-    views.back().deserialize(other);
+    views[i].deserialize(other, buffers[i]);
+    ++i;
   }
   mergeViews(views);
 }
@@ -765,10 +943,15 @@ KllSketch<T, A, C> KllSketch<T, A, C>::fromView(
 
 template <typename T, typename A, typename C>
 size_t KllSketch<T, A, C>::serializedByteSize() const {
-  size_t ans = sizeof detail::kVersion + sizeof k_ + sizeof n_;
+  size_t ans = sizeof detail::kVersion + detail::varintSize(k_) +
+      detail::varintSize(n_);
   ans += sizeof minValue_ + sizeof maxValue_;
-  ans += sizeof(size_t) + sizeof(T) * items_.size();
-  ans += sizeof(size_t) + sizeof(uint32_t) * levels_.size();
+  ans += sizeof(uint8_t);
+  for (uint8_t level = 0; level < numLevels(); ++level) {
+    ans += detail::varintSize(safeLevelSize(level));
+  }
+  ans += detail::encodedItemsSize(
+      items_.data() + levels_[0], getNumRetained());
   return ans;
 }
 
@@ -776,12 +959,15 @@ template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::serialize(char* out) const {
   size_t i = 0;
   detail::write(detail::kVersion, out, i);
-  detail::write(k_, out, i);
-  detail::write(n_, out, i);
+  detail::writeVarint(k_, out, i);
+  detail::writeVarint(n_, out, i);
   detail::write(minValue_, out, i);
   detail::write(maxValue_, out, i);
-  detail::writeVector(items_, out, i);
-  detail::writeVector(levels_, out, i);
+  detail::write(numLevels(), out, i);
+  for (uint8_t level = 0; level < numLevels(); ++level) {
+    detail::writeVarint(safeLevelSize(level), out, i);
+  }
+  detail::encodeItems(items_.data() + levels_[0], getNumRetained(), out, i);
   VELOX_DCHECK_EQ(i, serializedByteSize());
 }
 
@@ -791,7 +977,8 @@ KllSketch<T, A, C> KllSketch<T, A, C>::deserialize(
     const A& allocator,
     uint32_t seed) {
   detail::View<T> view;
-  view.deserialize(data);
+  detail::ViewBuffer<T> buffer;
+  view.deserialize(data, buffer);
   return fromView(view, allocator, seed);
 }
 
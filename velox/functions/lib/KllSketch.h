@@ -24,6 +24,10 @@
 
 namespace facebook::velox::functions::kll {
 namespace detail {
+/// Internal API, do not use outside Velox.
+template <typename T>
+struct ViewBuffer;
+
 /// Internal API, do not use outside Velox.
 template <typename T>
 struct View {
@@ -42,7 +46,17 @@ struct View {
     return level < numLevels() ? levels[level + 1] - levels[level] : 0;
   }
 
-  void deserialize(const char* FOLLY_NONNULL);
+  /// Reads a serialization made by KllSketch::serialize(). 'items' and
+  /// 'levels' point into 'data' for version 1 and into 'buffer' for later
+  /// versions, which are encoded. Both must outlive the view.
+  void deserialize(const char* FOLLY_NONNULL data, ViewBuffer<T>& buffer);
+};
+
+/// Internal API, do not use outside Velox.
+template <typename T>
+struct ViewBuffer {
+  std::vector<T> items;
+  std::vector<uint32_t> levels;
 };
 } // namespace detail
 
@@ -82,6 +96,10 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add the values in order. Same as calling insert(T) for each of them, but
+  /// faster.
+  void insert(folly::Range<const T*> values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -130,6 +148,11 @@ struct KllSketch {
   /// Serialize the sketch into bytes.  The serialzation is versioned, and newer
   /// version of code should be able to read all previous versions.
   ///
+  /// Only the retained items are written, without the free space of level
+  /// zero. The sizes of the levels and the items of integral types are
+  /// variable-length encoded, the latter as differences to the previous item,
+  /// which are small because the levels above zero are sorted.
+  ///
   /// @param out Pre-allocated memory at least serializedByteSize() in size
   void serialize(char* out) const;
 
@@ -175,6 +198,7 @@ struct KllSketch {
  private:
   KllSketch(const Allocator&, uint32_t seed);
   void doInsert(T);
+  void doInsert(const T* values, size_t count);
   uint32_t insertPosition();
   int findLevelToCompact() const;
   void addEmptyTopLevelToCompletelyFullSketch();
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+
+#include <re2/set.h>
+
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -645,9 +649,11 @@ bool matchSuffixPattern(
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return simd::simdStrstr(
+             input.data(),
+             input.size(),
+             fixedPattern.data(),
+             fixedPattern.size()) != std::string::npos;
 }
 
 // Return true if the input VARCHAR argument is all-ASCII for the specified
@@ -2311,4 +2317,383 @@ regexpReplaceWithLambdaSignatures() {
               .argumentType("function(array(varchar), varchar)")
               .build()};
 }
+
+namespace {
+
+// Searches a string for a constant list of patterns in a single pass with an
+// RE2::Set. If 'kFirst' is true, returns the 1-based position of the first
+// pattern that matches or 0, otherwise whether any pattern matches. Falls back
+// to matching the patterns one by one if the set cannot be compiled or runs
+// out of memory for its DFA.
+template <bool kFirst>
+class Re2SearchSet final : public exec::VectorFunction {
+ public:
+  using T = std::conditional_t<kFirst, int32_t, bool>;
+
+  explicit Re2SearchSet(std::vector<std::string> patterns)
+      : patterns_(std::move(patterns)),
+        set_(RE2::Options(RE2::Quiet), RE2::UNANCHORED) {
+    for (const auto& pattern : patterns_) {
+      std::string error;
+      VELOX_USER_CHECK_GE(
+          set_.Add(pattern, &error),
+          0,
+          "invalid regular expression:{}",
+          error);
+    }
+    setCompiled_ = set_.Compile();
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK_EQ(args.size(), 2);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    context.ensureWritable(rows, outputType, resultRef);
+    auto* result = resultRef->asUnchecked<FlatVector<T>>();
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+      result->set(row, match(toSearch->valueAt<StringView>(row)));
+    });
+  }
+
+ private:
+  T match(StringView str) const {
+    const auto text = toStringPiece(str);
+    if (setCompiled_) {
+      RE2::Set::ErrorInfo error;
+      if constexpr (kFirst) {
+        matches_.clear();
+        if (set_.Match(text, &matches_, &error)) {
+          return *std::min_element(matches_.begin(), matches_.end()) + 1;
+        }
+      } else {
+        if (set_.Match(text, nullptr, &error)) {
+          return true;
+        }
+      }
+      if (error.kind == RE2::Set::kNoError) {
+        return T{};
+      }
+    }
+    return matchOneByOne(text);
+  }
+
+  T matchOneByOne(const re2::StringPiece& text) const {
+    if (regexes_.empty()) {
+      for (const auto& pattern : patterns_) {
+        regexes_.push_back(std::make_unique<RE2>(pattern, RE2::Quiet));
+      }
+    }
+    for (auto i = 0; i < regexes_.size(); ++i) {
+      if (RE2::PartialMatch(text, *regexes_[i])) {
+        if constexpr (kFirst) {
+          return i + 1;
+        } else {
+          return true;
+        }
+      }
+    }
+    return T{};
+  }
+
+  const std::vector<std::string> patterns_;
+  RE2::Set set_;
+  bool setCompiled_;
+  mutable std::vector<int> matches_;
+  // Compiled on first use by matchOneByOne().
+  mutable std::vector<std::unique_ptr<RE2>> regexes_;
+};
+
+template <bool kFirst>
+std::shared_ptr<exec::VectorFunction> makeRe2SearchSet(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs) {
+  VELOX_CHECK_EQ(inputArgs.size(), 2);
+  const auto& patternsVector = inputArgs[1].constantValue;
+  VELOX_USER_CHECK_NOT_NULL(
+      patternsVector, "{} requires a constant array of patterns", name);
+  if (patternsVector->isNullAt(0)) {
+    // The result is null for all rows.
+    return std::make_shared<Re2SearchSet<kFirst>>(std::vector<std::string>{});
+  }
+  auto* patterns = patternsVector->wrappedVector()->as<ArrayVector>();
+  const auto index = patternsVector->wrappedIndex(0);
+  auto* elements = patterns->elements()->as<SimpleVector<StringView>>();
+
+  std::vector<std::string> patternStrings;
+  for (auto i = 0; i < patterns->sizeAt(index); ++i) {
+    const auto elementIndex = patterns->offsetAt(index) + i;
+    VELOX_USER_CHECK(
+        !elements->isNullAt(elementIndex), "{} patterns must not be null", name);
+    patternStrings.push_back(elements->valueAt(elementIndex));
+  }
+  return std::make_shared<Re2SearchSet<kFirst>>(std::move(patternStrings));
+}
+
+std::shared_ptr<exec::FunctionSignature> re2SearchSetSignature(
+    const std::string& returnType) {
+  return exec::FunctionSignatureBuilder()
+      .returnType(returnType)
+      .argumentType("varchar")
+      .constantArgumentType("array(varchar)")
+      .build();
+}
+
+const char* const kRegexpLikeAny = "$internal$regexp_like_any";
+const char* const kRegexpLikeFirst = "$internal$regexp_like_first";
+
+// Returns the value of 'expr' if it is a non-null VARCHAR constant.
+std::optional<std::string> toConstantString(const core::TypedExprPtr& expr) {
+  auto* constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || !constant->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    const auto& vector = constant->valueVector();
+    if (vector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    return std::string(vector->as<SimpleVector<StringView>>()->valueAt(0));
+  }
+  if (constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+// A regexp_like or like call with a constant valid pattern. 'pattern' is the
+// equivalent RE2 pattern for a substring search.
+struct SearchTerm {
+  core::TypedExprPtr input;
+  std::string pattern;
+};
+
+std::optional<SearchTerm> toSearchTerm(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->inputs().size() < 2 ||
+      !call->inputs()[0]->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  auto pattern = toConstantString(call->inputs()[1]);
+  if (!pattern.has_value()) {
+    return std::nullopt;
+  }
+
+  std::string regex;
+  if (call->name() == prefix + "regexp_like" && call->inputs().size() == 2) {
+    regex = std::move(pattern.value());
+  } else if (call->name() == prefix + "like" && call->inputs().size() <= 3) {
+    std::optional<char> escapeChar;
+    if (call->inputs().size() == 3) {
+      auto escape = toConstantString(call->inputs()[2]);
+      if (!escape.has_value() || escape->size() != 1) {
+        return std::nullopt;
+      }
+      escapeChar = escape.value()[0];
+    }
+    bool validPattern;
+    // LIKE matches the whole string and '%' and '_' match new lines, like in
+    // LikeWithRe2.
+    regex = fmt::format(
+        "(?s:{})",
+        likePatternToRe2(StringView(pattern.value()), escapeChar, validPattern));
+    if (!validPattern) {
+      return std::nullopt;
+    }
+  } else {
+    return std::nullopt;
+  }
+
+  if (!RE2(regex, RE2::Quiet).ok()) {
+    return std::nullopt;
+  }
+  return SearchTerm{call->inputs()[0], std::move(regex)};
+}
+
+core::TypedExprPtr makeSearchSetCall(
+    const std::string& name,
+    const TypePtr& type,
+    const core::TypedExprPtr& input,
+    const std::vector<std::string>& patterns) {
+  std::vector<variant> values;
+  values.reserve(patterns.size());
+  for (const auto& pattern : patterns) {
+    values.emplace_back(pattern);
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      type,
+      std::vector<core::TypedExprPtr>{
+          input,
+          std::make_shared<core::ConstantTypedExpr>(
+              ARRAY(VARCHAR()), variant::array(std::move(values)))},
+      name);
+}
+
+void collectDisjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& disjuncts) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      collectDisjuncts(input, disjuncts);
+    }
+    return;
+  }
+  disjuncts.push_back(expr);
+}
+
+// or(regexp_like(s, p1), x, like(s, p2)) =>
+// or(regexp_like_any(s, [p1, p2']), x)
+core::TypedExprPtr rewriteOr(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  std::vector<core::TypedExprPtr> disjuncts;
+  for (const auto& input : call.inputs()) {
+    collectDisjuncts(input, disjuncts);
+  }
+
+  struct Group {
+    core::TypedExprPtr input;
+    std::vector<std::string> patterns;
+  };
+  std::vector<Group> groups;
+  // The group of each disjunct or -1 if it is not a search term.
+  std::vector<int32_t> disjunctGroups;
+  for (const auto& disjunct : disjuncts) {
+    auto term = toSearchTerm(prefix, disjunct);
+    if (!term.has_value()) {
+      disjunctGroups.push_back(-1);
+      continue;
+    }
+    auto it = std::find_if(groups.begin(), groups.end(), [&](const auto& g) {
+      return *g.input == *term->input;
+    });
+    if (it == groups.end()) {
+      it = groups.insert(groups.end(), Group{term->input, {}});
+    }
+    it->patterns.push_back(std::move(term->pattern));
+    disjunctGroups.push_back(it - groups.begin());
+  }
+
+  std::vector<core::TypedExprPtr> newDisjuncts;
+  std::vector<bool> groupAdded(groups.size(), false);
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    const auto group = disjunctGroups[i];
+    if (group < 0 || groups[group].patterns.size() < 2) {
+      newDisjuncts.push_back(disjuncts[i]);
+    } else if (!groupAdded[group]) {
+      newDisjuncts.push_back(makeSearchSetCall(
+          prefix + kRegexpLikeAny,
+          BOOLEAN(),
+          groups[group].input,
+          groups[group].patterns));
+      groupAdded[group] = true;
+    }
+  }
+  if (newDisjuncts.size() == disjuncts.size()) {
+    return nullptr;
+  }
+  if (newDisjuncts.size() == 1) {
+    return newDisjuncts[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newDisjuncts), "or");
+}
+
+// switch(regexp_like(s, p1), v1, like(s, p2), v2, ...) =>
+// switch(eq(f, 1), v1, eq(f, 2), v2, ...) with f = regexp_like_first(s, [p1,
+// p2']). A condition is only evaluated on the rows for which the previous ones
+// are not true, so f = k there if and only if pattern k matches.
+core::TypedExprPtr rewriteSwitch(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  const auto& inputs = call.inputs();
+  const auto numConditions = inputs.size() / 2;
+  auto newInputs = inputs;
+  bool rewritten = false;
+  for (auto i = 0; i < numConditions;) {
+    auto term = toSearchTerm(prefix, inputs[2 * i]);
+    if (!term.has_value()) {
+      ++i;
+      continue;
+    }
+    std::vector<std::string> patterns{std::move(term->pattern)};
+    auto end = i + 1;
+    for (; end < numConditions; ++end) {
+      auto next = toSearchTerm(prefix, inputs[2 * end]);
+      if (!next.has_value() || !(*next->input == *term->input)) {
+        break;
+      }
+      patterns.push_back(std::move(next->pattern));
+    }
+    if (patterns.size() >= 2) {
+      auto first = makeSearchSetCall(
+          prefix + kRegexpLikeFirst, INTEGER(), term->input, patterns);
+      for (auto j = i; j < end; ++j) {
+        newInputs[2 * j] = std::make_shared<core::CallTypedExpr>(
+            BOOLEAN(),
+            std::vector<core::TypedExprPtr>{
+                first,
+                std::make_shared<core::ConstantTypedExpr>(
+                    INTEGER(), variant(static_cast<int32_t>(j - i + 1)))},
+            prefix + "eq");
+      }
+      rewritten = true;
+    }
+    i = end;
+  }
+  if (!rewritten) {
+    return nullptr;
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      call.type(), std::move(newInputs), call.name());
+}
+
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  return makeRe2SearchSet<false>(name, inputArgs);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures() {
+  // varchar, constant array(varchar) -> boolean
+  return {re2SearchSetSignature("boolean")};
+}
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchFirst(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  return makeRe2SearchSet<true>(name, inputArgs);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+re2SearchFirstSignatures() {
+  // varchar, constant array(varchar) -> integer
+  return {re2SearchSetSignature("integer")};
+}
+
+core::TypedExprPtr rewriteRegexpLikeChain(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return nullptr;
+  }
+  if (call->name() == "or") {
+    return rewriteOr(prefix, *call);
+  }
+  if (call->name() == "switch") {
+    return rewriteSwitch(prefix, *call);
+  }
+  return nullptr;
+}
 } // namespace facebook::velox::functions
@@ -237,6 +237,47 @@ std::shared_ptr<exec::VectorFunction> makeRe2ExtractAll(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2ExtractAllSignatures();
 
+/// re2SearchAny(string, patterns) → boolean
+///
+/// Returns whether any of the constant array of RE2 'patterns' matches a
+/// substring of 'string'. All the patterns are matched in a single pass over
+/// the string with an RE2::Set.
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures();
+
+/// re2SearchFirst(string, patterns) → integer
+///
+/// Returns the 1-based position in the constant array of RE2 'patterns' of the
+/// first pattern that matches a substring of 'string', or 0 if none does. All
+/// the patterns are matched in a single pass over the string with an RE2::Set.
+std::shared_ptr<exec::VectorFunction> makeRe2SearchFirst(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+re2SearchFirstSignatures();
+
+/// Rewrites chains of regexp_like and like calls with constant patterns on the
+/// same input into a single multi-pattern search. 'prefix' is the prefix of
+/// the function names. Returns nullptr if 'expr' has no such chain.
+///
+/// An OR of two or more such calls on the same string becomes a call to
+/// $internal$regexp_like_any, which returns whether any pattern matches. In a
+/// CASE, consecutive WHEN conditions that are such calls on the same string
+/// become comparisons of a shared call to $internal$regexp_like_first with the
+/// position of the condition. The shared call is evaluated once per row, so
+/// each string is scanned once instead of once per pattern. LIKE patterns are
+/// translated to equivalent RE2 patterns. Calls whose patterns are not valid
+/// are left alone so that they fail as before.
+core::TypedExprPtr rewriteRegexpLikeChain(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
 namespace detail {
 
 // A cache of compiled regular expressions (RE2 instances). Allows up to
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+
+#include "velox/type/FloatingPointUtil.h"
+
+namespace facebook::velox::functions {
+
+/// A set of scalar values for deduplicating the elements of one array at a
+/// time. The first kMaxLinearSize distinct values are kept in an inline array
+/// and looked up with a linear scan, which is faster than hashing for the
+/// short arrays that make up most inputs. Further values go to a hash set.
+/// Meant to be reused across the rows of a batch: clear() keeps the memory of
+/// the hash set and costs nothing if the hash set was not used. NaNs are equal
+/// to each other, as in HashSetNaNAware.
+template <typename T>
+class SmallValueSet {
+ public:
+  static constexpr int32_t kMaxLinearSize = 16;
+
+  /// Adds 'value' to the set. Returns true if it was not in the set.
+  bool insert(const T& value) {
+    if (containsLinear(value)) {
+      return false;
+    }
+    if (numLinear_ < kMaxLinearSize) {
+      linear_[numLinear_++] = value;
+      return true;
+    }
+    return hashed_.insert(value).second;
+  }
+
+  bool contains(const T& value) const {
+    return containsLinear(value) ||
+        (numLinear_ == kMaxLinearSize && hashed_.contains(value));
+  }
+
+  bool empty() const {
+    return numLinear_ == 0;
+  }
+
+  void clear() {
+    if (numLinear_ == kMaxLinearSize) {
+      hashed_.clear();
+    }
+    numLinear_ = 0;
+  }
+
+ private:
+  static bool equals(const T& left, const T& right) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return util::floating_point::NaNAwareEquals<T>{}(left, right);
+    } else {
+      return left == right;
+    }
+  }
+
+  bool containsLinear(const T& value) const {
+    for (auto i = 0; i < numLinear_; ++i) {
+      if (equals(linear_[i], value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::array<T, kMaxLinearSize> linear_;
+  int32_t numLinear_{0};
+
+  // Values after the first kMaxLinearSize. Only used when 'linear_' is full.
+  util::floating_point::HashSetNaNAware<T> hashed_;
+};
+
+} // namespace facebook::velox::functions
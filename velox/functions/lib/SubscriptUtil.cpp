@@ -19,6 +19,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/MemoryPool.h"
 #include "velox/functions/lib/SubscriptUtil.h"
 #include "velox/type/Type.h"
@@ -37,6 +38,31 @@ inline bool isPrimitiveEqual(const T& lhs, const T& rhs) {
   }
 }
 
+// Returns the index of the first of 'size' 'values' that is equal to 'key' or
+// -1 if there is none. Compares a SIMD batch of values at a time.
+template <typename T>
+vector_size_t findKey(const T* values, vector_size_t size, T key) {
+  using Batch = xsimd::batch<T>;
+  constexpr vector_size_t kBatchSize = Batch::size;
+  vector_size_t i = 0;
+  if (size >= kBatchSize) {
+    const auto target = Batch::broadcast(key);
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      const auto mask =
+          simd::toBitMask(Batch::load_unaligned(values + i) == target);
+      if (mask != 0) {
+        return i + __builtin_ctz(mask);
+      }
+    }
+  }
+  for (; i < size; ++i) {
+    if (values[i] == key) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 template <TypeKind Kind>
 struct SimpleType {
   using type = typename TypeTraits<Kind>::NativeType;
@@ -97,6 +123,15 @@ VectorPtr applyMapTyped(
   exec::LocalDecodedVector mapKeysHolder(context, *mapKeys, *allElementRows);
   auto decodedMapKeys = mapKeysHolder.get();
 
+  // Flat integer keys are searched with SIMD.
+  const TKey* rawMapKeys = nullptr;
+  if constexpr (
+      std::is_same_v<TKey, int32_t> || std::is_same_v<TKey, int64_t>) {
+    if (decodedMapKeys->isIdentityMapping()) {
+      rawMapKeys = decodedMapKeys->data<TKey>();
+    }
+  }
+
   // Get index vector (second argument).
   exec::LocalDecodedVector indexHolder(context, *indexArg, rows);
   auto decodedIndices = indexHolder.get();
@@ -134,6 +169,12 @@ VectorPtr applyMapTyped(
         found = true;
       }
 
+    } else if (rawMapKeys != nullptr) {
+      const auto index = findKey(rawMapKeys + offsetStart, size, searchKey);
+      if (index >= 0) {
+        rawIndices[row] = offsetStart + index;
+        found = true;
+      }
     } else {
       // Search map without caching.
       for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
@@ -300,6 +341,144 @@ VectorPtr applyMapComplexType(
       nullsBuilder.build(), indices, rows.end(), baseMap->mapValues());
 }
 
+// map_subscript_batch(map, ARRAY[k1, ..., kn]) for primitive keys. Returns a
+// ROW whose field i is the value of key ki. Reads the keys of each map once and
+// looks each of them up in a hash table of the n constant keys, instead of
+// searching each map n times.
+template <TypeKind kind>
+class MapSubscriptBatchFunction : public exec::VectorFunction {
+  using TKey = typename TypeTraits<kind>::NativeType;
+
+ public:
+  explicit MapSubscriptBatchFunction(VectorPtr keys) : keys_(std::move(keys)) {
+    auto* array = keys_->wrappedVector()->as<ArrayVector>();
+    const auto index = keys_->wrappedIndex(0);
+    auto* elements = array->elements()->as<SimpleVector<TKey>>();
+    numKeys_ = array->sizeAt(index);
+    for (auto i = 0; i < numKeys_; ++i) {
+      const auto offset = array->offsetAt(index) + i;
+      VELOX_USER_CHECK(
+          !elements->isNullAt(offset), "Map subscript keys must not be null");
+      VELOX_USER_CHECK(
+          keyToField_.emplace(elements->valueAt(offset), i).second,
+          "Map subscript keys must be distinct");
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(outputType->size(), numKeys_);
+    auto* pool = context.pool();
+
+    exec::LocalDecodedVector mapHolder(context, *args[0], rows);
+    auto* decodedMap = mapHolder.get();
+    auto* baseMap = decodedMap->base()->as<MapVector>();
+    auto* mapIndices = decodedMap->indices();
+    auto* rawSizes = baseMap->rawSizes();
+    auto* rawOffsets = baseMap->rawOffsets();
+
+    const auto& mapKeys = baseMap->mapKeys();
+    exec::LocalSelectivityVector allElementRows(context, mapKeys->size());
+    allElementRows->setAll();
+    exec::LocalDecodedVector mapKeysHolder(context, *mapKeys, *allElementRows);
+    auto* decodedMapKeys = mapKeysHolder.get();
+
+    // Field i of a row is null until key i is found in the map of the row.
+    std::vector<BufferPtr> nulls(numKeys_);
+    std::vector<BufferPtr> indices(numKeys_);
+    std::vector<uint64_t*> rawNulls(numKeys_);
+    std::vector<vector_size_t*> rawIndices(numKeys_);
+    for (auto i = 0; i < numKeys_; ++i) {
+      nulls[i] = allocateNulls(rows.end(), pool, bits::kNull);
+      rawNulls[i] = nulls[i]->asMutable<uint64_t>();
+      indices[i] = allocateIndices(rows.end(), pool);
+      rawIndices[i] = indices[i]->asMutable<vector_size_t>();
+    }
+
+    rows.applyToSelected([&](vector_size_t row) {
+      if (decodedMap->isNullAt(row)) {
+        return;
+      }
+      const auto mapIndex = mapIndices[row];
+      const auto offsetStart = rawOffsets[mapIndex];
+      const auto offsetEnd = offsetStart + rawSizes[mapIndex];
+      int32_t numFound = 0;
+      for (auto offset = offsetStart;
+           offset < offsetEnd && numFound < numKeys_;
+           ++offset) {
+        auto it = keyToField_.find(decodedMapKeys->valueAt<TKey>(offset));
+        if (it != keyToField_.end() &&
+            bits::isBitNull(rawNulls[it->second], row)) {
+          bits::setNull(rawNulls[it->second], row, false);
+          rawIndices[it->second][row] = offset;
+          ++numFound;
+        }
+      }
+    });
+
+    const auto& mapValues = baseMap->mapValues();
+    std::vector<VectorPtr> children(numKeys_);
+    for (auto i = 0; i < numKeys_; ++i) {
+      // Subscript into empty maps always returns NULLs.
+      children[i] = mapValues->size() == 0
+          ? BaseVector::createNullConstant(mapValues->type(), rows.end(), pool)
+          : BaseVector::wrapInDictionary(
+                nulls[i], indices[i], rows.end(), mapValues);
+    }
+    auto localResult = std::make_shared<RowVector>(
+        pool, outputType, nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  // The constant array of keys. Keeps the string keys in 'keyToField_' alive.
+  const VectorPtr keys_;
+  int32_t numKeys_;
+  // Key -> index of the result field for the key.
+  typename util::floating_point::
+      HashMapNaNAwareTypeTraits<TKey, int32_t>::Type keyToField_;
+};
+
+template <TypeKind kind>
+std::shared_ptr<exec::VectorFunction> makeMapSubscriptBatchTyped(
+    const VectorPtr& keys) {
+  return std::make_shared<MapSubscriptBatchFunction<kind>>(keys);
+}
+
+std::shared_ptr<exec::VectorFunction> makeMapSubscriptBatch(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_EQ(inputArgs.size(), 2);
+  const auto& keys = inputArgs[1].constantValue;
+  VELOX_USER_CHECK_NOT_NULL(keys, "{} requires a constant array of keys", name);
+  const auto& keyType = inputArgs[0].type->childAt(0);
+  VELOX_USER_CHECK(
+      keyType->isPrimitiveType(),
+      "{} requires map keys of a primitive type: {}",
+      name,
+      keyType->toString());
+  return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      makeMapSubscriptBatchTyped, keyType->kind(), keys);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+mapSubscriptBatchSignatures() {
+  // map(K, V), array(K) -> row(V, ...)
+  // The result has one field per key.
+  return {exec::FunctionSignatureBuilder()
+              .typeVariable("K")
+              .typeVariable("V")
+              .returnType("row(V)")
+              .argumentType("map(K,V)")
+              .constantArgumentType("array(K)")
+              .build()};
+}
+
 } // namespace
 
 VectorPtr MapSubscript::applyMap(
@@ -355,6 +534,16 @@ std::exception_ptr makeNegativeSubscriptError() {
 }
 } // namespace
 
+void registerMapSubscriptBatchFunction(const std::string& name) {
+  // Not default null behavior, as the result for a null map is a ROW of nulls,
+  // not a null ROW.
+  exec::registerStatefulVectorFunction(
+      name,
+      mapSubscriptBatchSignatures(),
+      makeMapSubscriptBatch,
+      exec::VectorFunctionMetadataBuilder().defaultNullBehavior(false).build());
+}
+
 const std::exception_ptr& zeroSubscriptError() {
   static std::exception_ptr error = makeZeroSubscriptError();
   return error;
@@ -36,6 +36,13 @@ const std::exception_ptr& zeroSubscriptError();
 const std::exception_ptr& badSubscriptError();
 const std::exception_ptr& negativeSubscriptError();
 
+/// Registers 'name'(map(K, V), ARRAY[k1, ..., kn]) for primitive K. It returns
+/// a ROW whose field i is the value of key ki in the map, or null if the map is
+/// null or does not have ki. The keys of each map are read once for all n keys.
+/// This is the batched form of map subscripts with constant keys, see
+/// exec::registerBatchableFunction.
+void registerMapSubscriptBatchFunction(const std::string& name);
+
 template <TypeKind kind>
 class LookupTable;
 
@@ -47,9 +47,19 @@ getSeconds(Timestamp timestamp, const date::time_zone* timeZone) {
   }
 }
 
+/// Same as above, but converts through 'timeZoneCache', which skips the time
+/// zone lookup for timestamps near the previously converted one.
+FOLLY_ALWAYS_INLINE int64_t
+getSeconds(Timestamp timestamp, TimeZoneOffsetCache& timeZoneCache) {
+  if (timeZoneCache.zone() != nullptr) {
+    return timeZoneCache.toTimezone(timestamp);
+  } else {
+    return timestamp.getSeconds();
+  }
+}
+
 FOLLY_ALWAYS_INLINE
-std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
-  int64_t seconds = getSeconds(timestamp, timeZone);
+std::tm getDateTimeFromSeconds(int64_t seconds) {
   std::tm dateTime;
   VELOX_USER_CHECK(
       Timestamp::epochToCalendarUtc(seconds, dateTime),
@@ -58,6 +68,16 @@ std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
   return dateTime;
 }
 
+FOLLY_ALWAYS_INLINE
+std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
+  return getDateTimeFromSeconds(getSeconds(timestamp, timeZone));
+}
+
+FOLLY_ALWAYS_INLINE
+std::tm getDateTime(Timestamp timestamp, TimeZoneOffsetCache& timeZoneCache) {
+  return getDateTimeFromSeconds(getSeconds(timestamp, timeZoneCache));
+}
+
 // days is the number of days since Epoch.
 FOLLY_ALWAYS_INLINE
 std::tm getDateTime(int32_t days) {
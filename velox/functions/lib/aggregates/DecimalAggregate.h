@@ -138,10 +138,8 @@ class DecimalAggregate : public exec::Aggregate {
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      accumulator.overflow = sumWithOverflow(
+          accumulator.sum, rows, [&](vector_size_t i) { return data[i]; });
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
@@ -150,12 +148,10 @@ class DecimalAggregate : public exec::Aggregate {
       mergeAccumulators<false>(group, serialized);
     } else {
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum,
-            decodedRaw_.valueAt<TInputType>(i),
-            accumulator.sum);
-      });
+      accumulator.overflow =
+          sumWithOverflow(accumulator.sum, rows, [&](vector_size_t i) {
+            return decodedRaw_.valueAt<TInputType>(i);
+          });
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
@@ -332,6 +328,24 @@ class DecimalAggregate : public exec::Aggregate {
     return exec::Aggregate::value<LongDecimalWithOverflowState>(group);
   }
 
+  // Sums the values returned by 'getValue' for 'rows' into 'sum' and returns
+  // the overflow. Adds up the 64 bit halves of the values separately and
+  // checks for overflow once at the end instead of once per value.
+  template <typename GetValue>
+  static int64_t sumWithOverflow(
+      int128_t& sum,
+      const SelectivityVector& rows,
+      GetValue getValue) {
+    int128_t upperSum = 0;
+    __uint128_t lowerSum = 0;
+    rows.applyToSelected([&](vector_size_t i) {
+      const int128_t value = getValue(i);
+      upperSum += static_cast<int64_t>(HugeInt::upper(value));
+      lowerSum += HugeInt::lower(value);
+    });
+    return DecimalUtil::combineHalfSums(sum, upperSum, lowerSum);
+  }
+
   DecodedVector decodedRaw_;
   DecodedVector decodedPartial_;
 };
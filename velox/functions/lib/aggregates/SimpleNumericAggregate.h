@@ -120,24 +120,69 @@ class SimpleNumericAggregate : public exec::Aggregate {
         });
       }
     } else if (decoded.mayHaveNulls()) {
-      rows.applyToSelected([&](vector_size_t i) {
-        if (decoded.isNullAt(i)) {
-          return;
-        }
-        updateNonNullValue<tableHasNulls, TData>(
-            groups[i], TData(decoded.valueAt<TValue>(i)), updateSingleValue);
-      });
+      updateGroupRuns<tableHasNulls, TData>(
+          groups,
+          rows,
+          [&](vector_size_t i) { return !decoded.isNullAt(i); },
+          [&](vector_size_t i) { return TData(decoded.valueAt<TValue>(i)); },
+          updateSingleValue);
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
-      rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<tableHasNulls, TData>(
-            groups[i], TData(data[i]), updateSingleValue);
-      });
+      updateGroupRuns<tableHasNulls, TData>(
+          groups,
+          rows,
+          [](vector_size_t /*i*/) { return true; },
+          [&](vector_size_t i) { return TData(data[i]); },
+          updateSingleValue);
     } else {
-      rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<tableHasNulls, TData>(
-            groups[i], TData(decoded.valueAt<TValue>(i)), updateSingleValue);
-      });
+      updateGroupRuns<tableHasNulls, TData>(
+          groups,
+          rows,
+          [](vector_size_t /*i*/) { return true; },
+          [&](vector_size_t i) { return TData(decoded.valueAt<TValue>(i)); },
+          updateSingleValue);
+    }
+  }
+
+  // Updates the accumulator of 'groups[i]' with 'valueAt(i)' for the selected
+  // rows for which 'hasValue(i)' is true. The accumulator is loaded into a
+  // local when the group changes and is stored back at the end of the run, so
+  // that consecutive rows of the same group, e.g. from input that is sorted
+  // or clustered on the grouping keys, update a register instead of doing a
+  // read-modify-write of the row for each value. The updates are applied in
+  // the same order as row by row.
+  template <
+      bool tableHasNulls,
+      typename TData,
+      typename HasValue,
+      typename ValueAt,
+      typename UpdateSingleValue>
+  void updateGroupRuns(
+      char** groups,
+      const SelectivityVector& rows,
+      HasValue hasValue,
+      ValueAt valueAt,
+      UpdateSingleValue updateSingleValue) {
+    char* group = nullptr;
+    TData accumulator{};
+    rows.applyToSelected([&](vector_size_t i) {
+      if (!hasValue(i)) {
+        return;
+      }
+      if (groups[i] != group) {
+        if (group) {
+          *exec::Aggregate::value<TData>(group) = accumulator;
+        }
+        group = groups[i];
+        if constexpr (tableHasNulls) {
+          exec::Aggregate::clearNull(group);
+        }
+        accumulator = *exec::Aggregate::value<TData>(group);
+      }
+      updateSingleValue(accumulator, valueAt(i));
+    });
+    if (group) {
+      *exec::Aggregate::value<TData>(group) = accumulator;
     }
   }
 
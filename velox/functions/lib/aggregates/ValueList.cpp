@@ -88,11 +88,105 @@ void ValueList::appendValue(
   }
 }
 
+template <typename T>
+void ValueList::appendFixedWidthRange(
+    const FlatVector<T>& vector,
+    vector_size_t offset,
+    vector_size_t size,
+    HashStringAllocator* allocator) {
+  const auto* rawValues = vector.rawValues();
+  const auto* rawNulls = vector.rawNulls();
+  auto isNull = [&](vector_size_t index) {
+    return rawNulls && bits::isBitNull(rawNulls, index);
+  };
+  const auto end = offset + size;
+  while (offset < end) {
+    prepareAppend(allocator);
+    // The values up to the next word of null flags.
+    const auto numValues =
+        std::min<vector_size_t>(end - offset, 64 - size_ % 64);
+    const auto last = offset + numValues;
+    ByteOutputStream stream(allocator);
+    allocator->extendWrite(dataCurrent_, stream);
+    const auto initialSize = stream.size();
+    for (auto index = offset; index < last;) {
+      if (isNull(index)) {
+        lastNulls_ |= 1UL << ((size_ + index - offset) % 64);
+        ++index;
+        continue;
+      }
+      auto runEnd = index + 1;
+      while (runEnd < last && !isNull(runEnd)) {
+        ++runEnd;
+      }
+      stream.append(folly::Range<const T*>(rawValues + index, runEnd - index));
+      index = runEnd;
+    }
+    size_ += numValues;
+    bytes_ += stream.size() - initialSize;
+    dataCurrent_ =
+        allocator->finishWrite(stream, std::clamp(bytes_ / 2, 24, 1024))
+            .second;
+    offset = last;
+  }
+}
+
 void ValueList::appendRange(
     const VectorPtr& vector,
     vector_size_t offset,
     vector_size_t size,
     HashStringAllocator* allocator) {
+  if (vector->encoding() == VectorEncoding::Simple::FLAT) {
+    switch (vector->typeKind()) {
+      case TypeKind::TINYINT:
+        return appendFixedWidthRange(
+            *vector->asUnchecked<FlatVector<int8_t>>(),
+            offset,
+            size,
+            allocator);
+      case TypeKind::SMALLINT:
+        return appendFixedWidthRange(
+            *vector->asUnchecked<FlatVector<int16_t>>(),
+            offset,
+            size,
+            allocator);
+      case TypeKind::INTEGER:
+        return appendFixedWidthRange(
+            *vector->asUnchecked<FlatVector<int32_t>>(),
+            offset,
+            size,
+            allocator);
+      case TypeKind::BIGINT:
+        return appendFixedWidthRange(
+            *vector->asUnchecked<FlatVector<int64_t>>(),
+            offset,
+            size,
+            allocator);
+      case TypeKind::HUGEINT:
+        return appendFixedWidthRange(
+            *vector->asUnchecked<FlatVector<int128_t>>(),
+            offset,
+            size,
+            allocator);
+      case TypeKind::REAL:
+        return appendFixedWidthRange(
+            *vector->asUnchecked<FlatVector<float>>(), offset, size, allocator);
+      case TypeKind::DOUBLE:
+        return appendFixedWidthRange(
+            *vector->asUnchecked<FlatVector<double>>(),
+            offset,
+            size,
+            allocator);
+      case TypeKind::TIMESTAMP:
+        return appendFixedWidthRange(
+            *vector->asUnchecked<FlatVector<Timestamp>>(),
+            offset,
+            size,
+            allocator);
+      default:
+        break;
+    }
+  }
   for (auto index = offset; index < offset + size; ++index) {
     if (vector->isNullAt(index)) {
       appendNull(allocator);
@@ -110,11 +204,7 @@ ValueListReader::ValueListReader(ValueList& values)
       nullsStream_{HashStringAllocator::prepareRead(values.nullsBegin())} {}
 
 bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
-  if (pos_ == lastNullsStart_) {
-    nulls_ = lastNulls_;
-  } else if (pos_ % 64 == 0) {
-    nulls_ = nullsStream_.read<uint64_t>();
-  }
+  loadNulls();
 
   if (nulls_ & (1UL << (pos_ % 64))) {
     output.setNull(outputIndex, true);
@@ -125,4 +215,90 @@ bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
   pos_++;
   return pos_ < size_;
 }
+
+template <typename T>
+void ValueListReader::nextFixedWidth(
+    FlatVector<T>& output,
+    vector_size_t outputIndex,
+    vector_size_t numValues) {
+  auto* rawValues = output.mutableRawValues();
+  const auto end = pos_ + numValues;
+  while (pos_ < end) {
+    loadNulls();
+    // The values up to the next word of null flags.
+    const auto count = std::min<vector_size_t>(end - pos_, 64 - pos_ % 64);
+    const auto firstBit = pos_ % 64;
+    auto isNull = [&](vector_size_t i) {
+      return (nulls_ & (1UL << (firstBit + i))) != 0;
+    };
+    for (auto i = 0; i < count;) {
+      if (isNull(i)) {
+        output.setNull(outputIndex + i, true);
+        ++i;
+        continue;
+      }
+      auto runEnd = i + 1;
+      while (runEnd < count && !isNull(runEnd)) {
+        ++runEnd;
+      }
+      dataStream_.readBytes(
+          reinterpret_cast<uint8_t*>(rawValues + outputIndex + i),
+          static_cast<int32_t>((runEnd - i) * sizeof(T)));
+      if (output.rawNulls()) {
+        bits::fillBits(
+            output.mutableRawNulls(),
+            outputIndex + i,
+            outputIndex + runEnd,
+            bits::kNotNull);
+      }
+      i = runEnd;
+    }
+    pos_ += count;
+    outputIndex += count;
+  }
+}
+
+void ValueListReader::next(
+    BaseVector& output,
+    vector_size_t outputIndex,
+    vector_size_t numValues) {
+  VELOX_CHECK_LE(pos_ + numValues, size_);
+  if (output.encoding() == VectorEncoding::Simple::FLAT) {
+    switch (output.typeKind()) {
+      case TypeKind::TINYINT:
+        return nextFixedWidth(
+            *output.asUnchecked<FlatVector<int8_t>>(), outputIndex, numValues);
+      case TypeKind::SMALLINT:
+        return nextFixedWidth(
+            *output.asUnchecked<FlatVector<int16_t>>(), outputIndex, numValues);
+      case TypeKind::INTEGER:
+        return nextFixedWidth(
+            *output.asUnchecked<FlatVector<int32_t>>(), outputIndex, numValues);
+      case TypeKind::BIGINT:
+        return nextFixedWidth(
+            *output.asUnchecked<FlatVector<int64_t>>(), outputIndex, numValues);
+      case TypeKind::HUGEINT:
+        return nextFixedWidth(
+            *output.asUnchecked<FlatVector<int128_t>>(),
+            outputIndex,
+            numValues);
+      case TypeKind::REAL:
+        return nextFixedWidth(
+            *output.asUnchecked<FlatVector<float>>(), outputIndex, numValues);
+      case TypeKind::DOUBLE:
+        return nextFixedWidth(
+            *output.asUnchecked<FlatVector<double>>(), outputIndex, numValues);
+      case TypeKind::TIMESTAMP:
+        return nextFixedWidth(
+            *output.asUnchecked<FlatVector<Timestamp>>(),
+            outputIndex,
+            numValues);
+      default:
+        break;
+    }
+  }
+  for (auto i = 0; i < numValues; ++i) {
+    next(output, outputIndex + i);
+  }
+}
 } // namespace facebook::velox::aggregate
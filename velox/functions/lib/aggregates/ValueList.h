@@ -47,6 +47,9 @@ class ValueList {
     }
   }
 
+  /// Appends the 'size' values of 'vector' starting at 'offset'. The values
+  /// of a flat vector of a fixed-width type other than boolean are copied in
+  /// runs of non-null values instead of one at a time.
   void appendRange(
       const VectorPtr& vector,
       vector_size_t offset,
@@ -93,6 +96,15 @@ class ValueList {
       vector_size_t index,
       HashStringAllocator* allocator);
 
+  // Appends the values of 'vector' in [offset, offset + size). The values are
+  // laid out as ContainerRowSerde would serialize them one at a time.
+  template <typename T>
+  void appendFixedWidthRange(
+      const FlatVector<T>& vector,
+      vector_size_t offset,
+      vector_size_t size,
+      HashStringAllocator* allocator);
+
   void prepareAppend(HashStringAllocator* allocator);
 
   // Writes lastNulls_ word to the 'nulls' block.
@@ -123,7 +135,32 @@ class ValueListReader {
 
   bool next(BaseVector& output, vector_size_t outputIndex);
 
+  /// Reads the next 'numValues' values into 'output' starting at
+  /// 'outputIndex'. The values of a fixed-width type other than boolean are
+  /// copied into a flat 'output' in runs of non-null values instead of one at
+  /// a time.
+  void next(
+      BaseVector& output,
+      vector_size_t outputIndex,
+      vector_size_t numValues);
+
  private:
+  template <typename T>
+  void nextFixedWidth(
+      FlatVector<T>& output,
+      vector_size_t outputIndex,
+      vector_size_t numValues);
+
+  // Sets 'nulls_' to the null flags of the values starting at 'pos_' when
+  // 'pos_' is at the start of a word of null flags.
+  void loadNulls() {
+    if (pos_ == lastNullsStart_) {
+      nulls_ = lastNulls_;
+    } else if (pos_ % 64 == 0) {
+      nulls_ = nullsStream_.read<uint64_t>();
+    }
+  }
+
   const vector_size_t size_;
   const vector_size_t lastNullsStart_;
   const uint64_t lastNulls_;
@@ -148,9 +185,7 @@ void copyValueListToArrayWriter(
   writer.reserve(size);
 
   ValueListReader reader(elements);
-  for (vector_size_t i = 0; i < size; ++i) {
-    reader.next(*writer.elementsVector(), writer.valuesOffset() + i);
-  }
+  reader.next(*writer.elementsVector(), writer.valuesOffset(), size);
   writer.resize(size);
 }
 
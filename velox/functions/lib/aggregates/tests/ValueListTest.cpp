@@ -45,6 +45,25 @@ class ValueListTest : public functions::test::FunctionBaseTest {
     return result;
   }
 
+  // Reads the first values one at a time and the rest in bulk.
+  VectorPtr readRange(
+      aggregate::ValueList& values,
+      const TypePtr& type,
+      vector_size_t size) {
+    aggregate::ValueListReader reader(values);
+    auto result = BaseVector::create(type, size, pool());
+    for (auto i = 0; i < size; ++i) {
+      result->setNull(i, true);
+    }
+
+    const auto numSingle = size / 3;
+    for (auto i = 0; i < numSingle; ++i) {
+      reader.next(*result, i);
+    }
+    reader.next(*result, numSingle, size - numSingle);
+    return result;
+  }
+
   void testRoundTrip(const VectorPtr& data) {
     auto size = data->size();
 
@@ -71,9 +90,25 @@ class ValueListTest : public functions::test::FunctionBaseTest {
       auto result = read(values, data->type(), size);
 
       assertEqualVectors(data, result);
+      assertEqualVectors(data, readRange(values, data->type(), size));
     }
   }
 
+  // Uses ValueList::appendRange with ranges that do not start at a word of
+  // null flags.
+  void testPartialRanges(const VectorPtr& data) {
+    const auto size = data->size();
+    aggregate::ValueList values;
+    for (vector_size_t offset = 0; offset < size; offset += 37) {
+      values.appendRange(
+          data, offset, std::min(37, size - offset), allocator());
+    }
+
+    ASSERT_EQ(size, values.size());
+    assertEqualVectors(data, read(values, data->type(), size));
+    assertEqualVectors(data, readRange(values, data->type(), size));
+  }
+
   HashStringAllocator* allocator() {
     return allocator_.get();
   }
@@ -110,6 +145,31 @@ TEST_F(ValueListTest, integers) {
   }
 }
 
+TEST_F(ValueListTest, fixedWidth) {
+  for (auto size : kTestSizes) {
+    for (auto nullEvery : {1, 2, 7, 97}) {
+      const std::vector<VectorPtr> vectors = {
+          makeFlatVector<double>(
+              size,
+              [](auto row) { return row * 0.5; },
+              test::VectorMaker::nullEvery(nullEvery)),
+          makeFlatVector<Timestamp>(
+              size,
+              [](auto row) { return Timestamp(row, row * 1'000); },
+              test::VectorMaker::nullEvery(nullEvery)),
+          makeFlatVector<int8_t>(
+              size,
+              [](auto row) { return row % 100; },
+              test::VectorMaker::nullEvery(nullEvery)),
+      };
+      for (const auto& data : vectors) {
+        testRoundTrip(data);
+        testPartialRanges(data);
+      }
+    }
+  }
+}
+
 TEST_F(ValueListTest, arrays) {
   // No nulls.
   int32_t kSizeCaps[] = {730, 4000, 7500, 50000};
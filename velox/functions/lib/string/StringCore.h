@@ -20,6 +20,7 @@
 #include <string_view>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 #if (ENABLE_VECTORIZATION > 0) && !defined(_DEBUG) && !defined(DEBUG)
@@ -48,7 +49,22 @@ namespace stringCore {
 static bool isAscii(const char* str, size_t length);
 
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
+  // Checks four SIMD widths at a time by or'ing them and testing the sign
+  // bits of the result.
+  using Batch = xsimd::batch<int8_t>;
+  constexpr size_t kStep = 4 * Batch::size;
+  auto data = reinterpret_cast<const int8_t*>(str);
+  size_t i = 0;
+  for (; i + kStep <= length; i += kStep) {
+    const auto bytes = Batch::load_unaligned(data + i) |
+        Batch::load_unaligned(data + i + Batch::size) |
+        Batch::load_unaligned(data + i + 2 * Batch::size) |
+        Batch::load_unaligned(data + i + 3 * Batch::size);
+    if (simd::toBitMask(bytes < Batch::broadcast(0)) != 0) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
     if (str[i] & 0x80) {
       return false;
     }
@@ -311,11 +327,16 @@ static inline int64_t findNthInstanceByteIndexFromStart(
     return -1;
   }
 
-  auto byteIndex = string.find(subString, startPosition);
+  auto byteIndex = simd::simdStrstr(
+      string.data() + startPosition,
+      string.size() - startPosition,
+      subString.data(),
+      subString.size());
   // Not found
   if (byteIndex == std::string_view::npos) {
     return -1;
   }
+  byteIndex += startPosition;
 
   // Search done
   if (instance == 1) {
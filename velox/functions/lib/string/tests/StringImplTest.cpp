@@ -62,6 +62,22 @@ class StringImplTest : public testing::Test {
   }
 };
 
+TEST_F(StringImplTest, isAscii) {
+  EXPECT_TRUE(isAscii("", 0));
+  EXPECT_TRUE(isAscii("abc", 3));
+  EXPECT_FALSE(isAscii("\xc3\xa4", 2));
+
+  // Non-ASCII bytes in and after the part checked a SIMD width at a time.
+  const std::string ascii(300, 'a');
+  EXPECT_TRUE(isAscii(ascii.data(), ascii.size()));
+  for (auto position : {0, 1, 31, 32, 63, 64, 127, 128, 255, 299}) {
+    auto string = ascii;
+    string[position] = static_cast<char>(0x80);
+    EXPECT_FALSE(isAscii(string.data(), string.size())) << position;
+    EXPECT_TRUE(isAscii(string.data(), position)) << position;
+  }
+}
+
 TEST_F(StringImplTest, upperAscii) {
   for (auto& testCase : getUpperAsciiTestData()) {
     auto input = StringView(std::get<0>(testCase));
@@ -287,6 +287,90 @@ TEST_F(KllSketchTest, deserializeSmall) {
   EXPECT_EQ(v, v2);
 }
 
+TEST_F(KllSketchTest, serializeIntegers) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  KllSketch<int64_t> kll(kDefaultK, {}, 0);
+  std::default_random_engine gen(0);
+  std::uniform_int_distribution<int64_t> dist(-1'000'000, 1'000'000);
+  for (int i = 0; i < N; ++i) {
+    kll.insert(dist(gen));
+  }
+  kll.insert(std::numeric_limits<int64_t>::min());
+  kll.insert(std::numeric_limits<int64_t>::max());
+  kll.compact();
+  std::vector<char> data(kll.serializedByteSize());
+  kll.serialize(data.data());
+  // Sorted items are encoded as small differences.
+  auto numRetained = kll.getFrequencies().size();
+  EXPECT_LT(data.size(), numRetained * sizeof(int64_t) / 2);
+  auto kll2 = KllSketch<int64_t>::deserialize(data.data());
+  EXPECT_EQ(kll2.totalCount(), kll.totalCount());
+  EXPECT_EQ(kll2.getFrequencies(), kll.getFrequencies());
+  auto q = linspace(M);
+  auto v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  auto v2 = kll2.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  EXPECT_EQ(v, v2);
+  EXPECT_EQ(v2.front(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(v2.back(), std::numeric_limits<int64_t>::max());
+}
+
+TEST_F(KllSketchTest, deserializeVersion1) {
+  constexpr int N = 1e4;
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  insertRandomData(0, N, kll, nullptr);
+  kll.finish();
+  // Writes the version 1 layout, which has the full item and level vectors.
+  auto view = kll.toView();
+  std::vector<double> items(view.items.begin(), view.items.end());
+  std::vector<uint32_t> levels(view.levels.begin(), view.levels.end());
+  std::vector<char> data(
+      sizeof(int16_t) + sizeof view.k + sizeof view.n + 2 * sizeof(double) +
+      2 * sizeof(size_t) + sizeof(double) * items.size() +
+      sizeof(uint32_t) * levels.size());
+  size_t offset = 0;
+  detail::write<int16_t>(1, data.data(), offset);
+  detail::write(view.k, data.data(), offset);
+  detail::write(view.n, data.data(), offset);
+  detail::write(view.minValue, data.data(), offset);
+  detail::write(view.maxValue, data.data(), offset);
+  detail::writeVector(items, data.data(), offset);
+  detail::writeVector(levels, data.data(), offset);
+  ASSERT_EQ(offset, data.size());
+  auto kll2 = KllSketch<double>::deserialize(data.data());
+  kll2.finish();
+  EXPECT_EQ(kll2.totalCount(), N);
+  EXPECT_EQ(kll2.getFrequencies(), kll.getFrequencies());
+}
+
+TEST_F(KllSketchTest, insertRange) {
+  constexpr int N = 1e5;
+  std::default_random_engine gen(0);
+  std::normal_distribution<> dist;
+  std::vector<double> values(N);
+  for (auto& value : values) {
+    value = dist(gen);
+  }
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  for (auto value : values) {
+    kll.insert(value);
+  }
+  KllSketch<double> kll2(kDefaultK, {}, 0);
+  std::uniform_int_distribution<int> batchSize(0, 1000);
+  for (int i = 0; i < N;) {
+    auto size = std::min(batchSize(gen), N - i);
+    kll2.insert(folly::Range(values.data() + i, size));
+    i += size;
+  }
+  // The same random bits are used for the compactions, so the sketches are
+  // identical.
+  std::vector<char> data(kll.serializedByteSize());
+  kll.serialize(data.data());
+  std::vector<char> data2(kll2.serializedByteSize());
+  kll2.serialize(data2.data());
+  EXPECT_EQ(data, data2);
+}
+
 TEST_F(KllSketchTest, compact) {
   constexpr int N = 1e5;
   KllSketch<double> kll(kFromEpsilon(0.001));
@@ -296,7 +380,7 @@ TEST_F(KllSketchTest, compact) {
   kll.finish();
   auto kll2 = kll;
   kll2.compact();
-  EXPECT_GT(kll.serializedByteSize(), 60000);
+  EXPECT_GT(kll.serializedByteSize(), 4 * kll2.serializedByteSize());
   EXPECT_LT(kll2.serializedByteSize(), 7000);
   auto freq = kll.getFrequencies();
   auto freq2 = kll2.getFrequencies();
@@ -375,6 +459,36 @@ TEST_F(KllSketchTest, mergeDeserialized) {
   }
 }
 
+TEST_F(KllSketchTest, mergeDeserializedMultiple) {
+  constexpr int N = 1e4;
+  constexpr int kSketches = 5;
+  KllSketch<int64_t> expected(kDefaultK, {}, 0);
+  std::vector<std::vector<char>> data(kSketches);
+  for (int i = 0; i < kSketches; ++i) {
+    KllSketch<int64_t> kll(kDefaultK, {}, i);
+    for (int j = 0; j < N; ++j) {
+      kll.insert(j * kSketches + i);
+    }
+    expected.merge(kll);
+    data[i].resize(kll.serializedByteSize());
+    kll.serialize(data[i].data());
+  }
+  std::vector<const char*> pointers;
+  for (auto& serialized : data) {
+    pointers.push_back(serialized.data());
+  }
+  KllSketch<int64_t> kll(kDefaultK, {}, 0);
+  kll.mergeDeserialized(folly::Range(pointers.begin(), pointers.end()));
+  EXPECT_EQ(kll.totalCount(), kSketches * N);
+  kll.finish();
+  auto q = linspace(1001);
+  auto v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  ASSERT_TRUE(std::is_sorted(std::begin(v), std::end(v)));
+  for (int i = 0; i < q.size(); ++i) {
+    EXPECT_NEAR(q[i], v[i] / double(kSketches * N), kEpsilon);
+  }
+}
+
 // Suppose the number of elements inserted is N
 // 1. When N < K, the memory usage should be O(N).
 // 2. Otherwise it's \f$ K \sum_i \(\frac{2}{3}\)^i \f$ and it converges to
@@ -1500,5 +1500,87 @@ TEST_F(Re2FunctionsTest, split) {
   assertEqualVectors(expected, result);
 }
 
+TEST_F(Re2FunctionsTest, regexpLikeChainInOr) {
+  auto input = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"apple pie",
+           "banana split",
+           "cherry",
+           std::nullopt,
+           "kiwi\nfruit",
+           "date"}),
+      makeFlatVector<std::string>({"x", "y", "x", "y", "x", "y"}),
+  });
+  const auto rowType = asRowType(input->type());
+
+  // All the calls on c0 become one search.
+  const std::string sql =
+      "regexp_like(c0, 'pie$') OR c0 like '%split' OR "
+      "regexp_like(c0, '^ch') OR c0 like 'kiwi_fruit'";
+  auto exprSet = compileExpression(sql, rowType);
+  ASSERT_EQ(exprSet->exprs()[0]->name(), "$internal$regexp_like_any");
+  assertEqualVectors(
+      makeNullableFlatVector<bool>({true, true, true, std::nullopt, true, false}),
+      evaluate(sql, input));
+
+  // Calls on other inputs and other disjuncts are kept.
+  const std::string mixedSql =
+      "regexp_like(c0, 'na') OR c1 = 'y' OR c0 like 'date' OR "
+      "regexp_like(c1, 'z')";
+  exprSet = compileExpression(mixedSql, rowType);
+  ASSERT_EQ(exprSet->exprs()[0]->name(), "or");
+  ASSERT_EQ(exprSet->exprs()[0]->inputs().size(), 3);
+  ASSERT_EQ(
+      exprSet->exprs()[0]->inputs()[0]->name(), "$internal$regexp_like_any");
+  assertEqualVectors(
+      makeFlatVector<bool>({false, true, false, true, false, true}),
+      evaluate(mixedSql, input));
+
+  // Invalid patterns are not rewritten and still fail.
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "regexp_like(c0, '(') OR regexp_like(c0, 'a') OR "
+          "regexp_like(c0, 'b')",
+          input),
+      "invalid regular expression");
+}
+
+TEST_F(Re2FunctionsTest, regexpLikeChainInCase) {
+  auto input = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"apple pie", "banana split", "cherry", std::nullopt, "kiwi", "date"}),
+  });
+
+  // 'apple pie' matches the first and the third pattern and gets the value of
+  // the first.
+  const std::string sql =
+      "CASE WHEN c0 like '%pie' THEN 1 "
+      "WHEN regexp_like(c0, 'an+a') THEN 2 "
+      "WHEN regexp_like(c0, 'e') THEN 3 "
+      "ELSE 0 END";
+  auto exprSet = compileExpression(sql, asRowType(input->type()));
+  ASSERT_EQ(exprSet->exprs()[0]->name(), "switch");
+  ASSERT_THAT(
+      exprSet->exprs()[0]->toString(),
+      ::testing::HasSubstr("$internal$regexp_like_first"));
+  assertEqualVectors(
+      makeFlatVector<int64_t>({1, 2, 3, 0, 0, 3}), evaluate(sql, input));
+}
+
+TEST_F(Re2FunctionsTest, regexpLikeSet) {
+  auto input = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"abc", "xbz", "xyz", std::nullopt, ""}),
+  });
+  assertEqualVectors(
+      makeNullableFlatVector<bool>({true, true, false, std::nullopt, false}),
+      evaluate(
+          "\"$internal$regexp_like_any\"(c0, ARRAY['b', 'c$'])", input));
+  assertEqualVectors(
+      makeNullableFlatVector<int32_t>({1, 2, 0, std::nullopt, 0}),
+      evaluate(
+          "\"$internal$regexp_like_first\"(c0, ARRAY['c$', 'b'])", input));
+}
+
 } // namespace
 } // namespace facebook::velox::functions
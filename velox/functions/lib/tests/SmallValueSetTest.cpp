@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "velox/functions/lib/SmallValueSet.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+TEST(SmallValueSetTest, spillToHashSet) {
+  constexpr int64_t kMaxLinear = SmallValueSet<int64_t>::kMaxLinearSize;
+  SmallValueSet<int64_t> set;
+  EXPECT_TRUE(set.empty());
+
+  // Insert values below, at and above the inline capacity, each twice.
+  for (auto round = 0; round < 3; ++round) {
+    for (int64_t i = 0; i < 3 * kMaxLinear; ++i) {
+      EXPECT_TRUE(set.insert(i * 7)) << i;
+      EXPECT_FALSE(set.insert(i * 7)) << i;
+    }
+    EXPECT_FALSE(set.empty());
+    for (int64_t i = 0; i < 3 * kMaxLinear; ++i) {
+      EXPECT_TRUE(set.contains(i * 7)) << i;
+      EXPECT_FALSE(set.contains(i * 7 + 1)) << i;
+    }
+
+    // Values from a previous use must not be found after clear().
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(0));
+    EXPECT_FALSE(set.contains(7 * (kMaxLinear + 1)));
+  }
+}
+
+TEST(SmallValueSetTest, nan) {
+  constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+  SmallValueSet<double> set;
+  EXPECT_TRUE(set.insert(kNaN));
+  EXPECT_FALSE(set.insert(std::nan("1")));
+  EXPECT_TRUE(set.contains(kNaN));
+
+  // NaN inserted after the inline array is full goes to the hash set.
+  set.clear();
+  for (auto i = 0; i < SmallValueSet<double>::kMaxLinearSize; ++i) {
+    EXPECT_TRUE(set.insert(i));
+  }
+  EXPECT_FALSE(set.contains(kNaN));
+  EXPECT_TRUE(set.insert(kNaN));
+  EXPECT_FALSE(set.insert(std::nan("2")));
+  EXPECT_TRUE(set.contains(kNaN));
+}
+
+} // namespace
+} // namespace facebook::velox::functions
@@ -73,6 +73,10 @@ class NthValueFunction : public exec::WindowFunction {
     partitionOffset_ = 0;
   }
 
+  RowAccess rowAccess() const override {
+    return RowAccess::kFrame;
+  }
+
   void apply(
       const BufferPtr& /*peerGroupStarts*/,
       const BufferPtr& /*peerGroupEnds*/,
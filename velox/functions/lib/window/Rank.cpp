@@ -43,6 +43,12 @@ class RankFunction : public exec::WindowFunction {
     numPartitionRows_ = partition->numRows();
   }
 
+  RowAccess rowAccess() const override {
+    // percent_rank() needs the number of rows of the partition.
+    return TRank == RankType::kPercentRank ? RowAccess::kPartition
+                                           : RowAccess::kPeers;
+  }
+
   void apply(
       const BufferPtr& peerGroupStarts,
       const BufferPtr& /*peerGroupEnds*/,
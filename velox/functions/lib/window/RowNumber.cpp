@@ -32,6 +32,10 @@ class RowNumberFunction : public exec::WindowFunction {
     rowNumber_ = 1;
   }
 
+  RowAccess rowAccess() const override {
+    return RowAccess::kPeers;
+  }
+
   void apply(
       const BufferPtr& peerGroupStarts,
       const BufferPtr& /*peerGroupEnds*/,
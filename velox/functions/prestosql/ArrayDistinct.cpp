@@ -18,17 +18,17 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
-#include "velox/type/FloatingPointUtil.h"
+#include "velox/functions/lib/SmallValueSet.h"
 
 namespace facebook::velox::functions {
 namespace {
 
 template <typename T>
 struct ValueSet {
-  util::floating_point::HashSetNaNAware<T> values;
+  SmallValueSet<T> values;
 
   bool insert(const T& value) {
-    return values.insert(value).second;
+    return values.insert(value);
   }
 
   void reset() {
@@ -14,13 +14,12 @@
  * limitations under the License.
  */
 
-#include <folly/container/F14Map.h>
-
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/ComparatorUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SmallValueSet.h"
 
 namespace facebook::velox::functions {
 namespace {
@@ -29,7 +28,7 @@ namespace {
 ///
 /// Implements the array_duplicates function.
 ///
-/// Along with the hash map, we maintain a `hasNull` flag that indicates
+/// Along with the sets of values seen once and emitted, we maintain a `hasNull` flag that indicates
 /// whether null is present in the array.
 ///
 /// Zero element copy:
@@ -99,9 +98,11 @@ class ArrayDuplicatesFunction : public exec::VectorFunction {
     auto* rawSizes = newSizes->asMutable<vector_size_t>();
     auto* rawOffsets = newOffsets->asMutable<vector_size_t>();
 
-    // Process the rows: use a hashmap to store unique values and
-    // whether it occurred once or more than once.
-    folly::F14FastMap<T, bool> uniqueMap;
+    // Process the rows: 'seen' holds the values that occurred at least once
+    // and 'emitted' the ones that occurred more than once. Both are reused
+    // across rows.
+    SmallValueSet<T> seen;
+    SmallValueSet<T> emitted;
 
     rows.applyToSelected([&](vector_size_t row) {
       auto size = arrayVector->sizeAt(row);
@@ -119,18 +120,15 @@ class ArrayDuplicatesFunction : public exec::VectorFunction {
           }
         } else {
           T value = elements->valueAt<T>(i);
-          auto it = uniqueMap.find(value);
-          if (it == uniqueMap.end()) {
-            uniqueMap[value] = true;
-          } else if (it->second) {
-            it->second = false;
+          if (!seen.insert(value) && emitted.insert(value)) {
             rawIndices[indexCursor] = i;
             indexCursor++;
           }
         }
       }
 
-      uniqueMap.clear();
+      seen.clear();
+      emitted.clear();
       rawSizes[row] = indexCursor - rawOffsets[row];
 
       std::sort(
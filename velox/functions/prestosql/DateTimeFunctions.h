@@ -963,7 +963,7 @@ template <typename T>
 struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  const date::time_zone* timeZone_ = nullptr;
+  TimeZoneOffsetCache timeZone_;
   std::optional<DateTimeUnit> unit_;
 
   FOLLY_ALWAYS_INLINE void initialize(
@@ -971,7 +971,7 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
       const core::QueryConfig& config,
       const arg_type<Varchar>* unitString,
       const arg_type<Timestamp>* /*timestamp*/) {
-    timeZone_ = getTimeZoneFromConfig(config);
+    timeZone_ = TimeZoneOffsetCache(getTimeZoneFromConfig(config));
 
     if (unitString != nullptr) {
       unit_ = getTimestampUnit(*unitString);
@@ -1116,8 +1116,8 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
         break;
     }
 
-    if (timeZone_ != nullptr) {
-      result.toGMT(*timeZone_);
+    if (timeZone_.zone() != nullptr) {
+      result = Timestamp(timeZone_.toGMT(result.getSeconds()), 0);
     }
   }
 
@@ -1390,7 +1390,7 @@ struct DateFormatFunction : public TimestampWithTimezoneSupport<T> {
       const core::QueryConfig& config,
       const arg_type<Timestamp>* /*timestamp*/,
       const arg_type<Varchar>* formatString) {
-    sessionTimeZone_ = getTimeZoneFromConfig(config);
+    sessionTimeZone_ = TimeZoneOffsetCache(getTimeZoneFromConfig(config));
     if (formatString != nullptr) {
       setFormatter(*formatString);
       isConstFormat_ = true;
@@ -1434,10 +1434,10 @@ struct DateFormatFunction : public TimestampWithTimezoneSupport<T> {
   FOLLY_ALWAYS_INLINE void setFormatter(const arg_type<Varchar> formatString) {
     mysqlDateTime_ = buildMysqlDateTimeFormatter(
         std::string_view(formatString.data(), formatString.size()));
-    maxResultSize_ = mysqlDateTime_->maxResultSize(sessionTimeZone_);
+    maxResultSize_ = mysqlDateTime_->maxResultSize(sessionTimeZone_.zone());
   }
 
-  const date::time_zone* sessionTimeZone_ = nullptr;
+  TimeZoneOffsetCache sessionTimeZone_;
   std::shared_ptr<DateTimeFormatter> mysqlDateTime_;
   uint32_t maxResultSize_;
   bool isConstFormat_ = false;
@@ -1555,7 +1555,7 @@ struct FormatDateTimeFunction {
       const core::QueryConfig& config,
       const arg_type<Timestamp>* /*timestamp*/,
       const arg_type<Varchar>* formatString) {
-    sessionTimeZone_ = getTimeZoneFromConfig(config);
+    sessionTimeZone_ = TimeZoneOffsetCache(getTimeZoneFromConfig(config));
     if (formatString != nullptr) {
       setFormatter(*formatString);
       isConstFormat_ = true;
@@ -1596,12 +1596,14 @@ struct FormatDateTimeFunction {
   FOLLY_ALWAYS_INLINE void setFormatter(const arg_type<Varchar>& formatString) {
     jodaDateTime_ = buildJodaDateTimeFormatter(
         std::string_view(formatString.data(), formatString.size()));
-    maxResultSize_ = jodaDateTime_->maxResultSize(sessionTimeZone_);
+    maxResultSize_ = jodaDateTime_->maxResultSize(sessionTimeZone_.zone());
   }
 
+  // 'TimeZone' is either a date::time_zone pointer or a TimeZoneOffsetCache.
+  template <typename TimeZone>
   void format(
       const Timestamp& timestamp,
-      const date::time_zone* timeZone,
+      TimeZone& timeZone,
       uint32_t maxResultSize,
       out_type<Varchar>& result) const {
     result.reserve(maxResultSize);
@@ -1610,7 +1612,7 @@ struct FormatDateTimeFunction {
     result.resize(resultSize);
   }
 
-  const date::time_zone* sessionTimeZone_ = nullptr;
+  TimeZoneOffsetCache sessionTimeZone_;
   std::shared_ptr<DateTimeFormatter> jodaDateTime_;
   uint32_t maxResultSize_;
   bool isConstFormat_ = false;
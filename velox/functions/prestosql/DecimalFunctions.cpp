@@ -24,6 +24,19 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Returns true if adding or subtracting decimals of the given types may
+// overflow. The inputs rescaled to the result scale have fewer digits than the
+// result, so the result can only overflow when its precision is capped at 38.
+inline bool plusMinusMayOverflow(
+    uint8_t aPrecision,
+    uint8_t aScale,
+    uint8_t bPrecision,
+    uint8_t bScale) {
+  return std::max(aPrecision - aScale, bPrecision - bScale) +
+      std::max(aScale, bScale) + 1 >
+      LongDecimalType::kMaxPrecision;
+}
+
 template <typename TExec>
 struct DecimalPlusFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
@@ -34,12 +47,14 @@ struct DecimalPlusFunction {
       const core::QueryConfig& /*config*/,
       A* /*a*/,
       B* /*b*/) {
-    auto aType = inputTypes[0];
-    auto bType = inputTypes[1];
-    auto aScale = getDecimalPrecisionScale(*aType).second;
-    auto bScale = getDecimalPrecisionScale(*bType).second;
+    const auto [aPrecision, aScale] = getDecimalPrecisionScale(*inputTypes[0]);
+    const auto [bPrecision, bScale] = getDecimalPrecisionScale(*inputTypes[1]);
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    aMultiplier_ = DecimalUtil::kPowersOfTen[aRescale_];
+    bMultiplier_ = DecimalUtil::kPowersOfTen[bRescale_];
+    mayOverflow_ =
+        plusMinusMayOverflow(aPrecision, aScale, bPrecision, bScale);
   }
 
   template <typename R, typename A, typename B>
@@ -50,12 +65,14 @@ struct DecimalPlusFunction {
 #endif
 #endif
   {
+    if (!mayOverflow_) {
+      out = R(a) * R(aMultiplier_) + R(b) * R(bMultiplier_);
+      return;
+    }
     int128_t aRescaled;
     int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    if (__builtin_mul_overflow(a, aMultiplier_, &aRescaled) ||
+        __builtin_mul_overflow(b, bMultiplier_, &bRescaled)) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} + {}", a, b);
     }
     out = checkedPlus<R>(R(aRescaled), R(bRescaled));
@@ -71,6 +88,9 @@ struct DecimalPlusFunction {
 
   uint8_t aRescale_;
   uint8_t bRescale_;
+  int128_t aMultiplier_;
+  int128_t bMultiplier_;
+  bool mayOverflow_;
 };
 
 template <typename TExec>
@@ -83,12 +103,14 @@ struct DecimalMinusFunction {
       const core::QueryConfig& /*config*/,
       A* /*a*/,
       B* /*b*/) {
-    const auto& aType = inputTypes[0];
-    const auto& bType = inputTypes[1];
-    auto aScale = getDecimalPrecisionScale(*aType).second;
-    auto bScale = getDecimalPrecisionScale(*bType).second;
+    const auto [aPrecision, aScale] = getDecimalPrecisionScale(*inputTypes[0]);
+    const auto [bPrecision, bScale] = getDecimalPrecisionScale(*inputTypes[1]);
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    aMultiplier_ = DecimalUtil::kPowersOfTen[aRescale_];
+    bMultiplier_ = DecimalUtil::kPowersOfTen[bRescale_];
+    mayOverflow_ =
+        plusMinusMayOverflow(aPrecision, aScale, bPrecision, bScale);
   }
 
   template <typename R, typename A, typename B>
@@ -99,12 +121,14 @@ struct DecimalMinusFunction {
 #endif
 #endif
   {
+    if (!mayOverflow_) {
+      out = R(a) * R(aMultiplier_) - R(b) * R(bMultiplier_);
+      return;
+    }
     int128_t aRescaled;
     int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    if (__builtin_mul_overflow(a, aMultiplier_, &aRescaled) ||
+        __builtin_mul_overflow(b, bMultiplier_, &bRescaled)) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} - {}", a, b);
     }
     out = checkedMinus<R>(R(aRescaled), R(bRescaled));
@@ -120,17 +144,40 @@ struct DecimalMinusFunction {
 
   uint8_t aRescale_;
   uint8_t bRescale_;
+  int128_t aMultiplier_;
+  int128_t bMultiplier_;
+  bool mayOverflow_;
 };
 
 template <typename TExec>
 struct DecimalMultiplyFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
 
+  template <typename A, typename B>
+  void initialize(
+      const std::vector<TypePtr>& inputTypes,
+      const core::QueryConfig& /*config*/,
+      A* /*a*/,
+      B* /*b*/) {
+    // The product has at most as many digits as both inputs together, so it
+    // can only overflow when the result precision is capped at 38.
+    mayOverflow_ = getDecimalPrecisionScale(*inputTypes[0]).first +
+            getDecimalPrecisionScale(*inputTypes[1]).first >
+        LongDecimalType::kMaxPrecision;
+  }
+
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
+    if (!mayOverflow_) {
+      out = R(a) * R(b);
+      return;
+    }
     out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
     DecimalUtil::valueInRange(out);
   }
+
+ private:
+  bool mayOverflow_;
 };
 
 template <typename TExec>
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -181,6 +182,109 @@ class JsonParseFunction : public exec::VectorFunction {
   mutable std::string paddedInput_;
 };
 
+
+// json_extract_scalar(json, path) for several constant paths on the same json.
+// Takes json and an array of paths and returns a ROW with the result for each
+// path. Each document is parsed once and queried for all paths.
+class JsonExtractScalarBatchFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarBatchFunction(
+      std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors)
+      : extractors_(std::move(extractors)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(outputType->size(), extractors_.size());
+    std::vector<FlatVector<StringView>*> outputs;
+    std::vector<VectorPtr> children;
+    for (auto i = 0; i < extractors_.size(); ++i) {
+      children.push_back(BaseVector::create(
+          outputType->childAt(i), rows.end(), context.pool()));
+      outputs.push_back(children.back()->asFlatVector<StringView>());
+    }
+
+    exec::LocalDecodedVector decodedJson(context, *args[0], rows);
+    std::optional<std::string> value;
+    rows.applyToSelected([&](auto row) {
+      if (decodedJson->isNullAt(row)) {
+        for (auto* output : outputs) {
+          output->setNull(row, true);
+        }
+        return;
+      }
+      const auto json = decodedJson->valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(json.data(), json.size());
+      simdjson::ondemand::document jsonDoc;
+      auto error = simdjsonParse(paddedJson).get(jsonDoc);
+      for (auto i = 0; i < extractors_.size(); ++i) {
+        if (error == simdjson::SUCCESS) {
+          value.reset();
+          error = extractJsonScalar(jsonDoc, *extractors_[i], value);
+          if (error == simdjson::SUCCESS && value.has_value()) {
+            outputs[i]->set(row, StringView(*value));
+            continue;
+          }
+        }
+        outputs[i]->setNull(row, true);
+        if (error != simdjson::SUCCESS) {
+          // The document may be left in an error state. Parses it again for
+          // the next path.
+          error = simdjsonParse(paddedJson).get(jsonDoc);
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // json, array(varchar) -> row(varchar, ...)
+    // varchar, array(varchar) -> row(varchar, ...)
+    // The result has one field per path.
+    std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+    for (const auto& jsonType : {"json", "varchar"}) {
+      signatures.push_back(exec::FunctionSignatureBuilder()
+                               .returnType("row(varchar)")
+                               .argumentType(jsonType)
+                               .constantArgumentType("array(varchar)")
+                               .build());
+    }
+    return signatures;
+  }
+
+ private:
+  const std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors_;
+};
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalarBatch(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_EQ(inputArgs.size(), 2);
+  const auto& pathsVector = inputArgs[1].constantValue;
+  VELOX_USER_CHECK_NOT_NULL(
+      pathsVector, "{} requires a constant array of paths", name);
+  auto* paths = pathsVector->wrappedVector()->as<ArrayVector>();
+  const auto index = pathsVector->wrappedIndex(0);
+  auto* elements = paths->elements()->as<SimpleVector<StringView>>();
+
+  std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors;
+  for (auto i = 0; i < paths->sizeAt(index); ++i) {
+    const auto path = elements->valueAt(paths->offsetAt(index) + i);
+    auto extractor = SIMDJsonExtractor::tryCreate(path);
+    VELOX_USER_CHECK_NOT_NULL(extractor, "Invalid JSON path: {}", path);
+    extractors.push_back(std::move(extractor));
+  }
+  return std::make_shared<JsonExtractScalarBatchFunction>(
+      std::move(extractors));
+}
+
 } // namespace
 
 VELOX_DECLARE_VECTOR_FUNCTION(
@@ -197,4 +301,12 @@ VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
       return std::make_shared<JsonParseFunction>();
     });
 
+// Not default null behavior, as the result for a null json is a ROW of nulls,
+// not a null ROW.
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION_WITH_METADATA(
+    udf_$internal$json_extract_scalar_batch,
+    JsonExtractScalarBatchFunction::signatures(),
+    exec::VectorFunctionMetadataBuilder().defaultNullBehavior(false).build(),
+    makeJsonExtractScalarBatch);
+
 } // namespace facebook::velox::functions
@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/CheckedArithmetic.h"
+#include "velox/expression/FieldReference.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
+#include "velox/functions/lib/RowsTranslationUtil.h"
 
 namespace facebook::velox::functions {
 namespace {
@@ -80,6 +83,176 @@ bool toNthElementRows(
   return arrayRows.hasSelections();
 }
 
+enum class ReduceOp { kPlus, kMultiply };
+
+// Returns the operation of a lambda (s, x) -> s + x or (s, x) -> s * x, or the
+// same with the operands swapped, where the state and the elements are of the
+// same numeric 'type'. Returns std::nullopt for any other lambda.
+std::optional<ReduceOp> toReduceOp(
+    const Callable& callable,
+    const TypePtr& type) {
+  static const std::vector<TypePtr> kNumericTypes = {
+      TINYINT(), SMALLINT(), INTEGER(), BIGINT(), REAL(), DOUBLE()};
+
+  const auto* body = callable.body();
+  const auto& signature = callable.signature();
+  if (body == nullptr || signature == nullptr || signature->size() != 2 ||
+      body->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  if (std::none_of(
+          kNumericTypes.begin(), kNumericTypes.end(), [&](const auto& other) {
+            return *type == *other;
+          })) {
+    return std::nullopt;
+  }
+  if (*body->type() != *type || *signature->childAt(0) != *type ||
+      *signature->childAt(1) != *type) {
+    return std::nullopt;
+  }
+
+  // Strip the catalog and schema from names like 'presto.default.plus'.
+  auto name = std::string_view(body->name());
+  if (const auto pos = name.rfind('.'); pos != std::string_view::npos) {
+    name = name.substr(pos + 1);
+  }
+  ReduceOp op;
+  if (name == "plus") {
+    op = ReduceOp::kPlus;
+  } else if (name == "multiply") {
+    op = ReduceOp::kMultiply;
+  } else {
+    return std::nullopt;
+  }
+
+  // Both operations are commutative, so the parameters may come in any order.
+  const auto* left = body->inputs()[0]->as<exec::FieldReference>();
+  const auto* right = body->inputs()[1]->as<exec::FieldReference>();
+  if (left == nullptr || right == nullptr || !left->inputs().empty() ||
+      !right->inputs().empty()) {
+    return std::nullopt;
+  }
+  const auto& state = signature->nameOf(0);
+  const auto& element = signature->nameOf(1);
+  if ((left->field() == state && right->field() == element) ||
+      (left->field() == element && right->field() == state)) {
+    return op;
+  }
+  return std::nullopt;
+}
+
+// Folds the arrays in 'rows' into 'result' one array at a time, starting from
+// 'initialState'. Nulls and integer overflow behave as in the interpreted
+// lambda: a null state or element makes the result null and overflow is an
+// error for the row.
+template <typename T>
+void reduceArrays(
+    ReduceOp op,
+    const SelectivityVector& rows,
+    const ArrayVector& array,
+    const DecodedVector& initialState,
+    const DecodedVector& elements,
+    exec::EvalCtx& context,
+    VectorPtr& resultVector) {
+  auto& result = *resultVector->asUnchecked<FlatVector<T>>();
+  const auto* rawOffsets = array.rawOffsets();
+  const auto* rawSizes = array.rawSizes();
+  auto* rawResult = result.mutableRawValues();
+
+  auto fold = [&](auto combine) {
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      // Keep the value defined if the row fails.
+      rawResult[row] = T();
+      if (initialState.isNullAt(row)) {
+        result.setNull(row, true);
+        return;
+      }
+      T state = initialState.valueAt<T>(row);
+      const auto end = rawOffsets[row] + rawSizes[row];
+      for (auto i = rawOffsets[row]; i < end; ++i) {
+        if (elements.isNullAt(i)) {
+          result.setNull(row, true);
+          return;
+        }
+        state = combine(state, elements.valueAt<T>(i));
+      }
+      result.set(row, state);
+    });
+  };
+
+  if constexpr (std::is_floating_point_v<T>) {
+    if (op == ReduceOp::kPlus) {
+      fold([](T a, T b) { return a + b; });
+    } else {
+      fold([](T a, T b) { return a * b; });
+    }
+  } else {
+    if (op == ReduceOp::kPlus) {
+      fold([](T a, T b) { return checkedPlus<T>(a, b); });
+    } else {
+      fold([](T a, T b) { return checkedMultiply<T>(a, b); });
+    }
+  }
+}
+
+// Evaluates the input function of 'reduce' for 'rows' without the interpreter
+// if it is a sum or product of the state and the element. Returns false if
+// the function must be interpreted.
+bool tryReduceArrays(
+    Callable& callable,
+    const SelectivityVector& rows,
+    const ArrayVectorPtr& flatArray,
+    const VectorPtr& initialState,
+    exec::EvalCtx& context,
+    VectorPtr& partialResult) {
+  const auto& type = initialState->type();
+  if (*flatArray->elements()->type() != *type ||
+      partialResult->encoding() != VectorEncoding::Simple::FLAT ||
+      partialResult.use_count() != 1) {
+    return false;
+  }
+  const auto op = toReduceOp(callable, type);
+  if (!op.has_value()) {
+    return false;
+  }
+
+  const auto elementRows = toElementRows<ArrayVector>(
+      flatArray->elements()->size(), rows, flatArray.get());
+  exec::LocalDecodedVector initialStateDecoder(context, *initialState, rows);
+  exec::LocalDecodedVector elementsDecoder(
+      context, *flatArray->elements(), elementRows);
+
+  auto reduce = [&](auto valueType) {
+    using T = decltype(valueType);
+    reduceArrays<T>(
+        *op,
+        rows,
+        *flatArray,
+        *initialStateDecoder.get(),
+        *elementsDecoder.get(),
+        context,
+        partialResult);
+    return true;
+  };
+
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+      return reduce(int8_t());
+    case TypeKind::SMALLINT:
+      return reduce(int16_t());
+    case TypeKind::INTEGER:
+      return reduce(int32_t());
+    case TypeKind::BIGINT:
+      return reduce(int64_t());
+    case TypeKind::REAL:
+      return reduce(float());
+    case TypeKind::DOUBLE:
+      return reduce(double());
+    default:
+      return false;
+  }
+}
+
 /// See documentation at
 /// https://prestodb.io/docs/current/functions/array.html#reduce
 class ReduceFunction : public exec::VectorFunction {
@@ -166,6 +339,16 @@ class ReduceFunction : public exec::VectorFunction {
     // At each step the number of arrays being processed will get smaller as
     // some arrays will run out of elements.
     while (auto entry = inputFuncIt.next()) {
+      if (tryReduceArrays(
+              *entry.callable,
+              *entry.rows,
+              flatArray,
+              initialState,
+              context,
+              partialResult)) {
+        continue;
+      }
+
       VectorPtr state = initialState;
 
       vector_size_t n = 0;
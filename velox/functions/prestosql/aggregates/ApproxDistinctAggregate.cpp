@@ -54,6 +54,18 @@ struct HllAccumulator {
     }
   }
 
+  void append(folly::Range<const uint64_t*> hashes) {
+    if (isSparse_) {
+      auto numInserted = sparseHll_.insertHashes(hashes);
+      if (!sparseHll_.overLimit()) {
+        return;
+      }
+      toDense();
+      hashes.advance(numInserted);
+    }
+    denseHll_.insertHashes(hashes);
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -217,21 +229,28 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addIntermediateResults(groups, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
-
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+      hashValues(rows, groups);
+
+      // Consecutive rows of the same group are added in one batch.
+      for (size_t i = 0; i < hashes_.size();) {
+        auto group = hashGroups_[i];
+        auto end = i + 1;
+        while (end < hashes_.size() && hashGroups_[end] == group) {
+          ++end;
         }
 
-        auto group = groups[row];
         auto tracker = trackRowSize(group);
         auto accumulator = value<HllAccumulator>(group);
         clearNull(group);
         accumulator->setIndexBitLength(indexBitLength_);
 
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
-      });
+        if (end - i == 1) {
+          accumulator->append(hashes_[i]);
+        } else {
+          accumulator->append(folly::Range(hashes_.data() + i, end - i));
+        }
+        i = end;
+      }
     }
   }
 
@@ -268,19 +287,15 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addSingleGroupIntermediateResults(group, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
+      hashValues(rows, nullptr);
+      if (hashes_.empty()) {
+        return;
+      }
 
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
-        }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
-      });
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(folly::Range(hashes_.data(), hashes_.size()));
     }
   }
 
@@ -372,6 +387,30 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     }
   }
 
+  // Hashes the non-null values of 'rows' into 'hashes_' and, if 'groups' is
+  // not null, their groups into 'hashGroups_'. Hashing all values before
+  // updating the accumulators keeps the hashing loop free of the scattered
+  // accumulator accesses.
+  void hashValues(const SelectivityVector& rows, char** groups) {
+    hashes_.clear();
+    hashGroups_.clear();
+    auto addRow = [&](vector_size_t row) {
+      hashes_.push_back(hashOne(decodedValue_.valueAt<T>(row)));
+      if (groups) {
+        hashGroups_.push_back(groups[row]);
+      }
+    };
+    if (decodedValue_.mayHaveNulls()) {
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          addRow(row);
+        }
+      });
+    } else {
+      rows.applyToSelected(addRow);
+    }
+  }
+
   void checkSetMaxStandardError(const SelectivityVector& rows) {
     if (decodedMaxStandardError_.isConstantMapping()) {
       const auto maxStandardError = decodedMaxStandardError_.valueAt<double>(0);
@@ -423,6 +462,10 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+
+  // Hashes of the non-null input values and their groups. See hashValues().
+  std::vector<uint64_t> hashes_;
+  std::vector<char*> hashGroups_;
 };
 
 template <TypeKind kind>
@@ -54,6 +54,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(folly::Range<const T*> values) {
+    sketch_.insert(values);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -73,7 +77,7 @@ struct KllSketchAccumulator {
     sketch_.mergeViews(folly::Range(&view, 1));
   }
 
-  void append(const std::vector<KllView<T>>& views) {
+  void append(folly::Range<const KllView<T>*> views) {
     sketch_.mergeViews(views);
   }
 
@@ -409,19 +413,23 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight);
       });
     } else {
+      // Gathers the values so that the sketch inserts them in one batch.
+      rawValues_.clear();
       if (decodedValue_.mayHaveNulls()) {
         rows.applyToSelected([&](auto row) {
           if (decodedValue_.isNullAt(row)) {
             return;
           }
 
-          accumulator->append(decodedValue_.valueAt<T>(row));
+          rawValues_.push_back(decodedValue_.valueAt<T>(row));
         });
       } else {
         rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
+          rawValues_.push_back(decodedValue_.valueAt<T>(row));
         });
       }
+      accumulator->append(folly::Range<const T*>(
+          rawValues_.data(), rawValues_.size()));
     }
   }
 
@@ -665,6 +673,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Non-null input values of a single group batch.
+  std::vector<T> rawValues_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
@@ -730,8 +740,11 @@ class ApproxPercentileAggregate : public exec::Aggregate {
 
     KllSketchAccumulator<T>* accumulator = nullptr;
     std::vector<KllView<T>> views;
+    std::vector<std::pair<char*, KllView<T>>> groupViews;
     if constexpr (kSingleGroup) {
       views.reserve(rows.end());
+    } else {
+      groupViews.reserve(rows.end());
     }
     rows.applyToSelected([&](auto row) {
       if (decoded.isNullAt(row)) {
@@ -792,14 +805,37 @@ class ApproxPercentileAggregate : public exec::Aggregate {
       if constexpr (kSingleGroup) {
         views.push_back(v);
       } else {
-        auto tracker = trackRowSize(group[row]);
-        accumulator->append(v);
+        groupViews.emplace_back(group[row], v);
       }
     });
     if constexpr (kSingleGroup) {
       if (!views.empty()) {
         auto tracker = trackRowSize(group);
-        accumulator->append(views);
+        accumulator->append(folly::Range(views.data(), views.size()));
+      }
+    } else {
+      // Merges all the sketches of a group at once, which makes one pass over
+      // the levels of the group's sketch instead of one per input row.
+      std::stable_sort(
+          groupViews.begin(),
+          groupViews.end(),
+          [](const auto& left, const auto& right) {
+            return left.first < right.first;
+          });
+      views.reserve(groupViews.size());
+      for (auto& groupView : groupViews) {
+        views.push_back(groupView.second);
+      }
+      for (size_t begin = 0; begin < groupViews.size();) {
+        auto* groupPtr = groupViews[begin].first;
+        auto end = begin + 1;
+        while (end < groupViews.size() && groupViews[end].first == groupPtr) {
+          ++end;
+        }
+        auto tracker = trackRowSize(groupPtr);
+        value<KllSketchAccumulator<T>>(groupPtr)->append(
+            folly::Range(views.data() + begin, end - begin));
+        begin = end;
       }
     }
   }
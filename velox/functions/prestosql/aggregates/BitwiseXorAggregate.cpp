@@ -62,6 +62,28 @@ class BitwiseXorAggregate {
       return true;
     }
   };
+
+  static void addInputBatch(
+      HashStringAllocator* /*allocator*/,
+      exec::AccumulatorBatch<AccumulatorType> accumulators,
+      const T* values,
+      vector_size_t numRows) {
+    for (auto i = 0; i < numRows; ++i) {
+      accumulators[i].xor_ ^= values[i];
+    }
+  }
+
+  static void addSingleGroupInputBatch(
+      HashStringAllocator* /*allocator*/,
+      AccumulatorType& accumulator,
+      const T* values,
+      vector_size_t numRows) {
+    T result = accumulator.xor_;
+    for (auto i = 0; i < numRows; ++i) {
+      result ^= values[i];
+    }
+    accumulator.xor_ = result;
+  }
 };
 
 } // namespace
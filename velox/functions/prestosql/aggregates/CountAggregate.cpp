@@ -46,26 +46,23 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
+    auto countAll = [](vector_size_t /*i*/) { return true; };
     if (args.empty()) {
-      rows.applyToSelected([&](vector_size_t i) { addToGroup(groups[i], 1); });
+      addRowCounts(groups, rows, countAll);
       return;
     }
 
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
-        rows.applyToSelected(
-            [&](vector_size_t i) { addToGroup(groups[i], 1); });
+        addRowCounts(groups, rows, countAll);
       }
     } else if (decoded.mayHaveNulls()) {
-      rows.applyToSelected([&](vector_size_t i) {
-        if (decoded.isNullAt(i)) {
-          return;
-        }
-        addToGroup(groups[i], 1);
+      addRowCounts(groups, rows, [&](vector_size_t i) {
+        return !decoded.isNullAt(i);
       });
     } else {
-      rows.applyToSelected([&](vector_size_t i) { addToGroup(groups[i], 1); });
+      addRowCounts(groups, rows, countAll);
     }
   }
 
@@ -146,6 +143,34 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     *value<int64_t>(group) += count;
   }
 
+  // Adds 1 to the group of each selected row for which 'isCounted(i)' is
+  // true. Consecutive rows of the same group are counted in a local and
+  // added to the group once per run.
+  template <typename IsCounted>
+  void addRowCounts(
+      char** groups,
+      const SelectivityVector& rows,
+      IsCounted isCounted) {
+    char* group = nullptr;
+    int64_t count = 0;
+    rows.applyToSelected([&](vector_size_t i) {
+      if (!isCounted(i)) {
+        return;
+      }
+      if (groups[i] != group) {
+        if (group) {
+          addToGroup(group, count);
+        }
+        group = groups[i];
+        count = 0;
+      }
+      ++count;
+    });
+    if (group) {
+      addToGroup(group, count);
+    }
+  }
+
   DecodedVector decodedIntermediate_;
 };
 
@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 #include <string>
 
+#include "velox/exec/SimpleAggregateAdapter.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -34,6 +35,120 @@ static constexpr int32_t kRowsPerVector = 10'000;
 
 namespace {
 
+// Sum written with the simple aggregate interface, adding one row at a time.
+template <typename TInput, typename TSum>
+class SimpleSumAggregate {
+ public:
+  using InputType = Row<TInput>;
+  using IntermediateType = TSum;
+  using OutputType = TSum;
+
+  struct AccumulatorType {
+    TSum sum_{0};
+
+    AccumulatorType() = delete;
+
+    explicit AccumulatorType(HashStringAllocator* /*allocator*/) {}
+
+    void addInput(HashStringAllocator* /*allocator*/, TInput value) {
+      sum_ += value;
+    }
+
+    void combine(HashStringAllocator* /*allocator*/, TSum other) {
+      sum_ += other;
+    }
+
+    bool writeFinalResult(exec::out_type<OutputType>& out) {
+      out = sum_;
+      return true;
+    }
+
+    bool writeIntermediateResult(exec::out_type<IntermediateType>& out) {
+      out = sum_;
+      return true;
+    }
+  };
+};
+
+// SimpleSumAggregate with batched addInput.
+template <typename TInput, typename TSum>
+class SimpleBatchSumAggregate : public SimpleSumAggregate<TInput, TSum> {
+ public:
+  using AccumulatorType =
+      typename SimpleSumAggregate<TInput, TSum>::AccumulatorType;
+
+  static void addInputBatch(
+      HashStringAllocator* /*allocator*/,
+      exec::AccumulatorBatch<AccumulatorType> accumulators,
+      const TInput* values,
+      vector_size_t numRows) {
+    for (auto i = 0; i < numRows; ++i) {
+      accumulators[i].sum_ += values[i];
+    }
+  }
+
+  static void addSingleGroupInputBatch(
+      HashStringAllocator* /*allocator*/,
+      AccumulatorType& accumulator,
+      const TInput* values,
+      vector_size_t numRows) {
+    TSum sum = accumulator.sum_;
+    for (auto i = 0; i < numRows; ++i) {
+      sum += values[i];
+    }
+    accumulator.sum_ = sum;
+  }
+};
+
+template <template <typename, typename> class TAggregate>
+void registerSimpleSum(const std::string& name) {
+  std::vector<std::shared_ptr<exec::AggregateFunctionSignature>> signatures;
+  for (const auto& [inputType, sumType] :
+       std::vector<std::pair<std::string, std::string>>{
+           {"integer", "bigint"},
+           {"bigint", "bigint"},
+           {"real", "double"},
+           {"double", "double"}}) {
+    signatures.push_back(exec::AggregateFunctionSignatureBuilder()
+                             .returnType(sumType)
+                             .intermediateType(sumType)
+                             .argumentType(inputType)
+                             .build());
+  }
+  exec::registerAggregateFunction(
+      name,
+      std::move(signatures),
+      [name](
+          core::AggregationNode::Step /*step*/,
+          const std::vector<TypePtr>& argTypes,
+          const TypePtr& resultType,
+          const core::QueryConfig& /*config*/)
+          -> std::unique_ptr<exec::Aggregate> {
+        switch (argTypes[0]->kind()) {
+          case TypeKind::INTEGER:
+            return std::make_unique<
+                exec::SimpleAggregateAdapter<TAggregate<int32_t, int64_t>>>(
+                resultType);
+          case TypeKind::BIGINT:
+            return std::make_unique<
+                exec::SimpleAggregateAdapter<TAggregate<int64_t, int64_t>>>(
+                resultType);
+          case TypeKind::REAL:
+            return std::make_unique<
+                exec::SimpleAggregateAdapter<TAggregate<float, double>>>(
+                resultType);
+          case TypeKind::DOUBLE:
+            return std::make_unique<
+                exec::SimpleAggregateAdapter<TAggregate<double, double>>>(
+                resultType);
+          default:
+            VELOX_UNREACHABLE("Unexpected type for {}", name);
+        }
+      },
+      false /*registerCompanionFunctions*/,
+      true /*overwrite*/);
+}
+
 class SimpleAggregatesBenchmark : public HiveConnectorTestBase {
  public:
   SimpleAggregatesBenchmark() {
@@ -267,11 +382,20 @@ AGG_BENCHMARKS(stddev, k_norm)
 AGG_BENCHMARKS(stddev, k_hash)
 BENCHMARK_DRAW_LINE();
 
+// Sum written with the simple aggregate interface, row by row and batched.
+AGG_BENCHMARKS(simple_sum, k_array)
+AGG_BENCHMARKS(simple_batch_sum, k_array)
+AGG_BENCHMARKS(simple_sum, k_hash)
+AGG_BENCHMARKS(simple_batch_sum, k_hash)
+BENCHMARK_DRAW_LINE();
+
 } // namespace
 
 int main(int argc, char** argv) {
   folly::Init init{&argc, &argv};
   OperatorTestBase::SetUpTestCase();
+  registerSimpleSum<SimpleSumAggregate>("simple_sum");
+  registerSimpleSum<SimpleBatchSumAggregate>("simple_batch_sum");
   benchmark = std::make_unique<SimpleAggregatesBenchmark>();
   folly::runBenchmarks();
   benchmark.reset();
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+static constexpr int32_t kNumPartitions = 10;
+static constexpr int32_t kRowsPerPartition = 100'000;
+static constexpr int32_t kRowsPerVector = 10'000;
+
+namespace {
+
+// Compares aggregate window functions over large partitions with sliding
+// frames computed from all the rows of each frame and from a segment tree of
+// partial aggregates.
+class WindowAggregatesBenchmark : public OperatorTestBase {
+ public:
+  WindowAggregatesBenchmark() {
+    OperatorTestBase::SetUp();
+    aggregate::prestosql::registerAllAggregateFunctions();
+
+    const auto numRows = kNumPartitions * kRowsPerPartition;
+    for (auto offset = 0; offset < numRows; offset += kRowsPerVector) {
+      vectors_.push_back(makeRowVector({
+          makeFlatVector<int32_t>(
+              kRowsPerVector,
+              [&](auto row) { return (offset + row) / kRowsPerPartition; }),
+          makeFlatVector<int32_t>(
+              kRowsPerVector, [&](auto row) { return offset + row; }),
+          makeFlatVector<int64_t>(
+              kRowsPerVector,
+              [&](auto row) { return (offset + row) % 1'000; },
+              nullEvery(17)),
+      }));
+    }
+  }
+
+  ~WindowAggregatesBenchmark() override {
+    OperatorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  void run(
+      const std::string& function,
+      int32_t numPreceding,
+      bool segmentTree) {
+    folly::BenchmarkSuspender suspender;
+    auto plan = PlanBuilder()
+                    .values(vectors_)
+                    .window({fmt::format(
+                        "{} over (partition by c0 order by c1 "
+                        "rows between {} preceding and current row)",
+                        function,
+                        numPreceding)})
+                    .planNode();
+    suspender.dismiss();
+
+    auto result =
+        AssertQueryBuilder(plan)
+            .config(
+                core::QueryConfig::kWindowSegmentTreeMinFrameSize,
+                segmentTree ? "64" : "0")
+            .copyResults(pool());
+    folly::doNotOptimizeAway(result);
+  }
+
+ private:
+  std::vector<RowVectorPtr> vectors_;
+};
+
+std::unique_ptr<WindowAggregatesBenchmark> benchmark;
+
+BENCHMARK(sum100Rows) {
+  benchmark->run("sum(c2)", 100, false);
+}
+
+BENCHMARK_RELATIVE(sum100RowsSegmentTree) {
+  benchmark->run("sum(c2)", 100, true);
+}
+
+BENCHMARK(sum1000Rows) {
+  benchmark->run("sum(c2)", 1'000, false);
+}
+
+BENCHMARK_RELATIVE(sum1000RowsSegmentTree) {
+  benchmark->run("sum(c2)", 1'000, true);
+}
+
+BENCHMARK(max1000Rows) {
+  benchmark->run("max(c2)", 1'000, false);
+}
+
+BENCHMARK_RELATIVE(max1000RowsSegmentTree) {
+  benchmark->run("max(c2)", 1'000, true);
+}
+
+BENCHMARK(avg10000Rows) {
+  benchmark->run("avg(c2)", 10'000, false);
+}
+
+BENCHMARK_RELATIVE(avg10000RowsSegmentTree) {
+  benchmark->run("avg(c2)", 10'000, true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  OperatorTestBase::SetUpTestCase();
+  benchmark = std::make_unique<WindowAggregatesBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  OperatorTestBase::TearDownTestCase();
+  return 0;
+}
@@ -152,6 +152,27 @@ TEST_F(CountAggregationTest, mask) {
   EXPECT_LT(0, partialStats.at("abandonedPartialAggregation").count);
 }
 
+TEST_F(CountAggregationTest, clusteredGroups) {
+  // Runs of rows with the same key are counted in a local before being added
+  // to the group.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(1'000, [](auto row) { return row / 7; }),
+         makeFlatVector<int64_t>(
+             1'000,
+             [](auto row) { return row; },
+             [](auto row) { return row % 5 == 0 || row / 7 % 11 == 0; })}));
+  }
+  createDuckDbTable(vectors);
+
+  testAggregations(
+      vectors,
+      {"c0"},
+      {"count()", "count(c1)"},
+      "SELECT c0, count(1), count(c1) FROM tmp GROUP BY 1");
+}
+
 TEST_F(CountAggregationTest, distinct) {
   static const auto kNaN = std::numeric_limits<double>::quiet_NaN();
   static const auto kSNaN = std::numeric_limits<double>::signaling_NaN();
@@ -398,6 +398,28 @@ TEST_F(SumTest, nulls) {
       "SELECT c0, sum(c1) as sum_c1 FROM tmp GROUP BY 1");
 }
 
+TEST_F(SumTest, clusteredGroups) {
+  // Runs of rows with the same key of different lengths, including runs where
+  // all values are null, accumulate each run in a local.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(1'000, [](auto row) { return row / 7; }),
+         makeFlatVector<int64_t>(
+             1'000,
+             [](auto row) { return row * 3 - 1'000; },
+             [](auto row) { return row % 5 == 0 || row / 7 % 11 == 0; }),
+         makeFlatVector<double>(1'000, [](auto row) { return row * 0.1; })}));
+  }
+  createDuckDbTable(vectors);
+
+  testAggregations(
+      vectors,
+      {"c0"},
+      {"sum(c1)", "sum(c2)", "min(c1)", "max(c2)"},
+      "SELECT c0, sum(c1), sum(c2), min(c1), max(c2) FROM tmp GROUP BY 1");
+}
+
 TEST_F(SumTest, hook) {
   SumRow<int64_t> sumRow;
   sumRow.nulls = 1;
@@ -73,6 +73,31 @@ class InBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  // Runs IN with 'numValues' strings longer than the inline limit. About half
+  // of the rows match. The others have the same lengths and mostly the same
+  // prefix as the values in the list.
+  void runStrings(size_t numValues) {
+    folly::BenchmarkSuspender suspender;
+    std::vector<std::string> strings;
+    strings.reserve(1'000);
+    for (auto i = 0; i < 1'000; ++i) {
+      strings.push_back(
+          fmt::format("customer-{:08}", (i * 7'919) % (2 * numValues)));
+    }
+    auto data = vectorMaker_.rowVector({vectorMaker_.flatVector(strings)});
+
+    std::ostringstream inList;
+    for (auto i = 0; i < numValues; ++i) {
+      inList << (i > 0 ? ", " : "") << fmt::format("'customer-{:08}'", i);
+    }
+
+    auto sql = fmt::format("c0 IN ({})", inList.str());
+    auto exprSet = compileExpression(sql, data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 1000; i++) {
@@ -126,6 +151,26 @@ BENCHMARK_RELATIVE(in1K) {
   benchmark.run(1'000);
 }
 
+BENCHMARK(in10K) {
+  InBenchmark benchmark;
+  benchmark.run(10'000);
+}
+
+BENCHMARK(inStrings10) {
+  InBenchmark benchmark;
+  benchmark.runStrings(10);
+}
+
+BENCHMARK(inStrings1K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(1'000);
+}
+
+BENCHMARK(inStrings10K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(10'000);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
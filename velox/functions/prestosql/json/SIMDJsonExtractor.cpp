@@ -46,6 +46,15 @@ using JsonVector = std::vector<simdjson::ondemand::value>;
   return *it.first->second;
 }
 
+/* static */ std::unique_ptr<SIMDJsonExtractor> SIMDJsonExtractor::tryCreate(
+    folly::StringPiece path) {
+  std::unique_ptr<SIMDJsonExtractor> extractor(new SIMDJsonExtractor());
+  if (!extractor->tokenize(folly::trimWhitespace(path).str())) {
+    return nullptr;
+  }
+  return extractor;
+}
+
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
   thread_local static JsonPathTokenizer tokenizer;
 
@@ -57,7 +57,14 @@ class SIMDJsonExtractor {
   /// the callers of simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns a new extractor for 'path' that is not cached, or nullptr if
+  /// 'path' is not valid. Use it for extractors kept across calls, e.g. for
+  /// constant paths, as getInstance() may evict them.
+  static std::unique_ptr<SIMDJsonExtractor> tryCreate(folly::StringPiece path);
+
  private:
+  SIMDJsonExtractor() = default;
+
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
     if (!tokenize(path)) {
@@ -127,6 +134,26 @@ simdjson::error_code SIMDJsonExtractor::extract(
   return consumer(input);
 };
 
+/// Same as simdJsonExtract below on a document that is already parsed. The
+/// document is rewound first, so that it can be queried for several paths
+/// without parsing it again. If an error is returned, the document should be
+/// parsed again before the next call.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
+  jsonDoc.rewind();
+  if (extractor.isRootOnlyPath()) {
+    // If the path is just to return the original object, call consumer on the
+    // document.  Note, we cannot convert this to a value as this is not
+    // supported if the object is a scalar.
+    return consumer(jsonDoc);
+  }
+  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
+  return extractor.extract(value, std::forward<TConsumer>(consumer));
+}
+
 /**
  * Extract element(s) from a JSON object using the given path.
  * @param json: A JSON object
@@ -152,15 +179,7 @@ simdjson::error_code simdJsonExtract(
     TConsumer&& consumer) {
   simdjson::padded_string paddedJson(json.data(), json.size());
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-
-  if (extractor.isRootOnlyPath()) {
-    // If the path is just to return the original object, call consumer on the
-    // document.  Note, we cannot convert this to a value as this is not
-    // supported if the object is a scalar.
-    return consumer(jsonDoc);
-  }
-  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
-  return extractor.extract(value, std::forward<TConsumer>(consumer));
+  return simdJsonExtract(jsonDoc, extractor, std::forward<TConsumer>(consumer));
 }
 
 } // namespace facebook::velox::functions
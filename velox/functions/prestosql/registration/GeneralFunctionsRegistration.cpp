@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/expression/RegisterSpecialForm.h"
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/IsNull.h"
 #include "velox/functions/prestosql/Cardinality.h"
@@ -75,6 +76,7 @@ extern void registerSubscriptFunction(
 extern void registerElementAtFunction(
     const std::string& name,
     bool enableCaching);
+extern void registerMapSubscriptBatchFunction(const std::string& name);
 
 // Special form functions don't have any prefix.
 void registerAllSpecialFormGeneralFunctions() {
@@ -93,6 +95,18 @@ void registerGeneralFunctions(const std::string& prefix) {
   registerSubscriptFunction(prefix + "subscript", true);
   registerElementAtFunction(prefix + "element_at", true);
 
+  // Subscripts with different constant keys into the same map can be evaluated
+  // together, reading the keys of each map once.
+  registerMapSubscriptBatchFunction(prefix + "$internal$map_subscript_batch");
+  for (const auto& name : {"subscript", "element_at"}) {
+    exec::registerBatchableFunction(
+        prefix + name,
+        {prefix + "$internal$map_subscript_batch",
+         [](const TypePtr& inputType, const core::ConstantTypedExpr& key) {
+           return inputType->isMap() && key.type()->isPrimitiveType();
+         }});
+  }
+
   VELOX_REGISTER_VECTOR_FUNCTION(udf_transform, prefix + "transform");
   VELOX_REGISTER_VECTOR_FUNCTION(udf_reduce, prefix + "reduce");
   VELOX_REGISTER_VECTOR_FUNCTION(udf_array_filter, prefix + "filter");
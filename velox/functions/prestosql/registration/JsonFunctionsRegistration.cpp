@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 
@@ -31,6 +32,20 @@ void registerJsonFunctions(const std::string& prefix) {
   registerFunction<JsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
 
+  // Calls with the same json and different constant valid paths can be
+  // evaluated together, parsing each document once.
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$json_extract_scalar_batch,
+      prefix + "$internal$json_extract_scalar_batch");
+  exec::registerBatchableFunction(
+      prefix + "json_extract_scalar",
+      {prefix + "$internal$json_extract_scalar_batch",
+       [](const TypePtr& /*jsonType*/, const core::ConstantTypedExpr& path) {
+         return path.type()->isVarchar() &&
+             SIMDJsonExtractor::tryCreate(
+                 path.value().value<TypeKind::VARCHAR>()) != nullptr;
+       }});
+
   registerFunction<JsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
   registerFunction<JsonExtractFunction, Json, Varchar, Varchar>(
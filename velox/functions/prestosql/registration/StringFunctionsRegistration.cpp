@@ -136,6 +136,20 @@ void registerStringFunctions(const std::string& prefix) {
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
 
+  // Chains of regexp_like and like calls on the same string in OR and CASE
+  // are evaluated with a single multi-pattern search.
+  exec::registerStatefulVectorFunction(
+      prefix + "$internal$regexp_like_any",
+      re2SearchAnySignatures(),
+      makeRe2SearchAny);
+  exec::registerStatefulVectorFunction(
+      prefix + "$internal$regexp_like_first",
+      re2SearchFirstSignatures(),
+      makeRe2SearchFirst);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteRegexpLikeChain(prefix, expr);
+  });
+
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar, int64_t>(
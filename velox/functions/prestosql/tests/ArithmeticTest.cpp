@@ -116,6 +116,38 @@ TEST_F(ArithmeticTest, minus) {
   assertExpression("c0 - c1", op1, op2, expected);
 }
 
+TEST_F(ArithmeticTest, checkedArithmeticErrors) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({10, kLongMax, kLongMin, 7}),
+      makeFlatVector<int64_t>({0, 1, -1, 2}),
+  });
+
+  // Failures are reported without throwing per row, but still surface as
+  // arithmetic errors outside of TRY.
+  try {
+    evaluate("c0 / c1", data);
+    FAIL() << "Expected an error";
+  } catch (const VeloxUserError& e) {
+    ASSERT_EQ(e.errorCode(), error_code::kArithmeticError);
+    ASSERT_EQ(e.message(), "division by zero");
+  }
+
+  auto testTry = [&](const std::string& expression,
+                     const std::vector<std::optional<int64_t>>& expected) {
+    SCOPED_TRACE(expression);
+    test::assertEqualVectors(
+        makeNullableFlatVector<int64_t>(expected),
+        evaluate(fmt::format("try({})", expression), data));
+  };
+
+  testTry("c0 + c1", {10, std::nullopt, std::nullopt, 9});
+  testTry("c0 - c1", {10, kLongMax - 1, kLongMin + 1, 5});
+  testTry("c0 * c1", {0, kLongMax, std::nullopt, 14});
+  testTry("c0 / c1", {std::nullopt, kLongMax, std::nullopt, 3});
+  testTry("mod(c0, c1)", {std::nullopt, 0, 0, 1});
+  testTry("negate(c0)", {-10, -kLongMax, std::nullopt, -7});
+}
+
 TEST_F(ArithmeticTest, divide)
 #if defined(__has_feature)
 #if __has_feature(__address_sanitizer__)
@@ -197,3 +197,25 @@ TEST_F(ArrayDuplicatesTest, constant) {
   expected = makeConstantArray<int64_t>(size, {6});
   assertEqualVectors(expected, result);
 }
+
+// Test arrays that have more distinct values than fit the inline part of the
+// value set, followed by short arrays that reuse the set.
+TEST_F(ArrayDuplicatesTest, longArrays) {
+  std::vector<int64_t> allDistinct;
+  std::vector<int64_t> halfRepeated;
+  std::vector<int64_t> repeatedValues;
+  for (int64_t i = 0; i < 40; ++i) {
+    allDistinct.push_back(i);
+    halfRepeated.push_back(i);
+    if (i >= 20) {
+      halfRepeated.push_back(i);
+      halfRepeated.push_back(i);
+      repeatedValues.push_back(i);
+    }
+  }
+
+  auto array = makeArrayVector<int64_t>(
+      {halfRepeated, {3, 25, 3}, allDistinct, {0, 39}});
+  auto expected = makeArrayVector<int64_t>({repeatedValues, {3}, {}, {}});
+  testExpr(expected, "array_duplicates(C0)", {array});
+}
@@ -1766,6 +1766,50 @@ TEST_F(DateTimeFunctionsTest, dateTrunc) {
       dateTrunc("year", Timestamp(998'474'645, 321'001'234)));
 }
 
+// Time zone offsets are cached across the rows of a batch. Checks that batch
+// results across DST transitions match the results of evaluating row by row.
+TEST_F(DateTimeFunctionsTest, dateTruncAndFormatAcrossDstTransitions) {
+  setQueryTimeZone("America/Los_Angeles");
+
+  // Every 17 minutes from 2021-03-13 to 2021-03-16 and from 2021-11-06 to
+  // 2021-11-09 UTC.
+  std::vector<Timestamp> timestamps;
+  for (int64_t start : {1'615'593'600, 1'636'156'800}) {
+    for (int64_t seconds = start; seconds < start + 3 * 86'400;
+         seconds += 17 * 60) {
+      timestamps.emplace_back(seconds, 123);
+    }
+  }
+  auto data = makeRowVector({makeFlatVector(timestamps)});
+
+  for (const auto& expression :
+       {"date_trunc('hour', c0)",
+        "date_trunc('day', c0)",
+        "date_trunc('week', c0)"}) {
+    SCOPED_TRACE(expression);
+    auto result = evaluate<SimpleVector<Timestamp>>(expression, data);
+    for (auto i = 0; i < timestamps.size(); ++i) {
+      ASSERT_EQ(
+          evaluateOnce<Timestamp>(
+              expression, std::optional<Timestamp>(timestamps[i]))
+              .value(),
+          result->valueAt(i))
+          << timestamps[i].toString();
+    }
+  }
+
+  const auto expression = "format_datetime(c0, 'yyyy-MM-dd HH:mm ZZ')";
+  auto result = evaluate<SimpleVector<StringView>>(expression, data);
+  for (auto i = 0; i < timestamps.size(); ++i) {
+    ASSERT_EQ(
+        evaluateOnce<std::string>(
+            expression, std::optional<Timestamp>(timestamps[i]))
+            .value(),
+        result->valueAt(i).str())
+        << timestamps[i].toString();
+  }
+}
+
 TEST_F(DateTimeFunctionsTest, dateTruncDate) {
   const auto dateTrunc = [&](const std::string& unit,
                              std::optional<int32_t> date) {
@@ -115,6 +115,18 @@ TEST_F(DecimalArithmeticTest, add) {
        makeNullableFlatVector<int64_t>(
            {1, 2, 5, std::nullopt, std::nullopt}, DECIMAL(10, 3))});
 
+  // The largest values of types whose sum cannot overflow, with rescaling.
+  const auto maxDecimal20 = DecimalUtil::kPowersOfTen[20] - 1;
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          {maxDecimal20 * 1'000 + 9'999'999'999,
+           -maxDecimal20 * 1'000 - 9'999'999'999},
+          DECIMAL(24, 5)),
+      "c0 + c1",
+      {makeFlatVector<int128_t>({maxDecimal20, -maxDecimal20}, DECIMAL(20, 2)),
+       makeFlatVector<int64_t>(
+           {9'999'999'999, -9'999'999'999}, DECIMAL(10, 5))});
+
   // Addition overflow.
   VELOX_ASSERT_USER_THROW(
       testDecimalExpr<TypeKind::HUGEINT>(
@@ -270,6 +282,16 @@ TEST_F(DecimalArithmeticTest, multiply) {
   testDecimalExpr<TypeKind::BIGINT>(
       expectedConstantFlat, "c0 * 1.00", {shortFlat});
 
+  // The largest values of types whose product cannot overflow.
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          {HugeInt::parse("99999999999999999899000000000000000001")},
+          DECIMAL(38, 5)),
+      "c0 * c1",
+      {makeFlatVector<int128_t>(
+           {DecimalUtil::kPowersOfTen[20] - 1}, DECIMAL(20, 2)),
+       makeFlatVector<int64_t>({999'999'999'999'999'999}, DECIMAL(18, 3))});
+
   // Long decimal limits
   VELOX_ASSERT_USER_THROW(
       testDecimalExpr<TypeKind::HUGEINT>(
@@ -1182,3 +1182,82 @@ TEST_F(ElementAtTest, floatingPointCornerCases) {
   testFloatingPointCornerCases<float>();
   testFloatingPointCornerCases<double>();
 }
+
+// Subscripts with different constant keys into the same map are evaluated by a
+// single batched call and return the same results as separate calls.
+TEST_F(ElementAtTest, batchedMapSubscripts) {
+  std::string longMap = "{";
+  for (auto i = 0; i < 20; ++i) {
+    longMap += fmt::format("{}{}: {}.5", i == 0 ? "" : ", ", 19 - i, i);
+  }
+  longMap += "}";
+  auto data = makeRowVector({
+      makeMapVectorFromJson<int64_t, float>({
+          "{1: 1.5, 2: 2.5, 3: 3.5}",
+          "null",
+          "{}",
+          "{3: 30.5, 7: null}",
+          longMap,
+          "{5: 5.5, 1: 10.5}",
+      }),
+      makeMapVectorFromJson<std::string, int64_t>({
+          "{\"a\": 1, \"b\": 2}",
+          "{\"b\": 3}",
+          "null",
+          "{}",
+          "{\"c\": 4, \"a\": 5}",
+          "{\"a\": null}",
+      }),
+      makeArrayVector<int64_t>({{1}, {2}, {3}, {4}, {5}, {6}}),
+  });
+  const std::vector<std::string> expressions = {
+      "c0[1]",
+      "c0[2]",
+      "c0[3] + c0[1]",
+      "c0[7]",
+      "element_at(c0, 5)",
+      "element_at(c0, 19)",
+      "c1['a']",
+      "coalesce(c1['b'], c1['c'])",
+      // Array subscripts are not batched.
+      "c2[1]",
+      "element_at(c2, 1)",
+  };
+
+  auto evaluateAll = [&](exec::ExprSet& exprSet) {
+    exec::EvalCtx context(&execCtx_, &exprSet, data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(expressions.size());
+    exprSet.eval(rows, context, results);
+    return results;
+  };
+
+  queryCtx_->testingOverrideConfigUnsafe({});
+  auto separate = compileExpressions(expressions, asRowType(data->type()));
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprBatchFunctionCalls, "true"}});
+  auto batched = compileExpressions(expressions, asRowType(data->type()));
+
+  std::unordered_set<const exec::Expr*> batchedCalls;
+  std::function<void(const exec::ExprPtr&)> findBatched =
+      [&](const exec::ExprPtr& expr) {
+        if (expr->name() == "$internal$map_subscript_batch") {
+          batchedCalls.insert(expr.get());
+        }
+        for (const auto& input : expr->inputs()) {
+          findBatched(input);
+        }
+      };
+  for (const auto& expr : batched->exprs()) {
+    findBatched(expr);
+  }
+  // c0 with subscript, c0 with element_at and c1 with subscript.
+  ASSERT_EQ(batchedCalls.size(), 3);
+
+  auto expected = evaluateAll(*separate);
+  auto actual = evaluateAll(*batched);
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    velox::test::assertEqualVectors(expected[i], actual[i]);
+  }
+}
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/Expr.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -235,6 +236,65 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+// Calls on the same json with different valid paths share one parse of each
+// document and return the same results as separate calls.
+TEST_F(JsonExtractScalarTest, batchedPaths) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {R"({"a": 1, "b": "x", "c": {"d": true}})",
+       std::nullopt,
+       R"({"a": [1, 2], "b": null, "c": {"d": 1.5}})",
+       R"({"a": "a long string value", "b": )",
+       R"(123)",
+       R"({"c": {"d": [1]}, "a": 2, "b": "y"})"},
+      JSON())});
+  const std::vector<std::string> expressions = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b')",
+      "json_extract_scalar(c0, '$.c.d')",
+      "concat(json_extract_scalar(c0, '$.b'), json_extract_scalar(c0, '$.a'))",
+      "json_extract_scalar(c0, '$')",
+      // Invalid paths are not batched.
+      "try(json_extract_scalar(c0, '$.a]'))",
+  };
+
+  auto evaluateAll = [&](exec::ExprSet& exprSet) {
+    exec::EvalCtx context(&execCtx_, &exprSet, data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(expressions.size());
+    exprSet.eval(rows, context, results);
+    return results;
+  };
+
+  queryCtx_->testingOverrideConfigUnsafe({});
+  auto separate = compileExpressions(expressions, asRowType(data->type()));
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprBatchFunctionCalls, "true"}});
+  auto batched = compileExpressions(expressions, asRowType(data->type()));
+
+  std::unordered_set<const exec::Expr*> batchedCalls;
+  std::function<void(const exec::ExprPtr&)> findBatched =
+      [&](const exec::ExprPtr& expr) {
+        if (expr->name() == "$internal$json_extract_scalar_batch") {
+          batchedCalls.insert(expr.get());
+        }
+        for (const auto& input : expr->inputs()) {
+          findBatched(input);
+        }
+      };
+  for (const auto& expr : batched->exprs()) {
+    findBatched(expr);
+  }
+  ASSERT_EQ(batchedCalls.size(), 1);
+  ASSERT_EQ((*batchedCalls.begin())->type()->size(), 4);
+
+  auto expected = evaluateAll(*separate);
+  auto actual = evaluateAll(*batched);
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    velox::test::assertEqualVectors(expected[i], actual[i]);
+  }
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -269,3 +269,69 @@ TEST_F(ReduceTest, limit) {
       {123 * 1'000, 123 * 9'000, std::nullopt, 123 * 10, std::nullopt});
   assertEqualVectors(expected, result);
 }
+
+// Sums and products of the state and the elements are evaluated without the
+// interpreter. Verify these against equivalent lambdas that are interpreted.
+TEST_F(ReduceTest, sumAndProduct) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeArrayVector<int64_t>(
+          size,
+          modN(7),
+          [](vector_size_t i) { return i % 7 - 3; },
+          nullEvery(11),
+          nullEvery(13)),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 3 - 1; }, nullEvery(17)),
+      makeArrayVector<double>(
+          size,
+          modN(7),
+          [](vector_size_t i) { return i * 0.1; },
+          nullEvery(11),
+          nullEvery(13)),
+  });
+
+  auto testReduce = [&](const std::string& array,
+                        const std::string& initialState,
+                        const std::string& lambda,
+                        const std::string& interpretedLambda) {
+    SCOPED_TRACE(fmt::format("{}: {}", array, lambda));
+    auto expected = evaluate(
+        fmt::format(
+            "reduce({}, {}, {}, s -> s)",
+            array,
+            initialState,
+            interpretedLambda),
+        data);
+    auto result = evaluate(
+        fmt::format("reduce({}, {}, {}, s -> s)", array, initialState, lambda),
+        data);
+    assertEqualVectors(expected, result);
+  };
+
+  // Adding zero and multiplying by one keep the lambda from being recognized.
+  for (const auto& [array, initialState, zero, one] :
+       {std::tuple{"c0", "c1", "0", "1"},
+        std::tuple{"c2", "0.5", "0.0", "1.0"}}) {
+    const std::string plusZero = fmt::format("(s, x) -> s + x + {}", zero);
+    const std::string timesOne = fmt::format("(s, x) -> s * x * {}", one);
+    testReduce(array, initialState, "(s, x) -> s + x", plusZero);
+    testReduce(array, initialState, "(s, x) -> x + s", plusZero);
+    testReduce(array, initialState, "(s, x) -> s * x", timesOne);
+    testReduce(array, initialState, "(s, x) -> x * s", timesOne);
+  }
+
+  // Integer overflow fails the row.
+  data = makeRowVector({
+      makeArrayVector<int64_t>({
+          {1, 2},
+          {std::numeric_limits<int64_t>::max(), 1},
+      }),
+  });
+  VELOX_ASSERT_THROW(
+      evaluate("reduce(c0, 0, (s, x) -> s + x, s -> s)", data),
+      "integer overflow");
+  auto result = evaluate("try(reduce(c0, 0, (s, x) -> s + x, s -> s))", data);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({3, std::nullopt}), result);
+}
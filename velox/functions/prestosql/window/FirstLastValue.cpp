@@ -47,6 +47,10 @@ class FirstLastValueFunction : public exec::WindowFunction {
     partition_ = partition;
   }
 
+  RowAccess rowAccess() const override {
+    return RowAccess::kFrame;
+  }
+
   void apply(
       const BufferPtr& /*peerGroupStarts*/,
       const BufferPtr& /*peerGroupEnds*/,
@@ -143,6 +143,37 @@ TEST_F(AggregateWindowTest, rangeFrames) {
   }
 }
 
+// Tests large sliding frames that are computed from a segment tree of partial
+// aggregates.
+TEST_F(AggregateWindowTest, largeFrames) {
+  const vector_size_t size = 9'000;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row / 3'000; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 101 - 50; }, nullEvery(13)),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 500 + 1; }),
+  });
+  const std::vector<std::string> frameClauses = {
+      "rows between 200 preceding and current row",
+      "rows between 100 preceding and 300 following",
+      "rows between 1000 preceding and 1000 following",
+      "rows between c3 preceding and c3 following",
+  };
+  auto aggregateFunctions = kAggregateFunctions;
+  aggregateFunctions.push_back("array_agg(c2)");
+  bool createTable = true;
+  for (const auto& function : aggregateFunctions) {
+    WindowTestBase::testWindowFunction(
+        {input},
+        function,
+        {"partition by c0 order by c1"},
+        frameClauses,
+        createTable);
+    createTable = false;
+  }
+}
+
 TEST_F(AggregateWindowTest, rangeNullsOrder) {
   auto c0 = makeNullableFlatVector<int64_t>({1, 2, 1, std::nullopt});
   auto input = makeRowVector({c0});
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/sparksql/MightContain.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/expression/DecodedArgs.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+class BloomFilterMightContainFunction : public exec::VectorFunction {
+ public:
+  // 'serialized' is the constant bloom filter argument or nullptr if it is not
+  // constant. A filter that is not constant is treated as empty.
+  explicit BloomFilterMightContainFunction(const VectorPtr& serialized) {
+    if (serialized != nullptr && !serialized->isNullAt(0)) {
+      bloomFilter_.merge(
+          serialized->as<ConstantVector<StringView>>()->valueAt(0).data());
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /*outputType*/,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    context.ensureWritable(rows, BOOLEAN(), result);
+    auto* rawResult =
+        result->asUnchecked<FlatVector<bool>>()->mutableRawValues<uint64_t>();
+
+    if (!bloomFilter_.isSet()) {
+      rows.applyToSelected(
+          [&](vector_size_t row) { bits::clearBit(rawResult, row); });
+      return;
+    }
+
+    exec::DecodedArgs decodedArgs(rows, {args[1]}, context);
+    const auto* values = decodedArgs.at(0);
+
+    // Hashes the selected rows into a dense array, tests them together and
+    // copies the outcome back to the positions of the rows.
+    const auto numRows = rows.countSelected();
+    std::vector<uint64_t> hashes(numRows);
+    vector_size_t index = 0;
+    rows.applyToSelected([&](vector_size_t row) {
+      hashes[index++] =
+          folly::hasher<int64_t>()(values->valueAt<int64_t>(row));
+    });
+
+    std::vector<uint64_t> found(bits::nwords(numRows));
+    bloomFilter_.mayContain(hashes.data(), numRows, found.data());
+
+    index = 0;
+    rows.applyToSelected([&](vector_size_t row) {
+      bits::setBit(rawResult, row, bits::isBitSet(found.data(), index++));
+    });
+  }
+
+ private:
+  BloomFilter<> bloomFilter_;
+};
+
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& /*name*/,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_EQ(inputArgs.size(), 2);
+  return std::make_shared<BloomFilterMightContainFunction>(
+      inputArgs[0].constantValue);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures() {
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varbinary")
+              .argumentType("bigint")
+              .build()};
+}
+
+} // namespace facebook::velox::functions::sparksql
@@ -55,6 +55,10 @@ struct BloomFilterAccumulator {
     bloomFilter.insert(folly::hasher<int64_t>()(value));
   }
 
+  void insert(const uint64_t* hashes, int32_t size) {
+    bloomFilter.insert(hashes, size);
+  }
+
   BloomFilter<StlAllocator<uint64_t>> bloomFilter;
 };
 
@@ -139,13 +143,18 @@ class BloomFilterAggAggregate : public exec::Aggregate {
       accumulator->insert(decodedRaw_.valueAt<int64_t>(0));
       return;
     }
+    // Hashes all rows first and inserts them together.
     auto mayHaveNulls = decodedRaw_.mayHaveNulls();
+    hashes_.resize(rows.countSelected());
+    vector_size_t index = 0;
     rows.applyToSelected([&](vector_size_t row) {
       if (mayHaveNulls) {
         checkBloomFilterNotNull(decodedRaw_, row);
       }
-      accumulator->insert(decodedRaw_.valueAt<int64_t>(row));
+      hashes_[index++] =
+          folly::hasher<int64_t>()(decodedRaw_.valueAt<int64_t>(row));
     });
+    accumulator->insert(hashes_.data(), hashes_.size());
   }
 
   void addSingleGroupIntermediateResults(
@@ -281,6 +290,10 @@ class BloomFilterAggAggregate : public exec::Aggregate {
   // Reusable instance of DecodedVector for decoding input vectors.
   DecodedVector decodedRaw_;
   DecodedVector decodedIntermediate_;
+
+  // Reusable buffer for the hashes of the input rows of a single group.
+  std::vector<uint64_t> hashes_;
+
   int64_t estimatedNumItems_ = kMissingArgument;
   int64_t numBits_ = kMissingArgument;
   int32_t capacity_ = kMissingArgument;
@@ -495,6 +495,34 @@ TEST_F(FunctionRegistryTest, functionNameInMixedCase) {
   ASSERT_EQ(*result, *VARCHAR());
 }
 
+TEST_F(FunctionRegistryTest, resolveAfterOverwrite) {
+  // Resolutions are cached. Registering a function again must not return the
+  // previous resolution.
+  testResolveVectorFunction("vector_func_overwrite", {VARCHAR()}, nullptr);
+
+  exec::registerVectorFunction(
+      "vector_func_overwrite",
+      VectorFuncOne::signatures(),
+      std::make_unique<VectorFuncOne>());
+  testResolveVectorFunction("vector_func_overwrite", {VARCHAR()}, BIGINT());
+  testResolveVectorFunction(
+      "vector_func_overwrite", {ARRAY(VARCHAR())}, nullptr);
+
+  exec::registerVectorFunction(
+      "vector_func_overwrite",
+      VectorFuncTwo::signatures(),
+      std::make_unique<VectorFuncTwo>());
+  testResolveVectorFunction("vector_func_overwrite", {VARCHAR()}, nullptr);
+  testResolveVectorFunction(
+      "vector_func_overwrite", {ARRAY(VARCHAR())}, ARRAY(BIGINT()));
+
+  auto result = resolveFunction("func_overwrite", {BIGINT()});
+  ASSERT_EQ(result, nullptr);
+  registerFunction<FuncFive, int64_t, int64_t>({"func_overwrite"});
+  result = resolveFunction("func_overwrite", {BIGINT()});
+  ASSERT_EQ(*result, *BIGINT());
+}
+
 template <typename T>
 struct TestFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -479,6 +479,198 @@ int32_t CompactRow::serializeVariableWidth(vector_size_t index, char* buffer) {
 
 namespace {
 
+// Copies 'kBytes' wide values at 'indices' of 'decoded' to the rows starting at
+// 'buffer + offsets[i]', at 'valueOffset(i)' bytes from the start of each row.
+template <size_t kBytes, typename ValueOffset>
+void copyFixedWidthValues(
+    const DecodedVector& decoded,
+    folly::Range<const vector_size_t*> indices,
+    const size_t* offsets,
+    ValueOffset valueOffset,
+    char* buffer) {
+  const auto* values = decoded.data<char>();
+  // 'values' can be null if all values are null.
+  if (values == nullptr) {
+    return;
+  }
+  const bool mayHaveNulls = decoded.mayHaveNulls();
+  for (auto i = 0; i < indices.size(); ++i) {
+    if (mayHaveNulls && decoded.isNullAt(indices[i])) {
+      continue;
+    }
+    memcpy(
+        buffer + offsets[i] + valueOffset(i),
+        values + decoded.index(indices[i]) * kBytes,
+        kBytes);
+  }
+}
+
+// Returns the indices of 'rows' in the base vector of 'decoded'.
+std::vector<vector_size_t> baseIndices(
+    const DecodedVector& decoded,
+    folly::Range<const vector_size_t*> rows) {
+  std::vector<vector_size_t> indices(rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    indices[i] = decoded.index(rows[i]);
+  }
+  return indices;
+}
+} // namespace
+
+template <typename ValueOffset>
+void CompactRow::serializeFixedWidthColumn(
+    folly::Range<const vector_size_t*> indices,
+    const size_t* offsets,
+    ValueOffset valueOffset,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  // Writes one value at a time.
+  auto serializeFixedWidthValues = [&]() {
+    const bool mayHaveNulls = decoded_.mayHaveNulls();
+    for (auto i = 0; i < indices.size(); ++i) {
+      if (mayHaveNulls && isNullAt(indices[i])) {
+        continue;
+      }
+      serializeFixedWidth(indices[i], buffer + offsets[i] + valueOffset(i));
+    }
+  };
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      [[fallthrough]];
+    case TypeKind::TIMESTAMP:
+      serializeFixedWidthValues();
+      break;
+    default:
+      // Dispatches on the value width once per column so that the copies
+      // compile to fixed size loads and stores.
+      switch (valueBytes_) {
+        case 0:
+          break;
+        case 1:
+          copyFixedWidthValues<1>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        case 2:
+          copyFixedWidthValues<2>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        case 4:
+          copyFixedWidthValues<4>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        case 8:
+          copyFixedWidthValues<8>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        case 16:
+          copyFixedWidthValues<16>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        default:
+          serializeFixedWidthValues();
+      }
+  }
+}
+
+void CompactRow::rowSizes(
+    folly::Range<const vector_size_t*> rows,
+    int32_t* sizes) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + rows.size(), fixedSize);
+
+  const auto childIndices = baseIndices(decoded_, rows);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    const bool isString = child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY;
+    for (auto j = 0; j < rows.size(); ++j) {
+      const auto childIndex = childIndices[j];
+      if (mayHaveNulls && child.isNullAt(childIndex)) {
+        continue;
+      }
+      if (isString) {
+        sizes[j] +=
+            kSizeBytes + child.decoded_.valueAt<StringView>(childIndex).size();
+      } else {
+        sizes[j] += child.variableWidthRowSize(childIndex);
+      }
+    }
+  }
+}
+
+void CompactRow::serialize(
+    folly::Range<const vector_size_t*> rows,
+    const size_t* offsets,
+    char* buffer) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  const auto childIndices = baseIndices(decoded_, rows);
+  const folly::Range<const vector_size_t*> indices(
+      childIndices.data(), childIndices.size());
+
+  // Offset of the next value in each row. Only differs between rows after a
+  // variable-width field.
+  int32_t fixedOffset = rowNullBytes_;
+  std::vector<int32_t> valueOffsets;
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+
+    // Write null bits. Skipped for columns without nulls.
+    if (child.decoded_.mayHaveNulls()) {
+      for (auto j = 0; j < rows.size(); ++j) {
+        if (child.isNullAt(childIndices[j])) {
+          bits::setBit(reinterpret_cast<uint8_t*>(buffer + offsets[j]), i);
+        }
+      }
+    }
+
+    if (childIsFixedWidth_[i]) {
+      if (valueOffsets.empty()) {
+        child.serializeFixedWidthColumn(
+            indices,
+            offsets,
+            [&](auto /*row*/) { return fixedOffset; },
+            buffer);
+        fixedOffset += child.valueBytes_;
+      } else {
+        child.serializeFixedWidthColumn(
+            indices,
+            offsets,
+            [&](auto row) { return valueOffsets[row]; },
+            buffer);
+        for (auto& offset : valueOffsets) {
+          offset += child.valueBytes_;
+        }
+      }
+      continue;
+    }
+
+    if (valueOffsets.empty()) {
+      valueOffsets.resize(rows.size(), fixedOffset);
+    }
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    for (auto j = 0; j < rows.size(); ++j) {
+      if (mayHaveNulls && child.isNullAt(childIndices[j])) {
+        continue;
+      }
+      valueOffsets[j] += child.serializeVariableWidth(
+          childIndices[j], buffer + offsets[j] + valueOffsets[j]);
+    }
+  }
+}
+
+namespace {
+
 // Reads single fixed-width value from buffer into flatVector[index].
 template <typename T>
 void readFixedWidthValue(
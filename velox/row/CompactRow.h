@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Range.h>
+
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
 
@@ -36,6 +38,20 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Sets 'sizes[i]' to the serialized size of the row at 'rows[i]'. Computes
+  /// the sizes one column at a time. Use only if 'fixedRowSize' returned
+  /// std::nullopt.
+  void rowSizes(folly::Range<const vector_size_t*> rows, int32_t* sizes);
+
+  /// Serializes the rows at 'rows' one column at a time. The row at 'rows[i]'
+  /// is written at 'buffer + offsets[i]'. Produces the same bytes as
+  /// serializing each row with 'serialize(index, buffer)'. 'buffer' must have
+  /// sufficient capacity and set to all zeros.
+  void serialize(
+      folly::Range<const vector_size_t*> rows,
+      const size_t* offsets,
+      char* buffer);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -64,6 +80,16 @@ class CompactRow {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes fixed-width values at 'indices' into the rows starting at
+  /// 'buffer + offsets[i]', at 'valueOffset(i)' bytes from the start of each
+  /// row. Skips null values.
+  template <typename ValueOffset>
+  void serializeFixedWidthColumn(
+      folly::Range<const vector_size_t*> indices,
+      const size_t* offsets,
+      ValueOffset valueOffset,
+      char* buffer);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
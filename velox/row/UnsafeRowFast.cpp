@@ -214,6 +214,178 @@ int32_t UnsafeRowFast::serializeVariableWidth(
   };
 }
 
+namespace {
+
+// Copies 'kBytes' wide values at 'indices' of 'decoded' to the rows starting at
+// 'buffer + offsets[i]', at 'valueOffset(i)' bytes from the start of each row.
+template <size_t kBytes, typename ValueOffset>
+void copyFixedWidthValues(
+    const DecodedVector& decoded,
+    folly::Range<const vector_size_t*> indices,
+    const size_t* offsets,
+    ValueOffset valueOffset,
+    char* buffer) {
+  const auto* values = decoded.data<char>();
+  // 'values' can be null if all values are null.
+  if (values == nullptr) {
+    return;
+  }
+  const bool mayHaveNulls = decoded.mayHaveNulls();
+  for (auto i = 0; i < indices.size(); ++i) {
+    if (mayHaveNulls && decoded.isNullAt(indices[i])) {
+      continue;
+    }
+    memcpy(
+        buffer + offsets[i] + valueOffset(i),
+        values + decoded.index(indices[i]) * kBytes,
+        kBytes);
+  }
+}
+
+// Returns the indices of 'rows' in the base vector of 'decoded'.
+std::vector<vector_size_t> baseIndices(
+    const DecodedVector& decoded,
+    folly::Range<const vector_size_t*> rows) {
+  std::vector<vector_size_t> indices(rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    indices[i] = decoded.index(rows[i]);
+  }
+  return indices;
+}
+} // namespace
+
+template <typename ValueOffset>
+void UnsafeRowFast::serializeFixedWidthColumn(
+    folly::Range<const vector_size_t*> indices,
+    const size_t* offsets,
+    ValueOffset valueOffset,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  // Writes one value at a time.
+  auto serializeFixedWidthValues = [&]() {
+    const bool mayHaveNulls = decoded_.mayHaveNulls();
+    for (auto i = 0; i < indices.size(); ++i) {
+      if (mayHaveNulls && isNullAt(indices[i])) {
+        continue;
+      }
+      serializeFixedWidth(indices[i], buffer + offsets[i] + valueOffset(i));
+    }
+  };
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      [[fallthrough]];
+    case TypeKind::TIMESTAMP:
+      serializeFixedWidthValues();
+      break;
+    default:
+      // Dispatches on the value width once per column so that the copies
+      // compile to fixed size loads and stores.
+      switch (valueBytes_) {
+        case 0:
+          break;
+        case 1:
+          copyFixedWidthValues<1>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        case 2:
+          copyFixedWidthValues<2>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        case 4:
+          copyFixedWidthValues<4>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        case 8:
+          copyFixedWidthValues<8>(
+              decoded_, indices, offsets, valueOffset, buffer);
+          break;
+        default:
+          serializeFixedWidthValues();
+      }
+  }
+}
+
+void UnsafeRowFast::rowSizes(
+    folly::Range<const vector_size_t*> rows,
+    int32_t* sizes) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  std::fill(
+      sizes, sizes + rows.size(), rowNullBytes_ + children_.size() * kFieldWidth);
+
+  const auto childIndices = baseIndices(decoded_, rows);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    for (auto j = 0; j < rows.size(); ++j) {
+      const auto childIndex = childIndices[j];
+      if (mayHaveNulls && child.isNullAt(childIndex)) {
+        continue;
+      }
+      sizes[j] += alignBytes(child.variableWidthRowSize(childIndex));
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    folly::Range<const vector_size_t*> rows,
+    const size_t* offsets,
+    char* buffer) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  const auto childIndices = baseIndices(decoded_, rows);
+  const folly::Range<const vector_size_t*> indices(
+      childIndices.data(), childIndices.size());
+
+  // Offset of the next variable-width value in each row.
+  std::vector<int64_t> variableWidthOffsets;
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+
+    // Write null bits. Skipped for columns without nulls.
+    if (child.decoded_.mayHaveNulls()) {
+      for (auto j = 0; j < rows.size(); ++j) {
+        if (child.isNullAt(childIndices[j])) {
+          bits::setBit(buffer + offsets[j], i, true);
+        }
+      }
+    }
+
+    // Write values. Fixed-width values are at the same offset in all rows.
+    const int32_t fieldOffset = rowNullBytes_ + i * kFieldWidth;
+    if (childIsFixedWidth_[i]) {
+      child.serializeFixedWidthColumn(
+          indices,
+          offsets,
+          [&](auto /*row*/) { return fieldOffset; },
+          buffer);
+      continue;
+    }
+
+    if (variableWidthOffsets.empty()) {
+      variableWidthOffsets.resize(
+          rows.size(), rowNullBytes_ + kFieldWidth * children_.size());
+    }
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    for (auto j = 0; j < rows.size(); ++j) {
+      if (mayHaveNulls && child.isNullAt(childIndices[j])) {
+        continue;
+      }
+      auto* row = buffer + offsets[j];
+      auto& variableWidthOffset = variableWidthOffsets[j];
+      auto size = child.serializeVariableWidth(
+          childIndices[j], row + variableWidthOffset);
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | size;
+      reinterpret_cast<uint64_t*>(row + rowNullBytes_)[i] = sizeAndOffset;
+
+      variableWidthOffset += alignBytes(size);
+    }
+  }
+}
+
 int32_t UnsafeRowFast::arrayRowSize(vector_size_t index) {
   auto baseIndex = decoded_.index(index);
 
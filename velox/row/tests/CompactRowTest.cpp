@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include "velox/row/CompactRow.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -78,6 +80,43 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
+
+    testBatchSerialize(row, rowType, numRows, serialized);
+  }
+
+  // Verifies that serializing all rows at once produces the same bytes as
+  // 'serialized', which has the rows serialized one at a time.
+  void testBatchSerialize(
+      CompactRow& row,
+      const RowTypePtr& rowType,
+      vector_size_t numRows,
+      const std::vector<std::string_view>& serialized) {
+    std::vector<vector_size_t> rows(numRows);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::vector<int32_t> rowSizes(numRows);
+    if (auto fixedRowSize = CompactRow::fixedRowSize(rowType)) {
+      std::fill(rowSizes.begin(), rowSizes.end(), fixedRowSize.value());
+    } else {
+      row.rowSizes(folly::Range(rows.data(), rows.size()), rowSizes.data());
+    }
+
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(rowSizes[i], serialized[i].size()) << "Row " << i;
+      offsets[i] = totalSize;
+      totalSize += rowSizes[i];
+    }
+
+    BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    auto* rawBuffer = buffer->asMutable<char>();
+    row.serialize(
+        folly::Range(rows.data(), rows.size()), offsets.data(), rawBuffer);
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(
+          serialized[i], std::string_view(rawBuffer + offsets[i], rowSizes[i]))
+          << "Row " << i;
+    }
   }
 };
 
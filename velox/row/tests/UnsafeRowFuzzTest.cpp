@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include <folly/Random.h>
 #include <folly/init/Init.h>
 
@@ -97,8 +99,8 @@ class UnsafeRowFuzzTests : public ::testing::Test {
       memory::memoryManager()->addLeafPool();
 };
 
-TEST_F(UnsafeRowFuzzTests, fast) {
-  auto rowType = ROW({
+RowTypePtr fuzzRowType() {
+  return ROW({
       BOOLEAN(),
       TINYINT(),
       SMALLINT(),
@@ -161,8 +163,10 @@ TEST_F(UnsafeRowFuzzTests, fast) {
       ARRAY({ROW({BIGINT(), VARCHAR()})}),
       MAP(BIGINT(), ROW({BOOLEAN(), TINYINT(), REAL()})),
   });
+}
 
-  doTest(rowType, [&](const RowVectorPtr& data) {
+TEST_F(UnsafeRowFuzzTests, fast) {
+  doTest(fuzzRowType(), [&](const RowVectorPtr& data) {
     std::vector<std::optional<std::string_view>> serialized;
     serialized.reserve(data->size());
 
@@ -179,5 +183,43 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, fastBatch) {
+  std::vector<BufferPtr> buffers;
+  doTest(fuzzRowType(), [&](const RowVectorPtr& data) {
+    UnsafeRowFast fast(data);
+    std::vector<vector_size_t> rows(data->size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::vector<int32_t> rowSizes(rows.size());
+    fast.rowSizes(folly::Range(rows.data(), rows.size()), rowSizes.data());
+
+    std::vector<size_t> offsets(rows.size());
+    size_t totalSize = 0;
+    for (auto i = 0; i < rows.size(); ++i) {
+      EXPECT_EQ(rowSizes[i], fast.rowSize(i)) << i << ", " << data->toString(i);
+      offsets[i] = totalSize;
+      totalSize += rowSizes[i];
+    }
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool_.get(), 0);
+    auto* rawBuffer = buffer->asMutable<char>();
+    fast.serialize(
+        folly::Range(rows.data(), rows.size()), offsets.data(), rawBuffer);
+    buffers.push_back(buffer);
+
+    // The batch produces the same bytes as serializing one row at a time.
+    std::vector<std::optional<std::string_view>> serialized;
+    serialized.reserve(data->size());
+    for (auto i = 0; i < rows.size(); ++i) {
+      auto rowSize = fast.serialize(i, buffers_[i]);
+      EXPECT_EQ(
+          std::string_view(buffers_[i], rowSize),
+          std::string_view(rawBuffer + offsets[i], rowSizes[i]))
+          << i << ", " << data->toString(i);
+      serialized.push_back(
+          std::string_view(rawBuffer + offsets[i], rowSizes[i]));
+    }
+    return serialized;
+  });
+}
+
 } // namespace
 } // namespace facebook::velox::row
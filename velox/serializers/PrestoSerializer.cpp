@@ -1594,6 +1594,11 @@ class VectorStream {
     return isConstantStream_;
   }
 
+  /// Returns the number of values appended to 'this', including nulls.
+  int32_t numValues() const {
+    return nonNullCount_ + nullCount_;
+  }
+
   VectorStream* childAt(int32_t index) {
     return children_[index].get();
   }
@@ -2908,6 +2913,71 @@ void serializeColumn(
   }
 }
 
+// Appends 'rows' of 'vector' to the dictionary stream 'stream' that holds a
+// column of a page made of many RowVectors. The values referenced by 'rows'
+// are appended to the dictionary of the page once per call, and the indices
+// of the rows point into it. The dictionary entries are not shared across
+// calls as a base vector may be reused with different contents by the time of
+// the next call.
+void serializeToPageDictionary(
+    const VectorPtr& vector,
+    const folly::Range<const vector_size_t*>& rows,
+    VectorStream* stream,
+    Scratch& scratch) {
+  VELOX_DCHECK(stream->isDictionaryStream());
+  const auto numRows = rows.size();
+  if (numRows == 0) {
+    return;
+  }
+
+  // The vector whose values are added to the dictionary, and the row of it
+  // for each row of 'vector'.
+  const VectorPtr* base;
+  const vector_size_t* baseIndices{nullptr};
+  if (vector->encoding() == VectorEncoding::Simple::DICTIONARY &&
+      vector->rawNulls() == nullptr) {
+    base = &vector->valueVector();
+    baseIndices = vector->wrapInfo()->as<vector_size_t>();
+  } else {
+    base = &vector;
+  }
+  const bool isConstant =
+      vector->encoding() == VectorEncoding::Simple::CONSTANT;
+  auto baseIndex = [&](vector_size_t row) -> vector_size_t {
+    if (isConstant) {
+      return 0;
+    }
+    return baseIndices != nullptr ? baseIndices[row] : row;
+  };
+
+  const auto baseSize = isConstant ? 1 : (*base)->size();
+  ScratchPtr<vector_size_t, 64> entriesHolder(scratch);
+  ScratchPtr<vector_size_t, 64> newBaseRowsHolder(scratch);
+  auto* entries = entriesHolder.get(baseSize);
+  std::fill(entries, entries + baseSize, -1);
+  auto* newBaseRows = newBaseRowsHolder.get(std::min(baseSize, numRows));
+  auto* dictionary = stream->childAt(0);
+  const auto firstEntry = dictionary->numValues();
+  int32_t numNewEntries{0};
+  for (auto i = 0; i < numRows; ++i) {
+    const auto index = baseIndex(rows[i]);
+    if (entries[index] < 0) {
+      entries[index] = firstEntry + numNewEntries;
+      newBaseRows[numNewEntries++] = isConstant ? rows[i] : index;
+    }
+  }
+  serializeColumn(
+      *base,
+      folly::Range<const vector_size_t*>(newBaseRows, numNewEntries),
+      dictionary,
+      scratch);
+
+  stream->appendNonNull(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    stream->appendOne<int32_t>(entries[baseIndex(rows[i])]);
+  }
+}
+
 void expandRepeatedRanges(
     const BaseVector* vector,
     const vector_size_t* rawOffsets,
@@ -3535,6 +3605,8 @@ namespace {
 struct FlushSizes {
   int64_t uncompressedSize;
   int64_t compressedSize;
+  // Time spent in compression.
+  uint64_t compressionNanos{0};
 };
 } // namespace
 
@@ -3607,7 +3679,12 @@ FlushSizes flushCompressed(
       codec.maxUncompressedLength(),
       "UncompressedSize exceeds limit");
   auto iobuf = out.getIOBuf();
+  const auto compressStart = std::chrono::steady_clock::now();
   const auto compressedBuffer = codec.compress(iobuf.get());
+  const uint64_t compressionNanos =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - compressStart)
+          .count();
   const int32_t compressedSize = compressedBuffer->length();
   if (compressedSize > uncompressedSize * minCompressionRatio) {
     flushSerialization(
@@ -3618,7 +3695,7 @@ FlushSizes flushCompressed(
         iobuf,
         output,
         listener);
-    return {uncompressedSize, uncompressedSize};
+    return {uncompressedSize, uncompressedSize, compressionNanos};
   }
   flushSerialization(
       numRows,
@@ -3628,7 +3705,7 @@ FlushSizes flushCompressed(
       compressedBuffer,
       output,
       listener);
-  return {uncompressedSize, compressedSize};
+  return {uncompressedSize, compressedSize, compressionNanos};
 }
 
 FlushSizes flushStreams(
@@ -3926,14 +4003,13 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const SerdeOpts& opts)
       : opts_(opts),
         streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(opts.compressionKind)) {
-    const auto types = rowType->children();
-    const auto numTypes = types.size();
-    streams_.resize(numTypes);
-
-    for (int i = 0; i < numTypes; ++i) {
-      streams_[i] = std::make_unique<VectorStream>(
-          types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
+        codec_(common::compressionKindToCodec(opts.compressionKind)),
+        rowType_(rowType),
+        initialNumRows_(numRows) {
+    // With 'preserveEncodings', the streams are set up by the first append to
+    // a page as they depend on the encodings of the appended columns.
+    if (!opts_.preserveEncodings) {
+      initializeStreams(nullptr);
     }
   }
 
@@ -3945,6 +4021,21 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     if (numNewRows == 0) {
       return;
     }
+    if (opts_.preserveEncodings) {
+      ScratchPtr<vector_size_t, 64> rowsHolder(scratch);
+      auto* rows = rowsHolder.get(numNewRows);
+      vector_size_t numRows{0};
+      for (const auto& range : ranges) {
+        for (auto row = range.begin; row < range.begin + range.size; ++row) {
+          rows[numRows++] = row;
+        }
+      }
+      append(
+          vector,
+          folly::Range<const vector_size_t*>(rows, numNewRows),
+          scratch);
+      return;
+    }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
       serializeColumn(vector->childAt(i), ranges, streams_[i].get(), scratch);
@@ -3959,9 +4050,20 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     if (numNewRows == 0) {
       return;
     }
+    if (streams_.empty()) {
+      initializeStreams(vector.get());
+    }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-      serializeColumn(vector->childAt(i), rows, streams_[i].get(), scratch);
+      if (streams_[i]->isDictionaryStream()) {
+        serializeToPageDictionary(
+            BaseVector::loadedVectorShared(vector->childAt(i)),
+            rows,
+            streams_[i].get(),
+            scratch);
+      } else {
+        serializeColumn(vector->childAt(i), rows, streams_[i].get(), scratch);
+      }
     }
   }
 
@@ -3982,6 +4084,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // checksum(8) | data
   void flush(OutputStream* out) override {
     constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
+    if (streams_.empty()) {
+      initializeStreams(nullptr);
+    }
     if (!needCompression(*codec_)) {
       flushStreams(
           streams_,
@@ -3991,16 +4096,18 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
           opts_.minCompressionRatio,
           out);
     } else {
-      if (numCompressionToSkip_ > 0) {
+      if (opts_.networkBandwidth > 0) {
+        flushAdaptive(out);
+      } else if (numCompressionToSkip_ > 0) {
         const auto noCompressionCodec = common::compressionKindToCodec(
             common::CompressionKind::CompressionKind_NONE);
-        auto [size, ignore] = flushStreams(
+        const auto sizes = flushStreams(
             streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
-        stats_.compressionSkippedBytes += size;
+        stats_.compressionSkippedBytes += sizes.uncompressedSize;
         --numCompressionToSkip_;
         ++stats_.numCompressionSkipped;
       } else {
-        auto [size, compressedSize] = flushStreams(
+        auto [size, compressedSize, compressionNanos] = flushStreams(
             streams_,
             numRows_,
             *streamArena_,
@@ -4009,6 +4116,7 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
             out);
         stats_.compressionInputBytes += size;
         stats_.compressedBytes += compressedSize;
+        stats_.compressionNanos += compressionNanos;
         if (compressedSize > size * opts_.minCompressionRatio) {
           numCompressionToSkip_ = std::min<int64_t>(
               kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
@@ -4027,18 +4135,113 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
               stats_.compressionInputBytes, RuntimeCounter::Unit::kBytes)},
          {"compressionSkippedBytes",
           RuntimeCounter(
-              stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
+              stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)},
+         {"compressionWallNanos",
+          RuntimeCounter(
+              stats_.compressionNanos, RuntimeCounter::Unit::kNanos)}});
     return map;
   }
 
   void clear() override {
     numRows_ = 0;
+    if (opts_.preserveEncodings) {
+      streams_.clear();
+      return;
+    }
     for (auto& stream : streams_) {
       stream->clear();
     }
   }
 
  private:
+  // Creates a stream per column of 'rowType_'. If 'vector' is not null, the
+  // columns of 'vector' that are dictionary or constant encoded get dictionary
+  // streams, except for fixed width types of at most 4 bytes where an int32_t
+  // index per row is no smaller than the value.
+  void initializeStreams(const RowVector* vector) {
+    const auto& types = rowType_->children();
+    const auto numTypes = types.size();
+    streams_.resize(numTypes);
+    for (int i = 0; i < numTypes; ++i) {
+      std::optional<VectorEncoding::Simple> encoding;
+      const bool smallFixedWidth = types[i]->isFixedWidth() &&
+          types[i]->cppSizeInBytes() <= sizeof(int32_t);
+      if (vector != nullptr && !smallFixedWidth) {
+        const auto childEncoding =
+            BaseVector::loadedVectorShared(vector->childAt(i))->encoding();
+        if (childEncoding == VectorEncoding::Simple::DICTIONARY ||
+            childEncoding == VectorEncoding::Simple::CONSTANT) {
+          encoding = VectorEncoding::Simple::DICTIONARY;
+        }
+      }
+      // A dictionary stream is only set up for a non-zero number of rows.
+      streams_[i] = std::make_unique<VectorStream>(
+          types[i],
+          encoding,
+          std::nullopt,
+          streamArena_,
+          encoding.has_value() ? std::max(1, initialNumRows_)
+                               : initialNumRows_,
+          opts_);
+    }
+  }
+
+  // Compresses the page if the compression measured on the previous pages of
+  // 'this' is expected to take less time than sending the saved bytes over a
+  // link of 'opts_.networkBandwidth'. Compresses every
+  // kAdaptiveCompressionSampleInterval'th page regardless to refresh the
+  // measurements.
+  void flushAdaptive(OutputStream* out) {
+    if (numPagesSinceCompression_ < kAdaptiveCompressionSampleInterval &&
+        !compressionPays()) {
+      const auto noCompressionCodec = common::compressionKindToCodec(
+          common::CompressionKind::CompressionKind_NONE);
+      const auto sizes = flushStreams(
+          streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
+      stats_.compressionSkippedBytes += sizes.uncompressedSize;
+      ++stats_.numCompressionSkipped;
+      ++numPagesSinceCompression_;
+      return;
+    }
+    auto [size, compressedSize, compressionNanos] = flushStreams(
+        streams_,
+        numRows_,
+        *streamArena_,
+        *codec_,
+        opts_.minCompressionRatio,
+        out);
+    stats_.compressionInputBytes += size;
+    stats_.compressedBytes += compressedSize;
+    stats_.compressionNanos += compressionNanos;
+    numPagesSinceCompression_ = 0;
+    // Exponential moving averages favoring the recent pages.
+    constexpr double kWeight = 0.5;
+    const double ratio = static_cast<double>(compressedSize) / size;
+    const double nanosPerByte = static_cast<double>(compressionNanos) / size;
+    if (!hasCompressionEstimate_) {
+      compressionRatio_ = ratio;
+      compressionNanosPerByte_ = nanosPerByte;
+      hasCompressionEstimate_ = true;
+    } else {
+      compressionRatio_ = kWeight * ratio + (1 - kWeight) * compressionRatio_;
+      compressionNanosPerByte_ =
+          kWeight * nanosPerByte + (1 - kWeight) * compressionNanosPerByte_;
+    }
+  }
+
+  // Returns true if compressing a byte is expected to take less time than
+  // sending the bytes saved by compression.
+  bool compressionPays() const {
+    if (!hasCompressionEstimate_) {
+      return true;
+    }
+    const double savedSendNanosPerByte =
+        (1 - compressionRatio_) * 1'000'000'000 / opts_.networkBandwidth;
+    return compressionNanosPerByte_ < savedSendNanosPerByte;
+  }
+
+  static constexpr int32_t kAdaptiveCompressionSampleInterval = 16;
+
   struct CompressionStats {
     // Number of times compression was not attempted.
     int32_t numCompressionSkipped{0};
@@ -4052,17 +4255,30 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     // Bytes for which compression was not attempted because of past
     // non-performance.
     int64_t compressionSkippedBytes{0};
+
+    // Time spent in compression.
+    uint64_t compressionNanos{0};
   };
 
   const SerdeOpts opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
+  const RowTypePtr rowType_;
+  const int32_t initialNumRows_;
 
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
 
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
+
+  // Compression ratio and compression time per uncompressed byte measured on
+  // the pages compressed by flushAdaptive().
+  bool hasCompressionEstimate_{false};
+  double compressionRatio_{1};
+  double compressionNanosPerByte_{0};
+  int32_t numPagesSinceCompression_{0};
+
   CompressionStats stats_;
 };
 } // namespace
@@ -4231,6 +4447,19 @@ void PrestoVectorSerde::deserialize(
   }
 }
 
+std::optional<int64_t> PrestoVectorSerde::numSerializedRows(
+    ByteInputStream* source) const {
+  int64_t numRows{0};
+  while (!source->atEnd()) {
+    const auto header = PrestoHeader::read(source);
+    numRows += header.numRows;
+    source->skip(
+        isCompressedBitSet(header.pageCodecMarker) ? header.compressedSize
+                                                   : header.uncompressedSize);
+  }
+  return numRows;
+}
+
 void PrestoVectorSerde::deserializeSingleColumn(
     ByteInputStream* source,
     velox::memory::MemoryPool* pool,
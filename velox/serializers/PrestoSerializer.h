@@ -30,7 +30,7 @@ namespace facebook::velox::serializer::presto {
 /// createIterativeSerializer(), then append successive RowVectors using
 /// IterativeVectorSerializer::append(). In this case, since different RowVector
 /// might encode columns differently, data is always flattened in the serialized
-/// payload.
+/// payload, unless PrestoOptions::preserveEncodings is set.
 ///
 /// Note that there are two flavors of append(), one that takes a range of rows,
 /// and one that takes a list of row ids. The former is useful when serializing
@@ -72,6 +72,26 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// Bandwidth in bytes per second of the link the serialized pages are sent
+    /// over. If non-zero and compression is enabled, the iterative serializer
+    /// compresses a page only if the time to compress it is expected to be
+    /// less than the time saved by sending fewer bytes. The expectation is
+    /// based on the compression ratio and throughput measured on the previous
+    /// pages. Compression is still attempted periodically to refresh the
+    /// measurements.
+    uint64_t networkBandwidth{0};
+
+    /// If true, the iterative serializer writes a top level column as a
+    /// DICTIONARY block if the column is dictionary or constant encoded in the
+    /// first RowVector appended to a page. The rows of all the RowVectors
+    /// appended to the page then share a single dictionary per column, which
+    /// holds the values referenced by the rows. The deserializer produces
+    /// DictionaryVectors for such columns. Columns of fixed width types of at
+    /// most 4 bytes are always flattened.
+    ///
+    /// NOTE: only used for the exchange between Velox workers.
+    bool preserveEncodings{false};
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
@@ -101,6 +121,10 @@ class PrestoVectorSerde : public VectorSerde {
       memory::MemoryPool* pool,
       const Options* options) override;
 
+  /// Reads the row counts from the page headers and skips the page contents.
+  std::optional<int64_t> numSerializedRows(
+      ByteInputStream* source) const override;
+
   bool supportsAppendInDeserialize() const override {
     return true;
   }
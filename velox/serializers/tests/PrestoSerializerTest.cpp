@@ -985,6 +985,17 @@ TEST_P(PrestoSerializerTest, multiPage) {
   }
 }
 
+TEST_P(PrestoSerializerTest, numSerializedRows) {
+  std::ostringstream out;
+  for (int size : {1234, 1250, 538, 2408}) {
+    serialize(makeTestVector(size), &out, nullptr);
+  }
+  const auto bytes = out.str();
+  auto byteStream = toByteStream(bytes);
+  ASSERT_EQ(serde_->numSerializedRows(&byteStream), 1234 + 1250 + 538 + 2408);
+  ASSERT_TRUE(byteStream.atEnd());
+}
+
 TEST_P(PrestoSerializerTest, timestampWithNanosecondPrecision) {
   // Verify that nanosecond precision is preserved when the right options are
   // passed to the serde.
@@ -1443,6 +1454,117 @@ TEST_P(PrestoSerializerTest, checksum) {
       "Received corrupted serialized page.");
 }
 
+TEST_P(PrestoSerializerTest, adaptiveCompression) {
+  if (GetParam() == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  auto data = makeRowVector({makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row % 7; })});
+  const IndexRange range{0, data->size()};
+
+  // Returns the bytes for which compression was attempted and skipped.
+  auto serializePages = [&](uint64_t networkBandwidth, int32_t numPages) {
+    serializer::presto::PrestoVectorSerde::PrestoOptions options;
+    options.compressionKind = GetParam();
+    options.networkBandwidth = networkBandwidth;
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer = serde_->createIterativeSerializer(
+        asRowType(data->type()), data->size(), arena.get(), &options);
+    for (auto i = 0; i < numPages; ++i) {
+      serializer->append(data, folly::Range(&range, 1));
+      std::ostringstream output;
+      OStreamOutputStream out(&output);
+      serializer->flush(&out);
+      serializer->clear();
+    }
+    const auto stats = serializer->runtimeStats();
+    return std::make_pair(
+        stats.at("compressionInputBytes").value,
+        stats.at("compressionSkippedBytes").value);
+  };
+
+  // Compression always pays off on a slow link.
+  auto [compressedBytes, skippedBytes] = serializePages(1, 18);
+  EXPECT_GT(compressedBytes, 0);
+  EXPECT_EQ(skippedBytes, 0);
+
+  // Compression never pays off on an infinitely fast link. Only the first page
+  // and the sample after 16 skipped pages are compressed.
+  std::tie(compressedBytes, skippedBytes) =
+      serializePages(std::numeric_limits<uint64_t>::max(), 18);
+  EXPECT_GT(compressedBytes, 0);
+  EXPECT_GT(skippedBytes, 7 * compressedBytes);
+}
+
+TEST_P(PrestoSerializerTest, preserveEncodings) {
+  const auto rowType = ROW({"a", "b", "c"}, {VARCHAR(), VARCHAR(), BIGINT()});
+  auto base = makeFlatVector<std::string>(
+      10, [](auto row) { return fmt::format("longer than inline {}", row); });
+  std::vector<RowVectorPtr> inputs = {
+      makeRowVector(
+          {wrapInDictionary(
+               makeIndices(100, [](auto row) { return row % 10; }), base),
+           makeConstant<std::string>("constant string value", 100),
+           makeFlatVector<int64_t>(100, [](auto row) { return row; })}),
+      makeRowVector(
+          {makeConstant<std::string>("another constant string", 50),
+           wrapInDictionary(
+               makeIndices(50, [](auto row) { return row % 3; }), base),
+           makeFlatVector<int64_t>(50, [](auto row) { return row * 2; })}),
+      makeRowVector(
+          {makeNullableFlatVector<std::string>(
+               {"x", std::nullopt, "longer than inline 1"}),
+           makeFlatVector<std::string>({"a", "b", "c"}),
+           makeFlatVector<int64_t>({1, 2, 3})}),
+  };
+
+  auto serializeAll = [&](bool preserveEncodings) {
+    serializer::presto::PrestoVectorSerde::PrestoOptions options;
+    options.compressionKind = GetParam();
+    options.preserveEncodings = preserveEncodings;
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer =
+        serde_->createIterativeSerializer(rowType, 100, arena.get(), &options);
+    Scratch scratch;
+    for (auto i = 0; i < inputs.size(); ++i) {
+      if (i % 2 == 0) {
+        std::vector<vector_size_t> rows(inputs[i]->size());
+        std::iota(rows.begin(), rows.end(), 0);
+        serializer->append(
+            inputs[i], folly::Range(rows.data(), rows.size()), scratch);
+      } else {
+        IndexRange range{0, inputs[i]->size()};
+        serializer->append(inputs[i], folly::Range(&range, 1), scratch);
+      }
+    }
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    return output.str();
+  };
+
+  const auto preserved = serializeAll(true);
+  const auto flattened = serializeAll(false);
+  EXPECT_LT(preserved.size(), flattened.size());
+
+  auto expected = BaseVector::create<RowVector>(rowType, 0, pool_.get());
+  for (const auto& input : inputs) {
+    expected->append(input.get());
+  }
+
+  auto options = getParamSerdeOptions(nullptr);
+  auto byteStream = toByteStream(preserved);
+  RowVectorPtr result;
+  serde_->deserialize(
+      &byteStream, pool_.get(), rowType, &result, 0, &options);
+  EXPECT_EQ(
+      result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  EXPECT_EQ(
+      result->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  EXPECT_EQ(result->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+  assertEqualVectors(expected, result);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     PrestoSerializerTest,
     PrestoSerializerTest,
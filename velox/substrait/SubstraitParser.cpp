@@ -71,6 +71,8 @@ TypePtr SubstraitParser::parseType(const ::substrait::Type& substraitType) {
       return UNKNOWN();
     case ::substrait::Type::KindCase::kDate:
       return DATE();
+    case ::substrait::Type::KindCase::kTimestamp:
+      return TIMESTAMP();
     default:
       VELOX_NYI(
           "Parsing for Substrait type not supported: {}",
@@ -93,6 +93,65 @@ ArrayVectorPtr makeEmptyArrayVector(memory::MemoryPool* pool) {
       pool, ARRAY(UNKNOWN()), nullptr, 1, offsets, sizes, nullptr);
 }
 
+// Throws if 'literal' is not null and its type case does not match 'type'.
+// The value is read with the getter for 'type', which returns a default for a
+// different type case.
+void checkLiteralTypeCase(
+    const ::substrait::Expression::Literal& literal,
+    const TypePtr& type) {
+  using LiteralTypeCase = ::substrait::Expression_Literal::LiteralTypeCase;
+  const auto typeCase = literal.literal_type_case();
+  if (typeCase == LiteralTypeCase::kNull) {
+    return;
+  }
+  bool matches;
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      matches = typeCase == LiteralTypeCase::kBoolean;
+      break;
+    case TypeKind::TINYINT:
+      matches = typeCase == LiteralTypeCase::kI8;
+      break;
+    case TypeKind::SMALLINT:
+      matches = typeCase == LiteralTypeCase::kI16;
+      break;
+    case TypeKind::INTEGER:
+      matches = typeCase ==
+          (type->isDate() ? LiteralTypeCase::kDate : LiteralTypeCase::kI32);
+      break;
+    case TypeKind::BIGINT:
+      if (type->isDecimal()) {
+        matches = false;
+      } else if (type->isIntervalDayTime()) {
+        matches = typeCase == LiteralTypeCase::kIntervalDayToSecond;
+      } else {
+        matches = typeCase == LiteralTypeCase::kI64;
+      }
+      break;
+    case TypeKind::REAL:
+      matches = typeCase == LiteralTypeCase::kFp32;
+      break;
+    case TypeKind::DOUBLE:
+      matches = typeCase == LiteralTypeCase::kFp64;
+      break;
+    case TypeKind::VARCHAR:
+      matches = typeCase == LiteralTypeCase::kString ||
+          typeCase == LiteralTypeCase::kVarChar;
+      break;
+    case TypeKind::TIMESTAMP:
+      matches = typeCase == LiteralTypeCase::kTimestamp;
+      break;
+    default:
+      matches = false;
+  }
+  if (!matches) {
+    VELOX_UNSUPPORTED(
+        "Substrait literal of type case '{}' is not supported for type {}",
+        typeCase,
+        type->toString());
+  }
+}
+
 template <typename T>
 void setLiteralValue(
     const ::substrait::Expression::Literal& literal,
@@ -111,6 +170,15 @@ void setLiteralValue(
   } else if (vector->type()->isDate()) {
     auto dateVector = vector->template asFlatVector<int32_t>();
     dateVector->set(index, int(literal.date()));
+  } else if (vector->type()->isIntervalDayTime()) {
+    // INTERVAL_DAY_TIME is in milliseconds.
+    const auto& interval = literal.interval_day_to_second();
+    auto intervalVector = vector->template asFlatVector<int64_t>();
+    intervalVector->set(
+        index,
+        static_cast<int64_t>(interval.days()) * 86'400'000 +
+            static_cast<int64_t>(interval.seconds()) * 1'000 +
+            interval.microseconds() / 1'000);
   } else {
     vector->set(index, getLiteralValue<T>(literal));
   }
@@ -118,18 +186,22 @@ void setLiteralValue(
 
 template <TypeKind kind>
 VectorPtr constructFlatVector(
-    const ::substrait::Expression::Literal& listLiteral,
+    const ::google::protobuf::RepeatedPtrField<
+        ::substrait::Expression::Literal>& literals,
+    int32_t offset,
     const vector_size_t size,
     const TypePtr& type,
     memory::MemoryPool* pool) {
   VELOX_CHECK(type->isPrimitiveType());
+  VELOX_CHECK_LE(offset + size, literals.size());
   auto vector = BaseVector::create(type, size, pool);
   using T = typename TypeTraits<kind>::NativeType;
   auto flatVector = vector->as<FlatVector<T>>();
 
-  vector_size_t index = 0;
-  for (auto child : listLiteral.list().values()) {
-    setLiteralValue(child, flatVector, index++);
+  for (vector_size_t i = 0; i < size; ++i) {
+    const auto& literal = literals.Get(offset + i);
+    checkLiteralTypeCase(literal, type);
+    setLiteralValue(literal, flatVector, i);
   }
   return vector;
 }
@@ -254,6 +326,23 @@ SubstraitVeloxExprConverter::toVeloxExpr(
   }
 }
 
+VectorPtr SubstraitVeloxExprConverter::literalsToFlatVector(
+    const ::google::protobuf::RepeatedPtrField<
+        ::substrait::Expression::Literal>& literals,
+    int32_t offset,
+    vector_size_t size,
+    const TypePtr& type) {
+  if (!type->isPrimitiveType()) {
+    VELOX_UNSUPPORTED(
+        "Complex type literals are not supported yet: {}", type->toString());
+  }
+  if (type->kind() == TypeKind::VARBINARY) {
+    VELOX_UNSUPPORTED("Return of VARBINARY data is not supported");
+  }
+  return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      constructFlatVector, type->kind(), literals, offset, size, type, pool_);
+}
+
 ArrayVectorPtr SubstraitVeloxExprConverter::literalsToArrayVector(
     const ::substrait::Expression::Literal& listLiteral) {
   auto childSize = listLiteral.list().values().size();
@@ -264,47 +353,57 @@ ArrayVectorPtr SubstraitVeloxExprConverter::literalsToArrayVector(
   switch (typeCase) {
     case ::substrait::Expression_Literal::LiteralTypeCase::kBoolean:
       return makeArrayVector(constructFlatVector<TypeKind::BOOLEAN>(
-          listLiteral, childSize, BOOLEAN(), pool_));
+          listLiteral.list().values(), 0, childSize, BOOLEAN(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kI8:
       return makeArrayVector(constructFlatVector<TypeKind::TINYINT>(
-          listLiteral, childSize, TINYINT(), pool_));
+          listLiteral.list().values(), 0, childSize, TINYINT(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kI16:
       return makeArrayVector(constructFlatVector<TypeKind::SMALLINT>(
-          listLiteral, childSize, SMALLINT(), pool_));
+          listLiteral.list().values(), 0, childSize, SMALLINT(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kI32:
       return makeArrayVector(constructFlatVector<TypeKind::INTEGER>(
-          listLiteral, childSize, INTEGER(), pool_));
+          listLiteral.list().values(), 0, childSize, INTEGER(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kFp32:
       return makeArrayVector(constructFlatVector<TypeKind::REAL>(
-          listLiteral, childSize, REAL(), pool_));
+          listLiteral.list().values(), 0, childSize, REAL(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kI64:
       return makeArrayVector(constructFlatVector<TypeKind::BIGINT>(
-          listLiteral, childSize, BIGINT(), pool_));
+          listLiteral.list().values(), 0, childSize, BIGINT(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kFp64:
       return makeArrayVector(constructFlatVector<TypeKind::DOUBLE>(
-          listLiteral, childSize, DOUBLE(), pool_));
+          listLiteral.list().values(), 0, childSize, DOUBLE(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kString:
     case ::substrait::Expression_Literal::LiteralTypeCase::kVarChar:
       return makeArrayVector(constructFlatVector<TypeKind::VARCHAR>(
-          listLiteral, childSize, VARCHAR(), pool_));
+          listLiteral.list().values(), 0, childSize, VARCHAR(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kNull: {
       auto veloxType = substraitParser_.parseType(listLiteral.null());
       auto kind = veloxType->kind();
       return makeArrayVector(VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
-          constructFlatVector, kind, listLiteral, childSize, veloxType, pool_));
+          constructFlatVector,
+          kind,
+          listLiteral.list().values(),
+          0,
+          childSize,
+          veloxType,
+          pool_));
     }
     case ::substrait::Expression_Literal::LiteralTypeCase::kDate:
       return makeArrayVector(constructFlatVector<TypeKind::INTEGER>(
-          listLiteral, childSize, DATE(), pool_));
+          listLiteral.list().values(), 0, childSize, DATE(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kTimestamp:
       return makeArrayVector(constructFlatVector<TypeKind::TIMESTAMP>(
-          listLiteral, childSize, TIMESTAMP(), pool_));
+          listLiteral.list().values(), 0, childSize, TIMESTAMP(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kIntervalDayToSecond:
       return makeArrayVector(constructFlatVector<TypeKind::BIGINT>(
-          listLiteral, childSize, INTERVAL_DAY_TIME(), pool_));
+          listLiteral.list().values(),
+          0,
+          childSize,
+          INTERVAL_DAY_TIME(),
+          pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kList: {
       VectorPtr elements;
-      for (auto it : listLiteral.list().values()) {
+      for (const auto& it : listLiteral.list().values()) {
         auto v = literalsToArrayVector(it);
         if (!elements) {
           elements = v;
@@ -54,6 +54,17 @@ class SubstraitVeloxExprConverter {
   std::shared_ptr<const core::ConstantTypedExpr> toVeloxExpr(
       const ::substrait::Expression::Literal& substraitLit);
 
+  /// Converts 'size' scalar literals of 'type' starting at 'offset' in
+  /// 'literals' into a flat vector, without going through variants. Throws
+  /// VELOX_UNSUPPORTED if a literal is neither null nor of the literal type
+  /// of 'type'.
+  VectorPtr literalsToFlatVector(
+      const ::google::protobuf::RepeatedPtrField<
+          ::substrait::Expression::Literal>& literals,
+      int32_t offset,
+      vector_size_t size,
+      const TypePtr& type);
+
   /// Convert Substrait Expression into Velox Expression.
   core::TypedExprPtr toVeloxExpr(
       const ::substrait::Expression& substraitExpr,
@@ -16,7 +16,6 @@
 
 #include "velox/substrait/SubstraitToVeloxPlan.h"
 #include "velox/substrait/TypeUtils.h"
-#include "velox/substrait/VariantToVectorConverter.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::substrait {
@@ -132,7 +131,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   for (const auto& measure : aggRel.measures()) {
     core::FieldAccessTypedExprPtr mask;
-    ::substrait::Expression substraitAggMask = measure.filter();
+    const auto& substraitAggMask = measure.filter();
     // Get Aggregation Masks.
     if (measure.has_filter()) {
       if (substraitAggMask.ByteSizeLong() > 0) {
@@ -314,12 +313,11 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   core::PlanNodePtr childNode;
   // Check the input of fetchRel, if it's sortRel, convert them into
   // topNNode. otherwise, to limitNode.
-  ::substrait::SortRel sortRel;
+  const auto& sortRel = fetchRel.input().sort();
   bool topNFlag;
   if (fetchRel.has_input()) {
     topNFlag = fetchRel.input().has_sort();
     if (topNFlag) {
-      sortRel = fetchRel.input().sort();
       childNode = toVeloxPlan(sortRel.input());
     } else {
       childNode = toVeloxPlan(fetchRel.input());
@@ -457,7 +455,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::ReadRel& readRel,
     const RowTypePtr& type) {
-  ::substrait::ReadRel_VirtualTable readVirtualTable = readRel.virtual_table();
+  const auto& readVirtualTable = readRel.virtual_table();
   int64_t numVectors = readVirtualTable.values_size();
   int64_t numColumns = type->size();
   int64_t valueFieldNums =
@@ -475,36 +473,14 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   for (int64_t index = 0; index < numVectors; ++index) {
     std::vector<VectorPtr> children;
-    ::substrait::Expression_Literal_Struct rowValue =
-        readRel.virtual_table().values(index);
+    const auto& rowValue = readVirtualTable.values(index);
     auto fieldSize = rowValue.fields_size();
     VELOX_CHECK_EQ(fieldSize, batchSize * numColumns);
 
+    // The values of a column are consecutive fields of 'rowValue'.
     for (int64_t col = 0; col < numColumns; ++col) {
-      const TypePtr& outputChildType = type->childAt(col);
-      std::vector<variant> batchChild;
-      batchChild.reserve(batchSize);
-      for (int64_t batchId = 0; batchId < batchSize; batchId++) {
-        // each value in the batch
-        auto fieldIdx = col * batchSize + batchId;
-        ::substrait::Expression_Literal field = rowValue.fields(fieldIdx);
-
-        auto expr = exprConverter_->toVeloxExpr(field);
-        if (auto constantExpr =
-                std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
-                    expr)) {
-          if (!constantExpr->hasValueVector()) {
-            batchChild.emplace_back(constantExpr->value());
-          } else {
-            VELOX_UNSUPPORTED(
-                "Values node with complex type values is not supported yet");
-          }
-        } else {
-          VELOX_FAIL("Expected constant expression");
-        }
-      }
-      children.emplace_back(
-          setVectorFromVariants(outputChildType, batchChild, pool_));
+      children.emplace_back(exprConverter_->literalsToFlatVector(
+          rowValue.fields(), col * batchSize, batchSize, type->childAt(col)));
     }
 
     vectors.emplace_back(
@@ -173,7 +173,7 @@ class SubstraitVeloxPlanConverter {
 
   /// Helper function to convert the input of Substrait Rel to Velox Node.
   template <typename T>
-  core::PlanNodePtr convertSingleInput(T rel) {
+  core::PlanNodePtr convertSingleInput(const T& rel) {
     VELOX_CHECK(rel.has_input(), "Child Rel is expected here.");
     return toVeloxPlan(rel.input());
   }
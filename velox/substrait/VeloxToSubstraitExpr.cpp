@@ -96,6 +96,15 @@ const ::substrait::Expression_Literal& toSubstraitNullLiteral(
       substraitField->mutable_null()->set_allocated_fp64(nullValue);
       break;
     }
+    case velox::TypeKind::TIMESTAMP: {
+      ::substrait::Type_Timestamp* nullValue =
+          google::protobuf::Arena::CreateMessage<::substrait::Type_Timestamp>(
+              &arena);
+      nullValue->set_nullability(
+          ::substrait::Type_Nullability_NULLABILITY_NULLABLE);
+      substraitField->mutable_null()->set_allocated_timestamp(nullValue);
+      break;
+    }
     case velox::TypeKind::ARRAY: {
       ::substrait::Type_List* nullValue =
           google::protobuf::Arena::CreateMessage<::substrait::Type_List>(
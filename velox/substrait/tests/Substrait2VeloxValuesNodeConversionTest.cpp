@@ -17,6 +17,7 @@
 #include "velox/substrait/tests/JsonToProtoConverter.h"
 
 #include "velox/common/base/Fs.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -60,3 +61,47 @@ TEST_F(Substrait2VeloxValuesNodeConversionTest, valuesNode) {
   createDuckDbTable({expectedData});
   assertQuery(veloxPlan, "SELECT * FROM tmp");
 }
+
+TEST_F(Substrait2VeloxValuesNodeConversionTest, literalsToFlatVector) {
+  const std::unordered_map<uint64_t, std::string> functionMap;
+  SubstraitVeloxExprConverter converter(pool_.get(), functionMap);
+  ::google::protobuf::RepeatedPtrField<::substrait::Expression::Literal>
+      literals;
+
+  literals.Add()->set_timestamp(1'700'000'000'123'456);
+  literals.Add()->mutable_null()->mutable_timestamp();
+  assertEqualVectors(
+      makeNullableFlatVector<Timestamp>(
+          {Timestamp(1'700'000'000, 123'456'000), std::nullopt}),
+      converter.literalsToFlatVector(literals, 0, 2, TIMESTAMP()));
+
+  literals.Clear();
+  auto* interval = literals.Add()->mutable_interval_day_to_second();
+  interval->set_days(2);
+  interval->set_seconds(3);
+  interval->set_microseconds(4'000);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          {2 * 86'400'000 + 3'000 + 4}, INTERVAL_DAY_TIME()),
+      converter.literalsToFlatVector(literals, 0, 1, INTERVAL_DAY_TIME()));
+
+  // The type case of a literal must match the type of the vector.
+  VELOX_ASSERT_THROW(
+      converter.literalsToFlatVector(literals, 0, 1, BIGINT()),
+      "is not supported for type BIGINT");
+
+  literals.Clear();
+  literals.Add()->set_i64(1);
+  VELOX_ASSERT_THROW(
+      converter.literalsToFlatVector(literals, 0, 1, INTERVAL_DAY_TIME()),
+      "is not supported for type INTERVAL DAY TO SECOND");
+  VELOX_ASSERT_THROW(
+      converter.literalsToFlatVector(literals, 0, 1, DECIMAL(10, 2)),
+      "is not supported for type DECIMAL(10, 2)");
+
+  literals.Clear();
+  literals.Add()->set_i32(1);
+  VELOX_ASSERT_THROW(
+      converter.literalsToFlatVector(literals, 0, 1, BIGINT()),
+      "is not supported for type BIGINT");
+}
@@ -163,6 +163,50 @@ TEST_F(VeloxSubstraitRoundTripTest, values) {
   assertPlanConversion(plan, "SELECT * FROM tmp");
 }
 
+TEST_F(VeloxSubstraitRoundTripTest, valuesWithTimestamp) {
+  RowVectorPtr vectors = makeRowVector(
+      {makeFlatVector<int64_t>({1, 2, 3, 4}),
+       makeNullableFlatVector<Timestamp>(
+           {Timestamp(0, 0),
+            Timestamp(1'700'000'000, 123'456'000),
+            std::nullopt,
+            Timestamp(-86'400, 0)})});
+  createDuckDbTable({vectors});
+
+  auto plan = PlanBuilder().values({vectors}).planNode();
+
+  assertPlanConversion(plan, "SELECT * FROM tmp");
+}
+
+TEST_F(VeloxSubstraitRoundTripTest, valuesLiteralTypeMismatch) {
+  RowVectorPtr vectors = makeRowVector(
+      {makeFlatVector<int64_t>({1, 2}),
+       makeFlatVector<Timestamp>({Timestamp(0, 0), Timestamp(1, 0)})});
+  auto plan = PlanBuilder().values({vectors}).planNode();
+
+  google::protobuf::Arena arena;
+  auto& substraitPlan = veloxConvertor_->toSubstrait(arena, plan);
+  auto* values = substraitPlan.mutable_relations(0)
+                     ->mutable_root()
+                     ->mutable_input()
+                     ->mutable_read()
+                     ->mutable_virtual_table()
+                     ->mutable_values(0);
+
+  // An INTEGER literal in the BIGINT column.
+  values->mutable_fields(1)->set_i32(2);
+  VELOX_ASSERT_THROW(
+      substraitConverter_->toVeloxPlan(substraitPlan),
+      "is not supported for type BIGINT");
+
+  // A BIGINT literal in the TIMESTAMP column.
+  values->mutable_fields(1)->set_i64(2);
+  values->mutable_fields(3)->set_i64(1'000'000);
+  VELOX_ASSERT_THROW(
+      substraitConverter_->toVeloxPlan(substraitPlan),
+      "is not supported for type TIMESTAMP");
+}
+
 TEST_F(VeloxSubstraitRoundTripTest, count) {
   auto vectors = makeVectors(2, 7, 3);
   createDuckDbTable(vectors);
@@ -0,0 +1,894 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+#include "velox/vector/FlatVector.h"
+
+#include <array>
+#include <cmath>
+
+namespace facebook::velox::tpcds {
+
+namespace {
+
+// Julian day number of 1970-01-01. Date surrogate keys are Julian day numbers
+// like in dsdgen.
+constexpr int64_t kJulianEpoch = 2'440'588;
+
+// date_dim starts at 1900-01-02.
+constexpr int32_t kFirstDate = -25'566;
+
+// store_sales are sold from 1998-01-02 to 2003-01-02.
+constexpr int32_t kFirstSalesDate = 10'228;
+constexpr int32_t kNumSalesDays = 1'827;
+
+// Number of store_sales rows with the same ticket number, customer, store and
+// date.
+constexpr int32_t kRowsPerTicket = 8;
+
+// Row counts of the spec for scale factors 1, 10, 100, 1000 and 10000.
+using RowCounts = std::array<size_t, 5>;
+
+// Returns the row count of the smallest scale factor of 'counts' that is at
+// least 'scaleFactor'. Scales the largest linearly after that.
+size_t steppedRowCount(double scaleFactor, const RowCounts& counts) {
+  double stepScaleFactor = 1;
+  for (auto count : counts) {
+    if (scaleFactor <= stepScaleFactor) {
+      return count;
+    }
+    stepScaleFactor *= 10;
+  }
+  return static_cast<size_t>(counts.back() * (scaleFactor / 10'000));
+}
+
+// Like steppedRowCount() but scales linearly below scale factor 1.
+size_t scaledRowCount(double scaleFactor, const RowCounts& counts) {
+  if (scaleFactor < 1) {
+    return static_cast<size_t>(counts[0] * scaleFactor);
+  }
+  return steppedRowCount(scaleFactor, counts);
+}
+
+size_t getVectorSize(size_t rowCount, size_t maxRows, size_t offset) {
+  if (offset >= rowCount) {
+    return 0;
+  }
+  return std::min(rowCount - offset, maxRows);
+}
+
+std::vector<VectorPtr> allocateVectors(
+    const RowTypePtr& type,
+    size_t vectorSize,
+    memory::MemoryPool* pool) {
+  std::vector<VectorPtr> vectors;
+  vectors.reserve(type->size());
+
+  for (const auto& childType : type->children()) {
+    vectors.emplace_back(BaseVector::create(childType, vectorSize, pool));
+  }
+  return vectors;
+}
+
+// Draws the values of one table. Each value is a hash of the table, a stream
+// number and the row number, so that it does not depend on the rows generated
+// before.
+class RowRandom {
+ public:
+  explicit RowRandom(Table table)
+      : seed_(static_cast<uint64_t>(table) << 56) {}
+
+  uint64_t next(uint32_t stream, uint64_t row) const {
+    // splitmix64 finalizer.
+    uint64_t x = seed_ ^ (static_cast<uint64_t>(stream) << 40) ^
+        (row * 0x9e3779b97f4a7c15ULL);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  // Returns a value in [min, max].
+  int64_t range(uint32_t stream, uint64_t row, int64_t min, int64_t max) const {
+    return min + next(stream, row) % (max - min + 1);
+  }
+
+  // Returns an amount of money in [minCents / 100, maxCents / 100].
+  double money(
+      uint32_t stream,
+      uint64_t row,
+      int64_t minCents,
+      int64_t maxCents) const {
+    return range(stream, row, minCents, maxCents) / 100.0;
+  }
+
+ private:
+  const uint64_t seed_;
+};
+
+double roundToCents(double value) {
+  return std::round(value * 100) / 100;
+}
+
+// Returns the 16 character business key for a surrogate key, e.g.
+// AAAAAAAABAAAAAAA for 1.
+std::string makeId(int64_t key) {
+  std::string id(16, 'A');
+  for (auto i = 8; i < 16 && key > 0; ++i) {
+    id[i] = 'A' + (key & 0xf);
+    key >>= 4;
+  }
+  return id;
+}
+
+// Returns a word made of one syllable per decimal digit of 'number', like
+// the names dsdgen makes for manufacturers and stores.
+std::string makeWord(int64_t number) {
+  static const std::array<const char*, 10> kSyllables = {
+      "ought",
+      "able",
+      "pri",
+      "ese",
+      "anti",
+      "cally",
+      "ation",
+      "eing",
+      "n st",
+      "bar"};
+  const auto digits = std::to_string(number);
+  std::string word;
+  for (auto digit : digits) {
+    word += kSyllables[digit - '0'];
+  }
+  return word;
+}
+
+template <typename T>
+FlatVector<T>* flat(const VectorPtr& vector) {
+  return vector->asFlatVector<T>();
+}
+
+void setString(const VectorPtr& vector, size_t row, std::string_view value) {
+  flat<StringView>(vector)->set(row, StringView(value.data(), value.size()));
+}
+
+// Splits days since epoch into year, month and day.
+void civilFromDays(int32_t days, int32_t& year, int32_t& month, int32_t& day) {
+  const int64_t z = days + 719'468;
+  const int64_t era = (z >= 0 ? z : z - 146'096) / 146'097;
+  const int64_t dayOfEra = z - era * 146'097;
+  const int64_t yearOfEra = (dayOfEra - dayOfEra / 1'460 +
+                             dayOfEra / 36'524 - dayOfEra / 146'096) /
+      365;
+  const int64_t dayOfYear =
+      dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  const int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+  day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+  month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+  year = yearOfEra + era * 400 + (month <= 2);
+}
+
+const std::array<const char*, 10> kCategories = {
+    "Women",
+    "Men",
+    "Children",
+    "Shoes",
+    "Music",
+    "Jewelry",
+    "Home",
+    "Sports",
+    "Books",
+    "Electronics"};
+
+constexpr int32_t kClassesPerCategory = 4;
+
+const std::array<std::array<const char*, kClassesPerCategory>, 10> kClasses = {
+    {{"dresses", "swimwear", "fragrances", "maternity"},
+     {"shirts", "pants", "accessories", "sports-apparel"},
+     {"infants", "toddlers", "school-uniforms", "newborn"},
+     {"athletic", "mens", "womens", "kids"},
+     {"rock", "pop", "classical", "country"},
+     {"rings", "bracelets", "earings", "diamonds"},
+     {"furniture", "bedding", "decor", "lighting"},
+     {"baseball", "camping", "fishing", "golf"},
+     {"fiction", "history", "science", "travel"},
+     {"audio", "cameras", "televisions", "wireless"}}};
+
+const std::array<const char*, 10> kBrandSyllables = {
+    "amalg",
+    "edu pack",
+    "export",
+    "import",
+    "scholar",
+    "corp",
+    "brand",
+    "univ",
+    "maxi",
+    "nameless"};
+
+const std::array<const char*, 7> kDayNames = {
+    "Sunday",
+    "Monday",
+    "Tuesday",
+    "Wednesday",
+    "Thursday",
+    "Friday",
+    "Saturday"};
+
+const std::array<const char*, 6> kCities = {
+    "Midway",
+    "Fairview",
+    "Oak Grove",
+    "Five Points",
+    "Pleasant Hill",
+    "Centerville"};
+
+const std::array<const char*, 4> kCounties = {
+    "Williamson County",
+    "Franklin Parish",
+    "Bronx County",
+    "Orange County"};
+
+// Most stores are in Tennessee like at the small scale factors of dsdgen.
+const std::array<const char*, 10> kStoreStates = {
+    "TN", "TN", "TN", "TN", "TN", "TN", "AL", "GA", "KY", "SD"};
+
+const std::array<const char*, 20> kStates = {
+    "TN", "GA", "KY", "TX", "VA", "IL", "OH", "MO", "NC", "MI",
+    "IA", "IN", "NE", "MS", "KS", "CA", "WI", "AL", "MN", "SD"};
+
+const std::array<const char*, 8> kFirstNames = {
+    "James",
+    "Mary",
+    "Robert",
+    "Patricia",
+    "John",
+    "Jennifer",
+    "Michael",
+    "Linda"};
+
+const std::array<const char*, 8> kLastNames = {
+    "Smith",
+    "Johnson",
+    "Williams",
+    "Brown",
+    "Jones",
+    "Garcia",
+    "Miller",
+    "Davis"};
+
+const std::array<const char*, 2> kGenders = {"M", "F"};
+const std::array<const char*, 5> kMaritalStatuses = {"M", "S", "D", "W", "U"};
+const std::array<const char*, 7> kEducationStatuses = {
+    "Primary",
+    "Secondary",
+    "College",
+    "2 yr Degree",
+    "4 yr Degree",
+    "Advanced Degree",
+    "Unknown"};
+const std::array<const char*, 4> kCreditRatings = {
+    "Good",
+    "High Risk",
+    "Low Risk",
+    "Unknown"};
+
+std::string makeZip(const RowRandom& random, uint32_t stream, uint64_t row) {
+  return fmt::format("{:05d}", random.range(stream, row, 10'000, 99'999));
+}
+
+void genDateDim(std::vector<VectorPtr>& children, size_t size, size_t offset) {
+  for (size_t i = 0; i < size; ++i) {
+    const int32_t days = kFirstDate + static_cast<int32_t>(offset + i);
+    const int64_t dateSk = days + kJulianEpoch;
+    int32_t year;
+    int32_t month;
+    int32_t day;
+    civilFromDays(days, year, month, day);
+    const int32_t dayOfWeek = ((days + 4) % 7 + 7) % 7;
+
+    flat<int64_t>(children[0])->set(i, dateSk);
+    setString(children[1], i, makeId(dateSk));
+    flat<int32_t>(children[2])->set(i, days);
+    flat<int32_t>(children[3])->set(i, (year - 1900) * 12 + month - 1);
+    flat<int32_t>(children[4])->set(i, year);
+    flat<int32_t>(children[5])->set(i, dayOfWeek);
+    flat<int32_t>(children[6])->set(i, month);
+    flat<int32_t>(children[7])->set(i, day);
+    flat<int32_t>(children[8])->set(i, (month - 1) / 3 + 1);
+    setString(children[9], i, kDayNames[dayOfWeek]);
+  }
+}
+
+void genItem(std::vector<VectorPtr>& children, size_t size, size_t offset) {
+  const RowRandom random(Table::TBL_ITEM);
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t itemSk = offset + i + 1;
+    const int32_t categoryId = random.range(0, itemSk, 1, kCategories.size());
+    const int32_t classId = random.range(1, itemSk, 1, kClassesPerCategory);
+    const int32_t brandNumber = random.range(2, itemSk, 1, 10);
+    const int32_t manufactId = random.range(3, itemSk, 1, 1'000);
+    const auto* category = kCategories[categoryId - 1];
+    const auto* className = kClasses[categoryId - 1][classId - 1];
+
+    flat<int64_t>(children[0])->set(i, itemSk);
+    setString(children[1], i, makeId(itemSk));
+    setString(
+        children[2],
+        i,
+        fmt::format("{} {} item {}", category, className, itemSk));
+    flat<double>(children[3])->set(i, random.money(4, itemSk, 100, 9'999));
+    flat<int32_t>(children[4])
+        ->set(i, categoryId * 1'000'000 + classId * 1'000 + brandNumber);
+    setString(
+        children[5],
+        i,
+        fmt::format(
+            "{}{} #{}",
+            kBrandSyllables[categoryId - 1],
+            kBrandSyllables[(categoryId + classId) % kBrandSyllables.size()],
+            brandNumber));
+    flat<int32_t>(children[6])->set(i, classId);
+    setString(children[7], i, className);
+    flat<int32_t>(children[8])->set(i, categoryId);
+    setString(children[9], i, category);
+    flat<int32_t>(children[10])->set(i, manufactId);
+    setString(children[11], i, makeWord(manufactId));
+    flat<int32_t>(children[12])->set(i, random.range(5, itemSk, 1, 100));
+  }
+}
+
+void genStore(std::vector<VectorPtr>& children, size_t size, size_t offset) {
+  const RowRandom random(Table::TBL_STORE);
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t storeSk = offset + i + 1;
+    flat<int64_t>(children[0])->set(i, storeSk);
+    setString(children[1], i, makeId(storeSk));
+    setString(children[2], i, makeWord(storeSk));
+    setString(
+        children[3],
+        i,
+        kCities[random.range(0, storeSk, 0, kCities.size() - 1)]);
+    setString(
+        children[4],
+        i,
+        kCounties[random.range(1, storeSk, 0, kCounties.size() - 1)]);
+    setString(
+        children[5],
+        i,
+        kStoreStates[random.range(2, storeSk, 0, kStoreStates.size() - 1)]);
+    setString(children[6], i, makeZip(random, 3, storeSk));
+  }
+}
+
+void genCustomer(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset,
+    double scaleFactor) {
+  const RowRandom random(Table::TBL_CUSTOMER);
+  const int64_t numDemographics =
+      getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, scaleFactor);
+  const int64_t numAddresses =
+      getRowCount(Table::TBL_CUSTOMER_ADDRESS, scaleFactor);
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t customerSk = offset + i + 1;
+    flat<int64_t>(children[0])->set(i, customerSk);
+    setString(children[1], i, makeId(customerSk));
+    flat<int64_t>(children[2])
+        ->set(i, random.range(0, customerSk, 1, numDemographics));
+    flat<int64_t>(children[3])
+        ->set(i, random.range(1, customerSk, 1, numAddresses));
+    setString(
+        children[4],
+        i,
+        kFirstNames[random.range(2, customerSk, 0, kFirstNames.size() - 1)]);
+    setString(
+        children[5],
+        i,
+        kLastNames[random.range(3, customerSk, 0, kLastNames.size() - 1)]);
+    flat<int32_t>(children[6])->set(i, random.range(4, customerSk, 1924, 1992));
+  }
+}
+
+void genCustomerAddress(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset) {
+  const RowRandom random(Table::TBL_CUSTOMER_ADDRESS);
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t addressSk = offset + i + 1;
+    flat<int64_t>(children[0])->set(i, addressSk);
+    setString(children[1], i, makeId(addressSk));
+    setString(
+        children[2],
+        i,
+        kCities[random.range(0, addressSk, 0, kCities.size() - 1)]);
+    setString(
+        children[3],
+        i,
+        kCounties[random.range(1, addressSk, 0, kCounties.size() - 1)]);
+    setString(
+        children[4],
+        i,
+        kStates[random.range(2, addressSk, 0, kStates.size() - 1)]);
+    setString(children[5], i, makeZip(random, 3, addressSk));
+    setString(children[6], i, "United States");
+  }
+}
+
+void genCustomerDemographics(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset) {
+  // Each row is a combination of the attribute values, with the gender
+  // varying fastest, like in dsdgen. The first 70 rows have all combinations
+  // of gender, marital and education status.
+  for (size_t i = 0; i < size; ++i) {
+    const int64_t demoSk = offset + i + 1;
+    auto remaining = offset + i;
+    auto nextDigit = [&](size_t base) {
+      const auto digit = remaining % base;
+      remaining /= base;
+      return digit;
+    };
+    flat<int64_t>(children[0])->set(i, demoSk);
+    setString(children[1], i, kGenders[nextDigit(kGenders.size())]);
+    setString(
+        children[2], i, kMaritalStatuses[nextDigit(kMaritalStatuses.size())]);
+    setString(
+        children[3],
+        i,
+        kEducationStatuses[nextDigit(kEducationStatuses.size())]);
+    flat<int32_t>(children[4])->set(i, (nextDigit(20) + 1) * 500);
+    setString(children[5], i, kCreditRatings[nextDigit(kCreditRatings.size())]);
+    flat<int32_t>(children[6])->set(i, nextDigit(7));
+    flat<int32_t>(children[7])->set(i, nextDigit(7));
+    flat<int32_t>(children[8])->set(i, nextDigit(7));
+  }
+}
+
+void genStoreSales(
+    std::vector<VectorPtr>& children,
+    size_t size,
+    size_t offset,
+    double scaleFactor) {
+  const RowRandom random(Table::TBL_STORE_SALES);
+  const int64_t numItems = getRowCount(Table::TBL_ITEM, scaleFactor);
+  const int64_t numStores = getRowCount(Table::TBL_STORE, scaleFactor);
+  const int64_t numCustomers = getRowCount(Table::TBL_CUSTOMER, scaleFactor);
+  const int64_t numDemographics =
+      getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, scaleFactor);
+  const int64_t numAddresses =
+      getRowCount(Table::TBL_CUSTOMER_ADDRESS, scaleFactor);
+  for (size_t i = 0; i < size; ++i) {
+    const uint64_t row = offset + i;
+    const uint64_t ticket = row / kRowsPerTicket + 1;
+
+    // The rows of a ticket share the date, the customer and the store.
+    flat<int64_t>(children[0])
+        ->set(
+            i,
+            kFirstSalesDate + kJulianEpoch +
+                random.range(0, ticket, 0, kNumSalesDays - 1));
+    flat<int64_t>(children[1])->set(i, random.range(1, row, 1, numItems));
+    flat<int64_t>(children[2])
+        ->set(i, random.range(2, ticket, 1, numCustomers));
+    flat<int64_t>(children[3])
+        ->set(i, random.range(3, ticket, 1, numDemographics));
+    flat<int64_t>(children[4])
+        ->set(i, random.range(4, ticket, 1, numAddresses));
+    flat<int64_t>(children[5])->set(i, random.range(5, ticket, 1, numStores));
+    flat<int64_t>(children[6])->set(i, ticket);
+
+    const int32_t quantity = random.range(6, row, 1, 100);
+    const double wholesaleCost = random.money(7, row, 100, 10'000);
+    const double listPrice = roundToCents(
+        wholesaleCost * (1 + random.range(8, row, 0, 100) / 100.0));
+    const double salesPrice = roundToCents(
+        listPrice * (1 - random.range(9, row, 0, 100) / 100.0));
+    const double extSalesPrice = roundToCents(salesPrice * quantity);
+    // Every fifth row has a coupon of up to the full price.
+    const double couponAmount = random.range(10, row, 0, 4) == 0
+        ? roundToCents(extSalesPrice * random.range(11, row, 0, 100) / 100.0)
+        : 0;
+    const double netPaid = roundToCents(extSalesPrice - couponAmount);
+
+    flat<int32_t>(children[7])->set(i, quantity);
+    flat<double>(children[8])->set(i, wholesaleCost);
+    flat<double>(children[9])->set(i, listPrice);
+    flat<double>(children[10])->set(i, salesPrice);
+    flat<double>(children[11])->set(i, extSalesPrice);
+    flat<double>(children[12])->set(i, couponAmount);
+    flat<double>(children[13])->set(i, netPaid);
+    flat<double>(children[14])
+        ->set(i, roundToCents(netPaid - wholesaleCost * quantity));
+  }
+}
+
+} // namespace
+
+std::string_view toTableName(Table table) {
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return "date_dim";
+    case Table::TBL_ITEM:
+      return "item";
+    case Table::TBL_STORE:
+      return "store";
+    case Table::TBL_CUSTOMER:
+      return "customer";
+    case Table::TBL_CUSTOMER_ADDRESS:
+      return "customer_address";
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return "customer_demographics";
+    case Table::TBL_STORE_SALES:
+      return "store_sales";
+  }
+  return ""; // make gcc happy.
+}
+
+Table fromTableName(std::string_view tableName) {
+  static std::unordered_map<std::string_view, Table> map{
+      {"date_dim", Table::TBL_DATE_DIM},
+      {"item", Table::TBL_ITEM},
+      {"store", Table::TBL_STORE},
+      {"customer", Table::TBL_CUSTOMER},
+      {"customer_address", Table::TBL_CUSTOMER_ADDRESS},
+      {"customer_demographics", Table::TBL_CUSTOMER_DEMOGRAPHICS},
+      {"store_sales", Table::TBL_STORE_SALES},
+  };
+
+  auto it = map.find(tableName);
+  if (it != map.end()) {
+    return it->second;
+  }
+  throw std::invalid_argument(
+      fmt::format("Invalid TPC-DS table name: '{}'", tableName));
+}
+
+size_t getRowCount(Table table, double scaleFactor) {
+  VELOX_CHECK_GE(scaleFactor, 0, "Tpcds scale factor must be non-negative");
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return 73'049;
+    case Table::TBL_ITEM:
+      return steppedRowCount(
+          scaleFactor, {18'000, 102'000, 204'000, 300'000, 402'000});
+    case Table::TBL_STORE:
+      return steppedRowCount(scaleFactor, {12, 102, 402, 1'002, 1'500});
+    case Table::TBL_CUSTOMER:
+      return scaledRowCount(
+          scaleFactor,
+          {100'000, 500'000, 2'000'000, 12'000'000, 65'000'000});
+    case Table::TBL_CUSTOMER_ADDRESS:
+      return scaledRowCount(
+          scaleFactor, {50'000, 250'000, 1'000'000, 6'000'000, 32'500'000});
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return scaleFactor < 1 ? static_cast<size_t>(1'920'800 * scaleFactor)
+                             : 1'920'800;
+    case Table::TBL_STORE_SALES:
+      return 2'880'404 * scaleFactor;
+  }
+  return 0; // make gcc happy.
+}
+
+RowTypePtr getTableSchema(Table table) {
+  switch (table) {
+    case Table::TBL_DATE_DIM: {
+      static RowTypePtr type = ROW(
+          {
+              "d_date_sk",
+              "d_date_id",
+              "d_date",
+              "d_month_seq",
+              "d_year",
+              "d_dow",
+              "d_moy",
+              "d_dom",
+              "d_qoy",
+              "d_day_name",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              DATE(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              VARCHAR(),
+          });
+      return type;
+    }
+    case Table::TBL_ITEM: {
+      static RowTypePtr type = ROW(
+          {
+              "i_item_sk",
+              "i_item_id",
+              "i_item_desc",
+              "i_current_price",
+              "i_brand_id",
+              "i_brand",
+              "i_class_id",
+              "i_class",
+              "i_category_id",
+              "i_category",
+              "i_manufact_id",
+              "i_manufact",
+              "i_manager_id",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              DOUBLE(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+          });
+      return type;
+    }
+    case Table::TBL_STORE: {
+      static RowTypePtr type = ROW(
+          {
+              "s_store_sk",
+              "s_store_id",
+              "s_store_name",
+              "s_city",
+              "s_county",
+              "s_state",
+              "s_zip",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+          });
+      return type;
+    }
+    case Table::TBL_CUSTOMER: {
+      static RowTypePtr type = ROW(
+          {
+              "c_customer_sk",
+              "c_customer_id",
+              "c_current_cdemo_sk",
+              "c_current_addr_sk",
+              "c_first_name",
+              "c_last_name",
+              "c_birth_year",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              BIGINT(),
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              INTEGER(),
+          });
+      return type;
+    }
+    case Table::TBL_CUSTOMER_ADDRESS: {
+      static RowTypePtr type = ROW(
+          {
+              "ca_address_sk",
+              "ca_address_id",
+              "ca_city",
+              "ca_county",
+              "ca_state",
+              "ca_zip",
+              "ca_country",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+          });
+      return type;
+    }
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS: {
+      static RowTypePtr type = ROW(
+          {
+              "cd_demo_sk",
+              "cd_gender",
+              "cd_marital_status",
+              "cd_education_status",
+              "cd_purchase_estimate",
+              "cd_credit_rating",
+              "cd_dep_count",
+              "cd_dep_employed_count",
+              "cd_dep_college_count",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+          });
+      return type;
+    }
+    case Table::TBL_STORE_SALES: {
+      static RowTypePtr type = ROW(
+          {
+              "ss_sold_date_sk",
+              "ss_item_sk",
+              "ss_customer_sk",
+              "ss_cdemo_sk",
+              "ss_addr_sk",
+              "ss_store_sk",
+              "ss_ticket_number",
+              "ss_quantity",
+              "ss_wholesale_cost",
+              "ss_list_price",
+              "ss_sales_price",
+              "ss_ext_sales_price",
+              "ss_coupon_amt",
+              "ss_net_paid",
+              "ss_net_profit",
+          },
+          {
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              INTEGER(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+          });
+      return type;
+    }
+  }
+  return nullptr; // make gcc happy.
+}
+
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName) {
+  return getTableSchema(table)->findChild(columnName);
+}
+
+RowVectorPtr genTpcdsData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  auto rowType = getTableSchema(table);
+  size_t vectorSize =
+      getVectorSize(getRowCount(table, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(rowType, vectorSize, pool);
+
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      genDateDim(children, vectorSize, offset);
+      break;
+    case Table::TBL_ITEM:
+      genItem(children, vectorSize, offset);
+      break;
+    case Table::TBL_STORE:
+      genStore(children, vectorSize, offset);
+      break;
+    case Table::TBL_CUSTOMER:
+      genCustomer(children, vectorSize, offset, scaleFactor);
+      break;
+    case Table::TBL_CUSTOMER_ADDRESS:
+      genCustomerAddress(children, vectorSize, offset);
+      break;
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      genCustomerDemographics(children, vectorSize, offset);
+      break;
+    case Table::TBL_STORE_SALES:
+      genStoreSales(children, vectorSize, offset, scaleFactor);
+      break;
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+std::string getQuery(int query) {
+  switch (query) {
+    case 3:
+      return "SELECT dt.d_year, item.i_brand_id brand_id, item.i_brand brand, "
+             "sum(ss_ext_sales_price) sum_agg "
+             "FROM date_dim dt, store_sales, item "
+             "WHERE dt.d_date_sk = store_sales.ss_sold_date_sk "
+             "AND store_sales.ss_item_sk = item.i_item_sk "
+             "AND item.i_manufact_id = 128 AND dt.d_moy = 11 "
+             "GROUP BY dt.d_year, item.i_brand, item.i_brand_id "
+             "ORDER BY dt.d_year, sum_agg DESC, brand_id LIMIT 100";
+    case 19:
+      return "SELECT i_brand_id brand_id, i_brand brand, i_manufact_id, "
+             "i_manufact, sum(ss_ext_sales_price) ext_price "
+             "FROM date_dim, store_sales, item, customer, customer_address, "
+             "store "
+             "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+             "AND i_manager_id = 8 AND d_moy = 11 AND d_year = 1998 "
+             "AND ss_customer_sk = c_customer_sk "
+             "AND c_current_addr_sk = ca_address_sk "
+             "AND substr(ca_zip, 1, 5) <> substr(s_zip, 1, 5) "
+             "AND ss_store_sk = s_store_sk "
+             "GROUP BY i_brand, i_brand_id, i_manufact_id, i_manufact "
+             "ORDER BY ext_price DESC, i_brand, i_brand_id, i_manufact_id, "
+             "i_manufact LIMIT 100";
+    case 27:
+      return "SELECT i_item_id, s_state, grouping(s_state) g_state, "
+             "avg(ss_quantity) agg1, avg(ss_list_price) agg2, "
+             "avg(ss_coupon_amt) agg3, avg(ss_sales_price) agg4 "
+             "FROM store_sales, customer_demographics, date_dim, store, item "
+             "WHERE ss_sold_date_sk = d_date_sk AND ss_item_sk = i_item_sk "
+             "AND ss_store_sk = s_store_sk AND ss_cdemo_sk = cd_demo_sk "
+             "AND cd_gender = 'M' AND cd_marital_status = 'S' "
+             "AND cd_education_status = 'College' AND d_year = 2002 "
+             "AND s_state IN ('TN') "
+             "GROUP BY ROLLUP (i_item_id, s_state) "
+             "ORDER BY i_item_id NULLS LAST, s_state NULLS LAST LIMIT 100";
+    case 55:
+      return "SELECT i_brand_id brand_id, i_brand brand, "
+             "sum(ss_ext_sales_price) ext_price "
+             "FROM date_dim, store_sales, item "
+             "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+             "AND i_manager_id = 28 AND d_moy = 11 AND d_year = 1999 "
+             "GROUP BY i_brand, i_brand_id "
+             "ORDER BY ext_price DESC, i_brand_id LIMIT 100";
+    case 98:
+      return "SELECT i_item_id, i_item_desc, i_category, i_class, "
+             "i_current_price, sum(ss_ext_sales_price) AS itemrevenue, "
+             "sum(ss_ext_sales_price) * 100 / "
+             "sum(sum(ss_ext_sales_price)) OVER (PARTITION BY i_class) "
+             "AS revenueratio "
+             "FROM store_sales, item, date_dim "
+             "WHERE ss_item_sk = i_item_sk "
+             "AND i_category IN ('Sports', 'Books', 'Home') "
+             "AND ss_sold_date_sk = d_date_sk "
+             "AND d_date BETWEEN cast('1999-02-22' AS date) "
+             "AND cast('1999-03-24' AS date) "
+             "GROUP BY i_item_id, i_item_desc, i_category, i_class, "
+             "i_current_price "
+             "ORDER BY i_category, i_class, i_item_id, i_item_desc, "
+             "revenueratio";
+    default:
+      VELOX_FAIL("TPC-DS query {} is not supported", query);
+  }
+}
+
+} // namespace facebook::velox::tpcds
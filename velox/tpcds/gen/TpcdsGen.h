@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::tpcds {
+
+/// Generates the tables of the TPC-DS store sales star schema encoded using
+/// Velox Vectors.
+///
+/// This is not dsdgen. The tables have the names, keys and a subset of the
+/// columns of the TPC-DS spec, and the value domains the spec queries filter
+/// on, e.g. categories, manufacturer ids, months and customer demographics,
+/// so that the queries of the store channel select a realistic share of the
+/// rows. Each value is a function of the table, the column and the row number
+/// only. The data for a scale factor is therefore the same in every run and
+/// any range of rows can be generated independently, like with the TPC-H
+/// generator.
+///
+/// The API follows TpchGen: callers pass the table, the scale factor, the
+/// maximum batch size and the offset, and advance the offset until all of
+/// "[0, getRowCount(Table, scaleFactor)[" is read. Less than maxRows rows are
+/// returned at the end of the table.
+
+enum class Table : uint8_t {
+  TBL_DATE_DIM,
+  TBL_ITEM,
+  TBL_STORE,
+  TBL_CUSTOMER,
+  TBL_CUSTOMER_ADDRESS,
+  TBL_CUSTOMER_DEMOGRAPHICS,
+  TBL_STORE_SALES,
+};
+
+static constexpr auto tables = {
+    tpcds::Table::TBL_DATE_DIM,
+    tpcds::Table::TBL_ITEM,
+    tpcds::Table::TBL_STORE,
+    tpcds::Table::TBL_CUSTOMER,
+    tpcds::Table::TBL_CUSTOMER_ADDRESS,
+    tpcds::Table::TBL_CUSTOMER_DEMOGRAPHICS,
+    tpcds::Table::TBL_STORE_SALES};
+
+/// Returns table name as a string.
+std::string_view toTableName(Table table);
+
+/// Returns the table enum value given a table name.
+Table fromTableName(std::string_view tableName);
+
+/// Returns the row count for a particular TPC-DS table given a scale factor.
+/// Follows the row counts of the spec for the scale factors it defines. Below
+/// scale factor 1 the fact table, customer, customer_address and
+/// customer_demographics shrink with the scale factor so that test data stays
+/// small, while date_dim, item and store keep their size at scale factor 1.
+size_t getRowCount(Table table, double scaleFactor);
+
+/// Returns the schema (RowType) for a particular TPC-DS table.
+RowTypePtr getTableSchema(Table table);
+
+/// Returns the type of a particular table:column pair. Throws if `columnName`
+/// does not exist in `table`.
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName);
+
+/// Returns a row vector containing at most `maxRows` rows of `table`,
+/// starting at `offset`, and given the scale factor. The row vector has the
+/// schema returned by getTableSchema(table).
+RowVectorPtr genTpcdsData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns the SQL text of the specified TPC-DS query as accepted by DuckDB.
+/// Only the queries built by TpcdsQueryBuilder are available. Throws for
+/// others.
+std::string getQuery(int query);
+
+} // namespace facebook::velox::tpcds
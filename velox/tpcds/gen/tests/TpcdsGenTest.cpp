@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+#include "velox/vector/FlatVector.h"
+
+namespace {
+
+using namespace facebook::velox;
+using namespace facebook::velox::tpcds;
+
+class TpcdsGenTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    pool_ = memory::memoryManager()->addLeafPool("TpcdsGenTest");
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+TEST_F(TpcdsGenTest, tableNames) {
+  for (const auto table : tables) {
+    EXPECT_EQ(table, fromTableName(toTableName(table)));
+    EXPECT_EQ(
+        genTpcdsData(table, pool_.get(), 1)->type()->toString(),
+        getTableSchema(table)->toString());
+  }
+  EXPECT_THROW(fromTableName("web_sales"), std::invalid_argument);
+}
+
+TEST_F(TpcdsGenTest, rowCount) {
+  EXPECT_EQ(73'049, getRowCount(Table::TBL_DATE_DIM, 0.01));
+  EXPECT_EQ(18'000, getRowCount(Table::TBL_ITEM, 0.01));
+  EXPECT_EQ(102'000, getRowCount(Table::TBL_ITEM, 10));
+  EXPECT_EQ(12, getRowCount(Table::TBL_STORE, 1));
+  EXPECT_EQ(1'000, getRowCount(Table::TBL_CUSTOMER, 0.01));
+  EXPECT_EQ(500'000, getRowCount(Table::TBL_CUSTOMER, 10));
+  EXPECT_EQ(1'920'800, getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, 100));
+  EXPECT_EQ(2'880'404, getRowCount(Table::TBL_STORE_SALES, 1));
+}
+
+TEST_F(TpcdsGenTest, dateDim) {
+  auto rowVector = genTpcdsData(Table::TBL_DATE_DIM, pool_.get(), 10, 35'794);
+  ASSERT_EQ(10, rowVector->size());
+
+  // 1998-01-02 was a Friday.
+  EXPECT_EQ(
+      2'450'816, rowVector->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
+  EXPECT_EQ(
+      DATE()->toDays("1998-01-02"),
+      rowVector->childAt(2)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(1998, rowVector->childAt(4)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(5, rowVector->childAt(5)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(1, rowVector->childAt(6)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(2, rowVector->childAt(7)->asFlatVector<int32_t>()->valueAt(0));
+  EXPECT_EQ(
+      "Friday"_sv,
+      rowVector->childAt(9)->asFlatVector<StringView>()->valueAt(0));
+}
+
+TEST_F(TpcdsGenTest, customerDemographics) {
+  auto rowVector =
+      genTpcdsData(Table::TBL_CUSTOMER_DEMOGRAPHICS, pool_.get(), 70, 0, 0.01);
+  ASSERT_EQ(70, rowVector->size());
+
+  // The first 70 rows have all combinations of gender, marital status and
+  // education.
+  std::set<std::string> combinations;
+  for (auto i = 0; i < rowVector->size(); ++i) {
+    std::string combination;
+    for (auto column = 1; column <= 3; ++column) {
+      combination += rowVector->childAt(column)
+                         ->asFlatVector<StringView>()
+                         ->valueAt(i)
+                         .str();
+      combination += ",";
+    }
+    combinations.insert(combination);
+  }
+  EXPECT_EQ(70, combinations.size());
+  EXPECT_EQ(1, combinations.count("M,S,College,"));
+}
+
+// Generating a range of rows in one or several batches gives the same rows.
+TEST_F(TpcdsGenTest, deterministic) {
+  for (const auto table : tables) {
+    SCOPED_TRACE(toTableName(table));
+    auto all = genTpcdsData(table, pool_.get(), 100, 0, 0.01);
+    auto first = genTpcdsData(table, pool_.get(), 40, 0, 0.01);
+    auto second = genTpcdsData(table, pool_.get(), 60, 40, 0.01);
+    ASSERT_EQ(all->size(), first->size() + second->size());
+    for (auto i = 0; i < all->size(); ++i) {
+      if (i < first->size()) {
+        ASSERT_TRUE(all->equalValueAt(first.get(), i, i));
+      } else {
+        ASSERT_TRUE(all->equalValueAt(second.get(), i, i - first->size()));
+      }
+    }
+  }
+}
+
+} // namespace
@@ -17,6 +17,7 @@
 #include "velox/tpch/gen/TpchGen.h"
 #include <velox/tpch/gen/dbgen/include/tpch_constants.hpp>
 #include "velox/tpch/gen/DBGenIterator.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::tpch {
@@ -63,25 +64,65 @@ size_t getVectorSize(size_t rowCount, size_t maxRows, size_t offset) {
   return std::min(rowCount - offset, maxRows);
 }
 
+// Allocates flat vectors for the columns in 'columns', or for all columns if
+// 'columns' is not set. The other columns are null constants that the
+// generators skip, which saves converting and copying their values.
 std::vector<VectorPtr> allocateVectors(
     const RowTypePtr& type,
     size_t vectorSize,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::optional<std::vector<column_index_t>>& columns) {
+  std::vector<bool> projected(type->size(), !columns.has_value());
+  if (columns.has_value()) {
+    for (auto column : columns.value()) {
+      VELOX_CHECK_LT(column, type->size());
+      projected[column] = true;
+    }
+  }
+
   std::vector<VectorPtr> vectors;
   vectors.reserve(type->size());
-
-  for (const auto& childType : type->children()) {
-    vectors.emplace_back(BaseVector::create(childType, vectorSize, pool));
+  for (auto i = 0; i < type->size(); ++i) {
+    const auto& childType = type->childAt(i);
+    vectors.emplace_back(
+        projected[i]
+            ? BaseVector::create(childType, vectorSize, pool)
+            : BaseVector::createNullConstant(childType, vectorSize, pool));
   }
   return vectors;
 }
 
+// Sets 'row' of 'vector' to the value returned by 'makeValue'. 'vector' is
+// nullptr if the column is not projected, in which case the value is not
+// computed.
+template <typename T, typename F>
+FOLLY_ALWAYS_INLINE void
+setIfProjected(FlatVector<T>* vector, vector_size_t row, F makeValue) {
+  if (vector != nullptr) {
+    vector->set(row, makeValue());
+  }
+}
+
 double decimalToDouble(int64_t value) {
   return (double)value * 0.01;
 }
 
-int32_t toDate(std::string_view stringDate) {
-  return DATE()->toDays(stringDate);
+// Dbgen formats dates as "yyyy-mm-dd". Converting the fields directly is much
+// cheaper than the general date parser, which matters for lineitem with its
+// three dates per row.
+int32_t toDate(const char* stringDate) {
+  auto digits = [&](int32_t begin, int32_t end) {
+    int32_t value = 0;
+    for (auto i = begin; i < end; ++i) {
+      value = value * 10 + (stringDate[i] - '0');
+    }
+    return value;
+  };
+  int64_t days;
+  const auto status = util::daysSinceEpochFromDate(
+      digits(0, 4), digits(5, 7), digits(8, 10), days);
+  VELOX_CHECK(status.ok(), "Invalid dbgen date: {}", stringDate);
+  return days;
 }
 
 } // namespace
@@ -357,12 +398,13 @@ RowVectorPtr genTpchOrders(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::optional<std::vector<column_index_t>>& columns) {
   // Create schema and allocate vectors.
   auto ordersRowType = getTableSchema(Table::TBL_ORDERS);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_ORDERS, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(ordersRowType, vectorSize, pool);
+  auto children = allocateVectors(ordersRowType, vectorSize, pool, columns);
 
   auto orderKeyVector = children[0]->asFlatVector<int64_t>();
   auto custKeyVector = children[1]->asFlatVector<int64_t>();
@@ -383,16 +425,25 @@ RowVectorPtr genTpchOrders(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genOrder(i + offset + 1, order);
 
-    orderKeyVector->set(i, order.okey);
-    custKeyVector->set(i, order.custkey);
-    orderStatusVector->set(i, StringView(&order.orderstatus, 1));
-    totalPriceVector->set(i, decimalToDouble(order.totalprice));
-    orderDateVector->set(i, toDate(order.odate));
-    orderPriorityVector->set(
-        i, StringView(order.opriority, strlen(order.opriority)));
-    clerkVector->set(i, StringView(order.clerk, strlen(order.clerk)));
-    shipPriorityVector->set(i, order.spriority);
-    commentVector->set(i, StringView(order.comment, order.clen));
+    setIfProjected(orderKeyVector, i, [&] { return order.okey; });
+    setIfProjected(custKeyVector, i, [&] { return order.custkey; });
+    setIfProjected(orderStatusVector, i, [&] {
+      return StringView(&order.orderstatus, 1);
+    });
+    setIfProjected(totalPriceVector, i, [&] {
+      return decimalToDouble(order.totalprice);
+    });
+    setIfProjected(orderDateVector, i, [&] { return toDate(order.odate); });
+    setIfProjected(orderPriorityVector, i, [&] {
+      return StringView(order.opriority, strlen(order.opriority));
+    });
+    setIfProjected(clerkVector, i, [&] {
+      return StringView(order.clerk, strlen(order.clerk));
+    });
+    setIfProjected(shipPriorityVector, i, [&] { return order.spriority; });
+    setIfProjected(commentVector, i, [&] {
+      return StringView(order.comment, order.clen);
+    });
   }
   return std::make_shared<RowVector>(
       pool, ordersRowType, BufferPtr(nullptr), vectorSize, std::move(children));
@@ -402,7 +453,8 @@ RowVectorPtr genTpchLineItem(
     memory::MemoryPool* pool,
     size_t maxOrderRows,
     size_t ordersOffset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::optional<std::vector<column_index_t>>& columns) {
   // We control the buffer size based on the orders table, then allocate the
   // underlying buffer using the worst case (orderVectorSize * 7).
   size_t orderVectorSize = getVectorSize(
@@ -411,7 +463,8 @@ RowVectorPtr genTpchLineItem(
 
   // Create schema and allocate vectors.
   auto lineItemRowType = getTableSchema(Table::TBL_LINEITEM);
-  auto children = allocateVectors(lineItemRowType, lineItemUpperBound, pool);
+  auto children =
+      allocateVectors(lineItemRowType, lineItemUpperBound, pool, columns);
 
   auto orderKeyVector = children[0]->asFlatVector<int64_t>();
   auto partKeyVector = children[1]->asFlatVector<int64_t>();
@@ -447,31 +500,45 @@ RowVectorPtr genTpchLineItem(
 
     for (size_t l = 0; l < order.lines; ++l) {
       const auto& line = order.l[l];
-      orderKeyVector->set(lineItemCount + l, line.okey);
-      partKeyVector->set(lineItemCount + l, line.partkey);
-      suppKeyVector->set(lineItemCount + l, line.suppkey);
-
-      lineNumberVector->set(lineItemCount + l, line.lcnt);
-
-      quantityVector->set(lineItemCount + l, decimalToDouble(line.quantity));
-      extendedPriceVector->set(lineItemCount + l, decimalToDouble(line.eprice));
-      discountVector->set(lineItemCount + l, decimalToDouble(line.discount));
-      taxVector->set(lineItemCount + l, decimalToDouble(line.tax));
-
-      returnFlagVector->set(lineItemCount + l, StringView(line.rflag, 1));
-      lineStatusVector->set(lineItemCount + l, StringView(line.lstatus, 1));
-
-      shipDateVector->set(lineItemCount + l, toDate(line.sdate));
-      commitDateVector->set(lineItemCount + l, toDate(line.cdate));
-      receiptDateVector->set(lineItemCount + l, toDate(line.rdate));
-
-      shipInstructVector->set(
-          lineItemCount + l,
-          StringView(line.shipinstruct, strlen(line.shipinstruct)));
-      shipModeVector->set(
-          lineItemCount + l, StringView(line.shipmode, strlen(line.shipmode)));
-      commentVector->set(
-          lineItemCount + l, StringView(line.comment, strlen(line.comment)));
+      const auto row = lineItemCount + l;
+      setIfProjected(orderKeyVector, row, [&] { return line.okey; });
+      setIfProjected(partKeyVector, row, [&] { return line.partkey; });
+      setIfProjected(suppKeyVector, row, [&] { return line.suppkey; });
+
+      setIfProjected(lineNumberVector, row, [&] { return line.lcnt; });
+
+      setIfProjected(quantityVector, row, [&] {
+        return decimalToDouble(line.quantity);
+      });
+      setIfProjected(extendedPriceVector, row, [&] {
+        return decimalToDouble(line.eprice);
+      });
+      setIfProjected(discountVector, row, [&] {
+        return decimalToDouble(line.discount);
+      });
+      setIfProjected(
+          taxVector, row, [&] { return decimalToDouble(line.tax); });
+
+      setIfProjected(
+          returnFlagVector, row, [&] { return StringView(line.rflag, 1); });
+      setIfProjected(
+          lineStatusVector, row, [&] { return StringView(line.lstatus, 1); });
+
+      setIfProjected(shipDateVector, row, [&] { return toDate(line.sdate); });
+      setIfProjected(
+          commitDateVector, row, [&] { return toDate(line.cdate); });
+      setIfProjected(
+          receiptDateVector, row, [&] { return toDate(line.rdate); });
+
+      setIfProjected(shipInstructVector, row, [&] {
+        return StringView(line.shipinstruct, strlen(line.shipinstruct));
+      });
+      setIfProjected(shipModeVector, row, [&] {
+        return StringView(line.shipmode, strlen(line.shipmode));
+      });
+      setIfProjected(commentVector, row, [&] {
+        return StringView(line.comment, strlen(line.comment));
+      });
     }
     lineItemCount += order.lines;
   }
@@ -492,12 +559,13 @@ RowVectorPtr genTpchPart(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::optional<std::vector<column_index_t>>& columns) {
   // Create schema and allocate vectors.
   auto partRowType = getTableSchema(Table::TBL_PART);
   size_t vectorSize =
       getVectorSize(getRowCount(Table::TBL_PART, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(partRowType, vectorSize, pool);
+  auto children = allocateVectors(partRowType, vectorSize, pool, columns);
 
   auto partKeyVector = children[0]->asFlatVector<int64_t>();
   auto nameVector = children[1]->asFlatVector<StringView>();
@@ -518,15 +586,28 @@ RowVectorPtr genTpchPart(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genPart(i + offset + 1, part);
 
-    partKeyVector->set(i, part.partkey);
-    nameVector->set(i, StringView(part.name, strlen(part.name)));
-    mfgrVector->set(i, StringView(part.mfgr, strlen(part.mfgr)));
-    brandVector->set(i, StringView(part.brand, strlen(part.brand)));
-    typeVector->set(i, StringView(part.type, part.tlen));
-    sizeVector->set(i, part.size);
-    containerVector->set(i, StringView(part.container, strlen(part.container)));
-    retailPriceVector->set(i, decimalToDouble(part.retailprice));
-    commentVector->set(i, StringView(part.comment, part.clen));
+    setIfProjected(partKeyVector, i, [&] { return part.partkey; });
+    setIfProjected(nameVector, i, [&] {
+      return StringView(part.name, strlen(part.name));
+    });
+    setIfProjected(mfgrVector, i, [&] {
+      return StringView(part.mfgr, strlen(part.mfgr));
+    });
+    setIfProjected(brandVector, i, [&] {
+      return StringView(part.brand, strlen(part.brand));
+    });
+    setIfProjected(
+        typeVector, i, [&] { return StringView(part.type, part.tlen); });
+    setIfProjected(sizeVector, i, [&] { return part.size; });
+    setIfProjected(containerVector, i, [&] {
+      return StringView(part.container, strlen(part.container));
+    });
+    setIfProjected(retailPriceVector, i, [&] {
+      return decimalToDouble(part.retailprice);
+    });
+    setIfProjected(commentVector, i, [&] {
+      return StringView(part.comment, part.clen);
+    });
   }
   return std::make_shared<RowVector>(
       pool, partRowType, BufferPtr(nullptr), vectorSize, std::move(children));
@@ -536,12 +617,13 @@ RowVectorPtr genTpchSupplier(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::optional<std::vector<column_index_t>>& columns) {
   // Create schema and allocate vectors.
   auto supplierRowType = getTableSchema(Table::TBL_SUPPLIER);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_SUPPLIER, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(supplierRowType, vectorSize, pool);
+  auto children = allocateVectors(supplierRowType, vectorSize, pool, columns);
 
   auto suppKeyVector = children[0]->asFlatVector<int64_t>();
   auto nameVector = children[1]->asFlatVector<StringView>();
@@ -560,13 +642,20 @@ RowVectorPtr genTpchSupplier(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genSupplier(i + offset + 1, supp);
 
-    suppKeyVector->set(i, supp.suppkey);
-    nameVector->set(i, StringView(supp.name, strlen(supp.name)));
-    addressVector->set(i, StringView(supp.address, supp.alen));
-    nationKeyVector->set(i, supp.nation_code);
-    phoneVector->set(i, StringView(supp.phone, strlen(supp.phone)));
-    acctbalVector->set(i, decimalToDouble(supp.acctbal));
-    commentVector->set(i, StringView(supp.comment, supp.clen));
+    setIfProjected(suppKeyVector, i, [&] { return supp.suppkey; });
+    setIfProjected(nameVector, i, [&] {
+      return StringView(supp.name, strlen(supp.name));
+    });
+    setIfProjected(
+        addressVector, i, [&] { return StringView(supp.address, supp.alen); });
+    setIfProjected(nationKeyVector, i, [&] { return supp.nation_code; });
+    setIfProjected(phoneVector, i, [&] {
+      return StringView(supp.phone, strlen(supp.phone));
+    });
+    setIfProjected(
+        acctbalVector, i, [&] { return decimalToDouble(supp.acctbal); });
+    setIfProjected(
+        commentVector, i, [&] { return StringView(supp.comment, supp.clen); });
   }
   return std::make_shared<RowVector>(
       pool,
@@ -580,12 +669,13 @@ RowVectorPtr genTpchPartSupp(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::optional<std::vector<column_index_t>>& columns) {
   // Create schema and allocate vectors.
   auto partSuppRowType = getTableSchema(Table::TBL_PARTSUPP);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_PARTSUPP, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(partSuppRowType, vectorSize, pool);
+  auto children = allocateVectors(partSuppRowType, vectorSize, pool, columns);
 
   auto partKeyVector = children[0]->asFlatVector<int64_t>();
   auto suppKeyVector = children[1]->asFlatVector<int64_t>();
@@ -612,12 +702,18 @@ RowVectorPtr genTpchPartSupp(
     while ((partSuppIdx < SUPP_PER_PART) && (partSuppCount < vectorSize)) {
       const auto& partSupp = part.s[partSuppIdx];
 
-      partKeyVector->set(partSuppCount, partSupp.partkey);
-      suppKeyVector->set(partSuppCount, partSupp.suppkey);
-      availQtyVector->set(partSuppCount, partSupp.qty);
-      supplyCostVector->set(partSuppCount, decimalToDouble(partSupp.scost));
-      commentVector->set(
-          partSuppCount, StringView(partSupp.comment, partSupp.clen));
+      setIfProjected(
+          partKeyVector, partSuppCount, [&] { return partSupp.partkey; });
+      setIfProjected(
+          suppKeyVector, partSuppCount, [&] { return partSupp.suppkey; });
+      setIfProjected(
+          availQtyVector, partSuppCount, [&] { return partSupp.qty; });
+      setIfProjected(supplyCostVector, partSuppCount, [&] {
+        return decimalToDouble(partSupp.scost);
+      });
+      setIfProjected(commentVector, partSuppCount, [&] {
+        return StringView(partSupp.comment, partSupp.clen);
+      });
 
       ++partSuppIdx;
       ++partSuppCount;
@@ -640,12 +736,13 @@ RowVectorPtr genTpchCustomer(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::optional<std::vector<column_index_t>>& columns) {
   // Create schema and allocate vectors.
   auto customerRowType = getTableSchema(Table::TBL_CUSTOMER);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_CUSTOMER, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(customerRowType, vectorSize, pool);
+  auto children = allocateVectors(customerRowType, vectorSize, pool, columns);
 
   auto custKeyVector = children[0]->asFlatVector<int64_t>();
   auto nameVector = children[1]->asFlatVector<StringView>();
@@ -665,15 +762,23 @@ RowVectorPtr genTpchCustomer(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genCustomer(i + offset + 1, cust);
 
-    custKeyVector->set(i, cust.custkey);
-    nameVector->set(i, StringView(cust.name, strlen(cust.name)));
-    addressVector->set(i, StringView(cust.address, cust.alen));
-    nationKeyVector->set(i, cust.nation_code);
-    phoneVector->set(i, StringView(cust.phone, strlen(cust.phone)));
-    acctBalVector->set(i, decimalToDouble(cust.acctbal));
-    mktSegmentVector->set(
-        i, StringView(cust.mktsegment, strlen(cust.mktsegment)));
-    commentVector->set(i, StringView(cust.comment, cust.clen));
+    setIfProjected(custKeyVector, i, [&] { return cust.custkey; });
+    setIfProjected(nameVector, i, [&] {
+      return StringView(cust.name, strlen(cust.name));
+    });
+    setIfProjected(
+        addressVector, i, [&] { return StringView(cust.address, cust.alen); });
+    setIfProjected(nationKeyVector, i, [&] { return cust.nation_code; });
+    setIfProjected(phoneVector, i, [&] {
+      return StringView(cust.phone, strlen(cust.phone));
+    });
+    setIfProjected(
+        acctBalVector, i, [&] { return decimalToDouble(cust.acctbal); });
+    setIfProjected(mktSegmentVector, i, [&] {
+      return StringView(cust.mktsegment, strlen(cust.mktsegment));
+    });
+    setIfProjected(
+        commentVector, i, [&] { return StringView(cust.comment, cust.clen); });
   }
   return std::make_shared<RowVector>(
       pool,
@@ -687,12 +792,13 @@ RowVectorPtr genTpchNation(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::optional<std::vector<column_index_t>>& columns) {
   // Create schema and allocate vectors.
   auto nationRowType = getTableSchema(Table::TBL_NATION);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_NATION, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(nationRowType, vectorSize, pool);
+  auto children = allocateVectors(nationRowType, vectorSize, pool, columns);
 
   auto nationKeyVector = children[0]->asFlatVector<int64_t>();
   auto nameVector = children[1]->asFlatVector<StringView>();
@@ -708,10 +814,13 @@ RowVectorPtr genTpchNation(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genNation(i + offset + 1, code);
 
-    nationKeyVector->set(i, code.code);
-    nameVector->set(i, StringView(code.text, strlen(code.text)));
-    regionKeyVector->set(i, code.join);
-    commentVector->set(i, StringView(code.comment, code.clen));
+    setIfProjected(nationKeyVector, i, [&] { return code.code; });
+    setIfProjected(nameVector, i, [&] {
+      return StringView(code.text, strlen(code.text));
+    });
+    setIfProjected(regionKeyVector, i, [&] { return code.join; });
+    setIfProjected(
+        commentVector, i, [&] { return StringView(code.comment, code.clen); });
   }
   return std::make_shared<RowVector>(
       pool, nationRowType, BufferPtr(nullptr), vectorSize, std::move(children));
@@ -721,12 +830,13 @@ RowVectorPtr genTpchRegion(
     memory::MemoryPool* pool,
     size_t maxRows,
     size_t offset,
-    double scaleFactor) {
+    double scaleFactor,
+    const std::optional<std::vector<column_index_t>>& columns) {
   // Create schema and allocate vectors.
   auto regionRowType = getTableSchema(Table::TBL_REGION);
   size_t vectorSize = getVectorSize(
       getRowCount(Table::TBL_REGION, scaleFactor), maxRows, offset);
-  auto children = allocateVectors(regionRowType, vectorSize, pool);
+  auto children = allocateVectors(regionRowType, vectorSize, pool, columns);
 
   auto regionKeyVector = children[0]->asFlatVector<int64_t>();
   auto nameVector = children[1]->asFlatVector<StringView>();
@@ -741,9 +851,12 @@ RowVectorPtr genTpchRegion(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genRegion(i + offset + 1, code);
 
-    regionKeyVector->set(i, code.code);
-    nameVector->set(i, StringView(code.text, strlen(code.text)));
-    commentVector->set(i, StringView(code.comment, code.clen));
+    setIfProjected(regionKeyVector, i, [&] { return code.code; });
+    setIfProjected(nameVector, i, [&] {
+      return StringView(code.text, strlen(code.text));
+    });
+    setIfProjected(
+        commentVector, i, [&] { return StringView(code.comment, code.clen); });
   }
   return std::make_shared<RowVector>(
       pool, regionRowType, BufferPtr(nullptr), vectorSize, std::move(children));
@@ -424,6 +424,34 @@ TEST_F(TpchGenTestLineItemTest, reproducible) {
   }
 }
 
+// Only the projected columns are filled in. They have the same values as
+// without projection.
+TEST_F(TpchGenTestLineItemTest, projection) {
+  auto all = genTpchLineItem(pool_.get(), 100, 10);
+  auto projected = genTpchLineItem(
+      pool_.get(), 100, 10, 1, std::vector<column_index_t>{0, 10});
+  ASSERT_EQ(all->size(), projected->size());
+  ASSERT_EQ(16, projected->childrenSize());
+
+  for (auto i = 0; i < projected->childrenSize(); ++i) {
+    const auto& child = projected->childAt(i);
+    if (i == 0 || i == 10) {
+      ASSERT_TRUE(child->isFlatEncoding());
+      for (auto row = 0; row < child->size(); ++row) {
+        ASSERT_TRUE(child->equalValueAt(all->childAt(i).get(), row, row));
+      }
+    } else {
+      ASSERT_TRUE(child->isConstantEncoding());
+      ASSERT_TRUE(child->isNullAt(0));
+      ASSERT_EQ(all->size(), child->size());
+    }
+  }
+
+  auto none =
+      genTpchOrders(pool_.get(), 100, 10, 1, std::vector<column_index_t>{});
+  EXPECT_EQ(100, none->size());
+}
+
 // Supplier.
 class TpchGenTestSupplierTest : public testing::Test {
  protected:
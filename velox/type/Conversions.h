@@ -19,6 +19,8 @@
 #include <folly/Conv.h>
 #include <folly/Expected.h>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -81,8 +83,136 @@ Expected<T> callFollyTo(const F& v) {
   return result.value();
 }
 
+// Returns true if the 8 bytes of 'chunk' are all ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+// Returns the value of the 8 ASCII digits in 'chunk', loaded from memory in
+// little endian order, so that the first digit is the most significant. The
+// digits are combined in pairs, then quadruples, then the two halves, with
+// one multiplication per step.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32;
+  return chunk;
+}
+
 } // namespace detail
 
+/// Parses the 'size' characters at 'data' into 'result' if they are an
+/// optional minus sign followed by 1 to 18 decimal digits and the value fits in
+/// T. Digits are parsed 8 at a time. Returns false without setting 'result' for
+/// any other input, e.g. with whitespace, a plus sign or more digits, so that
+/// the caller can fall back to a complete parser.
+template <typename T>
+bool tryParseDecimalDigits(const char* data, size_t size, T& result) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  const bool negative = size > 0 && data[0] == '-';
+  data += negative;
+  size -= negative;
+  if (size == 0 || size > 18) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (; size >= 8; data += 8, size -= 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data, sizeof(chunk));
+    if (!detail::isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + detail::parseEightDigits(chunk);
+  }
+  for (; size > 0; ++data, --size) {
+    const uint8_t digit = *data - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  // At most 18 digits do not overflow int64_t.
+  const int64_t signedValue =
+      negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+  if (signedValue < std::numeric_limits<T>::min() ||
+      signedValue > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  result = signedValue;
+  return true;
+}
+
+/// The maximum number of characters written by formatDecimalDigits().
+constexpr int32_t kMaxDecimalDigitsSize = 20;
+
+/// Writes the decimal representation of 'value' to 'out', which must have
+/// space for kMaxDecimalDigitsSize characters, and returns the number of
+/// characters written. Writes two digits at a time from a table of digit pairs.
+/// Produces the same text as folly::to<std::string>().
+template <typename T>
+int32_t formatDecimalDigits(T value, char* out) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  static constexpr char kDigitPairs[] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+  static constexpr uint64_t kPowersOfTen[] = {
+      1ULL,
+      10ULL,
+      100ULL,
+      1'000ULL,
+      10'000ULL,
+      100'000ULL,
+      1'000'000ULL,
+      10'000'000ULL,
+      100'000'000ULL,
+      1'000'000'000ULL,
+      10'000'000'000ULL,
+      100'000'000'000ULL,
+      1'000'000'000'000ULL,
+      10'000'000'000'000ULL,
+      100'000'000'000'000ULL,
+      1'000'000'000'000'000ULL,
+      10'000'000'000'000'000ULL,
+      100'000'000'000'000'000ULL,
+      1'000'000'000'000'000'000ULL,
+      10'000'000'000'000'000'000ULL};
+
+  const int32_t sign = value < 0;
+  uint64_t absValue = sign ? 0 - static_cast<uint64_t>(value) : value;
+  // log10 estimated from log2, corrected by one comparison.
+  const int32_t log10 = (64 - __builtin_clzll(absValue | 1)) * 1233 >> 12;
+  const int32_t numDigits = log10 + (absValue >= kPowersOfTen[log10]);
+  const int32_t size = sign + std::max(numDigits, 1);
+  if (sign) {
+    out[0] = '-';
+  }
+  char* pos = out + size;
+  while (absValue >= 100) {
+    pos -= 2;
+    std::memcpy(pos, &kDigitPairs[(absValue % 100) * 2], 2);
+    absValue /= 100;
+  }
+  if (absValue >= 10) {
+    std::memcpy(pos - 2, &kDigitPairs[absValue * 2], 2);
+  } else {
+    pos[-1] = '0' + absValue;
+  }
+  return size;
+}
+
 /// To BOOLEAN converter.
 template <typename TPolicy>
 struct Converter<TypeKind::BOOLEAN, void, TPolicy> {
@@ -270,6 +400,14 @@ struct Converter<
   }
 
   static Expected<T> tryCast(folly::StringPiece v) {
+    // Plain digit strings mean the same to all policies and are parsed
+    // without the per character checks of the complete parsers.
+    if constexpr (sizeof(T) <= sizeof(int64_t)) {
+      T result;
+      if (tryParseDecimalDigits(v.data(), v.size(), result)) {
+        return result;
+      }
+    }
     if constexpr (TPolicy::truncate) {
       return convertStringToInt(v);
     } else {
@@ -278,19 +416,11 @@ struct Converter<
   }
 
   static Expected<T> tryCast(const StringView& v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(folly::StringPiece(v));
-    } else {
-      return detail::callFollyTo<T>(folly::StringPiece(v));
-    }
+    return tryCast(folly::StringPiece(v));
   }
 
   static Expected<T> tryCast(const std::string& v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(v);
-    } else {
-      return detail::callFollyTo<T>(v);
-    }
+    return tryCast(folly::StringPiece(v));
   }
 
   static Expected<T> tryCast(const bool& v) {
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -25,6 +26,7 @@
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -1090,6 +1093,104 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// IN-list filter for integral data types backed by a blocked bloom filter.
+/// Used for value sets that are too large to be represented by
+/// BigintValuesUsingHashTable, e.g. dynamic filters pushed down from a hash
+/// join on a high-cardinality key. Values outside of [min, max] are rejected
+/// exactly. Values inside the range pass if the bloom filter may contain them,
+/// i.e. a small fraction of values not in the set pass as well. This filter is
+/// therefore only suitable for pruning rows that are re-checked later, as is
+/// the case for the probe side of a join.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value inserted into 'bloomFilter'.
+  /// @param max Maximum value inserted into 'bloomFilter'.
+  /// @param bloomFilter Bloom filter containing hash(value) for all values
+  /// that pass the filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, other.kind()),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Returns the hash number to insert into the bloom filter for 'value'.
+  static uint64_t hash(int64_t value) {
+    const uint64_t h = static_cast<uint64_t>(value) * M;
+    return h ^ (h >> 32);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hash(value));
+  }
+
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t>) const final;
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t>) const final;
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return Filter::testValues(x);
+  }
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  /// The result of merging with a filter whose intersection with 'this'
+  /// cannot be expressed exactly passes a superset of the intersection. This
+  /// is consistent with the approximate nature of this filter.
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  const BloomFilter<>& bloomFilter() const {
+    return *bloomFilter_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  // from Murmur hash
+  static constexpr uint64_t M = 0xc6a4a7935bd1e995L;
+
+  const int64_t min_;
+  const int64_t max_;
+  // Shared between copies. Immutable after construction.
+  std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -1871,6 +1972,7 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+    initializePrefilter();
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1878,7 +1980,10 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        smallLengths_(other.smallLengths_),
+        prefilterBits_(other.prefilterBits_),
+        prefilterShift_(other.prefilterShift_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1894,12 +1999,17 @@ class BytesValues final : public Filter {
   }
 
   bool testLength(int32_t length) const final {
+    if (length < kMaxSmallLength) {
+      return smallLengths_ & (1UL << length);
+    }
     return lengths_.contains(length);
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    return testLength(length) &&
+        bits::isBitSet(
+               prefilterBits_.data(), prefilterHash(value, length)) &&
+        values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
@@ -1916,10 +2026,43 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Lengths below this are tested with 'smallLengths_'.
+  static constexpr int32_t kMaxSmallLength = 64;
+
+  // Sets up 'smallLengths_' and 'prefilterBits_' from 'values_'.
+  void initializePrefilter();
+
+  // Returns the bit in 'prefilterBits_' for the length and the first and last
+  // 8 bytes of a value. Looking at both ends catches values that share a
+  // common prefix, like generated ids.
+  uint64_t prefilterHash(const char* value, int32_t length) const {
+    uint64_t edges = length;
+    if (length >= 8) {
+      uint64_t prefix;
+      uint64_t suffix;
+      std::memcpy(&prefix, value, 8);
+      std::memcpy(&suffix, value + length - 8, 8);
+      edges ^= prefix ^ (suffix * 0xC2B2AE3D27D4EB4FULL);
+    } else {
+      uint64_t prefix = 0;
+      std::memcpy(&prefix, value, length);
+      edges ^= prefix << 8;
+    }
+    return (edges * 0x9E3779B97F4A7C15ULL) >> prefilterShift_;
+  }
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+
+  // Bit i is set if a value has length i.
+  uint64_t smallLengths_{0};
+
+  // Bloom filter with one hash over the length and the ends of each value.
+  // Rejects most non-matching values before hashing the whole value.
+  std::vector<uint64_t> prefilterBits_;
+  int32_t prefilterShift_{0};
 };
 
 /// Represents a combination of two of more range filters on integral types with
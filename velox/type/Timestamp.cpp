@@ -145,6 +145,39 @@ void Timestamp::toTimezone(int16_t tzID) {
   }
 }
 
+int64_t TimeZoneOffsetCache::toTimezoneSlow(
+    const Timestamp& timestamp,
+    bool allowOverflow) {
+  // Goes through Timestamp::toTimezone to get the same range checks and
+  // errors.
+  Timestamp local = timestamp;
+  local.toTimezone(*zone_, allowOverflow);
+
+  // Only cache intervals within the range accepted by toTimezone so that the
+  // fast path never accepts a timestamp the slow path would reject.
+  static const int64_t kMinCachedSeconds =
+      date::sys_seconds(date::sys_days(date::year::min() / 1 / 1))
+          .time_since_epoch()
+          .count();
+  static const int64_t kMaxCachedSeconds =
+      date::sys_seconds(date::sys_days(date::year::max() / 12 / 31))
+          .time_since_epoch()
+          .count();
+  const auto seconds = timestamp.getSeconds();
+  if (seconds < kMinCachedSeconds || seconds >= kMaxCachedSeconds) {
+    return local.getSeconds();
+  }
+
+  const auto info =
+      zone_->get_info(date::sys_seconds(std::chrono::seconds(seconds)));
+  begin_ = std::max<int64_t>(
+      info.begin.time_since_epoch().count(), kMinCachedSeconds);
+  end_ = std::min<int64_t>(
+      info.end.time_since_epoch().count(), kMaxCachedSeconds);
+  offset_ = local.getSeconds() - seconds;
+  return local.getSeconds();
+}
+
 const date::time_zone& Timestamp::defaultTimezone() {
   static const date::time_zone* kDefault = ({
     // TODO: We are hard-coding PST/PDT here to be aligned with the current
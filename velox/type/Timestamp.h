@@ -431,6 +431,62 @@ struct Timestamp {
   uint64_t nanos_;
 };
 
+/// Converts timestamps between GMT and a time zone, remembering the UTC offset
+/// over the interval between the two time zone transitions around the last
+/// converted time. Nearby timestamps, like the rows of a batch, mostly fall
+/// into the same interval and are converted without a time zone database
+/// lookup. Not thread safe; meant to be owned by a function instance.
+class TimeZoneOffsetCache {
+ public:
+  explicit TimeZoneOffsetCache(const date::time_zone* zone = nullptr)
+      : zone_(zone) {}
+
+  const date::time_zone* zone() const {
+    return zone_;
+  }
+
+  /// Returns the seconds of 'timestamp' converted to the time zone. Same as
+  /// the seconds after Timestamp::toTimezone(zone, allowOverflow). The time
+  /// zone must not be null.
+  int64_t toTimezone(const Timestamp& timestamp, bool allowOverflow = false) {
+    const auto seconds = timestamp.getSeconds();
+    if (seconds >= begin_ && seconds < end_) {
+      return seconds + offset_;
+    }
+    return toTimezoneSlow(timestamp, allowOverflow);
+  }
+
+  /// Returns 'localSeconds' in the time zone converted to GMT. Same as the
+  /// seconds after Timestamp::toGMT(zone). Local to GMT conversion is not
+  /// uniform around transitions, so only the last conversion is remembered,
+  /// which covers truncated times that repeat across consecutive rows.
+  int64_t toGMT(int64_t localSeconds) {
+    if (localSeconds != lastLocalSeconds_ || !hasLastGMT_) {
+      Timestamp timestamp(localSeconds, 0);
+      timestamp.toGMT(*zone_);
+      lastGMTSeconds_ = timestamp.getSeconds();
+      lastLocalSeconds_ = localSeconds;
+      hasLastGMT_ = true;
+    }
+    return lastGMTSeconds_;
+  }
+
+ private:
+  int64_t toTimezoneSlow(const Timestamp& timestamp, bool allowOverflow);
+
+  const date::time_zone* zone_;
+
+  // GMT seconds interval [begin_, end_) in which the offset of the time zone
+  // is 'offset_'. Starts out empty.
+  int64_t begin_{0};
+  int64_t end_{0};
+  int64_t offset_{0};
+
+  int64_t lastLocalSeconds_{0};
+  int64_t lastGMTSeconds_{0};
+  bool hasLastGMT_{false};
+};
+
 void parseTo(folly::StringPiece in, ::facebook::velox::Timestamp& out);
 
 template <typename T>
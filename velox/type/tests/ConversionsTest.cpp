@@ -848,6 +848,47 @@ TEST_F(ConversionsTest, toString) {
   }
 }
 
+TEST_F(ConversionsTest, decimalDigits) {
+  std::vector<int64_t> values = {
+      0,
+      7,
+      -7,
+      99,
+      100,
+      12345678,
+      -123456789,
+      999'999'999'999'999'999,
+      -999'999'999'999'999'999,
+      1'000'000'000'000'000'000,
+      std::numeric_limits<int64_t>::max(),
+      std::numeric_limits<int64_t>::min()};
+  for (auto value : values) {
+    char buffer[kMaxDecimalDigitsSize];
+    const auto size = formatDecimalDigits(value, buffer);
+    const auto expected = std::to_string(value);
+    ASSERT_EQ(std::string(buffer, size), expected);
+
+    // Values of more than 18 digits are left to the complete parsers.
+    int64_t parsed;
+    const bool fast = tryParseDecimalDigits(buffer, size, parsed);
+    ASSERT_EQ(fast, size - (value < 0) <= 18) << expected;
+    if (fast) {
+      ASSERT_EQ(parsed, value);
+    }
+  }
+
+  int8_t tinyint;
+  ASSERT_TRUE(tryParseDecimalDigits("-128", 4, tinyint));
+  ASSERT_EQ(tinyint, -128);
+  ASSERT_FALSE(tryParseDecimalDigits("128", 3, tinyint));
+  int64_t bigint;
+  for (const std::string text :
+       {"", "-", "+1", " 1", "1 ", "1.0", "1234567a", "12345678a"}) {
+    ASSERT_FALSE(tryParseDecimalDigits(text.data(), text.size(), bigint))
+        << text;
+  }
+}
+
 TEST_F(ConversionsTest, toRealAndDouble) {
   // From integral types.
   {
@@ -198,6 +198,60 @@ TEST(DecimalTest, addUnsignedValues) {
   ASSERT_EQ(HugeInt::lower(sum), 0x11d0ffffff0bdc0);
 }
 
+TEST(DecimalTest, combineHalfSums) {
+  const auto sumHalves = [](const std::vector<int128_t>& values,
+                            int128_t& sum) {
+    int128_t upperSum = 0;
+    __uint128_t lowerSum = 0;
+    for (auto value : values) {
+      upperSum += static_cast<int64_t>(HugeInt::upper(value));
+      lowerSum += HugeInt::lower(value);
+    }
+    return DecimalUtil::combineHalfSums(sum, upperSum, lowerSum);
+  };
+
+  // Same series as in addUnsignedValues.
+  const int128_t a = HugeInt::build(0x4B3B4CA85A86C47A, 0x98A223FFFFFFFFF);
+  int128_t sum;
+  ASSERT_EQ(587747, sumHalves(std::vector<int128_t>(1'000'000, a), sum));
+  ASSERT_EQ(HugeInt::upper(sum), 0x1673df52e37f2410);
+  ASSERT_EQ(HugeInt::lower(sum), 0x11d0ffffff0bdc0);
+
+  // The remainder is non-negative, so a negative total borrows one more
+  // multiple of 2^127 than addWithOverflow does.
+  ASSERT_EQ(-587748, sumHalves(std::vector<int128_t>(1'000'000, -a), sum));
+  ASSERT_EQ(
+      sum,
+      static_cast<int128_t>(
+          DecimalUtil::kOverflowMultiplier -
+          HugeInt::build(0x1673df52e37f2410, 0x11d0ffffff0bdc0)));
+
+  // Totals that fit adjust to the same sum as with addWithOverflow.
+  const std::vector<std::vector<int128_t>> series = {
+      {},
+      {-1},
+      {1, -1, 5},
+      {DecimalUtil::kLongDecimalMax, DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMin},
+      {DecimalUtil::kLongDecimalMin, DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMax},
+      {DecimalUtil::kLongDecimalMax, DecimalUtil::kLongDecimalMax},
+      {DecimalUtil::kLongDecimalMin, DecimalUtil::kLongDecimalMin},
+  };
+  for (const auto& values : series) {
+    int128_t expectedSum = 0;
+    int64_t expectedOverflow = 0;
+    for (auto value : values) {
+      expectedOverflow +=
+          DecimalUtil::addWithOverflow(expectedSum, expectedSum, value);
+    }
+    const auto overflow = sumHalves(values, sum);
+    EXPECT_EQ(
+        DecimalUtil::adjustSumForOverflow(expectedSum, expectedOverflow),
+        DecimalUtil::adjustSumForOverflow(sum, overflow));
+  }
+}
+
 TEST(DecimalTest, longDecimalSerDe) {
   char data[100];
   HugeInt::serialize(DecimalUtil::kLongDecimalMin, data);
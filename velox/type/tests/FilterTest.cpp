@@ -396,6 +396,96 @@ TEST(FilterTest, bigintValuesUsingHashTableSimd) {
   checkSimd(filter.get(), values, verify);
 }
 
+namespace {
+std::unique_ptr<BigintValuesUsingBloomFilter> makeBloomFilter(
+    const std::vector<int64_t>& values,
+    bool nullAllowed) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(values.size());
+  for (auto value : values) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hash(value));
+  }
+  auto [min, max] = std::minmax_element(values.begin(), values.end());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      *min, *max, std::move(bloomFilter), nullAllowed);
+}
+} // namespace
+
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  std::vector<int64_t> numbers;
+  for (auto i = 0; i < 100'000; ++i) {
+    numbers.push_back(i * 7919);
+  }
+  auto filter = makeBloomFilter(numbers, false);
+  for (auto n : numbers) {
+    ASSERT_TRUE(filter->testInt64(n));
+  }
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(-1));
+  EXPECT_FALSE(filter->testInt64(numbers.back() + 1));
+  EXPECT_FALSE(filter->testInt64(INT64_MAX));
+
+  // Values in range but not in the set mostly fail.
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 10'000; ++i) {
+    numFalsePositives += filter->testInt64(i * 7919 + 1);
+  }
+  EXPECT_LT(numFalsePositives, 1'000);
+
+  EXPECT_TRUE(filter->testInt64Range(0, 10, false));
+  EXPECT_TRUE(filter->testInt64Range(7919, 7919, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter->testInt64Range(
+      numbers.back() + 1, numbers.back() + 100, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -5, true));
+
+  auto withNulls = filter->clone(true);
+  EXPECT_TRUE(withNulls->testNull());
+  EXPECT_TRUE(withNulls->testInt64(7919));
+  EXPECT_TRUE(withNulls->testInt64Range(-10, -5, true));
+
+  // Merging with a range narrows the range and keeps the bloom filter.
+  BigintRange range(7919, 7919 * 10, false);
+  auto merged = filter->mergeWith(&range);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(7919 * 2));
+  EXPECT_FALSE(merged->testInt64(0));
+  EXPECT_FALSE(merged->testInt64(7919 * 11));
+
+  // Merging with values keeps the values that pass the bloom filter.
+  auto values = createBigintValues({-5, 0, 7919, 7920, 100'000}, false);
+  merged = filter->mergeWith(values.get());
+  EXPECT_TRUE(merged->testInt64(0));
+  EXPECT_TRUE(merged->testInt64(7919));
+  EXPECT_FALSE(merged->testInt64(-5));
+  EXPECT_FALSE(merged->testInt64(1));
+  EXPECT_TRUE(values->mergeWith(filter.get())->testingEquals(*merged));
+}
+
+TEST(FilterTest, bigintValuesUsingBloomFilterSimd) {
+  std::vector<int64_t> numbers;
+  for (auto i = 0; i < 1000; ++i) {
+    numbers.push_back(i * 1209);
+  }
+  auto filter = makeBloomFilter(numbers, false);
+  int64_t outOfRange[] = {-100, -20000, 0x10000000, 0x20000000};
+  auto verify = [&](int64_t x) { return filter->testInt64(x); };
+  checkSimd(filter.get(), outOfRange, verify);
+  applySimdTestToVector(numbers, *filter, verify);
+
+  std::vector<int32_t> numbers32;
+  for (auto n : numbers) {
+    numbers32.push_back(n);
+  }
+  applySimdTestToVector(numbers32, *filter, verify);
+
+  std::vector<int16_t> numbers16;
+  for (auto n : numbers) {
+    numbers16.push_back(n);
+  }
+  applySimdTestToVector(numbers16, *filter, verify);
+}
+
 TEST(FilterTest, negatedBigintValuesUsingHashTableSimd) {
   std::vector<int64_t> numbers;
   // make a worst case filter where every item falls on the same slot.
@@ -950,6 +1040,40 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesLargeList) {
+  // Generated ids share their prefix and length, long values exceed the
+  // lengths tracked in a bitmask.
+  std::vector<std::string> values;
+  for (auto i = 0; i < 10'000; i += 2) {
+    values.push_back(fmt::format("customer-{:08}", i));
+  }
+  values.push_back(std::string(100, 'x'));
+  values.push_back("");
+  auto filter = in(values);
+
+  for (const auto& value : values) {
+    EXPECT_TRUE(filter->testBytes(value.data(), value.size())) << value;
+  }
+  for (auto i = 1; i < 10'000; i += 2) {
+    const auto value = fmt::format("customer-{:08}", i);
+    EXPECT_FALSE(filter->testBytes(value.data(), value.size())) << value;
+  }
+  const auto longValue = std::string(99, 'x') + "y";
+  EXPECT_FALSE(filter->testBytes(longValue.data(), longValue.size()));
+  EXPECT_FALSE(filter->testBytes("customer", 8));
+
+  EXPECT_TRUE(filter->testLength(0));
+  EXPECT_TRUE(filter->testLength(17));
+  EXPECT_TRUE(filter->testLength(100));
+  EXPECT_FALSE(filter->testLength(63));
+  EXPECT_FALSE(filter->testLength(64));
+
+  // Copies keep the prefilter.
+  auto copy = filter->clone(true);
+  EXPECT_TRUE(copy->testBytes(values[0].data(), values[0].size()));
+  EXPECT_FALSE(copy->testBytes("customer-00000001", 17));
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -390,6 +390,43 @@ TEST(TimestampTest, outOfRange) {
       "Unable to convert timezone 'America/Los_Angeles' past");
 }
 
+TEST(TimestampTest, timeZoneOffsetCache) {
+  auto* timezone = date::locate_zone("America/Los_Angeles");
+  TimeZoneOffsetCache cache(timezone);
+
+  // Steps across the DST transitions of 2021 forwards and backwards, so that
+  // both cache hits and misses are checked against the uncached conversions.
+  const int64_t start = 1'609'459'200; // 2021-01-01 00:00:00 UTC.
+  const int64_t end = start + 366 * 86'400;
+  for (bool forward : {true, false}) {
+    for (int64_t i = 0; i < 366 * 24; ++i) {
+      const auto utc = forward ? start + i * 3'599 : end - i * 3'599;
+      Timestamp expected(utc, 123);
+      expected.toTimezone(*timezone);
+      ASSERT_EQ(expected.getSeconds(), cache.toTimezone(Timestamp(utc, 123)))
+          << utc;
+
+      Timestamp expectedGMT(expected.getSeconds() / 3'600 * 3'600, 0);
+      expectedGMT.toGMT(*timezone);
+      ASSERT_EQ(
+          expectedGMT.getSeconds(),
+          cache.toGMT(expected.getSeconds() / 3'600 * 3'600))
+          << utc;
+    }
+  }
+
+  // Errors are the same as without the cache, also after a cache hit.
+  cache.toTimezone(Timestamp(start, 0));
+  VELOX_ASSERT_THROW(
+      cache.toTimezone(Timestamp(32517359891, 0)),
+      "Unable to convert timezone 'America/Los_Angeles' past");
+  VELOX_ASSERT_THROW(
+      cache.toTimezone(Timestamp(-3217830796800, 0)),
+      "Timestamp is outside of supported range");
+  // 2021-03-14 02:30:00 does not exist in America/Los_Angeles.
+  VELOX_ASSERT_THROW(cache.toGMT(1'615'689'000), "is in a gap");
+}
+
 // In debug mode, Timestamp constructor will throw exception if range check
 // fails.
 #ifdef NDEBUG
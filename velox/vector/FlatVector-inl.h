@@ -418,7 +418,7 @@ void FlatVector<T>::copyRanges(
 template <typename T>
 VectorPtr FlatVector<T>::slice(vector_size_t offset, vector_size_t length)
     const {
-  return std::make_shared<FlatVector<T>>(
+  auto sliced = std::make_shared<FlatVector<T>>(
       this->pool_,
       this->type_,
       this->sliceNulls(offset, length),
@@ -426,6 +426,12 @@ VectorPtr FlatVector<T>::slice(vector_size_t offset, vector_size_t length)
       BaseVector::sliceBuffer(
           *this->type_, values_, offset, length, this->pool_),
       std::vector<BufferPtr>(stringBuffers_));
+  if constexpr (std::is_same_v<T, StringView>) {
+    if (this->isAllAsciiInRange(offset, offset + length)) {
+      sliced->setAllIsAscii(true);
+    }
+  }
+  return sliced;
 }
 
 template <typename T>
@@ -23,6 +23,7 @@ namespace facebook::velox {
 namespace exec {
 class EvalCtx;
 class EvalErrors;
+class Expr;
 
 using EvalErrorsPtr = std::shared_ptr<EvalErrors>;
 } // namespace exec
@@ -34,6 +35,20 @@ class Callable {
 
   virtual bool hasCapture() const = 0;
 
+  /// Returns the parameters of the lambda if 'this' is an interpreted lambda
+  /// expression, nullptr otherwise.
+  virtual const RowTypePtr& signature() const {
+    static const RowTypePtr kNone;
+    return kNone;
+  }
+
+  /// Returns the body of the lambda if 'this' is an interpreted lambda
+  /// expression, nullptr otherwise. Lets functions that take lambdas evaluate
+  /// common bodies without the interpreter.
+  virtual const exec::Expr* body() const {
+    return nullptr;
+  }
+
   /// Applies 'this' to 'args' for 'rows' and returns the result in
   /// '*result'.
   /// @param rows The rows that this callable applies to. It is the element rows
@@ -0,0 +1,557 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/vector/MappedVectorFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+
+#include <folly/ScopeGuard.h>
+#include <folly/json.h>
+#include <folly/synchronization/CallOnce.h>
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+#include "velox/vector/LazyVector.h"
+
+namespace facebook::velox {
+
+namespace {
+
+constexpr char kMagic[8] = {'V', 'E', 'L', 'O', 'X', 'M', 'V', 'F'};
+
+// Buffers start at multiples of this offset in the file. mmap returns page
+// aligned addresses, so the buffers are aligned the same way in memory.
+constexpr int64_t kBufferAlignment = 64;
+
+enum class Encoding : int32_t {
+  kFlat = 0,
+  kConstant = 1,
+  kDictionary = 2,
+};
+
+class MappedVectorWriter {
+ public:
+  explicit MappedVectorWriter(const char* filePath)
+      : out_(filePath, std::ofstream::binary) {
+    VELOX_CHECK(!out_.fail(), "Cannot open file: {}", filePath);
+  }
+
+  void writeHeader() {
+    writeBytes(kMagic, sizeof(kMagic));
+    write<int32_t>(kMappedVectorFileVersion);
+    write<int32_t>(0);
+  }
+
+  void writeVector(const BaseVector& vector) {
+    switch (vector.encoding()) {
+      case VectorEncoding::Simple::LAZY: {
+        const auto& lazy = static_cast<const LazyVector&>(vector);
+        VELOX_CHECK(
+            lazy.isLoaded(), "Cannot write a lazy vector that is not loaded");
+        writeVector(*lazy.loadedVector());
+        return;
+      }
+      case VectorEncoding::Simple::FLAT:
+      case VectorEncoding::Simple::ROW:
+      case VectorEncoding::Simple::ARRAY:
+      case VectorEncoding::Simple::MAP:
+        writeVectorHeader(Encoding::kFlat, vector);
+        writeFlatVector(vector);
+        return;
+      case VectorEncoding::Simple::CONSTANT:
+        writeVectorHeader(Encoding::kConstant, vector);
+        writeConstantVector(vector);
+        return;
+      case VectorEncoding::Simple::DICTIONARY:
+        writeVectorHeader(Encoding::kDictionary, vector);
+        writeOptionalBuffer(vector.nulls());
+        writeBuffer(vector.wrapInfo()->as<char>(), vector.wrapInfo()->size());
+        writeVector(*vector.valueVector());
+        return;
+      default:
+        VELOX_UNSUPPORTED(
+            "Unsupported encoding: {}", mapSimpleToName(vector.encoding()));
+    }
+  }
+
+  void close() {
+    out_.close();
+    VELOX_CHECK(!out_.fail(), "Failed to write mapped vector file");
+  }
+
+ private:
+  template <typename T>
+  void write(const T& value) {
+    writeBytes(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void writeBytes(const char* data, int64_t size) {
+    out_.write(data, size);
+    offset_ += size;
+  }
+
+  // Writes the size of the buffer, pads to the next aligned offset and writes
+  // the bytes.
+  void writeBuffer(const char* data, int64_t size) {
+    write<int64_t>(size);
+    static const char kZeros[kBufferAlignment] = {};
+    writeBytes(kZeros, bits::roundUp(offset_, kBufferAlignment) - offset_);
+    writeBytes(data, size);
+  }
+
+  void writeOptionalBuffer(const BufferPtr& buffer) {
+    write<int8_t>(buffer != nullptr);
+    if (buffer) {
+      writeBuffer(buffer->as<char>(), buffer->size());
+    }
+  }
+
+  void writeVectorHeader(Encoding encoding, const BaseVector& vector) {
+    VELOX_USER_CHECK(
+        vector.typeKind() != TypeKind::OPAQUE,
+        "Cannot write OPAQUE vectors to a mapped file");
+    write<int32_t>(static_cast<int32_t>(encoding));
+    const auto type = folly::toJson(vector.type()->serialize());
+    write<int32_t>(type.size());
+    writeBytes(type.data(), type.size());
+    write<int32_t>(vector.size());
+  }
+
+  void writeFlatVector(const BaseVector& vector) {
+    writeOptionalBuffer(vector.nulls());
+    switch (vector.typeKind()) {
+      case TypeKind::ROW: {
+        const auto* row = vector.as<RowVector>();
+        write<int32_t>(row->childrenSize());
+        for (const auto& child : row->children()) {
+          write<int8_t>(child != nullptr);
+          if (child) {
+            writeVector(*child);
+          }
+        }
+        return;
+      }
+      case TypeKind::ARRAY: {
+        const auto* array = vector.as<ArrayVector>();
+        writeOptionalBuffer(array->offsets());
+        writeOptionalBuffer(array->sizes());
+        writeVector(*array->elements());
+        return;
+      }
+      case TypeKind::MAP: {
+        const auto* map = vector.as<MapVector>();
+        writeOptionalBuffer(map->offsets());
+        writeOptionalBuffer(map->sizes());
+        writeVector(*map->mapKeys());
+        writeVector(*map->mapValues());
+        return;
+      }
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        writeStrings(*vector.asFlatVector<StringView>());
+        return;
+      default:
+        writeOptionalBuffer(vector.values());
+    }
+  }
+
+  // Writes the views with the data pointers of non-inlined strings replaced by
+  // offsets into a single data buffer that follows the views.
+  void writeStrings(const FlatVector<StringView>& vector) {
+    const auto& values = vector.values();
+    write<int8_t>(values != nullptr);
+    if (!values) {
+      return;
+    }
+    const auto* rawValues = vector.rawValues();
+    std::vector<StringView> views(vector.size());
+    std::string data;
+    for (auto i = 0; i < vector.size(); ++i) {
+      if (vector.isNullAt(i)) {
+        continue;
+      }
+      const auto value = rawValues[i];
+      if (value.isInline()) {
+        views[i] = value;
+        continue;
+      }
+      auto* rawView = reinterpret_cast<char*>(&views[i]);
+      *reinterpret_cast<uint32_t*>(rawView) = value.size();
+      *reinterpret_cast<int64_t*>(rawView + 8) = data.size();
+      data.append(value.data(), value.size());
+    }
+    writeBuffer(
+        reinterpret_cast<const char*>(views.data()),
+        views.size() * sizeof(StringView));
+    writeBuffer(data.data(), data.size());
+  }
+
+  template <TypeKind kind>
+  void writeScalarConstant(const BaseVector& vector) {
+    using T = typename TypeTraits<kind>::NativeType;
+    const auto value = vector.as<ConstantVector<T>>()->valueAt(0);
+    if constexpr (std::is_same_v<T, StringView>) {
+      writeBuffer(value.data(), value.size());
+    } else {
+      write<T>(value);
+    }
+  }
+
+  void writeConstantVector(const BaseVector& vector) {
+    const bool isNull = vector.isNullAt(0);
+    write<int8_t>(isNull);
+    if (isNull) {
+      return;
+    }
+    const auto& base = vector.valueVector();
+    write<int8_t>(base == nullptr);
+    if (base) {
+      writeVector(*base);
+      write<int32_t>(vector.as<ConstantVector<ComplexType>>()->index());
+    } else {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          writeScalarConstant, vector.typeKind(), vector);
+    }
+  }
+
+  std::ofstream out_;
+  int64_t offset_{0};
+};
+
+// Unmaps the file when the last buffer over it is released.
+class MappedFile {
+ public:
+  MappedFile(char* data, size_t size) : data_(data), size_(size) {}
+
+  ~MappedFile() {
+    ::munmap(data_, size_);
+  }
+
+  char* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  char* const data_;
+  const size_t size_;
+};
+
+class MappedFileReleaser {
+ public:
+  explicit MappedFileReleaser(std::shared_ptr<MappedFile> file)
+      : file_(std::move(file)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<MappedFile> file_;
+};
+
+class MappedVectorReader {
+ public:
+  MappedVectorReader(std::shared_ptr<MappedFile> file, memory::MemoryPool* pool)
+      : file_(std::move(file)), pool_(pool) {}
+
+  void readHeader() {
+    VELOX_CHECK_GE(
+        file_->size(), sizeof(kMagic) + 8, "Not a mapped vector file");
+    VELOX_CHECK_EQ(
+        ::memcmp(file_->data(), kMagic, sizeof(kMagic)),
+        0,
+        "Not a mapped vector file");
+    offset_ = sizeof(kMagic);
+    const auto version = read<int32_t>();
+    VELOX_CHECK_EQ(
+        version,
+        kMappedVectorFileVersion,
+        "Unsupported mapped vector file version");
+    read<int32_t>();
+  }
+
+  VectorPtr readVector() {
+    const auto encoding = static_cast<Encoding>(read<int32_t>());
+    const auto type = readType();
+    const auto size = read<int32_t>();
+    switch (encoding) {
+      case Encoding::kFlat:
+        return readFlatVector(type, size);
+      case Encoding::kConstant:
+        return readConstantVector(type, size);
+      case Encoding::kDictionary: {
+        auto nulls = readOptionalBuffer();
+        auto indices = readBuffer();
+        auto base = readVector();
+        return BaseVector::wrapInDictionary(
+            std::move(nulls), std::move(indices), size, std::move(base));
+      }
+      default:
+        VELOX_FAIL(
+            "Unsupported encoding in mapped vector file: {}",
+            static_cast<int32_t>(encoding));
+    }
+  }
+
+ private:
+  template <typename T>
+  T read() {
+    checkAvailable(sizeof(T));
+    T value;
+    ::memcpy(&value, file_->data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return value;
+  }
+
+  void checkAvailable(int64_t size) const {
+    VELOX_CHECK_LE(
+        offset_ + size, file_->size(), "Truncated mapped vector file");
+  }
+
+  TypePtr readType() {
+    static folly::once_flag kOnce;
+    folly::call_once(kOnce, []() { Type::registerSerDe(); });
+
+    const auto size = read<int32_t>();
+    checkAvailable(size);
+    const auto json =
+        folly::parseJson(folly::StringPiece(file_->data() + offset_, size));
+    offset_ += size;
+    return ISerializable::deserialize<Type>(json);
+  }
+
+  // Returns the start of the next buffer and its size.
+  std::pair<char*, int64_t> nextBuffer() {
+    const auto size = read<int64_t>();
+    offset_ = bits::roundUp(offset_, kBufferAlignment);
+    checkAvailable(size);
+    auto* data = file_->data() + offset_;
+    offset_ += size;
+    return {data, size};
+  }
+
+  BufferPtr wrap(const char* data, int64_t size) {
+    return BufferView<MappedFileReleaser>::create(
+        reinterpret_cast<const uint8_t*>(data),
+        size,
+        MappedFileReleaser(file_));
+  }
+
+  BufferPtr readBuffer() {
+    const auto [data, size] = nextBuffer();
+    return wrap(data, size);
+  }
+
+  BufferPtr readOptionalBuffer() {
+    if (read<int8_t>() == 0) {
+      return nullptr;
+    }
+    return readBuffer();
+  }
+
+  template <TypeKind kind>
+  VectorPtr createFlat(
+      const TypePtr& type,
+      vector_size_t size,
+      BufferPtr nulls,
+      BufferPtr values,
+      std::vector<BufferPtr> stringBuffers) {
+    using T = typename TypeTraits<kind>::NativeType;
+    return std::make_shared<FlatVector<T>>(
+        pool_,
+        type,
+        std::move(nulls),
+        size,
+        std::move(values),
+        std::move(stringBuffers));
+  }
+
+  VectorPtr readFlatVector(const TypePtr& type, vector_size_t size) {
+    auto nulls = readOptionalBuffer();
+    switch (type->kind()) {
+      case TypeKind::ROW: {
+        const auto numChildren = read<int32_t>();
+        std::vector<VectorPtr> children;
+        children.reserve(numChildren);
+        for (auto i = 0; i < numChildren; ++i) {
+          children.push_back(read<int8_t>() ? readVector() : nullptr);
+        }
+        return std::make_shared<RowVector>(
+            pool_, type, std::move(nulls), size, std::move(children));
+      }
+      case TypeKind::ARRAY: {
+        auto offsets = readOptionalBuffer();
+        auto sizes = readOptionalBuffer();
+        auto elements = readVector();
+        return std::make_shared<ArrayVector>(
+            pool_,
+            type,
+            std::move(nulls),
+            size,
+            std::move(offsets),
+            std::move(sizes),
+            std::move(elements));
+      }
+      case TypeKind::MAP: {
+        auto offsets = readOptionalBuffer();
+        auto sizes = readOptionalBuffer();
+        auto keys = readVector();
+        auto values = readVector();
+        return std::make_shared<MapVector>(
+            pool_,
+            type,
+            std::move(nulls),
+            size,
+            std::move(offsets),
+            std::move(sizes),
+            std::move(keys),
+            std::move(values));
+      }
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return readStrings(type, size, std::move(nulls));
+      default: {
+        auto values = readOptionalBuffer();
+        return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+            createFlat,
+            type->kind(),
+            type,
+            size,
+            std::move(nulls),
+            std::move(values),
+            {});
+      }
+    }
+  }
+
+  VectorPtr readStrings(
+      const TypePtr& type,
+      vector_size_t size,
+      BufferPtr nulls) {
+    if (read<int8_t>() == 0) {
+      return std::make_shared<FlatVector<StringView>>(
+          pool_,
+          type,
+          std::move(nulls),
+          size,
+          nullptr,
+          std::vector<BufferPtr>{});
+    }
+    const auto [rawViews, viewBytes] = nextBuffer();
+    VELOX_CHECK_EQ(viewBytes, size * sizeof(StringView));
+    const auto [rawData, dataBytes] = nextBuffer();
+
+    // Points the views of non-inlined strings at the data. The mapping is
+    // private, so this only copies the touched pages of the views.
+    auto* views = reinterpret_cast<StringView*>(rawViews);
+    for (auto i = 0; i < size; ++i) {
+      if (views[i].isInline()) {
+        continue;
+      }
+      const auto offset = *reinterpret_cast<const int64_t*>(
+          rawViews + i * sizeof(StringView) + 8);
+      VELOX_CHECK_LE(offset + views[i].size(), dataBytes);
+      views[i] = StringView(rawData + offset, views[i].size());
+    }
+
+    std::vector<BufferPtr> stringBuffers;
+    if (dataBytes > 0) {
+      stringBuffers.push_back(wrap(rawData, dataBytes));
+    }
+    return std::make_shared<FlatVector<StringView>>(
+        pool_,
+        type,
+        std::move(nulls),
+        size,
+        wrap(rawViews, viewBytes),
+        std::move(stringBuffers));
+  }
+
+  template <TypeKind kind>
+  VectorPtr readScalarConstant(const TypePtr& type, vector_size_t size) {
+    using T = typename TypeTraits<kind>::NativeType;
+    if constexpr (std::is_same_v<T, StringView>) {
+      // The constructor copies the value.
+      const auto [data, dataBytes] = nextBuffer();
+      return std::make_shared<ConstantVector<T>>(
+          pool_, size, false, type, StringView(data, dataBytes));
+    } else {
+      return std::make_shared<ConstantVector<T>>(
+          pool_, size, false, type, read<T>());
+    }
+  }
+
+  VectorPtr readConstantVector(const TypePtr& type, vector_size_t size) {
+    if (read<int8_t>()) {
+      return BaseVector::createNullConstant(type, size, pool_);
+    }
+    if (read<int8_t>()) {
+      return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          readScalarConstant, type->kind(), type, size);
+    }
+    auto base = readVector();
+    const auto index = read<int32_t>();
+    return BaseVector::wrapInConstant(size, index, std::move(base));
+  }
+
+  const std::shared_ptr<MappedFile> file_;
+  memory::MemoryPool* const pool_;
+  int64_t offset_{0};
+};
+
+} // namespace
+
+void saveVectorToMappedFile(const BaseVector& vector, const char* filePath) {
+  MappedVectorWriter writer(filePath);
+  writer.writeHeader();
+  writer.writeVector(vector);
+  writer.close();
+}
+
+VectorPtr restoreVectorFromMappedFile(
+    const char* filePath,
+    memory::MemoryPool* pool) {
+  const int fd = ::open(filePath, O_RDONLY);
+  VELOX_CHECK_GE(fd, 0, "Cannot open file: {}", filePath);
+  SCOPE_EXIT {
+    ::close(fd);
+  };
+  struct stat stats;
+  VELOX_CHECK_EQ(::fstat(fd, &stats), 0, "Cannot stat file: {}", filePath);
+  VELOX_CHECK_GT(stats.st_size, 0, "Empty mapped vector file: {}", filePath);
+
+  // A private writable mapping lets the reader fix up string views in place
+  // without writing to the file.
+  void* data = ::mmap(
+      nullptr, stats.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  VELOX_CHECK(data != MAP_FAILED, "Cannot map file: {}", filePath);
+
+  MappedVectorReader reader(
+      std::make_shared<MappedFile>(static_cast<char*>(data), stats.st_size),
+      pool);
+  reader.readHeader();
+  return reader.readVector();
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox {
+
+// The file format used by the following functions is documented at
+// https://facebookincubator.github.io/velox/develop/debugging/vector-saver.html
+
+/// Version of the format written by saveVectorToMappedFile. Readers reject
+/// files with a different version.
+constexpr int32_t kMappedVectorFileVersion = 1;
+
+/// Writes 'vector' to a new file in 'filePath' in a format that
+/// restoreVectorFromMappedFile can memory map. All buffers are stored
+/// uncompressed at 64 byte aligned offsets. Supports flat, constant,
+/// dictionary, row, array and map vectors of any type except OPAQUE. Loaded
+/// lazy vectors are written as their loaded vector. Exceptions will be thrown
+/// if any error occurs while writing.
+void saveVectorToMappedFile(const BaseVector& vector, const char* filePath);
+
+/// Memory maps a file written by saveVectorToMappedFile and returns a vector
+/// whose buffers are views over the mapping. No data is copied except the
+/// values of scalar constants. The mapping stays alive as long as any of the
+/// buffers does. 'pool' is only used for the vector objects themselves.
+VectorPtr restoreVectorFromMappedFile(
+    const char* filePath,
+    memory::MemoryPool* pool);
+
+} // namespace facebook::velox
@@ -25,6 +25,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Range.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/vector/TypeAliases.h"
 
 namespace facebook {
@@ -189,8 +190,12 @@ class SelectivityVector {
    * Removes rows that are not present in the 'other' vector.
    */
   void intersect(const SelectivityVector& other) {
-    bits::andBits(
-        bits_.data(), other.bits_.data(), begin_, std::min(end_, other.size()));
+    simd::andRange<false>(
+        bits_.data(),
+        bits_.data(),
+        other.bits_.data(),
+        begin_,
+        std::min(end_, other.size()));
     updateBounds();
   }
 
@@ -200,13 +205,18 @@ class SelectivityVector {
    * any keys passing should actually be inverted
    */
   void deselect(const SelectivityVector& other) {
-    bits::andWithNegatedBits(
-        bits_.data(), other.bits_.data(), begin_, std::min(end_, other.size()));
+    simd::andRange<true>(
+        bits_.data(),
+        bits_.data(),
+        other.bits_.data(),
+        begin_,
+        std::min(end_, other.size()));
     updateBounds();
   }
 
   void deselect(const uint64_t* bits, int32_t begin, int32_t end) {
-    bits::andWithNegatedBits(
+    simd::andRange<true>(
+        bits_.data(),
         bits_.data(),
         reinterpret_cast<const uint64_t*>(bits),
         std::max<int32_t>(begin_, begin),
@@ -215,7 +225,8 @@ class SelectivityVector {
   }
 
   void deselectNulls(const uint64_t* bits, int32_t begin, int32_t end) {
-    bits::andBits(
+    simd::andRange<false>(
+        bits_.data(),
         bits_.data(),
         reinterpret_cast<const uint64_t*>(bits),
         std::max<int32_t>(begin_, begin),
@@ -224,7 +235,8 @@ class SelectivityVector {
   }
 
   void deselectNonNulls(const uint64_t* bits, int32_t begin, int32_t end) {
-    bits::andWithNegatedBits(
+    simd::andRange<true>(
+        bits_.data(),
         bits_.data(),
         reinterpret_cast<const uint64_t*>(bits),
         std::max<int32_t>(begin_, begin),
@@ -235,26 +247,27 @@ class SelectivityVector {
   /// Clear null bits in 'nulls' for active rows.
   void clearNulls(BufferPtr& nulls) const {
     if (nulls) {
-      bits::orBits(nulls->asMutable<uint64_t>(), bits_.data(), begin_, end_);
+      auto* rawNulls = nulls->asMutable<uint64_t>();
+      simd::orRange<false>(rawNulls, rawNulls, bits_.data(), begin_, end_);
     }
   }
 
   void clearNulls(uint64_t* rawNulls) const {
     if (rawNulls) {
-      bits::orBits(rawNulls, bits_.data(), begin_, end_);
+      simd::orRange<false>(rawNulls, rawNulls, bits_.data(), begin_, end_);
     }
   }
 
   /// Set null bits in 'nulls' for active rows.
   void setNulls(BufferPtr& nulls) const {
     VELOX_CHECK_NOT_NULL(nulls);
-    bits::andWithNegatedBits(
-        nulls->asMutable<uint64_t>(), bits_.data(), begin_, end_);
+    auto* rawNulls = nulls->asMutable<uint64_t>();
+    simd::andRange<true>(rawNulls, rawNulls, bits_.data(), begin_, end_);
   }
 
   void setNulls(uint64_t* rawNulls) const {
     VELOX_CHECK_NOT_NULL(rawNulls);
-    bits::andWithNegatedBits(rawNulls, bits_.data(), begin_, end_);
+    simd::andRange<true>(rawNulls, rawNulls, bits_.data(), begin_, end_);
   }
 
   /// Copy null bits from 'src' to 'dest' for active rows.
@@ -268,8 +281,12 @@ class SelectivityVector {
     if (size_ < other.size()) {
       resize(other.size(), false);
     }
-    bits::orBits(
-        bits_.data(), other.bits_.data(), 0, std::min(size_, other.size()));
+    simd::orRange<false>(
+        bits_.data(),
+        bits_.data(),
+        other.bits_.data(),
+        0,
+        std::min(size_, other.size()));
     updateBounds();
   }
 
@@ -287,7 +304,7 @@ class SelectivityVector {
    * index (noting that the range in between may contain not selected indices).
    */
   void updateBounds() {
-    begin_ = bits::findFirstBit(bits_.data(), 0, size_);
+    begin_ = simd::findFirstBit(bits_.data(), 0, size_);
     if (begin_ == -1) {
       begin_ = 0;
       end_ = 0;
@@ -313,7 +330,7 @@ class SelectivityVector {
     if (allSelected_.has_value() && *allSelected_) {
       return size();
     }
-    auto count = bits::countBits(bits_.data(), begin_, end_);
+    auto count = simd::countBits(bits_.data(), begin_, end_);
     allSelected_ = count == size();
     return count;
   }
@@ -286,14 +286,30 @@ class SimpleVector : public BaseVector {
     if (rows.isSubset(*asciiInfo.readLockedAsciiComputedRows())) {
       return asciiInfo.isAllAscii();
     }
+    // A dictionary or constant over strings that are all known to be ASCII
+    // needs no scan. This makes the result computed on a dictionary base
+    // reusable by all the dictionaries that wrap it.
+    if (this->encoding() != VectorEncoding::Simple::FLAT) {
+      const auto* base = this->wrappedVector();
+      const auto* stringBase = base != this
+          ? dynamic_cast<const SimpleVector<StringView>*>(base)
+          : nullptr;
+      if (stringBase != nullptr &&
+          stringBase->isAllAsciiInRange(0, stringBase->size())) {
+        setIsAscii(true, rows);
+        return true;
+      }
+    }
+
     ensureIsAsciiCapacity();
-    bool isAllAscii = true;
-    rows.template applyToSelected([&](auto row) {
-      if (!isNullAt(row)) {
-        auto string = valueAt(row);
-        isAllAscii &=
-            functions::stringCore::isAscii(string.data(), string.size());
+    // The flag covers all the rows, so the scan stops at the first non-ASCII
+    // string.
+    const bool isAllAscii = rows.template testSelected([&](auto row) {
+      if (isNullAt(row)) {
+        return true;
       }
+      const auto string = valueAt(row);
+      return functions::stringCore::isAscii(string.data(), string.size());
     });
 
     // Set isAllAscii flag, it will unset if we encounter any utf.
@@ -308,6 +324,19 @@ class SimpleVector : public BaseVector {
     return asciiInfo.isAllAscii();
   }
 
+  /// Returns true if the rows in [begin, end) are all known to be ASCII.
+  template <typename U = T>
+  typename std::enable_if_t<std::is_same_v<U, StringView>, bool>
+  isAllAsciiInRange(vector_size_t begin, vector_size_t end) const {
+    if (!asciiInfo.isAllAscii()) {
+      return false;
+    }
+    auto rlockedAsciiComputedRows{asciiInfo.readLockedAsciiComputedRows()};
+    return end <= rlockedAsciiComputedRows->size() &&
+        bits::isAllSet(
+               rlockedAsciiComputedRows->asRange().bits(), begin, end);
+  }
+
   /// Clears asciiness state.
   template <typename U = T>
   typename std::enable_if_t<std::is_same_v<U, StringView>, void>
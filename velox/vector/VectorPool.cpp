@@ -15,6 +15,8 @@
  */
 #include "velox/vector/VectorPool.h"
 
+#include <cstring>
+
 namespace facebook::velox {
 
 namespace {
@@ -47,12 +49,39 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+FOLLY_ALWAYS_INLINE bool isStringCacheIndex(int32_t cacheIndex) {
+  return cacheIndex == static_cast<int32_t>(TypeKind::VARCHAR) ||
+      cacheIndex == static_cast<int32_t>(TypeKind::VARBINARY);
+}
+
+// Smallest string buffer capacity class. Buffers of kInitialStringSize bytes
+// fall in it.
+constexpr int32_t kMinStringBufferClassBits = 15; // 32KB
+
+// Returns the capacity class of a string buffer of 'capacity' bytes. Classes
+// are by the power of two of the allocation size, including the buffer
+// header.
+int32_t stringBufferClass(size_t capacity) {
+  const uint64_t bytes = capacity + sizeof(AlignedBuffer);
+  return (63 - __builtin_clzll(bytes)) - kMinStringBufferClassBits;
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    const auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0) {
+      auto vector = vectors_[cacheIndex].pop(type, size, *pool_);
+      if (isStringCacheIndex(cacheIndex) && numStringBuffers_ > 0) {
+        maybeAddStringBuffer(*vector);
+      }
+      return vector;
+    }
+    auto* typePool = complexTypePool(type, false);
+    if (typePool != nullptr) {
+      return typePool->pop(type, size, *pool_);
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -67,9 +96,113 @@ bool VectorPool::release(VectorPtr& vector) {
 
   auto cacheIndex = toCacheIndex(vector->type());
   if (cacheIndex < 0) {
+    auto* typePool = complexTypePool(vector->type(), true);
+    return typePool != nullptr && typePool->maybePushBack(vector);
+  }
+  if (!isStringCacheIndex(cacheIndex) || !vector->isFlatEncoding() ||
+      vector->asUnchecked<FlatVector<StringView>>()->stringBuffers().size() <
+          2) {
+    return vectors_[cacheIndex].maybePushBack(vector);
+  }
+
+  // The vector keeps at most its first string buffer on reuse. The others
+  // become singly referenced here once it is pushed back.
+  const auto& vectorBuffers =
+      vector->asUnchecked<FlatVector<StringView>>()->stringBuffers();
+  std::vector<BufferPtr> stringBuffers(
+      vectorBuffers.begin() + 1, vectorBuffers.end());
+  if (!vectors_[cacheIndex].maybePushBack(vector)) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  for (auto& buffer : stringBuffers) {
+    releaseStringBuffer(buffer);
+  }
+  return true;
+}
+
+BufferPtr VectorPool::getStringBuffer(size_t size) {
+  if (numStringBuffers_ == 0) {
+    return nullptr;
+  }
+  for (auto i = std::max(0, stringBufferClass(size));
+       i < kNumStringBufferClasses;
+       ++i) {
+    auto& buffers = stringBuffers_[i];
+    for (auto j = buffers.size - 1; j >= 0; --j) {
+      if (buffers.buffers[j]->capacity() < size) {
+        continue;
+      }
+      auto buffer = std::move(buffers.buffers[j]);
+      if (j != --buffers.size) {
+        buffers.buffers[j] = std::move(buffers.buffers[buffers.size]);
+      }
+      --numStringBuffers_;
+      buffer->setSize(0);
+      return buffer;
+    }
+  }
+  return nullptr;
+}
+
+bool VectorPool::releaseStringBuffer(BufferPtr& buffer) {
+  if (buffer == nullptr || buffer->pool() != pool_ || !buffer->isMutable() ||
+      buffer->capacity() > FlatVector<StringView>::kMaxStringSizeForReuse) {
+    return false;
+  }
+  const auto bufferClass = stringBufferClass(buffer->capacity());
+  if (bufferClass < 0 || bufferClass >= kNumStringBufferClasses) {
+    return false;
+  }
+  auto& buffers = stringBuffers_[bufferClass];
+  if (buffers.size >= kNumStringBuffersPerClass) {
+    return false;
+  }
+  buffers.buffers[buffers.size++] = std::move(buffer);
+  ++numStringBuffers_;
+  return true;
+}
+
+void VectorPool::maybeAddStringBuffer(BaseVector& vector) {
+  auto* flatVector = vector.asUnchecked<FlatVector<StringView>>();
+  if (!flatVector->stringBuffers().empty()) {
+    return;
+  }
+  flatVector->addStringBuffer(getStringBuffer(0));
+}
+
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool assign) {
+  const auto kind = type->kind();
+  if (kind != TypeKind::ROW && kind != TypeKind::ARRAY &&
+      kind != TypeKind::MAP) {
+    return nullptr;
+  }
+  // Custom types have a name of their own.
+  if (std::strcmp(type->name(), type->kindName()) != 0) {
+    return nullptr;
+  }
+  int32_t freeSlot = -1;
+  for (auto i = 0; i < kNumComplexTypes; ++i) {
+    const auto& slotType = complexTypes_[i];
+    if (slotType == nullptr) {
+      if (freeSlot < 0) {
+        freeSlot = i;
+      }
+      continue;
+    }
+    if (slotType == type || *slotType == *type) {
+      return &complexVectors_[i];
+    }
+    if (freeSlot < 0 && complexVectors_[i].size == 0) {
+      freeSlot = i;
+    }
+  }
+  if (!assign || freeSlot < 0) {
+    return nullptr;
+  }
+  complexTypes_[freeSlot] = type;
+  return &complexVectors_[freeSlot];
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -86,15 +219,34 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer, or
+  // a writable complex vector.
+  if (!vector->isWritable()) {
     return false;
   }
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (!vector->values()) {
+        return false;
+      }
+      break;
+    case VectorEncoding::Simple::ROW:
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+      break;
+    default:
+      return false;
+  }
   if (size >= kNumPerType) {
     return false;
   }
 
   vector->prepareForReuse();
+  if (!vector->isFlatEncoding()) {
+    // The children are reset to size zero. A later resize to a larger size
+    // resizes them along.
+    vector->resize(0);
+  }
   vectors[size++] = std::move(vector);
   return true;
 }
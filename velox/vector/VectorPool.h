@@ -20,17 +20,29 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
+/// A thread-level cache of pre-allocated vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
 /// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// Only singleton built-in types and ROW, ARRAY and MAP types are supported.
+/// Complex vectors are kept for up to 8 distinct types at a time and their
+/// children are reset to size zero on release, keeping the child buffers.
+/// Decimal types, fixed-size array type and custom types are not supported.
+/// Calling 'get' for an unsupported type already returns a newly allocated
+/// vector. Calling 'release' for an unsupported type is a no-op.
+///
+/// Also keeps the string buffers that a recycled VARCHAR or VARBINARY vector
+/// holds beyond the one it keeps for reuse, up to 2 per power of two capacity
+/// between 32KB and 1MB. A VARCHAR or VARBINARY vector returned by 'get'
+/// without a string buffer gets one of these.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
+  /// Returns the pool the vectors of 'this' are allocated from.
+  memory::MemoryPool* pool() const {
+    return pool_;
+  }
+
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
   /// 'pool_' if no pre-allocated vector or type is a complex type.
   VectorPtr get(const TypePtr& type, vector_size_t size);
@@ -42,11 +54,24 @@ class VectorPool {
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  /// Returns an empty recycled string buffer with a capacity of at least
+  /// 'size' bytes. Returns nullptr if there is none.
+  BufferPtr getStringBuffer(size_t size);
+
+  /// Moves 'buffer' into 'this' if it is allocated from 'pool_', singly
+  /// referenced and mutable, its capacity is between 32KB and 1MB and there is
+  /// space. Returns true if 'buffer' has been moved.
+  bool releaseStringBuffer(BufferPtr& buffer);
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  static constexpr int32_t kNumComplexTypes = 8;
+  /// Classes of 32KB, 64KB, ... 1MB.
+  static constexpr int32_t kNumStringBufferClasses = 6;
+  static constexpr int32_t kNumStringBuffersPerClass = 2;
 
   struct TypePool {
     int32_t size{0};
@@ -60,6 +85,20 @@ class VectorPool {
         memory::MemoryPool& pool);
   };
 
+  struct StringBufferClass {
+    int32_t size{0};
+    std::array<BufferPtr, kNumStringBuffersPerClass> buffers;
+  };
+
+  /// Returns the TypePool for complex 'type' or nullptr if 'type' is not a
+  /// supported complex type. If 'assign' is true and there is no TypePool for
+  /// 'type', assigns an empty one to it.
+  TypePool* complexTypePool(const TypePtr& type, bool assign);
+
+  /// Attaches a recycled string buffer to 'vector' of VARCHAR or VARBINARY
+  /// if it has none.
+  void maybeAddStringBuffer(BaseVector& vector);
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +106,15 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Types of the complex vectors in 'complexVectors_' at the same index. A
+  /// slot with no vectors is reassigned to the next type released.
+  std::array<TypePtr, kNumComplexTypes> complexTypes_;
+  std::array<TypePool, kNumComplexTypes> complexVectors_;
+
+  /// Recycled string buffers by power of two capacity starting at 32KB.
+  std::array<StringBufferClass, kNumStringBufferClasses> stringBuffers_;
+  int32_t numStringBuffers_{0};
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
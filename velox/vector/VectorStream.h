@@ -208,6 +208,14 @@ class VectorSerde {
       RowVectorPtr* result,
       const Options* options = nullptr) = 0;
 
+  /// Returns the number of rows serialized in 'source' without deserializing
+  /// them, or std::nullopt if the format does not tell. Reads 'source' to the
+  /// end.
+  virtual std::optional<int64_t> numSerializedRows(
+      ByteInputStream* /*source*/) const {
+    return std::nullopt;
+  }
+
   /// Returns true if implements 'deserialize' API with 'resultOffset' to allow
   /// for appending deserialized data to an existing vector.
   virtual bool supportsAppendInDeserialize() const {
@@ -548,6 +548,105 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Imports an Arrow Utf8View or BinaryView array. An Arrow view is 16 bytes:
+// the string size followed by either the inlined string or a 4 byte prefix,
+// the index of the variadic data buffer and the offset of the string in it.
+// Inlined strings are zero padded and have the same layout as a Velox
+// StringView, so if all views are inlined the views buffer is used as is. Otherwise the views are rewritten
+// to point into the data buffers. The string data is never copied.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  static_assert(sizeof(StringView) == 16);
+  static constexpr size_t kViewSize = 16;
+  // Validity, views and variadic buffer sizes, plus the variadic buffers.
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto length = arrowArray.length;
+  const auto* views = static_cast<const char*>(arrowArray.buffers[1]);
+  VELOX_USER_CHECK(
+      length == 0 || views != nullptr, "Views buffer can't be null.");
+
+  auto viewSize = [&](int64_t i) {
+    int32_t size;
+    memcpy(&size, views + i * kViewSize, sizeof(int32_t));
+    return size;
+  };
+
+  // Null rows are also checked: their views are unspecified and must not be
+  // taken for pointers.
+  bool allInlined = true;
+  for (int64_t i = 0; i < length; ++i) {
+    if (!StringView::isInline(viewSize(i))) {
+      allInlined = false;
+      break;
+    }
+  }
+  if (allInlined) {
+    return std::make_shared<FlatVector<StringView>>(
+        pool,
+        type,
+        nulls,
+        length,
+        wrapInBufferView(views, length * kViewSize),
+        std::vector<BufferPtr>(),
+        SimpleVectorStats<StringView>{},
+        std::nullopt,
+        optionalNullCount(arrowArray.null_count));
+  }
+
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* dataBufferSizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  std::vector<BufferPtr> stringBuffers;
+  stringBuffers.reserve(numDataBuffers);
+  for (int64_t i = 0; i < numDataBuffers; ++i) {
+    stringBuffers.push_back(
+        wrapInBufferView(arrowArray.buffers[2 + i], dataBufferSizes[i]));
+  }
+
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  for (int64_t i = 0; i < length; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawStringViews[i] = StringView();
+      continue;
+    }
+    const auto* view = views + i * kViewSize;
+    const auto size = viewSize(i);
+    if (StringView::isInline(size)) {
+      memcpy(&rawStringViews[i], view, kViewSize);
+      continue;
+    }
+    int32_t bufferIndex;
+    int32_t offset;
+    memcpy(&bufferIndex, view + 8, sizeof(int32_t));
+    memcpy(&offset, view + 12, sizeof(int32_t));
+    VELOX_USER_CHECK_LT(
+        bufferIndex, numDataBuffers, "Invalid string view buffer index.");
+    rawStringViews[i] = StringView(
+        static_cast<const char*>(arrowArray.buffers[2 + bufferIndex]) + offset,
+        size);
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -1082,6 +1181,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // String and binary views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       if (format[1] == 's') {
         return TIMESTAMP();
@@ -1660,6 +1769,11 @@ bool isREE(const ArrowSchema& arrowSchema) {
   return arrowSchema.format[0] == '+' && arrowSchema.format[1] == 'r';
 }
 
+bool isStringView(const ArrowSchema& arrowSchema) {
+  return arrowSchema.format[0] == 'v' &&
+      (arrowSchema.format[1] == 'u' || arrowSchema.format[1] == 'z');
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1712,7 +1826,10 @@ VectorPtr importFromArrowImpl(
   }
 
   // String data types (VARCHAR and VARBINARY).
-  if (type->isVarchar() || type->isVarbinary()) {
+  if (isStringView(arrowSchema)) {
+    return createStringViewFlatVector(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  } else if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
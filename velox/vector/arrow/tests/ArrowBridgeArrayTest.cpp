@@ -1310,6 +1310,108 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
         });
   }
 
+  void testImportStringView() {
+    testStringViewImport("vu", {});
+    testStringViewImport("vu", {"single"});
+    // All strings inlined.
+    testStringViewImport(
+        "vu", {"hello", std::nullopt, "", "twelve bytes", "from", std::nullopt});
+    testStringViewImport(
+        "vu",
+        {
+            "hello world",
+            "larger string which should not be inlined...",
+            std::nullopt,
+            "hello",
+            "another string that is stored out of line",
+            "the",
+            "thirteen byte",
+            std::nullopt,
+        });
+    testStringViewImport(
+        "vz",
+        {
+            std::nullopt,
+            "testing",
+            "a varbinary value that is not inlined",
+            std::nullopt,
+            "vector",
+        });
+  }
+
+  // Imports an Arrow string view array of 'inputValues'. The strings that are
+  // not inlined alternate between two variadic data buffers.
+  void testStringViewImport(
+      const char* format,
+      const std::vector<std::optional<std::string>>& inputValues) {
+    constexpr size_t kViewSize = 16;
+    const int64_t length = inputValues.size();
+    int64_t nullCount = 0;
+    bool allInlined = true;
+
+    auto nulls = AlignedBuffer::allocate<uint64_t>(length, pool_.get());
+    auto views =
+        AlignedBuffer::allocate<char>(length * kViewSize, pool_.get(), 0);
+    auto* rawNulls = nulls->asMutable<uint64_t>();
+    auto* rawViews = views->asMutable<char>();
+    std::string data[2];
+    for (int64_t i = 0; i < length; ++i) {
+      if (inputValues[i] == std::nullopt) {
+        bits::setNull(rawNulls, i);
+        nullCount++;
+        continue;
+      }
+      bits::clearNull(rawNulls, i);
+      const auto& value = *inputValues[i];
+      auto* view = rawViews + i * kViewSize;
+      const int32_t size = value.size();
+      memcpy(view, &size, sizeof(int32_t));
+      if (size <= 12) {
+        memcpy(view + 4, value.data(), size);
+        continue;
+      }
+      allInlined = false;
+      const int32_t bufferIndex = i % 2;
+      const int32_t offset = data[bufferIndex].size();
+      memcpy(view + 4, value.data(), 4);
+      memcpy(view + 8, &bufferIndex, sizeof(int32_t));
+      memcpy(view + 12, &offset, sizeof(int32_t));
+      data[bufferIndex] += value;
+    }
+    const int64_t dataSizes[2] = {
+        static_cast<int64_t>(data[0].size()),
+        static_cast<int64_t>(data[1].size())};
+    const void* buffers[5] = {
+        rawNulls, rawViews, data[0].data(), data[1].data(), dataSizes};
+
+    auto arrowArray = makeArrowArray(buffers, 5, length, nullCount);
+    auto arrowSchema = makeArrowSchema(format);
+    auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    assertVectorContent(inputValues, output, nullCount);
+
+    auto* flat = output->asFlatVector<StringView>();
+    if (allInlined) {
+      // The Arrow views are used as is.
+      EXPECT_EQ(
+          reinterpret_cast<const char*>(flat->rawValues()),
+          static_cast<const char*>(rawViews));
+      EXPECT_TRUE(flat->stringBuffers().empty());
+    } else {
+      // The string data is not copied.
+      EXPECT_EQ(2, flat->stringBuffers().size());
+      for (int64_t i = 0; i < length; ++i) {
+        if (!flat->isNullAt(i) && !flat->valueAt(i).isInline()) {
+          const auto* chars = flat->valueAt(i).data();
+          EXPECT_TRUE(
+              (chars >= data[0].data() &&
+               chars < data[0].data() + data[0].size()) ||
+              (chars >= data[1].data() &&
+               chars < data[1].data() + data[1].size()));
+        }
+      }
+    }
+  }
+
  private:
   // Creates short decimals from int128 and asserts the content of actual vector
   // with the expected values.
@@ -1752,6 +1854,10 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, row) {
   testImportRow();
 }
@@ -1805,6 +1911,10 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, row) {
   testImportRow();
 }
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/vector/MappedVectorFile.h"
+#include <fstream>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+#include "velox/vector/VectorSaver.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::test {
+
+class MappedVectorFileTest : public testing::Test, public VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  VectorPtr roundTrip(const VectorPtr& vector) {
+    auto path = exec::test::TempFilePath::create();
+    saveVectorToMappedFile(*vector, path->getPath().c_str());
+    return restoreVectorFromMappedFile(path->getPath().c_str(), pool());
+  }
+
+  void testRoundTrip(const VectorPtr& vector) {
+    auto copy = roundTrip(vector);
+    ASSERT_EQ(vector->encoding(), copy->encoding());
+    ASSERT_EQ(*vector->type(), *copy->type());
+    assertEqualVectors(vector, copy);
+  }
+
+  const uint32_t seed_{folly::Random::rand32()};
+};
+
+TEST_F(MappedVectorFileTest, flat) {
+  testRoundTrip(makeFlatVector<int64_t>(10'000, [](auto row) { return row; }));
+  testRoundTrip(makeFlatVector<int32_t>(
+      1'000, [](auto row) { return row; }, nullEvery(7)));
+  testRoundTrip(makeFlatVector<bool>(
+      1'000, [](auto row) { return row % 3 == 0; }, nullEvery(5)));
+  testRoundTrip(makeFlatVector<Timestamp>(
+      1'000, [](auto row) { return Timestamp(row, row * 1'000); }));
+  testRoundTrip(makeFlatVector<int128_t>(
+      100, [](auto row) { return HugeInt::build(row, row); }, nullEvery(3)));
+  testRoundTrip(BaseVector::create(BIGINT(), 0, pool()));
+  testRoundTrip(BaseVector::createNullConstant(UNKNOWN(), 10, pool()));
+}
+
+TEST_F(MappedVectorFileTest, strings) {
+  testRoundTrip(makeNullableFlatVector<std::string>(
+      {"a",
+       std::nullopt,
+       "a string longer than the inline limit",
+       "",
+       "another non-inlined string"}));
+  testRoundTrip(makeFlatVector<std::string>(
+      1'000,
+      [](auto row) { return std::string(row % 40, 'a' + row % 26); },
+      nullEvery(11)));
+
+  // The views are fixed up in a private mapping. The file keeps the offsets.
+  auto path = exec::test::TempFilePath::create();
+  auto vector = makeFlatVector<std::string>(
+      {"long string number one", "long string number two"});
+  saveVectorToMappedFile(*vector, path->getPath().c_str());
+  auto first = restoreVectorFromMappedFile(path->getPath().c_str(), pool());
+  auto second = restoreVectorFromMappedFile(path->getPath().c_str(), pool());
+  assertEqualVectors(vector, first);
+  assertEqualVectors(vector, second);
+}
+
+TEST_F(MappedVectorFileTest, encodings) {
+  auto base = makeFlatVector<std::string>(
+      100, [](auto row) { return fmt::format("value number {}", row); });
+  testRoundTrip(BaseVector::wrapInDictionary(
+      makeNulls(50, nullEvery(4)),
+      makeIndices(50, [](auto row) { return row * 2; }),
+      50,
+      base));
+  testRoundTrip(BaseVector::wrapInConstant(10, 5, base));
+  testRoundTrip(makeConstant<int64_t>(7, 100));
+  testRoundTrip(makeConstant<StringView>(
+      StringView("a constant that is not inlined"), 100));
+  testRoundTrip(makeNullConstant(TypeKind::VARCHAR, 10));
+  testRoundTrip(BaseVector::wrapInConstant(
+      10, 1, makeArrayVector<int32_t>({{1, 2}, {3, 4, 5}})));
+}
+
+TEST_F(MappedVectorFileTest, complex) {
+  testRoundTrip(makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 3}),
+      makeNullableArrayVector<int64_t>({{{1, 2}}, std::nullopt, {{3}}}),
+      makeMapVector<int32_t, std::string>(
+          {{{1, "one"}}, {}, {{2, "a much longer value"}, {3, "three"}}}),
+      makeRowVector({makeFlatVector<double>({1.5, 2.5, 3.5})}),
+  }));
+}
+
+TEST_F(MappedVectorFileTest, fuzz) {
+  SCOPED_TRACE(fmt::format("seed: {}", seed_));
+  VectorFuzzer::Options options;
+  options.vectorSize = 100;
+  options.nullRatio = 0.1;
+  options.stringVariableLength = true;
+  options.stringLength = 40;
+  VectorFuzzer fuzzer(options, pool(), seed_);
+  for (auto i = 0; i < 20; ++i) {
+    auto type = fuzzer.randRowType();
+    testRoundTrip(fuzzer.fuzz(type));
+  }
+}
+
+TEST_F(MappedVectorFileTest, lazy) {
+  auto loaded = makeFlatVector<int32_t>({1, 2, 3});
+  auto lazy = std::make_shared<LazyVector>(
+      pool(),
+      INTEGER(),
+      3,
+      std::make_unique<SimpleVectorLoader>([&](auto) { return loaded; }));
+  VELOX_ASSERT_THROW(
+      roundTrip(lazy), "Cannot write a lazy vector that is not loaded");
+  lazy->loadedVector();
+  assertEqualVectors(loaded, roundTrip(lazy));
+}
+
+TEST_F(MappedVectorFileTest, errors) {
+  auto path = exec::test::TempFilePath::create();
+  saveVectorToFile(
+      makeFlatVector<int32_t>({1, 2, 3}).get(), path->getPath().c_str());
+  VELOX_ASSERT_THROW(
+      restoreVectorFromMappedFile(path->getPath().c_str(), pool()),
+      "Not a mapped vector file");
+
+  // Files of a different version are rejected.
+  saveVectorToMappedFile(
+      *makeFlatVector<int32_t>({1, 2, 3}), path->getPath().c_str());
+  {
+    std::fstream file(
+        path->getPath(), std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(8);
+    const int32_t version = kMappedVectorFileVersion + 1;
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  }
+  VELOX_ASSERT_THROW(
+      restoreVectorFromMappedFile(path->getPath().c_str(), pool()),
+      "Unsupported mapped vector file version");
+
+  VELOX_ASSERT_THROW(
+      saveVectorToMappedFile(
+          *BaseVector::create(OPAQUE<int>(), 1, pool()),
+          path->getPath().c_str()),
+      "Cannot write OPAQUE vectors to a mapped file");
+}
+
+} // namespace facebook::velox::test
@@ -407,6 +407,48 @@ TEST_F(SimpleVectorNonParameterizedTest, setAscii) {
   }
 }
 
+TEST_F(SimpleVectorNonParameterizedTest, asciiOfSlicesAndDictionaries) {
+  auto base = maker_.flatVector<std::string>({"a", "bc", "ä", "ghij"});
+  base->computeAndSetIsAscii(SelectivityVector(base->size()));
+  ASSERT_FALSE(base->isAllAsciiInRange(0, 4));
+
+  // The asciiness is not known for a slice of rows that are not all known to
+  // be ASCII.
+  auto slice = base->slice(1, 2)->as<SimpleVector<StringView>>();
+  ASSERT_FALSE(slice->isAscii(SelectivityVector(2)).has_value());
+
+  base->invalidateIsAscii();
+  SelectivityVector asciiRows(base->size());
+  asciiRows.setValid(2, false);
+  asciiRows.updateBounds();
+  base->computeAndSetIsAscii(asciiRows);
+  ASSERT_TRUE(base->isAllAsciiInRange(0, 2));
+  ASSERT_FALSE(base->isAllAsciiInRange(0, 3));
+
+  // A slice of ASCII rows is known to be ASCII.
+  slice = base->slice(0, 2)->as<SimpleVector<StringView>>();
+  ASSERT_TRUE(slice->isAscii(SelectivityVector(2)).value_or(false));
+
+  // A dictionary over a base known to be all ASCII takes the asciiness of the
+  // base without a scan. Mark the base as ASCII although it is not to verify
+  // that the strings are not scanned.
+  base->setAllIsAscii(true);
+  auto indices = AlignedBuffer::allocate<vector_size_t>(3, pool_.get());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  rawIndices[0] = 2;
+  rawIndices[1] = 0;
+  rawIndices[2] = 2;
+  auto dictionary = BaseVector::wrapInDictionary(nullptr, indices, 3, base);
+  ASSERT_TRUE(dictionary->as<SimpleVector<StringView>>()->computeAndSetIsAscii(
+      SelectivityVector(3)));
+
+  // Without the flag on the base the dictionary is scanned.
+  base->invalidateIsAscii();
+  dictionary = BaseVector::wrapInDictionary(nullptr, indices, 3, base);
+  ASSERT_FALSE(dictionary->as<SimpleVector<StringView>>()->computeAndSetIsAscii(
+      SelectivityVector(3)));
+}
+
 TEST_F(SimpleVectorNonParameterizedTest, stringsAsciiResize) {
   std::vector<std::string> largeStrings = {
       std::string(20, '.'),
@@ -151,4 +151,96 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+  const auto rowType = ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())});
+
+  auto vector = vectorPool.get(rowType, 1'000);
+  ASSERT_EQ(1'000, vector->size());
+  auto* rawVector = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  ASSERT_EQ(vector, nullptr);
+
+  // An equal type gets the recycled vector.
+  vector = vectorPool.get(ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())}), 100);
+  ASSERT_EQ(rawVector, vector.get());
+  ASSERT_EQ(100, vector->size());
+  ASSERT_EQ(100, vector->as<RowVector>()->childAt(0)->size());
+  ASSERT_EQ(100, vector->as<RowVector>()->childAt(1)->size());
+
+  // A type with other names does not.
+  auto other = vectorPool.get(ROW({"x", "y"}, {BIGINT(), ARRAY(VARCHAR())}), 1);
+  ASSERT_NE(rawVector, other.get());
+
+  // Shared vectors and other encodings are not recycled.
+  auto copy = vector;
+  ASSERT_FALSE(vectorPool.release(vector));
+  copy.reset();
+  VectorPtr constant = BaseVector::createNullConstant(rowType, 10, pool());
+  ASSERT_FALSE(vectorPool.release(constant));
+
+  auto array = makeArrayVector<int64_t>({{1, 2, 3}, {4}, {}});
+  auto* rawArray = array.get();
+  VectorPtr arrayVector = std::move(array);
+  ASSERT_TRUE(vectorPool.release(arrayVector));
+  auto recycledArray = vectorPool.get(ARRAY(BIGINT()), 10);
+  ASSERT_EQ(rawArray, recycledArray.get());
+  auto* arrayResult = recycledArray->as<ArrayVector>();
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_EQ(0, arrayResult->sizeAt(i));
+  }
+}
+
+TEST_F(VectorPoolTest, stringBuffers) {
+  VectorPool vectorPool(pool());
+  ASSERT_EQ(vectorPool.getStringBuffer(0), nullptr);
+
+  // Fill a vector with more than one string buffer.
+  auto vector = vectorPool.get(VARCHAR(), 1'000);
+  auto* flatVector = vector->asFlatVector<StringView>();
+  const std::string value(100, 'x');
+  for (auto i = 0; i < 1'000; ++i) {
+    flatVector->set(i, StringView(value));
+  }
+  const auto numBuffers = flatVector->stringBuffers().size();
+  ASSERT_GT(numBuffers, 1);
+
+  // The vector keeps its first buffer and the others are recycled.
+  ASSERT_TRUE(vectorPool.release(vector));
+  auto recycledVector = vectorPool.get(VARCHAR(), 1'000);
+  ASSERT_EQ(
+      1, recycledVector->asFlatVector<StringView>()->stringBuffers().size());
+
+  // A new vector gets a recycled buffer.
+  auto newVector = vectorPool.get(VARCHAR(), 1'000);
+  const auto& newBuffers =
+      newVector->asFlatVector<StringView>()->stringBuffers();
+  ASSERT_EQ(1, newBuffers.size());
+  ASSERT_EQ(0, newBuffers[0]->size());
+
+  auto buffer = vectorPool.getStringBuffer(0);
+  if (numBuffers > 2) {
+    ASSERT_NE(buffer, nullptr);
+    ASSERT_EQ(0, buffer->size());
+    auto* rawBuffer = buffer.get();
+    ASSERT_TRUE(vectorPool.releaseStringBuffer(buffer));
+    ASSERT_EQ(buffer, nullptr);
+    ASSERT_EQ(rawBuffer, vectorPool.getStringBuffer(1'000).get());
+  }
+
+  // Shared, small and large buffers are not recycled.
+  auto shared = AlignedBuffer::allocate<char>(64 << 10, pool());
+  auto copy = shared;
+  ASSERT_FALSE(vectorPool.releaseStringBuffer(shared));
+  auto small = AlignedBuffer::allocate<char>(100, pool());
+  ASSERT_FALSE(vectorPool.releaseStringBuffer(small));
+  auto large = AlignedBuffer::allocate<char>(4 << 20, pool());
+  ASSERT_FALSE(vectorPool.releaseStringBuffer(large));
+
+  // A buffer is only returned if it is large enough.
+  auto medium = AlignedBuffer::allocate<char>(64 << 10, pool());
+  ASSERT_TRUE(vectorPool.releaseStringBuffer(medium));
+  ASSERT_EQ(vectorPool.getStringBuffer(512 << 10), nullptr);
+  ASSERT_NE(vectorPool.getStringBuffer(64 << 10), nullptr);
+}
 } // namespace facebook::velox::test